@@ -271,6 +271,9 @@ static const spi_conf_t spi_config[] = {
  * @{
  */
 #define PM_BLOCKER_INITIAL  { .val_u32 = 0x00000000 }
+/* wakeup latency of standby, idle 2 and idle 1, including the DFLL relock
+ * after standby */
+#define PM_WAKEUP_LATENCY_US    { 250, 20, 10 }
 /** @} */
 
 #ifdef __cplusplus
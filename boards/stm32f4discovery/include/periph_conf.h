@@ -89,10 +89,7 @@ static const uart_conf_t uart_config[] = {
         .tx_af      = GPIO_AF7,
         .bus        = APB1,
         .irqn       = USART2_IRQn,
-#ifdef UART_USE_DMA
-        .dma_stream = 6,
-        .dma_chan   = 4
-#endif
+        .rx_dma     = DMA_TRIGGER(1, 5, 4)
     },
     {
         .dev        = USART3,
@@ -103,10 +100,7 @@ static const uart_conf_t uart_config[] = {
         .tx_af      = GPIO_AF7,
         .bus        = APB1,
         .irqn       = USART3_IRQn,
-#ifdef UART_USE_DMA
-        .dma_stream = 3,
-        .dma_chan   = 4
-#endif
+        .rx_dma     = DMA_TRIGGER(1, 1, 4)
     }
 };
 
@@ -133,6 +127,14 @@ static const uart_conf_t uart_config[] = {
 }
 
 #define ADC_NUMOF           (4)
+
+/* TIM8 is not used otherwise, its TRGO triggers the conversions */
+#define ADC_STREAM_CONFIG {             \
+    .dev      = TIM8,                   \
+    .rcc_mask = RCC_APB2ENR_TIM8EN,     \
+    .bus      = APB2,                   \
+    .extsel   = 14                      \
+}
 /** @} */
 
 /**
@@ -210,7 +212,9 @@ static const spi_conf_t spi_config[] = {
         .cs_pin   = GPIO_PIN(PORT_A, 4),
         .af       = GPIO_AF5,
         .rccmask  = RCC_APB2ENR_SPI1EN,
-        .apbbus   = APB2
+        .apbbus   = APB2,
+        .tx_dma   = DMA_TRIGGER(2, 3, 3),
+        .rx_dma   = DMA_TRIGGER(2, 0, 3)
     },
     {
         .dev      = SPI2,
@@ -220,7 +224,9 @@ static const spi_conf_t spi_config[] = {
         .cs_pin   = GPIO_PIN(PORT_B, 12),
         .af       = GPIO_AF5,
         .rccmask  = RCC_APB1ENR_SPI2EN,
-        .apbbus   = APB1
+        .apbbus   = APB1,
+        .tx_dma   = DMA_TRIGGER(1, 4, 0),
+        .rx_dma   = DMA_TRIGGER(1, 3, 0)
     }
 };
 
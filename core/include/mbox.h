@@ -155,6 +155,19 @@ static inline int mbox_try_get(mbox_t *mbox, msg_t *msg)
     return _mbox_get(mbox, msg, NON_BLOCKING);
 }
 
+/**
+ * @brief Check if mailbox is full
+ *
+ * @param[in] mbox  ptr to mailbox to check
+ *
+ * @return  1   if mbox_try_put() would fail
+ * @return  0   otherwise
+ */
+static inline unsigned int mbox_full(const mbox_t *mbox)
+{
+    return cib_full(&mbox->cib);
+}
+
 #ifdef __cplusplus
 }
 #endif
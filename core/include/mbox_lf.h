@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_mbox_lf Lock-free mailboxes
+ * @ingroup     core
+ * @brief       Multi-producer, single-consumer mailbox without IRQ locking
+ *
+ * In contrast to @ref core_mbox, putting a message into a lock-free mailbox
+ * does not disable interrupts. Any number of ISRs and threads may put
+ * messages concurrently; the slot is reserved with an atomic update of the
+ * underlying @ref cib_t and published once the message is copied. The
+ * scheduler is only entered if the consumer is waiting for a message.
+ *
+ * Restrictions:
+ * - there must only be a single consumer thread per mailbox
+ * - putting never blocks, so producers have to handle a full mailbox
+ * - the number of slots must be a power of two
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static mbox_lf_slot_t _slots[8];
+ * static mbox_lf_t _mbox = MBOX_LF_INIT(_slots, 8);
+ *
+ * static void _isr(void *arg)
+ * {
+ *     msg_t m = { .type = ISR_EVENT };
+ *     mbox_lf_try_put(&_mbox, &m);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free mailbox API
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef MBOX_LF_H
+#define MBOX_LF_H
+
+#include <stdint.h>
+
+#include "cib.h"
+#include "msg.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Slot of a lock-free mailbox
+ */
+typedef struct {
+    msg_t msg;              /**< the queued message                         */
+    uint8_t ready;          /**< 1 if @ref msg is completely written        */
+} mbox_lf_slot_t;
+
+/**
+ * @brief   Lock-free mailbox struct definition
+ */
+typedef struct {
+    cib_t cib;              /**< indices into @ref slots, updated atomically */
+    mbox_lf_slot_t *slots;  /**< ptr to array of slots                       */
+    thread_t *waiter;       /**< consumer waiting for a message, or NULL     */
+} mbox_lf_t;
+
+/** Static initializer for lock-free mbox objects */
+#define MBOX_LF_INIT(slots, slots_numof) { CIB_INIT(slots_numof), slots, NULL }
+
+/**
+ * @brief Initialize lock-free mailbox object
+ *
+ * @note The message slots must be zero initialized.
+ *
+ * @param[in] mbox          ptr to mailbox to initialize
+ * @param[in] slots         array of mbox_lf_slot_t used as queue
+ * @param[in] slots_numof   number of slots, must be a power of two
+ */
+static inline void mbox_lf_init(mbox_lf_t *mbox, mbox_lf_slot_t *slots,
+                                unsigned int slots_numof)
+{
+    mbox_lf_t m = MBOX_LF_INIT(slots, slots_numof);
+    *mbox = m;
+}
+
+/**
+ * @brief Add message to lock-free mailbox
+ *
+ * If the mailbox is full, this function will return right away. It may be
+ * called from interrupt context.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[in] msg   ptr to message that will be copied into mailbox
+ *
+ * @return  1   if msg could be delivered
+ * @return  0   otherwise
+ */
+int mbox_lf_try_put(mbox_lf_t *mbox, msg_t *msg);
+
+/**
+ * @brief Get message from lock-free mailbox
+ *
+ * If the mailbox is empty, this function will return right away. Must only
+ * be called by the consumer thread of @p mbox.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[in] msg   ptr to storage for retrieved message
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   otherwise
+ */
+int mbox_lf_try_get(mbox_lf_t *mbox, msg_t *msg);
+
+/**
+ * @brief Get message from lock-free mailbox
+ *
+ * If the mailbox is empty, this function will block until a message becomes
+ * available. Must only be called by the consumer thread of @p mbox.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[in] msg   ptr to storage for retrieved message
+ */
+void mbox_lf_get(mbox_lf_t *mbox, msg_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* MBOX_LF_H */
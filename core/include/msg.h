@@ -153,6 +153,13 @@
  * is out of scope for the basic IPC provided by the kernel. See the
  * @ref sys_xtimer "xtimer" module on information for these functionalities.
  *
+ * Statistics
+ * ==========
+ * With the `core_msg_stats` module, each thread counts the messages it
+ * received, the messages dropped because its queue was full, i.e. failed
+ * non-blocking sends and sends from interrupts, and the highest number of
+ * messages its queue held. `ps` shows them.
+ *
  * @{
  *
  * @file
@@ -309,6 +316,47 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a message, unless the receive gets cancelled.
+ *
+ * Behaves like msg_receive(), but returns without a message once
+ * msg_receive_cancel() was called for this receive, no matter whether that
+ * happens before or while the thread is blocked.
+ *
+ * This is the building block for receive timeouts (e.g.,
+ * @ref xtimer_msg_receive_timeout()): the timer callback cancels the receive
+ * directly instead of sending the receiver a message, so no message queue slot
+ * is needed for the timeout.
+ *
+ * @param[out] m            Pointer to preallocated ``msg_t`` structure, must
+ *                          not be NULL.
+ * @param[in]  cancelled    cancellation flag, must be initialized to 0 and
+ *                          only be set by msg_receive_cancel()
+ *
+ * @return  1, if a message was received
+ * @return  -1, if the receive was cancelled
+ */
+int msg_receive_cancellable(msg_t *m, volatile int *cancelled);
+
+/**
+ * @brief Cancel a msg_receive_cancellable() call.
+ *
+ * Sets @p cancelled and wakes up the receiver if it is still blocked waiting
+ * for a message to be written to @p m. A message arriving at the same time as
+ * the cancellation is never lost: if it was delivered first, the receive
+ * succeeds. Can be called from interrupt context.
+ *
+ * @param[in] target_pid    PID of the receiving thread
+ * @param[in] m             message buffer passed to msg_receive_cancellable()
+ * @param[out] cancelled    cancellation flag passed to
+ *                          msg_receive_cancellable()
+ *
+ * @return  1, if the thread was woken up without a message
+ * @return  0, if the thread was not blocked on @p m
+ */
+int msg_receive_cancel(kernel_pid_t target_pid, msg_t *m,
+                       volatile int *cancelled);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -11,6 +11,19 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * By default, the waiting threads are queued by priority, but the owner of a
+ * mutex keeps its own priority. Use the module
+ * `core_mutex_priority_inheritance` to temporarily raise the priority of the
+ * owner to the one of the highest priority waiter until the mutex is
+ * unlocked. This bounds priority inversion at the cost of a few bytes per
+ * mutex.
+ *
+ * @note    Priority inheritance is not transitive: if the owner is itself
+ *          blocked on another mutex, the owner of that one is not boosted.
+ *          When a thread holds several mutexes, its original priority is
+ *          restored as soon as any of them is unlocked.
+ *
  * @{
  *
  * @file
@@ -25,6 +38,7 @@
 #include <stddef.h>
 
 #include "list.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -40,18 +54,42 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The current owner of the mutex or KERNEL_PID_UNDEF
+     * @note    Only available if module core_mutex_priority_inheritance is
+     *          used
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Original priority of the owner, restored on unlock
+     * @note    Only available if module core_mutex_priority_inheritance is
+     *          used
+     * @internal
+     */
+    uint8_t owner_original_priority;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +110,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_util
+ * @{
+ *
+ * @file
+ * @brief       A priority queue based on a pairing heap
+ *
+ * Sibling of @ref priority_queue.h for queues with more than a handful of
+ * entries: insertion is O(1) and removing the head is O(log n) amortized,
+ * instead of O(n) insertion into the sorted list of priority_queue_t.
+ *
+ * Like priority_queue_t, the heap is intrusive and never allocates memory.
+ * Unlike priority_queue_t, the order of nodes with the same priority is
+ * unspecified.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief data type for priority heap nodes
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *child;   /**< leftmost child */
+    struct priority_heap_node *sibling; /**< next sibling */
+    struct priority_heap_node *prev;    /**< parent for the leftmost child,
+                                             previous sibling otherwise */
+    uint32_t priority;                  /**< heap node priority */
+    unsigned int data;                  /**< heap node data */
+} priority_heap_node_t;
+
+/**
+ * @brief data type for priority heaps
+ */
+typedef struct {
+    priority_heap_node_t *root;         /**< node with the lowest priority
+                                             value */
+} priority_heap_t;
+
+/**
+ * @brief Static initializer for priority_heap_node_t.
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, NULL, NULL, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap node object.
+ * @details For initialization of variables use PRIORITY_HEAP_NODE_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heap nodes.
+ * @param[out] node
+ *          pre-allocated priority_heap_node_t object, must not be NULL.
+ */
+static inline void priority_heap_node_init(priority_heap_node_t *node)
+{
+    priority_heap_node_t n = PRIORITY_HEAP_NODE_INIT;
+    *node = n;
+}
+
+/**
+ * @brief Static initializer for priority_heap_t.
+ */
+#define PRIORITY_HEAP_INIT { NULL }
+
+/**
+ * @brief   Initialize a priority heap object.
+ * @details For initialization of variables use PRIORITY_HEAP_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heaps.
+ * @param[out] heap
+ *          pre-allocated priority_heap_t object, must not be NULL.
+ */
+static inline void priority_heap_init(priority_heap_t *heap)
+{
+    heap->root = NULL;
+}
+
+/**
+ * @brief get the node with the lowest priority value without removing it
+ *
+ * @param[in]   heap    the heap
+ *
+ * @return              the head of the heap, NULL if empty
+ */
+static inline priority_heap_node_t *priority_heap_peek(const priority_heap_t *heap)
+{
+    return heap->root;
+}
+
+/**
+ * @brief remove the priority heap's head
+ *
+ * @note Complexity: O(log n) amortized
+ *
+ * @param[in,out]   heap    the heap
+ *
+ * @return                  the old head, NULL if the heap was empty
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap);
+
+/**
+ * @brief insert `node` into `heap` based on its priority
+ *
+ * @note Complexity: O(1)
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to insert
+ *
+ * @pre The heap does not already contain @p node.
+ */
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief remove `node` from `heap`
+ *
+ * Does nothing if @p node is not in a heap.
+ *
+ * @note Complexity: O(log n) amortized
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to remove
+ */
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* PRIORITY_HEAP_H */
@@ -150,6 +150,36 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
  */
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
+/**
+ * @brief           Get the oldest elements of the buffer in place.
+ * @details         The elements are not removed, use ringbuffer_remove() once they
+ *                  were consumed. If the elements wrap around the end of the
+ *                  buffer, only the first contiguous part is returned.
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[out]      span   Start of the oldest elements.
+ * @returns         Number of contiguous elements at @p span. 0 if rb is empty.
+ */
+unsigned ringbuffer_peek_span(const ringbuffer_t *__restrict rb, char **span);
+
+/**
+ * @brief           Get free space behind the newest element to write into in place.
+ * @details         The space only becomes part of the ringbuffer with
+ *                  ringbuffer_commit(). If the free space wraps around the end of
+ *                  the buffer, only the first contiguous part is returned.
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[out]      span   Start of the free space.
+ * @returns         Number of contiguous free elements at @p span. 0 if rb is full.
+ */
+unsigned ringbuffer_reserve_span(const ringbuffer_t *__restrict rb, char **span);
+
+/**
+ * @brief           Add elements that were written to the span of
+ *                  ringbuffer_reserve_span().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, at most the size of the span.
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -170,33 +170,78 @@ extern volatile kernel_pid_t sched_active_pid;
 extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 
 /**
- * @brief  Removes thread from scheduler and set status to #STATUS_STOPPED
+ * @brief   Check if more than one thread is queued on a runqueue
+ *
+ * @param[in] prio  priority of the runqueue
+ *
+ * @return  != 0 if at least two threads of priority @p prio are runnable
  */
-NORETURN void sched_task_exit(void);
+static inline int sched_runq_more_than_one(uint8_t prio)
+{
+    clist_node_t *last = sched_runqueues[prio].next;
+
+    return (last != NULL) && (last->next != last);
+}
 
-#ifdef MODULE_SCHEDSTATISTICS
 /**
- *  Scheduler statistics
+ * @brief   Move the first thread of a runqueue to its end
+ *
+ * @note    Must be called with interrupts disabled. If the running thread
+ *          is affected, the caller must trigger a context switch before the
+ *          running thread blocks again.
+ *
+ * @param[in] prio  priority of the runqueue
  */
-typedef struct {
-    uint64_t laststart;      /**< Time stamp of the last time this thread was
-                                  scheduled to run */
-    unsigned int schedules;  /**< How often the thread was scheduled to run */
-    uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
-} schedstat;
+static inline void sched_runq_advance(uint8_t prio)
+{
+    clist_lpoprpush(&sched_runqueues[prio]);
+}
 
+#if defined(MODULE_SCHED_RUNQ_CALLBACK) || defined(DOXYGEN)
 /**
- *  Thread statistics table
+ * @brief   Called by the scheduler whenever a thread is added to or removed
+ *          from a runqueue
+ *
+ * Has to be provided by the module using the @c sched_runq_callback
+ * pseudomodule. Is called with interrupts disabled.
+ *
+ * @param[in] prio  priority of the runqueue that changed
  */
-extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+void sched_runq_callback(uint8_t prio);
+#endif
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If the thread is on a runqueue, it is moved to the runqueue of the new
+ * priority. This function does not trigger a context switch, the caller has
+ * to yield (e.g. using @ref sched_switch()) if needed.
+ *
+ * @param[in] thread    thread to change the priority of, must not be NULL
+ * @param[in] priority  new priority, must be lower than SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
+/**
+ * @brief  Removes thread from scheduler and set status to #STATUS_STOPPED
+ */
+NORETURN void sched_task_exit(void);
+
+#ifdef MODULE_SCHED_CB
 /**
  *  @brief  Register a callback that will be called on every scheduler run
  *
- *  @param[in] callback The callback functions the will be called
+ *  The callback is executed with interrupts disabled, right before the
+ *  scheduler switches from @p active_thread to @p next_thread. It must be
+ *  short and must not block.
+ *
+ *  @param[in] callback The callback function that will be called, with the
+ *                      pid of the thread that was running (may be
+ *                      KERNEL_PID_UNDEF) and the pid of the thread that is
+ *                      about to be scheduled
  */
-void sched_register_cb(void (*callback)(uint32_t, uint32_t));
-#endif /* MODULE_SCHEDSTATISTICS */
+void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t));
+#endif /* MODULE_SCHED_CB */
 
 #ifdef __cplusplus
 }
@@ -191,14 +191,29 @@ struct _thread {
     cib_t msg_queue;                /**< message queue                  */
     msg_t *msg_array;               /**< memory holding messages        */
 #endif
+#if defined(MODULE_CORE_MSG_STATS)
+    uint16_t msg_queue_max;         /**< most messages ever queued      */
+    uint32_t msg_received;          /**< messages received              */
+    uint32_t msg_dropped;           /**< messages dropped as the queue
+                                         was full                       */
+#endif
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_STACKPROF)
     char *stack_start;              /**< thread's stack start address   */
 #endif
 #ifdef DEVELHELP
     const char *name;               /**< thread's name                  */
+#endif
+#if defined(DEVELHELP) || defined(MODULE_STACKPROF)
     int stack_size;                 /**< thread's stack size            */
 #endif
+#ifdef MODULE_STACKPROF
+    uintptr_t *stack_hwm;           /**< lowest stack address known to
+                                         have been used                 */
+    uintptr_t *stack_scan;          /**< next stack word the profiler
+                                         checks for use                 */
+#endif
 };
 
 /**
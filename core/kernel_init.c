@@ -30,10 +30,6 @@
 
 #include "periph/pm.h"
 
-#ifdef MODULE_SCHEDSTATISTICS
-#include "sched.h"
-#endif
-
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -50,11 +46,6 @@ static void *main_trampoline(void *arg)
     auto_init();
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
-    schedstat *stat = &sched_pidlist[thread_getpid()];
-    stat->laststart = 0;
-#endif
-
     LOG_INFO("main(): This is RIOT! (Version: " RIOT_VERSION ")\n");
 
     main();
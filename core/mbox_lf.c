@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_mbox_lf
+ * @{
+ *
+ * @file
+ * @brief       lock-free mailbox implementation
+ *
+ * Producers reserve a slot by advancing cib.write_count with a
+ * compare-and-swap and mark it ready after copying the message. The only
+ * consumer takes ready slots in order and clears the ready flag *before*
+ * advancing cib.read_count, so a producer never reserves a slot that is still
+ * being read.
+ *
+ * On CPUs without native atomic instructions, the __atomic builtins are
+ * provided by atomic_c11.c.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "mbox_lf.h"
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _wake_waiter(mbox_lf_t *mbox)
+{
+    thread_t *waiter = __atomic_exchange_n(&mbox->waiter, NULL,
+                                           __ATOMIC_ACQ_REL);
+    if (waiter) {
+        DEBUG("mbox_lf: waking up %" PRIkernel_pid ".\n", waiter->pid);
+        unsigned irqstate = irq_disable();
+        sched_set_status(waiter, STATUS_PENDING);
+        irq_restore(irqstate);
+        sched_switch(waiter->priority);
+    }
+}
+
+int mbox_lf_try_put(mbox_lf_t *mbox, msg_t *msg)
+{
+    cib_t *cib = &mbox->cib;
+    unsigned write_count = __atomic_load_n(&cib->write_count, __ATOMIC_RELAXED);
+    unsigned read_count;
+
+    do {
+        read_count = __atomic_load_n(&cib->read_count, __ATOMIC_ACQUIRE);
+        /* signed compare, as in cib_full() */
+        if ((int)(write_count - read_count) > (int)cib->mask) {
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&cib->write_count, &write_count,
+                                          write_count + 1, 1, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED));
+
+    mbox_lf_slot_t *slot = &mbox->slots[write_count & cib->mask];
+    msg->sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    slot->msg = *msg;
+    __atomic_store_n(&slot->ready, 1, __ATOMIC_RELEASE);
+
+    _wake_waiter(mbox);
+    return 1;
+}
+
+int mbox_lf_try_get(mbox_lf_t *mbox, msg_t *msg)
+{
+    cib_t *cib = &mbox->cib;
+    mbox_lf_slot_t *slot = &mbox->slots[cib->read_count & cib->mask];
+
+    /* a reserved slot that is not ready yet is being written by a producer
+     * we interrupted, it will wake us up once it is done */
+    if (!__atomic_load_n(&slot->ready, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    *msg = slot->msg;
+    __atomic_store_n(&slot->ready, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&cib->read_count, cib->read_count + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+void mbox_lf_get(mbox_lf_t *mbox, msg_t *msg)
+{
+    while (!mbox_lf_try_get(mbox, msg)) {
+        thread_t *me = (thread_t *)sched_active_thread;
+        unsigned irqstate = irq_disable();
+        /* check again, a producer could have been done before we disabled
+         * interrupts */
+        if (mbox_lf_try_get(mbox, msg)) {
+            irq_restore(irqstate);
+            return;
+        }
+        DEBUG("mbox_lf: Thread %" PRIkernel_pid " going blocked.\n", me->pid);
+        __atomic_store_n(&mbox->waiter, me, __ATOMIC_RELEASE);
+        sched_set_status(me, STATUS_MBOX_BLOCKED);
+        irq_restore(irqstate);
+        thread_yield_higher();
+    }
+}
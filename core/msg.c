@@ -34,9 +34,17 @@
 #include "debug.h"
 #include "thread.h"
 
-static int _msg_receive(msg_t *m, int block);
+static int _msg_receive(msg_t *m, int block, volatile int *cancelled);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
+#ifdef MODULE_CORE_MSG_STATS
+#define COUNT_RECEIVED(thread)  ((thread)->msg_received++)
+#define COUNT_DROPPED(thread)   ((thread)->msg_dropped++)
+#else
+#define COUNT_RECEIVED(thread)
+#define COUNT_DROPPED(thread)
+#endif
+
 static int queue_msg(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
@@ -48,6 +56,12 @@ static int queue_msg(thread_t *target, const msg_t *m)
     DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+#ifdef MODULE_CORE_MSG_STATS
+    unsigned depth = cib_avail(&(target->msg_queue));
+    if (depth > target->msg_queue_max) {
+        target->msg_queue_max = depth;
+    }
+#endif
     return 1;
 }
 
@@ -116,6 +130,7 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         if (!block) {
             DEBUG("msg_send: %" PRIkernel_pid ": Receiver not waiting, block=%u\n",
                   me->pid, block);
+            COUNT_DROPPED(target);
             irq_restore(state);
             return 0;
         }
@@ -166,6 +181,9 @@ int msg_send_to_self(msg_t *m)
 
     m->sender_pid = sched_active_pid;
     int res = queue_msg((thread_t *) sched_active_thread, m);
+    if (!res) {
+        COUNT_DROPPED((thread_t *) sched_active_thread);
+    }
 
     irq_restore(state);
     return res;
@@ -202,7 +220,11 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
     else {
         DEBUG("msg_send_int: Receiver not waiting.\n");
-        return (queue_msg(target, m));
+        if (!queue_msg(target, m)) {
+            COUNT_DROPPED(target);
+            return 0;
+        }
+        return 1;
     }
 }
 
@@ -267,15 +289,20 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    return _msg_receive(m, 0, NULL);
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    return _msg_receive(m, 1, NULL);
+}
+
+int msg_receive_cancellable(msg_t *m, volatile int *cancelled)
+{
+    return _msg_receive(m, 1, cancelled);
 }
 
-static int _msg_receive(msg_t *m, int block)
+static int _msg_receive(msg_t *m, int block, volatile int *cancelled)
 {
     unsigned state = irq_disable();
     DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive.\n",
@@ -311,6 +338,13 @@ static int _msg_receive(msg_t *m, int block)
               sched_active_thread->pid);
 
         if (queue_index < 0) {
+            if (cancelled && *cancelled) {
+                DEBUG("_msg_receive(): %" PRIkernel_pid ": cancelled before "
+                      "blocking.\n", sched_active_thread->pid);
+                irq_restore(state);
+                return -1;
+            }
+
             DEBUG("_msg_receive(): %" PRIkernel_pid ": No msg in queue. Going blocked.\n",
                   sched_active_thread->pid);
             sched_set_status(me, STATUS_RECEIVE_BLOCKED);
@@ -318,9 +352,16 @@ static int _msg_receive(msg_t *m, int block)
             irq_restore(state);
             thread_yield_higher();
 
+            /* msg_receive_cancel() clears wait_data, senders don't */
+            if (cancelled && (me->wait_data == NULL)) {
+                return -1;
+            }
+
             /* sender copied message */
+            COUNT_RECEIVED(me);
         }
         else {
+            COUNT_RECEIVED(me);
             irq_restore(state);
         }
 
@@ -343,6 +384,8 @@ static int _msg_receive(msg_t *m, int block)
         msg_t *sender_msg = (msg_t*) sender->wait_data;
         *m = *sender_msg;
 
+        COUNT_RECEIVED(me);
+
         /* remove sender from queue */
         uint16_t sender_prio = THREAD_PRIORITY_IDLE;
         if (sender->status != STATUS_REPLY_BLOCKED) {
@@ -361,6 +404,32 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_cancel(kernel_pid_t target_pid, msg_t *m,
+                       volatile int *cancelled)
+{
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    *cancelled = 1;
+
+    if ((target == NULL) || (target->status != STATUS_RECEIVE_BLOCKED) ||
+        (target->wait_data != (void *) m)) {
+        irq_restore(state);
+        return 0;
+    }
+
+    DEBUG("msg_receive_cancel: %" PRIkernel_pid ": waking up without message\n",
+          target_pid);
+    target->wait_data = NULL;
+    sched_set_status(target, STATUS_PENDING);
+
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+    sched_switch(target_prio);
+
+    return 1;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -34,6 +34,54 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    mutex->owner = owner->pid;
+    mutex->owner_original_priority = owner->priority;
+}
+
+static inline void _restore_owner_priority(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+    if ((mutex->owner != KERNEL_PID_UNDEF) && owner) {
+        sched_change_priority(owner, mutex->owner_original_priority);
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+}
+
+static inline void _boost_owner_priority(mutex_t *mutex, thread_t *waiter)
+{
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+    if ((mutex->owner != KERNEL_PID_UNDEF) && owner &&
+        (owner->priority > waiter->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", waiter->pid, owner->pid,
+              (uint32_t)waiter->priority);
+        sched_change_priority(owner, waiter->priority);
+    }
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    (void)mutex;
+    (void)owner;
+}
+
+static inline void _restore_owner_priority(mutex_t *mutex)
+{
+    (void)mutex;
+}
+
+static inline void _boost_owner_priority(mutex_t *mutex, thread_t *waiter)
+{
+    (void)mutex;
+    (void)waiter;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -43,6 +91,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t *)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -60,6 +109,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        _boost_owner_priority(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -87,6 +137,7 @@ void mutex_unlock(mutex_t *mutex)
 
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
+        _restore_owner_priority(mutex);
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
         return;
@@ -96,6 +147,9 @@ void mutex_unlock(mutex_t *mutex)
 
     thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
 
+    _restore_owner_priority(mutex);
+    _set_owner(mutex, process);
+
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
@@ -116,6 +170,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore_owner_priority(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -123,6 +178,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             list_node_t *next = list_remove_head(&mutex->queue);
             thread_t *process = container_of((clist_node_t*)next, thread_t,
                                              rq_entry);
+            _set_owner(mutex, process);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
             if (!mutex->queue.next) {
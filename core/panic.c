@@ -37,6 +37,12 @@
 #include "ps.h"
 #endif
 
+#if defined(MODULE_UART_STDIO)
+#include "uart_stdio.h"
+#elif defined(MODULE_RTT_STDIO)
+#include "rtt_stdio.h"
+#endif
+
 const char assert_crash_message[] = "FAILED ASSERTION.";
 
 /* flag preventing "recursive crash printing loop" */
@@ -73,6 +79,10 @@ NORETURN void core_panic(core_panic_t crash_code, const char *message)
     }
     /* disable watchdog and all possible sources of interrupts */
     irq_disable();
+#if defined(MODULE_UART_STDIO) || defined(MODULE_RTT_STDIO)
+    /* get the messages out before the system goes down */
+    uart_stdio_flush();
+#endif
     panic_arch();
 #ifndef DEVELHELP
     /* DEVELHELP not set => reboot system */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       A priority queue based on a pairing heap
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include "priority_heap.h"
+
+/* Make the root with the higher priority value the leftmost child of the
+ * other one. Both roots must not have siblings. */
+static priority_heap_node_t *_meld(priority_heap_node_t *a,
+                                   priority_heap_node_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+
+    if (b->priority < a->priority) {
+        priority_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/* Standard two pass pairing: meld the siblings pairwise from left to right,
+ * then meld the resulting heaps from right to left. */
+static priority_heap_node_t *_merge_pairs(priority_heap_node_t *first)
+{
+    priority_heap_node_t *pairs = NULL;
+
+    while (first) {
+        priority_heap_node_t *a = first;
+        priority_heap_node_t *b = a->sibling;
+
+        first = (b) ? b->sibling : NULL;
+        a->sibling = a->prev = NULL;
+        if (b) {
+            b->sibling = b->prev = NULL;
+        }
+
+        /* the melded pairs are kept in reverse order, linked by sibling */
+        a = _meld(a, b);
+        a->sibling = pairs;
+        pairs = a;
+    }
+
+    priority_heap_node_t *res = NULL;
+    while (pairs) {
+        priority_heap_node_t *next = pairs->sibling;
+        pairs->sibling = NULL;
+        res = _meld(res, pairs);
+        pairs = next;
+    }
+
+    return res;
+}
+
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    node->child = node->sibling = node->prev = NULL;
+    heap->root = _meld(heap->root, node);
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap)
+{
+    priority_heap_node_t *head = heap->root;
+
+    if (head) {
+        heap->root = _merge_pairs(head->child);
+        head->child = NULL;
+    }
+
+    return head;
+}
+
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    if (node == heap->root) {
+        priority_heap_remove_head(heap);
+        return;
+    }
+    if (node->prev == NULL) {
+        /* not part of a heap */
+        return;
+    }
+
+    /* cut the subtree of node out of the heap */
+    if (node->prev->child == node) {
+        node->prev->child = node->sibling;
+    }
+    else {
+        node->prev->sibling = node->sibling;
+    }
+    if (node->sibling) {
+        node->sibling->prev = node->prev;
+    }
+
+    heap->root = _meld(heap->root, _merge_pairs(node->child));
+    node->child = node->sibling = node->prev = NULL;
+}
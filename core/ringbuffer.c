@@ -20,6 +20,22 @@
 
 #include <string.h>
 
+#include "assert.h"
+
+/**
+ * @brief           Position behind the newest element of the ringbuffer.
+ * @param[in]       rb   Ringbuffer to operate on.
+ * @returns         The position the next element is added at.
+ */
+static inline unsigned get_tail(const ringbuffer_t *restrict rb)
+{
+    unsigned pos = rb->start + rb->avail;
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    return pos;
+}
+
 /**
  * @brief           Add an element to the end of the ringbuffer.
  * @details         This helper function does not check the pre-requirements for adding,
@@ -29,11 +45,8 @@
  */
 static void add_tail(ringbuffer_t *restrict rb, char c)
 {
-    unsigned pos = rb->start + rb->avail++;
-    if (pos >= rb->size) {
-        pos -= rb->size;
-    }
-    rb->buf[pos] = c;
+    rb->buf[get_tail(rb)] = c;
+    rb->avail++;
 }
 
 /**
@@ -54,14 +67,23 @@ static char get_head(ringbuffer_t *restrict rb)
 
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned free = ringbuffer_get_free(rb);
+    if (n > free) {
+        n = free;
+    }
+    if (n > 0) {
+        unsigned tail = get_tail(rb);
+        unsigned bytes_till_end = rb->size - tail;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + tail, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + tail, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
     }
-    return i;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -106,13 +128,17 @@ unsigned ringbuffer_get(ringbuffer_t *restrict rb, char *buf, unsigned n)
             memcpy(buf + bytes_till_end, rb->buf, rb->start);
         }
         rb->avail -= n;
+        if (rb->avail == 0) {
+            /* keep the free space in one piece */
+            rb->start = 0;
+        }
     }
     return n;
 }
 
 unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
 {
-    if (n > rb->avail) {
+    if (n >= rb->avail) {
         n = rb->avail;
         rb->start = rb->avail = 0;
     }
@@ -121,7 +147,7 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->avail -= n;
 
         /* compensate underflow */
-        if (rb->start > rb->size) {
+        if (rb->start >= rb->size) {
             rb->start -= rb->size;
         }
     }
@@ -140,3 +166,25 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf, unsigned n
     ringbuffer_t rb = *rb_;
     return ringbuffer_get(&rb, buf, n);
 }
+
+unsigned ringbuffer_peek_span(const ringbuffer_t *restrict rb, char **span)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+    *span = rb->buf + rb->start;
+    return (bytes_till_end < rb->avail) ? bytes_till_end : rb->avail;
+}
+
+unsigned ringbuffer_reserve_span(const ringbuffer_t *restrict rb, char **span)
+{
+    unsigned tail = get_tail(rb);
+    unsigned bytes_till_end = rb->size - tail;
+    unsigned free = ringbuffer_get_free(rb);
+    *span = rb->buf + tail;
+    return (bytes_till_end < free) ? bytes_till_end : free;
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
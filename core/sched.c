@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -33,8 +34,8 @@
 #include "mpu.h"
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
-#include "xtimer.h"
+#ifdef MODULE_STACKPROF
+#include "stackprof.h"
 #endif
 
 #define ENABLE_DEBUG (0)
@@ -74,9 +75,8 @@ FORCE_USED_SECTION
 uint8_t _tcb_name_offset = offsetof(thread_t, name);
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
-static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
-schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+#ifdef MODULE_SCHED_CB
+static void (*sched_cb) (kernel_pid_t active_thread, kernel_pid_t next_thread) = NULL;
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -100,10 +100,6 @@ int __attribute__((used)) sched_run(void)
         return 0;
     }
 
-#ifdef MODULE_SCHEDSTATISTICS
-    uint64_t now = _xtimer_now64();
-#endif
-
     if (active_thread) {
         if (active_thread->status == STATUS_RUNNING) {
             active_thread->status = STATUS_PENDING;
@@ -115,20 +111,15 @@ int __attribute__((used)) sched_run(void)
         }
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
-        schedstat *active_stat = &sched_pidlist[active_thread->pid];
-        if (active_stat->laststart) {
-            active_stat->runtime_ticks += now - active_stat->laststart;
-        }
+#ifdef MODULE_STACKPROF
+        stackprof_update(active_thread);
 #endif
     }
 
-#ifdef MODULE_SCHEDSTATISTICS
-    schedstat *next_stat = &sched_pidlist[next_thread->pid];
-    next_stat->laststart = now;
-    next_stat->schedules++;
+#ifdef MODULE_SCHED_CB
     if (sched_cb) {
-        sched_cb(now, next_thread->pid);
+        sched_cb((active_thread == NULL) ? KERNEL_PID_UNDEF : active_thread->pid,
+                 next_thread->pid);
     }
 #endif
 
@@ -151,8 +142,8 @@ int __attribute__((used)) sched_run(void)
     return 1;
 }
 
-#ifdef MODULE_SCHEDSTATISTICS
-void sched_register_cb(void (*callback)(uint32_t, uint32_t))
+#ifdef MODULE_SCHED_CB
+void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
     sched_cb = callback;
 }
@@ -166,6 +157,9 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHED_RUNQ_CALLBACK
+            sched_runq_callback(process->priority);
+#endif
         }
     }
     else {
@@ -177,12 +171,51 @@ void sched_set_status(thread_t *process, unsigned int status)
             if (!sched_runqueues[process->priority].next) {
                 runqueue_bitcache &= ~(1 << process->priority);
             }
+#ifdef MODULE_SCHED_RUNQ_CALLBACK
+            sched_runq_callback(process->priority);
+#endif
         }
     }
 
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(thread && (priority < SCHED_PRIO_LEVELS));
+
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        DEBUG("sched_change_priority: moving thread %" PRIkernel_pid " from "
+              "runqueue %" PRIu16 " to %" PRIu16 ".\n",
+              thread->pid, (uint16_t)thread->priority, (uint16_t)priority);
+        clist_remove(&sched_runqueues[thread->priority], &(thread->rq_entry));
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        clist_rpush(&sched_runqueues[priority], &(thread->rq_entry));
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    uint8_t old_priority = thread->priority;
+    thread->priority = priority;
+#ifdef MODULE_SCHED_RUNQ_CALLBACK
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        sched_runq_callback(old_priority);
+        sched_runq_callback(priority);
+    }
+#else
+    (void)old_priority;
+#endif
+    irq_restore(irqstate);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -146,9 +146,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
         return -EINVAL;
     }
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_STACKPROF)
     int total_stacksize = stacksize;
-#else
+#endif
+#ifndef DEVELHELP
     (void) name;
 #endif
 
@@ -172,7 +173,12 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     /* allocate our thread control block at the top of our stackspace */
     thread_t *cb = (thread_t *) (stack + stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK)
+#ifdef MODULE_STACKPROF
+    /* the stack profiler relies on every stack being painted */
+    flags |= THREAD_CREATE_STACKTEST;
+#endif
+
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_STACKPROF)
     if (flags & THREAD_CREATE_STACKTEST) {
         /* assign each int of the stack the value of it's address */
         uintptr_t *stackmax = (uintptr_t *) (stack + stacksize);
@@ -211,15 +217,24 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->pid = pid;
     cb->sp = thread_stack_init(function, arg, stack, stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_STACKPROF)
     cb->stack_start = stack;
 #endif
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_STACKPROF)
     cb->stack_size = total_stacksize;
+#endif
+#ifdef DEVELHELP
     cb->name = name;
 #endif
 
+#ifdef MODULE_STACKPROF
+    /* start with the initial stack frame as only known usage */
+    cb->stack_hwm = (uintptr_t *)cb->sp;
+    cb->stack_scan = (uintptr_t *)stack;
+#endif
+
     cb->priority = priority;
     cb->status = 0;
 
@@ -231,6 +246,11 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cib_init(&(cb->msg_queue), 0);
     cb->msg_array = NULL;
 #endif
+#ifdef MODULE_CORE_MSG_STATS
+    cb->msg_queue_max = 0;
+    cb->msg_received = 0;
+    cb->msg_dropped = 0;
+#endif
 
     sched_num_threads++;
 
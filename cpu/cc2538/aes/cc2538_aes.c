@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       AES engine backend for sys/crypto
+ *
+ * The engine works on the key stored in the cipher context by aes_init(), so
+ * the software implementation is used whenever the engine is busy, e.g. when
+ * called from an interrupt while a thread uses it, or when it fails. Its DMA
+ * only reads from and writes to SRAM, data elsewhere is processed in software
+ * as well.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/helper.h"
+#include "cc2538_crypto.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define KEY_STORE_SIZE_128          (1)
+#define KEY_STORE_READ_AREA_BUSY    (1UL << 31)
+#define KEY_AREA                    (0)
+
+#define AES_CTRL_DIRECTION_ENCRYPT  (1 << 2)
+#define AES_CTRL_CBC                (1 << 5)
+#define AES_CTRL_CTR                (1 << 6)
+#define AES_CTRL_CTR_WIDTH_POS      (7)
+
+/* key in the key store, also 4 byte aligned for the DMA */
+static uint32_t _key[AES_KEY_SIZE / sizeof(uint32_t)];
+static bool _key_loaded;
+
+static bool _load_key(const cipher_context_t *ctx)
+{
+    if (_key_loaded && (memcmp(_key, ctx->context, sizeof(_key)) == 0)) {
+        return true;
+    }
+    memcpy(_key, ctx->context, sizeof(_key));
+    _key_loaded = false;
+
+    AES_CTRL_ALG_SEL = CC2538_CRYPTO_ALG_SEL_KEYSTORE;
+    AES_CTRL_INT_CLR = CC2538_CRYPTO_INT_RESULT_AV | CC2538_CRYPTO_INT_DMA_IN_DONE;
+    AES_KEY_STORE_SIZE = KEY_STORE_SIZE_128;
+    /* a written area has to be cleared before it can take a new key */
+    AES_KEY_STORE_WRITTEN_AREA = (1 << KEY_AREA);
+    AES_KEY_STORE_WRITE_AREA = (1 << KEY_AREA);
+    AES_DMAC_CH0_CTRL = CC2538_CRYPTO_DMAC_CH_CTRL_EN;
+    AES_DMAC_CH0_EXTADDR = (uint32_t)_key;
+    AES_DMAC_CH0_DMALENGTH = sizeof(_key);
+    if (!cc2538_crypto_wait() ||
+        !(AES_KEY_STORE_WRITTEN_AREA & (1 << KEY_AREA))) {
+        return false;
+    }
+    _key_loaded = true;
+    return true;
+}
+
+/* runs one operation on the engine, the lock must be held */
+static bool _crypt(const cipher_context_t *ctx, uint32_t ctrl,
+                   const uint8_t *iv, const uint8_t *input, size_t length,
+                   uint8_t *output)
+{
+    cc2538_crypto_enable();
+    if (!_load_key(ctx)) {
+        return false;
+    }
+
+    AES_CTRL_ALG_SEL = CC2538_CRYPTO_ALG_SEL_AES;
+    AES_CTRL_INT_CLR = CC2538_CRYPTO_INT_RESULT_AV | CC2538_CRYPTO_INT_DMA_IN_DONE;
+    AES_KEY_STORE_READ_AREA = KEY_AREA;
+    while (AES_KEY_STORE_READ_AREA & KEY_STORE_READ_AREA_BUSY) {}
+    if (AES_CTRL_INT_STAT & CC2538_CRYPTO_INT_KEY_ST_RD_ERR) {
+        AES_CTRL_INT_CLR = CC2538_CRYPTO_INT_KEY_ST_RD_ERR;
+        AES_CTRL_ALG_SEL = 0;
+        _key_loaded = false;
+        return false;
+    }
+    if (iv != NULL) {
+        uint32_t w[AES_BLOCK_SIZE / sizeof(uint32_t)];
+
+        memcpy(w, iv, sizeof(w));
+        AES_AES_IV_0 = w[0];
+        AES_AES_IV_1 = w[1];
+        AES_AES_IV_2 = w[2];
+        AES_AES_IV_3 = w[3];
+    }
+    AES_AES_CTRL = ctrl;
+    AES_AES_C_LENGTH_0 = length;
+    AES_AES_C_LENGTH_1 = 0;
+    AES_DMAC_CH0_CTRL = CC2538_CRYPTO_DMAC_CH_CTRL_EN;
+    AES_DMAC_CH0_EXTADDR = (uint32_t)input;
+    AES_DMAC_CH0_DMALENGTH = length;
+    AES_DMAC_CH1_CTRL = CC2538_CRYPTO_DMAC_CH_CTRL_EN;
+    AES_DMAC_CH1_EXTADDR = (uint32_t)output;
+    AES_DMAC_CH1_DMALENGTH = length;
+    return cc2538_crypto_wait();
+}
+
+static int _encrypt(const cipher_context_t *ctx, const uint8_t *plain_block,
+                    uint8_t *cipher_block)
+{
+    if (cc2538_crypto_in_sram(plain_block) && cc2538_crypto_in_sram(cipher_block) &&
+        mutex_trylock(&cc2538_crypto_lock)) {
+        bool done = _crypt(ctx, AES_CTRL_DIRECTION_ENCRYPT, NULL, plain_block,
+                           AES_BLOCK_SIZE, cipher_block);
+
+        mutex_unlock(&cc2538_crypto_lock);
+        if (done) {
+            return 1;
+        }
+    }
+    return aes_encrypt(ctx, plain_block, cipher_block);
+}
+
+static int _decrypt(const cipher_context_t *ctx, const uint8_t *cipher_block,
+                    uint8_t *plain_block)
+{
+    if (cc2538_crypto_in_sram(cipher_block) && cc2538_crypto_in_sram(plain_block) &&
+        mutex_trylock(&cc2538_crypto_lock)) {
+        bool done = _crypt(ctx, 0, NULL, cipher_block, AES_BLOCK_SIZE,
+                           plain_block);
+
+        mutex_unlock(&cc2538_crypto_lock);
+        if (done) {
+            return 1;
+        }
+    }
+    return aes_decrypt(ctx, cipher_block, plain_block);
+}
+
+static int _process(const cipher_context_t *ctx, cipher_mode_t mode,
+                    int encrypt, uint8_t *iv, uint8_t nonce_len,
+                    const uint8_t *input, size_t length, uint8_t *output)
+{
+    uint32_t ctrl = encrypt ? AES_CTRL_DIRECTION_ENCRYPT : 0;
+    unsigned ctr_len = AES_BLOCK_SIZE - nonce_len;
+    bool done;
+
+    if ((length == 0) || (length > CC2538_CRYPTO_DMA_LENGTH_MAX) ||
+        !cc2538_crypto_in_sram(input) || !cc2538_crypto_in_sram(output)) {
+        return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    switch (mode) {
+        case CIPHER_MODE_ECB:
+            iv = NULL;
+            break;
+        case CIPHER_MODE_CBC:
+            ctrl |= AES_CTRL_CBC;
+            break;
+        case CIPHER_MODE_CTR:
+            /* the engine counts in 32, 64, 96 or 128 bits */
+            if ((nonce_len > AES_BLOCK_SIZE - 4) || (ctr_len % 4)) {
+                return CIPHER_ERR_NOT_SUPPORTED;
+            }
+            ctrl = AES_CTRL_DIRECTION_ENCRYPT | AES_CTRL_CTR |
+                   (((ctr_len / 4) - 1) << AES_CTRL_CTR_WIDTH_POS);
+            break;
+        default:
+            return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    if (!mutex_trylock(&cc2538_crypto_lock)) {
+        return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    done = _crypt(ctx, ctrl, iv, input, length, output);
+    mutex_unlock(&cc2538_crypto_lock);
+    if (!done) {
+        return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    if (mode == CIPHER_MODE_CTR) {
+        /* the counter of the next block, like the software mode leaves it */
+        for (size_t i = 0; i < length; i += AES_BLOCK_SIZE) {
+            crypto_block_inc_ctr(iv, ctr_len);
+        }
+    }
+    return length;
+}
+
+const cipher_interface_t aes_hw_interface = {
+    .block_size = AES_BLOCK_SIZE,
+    .max_key_size = AES_KEY_SIZE,
+    .init = aes_init,
+    .encrypt = _encrypt,
+    .decrypt = _decrypt,
+    .process = _process,
+};
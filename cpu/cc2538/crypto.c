@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       Shared access to the security core
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "cc2538_crypto.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* security module bit in SYS_CTRL_xCGCSEC and SYS_CTRL_SRSEC */
+#define SEC_AES                     (1 << 1)
+
+mutex_t cc2538_crypto_lock = MUTEX_INIT;
+static bool _enabled;
+
+void cc2538_crypto_enable(void)
+{
+    if (_enabled) {
+        return;
+    }
+    SYS_CTRL_RCGCSEC |= SEC_AES;
+    SYS_CTRL_SCGCSEC |= SEC_AES;
+    SYS_CTRL_DCGCSEC |= SEC_AES;
+    SYS_CTRL_SRSEC |= SEC_AES;
+    SYS_CTRL_SRSEC &= ~SEC_AES;
+    /* the status is polled, which requires level interrupts */
+    AES_CTRL_INT_CFG = 1;
+    AES_CTRL_INT_EN = CC2538_CRYPTO_INT_RESULT_AV |
+                      CC2538_CRYPTO_INT_DMA_IN_DONE;
+    _enabled = true;
+}
+
+bool cc2538_crypto_wait(void)
+{
+    uint32_t stat;
+
+    while (!((stat = AES_CTRL_INT_STAT) &
+             (CC2538_CRYPTO_INT_RESULT_AV | CC2538_CRYPTO_INT_ERRORS))) {}
+    AES_CTRL_INT_CLR = CC2538_CRYPTO_INT_RESULT_AV |
+                       CC2538_CRYPTO_INT_DMA_IN_DONE |
+                       CC2538_CRYPTO_INT_ERRORS;
+    AES_CTRL_ALG_SEL = 0;
+    if (stat & CC2538_CRYPTO_INT_ERRORS) {
+        DEBUG("cc2538_crypto: error 0x%08lx\n", (unsigned long)stat);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       Shared access to the AES and hash engines of the security core
+ *
+ * Both engines share the DMA, the interrupt status and the clock of the
+ * security core, so only one operation may run at a time.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef CC2538_CRYPTO_H
+#define CC2538_CRYPTO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    AES_CTRL_ALG_SEL bits
+ * @{
+ */
+#define CC2538_CRYPTO_ALG_SEL_KEYSTORE  (1 << 0)
+#define CC2538_CRYPTO_ALG_SEL_AES       (1 << 1)
+#define CC2538_CRYPTO_ALG_SEL_HASH      (1 << 2)
+/** @} */
+
+/**
+ * @name    AES_CTRL_INT_* bits
+ * @{
+ */
+#define CC2538_CRYPTO_INT_RESULT_AV     (1 << 0)
+#define CC2538_CRYPTO_INT_DMA_IN_DONE   (1 << 1)
+#define CC2538_CRYPTO_INT_KEY_ST_RD_ERR (1 << 29)
+#define CC2538_CRYPTO_INT_KEY_ST_WR_ERR (1 << 30)
+#define CC2538_CRYPTO_INT_DMA_BUS_ERR   (1UL << 31)
+#define CC2538_CRYPTO_INT_ERRORS        (CC2538_CRYPTO_INT_KEY_ST_RD_ERR | \
+                                         CC2538_CRYPTO_INT_KEY_ST_WR_ERR | \
+                                         CC2538_CRYPTO_INT_DMA_BUS_ERR)
+/** @} */
+
+#define CC2538_CRYPTO_DMAC_CH_CTRL_EN   (1 << 0)    /**< DMA channel enable */
+#define CC2538_CRYPTO_DMA_LENGTH_MAX    (0xffff)    /**< maximum DMA length */
+
+/**
+ * @brief   Lock of the security core, taken with mutex_trylock() so the
+ *          callers can fall back to software when it is busy
+ */
+extern mutex_t cc2538_crypto_lock;
+
+/**
+ * @brief   Checks if the DMA of the security core can access @p p
+ *
+ * @param[in] p an address
+ *
+ * @return  true, if @p p is in SRAM.
+ */
+static inline bool cc2538_crypto_in_sram(const void *p)
+{
+    return ((uintptr_t)p >> 28) == 0x2;
+}
+
+/**
+ * @brief   Enables the security core, if that was not done before
+ *
+ * @pre @ref cc2538_crypto_lock is held.
+ */
+void cc2538_crypto_enable(void);
+
+/**
+ * @brief   Waits for the current operation of the security core
+ *
+ * Clears the interrupt status and the algorithm selection afterwards.
+ *
+ * @pre @ref cc2538_crypto_lock is held.
+ *
+ * @return  true, if the operation completed without errors.
+ */
+bool cc2538_crypto_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC2538_CRYPTO_H */
+/** @} */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       Hash engine backend for sys/hashes/sha256
+ *
+ * Blocks are compressed into the intermediate hash value of the context,
+ * which is loaded into the digest registers for every operation, so the
+ * padding is still done in software. The DMA only reads from SRAM, blocks
+ * elsewhere, e.g. a firmware image in flash, are copied to a buffer in SRAM
+ * first. The software implementation is used while the security core is
+ * busy and when it fails.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "hashes/sha256.h"
+#include "cc2538_crypto.h"
+
+#define HASH_MODE_IN_SHA256     (1 << 3)
+
+/* number of blocks in a DMA operation from SRAM */
+#define DMA_BLOCKS_MAX          (CC2538_CRYPTO_DMA_LENGTH_MAX / \
+                                 SHA256_INTERNAL_BLOCK_SIZE)
+
+/**
+ * @brief   Number of blocks buffered in SRAM for data elsewhere
+ */
+#ifndef CC2538_SHA256_BUF_BLOCKS
+#define CC2538_SHA256_BUF_BLOCKS    (4U)
+#endif
+
+static uint32_t _buf[(CC2538_SHA256_BUF_BLOCKS * SHA256_INTERNAL_BLOCK_SIZE) /
+                     sizeof(uint32_t)];
+
+/* compresses numof blocks from SRAM, the lock must be held */
+static bool _hash(uint32_t *state, const void *blocks, size_t numof)
+{
+    AES_CTRL_ALG_SEL = CC2538_CRYPTO_ALG_SEL_HASH;
+    AES_CTRL_INT_CLR = CC2538_CRYPTO_INT_RESULT_AV |
+                       CC2538_CRYPTO_INT_DMA_IN_DONE;
+    /* continue from the intermediate hash value instead of a new hash */
+    AES_HASH_MODE_IN = HASH_MODE_IN_SHA256;
+    AES_HASH_DIGEST_A = state[0];
+    AES_HASH_DIGEST_B = state[1];
+    AES_HASH_DIGEST_C = state[2];
+    AES_HASH_DIGEST_D = state[3];
+    AES_HASH_DIGEST_E = state[4];
+    AES_HASH_DIGEST_F = state[5];
+    AES_HASH_DIGEST_G = state[6];
+    AES_HASH_DIGEST_H = state[7];
+    AES_DMAC_CH0_CTRL = CC2538_CRYPTO_DMAC_CH_CTRL_EN;
+    AES_DMAC_CH0_EXTADDR = (uint32_t)blocks;
+    AES_DMAC_CH0_DMALENGTH = numof * SHA256_INTERNAL_BLOCK_SIZE;
+    if (!cc2538_crypto_wait()) {
+        return false;
+    }
+    state[0] = AES_HASH_DIGEST_A;
+    state[1] = AES_HASH_DIGEST_B;
+    state[2] = AES_HASH_DIGEST_C;
+    state[3] = AES_HASH_DIGEST_D;
+    state[4] = AES_HASH_DIGEST_E;
+    state[5] = AES_HASH_DIGEST_F;
+    state[6] = AES_HASH_DIGEST_G;
+    state[7] = AES_HASH_DIGEST_H;
+    return true;
+}
+
+size_t sha256_hw_transform(uint32_t *state, const void *blocks, size_t numof)
+{
+    const uint8_t *src = blocks;
+    size_t done = 0;
+
+    if ((numof == 0) || !mutex_trylock(&cc2538_crypto_lock)) {
+        return 0;
+    }
+    cc2538_crypto_enable();
+    while (done < numof) {
+        const void *in = src;
+        size_t n = numof - done;
+
+        if (cc2538_crypto_in_sram(src)) {
+            n = (n > DMA_BLOCKS_MAX) ? DMA_BLOCKS_MAX : n;
+        }
+        else {
+            n = (n > CC2538_SHA256_BUF_BLOCKS) ? CC2538_SHA256_BUF_BLOCKS : n;
+            memcpy(_buf, src, n * SHA256_INTERNAL_BLOCK_SIZE);
+            in = _buf;
+        }
+        if (!_hash(state, in, n)) {
+            break;
+        }
+        src += n * SHA256_INTERNAL_BLOCK_SIZE;
+        done += n;
+    }
+    mutex_unlock(&cc2538_crypto_lock);
+    return done;
+}
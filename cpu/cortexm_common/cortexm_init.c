@@ -37,6 +37,9 @@ void cortexm_init(void)
 #if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
     /* give full access to the FPU */
     SCB->CPACR |= (uint32_t)FULL_FPU_ACCESS;
+    /* make sure automatic and lazy FPU state preservation is enabled, the
+     * context switch relies on it */
+    FPU->FPCCR |= (FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk);
 #endif
 
     /* configure the vector table location to internal flash */
@@ -24,6 +24,10 @@
 #include "cpu.h"
 #include "periph/pm.h"
 
+#ifdef MODULE_PM_LAYERED_STATS
+#include "pm_layered.h"
+#endif
+
 #ifndef FEATURE_PERIPH_PM
 void pm_set_lowest(void)
 {
@@ -31,6 +35,14 @@ void pm_set_lowest(void)
 }
 #endif
 
+#ifdef MODULE_PM_LAYERED_STATS
+unsigned pm_layered_wakeup_source(void)
+{
+    /* with interrupts disabled, the waking exception is still pending */
+    return (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+}
+#endif
+
 void pm_reboot(void)
 {
     NVIC_SystemReset();
@@ -82,7 +82,28 @@
  * | RET  | <- exception return code
  * -------- lowest address (top of stack)
  *
- * TODO: Implement handling of FPU registers for Cortex-M4 CPUs
+ * On the Cortex-M4F and Cortex-M7 the FPU context is saved lazily. The
+ * hardware reserves space for S0-S15 and FPSCR in the exception stack frame
+ * of threads that have used the FPU (signalled by bit 4 of the exception
+ * return code being cleared), but only writes them once another context
+ * touches the FPU. For those threads the context switch additionally saves
+ * S16-S31 between R4 and RET:
+ *
+ * ------------- highest address (bottom of stack)
+ * | FPSCR     |
+ * -------------
+ * | S15 - S0  | <- reserved by hardware, written lazily
+ * -------------
+ * | xPSR - R0 | <- same as for Cortex-M3/4
+ * -------------
+ * | R11 - R4  |
+ * -------------
+ * | S31 - S16 | <- only present if bit 4 of RET is cleared
+ * -------------
+ * | RET       | <- exception return code
+ * ------------- lowest address (top of stack)
+ *
+ * Threads that never use the FPU pay no extra cost on a context switch.
  *
  *
  * @author      Stefan Pfeiffer <stefan.pfeiffer@fu-berlin.de>
@@ -149,21 +170,10 @@ char *thread_arch_stack_init(thread_task_func_t task_func,
         *stk = ~((uint32_t)STACK_MARKER);
     }
 
-#if defined(CPU_ARCH_CORTEX_M4F) || (CPU_ARCH_CORTEX_M7)
-    /* TODO: fix FPU handling for Cortex-M4f */
-    /*
-    stk--;
-    *stk = (unsigned int) 0;
-    */
-
-    /* S0 - S15 */
-    /*
-    for (int i = 15; i >= 0; i--) {
-        stk--;
-        *stk = i;
-    }
-    */
-#endif
+    /* Newly created threads start without an FPU context: the initial
+     * exception return value (EXCEPT_RET_TASK_MODE) selects the basic stack
+     * frame. The hardware switches to the extended frame once the thread
+     * executes its first FPU instruction. */
 
     /* ****************************** */
     /* Automatically popped registers */
@@ -319,10 +329,12 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     "mov    sp, r12                   \n"
 #else
     "stmdb  r0!,{r4-r11}              \n" /* save regs */
-    "stmdb  r0!,{lr}                  \n" /* exception return value */
 #if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
-/*  "vstmdb sp!, {s16-s31}            \n" */ /* TODO save FPU registers */
+    "tst    lr, #0x10                 \n" /* was the FPU used by the thread? */
+    "it     eq                        \n"
+    "vstmdbeq r0!, {s16-s31}          \n" /* if so, save FPU registers */
 #endif
+    "stmdb  r0!,{lr}                  \n" /* exception return value */
 #endif
     "ldr    r1, =sched_active_thread  \n" /* load address of current tcb */
     "ldr    r1, [r1]                  \n" /* dereference pdc */
@@ -366,7 +378,9 @@ void __attribute__((naked)) __attribute__((used)) isr_svc(void) {
     "ldr    r1, [r0]                  \n" /* load tcb->sp to register 1 */
     "ldmia  r1!, {r0}                 \n" /* restore exception return value */
 #if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
-/*  "pop    {s16-s31}                 \n" */ /* TODO load FPU registers */
+    "tst    r0, #0x10                 \n" /* does the thread use the FPU? */
+    "it     eq                        \n"
+    "vldmiaeq r1!, {s16-s31}          \n" /* if so, restore FPU registers */
 #endif
     "ldmia  r1!, {r4-r11}             \n" /* restore other registers */
     "msr    psp, r1                   \n" /* restore user mode SP to PSP reg */
@@ -30,6 +30,7 @@
 #include "board.h"
 #include "mpu.h"
 #include "panic.h"
+#include "sched.h"
 #include "vectors_cortexm.h"
 
 #ifndef SRAM_BASE
@@ -343,8 +344,46 @@ void hard_fault_default(void)
 
 #if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
     defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+#ifdef MODULE_MPU_STACK_GUARD
+/**
+ * @name    MemManage fault status bits in SCB->CFSR
+ * @{
+ */
+#define MMFSR_MSTKERR           (0x10)  /**< fault while stacking on exception
+                                         *   entry */
+#define MMFSR_MMARVALID         (0x80)  /**< SCB->MMFAR holds the fault
+                                         *   address */
+/** @} */
+
+/**
+ * @brief   Check if a MemManage fault was caused by the stack guard of the
+ *          active thread
+ */
+static int _thread_stack_overflow(void)
+{
+    uint32_t mmfsr = SCB->CFSR & 0xff;
+    uintptr_t start = (uintptr_t)sched_active_thread->stack_start;
+    /* same rounding as the guard region configured in sched_run() */
+    uintptr_t guard = (start + 31) & ~31;
+
+    if (mmfsr & MMFSR_MSTKERR) {
+        /* the exception frame (up to 26 words with FPU state) did not fit
+         * onto the remaining thread stack */
+        uintptr_t psp = __get_PSP();
+        return (psp >= start) && (psp < guard + 32 + (26 * 4));
+    }
+    return (mmfsr & MMFSR_MMARVALID) && ((SCB->MMFAR - guard) < 32);
+}
+#endif
+
 void mem_manage_default(void)
 {
+#ifdef MODULE_MPU_STACK_GUARD
+    if (sched_active_thread && _thread_stack_overflow()) {
+        printf("stack overflow in thread %" PRIkernel_pid "\n", sched_active_pid);
+        core_panic(PANIC_MEM_MANAGE, "STACK OVERFLOW");
+    }
+#endif
     core_panic(PANIC_MEM_MANAGE, "MEM MANAGE HANDLER");
 }
 
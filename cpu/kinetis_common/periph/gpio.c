@@ -285,6 +285,27 @@ void gpio_write(gpio_t pin, int value)
     }
 }
 
+gpio_port_t gpio_port(gpio_t pin)
+{
+    return (gpio_port_t)gpio(pin);
+}
+
+uint32_t gpio_port_pin_mask(gpio_t pin)
+{
+    return (1 << pin_num(pin));
+}
+
+uint32_t gpio_port_read(gpio_port_t p)
+{
+    return ((GPIO_Type *)p)->PDIR;
+}
+
+void gpio_port_write_masked(gpio_port_t p, uint32_t mask, uint32_t value)
+{
+    ((GPIO_Type *)p)->PSOR = (value & mask);
+    ((GPIO_Type *)p)->PCOR = (~value & mask);
+}
+
 static inline void irq_handler(PORT_Type *port, int port_num)
 {
     /* take interrupt flags only from pins which interrupt is enabled */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     netdev
+ * @brief       Emulated IEEE 802.15.4 radio for native
+ *
+ * The device exchanges frames with the medium emulator in
+ * `dist/tools/medium` over a UNIX datagram socket. The medium delivers
+ * them to the neighbors of the sending node given by its topology file, with
+ * the configured loss, delay, bandwidth and RSSI of each link.
+ *
+ * Nodes are identified by the instance id given with `-i <id>`, which also
+ * sets their short address and the last two bytes of their long address, so
+ * the topology file refers to the same nodes across restarts. The socket of
+ * the medium is given with `-z <path>`.
+ *
+ * Frames are sent without FCS and the device does not emulate link layer
+ * acknowledgements: a sent frame is reported as complete right away.
+ * @{
+ *
+ * @file
+ * @brief       Definitions of the native medium netdev
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+#ifndef NETDEV_MEDIUM_H
+#define NETDEV_MEDIUM_H
+
+#include <stdint.h>
+#include <sys/un.h>
+
+#include "net/ieee802154.h"
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default path of the medium's socket
+ */
+#ifndef NETDEV_MEDIUM_DEFAULT_PATH
+#define NETDEV_MEDIUM_DEFAULT_PATH  "/tmp/riot-medium"
+#endif
+
+/**
+ * @brief   Maximum number of frames handled per SIGIO
+ */
+#ifndef NETDEV_MEDIUM_RX_BATCH
+#define NETDEV_MEDIUM_RX_BATCH      (16U)
+#endif
+
+/**
+ * @brief   Header of the datagrams exchanged with the medium
+ *
+ * Followed by the frame. A datagram without a frame registers the node with
+ * the medium.
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t id;            /**< sending node, network byte order */
+    uint8_t chan;           /**< channel of the sender */
+    int8_t rssi;            /**< RSSI in dBm, set by the medium */
+    uint8_t lqi;            /**< LQI, set by the medium */
+    uint8_t reserved;       /**< reserved, 0 */
+} netdev_medium_hdr_t;
+
+/**
+ * @brief   Device descriptor of the native medium netdev
+ */
+typedef struct {
+    netdev_ieee802154_t netdev;             /**< netdev parent struct */
+    const char *path;                       /**< path of the medium's socket */
+    int sock;                               /**< socket to the medium */
+    uint8_t promiscuous;                    /**< promiscuous mode */
+    uint16_t rx_len;                        /**< length of the frame in
+                                             *   netdev_medium_t::rx_buf */
+    netdev_medium_hdr_t rx_hdr;             /**< header of the received frame */
+    uint8_t rx_buf[IEEE802154_FRAME_LEN_MAX];   /**< received frame */
+} netdev_medium_t;
+
+/**
+ * @brief   Initialization parameters of the native medium netdev
+ */
+typedef struct {
+    const char *path;       /**< path of the medium's socket, set on startup */
+} netdev_medium_params_t;
+
+/**
+ * @brief   Setup a native medium netdev
+ *
+ * @param[out] dev      device descriptor
+ * @param[in] params    initialization parameters
+ */
+void netdev_medium_setup(netdev_medium_t *dev,
+                         const netdev_medium_params_t *params);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */
+#endif /* NETDEV_MEDIUM_H */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     netdev
+ * @{
+ *
+ * @file
+ * @brief       Default configuration for the native medium netdev
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+#ifndef NETDEV_MEDIUM_PARAMS_H
+#define NETDEV_MEDIUM_PARAMS_H
+
+#include "netdev_medium.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Configuration parameters for @ref netdev_medium_t
+ *
+ * There is only one device, as all devices of a node would share its id.
+ *
+ * @note    This variable is set on native start-up based on arguments provided
+ */
+extern netdev_medium_params_t netdev_medium_params;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETDEV_MEDIUM_PARAMS_H */
+/** @} */
@@ -35,6 +35,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames handled per SIGIO
+ *
+ * Frames that arrive faster are handled after the next signal, so other
+ * events of the device are not starved.
+ */
+#ifndef NETDEV_TAP_RX_BATCH
+#define NETDEV_TAP_RX_BATCH     (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
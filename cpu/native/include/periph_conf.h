@@ -54,12 +54,19 @@
  */
 #define XTIMER_OVERHEAD 14
 
+#ifdef __MACH__
 /* timer_set_absolute() has a high margin for possible underflow if set with
  * value not far in the future. To prevent this, we set high backoff values
  * here.
  */
 #define XTIMER_BACKOFF      200
 #define XTIMER_ISR_BACKOFF  200
+#else
+/* the timer is set to absolute deadlines, so only the latency of the host
+ * needs to be covered */
+#define XTIMER_BACKOFF      50
+#define XTIMER_ISR_BACKOFF  50
+#endif
 
 /** @} */
 
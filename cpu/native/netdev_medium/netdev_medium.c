@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/*
+ * @ingroup netdev
+ * @{
+ * @brief   Emulated IEEE 802.15.4 radio, connected to the medium emulator
+ * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* needs to be included before native's declarations of ntohl etc. */
+#include "byteorder.h"
+
+#include "native_internal.h"
+
+#include "async_read.h"
+
+#include "net/ieee802154.h"
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+#include "net/netopt.h"
+#include "netdev_medium.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _MAX_MHR_OVERHEAD   (IEEE802154_MAX_HDR_LEN)
+
+/* netdev interface */
+static void _isr(netdev_t *netdev);
+static int _init(netdev_t *netdev);
+static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n);
+static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len);
+static int _set(netdev_t *netdev, netopt_t opt, void *value, size_t value_len);
+
+static const netdev_driver_t netdev_driver_medium = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static ssize_t _write(netdev_medium_t *dev, const uint8_t *frame, size_t len)
+{
+    uint8_t buf[sizeof(netdev_medium_hdr_t) + IEEE802154_FRAME_LEN_MAX];
+    netdev_medium_hdr_t *hdr = (netdev_medium_hdr_t *)buf;
+    ssize_t res;
+
+    assert(len <= IEEE802154_FRAME_LEN_MAX);
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->id = byteorder_htonl((uint32_t)_native_id).u32;
+    hdr->chan = dev->netdev.chan;
+    if (len) {
+        memcpy(hdr + 1, frame, len);
+    }
+
+    _native_in_syscall++; /* no switching here */
+    res = real_write(dev->sock, buf, sizeof(*hdr) + len);
+    _native_in_syscall--;
+    if (res < 0) {
+        /* the medium is not running (yet), the frame is lost on the air */
+        DEBUG("netdev_medium: write: %s\n", strerror(errno));
+    }
+    return res;
+}
+
+/* reads the next datagram into the receive buffer */
+static int _read(netdev_medium_t *dev)
+{
+    uint8_t buf[sizeof(netdev_medium_hdr_t) + IEEE802154_FRAME_LEN_MAX];
+    ssize_t res;
+
+    _native_in_syscall++; /* no switching here */
+    res = real_read(dev->sock, buf, sizeof(buf));
+    _native_in_syscall--;
+    if (res < 0) {
+        return -1;
+    }
+    if ((size_t)res <= sizeof(netdev_medium_hdr_t)) {
+        /* nothing to receive, but there may be more */
+        dev->rx_len = 0;
+        return 0;
+    }
+    memcpy(&dev->rx_hdr, buf, sizeof(dev->rx_hdr));
+    dev->rx_len = res - sizeof(netdev_medium_hdr_t);
+    memcpy(dev->rx_buf, buf + sizeof(netdev_medium_hdr_t), dev->rx_len);
+    return dev->rx_len;
+}
+
+/* address filter of the emulated radio */
+static bool _accept(netdev_medium_t *dev)
+{
+    static const uint8_t bcast[] = IEEE802154_ADDR_BCAST;
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+    uint16_t pan;
+    size_t mhr_len;
+    int dst_len;
+
+    if (dev->promiscuous) {
+        return true;
+    }
+    mhr_len = ieee802154_get_frame_hdr_len(dev->rx_buf);
+    if ((mhr_len == 0) || (mhr_len > dev->rx_len)) {
+        return false;
+    }
+    dst_len = ieee802154_get_dst(dev->rx_buf, dst, &dst_pan);
+    if (dst_len <= 0) {
+        /* no destination, i.e. sent to the PAN coordinator */
+        return (dst_len == 0);
+    }
+    pan = byteorder_ntohs(byteorder_ltobs(dst_pan));
+    if ((pan != dev->netdev.pan) && (pan != 0xffff)) {
+        return false;
+    }
+    if (dst_len == IEEE802154_SHORT_ADDRESS_LEN) {
+        return (memcmp(dst, bcast, sizeof(bcast)) == 0) ||
+               (memcmp(dst, dev->netdev.short_addr, dst_len) == 0);
+    }
+    return (memcmp(dst, dev->netdev.long_addr, dst_len) == 0);
+}
+
+static bool _rx_pending(netdev_medium_t *dev)
+{
+    fd_set rfds;
+    struct timeval t;
+    int res;
+
+    memset(&t, 0, sizeof(t));
+    FD_ZERO(&rfds);
+    FD_SET(dev->sock, &rfds);
+
+    _native_in_syscall++; /* no switching here */
+    res = real_select(dev->sock + 1, &rfds, NULL, NULL, &t);
+    _native_in_syscall--;
+
+    return (res == 1);
+}
+
+static void _continue_reading(netdev_medium_t *dev)
+{
+    /* work around lost signals, as netdev_tap does */
+    if (_rx_pending(dev)) {
+        int sig = SIGIO;
+
+        _native_in_syscall++; /* no switching here */
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+        _native_in_syscall--;
+    }
+    else {
+        native_async_read_continue(dev->sock);
+    }
+}
+
+static void _isr(netdev_t *netdev)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+    int res;
+
+    for (unsigned frames = 0; frames < NETDEV_MEDIUM_RX_BATCH; frames++) {
+        if ((res = _read(dev)) < 0) {
+            break;
+        }
+        if ((res > 0) && _accept(dev) && netdev->event_callback) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        }
+        dev->rx_len = 0;
+    }
+    _continue_reading(dev);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop the frame */
+            dev->rx_len = 0;
+            return 0;
+        }
+        return dev->rx_len;
+    }
+    if (len > dev->rx_len) {
+        len = dev->rx_len;
+    }
+    memcpy(buf, dev->rx_buf, len);
+    if (info != NULL) {
+        netdev_ieee802154_rx_info_t *rx_info = info;
+
+        rx_info->rssi = (uint8_t)dev->rx_hdr.rssi;
+        rx_info->lqi = dev->rx_hdr.lqi;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += len;
+#endif
+    dev->rx_len = 0;
+    return len;
+}
+
+static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+    size_t len = 0;
+
+    for (unsigned i = 0; i < n; i++) {
+        if ((len + vector[i].iov_len) > sizeof(frame)) {
+            return -EOVERFLOW;
+        }
+        memcpy(&frame[len], vector[i].iov_base, vector[i].iov_len);
+        len += vector[i].iov_len;
+    }
+    _write(dev, frame, len);
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+    }
+    return len;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+
+    switch (opt) {
+        case NETOPT_MAX_PACKET_SIZE:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX - _MAX_MHR_OVERHEAD;
+            return sizeof(uint16_t);
+        case NETOPT_STATE:
+            assert(max_len >= sizeof(netopt_state_t));
+            *((netopt_state_t *)value) = NETOPT_STATE_IDLE;
+            return sizeof(netopt_state_t);
+        case NETOPT_PROMISCUOUSMODE:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = dev->promiscuous ? NETOPT_ENABLE :
+                                                             NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        default:
+            return netdev_ieee802154_get(&dev->netdev, opt, value, max_len);
+    }
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, void *value, size_t value_len)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+    int res;
+
+    switch (opt) {
+        case NETOPT_CHANNEL:
+            assert(value_len == sizeof(uint16_t));
+            if (*((uint16_t *)value) > IEEE802154_CHANNEL_MAX) {
+                return -EINVAL;
+            }
+            res = netdev_ieee802154_set(&dev->netdev, opt, value, value_len);
+            /* let the medium know where to find the node */
+            _write(dev, NULL, 0);
+            return res;
+        case NETOPT_PROMISCUOUSMODE:
+            dev->promiscuous = (*((netopt_enable_t *)value) == NETOPT_ENABLE);
+            return sizeof(netopt_enable_t);
+        default:
+            return netdev_ieee802154_set(&dev->netdev, opt, value, value_len);
+    }
+}
+
+static void _sock_isr(int fd, void *arg)
+{
+    netdev_t *netdev = (netdev_t *)arg;
+
+    (void)fd;
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    }
+}
+
+void netdev_medium_setup(netdev_medium_t *dev,
+                         const netdev_medium_params_t *params)
+{
+    memset(dev, 0, sizeof(*dev));
+    dev->netdev.netdev.driver = &netdev_driver_medium;
+    dev->path = params->path;
+    dev->sock = -1;
+}
+
+static int _init(netdev_t *netdev)
+{
+    netdev_medium_t *dev = (netdev_medium_t *)netdev;
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    uint16_t id = (uint16_t)_native_id;
+
+    /* the node's addresses follow from its id */
+    dev->netdev.long_addr[0] = 0x02;
+    dev->netdev.long_addr[6] = (uint8_t)(id >> 8);
+    dev->netdev.long_addr[7] = (uint8_t)id;
+    dev->netdev.short_addr[0] = (uint8_t)(id >> 8);
+    dev->netdev.short_addr[1] = (uint8_t)id;
+    dev->netdev.pan = IEEE802154_DEFAULT_PANID;
+    dev->netdev.chan = IEEE802154_DEFAULT_CHANNEL;
+    dev->netdev.flags = NETDEV_IEEE802154_SRC_MODE_LONG;
+#ifdef MODULE_GNRC_SIXLOWPAN
+    dev->netdev.proto = GNRC_NETTYPE_SIXLOWPAN;
+#elif MODULE_GNRC
+    dev->netdev.proto = GNRC_NETTYPE_UNDEF;
+#endif
+
+    if ((dev->sock = real_socket(AF_UNIX, SOCK_DGRAM, 0)) < 0) {
+        err(EXIT_FAILURE, "netdev_medium: socket");
+    }
+    /* the medium replies to this node's own socket */
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s.%u", dev->path,
+             (unsigned)_native_id);
+    real_unlink(addr.sun_path);
+    if (real_bind(dev->sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        err(EXIT_FAILURE, "netdev_medium: bind(%s)", addr.sun_path);
+    }
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", dev->path);
+    _native_in_syscall++; /* no switching here */
+    if (connect(dev->sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        warn("netdev_medium: connect(%s), is the medium running?", dev->path);
+        real_exit(EXIT_FAILURE);
+    }
+    _native_in_syscall--;
+
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock, netdev, _sock_isr);
+
+    /* register with the medium */
+    _write(dev, NULL, 0);
+
+#ifdef MODULE_NETSTATS_L2
+    memset(&netdev->stats, 0, sizeof(netstats_t));
+#endif
+    DEBUG("netdev_medium: node %u initialized\n", (unsigned)_native_id);
+    return 0;
+}
@@ -63,6 +63,7 @@
 #include "debug.h"
 
 /* netdev interface */
+static void _isr(netdev_t *netdev);
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
@@ -92,18 +93,6 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev_t *netdev)
-{
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
-#if DEVELHELP
-    else {
-        puts("netdev_tap: _isr(): no event_callback set.");
-    }
-#endif
-}
-
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
 {
     int res = 0;
@@ -173,31 +162,62 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
+static bool _rx_pending(netdev_tap_t *dev)
 {
-    /* work around lost signals */
     fd_set rfds;
     struct timeval t;
+    int res;
+
     memset(&t, 0, sizeof(t));
     FD_ZERO(&rfds);
     FD_SET(dev->tap_fd, &rfds);
 
     _native_in_syscall++; /* no switching here */
+    res = real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t);
+    _native_in_syscall--;
+
+    return (res == 1);
+}
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+static void _continue_reading(netdev_tap_t *dev)
+{
+    /* work around lost signals */
+    if (_rx_pending(dev)) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
+
+        _native_in_syscall++; /* no switching here */
         real_write(_sig_pipefd[1], &sig, sizeof(int));
         _native_sigpend++;
+        _native_in_syscall--;
         DEBUG("netdev_tap: sigpend++\n");
     }
     else {
         DEBUG("netdev_tap: native_async_read_continue\n");
         native_async_read_continue(dev->tap_fd);
     }
+}
 
-    _native_in_syscall--;
+static void _isr(netdev_t *netdev)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    unsigned frames = 0;
+
+    if (!netdev->event_callback) {
+#if DEVELHELP
+        puts("netdev_tap: _isr(): no event_callback set.");
+#endif
+        return;
+    }
+    /* drain the frames that arrived since the signal in one go instead of
+     * raising another signal for every single one of them */
+    do {
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    } while ((++frames < NETDEV_TAP_RX_BATCH) && _rx_pending(dev));
+    DEBUG("netdev_tap: handled %u frames\n", frames);
+    /* frames beyond the batch are handled after the next signal */
+    _continue_reading(dev);
 }
 
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
@@ -221,8 +241,6 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             static uint8_t buf[ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, buf, sizeof(buf));
-
-            _continue_reading(dev);
         }
 
         /* no way of figuring out packet size without racey buffering,
@@ -243,13 +261,9 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
-            native_async_read_continue(dev->tap_fd);
-
             return 0;
         }
 
-        _continue_reading(dev);
-
 #ifdef MODULE_NETSTATS_L2
         netdev->stats.rx_count++;
         netdev->stats.rx_bytes += nread;
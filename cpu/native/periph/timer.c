@@ -15,7 +15,17 @@
  * @file
  * @brief       Native CPU periph/timer.h implementation
  *
- * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
+ * Uses the POSIX monotonic clock and a POSIX per-process timer to mimic
+ * hardware. Targets are set as absolute deadlines of the clock timer_read()
+ * reads with nanosecond resolution, so no time is lost between reading the
+ * timer and setting it. The timer expires by SIGALRM like before, so there is
+ * a single dispatch path through native's interrupt emulation.
+ *
+ * timerfd is not used, as it does not signal its expiry, and a thread waiting
+ * in clock_nanosleep() would have to signal the process all the same.
+ *
+ * OS X does not have POSIX timers and still uses the relative itimer, with a
+ * minimum offset of NATIVE_TIMER_MIN_RES.
  *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
@@ -53,20 +63,52 @@
 
 #define NATIVE_TIMER_SPEED 1000000
 
-static unsigned long time_null;
+static uint64_t time_null;
 
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifdef __MACH__
 static struct itimerval itv;
+#else
+static timer_t _timer;
+static int _timer_created;
+#endif
 
 /**
  * returns ticks for give timespec
  */
-static unsigned long ts2ticks(struct timespec *tp)
+static uint64_t ts2ticks(struct timespec *tp)
 {
-    /* TODO: check for overflow */
-    return((tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
+    return (((uint64_t)tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
+}
+
+/**
+ * returns the ticks of the monotonic clock, not wrapped to 32 bit
+ */
+static uint64_t _native_ticks(void)
+{
+    struct timespec t;
+
+    _native_syscall_enter();
+#ifdef __MACH__
+    clock_serv_t cclock;
+    mach_timespec_t mts;
+    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
+    clock_get_time(cclock, &mts);
+    mach_port_deallocate(mach_task_self(), cclock);
+    t.tv_sec = mts.tv_sec;
+    t.tv_nsec = mts.tv_nsec;
+#else
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "timer_read: clock_gettime");
+    }
+
+#endif
+    _native_syscall_leave();
+
+    return ts2ticks(&t);
 }
 
 /**
@@ -93,8 +135,7 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
     }
 
     /* initialize time delta */
-    time_null = 0;
-    time_null = timer_read(0);
+    time_null = _native_ticks();
 
     _callback = cb;
     _cb_arg = arg;
@@ -102,9 +143,26 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
         DEBUG("darn!\n\n");
     }
 
+#ifndef __MACH__
+    if (!_timer_created) {
+        struct sigevent sev;
+
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = SIGALRM;
+        _native_syscall_enter();
+        if (timer_create(CLOCK_MONOTONIC, &sev, &_timer) == -1) {
+            err(EXIT_FAILURE, "timer_init: timer_create");
+        }
+        _native_syscall_leave();
+        _timer_created = 1;
+    }
+#endif
+
     return 0;
 }
 
+#ifdef __MACH__
 static void do_timer_set(unsigned int offset)
 {
     DEBUG("%s\n", __func__);
@@ -159,6 +217,74 @@ int timer_clear(tim_t dev, int channel)
 
     return 1;
 }
+#else
+/**
+ * arms the timer for a monotonic clock value in ticks, disarms it for 0
+ */
+static void do_timer_set(uint64_t target)
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = target / NATIVE_TIMER_SPEED;
+    its.it_value.tv_nsec = (target % NATIVE_TIMER_SPEED) * 1000;
+
+    DEBUG("timer_set(): setting %u.%06u\n", (unsigned)its.it_value.tv_sec,
+          (unsigned)(its.it_value.tv_nsec / 1000));
+
+    _native_syscall_enter();
+    if (timer_settime(_timer, TIMER_ABSTIME, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+    _native_syscall_leave();
+}
+
+int timer_set(tim_t dev, int channel, unsigned int offset)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+
+    if (channel != 0) {
+        return -1;
+    }
+
+    /* a deadline in the past expires right away */
+    do_timer_set(_native_ticks() + offset);
+
+    return 1;
+}
+
+int timer_set_absolute(tim_t dev, int channel, unsigned int value)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+
+    if (channel != 0) {
+        return -1;
+    }
+
+    /* like a hardware comparator, a value just passed is hit after the
+     * counter wrapped */
+    uint64_t now = _native_ticks();
+    uint32_t offset = value - (uint32_t)(now - time_null);
+
+    do_timer_set(now + offset);
+
+    return 1;
+}
+
+int timer_clear(tim_t dev, int channel)
+{
+    (void)dev;
+    (void)channel;
+
+    if (_timer_created) {
+        do_timer_set(0);
+    }
+
+    return 1;
+}
+#endif
 
 void timer_start(tim_t dev)
 {
@@ -178,27 +304,7 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
-    _native_syscall_enter();
-#ifdef __MACH__
-    clock_serv_t cclock;
-    mach_timespec_t mts;
-    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
-    clock_get_time(cclock, &mts);
-    mach_port_deallocate(mach_task_self(), cclock);
-    t.tv_sec = mts.tv_sec;
-    t.tv_nsec = mts.tv_nsec;
-#else
-
-    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
-        err(EXIT_FAILURE, "timer_read: clock_gettime");
-    }
-
-#endif
-    _native_syscall_leave();
-
-    return ts2ticks(&t) - time_null;
+    return (uint32_t)(_native_ticks() - time_null);
 }
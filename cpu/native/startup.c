@@ -67,6 +67,13 @@ const char *_native_unix_socket_path = NULL;
 
 netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 #endif
+#ifdef MODULE_NETDEV_MEDIUM
+#include "netdev_medium_params.h"
+
+netdev_medium_params_t netdev_medium_params = {
+    .path = NETDEV_MEDIUM_DEFAULT_PATH,
+};
+#endif
 #ifdef MODULE_MTD_NATIVE
 #include "board.h"
 #include "mtd_native.h"
@@ -81,6 +88,9 @@ static const char short_opts[] = ":hi:s:deEoc:"
 #endif
 #ifdef MODULE_CAN_LINUX
     "n:"
+#endif
+#ifdef MODULE_NETDEV_MEDIUM
+    "z:"
 #endif
     "";
 
@@ -98,6 +108,9 @@ static const struct option long_opts[] = {
 #endif
 #ifdef MODULE_CAN_LINUX
     { "can", required_argument, NULL, 'n' },
+#endif
+#ifdef MODULE_NETDEV_MEDIUM
+    { "medium", required_argument, NULL, 'z' },
 #endif
     { NULL, 0, NULL, '\0' },
 };
@@ -264,6 +277,13 @@ void usage_exit(int status)
 "    -n <ifnum>:<ifname>, --can <ifnum>:<ifname>\n"
 "        specify CAN interface <ifname> to use for CAN device #<ifnum>\n"
 "        max number of CAN device: %d\n", CAN_DLL_NUMOF);
+#endif
+#ifdef MODULE_NETDEV_MEDIUM
+    real_printf(
+"    -z <path>, --medium=<path>\n"
+"        specify the socket of the medium emulator (default: %s), the\n"
+"        instance id given with -i identifies the node\n",
+           NETDEV_MEDIUM_DEFAULT_PATH);
 #endif
     real_exit(status);
 }
@@ -359,6 +379,11 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
                         CAN_MAX_SIZE_INTERFACE_NAME);
                 }
                 break;
+#endif
+#ifdef MODULE_NETDEV_MEDIUM
+            case 'z':
+                netdev_medium_params.path = optarg;
+                break;
 #endif
             default:
                 usage_exit(EXIT_FAILURE);
@@ -47,6 +47,9 @@ extern "C" {
 #elif defined(CPU_MODEL_NRF51X22XXAB)
 #define FLASHPAGE_NUMOF         (128U)
 #endif
+/* flashpage_write_raw() programs words, the erase unit stays a page */
+#define FLASHPAGE_RAW_BLOCKSIZE     (4U)
+#define FLASHPAGE_RAW_ALIGNMENT     (4U)
 /** @} */
 
 /**
@@ -60,6 +60,9 @@ extern "C" {
 #elif defined(CPU_MODEL_NRF52840XXAA)
 #define FLASHPAGE_NUMOF                 (256U)
 #endif
+/* flashpage_write_raw() programs words, the erase unit stays a page */
+#define FLASHPAGE_RAW_BLOCKSIZE     (4U)
+#define FLASHPAGE_RAW_ALIGNMENT     (4U)
 /** @} */
 
 /**
@@ -56,10 +56,11 @@
  *   - link layer ACKs
  *   - retransmissions
  *
- * @todo        So far the driver uses only a single RX buffer that is locked
- *              until the data was read/discarded. This can potentially lead to
- *              a lot of packet loss -> using more than one buffer would help
- *              here...
+ * The driver uses two RX buffers: the radio continues receiving into one
+ * buffer while a packet in the other one is read. Only if both hold unread
+ * packets, the radio pauses until one of them was read/discarded. Outgoing
+ * packets are copied into one of two TX buffers, so the copy overlaps with
+ * the transmission of the previous packet.
  *
  * @{
  *
@@ -152,6 +152,27 @@ void gpio_write(gpio_t pin, int value)
     }
 }
 
+gpio_port_t gpio_port(gpio_t pin)
+{
+    return (gpio_port_t)port(pin);
+}
+
+uint32_t gpio_port_pin_mask(gpio_t pin)
+{
+    return (1 << pin_num(pin));
+}
+
+uint32_t gpio_port_read(gpio_port_t p)
+{
+    return ((NRF_GPIO_Type *)p)->IN;
+}
+
+void gpio_port_write_masked(gpio_port_t p, uint32_t mask, uint32_t value)
+{
+    ((NRF_GPIO_Type *)p)->OUTSET = (value & mask);
+    ((NRF_GPIO_Type *)p)->OUTCLR = (~value & mask);
+}
+
 void isr_gpiote(void)
 {
     if (NRF_GPIOTE->EVENTS_IN[0] == 1) {
@@ -22,6 +22,7 @@
 #include <errno.h>
 
 #include "cpu.h"
+#include "irq.h"
 #include "mutex.h"
 #include "assert.h"
 
@@ -112,21 +113,34 @@ static volatile state_t target_state = STATE_OFF;
 /**
  * @brief   When sending out data, the data needs to be in one continuous memory
  *          region. So we need to buffer outgoing data on the driver level.
+ *
+ * The next packet is copied into one buffer while the other one is sent.
+ */
+static nrfmin_pkt_t tx_buf[2];
+
+/**
+ * @brief   Index of the TX buffer the next packet is copied into
  */
-static nrfmin_pkt_t tx_buf;
+static uint8_t tx_cur = 0;
 
 /**
  * @brief   As the device is memory mapped, we need some space to save incoming
  *          data to.
  *
- * @todo    Improve the RX buffering to at least use double buffering
+ * The radio keeps receiving into one buffer while the other one holds a packet
+ * that was not read yet.
  */
-static nrfmin_pkt_t rx_buf;
+static nrfmin_pkt_t rx_buf[2];
 
 /**
- * @brief   While we listen for incoming data, we lock the RX buffer
+ * @brief   Index of the RX buffer the radio receives into
  */
-static volatile uint8_t rx_lock = 0;
+static volatile uint8_t rx_cur = 0;
+
+/**
+ * @brief   Bitmask of the RX buffers holding a packet that was not read yet
+ */
+static volatile uint8_t rx_full = 0;
 
 /**
  * @brief   Set radio into idle (DISABLED) state
@@ -137,8 +151,6 @@ static void go_idle(void)
     NRF_RADIO->EVENTS_DISABLED = 0;
     NRF_RADIO->TASKS_DISABLE = 1;
     while (NRF_RADIO->EVENTS_DISABLED == 0) {}
-    /* also release any existing lock on the RX buffer */
-    rx_lock = 0;
     state = STATE_IDLE;
 }
 
@@ -153,10 +165,12 @@ static void goto_target_state(void)
 {
     go_idle();
 
-    if ((target_state == STATE_RX) && (rx_buf.pkt.hdr.len == 0)) {
-        /* set receive buffer and our own address */
-        rx_lock = 1;
-        NRF_RADIO->PACKETPTR = (uint32_t)(&rx_buf);
+    if ((target_state == STATE_RX) && (rx_full != 0x03)) {
+        /* set a free receive buffer and our own address */
+        if (rx_full & (1 << rx_cur)) {
+            rx_cur ^= 1;
+        }
+        NRF_RADIO->PACKETPTR = (uint32_t)(&rx_buf[rx_cur]);
         NRF_RADIO->BASE0 = (CONF_ADDR_BASE | my_addr);
         /* goto RX mode */
         NRF_RADIO->TASKS_RXEN = 1;
@@ -169,6 +183,26 @@ static void goto_target_state(void)
     }
 }
 
+/**
+ * @brief   Mark a RX buffer as read
+ *
+ * If both buffers were full, the radio waits in RXIDLE state and continues
+ * receiving into the released buffer.
+ */
+static void rx_release(uint8_t buf)
+{
+    unsigned irq = irq_disable();
+
+    if ((rx_full == 0x03) && (state == STATE_RX)) {
+        rx_cur = buf;
+        NRF_RADIO->PACKETPTR = (uint32_t)(&rx_buf[rx_cur]);
+        NRF_RADIO->TASKS_START = 1;
+    }
+    rx_full &= ~(1 << buf);
+
+    irq_restore(irq);
+}
+
 void nrfmin_setup(void)
 {
     nrfmin_dev.driver = &nrfmin_netdev;
@@ -306,11 +340,17 @@ void isr_radio(void)
         if (state == STATE_RX) {
             /* drop packet on invalid CRC */
             if ((NRF_RADIO->CRCSTATUS != 1) || !(nrfmin_dev.event_callback)) {
-                rx_buf.pkt.hdr.len = 0;
                 NRF_RADIO->TASKS_START = 1;
                 return;
             }
-            rx_lock = 0;
+            rx_full |= (1 << rx_cur);
+            /* if the other buffer is free, continue receiving into it right
+             * away, otherwise wait until a packet was read */
+            if (!(rx_full & (1 << (rx_cur ^ 1)))) {
+                rx_cur ^= 1;
+                NRF_RADIO->PACKETPTR = (uint32_t)(&rx_buf[rx_cur]);
+                NRF_RADIO->TASKS_START = 1;
+            }
             nrfmin_dev.event_callback(&nrfmin_dev, NETDEV_EVENT_ISR);
         }
         else if (state == STATE_TX) {
@@ -327,24 +367,27 @@ static int nrfmin_send(netdev_t *dev, const struct iovec *vector, unsigned count
 
     assert((vector != NULL) && (count > 0) && (state != STATE_OFF));
 
-    /* wait for any ongoing transmission to finish and go into idle state */
-    while (state == STATE_TX) {}
-    go_idle();
-
-    /* copy packet data into the transmit buffer */
+    /* copy packet data into the transmit buffer that is not in use by an
+     * ongoing transmission */
+    nrfmin_pkt_t *tx = &tx_buf[tx_cur];
     int pos = 0;
     for (unsigned i = 0; i < count; i++) {
         if ((pos + vector[i].iov_len) > NRFMIN_PKT_MAX) {
             DEBUG("[nrfmin] send: unable to do so, packet is too large!\n");
             return -EOVERFLOW;
         }
-        memcpy(&tx_buf.raw[pos], vector[i].iov_base, vector[i].iov_len);
+        memcpy(&tx->raw[pos], vector[i].iov_base, vector[i].iov_len);
         pos += vector[i].iov_len;
     }
+    tx_cur ^= 1;
+
+    /* wait for any ongoing transmission to finish and go into idle state */
+    while (state == STATE_TX) {}
+    go_idle();
 
     /* set output buffer and destination address */
     nrfmin_hdr_t *hdr = (nrfmin_hdr_t *)vector[0].iov_base;
-    NRF_RADIO->PACKETPTR = (uint32_t)(&tx_buf);
+    NRF_RADIO->PACKETPTR = (uint32_t)(tx);
     NRF_RADIO->BASE0 = (CONF_ADDR_BASE | hdr->dst_addr);
 
     /* trigger the actual transmission */
@@ -362,29 +405,34 @@ static int nrfmin_recv(netdev_t *dev, void *buf, size_t len, void *info)
 
     assert(state != STATE_OFF);
 
-    int pktlen = (int)rx_buf.pkt.hdr.len;
+    unsigned irq = irq_disable();
 
     /* check if packet data is readable */
-    if (rx_lock || (pktlen == 0)) {
+    if (rx_full == 0) {
+        irq_restore(irq);
         DEBUG("[nrfmin] recv: no packet data available\n");
         return 0;
     }
 
+    /* read the older packet if both buffers are full, the radio does not
+     * touch a full buffer so it can be read with interrupts enabled */
+    uint8_t cur = (rx_full == 0x03) ? (rx_cur ^ 1) : (rx_full >> 1);
+    irq_restore(irq);
+    int pktlen = (int)rx_buf[cur].pkt.hdr.len;
+
     if (buf == NULL) {
         if (len > 0) {
             /* drop packet */
             DEBUG("[nrfmin] recv: dropping packet of length %i\n", pktlen);
-            rx_buf.pkt.hdr.len = 0;
-            goto_target_state();
+            rx_release(cur);
         }
     }
     else {
         DEBUG("[nrfmin] recv: reading packet of length %i\n", pktlen);
 
         pktlen = (len < pktlen) ? len : pktlen;
-        memcpy(buf, rx_buf.raw, pktlen);
-        rx_buf.pkt.hdr.len = 0;
-        goto_target_state();
+        memcpy(buf, rx_buf[cur].raw, pktlen);
+        rx_release(cur);
     }
 
     return pktlen;
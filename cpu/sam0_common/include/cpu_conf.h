@@ -44,6 +44,9 @@ extern "C" {
 #define FLASHPAGE_SIZE      (256U)
 /* one SAM0 row contains 4 SAM0 pages -> 4x the amount of RIOT flashpages */
 #define FLASHPAGE_NUMOF     (FLASH_NB_OF_PAGES / 4)
+/* flashpage_write_raw() programs words, the erase unit stays a page */
+#define FLASHPAGE_RAW_BLOCKSIZE     (4U)
+#define FLASHPAGE_RAW_ALIGNMENT     (4U)
 /** @} */
 
 #ifdef __cplusplus
@@ -211,6 +211,24 @@ typedef struct {
     uint32_t muxpos;       /**< ADC channel pin multiplexer value */
 } adc_conf_chan_t;
 
+/**
+ * @brief   Number of DMA channels
+ *
+ * The DMA triggers are the `*_DMAC_ID_*` values of the vendor headers.
+ */
+#define DMA_NUMOF           (DMAC_CH_NUM)
+
+/**
+ * @brief   Maximum number of beats of one DMA transfer
+ */
+#define DMA_MAX_LEN         (0xffffU)
+
+/**
+ * @brief   Trigger for transfers between two memory areas, started by
+ *          software
+ */
+#define DMA_TRIGGER_MEM     (0U)
+
 
 #ifdef __cplusplus
 }
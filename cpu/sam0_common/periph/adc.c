@@ -26,6 +26,7 @@
 #include "cpu.h"
 
 #include "periph/adc.h"
+#include "periph/dma.h"
 #include "periph_conf.h"
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -33,6 +34,13 @@
 /* guard in case that no ADC device is defined */
 #if ADC_NUMOF
 
+#if defined(ADC_STREAM_TCC) && !defined(ADC_STREAM_EVSYS_CH)
+/**
+ * @brief   Event channel from the trigger TCC to the ADC
+ */
+#define ADC_STREAM_EVSYS_CH     (0)
+#endif
+
 int adc_init(adc_t channel) {
 
     /*  Disable ADC Module before init. */
@@ -171,4 +179,163 @@ int adc_sample(adc_t channel, adc_res_t res){
 }
 
 
+#ifdef ADC_STREAM_TCC
+/**
+ * @brief   Overflow event of the trigger TCC (TCC0, TCC1 or TCC2)
+ */
+static const uint8_t tcc_evgen[] = {
+    EVSYS_ID_GEN_TCC0_OVF, EVSYS_ID_GEN_TCC1_OVF, EVSYS_ID_GEN_TCC2_OVF
+};
+
+/**
+ * @brief   Available prescalers of the TCC, as their log2
+ */
+static const uint8_t tcc_presc[] = { 0, 1, 2, 3, 4, 6, 8, 10 };
+
+static struct {
+    adc_stream_cb_t cb;
+    void *arg;
+    uint16_t *buf;
+    size_t half;
+    dma_t dma;
+} stream = { .dma = DMA_UNDEF };
+
+static inline int _tcc_num(void)
+{
+    return ((int)(ADC_STREAM_TCC) & 0xc00) >> 10;
+}
+
+static void _stream_cb(void *arg, int res)
+{
+    (void)arg;
+
+    if (res == DMA_HALF) {
+        stream.cb(stream.arg, stream.buf, stream.half);
+    }
+    else if (res == DMA_OK) {
+        stream.cb(stream.arg, stream.buf + stream.half, stream.half);
+    }
+}
+
+int adc_stream_start(const adc_t *lines, unsigned numof, adc_res_t res,
+                     uint32_t rate, uint16_t *buf, size_t len,
+                     adc_stream_cb_t cb, void *arg)
+{
+    Tcc *tcc = ADC_STREAM_TCC;
+    uint32_t ticks;
+    unsigned presc;
+    uint8_t ressel;
+
+    /* the trigger converts a single channel at a time */
+    if ((numof != 1) || (rate == 0) || (len < 2) || (len & 1) ||
+        (len > DMA_MAX_LEN)) {
+        return -1;
+    }
+    ticks = CLOCK_CORECLOCK / rate;
+    for (presc = 0; presc < sizeof(tcc_presc); presc++) {
+        if ((ticks >> tcc_presc[presc]) <= 0x10000) {
+            break;
+        }
+    }
+    if ((ticks < 2) || (presc == sizeof(tcc_presc))) {
+        return -1;
+    }
+    switch (res) {
+        case ADC_RES_8BIT:
+            ressel = ADC_CTRLB_RESSEL_8BIT_Val;
+            break;
+        case ADC_RES_10BIT:
+            ressel = ADC_CTRLB_RESSEL_10BIT_Val;
+            break;
+        case ADC_RES_12BIT:
+            ressel = ADC_CTRLB_RESSEL_12BIT_Val;
+            break;
+        case ADC_RES_16BIT:
+            ressel = ADC_CTRLB_RESSEL_16BIT_Val;
+            break;
+        default:
+            return -1;
+    }
+    if (stream.dma != DMA_UNDEF) {
+        return -2;
+    }
+    stream.dma = dma_acquire(ADC_DMAC_ID_RESRDY);
+    if (stream.dma == DMA_UNDEF) {
+        return -2;
+    }
+    stream.cb = cb;
+    stream.arg = arg;
+    stream.buf = buf;
+    stream.half = len / 2;
+
+    /* every overflow of the TCC starts a conversion through the event
+     * system */
+    ADC_DEV->CTRLB.bit.RESSEL = ressel;
+    ADC_DEV->INPUTCTRL.bit.MUXPOS = ADC_GET_CHANNEL(lines[0]);
+    SYSCTRL->VREF.reg |= SYSCTRL_VREF_BGOUTEN;
+    ADC_DEV->EVCTRL.reg |= ADC_EVCTRL_STARTEI;
+    while (ADC_DEV->STATUS.reg & ADC_STATUS_SYNCBUSY) {}
+    ADC_DEV->CTRLA.bit.ENABLE = 1;
+    while (ADC_DEV->STATUS.reg & ADC_STATUS_SYNCBUSY) {}
+
+    dma_xfer_t xfer = {
+        .src = &ADC_DEV->RESULT.reg,
+        .dst = buf,
+        .len = len,
+        .dir = DMA_PERIPH_TO_MEM,
+        .width = DMA_WIDTH_HALF_WORD,
+        .flags = DMA_INC_DST | DMA_CIRCULAR | DMA_HALF_IRQ,
+    };
+    dma_start(stream.dma, &xfer, _stream_cb, NULL);
+
+    PM->APBCMASK.reg |= PM_APBCMASK_EVSYS;
+    EVSYS->USER.reg = (EVSYS_USER_USER(EVSYS_ID_USER_ADC_START) |
+                       EVSYS_USER_CHANNEL(ADC_STREAM_EVSYS_CH + 1));
+    EVSYS->CHANNEL.reg = (EVSYS_CHANNEL_CHANNEL(ADC_STREAM_EVSYS_CH) |
+                          EVSYS_CHANNEL_EVGEN(tcc_evgen[_tcc_num()]) |
+                          EVSYS_CHANNEL_PATH_ASYNCHRONOUS);
+
+    /* clock the TCC like the PWM driver does */
+    PM->APBCMASK.reg |= (PM_APBCMASK_TCC0 << _tcc_num());
+    GCLK->CLKCTRL.reg = (GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 |
+                         GCLK_CLKCTRL_ID((_tcc_num() == 2) ? TCC2_GCLK_ID
+                                                           : TCC0_GCLK_ID));
+    while (GCLK->STATUS.bit.SYNCBUSY) {}
+    tcc->CTRLA.reg = TCC_CTRLA_SWRST;
+    while (tcc->SYNCBUSY.reg & TCC_SYNCBUSY_SWRST) {}
+    tcc->CTRLA.reg = TCC_CTRLA_PRESCALER(presc);
+    tcc->WAVE.reg = TCC_WAVE_WAVEGEN_NFRQ;
+    tcc->PER.reg = TCC_PER_PER((ticks >> tcc_presc[presc]) - 1);
+    tcc->EVCTRL.reg = TCC_EVCTRL_OVFEO;
+    tcc->CTRLA.reg |= TCC_CTRLA_ENABLE;
+    while (tcc->SYNCBUSY.reg & TCC_SYNCBUSY_ENABLE) {}
+
+    return 0;
+}
+
+void adc_stream_stop(adc_t line)
+{
+    Tcc *tcc = ADC_STREAM_TCC;
+
+    (void)line;
+
+    if (stream.dma == DMA_UNDEF) {
+        return;
+    }
+
+    tcc->CTRLA.reg = 0;
+    while (tcc->SYNCBUSY.reg & TCC_SYNCBUSY_ENABLE) {}
+    PM->APBCMASK.reg &= ~(PM_APBCMASK_TCC0 << _tcc_num());
+    EVSYS->USER.reg = EVSYS_USER_USER(EVSYS_ID_USER_ADC_START);
+    dma_release(stream.dma);
+    stream.dma = DMA_UNDEF;
+
+    /* leave the ADC as adc_sample() does */
+    ADC_DEV->EVCTRL.reg &= ~ADC_EVCTRL_STARTEI;
+    ADC_DEV->CTRLA.bit.ENABLE = 0;
+    while (ADC_DEV->STATUS.reg & ADC_STATUS_SYNCBUSY) {}
+    SYSCTRL->VREF.reg &= ~SYSCTRL_VREF_BGOUTEN;
+}
+#endif /* ADC_STREAM_TCC */
+
 #endif /* ADC_NUMOF */
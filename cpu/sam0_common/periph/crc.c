@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_sam0_common
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC driver implementation
+ *
+ * The CRC32 of IEEE 802.3 is computed by the device service unit (DSU),
+ * which reads the data itself and continues from the value in its DATA
+ * register.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crc.h"
+
+#define DSU_PAC_BIT     (0x00000002)
+
+static mutex_t _lock = MUTEX_INIT;
+
+static void _unlock(void)
+{
+    /* remove peripheral access lock for the DSU */
+#ifdef CPU_FAM_SAML21
+    PAC->WRCTRL.reg = (PAC_WRCTRL_KEY_CLR | ID_DSU);
+#else
+    if (PAC1->WPSET.reg & DSU_PAC_BIT) {
+        PAC1->WPCLR.reg = DSU_PAC_BIT;
+    }
+#endif
+}
+
+size_t crc_update32(uint32_t *reg, const void *data, size_t len)
+{
+    size_t res = len & ~(sizeof(uint32_t) - 1);
+
+    if ((res == 0) || !mutex_trylock(&_lock)) {
+        return 0;
+    }
+    _unlock();
+    DSU->STATUSA.reg = DSU_STATUSA_DONE | DSU_STATUSA_BERR;
+    DSU->DATA.reg = *reg;
+    DSU->ADDR.reg = (uint32_t)data;
+    DSU->LENGTH.reg = res;
+    DSU->CTRL.reg = DSU_CTRL_CRC;
+    while (!(DSU->STATUSA.reg & DSU_STATUSA_DONE)) {}
+    if (DSU->STATUSA.reg & DSU_STATUSA_BERR) {
+        /* the software computes the whole range again */
+        res = 0;
+    }
+    else {
+        *reg = DSU->DATA.reg;
+    }
+    mutex_unlock(&_lock);
+
+    return res;
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_sam0_common
+ * @ingroup     drivers_periph_dma
+ * @{
+ *
+ * @file
+ * @brief       Low-level DMA driver implementation
+ *
+ * Every channel of the DMAC can serve every trigger. A transfer is a single
+ * block described by the channel's descriptor in SRAM, the DMAC is enabled
+ * while at least one channel is acquired.
+ *
+ * The DMAC has no half transfer interrupt, so a transfer with DMA_HALF_IRQ is
+ * split into two linked blocks. A circular transfer links its last block back
+ * to the first one.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "assert.h"
+#include "periph/dma.h"
+
+#define TRIGGER_MAX         (DMAC_CHCTRLB_TRIGSRC_Msk >> DMAC_CHCTRLB_TRIGSRC_Pos)
+
+static DmacDescriptor _desc[DMA_NUMOF] __attribute__((aligned(16)));
+static DmacDescriptor _wrb[DMA_NUMOF] __attribute__((aligned(16)));
+static DmacDescriptor _second[DMA_NUMOF] __attribute__((aligned(16)));
+
+static struct {
+    dma_cb_t cb;
+    void *arg;
+    uint8_t trigger;
+    uint8_t flags;
+    uint8_t in_second;
+} _dma[DMA_NUMOF];
+
+static uint32_t _used;
+
+static void _poweron(void)
+{
+#ifdef CPU_FAM_SAML21
+    MCLK->AHBMASK.reg |= MCLK_AHBMASK_DMAC;
+#else
+    PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+    PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+#endif
+    DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+    while (DMAC->CTRL.reg & DMAC_CTRL_SWRST) {}
+    DMAC->BASEADDR.reg = (uint32_t)_desc;
+    DMAC->WRBADDR.reg = (uint32_t)_wrb;
+    DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xf);
+    NVIC_EnableIRQ(DMAC_IRQn);
+}
+
+static void _poweroff(void)
+{
+    NVIC_DisableIRQ(DMAC_IRQn);
+    DMAC->CTRL.reg = 0;
+#ifdef CPU_FAM_SAML21
+    MCLK->AHBMASK.reg &= ~MCLK_AHBMASK_DMAC;
+#else
+    PM->APBBMASK.reg &= ~PM_APBBMASK_DMAC;
+    PM->AHBMASK.reg &= ~PM_AHBMASK_DMAC;
+#endif
+}
+
+/* describe the beats @p from to @p to of @p xfer in @p desc */
+static void _set_block(DmacDescriptor *desc, uint16_t btctrl,
+                       const dma_xfer_t *xfer, size_t from, size_t to,
+                       uint32_t next)
+{
+    uint32_t src = (uint32_t)xfer->src;
+    uint32_t dst = (uint32_t)xfer->dst;
+
+    /* incremented addresses point behind the end of their block */
+    if (btctrl & DMAC_BTCTRL_SRCINC) {
+        src += (to << xfer->width);
+    }
+    if (btctrl & DMAC_BTCTRL_DSTINC) {
+        dst += (to << xfer->width);
+    }
+    desc->BTCTRL.reg = btctrl;
+    desc->BTCNT.reg = to - from;
+    desc->SRCADDR.reg = src;
+    desc->DSTADDR.reg = dst;
+    desc->DESCADDR.reg = next;
+}
+
+dma_t dma_acquire(dma_trigger_t trigger)
+{
+    dma_t dma;
+    unsigned state;
+
+    if (trigger > TRIGGER_MAX) {
+        return DMA_UNDEF;
+    }
+
+    state = irq_disable();
+    for (dma = 0; dma < DMA_NUMOF; dma++) {
+        if (!(_used & (1 << dma))) {
+            break;
+        }
+    }
+    if (dma == DMA_NUMOF) {
+        irq_restore(state);
+        return DMA_UNDEF;
+    }
+    if (_used == 0) {
+        _poweron();
+    }
+    _used |= (1 << dma);
+    irq_restore(state);
+
+    _dma[dma].trigger = trigger;
+    return dma;
+}
+
+void dma_release(dma_t dma)
+{
+    unsigned state;
+
+    assert((dma < DMA_NUMOF) && (_used & (1 << dma)));
+
+    dma_stop(dma);
+    state = irq_disable();
+    _used &= ~(1 << dma);
+    if (_used == 0) {
+        _poweroff();
+    }
+    irq_restore(state);
+}
+
+int dma_start(dma_t dma, const dma_xfer_t *xfer, dma_cb_t cb, void *arg)
+{
+    DmacDescriptor *desc = &_desc[dma];
+    uint16_t btctrl = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BLOCKACT_INT |
+                      (xfer->width << DMAC_BTCTRL_BEATSIZE_Pos);
+    uint32_t chctrlb = DMAC_CHCTRLB_TRIGSRC(_dma[dma].trigger);
+    uint32_t next = (xfer->flags & DMA_CIRCULAR) ? (uint32_t)desc : 0;
+    size_t first = xfer->len;
+    unsigned state;
+
+    assert((dma < DMA_NUMOF) && (_used & (1 << dma)));
+
+    if ((xfer->len == 0) || (xfer->len > DMA_MAX_LEN) ||
+        ((xfer->flags & DMA_HALF_IRQ) && (xfer->len < 2))) {
+        return DMA_NOLEN;
+    }
+
+    if (xfer->flags & DMA_INC_SRC) {
+        btctrl |= DMAC_BTCTRL_SRCINC;
+    }
+    if (xfer->flags & DMA_INC_DST) {
+        btctrl |= DMAC_BTCTRL_DSTINC;
+    }
+    if (xfer->flags & DMA_HALF_IRQ) {
+        first = xfer->len / 2;
+        _set_block(&_second[dma], btctrl, xfer, first, xfer->len, next);
+        next = (uint32_t)&_second[dma];
+    }
+    _set_block(desc, btctrl, xfer, 0, first, next);
+    /* the write-back only holds the block count once the channel ran */
+    _wrb[dma].BTCNT.reg = first;
+
+    /* a software trigger moves the whole block, a peripheral one beat by
+     * beat */
+    chctrlb |= (_dma[dma].trigger == DMA_TRIGGER_MEM) ? DMAC_CHCTRLB_TRIGACT_BLOCK
+                                                      : DMAC_CHCTRLB_TRIGACT_BEAT;
+
+    _dma[dma].cb = cb;
+    _dma[dma].arg = arg;
+    _dma[dma].flags = xfer->flags;
+    _dma[dma].in_second = 0;
+
+    state = irq_disable();
+    DMAC->CHID.reg = dma;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST) {}
+    DMAC->CHCTRLB.reg = chctrlb;
+    DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TERR | DMAC_CHINTENSET_TCMPL;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+    if (_dma[dma].trigger == DMA_TRIGGER_MEM) {
+        DMAC->SWTRIGCTRL.reg |= (1 << dma);
+    }
+    irq_restore(state);
+
+    return DMA_OK;
+}
+
+void dma_stop(dma_t dma)
+{
+    unsigned state;
+
+    assert(dma < DMA_NUMOF);
+
+    state = irq_disable();
+    DMAC->CHID.reg = dma;
+    DMAC->CHCTRLA.reg = 0;
+    while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_ENABLE) {}
+    DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+    _dma[dma].cb = NULL;
+    irq_restore(state);
+}
+
+unsigned dma_remaining(dma_t dma)
+{
+    unsigned state;
+    uint32_t active;
+    unsigned left;
+
+    assert(dma < DMA_NUMOF);
+
+    state = irq_disable();
+    active = DMAC->ACTIVE.reg;
+    /* the write-back is only updated when the channel loses the bus */
+    if ((active & DMAC_ACTIVE_ABUSY) &&
+        (((active & DMAC_ACTIVE_ID_Msk) >> DMAC_ACTIVE_ID_Pos) == dma)) {
+        left = (active & DMAC_ACTIVE_BTCNT_Msk) >> DMAC_ACTIVE_BTCNT_Pos;
+    }
+    else {
+        left = _wrb[dma].BTCNT.reg;
+    }
+    if ((_dma[dma].flags & DMA_HALF_IRQ) && !_dma[dma].in_second) {
+        left += _second[dma].BTCNT.reg;
+    }
+    irq_restore(state);
+    return left;
+}
+
+void isr_dmac(void)
+{
+    uint32_t pending = DMAC->INTSTATUS.reg;
+
+    for (dma_t dma = 0; pending; dma++, pending >>= 1) {
+        if (!(pending & 1)) {
+            continue;
+        }
+        DMAC->CHID.reg = dma;
+        uint8_t flags = DMAC->CHINTFLAG.reg;
+        DMAC->CHINTFLAG.reg = flags;
+
+        dma_cb_t cb = _dma[dma].cb;
+        int res;
+
+        if (flags & DMAC_CHINTFLAG_TERR) {
+            res = DMA_ERR;
+        }
+        else if (flags & DMAC_CHINTFLAG_TCMPL) {
+            res = ((_dma[dma].flags & DMA_HALF_IRQ) && !_dma[dma].in_second)
+                  ? DMA_HALF : DMA_OK;
+            if (_dma[dma].flags & DMA_HALF_IRQ) {
+                _dma[dma].in_second = (res == DMA_HALF);
+            }
+        }
+        else {
+            continue;
+        }
+
+        /* the channel disables itself at the end or on an error */
+        if ((res == DMA_ERR) ||
+            ((res == DMA_OK) && !(_dma[dma].flags & DMA_CIRCULAR))) {
+            _dma[dma].cb = NULL;
+        }
+        if (cb) {
+            cb(_dma[dma].arg, res);
+        }
+    }
+    cortexm_isr_end();
+}
@@ -8,7 +8,7 @@
 
 /**
  * @ingroup     cpu_sam0_common
- * @ingroup     drivers_periph_adc
+ * @ingroup     drivers_periph_flashpage
  * @{
  *
  * @file
@@ -31,12 +31,8 @@
 
 #define NVMCTRL_PAC_BIT     (0x00000002)
 
-void flashpage_write(int page, void *data)
+static void _unlock(void)
 {
-    assert(page < FLASHPAGE_NUMOF);
-
-    uint32_t *page_addr = (uint32_t *)flashpage_addr(page);
-
     /* remove peripheral access lock for the NVMCTRL peripheral */
 #ifdef CPU_FAM_SAML21
     PAC->WRCTRL.reg = (PAC_WRCTRL_KEY_CLR | ID_NVMCTRL);
@@ -45,19 +41,61 @@ void flashpage_write(int page, void *data)
         PAC1->WPCLR.reg = NVMCTRL_PAC_BIT;
     }
 #endif
+}
+
+static inline void _wait_ready(void)
+{
+    while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY)) {}
+}
+
+void flashpage_write_raw(void *target_addr, const void *data, size_t len)
+{
+    /* only whole, aligned words can be written to the page buffer */
+    assert(!(len % FLASHPAGE_RAW_BLOCKSIZE));
+    assert(!(((uintptr_t)target_addr % FLASHPAGE_RAW_ALIGNMENT) ||
+             ((uintptr_t)data % FLASHPAGE_RAW_ALIGNMENT)));
+    /* ensure the length doesn't exceed the actual flash size */
+    assert(((uintptr_t)target_addr + len) <=
+           (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)));
+
+    uint32_t *dst = (uint32_t *)target_addr;
+    const uint32_t *src = (const uint32_t *)data;
+
+    _unlock();
+    /* the page buffer holds a single SAM0 page, which is written at once
+     * (bytes left at 0xff in the page buffer do not change the flash) */
+    while (len > 0) {
+        size_t chunk = FLASH_PAGE_SIZE - ((uintptr_t)dst % FLASH_PAGE_SIZE);
+
+        if (chunk > len) {
+            chunk = len;
+        }
+        NVMCTRL->CTRLA.reg = (NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_PBC);
+        _wait_ready();
+        for (unsigned i = 0; i < (chunk / 4); i++) {
+            *dst++ = *src++;
+        }
+        NVMCTRL->CTRLA.reg = (NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_WP);
+        _wait_ready();
+        len -= chunk;
+    }
+}
+
+void flashpage_write(int page, void *data)
+{
+    assert(page < FLASHPAGE_NUMOF);
+
+    uint32_t *page_addr = (uint32_t *)flashpage_addr(page);
+
+    _unlock();
 
     /* erase given page (the ADDR register uses 16-bit addresses) */
     NVMCTRL->ADDR.reg = (((uint32_t)page_addr) >> 1);
     NVMCTRL->CTRLA.reg = (NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_ER);
-    while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY)) {}
+    _wait_ready();
 
     /* write data to page */
     if (data != NULL) {
-        uint32_t *data_addr = (uint32_t *)data;
-        NVMCTRL->CTRLA.reg = (NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_PBC);
-        for (unsigned i = 0; i < (FLASHPAGE_SIZE / 4); i++) {
-            *page_addr++ = data_addr[i];
-        }
-        NVMCTRL->CTRLA.reg = (NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_WP);
+        flashpage_write_raw(page_addr, data, FLASHPAGE_SIZE);
     }
 }
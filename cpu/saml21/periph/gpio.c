@@ -207,6 +207,27 @@ void gpio_write(gpio_t pin, int value)
     }
 }
 
+gpio_port_t gpio_port(gpio_t pin)
+{
+    return (gpio_port_t)_port(pin);
+}
+
+uint32_t gpio_port_pin_mask(gpio_t pin)
+{
+    return _pin_mask(pin);
+}
+
+uint32_t gpio_port_read(gpio_port_t port)
+{
+    return ((PortGroup *)port)->IN.reg;
+}
+
+void gpio_port_write_masked(gpio_port_t port, uint32_t mask, uint32_t value)
+{
+    ((PortGroup *)port)->OUTSET.reg = (value & mask);
+    ((PortGroup *)port)->OUTCLR.reg = (~value & mask);
+}
+
 void isr_eic(void)
 {
     for (int i = 0; i < NUMOF_IRQS; i++) {
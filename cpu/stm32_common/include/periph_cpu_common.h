@@ -54,6 +54,23 @@ extern uint32_t _cpuid_address;
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
 /** @} */
 
+/**
+ * @brief   The SPI driver moves asynchronous transfers by DMA, where available
+ */
+#define PERIPH_SPI_HAS_TRANSFER_BYTES_ASYNC
+
+/**
+ * @brief   The UART driver receives into a circular buffer by DMA, where
+ *          available
+ */
+#define PERIPH_UART_HAS_INIT_RX_DMA
+
+/**
+ * @brief   The UART driver sends from the TX empty interrupt on
+ *          uart_write_async()
+ */
+#define PERIPH_UART_HAS_WRITE_ASYNC
+
 /**
  * @brief   Number of usable low power modes
  */
@@ -217,6 +234,43 @@ typedef struct {
     uint8_t cc_chan;        /**< capture compare channel used */
 } pwm_chan_t;
 
+#if defined(CPU_FAM_STM32F2) || defined(CPU_FAM_STM32F4) \
+    || defined(CPU_FAM_STM32F7) || defined(DOXYGEN)
+/**
+ * @brief   Number of DMA streams, 8 on each of the two controllers
+ *
+ * A dma_t is the number of the stream, DMA2 stream 0 is stream 8.
+ */
+#define DMA_NUMOF           (16U)
+
+/**
+ * @brief   Maximum number of beats of one DMA transfer
+ */
+#define DMA_MAX_LEN         (0xffffU)
+
+/**
+ * @brief   Generate the DMA trigger of a peripheral request
+ *
+ * The request mapping tables in the reference manual list the stream and the
+ * channel of each peripheral request.
+ *
+ * 0 is never a valid trigger, so it marks an unused DMA request in the
+ * peripheral configurations.
+ *
+ * @param[in] ctrl      DMA controller, 1 or 2
+ * @param[in] stream    stream of the request, 0 to 7
+ * @param[in] chan      channel of the request on @p stream
+ */
+#define DMA_TRIGGER(ctrl, stream, chan) \
+    (((((ctrl) * 8) + (stream)) << 4) | (chan))
+
+/**
+ * @brief   Trigger for transfers between two memory areas, which only DMA2
+ *          supports
+ */
+#define DMA_TRIGGER_MEM     (0xffffU)
+#endif
+
 /**
  * @brief   PWM configuration
  */
@@ -243,9 +297,9 @@ typedef struct {
 #endif
     uint8_t bus;            /**< APB bus */
     uint8_t irqn;           /**< IRQ channel */
-#if 0 /* TODO */
-    uint8_t dma_stream;     /**< DMA stream used for TX */
-    uint8_t dma_chan;       /**< DMA channel used for TX */
+#if defined(DMA_NUMOF) || defined(DOXYGEN)
+    uint16_t rx_dma;        /**< DMA_TRIGGER() of the RX request, 0 to not use
+                             *   DMA */
 #endif
 #ifdef UART_USE_HW_FC
     gpio_t cts_pin;         /**< CTS pin - set to GPIO_UNDEF when not using HW flow control */
@@ -271,8 +325,15 @@ typedef struct {
 #endif
     uint32_t rccmask;       /**< bit in the RCC peripheral enable register */
     uint8_t apbbus;         /**< APBx bus the device is connected to */
+#if defined(DMA_NUMOF) || defined(DOXYGEN)
+    uint16_t tx_dma;        /**< DMA_TRIGGER() of the TX request, 0 to not use
+                             *   DMA */
+    uint16_t rx_dma;        /**< DMA_TRIGGER() of the RX request, 0 to not use
+                             *   DMA */
+#endif
 } spi_conf_t;
 
+
 /**
  * @brief   Get the actual bus clock frequency for the APB buses
  *
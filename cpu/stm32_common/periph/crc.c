@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32_common
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC driver implementation
+ *
+ * The CRC unit of all STM32 families shifts 32-bit words MSB first into a
+ * register that is reset to 0xFFFFFFFF, the CRC32 of IEEE 802.3 shifts the
+ * bytes LSB first. So every word is bit reversed before it is written and the
+ * register is bit reversed after it is read. Only the F0, F3, F7, L0 and L4
+ * have an INIT register, so a different start value is set by writing the
+ * word that shifts the reset value into it.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crc.h"
+
+/* only build if the CPU actually provides a CRC unit */
+#ifdef CRC
+
+#define POLY        (0x04c11db7)
+#define REG_RESET   (0xffffffff)
+
+#ifdef RCC_AHB1ENR_CRCEN
+#define CRC_BUS     AHB1
+#define CRC_EN      RCC_AHB1ENR_CRCEN
+#else
+#define CRC_BUS     AHB
+#define CRC_EN      RCC_AHBENR_CRCEN
+#endif
+
+static mutex_t _lock = MUTEX_INIT;
+
+/* the register value that is shifted into reg by one word of zeros */
+static uint32_t _unshift(uint32_t reg)
+{
+    for (unsigned i = 0; i < 32; i++) {
+        reg = (reg & 1) ? (((reg ^ POLY) >> 1) | 0x80000000) : (reg >> 1);
+    }
+    return reg;
+}
+
+size_t crc_update32(uint32_t *reg, const void *data, size_t len)
+{
+    const uint32_t *words = data;
+    size_t numof = len / sizeof(uint32_t);
+
+    if ((numof == 0) || !mutex_trylock(&_lock)) {
+        return 0;
+    }
+    periph_clk_en(CRC_BUS, CRC_EN);
+    CRC->CR = CRC_CR_RESET;
+    if (*reg != REG_RESET) {
+        CRC->DR = _unshift(__RBIT(*reg)) ^ REG_RESET;
+    }
+    for (size_t i = 0; i < numof; i++) {
+        /* the words are read as little endian */
+        CRC->DR = __RBIT(words[i]);
+    }
+    *reg = __RBIT(CRC->DR);
+    periph_clk_dis(CRC_BUS, CRC_EN);
+    mutex_unlock(&_lock);
+
+    return numof * sizeof(uint32_t);
+}
+
+#endif /* CRC */
@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32_common
+ * @ingroup     drivers_periph_dma
+ * @{
+ *
+ * @file
+ * @brief       Low-level DMA driver implementation
+ *
+ * Implementation for the stream based DMA controllers of the F2, F4 and F7
+ * families. Every stream serves one request at a time, selected by its
+ * channel, so a stream is only handed out for the trigger it is wired to.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "assert.h"
+#include "periph/dma.h"
+
+/* only build if the CPU has stream based DMA controllers */
+#ifdef DMA_NUMOF
+
+#define STREAMS_PER_CTRL    (8U)
+
+/* interrupt flags of a stream, relative to its position in LISR or HISR */
+#define FLAG_TE             (0x08)
+#define FLAG_HT             (0x10)
+#define FLAG_TC             (0x20)
+#define FLAG_ALL            (0x3d)
+
+static struct {
+    dma_cb_t cb;
+    void *arg;
+    uint8_t chan;
+} _dma[DMA_NUMOF];
+
+static uint16_t _used;
+
+static const uint8_t _flag_pos[] = { 0, 6, 16, 22 };
+
+static const uint8_t _irqn[DMA_NUMOF] = {
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn,
+};
+
+static inline DMA_TypeDef *_ctrl(dma_t dma)
+{
+    return (dma < STREAMS_PER_CTRL) ? DMA1 : DMA2;
+}
+
+static inline uint32_t _ctrl_en(dma_t dma)
+{
+    return (dma < STREAMS_PER_CTRL) ? RCC_AHB1ENR_DMA1EN : RCC_AHB1ENR_DMA2EN;
+}
+
+static inline DMA_Stream_TypeDef *_stream(dma_t dma)
+{
+    return (dma < STREAMS_PER_CTRL) ? (DMA1_Stream0 + dma)
+                                    : (DMA2_Stream0 + (dma - STREAMS_PER_CTRL));
+}
+
+/* read and clear the interrupt flags of a stream */
+static uint32_t _flags(dma_t dma)
+{
+    DMA_TypeDef *ctrl = _ctrl(dma);
+    unsigned pos = _flag_pos[dma & 0x3];
+    uint32_t flags;
+
+    if (dma & 0x4) {
+        flags = ctrl->HISR;
+        ctrl->HIFCR = (FLAG_ALL << pos);
+    }
+    else {
+        flags = ctrl->LISR;
+        ctrl->LIFCR = (FLAG_ALL << pos);
+    }
+    return (flags >> pos) & FLAG_ALL;
+}
+
+dma_t dma_acquire(dma_trigger_t trigger)
+{
+    dma_t first, last, dma;
+    unsigned state;
+
+    if (trigger == DMA_TRIGGER_MEM) {
+        first = STREAMS_PER_CTRL;
+        last = DMA_NUMOF - 1;
+    }
+    else {
+        /* the controller is counted from 1 in the trigger */
+        first = (trigger >> 4) - STREAMS_PER_CTRL;
+        last = first;
+        if (first >= DMA_NUMOF) {
+            return DMA_UNDEF;
+        }
+    }
+
+    state = irq_disable();
+    for (dma = first; dma <= last; dma++) {
+        if (!(_used & (1 << dma))) {
+            _used |= (1 << dma);
+            break;
+        }
+    }
+    irq_restore(state);
+    if (dma > last) {
+        return DMA_UNDEF;
+    }
+
+    _dma[dma].chan = (trigger == DMA_TRIGGER_MEM) ? 0 : (trigger & 0xf);
+    periph_clk_en(AHB1, _ctrl_en(dma));
+    NVIC_EnableIRQ(_irqn[dma]);
+    return dma;
+}
+
+void dma_release(dma_t dma)
+{
+    uint16_t ctrl_mask = (dma < STREAMS_PER_CTRL) ? 0x00ff : 0xff00;
+    unsigned state;
+
+    assert((dma < DMA_NUMOF) && (_used & (1 << dma)));
+
+    dma_stop(dma);
+    NVIC_DisableIRQ(_irqn[dma]);
+    state = irq_disable();
+    _used &= ~(1 << dma);
+    if (!(_used & ctrl_mask)) {
+        periph_clk_dis(AHB1, _ctrl_en(dma));
+    }
+    irq_restore(state);
+}
+
+int dma_start(dma_t dma, const dma_xfer_t *xfer, dma_cb_t cb, void *arg)
+{
+    DMA_Stream_TypeDef *stream = _stream(dma);
+    uint32_t cr = (_dma[dma].chan * DMA_SxCR_CHSEL_0) |
+                  (xfer->width * DMA_SxCR_PSIZE_0) |
+                  (xfer->width * DMA_SxCR_MSIZE_0) |
+                  DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    uint32_t fcr = 0;
+
+    assert((dma < DMA_NUMOF) && (_used & (1 << dma)));
+
+    if ((xfer->len == 0) || (xfer->len > DMA_MAX_LEN) ||
+        ((xfer->flags & DMA_HALF_IRQ) && (xfer->len < 2))) {
+        return DMA_NOLEN;
+    }
+    if (xfer->flags & DMA_CIRCULAR) {
+        cr |= DMA_SxCR_CIRC;
+    }
+    if (xfer->flags & DMA_HALF_IRQ) {
+        cr |= DMA_SxCR_HTIE;
+    }
+
+    /* PAR is the peripheral side, M0AR the memory side, PINC and MINC
+     * increment them */
+    switch (xfer->dir) {
+        case DMA_PERIPH_TO_MEM:
+            stream->PAR = (uint32_t)xfer->src;
+            stream->M0AR = (uint32_t)xfer->dst;
+            cr |= ((xfer->flags & DMA_INC_SRC) ? DMA_SxCR_PINC : 0) |
+                  ((xfer->flags & DMA_INC_DST) ? DMA_SxCR_MINC : 0);
+            break;
+        case DMA_MEM_TO_PERIPH:
+            stream->PAR = (uint32_t)xfer->dst;
+            stream->M0AR = (uint32_t)xfer->src;
+            cr |= DMA_SxCR_DIR_0 |
+                  ((xfer->flags & DMA_INC_SRC) ? DMA_SxCR_MINC : 0) |
+                  ((xfer->flags & DMA_INC_DST) ? DMA_SxCR_PINC : 0);
+            break;
+        default:
+            assert(_ctrl(dma) == DMA2);
+            /* memory to memory transfers need the FIFO */
+            stream->PAR = (uint32_t)xfer->src;
+            stream->M0AR = (uint32_t)xfer->dst;
+            cr |= DMA_SxCR_DIR_1 |
+                  ((xfer->flags & DMA_INC_SRC) ? DMA_SxCR_PINC : 0) |
+                  ((xfer->flags & DMA_INC_DST) ? DMA_SxCR_MINC : 0);
+            fcr = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+            break;
+    }
+
+    _dma[dma].cb = cb;
+    _dma[dma].arg = arg;
+    stream->NDTR = xfer->len;
+    stream->FCR = fcr;
+    _flags(dma);
+    stream->CR = cr;
+    stream->CR = cr | DMA_SxCR_EN;
+
+    return DMA_OK;
+}
+
+void dma_stop(dma_t dma)
+{
+    DMA_Stream_TypeDef *stream = _stream(dma);
+
+    assert(dma < DMA_NUMOF);
+
+    stream->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_HTIE |
+                    DMA_SxCR_TEIE);
+    /* the stream finishes its current beat first */
+    while (stream->CR & DMA_SxCR_EN) {}
+    _flags(dma);
+    _dma[dma].cb = NULL;
+}
+
+unsigned dma_remaining(dma_t dma)
+{
+    assert(dma < DMA_NUMOF);
+
+    return _stream(dma)->NDTR;
+}
+
+static inline void irq_handler(dma_t dma)
+{
+    DMA_Stream_TypeDef *stream = _stream(dma);
+    uint32_t flags = _flags(dma);
+    dma_cb_t cb = _dma[dma].cb;
+
+    if ((flags & FLAG_TE) ||
+        ((flags & FLAG_TC) && !(stream->CR & DMA_SxCR_CIRC))) {
+        /* the stream disables itself at the end or on an error */
+        stream->CR = 0;
+        _dma[dma].cb = NULL;
+        if (cb) {
+            cb(_dma[dma].arg, (flags & FLAG_TE) ? DMA_ERR : DMA_OK);
+        }
+    }
+    else if (cb) {
+        /* a circular stream that was slow to be served may report both */
+        if (flags & FLAG_HT) {
+            cb(_dma[dma].arg, DMA_HALF);
+        }
+        if (flags & FLAG_TC) {
+            cb(_dma[dma].arg, DMA_OK);
+        }
+    }
+    cortexm_isr_end();
+}
+
+void isr_dma1_stream0(void)
+{
+    irq_handler(0);
+}
+
+void isr_dma1_stream1(void)
+{
+    irq_handler(1);
+}
+
+void isr_dma1_stream2(void)
+{
+    irq_handler(2);
+}
+
+void isr_dma1_stream3(void)
+{
+    irq_handler(3);
+}
+
+void isr_dma1_stream4(void)
+{
+    irq_handler(4);
+}
+
+void isr_dma1_stream5(void)
+{
+    irq_handler(5);
+}
+
+void isr_dma1_stream6(void)
+{
+    irq_handler(6);
+}
+
+void isr_dma1_stream7(void)
+{
+    irq_handler(7);
+}
+
+void isr_dma2_stream0(void)
+{
+    irq_handler(8);
+}
+
+void isr_dma2_stream1(void)
+{
+    irq_handler(9);
+}
+
+void isr_dma2_stream2(void)
+{
+    irq_handler(10);
+}
+
+void isr_dma2_stream3(void)
+{
+    irq_handler(11);
+}
+
+void isr_dma2_stream4(void)
+{
+    irq_handler(12);
+}
+
+void isr_dma2_stream5(void)
+{
+    irq_handler(13);
+}
+
+void isr_dma2_stream6(void)
+{
+    irq_handler(14);
+}
+
+void isr_dma2_stream7(void)
+{
+    irq_handler(15);
+}
+
+#endif /* DMA_NUMOF */
@@ -28,12 +28,8 @@
 #if defined(FLASHPAGE_SIZE) && defined(FLASHPAGE_NUMOF)
 #include "periph/flashpage.h"
 
-void flashpage_write(int page, void *data)
+static uint32_t _unlock(void)
 {
-    assert(page < FLASHPAGE_NUMOF);
-
-    uint16_t *page_addr = flashpage_addr(page);
-    uint16_t *data_addr = (uint16_t *)data;
     uint32_t hsi_state = (RCC->CR & RCC_CR_HSION);
 
     /* the internal RC oscillator (HSI) must be enabled */
@@ -46,16 +42,32 @@ void flashpage_write(int page, void *data)
         FLASH->KEYR = FLASH_KEY1;
         FLASH->KEYR = FLASH_KEY2;
     }
+    return hsi_state;
+}
+
+static void _lock(uint32_t hsi_state)
+{
+    /* finally, lock the flash module again */
+    DEBUG("flashpage] now locking the flash module again\n");
+    FLASH->CR |= FLASH_CR_LOCK;
 
-    /* ERASE sequence */
+    /* restore the HSI state */
+    if (!hsi_state) {
+        RCC->CR &= ~(RCC_CR_HSION);
+        while (RCC->CR & RCC_CR_HSIRDY) {}
+    }
+}
+
+static void _erase_page(void *page_addr)
+{
     /* make sure no flash operation is ongoing */
     DEBUG("[flashpage] erase: waiting for any operation to finish\n");
     while (FLASH->SR & FLASH_SR_BSY) {}
     /* set page erase bit and program page address */
     DEBUG("[flashpage] erase: setting the erase bit and page address\n");
     FLASH->CR |= FLASH_CR_PER;
-    FLASH->AR = (uint32_t)flashpage_addr(page);
-    DEBUG("address to erase: %p\n", flashpage_addr(page));
+    FLASH->AR = (uint32_t)page_addr;
+    DEBUG("address to erase: %p\n", page_addr);
     /* trigger the page erase and wait for it to be finished */
     DEBUG("[flashpage] erase: trigger the page erase\n");
     FLASH->CR |= FLASH_CR_STRT;
@@ -64,30 +76,51 @@ void flashpage_write(int page, void *data)
     /* reset PER bit */
     DEBUG("[flashpage] erase: resetting the page erase bit\n");
     FLASH->CR &= ~(FLASH_CR_PER);
+}
 
-    /* WRITE sequence */
-    if (data != NULL) {
-        DEBUG("[flashpage] write: now writing the data\n");
-        /* set PG bit and program page to flash */
-        FLASH->CR |= FLASH_CR_PG;
-        for (unsigned i = 0; i < (FLASHPAGE_SIZE / 2); i++) {
-            *page_addr++ = data_addr[i];
-            while (FLASH->SR & FLASH_SR_BSY) {}
-        }
-        /* clear program bit again */
-        FLASH->CR &= ~(FLASH_CR_PG);
-        DEBUG("[flashpage] write: done writing data\n");
+static void _write(void *target_addr, const void *data, size_t len)
+{
+    uint16_t *dst = (uint16_t *)target_addr;
+    const uint16_t *src = (const uint16_t *)data;
+
+    DEBUG("[flashpage] write: now writing the data\n");
+    /* set PG bit and program the flash half-word by half-word */
+    FLASH->CR |= FLASH_CR_PG;
+    for (size_t i = 0; i < (len / 2); i++) {
+        *dst++ = src[i];
+        while (FLASH->SR & FLASH_SR_BSY) {}
     }
+    /* clear program bit again */
+    FLASH->CR &= ~(FLASH_CR_PG);
+    DEBUG("[flashpage] write: done writing data\n");
+}
 
-    /* finally, lock the flash module again */
-    DEBUG("flashpage] now locking the flash module again\n");
-    FLASH->CR |= FLASH_CR_LOCK;
+void flashpage_write_raw(void *target_addr, const void *data, size_t len)
+{
+    /* only whole, aligned half-words can be programmed */
+    assert(!(len % FLASHPAGE_RAW_BLOCKSIZE));
+    assert(!(((uintptr_t)target_addr % FLASHPAGE_RAW_ALIGNMENT) ||
+             ((uintptr_t)data % FLASHPAGE_RAW_ALIGNMENT)));
+    /* ensure the length doesn't exceed the actual flash size */
+    assert(((uintptr_t)target_addr + len) <=
+           (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)));
 
-    /* restore the HSI state */
-    if (!hsi_state) {
-        RCC->CR &= ~(RCC_CR_HSION);
-        while (RCC->CR & RCC_CR_HSIRDY) {}
+    uint32_t hsi_state = _unlock();
+    _write(target_addr, data, len);
+    _lock(hsi_state);
+}
+
+void flashpage_write(int page, void *data)
+{
+    assert(page < FLASHPAGE_NUMOF);
+
+    uint32_t hsi_state = _unlock();
+
+    _erase_page(flashpage_addr(page));
+    if (data != NULL) {
+        _write(flashpage_addr(page), data, FLASHPAGE_SIZE);
     }
+    _lock(hsi_state);
 }
 
 #endif /* defined(FLASHPAGE_SIZE) && defined(FLASHPAGE_NUMOF) */
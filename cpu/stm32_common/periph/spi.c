@@ -30,6 +30,7 @@
 #include "mutex.h"
 #include "assert.h"
 #include "periph/spi.h"
+#include "periph/dma.h"
 
 /* Remove this ugly guard once we selectively build the periph drivers */
 #ifdef SPI_NUMOF
@@ -44,6 +45,38 @@
  */
 static mutex_t locks[SPI_NUMOF];
 
+#ifdef DMA_NUMOF
+/**
+ * @brief   Minimum number of bytes that are transferred by DMA
+ */
+#ifndef SPI_DMA_THRESHOLD
+#define SPI_DMA_THRESHOLD   (16U)
+#endif
+
+/* single bytes are always polled, spi_transfer_reg_list() sends them from
+ * interrupt context */
+#if SPI_DMA_THRESHOLD < 2
+#error "SPI_DMA_THRESHOLD must be at least 2"
+#endif
+
+/**
+ * @brief   DMA streams and the state of a running asynchronous transfer
+ */
+static struct {
+    dma_t tx;
+    dma_t rx;
+    spi_cs_t cs;
+    bool cont;
+    spi_cb_t cb;
+    void *arg;
+} dma[SPI_NUMOF];
+
+/* source of the TX stream when only receiving, sink of the RX stream when
+ * only sending */
+static const uint8_t dma_zero = 0;
+static uint8_t dma_sink;
+#endif
+
 static inline SPI_TypeDef *dev(spi_t bus)
 {
     return spi_config[bus].dev;
@@ -71,6 +104,26 @@ void spi_init(spi_t bus)
     dev(bus)->CR2 = 0;
 #endif
     periph_clk_dis(spi_config[bus].apbbus, spi_config[bus].rccmask);
+
+#ifdef DMA_NUMOF
+    /* the bus falls back to polling if it does not get both streams */
+    dma[bus].tx = DMA_UNDEF;
+    dma[bus].rx = DMA_UNDEF;
+    if (spi_config[bus].tx_dma && spi_config[bus].rx_dma) {
+        dma[bus].tx = dma_acquire(spi_config[bus].tx_dma);
+        dma[bus].rx = dma_acquire(spi_config[bus].rx_dma);
+        if ((dma[bus].tx == DMA_UNDEF) || (dma[bus].rx == DMA_UNDEF)) {
+            if (dma[bus].tx != DMA_UNDEF) {
+                dma_release(dma[bus].tx);
+            }
+            if (dma[bus].rx != DMA_UNDEF) {
+                dma_release(dma[bus].rx);
+            }
+            dma[bus].tx = DMA_UNDEF;
+            dma[bus].rx = DMA_UNDEF;
+        }
+    }
+#endif
 }
 
 void spi_init_pins(spi_t bus)
@@ -141,6 +194,10 @@ int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
 
 void spi_release(spi_t bus)
 {
+#ifdef DMA_NUMOF
+    /* an asynchronous transfer must be finished before */
+    assert(dma[bus].cb == NULL);
+#endif
     /* disable device and release lock */
     dev(bus)->CR1 = 0;
     dev(bus)->CR2 &= ~(SPI_CR2_SSOE);
@@ -148,6 +205,93 @@ void spi_release(spi_t bus)
     mutex_unlock(&locks[bus]);
 }
 
+static void _select(spi_t bus, spi_cs_t cs)
+{
+    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
+    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
+        gpio_clear((gpio_t)cs);
+    }
+}
+
+static void _finish(spi_t bus, spi_cs_t cs, bool cont)
+{
+    /* make sure the transfer is completed before continuing, see reference
+     * manual(s) -> section 'Disabling the SPI' */
+    while (!(dev(bus)->SR & SPI_SR_TXE)) {}
+    while (dev(bus)->SR & SPI_SR_BSY) {}
+
+    /* release the chip select if not specified differently */
+    if ((!cont) && (cs != SPI_CS_UNDEF)) {
+        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
+        if (cs != SPI_HWCS_MASK) {
+            gpio_set((gpio_t)cs);
+        }
+    }
+}
+
+#ifdef DMA_NUMOF
+static inline bool _use_dma(spi_t bus, size_t len)
+{
+    return (dma[bus].tx != DMA_UNDEF) &&
+           (len >= SPI_DMA_THRESHOLD) && (len <= DMA_MAX_LEN);
+}
+
+static void _dma_start(spi_t bus, const void *out, void *in, size_t len,
+                       dma_cb_t cb, void *arg)
+{
+    dma_xfer_t rx = {
+        .src = &dev(bus)->DR,
+        .dst = in ? in : &dma_sink,
+        .len = len,
+        .dir = DMA_PERIPH_TO_MEM,
+        .width = DMA_WIDTH_BYTE,
+        .flags = in ? DMA_INC_DST : 0,
+    };
+    dma_xfer_t tx = {
+        .src = out ? out : &dma_zero,
+        .dst = &dev(bus)->DR,
+        .len = len,
+        .dir = DMA_MEM_TO_PERIPH,
+        .width = DMA_WIDTH_BYTE,
+        .flags = out ? DMA_INC_SRC : 0,
+    };
+
+    /* drop stale data, the RX stream must only see this transfer */
+    while (dev(bus)->SR & SPI_SR_RXNE) {
+        dev(bus)->DR;
+    }
+    /* the last byte is received after it was sent, so the end of the RX
+     * stream is the end of the transfer */
+    dma_start(dma[bus].rx, &rx, cb, arg);
+    dma_start(dma[bus].tx, &tx, NULL, NULL);
+    dev(bus)->CR2 |= SPI_CR2_RXDMAEN;
+    dev(bus)->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+static inline void _dma_end(spi_t bus)
+{
+    dev(bus)->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+}
+
+static void _dma_done_sync(void *arg, int res)
+{
+    (void)res;
+    mutex_unlock(arg);
+}
+
+static void _dma_done_async(void *arg, int res)
+{
+    spi_t bus = (spi_t)(uintptr_t)arg;
+    spi_cb_t cb = dma[bus].cb;
+
+    (void)res;
+    _dma_end(bus);
+    _finish(bus, dma[bus].cs, dma[bus].cont);
+    dma[bus].cb = NULL;
+    cb(dma[bus].arg);
+}
+#endif
+
 void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
                         const void *out, void *in, size_t len)
 {
@@ -161,10 +305,20 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
     volatile uint8_t *DR = (volatile uint8_t*)&(dev(bus)->DR);
 
     /* active the given chip select line */
-    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
-    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
-        gpio_clear((gpio_t)cs);
+    _select(bus, cs);
+
+#ifdef DMA_NUMOF
+    /* sleep while the DMA moves larger blocks */
+    if (_use_dma(bus, len)) {
+        mutex_t done = MUTEX_INIT_LOCKED;
+
+        _dma_start(bus, out, in, len, _dma_done_sync, &done);
+        mutex_lock(&done);
+        _dma_end(bus);
+        _finish(bus, cs, cont);
+        return;
     }
+#endif
 
     /* transfer data, use shortpath if only sending data */
     if (!inbuf) {
@@ -196,18 +350,32 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
         }
     }
 
-    /* make sure the transfer is completed before continuing, see reference
-     * manual(s) -> section 'Disabling the SPI' */
-    while (!(dev(bus)->SR & SPI_SR_TXE)) {}
-    while (dev(bus)->SR & SPI_SR_BSY) {}
+    _finish(bus, cs, cont);
+}
 
-    /* release the chip select if not specified differently */
-    if ((!cont) && (cs != SPI_CS_UNDEF)) {
-        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
-        if (cs != SPI_HWCS_MASK) {
-            gpio_set((gpio_t)cs);
-        }
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg)
+{
+    assert(cb);
+
+#ifdef DMA_NUMOF
+    if (_use_dma(bus, len)) {
+        assert(out || in);
+        assert(dma[bus].cb == NULL);
+
+        dma[bus].cs = cs;
+        dma[bus].cont = cont;
+        dma[bus].cb = cb;
+        dma[bus].arg = arg;
+        _select(bus, cs);
+        _dma_start(bus, out, in, len, _dma_done_async, (void *)(uintptr_t)bus);
+        return;
     }
+#endif
+
+    spi_transfer_bytes(bus, cs, cont, out, in, len);
+    cb(arg);
 }
 
 #endif /* SPI_NUMOF */
@@ -28,8 +28,12 @@
 #include "sched.h"
 #include "thread.h"
 #include "assert.h"
+#include "irq.h"
 #include "periph/uart.h"
 #include "periph/gpio.h"
+#ifdef DMA_NUMOF
+#include "periph/dma.h"
+#endif
 
 #ifdef UART_NUMOF
 
@@ -40,11 +44,91 @@
  */
 static uart_isr_ctx_t isr_ctx[UART_NUMOF];
 
+/**
+ * @brief   Receive state of uart_init_rx_dma()
+ */
+static struct {
+    uart_rx_span_cb_t cb;
+    void *arg;
+#ifdef DMA_NUMOF
+    uint8_t *buf;
+    uint16_t size;
+    uint16_t pos;           /* first byte not handed to cb yet */
+    dma_t dma;
+    uint8_t dma_on;
+#endif
+} rx_span[UART_NUMOF];
+
+/**
+ * @brief   State of a pending uart_write_async()
+ */
+static struct {
+    const uint8_t *data;
+    size_t len;
+    uart_tx_cb_t cb;
+    void *arg;
+} tx_async[UART_NUMOF];
+
 static inline USART_TypeDef *dev(uart_t uart)
 {
     return uart_config[uart].dev;
 }
 
+#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32L0) \
+    || defined(CPU_FAM_STM32F3) || defined(CPU_FAM_STM32L4) \
+    || defined(CPU_FAM_STM32F7)
+static inline int _txe(uart_t uart)
+{
+    return (dev(uart)->ISR & USART_ISR_TXE);
+}
+
+static inline void _put(uart_t uart, uint8_t c)
+{
+    dev(uart)->TDR = c;
+}
+#else
+static inline int _txe(uart_t uart)
+{
+    return (dev(uart)->SR & USART_SR_TXE);
+}
+
+static inline void _put(uart_t uart, uint8_t c)
+{
+    dev(uart)->DR = c;
+}
+#endif
+
+/* hand the next byte of a pending uart_write_async() to the hardware, with
+ * interrupts disabled */
+static void _tx_async_next(uart_t uart)
+{
+    _put(uart, *(tx_async[uart].data++));
+    if (--tx_async[uart].len == 0) {
+        uart_tx_cb_t cb = tx_async[uart].cb;
+
+        dev(uart)->CR1 &= ~USART_CR1_TXEIE;
+        if (cb) {
+            cb(tx_async[uart].arg);
+        }
+    }
+}
+
+/* complete pending writes by polling, returns with interrupts disabled */
+static unsigned _tx_async_wait(uart_t uart)
+{
+    unsigned state = irq_disable();
+
+    while (tx_async[uart].len) {
+        if (_txe(uart)) {
+            _tx_async_next(uart);
+        }
+        /* give other interrupts a chance in between */
+        irq_restore(state);
+        state = irq_disable();
+    }
+    return state;
+}
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     uint16_t mantissa;
@@ -53,6 +137,16 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 
     assert(uart < UART_NUMOF);
 
+#ifdef DMA_NUMOF
+    if (rx_span[uart].dma_on) {
+        rx_span[uart].dma_on = 0;
+        dma_release(rx_span[uart].dma);
+    }
+#endif
+
+    /* a pending write is aborted */
+    tx_async[uart].len = 0;
+
     /* save ISR context */
     isr_ctx[uart].rx_cb = rx_cb;
     isr_ctx[uart].arg   = arg;
@@ -119,20 +213,128 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     return UART_OK;
 }
 
-void uart_write(uart_t uart, const uint8_t *data, size_t len)
+static void _rx_one(void *arg, uint8_t data)
+{
+    uart_t uart = (uart_t)(uintptr_t)arg;
+
+    rx_span[uart].cb(rx_span[uart].arg, &data, 1);
+}
+
+#ifdef DMA_NUMOF
+/* hand everything the DMA wrote since the last call to the callback */
+static void _rx_dma_flush(uart_t uart)
 {
+    unsigned head = rx_span[uart].size - dma_remaining(rx_span[uart].dma);
+    unsigned pos = rx_span[uart].pos;
+
+    /* the stream reloads its counter at the end of the buffer */
+    if (head == rx_span[uart].size) {
+        head = 0;
+    }
+    if (head < pos) {
+        rx_span[uart].cb(rx_span[uart].arg, &rx_span[uart].buf[pos],
+                         rx_span[uart].size - pos);
+        pos = 0;
+    }
+    if (head > pos) {
+        rx_span[uart].cb(rx_span[uart].arg, &rx_span[uart].buf[pos],
+                         head - pos);
+        pos = head;
+    }
+    rx_span[uart].pos = pos;
+}
+
+static void _rx_dma_start(uart_t uart);
+
+static void _rx_dma_cb(void *arg, int res)
+{
+    uart_t uart = (uart_t)(uintptr_t)arg;
+
+    if (res == DMA_ERR) {
+        /* the stream stopped, start over at the beginning of the buffer */
+        _rx_dma_start(uart);
+        return;
+    }
+    _rx_dma_flush(uart);
+}
+
+static void _rx_dma_start(uart_t uart)
+{
+    dma_xfer_t xfer = {
+#if defined(CPU_FAM_STM32F7)
+        .src = &dev(uart)->RDR,
+#else
+        .src = &dev(uart)->DR,
+#endif
+        .dst = rx_span[uart].buf,
+        .len = rx_span[uart].size,
+        .dir = DMA_PERIPH_TO_MEM,
+        .width = DMA_WIDTH_BYTE,
+        .flags = DMA_INC_DST | DMA_CIRCULAR | DMA_HALF_IRQ,
+    };
+
+    rx_span[uart].pos = 0;
+    dma_start(rx_span[uart].dma, &xfer, _rx_dma_cb, (void *)(uintptr_t)uart);
+}
+#endif
+
+int uart_init_rx_dma(uart_t uart, uint32_t baudrate, uint8_t *buf,
+                     size_t size, uart_rx_span_cb_t rx_cb, void *arg)
+{
+    int res;
+
     assert(uart < UART_NUMOF);
 
-    for (size_t i = 0; i < len; i++) {
-#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32L0) \
-    || defined(CPU_FAM_STM32F3) || defined(CPU_FAM_STM32L4) \
-    || defined(CPU_FAM_STM32F7)
-        while (!(dev(uart)->ISR & USART_ISR_TXE)) {}
-        dev(uart)->TDR = data[i];
+    if (rx_cb == NULL) {
+        return uart_init(uart, baudrate, NULL, NULL);
+    }
+
+    /* receive byte by byte until the DMA is set up, or if there is none */
+    rx_span[uart].cb = rx_cb;
+    rx_span[uart].arg = arg;
+    res = uart_init(uart, baudrate, _rx_one, (void *)(uintptr_t)uart);
+
+#ifdef DMA_NUMOF
+    if ((res != UART_OK) || (uart_config[uart].rx_dma == 0)) {
+        return res;
+    }
+    assert((size >= 2) && (size <= DMA_MAX_LEN));
+
+    rx_span[uart].dma = dma_acquire(uart_config[uart].rx_dma);
+    if (rx_span[uart].dma == DMA_UNDEF) {
+        return res;
+    }
+    rx_span[uart].buf = buf;
+    rx_span[uart].size = size;
+    rx_span[uart].dma_on = 1;
+
+    /* hand the reception over from the RXNE interrupt to the DMA, the idle
+     * line interrupt flushes the bytes of a burst that did not fill half of
+     * the buffer */
+    dev(uart)->CR1 &= ~USART_CR1_RXNEIE;
+    dev(uart)->CR3 |= (USART_CR3_DMAR | USART_CR3_EIE);
+    _rx_dma_start(uart);
+    dev(uart)->CR1 |= USART_CR1_IDLEIE;
 #else
-        while (!(dev(uart)->SR & USART_SR_TXE)) {}
-        dev(uart)->DR = data[i];
+    (void)buf;
+    (void)size;
 #endif
+
+    return res;
+}
+
+void uart_write(uart_t uart, const uint8_t *data, size_t len)
+{
+    unsigned state;
+
+    assert(uart < UART_NUMOF);
+
+    state = _tx_async_wait(uart);
+    irq_restore(state);
+
+    for (size_t i = 0; i < len; i++) {
+        while (!_txe(uart)) {}
+        _put(uart, data[i]);
     }
 
     /* make sure the function is synchronous by waiting for the transfer to
@@ -146,6 +348,30 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
 #endif
 }
 
+void uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                      uart_tx_cb_t cb, void *arg)
+{
+    unsigned state;
+
+    assert(uart < UART_NUMOF);
+
+    state = _tx_async_wait(uart);
+    if (len == 0) {
+        irq_restore(state);
+        if (cb) {
+            cb(arg);
+        }
+        return;
+    }
+    tx_async[uart].data = data;
+    tx_async[uart].len = len;
+    tx_async[uart].cb = cb;
+    tx_async[uart].arg = arg;
+    NVIC_EnableIRQ(uart_config[uart].irqn);
+    dev(uart)->CR1 |= USART_CR1_TXEIE;
+    irq_restore(state);
+}
+
 void uart_poweron(uart_t uart)
 {
     assert(uart < UART_NUMOF);
@@ -166,27 +392,48 @@ static inline void irq_handler(uart_t uart)
 
     uint32_t status = dev(uart)->ISR;
 
-    if (status & USART_ISR_RXNE) {
+    /* with DMA, the data register is left to the DMA */
+    if ((status & USART_ISR_RXNE) && (dev(uart)->CR1 & USART_CR1_RXNEIE)) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg, (uint8_t)dev(uart)->RDR);
     }
     if (status & USART_ISR_ORE) {
         dev(uart)->ICR |= USART_ICR_ORECF;    /* simply clear flag on overrun */
     }
+#ifdef DMA_NUMOF
+    if ((status & USART_ISR_IDLE) && rx_span[uart].dma_on) {
+        dev(uart)->ICR = USART_ICR_IDLECF;
+        _rx_dma_flush(uart);
+    }
+#endif
 
 #else
 
     uint32_t status = dev(uart)->SR;
 
-    if (status & USART_SR_RXNE) {
+    /* with DMA, the data register is left to the DMA */
+    if ((status & USART_SR_RXNE) && (dev(uart)->CR1 & USART_CR1_RXNEIE)) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg, (uint8_t)dev(uart)->DR);
     }
     if (status & USART_SR_ORE) {
         /* ORE is cleared by reading SR and DR sequentially */
         dev(uart)->DR;
     }
+#ifdef DMA_NUMOF
+    if ((status & USART_SR_IDLE) && rx_span[uart].dma_on) {
+        /* and so is IDLE */
+        dev(uart)->DR;
+        _rx_dma_flush(uart);
+    }
+#endif
 
 #endif
 
+    if ((dev(uart)->CR1 & USART_CR1_TXEIE) && _txe(uart)) {
+        unsigned state = irq_disable();
+        _tx_async_next(uart);
+        irq_restore(state);
+    }
+
     cortexm_isr_end();
 }
 
@@ -81,6 +81,9 @@ extern "C" {
 #elif defined(CPU_MODEL_STM32F042K6)
 #define FLASHPAGE_NUMOF     (32U)
 #endif
+/* flashpage_write_raw() programs half-words, the erase unit stays a page */
+#define FLASHPAGE_RAW_BLOCKSIZE     (2U)
+#define FLASHPAGE_RAW_ALIGNMENT     (2U)
 /** @} */
 
 #ifdef __cplusplus
@@ -212,6 +212,27 @@ void gpio_write(gpio_t pin, int value)
     }
 }
 
+gpio_port_t gpio_port(gpio_t pin)
+{
+    return (gpio_port_t)_port(pin);
+}
+
+uint32_t gpio_port_pin_mask(gpio_t pin)
+{
+    return (1 << _pin_num(pin));
+}
+
+uint32_t gpio_port_read(gpio_port_t port)
+{
+    return ((GPIO_TypeDef *)port)->IDR;
+}
+
+void gpio_port_write_masked(gpio_port_t port, uint32_t mask, uint32_t value)
+{
+    /* the upper half of BSRR clears, the lower half sets the pins */
+    ((GPIO_TypeDef *)port)->BSRR = (((~value & mask) << 16) | (value & mask));
+}
+
 void isr_exti(void)
 {
     /* only generate interrupts against lines which have their IMR set */
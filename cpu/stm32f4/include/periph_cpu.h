@@ -75,6 +75,19 @@ typedef struct {
     uint8_t chan;           /**< CPU ADC channel connected to the pin */
 } adc_conf_t;
 
+/**
+ * @brief   Timer that triggers the conversions of adc_stream_start()
+ *
+ * The timer's TRGO output starts the conversions, so it must not be used by
+ * the timer or PWM drivers.
+ */
+typedef struct {
+    TIM_TypeDef *dev;       /**< timer */
+    uint32_t rcc_mask;      /**< bit in clock enable register */
+    uint8_t bus;            /**< APB bus */
+    uint8_t extsel;         /**< EXTSEL value of the timer's TRGO in ADC_CR2 */
+} adc_stream_conf_t;
+
 /**
  * @brief   Power on the DMA device the given stream belongs to
  *
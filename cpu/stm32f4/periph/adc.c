@@ -22,6 +22,7 @@
 #include "cpu.h"
 #include "mutex.h"
 #include "periph/adc.h"
+#include "periph/dma.h"
 #include "periph_conf.h"
 
 #ifdef ADC_CONFIG
@@ -123,6 +124,155 @@ int adc_sample(adc_t line, adc_res_t res)
     return sample;
 }
 
+#ifdef ADC_STREAM_CONFIG
+/**
+ * @brief   Multiplier of the APB clock to get the timer clock
+ */
+static const uint8_t apbmul[] = {
+#if (CLOCK_APB1 < CLOCK_CORECLOCK)
+    [APB1] = 2,
+#else
+    [APB1] = 1,
+#endif
+#if (CLOCK_APB2 < CLOCK_CORECLOCK)
+    [APB2] = 2
+#else
+    [APB2] = 1
+#endif
+};
+
+static const adc_stream_conf_t stream_config = ADC_STREAM_CONFIG;
+
+/**
+ * @brief   DMA requests of ADC1 to ADC3, all on DMA2
+ */
+static const uint16_t stream_dma[] = {
+    DMA_TRIGGER(2, 0, 0), DMA_TRIGGER(2, 2, 1), DMA_TRIGGER(2, 1, 2)
+};
+
+/**
+ * @brief   There is one trigger timer, so there is one stream at a time
+ */
+static struct {
+    adc_stream_cb_t cb;
+    void *arg;
+    uint16_t *buf;
+    size_t half;
+    adc_t line;
+    dma_t dma;
+} stream = { .dma = DMA_UNDEF };
+
+static void _stream_cb(void *arg, int res)
+{
+    (void)arg;
+
+    /* a bus error stops the DMA, the stream stays silent until stopped */
+    if (res == DMA_HALF) {
+        stream.cb(stream.arg, stream.buf, stream.half);
+    }
+    else if (res == DMA_OK) {
+        stream.cb(stream.arg, stream.buf + stream.half, stream.half);
+    }
+}
+
+int adc_stream_start(const adc_t *lines, unsigned numof, adc_res_t res,
+                     uint32_t rate, uint16_t *buf, size_t len,
+                     adc_stream_cb_t cb, void *arg)
+{
+    TIM_TypeDef *tim = stream_config.dev;
+    uint32_t ticks;
+    uint32_t psc;
+    volatile uint32_t *sqr;
+    ADC_TypeDef *adc;
+
+    /* check the parameters against what a scan sequence can do */
+    if ((numof == 0) || (numof > 16) || (res < 0xff) || (rate == 0) ||
+        (len == 0) || (len % (2 * numof)) || (len > DMA_MAX_LEN)) {
+        return -1;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if ((lines[i] >= ADC_NUMOF) ||
+            (adc_config[lines[i]].dev != adc_config[lines[0]].dev)) {
+            return -1;
+        }
+    }
+    ticks = (periph_apb_clk(stream_config.bus) * apbmul[stream_config.bus])
+            / rate;
+    if (ticks < 2) {
+        return -1;
+    }
+    if (stream.dma != DMA_UNDEF) {
+        return -2;
+    }
+
+    /* lock and power on the ADC device for the whole stream */
+    prep(lines[0]);
+    adc = dev(lines[0]);
+    stream.dma = dma_acquire(stream_dma[adc_config[lines[0]].dev]);
+    if (stream.dma == DMA_UNDEF) {
+        done(lines[0]);
+        return -2;
+    }
+    stream.cb = cb;
+    stream.arg = arg;
+    stream.buf = buf;
+    stream.half = len / 2;
+    stream.line = lines[0];
+
+    /* scan the channels in order, the sequence is filled from SQR3 on */
+    adc->CR1 = res | ADC_CR1_SCAN;
+    adc->SQR1 = (numof - 1) << 20;
+    adc->SQR2 = 0;
+    adc->SQR3 = 0;
+    for (unsigned i = 0; i < numof; i++) {
+        sqr = (i < 6) ? &adc->SQR3 : ((i < 12) ? &adc->SQR2 : &adc->SQR1);
+        *sqr |= (uint32_t)adc_config[lines[i]].chan << (5 * (i % 6));
+    }
+    adc->CR2 = (ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_EXTEN_0 |
+                (stream_config.extsel * ADC_CR2_EXTSEL_0));
+
+    dma_xfer_t xfer = {
+        .src = &adc->DR,
+        .dst = buf,
+        .len = len,
+        .dir = DMA_PERIPH_TO_MEM,
+        .width = DMA_WIDTH_HALF_WORD,
+        .flags = DMA_INC_DST | DMA_CIRCULAR | DMA_HALF_IRQ,
+    };
+    dma_start(stream.dma, &xfer, _stream_cb, NULL);
+
+    /* the timer's update event starts each scan */
+    psc = (ticks - 1) / 0x10000;
+    periph_clk_en(stream_config.bus, stream_config.rcc_mask);
+    tim->CR1 = 0;
+    tim->PSC = psc;
+    tim->ARR = (ticks / (psc + 1)) - 1;
+    tim->CR2 = TIM_CR2_MMS_1;
+    tim->EGR = TIM_EGR_UG;
+    tim->CR1 = TIM_CR1_CEN;
+
+    return 0;
+}
+
+void adc_stream_stop(adc_t line)
+{
+    if ((stream.dma == DMA_UNDEF) || (line >= ADC_NUMOF) ||
+        (adc_config[line].dev != adc_config[stream.line].dev)) {
+        return;
+    }
+
+    stream_config.dev->CR1 = 0;
+    periph_clk_dis(stream_config.bus, stream_config.rcc_mask);
+    dma_release(stream.dma);
+    stream.dma = DMA_UNDEF;
+
+    /* leave the device as adc_init() did for single conversions */
+    dev(stream.line)->CR2 = ADC_CR2_ADON;
+    dev(stream.line)->SQR1 = 0;
+    done(stream.line);
+}
+#endif /* ADC_STREAM_CONFIG */
+
 #else
 typedef int dont_be_pedantic;
 #endif /* ADC_CONFIG */
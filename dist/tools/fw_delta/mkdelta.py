@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Create a delta patch for the fw_update_delta module.
+
+    mkdelta.py <old image> <new image> <patch>
+
+The patch turns the old image into the new one. Regions of the new image that
+approximately match a region of the old one are encoded as byte-wise
+differences, which are mostly 0 for code that only moved, the rest is
+inserted as is. The patch is verified by applying it before it is written.
+
+Compress the patch with heatshrink (`heatshrink -e -w 8 -l 4`) and pass
+FW_UPDATE_COMPRESSED to fw_update_start() to fully benefit from it.
+"""
+
+import sys
+
+OP_ADD = 0x00
+OP_INSERT = 0x01
+OP_SEEK = 0x02
+
+BLOCK = 8           # length of the blocks indexed in the old image
+MIN_MATCH = 16      # shorter matches are inserted instead
+MAX_CANDIDATES = 8  # positions tried per block
+LOOKAHEAD = 64      # mismatching bytes tolerated before a match ends
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def match_len(old, new, j, i):
+    """Length of the approximate match of new[i:] at old[j:]."""
+    best, best_score, score, k = 0, 0, 0, 0
+    while (j + k < len(old)) and (i + k < len(new)):
+        score += 1 if old[j + k] == new[i + k] else -1
+        k += 1
+        if score > best_score:
+            best, best_score = k, score
+        elif k - best > LOOKAHEAD:
+            break
+    return best
+
+
+def diff(old, new):
+    index = {}
+    for j in range(len(old) - BLOCK + 1):
+        positions = index.setdefault(old[j:j + BLOCK], [])
+        if len(positions) < MAX_CANDIDATES:
+            positions.append(j)
+
+    patch = bytearray()
+    insert = bytearray()
+    src = i = 0
+
+    def flush():
+        if insert:
+            patch.append(OP_INSERT)
+            patch.extend(varint(len(insert)))
+            patch.extend(insert)
+            insert.clear()
+
+    while i < len(new):
+        # continuing at the current source position is cheapest
+        candidates = [src] + index.get(new[i:i + BLOCK], [])
+        best_j, best_len = 0, 0
+        for j in candidates:
+            length = match_len(old, new, j, i)
+            if length > best_len:
+                best_j, best_len = j, length
+        if best_len < MIN_MATCH:
+            insert.append(new[i])
+            i += 1
+            continue
+
+        flush()
+        if best_j != src:
+            patch.append(OP_SEEK)
+            patch.extend(varint(zigzag(best_j - src)))
+        patch.append(OP_ADD)
+        patch.extend(varint(best_len))
+        patch.extend((new[i + k] - old[best_j + k]) & 0xff
+                     for k in range(best_len))
+        src = best_j + best_len
+        i += best_len
+    flush()
+    return bytes(patch)
+
+
+def apply(old, patch):
+    out = bytearray()
+    src = pos = 0
+
+    def arg():
+        nonlocal pos
+        value = shift = 0
+        while True:
+            byte = patch[pos]
+            pos += 1
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    while pos < len(patch):
+        op = patch[pos]
+        pos += 1
+        value = arg()
+        if op == OP_SEEK:
+            src += (value >> 1) ^ -(value & 1)
+        elif op == OP_INSERT:
+            out.extend(patch[pos:pos + value])
+            pos += value
+        elif op == OP_ADD:
+            out.extend((patch[pos + k] + old[src + k]) & 0xff
+                       for k in range(value))
+            src += value
+            pos += value
+        else:
+            raise ValueError("unknown operation 0x%02x" % op)
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit("usage: %s <old image> <new image> <patch>" % sys.argv[0])
+
+    with open(sys.argv[1], "rb") as f:
+        old = f.read()
+    with open(sys.argv[2], "rb") as f:
+        new = f.read()
+
+    patch = diff(old, new)
+    if apply(old, patch) != new:
+        sys.exit("error: patch does not reproduce the new image")
+
+    with open(sys.argv[3], "wb") as f:
+        f.write(patch)
+    print("%u bytes, %.1f%% of the new image" %
+          (len(patch), 100.0 * len(patch) / max(len(new), 1)))
+
+
+if __name__ == "__main__":
+    main()
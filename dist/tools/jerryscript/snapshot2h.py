@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Embed JerryScript snapshots into a C header.
+
+    snapshot2h.py <header> <snapshot>...
+
+Every snapshot becomes a constant, 32-bit aligned array, so it is placed in
+flash and can be executed from there. The snapshots are named after their
+files, without the extension. The header defines
+JERRYSCRIPT_SNAPSHOTS_TABLE, the initializer of the table of all of them.
+"""
+
+import os
+import re
+import struct
+import sys
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: %s <header> <snapshot>..." % sys.argv[0])
+
+    out = ["/* generated by %s, do not edit */" % os.path.basename(sys.argv[0]),
+           ""]
+    table = []
+    for path in sys.argv[2:]:
+        name = os.path.splitext(os.path.basename(path))[0]
+        ident = "_snapshot_" + re.sub(r"\W", "_", name)
+        with open(path, "rb") as f:
+            data = f.read()
+        size = len(data)
+        data += bytes(-size % 4)
+        words = struct.unpack("<%uI" % (len(data) // 4), data)
+
+        out.append("static const uint32_t %s[] = {" % ident)
+        for i in range(0, len(words), 6):
+            out.append("    " + " ".join("0x%08x," % w for w in words[i:i + 6]))
+        out.append("};")
+        out.append("")
+        table.append('    { "%s", %s, %u },' % (name, ident, size))
+
+    out.append(" \\\n".join(["#define JERRYSCRIPT_SNAPSHOTS_TABLE"] + table))
+    out.append("")
+
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
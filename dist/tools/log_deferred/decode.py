@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Format the records of the log_deferred module.
+
+Reads the output of a node from stdin and prints it to stdout, with every
+`~L<hex>` record replaced by its formatted message. The ELF file of the
+application supplies the format strings and constant string arguments.
+
+Requires pyelftools (`pip3 install pyelftools`).
+"""
+
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+PREFIX = "~L"
+HDR_LEN = 10
+LEVELS = ["NONE", "ERROR", "WARNING", "INFO", "DEBUG", "ALL"]
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|j|z|t|L)?"
+                        r"([diouxXcsp%])")
+
+
+class Image:
+    def __init__(self, path):
+        self.sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            self.endian = "<" if elf.little_endian else ">"
+            for section in elf.iter_sections():
+                if section["sh_addr"] and section["sh_type"] == "SHT_PROGBITS":
+                    self.sections.append((section["sh_addr"], section.data()))
+
+    def string(self, addr):
+        for start, data in self.sections:
+            if start <= addr < start + len(data):
+                end = data.find(b"\0", addr - start)
+                return data[addr - start:end].decode(errors="replace")
+        return "<unknown string @ 0x%08x>" % addr
+
+
+def format_message(image, fmt, args):
+    args = list(args)
+
+    def convert(match):
+        flags, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        arg = args.pop(0) if args else 0
+        if conv == "s":
+            return ("%" + flags + "s") % image.string(arg)
+        if conv == "p":
+            return "0x%08x" % arg
+        if conv == "c":
+            return chr(arg & 0xff)
+        if conv in "di" and arg & 0x80000000:
+            arg -= 1 << 32
+        if conv == "u":
+            conv = "d"
+        return ("%" + flags + conv) % arg
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(image, record):
+    fmt, now, level, nargs = struct.unpack(image.endian + "IIBB",
+                                           record[:HDR_LEN])
+    args = struct.unpack(image.endian + "%dI" % nargs,
+                         record[HDR_LEN:HDR_LEN + 4 * nargs])
+    stamp = "[%u.%06u]" % (now // 1000000, now % 1000000)
+    if fmt == 0:
+        return "%s %u log records dropped\n" % (stamp, args[0])
+    level = LEVELS[level] if level < len(LEVELS) else str(level)
+    return "%s %s: %s" % (stamp, level, format_message(image, image.string(fmt),
+                                                        args))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <application ELF file>" % sys.argv[0])
+    image = Image(sys.argv[1])
+    for line in sys.stdin:
+        pos = line.find(PREFIX)
+        if pos < 0:
+            sys.stdout.write(line)
+        else:
+            try:
+                record = bytes.fromhex(line[pos + len(PREFIX):].strip())
+                sys.stdout.write(line[:pos] + decode(image, record))
+            except (ValueError, struct.error):
+                sys.stdout.write(line)
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/*
+ * Radio medium emulator for native nodes using netdev_medium.
+ *
+ * Nodes send their frames as datagrams to the medium's UNIX socket. For every
+ * link of the sending node in the topology, the medium drops the frame with
+ * the link's loss probability, queues it behind the frames still occupying
+ * the link at its bandwidth, and delivers it after the link's delay.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define FRAME_LEN_MAX   (127U)
+#define NODES_MAX       (4096U)
+#define QUEUE_MAX       (16U)       /* frames waiting per link */
+
+/* same layout as netdev_medium_hdr_t */
+typedef struct __attribute__((packed)) {
+    uint32_t id;
+    uint8_t chan;
+    int8_t rssi;
+    uint8_t lqi;
+    uint8_t reserved;
+} hdr_t;
+
+typedef struct {
+    double loss;                /* probability of losing a frame */
+    uint64_t delay;             /* propagation delay in us */
+    uint32_t kbps;              /* bandwidth, 0 for unlimited */
+    int rssi;                   /* in dBm */
+} link_param_t;
+
+typedef struct link {
+    struct link *next;
+    uint32_t dst;
+    link_param_t param;
+    uint64_t busy_until;        /* end of the last queued frame at the link */
+    unsigned queued;
+} link_t;
+
+typedef struct {
+    uint32_t id;
+    int registered;
+    uint8_t chan;
+    struct sockaddr_un addr;
+    socklen_t addr_len;
+    link_t *links;
+} node_t;
+
+typedef struct {
+    uint64_t time;
+    node_t *dst;
+    link_t *link;
+    size_t len;
+    uint8_t buf[sizeof(hdr_t) + FRAME_LEN_MAX];
+} event_t;
+
+static node_t *_nodes[NODES_MAX];
+static unsigned _nodes_num;
+
+static link_param_t _default;
+static int _has_default;
+
+static event_t **_heap;
+static size_t _heap_len, _heap_size;
+
+static struct {
+    unsigned long frames, delivered, lost, overflow;
+} _stats;
+
+static volatile sig_atomic_t _quit;
+
+static uint64_t _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static node_t *_node(uint32_t id, int create)
+{
+    for (unsigned i = 0; i < _nodes_num; i++) {
+        if (_nodes[i]->id == id) {
+            return _nodes[i];
+        }
+    }
+    if (!create || (_nodes_num == NODES_MAX)) {
+        return NULL;
+    }
+    node_t *node = calloc(1, sizeof(*node));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->id = id;
+    _nodes[_nodes_num++] = node;
+    return node;
+}
+
+static link_t *_link(node_t *src, uint32_t dst, int create)
+{
+    for (link_t *link = src->links; link; link = link->next) {
+        if (link->dst == dst) {
+            return link;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    link_t *link = calloc(1, sizeof(*link));
+    if (link == NULL) {
+        return NULL;
+    }
+    link->dst = dst;
+    link->param = _default;
+    link->next = src->links;
+    src->links = link;
+    return link;
+}
+
+static void _heap_push(event_t *ev)
+{
+    if (_heap_len == _heap_size) {
+        _heap_size = _heap_size ? (2 * _heap_size) : 64;
+        _heap = realloc(_heap, _heap_size * sizeof(*_heap));
+        if (_heap == NULL) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    size_t i = _heap_len++;
+    while (i && (_heap[(i - 1) / 2]->time > ev->time)) {
+        _heap[i] = _heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    _heap[i] = ev;
+}
+
+static event_t *_heap_pop(void)
+{
+    event_t *top = _heap[0];
+    event_t *last = _heap[--_heap_len];
+    size_t i = 0;
+
+    while ((2 * i) + 1 < _heap_len) {
+        size_t child = (2 * i) + 1;
+        if ((child + 1 < _heap_len) &&
+            (_heap[child + 1]->time < _heap[child]->time)) {
+            child++;
+        }
+        if (_heap[child]->time >= last->time) {
+            break;
+        }
+        _heap[i] = _heap[child];
+        i = child;
+    }
+    _heap[i] = last;
+    return top;
+}
+
+static int _parse_param(char **tok, unsigned num, link_param_t *param)
+{
+    if (num < 3) {
+        return -1;
+    }
+    param->loss = strtod(tok[0], NULL) / 100.0;
+    param->delay = strtoull(tok[1], NULL, 0);
+    param->kbps = strtoul(tok[2], NULL, 0);
+    param->rssi = (num > 3) ? atoi(tok[3]) : -60;
+    if ((param->loss < 0) || (param->loss > 1)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int _add_link(uint32_t a, uint32_t b, const link_param_t *param)
+{
+    node_t *node = _node(a, 1);
+    link_t *link;
+
+    if ((node == NULL) || ((link = _link(node, b, 1)) == NULL)) {
+        return -1;
+    }
+    link->param = *param;
+    return 0;
+}
+
+static int _load(const char *fname)
+{
+    FILE *f = fopen(fname, "r");
+    char line[256];
+    unsigned lineno = 0;
+
+    if (f == NULL) {
+        perror(fname);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        char *tok[8];
+        unsigned num = 0;
+        link_param_t param;
+
+        lineno++;
+        for (char *t = strtok(line, " \t\r\n"); t && (num < 8);
+             t = strtok(NULL, " \t\r\n")) {
+            if (t[0] == '#') {
+                break;
+            }
+            tok[num++] = t;
+        }
+        if (num == 0) {
+            continue;
+        }
+        if (strcmp(tok[0], "default") == 0) {
+            if (_parse_param(&tok[1], num - 1, &_default) < 0) {
+                goto error;
+            }
+            _has_default = 1;
+            continue;
+        }
+        /* "<a> <b> ..." is a link in both directions, "<a> > <b> ..." one
+         * from a to b */
+        int oneway = (num > 2) && (strcmp(tok[1], ">") == 0);
+        unsigned first = oneway ? 3 : 2;
+        if ((num < first) ||
+            (_parse_param(&tok[first], num - first, &param) < 0)) {
+            goto error;
+        }
+        uint32_t a = strtoul(tok[0], NULL, 0);
+        uint32_t b = strtoul(tok[first - 1], NULL, 0);
+        if ((_add_link(a, b, &param) < 0) ||
+            (!oneway && (_add_link(b, a, &param) < 0))) {
+            goto error;
+        }
+    }
+    fclose(f);
+    return 0;
+
+error:
+    fprintf(stderr, "%s:%u: invalid link\n", fname, lineno);
+    fclose(f);
+    return -1;
+}
+
+static void _transmit(node_t *src, const uint8_t *buf, size_t len,
+                      uint64_t now, link_t *link)
+{
+    node_t *dst = _node(link->dst, 0);
+
+    if ((dst == NULL) || !dst->registered || (dst->chan != src->chan)) {
+        return;
+    }
+    if ((link->param.loss > 0) &&
+        (((double)random() / RAND_MAX) < link->param.loss)) {
+        _stats.lost++;
+        return;
+    }
+    if (link->queued >= QUEUE_MAX) {
+        _stats.overflow++;
+        return;
+    }
+
+    event_t *ev = malloc(sizeof(*ev));
+    if (ev == NULL) {
+        return;
+    }
+    uint64_t start = (link->busy_until > now) ? link->busy_until : now;
+    uint64_t airtime = link->param.kbps ?
+                       (((uint64_t)len * 8 * 1000) / link->param.kbps) : 0;
+    hdr_t *hdr = (hdr_t *)ev->buf;
+
+    link->busy_until = start + airtime;
+    link->queued++;
+    ev->time = link->busy_until + link->param.delay;
+    ev->dst = dst;
+    ev->link = link;
+    ev->len = len;
+    memcpy(ev->buf, buf, len);
+    hdr->rssi = (int8_t)link->param.rssi;
+    hdr->lqi = (uint8_t)lround(255.0 * (1.0 - link->param.loss));
+    _heap_push(ev);
+}
+
+static void _receive(int sock)
+{
+    uint8_t buf[sizeof(hdr_t) + FRAME_LEN_MAX];
+    struct sockaddr_un addr;
+    socklen_t addr_len = sizeof(addr);
+    ssize_t len = recvfrom(sock, buf, sizeof(buf), 0,
+                           (struct sockaddr *)&addr, &addr_len);
+    hdr_t *hdr = (hdr_t *)buf;
+    node_t *src;
+
+    if (len < (ssize_t)sizeof(hdr_t)) {
+        return;
+    }
+    if ((src = _node(ntohl(hdr->id), 1)) == NULL) {
+        return;
+    }
+    /* every datagram updates where to find the node, it may have restarted */
+    if (!src->registered) {
+        printf("node %u joined\n", (unsigned)src->id);
+    }
+    src->registered = 1;
+    src->chan = hdr->chan;
+    src->addr = addr;
+    src->addr_len = addr_len;
+    if (len == sizeof(hdr_t)) {
+        return;
+    }
+
+    uint64_t now = _now();
+    _stats.frames++;
+    for (link_t *link = src->links; link; link = link->next) {
+        _transmit(src, buf, len, now, link);
+    }
+    if (_has_default) {
+        for (unsigned i = 0; i < _nodes_num; i++) {
+            node_t *dst = _nodes[i];
+            if ((dst != src) && dst->registered &&
+                (_link(src, dst->id, 0) == NULL)) {
+                _transmit(src, buf, len, now, _link(src, dst->id, 1));
+            }
+        }
+    }
+}
+
+static void _deliver(int sock, uint64_t now)
+{
+    while (_heap_len && (_heap[0]->time <= now)) {
+        event_t *ev = _heap_pop();
+
+        ev->link->queued--;
+        if (sendto(sock, ev->buf, ev->len, 0, (struct sockaddr *)&ev->dst->addr,
+                   ev->dst->addr_len) < 0) {
+            /* the node is gone, until it sends again */
+            if ((errno == ECONNREFUSED) || (errno == ENOENT)) {
+                ev->dst->registered = 0;
+                printf("node %u left\n", (unsigned)ev->dst->id);
+            }
+        }
+        else {
+            _stats.delivered++;
+        }
+        free(ev);
+    }
+}
+
+static void _sig_quit(int sig)
+{
+    (void)sig;
+    _quit = 1;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-s <seed>] <socket> <topology>\n\n"
+            "topology lines, loss in %%, delay in us, bandwidth in kbit/s "
+            "(0: unlimited),\n"
+            "RSSI in dBm (default: -60):\n"
+            "    <a> <b> <loss> <delay> <bandwidth> [<rssi>]    both "
+            "directions\n"
+            "    <a> > <b> <loss> <delay> <bandwidth> [<rssi>]  a to b only\n"
+            "    default <loss> <delay> <bandwidth> [<rssi>]    all other "
+            "pairs\n", name);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    unsigned seed = time(NULL);
+    int opt, sock;
+
+    while ((opt = getopt(argc, argv, "s:h")) != -1) {
+        switch (opt) {
+            case 's':
+                seed = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                _usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2) {
+        _usage(argv[0]);
+    }
+    srandom(seed);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (_load(argv[optind + 1]) < 0) {
+        return EXIT_FAILURE;
+    }
+
+    if ((sock = socket(AF_UNIX, SOCK_DGRAM, 0)) < 0) {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", argv[optind]);
+    unlink(addr.sun_path);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror(addr.sun_path);
+        return EXIT_FAILURE;
+    }
+    signal(SIGINT, _sig_quit);
+    signal(SIGTERM, _sig_quit);
+    printf("medium on %s, %u nodes in the topology, seed %u\n",
+           addr.sun_path, _nodes_num, seed);
+
+    while (!_quit) {
+        struct pollfd pfd = { .fd = sock, .events = POLLIN };
+        int timeout = -1;
+
+        if (_heap_len) {
+            uint64_t now = _now();
+            timeout = (_heap[0]->time > now) ?
+                      (int)((_heap[0]->time - now + 999) / 1000) : 0;
+        }
+        if ((poll(&pfd, 1, timeout) > 0) && (pfd.revents & POLLIN)) {
+            _receive(sock);
+        }
+        _deliver(sock, _now());
+    }
+
+    printf("\n%lu frames sent, %lu delivered, %lu lost, %lu queue overflows\n",
+           _stats.frames, _stats.delivered, _stats.lost, _stats.overflow);
+    unlink(addr.sun_path);
+    return EXIT_SUCCESS;
+}
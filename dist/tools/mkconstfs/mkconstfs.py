@@ -20,7 +20,8 @@ def mkconstfs(root_path, mount_point, constfs_name):
 
     print("\nstatic const constfs_file_t _files[] = {")
 
-    for mangled_name, target_name, _ in files:
+    # sorted by path, so constfs can use a binary search
+    for mangled_name, target_name, _ in sorted(files, key=lambda f: f[1].encode()):
         print("    {")
         print("    .path = \"%s\"," % target_name)
         print("    .data = %s," % mangled_name)
@@ -32,6 +33,7 @@ def mkconstfs(root_path, mount_point, constfs_name):
 static const constfs_t _fs_data = {
     .files = _files,
     .nfiles = sizeof(_files) / sizeof(_files[0]),
+    .sorted = true,
 };
 
 vfs_mount_t %s = {
@@ -0,0 +1,178 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Converts the record stream of RIOT's gnrc_pcap module into a pcap file.
+
+Each record is a frame delimited by 0x7E, with 0x7E and 0x7D escaped as 0x7D
+followed by the byte XOR 0x20. It starts with a 16 byte header in network byte
+order: seconds, microseconds, original length, packets dropped before, the
+interface, RSSI, LQI and a reserved byte. Bytes outside of frames are text,
+e.g. the shell sharing the UART, and are passed to stderr.
+
+With the IEEE 802.15.4 TAP link type, RSSI and LQI are kept in the TLVs of the
+TAP header. The RSSI is the device specific raw value, not dBm.
+'''
+
+from __future__ import print_function
+import argparse
+import socket
+import struct
+import sys
+
+FRAME_DELIMITER = 0x7E
+FRAME_ESC_CHAR = 0x7D
+
+HDR = struct.Struct('>IIHHBBBB')
+
+LINKTYPES = {
+    'ethernet': 1,
+    'ieee802154': 230,      # 802.15.4 without FCS
+    'ieee802154_tap': 283,  # 802.15.4 with TAP header, without FCS
+}
+
+TAP_FCS_TYPE = 0
+TAP_RSS = 1
+TAP_LQI = 10
+
+
+def pcap_header(linktype, snaplen=0xffff):
+    return struct.pack('<IHHiIII', 0xa1b2c3d4, 2, 4, 0, 0, snaplen, linktype)
+
+
+def tap_header(rssi, lqi):
+    tlvs = struct.pack('<HHI', TAP_FCS_TYPE, 1, 0)
+    tlvs += struct.pack('<HHf', TAP_RSS, 4, float(rssi))
+    tlvs += struct.pack('<HHBxxx', TAP_LQI, 1, lqi)
+    return struct.pack('<BBH', 0, 0, 4 + len(tlvs)) + tlvs
+
+
+class Deframer(object):
+    def __init__(self, on_frame, on_text):
+        self.on_frame = on_frame
+        self.on_text = on_text
+        self.frame = None
+        self.escape = False
+
+    def feed(self, data):
+        text = bytearray()
+        for c in bytearray(data):
+            if self.frame is None:
+                if c == FRAME_DELIMITER:
+                    self.frame = bytearray()
+                else:
+                    text.append(c)
+            elif c == FRAME_DELIMITER:
+                if not len(self.frame):
+                    # the end of a record and the start of the next one
+                    continue
+                if self.on_frame(bytes(self.frame)):
+                    self.frame = None
+                else:
+                    # started reading in the middle of a record, or text
+                    # containing a delimiter: this one may start a record
+                    text += self.frame
+                    self.frame = bytearray()
+                self.escape = False
+            elif self.escape:
+                self.frame.append(c ^ 0x20)
+                self.escape = False
+            elif c == FRAME_ESC_CHAR:
+                self.escape = True
+            else:
+                self.frame.append(c)
+        if text:
+            self.on_text(bytes(text))
+
+
+class Writer(object):
+    def __init__(self, out, linktype):
+        self.out = out
+        self.linktype = linktype
+        self.count = 0
+        self.dropped = 0
+        self.invalid = 0
+        out.write(pcap_header(linktype))
+        out.flush()
+
+    def record(self, frame):
+        if len(frame) < HDR.size:
+            self.invalid += 1
+            return False
+        (sec, usec, length, dropped, _, rssi, lqi,
+         reserved) = HDR.unpack_from(frame)
+        data = frame[HDR.size:]
+        if (len(data) > length) or (usec >= 1000000) or reserved:
+            # text interleaved with the frame or a lost delimiter
+            self.invalid += 1
+            return False
+        if self.linktype == LINKTYPES['ieee802154_tap']:
+            tap = tap_header(rssi, lqi)
+            data = tap + data
+            length += len(tap)
+        self.out.write(struct.pack('<IIII', sec, usec, len(data), length))
+        self.out.write(data)
+        self.out.flush()
+        self.count += 1
+        self.dropped += dropped
+        sys.stderr.write("RX: %i, dropped: %i, invalid: %i\r" %
+                         (self.count, self.dropped, self.invalid))
+        return True
+
+
+def connect(args):
+    if args.conn == 'serial':
+        from serial import Serial
+        try:
+            conn = Serial(args.target, args.baudrate, dsrdtr=0, rtscts=0,
+                          timeout=1)
+        except IOError:
+            print("error opening serial port", file=sys.stderr)
+            sys.exit(2)
+        return conn.read
+    try:
+        sock = socket.create_connection((args.target, args.baudrate))
+    except IOError:
+        print("error connecting to %s:%s" % (args.target, args.baudrate),
+              file=sys.stderr)
+        sys.exit(2)
+    return sock.recv
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('conn', choices=['serial', 'socket'])
+    parser.add_argument('target', help="tty or host")
+    parser.add_argument('baudrate', type=int, help="baudrate or port")
+    parser.add_argument('outfile', nargs='?', help="default: stdout")
+    parser.add_argument('-l', '--linktype', choices=sorted(LINKTYPES),
+                        default='ieee802154_tap')
+    args = parser.parse_args()
+
+    read = connect(args)
+    if args.outfile:
+        out = open(args.outfile, 'w+b')
+    elif sys.version_info > (3,):
+        out = sys.stdout.buffer
+    else:
+        out = sys.stdout
+    writer = Writer(out, LINKTYPES[args.linktype])
+    stderr = getattr(sys.stderr, 'buffer', sys.stderr)
+    deframer = Deframer(writer.record, stderr.write)
+
+    try:
+        while True:
+            deframer.feed(read(4096))
+    except KeyboardInterrupt:
+        print(file=sys.stderr)
+        sys.exit(0)
+
+
+if __name__ == "__main__":
+    main()
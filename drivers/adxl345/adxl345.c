@@ -34,6 +34,14 @@
 #define BUS                 (dev->i2c)
 #define ADDR                (dev->addr)
 
+static void _convert(const adxl345_t *dev, const uint8_t *raw,
+                     adxl345_data_t *data)
+{
+    data->x = ((int16_t)((raw[1] << 8) | raw[0]) * dev->scale_factor);
+    data->y = ((int16_t)((raw[3] << 8) | raw[2]) * dev->scale_factor);
+    data->z = ((int16_t)((raw[5] << 8) | raw[4]) * dev->scale_factor);
+}
+
 int adxl345_init(adxl345_t *dev, const adxl345_params_t* params)
 {
     uint8_t reg;
@@ -82,7 +90,7 @@ int adxl345_init(adxl345_t *dev, const adxl345_params_t* params)
 
 void adxl345_read(const adxl345_t *dev, adxl345_data_t *data)
 {
-    int8_t result[6];
+    uint8_t result[6];
 
     assert(dev && data);
 
@@ -90,9 +98,98 @@ void adxl345_read(const adxl345_t *dev, adxl345_data_t *data)
     i2c_read_regs(BUS, ADDR, ACCEL_ADXL345_DATA_X0, result, 6);
     i2c_release(BUS);
 
-    data->x = (((result[1] << 8)+result[0]) * dev->scale_factor);
-    data->y = (((result[3] << 8)+result[2]) * dev->scale_factor);
-    data->z = (((result[5] << 8)+result[4]) * dev->scale_factor);
+    _convert(dev, result, data);
+}
+
+int adxl345_read_fifo(const adxl345_t *dev, adxl345_data_t *data, size_t numof)
+{
+    uint8_t reg;
+    uint8_t result[6];
+    size_t num;
+
+    assert(dev && data);
+
+    i2c_acquire(BUS);
+    if (i2c_read_reg(BUS, ADDR, ACCEL_ADXL345_FIFO_STATUS, &reg) != 1) {
+        i2c_release(BUS);
+        return ADXL345_NOI2C;
+    }
+    num = reg & FIFO_ENTRIES_MASK;
+    if (num > numof) {
+        num = numof;
+    }
+    /* each read of the data registers pops one sample */
+    for (size_t i = 0; i < num; i++) {
+        if (i2c_read_regs(BUS, ADDR, ACCEL_ADXL345_DATA_X0, result, 6) != 6) {
+            i2c_release(BUS);
+            return ADXL345_NOI2C;
+        }
+        _convert(dev, result, &data[i]);
+    }
+    i2c_release(BUS);
+
+    return (int)num;
+}
+
+int adxl345_fifo_start(const adxl345_t *dev, uint8_t watermark,
+                       gpio_cb_t cb, void *arg)
+{
+    uint8_t reg;
+
+    assert(dev && (watermark > 0) && (watermark <= SAMPLES_MASK));
+
+    if (dev->params->int1 == GPIO_UNDEF) {
+        return ADXL345_NOINT;
+    }
+
+    DEBUG("[adxl345] stream to fifo, watermark %d\n", (int)watermark);
+
+    i2c_acquire(BUS);
+    /* bypass mode empties the FIFO, so INT1 is low when the IRQ is set up */
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_FIFO_CTL, BYPASS << FIFO_MODE_POS);
+    if (gpio_init_int(dev->params->int1, GPIO_IN, GPIO_RISING, cb, arg) < 0) {
+        i2c_release(BUS);
+        return ADXL345_NOINT;
+    }
+    /* a cleared bit maps the interrupt to INT1 */
+    i2c_read_reg(BUS, ADDR, ACCEL_ADXL345_INT_MAP, &reg);
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_INT_MAP, reg & ~WATERMARK);
+    i2c_read_reg(BUS, ADDR, ACCEL_ADXL345_INT_ENABLE, &reg);
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_INT_ENABLE, reg | WATERMARK);
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_FIFO_CTL,
+                  (STREAM << FIFO_MODE_POS) | watermark);
+    i2c_release(BUS);
+
+    return ADXL345_OK;
+}
+
+void adxl345_fifo_stop(const adxl345_t *dev)
+{
+    uint8_t reg;
+
+    assert(dev);
+
+    gpio_irq_disable(dev->params->int1);
+
+    i2c_acquire(BUS);
+    i2c_read_reg(BUS, ADDR, ACCEL_ADXL345_INT_ENABLE, &reg);
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_INT_ENABLE, reg & ~WATERMARK);
+    i2c_write_reg(BUS, ADDR, ACCEL_ADXL345_FIFO_CTL, BYPASS << FIFO_MODE_POS);
+    i2c_release(BUS);
+}
+
+uint32_t adxl345_get_period(const adxl345_t *dev)
+{
+    uint8_t reg;
+
+    assert(dev);
+
+    i2c_acquire(BUS);
+    i2c_read_reg(BUS, ADDR, ACCEL_ADXL345_BW_RATE, &reg);
+    i2c_release(BUS);
+
+    /* the rate doubles from 0.1Hz at 0 to 3200Hz at 15 */
+    return (10000UL << (ADXL345_RATE_3200HZ - (reg & RATE_MASK))) / 32;
 }
 
 void adxl345_set_interrupt(const adxl345_t *dev)
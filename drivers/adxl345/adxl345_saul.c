@@ -30,8 +30,52 @@ static int read_acc(const void *dev, phydat_t *res)
     return 3;
 }
 
+static int fifo_start(const void *dev, unsigned watermark,
+                      saul_notify_t cb, void *arg)
+{
+    if ((watermark == 0) || (watermark > 31)) {
+        return -ECANCELED;
+    }
+    if (adxl345_fifo_start((const adxl345_t *)dev, watermark,
+                           cb, arg) != ADXL345_OK) {
+        return -ENOTSUP;
+    }
+    return 0;
+}
+
+static void fifo_stop(const void *dev)
+{
+    adxl345_fifo_stop((const adxl345_t *)dev);
+}
+
+static int fifo_read(const void *dev, phydat_t *res, size_t numof,
+                     uint32_t *period)
+{
+    int num = adxl345_read_fifo((const adxl345_t *)dev,
+                                (adxl345_data_t *)res, numof);
+    if (num < 0) {
+        return -ECANCELED;
+    }
+
+    saul_fifo_unpack(res, num);
+    for (int i = 0; i < num; i++) {
+        res[i].unit = UNIT_G;
+        res[i].scale = -3;
+    }
+    *period = adxl345_get_period((const adxl345_t *)dev);
+
+    return num;
+}
+
+static const saul_fifo_t adxl345_saul_fifo = {
+    .start = fifo_start,
+    .stop = fifo_stop,
+    .read = fifo_read,
+};
+
 const saul_driver_t adxl345_saul_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .fifo = &adxl345_saul_fifo,
 };
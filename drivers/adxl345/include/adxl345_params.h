@@ -50,6 +50,12 @@ extern "C" {
 #ifndef ADXL345_PARAM_FULL_RES
 #define ADXL345_PARAM_FULL_RES      (1)
 #endif
+#ifndef ADXL345_PARAM_INT1
+#define ADXL345_PARAM_INT1          (GPIO_UNDEF)
+#endif
+#ifndef ADXL345_PARAM_INT2
+#define ADXL345_PARAM_INT2          (GPIO_UNDEF)
+#endif
 #ifndef ADXL345_PARAM_OFFSET
 #define ADXL345_PARAM_OFFSET        { 0, 0, 0 }
 #endif
@@ -57,7 +63,9 @@ extern "C" {
 #define ADXL345_PARAM_SCALE_FACTOR  (3.9)
 #endif
 #ifndef ADXL345_PARAMS
-#define ADXL345_PARAMS              { .offset = ADXL345_PARAM_OFFSET,    \
+#define ADXL345_PARAMS              { .int1   = ADXL345_PARAM_INT1,      \
+                                      .int2   = ADXL345_PARAM_INT2,      \
+                                      .offset = ADXL345_PARAM_OFFSET,    \
                                       .range  = ADXL345_PARAM_RANGE,     \
                                       .rate   = ADXL345_PARAM_RATE,      \
                                       .full_res = ADXL345_PARAM_FULL_RES }
@@ -166,8 +166,8 @@
  * @name bits definitions for FIFO_CTL register
  * @{
  */
-#define SAMPLES_MASK      (0x0F)
-#define FIFO_TRIGGER_POS  (4)
+#define SAMPLES_MASK      (0x1F)
+#define FIFO_TRIGGER_POS  (5)
 #define FIFO_TRIGGER      (1 << FIFO_TRIGGER_POS)
 #define FIFO_MODE_POS     (6)
 #define FIFO_MODE_MASK    (0xC0)
@@ -100,6 +100,10 @@ void at86rf2xx_reset(at86rf2xx_t *dev)
     /* don't populate masked interrupt flags to IRQ_STATUS register */
     uint8_t tmp = at86rf2xx_reg_read(dev, AT86RF2XX_REG__TRX_CTRL_1);
     tmp &= ~(AT86RF2XX_TRX_CTRL_1_MASK__IRQ_MASK_MODE);
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+    /* signal on the IRQ pin when reading overtakes the reception */
+    tmp |= AT86RF2XX_TRX_CTRL_1_MASK__RX_BL_CTRL;
+#endif
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__TRX_CTRL_1, tmp);
 
     /* disable clock output to save power */
@@ -110,8 +114,16 @@ void at86rf2xx_reset(at86rf2xx_t *dev)
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__TRX_CTRL_0, tmp);
 
     /* enable interrupts */
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+    /* frames are read from their start on */
+    dev->rx_len = 0;
+    at86rf2xx_reg_write(dev, AT86RF2XX_REG__IRQ_MASK,
+                        AT86RF2XX_IRQ_STATUS_MASK__TRX_END |
+                        AT86RF2XX_IRQ_STATUS_MASK__RX_START);
+#else
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__IRQ_MASK,
                         AT86RF2XX_IRQ_STATUS_MASK__TRX_END);
+#endif
     /* clear interrupt flags */
     at86rf2xx_reg_read(dev, AT86RF2XX_REG__IRQ_STATUS);
 
@@ -146,6 +146,25 @@ void at86rf2xx_set_chan(at86rf2xx_t *dev, uint8_t channel)
 
     dev->netdev.chan = channel;
 
+#ifndef MODULE_AT86RF212B
+    /* the PLL of the 2.4 GHz radios follows a channel change in any of the
+     * idle states within a few microseconds, so there is no need to leave
+     * them for TRX_OFF as for a change of the PHY mode */
+    uint8_t state = at86rf2xx_get_status(dev);
+
+    if ((state == AT86RF2XX_STATE_TRX_OFF) ||
+        (state == AT86RF2XX_STATE_PLL_ON) ||
+        (state == AT86RF2XX_STATE_RX_AACK_ON) ||
+        (state == AT86RF2XX_STATE_TX_ARET_ON)) {
+        uint8_t phy_cc_cca = at86rf2xx_reg_read(dev, AT86RF2XX_REG__PHY_CC_CCA);
+
+        phy_cc_cca &= ~(AT86RF2XX_PHY_CC_CCA_MASK__CHANNEL);
+        phy_cc_cca |= (channel & AT86RF2XX_PHY_CC_CCA_MASK__CHANNEL);
+        at86rf2xx_reg_write(dev, AT86RF2XX_REG__PHY_CC_CCA, phy_cc_cca);
+        return;
+    }
+#endif
+
     at86rf2xx_configure_phy(dev);
 }
 
@@ -328,6 +347,32 @@ void at86rf2xx_set_cca_threshold(at86rf2xx_t *dev, int8_t value)
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__CCA_THRES, value);
 }
 
+bool at86rf2xx_cca(at86rf2xx_t *dev)
+{
+    uint8_t reg;
+    uint8_t old_state = at86rf2xx_set_state(dev, AT86RF2XX_STATE_TRX_OFF);
+    uint8_t rx_syn = at86rf2xx_reg_read(dev, AT86RF2XX_REG__RX_SYN);
+
+    /* a manual CCA needs the basic operating mode: keep the receiver from
+     * detecting frames meanwhile, as they would end in the frame buffer */
+    at86rf2xx_reg_write(dev, AT86RF2XX_REG__RX_SYN,
+                        rx_syn | AT86RF2XX_RX_SYN__RX_PDT_DIS);
+    at86rf2xx_set_state(dev, AT86RF2XX_TRX_STATE__RX_ON);
+
+    reg = at86rf2xx_reg_read(dev, AT86RF2XX_REG__PHY_CC_CCA);
+    at86rf2xx_reg_write(dev, AT86RF2XX_REG__PHY_CC_CCA,
+                        reg | AT86RF2XX_PHY_CC_CCA_MASK__CCA_REQUEST);
+    do {
+        reg = at86rf2xx_reg_read(dev, AT86RF2XX_REG__TRX_STATUS);
+    } while (!(reg & AT86RF2XX_TRX_STATUS_MASK__CCA_DONE));
+
+    at86rf2xx_set_state(dev, AT86RF2XX_STATE_TRX_OFF);
+    at86rf2xx_reg_write(dev, AT86RF2XX_REG__RX_SYN, rx_syn);
+    at86rf2xx_set_state(dev, old_state);
+
+    return (reg & AT86RF2XX_TRX_STATUS_MASK__CCA_STATUS);
+}
+
 void at86rf2xx_set_option(at86rf2xx_t *dev, uint16_t option, bool state)
 {
     uint8_t tmp;
@@ -418,10 +463,13 @@ void at86rf2xx_set_option(at86rf2xx_t *dev, uint16_t option, bool state)
                 at86rf2xx_reg_write(dev, AT86RF2XX_REG__CSMA_SEED_1, tmp);
                 break;
             case AT86RF2XX_OPT_TELL_RX_START:
+#ifndef MODULE_AT86RF2XX_RX_STREAM
+                /* with at86rf2xx_rx_stream the IRQ starts reading the frame */
                 DEBUG("[at86rf2xx] opt: disabling SFD IRQ\n");
                 tmp = at86rf2xx_reg_read(dev, AT86RF2XX_REG__IRQ_MASK);
                 tmp &= ~AT86RF2XX_IRQ_STATUS_MASK__RX_START;
                 at86rf2xx_reg_write(dev, AT86RF2XX_REG__IRQ_MASK, tmp);
+#endif
                 break;
             default:
                 /* do nothing */
@@ -22,6 +22,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "periph/spi.h"
 #include "periph/gpio.h"
 #include "xtimer.h"
@@ -64,11 +66,10 @@ void at86rf2xx_sram_read(const at86rf2xx_t *dev,
                          uint8_t *data,
                          const size_t len)
 {
-    uint8_t reg = (AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_READ);
+    uint8_t cmd[] = { (AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_READ), offset };
 
     getbus(dev);
-    spi_transfer_byte(SPIDEV, CSPIN, true, reg);
-    spi_transfer_byte(SPIDEV, CSPIN, true, offset);
+    spi_transfer_bytes(SPIDEV, CSPIN, true, cmd, NULL, sizeof(cmd));
     spi_transfer_bytes(SPIDEV, CSPIN, false, NULL, data, len);
     spi_release(SPIDEV);
 }
@@ -78,11 +79,10 @@ void at86rf2xx_sram_write(const at86rf2xx_t *dev,
                           const uint8_t *data,
                           const size_t len)
 {
-    uint8_t reg = (AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_WRITE);
+    uint8_t cmd[] = { (AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_WRITE), offset };
 
     getbus(dev);
-    spi_transfer_byte(SPIDEV, CSPIN, true, reg);
-    spi_transfer_byte(SPIDEV, CSPIN, true, offset);
+    spi_transfer_bytes(SPIDEV, CSPIN, true, cmd, NULL, sizeof(cmd));
     spi_transfer_bytes(SPIDEV, CSPIN, false, data, NULL, len);
     spi_release(SPIDEV);
 }
@@ -102,6 +102,27 @@ void at86rf2xx_fb_read(const at86rf2xx_t *dev,
     spi_transfer_bytes(SPIDEV, CSPIN, true, NULL, data, len);
 }
 
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+int at86rf2xx_fb_read_stream(const at86rf2xx_t *dev,
+                             uint8_t *data,
+                             const size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint32_t start = xtimer_now_usec();
+
+        /* the frame buffer empty indicator keeps the IRQ pin high until the
+         * transceiver received the next byte */
+        while (gpio_read(dev->params.int_pin)) {
+            if ((xtimer_now_usec() - start) > AT86RF2XX_RX_STREAM_TIMEOUT_US) {
+                return -ETIMEDOUT;
+            }
+        }
+        data[i] = spi_transfer_byte(SPIDEV, CSPIN, true, 0);
+    }
+    return 0;
+}
+#endif
+
 void at86rf2xx_fb_stop(const at86rf2xx_t *dev)
 {
     /* transfer one byte (which we ignore) to release the chip select */
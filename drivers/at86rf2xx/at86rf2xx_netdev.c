@@ -124,12 +124,122 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
     return (int)len;
 }
 
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+/* checks the destination of a frame the transceiver would not acknowledge
+ * nor report */
+static bool _dst_match(at86rf2xx_t *dev, const uint8_t *mhr)
+{
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+    uint16_t pan;
+    int dst_len = ieee802154_get_dst(mhr, dst, &dst_pan);
+
+    if (dst_len <= 0) {
+        /* frames without destination are filtered by the transceiver */
+        return (dst_len == 0);
+    }
+    pan = byteorder_ntohs(byteorder_ltobs(dst_pan));
+    if ((pan != dev->netdev.pan) && (pan != 0xffff)) {
+        return false;
+    }
+    if (dst_len == IEEE802154_SHORT_ADDRESS_LEN) {
+        return (memcmp(dst, ieee802154_addr_bcast, dst_len) == 0) ||
+               (memcmp(dst, dev->netdev.short_addr, dst_len) == 0);
+    }
+    return (memcmp(dst, dev->netdev.long_addr, dst_len) == 0);
+}
+
+/* Reads a frame from its start on while the transceiver still receives it */
+static void _rx_stream(at86rf2xx_t *dev)
+{
+    uint8_t phr, tmp[IEEE802154_FCS_LEN];
+    size_t pkt_len, hdr_len;
+
+    dev->rx_len = 0;
+    /* the IRQ pin indicates an empty frame buffer while streaming */
+    gpio_irq_disable(dev->params.int_pin);
+    at86rf2xx_fb_start(dev);
+    /* the PHR is known at RX_START already */
+    at86rf2xx_fb_read(dev, &phr, 1);
+    pkt_len = (phr & 0x7f);
+    if ((pkt_len < (IEEE802154_FCF_LEN + 1 + IEEE802154_FCS_LEN)) ||
+        (at86rf2xx_fb_read_stream(dev, dev->rx_buf, IEEE802154_FCF_LEN + 1) < 0)) {
+        goto out;
+    }
+    pkt_len -= IEEE802154_FCS_LEN;
+    hdr_len = ieee802154_get_frame_hdr_len(dev->rx_buf);
+    if ((hdr_len == 0) || (hdr_len > pkt_len) ||
+        (at86rf2xx_fb_read_stream(dev, &dev->rx_buf[IEEE802154_FCF_LEN + 1],
+                                  hdr_len - (IEEE802154_FCF_LEN + 1)) < 0)) {
+        goto out;
+    }
+    if (!(dev->netdev.flags & AT86RF2XX_OPT_PROMISCUOUS) &&
+        !_dst_match(dev, dev->rx_buf)) {
+        DEBUG("[at86rf2xx] stream: frame for other destination\n");
+        goto out;
+    }
+    if ((at86rf2xx_fb_read_stream(dev, &dev->rx_buf[hdr_len], pkt_len - hdr_len) < 0) ||
+        (at86rf2xx_fb_read_stream(dev, tmp, sizeof(tmp)) < 0) ||
+        (at86rf2xx_fb_read_stream(dev, &dev->rx_lqi, 1) < 0)) {
+        goto out;
+    }
+#ifndef MODULE_AT86RF231
+    if (at86rf2xx_fb_read_stream(dev, &dev->rx_rssi, 1) < 0) {
+        goto out;
+    }
+#endif
+    dev->rx_len = pkt_len;
+out:
+    at86rf2xx_fb_stop(dev);
+    gpio_irq_enable(dev->params.int_pin);
+#ifdef MODULE_AT86RF231
+    if (dev->rx_len > 0) {
+        dev->rx_rssi = at86rf2xx_reg_read(dev, AT86RF2XX_REG__PHY_ED_LEVEL);
+    }
+#endif
+}
+
+static int _recv_stream(at86rf2xx_t *dev, void *buf, size_t len, void *info)
+{
+    size_t pkt_len = dev->rx_len;
+
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop the frame */
+            dev->rx_len = 0;
+        }
+        return pkt_len;
+    }
+    dev->rx_len = 0;
+    if (pkt_len > len) {
+        return -ENOBUFS;
+    }
+#ifdef MODULE_NETSTATS_L2
+    dev->netdev.netdev.stats.rx_count++;
+    dev->netdev.netdev.stats.rx_bytes += pkt_len;
+#endif
+    memcpy(buf, dev->rx_buf, pkt_len);
+    if (info != NULL) {
+        netdev_ieee802154_rx_info_t *radio_info = info;
+
+        radio_info->lqi = dev->rx_lqi;
+        radio_info->rssi = dev->rx_rssi;
+    }
+    return pkt_len;
+}
+#endif
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
     uint8_t phr;
     size_t pkt_len;
 
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+    if (dev->rx_len > 0) {
+        return _recv_stream(dev, buf, len, info);
+    }
+#endif
     /* frame buffer protection will be unlocked as soon as at86rf2xx_fb_stop()
      * is called*/
     at86rf2xx_fb_start(dev);
@@ -328,6 +438,23 @@ static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
             res = sizeof(uint8_t);
             break;
 
+#ifdef AT86RF2XX_REG__XAH_CTRL_2
+        case NETOPT_TX_RETRIES_NEEDED:
+            assert(max_len >= sizeof(uint8_t));
+            *((uint8_t *)val) = (at86rf2xx_reg_read(dev, AT86RF2XX_REG__XAH_CTRL_2) &
+                                 AT86RF2XX_XAH_CTRL_2__ARET_FRAME_RETRIES_MASK) >>
+                                AT86RF2XX_XAH_CTRL_2__ARET_FRAME_RETRIES_OFFSET;
+            res = sizeof(uint8_t);
+            break;
+#endif
+
+        case NETOPT_IS_CHANNEL_CLR:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)val) = at86rf2xx_cca(dev) ? NETOPT_ENABLE
+                                                           : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
+
         case NETOPT_CCA_THRESHOLD:
             assert(max_len >= sizeof(int8_t));
             *((int8_t *)val) = at86rf2xx_get_cca_threshold(dev);
@@ -432,9 +559,11 @@ static int _set(netdev_t *netdev, netopt_t opt, void *val, size_t len)
             /* don't set res to set netdev_ieee802154_t::flags */
             break;
 
-		case NETOPT_ACK_PENDING:
-			at86rf2xx_set_option(dev, AT86RF2XX_OPT_ACK_PENDING,
-						         ((bool *)val)[0]);
+        case NETOPT_ACK_PENDING:
+            /* no source address matching, the bit is set for all sources */
+            at86rf2xx_set_option(dev, AT86RF2XX_OPT_ACK_PENDING,
+                                 ((bool *)val)[0]);
+            res = sizeof(netopt_enable_t);
             break;
 
         case NETOPT_RETRANS:
@@ -544,7 +673,19 @@ static void _isr(netdev_t *netdev)
                   AT86RF2XX_TRX_STATE_MASK__TRAC;
 
     if (irq_mask & AT86RF2XX_IRQ_STATUS_MASK__RX_START) {
+#ifdef MODULE_AT86RF2XX_RX_STREAM
+        if (dev->netdev.flags & AT86RF2XX_OPT_TELL_RX_START) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_STARTED);
+        }
+        if (state == AT86RF2XX_STATE_BUSY_RX_AACK) {
+            _rx_stream(dev);
+            /* the frame may have ended while streaming */
+            irq_mask |= at86rf2xx_reg_read(dev, AT86RF2XX_REG__IRQ_STATUS);
+            state = at86rf2xx_get_status(dev);
+        }
+#else
         netdev->event_callback(netdev, NETDEV_EVENT_RX_STARTED);
+#endif
         DEBUG("[at86rf2xx] EVT - RX_START\n");
     }
 
@@ -119,6 +119,27 @@ void at86rf2xx_fb_start(const at86rf2xx_t *dev);
 void at86rf2xx_fb_read(const at86rf2xx_t *dev,
                        uint8_t *data, const size_t len);
 
+#if defined(MODULE_AT86RF2XX_RX_STREAM) || defined(DOXYGEN)
+/**
+ * @brief   Read the internal frame buffer of the given device while a frame is
+ *          still being received
+ *
+ * Each byte is read as soon as the frame buffer empty indicator on the IRQ
+ * pin shows that it was received, so the IRQ of the device must be disabled
+ * during the read.
+ *
+ * @param[in]  dev      device to read from
+ * @param[out] data     buffer to copy the data to
+ * @param[in]  len      number of bytes to read from the frame buffer
+ *
+ * @return  0 on success
+ * @return  -ETIMEDOUT if a byte did not arrive within
+ *          @ref AT86RF2XX_RX_STREAM_TIMEOUT_US
+ */
+int at86rf2xx_fb_read_stream(const at86rf2xx_t *dev,
+                             uint8_t *data, const size_t len);
+#endif
+
 /**
  * @brief   Stop a read transcation internal frame buffer of the given device
  *
@@ -116,6 +116,9 @@ extern "C" {
 #define AT86RF2XX_REG__CSMA_SEED_1                              (0x2E)
 #define AT86RF2XX_REG__CSMA_BE                                  (0x2F)
 #define AT86RF2XX_REG__TST_CTRL_DIGI                            (0x36)
+#if defined(MODULE_AT86RF232) || defined(MODULE_AT86RF233)
+#define AT86RF2XX_REG__XAH_CTRL_2                               (0x37)
+#endif
 /** @} */
 
 /**
@@ -242,6 +245,13 @@ extern "C" {
 #define AT86RF2XX_PHY_CC_CCA_DEFAULT__CCA_MODE                  (0x20)
 /** @} */
 
+/**
+ * @brief   Bitfield definitions for the RX_SYN register
+ * @{
+ */
+#define AT86RF2XX_RX_SYN__RX_PDT_DIS                            (0x80)
+/** @} */
+
 /**
  * @brief   Bitfield definitions for the CCA_THRES register
  * @{
@@ -310,6 +320,15 @@ extern "C" {
 #define AT86RF2XX_XAH_CTRL_0__SLOTTED_OPERATION                 (0x01)
 /** @} */
 
+/**
+ * @brief   Bitfield definitions for the XAH_CTRL_2 register
+ * @{
+ */
+#define AT86RF2XX_XAH_CTRL_2__ARET_FRAME_RETRIES_MASK           (0xF0)
+#define AT86RF2XX_XAH_CTRL_2__ARET_FRAME_RETRIES_OFFSET         (4U)
+#define AT86RF2XX_XAH_CTRL_2__ARET_CSMA_RETRIES_MASK            (0x0E)
+/** @} */
+
 /**
  * @brief   Bitfield definitions for the XAH_CTRL_1 register
  * @{
@@ -114,6 +114,10 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t value_len)
             return 1;
         case NETOPT_IPV6_IID:
             return _get_iid(dev, value, value_len);
+        case NETOPT_LISTEN_INTERVAL:
+            assert(value_len >= sizeof(uint32_t));
+            *((uint32_t *)value) = cc110x_get_listen_interval(cc110x);
+            return sizeof(uint32_t);
         default:
             break;
     }
@@ -146,6 +150,14 @@ static int _set(netdev_t *dev, netopt_t opt, void *value, size_t value_len)
                 return -EINVAL;
             }
             return 1;
+        case NETOPT_LISTEN_INTERVAL:
+            if (value_len != sizeof(uint32_t)) {
+                return -EINVAL;
+            }
+            if (cc110x_set_listen_interval(cc110x, *(uint32_t*)value) < 0) {
+                return -EINVAL;
+            }
+            return sizeof(uint32_t);
 #ifdef MODULE_GNRC_NETIF
         case NETOPT_PROTO:
             if (value_len != sizeof(gnrc_nettype_t)) {
@@ -28,6 +28,7 @@
 #include "cc110x-internal.h"
 #include "cc110x-interface.h"
 #include "cc110x-defines.h"
+#include "cc110x-defaultsettings.h"
 
 #include "periph/gpio.h"
 #include "irq.h"
@@ -39,6 +40,7 @@
 #include "cpu.h"
 
 #include "log.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -67,57 +69,33 @@ static void _rx_start(cc110x_t *dev)
 
 static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
 {
-    int fifo = cc110x_get_reg_robust(dev, 0xfb);
+    cc110x_pkt_buf_t *pkt_buf = &dev->pkt_buf;
+    int started = pkt_buf->pos;
+    int res = cc110x_read_rxfifo(dev);
 
-    if (fifo & 0x80) {
-        DEBUG("%s:%s:%u rx overflow\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
+    if (res < 0) {
+        DEBUG("%s:%s:%u rx %s\n", RIOT_FILE_RELATIVE, __func__, __LINE__,
+                (res == -EOVERFLOW) ? "overflow" : "oversized packet");
         _rx_abort(dev);
         return;
     }
 
-    if (!fifo) {
+    if (!res) {
         gpio_irq_enable(dev->params.gdo2);
         return;
     }
 
-    cc110x_pkt_buf_t *pkt_buf = &dev->pkt_buf;
-    if (!pkt_buf->pos) {
-        pkt_buf->pos = 1;
-        pkt_buf->packet.length = cc110x_read_reg(dev, CC110X_RXFIFO);
-
+    if (!started) {
         /* Possible packet received, RX -> IDLE (0.1 us) */
         dev->cc110x_statistic.packets_in++;
     }
 
-    int left = pkt_buf->packet.length+1 - pkt_buf->pos;
-
-    /* if the fifo doesn't contain the rest of the packet,
-     * leav at least one byte as per spec sheet. */
-    int to_read = (fifo < left) ? (fifo-1) : fifo;
-    if (to_read > left) {
-        to_read = left;
-    }
-
-    if (to_read) {
-        cc110x_readburst_reg(dev, CC110X_RXFIFO,
-                ((char *)&pkt_buf->packet)+pkt_buf->pos, to_read);
-        pkt_buf->pos += to_read;
-    }
-
-    if (to_read == left) {
-        uint8_t status[2];
-        /* full packet received. */
-        /* Read the 2 appended status bytes (status[0] = RSSI, status[1] = LQI) */
-        cc110x_readburst_reg(dev, CC110X_RXFIFO, (char *)status, 2);
-
-        /* Store RSSI value of packet */
-        pkt_buf->rssi = status[I_RSSI];
+    if (pkt_buf->pos == pkt_buf->packet.length + 3) {
+        /* full packet received, pkt_buf->lqi still holds the CRC_OK bit */
+        int crc_ok = pkt_buf->lqi & CRC_OK;
 
         /* Bit 0-6 of LQI indicates the link quality (LQI) */
-        pkt_buf->lqi = status[I_LQI] & LQI_EST;
-
-        /* MSB of LQI is the CRC_OK bit */
-        int crc_ok = (status[I_LQI] & CRC_OK) >> 7;
+        pkt_buf->lqi &= LQI_EST;
 
         if (crc_ok) {
                     LOG_DEBUG("cc110x: received packet from=%u to=%u payload "
@@ -288,6 +266,16 @@ int cc110x_send(cc110x_t *dev, cc110x_pkt_t *packet)
     /* Flush TX FIFO to be sure it is empty */
     cc110x_strobe(dev, CC110X_SFTX);
 
+    if (dev->listen_interval) {
+        /* the PATABLE is lost in SLEEP, except for its first entry */
+        cc110x_writeburst_reg(dev, CC110X_PATABLE, CC110X_DEFAULT_PATABLE, 8);
+        /* with an empty TX FIFO, the radio sends preamble until the packet
+         * is written: make it long enough for receivers in WOR mode to
+         * wake up and detect it */
+        cc110x_strobe(dev, CC110X_STX);
+        xtimer_usleep(dev->listen_interval + CC110X_WOR_RX_TIME);
+    }
+
     memcpy((char*)&dev->pkt_buf.packet, packet, size);
     dev->pkt_buf.pos = 0;
 
@@ -22,6 +22,7 @@
  * @}
  */
 
+#include <errno.h>
 #include <stdio.h>
 
 #include "cc110x.h"
@@ -112,6 +113,78 @@ void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t cou
     spi_release(dev->params.spi);
 }
 
+int cc110x_read_rxfifo(cc110x_t *dev)
+{
+    cc110x_pkt_buf_t *pkt_buf = &dev->pkt_buf;
+    uint8_t *pkt = (uint8_t *)&pkt_buf->packet;
+    uint8_t fifo, tmp;
+    int res = 0;
+    unsigned int cpsr;
+    lock(dev);
+    cpsr = irq_disable();
+    cc110x_cs(dev);
+    do {
+        fifo = spi_transfer_reg(dev->params.spi, SPI_CS_UNDEF,
+                                (CC110X_RXBYTES | CC110X_READ_BURST),
+                                CC110X_NOBYTE);
+        tmp = spi_transfer_reg(dev->params.spi, SPI_CS_UNDEF,
+                               (CC110X_RXBYTES | CC110X_READ_BURST),
+                               CC110X_NOBYTE);
+    } while (fifo != tmp);
+
+    if (fifo & RXFIFO_OVERFLOW) {
+        res = -EOVERFLOW;
+        goto out;
+    }
+
+    /* the length byte needs at least one byte following it in the FIFO */
+    if ((fifo == 0) || ((pkt_buf->pos == 0) && (fifo == 1))) {
+        goto out;
+    }
+
+    spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, false,
+                      (CC110X_RXFIFO | CC110X_READ_BURST));
+    if (pkt_buf->pos == 0) {
+        pkt[0] = spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, false,
+                                   CC110X_NOBYTE);
+        pkt_buf->pos = 1;
+        fifo--;
+        res++;
+        if (pkt_buf->packet.length >= sizeof(cc110x_pkt_t)) {
+            res = -EMSGSIZE;
+            goto out;
+        }
+    }
+
+    /* rest of the packet, including the 2 appended status bytes */
+    unsigned left = pkt_buf->packet.length + 3 - pkt_buf->pos;
+    /* if the FIFO doesn't contain the rest of the packet,
+     * leave at least one byte as per spec sheet. */
+    unsigned to_read = (fifo < left) ? (fifo - 1U) : left;
+
+    for (unsigned i = 0; i < to_read; i++) {
+        uint8_t byte = spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, false,
+                                         CC110X_NOBYTE);
+        if (pkt_buf->pos <= pkt_buf->packet.length) {
+            pkt[pkt_buf->pos] = byte;
+        }
+        else if (pkt_buf->pos == pkt_buf->packet.length + 1) {
+            pkt_buf->rssi = byte;
+        }
+        else {
+            pkt_buf->lqi = byte;
+        }
+        pkt_buf->pos++;
+    }
+    res += to_read;
+
+out:
+    gpio_set(dev->params.cs);
+    irq_restore(cpsr);
+    spi_release(dev->params.spi);
+    return res;
+}
+
 void cc110x_write_reg(cc110x_t *dev, uint8_t addr, uint8_t value)
 {
     unsigned int cpsr;
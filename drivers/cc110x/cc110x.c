@@ -20,6 +20,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "luid.h"
 #include "board.h"
 #include "periph/gpio.h"
@@ -67,6 +69,7 @@ int cc110x_setup(cc110x_t *dev, const cc110x_params_t *params)
 
     /* set default state */
     dev->radio_state = RADIO_IDLE;
+    dev->listen_interval = 0;
 
     /* Write configuration to configuration registers */
     cc110x_writeburst_reg(dev, 0x00, cc110x_default_conf, cc110x_default_conf_size);
@@ -126,12 +129,70 @@ void cc110x_set_monitor(cc110x_t *dev, uint8_t mode)
     cc110x_write_register(dev, CC110X_PKTCTRL1, mode ? 0x04 : 0x06);
 }
 
+uint32_t cc110x_get_listen_interval(const cc110x_t *dev)
+{
+    return dev->listen_interval;
+}
+
+int cc110x_set_listen_interval(cc110x_t *dev, uint32_t interval)
+{
+    DEBUG("%s:%s:%u setting listen interval %lu\n", RIOT_FILE_RELATIVE,
+            __func__, __LINE__, (unsigned long)interval);
+
+    /* EVENT0 timeout = 750 / fXOSC * EVENT0 * 2^(5 * WOR_RES) */
+    uint64_t event0 = ((uint64_t)interval * 26) / 750;
+    uint8_t wor_res = 0;
+    /* RX timeout relative to EVENT0 for RX_TIME = 0, halving per step */
+    uint32_t rx_time_max = interval / 8;
+
+    if (event0 > 0xffff) {
+        event0 >>= 5;
+        wor_res = 1;
+        rx_time_max = ((uint64_t)interval * 10) / 512;
+    }
+    if ((interval != 0) && ((event0 == 0) || (event0 > 0xffff))) {
+        return -EINVAL;
+    }
+
+    /* shortest RX timeout still covering CC110X_WOR_RX_TIME */
+    uint8_t rx_time = 0;
+    while ((rx_time < 6) && ((rx_time_max >> (rx_time + 1)) >= CC110X_WOR_RX_TIME)) {
+        rx_time++;
+    }
+
+    uint8_t old_state = dev->radio_state;
+    cc110x_wakeup_from_rx(dev);
+
+    dev->listen_interval = interval;
+    if (interval) {
+        cc110x_write_reg(dev, CC110X_WOREVT1, (uint8_t)(event0 >> 8));
+        cc110x_write_reg(dev, CC110X_WOREVT0, (uint8_t)event0);
+        /* RC oscillator on, EVENT1 ~1.3ms, RC oscillator calibration */
+        cc110x_write_reg(dev, CC110X_WORCTRL, 0x78 | wor_res);
+        /* Leave RX on timeout or when there is no carrier, stay in RX until
+         * end of packet once the sync word was found */
+        cc110x_write_reg(dev, CC110X_MCSM2, 0x10 | rx_time);
+    }
+    else {
+        cc110x_write_reg(dev, CC110X_WORCTRL, 0xF8);
+        cc110x_write_reg(dev, CC110X_MCSM2, 0x07);
+    }
+
+    if (old_state == RADIO_RX) {
+        cc110x_switch_to_rx(dev);
+    }
+
+    return 0;
+}
+
 void cc110x_setup_rx_mode(cc110x_t *dev)
 {
     DEBUG("%s:%s:%u\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
 
-    /* Stay in RX mode until end of packet */
-    cc110x_write_reg(dev, CC110X_MCSM2, 0x07);
+    /* Stay in RX mode until end of packet, the WOR timeout is kept */
+    if (!dev->listen_interval) {
+        cc110x_write_reg(dev, CC110X_MCSM2, 0x07);
+    }
     cc110x_switch_to_rx(dev);
 }
 
@@ -152,7 +213,8 @@ void cc110x_switch_to_rx(cc110x_t *dev)
     dev->radio_state = RADIO_RX;
 
     cc110x_write_reg(dev, CC110X_IOCFG2, 0x6);
-    cc110x_strobe(dev, CC110X_SRX);
+    /* in WOR mode the radio sleeps and enters RX on its own */
+    cc110x_strobe(dev, dev->listen_interval ? CC110X_SWOR : CC110X_SRX);
 
     gpio_irq_enable(dev->params.gdo2);
 }
@@ -165,6 +227,7 @@ void cc110x_wakeup_from_rx(cc110x_t *dev)
 
     LOG_DEBUG("cc110x: switching to idle mode\n");
 
+    /* also exits WOR mode */
     cc110x_strobe(dev, CC110X_SIDLE);
     dev->radio_state = RADIO_IDLE;
 }
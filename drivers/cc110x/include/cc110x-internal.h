@@ -56,6 +56,11 @@ extern "C" {
                                                  after CS */
 #define CC110X_GDO1_LOW_RETRY       (100)   /**< Max. retries for SO to go low
                                                  after CS */
+#ifndef CC110X_WOR_RX_TIME
+#define CC110X_WOR_RX_TIME          (1000)  /**< Minimum time in us to listen
+                                                 for a preamble after waking
+                                                 up in WOR mode */
+#endif
 #ifndef CC110X_DEFAULT_CHANNEL
 #define CC110X_DEFAULT_CHANNEL      (0)     /**< The default channel number */
 #endif
@@ -49,6 +49,25 @@ void cc110x_writeburst_reg(cc110x_t *dev, uint8_t addr, const char *buffer, uint
  */
 void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t count);
 
+/**
+ * @brief Read the received packet from the RX FIFO
+ *
+ * Reads the RX FIFO fill level and as much of the packet in
+ * dev->pkt_buf as is available in one SPI transaction. Once the complete
+ * packet is in the FIFO, its rest and the 2 appended status bytes are read
+ * in a single burst, so a packet fitting into the FIFO takes one transaction.
+ * The status bytes go to dev->pkt_buf.rssi and dev->pkt_buf.lqi, the latter
+ * including the CRC_OK bit. dev->pkt_buf.pos must be 0 for a new packet and
+ * equals the packet length + 3 when it is complete.
+ *
+ * @param dev       Device to work on
+ *
+ * @return number of bytes read, 0 if the FIFO holds nothing to read yet
+ * @return -EOVERFLOW if the RX FIFO overflowed
+ * @return -EMSGSIZE if the packet does not fit into dev->pkt_buf
+ */
+int cc110x_read_rxfifo(cc110x_t *dev);
+
 /**
  * @brief Write one byte to a register
  *
@@ -204,16 +204,6 @@ static void cmd_rbm(enc28j60_t *dev, uint8_t *data, size_t len)
     spi_release(dev->spi);
 }
 
-static void cmd_wbm(enc28j60_t *dev, uint8_t *data, size_t len)
-{
-    /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
-    /* transfer data */
-    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_WBM, data, NULL, len);
-    /* finish SPI transaction */
-    spi_release(dev->spi);
-}
-
 static void mac_get(enc28j60_t *dev, uint8_t *mac)
 {
     mac[0] = cmd_rcr_miimac(dev, REG_B3_MAADR6, 3);
@@ -243,30 +233,35 @@ static void on_int(void *arg)
 static int nd_send(netdev_t *netdev, const struct iovec *data, unsigned count)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
-    uint8_t ctrl = 0;
-    int c = 0;
+    size_t len = 0;
 
     mutex_lock(&dev->devlock);
 
-#ifdef MODULE_NETSTATS_L2
-    netdev->stats.tx_bytes += count;
-#endif
-
     /* set write pointer */
     cmd_w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START);
-    /* write control byte and the actual data into the buffer */
-    cmd_wbm(dev, &ctrl, 1);
-    for (int i = 0; i < count; i++) {
-        c += data[i].iov_len;
-        cmd_wbm(dev, (uint8_t *)data[i].iov_base, data[i].iov_len);
+    /* write control byte and the actual data into the buffer, all in one
+     * transfer straight from the given segments */
+    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    spi_transfer_byte(dev->spi, dev->cs_pin, true, CMD_WBM);
+    spi_transfer_byte(dev->spi, dev->cs_pin, (count > 0), 0);
+    for (unsigned i = 0; i < count; i++) {
+        len += data[i].iov_len;
+        spi_transfer_bytes(dev->spi, dev->cs_pin, ((i + 1) < count),
+                           data[i].iov_base, NULL, data[i].iov_len);
     }
-    /* set TX end pointer */
-    cmd_w_addr(dev, ADDR_TX_END, cmd_r_addr(dev, ADDR_WRITE_PTR) - 1);
+    spi_release(dev->spi);
+    /* set TX end pointer to the last byte of the frame, behind the control
+     * byte */
+    cmd_w_addr(dev, ADDR_TX_END, BUF_TX_START + len);
     /* trigger the send process */
     cmd_bfs(dev, REG_ECON1, -1, ECON1_TXRTS);
 
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+
     mutex_unlock(&dev->devlock);
-    return c;
+    return (int)len;
 }
 
 static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
@@ -299,7 +294,9 @@ static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
             DEBUG("[enc28j60] recv: unable to get packet - buffer too small\n");
             size = 0;
         }
-        /* release memory */
+    }
+    if ((buf != NULL) || (max_len > 0)) {
+        /* release memory, also when the packet is dropped */
         cmd_w_addr(dev, ADDR_RX_READ, next);
         cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
     }
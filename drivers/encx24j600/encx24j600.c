@@ -298,11 +298,15 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count) {
     /* wait until previous packet has been sent */
     while ((reg_get(dev, ENC_ECON1) & ENC_TXRTS)) {}
 
-    /* copy packet to SRAM */
+    /* copy packet to SRAM straight from the given segments, all in one
+     * transfer */
     size_t len = 0;
 
-    for (int i = 0; i < count; i++) {
-        sram_op(dev, ENC_WGPDATA, (i ? 0xFFFF : TX_BUFFER_START), vector[i].iov_base, vector[i].iov_len);
+    reg_set(dev, ENC_EGPWRPT, TX_BUFFER_START);
+    spi_transfer_byte(dev->spi, dev->cs, (count > 0), ENC_WGPDATA);
+    for (unsigned i = 0; i < count; i++) {
+        spi_transfer_bytes(dev->spi, dev->cs, ((i + 1) < count),
+                           vector[i].iov_base, NULL, vector[i].iov_len);
         len += vector[i].iov_len;
     }
 
@@ -361,20 +365,23 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     size_t payload_len = hdr.frame_len - 4;
 
 
-    if (buf) {
-        if (payload_len > len) {
-            /* payload exceeds buffer size */
-            unlock(dev);
-            return -ENOBUFS;
-        }
+    if (buf || len) {
+        if (buf) {
+            if (payload_len > len) {
+                /* payload exceeds buffer size */
+                unlock(dev);
+                return -ENOBUFS;
+            }
 #ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev->stats.rx_bytes += payload_len;
+            netdev->stats.rx_count++;
+            netdev->stats.rx_bytes += payload_len;
 #endif
-        /* read packet (without 4 bytes checksum) */
-        sram_op(dev, ENC_RRXDATA, 0xFFFF, buf, payload_len);
+            /* read packet (without 4 bytes checksum) */
+            sram_op(dev, ENC_RRXDATA, 0xFFFF, buf, payload_len);
+        }
 
-        /* decrement available packet count */
+        /* decrement available packet count, also when the packet is
+         * dropped */
         cmd(dev, ENC_SETPKTDEC);
 
         dev->rx_next_ptr = hdr.rx_next_ptr;
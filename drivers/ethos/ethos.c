@@ -57,7 +57,9 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
     dev->state = WAIT_FRAMESTART;
     dev->framesize = 0;
     dev->frametype = 0;
-    dev->last_framesize = 0;
+    dev->frame_start = 0;
+    dev->frames_in = 0;
+    dev->frames_out = 0;
 
     tsrb_init(&dev->inbuf, (char*)params->buf, params->bufsize);
     mutex_init(&dev->out_mutex);
@@ -82,22 +84,37 @@ static void _reset_state(ethos_t *dev)
     dev->state = WAIT_FRAMESTART;
     dev->frametype = 0;
     dev->framesize = 0;
+    dev->frame_start = dev->inbuf.writes;
+}
+
+/* only the ISR writes to the ringbuffer, so it can take back what it wrote */
+static void _drop_frame(ethos_t *dev)
+{
+    DEBUG("ethos: dropping incoming frame\n");
+    dev->inbuf.writes = dev->frame_start;
+    _reset_state(dev);
 }
 
 static void _handle_char(ethos_t *dev, char c)
 {
     switch (dev->frametype) {
         case ETHOS_FRAME_TYPE_DATA:
+            if (tsrb_add_one(&dev->inbuf, c) == 0) {
+                dev->framesize++;
+            }
+            else {
+                /* frames waiting in the ringbuffer stay intact */
+                _drop_frame(dev);
+            }
+            break;
         case ETHOS_FRAME_TYPE_HELLO:
         case ETHOS_FRAME_TYPE_HELLO_REPLY:
-             if (tsrb_add_one(&dev->inbuf, c) == 0) {
-                dev->framesize++;
-            } else {
-                //puts("lost frame");
-                dev->inbuf.reads = 0;
-                dev->inbuf.writes = 0;
-                _reset_state(dev);
+            /* the ringbuffer might hold data frames, so the address goes
+             * straight to its place */
+            if (dev->framesize < sizeof(dev->remote_mac_addr)) {
+                dev->remote_mac_addr[dev->framesize] = c;
             }
+            dev->framesize++;
             break;
 #ifdef USE_ETHOS_FOR_STDIO
         case ETHOS_FRAME_TYPE_TEXT:
@@ -111,18 +128,16 @@ static void _end_of_frame(ethos_t *dev)
 {
     switch(dev->frametype) {
         case ETHOS_FRAME_TYPE_DATA:
-            if (dev->framesize) {
-                dev->last_framesize = dev->framesize;
-                dev->netdev.event_callback((netdev_t*) dev, NETDEV_EVENT_ISR);
+            if ((uint8_t)(dev->frames_in - dev->frames_out) >= ETHOS_RX_FRAMES) {
+                _drop_frame(dev);
+                return;
             }
+            dev->frame_sizes[dev->frames_in & (ETHOS_RX_FRAMES - 1)] = dev->framesize;
+            dev->frames_in++;
+            dev->netdev.event_callback((netdev_t*) dev, NETDEV_EVENT_ISR);
             break;
         case ETHOS_FRAME_TYPE_HELLO:
             ethos_send_frame(dev, dev->mac_addr, 6, ETHOS_FRAME_TYPE_HELLO_REPLY);
-            /* fall through */
-        case ETHOS_FRAME_TYPE_HELLO_REPLY:
-            if (dev->framesize == 6) {
-                tsrb_get(&dev->inbuf, (char*)dev->remote_mac_addr, 6);
-            }
             break;
     }
 
@@ -179,7 +194,12 @@ static void ethos_isr(void *arg, uint8_t c)
 static void _isr(netdev_t *netdev)
 {
     ethos_t *dev = (ethos_t *) netdev;
-    dev->netdev.event_callback((netdev_t*) dev, NETDEV_EVENT_RX_COMPLETE);
+    uint8_t frames = dev->frames_in - dev->frames_out;
+
+    /* the ISR events of frames that ended in a row might have been merged */
+    while (frames--) {
+        dev->netdev.event_callback((netdev_t*) dev, NETDEV_EVENT_RX_COMPLETE);
+    }
 }
 
 static int _init(netdev_t *encdev)
@@ -199,26 +219,32 @@ static size_t iovec_count_total(const struct iovec *vector, int count)
     return result;
 }
 
-static void _write_escaped(uart_t uart, uint8_t c)
+static void _write_escaped(uart_t uart, const uint8_t *data, size_t len)
 {
-    uint8_t *out;
-    int n;
+    const uint8_t *start = data, *end = data + len;
 
-    switch(c) {
-        case ETHOS_FRAME_DELIMITER:
-            out = (uint8_t*)_esc_delim;
-            n = 2;
-            break;
-        case ETHOS_ESC_CHAR:
-            out = (uint8_t*)_esc_esc;
-            n = 2;
-            break;
-        default:
-            out = &c;
-            n = 1;
-    }
+    for (; data < end; data++) {
+        const uint8_t *esc;
 
-    uart_write(uart, out, n);
+        if (*data == ETHOS_FRAME_DELIMITER) {
+            esc = _esc_delim;
+        }
+        else if (*data == ETHOS_ESC_CHAR) {
+            esc = _esc_esc;
+        }
+        else {
+            continue;
+        }
+        /* write everything up to the special character in one go */
+        if (data > start) {
+            uart_write(uart, start, data - start);
+        }
+        uart_write(uart, esc, 2);
+        start = data + 1;
+    }
+    if (end > start) {
+        uart_write(uart, start, end - start);
+    }
 }
 
 void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned frame_type)
@@ -244,9 +270,7 @@ void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned fr
     }
 
     /* send frame content */
-    while(len--) {
-        _write_escaped(dev->uart, *(uint8_t*)data++);
-    }
+    _write_escaped(dev->uart, data, len);
 
     /* end of frame */
     uart_write(dev->uart, &frame_delim, 1);
@@ -273,11 +297,7 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
 
     /* send iovec */
     while(count--) {
-        size_t n = vector->iov_len;
-        uint8_t *ptr = vector->iov_base;
-        while(n--) {
-            _write_escaped(dev->uart, *ptr++);
-        }
+        _write_escaped(dev->uart, vector->iov_base, vector->iov_len);
         vector++;
     }
 
@@ -298,26 +318,36 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void* info)
 {
     (void) info;
     ethos_t * dev = (ethos_t *) netdev;
+    size_t size;
+
+    if (dev->frames_out == dev->frames_in) {
+        return (buf) ? -1 : 0;
+    }
+    size = dev->frame_sizes[dev->frames_out & (ETHOS_RX_FRAMES - 1)];
 
     if (buf) {
-        if (len < (int)dev->last_framesize) {
+        if (len < size) {
             DEBUG("ethos _recv(): receive buffer too small.\n");
+            tsrb_drop(&dev->inbuf, size);
+            dev->frames_out++;
             return -1;
         }
 
-        len = dev->last_framesize;
-        dev->last_framesize = 0;
-
-        if ((tsrb_get(&dev->inbuf, buf, len) != len)) {
+        if ((tsrb_get(&dev->inbuf, buf, size) != (int)size)) {
             DEBUG("ethos _recv(): inbuf doesn't contain enough bytes.\n");
+            dev->frames_out++;
             return -1;
         }
+        dev->frames_out++;
 
-        return (int)len;
+        return (int)size;
     }
-    else {
-        return dev->last_framesize;
+    else if (len > 0) {
+        /* drop frame */
+        tsrb_drop(&dev->inbuf, size);
+        dev->frames_out++;
     }
+    return (int)size;
 }
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
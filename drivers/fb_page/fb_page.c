@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_fb_page
+ * @{
+ *
+ * @file
+ * @brief       Implementation of the paged framebuffer
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "fb_page.h"
+
+static void _mark(fb_page_dirty_t *dirty, uint16_t x0, uint16_t x1)
+{
+    if (dirty->x0 == dirty->x1) {
+        dirty->x0 = x0;
+        dirty->x1 = x1;
+        return;
+    }
+    if (x0 < dirty->x0) {
+        dirty->x0 = x0;
+    }
+    if (x1 > dirty->x1) {
+        dirty->x1 = x1;
+    }
+}
+
+void fb_page_init(fb_page_t *fb, uint8_t *buf, fb_page_dirty_t *dirty,
+                  uint16_t width, uint8_t pages)
+{
+    assert(buf && dirty && (width > 0) && (pages > 0));
+
+    fb->buf = buf;
+    fb->dirty = dirty;
+    fb->width = width;
+    fb->pages = pages;
+    fb->next = 0;
+    memset(buf, 0, (size_t)width * pages);
+    fb_page_mark_all(fb);
+}
+
+void fb_page_mark(fb_page_t *fb, uint8_t page, uint16_t x, size_t len)
+{
+    if ((page >= fb->pages) || (x >= fb->width) || (len == 0)) {
+        return;
+    }
+    if (len > (size_t)(fb->width - x)) {
+        len = fb->width - x;
+    }
+    _mark(&fb->dirty[page], x, x + len);
+}
+
+void fb_page_mark_all(fb_page_t *fb)
+{
+    for (unsigned page = 0; page < fb->pages; page++) {
+        fb->dirty[page].x0 = 0;
+        fb->dirty[page].x1 = fb->width;
+    }
+}
+
+void fb_page_write(fb_page_t *fb, uint8_t page, uint16_t x,
+                   const uint8_t *data, size_t len)
+{
+    uint8_t *row;
+    int first = -1, last = -1;
+
+    if ((page >= fb->pages) || (x >= fb->width)) {
+        return;
+    }
+    if (len > (size_t)(fb->width - x)) {
+        len = fb->width - x;
+    }
+    row = &fb->buf[(size_t)page * fb->width + x];
+    for (size_t i = 0; i < len; i++) {
+        if (row[i] != data[i]) {
+            row[i] = data[i];
+            if (first < 0) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+    if (first >= 0) {
+        _mark(&fb->dirty[page], x + first, x + last + 1);
+    }
+}
+
+void fb_page_fill(fb_page_t *fb, uint8_t val)
+{
+    for (unsigned page = 0; page < fb->pages; page++) {
+        uint8_t *row = &fb->buf[page * fb->width];
+        int first = -1, last = -1;
+
+        for (unsigned x = 0; x < fb->width; x++) {
+            if (row[x] != val) {
+                row[x] = val;
+                if (first < 0) {
+                    first = x;
+                }
+                last = x;
+            }
+        }
+        if (first >= 0) {
+            _mark(&fb->dirty[page], first, last + 1);
+        }
+    }
+}
+
+void fb_page_set_pixel(fb_page_t *fb, uint16_t x, uint16_t y, bool on)
+{
+    uint8_t page = y / 8;
+    uint8_t col;
+
+    if ((x >= fb->width) || (page >= fb->pages)) {
+        return;
+    }
+    col = fb->buf[(size_t)page * fb->width + x];
+    if (on) {
+        col |= (1 << (y % 8));
+    }
+    else {
+        col &= ~(1 << (y % 8));
+    }
+    fb_page_write(fb, page, x, &col, 1);
+}
+
+bool fb_page_get_pixel(const fb_page_t *fb, uint16_t x, uint16_t y)
+{
+    uint8_t page = y / 8;
+
+    if ((x >= fb->width) || (page >= fb->pages)) {
+        return false;
+    }
+    return (fb->buf[(size_t)page * fb->width + x] & (1 << (y % 8)));
+}
+
+bool fb_page_is_dirty(const fb_page_t *fb)
+{
+    for (unsigned page = 0; page < fb->pages; page++) {
+        if (fb->dirty[page].x0 != fb->dirty[page].x1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t fb_page_take(fb_page_t *fb, uint8_t *page, uint16_t *x)
+{
+    for (unsigned i = 0; i < fb->pages; i++) {
+        uint8_t p = (fb->next + i) % fb->pages;
+        fb_page_dirty_t *dirty = &fb->dirty[p];
+        size_t len = dirty->x1 - dirty->x0;
+
+        if (len > 0) {
+            *page = p;
+            *x = dirty->x0;
+            dirty->x1 = dirty->x0;
+            fb->next = (p + 1) % fb->pages;
+            return len;
+        }
+    }
+    return 0;
+}
+
+bool fb_page_flush(fb_page_t *fb, fb_page_flush_cb_t cb, void *arg,
+                   unsigned max_pages)
+{
+    unsigned count = 0;
+    uint8_t page;
+    uint16_t x;
+    size_t len;
+
+    while (((max_pages == 0) || (count < max_pages)) &&
+           ((len = fb_page_take(fb, &page, &x)) > 0)) {
+        cb(arg, page, x, &fb->buf[(size_t)page * fb->width + x], len);
+        count++;
+    }
+    return fb_page_is_dirty(fb);
+}
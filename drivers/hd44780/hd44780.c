@@ -87,6 +87,23 @@ static void _send(const hd44780_t *dev, uint8_t value, hd44780_state_t state)
 
 static void _write_bits(const hd44780_t *dev, uint8_t bits, uint8_t value)
 {
+#ifdef FEATURE_PERIPH_GPIO_PORT
+    /* change all data pins at once if they share a port */
+    if (dev->port) {
+        uint32_t mask = 0;
+        uint32_t port_val = 0;
+
+        for (unsigned i = 0; i < bits; ++i) {
+            mask |= dev->mask[i];
+            if ((value >> i) & 0x01) {
+                port_val |= dev->mask[i];
+            }
+        }
+        gpio_port_write_masked(dev->port, mask, port_val);
+        _pulse(dev);
+        return;
+    }
+#endif
     for (unsigned i = 0; i < bits; ++i) {
         if ((value >> i) & 0x01) {
             gpio_set(dev->p.data[i]);
@@ -147,6 +164,16 @@ int hd44780_init(hd44780_t *dev, const hd44780_params_t *params)
     for (int i = 0; i < ((dev->flag & HD44780_8BITMODE) ? 8 : 4); ++i) {
         gpio_init(dev->p.data[i], GPIO_OUT);
     }
+#ifdef FEATURE_PERIPH_GPIO_PORT
+    dev->port = gpio_port(dev->p.data[0]);
+    for (int i = 0; i < ((dev->flag & HD44780_8BITMODE) ? 8 : 4); ++i) {
+        if (gpio_port(dev->p.data[i]) != dev->port) {
+            dev->port = 0;
+            break;
+        }
+        dev->mask[i] = gpio_port_pin_mask(dev->p.data[i]);
+    }
+#endif
     /* see hitachi HD44780 datasheet pages 45/46 for init specs */
     xtimer_usleep(HD44780_INIT_WAIT_XXL);
     gpio_clear(dev->p.rs);
@@ -25,6 +25,8 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+
 #include "periph/i2c.h"
 #include "periph/gpio.h"
 
@@ -103,7 +105,8 @@ enum {
     ADXL345_DATA_READY  =  1,       /**< new data ready to be read */
     ADXL345_NOI2C       = -1,       /**< I2C communication failed */
     ADXL345_NODEV       = -2,       /**< no ADXL345 device found on the bus */
-    ADXL345_NODATA      = -3        /**< no data available */
+    ADXL345_NODATA      = -3,       /**< no data available */
+    ADXL345_NOINT       = -4        /**< no interrupt pin configured */
 };
 
 /**
@@ -237,6 +240,55 @@ void adxl345_set_bandwidth_rate(const adxl345_t *dev, uint8_t bw_rate);
 void adxl345_set_fifo_mode(const adxl345_t *dev, uint8_t mode,
                            uint8_t output, uint8_t value);
 
+/**
+ * @brief   Read the samples in the FIFO
+ *
+ * Every sample needs a read of its own, but all of them are read in one go
+ * on the bus.
+ *
+ * @param[in]  dev          device descriptor of accelerometer
+ * @param[out] data         the acceleration data [in mg], oldest first
+ * @param[in]  numof        maximum number of samples to read
+ *
+ * @return                  number of samples read
+ * @return                  ADXL345_NOI2C on bus errors
+ */
+int adxl345_read_fifo(const adxl345_t *dev, adxl345_data_t *data, size_t numof);
+
+/**
+ * @brief   Stream samples into the FIFO and signal the watermark on INT1
+ *
+ * This empties the FIFO and puts it into stream mode. @p cb runs in interrupt
+ * context on the rising edge of INT1, which stays high until the FIFO is read
+ * below the watermark again.
+ *
+ * @param[in]  dev          device descriptor of accelerometer
+ * @param[in]  watermark    FIFO level that triggers @p cb, 1 to 31
+ * @param[in]  cb           callback for reaching the watermark
+ * @param[in]  arg          argument passed to @p cb
+ *
+ * @return                  ADXL345_OK on success
+ * @return                  ADXL345_NOINT if INT1 is not configured
+ */
+int adxl345_fifo_start(const adxl345_t *dev, uint8_t watermark,
+                       gpio_cb_t cb, void *arg);
+
+/**
+ * @brief   Stop streaming samples into the FIFO
+ *
+ * @param[in]  dev          device descriptor of accelerometer
+ */
+void adxl345_fifo_stop(const adxl345_t *dev);
+
+/**
+ * @brief   Get the time between two samples at the current data rate
+ *
+ * @param[in]  dev          device descriptor of accelerometer
+ *
+ * @return                  sample period in microseconds
+ */
+uint32_t adxl345_get_period(const adxl345_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
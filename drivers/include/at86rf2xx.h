@@ -76,6 +76,20 @@ extern "C" {
  */
 #define AT86RF2XX_DEFAULT_TXPOWER       (IEEE802154_DEFAULT_TXPOWER)
 
+/**
+ * @brief   Time to wait for the next byte of a frame that is read while being
+ *          received, before giving up on it
+ *
+ * Four times the duration of a byte at the lowest data rate of the device.
+ */
+#ifndef AT86RF2XX_RX_STREAM_TIMEOUT_US
+#ifdef MODULE_AT86RF212B
+#define AT86RF2XX_RX_STREAM_TIMEOUT_US  (4U * 400U)
+#else
+#define AT86RF2XX_RX_STREAM_TIMEOUT_US  (4U * 32U)
+#endif
+#endif
+
 /**
  * @brief   Base (minimal) RSSI value in dBm
  */
@@ -168,6 +182,17 @@ typedef struct {
     uint8_t pending_tx;                 /**< keep track of pending TX calls
                                              this is required to know when to
                                              return to @ref at86rf2xx_t::idle_state */
+#if defined(MODULE_AT86RF2XX_RX_STREAM) || defined(DOXYGEN)
+    uint8_t rx_buf[AT86RF2XX_MAX_PKT_LENGTH];   /**< frame read while it was
+                                                 *   received */
+    uint8_t rx_len;                     /**< length of the frame in
+                                             @ref at86rf2xx_t::rx_buf without
+                                             FCS, 0 if there is none */
+    uint8_t rx_lqi;                     /**< LQI of the frame in
+                                             @ref at86rf2xx_t::rx_buf */
+    uint8_t rx_rssi;                    /**< ED level of the frame in
+                                             @ref at86rf2xx_t::rx_buf */
+#endif
     /** @} */
 } at86rf2xx_t;
 
@@ -373,6 +398,18 @@ int8_t at86rf2xx_get_cca_threshold(at86rf2xx_t *dev);
  */
 void at86rf2xx_set_cca_threshold(at86rf2xx_t *dev, int8_t value);
 
+/**
+ * @brief   Perform one manual channel clear assessment (CCA)
+ *
+ * The CCA mode and threshold are taken from the device configuration.
+ *
+ * @param[in] dev           device to use
+ *
+ * @return                  true if the channel is clear
+ * @return                  false if the channel is busy
+ */
+bool at86rf2xx_cca(at86rf2xx_t *dev);
+
 /**
  * @brief   Enable or disable driver specific options
  *
@@ -57,6 +57,8 @@ struct cc110x {
     uint8_t radio_state;                        /**< Radio state */
     uint8_t radio_channel;                      /**< current Radio channel */
     uint8_t radio_address;                      /**< current Radio address */
+    uint32_t listen_interval;                   /**< WOR interval in us, 0 if
+                                                     WOR is disabled */
 
     cc110x_pkt_buf_t pkt_buf;                   /**< RX/TX buffer */
     void (*isr_cb)(cc110x_t *dev, void* arg);   /**< isr callback */
@@ -120,6 +122,33 @@ uint8_t cc110x_get_address(cc110x_t *dev);
 uint8_t cc110x_set_address(cc110x_t *dev, uint8_t address);
 
 
+/**
+ * @brief Get the wake-on-radio interval of a cc110x device
+ *
+ * @param[in] dev   device to query
+ *
+ * @return the interval in us, 0 if wake-on-radio is disabled
+ */
+uint32_t cc110x_get_listen_interval(const cc110x_t *dev);
+
+/**
+ * @brief Set the wake-on-radio interval of a cc110x device
+ *
+ * In wake-on-radio (WOR) mode the radio sleeps instead of listening and only
+ * wakes up every @p interval us to listen for a preamble, leaving RX again
+ * early when there is no carrier. Packets sent by the device are preceded by
+ * a preamble of at least @p interval us, so receivers in WOR mode with the
+ * same or a shorter interval pick them up. This blocks the sending thread for
+ * the length of the preamble.
+ *
+ * @param[in] dev       device to work on
+ * @param[in] interval  interval in us, 0 disables wake-on-radio
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p interval can not be configured (above ~60s)
+ */
+int cc110x_set_listen_interval(cc110x_t *dev, uint32_t interval);
+
 /**
  * @brief Set cc110x monitor mode setting
  *
@@ -42,6 +42,16 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Maximum number of received frames waiting to be read
+ *
+ * Frames that arrive while this many are waiting are dropped. Must be a power
+ * of two.
+ */
+#ifndef ETHOS_RX_FRAMES
+#define ETHOS_RX_FRAMES                 (4U)
+#endif
+
 /**
  * @name Escape char definitions
  * @{
@@ -76,7 +86,12 @@ typedef struct {
     line_state_t state;     /**< Line status variable */
     size_t framesize;       /**< size of currently incoming frame */
     unsigned frametype;     /**< type of currently incoming frame */
-    size_t last_framesize;  /**< size of last completed frame */
+    unsigned frame_start;   /**< ethos_t::inbuf write count at the start of
+                             *   the currently incoming frame */
+    uint16_t frame_sizes[ETHOS_RX_FRAMES];  /**< sizes of the completed frames
+                                             *   in ethos_t::inbuf */
+    volatile uint8_t frames_in;     /**< number of completed frames */
+    volatile uint8_t frames_out;    /**< number of read frames */
     mutex_t out_mutex;      /**< mutex used for locking concurrent sends */
 } ethos_t;
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_fb_page Paged framebuffer
+ * @ingroup     drivers_actuators
+ * @brief       Framebuffer for monochrome displays organized in pages
+ *
+ * Monochrome display controllers like the PCD8544 or the SSD1306 group their
+ * memory in pages of 8 rows, each byte holds 8 stacked pixels of one column
+ * with the top pixel in the least significant bit. The framebuffer keeps the
+ * content of the display in this layout and tracks the changed columns of
+ * every page, so a display driver needs to transfer only the changed part of
+ * each page instead of the whole screen.
+ *
+ * Writing to the framebuffer marks only bytes that actually change, so
+ * redrawing a whole screen with mostly the same content is cheap, too.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the paged framebuffer
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef FB_PAGE_H
+#define FB_PAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Changed columns of one page
+ */
+typedef struct {
+    uint16_t x0;        /**< first changed column */
+    uint16_t x1;        /**< column after the last changed one, equal to
+                         *   fb_page_dirty_t::x0 for an unchanged page */
+} fb_page_dirty_t;
+
+/**
+ * @brief   Paged framebuffer
+ */
+typedef struct {
+    uint8_t *buf;               /**< content, fb_page_t::width bytes per page */
+    fb_page_dirty_t *dirty;     /**< changed columns, one entry per page */
+    uint16_t width;             /**< width of the display in pixels */
+    uint8_t pages;              /**< height of the display in pages */
+    uint8_t next;               /**< page to look at first for a change */
+} fb_page_t;
+
+/**
+ * @brief   Callback transferring a changed part of a page to the display
+ *
+ * @param[in] arg       argument given to fb_page_flush()
+ * @param[in] page      page of the part
+ * @param[in] x         first column of the part
+ * @param[in] data      content of the part
+ * @param[in] len       number of columns of the part
+ */
+typedef void (*fb_page_flush_cb_t)(void *arg, uint8_t page, uint16_t x,
+                                   const uint8_t *data, size_t len);
+
+/**
+ * @brief   Size of the content buffer for a display
+ *
+ * @param[in] width     width in pixels
+ * @param[in] height    height in pixels
+ */
+#define FB_PAGE_BUF_SIZE(width, height) ((width) * (((height) + 7) / 8))
+
+/**
+ * @brief   Initialize a framebuffer
+ *
+ * The framebuffer is cleared and completely marked as changed, as the
+ * content of the display is unknown.
+ *
+ * @param[out] fb       framebuffer to initialize
+ * @param[in] buf       content buffer of FB_PAGE_BUF_SIZE() bytes
+ * @param[in] dirty     @p pages entries to track the changes in
+ * @param[in] width     width of the display in pixels
+ * @param[in] pages     height of the display in pages
+ */
+void fb_page_init(fb_page_t *fb, uint8_t *buf, fb_page_dirty_t *dirty,
+                  uint16_t width, uint8_t pages);
+
+/**
+ * @brief   Mark a part of a page as changed
+ *
+ * For content written to fb_page_t::buf directly.
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] page      page of the part
+ * @param[in] x         first column of the part
+ * @param[in] len       number of columns of the part
+ */
+void fb_page_mark(fb_page_t *fb, uint8_t page, uint16_t x, size_t len);
+
+/**
+ * @brief   Mark the whole framebuffer as changed
+ *
+ * @param[in] fb        framebuffer
+ */
+void fb_page_mark_all(fb_page_t *fb);
+
+/**
+ * @brief   Write columns to a page
+ *
+ * Columns beyond the width of the display are cut off.
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] page      page to write to
+ * @param[in] x         first column to write
+ * @param[in] data      one byte per column, top pixel in the LSB
+ * @param[in] len       number of columns in @p data
+ */
+void fb_page_write(fb_page_t *fb, uint8_t page, uint16_t x,
+                   const uint8_t *data, size_t len);
+
+/**
+ * @brief   Fill the whole framebuffer with the same column
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] val       column to fill with, 0x00 to clear the display
+ */
+void fb_page_fill(fb_page_t *fb, uint8_t val);
+
+/**
+ * @brief   Set or clear a pixel
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] x         column of the pixel
+ * @param[in] y         row of the pixel
+ * @param[in] on        true to set the pixel
+ */
+void fb_page_set_pixel(fb_page_t *fb, uint16_t x, uint16_t y, bool on);
+
+/**
+ * @brief   Get a pixel
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] x         column of the pixel
+ * @param[in] y         row of the pixel
+ *
+ * @return  true, if the pixel is set
+ */
+bool fb_page_get_pixel(const fb_page_t *fb, uint16_t x, uint16_t y);
+
+/**
+ * @brief   Check if the framebuffer was changed since its last transfer
+ *
+ * @param[in] fb        framebuffer
+ *
+ * @return  true, if a page changed
+ */
+bool fb_page_is_dirty(const fb_page_t *fb);
+
+/**
+ * @brief   Take the changed part of the next changed page
+ *
+ * The part is marked as unchanged, so changes written while it is
+ * transferred are taken with the next call. Pages are taken in turns.
+ *
+ * @param[in] fb        framebuffer
+ * @param[out] page     page of the part
+ * @param[out] x        first column of the part
+ *
+ * @return  number of columns of the part
+ * @return  0, if no page changed
+ */
+size_t fb_page_take(fb_page_t *fb, uint8_t *page, uint16_t *x);
+
+/**
+ * @brief   Transfer the changed parts of a number of pages
+ *
+ * @param[in] fb        framebuffer
+ * @param[in] cb        callback doing the transfer of each part
+ * @param[in] arg       argument passed to @p cb
+ * @param[in] max_pages number of pages to transfer at most, 0 for all
+ *
+ * @return  true, if there are changed pages left
+ */
+bool fb_page_flush(fb_page_t *fb, fb_page_flush_cb_t cb, void *arg,
+                   unsigned max_pages);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FB_PAGE_H */
+/** @} */
@@ -80,6 +80,12 @@ typedef struct {
     uint8_t ctrl;                   /**< LCD control flags */
     uint8_t mode;                   /**< LCD mode flags */
     uint8_t roff[HD44780_MAX_ROWS]; /**< offsets for LCD rows */
+#if defined(FEATURE_PERIPH_GPIO_PORT) || defined(DOXYGEN)
+    gpio_port_t port;               /**< port of all data pins, 0 if they are
+                                     *   spread over several ports */
+    uint32_t mask[HD44780_MAX_PINS];    /**< bit of each data pin in the
+                                         *   value of hd44780_t::port */
+#endif
 } hd44780_t;
 
 /**
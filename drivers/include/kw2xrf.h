@@ -41,6 +41,11 @@ extern "C" {
  */
 #define KW2XRF_MAX_PKT_LENGTH           (IEEE802154_FRAME_LEN_MAX)
 
+/**
+ * @brief   Number of entries of the source address matching table
+ */
+#define KW2XRF_SRC_ADDR_TABLE_SIZE      (12U)
+
 /**
  * @brief   Default PAN ID used after initialization
  */
@@ -91,6 +96,7 @@ extern "C" {
 #define KW2XRF_OPT_SRC_ADDR_LONG    (NETDEV_IEEE802154_SRC_MODE_LONG)  /**< legacy define */
 #define KW2XRF_OPT_RAWDUMP          (NETDEV_IEEE802154_RAW)            /**< legacy define */
 #define KW2XRF_OPT_ACK_REQ          (NETDEV_IEEE802154_ACK_REQ)        /**< legacy define */
+#define KW2XRF_OPT_ACK_PENDING      (NETDEV_IEEE802154_FRAME_PEND)     /**< legacy define */
 
 #define KW2XRF_OPT_AUTOCCA          (0x0100)    /**< CCA befor TX active */
 #define KW2XRF_OPT_PROMISCUOUS      (0x0200)    /**< promiscuous mode
@@ -138,6 +144,10 @@ typedef struct {
                                              this is required to know when to
                                              return to @ref kw2xrf_t::idle_state */
     int16_t tx_power;                   /**< The current tx-power setting of the device */
+    uint16_t src_sum[KW2XRF_SRC_ADDR_TABLE_SIZE];   /**< checksums of the sources
+                                                     *   to set the frame pending
+                                                     *   bit for */
+    uint16_t src_used;                  /**< used entries of @ref kw2xrf_t::src_sum */
     /** @} */
 } kw2xrf_t;
 
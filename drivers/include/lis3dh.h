@@ -22,6 +22,7 @@
 #ifndef LIS3DH_H
 #define LIS3DH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "periph/spi.h"
@@ -696,6 +697,7 @@ typedef struct {
     spi_t spi;              /**< SPI device the sensor is connected to */
     spi_clk_t clk;          /**< clock speed of the SPI bus */
     gpio_t cs;              /**< Chip select pin */
+    gpio_t int1;            /**< INT1 pin */
     int16_t scale;          /**< Current scale setting of the sensor */
 } lis3dh_t;
 
@@ -858,6 +860,54 @@ int lis3dh_set_int1(const lis3dh_t *dev, const uint8_t mode);
  */
 int lis3dh_get_fifo_level(const lis3dh_t *dev);
 
+/**
+ * @brief Read the samples in the FIFO in one bus transaction
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[out] data         Accelerometer data output buffer, oldest sample
+ *                          first
+ * @param[in]  numof        Maximum number of samples to read
+ *
+ * @return                  number of samples read on success
+ * @return                  -1 on error
+ */
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *data, size_t numof);
+
+/**
+ * @brief Stream samples into the FIFO and signal the watermark on INT1
+ *
+ * This empties the FIFO and puts it into stream mode. @p cb runs in interrupt
+ * context on the rising edge of INT1, which stays high until the FIFO is read
+ * below the watermark again.
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[in]  watermark    FIFO level that triggers @p cb, 1 to 31
+ * @param[in]  cb           Callback for reaching the watermark
+ * @param[in]  arg          Argument passed to @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+int lis3dh_fifo_start(const lis3dh_t *dev, const uint8_t watermark,
+                      gpio_cb_t cb, void *arg);
+
+/**
+ * @brief Stop streaming samples into the FIFO
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ */
+void lis3dh_fifo_stop(const lis3dh_t *dev);
+
+/**
+ * @brief Get the time between two samples at the current output data rate
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ *
+ * @return                  sample period in microseconds
+ * @return                  0 when powered down or on error
+ */
+uint32_t lis3dh_get_period(const lis3dh_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,12 @@
  * This driver implementation does not buffer the current values for each LED.
  * It expects the application to take care of this.
  *
+ * By default, the driver shifts out the values by toggling the data and clock
+ * pins. With the `lpd8808_spi` module, a strip connected to the SCK and MOSI
+ * lines of a SPI bus is driven by the SPI peripheral instead, which moves
+ * larger transfers by DMA on platforms that support it. The GPIO path stays
+ * available for strips configured with `SPI_UNDEF`.
+ *
  * @{
  * @file
  * @brief       Interface definition for the LPD8808 LED strip driver
@@ -32,11 +38,26 @@
 
 #include "color.h"
 #include "periph/gpio.h"
+#ifdef MODULE_LPD8808_SPI
+#include "periph/spi.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(MODULE_LPD8808_SPI) || defined(DOXYGEN)
+/**
+ * @brief   Number of bytes encoded for one SPI transfer
+ *
+ * The values are encoded into a buffer of this size on the stack, a multiple
+ * of the 3 bytes of one LED.
+ */
+#ifndef LPD8808_SPI_CHUNK
+#define LPD8808_SPI_CHUNK   (48U)
+#endif
+#endif
+
 /**
  * @brief   Parameters needed for configuration
  */
@@ -44,6 +65,13 @@ typedef struct {
     int led_cnt;        /**< number of LEDs on the strip */
     gpio_t pin_clk;     /**< pin connected to the strip's clock signal */
     gpio_t pin_dat;     /**< pin connected to the strip's data signal */
+#if defined(MODULE_LPD8808_SPI) || defined(DOXYGEN)
+    spi_t spi;          /**< SPI bus with SCK connected to the clock and MOSI
+                         *   to the data signal, SPI_UNDEF to use
+                         *   lpd8808_params_t::pin_clk and
+                         *   lpd8808_params_t::pin_dat instead */
+    spi_clk_t spi_clk;  /**< clock speed of lpd8808_params_t::spi */
+#endif
 } lpd8808_params_t;
 
 /**
@@ -29,7 +29,19 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+
 #include "periph/i2c.h"
+#include "periph/gpio.h"
+
+/**
+ * @brief   Maximum number of samples read from the FIFO in one bus transaction
+ *
+ * Every sample takes 12 bytes of stack while reading.
+ */
+#ifndef LSM6DSL_FIFO_BURST
+#define LSM6DSL_FIFO_BURST  (8U)
+#endif
 
 /**
  * @brief Data rate settings
@@ -97,6 +109,7 @@ typedef struct {
     uint8_t gyro_fs;            /**< gyroscope full scale */
     uint8_t acc_decimation;     /**< accelerometer decimation */
     uint8_t gyro_decimation;    /**< gyroscope decimation */
+    gpio_t int1;                /**< INT1 pin, GPIO_UNDEF if not connected */
 } lsm6dsl_params_t;
 
 /**
@@ -173,6 +186,59 @@ int lsm6dsl_read_gyro(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data);
  */
 int lsm6dsl_read_temp(const lsm6dsl_t *dev, int16_t *data);
 
+/**
+ * @brief Read the samples in the FIFO
+ *
+ * The FIFO holds the samples of the sensors with a decimation other than
+ * LSM6DSL_DECIMATION_NOT_IN_FIFO. If both sensors are in the FIFO, they must
+ * have the same decimation, and every sample read consumes one of each. The
+ * samples are read in bursts of up to LSM6DSL_FIFO_BURST samples per bus
+ * transaction.
+ *
+ * @param[in] dev    device to read
+ * @param[out] acc   accelerometer values, oldest first, may be NULL
+ * @param[out] gyro  gyroscope values, oldest first, may be NULL
+ * @param[in] numof  maximum number of samples to read
+ *
+ * @return number of samples read on success
+ * @return < 0 on error
+ */
+int lsm6dsl_read_fifo(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *acc,
+                      lsm6dsl_3d_data_t *gyro, size_t numof);
+
+/**
+ * @brief Signal reaching a FIFO level on INT1
+ *
+ * @p cb runs in interrupt context on the rising edge of INT1, which stays high
+ * until the FIFO is read below the watermark again.
+ *
+ * @param[in] dev        device to configure
+ * @param[in] watermark  number of samples that trigger @p cb
+ * @param[in] cb         callback for reaching the watermark
+ * @param[in] arg        argument passed to @p cb
+ *
+ * @return LSM6DSL_OK on success
+ * @return < 0 on error
+ */
+int lsm6dsl_fifo_start(const lsm6dsl_t *dev, unsigned watermark,
+                       gpio_cb_t cb, void *arg);
+
+/**
+ * @brief Stop signaling the FIFO level on INT1
+ *
+ * @param[in] dev    device to configure
+ */
+void lsm6dsl_fifo_stop(const lsm6dsl_t *dev);
+
+/**
+ * @brief Get the time between two samples in the FIFO
+ *
+ * @param[in] dev    device to query
+ *
+ * @return sample period in microseconds, 0 when the FIFO is not used
+ */
+uint32_t lsm6dsl_get_fifo_period(const lsm6dsl_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -146,6 +146,20 @@ struct mtd_desc {
      * @return < 0 value on error
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
+
+    /**
+     * @brief Get the address of a memory mapped Memory Technology Device (MTD)
+     *
+     * Only for devices whose whole content can be read from the address space
+     * of the CPU in one contiguous block, e.g. internal flash. May be NULL.
+     *
+     * @param[in]  dev      Pointer to the selected driver
+     * @param[out] addr     Address the first byte of the device is mapped to
+     *
+     * @return 0 on success
+     * @return < 0 value on error, e.g. if the device is not mapped currently
+     */
+    int (*mmap)(mtd_dev_t *dev, const void **addr);
 };
 
 /**
@@ -229,6 +243,22 @@ int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count);
  */
 int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power);
 
+/**
+ * @brief mtd_mmap Get the address a MTD device is mapped to
+ *
+ * The content of the device can be read from the returned address directly,
+ * without copying it with mtd_read().
+ *
+ * @param      mtd   the device to access
+ * @param[out] addr  the address of the first byte of the device
+ *
+ * @return 0 on success
+ * @return < 0 if an error occured
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return -ENOTSUP if @p mtd is not memory mapped
+ */
+int mtd_mmap(mtd_dev_t *mtd, const void **addr);
+
 #if defined(MODULE_VFS) || defined(DOXYGEN)
 /**
  * @brief MTD driver for VFS
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache MTD page cache
+ * @ingroup     drivers_storage
+ * @brief       Caches pages of another memory technology device
+ *
+ * This MTD stacks on another MTD (the parent) and keeps
+ * @ref MTD_CACHE_PAGES of its pages in RAM:
+ *
+ * - Reads are served from the cache. Reads of pages that are not cached load
+ *   the page and up to mtd_cache_t::read_ahead following pages. Reads of
+ *   whole pages that are not cached go directly to the parent, in a single
+ *   call for consecutive pages.
+ * - Writes only modify the cached page. The modified part of a page is
+ *   written to the parent in one go when the page is evicted, on
+ *   @ref mtd_cache_flush(), or before powering the device down.
+ * - Erasing drops the cached pages of the erased sectors.
+ *
+ * A written byte is expected to read back like written, i.e. only erased bits
+ * should be programmed, as the cache does not know how the parent combines
+ * old and new data.
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * static mtd_cache_t cache = {
+ *     .base = { .driver = &mtd_cache_driver },
+ *     .parent = (mtd_dev_t *)&flash,
+ *     .read_ahead = 1,
+ * };
+ *
+ * mtd_init(&cache.base);
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the MTD page cache
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Number of cached pages
+ */
+#ifndef MTD_CACHE_PAGES
+#define MTD_CACHE_PAGES         (4U)
+#endif
+
+/**
+ * @brief Maximum page size of the parent device
+ */
+#ifndef MTD_CACHE_PAGE_SIZE
+#define MTD_CACHE_PAGE_SIZE     (256U)
+#endif
+
+/**
+ * @brief Page number of an unused cache entry
+ */
+#define MTD_CACHE_PAGE_NONE     (UINT32_MAX)
+
+/**
+ * @brief A cached page
+ */
+typedef struct {
+    uint32_t page;              /**< page number, @ref MTD_CACHE_PAGE_NONE if unused */
+    uint32_t last_used;         /**< mtd_cache_t::tick at the last access */
+    uint16_t dirty_start;       /**< first byte not written to the parent yet */
+    uint16_t dirty_end;         /**< end of the bytes not written to the parent
+                                 *   yet, 0 if none */
+    uint8_t data[MTD_CACHE_PAGE_SIZE];  /**< content of the page */
+} mtd_cache_page_t;
+
+/**
+ * @brief Device descriptor for the MTD page cache
+ *
+ * This is an extension of the @c mtd_dev_t struct. The geometry is copied
+ * from the parent by @ref mtd_init().
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *parent;          /**< cached device */
+    uint8_t read_ahead;         /**< number of pages to load in addition to a
+                                 *   page that was read but not cached */
+    uint32_t tick;              /**< access counter for least recently used
+                                 *   replacement */
+    mutex_t lock;               /**< serializes access to the cache */
+    mtd_cache_page_t pages[MTD_CACHE_PAGES];  /**< cached pages */
+} mtd_cache_t;
+
+/**
+ * @brief MTD page cache operations table
+ *
+ * mtd_desc::init returns -EINVAL if the page size of the parent exceeds
+ * @ref MTD_CACHE_PAGE_SIZE.
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief Writes all modified pages to the parent device
+ *
+ * The pages stay cached.
+ *
+ * @param[in] cache     the cache
+ *
+ * @return 0 on success
+ * @return < 0 on error of the parent, the pages that could not be written
+ *         stay modified
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
@@ -44,8 +44,9 @@ typedef struct {
     uint8_t wren;            /**< Write enable */
     uint8_t rdsr;            /**< Read status register */
     uint8_t wrsr;            /**< Write status register */
-    uint8_t read;            /**< Read data bytes, 3 byte address */
-    uint8_t read_fast;       /**< Read data bytes, 3 byte address, at higher speed */
+    uint8_t read;            /**< Read data bytes */
+    uint8_t read_fast;       /**< Read data bytes, at higher speed, see
+                              *   @ref SPI_NOR_F_FAST_READ */
     uint8_t page_program;    /**< Page program */
     uint8_t sector_erase;    /**< Block erase 4 KiB */
     uint8_t block_erase_32k; /**< 32KiB block erase */
@@ -53,7 +54,6 @@ typedef struct {
     uint8_t chip_erase;      /**< Chip erase */
     uint8_t sleep;           /**< Deep power down */
     uint8_t wake;            /**< Release from deep power down */
-    /* TODO: enter 4 byte address mode for large memories */
 } mtd_spi_nor_opcode_t;
 
 /**
@@ -82,6 +82,13 @@ typedef struct __attribute__((packed)) {
  * @brief Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief Flag to set to read with the read_fast opcode
+ *
+ * Fast reads send a dummy byte after the address, in return most devices
+ * allow higher SPI clocks for them than for plain reads.
+ */
+#define SPI_NOR_F_FAST_READ (4)
 
 /**
  * @brief Device descriptor for serial flash memory devices
@@ -109,6 +116,15 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint32_t sec_addr_mask;
+    /**
+     * @brief next address of an erase in progress
+     *
+     * Managed by the driver, no need to touch outside the driver.
+     */
+    uint32_t erase_addr;
+    uint32_t erase_left;     /**< bytes still to erase, 0 if no erase is in progress */
+    uint32_t erase_unit;     /**< bytes erased with mtd_spi_nor_t::erase_op,
+                              *   0 if no erase is in progress */
     uint8_t addr_width;      /**< Number of bytes in addresses, usually 3 for small devices */
     /**
      * @brief number of right shifts to get the address to the start of the page
@@ -122,6 +138,7 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint8_t sec_addr_shift;
+    uint8_t erase_op;        /**< erase opcode of the erase in progress */
 } mtd_spi_nor_t;
 
 /**
@@ -129,6 +146,37 @@ typedef struct {
  */
 extern const mtd_desc_t mtd_spi_nor_driver;
 
+/**
+ * @brief Starts erasing sectors without waiting for the erase to complete
+ *
+ * Erasing takes tens to hundreds of milliseconds per sector, during which the
+ * caller can do something else. The erase of the next sector is started by
+ * @ref mtd_spi_nor_erase_poll(). Any other operation on @p dev first waits
+ * until the erase is completed.
+ *
+ * The same restrictions as for @ref mtd_erase() apply to @p addr and @p size.
+ *
+ * @param[in] dev   the device
+ * @param[in] addr  the address of the first sector to erase
+ * @param[in] size  the number of bytes to erase
+ *
+ * @return 0 if the erase was started
+ * @return -EOVERFLOW if @p addr or @p size are not valid
+ */
+int mtd_spi_nor_erase_async(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size);
+
+/**
+ * @brief Continues an erase started with @ref mtd_spi_nor_erase_async()
+ *
+ * Does not block, call it again later while it returns -EINPROGRESS.
+ *
+ * @param[in] dev   the device
+ *
+ * @return 0 if the erase is completed, or none was started
+ * @return -EINPROGRESS if the erase is still in progress
+ */
+int mtd_spi_nor_erase_poll(mtd_spi_nor_t *dev);
+
 /* Available opcode tables for known devices */
 /* Defined in mtd_spi_nor_configs.c */
 /**
@@ -140,6 +188,15 @@ extern const mtd_desc_t mtd_spi_nor_driver;
  * sensible for default values. */
 extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default;
 
+/**
+ * @brief Default command opcodes for 4 byte addresses
+ *
+ * Devices larger than 16 MiB need 4 byte addresses. These opcodes take them
+ * regardless of the address mode the device is in, use them with
+ * mtd_spi_nor_t::addr_width set to 4.
+ */
+extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes;
+
 #ifdef __cplusplus
 }
 #endif
@@ -205,6 +205,9 @@ extern "C" {
 #ifdef MODULE_L2FILTER
 #include "net/l2filter.h"
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
 
 enum {
     NETDEV_TYPE_UNKNOWN,
@@ -281,6 +284,9 @@ struct netdev {
 #ifdef MODULE_L2FILTER
     l2filter_t filter[L2FILTER_LISTSIZE];   /**< link layer address filters */
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    netstats_nb_table_t nb_stats;           /**< statistics per neighbor */
+#endif
 };
 
 /**
@@ -23,6 +23,9 @@
 #include "net/gnrc/nettype.h"
 #include "net/netopt.h"
 #include "net/netdev.h"
+#ifdef MODULE_IEEE802154_SECURITY
+#include "net/ieee802154_security.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,6 +80,70 @@ typedef enum {
                                          *   with the multiplexed preamble */
 } netdev_ieee802154_cca_mode_t;
 
+#if defined(MODULE_NETDEV_IEEE802154_MULTICHANNEL) || defined(DOXYGEN)
+/**
+ * @name    Multi-channel operation
+ * @brief   Definitions of the netdev_ieee802154_multichannel module
+ *
+ * Each neighbor may listen on its own channel, so frames to different
+ * neighbors are sent in parallel on different channels instead of one channel
+ * shared by the whole network. The device listens on its receive channel,
+ * set with @ref NETOPT_CHANNEL or by a hopping sequence, and switches to the
+ * channel of the destination only for the transmission of a frame. As the
+ * switch happens before the channel access, CCA and CSMA are done on the
+ * channel the frame is sent on.
+ *
+ * The upper layer switches with netdev_ieee802154_chan_tx_begin() before it
+ * sends and switches back with netdev_ieee802154_chan_tx_end() once the
+ * device reported the end of the transmission, gnrc_netdev does both for its
+ * IEEE 802.15.4 interfaces. MACs with a schedule (e.g. LWMAC, TSCH) set the
+ * receive channel of each slot with netdev_ieee802154_chan_hop().
+ * @{
+ */
+/**
+ * @brief   Number of neighbors with a receive channel of their own
+ */
+#ifndef NETDEV_IEEE802154_CHAN_NEIGHBORS
+#define NETDEV_IEEE802154_CHAN_NEIGHBORS    (8U)
+#endif
+
+/**
+ * @brief   No channel, channel 0 is valid in the sub-GHz band
+ */
+#define NETDEV_IEEE802154_CHAN_UNSET        (0xff)
+
+/**
+ * @brief   Receive channel of a neighbor
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< address of the neighbor */
+    uint8_t addr_len;                           /**< length of
+                                                 *   netdev_ieee802154_chan_nb_t::addr,
+                                                 *   0 for an unused entry */
+    uint8_t chan;                               /**< channel it listens on */
+} netdev_ieee802154_chan_nb_t;
+
+/**
+ * @brief   Multi-channel state of an IEEE 802.15.4 device
+ */
+typedef struct {
+    /**
+     * @brief   Receive channels of the neighbors
+     */
+    netdev_ieee802154_chan_nb_t nbs[NETDEV_IEEE802154_CHAN_NEIGHBORS];
+    const uint8_t *hop_seq;     /**< hopping sequence, NULL for none */
+    uint8_t hop_len;            /**< length of
+                                 *   netdev_ieee802154_multichannel_t::hop_seq */
+    /**
+     * @brief   Channel to return to after the current transmission,
+     *          @ref NETDEV_IEEE802154_CHAN_UNSET while the device is on its
+     *          receive channel
+     */
+    uint8_t rx_chan;
+} netdev_ieee802154_multichannel_t;
+/** @} */
+#endif
+
 /**
  * @brief Extended structure to hold IEEE 802.15.4 driver state
  *
@@ -112,6 +179,16 @@ typedef struct {
     uint8_t seq;                            /**< sequence number */
     uint8_t chan;                           /**< channel */
     uint16_t flags;                         /**< flags as defined above */
+#if defined(MODULE_IEEE802154_SECURITY) || defined(DOXYGEN)
+    /**
+     * @brief   Security state, frames are secured while
+     *          @ref NETDEV_IEEE802154_SECURITY_EN is set
+     */
+    ieee802154_sec_context_t sec_ctx;
+#endif
+#if defined(MODULE_NETDEV_IEEE802154_MULTICHANNEL) || defined(DOXYGEN)
+    netdev_ieee802154_multichannel_t mc;    /**< multi-channel state */
+#endif
     /** @} */
 } netdev_ieee802154_t;
 
@@ -143,7 +220,10 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
  * netdev_ieee802154_t::long_addr in device struct.
  * Additionally @ref NETDEV_IEEE802154_SRC_MODE_LONG,
  * @ref NETDEV_IEEE802154_RAW and, @ref NETDEV_IEEE802154_ACK_REQ in
- * netdev_ieee802154_t::flags can be set or unset.
+ * netdev_ieee802154_t::flags can be set or unset. With the
+ * ieee802154_security module, @ref NETOPT_ENCRYPTION sets or unsets
+ * @ref NETDEV_IEEE802154_SECURITY_EN and @ref NETOPT_ENCRYPTION_KEY sets the
+ * key of ieee802154_sec_context_t::key_index in netdev_ieee802154_t::sec_ctx.
  *
  * The setting of netdev_ieee802154_t::chan is omitted since the legality of
  * its value can be very device specific and can't be checked in this function.
@@ -165,6 +245,119 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
 int netdev_ieee802154_set(netdev_ieee802154_t *dev, netopt_t opt, void *value,
                           size_t value_len);
 
+#if defined(MODULE_NETDEV_IEEE802154_MULTICHANNEL) || defined(DOXYGEN)
+/**
+ * @brief   Initializes the multi-channel state of a device
+ *
+ * The device has no neighbors with a channel of their own and no hopping
+ * sequence afterwards.
+ *
+ * @param[in] dev   network device descriptor
+ */
+void netdev_ieee802154_chan_init(netdev_ieee802154_t *dev);
+
+/**
+ * @brief   Sets the receive channel of a neighbor
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] addr      address of the neighbor
+ * @param[in] addr_len  length of @p addr
+ * @param[in] chan      channel the neighbor listens on,
+ *                      @ref NETDEV_IEEE802154_CHAN_UNSET to send to it on the
+ *                      receive channel of @p dev again
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p addr_len is no length of an IEEE 802.15.4 address
+ * @return  -ENOMEM, if there is no room for another neighbor
+ */
+int netdev_ieee802154_chan_nb_set(netdev_ieee802154_t *dev,
+                                  const uint8_t *addr, size_t addr_len,
+                                  uint8_t chan);
+
+/**
+ * @brief   Gets the receive channel of a neighbor
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] addr      address of the neighbor
+ * @param[in] addr_len  length of @p addr
+ *
+ * @return  channel the neighbor listens on
+ * @return  @ref NETDEV_IEEE802154_CHAN_UNSET, if it has no channel of its own
+ */
+uint8_t netdev_ieee802154_chan_nb_get(const netdev_ieee802154_t *dev,
+                                      const uint8_t *addr, size_t addr_len);
+
+/**
+ * @brief   Switches to the channel of a destination before sending to it
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] dst       destination address
+ * @param[in] dst_len   length of @p dst
+ *
+ * @return  1, if the device switched the channel
+ * @return  0, if the frame is sent on the receive channel
+ * @return  <0 on error of the device
+ */
+int netdev_ieee802154_chan_tx_begin(netdev_ieee802154_t *dev,
+                                    const uint8_t *dst, size_t dst_len);
+
+/**
+ * @brief   Switches back to the receive channel after a transmission
+ *
+ * To be called on @ref NETDEV_EVENT_TX_COMPLETE, @ref NETDEV_EVENT_TX_NOACK
+ * and @ref NETDEV_EVENT_TX_MEDIUM_BUSY. Does nothing, if the device did not
+ * switch for the transmission.
+ *
+ * @param[in] dev   network device descriptor
+ */
+void netdev_ieee802154_chan_tx_end(netdev_ieee802154_t *dev);
+
+/**
+ * @brief   Sets the hopping sequence of the receive channel
+ *
+ * @param[in] dev   network device descriptor
+ * @param[in] seq   channels to hop through, must stay valid while set,
+ *                  NULL to stop hopping
+ * @param[in] len   number of channels in @p seq
+ */
+void netdev_ieee802154_chan_hop_set(netdev_ieee802154_t *dev,
+                                    const uint8_t *seq, uint8_t len);
+
+/**
+ * @brief   Sets the receive channel of a slot from the hopping sequence
+ *
+ * The channel of @p slot is `seq[slot % len]`, so the MAC derives @p slot
+ * from its schedule, e.g. the absolute slot number plus the channel offset
+ * of the link for TSCH. When called during a transmission on another
+ * channel, the device switches to the new channel at its end.
+ *
+ * @param[in] dev   network device descriptor
+ * @param[in] slot  number of the slot
+ *
+ * @return  the new receive channel
+ * @return  -ENOTSUP, if no hopping sequence is set
+ * @return  <0 on error of the device
+ */
+int netdev_ieee802154_chan_hop(netdev_ieee802154_t *dev, uint32_t slot);
+
+/**
+ * @brief   Chooses the first clear one of a number of channels
+ *
+ * Does a CCA on each channel with @ref NETOPT_IS_CHANNEL_CLR and stays on
+ * the first clear one, e.g. to choose a quiet receive channel.
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] chans     candidate channels
+ * @param[in] numof     number of channels in @p chans
+ *
+ * @return  the chosen channel
+ * @return  -EBUSY, if no channel is clear, the device stays on its channel
+ * @return  <0 on error of the device
+ */
+int netdev_ieee802154_chan_select(netdev_ieee802154_t *dev,
+                                  const uint8_t *chans, unsigned numof);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,12 @@
  * @ingroup     drivers_actuators
  * @brief       Driver for PCD8544 LCD displays
  *
+ * By default, all functions write to the display right away. With the
+ * `pcd8544_fb` module, a framebuffer can be attached with
+ * pcd8544_fb_attach(). The drawing functions then only change the
+ * framebuffer and pcd8544_flush() transfers the changed parts to the display
+ * without waiting for the transfer, by DMA where the platform supports it.
+ *
  * @{
  *
  * @file
@@ -22,10 +28,14 @@
 #ifndef PCD8544_H
 #define PCD8544_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "periph/gpio.h"
 #include "periph/spi.h"
+#ifdef MODULE_PCD8544_FB
+#include "fb_page.h"
+#endif
 
 #ifdef __cplusplus
  extern "C" {
@@ -50,6 +60,18 @@
 #define PCD8544_DEFAULT_TEMPCOEF        (0U)
 /** @} */
 
+#if defined(MODULE_PCD8544_FB) || defined(DOXYGEN)
+/**
+ * @brief   Framebuffer of a PCD8544 display
+ */
+typedef struct {
+    fb_page_t fb;                               /**< framebuffer */
+    fb_page_dirty_t dirty[PCD8544_ROWS];        /**< changes of each page */
+    uint8_t buf[PCD8544_RES_X * PCD8544_ROWS];  /**< content */
+    volatile uint8_t state;                     /**< state of the transfer */
+} pcd8544_fb_t;
+#endif
+
 /**
  * @brief   PCD8544 device descriptor
  */
@@ -59,6 +81,9 @@ typedef struct {
     gpio_t reset;       /**< reset pin, low: active */
     gpio_t mode;        /**< mode pin: low: cmd mode, high: data mode */
     uint8_t inverted;   /**< internal flag to keep track of inversion state */
+#if defined(MODULE_PCD8544_FB) || defined(DOXYGEN)
+    pcd8544_fb_t *fb;   /**< attached framebuffer, NULL for none */
+#endif
 } pcd8544_t;
 
 /**
@@ -194,6 +219,49 @@ void pcd8544_poweroff(const pcd8544_t *dev);
  */
 void pcd8544_riot(const pcd8544_t *dev);
 
+#if defined(MODULE_PCD8544_FB) || defined(DOXYGEN)
+/**
+ * @brief   Attach a framebuffer to the display
+ *
+ * The framebuffer is cleared. As the content of the display is unknown, the
+ * next flushes transfer the whole framebuffer.
+ *
+ * @param[in] dev           device descriptor of display to use
+ * @param[in] fb            framebuffer to draw to, NULL to write to the
+ *                          display right away again
+ */
+void pcd8544_fb_attach(pcd8544_t *dev, pcd8544_fb_t *fb);
+
+/**
+ * @brief   Set or clear a pixel in the attached framebuffer
+ *
+ * @param[in] dev           device descriptor of display to use
+ * @param[in] x             column of the pixel [0 - 83]
+ * @param[in] y             row of the pixel [0 - 47]
+ * @param[in] on            true for a dark pixel
+ */
+void pcd8544_set_pixel(const pcd8544_t *dev, uint8_t x, uint8_t y, bool on);
+
+/**
+ * @brief   Transfer the next changed part of the attached framebuffer
+ *
+ * Starts the transfer of the changed columns of the next changed row and
+ * returns without waiting for the end of the transfer, if the platform
+ * moves it by DMA. Call it again, e.g. from the main loop, until it returns
+ * 0 to bring the whole display up to date. Changes only cost the transfer of
+ * the changed columns.
+ *
+ * The SPI bus stays acquired from the start of a transfer to the next call
+ * of any of the functions of the display.
+ *
+ * @param[in] dev           device descriptor of display to use
+ *
+ * @return      1, if a transfer is running or changes are left
+ * @return      0, if the display is up to date
+ */
+int pcd8544_flush(const pcd8544_t *dev);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
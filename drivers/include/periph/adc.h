@@ -30,7 +30,11 @@
  * waiting for the result of a conversion (e.g. through putting the calling
  * thread to sleep while waiting for the conversion results).
  *
- * @todo        Extend interface for continuous mode?
+ * For signal processing, adc_stream_start() samples one or more lines of the
+ * same ADC device continuously at a given rate. A hardware timer triggers the
+ * conversions and the DMA moves the results into a buffer, that is used as two
+ * halves: one is filled while the callback processes the other one. This
+ * continuous mode is provided by the `periph_adc_stream` feature.
  *
  * @{
  *
@@ -44,6 +48,8 @@
 #define PERIPH_ADC_H
 
 #include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -123,6 +129,54 @@ int adc_init(adc_t line);
  */
 int adc_sample(adc_t line, adc_res_t res);
 
+/**
+ * @brief   Signature of the callback of adc_stream_start()
+ *
+ * @param[in] arg           argument given to adc_stream_start()
+ * @param[in] samples       the half of the buffer that was filled last, the
+ *                          samples of one point of time follow each other in
+ *                          the order of the lines
+ * @param[in] len           number of samples at @p samples
+ */
+typedef void (*adc_stream_cb_t)(void *arg, const uint16_t *samples, size_t len);
+
+/**
+ * @brief   Sample the given ADC lines continuously
+ *
+ * The lines must be initialized with adc_init() and belong to the same ADC
+ * device, which is reserved for the stream until adc_stream_stop().
+ *
+ * @p cb runs in interrupt context each time half of @p buf is filled, and has
+ * to be done with that half when the other one is full. Use a @p len that
+ * gives the callback enough time, e.g. at a @p rate of 20kHz, a buffer of
+ * 2 * 512 samples leaves 25.6ms for each half.
+ *
+ * @param[in] lines         lines to sample, in the order of the samples
+ * @param[in] numof         number of lines in @p lines
+ * @param[in] res           resolution to use for conversion
+ * @param[in] rate          sampling rate of each line in Hz
+ * @param[out] buf          buffer for the samples
+ * @param[in] len           number of samples @p buf holds, a multiple of
+ *                          2 * @p numof
+ * @param[in] cb            called with each filled half of @p buf
+ * @param[in] arg           argument passed to @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 if the lines, resolution, rate or buffer length
+ *                          are not applicable
+ * @return                  -2 if no trigger timer or DMA channel is available
+ */
+int adc_stream_start(const adc_t *lines, unsigned numof, adc_res_t res,
+                     uint32_t rate, uint16_t *buf, size_t len,
+                     adc_stream_cb_t cb, void *arg);
+
+/**
+ * @brief   Stop the continuous sampling of adc_stream_start()
+ *
+ * @param[in] line          one of the lines of the stream
+ */
+void adc_stream_stop(adc_t line);
+
 #ifdef __cplusplus
 }
 #endif
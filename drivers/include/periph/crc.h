@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crc CRC
+ * @ingroup     drivers_periph
+ * @brief       Low-level CRC unit peripheral driver
+ *
+ * Computes the CRC32 of IEEE 802.3 on the CRC unit of the MCU. This is the
+ * backend of @ref sys_checksum_crc32, which handles the parts of the data
+ * the CRC unit can not process and falls back to software when it is busy,
+ * so applications should use that instead.
+ *
+ * @{
+ * @file
+ * @brief       Low-level CRC peripheral driver interface definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef PERIPH_CRC_H
+#define PERIPH_CRC_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "periph_cpu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Continues a CRC32 on the CRC unit
+ *
+ * @param[in,out] reg   The CRC register, i.e. the complement of the CRC
+ *                      (0xFFFFFFFF for a new CRC)
+ * @param[in] data      Start of the memory area to checksum, word aligned
+ * @param[in] len       Number of bytes to checksum
+ *
+ * @return  Number of bytes processed from the start of @p data, a multiple
+ *          of 4. 0 if the CRC unit is busy.
+ */
+size_t crc_update32(uint32_t *reg, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRC_H */
+/**
+ * @}
+ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_dma DMA
+ * @ingroup     drivers_periph
+ * @brief       Low-level DMA peripheral driver
+ *
+ * This interface moves blocks of data between memory and peripherals (or
+ * between two memory areas) without the CPU.
+ *
+ * A DMA channel is a shared resource that is bound to a trigger, i.e. the
+ * request line of a peripheral that paces the transfer. A driver acquires a
+ * channel for its trigger with dma_acquire(), usually once during its
+ * initialization, and returns it with dma_release().
+ *
+ * The triggers are CPU specific: on STM32 they name the DMA controller,
+ * stream and channel of the peripheral request, on SAM0 they are the trigger
+ * IDs of the vendor headers (e.g. `SERCOM0_DMAC_ID_TX`). Transfers between
+ * two memory areas use @ref DMA_TRIGGER_MEM.
+ *
+ * A transfer is described by a dma_xfer_t. dma_start() starts it and calls
+ * the callback from interrupt context when it is done, dma_transfer() blocks
+ * the calling thread until then.
+ *
+ * @{
+ * @file
+ * @brief       Low-level DMA peripheral driver interface definition
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef PERIPH_DMA_H
+#define PERIPH_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "periph_cpu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Define global value for an undefined DMA channel
+ */
+#ifndef DMA_UNDEF
+#define DMA_UNDEF       (UINT_MAX)
+#endif
+
+/**
+ * @brief   Default type for DMA channels
+ */
+#ifndef HAVE_DMA_T
+typedef unsigned int dma_t;
+#endif
+
+/**
+ * @brief   Default type for DMA triggers
+ */
+#ifndef HAVE_DMA_TRIGGER_T
+typedef unsigned int dma_trigger_t;
+#endif
+
+/**
+ * @brief   Status codes used by the DMA driver interface
+ */
+enum {
+    DMA_HALF        =  1,   /**< the first half of the transfer is done */
+    DMA_OK          =  0,   /**< everything went as planned */
+    DMA_NODEV       = -1,   /**< invalid DMA channel specified */
+    DMA_NOLEN       = -2,   /**< transfer length is not supported */
+    DMA_ERR         = -3    /**< bus error during the transfer */
+};
+
+/**
+ * @brief   Direction of a transfer
+ */
+typedef enum {
+    DMA_MEM_TO_MEM,         /**< from memory to memory */
+    DMA_MEM_TO_PERIPH,      /**< from memory to a peripheral register */
+    DMA_PERIPH_TO_MEM       /**< from a peripheral register to memory */
+} dma_dir_t;
+
+/**
+ * @brief   Size of a single transfer (beat)
+ */
+typedef enum {
+    DMA_WIDTH_BYTE,         /**< 8 bit */
+    DMA_WIDTH_HALF_WORD,    /**< 16 bit */
+    DMA_WIDTH_WORD          /**< 32 bit */
+} dma_width_t;
+
+/**
+ * @name    Flags of a transfer
+ * @{
+ */
+#define DMA_INC_SRC     (0x01)  /**< increment the source address */
+#define DMA_INC_DST     (0x02)  /**< increment the destination address */
+#define DMA_CIRCULAR    (0x04)  /**< start over at the end, until stopped */
+#define DMA_HALF_IRQ    (0x08)  /**< call the callback at half of the
+                                 *   transfer as well */
+/** @} */
+
+/**
+ * @brief   Descriptor of a transfer
+ *
+ * Peripheral registers are usually read or written without incrementing
+ * their address, memory buffers with.
+ */
+typedef struct {
+    const volatile void *src;   /**< source address */
+    volatile void *dst;         /**< destination address */
+    size_t len;                 /**< number of beats, not bytes */
+    dma_dir_t dir;              /**< direction of the transfer */
+    dma_width_t width;          /**< size of a beat */
+    uint8_t flags;              /**< DMA_INC_SRC, DMA_INC_DST, DMA_CIRCULAR
+                                 *   and DMA_HALF_IRQ */
+} dma_xfer_t;
+
+/**
+ * @brief   Signature of the callback of a finished transfer
+ *
+ * @param[in] arg       argument given to dma_start()
+ * @param[in] res       DMA_OK on success, DMA_HALF at half of a transfer
+ *                      with DMA_HALF_IRQ, DMA_ERR on a bus error
+ */
+typedef void (*dma_cb_t)(void *arg, int res);
+
+/**
+ * @brief   Acquire a DMA channel for a trigger
+ *
+ * @param[in] trigger   CPU specific trigger of the peripheral, or
+ *                      @ref DMA_TRIGGER_MEM
+ *
+ * @return  the channel
+ * @return  DMA_UNDEF if no channel is free for @p trigger
+ */
+dma_t dma_acquire(dma_trigger_t trigger);
+
+/**
+ * @brief   Release a DMA channel, stopping any running transfer
+ *
+ * @param[in] dma       channel to release
+ */
+void dma_release(dma_t dma);
+
+/**
+ * @brief   Start a transfer
+ *
+ * @p xfer is only read by this function and may be reused afterwards, the
+ * buffers it points to must stay valid until the transfer is done.
+ *
+ * A transfer with DMA_CIRCULAR starts over with the original addresses each
+ * time it is done and keeps running until dma_stop(). @p cb is called for
+ * every round then, which together with DMA_HALF_IRQ turns the destination
+ * into a double buffer for continuous reception.
+ *
+ * @param[in] dma       channel to use, no transfer running on it
+ * @param[in] xfer      the transfer
+ * @param[in] cb        called from interrupt context when the transfer is
+ *                      done, may be NULL
+ * @param[in] arg       argument passed to @p cb
+ *
+ * @return  DMA_OK on success
+ * @return  DMA_NOLEN if @p xfer has more than @ref DMA_MAX_LEN beats or none,
+ *          or less than two with DMA_HALF_IRQ
+ */
+int dma_start(dma_t dma, const dma_xfer_t *xfer, dma_cb_t cb, void *arg);
+
+/**
+ * @brief   Stop the running transfer of a channel, without calling its
+ *          callback
+ *
+ * @param[in] dma       channel to stop
+ */
+void dma_stop(dma_t dma);
+
+/**
+ * @brief   Get the number of beats a channel has still to transfer
+ *
+ * For a circular transfer this tells how far the current round got.
+ *
+ * @param[in] dma       channel to query
+ *
+ * @return  the number of beats left of the running or the last transfer
+ */
+unsigned dma_remaining(dma_t dma);
+
+/**
+ * @brief   Run a transfer and block until it is done
+ *
+ * DMA_CIRCULAR is not allowed here, as such a transfer is never done.
+ *
+ * @param[in] dma       channel to use, no transfer running on it
+ * @param[in] xfer      the transfer
+ *
+ * @return  DMA_OK on success
+ * @return  DMA_NOLEN if @p xfer has more than @ref DMA_MAX_LEN beats or none
+ * @return  DMA_ERR on a bus error
+ */
+int dma_transfer(dma_t dma, const dma_xfer_t *xfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_DMA_H */
+/** @} */
@@ -12,12 +12,14 @@
  * @brief       Low-level flash page interface
  *
  * This interface provides a very simple and straight forward way for writing
- * a MCU's internal flash. This interface is only capable of reading, verifying,
- * and writing complete flash pages, it has no support for partial flash access.
- * This enables for very slim and efficient implementations.
+ * a MCU's internal flash. The page based functions are only capable of
+ * reading, verifying, and writing complete flash pages. This enables for very
+ * slim and efficient implementations.
  *
- * A module for more fine-grained access of memory locations can easily be
- * programmed on top of this interface.
+ * CPUs that define @ref FLASHPAGE_RAW_BLOCKSIZE additionally allow to program
+ * single blocks of already erased flash with flashpage_write_raw(). On top of
+ * that, the @ref flashpage_writer_t buffers modifications of arbitrary flash
+ * locations and only erases a page if the modified blocks are not erased.
  *
  * @note        Flash memory has only a limited amount of erase cycles (mostly
  *              around 10K times), so using this interface in some kind of loops
@@ -33,6 +35,7 @@
 #ifndef PERIPH_FLASHPAGE_H
 #define PERIPH_FLASHPAGE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "periph_cpu.h"
@@ -58,6 +61,19 @@ extern "C" {
 #error "periph/flashpage: FLASHPAGE_NUMOF not defined"
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief   Smallest number of bytes flashpage_write_raw() can program
+ *
+ * Defined by the CPU if it supports flashpage_write_raw().
+ */
+#define FLASHPAGE_RAW_BLOCKSIZE
+/**
+ * @brief   Required alignment of the addresses given to flashpage_write_raw()
+ */
+#define FLASHPAGE_RAW_ALIGNMENT
+#endif
+
 /**
  * @brief   Return values used in this interface
  */
@@ -141,6 +157,67 @@ int flashpage_verify(int page, void *data);
  */
 int flashpage_write_and_verify(int page, void *data);
 
+#if defined(FLASHPAGE_RAW_BLOCKSIZE) || defined(DOXYGEN)
+/**
+ * @brief   Program blocks of erased flash with the given data
+ *
+ * Unlike flashpage_write(), nothing is erased, so the target region must be
+ * erased before. The region may span several pages.
+ *
+ * @param[in] target_addr   address to write to, aligned to
+ *                          @ref FLASHPAGE_RAW_ALIGNMENT
+ * @param[in] data          data to write, aligned to
+ *                          @ref FLASHPAGE_RAW_ALIGNMENT
+ * @param[in] len           number of bytes to write, a multiple of
+ *                          @ref FLASHPAGE_RAW_BLOCKSIZE
+ */
+void flashpage_write_raw(void *target_addr, const void *data, size_t len);
+
+/**
+ * @brief   Buffered writer for arbitrary flash locations
+ *
+ * The writer holds a copy of one page. Writes to that page only modify the
+ * copy. When a different page is written or on flashpage_writer_flush(), the
+ * modified blocks are programmed with flashpage_write_raw() if they are still
+ * erased, only otherwise the whole page is erased and rewritten.
+ *
+ * The writer needs @ref FLASHPAGE_SIZE bytes of RAM.
+ */
+typedef struct {
+    int page;                   /**< buffered page, -1 if none */
+    uint16_t start;             /**< first modified byte of the page */
+    uint16_t end;               /**< end of the modified bytes, 0 if none */
+    uint32_t buf[FLASHPAGE_SIZE / sizeof(uint32_t)];  /**< the page copy */
+} flashpage_writer_t;
+
+/**
+ * @brief   Initialize a buffered writer
+ *
+ * @param[out] writer   the writer
+ */
+void flashpage_writer_init(flashpage_writer_t *writer);
+
+/**
+ * @brief   Write data to an arbitrary flash location
+ *
+ * The data is written to flash at the latest by flashpage_writer_flush().
+ *
+ * @param[in] writer    the writer
+ * @param[in] addr      flash address to write to
+ * @param[in] data      data to write
+ * @param[in] len       number of bytes to write
+ */
+void flashpage_writer_write(flashpage_writer_t *writer, void *addr,
+                            const void *data, size_t len);
+
+/**
+ * @brief   Write the buffered modifications to flash
+ *
+ * @param[in] writer    the writer
+ */
+void flashpage_writer_flush(flashpage_writer_t *writer);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,15 @@
  * definitions in `RIOT/boards/ * /include/periph_conf.h` will define the selected
  * GPIO pin.
  *
+ * Platforms providing the `periph_gpio_port` feature additionally allow to
+ * read and write all pins of a port at once, e.g. for parallel buses. The
+ * port is taken from any of its pins with gpio_port(), the position of a pin
+ * in the port's value with gpio_port_pin_mask(). gpio_port_write_masked()
+ * uses the set and clear registers of the port, so every selected pin changes
+ * at most once and other pins of the port are never touched. Where the
+ * hardware has a combined set/reset register (e.g. STM32), all pins change
+ * with a single register write.
+ *
  * @{
  * @file
  * @brief       Low-level GPIO peripheral driver interface definitions
@@ -54,6 +63,7 @@
 #define PERIPH_GPIO_H
 
 #include <limits.h>
+#include <stdint.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -84,6 +94,13 @@ typedef unsigned int gpio_t;
 #define GPIO_UNDEF          ((gpio_t)(UINT_MAX))
 #endif
 
+#if !defined(HAVE_GPIO_PORT_T) || defined(DOXYGEN)
+/**
+ * @brief   GPIO port identifier, the base address of the port's registers
+ */
+typedef uintptr_t gpio_port_t;
+#endif
+
 /**
  * @brief   Available pin modes
  *
@@ -219,6 +236,49 @@ void gpio_toggle(gpio_t pin);
  */
 void gpio_write(gpio_t pin, int value);
 
+/**
+ * @brief   Get the port of the given pin
+ *
+ * @note    Only available on platforms providing the `periph_gpio_port`
+ *          feature
+ *
+ * @param[in] pin       any pin of the port
+ *
+ * @return              the port @p pin belongs to
+ */
+gpio_port_t gpio_port(gpio_t pin);
+
+/**
+ * @brief   Get the bit of the given pin in the value of its port
+ *
+ * @param[in] pin       the pin
+ *
+ * @return              mask with only the bit of @p pin set
+ */
+uint32_t gpio_port_pin_mask(gpio_t pin);
+
+/**
+ * @brief   Get the current value of all pins of a port
+ *
+ * @param[in] port      the port to read
+ *
+ * @return              the levels applied to the pins, one bit per pin
+ */
+uint32_t gpio_port_read(gpio_port_t port);
+
+/**
+ * @brief   Set a number of pins of a port to the given values
+ *
+ * Only pins configured as output are affected. Pins not selected by @p mask
+ * keep their value, so the function can be used while other pins of the port
+ * are driven from a different context.
+ *
+ * @param[in] port      the port to write
+ * @param[in] mask      pins to change, one bit per pin
+ * @param[in] value     new values of the pins in @p mask, one bit per pin
+ */
+void gpio_port_write_masked(gpio_port_t port, uint32_t mask, uint32_t value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -129,6 +129,16 @@ typedef enum {
 #endif
 /** @} */
 
+/**
+ * @brief   One step of i2c_transfer_reg_list()
+ */
+typedef struct {
+    uint8_t reg;            /**< register address on the target device */
+    uint8_t flags;          /**< I2C_FLAG_READ or I2C_FLAG_WRITE */
+    void *data;             /**< bytes to read into or to write */
+    int length;             /**< number of bytes to transfer */
+} i2c_reg_xfer_t;
+
 /**
  * @brief   Initialize an I2C device to run as bus master
  *
@@ -274,6 +284,25 @@ int i2c_write_reg(i2c_t dev, uint8_t address, uint8_t reg, uint8_t data);
 int i2c_write_regs(i2c_t dev, uint8_t address, uint8_t reg,
                    const void *data, int length);
 
+/**
+ * @brief   Read and write a list of registers at the I2C slave with the given
+ *          address
+ *
+ * The steps run back to back, the bus must be acquired by the caller. This
+ * saves the calls and bus lock handling of a driver that reads several
+ * registers per sample.
+ *
+ * @param[in] dev           I2C peripheral device
+ * @param[in] address       bus address of the target device
+ * @param[in] xfers         the steps, in order
+ * @param[in] numof         number of steps in @p xfers
+ *
+ * @return                  the number of steps that were done completely,
+ *                          the list ends at the first failing step
+ */
+int i2c_transfer_reg_list(i2c_t dev, uint8_t address,
+                          const i2c_reg_xfer_t *xfers, unsigned numof);
+
 /**
  * @brief   Power on the given I2C peripheral
  *
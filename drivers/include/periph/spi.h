@@ -124,6 +124,24 @@ enum {
     SPI_NOCLK       = -4    /**< selected clock value is not supported */
 };
 
+/**
+ * @brief   Signature of the callback of spi_transfer_bytes_async()
+ *
+ * @param[in] arg       argument given to spi_transfer_bytes_async()
+ */
+typedef void (*spi_cb_t)(void *arg);
+
+/**
+ * @brief   One step of spi_transfer_reg_list()
+ */
+typedef struct {
+    uint8_t reg;            /**< register address to transfer data to/from */
+    const void *out;        /**< buffer to send data from, NULL if only
+                             *   receiving */
+    void *in;               /**< buffer to read into, NULL if only sending */
+    size_t len;             /**< number of bytes to transfer */
+} spi_reg_xfer_t;
+
 /**
  * @brief   Available SPI modes, defining the configuration of clock polarity
  *          and clock phase
@@ -285,6 +303,32 @@ uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out);
 void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
                         const void *out, void *in, size_t len);
 
+/**
+ * @brief   Transfer a number bytes using the given SPI bus without waiting
+ *          for the end of the transfer
+ *
+ * On platforms that move larger transfers by DMA, this function returns
+ * right after starting the transfer and @p cb is called from interrupt
+ * context when it is done. Otherwise the transfer is done right away and
+ * @p cb is called before this function returns.
+ *
+ * The bus must stay acquired and no other transfer must be started on it
+ * until @p cb was called, the buffers must stay valid until then.
+ *
+ * @param[in]  bus      SPI device to use
+ * @param[in]  cs       chip select pin/line to use, set to SPI_CS_UNDEF if chip
+ *                      select should not be handled by the SPI driver
+ * @param[in]  cont     if true, keep device selected after transfer
+ * @param[in]  out      buffer to send data from, set NULL if only receiving
+ * @param[out] in       buffer to read into, set NULL if only sending
+ * @param[in]  len      number of bytes to transfer
+ * @param[in]  cb       called when the transfer is done
+ * @param[in]  arg      argument passed to @p cb
+ */
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg);
+
 /**
  * @brief   Transfer one byte to/from a given register address
  *
@@ -318,6 +362,23 @@ uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out);
 void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
                        const void *out, void *in, size_t len);
 
+/**
+ * @brief   Transfer a list of registers, each like spi_transfer_regs()
+ *
+ * The chip select is released after every step. The steps run back to back
+ * on the acquired bus and are chained from the completion of the previous
+ * one, so on platforms with asynchronous transfers the calling thread sleeps
+ * until the whole list is done.
+ *
+ * @param[in]  bus      SPI device to use
+ * @param[in]  cs       chip select pin/line to use, set to SPI_CS_UNDEF if chip
+ *                      select should not be handled by the SPI driver
+ * @param[in]  xfers    the steps, in order
+ * @param[in]  numof    number of steps in @p xfers
+ */
+void spi_transfer_reg_list(spi_t bus, spi_cs_t cs,
+                           const spi_reg_xfer_t *xfers, unsigned numof);
+
 #ifdef __cplusplus
 }
 #endif
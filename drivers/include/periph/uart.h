@@ -93,6 +93,22 @@ typedef unsigned int uart_t;
  */
 typedef void(*uart_rx_cb_t)(void *arg, uint8_t data);
 
+/**
+ * @brief   Signature for the callback of uart_init_rx_dma()
+ *
+ * @param[in] arg           context to the callback (optional)
+ * @param[in] data          the bytes received since the last call
+ * @param[in] len           number of bytes at @p data
+ */
+typedef void(*uart_rx_span_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Signature for the callback of uart_write_async()
+ *
+ * @param[in] arg           context to the callback (optional)
+ */
+typedef void(*uart_tx_cb_t)(void *arg);
+
 /**
  * @brief   Interrupt context for a UART device
  * @{
@@ -142,6 +158,36 @@ enum {
  */
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
 
+/**
+ * @brief   Initialize a given UART device to receive into a circular buffer
+ *
+ * Where the CPU supports it, the received bytes are moved by DMA into @p buf,
+ * and @p rx_cb is called with the new part of @p buf when the RX line goes
+ * idle and when half or all of @p buf is filled. Compared to uart_init(), this
+ * costs a few interrupts per burst instead of one per byte.
+ *
+ * @p rx_cb has to consume the bytes before the DMA comes around again, so
+ * @p buf should hold at least twice as many bytes as arrive during the
+ * longest time the callback may be delayed.
+ *
+ * Without DMA this falls back to uart_init(), with @p rx_cb called for every
+ * byte and @p buf unused.
+ *
+ * @param[in] uart          UART device to initialize
+ * @param[in] baudrate      desired baudrate in baud/s
+ * @param[in] buf           circular receive buffer
+ * @param[in] size          size of @p buf in bytes
+ * @param[in] rx_cb         receive callback, executed in interrupt context
+ * @param[in] arg           optional context passed to @p rx_cb
+ *
+ * @return                  UART_OK on success
+ * @return                  UART_NODEV on invalid UART device
+ * @return                  UART_NOBAUD on inapplicable baudrate
+ * @return                  UART_INTERR on other errors
+ */
+int uart_init_rx_dma(uart_t uart, uint32_t baudrate, uint8_t *buf,
+                     size_t size, uart_rx_span_cb_t rx_cb, void *arg);
+
 /**
  * @brief   Write data from the given buffer to the specified UART device
  *
@@ -156,6 +202,29 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
  */
 void uart_write(uart_t uart, const uint8_t *data, size_t len);
 
+/**
+ * @brief   Start writing data from the given buffer to the specified UART
+ *          device
+ *
+ * Where the CPU supports it (`PERIPH_UART_HAS_WRITE_ASYNC`), this returns
+ * right away and the data is sent from interrupt context. @p cb is called,
+ * in interrupt context, once all of @p data was handed to the hardware, so
+ * @p data must stay valid until then. Otherwise this falls back to
+ * uart_write() and calls @p cb before returning.
+ *
+ * Only one write can be pending per device. Starting another one, or calling
+ * uart_write(), completes the pending one by polling first, so the order of
+ * the data is kept.
+ *
+ * @param[in] uart          UART device to use for transmission
+ * @param[in] data          data buffer to send
+ * @param[in] len           number of bytes to send
+ * @param[in] cb            callback, may be NULL
+ * @param[in] arg           optional context passed to @p cb
+ */
+void uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                      uart_tx_cb_t cb, void *arg);
+
 /**
  * @brief   Power on the given UART device
  *
@@ -44,6 +44,7 @@
 #ifndef SAUL_H
 #define SAUL_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <errno.h>
 
@@ -136,6 +137,63 @@ typedef int(*saul_read_t)(const void *dev, phydat_t *res);
  */
 typedef int(*saul_write_t)(const void *dev, phydat_t *data);
 
+/**
+ * @brief   Signature of the callback a device calls when its FIFO reached the
+ *          watermark
+ *
+ * @note    This is called in interrupt context, read the samples from a thread
+ *
+ * @param[in] arg       argument given when starting the FIFO
+ */
+typedef void(*saul_notify_t)(void *arg);
+
+/**
+ * @brief   Start collecting samples in the hardware FIFO of a device
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[in] watermark number of samples in the FIFO that trigger @p cb
+ * @param[in] cb        callback for reaching the watermark
+ * @param[in] arg       argument passed to @p cb
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if the device can not signal the watermark
+ * @return  -ECANCELED on other errors
+ */
+typedef int(*saul_fifo_start_t)(const void *dev, unsigned watermark,
+                                saul_notify_t cb, void *arg);
+
+/**
+ * @brief   Stop collecting samples in the hardware FIFO of a device
+ *
+ * @param[in] dev       device descriptor of the target device
+ */
+typedef void(*saul_fifo_stop_t)(const void *dev);
+
+/**
+ * @brief   Read the samples collected in the hardware FIFO of a device
+ *
+ * The samples are read in as few bus transactions as the device allows.
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[out] res      samples, oldest first
+ * @param[in] numof     maximum number of samples to read
+ * @param[out] period   time between two samples in microseconds
+ *
+ * @return  number of samples written to @p res
+ * @return  -ECANCELED on errors
+ */
+typedef int(*saul_fifo_read_t)(const void *dev, phydat_t *res, size_t numof,
+                               uint32_t *period);
+
+/**
+ * @brief   Access to the hardware FIFO of a device
+ */
+typedef struct {
+    saul_fifo_start_t start;    /**< start collecting samples */
+    saul_fifo_stop_t stop;      /**< stop collecting samples */
+    saul_fifo_read_t read;      /**< read the collected samples */
+} saul_fifo_t;
+
 /**
  * @brief   Definition of the RIOT actuator/sensor interface
  */
@@ -143,6 +201,8 @@ typedef struct {
     saul_read_t read;       /**< read function pointer */
     saul_write_t write;     /**< write function pointer */
     uint8_t type;           /**< device class the device belongs to */
+    const saul_fifo_t *fifo;    /**< hardware FIFO of the device, NULL if it
+                                 *   has none */
 } saul_driver_t;
 
 /**
@@ -150,6 +210,18 @@ typedef struct {
  */
 int saul_notsup(const void *dev, phydat_t *dat);
 
+/**
+ * @brief   Spread samples of three values out to one per phydat_t
+ *
+ * Drivers read the samples of their FIFO as packed int16_t triples into the
+ * start of @p res, this moves them into place. Unit and scale are left for
+ * the caller.
+ *
+ * @param[in,out] res       samples
+ * @param[in] numof         number of samples
+ */
+void saul_fifo_unpack(phydat_t *res, size_t numof);
+
 /**
  * @brief   Helper function converts a class ID to a string
  *
@@ -116,6 +116,7 @@ extern "C" {
 #define SX127X_IRQ_DIO3                  (1<<3)  /**< DIO3 IRQ */
 #define SX127X_IRQ_DIO4                  (1<<4)  /**< DIO4 IRQ */
 #define SX127X_IRQ_DIO5                  (1<<5)  /**< DIO5 IRQ */
+#define SX127X_IRQ_LISTEN                (1<<6)  /**< Listen mode CAD timer */
 /** @} */
 
 /**
@@ -224,6 +225,8 @@ typedef struct {
 typedef struct {
     uint32_t channel;                  /**< Radio channel */
     uint32_t window_timeout;           /**< Timeout window */
+    uint32_t listen_interval;          /**< CAD interval of the listen mode in us,
+                                        *   0 if disabled */
     uint8_t state;                     /**< Radio state */
     uint8_t modem;                     /**< Driver model (FSK or LoRa) */
     sx127x_lora_settings_t lora;       /**< LoRa settings */
@@ -236,6 +239,7 @@ typedef struct {
     /* Data that will be passed to events handler in application */
     xtimer_t tx_timeout_timer;         /**< TX operation timeout timer */
     xtimer_t rx_timeout_timer;         /**< RX operation timeout timer */
+    xtimer_t listen_timer;             /**< Listen mode CAD timer */
     uint32_t last_channel;             /**< Last channel in frequency hopping sequence */
     bool is_last_cad_success;          /**< Sign of success of last CAD operation (activity detected) */
 } sx127x_internal_t;
@@ -350,6 +354,13 @@ void sx127x_on_dio2(void *arg);
  */
 void sx127x_on_dio3(void *arg);
 
+/**
+ * @brief   sx127x listen mode CAD timer handler.
+ *
+ * @param[in] arg                      An sx127x device instance
+ */
+void sx127x_on_listen(void *arg);
+
 /**
  * @brief   Start a channel activity detection.
  *
@@ -703,6 +714,28 @@ void sx127x_set_iq_invert(sx127x_t *dev, bool iq_invert);
  */
 void sx127x_set_freq_hop(sx127x_t *dev, bool freq_hop_on);
 
+/**
+ * @brief   Gets the SX127X listen mode CAD interval
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ *
+ * @return the CAD interval in us, 0 if the listen mode is disabled
+ */
+uint32_t sx127x_get_listen_interval(const sx127x_t *dev);
+
+/**
+ * @brief   Sets the SX127X listen mode CAD interval
+ *
+ * In listen mode the device sleeps and wakes up every @p interval us for a
+ * channel activity detection. Only if it detects activity, it receives a
+ * single packet and goes back to sleep afterwards.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ * @param[in] interval                 The CAD interval in us, 0 to disable
+ *                                     the listen mode
+ */
+void sx127x_set_listen_interval(sx127x_t *dev, uint32_t interval);
+
 #ifdef __cplusplus
 }
 #endif
@@ -61,6 +61,22 @@ extern "C" {
  */
 #define XBEE_MAX_TXHDR_LENGTH       (14U)
 
+/**
+ * @brief   Number of received frames buffered until they are read
+ */
+#ifndef XBEE_RX_FRAMES
+#define XBEE_RX_FRAMES              (4U)
+#endif
+
+/**
+ * @brief   Maximum number of sent frames waiting for their TX status
+ *
+ * Sending blocks while this many frames are in flight.
+ */
+#ifndef XBEE_TX_FRAMES
+#define XBEE_TX_FRAMES              (4U)
+#endif
+
 /**
  * @brief   Default protocol for data that is coming in
  */
@@ -111,6 +127,9 @@ typedef enum {
                              *   responses */
     XBEE_INT_STATE_RX,      /**< handling incoming data when receiving radio
                              *   packets */
+    XBEE_INT_STATE_TX_STATUS,   /**< handling incoming TX status frames */
+    XBEE_INT_STATE_SKIP,    /**< skipping a frame that is not handled or does
+                             *   not fit into its buffer */
 } xbee_rx_state_t;
 
 /**
@@ -146,11 +165,22 @@ typedef struct {
     xbee_rx_state_t int_state;          /**< current state if the UART RX FSM */
     uint16_t int_size;                  /**< temporary space for parsing the
                                          *   frame size */
+    uint16_t int_count;                 /**< bytes of the current frame
+                                         *   handled so far */
+    uint8_t int_cksum;                  /**< checksum of the current frame
+                                         *   so far */
     /* values for the UART TX state machine */
     mutex_t tx_lock;                    /**< mutex to allow only one
                                          *   transmission at a time */
     uint8_t cmd_buf[XBEE_MAX_RESP_LENGTH];/**< command data buffer */
     uint8_t tx_fid;                     /**< TX frame ID */
+    /* accounting of frames in flight */
+    mutex_t tx_wait;                    /**< unlocked when a TX status
+                                         *   frame arrives */
+    uint8_t tx_inflight;                /**< frames waiting for TX status */
+    uint8_t tx_status[XBEE_TX_FRAMES];  /**< TX status values to report */
+    uint8_t tx_status_first;            /**< oldest TX status to report */
+    uint8_t tx_status_num;              /**< number of TX status to report */
     /* buffer and synchronization for command responses */
     mutex_t resp_lock;                  /**< mutex for waiting for AT command
                                          *   response frames */
@@ -158,9 +188,11 @@ typedef struct {
     uint16_t resp_count;                /**< counter for ongoing transmission */
     uint16_t resp_limit;                /**< size RESP frame in transferred */
     /* buffer and synchronization for incoming network packets */
-    uint8_t rx_buf[XBEE_MAX_PKT_LENGTH];/**< receiving data buffer */
-    uint16_t rx_count;                  /**< counter for ongoing transmission */
-    uint16_t rx_limit;                  /**< size RX frame transferred */
+    uint8_t rx_buf[XBEE_RX_FRAMES][XBEE_MAX_PKT_LENGTH];    /**< received
+                                         *   frames, without checksum */
+    uint8_t rx_len[XBEE_RX_FRAMES];     /**< length of the received frames */
+    uint8_t rx_first;                   /**< oldest received frame */
+    uint8_t rx_num;                     /**< number of received frames */
 } xbee_t;
 
 /**
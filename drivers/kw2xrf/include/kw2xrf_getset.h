@@ -196,6 +196,26 @@ void kw2xrf_set_rx_watermark(kw2xrf_t *dev, uint8_t value);
  */
 void kw2xrf_set_option(kw2xrf_t *dev, uint16_t option, bool state);
 
+/**
+ * @brief   Add or remove a source address for which ACKs to data requests
+ *          have the frame pending bit set
+ *
+ * The transceiver only compares checksums of source PAN and address, so
+ * sources with the same checksum share an entry.
+ *
+ * @param[in] dev       kw2xrf device descriptor
+ * @param[in] addr      short or long address in network byte order
+ * @param[in] len       length of @p addr
+ * @param[in] state     true to add, false to remove the address
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no address length
+ * @return  -ENOMEM if the table is full
+ * @return  -ENOENT if the address to remove is not in the table
+ */
+int kw2xrf_set_pending_src(kw2xrf_t *dev, const uint8_t *addr, size_t len,
+                           bool state);
+
 #ifdef __cplusplus
 }
 #endif
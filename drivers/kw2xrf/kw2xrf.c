@@ -101,6 +101,13 @@ void kw2xrf_reset_phy(kw2xrf_t *dev)
     dev->netdev.proto = GNRC_NETTYPE_UNDEF;
 #endif
 
+    /* no sources with pending frames */
+    for (unsigned i = 0; i < KW2XRF_SRC_ADDR_TABLE_SIZE; i++) {
+        kw2xrf_write_dreg(dev, MKW2XDM_SRC_CTRL, MKW2XDM_SRC_CTRL_INDEX_DISABLE |
+                          (i << MKW2XDM_SRC_CTRL_INDEX_SHIFT));
+    }
+    dev->src_used = 0;
+
     dev->tx_power = KW2XRF_DEFAULT_TX_POWER;
     kw2xrf_set_tx_power(dev, dev->tx_power);
 
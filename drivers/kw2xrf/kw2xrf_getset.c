@@ -19,6 +19,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "log.h"
 #include "kw2xrf.h"
 #include "kw2xrf_spi.h"
@@ -400,6 +402,14 @@ void kw2xrf_set_option(kw2xrf_t *dev, uint16_t option, bool state)
                     MKW2XDM_PHY_CTRL1_RXACKRQD);
                 break;
 
+            case KW2XRF_OPT_ACK_PENDING:
+                /* set the frame pending bit for all sources */
+                kw2xrf_clear_dreg_bit(dev, MKW2XDM_SRC_CTRL,
+                    MKW2XDM_SRC_CTRL_SRCADDR_EN);
+                kw2xrf_set_dreg_bit(dev, MKW2XDM_SRC_CTRL,
+                    MKW2XDM_SRC_CTRL_ACK_FRM_PND);
+                break;
+
             case KW2XRF_OPT_TELL_RX_START:
                 kw2xrf_clear_dreg_bit(dev, MKW2XDM_PHY_CTRL2,
                     MKW2XDM_PHY_CTRL2_RX_WMRK_MSK);
@@ -455,6 +465,16 @@ void kw2xrf_set_option(kw2xrf_t *dev, uint16_t option, bool state)
                     MKW2XDM_PHY_CTRL1_RXACKRQD);
                 break;
 
+            case KW2XRF_OPT_ACK_PENDING:
+                kw2xrf_clear_dreg_bit(dev, MKW2XDM_SRC_CTRL,
+                    MKW2XDM_SRC_CTRL_ACK_FRM_PND);
+                /* back to the sources in the table */
+                if (dev->src_used) {
+                    kw2xrf_set_dreg_bit(dev, MKW2XDM_SRC_CTRL,
+                        MKW2XDM_SRC_CTRL_SRCADDR_EN);
+                }
+                break;
+
             case KW2XRF_OPT_TELL_RX_START:
                 kw2xrf_set_dreg_bit(dev, MKW2XDM_PHY_CTRL2,
                     MKW2XDM_PHY_CTRL2_RX_WMRK_MSK);
@@ -519,3 +539,71 @@ void kw2xrf_set_rx_watermark(kw2xrf_t *dev, uint8_t value)
 {
     kw2xrf_write_iregs(dev, MKW2XDMI_RX_WTR_MARK, &value, 1);
 }
+
+static uint16_t _src_checksum(kw2xrf_t *dev, const uint8_t *addr, size_t len)
+{
+    /* sum of the source PAN and the 16-bit words of the source address as
+     * they are sent, i.e. little endian */
+    uint16_t sum = dev->netdev.pan;
+
+    for (size_t i = 0; i < len; i += 2) {
+        sum += (addr[len - 1 - i] | (addr[len - 2 - i] << 8));
+    }
+    return sum;
+}
+
+int kw2xrf_set_pending_src(kw2xrf_t *dev, const uint8_t *addr, size_t len,
+                           bool state)
+{
+    uint16_t sum;
+    int idx = -1, free_idx = -1;
+    uint8_t ctrl;
+
+    if ((len != IEEE802154_SHORT_ADDRESS_LEN) &&
+        (len != IEEE802154_LONG_ADDRESS_LEN)) {
+        return -EINVAL;
+    }
+    sum = _src_checksum(dev, addr, len);
+    for (unsigned i = 0; i < KW2XRF_SRC_ADDR_TABLE_SIZE; i++) {
+        if (!(dev->src_used & (1 << i))) {
+            if (free_idx < 0) {
+                free_idx = i;
+            }
+        }
+        else if (dev->src_sum[i] == sum) {
+            idx = i;
+        }
+    }
+    ctrl = kw2xrf_read_dreg(dev, MKW2XDM_SRC_CTRL) &
+           (MKW2XDM_SRC_CTRL_ACK_FRM_PND | MKW2XDM_SRC_CTRL_SRCADDR_EN);
+    if (state) {
+        if (idx >= 0) {
+            return 0;
+        }
+        if (free_idx < 0) {
+            return -ENOMEM;
+        }
+        kw2xrf_write_dreg(dev, MKW2XDM_SRC_ADDRS_SUM_LSB, (uint8_t)sum);
+        kw2xrf_write_dreg(dev, MKW2XDM_SRC_ADDRS_SUM_MSB, (uint8_t)(sum >> 8));
+        dev->src_sum[free_idx] = sum;
+        dev->src_used |= (1 << free_idx);
+        if (!(dev->netdev.flags & KW2XRF_OPT_ACK_PENDING)) {
+            ctrl |= MKW2XDM_SRC_CTRL_SRCADDR_EN;
+        }
+        kw2xrf_write_dreg(dev, MKW2XDM_SRC_CTRL, ctrl | MKW2XDM_SRC_CTRL_INDEX_EN |
+                          (free_idx << MKW2XDM_SRC_CTRL_INDEX_SHIFT));
+    }
+    else {
+        if (idx < 0) {
+            return -ENOENT;
+        }
+        dev->src_used &= ~(1 << idx);
+        if (!dev->src_used) {
+            ctrl &= ~MKW2XDM_SRC_CTRL_SRCADDR_EN;
+        }
+        kw2xrf_write_dreg(dev, MKW2XDM_SRC_CTRL, ctrl | MKW2XDM_SRC_CTRL_INDEX_DISABLE |
+                          (idx << MKW2XDM_SRC_CTRL_INDEX_SHIFT));
+    }
+    DEBUG("[kw2xrf] %s pending source 0x%04x\n", state ? "added" : "removed", sum);
+    return 0;
+}
@@ -373,6 +373,10 @@ static int _set(netdev_t *netdev, netopt_t opt, void *value, size_t len)
             }
             else {
                 uint8_t chan = ((uint8_t *)value)[0];
+                if (chan == dev->netdev.chan) {
+                    /* spare aborting the current sequence */
+                    break;
+                }
                 if (kw2xrf_set_channel(dev, chan)) {
                     res = -EINVAL;
                     break;
@@ -416,6 +420,21 @@ static int _set(netdev_t *netdev, netopt_t opt, void *value, size_t len)
                               ((bool *)value)[0]);
             break;
 
+        case NETOPT_ACK_PENDING:
+            kw2xrf_set_option(dev, KW2XRF_OPT_ACK_PENDING,
+                              ((bool *)value)[0]);
+            res = sizeof(netopt_enable_t);
+            break;
+
+        case NETOPT_ACK_PENDING_SRC:
+        case NETOPT_ACK_PENDING_SRC_RM:
+            res = kw2xrf_set_pending_src(dev, value, len,
+                                         (opt == NETOPT_ACK_PENDING_SRC));
+            if (res == 0) {
+                res = len;
+            }
+            break;
+
         case NETOPT_PRELOADING:
             kw2xrf_set_option(dev, KW2XRF_OPT_PRELOADING,
                               ((bool *)value)[0]);
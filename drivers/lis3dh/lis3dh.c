@@ -35,6 +35,14 @@ static int lis3dh_write_reg(const lis3dh_t *dev, const lis3dh_reg_t reg,
                             const uint8_t value);
 static int lis3dh_read_regs(const lis3dh_t *dev, const lis3dh_reg_t reg,
                             const uint8_t len, uint8_t *buf);
+static void lis3dh_scale(const lis3dh_t *dev, lis3dh_data_t *acc_data);
+
+/* sample period in us for each ODR setting, the last one differs in low
+ * power mode */
+static const uint32_t lis3dh_periods[] = {
+    0, 1000000, 100000, 40000, 20000, 10000, 5000, 2500, 625, 744
+};
+#define LIS3DH_PERIOD_LP5000HZ  (186)
 
 int lis3dh_init(lis3dh_t *dev, const lis3dh_params_t *params)
 {
@@ -43,6 +51,7 @@ int lis3dh_init(lis3dh_t *dev, const lis3dh_params_t *params)
     dev->spi   = params->spi;
     dev->clk   = params->clk;
     dev->cs    = params->cs;
+    dev->int1  = params->int1;
     dev->scale = params->scale;
 
     /* initialize the chip select line */
@@ -83,7 +92,6 @@ int lis3dh_init(lis3dh_t *dev, const lis3dh_params_t *params)
 
 int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
 {
-    uint8_t i;
     /* Set READ MULTIPLE mode */
     static const uint8_t addr = (LIS3DH_REG_OUT_X_L | LIS3DH_SPI_READ_MASK |
                                  LIS3DH_SPI_MULTI_MASK);
@@ -96,17 +104,91 @@ int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
     /* Release the bus for other threads. */
     spi_release(dev->spi);
 
-    /* Scale to milli-G */
-    for (i = 0; i < 3; ++i) {
-        int32_t tmp = (int32_t)(((int16_t *)acc_data)[i]);
-        tmp *= dev->scale;
-        tmp /= 32768;
-        (((int16_t *)acc_data)[i]) = (int16_t)tmp;
+    lis3dh_scale(dev, acc_data);
+
+    return 0;
+}
+
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *data, size_t numof)
+{
+    /* with the FIFO enabled the address rolls back from OUT_Z_H to OUT_X_L,
+     * so a longer read pops one sample after the other */
+    static const uint8_t addr = (LIS3DH_REG_OUT_X_L | LIS3DH_SPI_READ_MASK |
+                                 LIS3DH_SPI_MULTI_MASK);
+    int level = lis3dh_get_fifo_level(dev);
+
+    if (level < 0) {
+        return -1;
+    }
+    if ((size_t)level < numof) {
+        numof = level;
+    }
+    if (numof == 0) {
+        return 0;
+    }
+
+    spi_acquire(dev->spi, dev->cs, SPI_MODE, dev->clk);
+    spi_transfer_regs(dev->spi, dev->cs, addr,
+                      NULL, data, numof * sizeof(lis3dh_data_t));
+    spi_release(dev->spi);
+
+    for (size_t i = 0; i < numof; i++) {
+        lis3dh_scale(dev, &data[i]);
     }
 
+    return (int)numof;
+}
+
+int lis3dh_fifo_start(const lis3dh_t *dev, const uint8_t watermark,
+                      gpio_cb_t cb, void *arg)
+{
+    if ((dev->int1 == GPIO_UNDEF) ||
+        (watermark == 0) || (watermark > LIS3DH_FIFO_CTRL_REG_FTH_MASK)) {
+        return -1;
+    }
+
+    /* bypass mode empties the FIFO, so INT1 is low when the IRQ is set up */
+    if (lis3dh_set_fifo(dev, LIS3DH_FIFO_MODE_BYPASS, 0) < 0) {
+        return -1;
+    }
+    if (gpio_init_int(dev->int1, GPIO_IN, GPIO_RISING, cb, arg) < 0) {
+        DEBUG("[lis3dh] error while initializing INT1 pin\n");
+        return -1;
+    }
+    if ((lis3dh_set_int1(dev, LIS3DH_CTRL_REG3_I1_WTM_MASK) < 0) ||
+        (lis3dh_set_fifo(dev, LIS3DH_FIFO_MODE_STREAM, watermark) < 0)) {
+        gpio_irq_disable(dev->int1);
+        return -1;
+    }
     return 0;
 }
 
+void lis3dh_fifo_stop(const lis3dh_t *dev)
+{
+    gpio_irq_disable(dev->int1);
+    lis3dh_set_int1(dev, 0);
+    lis3dh_set_fifo(dev, LIS3DH_FIFO_MODE_BYPASS, 0);
+}
+
+uint32_t lis3dh_get_period(const lis3dh_t *dev)
+{
+    uint8_t reg;
+    unsigned odr;
+
+    if (lis3dh_read_regs(dev, LIS3DH_REG_CTRL_REG1, 1, &reg) != 0) {
+        return 0;
+    }
+    odr = (reg & LIS3DH_CTRL_REG1_ODR_MASK) >> LIS3DH_CTRL_REG1_ODR_SHIFT;
+    if (odr >= sizeof(lis3dh_periods) / sizeof(lis3dh_periods[0])) {
+        return 0;
+    }
+    if ((odr == (LIS3DH_ODR_LP5000HZ >> LIS3DH_CTRL_REG1_ODR_SHIFT)) &&
+        (reg & LIS3DH_CTRL_REG1_LPEN_MASK)) {
+        return LIS3DH_PERIOD_LP5000HZ;
+    }
+    return lis3dh_periods[odr];
+}
+
 int lis3dh_read_aux_adc1(const lis3dh_t *dev, int16_t *out)
 {
     return lis3dh_read_regs(dev, LIS3DH_REG_OUT_AUX_ADC1_L,
@@ -216,6 +298,25 @@ int lis3dh_get_fifo_level(const lis3dh_t *dev)
 }
 
 
+/**
+ * @brief Scale a raw sample to milli-G.
+ *
+ * @param[in]  dev          Device descriptor
+ * @param[in,out] acc_data  The sample to scale
+ */
+static void lis3dh_scale(const lis3dh_t *dev, lis3dh_data_t *acc_data)
+{
+    uint8_t i;
+
+    /* Sensor full range is -32768 -- +32767 (measurements are left adjusted) */
+    for (i = 0; i < 3; ++i) {
+        int32_t tmp = (int32_t)(((int16_t *)acc_data)[i]);
+        tmp *= dev->scale;
+        tmp /= 32768;
+        (((int16_t *)acc_data)[i]) = (int16_t)tmp;
+    }
+}
+
 /**
  * @brief Read sequential registers from the LIS3DH.
  *
@@ -44,8 +44,52 @@ static int read_acc(const void *dev, phydat_t *res)
     return 3;
 }
 
+static int fifo_start(const void *dev, unsigned watermark,
+                      saul_notify_t cb, void *arg)
+{
+    if (watermark > UINT8_MAX) {
+        return -ECANCELED;
+    }
+    if (lis3dh_fifo_start((const lis3dh_t *)dev, watermark, cb, arg) != 0) {
+        return -ECANCELED;
+    }
+    return 0;
+}
+
+static void fifo_stop(const void *dev)
+{
+    lis3dh_fifo_stop((const lis3dh_t *)dev);
+}
+
+static int fifo_read(const void *dev, phydat_t *res, size_t numof,
+                     uint32_t *period)
+{
+    int num = lis3dh_read_fifo((const lis3dh_t *)dev, (lis3dh_data_t *)res,
+                               numof);
+    if (num < 0) {
+        return -ECANCELED;
+    }
+
+    saul_fifo_unpack(res, num);
+    for (int i = 0; i < num; i++) {
+        /* unit: milli-G */
+        res[i].scale = -3;
+        res[i].unit = UNIT_G;
+    }
+    *period = lis3dh_get_period((const lis3dh_t *)dev);
+
+    return num;
+}
+
+static const saul_fifo_t lis3dh_saul_fifo = {
+    .start = fifo_start,
+    .stop = fifo_stop,
+    .read = fifo_read,
+};
+
 const saul_driver_t lis3dh_saul_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .fifo = &lis3dh_saul_fifo,
 };
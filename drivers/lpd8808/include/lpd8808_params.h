@@ -39,9 +39,24 @@ extern "C" {
 #define LPD8808_PARAM_PIN_DAT       (GPIO_PIN(0, 1))
 #endif
 
+#ifdef MODULE_LPD8808_SPI
+#ifndef LPD8808_PARAM_SPI
+#define LPD8808_PARAM_SPI           (SPI_DEV(0))
+#endif
+#ifndef LPD8808_PARAM_SPI_CLK
+#define LPD8808_PARAM_SPI_CLK       (SPI_CLK_5MHZ)
+#endif
+
+#define LPD8808_PARAMS_DEFAULT      {.led_cnt = LPD8808_PARAM_LED_CNT, \
+                                     .pin_clk = LPD8808_PARAM_PIN_CLK, \
+                                     .pin_dat = LPD8808_PARAM_PIN_DAT, \
+                                     .spi = LPD8808_PARAM_SPI, \
+                                     .spi_clk = LPD8808_PARAM_SPI_CLK }
+#else
 #define LPD8808_PARAMS_DEFAULT      {.led_cnt = LPD8808_PARAM_LED_CNT, \
                                      .pin_clk = LPD8808_PARAM_PIN_CLK, \
                                      .pin_dat = LPD8808_PARAM_PIN_DAT }
+#endif
 /**@}*/
 
 /**
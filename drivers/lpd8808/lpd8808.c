@@ -22,6 +22,56 @@
 
 #include "lpd8808.h"
 
+#ifdef MODULE_LPD8808_SPI
+/**
+ * @brief   The strip takes the data on the rising edge of the clock
+ */
+#define SPI_MODE            (SPI_MODE_0)
+
+/**
+ * @brief   Buffer the values are encoded into for SPI transfers
+ */
+typedef struct {
+    uint8_t buf[LPD8808_SPI_CHUNK];     /**< encoded values */
+    unsigned pos;                       /**< number of bytes in buf */
+} spi_chunk_t;
+
+static void spi_flush_chunk(const lpd8808_t *dev, spi_chunk_t *chunk)
+{
+    if (chunk->pos > 0) {
+        spi_transfer_bytes(dev->spi, SPI_CS_UNDEF, true,
+                           chunk->buf, NULL, chunk->pos);
+        chunk->pos = 0;
+    }
+}
+
+static void spi_put_byte(const lpd8808_t *dev, spi_chunk_t *chunk, uint8_t d)
+{
+    if (chunk->pos == sizeof(chunk->buf)) {
+        spi_flush_chunk(dev, chunk);
+    }
+    chunk->buf[chunk->pos++] = d;
+}
+
+/* the same bytes as with GPIO, but without toggling the pins for each bit */
+static void spi_load(const lpd8808_t *dev, color_rgb_t vals[])
+{
+    spi_chunk_t chunk = { .pos = 0 };
+
+    spi_acquire(dev->spi, SPI_CS_UNDEF, SPI_MODE, dev->spi_clk);
+    for (int i = 0; (vals != NULL) && (i < dev->led_cnt); i++) {
+        spi_put_byte(dev, &chunk, ((vals[i].g >> 1) | 0x80));
+        spi_put_byte(dev, &chunk, ((vals[i].r >> 1) | 0x80));
+        spi_put_byte(dev, &chunk, ((vals[i].b >> 1) | 0x80));
+    }
+    for (int i = 0; i < ((dev->led_cnt + 31) / 32); i++) {
+        spi_put_byte(dev, &chunk, 0);
+    }
+    spi_flush_chunk(dev, &chunk);
+    spi_release(dev->spi);
+}
+#endif
+
 /**
  * @brief   Shift a single byte to the strip
  *
@@ -58,6 +108,13 @@ int lpd8808_init(lpd8808_t *dev, const lpd8808_params_t *params)
 {
     memcpy(dev, params, sizeof(lpd8808_params_t));
 
+#ifdef MODULE_LPD8808_SPI
+    if (dev->spi != SPI_UNDEF) {
+        /* the bus was initialized on startup */
+        spi_load(dev, NULL);
+        return 0;
+    }
+#endif
     /* initialize pins */
     gpio_init(dev->pin_dat, GPIO_OUT);
     gpio_init(dev->pin_clk, GPIO_OUT);
@@ -68,6 +125,12 @@ int lpd8808_init(lpd8808_t *dev, const lpd8808_params_t *params)
 
 void lpd8808_load_rgb(const lpd8808_t *dev, color_rgb_t vals[])
 {
+#ifdef MODULE_LPD8808_SPI
+    if (dev->spi != SPI_UNDEF) {
+        spi_load(dev, vals);
+        return;
+    }
+#endif
     for (int i = 0; i < dev->led_cnt; i++) {
         put_byte(dev, ((vals[i].g >> 1) | 0x80));
         put_byte(dev, ((vals[i].r >> 1) | 0x80));
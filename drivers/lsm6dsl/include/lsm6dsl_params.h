@@ -57,6 +57,9 @@ extern "C" {
 #ifndef LSM6DSL_PARAM_GYRO_FIFO_DEC
 #define LSM6DSL_PARAM_GYRO_FIFO_DEC  (LSM6DSL_DECIMATION_NO)
 #endif
+#ifndef LSM6DSL_PARAM_INT1
+#define LSM6DSL_PARAM_INT1           (GPIO_UNDEF)
+#endif
 
 #define LSM6DSL_PARAMS_DEFAULT       { .i2c             = LSM6DSL_PARAM_I2C, \
                                        .addr            = LSM6DSL_PARAM_ADDR, \
@@ -65,7 +68,8 @@ extern "C" {
                                        .acc_fs          = LSM6DSL_PARAM_ACC_FS, \
                                        .gyro_fs         = LSM6DSL_PARAM_GYRO_FS, \
                                        .acc_decimation  = LSM6DSL_PARAM_ACC_FIFO_DEC, \
-                                       .gyro_decimation = LSM6DSL_PARAM_GYRO_FIFO_DEC }
+                                       .gyro_decimation = LSM6DSL_PARAM_GYRO_FIFO_DEC, \
+                                       .int1            = LSM6DSL_PARAM_INT1 }
 /** @} */
 
 /**
@@ -46,6 +46,49 @@ static const int16_t range_acc[] = { 2000, 16000, 4000, 8000 };
  */
 static const int16_t range_gyro[] = { 2450, 5000, 10000, 20000 };
 
+/**
+ * FIFO samples per stored sample for each decimation setting
+ */
+static const uint8_t decimation[] = { 0, 1, 2, 3, 4, 8, 16, 32 };
+
+/**
+ * sample period in us for each data rate setting, LSM6DSL_DATA_RATE_POWER_DOWN
+ * to LSM6DSL_DATA_RATE_1_6HZ
+ */
+static const uint32_t period[] = {
+    0, 80000, 38462, 19231, 9615, 4808, 2404, 1202, 601, 300, 150, 625000
+};
+
+/**
+ * number of FIFO words per sample, three for each sensor in the FIFO, 0 if
+ * the decimations give no fixed pattern
+ */
+static unsigned _fifo_words(const lsm6dsl_t *dev)
+{
+    uint8_t acc = dev->params.acc_decimation;
+    uint8_t gyro = dev->params.gyro_decimation;
+
+    if (acc && gyro && (acc != gyro)) {
+        return 0;
+    }
+    return (acc ? 3 : 0) + (gyro ? 3 : 0);
+}
+
+static void _scale(lsm6dsl_3d_data_t *data, int16_t range)
+{
+    data->x = ((int32_t)data->x * range) / INT16_MAX;
+    data->y = ((int32_t)data->y * range) / INT16_MAX;
+    data->z = ((int32_t)data->z * range) / INT16_MAX;
+}
+
+static void _decode(lsm6dsl_3d_data_t *data, const uint8_t *raw, int16_t range)
+{
+    data->x = raw[0] | (raw[1] << 8);
+    data->y = raw[2] | (raw[3] << 8);
+    data->z = raw[4] | (raw[5] << 8);
+    _scale(data, range);
+}
+
 int lsm6dsl_init(lsm6dsl_t *dev, const lsm6dsl_params_t *params)
 {
     uint8_t tmp;
@@ -100,74 +143,64 @@ int lsm6dsl_init(lsm6dsl_t *dev, const lsm6dsl_params_t *params)
     return LSM6DSL_OK;
 }
 
-int lsm6dsl_read_acc(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data)
+/**
+ * reads the status and the six output registers of the accelerometer or the
+ * gyroscope, starting at @p reg, in one list on the bus
+ */
+static int _read_raw(const lsm6dsl_t *dev, uint8_t reg,
+                     lsm6dsl_3d_data_t *data)
 {
+    uint8_t status;
+    uint8_t raw[6];
+    i2c_reg_xfer_t xfers[1 + sizeof(raw)] = {
+        { .reg = LSM6DSL_REG_STATUS_REG, .flags = I2C_FLAG_READ,
+          .data = &status, .length = 1 },
+    };
     int res;
-    uint8_t tmp;
+
+    for (unsigned i = 0; i < sizeof(raw); i++) {
+        xfers[i + 1].reg = reg + i;
+        xfers[i + 1].flags = I2C_FLAG_READ;
+        xfers[i + 1].data = &raw[i];
+        xfers[i + 1].length = 1;
+    }
 
     i2c_acquire(BUS);
-    i2c_read_reg(BUS, ADDR, LSM6DSL_REG_STATUS_REG, &tmp);
-    DEBUG("lsm6dsl status: %x\n", tmp);
-
-    res = i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTX_L_XL, &tmp);
-    data->x = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTX_H_XL, &tmp);
-    data->x |= tmp << 8;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTY_L_XL, &tmp);
-    data->y = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTY_H_XL, &tmp);
-    data->y |= tmp << 8;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTZ_L_XL, &tmp);
-    data->z = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTZ_H_XL, &tmp);
-    data->z |= tmp << 8;
+    res = i2c_transfer_reg_list(BUS, ADDR, xfers, sizeof(xfers) / sizeof(xfers[0]));
     i2c_release(BUS);
+    DEBUG("lsm6dsl status: %x\n", status);
 
-    if (res < 6) {
+    if (res < (int)(sizeof(xfers) / sizeof(xfers[0]))) {
+        return -LSM6DSL_ERROR_BUS;
+    }
+    data->x = raw[0] | (raw[1] << 8);
+    data->y = raw[2] | (raw[3] << 8);
+    data->z = raw[4] | (raw[5] << 8);
+    return LSM6DSL_OK;
+}
+
+int lsm6dsl_read_acc(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data)
+{
+    if (_read_raw(dev, LSM6DSL_REG_OUTX_L_XL, data) != LSM6DSL_OK) {
         DEBUG("[ERROR] lsm6dsl_read_acc\n");
         return -LSM6DSL_ERROR_BUS;
     }
 
     assert(dev->params.acc_fs < LSM6DSL_ACC_FS_MAX);
-    data->x = ((int32_t)data->x * range_acc[dev->params.acc_fs]) / INT16_MAX;
-    data->y = ((int32_t)data->y * range_acc[dev->params.acc_fs]) / INT16_MAX;
-    data->z = ((int32_t)data->z * range_acc[dev->params.acc_fs]) / INT16_MAX;
+    _scale(data, range_acc[dev->params.acc_fs]);
 
     return LSM6DSL_OK;
 }
 
 int lsm6dsl_read_gyro(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data)
 {
-    int res;
-    uint8_t tmp;
-
-    i2c_acquire(BUS);
-    i2c_read_reg(BUS, ADDR, LSM6DSL_REG_STATUS_REG, &tmp);
-    DEBUG("lsm6dsl status: %x\n", tmp);
-
-    res = i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTX_L_G, &tmp);
-    data->x = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTX_H_G, &tmp);
-    data->x |= tmp << 8;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTY_L_G, &tmp);
-    data->y = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTY_H_G, &tmp);
-    data->y |= tmp << 8;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTZ_L_G, &tmp);
-    data->z = tmp;
-    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_OUTZ_H_G, &tmp);
-    data->z |= tmp << 8;
-    i2c_release(BUS);
-
-    if (res < 6) {
+    if (_read_raw(dev, LSM6DSL_REG_OUTX_L_G, data) != LSM6DSL_OK) {
         DEBUG("[ERROR] lsm6dsl_read_gyro\n");
         return -LSM6DSL_ERROR_BUS;
     }
 
     assert(dev->params.gyro_fs < LSM6DSL_GYRO_FS_MAX);
-    data->x = ((int32_t)data->x * range_gyro[dev->params.gyro_fs]) / INT16_MAX;
-    data->y = ((int32_t)data->y * range_gyro[dev->params.gyro_fs]) / INT16_MAX;
-    data->z = ((int32_t)data->z * range_gyro[dev->params.gyro_fs]) / INT16_MAX;
+    _scale(data, range_gyro[dev->params.gyro_fs]);
 
     return LSM6DSL_OK;
 }
@@ -195,3 +228,132 @@ int lsm6dsl_read_temp(const lsm6dsl_t *dev, int16_t *data)
 
     return LSM6DSL_OK;
 }
+
+int lsm6dsl_read_fifo(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *acc,
+                      lsm6dsl_3d_data_t *gyro, size_t numof)
+{
+    uint8_t buf[LSM6DSL_FIFO_BURST * 12];
+    uint8_t status[4];
+    unsigned words = _fifo_words(dev);
+    unsigned unread, skip;
+    size_t num, done = 0;
+
+    if (words == 0) {
+        return -LSM6DSL_ERROR_CNF;
+    }
+    assert(dev->params.acc_fs < LSM6DSL_ACC_FS_MAX);
+    assert(dev->params.gyro_fs < LSM6DSL_GYRO_FS_MAX);
+
+    i2c_acquire(BUS);
+    if (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_STATUS1, status, 4) != 4) {
+        i2c_release(BUS);
+        return -LSM6DSL_ERROR_BUS;
+    }
+    unread = status[0] | ((status[1] & LSM6DSL_FIFO_STATUS2_DIFF_MASK) << 8);
+    /* the pattern is the word of a sample that comes next, drop what is left
+     * of a sample that was read in part */
+    skip = status[2] | ((status[3] & LSM6DSL_FIFO_STATUS4_PATTERN_MASK) << 8);
+    skip = (words - (skip % words)) % words;
+    if (skip > unread) {
+        skip = unread;
+    }
+    if (skip &&
+        (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_DATA_OUT_L, buf, skip * 2)
+         != (int)(skip * 2))) {
+        i2c_release(BUS);
+        return -LSM6DSL_ERROR_BUS;
+    }
+    num = (unread - skip) / words;
+    if (num > numof) {
+        num = numof;
+    }
+
+    while (done < num) {
+        /* the address rolls back from FIFO_DATA_OUT_H to FIFO_DATA_OUT_L, so
+         * a burst reads one word after the other */
+        size_t burst = ((num - done) > LSM6DSL_FIFO_BURST) ? LSM6DSL_FIFO_BURST
+                                                           : (num - done);
+        int len = burst * words * 2;
+
+        if (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_DATA_OUT_L,
+                          buf, len) != len) {
+            i2c_release(BUS);
+            return -LSM6DSL_ERROR_BUS;
+        }
+        /* a sample holds the gyroscope before the accelerometer */
+        for (size_t i = 0; i < burst; i++) {
+            const uint8_t *raw = &buf[i * words * 2];
+
+            if (dev->params.gyro_decimation) {
+                if (gyro) {
+                    _decode(&gyro[done + i], raw, range_gyro[dev->params.gyro_fs]);
+                }
+                raw += 6;
+            }
+            if (dev->params.acc_decimation && acc) {
+                _decode(&acc[done + i], raw, range_acc[dev->params.acc_fs]);
+            }
+        }
+        done += burst;
+    }
+    i2c_release(BUS);
+
+    return (int)num;
+}
+
+int lsm6dsl_fifo_start(const lsm6dsl_t *dev, unsigned watermark,
+                       gpio_cb_t cb, void *arg)
+{
+    unsigned words = _fifo_words(dev);
+    uint8_t fth[2];
+    int res;
+
+    /* the threshold counts words */
+    watermark *= words;
+    if ((dev->params.int1 == GPIO_UNDEF) || (watermark == 0) ||
+        (watermark > LSM6DSL_FIFO_FTH_MAX)) {
+        return -LSM6DSL_ERROR_CNF;
+    }
+    fth[0] = watermark & 0xff;
+    fth[1] = (watermark >> 8) & LSM6DSL_FIFO_CTRL2_FTH_MASK;
+
+    if (gpio_init_int(dev->params.int1, GPIO_IN, GPIO_RISING, cb, arg) < 0) {
+        DEBUG("[ERROR] lsm6dsl_fifo_start: INT1 pin\n");
+        return -LSM6DSL_ERROR_CNF;
+    }
+
+    i2c_acquire(BUS);
+    res = i2c_write_regs(BUS, ADDR, LSM6DSL_REG_FIFO_CTRL1, fth, 2);
+    res += i2c_write_reg(BUS, ADDR, LSM6DSL_REG_INT1_CTRL, LSM6DSL_INT1_CTRL_FTH);
+    i2c_release(BUS);
+
+    if (res < 3) {
+        gpio_irq_disable(dev->params.int1);
+        DEBUG("[ERROR] lsm6dsl_fifo_start: config\n");
+        return -LSM6DSL_ERROR_BUS;
+    }
+    return LSM6DSL_OK;
+}
+
+void lsm6dsl_fifo_stop(const lsm6dsl_t *dev)
+{
+    gpio_irq_disable(dev->params.int1);
+
+    i2c_acquire(BUS);
+    i2c_write_reg(BUS, ADDR, LSM6DSL_REG_INT1_CTRL, 0);
+    i2c_release(BUS);
+}
+
+uint32_t lsm6dsl_get_fifo_period(const lsm6dsl_t *dev)
+{
+    /* the FIFO runs at the rate set in lsm6dsl_init() */
+    uint8_t fifo_odr = MAX(dev->params.acc_odr, dev->params.gyro_odr);
+    uint8_t dec = MAX(dev->params.acc_decimation, dev->params.gyro_decimation);
+
+    if ((_fifo_words(dev) == 0) ||
+        (fifo_odr >= sizeof(period) / sizeof(period[0])) ||
+        (dec >= sizeof(decimation))) {
+        return 0;
+    }
+    return period[fifo_odr] * decimation[dec];
+}
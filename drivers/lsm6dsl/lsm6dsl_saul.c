@@ -60,16 +60,76 @@ static int read_temp(const void *dev, phydat_t *res)
     return 1;
 }
 
+static int fifo_start(const void *dev, unsigned watermark,
+                      saul_notify_t cb, void *arg)
+{
+    if (lsm6dsl_fifo_start((const lsm6dsl_t *)dev, watermark, cb, arg) < 0) {
+        return -ECANCELED;
+    }
+    return 0;
+}
+
+static void fifo_stop(const void *dev)
+{
+    lsm6dsl_fifo_stop((const lsm6dsl_t *)dev);
+}
+
+static int fifo_read(const lsm6dsl_t *dev, phydat_t *res, size_t numof,
+                     uint32_t *period, int acc)
+{
+    lsm6dsl_3d_data_t *data = (lsm6dsl_3d_data_t *)res;
+    int num = lsm6dsl_read_fifo(dev, acc ? data : NULL, acc ? NULL : data,
+                                numof);
+    if (num < 0) {
+        return -ECANCELED;
+    }
+
+    saul_fifo_unpack(res, num);
+    for (int i = 0; i < num; i++) {
+        res[i].scale = acc ? -3 : -1;
+        res[i].unit = acc ? UNIT_G : UNIT_DPS;
+    }
+    *period = lsm6dsl_get_fifo_period(dev);
+
+    return num;
+}
+
+static int fifo_read_acc(const void *dev, phydat_t *res, size_t numof,
+                         uint32_t *period)
+{
+    return fifo_read((const lsm6dsl_t *)dev, res, numof, period, 1);
+}
+
+static int fifo_read_gyro(const void *dev, phydat_t *res, size_t numof,
+                          uint32_t *period)
+{
+    return fifo_read((const lsm6dsl_t *)dev, res, numof, period, 0);
+}
+
+static const saul_fifo_t lsm6dsl_saul_acc_fifo = {
+    .start = fifo_start,
+    .stop = fifo_stop,
+    .read = fifo_read_acc,
+};
+
+static const saul_fifo_t lsm6dsl_saul_gyro_fifo = {
+    .start = fifo_start,
+    .stop = fifo_stop,
+    .read = fifo_read_gyro,
+};
+
 const saul_driver_t lsm6dsl_saul_acc_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .fifo = &lsm6dsl_saul_acc_fifo,
 };
 
 const saul_driver_t lsm6dsl_saul_gyro_driver = {
     .read = read_gyro,
     .write = saul_notsup,
     .type = SAUL_SENSE_GYRO,
+    .fifo = &lsm6dsl_saul_gyro_fifo,
 };
 
 const saul_driver_t lsm6dsl_saul_temp_driver = {
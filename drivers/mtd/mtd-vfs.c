@@ -36,12 +36,14 @@ static int mtd_vfs_fstat(vfs_file_t *filp, struct stat *buf);
 static off_t mtd_vfs_lseek(vfs_file_t *filp, off_t off, int whence);
 static ssize_t mtd_vfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t mtd_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
+static int mtd_vfs_mmap(vfs_file_t *filp, const void **addr, size_t *len);
 
 const vfs_file_ops_t mtd_vfs_ops = {
     .fstat = mtd_vfs_fstat,
     .lseek = mtd_vfs_lseek,
     .read  = mtd_vfs_read,
     .write = mtd_vfs_write,
+    .mmap  = mtd_vfs_mmap,
 };
 
 static int mtd_vfs_fstat(vfs_file_t *filp, struct stat *buf)
@@ -132,6 +134,27 @@ static ssize_t mtd_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes)
     return res;
 }
 
+static int mtd_vfs_mmap(vfs_file_t *filp, const void **addr, size_t *len)
+{
+    mtd_dev_t *mtd = filp->private_data.ptr;
+    if (mtd == NULL) {
+        return -EFAULT;
+    }
+    const uint8_t *base;
+    int res = mtd_mmap(mtd, (const void **)&base);
+    if (res < 0) {
+        return res;
+    }
+    uint32_t size = mtd->page_size * mtd->sector_count * mtd->pages_per_sector;
+    uint32_t src = filp->pos;
+    if (src >= size) {
+        src = size;
+    }
+    *addr = base + src;
+    *len = size - src;
+    return 0;
+}
+
 /** @} */
 
 #else
@@ -92,4 +92,18 @@ int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power)
     }
 }
 
+int mtd_mmap(mtd_dev_t *mtd, const void **addr)
+{
+    if (!mtd || !mtd->driver) {
+        return -ENODEV;
+    }
+
+    if (mtd->driver->mmap) {
+        return mtd->driver->mmap(mtd, addr);
+    }
+    else {
+        return -ENOTSUP;
+    }
+}
+
 /** @} */
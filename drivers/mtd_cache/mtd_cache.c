@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       MTD page cache implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static int mtd_cache_init(mtd_dev_t *mtd);
+static int mtd_cache_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t size);
+static int mtd_cache_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size);
+static int mtd_cache_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
+static int mtd_cache_power(mtd_dev_t *mtd, enum mtd_power_state power);
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = mtd_cache_init,
+    .read = mtd_cache_read,
+    .write = mtd_cache_write,
+    .erase = mtd_cache_erase,
+    .power = mtd_cache_power,
+};
+
+static inline uint32_t _numof_pages(const mtd_dev_t *mtd)
+{
+    return mtd->sector_count * mtd->pages_per_sector;
+}
+
+static mtd_cache_page_t *_find(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        if (cache->pages[i].page == page) {
+            return &cache->pages[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void _use(mtd_cache_t *cache, mtd_cache_page_t *p)
+{
+    p->last_used = ++cache->tick;
+}
+
+static int _flush_page(mtd_cache_t *cache, mtd_cache_page_t *p)
+{
+    if (p->dirty_end == 0) {
+        return 0;
+    }
+
+    uint32_t addr = (p->page * cache->base.page_size) + p->dirty_start;
+    int res = mtd_write(cache->parent, &p->data[p->dirty_start], addr,
+                        p->dirty_end - p->dirty_start);
+
+    DEBUG("mtd_cache: write back page %" PRIu32 " [%u, %u): %d\n", p->page,
+          p->dirty_start, p->dirty_end, res);
+    if (res < 0) {
+        return res;
+    }
+    p->dirty_start = 0;
+    p->dirty_end = 0;
+    return 0;
+}
+
+/* puts page into the least recently used entry, reading it from the parent
+ * if fill is set */
+static int _load(mtd_cache_t *cache, uint32_t page, bool fill,
+                 mtd_cache_page_t **pp)
+{
+    mtd_cache_page_t *p = &cache->pages[0];
+    int res;
+
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        mtd_cache_page_t *it = &cache->pages[i];
+
+        if (it->page == MTD_CACHE_PAGE_NONE) {
+            p = it;
+            break;
+        }
+        if ((int32_t)(it->last_used - p->last_used) < 0) {
+            p = it;
+        }
+    }
+    if ((res = _flush_page(cache, p)) < 0) {
+        return res;
+    }
+    p->page = MTD_CACHE_PAGE_NONE;
+    if (fill) {
+        uint32_t size = cache->base.page_size;
+
+        res = mtd_read(cache->parent, p->data, page * size, size);
+        if (res < 0) {
+            return res;
+        }
+    }
+    p->page = page;
+    _use(cache, p);
+    *pp = p;
+    return 0;
+}
+
+static int mtd_cache_init(mtd_dev_t *mtd)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    int res;
+
+    if (cache->parent == NULL) {
+        return -ENODEV;
+    }
+    res = mtd_init(cache->parent);
+    if ((res < 0) && (res != -ENOTSUP)) {
+        return res;
+    }
+    if (cache->parent->page_size > MTD_CACHE_PAGE_SIZE) {
+        DEBUG("mtd_cache: page size %" PRIu32 " too large\n",
+              cache->parent->page_size);
+        return -EINVAL;
+    }
+    mtd->sector_count = cache->parent->sector_count;
+    mtd->pages_per_sector = cache->parent->pages_per_sector;
+    mtd->page_size = cache->parent->page_size;
+    mutex_init(&cache->lock);
+    cache->tick = 0;
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        cache->pages[i].page = MTD_CACHE_PAGE_NONE;
+        cache->pages[i].dirty_start = 0;
+        cache->pages[i].dirty_end = 0;
+    }
+    return 0;
+}
+
+static int mtd_cache_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    uint32_t page_size = mtd->page_size;
+    uint32_t total = _numof_pages(mtd) * page_size;
+    uint8_t *dst = dest;
+    int res = 0;
+
+    if ((addr > total) || (size > (total - addr))) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    for (uint32_t done = 0; (done < size) && (res >= 0);) {
+        uint32_t page = (addr + done) / page_size;
+        uint32_t offset = (addr + done) % page_size;
+        uint32_t len = page_size - offset;
+        mtd_cache_page_t *p = _find(cache, page);
+
+        if (len > (size - done)) {
+            len = size - done;
+        }
+        if ((p == NULL) && (len == page_size)) {
+            /* whole pages are read directly, consecutive ones at once */
+            while (((size - done - len) >= page_size) &&
+                   !_find(cache, page + (len / page_size))) {
+                len += page_size;
+            }
+            res = mtd_read(cache->parent, dst + done, addr + done, len);
+        }
+        else if (p != NULL) {
+            _use(cache, p);
+            memcpy(dst + done, &p->data[offset], len);
+        }
+        else if ((res = _load(cache, page, true, &p)) == 0) {
+            memcpy(dst + done, &p->data[offset], len);
+            /* read ahead, at most so many pages that the page just read is
+             * not evicted again */
+            for (unsigned i = 1; (i <= cache->read_ahead) && (i < MTD_CACHE_PAGES); i++) {
+                uint32_t next = page + i;
+
+                if (next >= _numof_pages(mtd)) {
+                    break;
+                }
+                if (!_find(cache, next) && (_load(cache, next, true, &p) < 0)) {
+                    /* only a hint, the read itself succeeded */
+                    break;
+                }
+            }
+        }
+        done += len;
+    }
+    mutex_unlock(&cache->lock);
+    return (res < 0) ? res : (int)size;
+}
+
+static int mtd_cache_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    uint32_t page = addr / mtd->page_size;
+    uint32_t offset = addr % mtd->page_size;
+    mtd_cache_page_t *p;
+    int res = 0;
+
+    if ((page >= _numof_pages(mtd)) || (size > (mtd->page_size - offset))) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    mutex_lock(&cache->lock);
+    if ((p = _find(cache, page)) != NULL) {
+        _use(cache, p);
+    }
+    else {
+        /* the page does not need to be read if it is overwritten completely */
+        res = _load(cache, page, (size < mtd->page_size), &p);
+    }
+    if (res == 0) {
+        memcpy(&p->data[offset], src, size);
+        if (p->dirty_end == 0) {
+            p->dirty_start = offset;
+            p->dirty_end = offset + size;
+        }
+        else {
+            if (offset < p->dirty_start) {
+                p->dirty_start = offset;
+            }
+            if ((offset + size) > p->dirty_end) {
+                p->dirty_end = offset + size;
+            }
+        }
+    }
+    mutex_unlock(&cache->lock);
+    return (res < 0) ? res : (int)size;
+}
+
+static int mtd_cache_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    uint32_t first = addr / mtd->page_size;
+    uint32_t end = first + (size / mtd->page_size);
+    int res;
+
+    mutex_lock(&cache->lock);
+    /* the data of erased pages, including modifications, is gone */
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        mtd_cache_page_t *p = &cache->pages[i];
+
+        if ((p->page != MTD_CACHE_PAGE_NONE) &&
+            (p->page >= first) && (p->page < end)) {
+            p->page = MTD_CACHE_PAGE_NONE;
+            p->dirty_start = 0;
+            p->dirty_end = 0;
+        }
+    }
+    res = mtd_erase(cache->parent, addr, size);
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+static int mtd_cache_power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->parent, power);
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        int tmp = _flush_page(cache, &cache->pages[i]);
+
+        if ((tmp < 0) && (res == 0)) {
+            res = tmp;
+        }
+    }
+    mutex_unlock(&cache->lock);
+    return res;
+}
@@ -44,10 +44,16 @@
 #define TRACE(...)
 #endif
 
+/* Poll interval while erasing */
 #ifndef MTD_SPI_NOR_WRITE_WAIT_US
 #define MTD_SPI_NOR_WRITE_WAIT_US (50 * US_PER_MS)
 #endif
 
+/* Poll interval while programming a page, which takes around a millisecond */
+#ifndef MTD_SPI_NOR_PROGRAM_WAIT_US
+#define MTD_SPI_NOR_PROGRAM_WAIT_US (250U)
+#endif
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd);
 static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t size);
 static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size);
@@ -71,9 +77,10 @@ const mtd_desc_t mtd_spi_nor_driver = {
  * @param[in]  addr   address (big endian)
  * @param[out] dest   read buffer
  * @param[in]  count  number of bytes to read after the address has been sent
+ * @param[in]  dummy  number of dummy bytes between the address and the data
  */
 static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
-    be_uint32_t addr, void* dest, uint32_t count)
+    be_uint32_t addr, void* dest, uint32_t count, unsigned dummy)
 {
     TRACE("mtd_spi_cmd_addr_read: %p, %02x, (%02x %02x %02x %02x), %p, %" PRIu32 "\n",
         (void *)dev, (unsigned int)opcode, addr.u8[0], addr.u8[1], addr.u8[2],
@@ -96,6 +103,11 @@ static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
         spi_transfer_byte(dev->spi, dev->cs, true, opcode);
         spi_transfer_bytes(dev->spi, dev->cs, true, (char *)addr_buf, NULL, dev->addr_width);
 
+        /* Clock out the dummy cycles of fast read commands */
+        for (unsigned int i = 0; i < dummy; ++i) {
+            spi_transfer_byte(dev->spi, dev->cs, true, 0);
+        }
+
         /* Read data */
         spi_transfer_bytes(dev->spi, dev->cs, false, NULL, dest, count);
     } while(0);
@@ -283,22 +295,62 @@ static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
     return status;
 }
 
-static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
+static inline bool write_in_progress(const mtd_spi_nor_t *dev)
 {
-    do {
-        uint8_t status;
-        mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
+    uint8_t status;
+    mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
 
-        TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
-        if ((status & 1) == 0) { /* TODO magic number */
-            break;
-        }
+    TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
+    return (status & 1); /* TODO magic number */
+}
+
+static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us)
+{
+#if !MODULE_XTIMER
+    (void)us;
+#endif
+    while (write_in_progress(dev)) {
 #if MODULE_XTIMER
-        xtimer_usleep(MTD_SPI_NOR_WRITE_WAIT_US);
+        xtimer_usleep(us);
 #else
         thread_yield();
 #endif
-    } while (1);
+    }
+}
+
+/**
+ * @internal
+ * @brief Start erasing the next unit of an erase in progress
+ *
+ * The device must not be busy.
+ */
+static void erase_next(mtd_spi_nor_t *dev)
+{
+    be_uint32_t addr_be = byteorder_htonl(dev->erase_addr);
+
+    /* write enable, it is reset after each erase */
+    mtd_spi_cmd(dev, dev->opcode->wren);
+    mtd_spi_cmd_addr_write(dev, dev->erase_op, addr_be, NULL, 0);
+    dev->erase_addr += dev->erase_unit;
+    dev->erase_left -= dev->erase_unit;
+}
+
+/**
+ * @internal
+ * @brief Complete an erase started with mtd_spi_nor_erase_async()
+ */
+static void erase_finish(mtd_spi_nor_t *dev)
+{
+    if (dev->erase_unit == 0) {
+        /* no erase in progress */
+        return;
+    }
+    wait_for_write_complete(dev, MTD_SPI_NOR_WRITE_WAIT_US);
+    while (dev->erase_left > 0) {
+        erase_next(dev);
+        wait_for_write_complete(dev, MTD_SPI_NOR_WRITE_WAIT_US);
+    }
+    dev->erase_unit = 0;
 }
 
 static int mtd_spi_nor_init(mtd_dev_t *mtd)
@@ -319,7 +371,14 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
         mtd->pages_per_sector, mtd->page_size);
     DEBUG("mtd_spi_nor_init: Using %u byte addresses\n", dev->addr_width);
 
-    if (dev->addr_width == 0) {
+    if ((dev->addr_width == 0) || (dev->addr_width > 4)) {
+        return -EINVAL;
+    }
+    if ((dev->addr_width < 4) &&
+        (((uint64_t)mtd->pages_per_sector * mtd->sector_count * mtd->page_size) >
+         ((uint64_t)1 << (8 * dev->addr_width)))) {
+        DEBUG("mtd_spi_nor_init: ERR: chip too large for %u byte addresses\n",
+              dev->addr_width);
         return -EINVAL;
     }
 
@@ -366,6 +425,8 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
     }
     dev->sec_addr_mask = mask;
     dev->sec_addr_shift = shift;
+    dev->erase_unit = 0;
+    dev->erase_left = 0;
 
     DEBUG("mtd_spi_nor_init: sec_addr_mask = 0x%08" PRIx32 ", sec_addr_shift = %u\n",
         mask, (unsigned int)shift);
@@ -377,27 +438,27 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
 {
     DEBUG("mtd_spi_nor_read: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
         (void *)mtd, dest, addr, size);
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     size_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
     if (addr > chipsize) {
         return -EOVERFLOW;
     }
-    if (size > mtd->page_size) {
-        size = mtd->page_size;
-    }
     if ((addr + size) > chipsize) {
         size = chipsize - addr;
     }
-    uint32_t page_addr_mask = dev->page_addr_mask;
-    if ((addr & page_addr_mask) != ((addr + size - 1) & page_addr_mask)) {
-        /* Reads across page boundaries must be split */
-        size = mtd->page_size - (addr & ~(page_addr_mask));
-    }
     if (size == 0) {
         return 0;
     }
+    erase_finish(dev);
+    /* the read command continues over page boundaries, so it is done in one
+     * transfer regardless of the size */
     be_uint32_t addr_be = byteorder_htonl(addr);
-    mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size);
+    if (dev->flag & SPI_NOR_F_FAST_READ) {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read_fast, addr_be, dest, size, 1);
+    }
+    else {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size, 0);
+    }
 
     return size;
 }
@@ -410,7 +471,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (size == 0) {
         return 0;
     }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -425,6 +486,8 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    erase_finish(dev);
+
     /* write enable */
     mtd_spi_cmd(dev, dev->opcode->wren);
 
@@ -432,15 +495,15 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     mtd_spi_cmd_addr_write(dev, dev->opcode->page_program, addr_be, src, size);
 
     /* waiting for the command to complete before returning */
-    wait_for_write_complete(dev);
+    wait_for_write_complete(dev, MTD_SPI_NOR_PROGRAM_WAIT_US);
     return size;
 }
 
-static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+int mtd_spi_nor_erase_async(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
 {
-    DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
-        (void *)mtd, addr, size);
-    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    DEBUG("mtd_spi_nor_erase_async: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+        (void *)dev, addr, size);
+    mtd_dev_t *mtd = &dev->base;
     uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
     uint32_t total_size = sector_size * mtd->sector_count;
 
@@ -456,42 +519,74 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     if (addr + size > total_size) {
         return -EOVERFLOW;
     }
-    be_uint32_t addr_be = byteorder_htonl(addr);
-
-    /* write enable */
-    mtd_spi_cmd(dev, dev->opcode->wren);
+    if (size == 0) {
+        return 0;
+    }
 
+    /* finish a previous erase before starting this one */
+    erase_finish(dev);
     if (size == total_size) {
-        mtd_spi_cmd_addr_write(dev, dev->opcode->chip_erase, addr_be, NULL, 0);
+        dev->erase_op = dev->opcode->chip_erase;
+        dev->erase_unit = size;
     }
     else if ((dev->flag & SPI_NOR_F_SECT_4K) && size == 4096) {
         /* 4 KiO sectors can be erased with sector erase command */
-        mtd_spi_cmd_addr_write(dev, dev->opcode->sector_erase, addr_be, NULL, 0);
+        dev->erase_op = dev->opcode->sector_erase;
+        dev->erase_unit = size;
     }
     else if ((dev->flag & SPI_NOR_F_SECT_32K) && size == 32768) {
         /* 32 KiO sectors can be erased with sector erase command */
-        mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase_32k, addr_be, NULL, 0);
+        dev->erase_op = dev->opcode->block_erase_32k;
+        dev->erase_unit = size;
     }
     else if (size % sector_size != 0) {
         return -EOVERFLOW;
     }
     else {
-        for (size_t i = 0; i < size / sector_size; i++) {
-            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase, addr_be, NULL, 0);
-            addr += sector_size;
-            addr_be = byteorder_htonl(addr);
+        /* one block erase per sector, each one after the previous completed */
+        dev->erase_op = dev->opcode->block_erase;
+        dev->erase_unit = sector_size;
+    }
+    dev->erase_addr = addr;
+    dev->erase_left = size;
+    erase_next(dev);
+    return 0;
+}
+
+int mtd_spi_nor_erase_poll(mtd_spi_nor_t *dev)
+{
+    if (dev->erase_unit == 0) {
+        return 0;
+    }
+    while (!write_in_progress(dev)) {
+        if (dev->erase_left == 0) {
+            dev->erase_unit = 0;
+            return 0;
         }
+        erase_next(dev);
     }
+    return -EINPROGRESS;
+}
 
-    /* waiting for the command to complete before returning */
-    wait_for_write_complete(dev);
-    return 0;
+static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    int res = mtd_spi_nor_erase_async(dev, addr, size);
+
+    if (res == 0) {
+        /* waiting for the command to complete before returning */
+        erase_finish(dev);
+    }
+    return res;
 }
 
 static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
 {
     mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
 
+    if (power == MTD_POWER_DOWN) {
+        erase_finish(dev);
+    }
     switch (power) {
         case MTD_POWER_UP:
             mtd_spi_cmd(dev, dev->opcode->wake);
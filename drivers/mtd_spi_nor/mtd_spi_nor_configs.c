@@ -42,4 +42,20 @@ const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default = {
     .wake            = 0xab,
 };
 
+const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes = {
+    .rdid            = 0x9f,
+    .wren            = 0x06,
+    .rdsr            = 0x05,
+    .wrsr            = 0x01,
+    .read            = 0x13,
+    .read_fast       = 0x0c,
+    .page_program    = 0x12,
+    .sector_erase    = 0x21,
+    .block_erase_32k = 0x5c,
+    .block_erase     = 0xdc,
+    .chip_erase      = 0xc7,
+    .sleep           = 0xb9,
+    .wake            = 0xab,
+};
+
 /** @} */
@@ -88,6 +88,15 @@ int netdev_eth_get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
                 break;
             }
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+        case NETOPT_STATS_NEIGHBOR:
+            {
+                assert(max_len >= sizeof(uintptr_t));
+                *((netstats_nb_table_t **)value) = &dev->nb_stats;
+                res = sizeof(uintptr_t);
+                break;
+            }
+#endif
 #ifdef MODULE_L2FILTER
         case NETOPT_L2FILTER:
             {
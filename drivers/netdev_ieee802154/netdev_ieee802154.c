@@ -104,6 +104,18 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
             }
             res = sizeof(netopt_enable_t);
             break;
+#ifdef MODULE_IEEE802154_SECURITY
+        case NETOPT_ENCRYPTION:
+            assert(max_len == sizeof(netopt_enable_t));
+            if (dev->flags & NETDEV_IEEE802154_SECURITY_EN) {
+                *((netopt_enable_t *)value) = NETOPT_ENABLE;
+            }
+            else {
+                *((netopt_enable_t *)value) = NETOPT_DISABLE;
+            }
+            res = sizeof(netopt_enable_t);
+            break;
+#endif
 #ifdef MODULE_GNRC
         case NETOPT_PROTO:
             assert(max_len == sizeof(gnrc_nettype_t));
@@ -126,6 +138,13 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
             res = sizeof(uintptr_t);
             break;
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+        case NETOPT_STATS_NEIGHBOR:
+            assert(max_len == sizeof(uintptr_t));
+            *((netstats_nb_table_t **)value) = &dev->netdev.nb_stats;
+            res = sizeof(uintptr_t);
+            break;
+#endif
 #ifdef MODULE_L2FILTER
         case NETOPT_L2FILTER:
             assert(max_len >= sizeof(l2filter_t **));
@@ -208,6 +227,24 @@ int netdev_ieee802154_set(netdev_ieee802154_t *dev, netopt_t opt, void *value,
             }
             res = sizeof(uint16_t);
             break;
+#ifdef MODULE_IEEE802154_SECURITY
+        case NETOPT_ENCRYPTION:
+            if ((*(bool *)value)) {
+                dev->flags |= NETDEV_IEEE802154_SECURITY_EN;
+            }
+            else {
+                dev->flags &= ~NETDEV_IEEE802154_SECURITY_EN;
+            }
+            res = sizeof(netopt_enable_t);
+            break;
+        case NETOPT_ENCRYPTION_KEY:
+            res = ieee802154_sec_set_key(&dev->sec_ctx, dev->sec_ctx.key_index,
+                                         value, len);
+            if (res == 0) {
+                res = len;
+            }
+            break;
+#endif
 #ifdef MODULE_GNRC
         case NETOPT_PROTO:
             assert(len == sizeof(gnrc_nettype_t));
@@ -229,4 +266,168 @@ int netdev_ieee802154_set(netdev_ieee802154_t *dev, netopt_t opt, void *value,
     return res;
 }
 
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+static int _set_chan(netdev_ieee802154_t *dev, uint8_t chan)
+{
+    uint16_t tmp = chan;
+    int res;
+
+    if (dev->chan == chan) {
+        return 0;
+    }
+    res = dev->netdev.driver->set(&dev->netdev, NETOPT_CHANNEL, &tmp,
+                                  sizeof(tmp));
+    return (res < 0) ? res : 0;
+}
+
+static netdev_ieee802154_chan_nb_t *_nb_find(netdev_ieee802154_multichannel_t *mc,
+                                             const uint8_t *addr,
+                                             size_t addr_len)
+{
+    for (unsigned i = 0; i < NETDEV_IEEE802154_CHAN_NEIGHBORS; i++) {
+        if ((mc->nbs[i].addr_len == addr_len) &&
+            ((addr_len == 0) || (memcmp(mc->nbs[i].addr, addr, addr_len) == 0))) {
+            return &mc->nbs[i];
+        }
+    }
+    return NULL;
+}
+
+void netdev_ieee802154_chan_init(netdev_ieee802154_t *dev)
+{
+    memset(&dev->mc, 0, sizeof(dev->mc));
+    dev->mc.rx_chan = NETDEV_IEEE802154_CHAN_UNSET;
+}
+
+int netdev_ieee802154_chan_nb_set(netdev_ieee802154_t *dev,
+                                  const uint8_t *addr, size_t addr_len,
+                                  uint8_t chan)
+{
+    netdev_ieee802154_chan_nb_t *nb;
+
+    if ((addr_len != IEEE802154_SHORT_ADDRESS_LEN) &&
+        (addr_len != IEEE802154_LONG_ADDRESS_LEN)) {
+        return -EINVAL;
+    }
+    nb = _nb_find(&dev->mc, addr, addr_len);
+    if (chan == NETDEV_IEEE802154_CHAN_UNSET) {
+        if (nb != NULL) {
+            nb->addr_len = 0;
+        }
+        return 0;
+    }
+    if (nb == NULL) {
+        /* an unused entry has an address of length 0 */
+        if ((nb = _nb_find(&dev->mc, NULL, 0)) == NULL) {
+            return -ENOMEM;
+        }
+        memcpy(nb->addr, addr, addr_len);
+        nb->addr_len = addr_len;
+    }
+    DEBUG("netdev_ieee802154: neighbor listens on channel %u\n", chan);
+    nb->chan = chan;
+    return 0;
+}
+
+uint8_t netdev_ieee802154_chan_nb_get(const netdev_ieee802154_t *dev,
+                                      const uint8_t *addr, size_t addr_len)
+{
+    netdev_ieee802154_chan_nb_t *nb;
+
+    if (addr_len == 0) {
+        return NETDEV_IEEE802154_CHAN_UNSET;
+    }
+    nb = _nb_find((netdev_ieee802154_multichannel_t *)&dev->mc, addr, addr_len);
+    return (nb != NULL) ? nb->chan : NETDEV_IEEE802154_CHAN_UNSET;
+}
+
+int netdev_ieee802154_chan_tx_begin(netdev_ieee802154_t *dev,
+                                    const uint8_t *dst, size_t dst_len)
+{
+    uint8_t chan = netdev_ieee802154_chan_nb_get(dev, dst, dst_len);
+    uint8_t rx_chan = dev->chan;
+    int res;
+
+    if (dev->mc.rx_chan != NETDEV_IEEE802154_CHAN_UNSET) {
+        /* the previous transmission did not report its end */
+        rx_chan = dev->mc.rx_chan;
+    }
+    if ((chan == NETDEV_IEEE802154_CHAN_UNSET) || (chan == rx_chan)) {
+        netdev_ieee802154_chan_tx_end(dev);
+        return 0;
+    }
+    if ((res = _set_chan(dev, chan)) < 0) {
+        return res;
+    }
+    dev->mc.rx_chan = rx_chan;
+    return 1;
+}
+
+void netdev_ieee802154_chan_tx_end(netdev_ieee802154_t *dev)
+{
+    uint8_t rx_chan = dev->mc.rx_chan;
+
+    if (rx_chan == NETDEV_IEEE802154_CHAN_UNSET) {
+        return;
+    }
+    dev->mc.rx_chan = NETDEV_IEEE802154_CHAN_UNSET;
+    if (_set_chan(dev, rx_chan) < 0) {
+        DEBUG("netdev_ieee802154: unable to return to channel %u\n", rx_chan);
+    }
+}
+
+void netdev_ieee802154_chan_hop_set(netdev_ieee802154_t *dev,
+                                    const uint8_t *seq, uint8_t len)
+{
+    dev->mc.hop_seq = (len > 0) ? seq : NULL;
+    dev->mc.hop_len = len;
+}
+
+int netdev_ieee802154_chan_hop(netdev_ieee802154_t *dev, uint32_t slot)
+{
+    uint8_t chan;
+    int res;
+
+    if (dev->mc.hop_seq == NULL) {
+        return -ENOTSUP;
+    }
+    chan = dev->mc.hop_seq[slot % dev->mc.hop_len];
+    if (dev->mc.rx_chan != NETDEV_IEEE802154_CHAN_UNSET) {
+        /* switch at the end of the transmission */
+        dev->mc.rx_chan = chan;
+        return chan;
+    }
+    if ((res = _set_chan(dev, chan)) < 0) {
+        return res;
+    }
+    return chan;
+}
+
+int netdev_ieee802154_chan_select(netdev_ieee802154_t *dev,
+                                  const uint8_t *chans, unsigned numof)
+{
+    uint8_t prev = dev->chan;
+
+    for (unsigned i = 0; i < numof; i++) {
+        netopt_enable_t clear;
+        int res;
+
+        if ((res = _set_chan(dev, chans[i])) < 0) {
+            return res;
+        }
+        res = dev->netdev.driver->get(&dev->netdev, NETOPT_IS_CHANNEL_CLR,
+                                      &clear, sizeof(clear));
+        if (res < 0) {
+            return res;
+        }
+        if (clear == NETOPT_ENABLE) {
+            DEBUG("netdev_ieee802154: channel %u is clear\n", chans[i]);
+            return chans[i];
+        }
+    }
+    _set_chan(dev, prev);
+    return -EBUSY;
+}
+#endif
+
 /** @} */
@@ -16,8 +16,10 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "xtimer.h"
 #include "periph/spi.h"
@@ -199,8 +201,25 @@ static const char _riot[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#ifdef MODULE_PCD8544_FB
+/**
+ * @brief   States of the transfer of the framebuffer
+ * @{
+ */
+#define FB_IDLE             (0U)    /**< no transfer */
+#define FB_BUSY             (1U)    /**< transfer running */
+#define FB_DONE             (2U)    /**< transfer done, bus still acquired */
+/** @} */
+
+static void _flush_wait(const pcd8544_t *dev);
+#endif
+
 static inline void lock(const pcd8544_t *dev)
 {
+#ifdef MODULE_PCD8544_FB
+    /* the bus is still acquired for a transfer of the framebuffer */
+    _flush_wait(dev);
+#endif
     spi_acquire(dev->spi, dev->cs, SPI_MODE, SPI_CLK);
 }
 
@@ -217,6 +236,13 @@ static void _write(const pcd8544_t *dev, uint8_t is_data, char data)
     spi_transfer_bytes(dev->spi, dev->cs, false, (uint8_t *)&data, NULL, 1);
 }
 
+static void _write_data(const pcd8544_t *dev, const void *data, size_t len)
+{
+    gpio_write(dev->mode, MODE_DTA);
+    /* in one go, so larger transfers can be moved by DMA */
+    spi_transfer_bytes(dev->spi, dev->cs, false, data, NULL, len);
+}
+
 static inline void _set_x(const pcd8544_t *dev, uint8_t x)
 {
     _write(dev, MODE_CMD, CMD_SET_X | x);
@@ -235,6 +261,9 @@ int pcd8544_init(pcd8544_t *dev, spi_t spi, gpio_t cs, gpio_t reset, gpio_t mode
     dev->reset = reset;
     dev->mode = mode;
     dev->inverted = 0;
+#ifdef MODULE_PCD8544_FB
+    dev->fb = NULL;
+#endif
 
     DEBUG("done setting dev members\n");
 
@@ -309,14 +338,22 @@ void pcd8544_riot(const pcd8544_t *dev)
 
 void pcd8544_write_img(const pcd8544_t *dev, const char img[])
 {
+#ifdef MODULE_PCD8544_FB
+    if (dev->fb) {
+        for (unsigned page = 0; page < PCD8544_ROWS; page++) {
+            fb_page_write(&dev->fb->fb, page, 0,
+                          (const uint8_t *)&img[page * PCD8544_RES_X],
+                          PCD8544_RES_X);
+        }
+        return;
+    }
+#endif
     /* set initial position */
     lock(dev);
     _set_x(dev, 0);
     _set_y(dev, 0);
     /* write image data to display */
-    for (int i = 0; i < (PCD8544_RES_X * PCD8544_RES_Y / 8); i++) {
-        _write(dev, MODE_DTA, img[i]);
-    }
+    _write_data(dev, img, PCD8544_RES_X * PCD8544_RES_Y / 8);
     done(dev);
 }
 
@@ -326,15 +363,22 @@ void pcd8544_write_c(const pcd8544_t *dev, uint8_t x, uint8_t y, char c)
     if (x >= PCD8544_COLS || y >= PCD8544_ROWS) {
         return ;
     }
+    uint8_t cols[CHAR_WIDTH];
+
+    memcpy(cols, _ascii[c - ASCII_MIN], CHAR_WIDTH - 1);
+    cols[CHAR_WIDTH - 1] = 0x00;
+#ifdef MODULE_PCD8544_FB
+    if (dev->fb) {
+        fb_page_write(&dev->fb->fb, y, x * CHAR_WIDTH, cols, CHAR_WIDTH);
+        return;
+    }
+#endif
     /* set position */
     lock(dev);
     _set_x(dev, x * CHAR_WIDTH);
     _set_y(dev, y);
     /* write char */
-    for (int i = 0; i < CHAR_WIDTH - 1; i++) {
-        _write(dev, MODE_DTA, _ascii[c - ASCII_MIN][i]);
-    }
-    _write(dev, MODE_DTA, 0x00);
+    _write_data(dev, cols, CHAR_WIDTH);
     done(dev);
 }
 
@@ -347,11 +391,19 @@ void pcd8544_write_s(const pcd8544_t *dev, uint8_t x, uint8_t y, const char *s)
 
 void pcd8544_clear(const pcd8544_t *dev)
 {
+    static const uint8_t empty[PCD8544_RES_X] = { 0 };
+
+#ifdef MODULE_PCD8544_FB
+    if (dev->fb) {
+        fb_page_fill(&dev->fb->fb, 0x00);
+        return;
+    }
+#endif
     lock(dev);
     _set_x(dev, 0);
     _set_y(dev, 0);
-    for (int i = 0; i < PCD8544_RES_X * PCD8544_ROWS; i++) {
-        _write(dev, MODE_DTA, 0x00);
+    for (unsigned page = 0; page < PCD8544_ROWS; page++) {
+        _write_data(dev, empty, sizeof(empty));
     }
     done(dev);
 }
@@ -387,3 +439,74 @@ void pcd8544_poweroff(const pcd8544_t *dev)
     _write(dev, MODE_CMD, CMD_DISABLE);
     done(dev);
 }
+
+#ifdef MODULE_PCD8544_FB
+static void _flush_done(void *arg)
+{
+    pcd8544_fb_t *fb = arg;
+
+    fb->state = FB_DONE;
+}
+
+/* ends the transfer of the framebuffer and releases the bus */
+static void _flush_wait(const pcd8544_t *dev)
+{
+    pcd8544_fb_t *fb = dev->fb;
+
+    if ((fb == NULL) || (fb->state == FB_IDLE)) {
+        return;
+    }
+    while (fb->state == FB_BUSY) {}
+    fb->state = FB_IDLE;
+    done(dev);
+}
+
+void pcd8544_fb_attach(pcd8544_t *dev, pcd8544_fb_t *fb)
+{
+    _flush_wait(dev);
+    if (fb) {
+        fb_page_init(&fb->fb, fb->buf, fb->dirty, PCD8544_RES_X, PCD8544_ROWS);
+        fb->state = FB_IDLE;
+    }
+    dev->fb = fb;
+}
+
+void pcd8544_set_pixel(const pcd8544_t *dev, uint8_t x, uint8_t y, bool on)
+{
+    assert(dev->fb);
+    fb_page_set_pixel(&dev->fb->fb, x, y, on);
+}
+
+int pcd8544_flush(const pcd8544_t *dev)
+{
+    pcd8544_fb_t *fb = dev->fb;
+    uint8_t page;
+    uint16_t x;
+    size_t len;
+
+    if (fb == NULL) {
+        return 0;
+    }
+    if (fb->state == FB_BUSY) {
+        return 1;
+    }
+    _flush_wait(dev);
+    if ((len = fb_page_take(&fb->fb, &page, &x)) == 0) {
+        return 0;
+    }
+    lock(dev);
+    _set_x(dev, x);
+    _set_y(dev, page);
+    gpio_write(dev->mode, MODE_DTA);
+    fb->state = FB_BUSY;
+    spi_transfer_bytes_async(dev->spi, dev->cs, false,
+                             &fb->buf[page * PCD8544_RES_X + x], NULL, len,
+                             _flush_done, fb);
+    if (fb->state == FB_DONE) {
+        /* there was no DMA for the transfer, don't keep the bus */
+        _flush_wait(dev);
+        return fb_page_is_dirty(&fb->fb);
+    }
+    return 1;
+}
+#endif
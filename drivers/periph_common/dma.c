@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers
+ * @{
+ *
+ * @file
+ * @brief       Common DMA functions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "cpu.h"
+#include "assert.h"
+#include "mutex.h"
+
+/* guard this file, must be done before including periph/dma.h
+ * TODO: remove as soon as periph drivers can be build selectively */
+#ifdef DMA_NUMOF
+
+#include "periph/dma.h"
+
+typedef struct {
+    mutex_t done;
+    int res;
+} _wait_t;
+
+static void _done(void *arg, int res)
+{
+    _wait_t *wait = arg;
+
+    if (res == DMA_HALF) {
+        return;
+    }
+    wait->res = res;
+    mutex_unlock(&wait->done);
+}
+
+int dma_transfer(dma_t dma, const dma_xfer_t *xfer)
+{
+    _wait_t wait = { .done = MUTEX_INIT_LOCKED };
+    int res;
+
+    assert(!(xfer->flags & DMA_CIRCULAR));
+
+    res = dma_start(dma, xfer, _done, &wait);
+    if (res != DMA_OK) {
+        return res;
+    }
+    mutex_lock(&wait.done);
+    return wait.res;
+}
+
+#endif /* DMA_NUMOF */
@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include "cpu.h"
 #include "assert.h"
@@ -53,4 +54,104 @@ int flashpage_write_and_verify(int page, void *data)
     return flashpage_verify(page, data);
 }
 
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+static bool _erased(const uint8_t *mem, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (mem[i] != 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void flashpage_writer_init(flashpage_writer_t *writer)
+{
+    writer->page = -1;
+    writer->start = 0;
+    writer->end = 0;
+}
+
+void flashpage_writer_write(flashpage_writer_t *writer, void *addr,
+                            const void *data, size_t len)
+{
+    uintptr_t pos = (uintptr_t)addr;
+    const uint8_t *src = data;
+
+    while (len > 0) {
+        int page = flashpage_page((void *)pos);
+        unsigned offset = (pos - CPU_FLASH_BASE) % FLASHPAGE_SIZE;
+        size_t chunk = FLASHPAGE_SIZE - offset;
+
+        assert(page < FLASHPAGE_NUMOF);
+
+        if (chunk > len) {
+            chunk = len;
+        }
+        if (page != writer->page) {
+            flashpage_writer_flush(writer);
+            flashpage_read(page, writer->buf);
+            writer->page = page;
+        }
+        memcpy((uint8_t *)writer->buf + offset, src, chunk);
+        if (writer->end == 0) {
+            writer->start = offset;
+            writer->end = offset + chunk;
+        }
+        else {
+            if (offset < writer->start) {
+                writer->start = offset;
+            }
+            if ((offset + chunk) > writer->end) {
+                writer->end = offset + chunk;
+            }
+        }
+        pos += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+}
+
+void flashpage_writer_flush(flashpage_writer_t *writer)
+{
+    const uint8_t *buf = (const uint8_t *)writer->buf;
+    uint8_t *flash;
+    unsigned start, end, pos;
+
+    if (writer->end == 0) {
+        return;
+    }
+    flash = flashpage_addr(writer->page);
+    start = writer->start - (writer->start % FLASHPAGE_RAW_BLOCKSIZE);
+    end = writer->end + FLASHPAGE_RAW_BLOCKSIZE - 1;
+    end -= end % FLASHPAGE_RAW_BLOCKSIZE;
+    writer->start = 0;
+    writer->end = 0;
+
+    /* blocks that changed can only be programmed if they are erased */
+    for (pos = start; pos < end; pos += FLASHPAGE_RAW_BLOCKSIZE) {
+        if ((memcmp(&flash[pos], &buf[pos], FLASHPAGE_RAW_BLOCKSIZE) != 0) &&
+            !_erased(&flash[pos], FLASHPAGE_RAW_BLOCKSIZE)) {
+            flashpage_write(writer->page, writer->buf);
+            return;
+        }
+    }
+    /* program each run of changed blocks at once */
+    for (pos = start; pos < end;) {
+        unsigned run = pos;
+
+        while ((pos < end) &&
+               (memcmp(&flash[pos], &buf[pos], FLASHPAGE_RAW_BLOCKSIZE) != 0)) {
+            pos += FLASHPAGE_RAW_BLOCKSIZE;
+        }
+        if (pos > run) {
+            flashpage_write_raw(&flash[run], &buf[run], pos - run);
+        }
+        else {
+            pos += FLASHPAGE_RAW_BLOCKSIZE;
+        }
+    }
+}
+#endif /* FLASHPAGE_RAW_BLOCKSIZE */
+
 #endif
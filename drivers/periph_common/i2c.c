@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers
+ * @{
+ *
+ * @file
+ * @brief       Common I2C driver functions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "board.h"
+#include "cpu.h"
+#include "periph_conf.h"
+#include "periph/i2c.h"
+
+#ifdef I2C_NUMOF
+
+int i2c_transfer_reg_list(i2c_t dev, uint8_t address,
+                          const i2c_reg_xfer_t *xfers, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        int res;
+
+        if (xfers[i].flags & I2C_FLAG_READ) {
+            res = i2c_read_regs(dev, address, xfers[i].reg,
+                                xfers[i].data, xfers[i].length);
+        }
+        else {
+            res = i2c_write_regs(dev, address, xfers[i].reg,
+                                 xfers[i].data, xfers[i].length);
+        }
+        if (res != xfers[i].length) {
+            return i;
+        }
+    }
+    return numof;
+}
+
+#endif /* I2C_NUMOF */
@@ -23,6 +23,8 @@
 
 #include "board.h"
 #include "cpu.h"
+#include "irq.h"
+#include "mutex.h"
 #include "periph/spi.h"
 
 #ifdef SPI_NUMOF
@@ -53,6 +55,16 @@ uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out)
 }
 #endif
 
+#ifndef PERIPH_SPI_HAS_TRANSFER_BYTES_ASYNC
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg)
+{
+    spi_transfer_bytes(bus, cs, cont, out, in, len);
+    cb(arg);
+}
+#endif
+
 #ifdef PERIPH_SPI_NEEDS_TRANSFER_REG
 uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out)
 {
@@ -70,4 +82,73 @@ void spi_transfer_regs(spi_t bus, spi_cs_t cs,
 }
 #endif
 
+typedef struct {
+    spi_t bus;
+    spi_cs_t cs;
+    const spi_reg_xfer_t *xfers;
+    unsigned numof;
+    volatile unsigned pos;
+    volatile bool starting;
+    volatile bool done_early;
+    mutex_t done;
+} reg_list_t;
+
+static void _reg_list_next(void *arg);
+
+/* starts the remaining steps, from the thread or from the completion of the
+ * previous step, until one of them runs asynchronously */
+static void _reg_list_run(reg_list_t *list)
+{
+    while (list->pos < list->numof) {
+        const spi_reg_xfer_t *xfer = &list->xfers[list->pos++];
+        unsigned state;
+        bool done_early;
+
+        list->starting = true;
+        list->done_early = false;
+        spi_transfer_bytes(list->bus, list->cs, true, &xfer->reg, NULL, 1);
+        spi_transfer_bytes_async(list->bus, list->cs, false,
+                                 xfer->out, xfer->in, xfer->len,
+                                 _reg_list_next, list);
+        state = irq_disable();
+        list->starting = false;
+        done_early = list->done_early;
+        irq_restore(state);
+        if (!done_early) {
+            /* the completion continues the list */
+            return;
+        }
+    }
+    mutex_unlock(&list->done);
+}
+
+static void _reg_list_next(void *arg)
+{
+    reg_list_t *list = arg;
+
+    if (list->starting) {
+        /* done before spi_transfer_bytes_async() returned, the loop in
+         * _reg_list_run() goes on */
+        list->done_early = true;
+        return;
+    }
+    _reg_list_run(list);
+}
+
+void spi_transfer_reg_list(spi_t bus, spi_cs_t cs,
+                           const spi_reg_xfer_t *xfers, unsigned numof)
+{
+    reg_list_t list = {
+        .bus = bus,
+        .cs = cs,
+        .xfers = xfers,
+        .numof = numof,
+        .pos = 0,
+        .done = MUTEX_INIT_LOCKED,
+    };
+
+    _reg_list_run(&list);
+    mutex_lock(&list.done);
+}
+
 #endif /* SPI_NUMOF */
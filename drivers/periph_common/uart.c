@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup drivers
+ * @{
+ *
+ * @file
+ * @brief       common UART function fallback implementations
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "board.h"
+#include "cpu.h"
+#include "periph_conf.h"
+#include "periph/uart.h"
+
+#if defined(UART_NUMOF) && !defined(PERIPH_UART_HAS_INIT_RX_DMA)
+
+static struct {
+    uart_rx_span_cb_t cb;
+    void *arg;
+} _span[UART_NUMOF];
+
+static void _rx_one(void *arg, uint8_t data)
+{
+    uart_t uart = (uart_t)(uintptr_t)arg;
+
+    _span[uart].cb(_span[uart].arg, &data, 1);
+}
+
+int uart_init_rx_dma(uart_t uart, uint32_t baudrate, uint8_t *buf,
+                     size_t size, uart_rx_span_cb_t rx_cb, void *arg)
+{
+    (void)buf;
+    (void)size;
+
+    if (uart >= UART_NUMOF) {
+        return UART_NODEV;
+    }
+    if (rx_cb == NULL) {
+        return uart_init(uart, baudrate, NULL, NULL);
+    }
+    _span[uart].cb = rx_cb;
+    _span[uart].arg = arg;
+    return uart_init(uart, baudrate, _rx_one, (void *)(uintptr_t)uart);
+}
+
+#endif /* UART_NUMOF && !PERIPH_UART_HAS_INIT_RX_DMA */
+
+#if defined(UART_NUMOF) && !defined(PERIPH_UART_HAS_WRITE_ASYNC)
+
+void uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                      uart_tx_cb_t cb, void *arg)
+{
+    uart_write(uart, data, len);
+    if (cb) {
+        cb(arg);
+    }
+}
+
+#endif /* UART_NUMOF && !PERIPH_UART_HAS_WRITE_ASYNC */
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "saul.h"
 
@@ -28,3 +29,15 @@ int saul_notsup(const void *dev, phydat_t *dat)
     (void)dat;
     return -ENOTSUP;
 }
+
+void saul_fifo_unpack(phydat_t *res, size_t numof)
+{
+    int16_t *packed = (int16_t *)res;
+
+    /* from the back, as sample i moves from 3 * i to the larger offset of
+     * res[i] */
+    while (numof--) {
+        memmove(res[numof].val, &packed[numof * PHYDAT_DIM],
+                sizeof(res[numof].val));
+    }
+}
@@ -24,6 +24,7 @@
 #include "sdcard_spi_params.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "checksum/crc16_ccitt.h"
 #include "xtimer.h"
 
 #include <stdio.h>
@@ -45,9 +46,6 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, char token, char
 /* CRC-7 (polynomial: x^7 + x^3 + 1) LSB of CRC-7 in a 8-bit variable is always 1*/
 static char _crc_7(const char *data, int n);
 
-/* CRC-16 (CRC-CCITT) (polynomial: x^16 + x^12 + x^5 + x^1) */
-static uint16_t _crc_16(const char *data, size_t n);
-
 /* use this transfer method instead of _transfer_bytes to force the use of 0xFF as dummy bytes */
 static inline int _transfer_bytes(sdcard_spi_t *card, char *out, char *in, unsigned int length);
 
@@ -410,20 +408,6 @@ static char _crc_7(const char *data, int n)
     return (crc << 1) | 1;
 }
 
-static uint16_t _crc_16(const char *data, size_t n)
-{
-    uint16_t crc = 0;
-
-    for (size_t i = 0; i < n; i++) {
-        crc = (uint8_t)(crc >> 8) | (crc << 8);
-        crc ^= data[i];
-        crc ^= (uint8_t)(crc & 0xFF) >> 4;
-        crc ^= crc << 12;
-        crc ^= (crc & 0xFF) << 5;
-    }
-    return crc;
-}
-
 char sdcard_spi_send_cmd(sdcard_spi_t *card, char sd_cmd_idx, uint32_t argument, int32_t max_retry)
 {
     int try_cnt = 0;
@@ -581,6 +565,18 @@ static inline int _transfer_bytes(sdcard_spi_t *card, char *out, char *in, unsig
     unsigned trans_bytes = 0;
     char in_temp;
 
+    if (_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) {
+        /* transfer the whole buffer at once with the hardware SPI */
+        if (out == NULL) {
+            /* the card expects MOSI to stay high while sending data, so dummy
+             * bytes are sent from the receive buffer */
+            memset(in, SD_CARD_DUMMY_BYTE, length);
+            out = in;
+        }
+        spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, out, in, length);
+        return length;
+    }
+
     for (trans_bytes = 0; trans_bytes < length; trans_bytes++) {
         if (out != NULL) {
             trans_ret = _dyn_spi_rxtx_byte(card, out[trans_bytes], &in_temp);
@@ -622,7 +618,8 @@ static sd_rw_response_t _read_data_packet(sdcard_spi_t *card, char token, char *
         if (_transfer_bytes(card, 0, crc_bytes, sizeof(crc_bytes)) == sizeof(crc_bytes)) {
             uint16_t data__crc_16 = (crc_bytes[0] << 8) | crc_bytes[1];
 
-            if (_crc_16(data, size) == data__crc_16) {
+            /* CRC-16 (CRC-CCITT) with start value 0 */
+            if (crc16_ccitt_update(0, (uint8_t *)data, size) == data__crc_16) {
                 DEBUG("_read_data_packet: [OK]\n");
                 return SD_RW_OK;
             }
@@ -669,7 +666,9 @@ static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, char
         if (cmd_idx == SD_CMD_18) {
             cmd_r1_resu = sdcard_spi_send_cmd(card, SD_CMD_12, 0, 1);
 
-            if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
+            /* the card may signal busy after the response to CMD12 */
+            if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu) &&
+                _wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
                 DEBUG("_read_blocks: read multi (%d) blocks [OK]\n", nbl);
                 *state = SD_RW_OK;
             }
@@ -710,7 +709,7 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, char token, char
 
     if (_transfer_bytes(card, data, 0, size) == size) {
 
-        uint16_t data__crc_16 = _crc_16(data, size);
+        uint16_t data__crc_16 = crc16_ccitt_update(0, (uint8_t *)data, size);
         char crc[sizeof(uint16_t)] = { data__crc_16 >> 8, data__crc_16 & 0xFF };
 
         if (_transfer_bytes(card, crc, 0, sizeof(crc)) == sizeof(crc)) {
@@ -764,6 +763,13 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, ch
     _select_card_spi(card);
     int written = 0;
 
+    /* letting the card pre-erase the blocks speeds up the multiple block
+     * write, but is only a hint, so failing is fine */
+    if ((cmd_idx == SD_CMD_25) &&
+        (sdcard_spi_send_acmd(card, SD_CMD_23, nbl, 0) == SD_INVALID_R1_RESPONSE)) {
+        DEBUG("_write_blocks: send ACMD23: [FAILED]\n");
+    }
+
     uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
     char cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRIES);
 
@@ -805,7 +811,9 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, ch
             if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
                 _unselect_card_spi(card);
                 *state = SD_RW_TIMEOUT;
+                return written;
             }
+            *state = SD_RW_OK;
         }
         else {
             DEBUG("_write_blocks: write single block: [OK]\n");
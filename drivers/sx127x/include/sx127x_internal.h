@@ -127,6 +127,15 @@ void sx127x_rx_chain_calibration(sx127x_t *dev);
  */
 int16_t sx127x_read_rssi(const sx127x_t *dev);
 
+/**
+ * @brief   Puts the device to sleep until the next CAD of the listen mode
+ *
+ * Does nothing if the listen mode is disabled.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ */
+void sx127x_listen_next(sx127x_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,7 @@ static void _init_timers(sx127x_t *dev);
 static int _init_peripherals(sx127x_t *dev);
 static void _on_tx_timeout(void *arg);
 static void _on_rx_timeout(void *arg);
+static void _on_listen_timer(void *arg);
 
 /* SX127X DIO interrupt handlers initialization */
 static void sx127x_on_dio0_isr(void *arg);
@@ -209,6 +210,7 @@ void sx127x_on_dio0(void *arg)
     switch (dev->settings.state) {
         case SX127X_RF_RX_RUNNING:
             netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+            sx127x_listen_next(dev);
             break;
         case SX127X_RF_TX_RUNNING:
             xtimer_remove(&dev->_internal.tx_timeout_timer);
@@ -222,6 +224,7 @@ void sx127x_on_dio0(void *arg)
                 default:
                     sx127x_set_state(dev, SX127X_RF_IDLE);
                     netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+                    sx127x_listen_next(dev);
                     break;
             }
             break;
@@ -252,6 +255,7 @@ void sx127x_on_dio1(void *arg)
                     sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS, SX127X_RF_LORA_IRQFLAGS_RXTIMEOUT);
                     sx127x_set_state(dev, SX127X_RF_IDLE);
                     netdev->event_callback(netdev, NETDEV_EVENT_RX_TIMEOUT);
+                    sx127x_listen_next(dev);
                     break;
                 default:
                     break;
@@ -345,7 +349,16 @@ void sx127x_on_dio3(void *arg)
             /* Send event message */
             dev->_internal.is_last_cad_success = (sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS) &
                                                   SX127X_RF_LORA_IRQFLAGS_CADDETECTED) == SX127X_RF_LORA_IRQFLAGS_CADDETECTED;
-            netdev->event_callback(netdev, NETDEV_EVENT_CAD_DONE);
+            if (dev->settings.listen_interval == 0) {
+                netdev->event_callback(netdev, NETDEV_EVENT_CAD_DONE);
+            }
+            else if (dev->_internal.is_last_cad_success) {
+                /* someone is sending, receive the packet */
+                sx127x_set_rx(dev);
+            }
+            else {
+                sx127x_listen_next(dev);
+            }
             break;
         default:
             puts("sx127x_on_dio3: Unknown modem");
@@ -353,6 +366,17 @@ void sx127x_on_dio3(void *arg)
     }
 }
 
+void sx127x_on_listen(void *arg)
+{
+    sx127x_t *dev = (sx127x_t *) arg;
+
+    /* an ongoing operation restarts the listen mode when it is done */
+    if ((dev->settings.listen_interval != 0) &&
+        (dev->settings.state == SX127X_RF_IDLE)) {
+        sx127x_start_cad(dev);
+    }
+}
+
 static void _init_isrs(sx127x_t *dev)
 {
     if (gpio_init_int(dev->params.dio0_pin, GPIO_IN, GPIO_RISING, sx127x_on_dio0_isr, dev) < 0) {
@@ -386,6 +410,11 @@ static void _on_rx_timeout(void *arg)
     dev->event_callback(dev, NETDEV_EVENT_RX_TIMEOUT);
 }
 
+static void _on_listen_timer(void *arg)
+{
+    sx127x_on_dio_isr((sx127x_t*) arg, SX127X_IRQ_LISTEN);
+}
+
 static void _init_timers(sx127x_t *dev)
 {
     dev->_internal.tx_timeout_timer.arg = dev;
@@ -393,6 +422,9 @@ static void _init_timers(sx127x_t *dev)
 
     dev->_internal.rx_timeout_timer.arg = dev;
     dev->_internal.rx_timeout_timer.callback = _on_rx_timeout;
+
+    dev->_internal.listen_timer.arg = dev;
+    dev->_internal.listen_timer.callback = _on_listen_timer;
 }
 
 static int _init_peripherals(sx127x_t *dev)
@@ -187,6 +187,7 @@ void sx127x_set_sleep(sx127x_t *dev)
     /* Disable running timers */
     xtimer_remove(&dev->_internal.tx_timeout_timer);
     xtimer_remove(&dev->_internal.rx_timeout_timer);
+    xtimer_remove(&dev->_internal.listen_timer);
 
     /* Put chip into sleep */
     sx127x_set_op_mode(dev, SX127X_RF_OPMODE_SLEEP);
@@ -200,6 +201,7 @@ void sx127x_set_standby(sx127x_t *dev)
     /* Disable running timers */
     xtimer_remove(&dev->_internal.tx_timeout_timer);
     xtimer_remove(&dev->_internal.rx_timeout_timer);
+    xtimer_remove(&dev->_internal.listen_timer);
 
     sx127x_set_op_mode(dev, SX127X_RF_OPMODE_STANDBY);
     sx127x_set_state(dev,  SX127X_RF_IDLE);
@@ -292,7 +294,9 @@ void sx127x_set_rx(sx127x_t *dev)
                    dev->settings.window_timeout);
     }
 
-    if (dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG) {
+    /* the listen mode only receives the packet it detected */
+    if ((dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG) &&
+        (dev->settings.listen_interval == 0)) {
         sx127x_set_op_mode(dev, SX127X_RF_LORA_OPMODE_RECEIVER);
     }
     else {
@@ -602,6 +606,24 @@ void sx127x_set_rx_single(sx127x_t *dev, bool single)
     _set_flag(dev, SX127X_RX_CONTINUOUS_FLAG, !single);
 }
 
+uint32_t sx127x_get_listen_interval(const sx127x_t *dev)
+{
+    return dev->settings.listen_interval;
+}
+
+void sx127x_set_listen_interval(sx127x_t *dev, uint32_t interval)
+{
+    DEBUG("[DEBUG] Set listen interval: %" PRIu32 "\n", interval);
+
+    dev->settings.listen_interval = interval;
+    if (interval == 0) {
+        xtimer_remove(&dev->_internal.listen_timer);
+    }
+    else {
+        sx127x_listen_next(dev);
+    }
+}
+
 bool sx127x_get_crc(const sx127x_t *dev)
 {
 #if defined(MODULE_SX1272)
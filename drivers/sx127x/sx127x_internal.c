@@ -218,3 +218,13 @@ void sx127x_start_cad(sx127x_t *dev)
             break;
     }
 }
+
+void sx127x_listen_next(sx127x_t *dev)
+{
+    if (dev->settings.listen_interval == 0) {
+        return;
+    }
+
+    sx127x_set_sleep(dev);
+    xtimer_set(&dev->_internal.listen_timer, dev->settings.listen_interval);
+}
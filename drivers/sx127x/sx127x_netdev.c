@@ -121,96 +121,113 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
     return 0;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+static void _rx_done(sx127x_t *dev)
 {
-    sx127x_t *dev = (sx127x_t*) netdev;
-    volatile uint8_t irq_flags = 0;
-    uint8_t size = 0;
-    switch (dev->settings.modem) {
-        case SX127X_MODEM_FSK:
-            /* todo */
-            break;
-        case SX127X_MODEM_LORA:
-            /* Clear IRQ */
-            sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS, SX127X_RF_LORA_IRQFLAGS_RXDONE);
+    if (!(dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG)) {
+        sx127x_set_state(dev, SX127X_RF_IDLE);
+    }
 
-            irq_flags = sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS);
-            if ( (irq_flags & SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR_MASK) ==
-                 SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR) {
-                /* Clear IRQ */
-                sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
-                                 SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR);
+    xtimer_remove(&dev->_internal.rx_timeout_timer);
+}
 
-                if (!(dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG)) {
-                    sx127x_set_state(dev, SX127X_RF_IDLE);
-                }
+static void _packet_info(const sx127x_t *dev, netdev_sx127x_lora_packet_info_t *packet_info,
+                         uint8_t size)
+{
+    uint8_t pkt[2];
 
-                xtimer_remove(&dev->_internal.rx_timeout_timer);
-                netdev->event_callback(netdev, NETDEV_EVENT_CRC_ERROR);
-                return -EBADMSG;
-            }
+    /* SNR and RSSI of the packet are read in one burst */
+    sx127x_reg_read_burst(dev, SX127X_REG_LR_PKTSNRVALUE, pkt, sizeof(pkt));
 
-            netdev_sx127x_lora_packet_info_t *packet_info = info;
-            if (packet_info) {
-                /* there is no LQI for LoRa */
-                packet_info->lqi = 0;
-                uint8_t snr_value = sx127x_reg_read(dev, SX127X_REG_LR_PKTSNRVALUE);
-                if (snr_value & 0x80) { /* The SNR is negative */
-                    /* Invert and divide by 4 */
-                    packet_info->snr = -1 * ((~snr_value + 1) & 0xFF) >> 2;
-                }
-                else {
-                    /* Divide by 4 */
-                    packet_info->snr = (snr_value & 0xFF) >> 2;
-                }
+    uint8_t snr_value = pkt[0];
+    int16_t rssi = pkt[1];
 
-                int16_t rssi = sx127x_reg_read(dev, SX127X_REG_LR_PKTRSSIVALUE);
+    /* there is no LQI for LoRa */
+    packet_info->lqi = 0;
+    if (snr_value & 0x80) { /* The SNR is negative */
+        /* Invert and divide by 4 */
+        packet_info->snr = -1 * ((~snr_value + 1) & 0xFF) >> 2;
+    }
+    else {
+        /* Divide by 4 */
+        packet_info->snr = (snr_value & 0xFF) >> 2;
+    }
 
-                if (packet_info->snr < 0) {
+    if (packet_info->snr < 0) {
 #if defined(MODULE_SX1272)
-                    packet_info->rssi = SX127X_RSSI_OFFSET + rssi + (rssi >> 4) + packet_info->snr;
+        packet_info->rssi = SX127X_RSSI_OFFSET + rssi + (rssi >> 4) + packet_info->snr;
 #else /* MODULE_SX1276 */
-                    if (dev->settings.channel > SX127X_RF_MID_BAND_THRESH) {
-                        packet_info->rssi = SX127X_RSSI_OFFSET_HF + rssi + (rssi >> 4) + packet_info->snr;
-                    }
-                    else {
-                        packet_info->rssi = SX127X_RSSI_OFFSET_LF + rssi + (rssi >> 4) + packet_info->snr;
-                    }
+        if (dev->settings.channel > SX127X_RF_MID_BAND_THRESH) {
+            packet_info->rssi = SX127X_RSSI_OFFSET_HF + rssi + (rssi >> 4) + packet_info->snr;
+        }
+        else {
+            packet_info->rssi = SX127X_RSSI_OFFSET_LF + rssi + (rssi >> 4) + packet_info->snr;
+        }
 #endif
-                }
-                else {
+    }
+    else {
 #if defined(MODULE_SX1272)
-                    packet_info->rssi = SX127X_RSSI_OFFSET + rssi + (rssi >> 4);
+        packet_info->rssi = SX127X_RSSI_OFFSET + rssi + (rssi >> 4);
 #else /* MODULE_SX1276 */
-                    if (dev->settings.channel > SX127X_RF_MID_BAND_THRESH) {
-                        packet_info->rssi = SX127X_RSSI_OFFSET_HF + rssi + (rssi >> 4);
-                    }
-                    else {
-                        packet_info->rssi = SX127X_RSSI_OFFSET_LF + rssi + (rssi >> 4);
-                    }
+        if (dev->settings.channel > SX127X_RF_MID_BAND_THRESH) {
+            packet_info->rssi = SX127X_RSSI_OFFSET_HF + rssi + (rssi >> 4);
+        }
+        else {
+            packet_info->rssi = SX127X_RSSI_OFFSET_LF + rssi + (rssi >> 4);
+        }
 #endif
-                }
-                packet_info->time_on_air = sx127x_get_time_on_air(dev, len);
-            }
+    }
+    packet_info->time_on_air = sx127x_get_time_on_air(dev, size);
+}
 
-            size = sx127x_reg_read(dev, SX127X_REG_LR_RXNBBYTES);
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    sx127x_t *dev = (sx127x_t*) netdev;
+    /* FIFORXCURRENTADDR, IRQFLAGSMASK, IRQFLAGS and RXNBBYTES */
+    uint8_t regs[4];
+    uint8_t size = 0;
+
+    switch (dev->settings.modem) {
+        case SX127X_MODEM_FSK:
+            /* todo */
+            break;
+        case SX127X_MODEM_LORA:
+            sx127x_reg_read_burst(dev, SX127X_REG_LR_FIFORXCURRENTADDR, regs,
+                                  sizeof(regs));
+            size = regs[3];
             if (buf == NULL) {
+                if (len > 0) {
+                    /* drop the packet */
+                    sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
+                                     SX127X_RF_LORA_IRQFLAGS_RXDONE |
+                                     SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR);
+                    _rx_done(dev);
+                }
                 return size;
             }
 
+            /* Clear IRQ */
+            sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
+                             SX127X_RF_LORA_IRQFLAGS_RXDONE |
+                             SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR);
+            _rx_done(dev);
+
+            if ((regs[2] & SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR_MASK) ==
+                SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR) {
+                netdev->event_callback(netdev, NETDEV_EVENT_CRC_ERROR);
+                return -EBADMSG;
+            }
+
             if (size > len) {
                 return -ENOBUFS;
             }
 
-            if (!(dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG)) {
-                sx127x_set_state(dev, SX127X_RF_IDLE);
+            if (info) {
+                _packet_info(dev, info, size);
             }
 
-            xtimer_remove(&dev->_internal.rx_timeout_timer);
-
-            /* Read the last packet from FIFO */
-            uint8_t last_rx_addr = sx127x_reg_read(dev, SX127X_REG_LR_FIFORXCURRENTADDR);
-            sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, last_rx_addr);
+            /* The FIFO keeps rolling in continuous mode, so read the last
+             * packet from where it was received to */
+            sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, regs[0]);
             sx127x_read_fifo(dev, (uint8_t*)buf, size);
             break;
         default:
@@ -229,6 +246,8 @@ static int _init(netdev_t *netdev)
     settings.channel = SX127X_CHANNEL_DEFAULT;
     settings.modem = SX127X_MODEM_DEFAULT;
     settings.state = SX127X_RF_IDLE;
+    settings.window_timeout = 0;
+    settings.listen_interval = 0;
 
     sx127x->settings = settings;
 
@@ -269,6 +288,10 @@ static void _isr(netdev_t *netdev)
             sx127x_on_dio3(dev);
             break;
 
+        case SX127X_IRQ_LISTEN:
+            sx127x_on_listen(dev);
+            break;
+
         default:
             break;
     }
@@ -337,6 +360,11 @@ static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
             *((netopt_enable_t*) val) = sx127x_get_rx_single(dev) ? NETOPT_ENABLE : NETOPT_DISABLE;
             break;
 
+        case NETOPT_LISTEN_INTERVAL:
+            assert(max_len >= sizeof(uint32_t));
+            *((uint32_t*) val) = sx127x_get_listen_interval(dev);
+            return sizeof(uint32_t);
+
         default:
             break;
     }
@@ -456,6 +484,11 @@ static int _set(netdev_t *netdev, netopt_t opt, void *val, size_t len)
             sx127x_set_iq_invert(dev, *((netopt_enable_t*) val) ? true : false);
             return sizeof(bool);
 
+        case NETOPT_LISTEN_INTERVAL:
+            assert(len <= sizeof(uint32_t));
+            sx127x_set_listen_interval(dev, *((uint32_t*) val));
+            return sizeof(uint32_t);
+
         default:
             break;
     }
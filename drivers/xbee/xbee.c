@@ -25,6 +25,7 @@
 
 #include "xbee.h"
 #include "assert.h"
+#include "irq.h"
 #include "xtimer.h"
 #include "net/eui64.h"
 #include "net/netdev.h"
@@ -52,6 +53,11 @@
  */
 #define RESP_TIMEOUT_USEC           (US_PER_SEC)
 
+/**
+ * @brief   Timeout for a TX status when all frames are in flight
+ */
+#define TX_STATUS_TIMEOUT_USEC      (US_PER_SEC)
+
 /**
  * @brief   Start delimiter in API frame mode
  */
@@ -72,6 +78,16 @@
 #define API_ID_RX_SHORT_ADDR        (0x81)  /**< RX frame (short address) */
 /** @} */
 
+/**
+ * @brief   TX status values as reported in TX response frames
+ * @{
+ */
+#define TX_STATUS_SUCCESS           (0x00)  /**< frame sent (and ACKed) */
+#define TX_STATUS_NOACK             (0x01)  /**< no ACK received */
+#define TX_STATUS_CCA_FAIL          (0x02)  /**< channel was busy */
+#define TX_STATUS_PURGED            (0x03)  /**< frame was dropped */
+/** @} */
+
 /**
  * @brief   Internal option flags (to be expanded if needed)
  * @{
@@ -185,6 +201,29 @@ static void _rx_cb(void *arg, uint8_t c)
     xbee_t *dev = (xbee_t *)arg;
 
     switch (dev->int_state) {
+        case XBEE_INT_STATE_RX:
+            /* fast path: data bytes of a radio packet */
+            if (dev->int_count < dev->int_size) {
+                uint8_t slot = (dev->rx_first + dev->rx_num) % XBEE_RX_FRAMES;
+                dev->rx_buf[slot][dev->int_count++] = c;
+                dev->int_cksum += c;
+                return;
+            }
+            /* the checksum completes the frame, drop it right away if
+             * it does not check out */
+            if ((uint8_t)(dev->int_cksum + c) == 0xff) {
+                uint8_t slot = (dev->rx_first + dev->rx_num) % XBEE_RX_FRAMES;
+                dev->rx_len[slot] = (uint8_t)dev->int_size;
+                dev->rx_num++;
+                if (dev->event_callback) {
+                    dev->event_callback((netdev_t *)dev, NETDEV_EVENT_ISR);
+                }
+            }
+            else {
+                DEBUG("[xbee] rx_cb: invalid RX checksum\n");
+            }
+            dev->int_state = XBEE_INT_STATE_IDLE;
+            break;
         case XBEE_INT_STATE_IDLE:
             /* check for beginning of new data frame */
             if (c == API_START_DELIMITER) {
@@ -197,25 +236,34 @@ static void _rx_cb(void *arg, uint8_t c)
             break;
         case XBEE_INT_STATE_SIZE2:
             dev->int_size += c;
-            dev->int_state = XBEE_INT_STATE_TYPE;
+            /* a frame holds at least its type */
+            dev->int_state = (dev->int_size) ? XBEE_INT_STATE_TYPE
+                                             : XBEE_INT_STATE_IDLE;
             break;
         case XBEE_INT_STATE_TYPE:
+            dev->int_count = 1;
+            dev->int_cksum = c;
+            dev->int_state = XBEE_INT_STATE_SKIP;
             if (c == API_ID_RX_SHORT_ADDR || c == API_ID_RX_LONG_ADDR) {
-                /* in case old data was not processed, ignore incoming data */
-                if (dev->rx_count != 0) {
-                    dev->int_state = XBEE_INT_STATE_IDLE;
-                    return;
+                /* skip the frame if all buffers hold unread frames */
+                if ((dev->rx_num < XBEE_RX_FRAMES) &&
+                    (dev->int_size <= XBEE_MAX_PKT_LENGTH)) {
+                    uint8_t slot = (dev->rx_first + dev->rx_num) % XBEE_RX_FRAMES;
+                    dev->rx_buf[slot][0] = c;
+                    dev->int_state = XBEE_INT_STATE_RX;
+                }
+                else {
+                    DEBUG("[xbee] rx_cb: no space for RX frame\n");
                 }
-                dev->rx_limit = dev->int_size + 1;
-                dev->rx_buf[dev->rx_count++] = c;
-                dev->int_state = XBEE_INT_STATE_RX;
             }
-            else if (c == API_ID_AT_RESP) {
-                dev->resp_limit = dev->int_size;
-                dev->int_state = XBEE_INT_STATE_RESP;
+            else if (c == API_ID_TX_RESP) {
+                dev->int_state = XBEE_INT_STATE_TX_STATUS;
             }
-            else {
-                dev->int_state = XBEE_INT_STATE_IDLE;
+            else if (c == API_ID_AT_RESP) {
+                if (dev->int_size <= XBEE_MAX_RESP_LENGTH) {
+                    dev->resp_limit = dev->int_size;
+                    dev->int_state = XBEE_INT_STATE_RESP;
+                }
             }
             break;
         case XBEE_INT_STATE_RESP:
@@ -226,16 +274,35 @@ static void _rx_cb(void *arg, uint8_t c)
                 dev->int_state = XBEE_INT_STATE_IDLE;
             }
             break;
-        case XBEE_INT_STATE_RX:
-            dev->rx_buf[dev->rx_count++] = c;
-            if (dev->rx_count == dev->rx_limit) {
-                /* packet is complete */
+        case XBEE_INT_STATE_TX_STATUS:
+            /* frame ID, status and checksum, the status is expected for the
+             * oldest frame in flight. Again, the checksum is ignored so the
+             * frame is accounted for in any case. */
+            if (dev->int_count == 2) {
+                if (dev->tx_status_num < XBEE_TX_FRAMES) {
+                    dev->tx_status[(dev->tx_status_first + dev->tx_status_num) %
+                                   XBEE_TX_FRAMES] = c;
+                    dev->tx_status_num++;
+                }
+            }
+            if (dev->int_count++ == dev->int_size) {
+                if (dev->tx_inflight > 0) {
+                    dev->tx_inflight--;
+                }
+                mutex_unlock(&(dev->tx_wait));
                 if (dev->event_callback) {
                     dev->event_callback((netdev_t *)dev, NETDEV_EVENT_ISR);
                 }
                 dev->int_state = XBEE_INT_STATE_IDLE;
             }
             break;
+        case XBEE_INT_STATE_SKIP:
+            /* the frame and its checksum must be consumed, as the payload can
+             * contain the start delimiter */
+            if (dev->int_count++ == dev->int_size) {
+                dev->int_state = XBEE_INT_STATE_IDLE;
+            }
+            break;
         default:
             /* this should never be the case */
             break;
@@ -505,7 +572,11 @@ int xbee_build_hdr(xbee_t *dev, uint8_t *xhdr, size_t payload_len,
     /* set start delimiter, configure address and set options. Also make sure,
      * that the link layer address is of known length */
     xhdr[0] = API_START_DELIMITER;
-    xhdr[4] = dev->tx_fid++;
+    /* frame ID 0 would suppress the TX status */
+    if (++dev->tx_fid == 0) {
+        dev->tx_fid = 1;
+    }
+    xhdr[4] = dev->tx_fid;
     if (addr_len == IEEE802154_SHORT_ADDRESS_LEN) {
         xhdr[3] = API_ID_TX_SHORT_ADDR;
         xhdr[7] = dev->options;
@@ -577,8 +648,13 @@ int xbee_init(netdev_t *dev)
     /* initialize buffers and locks*/
     mutex_init(&(xbee->tx_lock));
     mutex_init(&(xbee->resp_lock));
+    mutex_init(&(xbee->tx_wait));
     xbee->resp_limit = 1;    /* needs to be greater then 0 initially */
-    xbee->rx_count = 0;
+    xbee->rx_first = 0;
+    xbee->rx_num = 0;
+    xbee->tx_inflight = 0;
+    xbee->tx_status_first = 0;
+    xbee->tx_status_num = 0;
     /* initialize UART and GPIO pins */
     if (uart_init(xbee->p.uart, xbee->p.br, _rx_cb, xbee) != UART_OK) {
         DEBUG("[xbee] init: error initializing UART\n");
@@ -655,9 +731,22 @@ static int xbee_send(netdev_t *dev, const struct iovec *vector, unsigned count)
         return -1;
     }
 
+    /* frames are pipelined, only wait if too many are in flight. A TX
+     * status that got lost must not block sending forever. */
+    while (xbee->tx_inflight >= XBEE_TX_FRAMES) {
+        if (xtimer_mutex_lock_timeout(&(xbee->tx_wait),
+                                      TX_STATUS_TIMEOUT_USEC) < 0) {
+            DEBUG("[xbee] send: TX status timeout\n");
+            xbee->tx_inflight = 0;
+        }
+    }
+
     /* send the actual data packet */
     DEBUG("[xbee] send: now sending out %i byte\n", (int)size);
     mutex_lock(&(xbee->tx_lock));
+    unsigned state = irq_disable();
+    xbee->tx_inflight++;
+    irq_restore(state);
     for (unsigned i = 0; i < count; i++) {
         uart_write(xbee->p.uart, vector[i].iov_base, vector[i].iov_len);
     }
@@ -677,29 +766,31 @@ static int xbee_recv(netdev_t *dev, void *buf, size_t len, void *info)
     assert(xbee);
 
     /* make sure we have new data waiting */
-    if (xbee->rx_count != xbee->rx_limit) {
+    if (xbee->rx_num == 0) {
         DEBUG("[xbee] recv: no data available for reading\n");
         return 0;
     }
 
-    /* data available, so we read it (or it's size) */
-    size = (size_t)(xbee->rx_limit - 1);
+    /* data available, so we read the oldest frame (or it's size) */
+    size = xbee->rx_len[xbee->rx_first];
     if (buf == NULL) {
-        if (len > 0) {
-            DEBUG("[xbee] recv: reading size and dropping: %i\n", size);
-            xbee->rx_count = 0;
-        }
-        else {
+        if (len == 0) {
             DEBUG("[xbee] recv: reading size without dropping: %i\n", size);
+            return (int)size;
         }
+        DEBUG("[xbee] recv: reading size and dropping: %i\n", size);
     }
     else {
         size = (size > len) ? len : size;
         DEBUG("[xbee] recv: consuming packet: reading %i byte\n", size);
-        memcpy(buf, xbee->rx_buf, size);
-        xbee->rx_count = 0;
+        memcpy(buf, xbee->rx_buf[xbee->rx_first], size);
     }
 
+    unsigned state = irq_disable();
+    xbee->rx_first = (xbee->rx_first + 1) % XBEE_RX_FRAMES;
+    xbee->rx_num--;
+    irq_restore(state);
+
     return (int)size;
 }
 
@@ -707,17 +798,37 @@ static void xbee_isr(netdev_t *netdev)
 {
     xbee_t *dev = (xbee_t *)netdev;
 
-    if (dev->rx_count == dev->rx_limit) {
-        /* make sure the checksum checks out */
-        if (_cksum(0, dev->rx_buf, dev->rx_limit) != 0) {
-            DEBUG("[xbee] isr: invalid RX checksum\n");
-            dev->rx_count = 0;
-        }
-        else {
-            DEBUG("[xbee] isr: data available, waiting for read\n");
-            dev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    /* report the outcome of sent frames */
+    while (dev->tx_status_num > 0) {
+        unsigned state = irq_disable();
+        uint8_t status = dev->tx_status[dev->tx_status_first];
+        dev->tx_status_first = (dev->tx_status_first + 1) % XBEE_TX_FRAMES;
+        dev->tx_status_num--;
+        irq_restore(state);
+
+        switch (status) {
+            case TX_STATUS_SUCCESS:
+                dev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+                break;
+            case TX_STATUS_NOACK:
+                dev->event_callback(netdev, NETDEV_EVENT_TX_NOACK);
+                break;
+            case TX_STATUS_CCA_FAIL:
+                dev->event_callback(netdev, NETDEV_EVENT_TX_MEDIUM_BUSY);
+                break;
+            default:
+                DEBUG("[xbee] isr: TX status 0x%02x\n", (unsigned)status);
+                break;
         }
     }
+
+    /* hand all frames received so far to the upper layer, which reads them in
+     * the callback. Frames completing in the meantime trigger another ISR
+     * event. */
+    for (unsigned num = dev->rx_num; (num > 0) && (dev->rx_num > 0); num--) {
+        DEBUG("[xbee] isr: data available, waiting for read\n");
+        dev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    }
 }
 
 static int xbee_get(netdev_t *ndev, netopt_t opt, void *value, size_t max_len)
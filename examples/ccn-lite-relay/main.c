@@ -43,6 +43,9 @@ int main(void)
 
     ccnl_core_init();
 
+    /* replace the least recently used content and count the cache hits */
+    ccnl_cache_lru_init(NULL);
+
     ccnl_start();
 
     /* get the default interface */
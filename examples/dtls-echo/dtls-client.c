@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6.h"
@@ -70,6 +71,17 @@ static dtls_context_t *dtls_context = NULL;
 static char *client_payload;
 static size_t buflen = 0;
 
+/*
+ * The context, and with it the DTLS channel to the server, is kept between
+ * the dtlsc commands, so only the first message to a server needs a
+ * handshake. peer_addr is the application data of the context.
+ */
+static session_t dst;
+static int connected = 0;
+static char peer_addr[IPV6_ADDR_MAX_STR_LEN];
+static gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(CLIENT_PORT,
+                                                              KERNEL_PID_UNDEF);
+
 static const unsigned char ecdsa_priv_key[] = {
     0x41, 0xC1, 0xCB, 0x6B, 0x51, 0x24, 0x7A, 0x14,
     0x43, 0x21, 0x43, 0x5B, 0x7A, 0x80, 0xE7, 0x14,
@@ -345,6 +357,28 @@ static int send_to_peer(struct dtls_context_t *ctx,
 
 
 
+/**
+ * @brief Tracks the state of the channel, so it is only set up again if
+ * the server closed it or the handshake failed.
+ */
+static int peer_event(struct dtls_context_t *ctx, session_t *session,
+                      dtls_alert_level_t level, unsigned short code)
+{
+    (void) ctx;
+    (void) session;
+
+    if ((level == 0) && (code == DTLS_EVENT_CONNECTED)) {
+        DEBUG("DBG-Client: channel established\n");
+        connected = 1;
+    }
+    else if ((level == DTLS_ALERT_LEVEL_FATAL) ||
+             (code == DTLS_ALERT_CLOSE_NOTIFY)) {
+        DEBUG("DBG-Client: channel closed\n");
+        connected = 0;
+    }
+    return 0;
+}
+
 /***
  *  This is a custom function for preparing the SIGNAL events and
  *  create a new DTLS context.
@@ -355,7 +389,7 @@ static void init_dtls(session_t *dst, char *addr_str)
     static dtls_handler_t cb = {
         .write = send_to_peer,
         .read  = read_from_peer,
-        .event = NULL,
+        .event = peer_event,
 #ifdef DTLS_PSK
         .get_psk_info = peer_get_psk_info,
 #endif  /* DTLS_PSK */
@@ -390,13 +424,14 @@ static void init_dtls(session_t *dst, char *addr_str)
         return;
     }
 
-    ipv6_addr_t addr_dbg;
-    ipv6_addr_from_str(&addr_dbg, addr_str);
+    /* the shell reuses the buffer of addr_str */
+    strncpy(peer_addr, addr_str, sizeof(peer_addr) - 1);
+    connected = 0;
 
     /*akin to syslog: EMERG, ALERT, CRITC, NOTICE, INFO, DEBUG */
     dtls_set_log_level(DTLS_LOG_NOTICE);
 
-    dtls_context = dtls_new_context(addr_str);
+    dtls_context = dtls_new_context(peer_addr);
     if (dtls_context) {
         dtls_set_handler(dtls_context, &cb);
     }
@@ -411,30 +446,39 @@ static void init_dtls(session_t *dst, char *addr_str)
 static void client_send(char *addr_str, char *data, unsigned int delay)
 {
     int8_t iWatch;
-    static session_t dst;
-    static int connected = 0;
     msg_t msg;
 
-   gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(CLIENT_PORT,
-                                                           sched_active_pid);
-    dtls_init();
-
-    if (gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry)) {
-        puts("Unable to register ports");
-        /*FIXME: Release memory?*/
-        return;
-    }
-
     if (strlen(data) > DTLS_MAX_BUF) {
         puts("Data too long ");
         return;
     }
 
-    init_dtls(&dst, addr_str);
+    /* the UDP listener stays registered with the context */
+    if (entry.target.pid == KERNEL_PID_UNDEF) {
+        dtls_init();
+        entry.target.pid = sched_active_pid;
+        if (gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry)) {
+            puts("Unable to register ports");
+            entry.target.pid = KERNEL_PID_UNDEF;
+            return;
+        }
+    }
+
+    /* reuse the channel if it is to the same server */
+    if (dtls_context && (strcmp(peer_addr, addr_str) != 0)) {
+        dtls_free_context(dtls_context);
+        dtls_context = NULL;
+    }
     if (!dtls_context) {
-        dtls_emerg("cannot create context\n");
-        puts("Client unable to load context!");
-        return;
+        init_dtls(&dst, addr_str);
+        if (!dtls_context) {
+            dtls_emerg("cannot create context\n");
+            puts("Client unable to load context!");
+            return;
+        }
+    }
+    else {
+        DEBUG("DBG-Client: reusing the DTLS channel to %s\n", peer_addr);
     }
 
     /* client_payload is global due to the SIGNAL function send_to_peer  */
@@ -463,14 +507,14 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
          * commented..
          */
         if (!connected) {
-            connected = dtls_connect(dtls_context, &dst);
-        }
-        else if (connected < 0) {
-            puts("Client DTLS was unable to establish a channel!\n");
-            /*NOTE: Not sure what to do in this scenario (if can happens)*/
+            /* starts the handshake, peer_event() signals when it is done */
+            if (dtls_connect(dtls_context, &dst) < 0) {
+                puts("Client DTLS was unable to establish a channel!\n");
+                break;
+            }
+            connected = -1;
         }
-        else {
-            /*TODO: must happens always or only when connected?*/
+        else if (connected > 0) {
             try_send(dtls_context, &dst);
         }
 
@@ -484,20 +528,25 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
 
         xtimer_usleep(delay);
 
-        if (msg_try_receive(&msg) == 1) {
-            dtls_handle_read(dtls_context, (gnrc_pktsnip_t *)(msg.content.ptr));
+        while (msg_try_receive(&msg) == 1) {
+            if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+                dtls_handle_read(dtls_context, pkt);
+                gnrc_pktbuf_release(pkt);
+            }
         }
 
         iWatch--;
     } /*END while*/
 
-    dtls_free_context(dtls_context);
-    /* unregister our UDP listener on this thread */
-    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
-    connected = 0; /*Probably this should be removed or global */
+    if (connected <= 0) {
+        /* start over with a fresh handshake next time */
+        dtls_free_context(dtls_context);
+        dtls_context = NULL;
+    }
 
-    /* Permanent or not permanent? */
-    DEBUG("DTLS-Client: DTLS session finished\n");
+    DEBUG("DTLS-Client: message %s\n", buflen ? "not sent" : "sent");
 }
 
 int udp_client_cmd(int argc, char **argv)
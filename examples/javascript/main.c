@@ -23,6 +23,10 @@
 #include "shell.h"
 #include "jerryscript.h"
 
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOTS
+#include "jerryscript_snapshots.h"
+#endif
+
 int shell_script(int argc, char **argv)
 {
     if (argc < 2) {
@@ -49,8 +53,36 @@ int shell_script(int argc, char **argv)
     return (ret_value != 0);
 }
 
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOTS
+int shell_snapshot(int argc, char **argv)
+{
+    if (argc < 2) {
+        puts("Usage: snapshot <name>\nAvailable snapshots:");
+        for (unsigned i = 0; i < jerryscript_snapshots_numof; i++) {
+            printf("  %s\n", jerryscript_snapshots[i].name);
+        }
+        return -1;
+    }
+
+    const jerryscript_snapshot_t *snapshot = jerryscript_snapshot_find(argv[1]);
+    if (snapshot == NULL) {
+        printf("No snapshot named %s\n", argv[1]);
+        return -1;
+    }
+
+    jerry_init(JERRY_INIT_EMPTY);
+    int res = jerryscript_snapshot_run(snapshot);
+    jerry_cleanup();
+
+    return res;
+}
+#endif
+
 const shell_command_t shell_commands[] = {
     { "script", "Shell scripting ", shell_script },
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOTS
+    { "snapshot", "Run a script compiled at build time", shell_snapshot },
+#endif
     { NULL, NULL, NULL }
 };
 
@@ -0,0 +1,3 @@
+var txt = 'Pi=';
+txt += Math.PI;
+print(txt);
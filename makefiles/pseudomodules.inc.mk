@@ -1,4 +1,5 @@
 PSEUDOMODULES += auto_init_gnrc_rpl
+PSEUDOMODULES += auto_init_profile
 PSEUDOMODULES += can_mbox
 PSEUDOMODULES += can_pm
 PSEUDOMODULES += can_raw
@@ -7,17 +8,29 @@ PSEUDOMODULES += cbor_float
 PSEUDOMODULES += cbor_semantic_tagging
 PSEUDOMODULES += conn_can_isotp_multi
 PSEUDOMODULES += core_%
+PSEUDOMODULES += crypto_aes_hw
+PSEUDOMODULES += dsp_pipeline_%
 PSEUDOMODULES += emb6_router
+PSEUDOMODULES += event_%
+PSEUDOMODULES += evtimer_heap
+PSEUDOMODULES += fib_trie
+PSEUDOMODULES += fw_update_%
 PSEUDOMODULES += gnrc_ipv6_default
+PSEUDOMODULES += gnrc_ipv6_nc_hash
 PSEUDOMODULES += gnrc_ipv6_router
 PSEUDOMODULES += gnrc_ipv6_router_default
 PSEUDOMODULES += gnrc_netdev_default
 PSEUDOMODULES += gnrc_neterr
 PSEUDOMODULES += gnrc_netapi_callbacks
+PSEUDOMODULES += gnrc_netapi_direct
 PSEUDOMODULES += gnrc_netapi_mbox
+PSEUDOMODULES += gnrc_netreg_hash
 PSEUDOMODULES += gnrc_pktbuf
+PSEUDOMODULES += gnrc_pktbuf_counters
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
+PSEUDOMODULES += gnrc_sixlowpan_frag_sfr
+PSEUDOMODULES += gnrc_sixlowpan_frag_vrb
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router
@@ -28,6 +41,7 @@ PSEUDOMODULES += l2filter_blacklist
 PSEUDOMODULES += l2filter_whitelist
 PSEUDOMODULES += log
 PSEUDOMODULES += log_printfnoformat
+PSEUDOMODULES += lpd8808_spi
 PSEUDOMODULES += lwip_arp
 PSEUDOMODULES += lwip_autoip
 PSEUDOMODULES += lwip_dhcp
@@ -43,6 +57,7 @@ PSEUDOMODULES += lwip_udp
 PSEUDOMODULES += lwip_udplite
 PSEUDOMODULES += mpu_stack_guard
 PSEUDOMODULES += netdev_default
+PSEUDOMODULES += netdev_ieee802154_multichannel
 PSEUDOMODULES += netif
 PSEUDOMODULES += netstats
 PSEUDOMODULES += netstats_l2
@@ -51,21 +66,32 @@ PSEUDOMODULES += netstats_rpl
 PSEUDOMODULES += newlib
 PSEUDOMODULES += newlib_nano
 PSEUDOMODULES += openthread
+PSEUDOMODULES += pcd8544_fb
 PSEUDOMODULES += pktqueue
+PSEUDOMODULES += pm_layered_stats
 PSEUDOMODULES += posix
 PSEUDOMODULES += printf_float
 PSEUDOMODULES += saul_adc
 PSEUDOMODULES += saul_default
 PSEUDOMODULES += saul_gpio
-PSEUDOMODULES += schedstatistics
+PSEUDOMODULES += sched_cb
+PSEUDOMODULES += sched_runq_callback
+PSEUDOMODULES += sha256_hw
+PSEUDOMODULES += sntp_clock
 PSEUDOMODULES += sock
+PSEUDOMODULES += sock_async
+PSEUDOMODULES += sock_dns_cache
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
 PSEUDOMODULES += sock_udp
+PSEUDOMODULES += xtimer_slack
+PSEUDOMODULES += xtimer_stats
+PSEUDOMODULES += xtimer_wheel
 
 # include variants of the AT86RF2xx drivers as pseudo modules
 PSEUDOMODULES += at86rf23%
 PSEUDOMODULES += at86rf21%
+PSEUDOMODULES += at86rf2xx_rx_stream
 
 # include variants of the BMX280 drivers as pseudo modules
 PSEUDOMODULES += bmp280
@@ -295,6 +295,40 @@ void ccnl_set_local_producer(ccnl_producer_func func);
  */
 void ccnl_set_cache_strategy_remove(ccnl_cache_strategy_func func);
 
+/**
+ * @brief Statistics of the content store, see @ref ccnl_cache_get_stats()
+ */
+typedef struct {
+    uint32_t interests;     /**< interests received by the relay */
+    uint32_t hits;          /**< interests answered from the content store */
+    uint32_t evictions;     /**< entries removed to make room for new content */
+} ccnl_cache_stats_t;
+
+/**
+ * @brief Replaces the content store entries least recently used first
+ *
+ * Part of the module `ccn-lite-cache`. Sets the caching strategy to evict the
+ * entry not served by the relay for the longest time, and among those the one
+ * served least often, instead of the oldest entry. Static entries are never
+ * evicted. It also installs a local producer (see
+ * @ref ccnl_set_local_producer()) that counts the interests for
+ * @ref ccnl_cache_get_stats() and passes them on to @p producer.
+ *
+ * @param[in] producer  The local producer of the application, may be NULL
+ */
+void ccnl_cache_lru_init(ccnl_producer_func producer);
+
+/**
+ * @brief Gets the statistics of the content store
+ *
+ * Part of the module `ccn-lite-cache`, counted since
+ * @ref ccnl_cache_lru_init().
+ *
+ * @param[in] relay     Local relay struct
+ * @param[out] stats    The statistics
+ */
+void ccnl_cache_get_stats(struct ccnl_relay_s *relay, ccnl_cache_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_ccnlite
+ * @{
+ *
+ * @file
+ * @brief       Least recently used replacement and statistics for the
+ *              content store of CCN-Lite
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "ccn-lite-riot.h"
+
+static ccnl_producer_func _producer;
+static uint32_t _interests;
+/* hits of the entries that have been evicted already */
+static uint32_t _hits_evicted;
+static uint32_t _evictions;
+
+static int _count_interest(struct ccnl_relay_s *relay, struct ccnl_face_s *from,
+                           struct ccnl_pkt_s *pkt)
+{
+    _interests++;
+    return (_producer) ? _producer(relay, from, pkt) : 0;
+}
+
+static int _remove_lru(struct ccnl_relay_s *relay, struct ccnl_content_s *c)
+{
+    struct ccnl_content_s *lru = NULL;
+
+    (void)c;
+    for (struct ccnl_content_s *e = relay->contents; e; e = e->next) {
+        if (e->flags & CCNL_CONTENT_FLAGS_STATIC) {
+            continue;
+        }
+        /* new content is added in front, so on ties the later entry is the
+         * older one */
+        if (!lru || (e->last_used < lru->last_used) ||
+            ((e->last_used == lru->last_used) &&
+             (e->served_cnt <= lru->served_cnt))) {
+            lru = e;
+        }
+    }
+    if (!lru) {
+        /* only static entries, let the default strategy decide */
+        return 0;
+    }
+    _hits_evicted += lru->served_cnt;
+    _evictions++;
+    ccnl_content_remove(relay, lru);
+    return 1;
+}
+
+void ccnl_cache_lru_init(ccnl_producer_func producer)
+{
+    _producer = producer;
+    _interests = 0;
+    _hits_evicted = 0;
+    _evictions = 0;
+    ccnl_set_local_producer(_count_interest);
+    ccnl_set_cache_strategy_remove(_remove_lru);
+}
+
+void ccnl_cache_get_stats(struct ccnl_relay_s *relay, ccnl_cache_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->interests = _interests;
+    stats->hits = _hits_evicted;
+    for (struct ccnl_content_s *e = relay->contents; e; e = e->next) {
+        stats->hits += e->served_cnt;
+    }
+    stats->evictions = _evictions;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup  sys_fatfs_diskio
+ * @{
+ *
+ * @file
+ * @brief    Sector cache between FatFs and the disk I/O backend
+ *
+ * The location of the file allocation tables is taken from the boot sector
+ * of a FAT volume when FatFs reads it while mounting.
+ *
+ * @author   Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fatfs/diskio.h"
+#include "fatfs/ffconf.h"
+#include "fatfs/integer.h"
+#include "fatfs_diskio_common.h"
+#include "mutex.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* boot sector fields, see FAT specification */
+#define BS_JMP_BOOT         (0)
+#define BPB_BYTS_PER_SEC    (11)
+#define BPB_RSVD_SEC_CNT    (14)
+#define BPB_NUM_FATS        (16)
+#define BPB_FAT_SZ16        (22)
+#define BPB_FAT_SZ32        (36)
+#define BS_SIGNATURE        (510)
+
+typedef struct {
+    DWORD sector;
+    uint32_t last_used;
+    BYTE pdrv;
+    bool valid;
+    BYTE data[FIXED_BLOCK_SIZE];
+} _entry_t;
+
+typedef struct {
+    DWORD start;                /* first sector of the FATs */
+    DWORD end;                  /* end of the FATs, 0 if unknown */
+} _fat_area_t;
+
+static _entry_t _data[FATFS_DISKIO_CACHE_SECTORS];
+static _entry_t _fat[FATFS_DISKIO_CACHE_FAT_SECTORS];
+static _fat_area_t _fat_areas[FATFS_DISKIO_CACHE_DRIVES];
+static uint32_t _tick;
+static mutex_t _lock = MUTEX_INIT;
+
+static inline uint16_t _ld16(const BYTE *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t _ld32(const BYTE *p)
+{
+    return _ld16(p) | ((uint32_t)_ld16(&p[2]) << 16);
+}
+
+static void _invalidate(BYTE pdrv, DWORD start, DWORD end)
+{
+    for (unsigned i = 0; i < FATFS_DISKIO_CACHE_SECTORS; i++) {
+        if ((_data[i].pdrv == pdrv) && (_data[i].sector >= start) &&
+            (_data[i].sector < end)) {
+            _data[i].valid = false;
+        }
+    }
+    for (unsigned i = 0; i < FATFS_DISKIO_CACHE_FAT_SECTORS; i++) {
+        if ((_fat[i].pdrv == pdrv) && (_fat[i].sector >= start) &&
+            (_fat[i].sector < end)) {
+            _fat[i].valid = false;
+        }
+    }
+}
+
+/* learns where the FATs are when the boot sector of a volume passes by */
+static void _check_boot_sector(BYTE pdrv, DWORD sector, const BYTE *data)
+{
+    uint32_t fat_size;
+    DWORD start;
+
+    if ((pdrv >= FATFS_DISKIO_CACHE_DRIVES) ||
+        (_ld16(&data[BS_SIGNATURE]) != 0xAA55) ||
+        ((data[BS_JMP_BOOT] != 0xEB) && (data[BS_JMP_BOOT] != 0xE9)) ||
+        (_ld16(&data[BPB_BYTS_PER_SEC]) != FIXED_BLOCK_SIZE) ||
+        (_ld16(&data[BPB_RSVD_SEC_CNT]) == 0) ||
+        (data[BPB_NUM_FATS] == 0) || (data[BPB_NUM_FATS] > 2)) {
+        return;
+    }
+    fat_size = _ld16(&data[BPB_FAT_SZ16]);
+    if (fat_size == 0) {
+        fat_size = _ld32(&data[BPB_FAT_SZ32]);
+    }
+    start = sector + _ld16(&data[BPB_RSVD_SEC_CNT]);
+    if ((_fat_areas[pdrv].start == start) &&
+        (_fat_areas[pdrv].end == (start + (data[BPB_NUM_FATS] * fat_size)))) {
+        return;
+    }
+    /* cached sectors may now belong to the other cache */
+    _invalidate(pdrv, 0, (DWORD)-1);
+    _fat_areas[pdrv].start = start;
+    _fat_areas[pdrv].end = start + (data[BPB_NUM_FATS] * fat_size);
+    DEBUG("fatfs_diskio_cache: FATs of drive %u at [%lu, %lu)\n", (unsigned)pdrv,
+          (unsigned long)_fat_areas[pdrv].start, (unsigned long)_fat_areas[pdrv].end);
+}
+
+static inline bool _is_fat(BYTE pdrv, DWORD sector)
+{
+    return (pdrv < FATFS_DISKIO_CACHE_DRIVES) &&
+           (sector >= _fat_areas[pdrv].start) && (sector < _fat_areas[pdrv].end);
+}
+
+/* the cache a sector belongs to */
+static _entry_t *_cache(BYTE pdrv, DWORD sector, unsigned *numof)
+{
+    if (_is_fat(pdrv, sector)) {
+        *numof = FATFS_DISKIO_CACHE_FAT_SECTORS;
+        return _fat;
+    }
+    *numof = FATFS_DISKIO_CACHE_SECTORS;
+    return _data;
+}
+
+static _entry_t *_find(BYTE pdrv, DWORD sector)
+{
+    unsigned numof;
+    _entry_t *cache = _cache(pdrv, sector, &numof);
+
+    for (unsigned i = 0; i < numof; i++) {
+        if (cache[i].valid && (cache[i].pdrv == pdrv) &&
+            (cache[i].sector == sector)) {
+            return &cache[i];
+        }
+    }
+    return NULL;
+}
+
+/* the least recently used entry of the cache the sector belongs to */
+static _entry_t *_victim(BYTE pdrv, DWORD sector)
+{
+    unsigned numof;
+    _entry_t *cache = _cache(pdrv, sector, &numof);
+    _entry_t *e = &cache[0];
+
+    for (unsigned i = 0; i < numof; i++) {
+        if (!cache[i].valid) {
+            return &cache[i];
+        }
+        if ((int32_t)(cache[i].last_used - e->last_used) < 0) {
+            e = &cache[i];
+        }
+    }
+    return e;
+}
+
+static void _put(BYTE pdrv, DWORD sector, const BYTE *data)
+{
+    _entry_t *e = _find(pdrv, sector);
+
+    if (e == NULL) {
+        e = _victim(pdrv, sector);
+    }
+    e->pdrv = pdrv;
+    e->sector = sector;
+    e->last_used = ++_tick;
+    e->valid = true;
+    memcpy(e->data, data, FIXED_BLOCK_SIZE);
+}
+
+DSTATUS disk_initialize(BYTE pdrv)
+{
+    mutex_lock(&_lock);
+    /* the medium may have changed */
+    _invalidate(pdrv, 0, (DWORD)-1);
+    if (pdrv < FATFS_DISKIO_CACHE_DRIVES) {
+        _fat_areas[pdrv].end = 0;
+    }
+    mutex_unlock(&_lock);
+    return fatfs_diskio_backend_disk_initialize(pdrv);
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+    DRESULT res = RES_OK;
+    _entry_t *e;
+
+    if (count != 1) {
+        /* multi sector transfers go directly to the disk, the cache writes
+         * through, so there is nothing newer in it */
+        return fatfs_diskio_backend_disk_read(pdrv, buff, sector, count);
+    }
+
+    mutex_lock(&_lock);
+    if ((e = _find(pdrv, sector)) != NULL) {
+        e->last_used = ++_tick;
+        memcpy(buff, e->data, FIXED_BLOCK_SIZE);
+    }
+    else if ((res = fatfs_diskio_backend_disk_read(pdrv, buff, sector, 1)) == RES_OK) {
+        _check_boot_sector(pdrv, sector, buff);
+        _put(pdrv, sector, buff);
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+    DRESULT res;
+
+    mutex_lock(&_lock);
+    res = fatfs_diskio_backend_disk_write(pdrv, buff, sector, count);
+    if ((res == RES_OK) && (count == 1)) {
+        _check_boot_sector(pdrv, sector, buff);
+        _put(pdrv, sector, buff);
+    }
+    else {
+        /* cached copies of multiple sectors are dropped, as are those of a
+         * failed write, where it is unknown what reached the disk */
+        _invalidate(pdrv, sector, sector + count);
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+#if (_USE_TRIM == 1)
+    if (cmd == CTRL_TRIM) {
+        DWORD *range = buff;
+
+        mutex_lock(&_lock);
+        _invalidate(pdrv, range[0], range[1] + 1);
+        mutex_unlock(&_lock);
+    }
+#endif
+    return fatfs_diskio_backend_disk_ioctl(pdrv, cmd, buff);
+}
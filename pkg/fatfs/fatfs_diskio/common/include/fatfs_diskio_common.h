@@ -37,6 +37,51 @@ extern "C" {
 #define FATFS_DISKIO_FATTIME_HH_OFFS   (11)
 #define FATFS_DISKIO_FATTIME_MM_OFFS   (5)
 
+/**
+ * @name    Sector cache configuration (module `fatfs_diskio_cache`)
+ *
+ * Single sector accesses go through a cache of recently used sectors. Sectors
+ * of the file allocation tables are kept in a separate cache, so file data
+ * does not evict them. Multi sector transfers, e.g. FatFs' direct transfers of
+ * whole sectors of a file, bypass the cache. The cache writes through, so it
+ * never holds data that is not on the disk.
+ * @{
+ */
+#ifndef FATFS_DISKIO_CACHE_SECTORS
+#define FATFS_DISKIO_CACHE_SECTORS      (4U)    /**< number of cached data sectors */
+#endif
+#ifndef FATFS_DISKIO_CACHE_FAT_SECTORS
+#define FATFS_DISKIO_CACHE_FAT_SECTORS  (2U)    /**< number of cached FAT sectors */
+#endif
+#ifndef FATFS_DISKIO_CACHE_DRIVES
+#define FATFS_DISKIO_CACHE_DRIVES       (1U)    /**< number of drives the FAT
+                                                 *   location is tracked for */
+#endif
+/** @} */
+
+/**
+ * @brief   Name of a disk I/O function of the backend
+ *
+ * With the sector cache the backends (native, sdcard_spi) provide their
+ * disk_initialize(), disk_read(), disk_write() and disk_ioctl() under this
+ * name, and the cache implements the FatFs functions on top of them.
+ */
+#ifdef MODULE_FATFS_DISKIO_CACHE
+#define FATFS_DISKIO_BACKEND(func)  fatfs_diskio_backend_##func
+
+/**
+ * @name    Disk I/O functions of the backend used by the sector cache
+ * @{
+ */
+DSTATUS fatfs_diskio_backend_disk_initialize(BYTE pdrv);
+DRESULT fatfs_diskio_backend_disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+DRESULT fatfs_diskio_backend_disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count);
+DRESULT fatfs_diskio_backend_disk_ioctl(BYTE pdrv, BYTE cmd, void *buff);
+/** @} */
+#else
+#define FATFS_DISKIO_BACKEND(func)  func
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,7 +89,7 @@ DSTATUS disk_status(BYTE pdrv)
  * @return          0 if disk was initialized sucessfully
  * @return          STA_NOINIT if disk id exists, but couldn't be initialized
  */
-DSTATUS disk_initialize(BYTE pdrv)
+DSTATUS FATFS_DISKIO_BACKEND(disk_initialize)(BYTE pdrv)
 {
     dummy_volume_t *volume = get_volume_file(pdrv);
     DEBUG("disk_initialize: %d\n", pdrv);
@@ -128,7 +128,7 @@ DSTATUS disk_initialize(BYTE pdrv)
  * @return             RES_OK if no error occurred
  * @return             RES_NOTRDY if data wasn't read completely
  */
-DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+DRESULT FATFS_DISKIO_BACKEND(disk_read)(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
 {
     dummy_volume_t *volume = get_volume_file(pdrv);
 
@@ -162,7 +162,7 @@ DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
  * @return             RES_OK if no error occurred
  * @return             RES_NOTRDY if data wasn't written completely
  */
-DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+DRESULT FATFS_DISKIO_BACKEND(disk_write)(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
 {
     dummy_volume_t *volume = get_volume_file(pdrv);
 
@@ -201,7 +201,7 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
  * @return                 RES_ERROR if an error occurred
  * @return                 RES_PARERR if an error occurred
  */
-DRESULT disk_ioctl(
+DRESULT FATFS_DISKIO_BACKEND(disk_ioctl)(
     BYTE pdrv,      /*  */
     BYTE cmd,       /*  */
     void *buff      /* Buffer to send/receive control data */
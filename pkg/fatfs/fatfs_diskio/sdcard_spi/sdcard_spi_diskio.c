@@ -77,7 +77,7 @@ DSTATUS disk_status(BYTE pdrv)
  * @return          0 if disk was initialized sucessfully
  * @return          STA_NOINIT if disk id exists, but couldn't be initialized
  */
-DSTATUS disk_initialize(BYTE pdrv)
+DSTATUS FATFS_DISKIO_BACKEND(disk_initialize)(BYTE pdrv)
 {
     sdcard_spi_t *card = get_sd_card(pdrv);
 
@@ -102,7 +102,7 @@ DSTATUS disk_initialize(BYTE pdrv)
  * @return             RES_OK if no error occurred
  * @return             RES_NOTRDY if data wasn't read completely
  */
-DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+DRESULT FATFS_DISKIO_BACKEND(disk_read)(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
 {
     sdcard_spi_t *card = get_sd_card(pdrv);
 
@@ -130,7 +130,7 @@ DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
  * @return             RES_OK if no error occurred
  * @return             RES_NOTRDY if data wasn't written completely
  */
-DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+DRESULT FATFS_DISKIO_BACKEND(disk_write)(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
 {
     sdcard_spi_t *card = get_sd_card(pdrv);
 
@@ -158,7 +158,7 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
  * @return                 RES_ERROR if an error occurred
  * @return                 RES_PARERR if an error occurred
  */
-DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+DRESULT FATFS_DISKIO_BACKEND(disk_ioctl)(BYTE pdrv, BYTE cmd, void *buff)
 {
     #if (_USE_MKFS == 1)
     sdcard_spi_t *card = get_sd_card(pdrv);
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_jerryscript_snapshots
+ * @{
+ *
+ * @file
+ * @brief       JerryScript snapshot implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "jerryscript.h"
+#include "jerryscript_snapshots.h"
+
+/* created from JERRY_SNAPSHOTS by dist/tools/jerryscript/snapshot2h.py */
+#include "jerryscript_snapshots_gen.h"
+
+const jerryscript_snapshot_t jerryscript_snapshots[] = {
+    JERRYSCRIPT_SNAPSHOTS_TABLE
+};
+
+const unsigned jerryscript_snapshots_numof =
+    sizeof(jerryscript_snapshots) / sizeof(jerryscript_snapshots[0]);
+
+const jerryscript_snapshot_t *jerryscript_snapshot_find(const char *name)
+{
+    for (unsigned i = 0; i < jerryscript_snapshots_numof; i++) {
+        if (strcmp(jerryscript_snapshots[i].name, name) == 0) {
+            return &jerryscript_snapshots[i];
+        }
+    }
+    return NULL;
+}
+
+int jerryscript_snapshot_run(const jerryscript_snapshot_t *snapshot)
+{
+    /* without copying, the byte code is executed right from the snapshot */
+    jerry_value_t res = jerry_exec_snapshot(snapshot->data, snapshot->len,
+                                            false);
+    int err = jerry_value_has_error_flag(res) ? -1 : 0;
+
+    jerry_release_value(res);
+    return err;
+}
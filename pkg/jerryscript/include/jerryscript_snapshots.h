@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_jerryscript_snapshots JerryScript snapshots
+ * @ingroup     pkg_jerryscript
+ * @brief       Scripts compiled at build time and executed from flash
+ *
+ * Scripts listed in `JERRY_SNAPSHOTS` in the application's Makefile are
+ * compiled to JerryScript snapshots while building, by a host build of
+ * jerry, and embedded as constant data:
+ *
+ *     JERRY_SNAPSHOTS += main.js
+ *
+ * Running a snapshot neither parses the script nor copies its byte code to
+ * the JerryScript heap, which saves start-up time and heap. The host build
+ * requires cmake and a host C compiler.
+ *
+ * @{
+ *
+ * @file
+ * @brief       JerryScript snapshot interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef JERRYSCRIPT_SNAPSHOTS_H
+#define JERRYSCRIPT_SNAPSHOTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A snapshot embedded in the firmware
+ */
+typedef struct {
+    const char *name;       /**< name of the script, without ".js" */
+    const uint32_t *data;   /**< snapshot */
+    size_t len;             /**< size of jerryscript_snapshot_t::data in bytes */
+} jerryscript_snapshot_t;
+
+/**
+ * @brief   All embedded snapshots
+ */
+extern const jerryscript_snapshot_t jerryscript_snapshots[];
+
+/**
+ * @brief   Number of entries in @ref jerryscript_snapshots
+ */
+extern const unsigned jerryscript_snapshots_numof;
+
+/**
+ * @brief   Find an embedded snapshot by name
+ *
+ * @param[in] name      name of the script, without ".js"
+ *
+ * @return  the snapshot
+ * @return  NULL, if there is none of that name
+ */
+const jerryscript_snapshot_t *jerryscript_snapshot_find(const char *name);
+
+/**
+ * @brief   Execute a snapshot directly from flash
+ *
+ * The engine must be initialized with jerry_init().
+ *
+ * @param[in] snapshot  snapshot to run
+ *
+ * @return  0 on success
+ * @return  -1, if the script threw an error or the snapshot is invalid
+ */
+int jerryscript_snapshot_run(const jerryscript_snapshot_t *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JERRYSCRIPT_SNAPSHOTS_H */
+/** @} */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_libfixmath_vec
+ * @{
+ *
+ * @file
+ * @brief       Q16.16 array kernel implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "assert.h"
+#include "fix16_vec.h"
+
+/* Q32.32 sum of products to Q16.16, rounded like fix16_mul() */
+static inline fix16_t _narrow(int64_t acc)
+{
+#ifndef FIXMATH_NO_ROUNDING
+    if (acc < 0) {
+        acc--;
+    }
+    acc += 0x8000;
+#endif
+    acc >>= 16;
+    if (acc > fix16_maximum) {
+        return fix16_maximum;
+    }
+    if (acc < fix16_minimum) {
+        return fix16_minimum;
+    }
+    return (fix16_t)acc;
+}
+
+static inline fix16_t _sadd(fix16_t a, fix16_t b)
+{
+#ifdef __ARM_FEATURE_DSP
+    fix16_t res;
+    __asm__ ("qadd %0, %1, %2" : "=r" (res) : "r" (a), "r" (b));
+    return res;
+#else
+    int64_t sum = (int64_t)a + b;
+    if (sum > fix16_maximum) {
+        return fix16_maximum;
+    }
+    if (sum < fix16_minimum) {
+        return fix16_minimum;
+    }
+    return (fix16_t)sum;
+#endif
+}
+
+/* unrolled, so each element costs one SMLAL on Cortex-M3 and up */
+static int64_t _dot(const fix16_t *a, const fix16_t *b, size_t len)
+{
+    int64_t acc = 0;
+
+    for (; len >= 4; len -= 4) {
+        acc += (int64_t)a[0] * b[0];
+        acc += (int64_t)a[1] * b[1];
+        acc += (int64_t)a[2] * b[2];
+        acc += (int64_t)a[3] * b[3];
+        a += 4;
+        b += 4;
+    }
+    while (len--) {
+        acc += (int64_t)*a++ * *b++;
+    }
+    return acc;
+}
+
+fix16_t fix16_vec_dot(const fix16_t *a, const fix16_t *b, size_t len)
+{
+    return _narrow(_dot(a, b, len));
+}
+
+void fix16_vec_add(fix16_t *out, const fix16_t *a, const fix16_t *b,
+                   size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[i] = _sadd(a[i], b[i]);
+    }
+}
+
+void fix16_vec_scale(fix16_t *out, const fix16_t *in, fix16_t k, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[i] = _narrow((int64_t)in[i] * k);
+    }
+}
+
+void fix16_fir_init(fix16_fir_t *fir, const fix16_t *coeffs, fix16_t *state,
+                    size_t taps)
+{
+    assert(fir && coeffs && state && (taps > 0));
+
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->pos = 0;
+    for (size_t i = 0; i < 2 * taps; i++) {
+        state[i] = 0;
+    }
+}
+
+void fix16_fir_process(fix16_fir_t *fir, fix16_t *out, const fix16_t *in,
+                       size_t len)
+{
+    size_t taps = fir->taps;
+    size_t pos = fir->pos;
+
+    for (size_t i = 0; i < len; i++) {
+        /* inputs are stored twice, so the newest taps inputs are always
+         * contiguous, newest first, at state[pos] */
+        pos = (pos == 0) ? taps - 1 : pos - 1;
+        fir->state[pos] = fir->state[pos + taps] = in[i];
+        out[i] = _narrow(_dot(fir->coeffs, &fir->state[pos], taps));
+    }
+    fir->pos = pos;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_libfixmath_vec Q16.16 array kernels
+ * @ingroup     pkg_libfixmath
+ * @brief       Dot product, FIR filter, scaling and addition of fix16_t arrays
+ *
+ * The kernels accumulate products in 64 bits and round and saturate only the
+ * result, so a dot product or filter output is both faster and more precise
+ * than a loop of fix16_mul() and fix16_sadd(). Results that do not fit
+ * saturate to fix16_maximum or fix16_minimum. Intermediate sums of products
+ * must stay within +-2^31, i.e. 2^15 times the range of fix16_t.
+ *
+ * On ARMv7-M and ARMv7E-M (Cortex-M3/M4/M7), the accumulation compiles to
+ * one SMLAL per element and, with the DSP extension, additions use QADD.
+ * Other platforms use the same code with the compiler's 64-bit arithmetic.
+ *
+ * Use the `libfixmath-vec` module.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Q16.16 array kernel interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef FIX16_VEC_H
+#define FIX16_VEC_H
+
+#include <stddef.h>
+
+#include "fix16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   State of a FIR filter
+ *
+ * All members are private.
+ */
+typedef struct {
+    const fix16_t *coeffs;  /**< coefficients, coeffs[0] weights the newest input */
+    fix16_t *state;         /**< last inputs, stored twice */
+    size_t taps;            /**< number of coefficients */
+    size_t pos;             /**< position of the newest input in state */
+} fix16_fir_t;
+
+/**
+ * @brief   Dot product of two arrays
+ *
+ * @param[in] a     first array
+ * @param[in] b     second array
+ * @param[in] len   number of elements of @p a and @p b
+ *
+ * @return  sum of a[i] * b[i]
+ */
+fix16_t fix16_vec_dot(const fix16_t *a, const fix16_t *b, size_t len);
+
+/**
+ * @brief   Element-wise saturating addition
+ *
+ * @p out may be @p a or @p b.
+ *
+ * @param[out] out  result array
+ * @param[in] a     first array
+ * @param[in] b     second array
+ * @param[in] len   number of elements of all arrays
+ */
+void fix16_vec_add(fix16_t *out, const fix16_t *a, const fix16_t *b,
+                   size_t len);
+
+/**
+ * @brief   Multiply all elements of an array with a scalar
+ *
+ * @p out may be @p in.
+ *
+ * @param[out] out  result array
+ * @param[in] in    input array
+ * @param[in] k     factor
+ * @param[in] len   number of elements of both arrays
+ */
+void fix16_vec_scale(fix16_t *out, const fix16_t *in, fix16_t k, size_t len);
+
+/**
+ * @brief   Initialize a FIR filter, with all previous inputs 0
+ *
+ * @param[out] fir      filter to initialize
+ * @param[in] coeffs    @p taps coefficients, must stay valid while the
+ *                      filter is used
+ * @param[in] state     buffer of 2 * @p taps elements
+ * @param[in] taps      number of coefficients, > 0
+ */
+void fix16_fir_init(fix16_fir_t *fir, const fix16_t *coeffs, fix16_t *state,
+                    size_t taps);
+
+/**
+ * @brief   Filter a block of samples
+ *
+ * Computes out[n] = sum coeffs[k] * x[n - k], where x continues the inputs of
+ * previous calls. @p out may be @p in.
+ *
+ * @param[in,out] fir   filter
+ * @param[out] out      filtered samples
+ * @param[in] in        input samples
+ * @param[in] len       number of samples
+ */
+void fix16_fir_process(fix16_fir_t *fir, fix16_t *out, const fix16_t *in,
+                       size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX16_VEC_H */
+/** @} */
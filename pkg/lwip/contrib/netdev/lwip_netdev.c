@@ -49,7 +49,6 @@
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _stack[LWIP_NETDEV_STACKSIZE];
 static msg_t _queue[LWIP_NETDEV_QUEUE_LEN];
-static char _tmp_buf[LWIP_NETDEV_BUFLEN];
 
 #ifdef MODULE_NETDEV_ETH
 static err_t _eth_link_output(struct netif *netif, struct pbuf *p);
@@ -213,20 +212,33 @@ static err_t _ieee802154_link_output(struct netif *netif, struct pbuf *p)
 
 static struct pbuf *_get_recv_pkt(netdev_t *dev)
 {
-    int len = dev->driver->recv(dev, _tmp_buf, sizeof(_tmp_buf), NULL);
+    int len = dev->driver->recv(dev, NULL, 0, NULL);
+    struct pbuf *p;
 
-    if (len < 0) {
-        DEBUG("lwip_netdev: an error occurred while reading the packet\n");
+    if ((len <= 0) || ((unsigned)len > LWIP_NETDEV_BUFLEN)) {
+        DEBUG("lwip_netdev: invalid packet length %d\n", len);
+        if (len > 0) {
+            dev->driver->recv(dev, NULL, len, NULL);    /* drop packet */
+        }
         return NULL;
     }
-    assert(((unsigned)len) <= UINT16_MAX);
-    struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_POOL);
-
+    /* let the driver write into a contiguous pbuf directly instead of copying
+     * from an intermediate buffer */
+    p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_RAM);
     if (p == NULL) {
         DEBUG("lwip_netdev: can not allocate in pbuf\n");
+        dev->driver->recv(dev, NULL, len, NULL);        /* drop packet */
         return NULL;
     }
-    pbuf_take(p, _tmp_buf, len);
+    len = dev->driver->recv(dev, p->payload, p->len, NULL);
+    if (len <= 0) {
+        DEBUG("lwip_netdev: an error occurred while reading the packet\n");
+        pbuf_free(p);
+        return NULL;
+    }
+    if (len < p->len) {
+        pbuf_realloc(p, (u16_t)len);
+    }
     return p;
 }
 
@@ -32,7 +32,11 @@ extern "C" {
 #endif
 
 /**
- * @brief   Length of the temporary copying buffer for receival.
+ * @brief   Maximum length of a received frame
+ *
+ * Received frames are read by the driver directly into a pbuf of their
+ * length. Longer frames are dropped.
+ *
  * @note    It should be as long as the maximum packet length of all the netdev you use.
  */
 #ifndef LWIP_NETDEV_BUFLEN
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#include <errno.h>
+
+#include "nanocoap_opt.h"
+
+#define PAYLOAD_MARKER  (0xff)
+
+/* reads the extended option delta or length following an option header */
+static int _get_ext(coap_opt_iter_t *iter, unsigned *val)
+{
+    if (*val == 13) {
+        if (iter->pos >= iter->end) {
+            return -EBADMSG;
+        }
+        *val = 13 + *iter->pos++;
+    }
+    else if (*val == 14) {
+        if ((iter->pos + 2) > iter->end) {
+            return -EBADMSG;
+        }
+        *val = 269 + ((iter->pos[0] << 8) | iter->pos[1]);
+        iter->pos += 2;
+    }
+    else if (*val == 15) {
+        return -EBADMSG;
+    }
+    return 0;
+}
+
+void coap_opt_iter_init(coap_opt_iter_t *iter, coap_pkt_t *pkt)
+{
+    iter->pos = (uint8_t *)pkt->hdr + coap_get_total_hdr_len(pkt);
+    /* coap_parse() points the payload behind the options */
+    iter->end = pkt->payload;
+    iter->num = 0;
+}
+
+int coap_opt_iter_next(coap_opt_iter_t *iter, coap_opt_t *opt)
+{
+    unsigned delta, len;
+
+    if ((iter->pos >= iter->end) || (*iter->pos == PAYLOAD_MARKER)) {
+        return 0;
+    }
+    delta = *iter->pos >> 4;
+    len = *iter->pos & 0xf;
+    iter->pos++;
+    if ((_get_ext(iter, &delta) < 0) || (_get_ext(iter, &len) < 0) ||
+        ((iter->pos + len) > iter->end) || ((iter->num + delta) > UINT16_MAX)) {
+        /* do not continue after a malformed option */
+        iter->pos = iter->end;
+        return -EBADMSG;
+    }
+    iter->num += delta;
+    opt->num = iter->num;
+    opt->val = iter->pos;
+    opt->len = len;
+    iter->pos += len;
+    return 1;
+}
+
+int coap_opt_find(coap_pkt_t *pkt, uint16_t num, coap_opt_t *opt)
+{
+    coap_opt_iter_t iter;
+    int res;
+
+    coap_opt_iter_init(&iter, pkt);
+    while ((res = coap_opt_iter_next(&iter, opt)) > 0) {
+        if (opt->num == num) {
+            return 1;
+        }
+        else if (opt->num > num) {
+            return 0;
+        }
+    }
+    return res;
+}
+
+/** @} */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_nanocoap_opt    nanocoap option iterator
+ * @ingroup     pkg_nanocoap
+ * @brief       Reads options of a parsed CoAP packet on demand
+ *
+ * nanocoap only decodes the options it knows into the @ref coap_pkt_t. With
+ * the module `nanocoap_opt` all other options of a packet can be read
+ * directly from the packet buffer, without copying them, and only when a
+ * handler needs them:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * coap_opt_t opt;
+ *
+ * if (coap_opt_find(pkt, COAP_OPT_ACCEPT, &opt) > 0) {
+ *     uint32_t accept = coap_opt_uint(&opt);
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~
+ * @{
+ *
+ * @file
+ * @brief       Option iterator definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NANOCOAP_OPT_H
+#define NANOCOAP_OPT_H
+
+#include <stdint.h>
+
+#include "nanocoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Option number of the Accept option
+ */
+#define COAP_OPT_ACCEPT         (17)
+
+/**
+ * @brief   An option of a packet
+ */
+typedef struct {
+    const uint8_t *val;     /**< value of the option within the packet */
+    uint16_t num;           /**< option number */
+    uint16_t len;           /**< length of coap_opt_t::val */
+} coap_opt_t;
+
+/**
+ * @brief   Iterator over the options of a packet
+ */
+typedef struct {
+    const uint8_t *pos;     /**< next option */
+    const uint8_t *end;     /**< end of the options */
+    uint16_t num;           /**< number of the last option */
+} coap_opt_iter_t;
+
+/**
+ * @brief   Initializes an iterator over the options of a packet
+ *
+ * @pre @p pkt was parsed with coap_parse()
+ *
+ * @param[out] iter the iterator
+ * @param[in] pkt   the packet
+ */
+void coap_opt_iter_init(coap_opt_iter_t *iter, coap_pkt_t *pkt);
+
+/**
+ * @brief   Decodes the next option of a packet
+ *
+ * Options are returned in the order of their number.
+ *
+ * @param[in,out] iter  the iterator
+ * @param[out] opt      the option
+ *
+ * @return  1 if @p opt was decoded
+ * @return  0 if there are no more options
+ * @return  -EBADMSG if the option is malformed
+ */
+int coap_opt_iter_next(coap_opt_iter_t *iter, coap_opt_t *opt);
+
+/**
+ * @brief   Finds the first option with a given number in a packet
+ *
+ * Stops decoding at the first option with a higher number.
+ *
+ * @pre @p pkt was parsed with coap_parse()
+ *
+ * @param[in] pkt   the packet
+ * @param[in] num   option number
+ * @param[out] opt  the option
+ *
+ * @return  1 if the option was found
+ * @return  0 if @p pkt has no option @p num
+ * @return  -EBADMSG if an option is malformed
+ */
+int coap_opt_find(coap_pkt_t *pkt, uint16_t num, coap_opt_t *opt);
+
+/**
+ * @brief   Decodes the value of an option of type uint
+ *
+ * @param[in] opt   the option
+ *
+ * @return  the value, values longer than 4 bytes are truncated to their last
+ *          4 bytes
+ */
+static inline uint32_t coap_opt_uint(const coap_opt_t *opt)
+{
+    uint32_t val = 0;
+
+    for (unsigned i = 0; i < opt->len; i++) {
+        val = (val << 8) | opt->val[i];
+    }
+    return val;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOCOAP_OPT_H */
+/** @} */
@@ -38,6 +38,7 @@ static msg_t _queue[OPENTHREAD_QUEUE_LEN];
 
 static kernel_pid_t _pid;
 static otInstance *sInstance;
+static bool _tasklets_pending;
 
 /**
  * @name    Default configuration for OpenThread network
@@ -65,9 +66,11 @@ uint8_t ot_call_command(char* command, void *arg, void* answer) {
     return (uint8_t)reply.content.value;
 }
 
-/* OpenThread will call this when switching state from empty tasklet to non-empty tasklet. */
+/* OpenThread will call this when switching state from empty tasklet to non-empty tasklet.
+ * The tasklets are processed by the event loop, before it waits for the next message. */
 void otTaskletsSignalPending(otInstance *aInstance) {
-    otTaskletsProcess(aInstance);
+    (void)aInstance;
+    _tasklets_pending = true;
 }
 
 static void *_openthread_event_loop(void *arg) {
@@ -102,6 +105,10 @@ static void *_openthread_event_loop(void *arg) {
     uint8_t *buf;
     ot_job_t *job;
     while (1) {
+        while (_tasklets_pending) {
+            _tasklets_pending = false;
+            otTaskletsProcess(sInstance);
+        }
         msg_receive(&msg);
         switch (msg.type) {
             case OPENTHREAD_XTIMER_MSG_TYPE_EVENT:
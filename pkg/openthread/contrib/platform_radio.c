@@ -42,25 +42,30 @@ static netdev_t *_dev;
 
 static bool sDisabled;
 
+/* last values set in the driver, OpenThread sets both for every frame */
+static uint16_t _channel = UINT16_MAX;
+static int16_t _power = INT16_MIN;
+
 /* set 15.4 channel */
 static int _set_channel(uint16_t channel)
 {
-    return _dev->driver->set(_dev, NETOPT_CHANNEL, &channel, sizeof(uint16_t));
-}
-
-/*get transmission power from driver */
-static int16_t _get_power(void)
-{
-    int16_t power;
-
-    _dev->driver->get(_dev, NETOPT_TX_POWER, &power, sizeof(int16_t));
-    return power;
+    if (channel == _channel) {
+        return sizeof(uint16_t);
+    }
+    int res = _dev->driver->set(_dev, NETOPT_CHANNEL, &channel, sizeof(uint16_t));
+    _channel = (res < 0) ? UINT16_MAX : channel;
+    return res;
 }
 
 /* set transmission power */
 static int _set_power(int16_t power)
 {
-    return _dev->driver->set(_dev, NETOPT_TX_POWER, &power, sizeof(int16_t));
+    if (power == _power) {
+        return sizeof(int16_t);
+    }
+    int res = _dev->driver->set(_dev, NETOPT_TX_POWER, &power, sizeof(int16_t));
+    _power = (res < 0) ? INT16_MIN : power;
+    return res;
 }
 
 /* set IEEE802.15.4 PAN ID */
@@ -137,34 +142,33 @@ void recv_pkt(otInstance *aInstance, netdev_t *dev)
 {
     DEBUG("Openthread: Received pkt\n");
     netdev_ieee802154_rx_info_t rx_info;
-    /* Read frame length from driver */
-    int len = dev->driver->recv(dev, NULL, 0, &rx_info);
-    Rssi = rx_info.rssi;
 
-    /* very unlikely */
-    if ((len > (unsigned) UINT16_MAX)) {
-        DEBUG("Len too high: %d\n", len);
+    /* Read the frame straight into OpenThread's receive frame, leaving room
+     * for the FCS */
+    int res = dev->driver->recv(dev, (char *) sReceiveFrame.mPsdu,
+                                IEEE802154_FRAME_LEN_MAX - RADIO_IEEE802154_FCS_LEN,
+                                &rx_info);
+    if (res <= 0) {
+        DEBUG("openthread: failed to receive frame: %d\n", res);
         otPlatRadioReceiveDone(aInstance, NULL, kThreadError_Abort);
         return;
     }
+    Rssi = rx_info.rssi;
 
     /* Fill OpenThread receive frame */
     /* Openthread needs a packet length with FCS included,
      * OpenThread do not use the data so we don't need to calculate FCS */
-    sReceiveFrame.mLength = len + RADIO_IEEE802154_FCS_LEN;
-    sReceiveFrame.mPower = _get_power();
-
-    /* Read received frame */
-    int res = dev->driver->recv(dev, (char *) sReceiveFrame.mPsdu, len, NULL);
+    sReceiveFrame.mLength = res + RADIO_IEEE802154_FCS_LEN;
+    sReceiveFrame.mPower = Rssi;
 
-   DEBUG("Received message: len %d\n", (int) sReceiveFrame.mLength);
+    DEBUG("Received message: len %d\n", (int) sReceiveFrame.mLength);
     for (int i = 0; i < sReceiveFrame.mLength; ++i) {
         DEBUG("%x ", sReceiveFrame.mPsdu[i]);
     }
     DEBUG("\n");
 
     /* Tell OpenThread that receive has finished */
-    otPlatRadioReceiveDone(aInstance, res > 0 ? &sReceiveFrame : NULL, res > 0 ? kThreadError_None : kThreadError_Abort);
+    otPlatRadioReceiveDone(aInstance, &sReceiveFrame, kThreadError_None);
 }
 
 /* Called upon TX event */
@@ -117,6 +117,10 @@ void spiffs_unlock(struct spiffs_t *fs)
     spiffs_desc_t *fs_desc = container_of(fs, spiffs_desc_t, fs);
 
     DEBUG("spiffs: unlock: fs_desc %p\n", (void*)fs_desc);
+#if SPIFFS_FS_MTD_CACHE
+    /* write back what the operation modified before the next one starts */
+    mtd_cache_flush(&fs_desc->mtd_cache);
+#endif
     mutex_unlock(&fs_desc->lock);
 }
 
@@ -125,6 +129,17 @@ static int _mount(vfs_mount_t *mountp)
     spiffs_desc_t *fs_desc = mountp->private_data;
 #if SPIFFS_HAL_CALLBACK_EXTRA == 1
     mtd_dev_t *dev = fs_desc->dev;
+#if SPIFFS_FS_MTD_CACHE
+    fs_desc->mtd_cache.base.driver = &mtd_cache_driver;
+    fs_desc->mtd_cache.parent = dev;
+    dev = &fs_desc->mtd_cache.base;
+    /* copies the geometry of the cached device */
+    int res = mtd_init(dev);
+    if (res < 0) {
+        DEBUG("spiffs: mount: mtd cache init: %d\n", res);
+        return res;
+    }
+#endif
     fs_desc->fs.user_data = dev;
 #else
     mtd_dev_t *dev = SPIFFS_MTD_DEV;
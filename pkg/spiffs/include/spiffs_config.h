@@ -226,6 +226,19 @@ void spiffs_unlock(struct spiffs_t *fs);
 #define SPIFFS_FILEHDL_OFFSET                 0
 #endif
 
+// Enable this to keep file descriptors of closed files around, so opening
+// the same file again does not have to search the object lookup pages for
+// its index header. Uses the file descriptors given in SPIFFS_mount, so
+// more of them make reopening recently used files faster.
+#ifndef SPIFFS_TEMPORAL_FD_CACHE
+#define SPIFFS_TEMPORAL_FD_CACHE              1
+#endif
+// Score given to a cached file descriptor when its file is opened again,
+// descriptors of frequently opened files are replaced last.
+#ifndef SPIFFS_TEMPORAL_CACHE_HIT_SCORE
+#define SPIFFS_TEMPORAL_CACHE_HIT_SCORE       4
+#endif
+
 // Enable this to compile a read only version of spiffs.
 // This will reduce binary size of spiffs. All code comprising modification
 // of the file system will not be compiled. Some config will be ignored.
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_tlsf
+ * @{
+ *
+ * @file
+ * @brief       TLSF based system memory allocator
+ *
+ * Provides malloc(), calloc(), realloc(), memalign() and free() on top of a
+ * static TLSF pool, so every call is O(1). The pool is set up on first use,
+ * all calls are serialized by disabling interrupts, which makes them usable
+ * from interrupt context as well.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "tlsf.h"
+
+#ifdef MODULE_NEWLIB
+#include <reent.h>
+#endif
+
+/**
+ * @brief   Size of the heap managed by TLSF in bytes
+ *
+ * This includes TLSF's control structure.
+ */
+#ifndef TLSF_MALLOC_HEAP_SIZE
+#define TLSF_MALLOC_HEAP_SIZE   (8192U)
+#endif
+
+/* TLSF keeps the size of a block, together with two status bits, in the word
+ * right in front of the block's payload */
+#define BLOCK_OVERHEAD          (sizeof(size_t))
+
+static uint32_t _heap[TLSF_MALLOC_HEAP_SIZE / sizeof(uint32_t)];
+static size_t _capacity;
+static size_t _used;
+static size_t _used_max;
+static unsigned _blocks;
+
+static inline size_t _block_size(void *ptr)
+{
+    return ((size_t *)ptr)[-1] & ~((size_t)0x3);
+}
+
+/* find the largest block tlsf_malloc() currently hands out, interrupts must
+ * be disabled */
+static size_t _largest(size_t max)
+{
+    size_t lo = 0;
+
+    while (lo < max) {
+        size_t mid = max - ((max - lo) / 2);
+        void *ptr = tlsf_malloc(mid);
+
+        if (ptr) {
+            tlsf_free(ptr);
+            lo = mid;
+        }
+        else {
+            max = mid - 1;
+        }
+    }
+    return lo;
+}
+
+static void _init(void)
+{
+    tlsf_create_with_pool(_heap, sizeof(_heap));
+    _capacity = _largest(sizeof(_heap)) + BLOCK_OVERHEAD;
+}
+
+static void _account_alloc(void *ptr)
+{
+    _used += _block_size(ptr) + BLOCK_OVERHEAD;
+    if (_used > _used_max) {
+        _used_max = _used;
+    }
+    _blocks++;
+}
+
+static void _account_free(void *ptr)
+{
+    _used -= _block_size(ptr) + BLOCK_OVERHEAD;
+    _blocks--;
+}
+
+void *malloc(size_t bytes)
+{
+    unsigned state = irq_disable();
+    void *res;
+
+    if (!_capacity) {
+        _init();
+    }
+    res = tlsf_malloc(bytes);
+    if (res) {
+        _account_alloc(res);
+    }
+    irq_restore(state);
+    return res;
+}
+
+void *calloc(size_t count, size_t bytes)
+{
+    size_t total = count * bytes;
+    void *res;
+
+    if (bytes && ((total / bytes) != count)) {
+        return NULL;
+    }
+    res = malloc(total);
+    if (res) {
+        memset(res, 0, total);
+    }
+    return res;
+}
+
+void *memalign(size_t align, size_t bytes)
+{
+    unsigned state = irq_disable();
+    void *res;
+
+    if (!_capacity) {
+        _init();
+    }
+    res = tlsf_memalign(align, bytes);
+    if (res) {
+        _account_alloc(res);
+    }
+    irq_restore(state);
+    return res;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    unsigned state = irq_disable();
+    void *res;
+
+    if (!_capacity) {
+        _init();
+    }
+    if (ptr) {
+        _account_free(ptr);
+    }
+    res = tlsf_realloc(ptr, size);
+    if (res) {
+        _account_alloc(res);
+    }
+    else if (ptr && size) {
+        /* the old block is still in place */
+        _account_alloc(ptr);
+    }
+    irq_restore(state);
+    return res;
+}
+
+void free(void *ptr)
+{
+    if (ptr) {
+        unsigned state = irq_disable();
+        _account_free(ptr);
+        tlsf_free(ptr);
+        irq_restore(state);
+    }
+}
+
+#ifdef MODULE_NEWLIB
+void *_malloc_r(struct _reent *r, size_t bytes)
+{
+    (void)r;
+    return malloc(bytes);
+}
+
+void *_calloc_r(struct _reent *r, size_t count, size_t bytes)
+{
+    (void)r;
+    return calloc(count, bytes);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    (void)r;
+    return realloc(ptr, size);
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    free(ptr);
+}
+#endif
+
+void heap_stats(void)
+{
+    unsigned state = irq_disable();
+    size_t free_bytes, largest;
+    size_t used, used_max;
+    unsigned blocks;
+
+    if (!_capacity) {
+        _init();
+    }
+    free_bytes = _capacity - _used;
+    largest = _largest(free_bytes);
+    used = _used;
+    used_max = _used_max;
+    blocks = _blocks;
+    irq_restore(state);
+
+    printf("heap: %u (used %u in %u blocks, max %u, free %u) [bytes]\n",
+           (unsigned)_capacity, (unsigned)used, blocks, (unsigned)used_max,
+           (unsigned)free_bytes);
+    /* the share of free memory that is not part of the largest free block */
+    printf("largest free block: %u [bytes], fragmentation: %u%%\n",
+           (unsigned)largest, free_bytes ?
+           (unsigned)(100 - ((100 * (uint64_t)(largest + BLOCK_OVERHEAD)) /
+                             free_bytes)) : 0);
+}
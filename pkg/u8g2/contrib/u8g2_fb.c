@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_u8g2_fb
+ * @{
+ *
+ * @file
+ * @brief       Partial refresh for U8g2
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "u8g2_fb.h"
+
+/* U8g2 transfers whole tiles of 8 columns */
+#define TILE_COLS       (8U)
+
+static void _draw(void *arg, uint8_t page, uint16_t x, const uint8_t *data,
+                  size_t len)
+{
+    u8g2_fb_t *fb = arg;
+    uint8_t tx0 = x / TILE_COLS;
+    uint8_t tx1 = (x + len + TILE_COLS - 1) / TILE_COLS;
+
+    /* the tiles start at the first changed one, not at the first change */
+    data -= x - (tx0 * TILE_COLS);
+    u8x8_DrawTile(u8g2_GetU8x8(fb->u8g2), tx0, page, tx1 - tx0,
+                  (uint8_t *)data);
+}
+
+void u8g2_fb_init(u8g2_fb_t *fb, u8g2_t *u8g2, uint8_t *buf,
+                  fb_page_dirty_t *dirty)
+{
+    uint8_t tile_width = u8g2_GetBufferTileWidth(u8g2);
+    uint8_t tile_height = u8g2_GetBufferTileHeight(u8g2);
+
+    /* needs the full buffer of the display */
+    assert(tile_height == u8g2_GetU8x8(u8g2)->display_info->tile_height);
+
+    fb->u8g2 = u8g2;
+    fb_page_init(&fb->fb, buf, dirty, tile_width * TILE_COLS, tile_height);
+}
+
+void u8g2_fb_sync(u8g2_fb_t *fb)
+{
+    const uint8_t *content = u8g2_GetBufferPtr(fb->u8g2);
+
+    for (unsigned page = 0; page < fb->fb.pages; page++) {
+        fb_page_write(&fb->fb, page, 0, &content[page * fb->fb.width],
+                      fb->fb.width);
+    }
+}
+
+bool u8g2_fb_flush(u8g2_fb_t *fb, unsigned max_rows)
+{
+    return fb_page_flush(&fb->fb, _draw, fb, max_rows);
+}
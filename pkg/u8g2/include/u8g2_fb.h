@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_u8g2_fb Partial refresh for U8g2
+ * @ingroup     pkg_u8g2
+ * @brief       Transfers only the changed tiles of a U8g2 full buffer
+ *
+ * u8g2_SendBuffer() transfers the whole buffer on every refresh. Instead,
+ * u8g2_fb_sync() compares the buffer of U8g2 to a copy of the content of the
+ * display in a @ref drivers_fb_page and u8g2_fb_flush() transfers only the
+ * tiles that changed, a number of tile rows per call, so a refresh does not
+ * hold up the application for the transfer of the whole screen.
+ *
+ * The copy takes as much memory as the buffer of U8g2. It works with the
+ * full buffer setup functions (`u8g2_Setup_..._f()`) of displays that use
+ * the vertical layout of the SSD1306, PCD8544 or UC1701, i.e. where a byte
+ * of the buffer holds 8 stacked pixels.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface of the partial refresh for U8g2
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef U8G2_FB_H
+#define U8G2_FB_H
+
+#include <stdbool.h>
+
+#include "fb_page.h"
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the copy of the display content
+ *
+ * @param[in] tile_width    width of the display in tiles of 8 pixels
+ * @param[in] tile_height   height of the display in tiles of 8 pixels
+ */
+#define U8G2_FB_BUF_SIZE(tile_width, tile_height) \
+    ((tile_width) * 8 * (tile_height))
+
+/**
+ * @brief   Partial refresh state of a U8g2 display
+ */
+typedef struct {
+    fb_page_t fb;       /**< content of the display */
+    u8g2_t *u8g2;       /**< display */
+} u8g2_fb_t;
+
+/**
+ * @brief   Initialize the partial refresh of a display
+ *
+ * As the content of the display is unknown, the first flushes transfer the
+ * whole screen.
+ *
+ * @param[out] fb       state to initialize
+ * @param[in] u8g2      display, set up with a full buffer
+ * @param[in] buf       U8G2_FB_BUF_SIZE() bytes for the copy of the content
+ * @param[in] dirty     one entry per tile row of the display
+ */
+void u8g2_fb_init(u8g2_fb_t *fb, u8g2_t *u8g2, uint8_t *buf,
+                  fb_page_dirty_t *dirty);
+
+/**
+ * @brief   Take the changes of the buffer of U8g2
+ *
+ * Replaces u8g2_SendBuffer(), the changes are transferred with
+ * u8g2_fb_flush().
+ *
+ * @param[in] fb        partial refresh state
+ */
+void u8g2_fb_sync(u8g2_fb_t *fb);
+
+/**
+ * @brief   Transfer the changed tiles of a number of tile rows
+ *
+ * @param[in] fb        partial refresh state
+ * @param[in] max_rows  number of tile rows to transfer at most, 0 for all
+ *
+ * @return  true, if there are changed tiles left
+ */
+bool u8g2_fb_flush(u8g2_fb_t *fb, unsigned max_rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U8G2_FB_H */
+/** @} */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama_contrib
+ * @{
+ *
+ * @file
+ * @brief       Platform functions of Wakaama for RIOT
+ *
+ * The pools are set up on the first allocation. Wakaama allocates from the
+ * thread running the client only, so they are not locked.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memarray.h"
+#include "timex.h"
+#include "xtimer.h"
+#include "lwm2m_riot.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define SMALL_WORDS     (LWM2M_RIOT_POOL_SMALL_SIZE / sizeof(void *))
+#define LARGE_WORDS     (LWM2M_RIOT_POOL_LARGE_SIZE / sizeof(void *))
+
+static void *_small_data[LWM2M_RIOT_POOL_SMALL_NUMOF][SMALL_WORDS];
+static void *_large_data[LWM2M_RIOT_POOL_LARGE_NUMOF][LARGE_WORDS];
+static memarray_t _small;
+static memarray_t _large;
+static bool _init;
+
+static inline bool _in(const void *ptr, const void *data, size_t size)
+{
+    return ((const uint8_t *)ptr >= (const uint8_t *)data) &&
+           ((const uint8_t *)ptr < (const uint8_t *)data + size);
+}
+
+void *lwm2m_malloc(size_t s)
+{
+    void *ptr = NULL;
+
+    if (!_init) {
+        memarray_init(&_small, _small_data, sizeof(_small_data[0]),
+                      LWM2M_RIOT_POOL_SMALL_NUMOF);
+        memarray_init(&_large, _large_data, sizeof(_large_data[0]),
+                      LWM2M_RIOT_POOL_LARGE_NUMOF);
+        _init = true;
+    }
+    if (s <= sizeof(_small_data[0])) {
+        ptr = memarray_alloc(&_small);
+    }
+    if ((ptr == NULL) && (s <= sizeof(_large_data[0]))) {
+        ptr = memarray_alloc(&_large);
+    }
+    if (ptr == NULL) {
+        DEBUG("lwm2m_malloc: %u bytes from the heap\n", (unsigned)s);
+        ptr = malloc(s);
+    }
+    return ptr;
+}
+
+void lwm2m_free(void *p)
+{
+    if (_in(p, _small_data, sizeof(_small_data))) {
+        memarray_free(&_small, p);
+    }
+    else if (_in(p, _large_data, sizeof(_large_data))) {
+        memarray_free(&_large, p);
+    }
+    else {
+        free(p);
+    }
+}
+
+char *lwm2m_strdup(const char *str)
+{
+    size_t len = strlen(str) + 1;
+    char *res = lwm2m_malloc(len);
+
+    if (res != NULL) {
+        memcpy(res, str, len);
+    }
+    return res;
+}
+
+time_t lwm2m_gettime(void)
+{
+    return (time_t)(xtimer_now_usec64() / US_PER_SEC);
+}
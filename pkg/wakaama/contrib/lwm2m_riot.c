@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama_contrib
+ * @{
+ *
+ * @file
+ * @brief       sock_udp transport and batched notifications for Wakaama
+ *
+ * The batch is kept globally, as a node runs one LwM2M client.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "lwm2m_riot.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static lwm2m_uri_t _batch[LWM2M_RIOT_BATCH_NUMOF];
+static unsigned _batch_numof;
+static time_t _batch_start;
+
+uint8_t lwm2m_riot_send(void *session_h, uint8_t *buffer, size_t length,
+                        void *user_data)
+{
+    lwm2m_riot_session_t *session = session_h;
+    ssize_t res;
+
+    (void)user_data;
+    /* the serialized message goes straight to the stack */
+    res = sock_udp_send(session->sock, buffer, length, &session->remote);
+    if (res < 0) {
+        DEBUG("lwm2m_riot_send: error sending (%d)\n", (int)res);
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+    return COAP_NO_ERROR;
+}
+
+static bool _ep_equal(const sock_udp_ep_t *a, const sock_udp_ep_t *b)
+{
+    if ((a->family != b->family) || (a->port != b->port)) {
+        return false;
+    }
+    switch (a->family) {
+#ifdef SOCK_HAS_IPV6
+        case AF_INET6:
+            return memcmp(a->addr.ipv6, b->addr.ipv6, sizeof(a->addr.ipv6)) == 0;
+#endif
+        case AF_INET:
+            return a->addr.ipv4_u32 == b->addr.ipv4_u32;
+        default:
+            return false;
+    }
+}
+
+int lwm2m_riot_recv(lwm2m_context_t *ctx, sock_udp_t *sock,
+                    lwm2m_riot_session_t *sessions, unsigned numof,
+                    uint32_t timeout)
+{
+    static uint8_t buf[LWM2M_RIOT_RX_BUFSIZE];
+    sock_udp_ep_t remote;
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), timeout, &remote);
+
+    if (res <= 0) {
+        return (int)res;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if (_ep_equal(&sessions[i].remote, &remote)) {
+            lwm2m_handle_packet(ctx, buf, (int)res, &sessions[i]);
+            return (int)res;
+        }
+    }
+    DEBUG("lwm2m_riot_recv: dropped packet of unknown peer\n");
+    return -ENOENT;
+}
+
+/* true if a change of uri a includes the change of uri b */
+static bool _covers(const lwm2m_uri_t *a, const lwm2m_uri_t *b)
+{
+    if (a->objectId != b->objectId) {
+        return false;
+    }
+    if (a->flag & LWM2M_URI_FLAG_INSTANCE_ID) {
+        if (!(b->flag & LWM2M_URI_FLAG_INSTANCE_ID) ||
+            (a->instanceId != b->instanceId)) {
+            return false;
+        }
+    }
+    if (a->flag & LWM2M_URI_FLAG_RESOURCE_ID) {
+        if (!(b->flag & LWM2M_URI_FLAG_RESOURCE_ID) ||
+            (a->resourceId != b->resourceId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _remove_covered(const lwm2m_uri_t *uri)
+{
+    unsigned num = 0;
+
+    for (unsigned i = 0; i < _batch_numof; i++) {
+        if (!_covers(uri, &_batch[i])) {
+            _batch[num++] = _batch[i];
+        }
+    }
+    _batch_numof = num;
+}
+
+static void _flush(lwm2m_context_t *ctx)
+{
+    DEBUG("lwm2m_riot: reporting %u changes\n", _batch_numof);
+    for (unsigned i = 0; i < _batch_numof; i++) {
+        lwm2m_resource_value_changed(ctx, &_batch[i]);
+    }
+    _batch_numof = 0;
+}
+
+void lwm2m_riot_changed(lwm2m_context_t *ctx, const lwm2m_uri_t *uri)
+{
+    lwm2m_uri_t change = *uri;
+
+    for (unsigned i = 0; i < _batch_numof; i++) {
+        if (_covers(&_batch[i], &change)) {
+            return;
+        }
+    }
+    _remove_covered(&change);
+    if (_batch_numof == LWM2M_RIOT_BATCH_NUMOF) {
+        /* the observers of the resource are observers of its instance */
+        change.flag &= ~LWM2M_URI_FLAG_RESOURCE_ID;
+        _remove_covered(&change);
+    }
+    if (_batch_numof == LWM2M_RIOT_BATCH_NUMOF) {
+        _flush(ctx);
+    }
+    if (_batch_numof == 0) {
+        _batch_start = lwm2m_gettime();
+    }
+    _batch[_batch_numof++] = change;
+}
+
+int lwm2m_riot_step(lwm2m_context_t *ctx, time_t *timeout)
+{
+    int res;
+
+    if ((_batch_numof > 0) &&
+        ((lwm2m_gettime() - _batch_start) >= (time_t)LWM2M_RIOT_BATCH_WINDOW)) {
+        _flush(ctx);
+    }
+    res = lwm2m_step(ctx, timeout);
+    if (_batch_numof > 0) {
+        time_t left = _batch_start + (time_t)LWM2M_RIOT_BATCH_WINDOW -
+                      lwm2m_gettime();
+
+        if (left < 0) {
+            left = 0;
+        }
+        if (*timeout > left) {
+            *timeout = left;
+        }
+    }
+    return res;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_wakaama_contrib Wakaama RIOT integration
+ * @ingroup     pkg_wakaama
+ * @brief       Platform functions, sock_udp transport and batched
+ *              notifications for Wakaama LwM2M clients
+ *
+ * Wakaama expects the application to provide its platform functions. The
+ * `wakaama_contrib` module implements them for RIOT:
+ *
+ * - lwm2m_malloc() takes memory from two pools of fixed size blocks and
+ *   only falls back to malloc() for larger or excess requests. The many
+ *   short lived buffers for serializing notifications and CoAP messages thus
+ *   do not fragment the heap.
+ * - lwm2m_gettime() is based on xtimer.
+ *
+ * lwm2m_riot_send() is the buffer send callback of the client and passes the
+ * serialized message straight to sock_udp_send(). lwm2m_riot_recv() receives
+ * into a static buffer and hands the packet to lwm2m_handle_packet().
+ *
+ * Changed resources are reported with lwm2m_riot_changed() instead of
+ * lwm2m_resource_value_changed(). Changes are collected for
+ * LWM2M_RIOT_BATCH_WINDOW seconds, and repeated changes of a resource are
+ * reported to the core only once. lwm2m_riot_step() then reports all of them
+ * right before the core builds its notifications. So a server observing an
+ * object instance gets all changed resources in one TLV message per window
+ * and not one message per change.
+ *
+ * @note    SenML-CBOR and composite observations are not part of the LwM2M
+ *          version the package implements. A batch is sent as one message
+ *          per observation, which is one message for an observed instance.
+ * @{
+ *
+ * @file
+ * @brief       Wakaama RIOT integration interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef LWM2M_RIOT_H
+#define LWM2M_RIOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "liblwm2m.h"
+#include "net/sock/udp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the blocks of the small pool in bytes
+ *
+ * Must be a multiple of `sizeof(void *)`.
+ */
+#ifndef LWM2M_RIOT_POOL_SMALL_SIZE
+#define LWM2M_RIOT_POOL_SMALL_SIZE      (32U)
+#endif
+
+/**
+ * @brief   Number of blocks of the small pool
+ */
+#ifndef LWM2M_RIOT_POOL_SMALL_NUMOF
+#define LWM2M_RIOT_POOL_SMALL_NUMOF     (32U)
+#endif
+
+/**
+ * @brief   Size of the blocks of the large pool in bytes
+ *
+ * Must be a multiple of `sizeof(void *)`. Should fit a whole CoAP message.
+ */
+#ifndef LWM2M_RIOT_POOL_LARGE_SIZE
+#define LWM2M_RIOT_POOL_LARGE_SIZE      (256U)
+#endif
+
+/**
+ * @brief   Number of blocks of the large pool
+ */
+#ifndef LWM2M_RIOT_POOL_LARGE_NUMOF
+#define LWM2M_RIOT_POOL_LARGE_NUMOF     (4U)
+#endif
+
+/**
+ * @brief   Size of the receive buffer of lwm2m_riot_recv() in bytes
+ */
+#ifndef LWM2M_RIOT_RX_BUFSIZE
+#define LWM2M_RIOT_RX_BUFSIZE           (256U)
+#endif
+
+/**
+ * @brief   Time changes are collected for before they are reported, in
+ *          seconds
+ *
+ * Should match the smallest minimum period (pmin) of the server.
+ */
+#ifndef LWM2M_RIOT_BATCH_WINDOW
+#define LWM2M_RIOT_BATCH_WINDOW         (1U)
+#endif
+
+/**
+ * @brief   Number of changed resources collected at most
+ *
+ * When more resources change in a window, changes are merged to their
+ * object instance, and the batch is reported early as a last resort.
+ */
+#ifndef LWM2M_RIOT_BATCH_NUMOF
+#define LWM2M_RIOT_BATCH_NUMOF          (8U)
+#endif
+
+/**
+ * @brief   Session of a LwM2M server, the session handle given to Wakaama
+ */
+typedef struct {
+    sock_udp_t *sock;               /**< socket to reach the server with */
+    sock_udp_ep_t remote;           /**< the server */
+} lwm2m_riot_session_t;
+
+/**
+ * @brief   Buffer send callback for the Wakaama client
+ *
+ * @param[in] session_h     the session, a lwm2m_riot_session_t
+ * @param[in] buffer        the serialized message
+ * @param[in] length        length of @p buffer in bytes
+ * @param[in] user_data     user data of the client, unused
+ *
+ * @return  COAP_NO_ERROR on success
+ * @return  COAP_500_INTERNAL_SERVER_ERROR, if the message was not sent
+ */
+uint8_t lwm2m_riot_send(void *session_h, uint8_t *buffer, size_t length,
+                        void *user_data);
+
+/**
+ * @brief   Receive a packet and hand it to the client
+ *
+ * Packets of peers not in @p sessions are dropped.
+ *
+ * @param[in] ctx           the client
+ * @param[in] sock          socket to receive from
+ * @param[in] sessions      sessions of the known servers
+ * @param[in] numof         number of entries in @p sessions
+ * @param[in] timeout       receive timeout in microseconds, see
+ *                          sock_udp_recv()
+ *
+ * @return  length of the handled packet
+ * @return  -ENOENT, if the packet came from an unknown peer
+ * @return  the errors of sock_udp_recv()
+ */
+int lwm2m_riot_recv(lwm2m_context_t *ctx, sock_udp_t *sock,
+                    lwm2m_riot_session_t *sessions, unsigned numof,
+                    uint32_t timeout);
+
+/**
+ * @brief   Report a changed resource
+ *
+ * Must be called from the thread running lwm2m_riot_step().
+ *
+ * @param[in] ctx           the client
+ * @param[in] uri           the changed object, instance or resource
+ */
+void lwm2m_riot_changed(lwm2m_context_t *ctx, const lwm2m_uri_t *uri);
+
+/**
+ * @brief   Run the client, replacement for lwm2m_step()
+ *
+ * Reports the collected changes when the window is over.
+ *
+ * @param[in] ctx           the client
+ * @param[in,out] timeout   time until the next call in seconds, lowered to
+ *                          the end of the window while changes are pending
+ *
+ * @return  the result of lwm2m_step()
+ */
+int lwm2m_riot_step(lwm2m_context_t *ctx, time_t *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWM2M_RIOT_H */
+/** @} */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_arena
+ * @{
+ *
+ * @file
+ * @brief       Arena allocator implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "arena.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void arena_init(arena_t *arena, void *buf, size_t size)
+{
+    arena->buf = buf;
+    arena->size = size;
+    arena->pos = 0;
+}
+
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    /* align the address, not the offset, the region may be unaligned */
+    size_t pad = (0 - (uintptr_t)(arena->buf + arena->pos)) & (ARENA_ALIGN - 1);
+
+    if ((pad > arena_available(arena)) ||
+        (size > (arena_available(arena) - pad))) {
+        DEBUG("arena_alloc(): %u bytes do not fit into %p\n", (unsigned)size,
+              (void *)arena);
+        return NULL;
+    }
+    arena->pos += pad;
+    void *res = arena->buf + arena->pos;
+    arena->pos += size;
+    return res;
+}
+
+void *arena_calloc(arena_t *arena, size_t size)
+{
+    void *res = arena_alloc(arena, size);
+
+    if (res) {
+        memset(res, 0, size);
+    }
+    return res;
+}
@@ -17,8 +17,12 @@
  */
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "auto_init.h"
+#include "irq.h"
+#include "mutex.h"
+#include "thread.h"
 
 #ifdef MODULE_SHT11
 #include "sht11.h"
@@ -32,10 +36,38 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_XTIMER_RTT
+#include "xtimer_rtt.h"
+#endif
+
 #ifdef MODULE_RTC
 #include "periph/rtc.h"
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+#include "sched_round_robin.h"
+#endif
+
+#ifdef MODULE_IRQ_HANDLER
+#include "irq_handler.h"
+#endif
+
+#ifdef MODULE_LOG_DEFERRED
+#include "log_module.h"
+#endif
+
+#ifdef MODULE_RANDOM_POOL
+#include "random_pool.h"
+#endif
+
+#ifdef MODULE_BENCHMARK
+#include "benchmark.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
@@ -60,6 +92,10 @@
 #include "net/gnrc/pktdump.h"
 #endif
 
+#ifdef MODULE_GNRC_PCAP
+#include "net/gnrc/pcap.h"
+#endif
+
 #ifdef MODULE_GNRC_UDP
 #include "net/gnrc/udp.h"
 #endif
@@ -91,71 +127,179 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-void auto_init(void)
+/**
+ * @name    Phases a step runs in
+ * @{
+ */
+#define PHASE_BOOT          (0U)
+#define PHASE_DEFERRED      (1U)
+#define PHASE_LAZY          (2U)
+/** @} */
+
+/**
+ * @brief   Expands to 1 if @p macro is defined to 1, to 0 otherwise
+ *
+ * This allows to test the `AUTO_INIT_DEFER_<name>` and `AUTO_INIT_LAZY_<name>`
+ * flags set by the build system inside of a macro.
+ */
+#define _IS_SET(macro)          _IS_SET_(macro)
+#define _IS_SET_(value)         _IS_SET__(_PLACEHOLDER_##value)
+#define _IS_SET__(arg_or_junk)  _SECOND_ARG(arg_or_junk 1, 0)
+#define _SECOND_ARG(ignored, value, ...) value
+#define _PLACEHOLDER_1          0,
+
+/**
+ * @brief   Phase the step @p name was configured to run in
+ */
+#define _PHASE(name) \
+    (_IS_SET(AUTO_INIT_LAZY_##name) ? PHASE_LAZY : \
+     _IS_SET(AUTO_INIT_DEFER_##name) ? PHASE_DEFERRED : PHASE_BOOT)
+
+#ifdef MODULE_AUTO_INIT_PROFILE
+static auto_init_profile_t _profile[AUTO_INIT_PROFILE_NUMOF];
+static unsigned _profile_numof;
+
+static void _profile_add(const char *name, uint32_t start)
+{
+    uint32_t usec = xtimer_now_usec() - start;
+    unsigned state = irq_disable();
+
+    if (_profile_numof < AUTO_INIT_PROFILE_NUMOF) {
+        _profile[_profile_numof].name = name;
+        _profile[_profile_numof].usec = usec;
+        _profile_numof++;
+    }
+    irq_restore(state);
+}
+
+#define _RUN(name, call) do { \
+        uint32_t _start = xtimer_now_usec(); \
+        call; \
+        _profile_add(#name, _start); \
+    } while (0)
+#else
+#define _RUN(name, call)    call
+#endif
+
+/**
+ * @brief   Run @p call, if the step @p name belongs to the current phase
+ *
+ * Lazy steps only run when they are requested by name, and only once.
+ */
+#define AUTO_INIT_STEP(name, call) do { \
+        if (_PHASE(name) != phase) { \
+            break; \
+        } \
+        if (phase == PHASE_LAZY) { \
+            static uint8_t _done; \
+            if (_done || (strcmp(lazy, #name) != 0)) { \
+                break; \
+            } \
+            _done = 1; \
+        } \
+        _RUN(name, call); \
+    } while (0)
+
+static void _auto_init_run(unsigned phase, const char *lazy)
 {
+    (void)phase;
+    (void)lazy;
+
 #ifdef MODULE_TINYMT32
-    random_init(0);
+    AUTO_INIT_STEP(tinymt32, random_init(0));
 #endif
 #ifdef MODULE_XTIMER
     DEBUG("Auto init xtimer module.\n");
-    xtimer_init();
+    AUTO_INIT_STEP(xtimer, xtimer_init());
+#endif
+#ifdef MODULE_XTIMER_RTT
+    DEBUG("Auto init xtimer_rtt module.\n");
+    AUTO_INIT_STEP(xtimer_rtt, xtimer_rtt_init());
+#endif
+#ifdef MODULE_SCHEDSTATISTICS
+    DEBUG("Auto init schedstatistics.\n");
+    AUTO_INIT_STEP(schedstatistics, init_schedstatistics());
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    DEBUG("Auto init sched_round_robin.\n");
+    AUTO_INIT_STEP(sched_round_robin, sched_round_robin_init());
+#endif
+#ifdef MODULE_IRQ_HANDLER
+    DEBUG("Auto init irq_handler.\n");
+    AUTO_INIT_STEP(irq_handler, irq_handler_init());
+#endif
+#ifdef MODULE_LOG_DEFERRED
+    DEBUG("Auto init log_deferred.\n");
+    AUTO_INIT_STEP(log_deferred, log_deferred_init());
+#endif
+#ifdef MODULE_RANDOM_POOL
+    DEBUG("Auto init random_pool.\n");
+    AUTO_INIT_STEP(random_pool, random_pool_init());
+#endif
+#ifdef MODULE_BENCHMARK
+    DEBUG("Auto init benchmark.\n");
+    AUTO_INIT_STEP(benchmark, benchmark_init());
 #endif
 #ifdef MODULE_RTC
     DEBUG("Auto init rtc module.\n");
-    rtc_init();
+    AUTO_INIT_STEP(rtc, rtc_init());
 #endif
 #ifdef MODULE_SHT11
     DEBUG("Auto init SHT11 module.\n");
-    sht11_init();
+    AUTO_INIT_STEP(sht11, sht11_init());
 #endif
 #ifdef MODULE_MCI
     DEBUG("Auto init mci module.\n");
-    mci_initialize();
+    AUTO_INIT_STEP(mci, mci_initialize());
 #endif
 #ifdef MODULE_PROFILING
     extern void profiling_init(void);
-    profiling_init();
+    AUTO_INIT_STEP(profiling, profiling_init());
 #endif
 #ifdef MODULE_GNRC_PKTBUF
     DEBUG("Auto init gnrc_pktbuf module\n");
-    gnrc_pktbuf_init();
+    AUTO_INIT_STEP(gnrc_pktbuf, gnrc_pktbuf_init());
 #endif
 #ifdef MODULE_GNRC_PKTDUMP
     DEBUG("Auto init gnrc_pktdump module.\n");
-    gnrc_pktdump_init();
+    AUTO_INIT_STEP(gnrc_pktdump, gnrc_pktdump_init());
+#endif
+#ifdef MODULE_GNRC_PCAP
+    DEBUG("Auto init gnrc_pcap module.\n");
+    AUTO_INIT_STEP(gnrc_pcap, gnrc_pcap_init());
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN
     DEBUG("Auto init gnrc_sixlowpan module.\n");
-    gnrc_sixlowpan_init();
+    AUTO_INIT_STEP(gnrc_sixlowpan, gnrc_sixlowpan_init());
 #endif
 #ifdef MODULE_GNRC_IPV6
     DEBUG("Auto init gnrc_ipv6 module.\n");
-    gnrc_ipv6_init();
+    AUTO_INIT_STEP(gnrc_ipv6, gnrc_ipv6_init());
 #endif
 #ifdef MODULE_GNRC_UDP
     DEBUG("Auto init UDP module.\n");
-    gnrc_udp_init();
+    AUTO_INIT_STEP(gnrc_udp, gnrc_udp_init());
 #endif
 #ifdef MODULE_GNRC_TCP
     DEBUG("Auto init TCP module\n");
-    gnrc_tcp_init();
+    AUTO_INIT_STEP(gnrc_tcp, gnrc_tcp_init());
 #endif
 #ifdef MODULE_LWIP
     DEBUG("Bootstraping lwIP.\n");
-    lwip_bootstrap();
+    AUTO_INIT_STEP(lwip, lwip_bootstrap());
 #endif
 #ifdef MODULE_OPENTHREAD
     extern void openthread_bootstrap(void);
-    openthread_bootstrap();
+    AUTO_INIT_STEP(openthread, openthread_bootstrap());
 #endif
 #ifdef MODULE_GCOAP
     DEBUG("Auto init gcoap module.\n");
-    gcoap_init();
+    AUTO_INIT_STEP(gcoap, gcoap_init());
 #endif
 #ifdef MODULE_DEVFS
     DEBUG("Mounting /dev\n");
     extern void auto_init_devfs(void);
-    auto_init_devfs();
+    AUTO_INIT_STEP(devfs, auto_init_devfs());
 #endif
 
 /* initialize network devices */
@@ -163,88 +307,93 @@ void auto_init(void)
 
 #ifdef MODULE_AT86RF2XX
     extern void auto_init_at86rf2xx(void);
-    auto_init_at86rf2xx();
+    AUTO_INIT_STEP(at86rf2xx, auto_init_at86rf2xx());
 #endif
 
 #ifdef MODULE_MRF24J40
     extern void auto_init_mrf24j40(void);
-    auto_init_mrf24j40();
+    AUTO_INIT_STEP(mrf24j40, auto_init_mrf24j40());
 #endif
 
 #ifdef MODULE_CC2420
     extern void auto_init_cc2420(void);
-    auto_init_cc2420();
+    AUTO_INIT_STEP(cc2420, auto_init_cc2420());
 #endif
 
 #ifdef MODULE_ENCX24J600
     extern void auto_init_encx24j600(void);
-    auto_init_encx24j600();
+    AUTO_INIT_STEP(encx24j600, auto_init_encx24j600());
 #endif
 
 #ifdef MODULE_ENC28J60
     extern void auto_init_enc28j60(void);
-    auto_init_enc28j60();
+    AUTO_INIT_STEP(enc28j60, auto_init_enc28j60());
 #endif
 
 #ifdef MODULE_ETHOS
     extern void auto_init_ethos(void);
-    auto_init_ethos();
+    AUTO_INIT_STEP(ethos, auto_init_ethos());
 #endif
 
 #ifdef MODULE_GNRC_SLIP
     extern void auto_init_slip(void);
-    auto_init_slip();
+    AUTO_INIT_STEP(gnrc_slip, auto_init_slip());
 #endif
 
 #ifdef MODULE_CC110X
     extern void auto_init_cc110x(void);
-    auto_init_cc110x();
+    AUTO_INIT_STEP(cc110x, auto_init_cc110x());
 #endif
 
 #ifdef MODULE_CC2538_RF
     extern void auto_init_cc2538_rf(void);
-    auto_init_cc2538_rf();
+    AUTO_INIT_STEP(cc2538_rf, auto_init_cc2538_rf());
 #endif
 
 #ifdef MODULE_XBEE
     extern void auto_init_xbee(void);
-    auto_init_xbee();
+    AUTO_INIT_STEP(xbee, auto_init_xbee());
 #endif
 
 #ifdef MODULE_KW2XRF
     extern void auto_init_kw2xrf(void);
-    auto_init_kw2xrf();
+    AUTO_INIT_STEP(kw2xrf, auto_init_kw2xrf());
 #endif
 
 #ifdef MODULE_NETDEV_TAP
     extern void auto_init_netdev_tap(void);
-    auto_init_netdev_tap();
+    AUTO_INIT_STEP(netdev_tap, auto_init_netdev_tap());
+#endif
+
+#ifdef MODULE_NETDEV_MEDIUM
+    extern void auto_init_netdev_medium(void);
+    AUTO_INIT_STEP(netdev_medium, auto_init_netdev_medium());
 #endif
 
 #ifdef MODULE_NORDIC_SOFTDEVICE_BLE
     extern void gnrc_nordic_ble_6lowpan_init(void);
-    gnrc_nordic_ble_6lowpan_init();
+    AUTO_INIT_STEP(nordic_softdevice_ble, gnrc_nordic_ble_6lowpan_init());
 #endif
 
 #ifdef MODULE_NRFMIN
     extern void gnrc_nrfmin_init(void);
-    gnrc_nrfmin_init();
+    AUTO_INIT_STEP(nrfmin, gnrc_nrfmin_init());
 #endif
 
 #ifdef MODULE_W5100
     extern void auto_init_w5100(void);
-    auto_init_w5100();
+    AUTO_INIT_STEP(w5100, auto_init_w5100());
 #endif
 
 #endif /* MODULE_AUTO_INIT_GNRC_NETIF */
 
 #ifdef MODULE_GNRC_IPV6_NETIF
-    gnrc_ipv6_netif_init_by_dev();
+    AUTO_INIT_STEP(gnrc_ipv6_netif, gnrc_ipv6_netif_init_by_dev());
 #endif
 
 #ifdef MODULE_GNRC_UHCPC
     extern void auto_init_gnrc_uhcpc(void);
-    auto_init_gnrc_uhcpc();
+    AUTO_INIT_STEP(gnrc_uhcpc, auto_init_gnrc_uhcpc());
 #endif
 
 /* initialize sensors and actuators */
@@ -253,115 +402,115 @@ void auto_init(void)
 
 #ifdef MODULE_SAUL_GPIO
     extern void auto_init_gpio(void);
-    auto_init_gpio();
+    AUTO_INIT_STEP(saul_gpio, auto_init_gpio());
 #endif
 #ifdef MODULE_SAUL_ADC
     extern void auto_init_adc(void);
-    auto_init_adc();
+    AUTO_INIT_STEP(saul_adc, auto_init_adc());
 #endif
 #ifdef MODULE_LSM303DLHC
     extern void auto_init_lsm303dlhc(void);
-    auto_init_lsm303dlhc();
+    AUTO_INIT_STEP(lsm303dlhc, auto_init_lsm303dlhc());
 #endif
 #ifdef MODULE_LPS331AP
     extern void auto_init_lps331ap(void);
-    auto_init_lps331ap();
+    AUTO_INIT_STEP(lps331ap, auto_init_lps331ap());
 #endif
 #ifdef MODULE_ISL29020
     extern void auto_init_isl29020(void);
-    auto_init_isl29020();
+    AUTO_INIT_STEP(isl29020, auto_init_isl29020());
 #endif
 #ifdef MODULE_L3G4200D
     extern void auto_init_l3g4200d(void);
-    auto_init_l3g4200d();
+    AUTO_INIT_STEP(l3g4200d, auto_init_l3g4200d());
 #endif
 #ifdef MODULE_LIS3DH
     extern void auto_init_lis3dh(void);
-    auto_init_lis3dh();
+    AUTO_INIT_STEP(lis3dh, auto_init_lis3dh());
 #endif
 #ifdef MODULE_MAG3110
     extern void auto_init_mag3110(void);
-    auto_init_mag3110();
+    AUTO_INIT_STEP(mag3110, auto_init_mag3110());
 #endif
 #ifdef MODULE_MMA8X5X
     extern void auto_init_mma8x5x(void);
-    auto_init_mma8x5x();
+    AUTO_INIT_STEP(mma8x5x, auto_init_mma8x5x());
 #endif
 #ifdef MODULE_MPL3115A2
     extern void auto_init_mpl3115a2(void);
-    auto_init_mpl3115a2();
+    AUTO_INIT_STEP(mpl3115a2, auto_init_mpl3115a2());
 #endif
 #ifdef MODULE_SI70XX
     extern void auto_init_si70xx(void);
-    auto_init_si70xx();
+    AUTO_INIT_STEP(si70xx, auto_init_si70xx());
 #endif
 #ifdef MODULE_BMP180
     extern void auto_init_bmp180(void);
-    auto_init_bmp180();
+    AUTO_INIT_STEP(bmp180, auto_init_bmp180());
 #endif
 #if defined(MODULE_BME280) || defined(MODULE_BMP280)
     extern void auto_init_bmx280(void);
-    auto_init_bmx280();
+    AUTO_INIT_STEP(bmx280, auto_init_bmx280());
 #endif
 #ifdef MODULE_JC42
     extern void auto_init_jc42(void);
-    auto_init_jc42();
+    AUTO_INIT_STEP(jc42, auto_init_jc42());
 #endif
 #ifdef MODULE_TSL2561
     extern void auto_init_tsl2561(void);
-    auto_init_tsl2561();
+    AUTO_INIT_STEP(tsl2561, auto_init_tsl2561());
 #endif
 #ifdef MODULE_HDC1000
     extern void auto_init_hdc1000(void);
-    auto_init_hdc1000();
+    AUTO_INIT_STEP(hdc1000, auto_init_hdc1000());
 #endif
 #ifdef MODULE_DHT
     extern void auto_init_dht(void);
-    auto_init_dht();
+    AUTO_INIT_STEP(dht, auto_init_dht());
 #endif
 #ifdef MODULE_TMP006
     extern void auto_init_tmp006(void);
-    auto_init_tmp006();
+    AUTO_INIT_STEP(tmp006, auto_init_tmp006());
 #endif
 #ifdef MODULE_TCS37727
     extern void auto_init_tcs37727(void);
-    auto_init_tcs37727();
+    AUTO_INIT_STEP(tcs37727, auto_init_tcs37727());
 #endif
 #ifdef MODULE_VEML6070
     extern void auto_init_veml6070(void);
-    auto_init_veml6070();
+    AUTO_INIT_STEP(veml6070, auto_init_veml6070());
 #endif
 #ifdef MODULE_IO1_XPLAINED
     extern void auto_init_io1_xplained(void);
-    auto_init_io1_xplained();
+    AUTO_INIT_STEP(io1_xplained, auto_init_io1_xplained());
 #endif
 #ifdef MODULE_ADXL345
     extern void auto_init_adxl345(void);
-    auto_init_adxl345();
+    AUTO_INIT_STEP(adxl345, auto_init_adxl345());
 #endif
 #ifdef MODULE_LSM6DSL
     extern void auto_init_lsm6dsl(void);
-    auto_init_lsm6dsl();
+    AUTO_INIT_STEP(lsm6dsl, auto_init_lsm6dsl());
 #endif
 #ifdef MODULE_ADCXX1C
     extern void auto_init_adcxx1c(void);
-    auto_init_adcxx1c();
+    AUTO_INIT_STEP(adcxx1c, auto_init_adcxx1c());
 #endif
 #ifdef MODULE_PUSH_BUTTON
     extern void auto_init_push_button(void);
-    auto_init_push_button();
+    AUTO_INIT_STEP(push_button, auto_init_push_button());
 #endif
 #ifdef MODULE_FXOS8700
     extern void auto_init_fxos8700(void);
-    auto_init_fxos8700();
+    AUTO_INIT_STEP(fxos8700, auto_init_fxos8700());
 #endif
 #ifdef MODULE_EKMB1101111
     extern void auto_init_ekmb1101111(void);
-    auto_init_ekmb1101111();
+    AUTO_INIT_STEP(ekmb1101111, auto_init_ekmb1101111());
 #endif
 #ifdef MODULE_APDS9007
     extern void auto_init_apds9007(void);
-    auto_init_apds9007();
+    AUTO_INIT_STEP(apds9007, auto_init_apds9007());
 #endif
 
 #endif /* MODULE_AUTO_INIT_SAUL */
@@ -370,7 +519,7 @@ void auto_init(void)
 
 #ifdef MODULE_GNRC_RPL
     extern void auto_init_gnrc_rpl(void);
-    auto_init_gnrc_rpl();
+    AUTO_INIT_STEP(gnrc_rpl, auto_init_gnrc_rpl());
 #endif
 
 #endif /* MODULE_AUTO_INIT_GNRC_RPL */
@@ -381,7 +530,7 @@ void auto_init(void)
 
 #ifdef MODULE_SDCARD_SPI
     extern void auto_init_sdcard_spi(void);
-    auto_init_sdcard_spi();
+    AUTO_INIT_STEP(sdcard_spi, auto_init_sdcard_spi());
 #endif
 
 #endif /* MODULE_AUTO_INIT_STORAGE */
@@ -390,7 +539,62 @@ void auto_init(void)
     DEBUG("auto_init CAN\n");
 
     extern void auto_init_candev(void);
-    auto_init_candev();
+    AUTO_INIT_STEP(can, auto_init_candev());
 
 #endif /* MODULE_AUTO_INIT_CAN */
 }
+
+#ifdef AUTO_INIT_HAS_DEFERRED
+static char _deferred_stack[AUTO_INIT_DEFERRED_STACKSIZE];
+static mutex_t _deferred_lock = MUTEX_INIT_LOCKED;
+
+static void *_deferred_thread(void *arg)
+{
+    (void)arg;
+
+    DEBUG("auto_init: running deferred steps\n");
+    _auto_init_run(PHASE_DEFERRED, NULL);
+    mutex_unlock(&_deferred_lock);
+
+    return NULL;
+}
+#endif
+
+void auto_init(void)
+{
+    _auto_init_run(PHASE_BOOT, NULL);
+
+#ifdef AUTO_INIT_HAS_DEFERRED
+    thread_create(_deferred_stack, sizeof(_deferred_stack),
+                  AUTO_INIT_DEFERRED_PRIO, THREAD_CREATE_STACKTEST,
+                  _deferred_thread, NULL, "auto_init");
+#endif
+}
+
+void auto_init_deferred_wait(void)
+{
+#ifdef AUTO_INIT_HAS_DEFERRED
+    /* pass the lock on, so every waiting thread returns */
+    mutex_lock(&_deferred_lock);
+    mutex_unlock(&_deferred_lock);
+#endif
+}
+
+void auto_init_lazy(const char *name)
+{
+    static mutex_t lock = MUTEX_INIT;
+
+    /* serializes first users of the same step, so they all return after it
+     * is initialized */
+    mutex_lock(&lock);
+    _auto_init_run(PHASE_LAZY, name);
+    mutex_unlock(&lock);
+}
+
+#ifdef MODULE_AUTO_INIT_PROFILE
+const auto_init_profile_t *auto_init_profile(unsigned *numof)
+{
+    *numof = _profile_numof;
+    return _profile;
+}
+#endif
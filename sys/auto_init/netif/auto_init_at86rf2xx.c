@@ -25,6 +25,7 @@
 #include "net/gnrc/netdev/ieee802154.h"
 #include "net/gnrc/lwmac/lwmac.h"
 #include "net/gnrc/lasmac/lasmac.h"
+#include "net/gnrc/tsch.h"
 #include "net/gnrc.h"
 
 #include "at86rf2xx.h"
@@ -73,6 +74,12 @@ void auto_init_at86rf2xx(void)
                              AT86RF2XX_MAC_PRIO,
                              "at86rf2xx-lasmac",
                              &gnrc_adpt[i]);
+#elif defined(MODULE_GNRC_TSCH)
+            gnrc_tsch_init(_at86rf2xx_stacks[i],
+                           AT86RF2XX_MAC_STACKSIZE,
+                           AT86RF2XX_MAC_PRIO,
+                           "at86rf2xx-tsch",
+                           &gnrc_adpt[i]);
 #else
             gnrc_netdev_init(_at86rf2xx_stacks[i],
                              AT86RF2XX_MAC_STACKSIZE,
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for the native medium netdev
+ *
+ * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifdef MODULE_NETDEV_MEDIUM
+
+#include "log.h"
+#include "debug.h"
+#include "netdev_medium_params.h"
+#include "net/gnrc/netdev.h"
+#include "net/gnrc/netdev/ieee802154.h"
+
+#define MEDIUM_MAC_STACKSIZE        (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#define MEDIUM_MAC_PRIO             (THREAD_PRIORITY_MAIN - 3)
+
+static netdev_medium_t netdev_medium;
+static char _netdev_medium_stack[MEDIUM_MAC_STACKSIZE + DEBUG_EXTRA_STACKSIZE];
+static gnrc_netdev_t _gnrc_netdev_medium;
+
+void auto_init_netdev_medium(void)
+{
+    LOG_DEBUG("[auto_init_netif] initializing netdev_medium on %s\n",
+              netdev_medium_params.path);
+
+    netdev_medium_setup(&netdev_medium, &netdev_medium_params);
+    gnrc_netdev_ieee802154_init(&_gnrc_netdev_medium,
+                                (netdev_ieee802154_t *)&netdev_medium);
+
+    gnrc_netdev_init(_netdev_medium_stack, MEDIUM_MAC_STACKSIZE,
+                     MEDIUM_MAC_PRIO, "gnrc_netdev_medium",
+                     &_gnrc_netdev_medium);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NETDEV_MEDIUM */
+/** @} */
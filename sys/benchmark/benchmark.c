@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_benchmark
+ * @{
+ *
+ * @file
+ * @brief       Time sources and output of the benchmark module
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+#include "cpu.h"
+
+void benchmark_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t benchmark_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#elif defined(CPU_NATIVE)
+#include <time.h>
+
+/* from native_internal.h, which clashes with the RIOT libc headers */
+extern int (*real_clock_gettime)(clockid_t clk_id, struct timespec *tp);
+
+void benchmark_init(void)
+{
+    /* nothing to do, the monotonic clock is always running */
+}
+
+uint32_t benchmark_now(void)
+{
+    struct timespec t;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)((uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec);
+}
+
+#elif defined(MODULE_XTIMER)
+#include "xtimer.h"
+
+void benchmark_init(void)
+{
+    /* the timer is already running for xtimer */
+}
+
+uint32_t benchmark_now(void)
+{
+    /* xtimer extends narrow timers to 32 bit for us */
+    return xtimer_now().ticks32;
+}
+
+#else
+#include "periph/timer.h"
+
+void benchmark_init(void)
+{
+    timer_init(BENCHMARK_TIMER, BENCHMARK_TIMER_HZ, NULL, NULL);
+}
+
+uint32_t benchmark_now(void)
+{
+    return timer_read(BENCHMARK_TIMER);
+}
+#endif
+
+void benchmark_print(const char *name, uint32_t total, unsigned long runs)
+{
+    uint64_t per_run = ((uint64_t)total * 100) / runs;
+
+    printf("%s: %lu runs, %lu.%02u %s per run\n", name, runs,
+           (unsigned long)(per_run / 100), (unsigned)(per_run % 100),
+           BENCHMARK_UNIT);
+}
@@ -23,12 +23,70 @@
 
 #define ROUND(size) ((size + CHAR_BIT - 1) / CHAR_BIT)
 
+#define COUNTER_BITS    (CHAR_BIT / BLOOM_COUNTERS_PER_BYTE)
+
+typedef struct {
+    size_t pos;
+    size_t step;
+    size_t i;
+} probe_t;
+
+/* (a + b) % m for a, b < m without overflow or division */
+static inline size_t _add_mod(size_t a, size_t b, size_t m)
+{
+    return (a >= m - b) ? a - (m - b) : a + b;
+}
+
+static inline void _probe_init(probe_t *probe, size_t m, hashfp_t *hash,
+                               const uint8_t *buf, size_t len)
+{
+    probe->pos = hash[0](buf, len) % m;
+    /* a step of 0 would let all probes hit the first position */
+    probe->step = (hash[1](buf, len) % (m - 1)) + 1;
+    probe->i = 0;
+}
+
+/* enhanced double hashing: the position moves by step, the step by i */
+static inline size_t _probe_next(probe_t *probe, size_t m)
+{
+    size_t res = probe->pos;
+
+    probe->pos = _add_mod(probe->pos, probe->step, m);
+    probe->i = _add_mod(probe->i, 1, m);
+    probe->step = _add_mod(probe->step, probe->i, m);
+    return res;
+}
+
+static inline unsigned _counter_get(const uint8_t *c, size_t idx)
+{
+    unsigned shift = (idx % BLOOM_COUNTERS_PER_BYTE) * COUNTER_BITS;
+
+    return (c[idx / BLOOM_COUNTERS_PER_BYTE] >> shift) & BLOOM_COUNTER_MAX;
+}
+
+static inline void _counter_add(uint8_t *c, size_t idx, int diff)
+{
+    unsigned shift = (idx % BLOOM_COUNTERS_PER_BYTE) * COUNTER_BITS;
+
+    c[idx / BLOOM_COUNTERS_PER_BYTE] += (uint8_t)((unsigned)diff << shift);
+}
+
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof)
 {
     bloom->m = size;
     bloom->a = bitfield;
     bloom->hash = hashes;
     bloom->k = hashes_numof;
+    bloom->double_hashing = false;
+}
+
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, size_t k)
+{
+    bloom->m = size;
+    bloom->a = bitfield;
+    bloom->hash = hashes;
+    bloom->k = k;
+    bloom->double_hashing = true;
 }
 
 void bloom_del(bloom_t *bloom)
@@ -40,10 +98,20 @@ void bloom_del(bloom_t *bloom)
     bloom->m = 0;
     bloom->hash = NULL;
     bloom->k = 0;
+    bloom->double_hashing = false;
 }
 
 void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->double_hashing) {
+        probe_t probe;
+
+        _probe_init(&probe, bloom->m, bloom->hash, buf, len);
+        for (size_t n = 0; n < bloom->k; n++) {
+            bf_set(bloom->a, _probe_next(&probe, bloom->m));
+        }
+        return;
+    }
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
         bf_set(bloom->a, (hash % bloom->m));
@@ -52,6 +120,17 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->double_hashing) {
+        probe_t probe;
+
+        _probe_init(&probe, bloom->m, bloom->hash, buf, len);
+        for (size_t n = 0; n < bloom->k; n++) {
+            if (!(bf_isset(bloom->a, _probe_next(&probe, bloom->m)))) {
+                return false;
+            }
+        }
+        return true;
+    }
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
 
@@ -62,3 +141,60 @@ bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 
     return true; /* ? */
 }
+
+void bloom_counting_init(bloom_counting_t *bloom, size_t size, uint8_t *counters,
+                         hashfp_t *hashes, size_t k)
+{
+    bloom->m = size;
+    bloom->c = counters;
+    bloom->hash = hashes;
+    bloom->k = k;
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    probe_t probe;
+
+    _probe_init(&probe, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _probe_next(&probe, bloom->m);
+
+        /* a saturated counter stays, it no longer knows its real value */
+        if (_counter_get(bloom->c, idx) < BLOOM_COUNTER_MAX) {
+            _counter_add(bloom->c, idx, 1);
+        }
+    }
+}
+
+bool bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    probe_t probe;
+
+    if (!bloom_counting_check(bloom, buf, len)) {
+        return false;
+    }
+    _probe_init(&probe, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _probe_next(&probe, bloom->m);
+        unsigned count = _counter_get(bloom->c, idx);
+
+        /* checked above, but two probes of one string may hit one counter */
+        if ((count > 0) && (count < BLOOM_COUNTER_MAX)) {
+            _counter_add(bloom->c, idx, -1);
+        }
+    }
+    return true;
+}
+
+bool bloom_counting_check(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    probe_t probe;
+
+    _probe_init(&probe, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (_counter_get(bloom->c, _probe_next(&probe, bloom->m)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
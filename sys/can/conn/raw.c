@@ -22,6 +22,8 @@
 #include "can/conn/raw.h"
 #include "can/can.h"
 #include "can/raw.h"
+#include "can/pkt.h"
+#include "can/router.h"
 #include "timex.h"
 
 #define ENABLE_DEBUG (0)
@@ -197,12 +199,9 @@ static void _rx_timeout(void *arg)
     mbox_put(&conn->mbox, &msg);
 }
 
-int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t timeout)
+/* wait for the next message of @p conn, 0 if it holds a received frame */
+static int _recv_msg(conn_can_raw_t *conn, msg_t *msg, uint32_t timeout)
 {
-    assert(conn != NULL);
-    assert(conn->ifnum < CAN_DLL_NUMOF);
-    assert(frame != NULL);
-
     xtimer_t timer;
 
     if (timeout != 0) {
@@ -212,23 +211,18 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
     }
 
     int ret;
-    msg_t msg;
-    can_rx_data_t *rx;
 
-    mbox_get(&conn->mbox, &msg);
+    mbox_get(&conn->mbox, msg);
     if (timeout != 0) {
         xtimer_remove(&timer);
     }
-    switch (msg.type) {
+    switch (msg->type) {
     case CAN_MSG_RX_INDICATION:
         DEBUG("conn_can_raw_recv: CAN_MSG_RX_INDICATION\n");
-        rx = msg.content.ptr;
-        memcpy(frame, rx->data.iov_base, rx->data.iov_len);
-        ret = rx->data.iov_len;
-        raw_can_free_frame(rx);
+        ret = 0;
         break;
     case _TIMEOUT_RX_MSG_TYPE:
-        if (msg.content.value == _TIMEOUT_MSG_VALUE) {
+        if (msg->content.value == _TIMEOUT_MSG_VALUE) {
             ret = -ETIMEDOUT;
         }
         else {
@@ -236,7 +230,7 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
         }
         break;
     case _CLOSE_CONN_MSG_TYPE:
-        if (msg.content.ptr == conn) {
+        if (msg->content.ptr == conn) {
             ret = -ECONNABORTED;
         }
         else {
@@ -244,7 +238,7 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
         }
         break;
     default:
-        mbox_put(&conn->mbox, &msg);
+        mbox_put(&conn->mbox, msg);
         ret = -EINTR;
         break;
     }
@@ -252,6 +246,75 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
     return ret;
 }
 
+/* keep the reference to the frame held by @p rx and drop the wrapper */
+static struct can_frame *_take_frame(can_rx_data_t *rx)
+{
+    struct can_frame *frame = rx->data.iov_base;
+
+    can_pkt_free_rx_data(rx);
+
+    return frame;
+}
+
+int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t timeout)
+{
+    assert(conn != NULL);
+    assert(conn->ifnum < CAN_DLL_NUMOF);
+    assert(frame != NULL);
+
+    msg_t msg;
+    can_rx_data_t *rx;
+
+    int ret = _recv_msg(conn, &msg, timeout);
+    if (ret == 0) {
+        rx = msg.content.ptr;
+        memcpy(frame, rx->data.iov_base, rx->data.iov_len);
+        ret = rx->data.iov_len;
+        raw_can_free_frame(rx);
+    }
+
+    return ret;
+}
+
+int conn_can_raw_recv_batch(conn_can_raw_t *conn, struct can_frame **frames,
+                            size_t max, uint32_t timeout)
+{
+    assert(conn != NULL);
+    assert(conn->ifnum < CAN_DLL_NUMOF);
+    assert(frames != NULL && max > 0);
+
+    msg_t msg;
+    size_t count = 0;
+
+    int ret = _recv_msg(conn, &msg, timeout);
+    if (ret < 0) {
+        return ret;
+    }
+    frames[count++] = _take_frame(msg.content.ptr);
+
+    while (count < max && mbox_try_get(&conn->mbox, &msg)) {
+        if (msg.type != CAN_MSG_RX_INDICATION) {
+            /* leave anything else to the next call */
+            mbox_try_put(&conn->mbox, &msg);
+            break;
+        }
+        frames[count++] = _take_frame(msg.content.ptr);
+    }
+
+    DEBUG("conn_can_raw_recv_batch: %u frames\n", (unsigned)count);
+
+    return count;
+}
+
+void conn_can_raw_release(struct can_frame **frames, size_t count)
+{
+    assert(frames != NULL || count == 0);
+
+    for (size_t i = 0; i < count; i++) {
+        can_router_free_frame(frames[i]);
+    }
+}
+
 int conn_can_raw_close(conn_can_raw_t *conn)
 {
     assert(conn != NULL);
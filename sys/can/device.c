@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "thread.h"
 #include "can/device.h"
@@ -37,13 +38,31 @@
 #define CAN_DEVICE_MSG_QUEUE_SIZE 64
 #endif
 
+#ifndef CAN_DEVICE_TX_QUEUE_SIZE
+#define CAN_DEVICE_TX_QUEUE_SIZE 16
+#endif
+
+#ifndef CAN_DEVICE_TX_MAILBOXES
+#define CAN_DEVICE_TX_MAILBOXES 3
+#endif
+
 #ifdef MODULE_CAN_PM
 #define CAN_DEVICE_PM_DEFAULT_RX_TIMEOUT (10 * US_PER_SEC)
 #define CAN_DEVICE_PM_DEFAULT_TX_TIMEOUT (2 * US_PER_SEC)
 #endif
 
+/* frames waiting for a mailbox, in arbitration order, and frames in the
+ * controller's mailboxes */
+static struct {
+    can_pkt_t *queue[CAN_DEVICE_TX_QUEUE_SIZE];
+    can_pkt_t *sent[CAN_DEVICE_TX_MAILBOXES];
+    uint8_t queued;
+    uint8_t busy;
+} _tx[CAN_DLL_NUMOF];
+
 static int power_up(candev_dev_t *candev_dev);
 static int power_down(candev_dev_t *candev_dev);
+static void _tx_run(candev_dev_t *candev_dev);
 #ifdef MODULE_CAN_PM
 static void pm_cb(void *arg);
 static void pm_reset(candev_dev_t *candev_dev, uint32_t value);
@@ -67,6 +86,153 @@ static inline enum can_msg _can_event_error_to_msg(candev_event_t error)
     }
 }
 
+/* position of @p frame in the bus arbitration, the lowest value wins */
+static uint32_t _arbitration_key(const struct can_frame *frame)
+{
+    canid_t id = frame->can_id;
+    uint32_t rtr = (id & CAN_RTR_FLAG) ? 1 : 0;
+
+    if (id & CAN_EFF_FLAG) {
+        id &= CAN_EFF_MASK;
+        /* base ID, SRR, IDE, extended ID, RTR */
+        return ((id >> 18) << 21) | (1UL << 20) | (1UL << 19) |
+               ((id & 0x3FFFF) << 1) | rtr;
+    }
+    /* ID, RTR, dominant IDE */
+    return ((id & CAN_SFF_MASK) << 21) | (rtr << 20);
+}
+
+/* add @p pkt to the waiting frames, behind the ones of the same priority */
+static int _tx_enqueue(int ifnum, can_pkt_t *pkt)
+{
+    uint32_t key = _arbitration_key(&pkt->frame);
+    unsigned i;
+
+    if (_tx[ifnum].queued == CAN_DEVICE_TX_QUEUE_SIZE) {
+        return -EOVERFLOW;
+    }
+    for (i = _tx[ifnum].queued; i > 0; i--) {
+        if (_arbitration_key(&_tx[ifnum].queue[i - 1]->frame) <= key) {
+            break;
+        }
+        _tx[ifnum].queue[i] = _tx[ifnum].queue[i - 1];
+    }
+    _tx[ifnum].queue[i] = pkt;
+    _tx[ifnum].queued++;
+
+    return 0;
+}
+
+/* forget @p pkt wherever it is, 1 if it was in a mailbox */
+static int _tx_remove(int ifnum, can_pkt_t *pkt)
+{
+    for (unsigned i = 0; i < CAN_DEVICE_TX_MAILBOXES; i++) {
+        if (_tx[ifnum].sent[i] == pkt) {
+            _tx[ifnum].sent[i] = NULL;
+            return 1;
+        }
+    }
+    for (unsigned i = 0; i < _tx[ifnum].queued; i++) {
+        if (_tx[ifnum].queue[i] == pkt) {
+            _tx[ifnum].queued--;
+            memmove(&_tx[ifnum].queue[i], &_tx[ifnum].queue[i + 1],
+                    (_tx[ifnum].queued - i) * sizeof(can_pkt_t *));
+            break;
+        }
+    }
+    return 0;
+}
+
+/* the frame in a mailbox losing the arbitration against all others */
+static int _tx_lowest_sent(int ifnum)
+{
+    int lowest = -1;
+
+    for (unsigned i = 0; i < CAN_DEVICE_TX_MAILBOXES; i++) {
+        if (_tx[ifnum].sent[i] && ((lowest < 0) ||
+            (_arbitration_key(&_tx[ifnum].sent[i]->frame) >
+             _arbitration_key(&_tx[ifnum].sent[lowest]->frame)))) {
+            lowest = i;
+        }
+    }
+    return lowest;
+}
+
+static int _tx_free_slot(int ifnum)
+{
+    for (unsigned i = 0; i < CAN_DEVICE_TX_MAILBOXES; i++) {
+        if (!_tx[ifnum].sent[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* take back the frame of mailbox @p slot if @p pkt should be sent before it */
+static int _tx_preempt(candev_dev_t *candev_dev, int slot, can_pkt_t *pkt)
+{
+    candev_t *dev = candev_dev->dev;
+    int ifnum = candev_dev->ifnum;
+    can_pkt_t *victim = _tx[ifnum].sent[slot];
+
+    /* the aborted frame must be able to wait for its turn */
+    if ((_tx[ifnum].queued == CAN_DEVICE_TX_QUEUE_SIZE) ||
+        (_arbitration_key(&victim->frame) <= _arbitration_key(&pkt->frame))) {
+        return 0;
+    }
+    if (dev->driver->abort(dev, &victim->frame) < 0) {
+        return 0;
+    }
+    DEBUG("can device: frame 0x%" PRIx32 " preempted by 0x%" PRIx32 "\n",
+          victim->frame.can_id, pkt->frame.can_id);
+    _tx[ifnum].sent[slot] = NULL;
+    _tx_enqueue(ifnum, victim);
+
+    return 1;
+}
+
+/* move the waiting frames to the mailboxes, highest priority first */
+static void _tx_run(candev_dev_t *candev_dev)
+{
+    candev_t *dev = candev_dev->dev;
+    int ifnum = candev_dev->ifnum;
+
+    /* the driver may confirm a frame from within send() */
+    if (_tx[ifnum].busy) {
+        return;
+    }
+    _tx[ifnum].busy = 1;
+
+    while (_tx[ifnum].queued) {
+        can_pkt_t *pkt = _tx[ifnum].queue[0];
+        int slot = _tx_free_slot(ifnum);
+
+        if (slot >= 0) {
+            _tx_remove(ifnum, pkt);
+            _tx[ifnum].sent[slot] = pkt;
+            if (dev->driver->send(dev, &pkt->frame) >= 0) {
+                continue;
+            }
+            _tx[ifnum].sent[slot] = NULL;
+            if (_tx_lowest_sent(ifnum) < 0) {
+                /* nothing in the controller, this is not a lack of
+                 * mailboxes */
+                DEBUG("can device: send failed\n");
+                can_dll_dispatch_tx_error(pkt);
+                continue;
+            }
+            /* the controller has less mailboxes than tracked */
+            _tx_enqueue(ifnum, pkt);
+        }
+        slot = _tx_lowest_sent(ifnum);
+        if (!_tx_preempt(candev_dev, slot, pkt)) {
+            break;
+        }
+    }
+
+    _tx[ifnum].busy = 0;
+}
+
 static void _can_event(candev_t *dev, candev_event_t event, void *arg)
 {
     msg_t msg;
@@ -81,8 +247,15 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
     switch (event) {
     case CANDEV_EVENT_ISR:
         DEBUG("_can_event: CANDEV_EVENT_ISR\n");
+        /* the driver's isr handles everything pending, one queued event
+         * is enough no matter how many frames arrive meanwhile */
+        if (candev_dev->isr_pending) {
+            break;
+        }
+        candev_dev->isr_pending = 1;
         msg.type = CAN_MSG_EVENT;
         if (msg_send(&msg, candev_dev->pid) <= 0) {
+            candev_dev->isr_pending = 0;
             DEBUG("can device: isr lost\n");
         }
         break;
@@ -97,13 +270,17 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
         DEBUG("_can_event: CANDEV_EVENT_TX_CONFIRMATION\n");
         /* frame pointer in arg */
         pkt = container_of((struct can_frame *)arg, can_pkt_t, frame);
+        _tx_remove(candev_dev->ifnum, pkt);
         can_dll_dispatch_tx_conf(pkt);
+        _tx_run(candev_dev);
         break;
     case CANDEV_EVENT_TX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_TX_ERROR\n");
         /* frame pointer in arg */
         pkt = container_of((struct can_frame *)arg, can_pkt_t, frame);
+        _tx_remove(candev_dev->ifnum, pkt);
         can_dll_dispatch_tx_error(pkt);
+        _tx_run(candev_dev);
         break;
     case CANDEV_EVENT_RX_INDICATION:
         DEBUG("_can_event: CANDEV_EVENT_RX_INDICATION\n");
@@ -210,6 +387,7 @@ static void *_can_device_thread(void *args)
     DEBUG("_cand_device_thread: dev=%p, params=%p\n", (void*)dev, (void*)candev_dev);
 
     candev_dev->pid = thread_getpid();
+    candev_dev->isr_pending = 0;
 
 #ifdef MODULE_CAN_PM
     if (candev_dev->rx_inactivity_timeout == 0) {
@@ -247,12 +425,15 @@ static void *_can_device_thread(void *args)
         switch (msg.type) {
         case CAN_MSG_EVENT:
             DEBUG("can device: CAN_MSG_EVENT received\n");
+            candev_dev->isr_pending = 0;
             dev->driver->isr(dev);
             break;
         case CAN_MSG_ABORT_FRAME:
             DEBUG("can device: CAN_MSG_ABORT_FRAME received\n");
             pkt = (can_pkt_t *) msg.content.ptr;
-            dev->driver->abort(dev, &pkt->frame);
+            if (_tx_remove(candev_dev->ifnum, pkt)) {
+                dev->driver->abort(dev, &pkt->frame);
+            }
             reply.type = CAN_MSG_ACK;
             reply.content.value = 0;
             msg_reply(&msg, &reply);
@@ -267,7 +448,12 @@ static void *_can_device_thread(void *args)
 #ifdef MODULE_CAN_PM
             pm_reset(candev_dev, candev_dev->tx_wakeup_timeout);
 #endif
-            dev->driver->send(dev, &pkt->frame);
+            if (_tx_enqueue(candev_dev->ifnum, pkt) < 0) {
+                DEBUG("can device: tx queue full\n");
+                can_dll_dispatch_tx_error(pkt);
+                break;
+            }
+            _tx_run(candev_dev);
             break;
         case CAN_MSG_SET:
             DEBUG("can device: CAN_MSG_SET received\n");
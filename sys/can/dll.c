@@ -126,7 +126,13 @@ int raw_can_abort(int ifnum, int handle)
         }
     }
 
-    LL_DELETE(tx_list[ifnum], entry);
+    /* the frame may have been confirmed meanwhile */
+    if (entry == NULL) {
+        pkt = NULL;
+    }
+    else {
+        LL_DELETE(tx_list[ifnum], entry);
+    }
     mutex_unlock(&tx_lock);
 
     if (pkt == NULL) {
@@ -386,6 +392,7 @@ int can_dll_dispatch_bus_off(kernel_pid_t pid)
 int can_dll_init(void)
 {
     can_pkt_init();
+    can_router_init();
 
     return 0;
 }
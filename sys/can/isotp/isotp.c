@@ -103,6 +103,7 @@ static mutex_t lock = MUTEX_INIT;
 static void _rx_timeout(void *arg);
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status);
 static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame);
+static void _isotp_send_cf(struct isotp *isotp);
 
 static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 {
@@ -528,11 +529,56 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 
 }
 
-static void _isotp_tx_timeout_task(struct isotp *isotp)
+/* abort all frames of @p isotp still waiting in the DLL */
+static void _isotp_tx_abort(struct isotp *isotp)
+{
+    while (isotp->tx_pending) {
+        raw_can_abort(isotp->entry.ifnum, isotp->tx_handles[--isotp->tx_pending]);
+    }
+}
+
+/* forget the pending frame @p handle, 1 if it was sent by @p isotp */
+static int _isotp_tx_confirmed(struct isotp *isotp, int handle)
+{
+    for (unsigned i = 0; i < isotp->tx_pending; i++) {
+        if (isotp->tx_handles[i] == handle) {
+            isotp->tx_handles[i] = isotp->tx_handles[--isotp->tx_pending];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline int _isotp_block_done(struct isotp *isotp)
+{
+    return isotp->txfc.bs && (isotp->tx.bs >= isotp->txfc.bs);
+}
+
+/* send the next consecutive frames, several at once without separation time */
+static void _isotp_send_cf(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
+    unsigned burst = isotp->tx_gap ? 1 : CAN_ISOTP_TX_PIPELINE;
     struct can_frame frame;
 
+    isotp->tx.state = ISOTP_SENDING_CF;
+    while ((isotp->tx_pending < burst) && (isotp->tx.idx < isotp->tx.snip->size) &&
+           !_isotp_block_done(isotp)) {
+        _isotp_fill_dataframe(isotp, &frame, ae);
+        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
+        isotp->tx.sn %= 16;
+        isotp->tx.bs++;
+
+        _isotp_tx_send(isotp, &frame);
+        if (isotp->tx.state != ISOTP_SENDING_CF) {
+            /* sending failed, the error is already dispatched */
+            break;
+        }
+    }
+}
+
+static void _isotp_tx_timeout_task(struct isotp *isotp)
+{
     DEBUG("_isotp_tx_timeout_task: state=%d\n", isotp->tx.state);
 
     switch (isotp->tx.state) {
@@ -544,13 +590,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
-        _isotp_fill_dataframe(isotp, &frame, ae);
-        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
-        isotp->tx.sn %= 16;
-        isotp->tx.bs++;
-
-        isotp->tx.state = ISOTP_SENDING_CF;
-        _isotp_tx_send(isotp, &frame);
+        _isotp_send_cf(isotp);
         break;
 
     case ISOTP_SENDING_CF:
@@ -558,7 +598,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
     case ISOTP_SENDING_SF:
         DEBUG("_isotp_tx_timeout_task: timeout on DLL\n");
         isotp->tx.state = ISOTP_IDLE;
-        raw_can_abort(isotp->entry.ifnum, isotp->tx.tx_handle);
+        _isotp_tx_abort(isotp);
         _isotp_dispatch_tx(isotp, ETIMEDOUT);
         break;
     }
@@ -567,7 +607,6 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 static void _isotp_tx_tx_conf(struct isotp *isotp)
 {
     xtimer_remove(&isotp->tx_timer);
-    isotp->tx.tx_handle = 0;
 
     DEBUG("_isotp_tx_tx_conf: state=%d\n", isotp->tx.state);
 
@@ -583,17 +622,27 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
         break;
 
     case ISOTP_SENDING_CF:
-        if (isotp->tx.idx >= isotp->tx.snip->size) {
-            /* Finished */
-            isotp->tx.state = ISOTP_IDLE;
-            _isotp_dispatch_tx(isotp, 0);
+        if ((isotp->tx.idx >= isotp->tx.snip->size) || _isotp_block_done(isotp)) {
+            if (isotp->tx_pending) {
+                /* the rest of the burst is still on its way */
+                xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_As);
+            }
+            else if (isotp->tx.idx >= isotp->tx.snip->size) {
+                /* Finished */
+                isotp->tx.state = ISOTP_IDLE;
+                _isotp_dispatch_tx(isotp, 0);
+            }
+            else {
+                /* wait for FC */
+                isotp->tx.state = ISOTP_WAIT_FC;
+                xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_Bs);
+            }
             break;
         }
 
-        if (isotp->txfc.bs && (isotp->tx.bs >= isotp->txfc.bs)) {
-            /* wait for FC */
-            isotp->tx.state = ISOTP_WAIT_FC;
-            xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_Bs);
+        if (!isotp->tx_gap) {
+            /* refill the DLL as soon as a frame left it */
+            _isotp_send_cf(isotp);
             break;
         }
 
@@ -642,8 +691,10 @@ static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame)
     if (isotp->tx.tx_handle < 0) {
         xtimer_remove(&isotp->tx_timer);
         isotp->tx.state = ISOTP_IDLE;
+        _isotp_tx_abort(isotp);
         return _isotp_dispatch_tx(isotp, isotp->tx.tx_handle);
     }
+    isotp->tx_handles[isotp->tx_pending++] = isotp->tx.tx_handle;
 
     return 0;
 }
@@ -704,7 +755,7 @@ static void *_isotp_thread(void *args)
             DEBUG("_isotp_thread: CAN_MSG_TX_CONFIRMATION, handle=%d\n", (int)msg.content.value);
             mutex_lock(&lock);
             LL_FOREACH(isotp_list, isotp) {
-                if (isotp->tx.tx_handle == (int)msg.content.value) {
+                if (_isotp_tx_confirmed(isotp, (int)msg.content.value)) {
                     mutex_unlock(&lock);
                     _isotp_tx_tx_conf(isotp);
                     break;
@@ -814,6 +865,7 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 
     memset(&isotp->rx, 0, sizeof(struct tpcon));
     memset(&isotp->tx, 0, sizeof(struct tpcon));
+    isotp->tx_pending = 0;
 
     isotp->rxfc.bs = CAN_ISOTP_BS;
     isotp->rxfc.stmin = CAN_ISOTP_STMIN;
@@ -853,6 +905,23 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
     return 0;
 }
 
+int isotp_set_rxfc(struct isotp *isotp, const struct isotp_fc_options *fc)
+{
+    assert(isotp != NULL);
+    assert(fc != NULL);
+
+    /* ISO15765-2 8.5.5.5 */
+    if ((fc->stmin > 0x7F) && ((fc->stmin < 0xF1) || (fc->stmin > 0xF9))) {
+        return -EINVAL;
+    }
+
+    DEBUG("isotp_set_rxfc: bs=%" PRIu8 ", stmin=0x%" PRIx8 "\n", fc->bs, fc->stmin);
+
+    isotp->rxfc = *fc;
+
+    return 0;
+}
+
 void isotp_free_rx(can_rx_data_t *rx)
 {
     DEBUG("isotp_free_rx: rx=%p\n", (void *)rx);
@@ -890,6 +959,7 @@ int isotp_release(struct isotp *isotp)
     LL_DELETE(isotp_list, isotp);
     mutex_unlock(&lock);
 
+    _isotp_tx_abort(isotp);
     if (isotp->tx.snip) {
         DEBUG("isotp_release: freeing rx buf\n");
         gnrc_pktbuf_release(isotp->tx.snip);
@@ -23,6 +23,7 @@
 
 #include "net/gnrc/pktbuf.h"
 #include "can/pkt.h"
+#include "memarray.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -33,27 +34,48 @@
 static int handle;
 static mutex_t _mutex = MUTEX_INIT;
 
+/* received packets are taken from this pool first */
+static can_pkt_t _rx_pool[CAN_PKT_RX_POOL_SIZE];
+static memarray_t _rx_mem;
+
 void can_pkt_init(void)
 {
     mutex_lock(&_mutex);
     handle = 1;
+    memarray_init(&_rx_mem, _rx_pool, sizeof(can_pkt_t), CAN_PKT_RX_POOL_SIZE);
     mutex_unlock(&_mutex);
 }
 
-static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame)
+static can_pkt_t *_pool_alloc(void)
 {
     can_pkt_t *pkt;
 
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*pkt), GNRC_NETTYPE_UNDEF);
-    if (!snip) {
-        DEBUG("can_pkt_alloc: out of memory\n");
-        return NULL;
+    mutex_lock(&_mutex);
+    pkt = memarray_alloc(&_rx_mem);
+    mutex_unlock(&_mutex);
+
+    return pkt;
+}
+
+static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame, int pool)
+{
+    can_pkt_t *pkt = pool ? _pool_alloc() : NULL;
+
+    if (pkt) {
+        pkt->snip = NULL;
+    }
+    else {
+        gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*pkt), GNRC_NETTYPE_UNDEF);
+        if (!snip) {
+            DEBUG("can_pkt_alloc: out of memory\n");
+            return NULL;
+        }
+        pkt = snip->data;
+        pkt->snip = snip;
     }
 
-    pkt = snip->data;
     pkt->entry.ifnum = ifnum;
     pkt->frame = *frame;
-    pkt->snip = snip;
 
     DEBUG("can_pkt_alloc: pkt allocated\n");
 
@@ -79,7 +101,7 @@ static void _init_pkt(can_pkt_t *pkt, int tx)
 
 can_pkt_t *can_pkt_alloc_tx(int ifnum, const struct can_frame *frame, kernel_pid_t tx_pid)
 {
-    can_pkt_t *pkt = _pkt_alloc(ifnum, frame);
+    can_pkt_t *pkt = _pkt_alloc(ifnum, frame, 0);
 
     if (!pkt) {
         return NULL;
@@ -96,7 +118,7 @@ can_pkt_t *can_pkt_alloc_tx(int ifnum, const struct can_frame *frame, kernel_pid
 
 can_pkt_t *can_pkt_alloc_rx(int ifnum, const struct can_frame *frame)
 {
-    can_pkt_t *pkt = _pkt_alloc(ifnum, frame);
+    can_pkt_t *pkt = _pkt_alloc(ifnum, frame, 1);
 
     if (!pkt) {
         return NULL;
@@ -110,7 +132,7 @@ can_pkt_t *can_pkt_alloc_rx(int ifnum, const struct can_frame *frame)
 #ifdef MODULE_CAN_MBOX
 can_pkt_t *can_pkt_alloc_mbox_tx(int ifnum, const struct can_frame *frame, mbox_t *tx_mbox)
 {
-    can_pkt_t *pkt = _pkt_alloc(ifnum, frame);
+    can_pkt_t *pkt = _pkt_alloc(ifnum, frame, 0);
 
     if (!pkt) {
         return NULL;
@@ -132,6 +154,13 @@ void can_pkt_free(can_pkt_t *pkt)
 
     DEBUG("can_pkt_free: free pkt=%p\n", (void*)pkt);
 
+    if (!pkt->snip) {
+        mutex_lock(&_mutex);
+        memarray_free(&_rx_mem, pkt);
+        mutex_unlock(&_mutex);
+        return;
+    }
+
     gnrc_pktbuf_release(pkt->snip);
 }
 
@@ -28,6 +28,7 @@
 #include "can/pkt.h"
 #include "can/device.h"
 #include "utlist.h"
+#include "memarray.h"
 #include "mutex.h"
 #include "assert.h"
 
@@ -50,7 +51,8 @@ typedef struct filter_el {
     canid_t can_id;          /**< CAN ID of the element */
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
-    gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip */
+    gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip, NULL if
+                              *   the element is from the pool */
 } filter_el_t;
 
 /**
@@ -58,26 +60,58 @@ typedef struct filter_el {
  */
 static can_reg_entry_t *table[CAN_DLL_NUMOF];
 
+/**
+ * This table contains the exact match filters per interface, hashed by CAN ID
+ */
+static can_reg_entry_t *hash[CAN_DLL_NUMOF][CAN_ROUTER_HASH_SIZE];
+
 
 static mutex_t lock = MUTEX_INIT;
 
+/* filter elements are taken from this pool first */
+static filter_el_t _filter_pool[CAN_ROUTER_FILTER_POOL_SIZE];
+static memarray_t _filter_mem;
+
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data);
 static void _free_filter_el(filter_el_t *el);
 static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
 
+static inline unsigned _hash(canid_t can_id)
+{
+    /* fold the upper bits of extended IDs onto the standard ID */
+    return (can_id ^ (can_id >> 11) ^ (can_id >> 22)) % CAN_ROUTER_HASH_SIZE;
+}
+
+static inline can_reg_entry_t **_list(unsigned int ifnum, canid_t can_id,
+                                      canid_t mask)
+{
+    if (mask == CAN_ROUTER_EXACT_MASK) {
+        return &hash[ifnum][_hash(can_id)];
+    }
+    return &table[ifnum];
+}
+
 #if ENABLE_DEBUG
+static void _print_list(can_reg_entry_t *list)
+{
+    can_reg_entry_t *entry;
+    LL_FOREACH(list, entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
+              el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+    }
+}
+
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        for (unsigned j = 0; j < CAN_ROUTER_HASH_SIZE; j++) {
+            _print_list(hash[i][j]);
         }
+        _print_list(table[i]);
     }
 }
 
@@ -88,19 +122,25 @@ static void _print_filters(void)
 
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
 {
-    filter_el_t *el;
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*el), GNRC_NETTYPE_UNDEF);
-    if (!snip) {
-        DEBUG("can_router: _alloc_canid_el: out of memory\n");
-        return NULL;
+    filter_el_t *el = memarray_alloc(&_filter_mem);
+
+    if (el) {
+        el->snip = NULL;
+    }
+    else {
+        gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*el), GNRC_NETTYPE_UNDEF);
+        if (!snip) {
+            DEBUG("can_router: _alloc_canid_el: out of memory\n");
+            return NULL;
+        }
+        el = snip->data;
+        el->snip = snip;
     }
 
-    el = snip->data;
     el->can_id = can_id;
     el->mask = mask;
     el->data = data;
     el->entry.next = NULL;
-    el->snip = snip;
     DEBUG("_alloc_canid_el: el allocated with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", can_id, mask, data);
     return el;
@@ -111,7 +151,12 @@ static void _free_filter_el(filter_el_t *el)
     DEBUG("_free_canid_el: el freed with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", el->can_id, el->mask, el->data);
 
-    gnrc_pktbuf_release(el->snip);
+    if (el->snip) {
+        gnrc_pktbuf_release(el->snip);
+    }
+    else {
+        memarray_free(&_filter_mem, el);
+    }
 }
 
 /* Insert to the list in a sorted way
@@ -179,7 +224,7 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
 
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = container_of(*_list(ifnum, can_id, mask), filter_el_t, entry);
     if (!el) {
         DEBUG("_filter_is_used: empty list\n");
         return 0;
@@ -198,6 +243,14 @@ static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
     return 0;
 }
 
+void can_router_init(void)
+{
+    mutex_lock(&lock);
+    memarray_init(&_filter_mem, _filter_pool, sizeof(filter_el_t),
+                  CAN_ROUTER_FILTER_POOL_SIZE);
+    mutex_unlock(&lock);
+}
+
 /* register interested users */
 int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *param)
 {
@@ -238,7 +291,7 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+    _insert_to_list(_list(entry->ifnum, can_id, mask), filter);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -251,6 +304,7 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
                           canid_t mask, void *param)
 {
     filter_el_t *el;
+    can_reg_entry_t **list = _list(entry->ifnum, can_id, mask);
     int ret;
 
 #if ENABLE_DEBUG
@@ -264,12 +318,12 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    el = _find_filter_el(*list, entry, can_id, mask, param);
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    LL_DELETE(*list, &el->entry);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -296,27 +350,16 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
-/* send received pkt to all interested users */
-int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+/* send received pkt to the interested users of one list, stops at the first
+ * user that can not take it */
+static int _dispatch_list(can_reg_entry_t *list, can_pkt_t *pkt, int *msg_cnt)
 {
-    if (!pkt) {
-        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
-        return -EINVAL;
-    }
-
-    int res = 0;
     msg_t msg;
-    msg.type = CAN_MSG_RX_INDICATION;
-#if ENABLE_DEBUG
-    int msg_cnt = 0;
-#endif
-    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
-          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
-
-    mutex_lock(&lock);
     can_reg_entry_t *entry;
     filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
+
+    msg.type = CAN_MSG_RX_INDICATION;
+    LL_FOREACH(list, entry) {
         el = container_of(entry, filter_el_t, entry);
         if ((pkt->frame.can_id & el->mask) == el->can_id) {
             DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
@@ -325,23 +368,42 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
                   PRIkernel_pid "\n", entry->target.pid);
             atomic_fetch_add(&pkt->ref_count, 1);
             msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
-#if ENABLE_DEBUG
-            msg_cnt++;
-#endif
+            (*msg_cnt)++;
             if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
                 can_pkt_free_rx_data(msg.content.ptr);
                 atomic_fetch_sub(&pkt->ref_count, 1);
                 DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
                       "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
-                break;
+                return -EBUSY;
             }
         }
     }
+    return 0;
+}
+
+/* send received pkt to all interested users */
+int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+{
+    if (!pkt) {
+        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
+        return -EINVAL;
+    }
+
+    int res;
+    int msg_cnt = 0;
+    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
+          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
+
+    mutex_lock(&lock);
+    /* exact match filters of this ID can only be in its bucket */
+    res = _dispatch_list(hash[pkt->entry.ifnum][_hash(pkt->frame.can_id)],
+                         pkt, &msg_cnt);
+    if (res == 0) {
+        res = _dispatch_list(table[pkt->entry.ifnum], pkt, &msg_cnt);
+    }
     mutex_unlock(&lock);
-#if ENABLE_DEBUG
     DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
-#endif
+    (void)msg_cnt;
     if (atomic_load(&pkt->ref_count) == 0) {
         can_pkt_free(pkt);
     }
@@ -393,9 +455,8 @@ int can_router_free_frame(struct can_frame *frame)
         return -1;
     }
 
-    atomic_fetch_sub(&pkt->ref_count, 1);
-
-    if (atomic_load(&pkt->ref_count) == 0) {
+    /* only the holder of the last reference may free the packet */
+    if (atomic_fetch_sub(&pkt->ref_count, 1) == 1) {
         can_pkt_free(pkt);
     }
     return 0;
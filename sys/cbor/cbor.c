@@ -17,6 +17,7 @@
 
 #include "byteorder.h"
 
+#include <errno.h>
 #include <inttypes.h>
 #include <math.h>
 #include <stdint.h>
@@ -72,7 +73,7 @@
 
 /* Ensure that @p stream is big enough to fit @p bytes bytes, otherwise return 0 */
 #define CBOR_ENSURE_SIZE(stream, bytes) do { \
-    if (stream->pos + bytes >= stream->size) { return 0; } \
+    if (!ensure_size(stream, bytes)) { return 0; } \
 } while(0)
 
 #define CBOR_ENSURE_SIZE_READ(stream, bytes) do { \
@@ -249,6 +250,81 @@ void cbor_init(cbor_stream_t *stream, unsigned char *buffer, size_t size)
     stream->data = buffer;
     stream->size = size;
     stream->pos = 0;
+    stream->flush = NULL;
+    stream->arg = NULL;
+}
+
+void cbor_init_flush(cbor_stream_t *stream, unsigned char *buffer, size_t size,
+                     cbor_flush_t flush, void *arg)
+{
+    if (!stream) {
+        return;
+    }
+
+    cbor_init(stream, buffer, size);
+    stream->flush = flush;
+    stream->arg = arg;
+}
+
+int cbor_flush(cbor_stream_t *stream)
+{
+    if (!stream->flush || (stream->pos == 0)) {
+        return 0;
+    }
+
+    int res = stream->flush(stream->data, stream->pos, stream->arg);
+
+    if (res >= 0) {
+        stream->pos = 0;
+    }
+    return res;
+}
+
+/**
+ * Make room for @p bytes bytes in @p s, flushing it if needed
+ *
+ * @return True if @p bytes bytes fit into @p s
+ */
+static bool ensure_size(cbor_stream_t *s, size_t bytes)
+{
+    if (s->pos + bytes < s->size) {
+        return true;
+    }
+    if ((bytes >= s->size) || (cbor_flush(s) < 0)) {
+        return false;
+    }
+    return (s->pos + bytes < s->size);
+}
+
+void cbor_reader_init(cbor_reader_t *reader, unsigned char *buffer, size_t size,
+                      cbor_read_t read, void *arg)
+{
+    /* the stream only covers the data read so far */
+    cbor_init(&reader->stream, buffer, 0);
+    reader->read = read;
+    reader->arg = arg;
+    reader->capacity = size;
+}
+
+ssize_t cbor_reader_fill(cbor_reader_t *reader, size_t *offset)
+{
+    cbor_stream_t *s = &reader->stream;
+    size_t keep = s->pos - *offset;
+
+    /* drop everything before the incomplete item */
+    memmove(s->data, &s->data[*offset], keep);
+    *offset = 0;
+    s->pos = s->size = keep;
+    if (keep >= reader->capacity) {
+        return -ENOBUFS;
+    }
+
+    ssize_t res = reader->read(&s->data[keep], reader->capacity - keep, reader->arg);
+
+    if (res > 0) {
+        s->pos = s->size = keep + res;
+    }
+    return res;
 }
 
 void cbor_clear(cbor_stream_t *stream)
@@ -372,6 +448,16 @@ static size_t encode_bytes(unsigned char major_type, cbor_stream_t *s, const cha
                            size_t length)
 {
     size_t length_field_size = uint_bytes_follow(uint_additional_info(length)) + 1;
+
+    if (s->flush && ((length_field_size + length) >= s->size)) {
+        /* does not fit into the buffer at all, so pass the string on directly */
+        if (!encode_int(major_type, s, (uint64_t) length) || (cbor_flush(s) < 0) ||
+            (s->flush((const unsigned char *)data, length, s->arg) < 0)) {
+            return 0;
+        }
+        return (length_field_size + length);
+    }
+
     CBOR_ENSURE_SIZE(s, length_field_size + length);
 
     size_t bytes_start = encode_int(major_type, s, (uint64_t) length);
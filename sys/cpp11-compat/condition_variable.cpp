@@ -24,7 +24,6 @@
 #include "irq.h"
 #include "sched.h"
 #include "thread.h"
-#include "timex.h"
 #include "xtimer.h"
 #include "priority_queue.h"
 
@@ -34,6 +33,37 @@ using namespace std::chrono;
 
 namespace riot {
 
+namespace {
+
+// n.data holds the pid of the waiting thread until it is woken up
+constexpr unsigned notified = -1u;
+constexpr unsigned timed_out = -2u;
+
+struct timeout_arg {
+  priority_queue_t* queue;
+  priority_queue_node_t* node;
+};
+
+// dequeues the waiting thread, so a timeout and a notification can not both
+// wake it up
+void timeout_cb(void* arg) {
+  auto ta = static_cast<timeout_arg*>(arg);
+  unsigned old_state = irq_disable();
+  priority_queue_node_t* n = ta->node;
+  if (n->data != notified) {
+    thread_t* other_thread = (thread_t*)sched_threads[n->data];
+    priority_queue_remove(ta->queue, n);
+    n->data = timed_out;
+    if (other_thread && other_thread->status == STATUS_SLEEPING) {
+      sched_set_status(other_thread, STATUS_PENDING);
+      sched_context_switch_request = 1;
+    }
+  }
+  irq_restore(old_state);
+}
+
+} // namespace anonymous
+
 condition_variable::~condition_variable() { m_queue.first = NULL; }
 
 void condition_variable::notify_one() noexcept {
@@ -46,7 +76,7 @@ void condition_variable::notify_one() noexcept {
       other_prio = other_thread->priority;
       sched_set_status(other_thread, STATUS_PENDING);
     }
-    head->data = -1u;
+    head->data = notified;
   }
   irq_restore(old_state);
   if (other_prio >= 0) {
@@ -69,7 +99,7 @@ void condition_variable::notify_all() noexcept {
       other_prio = max_prio(other_prio, other_thread->priority);
       sched_set_status(other_thread, STATUS_PENDING);
     }
-    head->data = -1u;
+    head->data = notified;
   }
   irq_restore(old_state);
   if (other_prio >= 0) {
@@ -78,6 +108,27 @@ void condition_variable::notify_all() noexcept {
 }
 
 void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
+  do_wait(lock, nullptr);
+}
+
+cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
+                                         const time_point& timeout_time) {
+  auto deadline = timeout_time.native_handle();
+  return do_wait(lock, &deadline);
+}
+
+cv_status condition_variable::do_wait(unique_lock<mutex>& lock,
+                                      const xtimer_ticks64_t* deadline)
+  noexcept {
+  xtimer_ticks64_t offset;
+  if (deadline) {
+    // the only clock read of a timed wait
+    xtimer_ticks64_t now = xtimer_now64();
+    if (!xtimer_less64(now, *deadline)) {
+      return cv_status::timeout;
+    }
+    offset = xtimer_diff64(*deadline, now);
+  }
   priority_queue_node_t n;
   n.priority = sched_active_thread->priority;
   n.data = sched_active_pid;
@@ -86,31 +137,32 @@ void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
   unsigned old_state = irq_disable();
   priority_queue_add(&m_queue, &n);
   irq_restore(old_state);
-  mutex_unlock_and_sleep(lock.mutex()->native_handle());
-  if (n.data != -1u) {
-    // on signaling n.data is set to -1u
-    // if it isn't set, then the wakeup is either spurious or a timer wakeup
+  xtimer_t timer;
+  timeout_arg ta{&m_queue, &n};
+  if (deadline) {
+    timer.target = timer.long_target = 0;
+    timer.callback = timeout_cb;
+    timer.arg = &ta;
+    // short timeouts expire right away, from within _xtimer_set64()
+    _xtimer_set64(&timer, offset.ticks64, offset.ticks64 >> 32);
+  }
+  if (n.data == timed_out) {
+    mutex_unlock(lock.mutex()->native_handle());
+  }
+  else {
+    mutex_unlock_and_sleep(lock.mutex()->native_handle());
+  }
+  if (deadline) {
+    xtimer_remove(&timer);
+  }
+  if ((n.data != notified) && (n.data != timed_out)) {
+    // spurious wakeup, the thread is still queued
     old_state = irq_disable();
     priority_queue_remove(&m_queue, &n);
     irq_restore(old_state);
   }
   mutex_lock(lock.mutex()->native_handle());
-}
-
-cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
-                                         const time_point& timeout_time) {
-  xtimer_t timer;
-  // todo: use function to wait for absolute timepoint once available
-  timex_t before;
-  xtimer_now_timex(&before);
-  auto diff = timex_sub(timeout_time.native_handle(), before);
-  xtimer_set_wakeup(&timer, timex_uint64(diff), sched_active_pid);
-  wait(lock);
-  timex_t after;
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto cmp = timex_cmp(after, timeout_time.native_handle());
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  return (n.data == timed_out) ? cv_status::timeout : cv_status::no_timeout;
 }
 
 } // namespace riot
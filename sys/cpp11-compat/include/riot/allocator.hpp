@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Allocators for standard containers that do not use the heap
+ *
+ * riot::pool_allocator takes the nodes of list, set and map containers from a
+ * static @ref sys_memarray "memarray" of N nodes. The pool is created for the
+ * node type the container rebinds the allocator to, so its elements have
+ * exactly the size of a node. Allocating and freeing a node is O(1) and can
+ * not fragment memory. All containers using the same allocator type share its
+ * pool:
+ *
+ * @code
+ * // at most 16 pending requests, in all pending_t lists together
+ * using pending_t = riot::pool_list<request_t, 16>;
+ * @endcode
+ *
+ * riot::arena_allocator takes memory from an @ref sys_arena "arena", which
+ * suits containers of contiguous elements like vector and string that live
+ * as long as the request they are used for. Memory is only released when the
+ * arena is reset, so reserve() the needed capacity up front:
+ *
+ * @code
+ * arena_mark_t mark = arena_mark(&arena);
+ * {
+ *     riot::arena_vector<token_t> tokens{riot::arena_allocator<token_t>(arena)};
+ *     tokens.reserve(num);
+ *     ...
+ * }
+ * arena_reset(&arena, mark);
+ * @endcode
+ *
+ * Both throw std::bad_alloc when out of memory. A pool can be shared between
+ * threads, an arena can not.
+ *
+ * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#ifndef RIOT_ALLOCATOR_HPP
+#define RIOT_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <forward_list>
+#include <functional>
+#include <list>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "irq.h"
+#include "memarray.h"
+
+namespace riot {
+
+/**
+ * @brief Allocator taking single objects from a static pool.
+ * @tparam T    Type of the objects.
+ * @tparam N    Number of objects in the pool.
+ */
+template <class T, size_t N>
+class pool_allocator {
+  static_assert(N > 0, "A pool needs room for at least one object");
+
+public:
+  /**
+   * @brief The type of the allocated objects.
+   */
+  using value_type = T;
+
+  /**
+   * @brief The same allocator for another type, with a pool of its own.
+   */
+  template <class U>
+  struct rebind {
+    /**
+     * @brief The rebound allocator type.
+     */
+    using other = pool_allocator<U, N>;
+  };
+
+  pool_allocator() noexcept = default;
+
+  /**
+   * @brief Converting constructor, used by containers that rebind.
+   */
+  template <class U>
+  pool_allocator(const pool_allocator<U, N>&) noexcept {}
+
+  /**
+   * @brief Allocate an object.
+   * @param[in] n   Number of objects, must be 1.
+   * @throws std::bad_alloc if the pool is exhausted or @p n is not 1.
+   */
+  T* allocate(size_t n) {
+    void* p = nullptr;
+    if (n == 1) {
+      unsigned state = irq_disable();
+      if (s_pool.size == 0) {
+        memarray_init(&s_pool, s_slots, sizeof(slot), N);
+      }
+      p = memarray_alloc(&s_pool);
+      irq_restore(state);
+    }
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  /**
+   * @brief Return an object to the pool.
+   */
+  void deallocate(T* p, size_t) noexcept {
+    unsigned state = irq_disable();
+    memarray_free(&s_pool, p);
+    irq_restore(state);
+  }
+
+  /**
+   * @brief Returns the number of objects that can still be allocated.
+   */
+  static size_t available() noexcept {
+    return (s_pool.size == 0) ? N : memarray_available(&s_pool);
+  }
+
+private:
+  union slot {
+    void* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+  };
+
+  static slot s_slots[N];
+  static memarray_t s_pool;
+};
+
+/** @cond INTERNAL */
+template <class T, size_t N>
+typename pool_allocator<T, N>::slot pool_allocator<T, N>::s_slots[N];
+
+template <class T, size_t N>
+memarray_t pool_allocator<T, N>::s_pool;
+/** @endcond */
+
+/**
+ * @brief Memory allocated by one pool allocator can be freed by any other of
+ *        the same type.
+ */
+template <class T, class U, size_t N>
+inline bool operator==(const pool_allocator<T, N>&,
+                       const pool_allocator<U, N>&) noexcept {
+  return std::is_same<T, U>::value;
+}
+
+/**
+ * @brief Compares two pool allocators.
+ */
+template <class T, class U, size_t N>
+inline bool operator!=(const pool_allocator<T, N>& lhs,
+                       const pool_allocator<U, N>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+/**
+ * @brief Allocator taking memory from an arena.
+ *
+ * Deallocating does nothing, the memory is released by arena_reset().
+ *
+ * @tparam T    Type of the objects.
+ */
+template <class T>
+class arena_allocator {
+  static_assert(alignof(T) <= ARENA_ALIGN,
+                "The arena does not align memory for this type");
+
+public:
+  /**
+   * @brief The type of the allocated objects.
+   */
+  using value_type = T;
+
+  /**
+   * @brief Create an allocator for an arena.
+   * @param[in] arena   Arena to allocate from, must outlive the allocator.
+   */
+  explicit arena_allocator(arena_t& arena) noexcept : m_arena(&arena) {}
+
+  /**
+   * @brief Converting constructor, used by containers that rebind.
+   */
+  template <class U>
+  arena_allocator(const arena_allocator<U>& other) noexcept
+      : m_arena(other.arena()) {}
+
+  /**
+   * @brief Allocate @p n objects.
+   * @throws std::bad_alloc if the arena is exhausted.
+   */
+  T* allocate(size_t n) {
+    void* p = nullptr;
+    if (n <= SIZE_MAX / sizeof(T)) {
+      p = arena_alloc(m_arena, n * sizeof(T));
+    }
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  /**
+   * @brief Does nothing, the memory stays in use until the arena is reset.
+   */
+  void deallocate(T*, size_t) noexcept {}
+
+  /**
+   * @brief Returns the arena of the allocator.
+   */
+  arena_t* arena() const noexcept { return m_arena; }
+
+private:
+  arena_t* m_arena;
+};
+
+/**
+ * @brief Arena allocators are equal if they use the same arena.
+ */
+template <class T, class U>
+inline bool operator==(const arena_allocator<T>& lhs,
+                       const arena_allocator<U>& rhs) noexcept {
+  return lhs.arena() == rhs.arena();
+}
+
+/**
+ * @brief Compares two arena allocators.
+ */
+template <class T, class U>
+inline bool operator!=(const arena_allocator<T>& lhs,
+                       const arena_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+/**
+ * @brief std::list with at most @p N elements from a pool.
+ */
+template <class T, size_t N>
+using pool_list = std::list<T, pool_allocator<T, N>>;
+
+/**
+ * @brief std::forward_list with at most @p N elements from a pool.
+ */
+template <class T, size_t N>
+using pool_forward_list = std::forward_list<T, pool_allocator<T, N>>;
+
+/**
+ * @brief std::set with at most @p N elements from a pool.
+ */
+template <class Key, size_t N, class Compare = std::less<Key>>
+using pool_set = std::set<Key, Compare, pool_allocator<Key, N>>;
+
+/**
+ * @brief std::map with at most @p N elements from a pool.
+ */
+template <class Key, class T, size_t N, class Compare = std::less<Key>>
+using pool_map = std::map<Key, T, Compare,
+                          pool_allocator<std::pair<const Key, T>, N>>;
+
+/**
+ * @brief std::vector taking its storage from an arena.
+ */
+template <class T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+/**
+ * @brief std::string taking its storage from an arena.
+ */
+using arena_string = std::basic_string<char, std::char_traits<char>,
+                                       arena_allocator<char>>;
+
+} // namespace riot
+
+#endif // RIOT_ALLOCATOR_HPP
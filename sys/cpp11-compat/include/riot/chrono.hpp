@@ -12,7 +12,7 @@
  *
  * @file
  * @brief  C++11 chrono drop in replacement that adds the function now based on
- *         xtimer/timex
+ *         xtimer
  * @see    <a href="http://en.cppreference.com/w/cpp/thread/thread">
  *           std::thread, defined in header thread
  *         </a>
@@ -28,31 +28,36 @@
 #include <chrono>
 #include <algorithm>
 
-#include "time.h"
+#include "timex.h"
 #include "xtimer.h"
 
 namespace riot {
 
-namespace {
-constexpr uint32_t microsecs_in_sec = 1000000;
-} // namespace anaonymous
-
 /**
  * @brief A time point for timed wait, as clocks from the standard are not
  *        available on RIOT.
+ *
+ * The time point is kept in xtimer ticks, so taking the current time,
+ * comparing time points and arming a timer for one need no conversion.
+ * Only adding a duration converts it, at compile time for most periods.
  */
 class time_point {
-  using native_handle_type = timex_t;
+  using native_handle_type = xtimer_ticks64_t;
 
  public:
   /**
-   * @brief Creates a time point with seconds and microseconds set to 0.
+   * @brief Creates a time point at tick 0.
+   */
+  inline time_point() : m_handle{0} {}
+  /**
+   * @brief Create time point from xtimer ticks.
    */
-  inline time_point() : m_handle{0, 0} {}
+  explicit inline time_point(xtimer_ticks64_t ticks) : m_handle(ticks) {}
   /**
    * @brief Create time point from timex_t struct.
    */
-  explicit inline time_point(timex_t&& tp) : m_handle(tp) {}
+  explicit inline time_point(timex_t&& tp)
+      : m_handle(xtimer_ticks_from_usec64(timex_uint64(tp))) {}
   /**
    * @brief Use default copy constructor.
    */
@@ -61,6 +66,10 @@ class time_point {
    * @brief Use default move constructor.
    */
   constexpr time_point(time_point&& tp) = default;
+  /**
+   * @brief Use default copy assignment.
+   */
+  time_point& operator=(const time_point& tp) = default;
 
   /**
    * @brief Gives access to the native handle that stores the time information.
@@ -72,31 +81,32 @@ class time_point {
    */
   template <class Rep, class Period>
   inline time_point& operator+=(const std::chrono::duration<Rep, Period>& d) {
-    auto s = std::chrono::duration_cast<std::chrono::seconds>(d);
-    auto m = (std::chrono::duration_cast<std::chrono::microseconds>(d) - s);
-    m_handle.seconds += s.count();
-    m_handle.microseconds += m.count();
-    adjust_overhead();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    if (us < 0) {
+      m_handle.ticks64 -= xtimer_ticks_from_usec64(-us).ticks64;
+    }
+    else {
+      m_handle.ticks64 += xtimer_ticks_from_usec64(us).ticks64;
+    }
     return *this;
   }
 
   /**
-   * @brief Returns seconds member as uint32_t.
+   * @brief Returns the seconds part of the time point.
    */
-  inline uint32_t seconds() const { return m_handle.seconds; }
+  inline uint32_t seconds() const {
+    return xtimer_usec_from_ticks64(m_handle) / US_PER_SEC;
+  }
 
   /**
-   * @brief Returns microseconds member as uint32_t.
+   * @brief Returns the microseconds part of the time point.
    */
-  inline uint32_t microseconds() const { return m_handle.microseconds; }
+  inline uint32_t microseconds() const {
+    return xtimer_usec_from_ticks64(m_handle) % US_PER_SEC;
+  }
 
  private:
-  timex_t m_handle;
-  void inline adjust_overhead() {
-    auto secs = m_handle.microseconds / microsecs_in_sec;
-    m_handle.seconds += secs;
-    m_handle.microseconds -= (secs * microsecs_in_sec);
-  }
+  xtimer_ticks64_t m_handle;
 };
 
 /**
@@ -105,18 +115,23 @@ class time_point {
  * @return time_point containing the current time.
  */
 inline time_point now() {
-  timex_t tp;
-  xtimer_now_timex(&tp);
-  return time_point(std::move(tp));
+  return time_point(xtimer_now64());
+}
+
+/**
+ * @brief Returns a time point @p d after @p tp.
+ */
+template <class Rep, class Period>
+inline time_point operator+(time_point tp,
+                            const std::chrono::duration<Rep, Period>& d) {
+  return tp += d;
 }
 
 /**
  * @brief Compares two timepoints.
  */
 inline bool operator<(const time_point& lhs, const time_point& rhs) {
-  return lhs.seconds() < rhs.seconds()
-         || (lhs.seconds() == rhs.seconds() && lhs.microseconds()
-                                               < rhs.microseconds());
+  return xtimer_less64(lhs.native_handle(), rhs.native_handle());
 }
 
 /**
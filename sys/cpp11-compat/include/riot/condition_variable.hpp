@@ -140,6 +140,9 @@ private:
   condition_variable(const condition_variable&);
   condition_variable& operator=(const condition_variable&);
 
+  cv_status do_wait(unique_lock<mutex>& lock,
+                    const xtimer_ticks64_t* deadline) noexcept;
+
   priority_queue_t m_queue;
 };
 
@@ -166,25 +169,10 @@ template <class Rep, class Period>
 cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
                                        const std::chrono::duration
                                        <Rep, Period>& timeout_duration) {
-  using namespace std::chrono;
-  using std::chrono::duration;
   if (timeout_duration <= timeout_duration.zero()) {
     return cv_status::timeout;
   }
-  timex_t timeout, before, after;
-  auto s = duration_cast<seconds>(timeout_duration);
-  timeout.seconds = s.count();
-  timeout.microseconds
-    = (duration_cast<microseconds>(timeout_duration - s)).count();
-  xtimer_now_timex(&before);
-  xtimer_t timer;
-  xtimer_set_wakeup(&timer, timex_uint64(timeout), sched_active_pid);
-  wait(lock);
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto passed = timex_sub(after, before);
-  auto cmp = timex_cmp(passed, timeout);
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  return wait_until(lock, riot::now() + timeout_duration);
 }
 
 template <class Rep, class Period, class Predicate>
@@ -192,7 +180,7 @@ inline bool condition_variable::wait_for(unique_lock<mutex>& lock,
                                          const std::chrono::duration
                                          <Rep, Period>& timeout_duration,
                                          Predicate pred) {
-  return wait_until(lock, std::chrono::steady_clock::now() + timeout_duration,
+  return wait_until(lock, riot::now() + timeout_duration,
                     std::move(pred));
 }
 
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Thread pool with preallocated workers
+ *
+ * A pool owns a fixed number of worker threads, whose stacks are part of the
+ * pool object, and a bounded queue of tasks. A task combines the work to do
+ * with the storage of its result, similar to a packaged task and its future.
+ * It is owned by the caller, so neither submitting nor completing work uses
+ * the heap:
+ *
+ * @code
+ * static riot::thread_pool<2> pool;
+ *
+ * auto lo = riot::make_task([&] { return filter(samples, 0, n / 2); });
+ * auto hi = riot::make_task([&] { return filter(samples, n / 2, n); });
+ * pool.submit(lo);
+ * pool.submit(hi);
+ * int energy = lo.get() + hi.get();
+ * @endcode
+ *
+ * A task must not be moved or destroyed between being submitted and having
+ * completed. The pool can not be destroyed, as its workers never stop, so it
+ * is best declared `static`. Exceptions thrown by a task terminate the
+ * program.
+ *
+ * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include <array>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "irq.h"
+#include "mutex.h"
+#include "sema.h"
+#include "thread.h"
+
+namespace riot {
+
+template <size_t Workers, size_t QueueSize, size_t StackSize>
+class thread_pool;
+
+/**
+ * @brief Type independent part of a task, as queued by a pool.
+ */
+class task_base {
+  template <size_t Workers, size_t QueueSize, size_t StackSize>
+  friend class thread_pool;
+
+public:
+  task_base() noexcept {
+    // held until the task has completed (MUTEX_INIT_LOCKED is not valid C++)
+    mutex_lock(&m_done);
+  }
+  virtual ~task_base() = default;
+
+  task_base(const task_base&) = delete;
+  task_base& operator=(const task_base&) = delete;
+
+  /**
+   * @brief Block until the task has completed.
+   */
+  void wait() noexcept {
+    mutex_lock(&m_done);
+    mutex_unlock(&m_done);
+  }
+
+  /**
+   * @brief Query if the task has completed.
+   * @return `true` if the result is available, `false` otherwise.
+   */
+  bool ready() noexcept {
+    if (mutex_trylock(&m_done)) {
+      mutex_unlock(&m_done);
+      return true;
+    }
+    return false;
+  }
+
+protected:
+  /**
+   * @brief Do the work of the task, called by a worker.
+   */
+  virtual void run() = 0;
+
+private:
+  mutex_t m_done = MUTEX_INIT;
+};
+
+namespace detail {
+
+/**
+ * @brief Storage for the result of a task, constructed by the worker.
+ */
+template <class R>
+class task_result {
+public:
+  task_result() noexcept : m_valid{false} {}
+  ~task_result() {
+    if (m_valid) {
+      reinterpret_cast<R*>(&m_storage)->~R();
+    }
+  }
+
+  template <class F>
+  void set(F& f) {
+    new (&m_storage) R(f());
+    m_valid = true;
+  }
+
+  R get() {
+    return std::move(*reinterpret_cast<R*>(&m_storage));
+  }
+
+private:
+  typename std::aligned_storage<sizeof(R), alignof(R)>::type m_storage;
+  bool m_valid;
+};
+
+/** @cond INTERNAL */
+template <>
+class task_result<void> {
+public:
+  template <class F>
+  void set(F& f) {
+    f();
+  }
+
+  void get() noexcept {}
+};
+/** @endcond */
+
+} // namespace detail
+
+/**
+ * @brief A unit of work and its result.
+ * @see   riot::make_task
+ */
+template <class F>
+class task : public task_base {
+public:
+  /**
+   * @brief The type returned by the work.
+   */
+  using result_type = typename std::result_of<F()>::type;
+
+  /**
+   * @brief Create a task from a functor.
+   */
+  explicit task(F f) : m_f(std::move(f)) {}
+
+  /**
+   * @brief Move constructor, only valid before the task was submitted.
+   */
+  task(task&& other) : task_base(), m_f(std::move(other.m_f)) {}
+
+  /**
+   * @brief Block until the task has completed and return its result.
+   *
+   * The result is moved out, so this can be called only once.
+   */
+  result_type get() {
+    wait();
+    return m_result.get();
+  }
+
+protected:
+  void run() override {
+    m_result.set(m_f);
+  }
+
+private:
+  F m_f;
+  detail::task_result<result_type> m_result;
+};
+
+/**
+ * @brief Create a task from a functor.
+ * @param[in] f     Functor to run, without arguments.
+ * @return  The task, to be passed to thread_pool::submit().
+ */
+template <class F>
+task<typename std::decay<F>::type> make_task(F&& f) {
+  return task<typename std::decay<F>::type>(std::forward<F>(f));
+}
+
+/**
+ * @brief Pool of preallocated worker threads.
+ * @tparam Workers      Number of worker threads.
+ * @tparam QueueSize    Maximum number of tasks waiting for a worker.
+ * @tparam StackSize    Stack size of each worker.
+ */
+template <size_t Workers, size_t QueueSize = 8,
+          size_t StackSize = THREAD_STACKSIZE_MAIN>
+class thread_pool {
+  static_assert(Workers > 0, "A pool needs at least one worker");
+  static_assert(QueueSize > 0, "A pool needs room for at least one task");
+
+public:
+  /**
+   * @brief Start the workers.
+   * @param[in] priority    Priority of the workers.
+   */
+  explicit thread_pool(uint8_t priority = THREAD_PRIORITY_MAIN - 1)
+      : m_head{0}, m_count{0} {
+    sema_create(&m_tasks, 0);
+    for (auto& stack : m_stacks) {
+      thread_create(stack.data(), StackSize, priority,
+                    THREAD_CREATE_STACKTEST, &worker, this, "riot_cpp_pool");
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * @brief Queue a task, the next idle worker runs it.
+   * @param[in] t   Task to run.
+   * @return `true` if the task was queued, `false` if the queue is full.
+   */
+  bool submit(task_base& t) noexcept {
+    unsigned state = irq_disable();
+    if (m_count == QueueSize) {
+      irq_restore(state);
+      return false;
+    }
+    m_queue[(m_head + m_count) % QueueSize] = &t;
+    ++m_count;
+    irq_restore(state);
+    sema_post(&m_tasks);
+    return true;
+  }
+
+  /**
+   * @brief Returns the number of workers.
+   */
+  static constexpr size_t size() noexcept { return Workers; }
+
+private:
+  task_base* pop() noexcept {
+    unsigned state = irq_disable();
+    task_base* t = m_queue[m_head];
+    m_head = (m_head + 1) % QueueSize;
+    --m_count;
+    irq_restore(state);
+    return t;
+  }
+
+  static void* worker(void* arg) {
+    auto pool = static_cast<thread_pool*>(arg);
+    while (true) {
+      if (sema_wait(&pool->m_tasks) < 0) {
+        continue;
+      }
+      task_base* t = pool->pop();
+      t->run();
+      mutex_unlock(&t->m_done);
+    }
+    return nullptr;
+  }
+
+  std::array<std::array<char, StackSize>, Workers> m_stacks;
+  std::array<task_base*, QueueSize> m_queue;
+  size_t m_head;
+  size_t m_count;
+  sema_t m_tasks;
+};
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
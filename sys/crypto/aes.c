@@ -37,6 +37,10 @@
 #include "crypto/aes.h"
 #include "crypto/ciphers.h"
 
+#ifdef MODULE_CRYPTO_AES_HW
+/* the hardware backend uses the functions below as fallback */
+const cipher_id_t CIPHER_AES_128 = &aes_hw_interface;
+#else
 /**
  * Interface to the aes cipher
  */
@@ -45,9 +49,11 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    NULL
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
+#endif
 
 static const u32 Te0[256] = {
     0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
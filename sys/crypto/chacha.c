@@ -25,9 +25,9 @@
  * Please notice:
  *  - This implementation of the ChaCha stream cipher is very stripped down.
  *  - It assumes a little-endian system.
- *  - It is implemented for little code and data size, but will likely be
- *    slower than the refenrence implementation. Optimized implementation will
- *    out-perform the code even more.
+ *  - The double rounds are unrolled, the keystream is XORed word by word
+ *    into aligned buffers. It is still kept small, vectorized
+ *    implementations will out-perform it.
  */
 
 #include "crypto/chacha.h"
@@ -39,38 +39,47 @@
 
 #include <string.h>
 
-static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
-{
-    *a += *b;
-    uint32_t tmp = *a ^ *d;
-    *d = (tmp << c) | (tmp >> (32 - c));
-}
+#define ROTL(x, c)  (((x) << (c)) | ((x) >> (32 - (c))))
 
-static void _doubleround(void *output_, const uint32_t input[16], uint8_t rounds)
+#define QUARTERROUND(a, b, c, d)                \
+    do {                                        \
+        a += b; d = ROTL(d ^ a, 16);            \
+        c += d; b = ROTL(b ^ c, 12);            \
+        a += b; d = ROTL(d ^ a, 8);             \
+        c += d; b = ROTL(b ^ c, 7);             \
+    } while (0)
+
+/* generates the next block of the keystream and advances the block counter */
+static void _block(chacha_ctx *ctx, uint32_t output[16])
 {
-    uint32_t *output = (uint32_t *) output_;
-    memcpy(output, input, 64);
-
-    rounds *= 4;
-    for (unsigned i = 0; i < rounds; ++i) {
-        /* cppcheck-suppress duplicateExpressionTernary
-         * (reason: Externally imported code beautification) */
-        uint32_t *a = &output[((i + ((i & 4) ? 0 : 0)) & 3) + (4 * 0)];
-        uint32_t *b = &output[((i + ((i & 4) ? 1 : 0)) & 3) + (4 * 1)];
-        uint32_t *c = &output[((i + ((i & 4) ? 2 : 0)) & 3) + (4 * 2)];
-        uint32_t *d = &output[((i + ((i & 4) ? 3 : 0)) & 3) + (4 * 3)];
-
-        _r(d, a, b, 16);
-        _r(b, c, d, 12);
-        _r(d, a, b,  8);
-        _r(b, c, d,  7);
+    uint32_t x[16];
+
+    memcpy(x, ctx->state, 64);
+    for (unsigned i = 0; i < ctx->rounds; i += 2) {
+        QUARTERROUND(x[0], x[4], x[ 8], x[12]);
+        QUARTERROUND(x[1], x[5], x[ 9], x[13]);
+        QUARTERROUND(x[2], x[6], x[10], x[14]);
+        QUARTERROUND(x[3], x[7], x[11], x[15]);
+        QUARTERROUND(x[0], x[5], x[10], x[15]);
+        QUARTERROUND(x[1], x[6], x[11], x[12]);
+        QUARTERROUND(x[2], x[7], x[ 8], x[13]);
+        QUARTERROUND(x[3], x[4], x[ 9], x[14]);
     }
-
     for (unsigned i = 0; i < 16; ++i) {
-        output[i] += input[i];
+        output[i] = x[i] + ctx->state[i];
+    }
+
+    ++ctx->state[12];
+    if (ctx->state[12] == 0) {
+        ++ctx->state[13];
     }
 }
 
+static inline int _aligned(const void *p)
+{
+    return ((uintptr_t)p % sizeof(uint32_t)) == 0;
+}
+
 int chacha_init(chacha_ctx *ctx,
                 unsigned rounds,
                 const uint8_t *key, uint32_t keylen,
@@ -102,21 +111,50 @@ int chacha_init(chacha_ctx *ctx,
     return 0;
 }
 
-void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t numof)
 {
-    _doubleround(x, ctx->state, ctx->rounds);
-
-    ++ctx->state[12];
-    if (ctx->state[12] == 0) {
-        ++ctx->state[13];
+    uint8_t *out = x;
+
+    for (; numof > 0; numof--, out += 64) {
+        if (_aligned(out)) {
+            _block(ctx, (uint32_t *)out);
+        }
+        else {
+            uint32_t block[16];
+
+            _block(ctx, block);
+            memcpy(out, block, 64);
+        }
     }
 }
 
-void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
+void chacha_encrypt(chacha_ctx *ctx, const void *m, void *c, size_t len)
 {
-    uint8_t x[64];
-    chacha_keystream_bytes(ctx, x);
-    for (unsigned i = 0 ; i < 64; ++i) {
-        c[i] = m[i] ^ x[i];
+    const uint8_t *in = m;
+    uint8_t *out = c;
+    uint32_t block[16];
+
+    while (len > 0) {
+        size_t n = (len < 64) ? len : 64;
+
+        _block(ctx, block);
+        if ((n == 64) && _aligned(in) && _aligned(out)) {
+            const uint32_t *in_w = (const uint32_t *)in;
+            uint32_t *out_w = (uint32_t *)out;
+
+            for (unsigned i = 0; i < 16; ++i) {
+                out_w[i] = in_w[i] ^ block[i];
+            }
+        }
+        else {
+            const uint8_t *k = (const uint8_t *)block;
+
+            for (unsigned i = 0; i < n; ++i) {
+                out[i] = in[i] ^ k[i];
+            }
+        }
+        in += n;
+        out += n;
+        len -= n;
     }
 }
@@ -35,10 +35,18 @@ static chacha_ctx _chacha_prng_ctx = {
     .state = { RIOT_CHACHA_PRNG_DEFAULT },
     .rounds = 8,
 };
-static uint32_t _chacha_prng_data[64];
+/* numbers are taken from the end, _chacha_prng_pos is the number left */
+static uint32_t _chacha_prng_data[CHACHA_PRNG_BLOCKS * 16];
 static signed _chacha_prng_pos = 0;
 static mutex_t _chacha_prng_mutex = MUTEX_INIT;
 
+static void _refill(void)
+{
+    chacha_keystream_blocks(&_chacha_prng_ctx, _chacha_prng_data,
+                            CHACHA_PRNG_BLOCKS);
+    _chacha_prng_pos = CHACHA_PRNG_BLOCKS * 16;
+}
+
 void chacha_prng_seed(const void *data, size_t bytes)
 {
     mutex_lock(&_chacha_prng_mutex);
@@ -49,16 +57,57 @@ void chacha_prng_seed(const void *data, size_t bytes)
     mutex_unlock(&_chacha_prng_mutex);
 }
 
+void chacha_prng_reseed(const void *data, size_t bytes)
+{
+    const uint8_t *in = data;
+    uint8_t *key = (uint8_t *)&_chacha_prng_ctx.state[4];
+
+    mutex_lock(&_chacha_prng_mutex);
+
+    for (size_t i = 0; i < bytes; i++) {
+        key[i] ^= in[i];
+    }
+    memset(_chacha_prng_data, 0, sizeof(_chacha_prng_data));
+    _chacha_prng_pos = 0;
+
+    mutex_unlock(&_chacha_prng_mutex);
+}
+
 uint32_t chacha_prng_next(void)
 {
     mutex_lock(&_chacha_prng_mutex);
 
-    if (--_chacha_prng_pos < 0) {
-        _chacha_prng_pos = 15;
-        chacha_keystream_bytes(&_chacha_prng_ctx, _chacha_prng_data);
+    if (_chacha_prng_pos == 0) {
+        _refill();
     }
-    uint32_t result = _chacha_prng_data[_chacha_prng_pos];
+    uint32_t result = _chacha_prng_data[--_chacha_prng_pos];
 
     mutex_unlock(&_chacha_prng_mutex);
     return result;
 }
+
+void chacha_prng_bytes(void *buf, size_t len)
+{
+    uint8_t *out = buf;
+
+    mutex_lock(&_chacha_prng_mutex);
+
+    while (len > 0) {
+        if (_chacha_prng_pos == 0) {
+            _refill();
+        }
+        size_t n = _chacha_prng_pos * sizeof(uint32_t);
+        n = (len < n) ? len : n;
+
+        /* the numbers in the order chacha_prng_next() returns them */
+        for (size_t i = 0; i < n; i += sizeof(uint32_t)) {
+            uint32_t num = _chacha_prng_data[--_chacha_prng_pos];
+
+            memcpy(&out[i], &num, ((n - i) < sizeof(num)) ? (n - i) : sizeof(num));
+        }
+        out += n;
+        len -= n;
+    }
+
+    mutex_unlock(&_chacha_prng_mutex);
+}
@@ -48,3 +48,15 @@ int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
 }
+
+
+int cipher_process(const cipher_t* cipher, cipher_mode_t mode, int encrypt,
+                   uint8_t* iv, uint8_t nonce_len, const uint8_t* input,
+                   size_t length, uint8_t* output)
+{
+    if (cipher->interface->process == NULL) {
+        return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    return cipher->interface->process(&cipher->context, mode, encrypt, iv,
+                                      nonce_len, input, length, output);
+}
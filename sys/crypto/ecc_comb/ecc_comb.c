@@ -0,0 +1,558 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto_ecc_comb
+ * @{
+ *
+ * @file
+ * @brief       Fixed point ECC with comb tables
+ *
+ * A scalar k is split into ECC_COMB_TEETH rows of d bits, column i of the
+ * rows is the index into the table of the sum of 2^(j * d) * P, so k * P is
+ * computed from the top column down with one doubling and one addition
+ * (of an affine point to a Jacobian one) per column.
+ *
+ * For private scalars every column adds a point, which is only kept for
+ * columns that are not zero, and the table is read completely. To never add
+ * to the point at infinity the sum starts at P instead, which is 2^d * P
+ * (the second point of the table) too much in the end.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/ecc_comb.h"
+
+#if ECC_COMB_TEETH < 2
+#error "ECC_COMB_TEETH must be at least 2"
+#endif
+
+#define W               (ECC_COMB_WORDS)
+/* scalars, with room for the columns above the bits of the order */
+#define SCALAR_WORDS    (ECC_COMB_WORDS + 1)
+#define WORD_BITS       (sizeof(uECC_word_t) * 8)
+#define SIGN_TRIES      (64U)
+
+typedef struct {
+    uECC_word_t x[W];
+    uECC_word_t y[W];
+    uECC_word_t z[W];   /* 0 for the point at infinity */
+} _jacobian_t;
+
+static inline void _mul(uECC_word_t *res, const uECC_word_t *a,
+                        const uECC_word_t *b, uECC_Curve curve)
+{
+    uECC_vli_modMult_fast(res, a, b, curve);
+}
+
+static inline unsigned _cols(uECC_Curve curve)
+{
+    return (uECC_curve_num_n_bits(curve) + ECC_COMB_TEETH - 1) /
+           ECC_COMB_TEETH;
+}
+
+static inline int _a_is_zero(uECC_Curve curve)
+{
+#if uECC_SUPPORTS_secp256k1
+    return curve == uECC_secp256k1();
+#else
+    (void)curve;
+    return 0;
+#endif
+}
+
+static void _double(_jacobian_t *q, uECC_Curve curve)
+{
+    const uECC_word_t *p = uECC_curve_p(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t delta[W], gamma[W], beta[W], alpha[W], t[W];
+
+    if (uECC_vli_isZero(q->z, nw)) {
+        return;
+    }
+    if (uECC_vli_isZero(q->y, nw)) {
+        uECC_vli_clear(q->z, nw);
+        return;
+    }
+    _mul(delta, q->z, q->z, curve);
+    _mul(gamma, q->y, q->y, curve);
+    _mul(beta, q->x, gamma, curve);
+    if (_a_is_zero(curve)) {
+        _mul(alpha, q->x, q->x, curve);
+    }
+    else {
+        /* 3 * (x - z^2) * (x + z^2) = 3 * x^2 + a * z^4 for a = -3 */
+        uECC_vli_modSub(t, q->x, delta, p, nw);
+        uECC_vli_modAdd(alpha, q->x, delta, p, nw);
+        _mul(alpha, alpha, t, curve);
+    }
+    uECC_vli_modAdd(t, alpha, alpha, p, nw);
+    uECC_vli_modAdd(alpha, alpha, t, p, nw);
+    /* z' = (y + z)^2 - y^2 - z^2 = 2 * y * z */
+    uECC_vli_modAdd(t, q->y, q->z, p, nw);
+    _mul(q->z, t, t, curve);
+    uECC_vli_modSub(q->z, q->z, gamma, p, nw);
+    uECC_vli_modSub(q->z, q->z, delta, p, nw);
+    /* x' = alpha^2 - 8 * beta */
+    uECC_vli_modAdd(beta, beta, beta, p, nw);
+    uECC_vli_modAdd(beta, beta, beta, p, nw);
+    _mul(q->x, alpha, alpha, curve);
+    uECC_vli_modSub(q->x, q->x, beta, p, nw);
+    uECC_vli_modSub(q->x, q->x, beta, p, nw);
+    /* y' = alpha * (4 * beta - x') - 8 * gamma^2 */
+    uECC_vli_modSub(t, beta, q->x, p, nw);
+    _mul(t, alpha, t, curve);
+    _mul(gamma, gamma, gamma, curve);
+    uECC_vli_modAdd(gamma, gamma, gamma, p, nw);
+    uECC_vli_modAdd(gamma, gamma, gamma, p, nw);
+    uECC_vli_modAdd(gamma, gamma, gamma, p, nw);
+    uECC_vli_modSub(q->y, t, gamma, p, nw);
+}
+
+/* q += (a[0..W-1], a[W..2W-1]) */
+static void _add_affine(_jacobian_t *q, const uECC_word_t *a, uECC_Curve curve)
+{
+    const uECC_word_t *p = uECC_curve_p(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t zz[W], u[W], s[W], h[W], r[W], hh[W];
+
+    if (uECC_vli_isZero(q->z, nw)) {
+        uECC_vli_set(q->x, a, nw);
+        uECC_vli_set(q->y, a + W, nw);
+        uECC_vli_clear(q->z, nw);
+        q->z[0] = 1;
+        return;
+    }
+    _mul(zz, q->z, q->z, curve);
+    _mul(u, a, zz, curve);
+    _mul(s, a + W, zz, curve);
+    _mul(s, s, q->z, curve);
+    uECC_vli_modSub(h, u, q->x, p, nw);
+    uECC_vli_modSub(r, s, q->y, p, nw);
+    if (uECC_vli_isZero(h, nw)) {
+        if (uECC_vli_isZero(r, nw)) {
+            _double(q, curve);
+        }
+        else {
+            uECC_vli_clear(q->z, nw);
+        }
+        return;
+    }
+    _mul(q->z, q->z, h, curve);
+    /* u = x * h^2, hh = h^3 */
+    _mul(hh, h, h, curve);
+    _mul(u, q->x, hh, curve);
+    _mul(hh, hh, h, curve);
+    /* x' = r^2 - h^3 - 2 * u */
+    _mul(q->x, r, r, curve);
+    uECC_vli_modSub(q->x, q->x, hh, p, nw);
+    uECC_vli_modSub(q->x, q->x, u, p, nw);
+    uECC_vli_modSub(q->x, q->x, u, p, nw);
+    /* y' = r * (u - x') - y * h^3 */
+    uECC_vli_modSub(u, u, q->x, p, nw);
+    _mul(u, r, u, curve);
+    _mul(hh, q->y, hh, curve);
+    uECC_vli_modSub(q->y, u, hh, p, nw);
+}
+
+static int _to_affine(uECC_word_t *a, const _jacobian_t *q, uECC_Curve curve)
+{
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t zi[W], t[W];
+
+    if (uECC_vli_isZero(q->z, nw)) {
+        return 0;
+    }
+    uECC_vli_modInv(zi, q->z, uECC_curve_p(curve), nw);
+    _mul(t, zi, zi, curve);
+    _mul(a, q->x, t, curve);
+    _mul(t, t, zi, curve);
+    _mul(a + W, q->y, t, curve);
+    return 1;
+}
+
+static void _load(_jacobian_t *q, const uECC_word_t *a, uECC_Curve curve)
+{
+    memset(q, 0, sizeof(*q));
+    _add_affine(q, a, curve);
+}
+
+static inline unsigned _digit(const uECC_word_t *k, unsigned col, unsigned d)
+{
+    unsigned digit = 0;
+
+    for (unsigned j = 0; j < ECC_COMB_TEETH; j++) {
+        unsigned bit = col + (j * d);
+
+        digit |= ((k[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1) << j;
+    }
+    return digit;
+}
+
+/* reads the whole table, digit 0 selects the first point */
+static void _select(uECC_word_t *a, const ecc_comb_t *comb, unsigned digit)
+{
+    unsigned target = digit + (digit == 0);
+
+    for (unsigned i = 0; i < ECC_COMB_POINTS; i++) {
+        uECC_word_t mask = (uECC_word_t)0 - (uECC_word_t)(i + 1 == target);
+
+        for (unsigned j = 0; j < 2 * W; j++) {
+            a[j] = (a[j] & ~mask) | (comb->points[i][j] & mask);
+        }
+    }
+}
+
+static void _cmov(_jacobian_t *q, const _jacobian_t *t, unsigned cond)
+{
+    uECC_word_t mask = (uECC_word_t)0 - (uECC_word_t)(cond != 0);
+    uECC_word_t *dst = (uECC_word_t *)q;
+    const uECC_word_t *src = (const uECC_word_t *)t;
+
+    for (unsigned i = 0; i < (sizeof(*q) / sizeof(uECC_word_t)); i++) {
+        dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+    }
+}
+
+/* a = k * P for a private k */
+static int _mult_private(uECC_word_t *a, const ecc_comb_t *comb,
+                         const uECC_word_t *k)
+{
+    uECC_Curve curve = comb->curve;
+    wordcount_t nw = uECC_curve_num_words(curve);
+    unsigned d = _cols(curve);
+    _jacobian_t q, t;
+
+    _load(&q, comb->points[0], curve);
+    for (unsigned col = d; col-- > 0;) {
+        unsigned digit = _digit(k, col, d);
+
+        _double(&q, curve);
+        _select(a, comb, digit);
+        t = q;
+        _add_affine(&t, a, curve);
+        _cmov(&q, &t, digit);
+    }
+    /* subtract the 2^d * P the sum started with */
+    memcpy(a, comb->points[1], sizeof(comb->points[1]));
+    uECC_vli_sub(a + W, uECC_curve_p(curve), a + W, nw);
+    _add_affine(&q, a, curve);
+    return _to_affine(a, &q, curve);
+}
+
+static int _load_private(uECC_word_t *d, const uint8_t *private_key,
+                         uECC_Curve curve)
+{
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nnw = uECC_curve_num_n_words(curve);
+
+    memset(d, 0, SCALAR_WORDS * sizeof(uECC_word_t));
+    uECC_vli_bytesToNative(d, private_key, uECC_curve_private_key_size(curve));
+    return !uECC_vli_isZero(d, nnw) && (uECC_vli_cmp(n, d, nnw) == 1);
+}
+
+/* the hash as an integer modulo n, like bits2int() of micro-ecc */
+static void _bits2int(uECC_word_t *e, const uint8_t *hash, unsigned hash_size,
+                      uECC_Curve curve)
+{
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nnw = uECC_curve_num_n_words(curve);
+    unsigned nbits = uECC_curve_num_n_bits(curve);
+    unsigned nbytes = (nbits + 7) / 8;
+
+    if (hash_size > nbytes) {
+        hash_size = nbytes;
+    }
+    memset(e, 0, SCALAR_WORDS * sizeof(uECC_word_t));
+    uECC_vli_bytesToNative(e, hash, hash_size);
+    if ((hash_size * 8) > nbits) {
+        unsigned shift = (hash_size * 8) - nbits;
+
+        for (wordcount_t i = 0; i < nnw; i++) {
+            e[i] = (e[i] >> shift) | (e[i + 1] << (WORD_BITS - shift));
+        }
+    }
+    if (uECC_vli_cmp(n, e, nnw) != 1) {
+        uECC_vli_sub(e, e, n, nnw);
+    }
+}
+
+int ecc_comb_init(ecc_comb_t *comb, const uint8_t *public_key,
+                  uECC_Curve curve)
+{
+    wordcount_t nw = uECC_curve_num_words(curve);
+    unsigned nbytes = uECC_curve_num_bytes(curve);
+    unsigned d = _cols(curve);
+    uECC_word_t *first = comb->points[0];
+    _jacobian_t q;
+
+    memset(comb, 0, sizeof(*comb));
+    comb->curve = curve;
+    if (public_key == NULL) {
+        const uECC_word_t *g = uECC_curve_G(curve);
+
+        uECC_vli_set(first, g, nw);
+        uECC_vli_set(first + W, g + nw, nw);
+    }
+    else {
+        if (!uECC_valid_public_key(public_key, curve)) {
+            return 0;
+        }
+        uECC_vli_bytesToNative(first, public_key, nbytes);
+        uECC_vli_bytesToNative(first + W, public_key + nbytes, nbytes);
+    }
+    /* the powers of two: 2^(j * d) * P */
+    for (unsigned j = 1; j < ECC_COMB_TEETH; j++) {
+        _load(&q, comb->points[(1U << (j - 1)) - 1], curve);
+        for (unsigned i = 0; i < d; i++) {
+            _double(&q, curve);
+        }
+        if (!_to_affine(comb->points[(1U << j) - 1], &q, curve)) {
+            return 0;
+        }
+    }
+    /* the sums of them, from their lowest power and the rest */
+    for (unsigned i = 3; i <= ECC_COMB_POINTS; i++) {
+        unsigned low = i & (~i + 1);
+
+        if (low == i) {
+            continue;
+        }
+        _load(&q, comb->points[low - 1], curve);
+        _add_affine(&q, comb->points[(i ^ low) - 1], curve);
+        if (!_to_affine(comb->points[i - 1], &q, curve)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int ecc_comb_compute_public_key(const ecc_comb_t *g, const uint8_t *private_key,
+                                uint8_t *public_key)
+{
+    unsigned nbytes = uECC_curve_num_bytes(g->curve);
+    uECC_word_t d[SCALAR_WORDS], a[2 * W];
+
+    if (!_load_private(d, private_key, g->curve) ||
+        !_mult_private(a, g, d)) {
+        return 0;
+    }
+    uECC_vli_nativeToBytes(public_key, nbytes, a);
+    uECC_vli_nativeToBytes(public_key + nbytes, nbytes, a + W);
+    return 1;
+}
+
+int ecc_comb_shared_secret(const ecc_comb_t *key, const uint8_t *private_key,
+                           uint8_t *secret)
+{
+    uECC_word_t d[SCALAR_WORDS], a[2 * W];
+
+    if (!_load_private(d, private_key, key->curve) ||
+        !_mult_private(a, key, d)) {
+        return 0;
+    }
+    uECC_vli_nativeToBytes(secret, uECC_curve_num_bytes(key->curve), a);
+    return 1;
+}
+
+int ecc_comb_sign(const ecc_comb_t *g, const uint8_t *private_key,
+                  const uint8_t *hash, unsigned hash_size, uint8_t *signature)
+{
+    uECC_Curve curve = g->curve;
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    wordcount_t nnw = uECC_curve_num_n_words(curve);
+    unsigned nbytes = uECC_curve_num_bytes(curve);
+    uECC_word_t d[SCALAR_WORDS], k[SCALAR_WORDS], b[SCALAR_WORDS];
+    uECC_word_t r[SCALAR_WORDS], s[SCALAR_WORDS], e[SCALAR_WORDS];
+    uECC_word_t a[2 * W];
+
+    if (!_load_private(d, private_key, curve)) {
+        return 0;
+    }
+    _bits2int(e, hash, hash_size, curve);
+    for (unsigned tries = 0; tries < SIGN_TRIES; tries++) {
+        memset(k, 0, sizeof(k));
+        if (!uECC_generate_random_int(k, n, nnw)) {
+            return 0;
+        }
+        if (!_mult_private(a, g, k)) {
+            continue;
+        }
+        /* r = x mod n */
+        memset(r, 0, sizeof(r));
+        uECC_vli_set(r, a, nw);
+        if (uECC_vli_cmp(n, r, nnw) != 1) {
+            uECC_vli_sub(r, r, n, nnw);
+        }
+        if (uECC_vli_isZero(r, nnw)) {
+            continue;
+        }
+        /* k^-1 = b * (b * k)^-1, a random b hides k from the inversion */
+        if (!uECC_generate_random_int(b, n, nnw)) {
+            return 0;
+        }
+        uECC_vli_modMult(k, k, b, n, nnw);
+        uECC_vli_modInv(k, k, n, nnw);
+        uECC_vli_modMult(k, k, b, n, nnw);
+        /* s = k^-1 * (e + r * d) */
+        uECC_vli_modMult(s, r, d, n, nnw);
+        uECC_vli_modAdd(s, s, e, n, nnw);
+        uECC_vli_modMult(s, s, k, n, nnw);
+        if (uECC_vli_isZero(s, nnw) ||
+            (uECC_vli_numBits(s, nnw) > (bitcount_t)(nbytes * 8))) {
+            continue;
+        }
+        uECC_vli_nativeToBytes(signature, nbytes, r);
+        uECC_vli_nativeToBytes(signature + nbytes, nbytes, s);
+        return 1;
+    }
+    return 0;
+}
+
+/* r, s and e of a signature with r and s in [1, n - 1] */
+static int _parse(const ecc_comb_t *g, const ecc_comb_sig_t *sig,
+                  uECC_word_t *r, uECC_word_t *s, uECC_word_t *e)
+{
+    uECC_Curve curve = g->curve;
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nnw = uECC_curve_num_n_words(curve);
+    unsigned nbytes = uECC_curve_num_bytes(curve);
+
+    if (sig->key->curve != curve) {
+        return 0;
+    }
+    memset(r, 0, SCALAR_WORDS * sizeof(uECC_word_t));
+    memset(s, 0, SCALAR_WORDS * sizeof(uECC_word_t));
+    uECC_vli_bytesToNative(r, sig->signature, nbytes);
+    uECC_vli_bytesToNative(s, sig->signature + nbytes, nbytes);
+    if (uECC_vli_isZero(r, nnw) || uECC_vli_isZero(s, nnw) ||
+        (uECC_vli_cmp(n, r, nnw) != 1) || (uECC_vli_cmp(n, s, nnw) != 1)) {
+        return 0;
+    }
+    _bits2int(e, sig->hash, sig->hash_size, curve);
+    return 1;
+}
+
+/* checks x(u1 * G + u2 * Q) mod n == r for u1 = e * w, u2 = r * w */
+static int _check(const ecc_comb_t *g, const ecc_comb_t *key,
+                  const uECC_word_t *r, const uECC_word_t *w,
+                  const uECC_word_t *e)
+{
+    uECC_Curve curve = g->curve;
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    wordcount_t nnw = uECC_curve_num_n_words(curve);
+    wordcount_t max = (nnw > nw) ? nnw : nw;
+    unsigned d = _cols(curve);
+    uECC_word_t u1[SCALAR_WORDS], u2[SCALAR_WORDS];
+    uECC_word_t p[SCALAR_WORDS], t[SCALAR_WORDS], zz[W];
+    _jacobian_t q;
+
+    memset(u1, 0, sizeof(u1));
+    memset(u2, 0, sizeof(u2));
+    uECC_vli_modMult(u1, e, w, n, nnw);
+    uECC_vli_modMult(u2, r, w, n, nnw);
+    memset(&q, 0, sizeof(q));
+    for (unsigned col = d; col-- > 0;) {
+        unsigned dg = _digit(u1, col, d);
+        unsigned dq = _digit(u2, col, d);
+
+        _double(&q, curve);
+        if (dg) {
+            _add_affine(&q, g->points[dg - 1], curve);
+        }
+        if (dq) {
+            _add_affine(&q, key->points[dq - 1], curve);
+        }
+    }
+    if (uECC_vli_isZero(q.z, nw)) {
+        return 0;
+    }
+    /* x < p, so x mod n = r only if x = r or x = r + n, which is compared
+     * as r * z^2 = X without converting to affine coordinates */
+    memset(p, 0, sizeof(p));
+    uECC_vli_set(p, uECC_curve_p(curve), nw);
+    if (uECC_vli_cmp(p, r, max) != 1) {
+        return 0;
+    }
+    _mul(zz, q.z, q.z, curve);
+    _mul(t, r, zz, curve);
+    if (uECC_vli_cmp(t, q.x, nw) == 0) {
+        return 1;
+    }
+    memset(t, 0, sizeof(t));
+    if (!uECC_vli_add(t, r, n, nnw) && (uECC_vli_cmp(p, t, max) == 1)) {
+        _mul(t, t, zz, curve);
+        return uECC_vli_cmp(t, q.x, nw) == 0;
+    }
+    return 0;
+}
+
+int ecc_comb_verify(const ecc_comb_t *g, const ecc_comb_t *key,
+                    const uint8_t *hash, unsigned hash_size,
+                    const uint8_t *signature)
+{
+    const ecc_comb_sig_t sig = {
+        .key = key,
+        .hash = hash,
+        .hash_size = hash_size,
+        .signature = signature,
+    };
+
+    return ecc_comb_verify_batch(g, &sig, 1);
+}
+
+int ecc_comb_verify_batch(const ecc_comb_t *g, const ecc_comb_sig_t *sigs,
+                          unsigned numof)
+{
+    const uECC_word_t *n = uECC_curve_n(g->curve);
+    wordcount_t nnw = uECC_curve_num_n_words(g->curve);
+    uECC_word_t r[ECC_COMB_BATCH_MAX][SCALAR_WORDS];
+    uECC_word_t s[ECC_COMB_BATCH_MAX][SCALAR_WORDS];
+    uECC_word_t e[ECC_COMB_BATCH_MAX][SCALAR_WORDS];
+    uECC_word_t acc[ECC_COMB_BATCH_MAX][SCALAR_WORDS];
+    uECC_word_t inv[SCALAR_WORDS];
+
+    while (numof > 0) {
+        unsigned num = (numof > ECC_COMB_BATCH_MAX) ? ECC_COMB_BATCH_MAX : numof;
+
+        for (unsigned i = 0; i < num; i++) {
+            if (!_parse(g, &sigs[i], r[i], s[i], e[i])) {
+                return 0;
+            }
+        }
+        /* invert all s at once: acc[i] = s[0] * ... * s[i] */
+        memset(acc, 0, sizeof(acc));
+        memset(inv, 0, sizeof(inv));
+        uECC_vli_set(acc[0], s[0], nnw);
+        for (unsigned i = 1; i < num; i++) {
+            uECC_vli_modMult(acc[i], acc[i - 1], s[i], n, nnw);
+        }
+        uECC_vli_modInv(inv, acc[num - 1], n, nnw);
+        for (unsigned i = num - 1; i > 0; i--) {
+            /* s[i]^-1 = acc[i - 1] * acc[i]^-1, acc[i - 1]^-1 = s[i] * acc[i]^-1 */
+            uECC_vli_modMult(acc[i], acc[i - 1], inv, n, nnw);
+            uECC_vli_modMult(inv, inv, s[i], n, nnw);
+        }
+        uECC_vli_set(acc[0], inv, nnw);
+        for (unsigned i = 0; i < num; i++) {
+            if (!_check(g, sigs[i].key, r[i], acc[i], e[i])) {
+                return 0;
+            }
+        }
+        sigs += num;
+        numof -= num;
+    }
+    return 1;
+}
@@ -34,6 +34,12 @@ int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    int res = cipher_process(cipher, CIPHER_MODE_CBC, 1, iv, 0, input, length,
+                             output);
+    if (res != CIPHER_ERR_NOT_SUPPORTED) {
+        return res;
+    }
+
     output_block_last = iv;
     do {
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
@@ -67,6 +73,12 @@ int cipher_decrypt_cbc(cipher_t* cipher, uint8_t iv[16],
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    int res = cipher_process(cipher, CIPHER_MODE_CBC, 0, iv, 0, input, length,
+                             output);
+    if (res != CIPHER_ERR_NOT_SUPPORTED) {
+        return res;
+    }
+
     input_block_last = iv;
     do {
         input_block = input + offset;
@@ -13,6 +13,10 @@
  * @file
  * @brief       Crypto mode - counter with CBC-MAC
  *
+ * The CBC-MAC and the counter mode are computed in one pass over the data,
+ * unless the cipher can run the counter mode on the whole message at once,
+ * e.g. a hardware backend.
+ *
  * @author      Nico von Geyso <nico.geyso@fu-berlin.de>
  *
  * @}
@@ -24,7 +28,11 @@
 #include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
 
-static inline int min(int a, int b)
+#define CCM_BLOCK_SIZE      (16U)
+/* longest additional data encoded with two octets */
+#define CCM_ADATA_LEN_MAX   (0xfeffU)
+
+static inline size_t min(size_t a, size_t b)
 {
     if (a < b) {
         return a;
@@ -34,224 +42,302 @@ static inline int min(int a, int b)
     }
 }
 
-int ccm_compute_cbc_mac(cipher_t* cipher, uint8_t iv[16],
-                        uint8_t* input, size_t length, uint8_t* mac)
+/* adds data to the CBC-MAC in X, pos is the offset in the current block */
+static int _cbc_mac_update(cipher_t* cipher, uint8_t X[16], uint8_t* pos,
+                           const uint8_t* data, size_t length)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
-
-    block_size = cipher_get_block_size(cipher);
-    memmove(mac, iv, 16);
-    offset = 0;
-    do {
-        uint8_t block_size_input = (length - offset > block_size) ?
-                                   block_size : length - offset;
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
+    while (length > 0) {
+        size_t n = min(CCM_BLOCK_SIZE - *pos, length);
+
+        for (size_t i = 0; i < n; ++i) {
+            X[*pos + i] ^= data[i];
+        }
+        *pos += n;
+        data += n;
+        length -= n;
+        if (*pos == CCM_BLOCK_SIZE) {
+            if (cipher_encrypt(cipher, X, X) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            *pos = 0;
         }
+    }
+    return 0;
+}
 
-        if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
+/* pads the last block of the CBC-MAC in X with zeros */
+static int _cbc_mac_finish(cipher_t* cipher, uint8_t X[16], uint8_t* pos)
+{
+    if (*pos > 0) {
+        *pos = 0;
+        if (cipher_encrypt(cipher, X, X) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
-
-        memcpy(mac, mac_enc, block_size);
-        offset += block_size_input;
-    } while (offset < length);
-
-    return offset;
+    }
+    return 0;
 }
 
-
-int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
-                      uint8_t L, uint8_t* nonce, uint8_t nonce_len,
-                      size_t plaintext_len, uint8_t X1[16])
+/* CBC-MAC of B0 and the additional data */
+static int _cbc_mac_start(cipher_t* cipher, const uint8_t* auth_data,
+                          uint32_t auth_data_len, uint8_t M, uint8_t L,
+                          const uint8_t* nonce, size_t nonce_len,
+                          size_t length, uint8_t X[16])
 {
-    uint8_t M_, L_;
+    uint8_t pos = 0;
 
-    /* ensure everything is set to zero */
-    memset(X1, 0, 16);
+    if (auth_data_len > CCM_ADATA_LEN_MAX) {
+        DEBUG("UNSUPPORTED Adata length\n");
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
 
     /* set flags in B[0] - bit format:
             7        6     5..3  2..0
         Reserved   Adata    M_    L_    */
-    M_ = (M - 2) / 2;
-    L_ = L - 1;
-    X1[0] = 64 * (auth_data_len > 0) + 8 * M_ + L_;
-
-    /* copy nonce to B[1..15-L] */
-    memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
-
-    /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
-        X1[i] = plaintext_len & 0xff;
-        plaintext_len >>= 8;
+    memset(X, 0, CCM_BLOCK_SIZE);
+    X[0] = 64 * (auth_data_len > 0) + 8 * ((M - 2) / 2) + (L - 1);
+    memcpy(&X[1], nonce, nonce_len);
+    for (uint8_t i = 15; i > 15 - L; --i) {
+        X[i] = length & 0xff;
+        length >>= 8;
     }
-
-    /* if there is still data, plaintext_len was too big */
-    if (plaintext_len > 0) {
-        return CIPHER_ERR_INVALID_LENGTH;
+    /* if there is still data, length was too big */
+    if (length > 0) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
-
-    if (cipher_encrypt(cipher, X1, X1) != 1) {
+    if (cipher_encrypt(cipher, X, X) != 1) {
         return CIPHER_ERR_ENC_FAILED;
     }
+
+    if (auth_data_len > 0) {
+        uint8_t len_encoded[2] = { auth_data_len >> 8, auth_data_len & 0xff };
+        int res;
+
+        if (((res = _cbc_mac_update(cipher, X, &pos, len_encoded,
+                                    sizeof(len_encoded))) < 0) ||
+            ((res = _cbc_mac_update(cipher, X, &pos, auth_data,
+                                    auth_data_len)) < 0)) {
+            return res;
+        }
+        return _cbc_mac_finish(cipher, X, &pos);
+    }
     return 0;
 }
 
-int ccm_compute_adata_mac(cipher_t* cipher, uint8_t* auth_data,
-                          uint32_t auth_data_len, uint8_t X1[16])
+/*
+ * Encrypts (or decrypts) length bytes of input to output, which may be the
+ * same buffer, and stores the M bytes of the encrypted MAC in mac.
+ */
+static int _ccm(cipher_t* cipher, int encrypt, const uint8_t* auth_data,
+                uint32_t auth_data_len, uint8_t M, uint8_t L,
+                const uint8_t* nonce, size_t nonce_len,
+                const uint8_t* input, size_t length, uint8_t* output,
+                uint8_t* mac)
 {
-    if (auth_data_len > 0) {
-        int len;
+    /* the counter is kept a multiple of four octets wide for engines counting
+     * words, the blocks of a message never carry beyond its L octets */
+    uint8_t ctr_nonce_len = CCM_BLOCK_SIZE - ((L + 3) & ~3);
+    uint8_t A[16], X[16], S[16];
+    int res;
 
-        /* 16 octet block size + max. 10 len encoding  */
-        uint8_t auth_data_encoded[26], len_encoding = 0;
+    if (cipher_get_block_size(cipher) != CCM_BLOCK_SIZE) {
+        return CIPHER_ERR_INVALID_LENGTH;
+    }
+    nonce_len = min(nonce_len, 15 - L);
 
-        if ( auth_data_len < (((uint32_t) 2) << 16)) {       /* length (0x0001 ... 0xFEFF)  */
-            len_encoding = 2;
+    if ((M > 0) && ((res = _cbc_mac_start(cipher, auth_data, auth_data_len,
+                                          M, L, nonce, nonce_len, length,
+                                          X)) < 0)) {
+        return res;
+    }
 
-            auth_data_encoded[1] = auth_data_len & 0xFF;
-            auth_data_encoded[0] = (auth_data_len >> 8) & 0xFF;
-        } else {
-            DEBUG("UNSUPPORTED Adata length\n");
-            return -1;
-        }
+    /* A_0, its key stream block encrypts the MAC */
+    memset(A, 0, sizeof(A));
+    A[0] = L - 1;
+    memcpy(&A[1], nonce, nonce_len);
+    if (cipher_encrypt(cipher, A, S) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    for (uint8_t i = 0; i < M; ++i) {
+        mac[i] = S[i];
+    }
+    crypto_block_inc_ctr(A, CCM_BLOCK_SIZE - ctr_nonce_len);
 
-        memcpy(auth_data_encoded + len_encoding, auth_data, auth_data_len);
-        len = ccm_compute_cbc_mac(cipher, X1, auth_data_encoded, auth_data_len + len_encoding, X1);
-        if (len < 0) {
-            return -1;
+    if ((length > 0) && (cipher->interface->process != NULL)) {
+        uint8_t pos = 0;
+
+        /* the MAC is taken from the plaintext, which may be overwritten */
+        if ((M > 0) && encrypt &&
+            (((res = _cbc_mac_update(cipher, X, &pos, input, length)) < 0) ||
+             ((res = _cbc_mac_finish(cipher, X, &pos)) < 0))) {
+            return res;
+        }
+        res = cipher_encrypt_ctr(cipher, A, ctr_nonce_len, (uint8_t*)input,
+                                 length, output);
+        if (res < 0) {
+            return res;
+        }
+        if ((M > 0) && !encrypt &&
+            (((res = _cbc_mac_update(cipher, X, &pos, output, length)) < 0) ||
+             ((res = _cbc_mac_finish(cipher, X, &pos)) < 0))) {
+            return res;
+        }
+    }
+    else {
+        for (size_t offset = 0; offset < length; offset += CCM_BLOCK_SIZE) {
+            size_t n = min(CCM_BLOCK_SIZE, length - offset);
+
+            if (cipher_encrypt(cipher, A, S) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            crypto_block_inc_ctr(A, CCM_BLOCK_SIZE - ctr_nonce_len);
+            for (size_t i = 0; i < n; ++i) {
+                uint8_t in = input[offset + i];
+
+                output[offset + i] = in ^ S[i];
+                /* the MAC is taken from the plaintext */
+                if (M > 0) {
+                    X[i] ^= encrypt ? in : output[offset + i];
+                }
+            }
+            if ((M > 0) && (cipher_encrypt(cipher, X, X) != 1)) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
         }
     }
 
-    return 0;
+    /* auth value: mac ^ first stream block */
+    for (uint8_t i = 0; i < M; ++i) {
+        mac[i] ^= X[i];
+    }
+    return length;
 }
 
-
-int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_len,
-                       uint8_t mac_length, uint8_t length_encoding,
-                       uint8_t* nonce, size_t nonce_len,
-                       uint8_t* input, size_t input_len,
-                       uint8_t* output)
+static int _check_params(uint8_t mac_length, uint8_t length_encoding,
+                         int star)
 {
-    int len = -1;
-    uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
-
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
+    if (!(star && (mac_length == 0)) &&
+        (mac_length % 2 != 0 || mac_length < 4 || mac_length > 16)) {
         return CCM_ERR_INVALID_MAC_LENGTH;
     }
-
-    length_max = 2 << (8 * length_encoding);
-    if (length_encoding < 2 || length_encoding > 8 ||
-            input_len - auth_data_len > length_max) {
+    if (length_encoding < 2 || length_encoding > 8) {
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
+    return 0;
+}
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
+static int _encrypt(cipher_t* cipher, const uint8_t* auth_data,
+                    uint32_t auth_data_len, uint8_t mac_length,
+                    uint8_t length_encoding, const uint8_t* nonce,
+                    size_t nonce_len, const uint8_t* input, size_t input_len,
+                    uint8_t* output)
+{
+    int len = _ccm(cipher, 1, auth_data, auth_data_len, mac_length,
+                   length_encoding, nonce, nonce_len, input, input_len,
+                   output, &output[input_len]);
 
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
     if (len < 0) {
         return len;
     }
+    return len + mac_length;
+}
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
+static int _decrypt(cipher_t* cipher, const uint8_t* auth_data,
+                    uint32_t auth_data_len, uint8_t mac_length,
+                    uint8_t length_encoding, const uint8_t* nonce,
+                    size_t nonce_len, const uint8_t* input, size_t input_len,
+                    uint8_t* plain)
+{
+    uint8_t mac[16], mac_recv[16] = {0};
+    size_t plain_len;
+    int len;
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
+    /* the received MAC is kept in case the plaintext overwrites it */
+    plain_len = input_len - mac_length;
+    memcpy(mac_recv, &input[plain_len], mac_length);
+    len = _ccm(cipher, 0, auth_data, auth_data_len, mac_length,
+               length_encoding, nonce, nonce_len, input, plain_len, plain,
+               mac);
     if (len < 0) {
         return len;
     }
-
-    /* auth value: mac ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        output[len + i] = mac[i] ^ stream_block[i];
+    if (!crypto_equals(mac_recv, mac, mac_length)) {
+        return CCM_ERR_INVALID_CBC_MAC;
     }
-
-    return len + mac_length;
+    return len;
 }
 
+int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_len,
+                       uint8_t mac_length, uint8_t length_encoding,
+                       uint8_t* nonce, size_t nonce_len,
+                       uint8_t* input, size_t input_len,
+                       uint8_t* output)
+{
+    uint32_t length_max;
+    int res = _check_params(mac_length, length_encoding, 0);
+
+    if (res < 0) {
+        return res;
+    }
+    length_max = 2 << (8 * length_encoding);
+    if (input_len - auth_data_len > length_max) {
+        return CCM_ERR_INVALID_LENGTH_ENCODING;
+    }
+    return _encrypt(cipher, auth_data, auth_data_len, mac_length,
+                    length_encoding, nonce, nonce_len, input, input_len,
+                    output);
+}
 
 int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
                        uint32_t auth_data_len, uint8_t mac_length,
                        uint8_t length_encoding, uint8_t* nonce, size_t nonce_len,
                        uint8_t* input, size_t input_len, uint8_t* plain)
 {
-    int len = -1;
     uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    int res = _check_params(mac_length, length_encoding, 0);
 
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
+    if (res < 0) {
+        return res;
     }
-
     length_max = 2 << (8 * length_encoding);
-    if (length_encoding < 2 || length_encoding > 8 ||
-            input_len - auth_data_len > length_max) {
+    if (input_len - auth_data_len > length_max) {
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
+    return _decrypt(cipher, auth_data, auth_data_len, mac_length,
+                    length_encoding, nonce, nonce_len, input, input_len,
+                    plain);
+}
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Decrypt message in counter mode */
-    plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
+int cipher_encrypt_ccm_star(cipher_t* cipher, const uint8_t* auth_data,
+                            uint32_t auth_data_len, uint8_t mac_length,
+                            uint8_t length_encoding, const uint8_t* nonce,
+                            size_t nonce_len, const uint8_t* input,
+                            size_t input_len, uint8_t* output)
+{
+    int res = _check_params(mac_length, length_encoding, 1);
 
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
-    if (len < 0) {
-        return len;
+    if (res < 0) {
+        return res;
     }
+    return _encrypt(cipher, auth_data, auth_data_len, mac_length,
+                    length_encoding, nonce, nonce_len, input, input_len,
+                    output);
+}
 
-    /* mac = input[plain_len...plain_len+mac_length] ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        mac_recv[i] = input[len + i] ^ stream_block[i];
-    }
+int cipher_decrypt_ccm_star(cipher_t* cipher, const uint8_t* auth_data,
+                            uint32_t auth_data_len, uint8_t mac_length,
+                            uint8_t length_encoding, const uint8_t* nonce,
+                            size_t nonce_len, const uint8_t* input,
+                            size_t input_len, uint8_t* plain)
+{
+    int res = _check_params(mac_length, length_encoding, 1);
 
-    if (!crypto_equals(mac_recv, mac, mac_length)) {
-        return CCM_ERR_INVALID_CBC_MAC;
+    if (res < 0) {
+        return res;
     }
-
-    return plain_len;
+    return _decrypt(cipher, auth_data, auth_data_len, mac_length,
+                    length_encoding, nonce, nonce_len, input, input_len,
+                    plain);
 }
@@ -28,6 +28,12 @@ int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
     size_t offset = 0;
     uint8_t stream_block[16] = {0}, block_size;
 
+    int res = cipher_process(cipher, CIPHER_MODE_CTR, 1, nonce_counter,
+                             nonce_len, input, length, output);
+    if (res != CIPHER_ERR_NOT_SUPPORTED) {
+        return res;
+    }
+
     block_size = cipher_get_block_size(cipher);
     do {
         uint8_t block_size_input;
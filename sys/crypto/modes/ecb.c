@@ -28,12 +28,19 @@ int cipher_encrypt_ecb(cipher_t* cipher, uint8_t* input,
 {
     size_t offset;
     uint8_t block_size;
+    int res;
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    res = cipher_process(cipher, CIPHER_MODE_ECB, 1, NULL, 0, input, length,
+                         output);
+    if (res != CIPHER_ERR_NOT_SUPPORTED) {
+        return res;
+    }
+
     offset = 0;
     do {
         if (cipher_encrypt(cipher, input + offset, output + offset) != 1) {
@@ -51,12 +58,19 @@ int cipher_decrypt_ecb(cipher_t* cipher, uint8_t* input,
 {
     size_t offset = 0;
     uint8_t block_size;
+    int res;
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    res = cipher_process(cipher, CIPHER_MODE_ECB, 0, NULL, 0, input, length,
+                         output);
+    if (res != CIPHER_ERR_NOT_SUPPORTED) {
+        return res;
+    }
+
     do {
         if (cipher_decrypt(cipher, input + offset, output + offset) != 1) {
             return CIPHER_ERR_DEC_FAILED;
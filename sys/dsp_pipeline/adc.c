@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       ADC source of the signal processing pipeline
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "dsp_pipeline.h"
+#include "dsp_pipeline_priv.h"
+#include "thread.h"
+
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+
+/* runs in interrupt context, for each filled half of the DMA buffer */
+static void _adc_cb(void *arg, const uint16_t *samples, size_t len)
+{
+    dsp_pipeline_t *p = (dsp_pipeline_t *)arg;
+#ifdef MODULE_XTIMER
+    uint32_t now = xtimer_now_usec();
+#else
+    uint32_t now = 0;
+#endif
+
+    while (len) {
+        size_t n;
+        float32_t *out = dsp_pipeline_space(p, &n);
+
+        if (n > len) {
+            n = len;
+        }
+        for (size_t i = 0; i < n; i++) {
+            out[i] = samples[i];
+        }
+        samples += n;
+        len -= n;
+        dsp_pipeline_commit(p, n, now);
+    }
+}
+
+int dsp_pipeline_adc_start(dsp_pipeline_t *p, adc_t line, adc_res_t res,
+                           uint32_t rate, uint16_t *dma, size_t len)
+{
+    p->thread = (thread_t *)sched_active_thread;
+    p->line = line;
+    p->source = DSP_SOURCE_ADC;
+
+    int err = adc_stream_start(&p->line, 1, res, rate, dma, len, _adc_cb, p);
+    if (err < 0) {
+        p->source = DSP_SOURCE_NONE;
+    }
+    return err;
+}
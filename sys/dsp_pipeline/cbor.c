@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       CBOR sink of the signal processing pipeline
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cbor.h"
+#include "dsp_pipeline.h"
+
+ssize_t dsp_pipeline_cbor_encode(const dsp_frame_t *frame, uint8_t *buf,
+                                 size_t size)
+{
+    cbor_stream_t stream;
+
+    cbor_init(&stream, buf, size);
+    if (!cbor_serialize_array(&stream, frame->numof + 1) ||
+        !cbor_serialize_uint64_t(&stream, frame->time)) {
+        return -ENOBUFS;
+    }
+    for (unsigned i = 0; i < frame->numof; i++) {
+        if (!cbor_serialize_float(&stream, frame->features[i])) {
+            return -ENOBUFS;
+        }
+    }
+    return stream.pos;
+}
+
+static int _write(dsp_sink_t *sink, const dsp_frame_t *frame)
+{
+    dsp_sink_cbor_t *cbor = (dsp_sink_cbor_t *)sink;
+    ssize_t len = dsp_pipeline_cbor_encode(frame, cbor->buf, cbor->size);
+
+    if (len < 0) {
+        return len;
+    }
+    return cbor->cb(cbor->arg, cbor->buf, len);
+}
+
+void dsp_sink_cbor_init(dsp_sink_cbor_t *sink, uint8_t *buf, size_t size,
+                        dsp_cbor_cb_t cb, void *arg)
+{
+    sink->sink.write = _write;
+    sink->buf = buf;
+    sink->size = size;
+    sink->cb = cb;
+    sink->arg = arg;
+}
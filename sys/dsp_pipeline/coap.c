@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       CoAP sink of the signal processing pipeline
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+#include "net/gcoap.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static int _write(dsp_sink_t *sink, const dsp_frame_t *frame)
+{
+    dsp_sink_coap_t *coap = (dsp_sink_coap_t *)sink;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    switch (gcoap_obs_init(&pdu, buf, sizeof(buf), coap->resource)) {
+        case GCOAP_OBS_INIT_OK:
+            break;
+        case GCOAP_OBS_INIT_UNUSED:
+            /* nobody is interested */
+            return 0;
+        default:
+            return -ECANCELED;
+    }
+
+    ssize_t len = dsp_pipeline_cbor_encode(frame, pdu.payload,
+                                           pdu.payload_len);
+    if (len < 0) {
+        return len;
+    }
+    len = gcoap_finish(&pdu, len, COAP_FORMAT_CBOR);
+    if (len < 0) {
+        return len;
+    }
+    if (gcoap_obs_send(buf, len, coap->resource) == 0) {
+        DEBUG("dsp_pipeline: sending notification failed\n");
+        return -ECANCELED;
+    }
+    return 0;
+}
+
+void dsp_sink_coap_init(dsp_sink_coap_t *sink, const coap_resource_t *resource)
+{
+    sink->sink.write = _write;
+    sink->resource = resource;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       Signal processing pipeline implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "assert.h"
+#include "dsp_pipeline.h"
+#include "dsp_pipeline_priv.h"
+#include "irq.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void dsp_pipeline_init(dsp_pipeline_t *p, float32_t *buf0, float32_t *buf1,
+                       size_t len)
+{
+    assert(p && buf0 && buf1 && len);
+
+    p->buf[0] = buf0;
+    p->buf[1] = buf1;
+    p->len = len;
+    p->pos = 0;
+    p->ready = -1;
+    p->fill = 0;
+    p->source = DSP_SOURCE_NONE;
+    p->overruns = 0;
+    p->stages = NULL;
+    p->sink = NULL;
+    p->thread = NULL;
+}
+
+void dsp_pipeline_add(dsp_pipeline_t *p, dsp_stage_t *stage)
+{
+    dsp_stage_t **last = &p->stages;
+
+    while (*last) {
+        last = &(*last)->next;
+    }
+    stage->next = NULL;
+    *last = stage;
+}
+
+void dsp_pipeline_commit(dsp_pipeline_t *p, size_t n, uint32_t time)
+{
+    p->pos += n;
+    if (p->pos < p->len) {
+        return;
+    }
+
+    p->pos = 0;
+    if (p->ready >= 0) {
+        /* the other buffer is still processed, refill this one */
+        p->overruns++;
+        return;
+    }
+    p->time[p->fill] = time;
+    p->ready = p->fill;
+    p->fill ^= 1;
+    if (irq_is_in()) {
+        thread_flags_set(p->thread, DSP_PIPELINE_FLAG);
+    }
+}
+
+void dsp_pipeline_stop(dsp_pipeline_t *p)
+{
+    switch (p->source) {
+#ifdef MODULE_DSP_PIPELINE_ADC
+        case DSP_SOURCE_ADC:
+            adc_stream_stop(p->line);
+            break;
+#endif
+#ifdef MODULE_DSP_PIPELINE_SAUL
+        case DSP_SOURCE_SAUL:
+            saul_reg_fifo_stop(p->dev);
+            break;
+#endif
+        default:
+            break;
+    }
+    p->source = DSP_SOURCE_NONE;
+}
+
+int dsp_pipeline_process(dsp_pipeline_t *p)
+{
+    int idx;
+
+    assert(p->thread == (thread_t *)sched_active_thread);
+
+    while ((idx = p->ready) < 0) {
+        thread_flags_wait_any(DSP_PIPELINE_FLAG);
+#ifdef MODULE_DSP_PIPELINE_SAUL
+        if (p->source == DSP_SOURCE_SAUL) {
+            int res = dsp_pipeline_saul_read(p);
+            if (res < 0) {
+                return res;
+            }
+        }
+#endif
+    }
+
+    dsp_frame_t frame = {
+        .data = p->buf[idx],
+        .len = p->len,
+        .features = p->features,
+        .numof = 0,
+        .time = p->time[idx],
+    };
+    int res = 0;
+
+    for (dsp_stage_t *stage = p->stages; stage; stage = stage->next) {
+        res = stage->process(stage, &frame);
+        if (res < 0) {
+            DEBUG("dsp_pipeline: stage %p dropped frame (%d)\n",
+                  (void *)stage, res);
+            break;
+        }
+    }
+    if ((res == 0) && p->sink) {
+        res = p->sink->write(p->sink, &frame);
+    }
+
+    /* the source may fill this buffer again */
+    p->ready = -1;
+    return res;
+}
+
+int dsp_frame_add_feature(dsp_frame_t *frame, float32_t value)
+{
+    if (frame->numof == DSP_PIPELINE_FEATURES) {
+        return -ENOBUFS;
+    }
+    frame->features[frame->numof++] = value;
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       Interface between the pipeline and its sources
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef DSP_PIPELINE_PRIV_H
+#define DSP_PIPELINE_PRIV_H
+
+#include "dsp_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Types of sources
+ */
+enum {
+    DSP_SOURCE_NONE,
+    DSP_SOURCE_ADC,
+    DSP_SOURCE_SAUL,
+};
+
+/**
+ * @brief   Get the free part of the buffer being filled
+ *
+ * @param[in] p         pipeline
+ * @param[out] space    number of samples that fit
+ *
+ * @return  where to write the next sample
+ */
+static inline float32_t *dsp_pipeline_space(dsp_pipeline_t *p, size_t *space)
+{
+    *space = p->len - p->pos;
+    return &p->buf[p->fill][p->pos];
+}
+
+/**
+ * @brief   Add samples written to dsp_pipeline_space() to the frame
+ *
+ * May be called in interrupt context.
+ *
+ * @param[in,out] p     pipeline
+ * @param[in] n         number of samples written
+ * @param[in] time      time of the last of them
+ */
+void dsp_pipeline_commit(dsp_pipeline_t *p, size_t n, uint32_t time);
+
+/**
+ * @brief   Read the samples collected by the SAUL source
+ *
+ * @param[in,out] p     pipeline
+ *
+ * @return  0 on success
+ * @return  < 0, as saul_reg_read_fifo()
+ */
+int dsp_pipeline_saul_read(dsp_pipeline_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_PIPELINE_PRIV_H */
+/** @} */
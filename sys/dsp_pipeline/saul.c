@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       SAUL source of the signal processing pipeline
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "dsp_pipeline.h"
+#include "dsp_pipeline_priv.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+/* runs in interrupt context, once the FIFO reached the watermark */
+static void _notify(void *arg)
+{
+    dsp_pipeline_t *p = (dsp_pipeline_t *)arg;
+
+    thread_flags_set(p->thread, DSP_PIPELINE_FLAG);
+}
+
+static float32_t _exp10(int8_t scale)
+{
+    float32_t res = 1.0f;
+
+    for (; scale > 0; scale--) {
+        res *= 10.0f;
+    }
+    for (; scale < 0; scale++) {
+        res /= 10.0f;
+    }
+    return res;
+}
+
+int dsp_pipeline_saul_read(dsp_pipeline_t *p)
+{
+    phydat_t res[DSP_PIPELINE_SAUL_CHUNK];
+    uint32_t time, period;
+    int numof;
+
+    /* empty the FIFO, it fills up while the last batch is processed */
+    do {
+        numof = saul_reg_read_fifo(p->dev, res, DSP_PIPELINE_SAUL_CHUNK,
+                                   &time, &period);
+        if (numof <= 0) {
+            return numof;
+        }
+
+        float32_t scale = _exp10(res[0].scale);
+        int i = 0;
+        while (i < numof) {
+            size_t n;
+            float32_t *out = dsp_pipeline_space(p, &n);
+
+            if (n > (size_t)(numof - i)) {
+                n = numof - i;
+            }
+            for (size_t j = 0; j < n; j++) {
+                out[j] = res[i + j].val[p->axis] * scale;
+            }
+            i += n;
+            dsp_pipeline_commit(p, n, time - (numof - i) * period);
+        }
+    } while (numof == DSP_PIPELINE_SAUL_CHUNK);
+
+    return 0;
+}
+
+int dsp_pipeline_saul_start(dsp_pipeline_t *p, saul_reg_t *dev, unsigned axis,
+                            unsigned watermark)
+{
+    assert(axis < PHYDAT_DIM);
+
+    p->thread = (thread_t *)sched_active_thread;
+    p->dev = dev;
+    p->axis = axis;
+    p->source = DSP_SOURCE_SAUL;
+
+    int err = saul_reg_fifo_start(dev, watermark, _notify, p);
+    if (err < 0) {
+        p->source = DSP_SOURCE_NONE;
+    }
+    return err;
+}
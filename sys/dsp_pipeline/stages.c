@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       Signal processing pipeline stages
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+
+static int _dc(dsp_stage_t *stage, dsp_frame_t *frame)
+{
+    (void)stage;
+    float32_t mean;
+
+    arm_mean_f32(frame->data, frame->len, &mean);
+    arm_offset_f32(frame->data, -mean, frame->data, frame->len);
+    return 0;
+}
+
+void dsp_dc_init(dsp_dc_t *dc)
+{
+    dc->stage.process = _dc;
+}
+
+static int _window(dsp_stage_t *stage, dsp_frame_t *frame)
+{
+    dsp_window_t *win = (dsp_window_t *)stage;
+
+    arm_mult_f32(frame->data, win->coeffs, frame->data, frame->len);
+    return 0;
+}
+
+void dsp_window_init(dsp_window_t *win, float32_t *coeffs, size_t len)
+{
+    /* periodic Hann window, as used for spectral analysis */
+    for (size_t i = 0; i < len; i++) {
+        coeffs[i] = 0.5f - 0.5f * arm_cos_f32((2 * PI * i) / len);
+    }
+    win->coeffs = coeffs;
+    win->stage.process = _window;
+}
+
+static int _fft(dsp_stage_t *stage, dsp_frame_t *frame)
+{
+    dsp_fft_t *fft = (dsp_fft_t *)stage;
+    uint32_t bins = fft->rfft.fftLenRFFT / 2;
+
+    if (frame->len != fft->rfft.fftLenRFFT) {
+        return -EINVAL;
+    }
+    /* uses frame->data as scratch */
+    arm_rfft_fast_f32(&fft->rfft, frame->data, fft->out, 0);
+    /* the real part of the Nyquist bin takes the place of the imaginary part
+     * of the DC bin, drop it */
+    fft->out[1] = 0;
+    arm_cmplx_mag_f32(fft->out, fft->out, bins);
+
+    frame->data = fft->out;
+    frame->len = bins;
+    return 0;
+}
+
+int dsp_fft_init(dsp_fft_t *fft, float32_t *out, size_t len)
+{
+    if (arm_rfft_fast_init_f32(&fft->rfft, len) != ARM_MATH_SUCCESS) {
+        return -EINVAL;
+    }
+    fft->out = out;
+    fft->stage.process = _fft;
+    return 0;
+}
+
+static int _rms(dsp_stage_t *stage, dsp_frame_t *frame)
+{
+    (void)stage;
+    float32_t rms;
+
+    arm_rms_f32(frame->data, frame->len, &rms);
+    return dsp_frame_add_feature(frame, rms);
+}
+
+void dsp_rms_init(dsp_rms_t *rms)
+{
+    rms->stage.process = _rms;
+}
+
+static int _bands(dsp_stage_t *stage, dsp_frame_t *frame)
+{
+    dsp_bands_t *bands = (dsp_bands_t *)stage;
+    const uint16_t *edges = bands->edges;
+
+    if (edges[bands->numof] > frame->len) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < bands->numof; i++) {
+        float32_t energy;
+
+        arm_power_f32(&frame->data[edges[i]], edges[i + 1] - edges[i],
+                      &energy);
+        int res = dsp_frame_add_feature(frame, energy);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+void dsp_bands_init(dsp_bands_t *bands, const uint16_t *edges, unsigned numof)
+{
+    bands->edges = edges;
+    bands->numof = numof;
+    bands->stage.process = _bands;
+}
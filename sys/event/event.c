@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * The list node of an event is NULL while the event is not queued, so
+ * posting a queued event again is detected in O(1).
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "event.h"
+#include "irq.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && queue->waiter && event);
+
+    unsigned state = irq_disable();
+    if (!event->list_node.next) {
+        clist_rpush(&queue->event_list, &event->list_node);
+    }
+    else {
+        DEBUG("event: event %p already queued\n", (void *)event);
+    }
+    irq_restore(state);
+
+    thread_flags_set(queue->waiter, THREAD_FLAG_EVENT);
+}
+
+void event_cancel(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    clist_remove(&queue->event_list, &event->list_node);
+    event->list_node.next = NULL;
+    irq_restore(state);
+}
+
+event_t *event_get(event_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    event_t *result = (event_t *)clist_lpop(&queue->event_list);
+
+    /* the event can be posted again as soon as interrupts are back on */
+    if (result) {
+        result->list_node.next = NULL;
+    }
+    irq_restore(state);
+
+    return result;
+}
+
+event_t *event_wait(event_queue_t *queue)
+{
+    event_t *result;
+
+    assert(queue->waiter == sched_active_thread);
+
+    while ((result = event_get(queue)) == NULL) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+    return result;
+}
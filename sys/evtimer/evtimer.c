@@ -29,6 +29,142 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifdef MODULE_EVTIMER_HEAP
+/* The events are kept in a pairing heap. Like in the list below, the offset
+ * of an event is relative to the event it is linked to: the offset of the
+ * root is relative to the last update of the evtimer, offsets of children
+ * are relative to their parent. An event's next pointer points to its next
+ * sibling, prev points to its previous sibling or, for the first child, to
+ * its parent. */
+
+/* links two heaps whose roots' offsets are relative to the same time,
+ * @p a wins ties */
+static evtimer_event_t *_link(evtimer_event_t *a, evtimer_event_t *b)
+{
+    if (!b) {
+        return a;
+    }
+    if (!a) {
+        return b;
+    }
+    if (b->offset < a->offset) {
+        evtimer_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->offset -= a->offset;
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/* merges the children of @p parent into one heap, whose root's offset is
+ * relative to the time @p parent is relative to */
+static evtimer_event_t *_merge_children(evtimer_event_t *parent)
+{
+    evtimer_event_t *list = parent->child;
+    evtimer_event_t *pairs = NULL;
+
+    /* first pass: link pairs from left to right, collect the results in
+     * reverse order */
+    while (list) {
+        evtimer_event_t *a = list;
+        evtimer_event_t *b = a->next;
+
+        a->offset += parent->offset;
+        if (b) {
+            b->offset += parent->offset;
+            list = b->next;
+        }
+        else {
+            list = NULL;
+        }
+        a = _link(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: link the results from right to left */
+    evtimer_event_t *root = NULL;
+    while (pairs) {
+        evtimer_event_t *next = pairs->next;
+        root = _link(root, pairs);
+        pairs = next;
+    }
+
+    if (root) {
+        root->next = NULL;
+        root->prev = NULL;
+    }
+    return root;
+}
+
+static void _add_event(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    event->child = NULL;
+    event->next = NULL;
+    event->prev = NULL;
+
+    evtimer->events = _link(evtimer->events, event);
+    evtimer->events->prev = NULL;
+    evtimer->events->next = NULL;
+}
+
+static void _del_event(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    if (event == evtimer->events) {
+        evtimer->events = _merge_children(event);
+    }
+    else if (event->prev) {
+        /* the merged children are not earlier than event itself, so they can
+         * take its place among its siblings */
+        evtimer_event_t *sub = _merge_children(event);
+        evtimer_event_t *replacement = event->next;
+
+        if (sub) {
+            sub->next = event->next;
+            sub->prev = event->prev;
+            replacement = sub;
+        }
+        if (event->next) {
+            event->next->prev = sub ? sub : event->prev;
+        }
+        if (event->prev->child == event) {
+            event->prev->child = replacement;
+        }
+        else {
+            event->prev->next = replacement;
+        }
+    }
+    else {
+        /* not pending */
+        return;
+    }
+
+    event->child = NULL;
+    event->next = NULL;
+    event->prev = NULL;
+}
+
+static evtimer_event_t *_get_next(evtimer_t *evtimer)
+{
+    evtimer_event_t *event = evtimer->events;
+
+    if (event && (event->offset == 0)) {
+        _del_event(evtimer, event);
+        return event;
+    }
+    else {
+        return NULL;
+    }
+}
+#else
 /* XXX this function is intentionally non-static, since the optimizer can't
  * handle the pointer hack in this function */
 void evtimer_add_event_to_list(evtimer_t *evtimer, evtimer_event_t *event)
@@ -79,6 +215,20 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
+static evtimer_event_t *_get_next(evtimer_t *evtimer)
+{
+    evtimer_event_t *event = evtimer->events;
+
+    if (event && (event->offset == 0)) {
+        evtimer->events = event->next;
+        return event;
+    }
+    else {
+        return NULL;
+    }
+}
+#endif
+
 static void _set_timer(xtimer_t *timer, uint32_t offset)
 {
     uint64_t offset_in_us = (uint64_t)offset * 1000;
@@ -131,7 +281,11 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
     DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
 
     _update_head_offset(evtimer);
+#ifdef MODULE_EVTIMER_HEAP
+    _add_event(evtimer, event);
+#else
     evtimer_add_event_to_list(evtimer, event);
+#endif
     if (evtimer->events == event) {
         _set_timer(&evtimer->timer, event->offset);
     }
@@ -148,24 +302,15 @@ void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
     DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
 
     _update_head_offset(evtimer);
+#ifdef MODULE_EVTIMER_HEAP
+    _del_event(evtimer, event);
+#else
     _del_event_from_list(evtimer, event);
+#endif
     _update_timer(evtimer);
     irq_restore(state);
 }
 
-static evtimer_event_t *_get_next(evtimer_t *evtimer)
-{
-    evtimer_event_t *event = evtimer->events;
-
-    if (event && (event->offset == 0)) {
-        evtimer->events = event->next;
-        return event;
-    }
-    else {
-        return NULL;
-    }
-}
-
 static void _evtimer_handler(void *arg)
 {
     DEBUG("_evtimer_handler()\n");
@@ -193,6 +338,36 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->events = NULL;
 }
 
+#ifdef MODULE_EVTIMER_HEAP
+void evtimer_print(const evtimer_t *evtimer)
+{
+    const evtimer_event_t *event = evtimer->events;
+    uint32_t base = 0;
+
+    /* pre-order walk, printing offsets relative to the last update */
+    while (event) {
+        printf("ev offset=%u\n", (unsigned)(base + event->offset));
+        if (event->child) {
+            base += event->offset;
+            event = event->child;
+            continue;
+        }
+        while (event && !event->next) {
+            /* go up to the parent */
+            while (event->prev && (event->prev->child != event)) {
+                event = event->prev;
+            }
+            event = event->prev;
+            if (event) {
+                base -= event->offset;
+            }
+        }
+        if (event) {
+            event = event->next;
+        }
+    }
+}
+#else
 void evtimer_print(const evtimer_t *evtimer)
 {
     evtimer_event_t *list = evtimer->events;
@@ -203,3 +378,4 @@ void evtimer_print(const evtimer_t *evtimer)
         list = list->next;
     }
 }
+#endif
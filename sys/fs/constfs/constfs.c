@@ -45,6 +45,7 @@ static int constfs_fstat(vfs_file_t *filp, struct stat *buf);
 static off_t constfs_lseek(vfs_file_t *filp, off_t off, int whence);
 static int constfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mode, const char *abs_path);
 static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
+static int constfs_mmap(vfs_file_t *filp, const void **addr, size_t *len);
 static ssize_t constfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
 
 /* Directory operations */
@@ -67,6 +68,7 @@ static const vfs_file_ops_t constfs_file_ops = {
     .open  = constfs_open,
     .read  = constfs_read,
     .write = constfs_write,
+    .mmap  = constfs_mmap,
 };
 
 static const vfs_dir_ops_t constfs_dir_ops = {
@@ -116,24 +118,20 @@ static int constfs_unlink(vfs_mount_t *mountp, const char *name)
 
 static int constfs_stat(vfs_mount_t *mountp, const char *restrict name, struct stat *restrict buf)
 {
-    (void) name;
     /* Fill out some information about this file */
     if (buf == NULL) {
         return -EFAULT;
     }
     constfs_t *fs = mountp->private_data;
-    /* linear search through the files array */
-    for (size_t i = 0; i < fs->nfiles; ++i) {
-        DEBUG("constfs_stat ? \"%s\"\n", fs->files[i].path);
-        if (strcmp(fs->files[i].path, name) == 0) {
-            DEBUG("constfs_stat: Found :)\n");
-            _constfs_write_stat(&fs->files[i], buf);
-            buf->st_ino = i;
-            return 0;
-        }
+    const constfs_file_t *fp = constfs_find(fs, name);
+    if (fp == NULL) {
+        DEBUG("constfs_stat: Not found :(\n");
+        return -ENOENT;
     }
-    DEBUG("constfs_stat: Not found :(\n");
-    return -ENOENT;
+    DEBUG("constfs_stat: Found :)\n");
+    _constfs_write_stat(fp, buf);
+    buf->st_ino = fp - fs->files;
+    return 0;
 }
 
 static int constfs_statvfs(vfs_mount_t *mountp, const char *restrict path, struct statvfs *restrict buf)
@@ -215,17 +213,14 @@ static int constfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mo
     if ((flags & O_ACCMODE) != O_RDONLY) {
         return -EROFS;
     }
-    /* linear search through the files array */
-    for (size_t i = 0; i < fs->nfiles; ++i) {
-        DEBUG("constfs_open ? \"%s\"\n", fs->files[i].path);
-        if (strcmp(fs->files[i].path, name) == 0) {
-            DEBUG("constfs_open: Found :)\n");
-            filp->private_data.ptr = (void *)&fs->files[i];
-            return 0;
-        }
+    const constfs_file_t *fp = constfs_find(fs, name);
+    if (fp == NULL) {
+        DEBUG("constfs_open: Not found :(\n");
+        return -ENOENT;
     }
-    DEBUG("constfs_open: Not found :(\n");
-    return -ENOENT;
+    DEBUG("constfs_open: Found :)\n");
+    filp->private_data.ptr = (void *)fp;
+    return 0;
 }
 
 static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
@@ -246,6 +241,21 @@ static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
     return nbytes;
 }
 
+static int constfs_mmap(vfs_file_t *filp, const void **addr, size_t *len)
+{
+    constfs_file_t *fp = filp->private_data.ptr;
+    DEBUG("constfs_mmap: %p\n", (void *)filp);
+    if ((size_t)filp->pos >= fp->size) {
+        /* Current offset is at or beyond end of file */
+        *addr = fp->data + fp->size;
+        *len = 0;
+        return 0;
+    }
+    *addr = fp->data + filp->pos;
+    *len = fp->size - filp->pos;
+    return 0;
+}
+
 static ssize_t constfs_write(vfs_file_t *filp, const void *src, size_t nbytes)
 {
     DEBUG("constfs_write: %p, %p, %lu\n", (void *)filp, src, (unsigned long)nbytes);
@@ -317,3 +327,35 @@ static void _constfs_write_stat(const constfs_file_t *fp, struct stat *restrict
     buf->st_blocks = fp->size;
     buf->st_blksize = sizeof(uint8_t);
 }
+
+const constfs_file_t *constfs_find(const constfs_t *fs, const char *path)
+{
+    if (!fs->sorted) {
+        /* linear search through the files array */
+        for (size_t i = 0; i < fs->nfiles; ++i) {
+            DEBUG("constfs_find ? \"%s\"\n", fs->files[i].path);
+            if (strcmp(fs->files[i].path, path) == 0) {
+                return &fs->files[i];
+            }
+        }
+        return NULL;
+    }
+    /* binary search through the sorted files array */
+    size_t lo = 0;
+    size_t hi = fs->nfiles;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        DEBUG("constfs_find ? \"%s\"\n", fs->files[mid].path);
+        int cmp = strcmp(fs->files[mid].path, path);
+        if (cmp == 0) {
+            return &fs->files[mid];
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fw_update
+ * @{
+ *
+ * @file
+ * @brief       Streaming delta patch decoder
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "fw_update.h"
+#include "fw_update_priv.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @name    Patch operations
+ * @{
+ */
+#define OP_ADD          (0x00)
+#define OP_INSERT       (0x01)
+#define OP_SEEK         (0x02)
+/** @} */
+
+/**
+ * @name    Parser states
+ * @{
+ */
+enum {
+    STATE_OP = 0,       /**< expecting an opcode */
+    STATE_ARG,          /**< decoding the argument of fw_update_t::op */
+    STATE_DATA,         /**< fw_update_t::arg bytes of data follow */
+};
+/** @} */
+
+void fw_update_set_source(fw_update_t *update, mtd_dev_t *mtd,
+                          uint32_t offset, uint32_t size)
+{
+    update->src_mtd = mtd;
+    update->src_offset = offset;
+    update->src_size = size;
+    update->src_pos = 0;
+    update->state = STATE_OP;
+}
+
+static int _add(fw_update_t *update, const uint8_t *diff, size_t len)
+{
+    uint8_t buf[FW_UPDATE_DELTA_CHUNK];
+
+    if (len > sizeof(buf)) {
+        len = sizeof(buf);
+    }
+    if (len > update->src_size - update->src_pos) {
+        DEBUG("fw_update: patch reads beyond the source\n");
+        return -EINVAL;
+    }
+    /* reading the device while it is programmed is not allowed by most
+     * flash controllers */
+    if (update->src_mtd == update->mtd) {
+        fw_update_wait(update);
+    }
+    int res = mtd_read(update->src_mtd, buf,
+                       update->src_offset + update->src_pos, len);
+    if (res < 0) {
+        return res;
+    }
+    for (unsigned i = 0; i < len; i++) {
+        buf[i] += diff[i];
+    }
+    update->src_pos += len;
+
+    res = fw_update_append(update, buf, len);
+    return (res < 0) ? res : (int)len;
+}
+
+static int _arg_done(fw_update_t *update)
+{
+    switch (update->op) {
+        case OP_SEEK: {
+            /* zigzag decoding */
+            int32_t offset = (int32_t)(update->arg >> 1) ^
+                             -(int32_t)(update->arg & 1);
+            uint32_t pos = update->src_pos + offset;
+
+            if (pos > update->src_size) {
+                DEBUG("fw_update: seek beyond the source\n");
+                return -EINVAL;
+            }
+            update->src_pos = pos;
+            update->state = STATE_OP;
+            break;
+        }
+        case OP_ADD:
+        case OP_INSERT:
+            update->state = (update->arg) ? STATE_DATA : STATE_OP;
+            break;
+    }
+    return 0;
+}
+
+int fw_update_delta_write(fw_update_t *update, const uint8_t *data, size_t len)
+{
+    while (len) {
+        switch (update->state) {
+            case STATE_OP:
+                update->op = *data;
+                if (update->op > OP_SEEK) {
+                    DEBUG("fw_update: unknown patch operation 0x%02x\n",
+                          update->op);
+                    return -EINVAL;
+                }
+                update->arg = 0;
+                update->shift = 0;
+                update->state = STATE_ARG;
+                data++;
+                len--;
+                break;
+            case STATE_ARG:
+                if (update->shift > 28) {
+                    return -EINVAL;
+                }
+                update->arg |= (uint32_t)(*data & 0x7f) << update->shift;
+                update->shift += 7;
+                if (!(*data & 0x80)) {
+                    int res = _arg_done(update);
+                    if (res < 0) {
+                        return res;
+                    }
+                }
+                data++;
+                len--;
+                break;
+            case STATE_DATA: {
+                size_t n = (len < update->arg) ? len : update->arg;
+                int res;
+
+                if (update->op == OP_INSERT) {
+                    res = fw_update_append(update, data, n);
+                    if (res == 0) {
+                        res = n;
+                    }
+                }
+                else {
+                    res = _add(update, data, n);
+                }
+                if (res < 0) {
+                    return res;
+                }
+                data += res;
+                len -= res;
+                update->arg -= res;
+                if (update->arg == 0) {
+                    update->state = STATE_OP;
+                }
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+int fw_update_delta_finish(fw_update_t *update)
+{
+    if (update->state != STATE_OP) {
+        DEBUG("fw_update: patch is truncated\n");
+        return -EINVAL;
+    }
+    return 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fw_update
+ * @{
+ *
+ * @file
+ * @brief       Streaming firmware update implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "fw_update.h"
+#include "fw_update_priv.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define FW_UPDATE_FLAG      (0x1)
+
+static char _stack[FW_UPDATE_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static fw_update_t *_update;
+
+static int _program(fw_update_t *update)
+{
+    mtd_dev_t *mtd = update->mtd;
+    uint32_t sector_size = mtd->pages_per_sector * mtd->page_size;
+    uint32_t end = update->wr_addr + update->wr_len;
+    const uint8_t *buf = update->wr_buf;
+    uint32_t addr = update->wr_addr;
+
+    /* erase the sectors just before they are programmed, so the first
+     * buffers are written without waiting for the whole slot */
+    while (update->erased < end) {
+        DEBUG("fw_update: erasing 0x%08lx\n",
+              (unsigned long)(update->offset + update->erased));
+        int res = mtd_erase(mtd, update->offset + update->erased, sector_size);
+        if (res < 0) {
+            return res;
+        }
+        update->erased += sector_size;
+    }
+
+    while (addr < end) {
+        uint32_t abs = update->offset + addr;
+        uint32_t len = mtd->page_size - (abs % mtd->page_size);
+
+        if (len > end - addr) {
+            len = end - addr;
+        }
+        int res = mtd_write(mtd, buf, abs, len);
+        if (res < 0) {
+            return res;
+        }
+        buf += len;
+        addr += len;
+    }
+
+    sha256_update(&update->sha, update->wr_buf, update->wr_len);
+    return 0;
+}
+
+static void *_writer_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FW_UPDATE_FLAG);
+
+        fw_update_t *update = _update;
+        int res = _program(update);
+        if (res < 0) {
+            DEBUG("fw_update: writing 0x%08lx failed (%d)\n",
+                  (unsigned long)update->wr_addr, res);
+            update->error = res;
+        }
+        mutex_unlock(&update->busy);
+    }
+
+    return NULL;
+}
+
+/* hands the current buffer to the writer thread, once it is done with the
+ * other one */
+static int _submit(fw_update_t *update)
+{
+    mutex_lock(&update->busy);
+    if (update->error) {
+        mutex_unlock(&update->busy);
+        return update->error;
+    }
+
+    update->wr_buf = update->buf[update->cur];
+    update->wr_len = update->fill;
+    update->wr_addr = update->pos;
+    update->pos += update->fill;
+    update->cur ^= 1;
+    update->fill = 0;
+
+    thread_flags_set((thread_t *)sched_threads[_pid], FW_UPDATE_FLAG);
+    return 0;
+}
+
+int fw_update_wait(fw_update_t *update)
+{
+    mutex_lock(&update->busy);
+    mutex_unlock(&update->busy);
+    return update->error;
+}
+
+int fw_update_append(fw_update_t *update, const uint8_t *data, size_t len)
+{
+    while (len) {
+        size_t n = FW_UPDATE_BUF_SIZE - update->fill;
+
+        if (n > len) {
+            n = len;
+        }
+        if (update->pos + update->fill + n > update->size) {
+            return -EFBIG;
+        }
+        memcpy(&update->buf[update->cur][update->fill], data, n);
+        update->fill += n;
+        data += n;
+        len -= n;
+        if (update->fill == FW_UPDATE_BUF_SIZE) {
+            int res = _submit(update);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+static int _output(fw_update_t *update, const uint8_t *data, size_t len)
+{
+#ifdef MODULE_FW_UPDATE_DELTA
+    if (update->src_mtd) {
+        return fw_update_delta_write(update, data, len);
+    }
+#endif
+    return fw_update_append(update, data, len);
+}
+
+#ifdef MODULE_HEATSHRINK
+/* decompresses right into the current buffer, unless the output is a delta
+ * patch */
+static int _decompress(fw_update_t *update)
+{
+    HSD_poll_res res;
+
+    do {
+        size_t n;
+
+#ifdef MODULE_FW_UPDATE_DELTA
+        if (update->src_mtd) {
+            uint8_t patch[FW_UPDATE_DELTA_CHUNK];
+
+            res = heatshrink_decoder_poll(&update->hsd, patch, sizeof(patch),
+                                          &n);
+            if (res < 0) {
+                return -EINVAL;
+            }
+            int err = fw_update_delta_write(update, patch, n);
+            if (err < 0) {
+                return err;
+            }
+            continue;
+        }
+#endif
+
+        res = heatshrink_decoder_poll(&update->hsd,
+                                      &update->buf[update->cur][update->fill],
+                                      FW_UPDATE_BUF_SIZE - update->fill, &n);
+        if (res < 0) {
+            return -EINVAL;
+        }
+        if (update->pos + update->fill + n > update->size) {
+            return -EFBIG;
+        }
+        update->fill += n;
+        if (update->fill == FW_UPDATE_BUF_SIZE) {
+            int err = _submit(update);
+            if (err < 0) {
+                return err;
+            }
+        }
+    } while (res == HSDR_POLL_MORE);
+
+    return 0;
+}
+#endif
+
+int fw_update_start(fw_update_t *update, mtd_dev_t *mtd, uint32_t offset,
+                    uint32_t size, unsigned flags)
+{
+    assert(update && mtd);
+
+    if (offset % (mtd->pages_per_sector * mtd->page_size) != 0) {
+        return -EINVAL;
+    }
+#ifdef MODULE_HEATSHRINK
+    update->flags = flags;
+    heatshrink_decoder_reset(&update->hsd);
+#else
+    if (flags & FW_UPDATE_COMPRESSED) {
+        return -ENOTSUP;
+    }
+#endif
+
+    update->mtd = mtd;
+    update->offset = offset;
+    update->size = size;
+    update->pos = 0;
+    update->erased = 0;
+    update->fill = 0;
+    update->cur = 0;
+    update->error = 0;
+#ifdef MODULE_FW_UPDATE_DELTA
+    update->src_mtd = NULL;
+#endif
+    mutex_init(&update->busy);
+    sha256_init(&update->sha);
+    _update = update;
+
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), FW_UPDATE_PRIO,
+                             THREAD_CREATE_STACKTEST, _writer_thread, NULL,
+                             "fw_update");
+    }
+
+    return 0;
+}
+
+int fw_update_write(fw_update_t *update, const void *data, size_t len)
+{
+    if (update->error) {
+        return update->error;
+    }
+
+#ifdef MODULE_HEATSHRINK
+    if (update->flags & FW_UPDATE_COMPRESSED) {
+        /* the decoder does not modify its input */
+        uint8_t *in = (uint8_t *)data;
+
+        while (len) {
+            size_t n;
+
+            if (heatshrink_decoder_sink(&update->hsd, in, len, &n) < 0) {
+                return -EINVAL;
+            }
+            in += n;
+            len -= n;
+
+            int res = _decompress(update);
+            if (res < 0) {
+                return res;
+            }
+        }
+        return 0;
+    }
+#endif
+
+    return _output(update, data, len);
+}
+
+int fw_update_finish(fw_update_t *update,
+                     const uint8_t digest[SHA256_DIGEST_LENGTH])
+{
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    int res = update->error;
+
+#ifdef MODULE_HEATSHRINK
+    if ((res == 0) && (update->flags & FW_UPDATE_COMPRESSED)) {
+        HSD_finish_res fin;
+
+        while ((fin = heatshrink_decoder_finish(&update->hsd)) ==
+               HSDR_FINISH_MORE) {
+            res = _decompress(update);
+            if (res < 0) {
+                break;
+            }
+        }
+        if ((res == 0) && (fin < 0)) {
+            res = -EINVAL;
+        }
+    }
+#endif
+
+#ifdef MODULE_FW_UPDATE_DELTA
+    if ((res == 0) && update->src_mtd) {
+        res = fw_update_delta_finish(update);
+    }
+#endif
+
+    if ((res == 0) && update->fill) {
+        res = _submit(update);
+    }
+
+    /* the writer must be idle before update may be reused */
+    int err = fw_update_wait(update);
+    if (res == 0) {
+        res = err;
+    }
+    if (res < 0) {
+        return res;
+    }
+
+    sha256_final(&update->sha, hash);
+    if (digest && (memcmp(hash, digest, sizeof(hash)) != 0)) {
+        DEBUG("fw_update: digest mismatch\n");
+        return -EBADMSG;
+    }
+
+    return update->pos;
+}
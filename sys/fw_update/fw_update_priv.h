@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fw_update
+ * @{
+ *
+ * @file
+ * @brief       Functions shared by the fw_update implementation files
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef FW_UPDATE_PRIV_H
+#define FW_UPDATE_PRIV_H
+
+#include "fw_update.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Append bytes to the image written to the slot
+ */
+int fw_update_append(fw_update_t *update, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Wait until the writer thread is idle
+ *
+ * @return  first error of the writer thread, 0 if none
+ */
+int fw_update_wait(fw_update_t *update);
+
+/**
+ * @brief   Apply the next bytes of a delta patch
+ */
+int fw_update_delta_write(fw_update_t *update, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Check that the delta patch ended with a complete operation
+ */
+int fw_update_delta_finish(fw_update_t *update);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_UPDATE_PRIV_H */
+/** @} */
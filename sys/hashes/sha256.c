@@ -122,41 +122,83 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+/*
+ * One round of the compression function. The working variables are renamed
+ * by the caller instead of being moved, only d and h are written.
+ */
+#define RND(a, b, c, d, e, f, g, h, w, k)           \
+    do {                                            \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + (w) + (k); \
+        d += t0;                                    \
+        h = t0 + S0(a) + Maj(a, b, c);              \
+    } while (0)
+
+/* Next word of the message schedule, in the window of the last 16 words */
+#define MSG(W, i)   (W[(i) & 15] += s1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] + \
+                                    s0(W[((i) - 15) & 15]))
+
+/* Eight rounds, after which the working variables are back in place */
+#define RND8(W, i, w)                                       \
+    do {                                                    \
+        RND(a, b, c, d, e, f, g, h, w(W, (i) + 0), K[(i) + 0]); \
+        RND(h, a, b, c, d, e, f, g, w(W, (i) + 1), K[(i) + 1]); \
+        RND(g, h, a, b, c, d, e, f, w(W, (i) + 2), K[(i) + 2]); \
+        RND(f, g, h, a, b, c, d, e, w(W, (i) + 3), K[(i) + 3]); \
+        RND(e, f, g, h, a, b, c, d, w(W, (i) + 4), K[(i) + 4]); \
+        RND(d, e, f, g, h, a, b, c, w(W, (i) + 5), K[(i) + 5]); \
+        RND(c, d, e, f, g, h, a, b, w(W, (i) + 6), K[(i) + 6]); \
+        RND(b, c, d, e, f, g, h, a, w(W, (i) + 7), K[(i) + 7]); \
+    } while (0)
+
+/* Word of the message block itself */
+#define BLK(W, i)   (W[i])
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
+ *
+ * The rounds are unrolled eight at a time, which keeps the working variables
+ * in registers on Cortex-M, and the message schedule is computed along the
+ * rounds in a window of 16 words.
  */
 static void sha256_transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    unsigned i;
 
-    /* 1. Prepare message schedule W. */
     be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+    for (i = 0; i < 16; i += 8) {
+        RND8(W, i, BLK);
     }
-
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
-
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
-
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
-
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+    for (; i < 64; i += 8) {
+        RND8(W, i, MSG);
     }
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/* Compresses numof complete blocks, with the hash engine if there is one */
+static void sha256_transform_blocks(uint32_t *state, const unsigned char *blocks,
+                                    size_t numof)
+{
+#ifdef MODULE_SHA256_HW
+    size_t done = sha256_hw_transform(state, blocks, numof);
+
+    blocks += done * SHA256_INTERNAL_BLOCK_SIZE;
+    numof -= done;
+#endif
+    while (numof--) {
+        sha256_transform(state, blocks);
+        blocks += SHA256_INTERNAL_BLOCK_SIZE;
     }
 }
 
@@ -231,16 +273,14 @@ void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha256_transform(ctx->state, ctx->buf);
+    sha256_transform_blocks(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
     /* Perform complete blocks */
-    while (len >= 64) {
-        sha256_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
-    }
+    sha256_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~0x3f;
+    len &= 0x3f;
 
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_arena   Arena allocator
+ * @ingroup     sys
+ * @brief       Scoped bump allocation with O(1) release
+ *
+ * An arena hands out memory from a caller provided region by bumping an
+ * offset. Single allocations are never freed; instead, a handler takes a mark
+ * of the arena when it starts and resets the arena to that mark when it is
+ * done, which releases everything it allocated at once. This suits parsers
+ * and message handlers that allocate many small objects with the lifetime of
+ * the request they process, without the fragmentation and bookkeeping of a
+ * heap.
+ *
+ * The region can be a static array or be taken once at boot time from
+ * @ref oneway_malloc.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static uint8_t _buf[512];
+ * static arena_t _arena;
+ *
+ * arena_init(&_arena, _buf, sizeof(_buf));
+ * ...
+ * arena_mark_t mark = arena_mark(&_arena);
+ * token_t *tokens = arena_alloc(&_arena, num * sizeof(token_t));
+ * ...
+ * arena_reset(&_arena, mark);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @note    An arena is not thread-safe, it is meant to be owned by the one
+ *          thread that handles a request.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Arena allocator interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Alignment of the memory returned by arena_alloc()
+ *
+ * Must be a power of two.
+ */
+#ifndef ARENA_ALIGN
+#define ARENA_ALIGN     (sizeof(void *))
+#endif
+
+/**
+ * @brief   Arena
+ */
+typedef struct {
+    uint8_t *buf;       /**< managed region */
+    size_t size;        /**< size of arena_t::buf */
+    size_t pos;         /**< offset of the first free byte in arena_t::buf */
+} arena_t;
+
+/**
+ * @brief   Position in an arena that it can be reset to
+ */
+typedef size_t arena_mark_t;
+
+/**
+ * @brief   Initialize an arena
+ *
+ * @param[out] arena    arena to initialize
+ * @param[in] buf       memory region the arena allocates from
+ * @param[in] size      size of @p buf in bytes
+ */
+void arena_init(arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief   Allocate memory from an arena
+ *
+ * @param[in,out] arena arena to allocate from
+ * @param[in] size      number of bytes to allocate
+ *
+ * @return  pointer to @p size bytes aligned to @ref ARENA_ALIGN
+ * @return  NULL, if the arena has no room for @p size bytes
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief   Allocate zeroed memory from an arena
+ *
+ * @param[in,out] arena arena to allocate from
+ * @param[in] size      number of bytes to allocate
+ *
+ * @return  pointer to @p size zeroed bytes aligned to @ref ARENA_ALIGN
+ * @return  NULL, if the arena has no room for @p size bytes
+ */
+void *arena_calloc(arena_t *arena, size_t size);
+
+/**
+ * @brief   Get the current position of an arena
+ *
+ * @param[in] arena     arena
+ *
+ * @return  mark to pass to arena_reset()
+ */
+static inline arena_mark_t arena_mark(const arena_t *arena)
+{
+    return arena->pos;
+}
+
+/**
+ * @brief   Release all memory allocated from an arena since @p mark was
+ *          taken
+ *
+ * Marks taken after @p mark become invalid.
+ *
+ * @param[in,out] arena arena
+ * @param[in] mark      mark taken with arena_mark()
+ */
+static inline void arena_reset(arena_t *arena, arena_mark_t mark)
+{
+    arena->pos = mark;
+}
+
+/**
+ * @brief   Release all memory allocated from an arena
+ *
+ * @param[in,out] arena arena
+ */
+static inline void arena_clear(arena_t *arena)
+{
+    arena->pos = 0;
+}
+
+/**
+ * @brief   Get the number of bytes left in an arena
+ *
+ * Alignment may make less than that available to the next allocation.
+ *
+ * @param[in] arena     arena
+ *
+ * @return  number of unused bytes
+ */
+static inline size_t arena_available(const arena_t *arena)
+{
+    return arena->size - arena->pos;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
+/** @} */
@@ -24,6 +24,27 @@
  *              initialized only once, so do not call a module's init function
  *              when using auto_init unless you know what you're doing.
  *
+ * Every module is initialized by a step named like the module, e.g.
+ * `sdcard_spi` or `saul_gpio`. Steps that are slow, e.g. because they probe
+ * hardware, need not delay the start of @e main:
+ *
+ * - steps listed in `AUTO_INIT_DEFERRED` in the application's Makefile are
+ *   run after @e main was started, in a thread of lower priority
+ *   (see auto_init_deferred_wait())
+ * - steps listed in `AUTO_INIT_LAZY` are not run at all, until the code using
+ *   the module requests them by calling auto_init_lazy()
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * AUTO_INIT_DEFERRED += gnrc_rpl
+ * AUTO_INIT_LAZY += sdcard_spi
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Steps keep their order within each of these phases. A step must not be
+ * deferred when a step run at boot relies on it.
+ *
+ * With the `auto_init_profile` module, the time each step takes is recorded.
+ * The shell command `autoinit` prints it.
+ *
  * @{
  *
  * @file
@@ -36,10 +57,45 @@
 #ifndef AUTO_INIT_H
 #define AUTO_INIT_H
 
+#include <stdint.h>
+
+#include "thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Priority of the thread running the deferred steps
+ *
+ * Lower than main, so the deferred steps run while main is waiting.
+ */
+#ifndef AUTO_INIT_DEFERRED_PRIO
+#define AUTO_INIT_DEFERRED_PRIO         (THREAD_PRIORITY_MAIN + 1)
+#endif
+
+/**
+ * @brief   Stack size of the thread running the deferred steps
+ */
+#ifndef AUTO_INIT_DEFERRED_STACKSIZE
+#define AUTO_INIT_DEFERRED_STACKSIZE    (THREAD_STACKSIZE_MAIN)
+#endif
+
+/**
+ * @brief   Maximum number of steps recorded by `auto_init_profile`
+ */
+#ifndef AUTO_INIT_PROFILE_NUMOF
+#define AUTO_INIT_PROFILE_NUMOF         (32U)
+#endif
+
+/**
+ * @brief   Time an initialization step took
+ */
+typedef struct {
+    const char *name;       /**< name of the step */
+    uint32_t usec;          /**< duration in microseconds */
+} auto_init_profile_t;
+
 /**
  * @brief Initializes all high level modules that do not require parameters for
  *        initialization or uses default values.
@@ -49,6 +105,36 @@ extern "C" {
  */
 void auto_init(void);
 
+/**
+ * @brief   Wait until the deferred steps are done
+ *
+ * Returns immediately if there are no deferred steps.
+ */
+void auto_init_deferred_wait(void);
+
+/**
+ * @brief   Run the lazy step @p name, if it did not run yet
+ *
+ * Meant to be called by the code using a module before each use of it.
+ * Returns once the step is done, also if another thread requested it first.
+ * Does nothing if @p name is not a lazy step.
+ *
+ * @param[in] name      name of the step
+ */
+void auto_init_lazy(const char *name);
+
+/**
+ * @brief   Get the recorded durations of the initialization steps
+ *
+ * Steps are listed in the order they finished. Only available with the
+ * `auto_init_profile` module.
+ *
+ * @param[out] numof    number of entries
+ *
+ * @return  array of @p numof entries
+ */
+const auto_init_profile_t *auto_init_profile(unsigned *numof);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_benchmark Benchmark
+ * @ingroup     sys
+ * @brief       Run a piece of code a number of times and report its runtime
+ *
+ * The runtime is measured with the finest time source available on the
+ * platform:
+ *
+ * - the DWT cycle counter (CYCCNT) on Cortex-M3, M4, M4F and M7, the result
+ *   is given in CPU cycles
+ * - `clock_gettime()` on `native`, the result is given in nanoseconds
+ * - xtimer (or the peripheral timer @ref BENCHMARK_TIMER if xtimer is not
+ *   used) everywhere else, the result is given in timer ticks
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * BENCHMARK_FUNC("mutex_lock/unlock", 10000UL,
+ *                mutex_lock(&lock);
+ *                mutex_unlock(&lock));
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * prints
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ * mutex_lock/unlock: 10000 runs, 58.12 cycles per run
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The counters are 32 bit wide, so a single measurement must not take longer
+ * than one wrap around of the time source (e.g. ~67s for a 64MHz CPU clock).
+ * Interrupts are not disabled during the measurement, as this would prevent
+ * benchmarking anything that involves a context switch.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Micro-benchmark interface
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Unit of the values returned by benchmark_now()
+ */
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7) || \
+    defined(DOXYGEN)
+#define BENCHMARK_UNIT      "cycles"
+#elif defined(CPU_NATIVE)
+#define BENCHMARK_UNIT      "ns"
+#else
+#define BENCHMARK_UNIT      "ticks"
+#endif
+
+/**
+ * @brief   Timer to use if neither a cycle counter nor xtimer is available
+ */
+#ifndef BENCHMARK_TIMER
+#define BENCHMARK_TIMER     TIMER_DEV(0)
+#endif
+
+/**
+ * @brief   Frequency @ref BENCHMARK_TIMER is configured to
+ */
+#ifndef BENCHMARK_TIMER_HZ
+#define BENCHMARK_TIMER_HZ  (1000000ul)
+#endif
+
+/**
+ * @brief   Run @p func @p runs times and print the time per run
+ *
+ * @param[in] name      name of the benchmark, used in the output
+ * @param[in] runs      number of times to run @p func
+ * @param[in] func      the code to benchmark, may be any statement(s)
+ */
+#define BENCHMARK_FUNC(name, runs, func)                                    \
+    do {                                                                    \
+        uint32_t _benchmark_start = benchmark_now();                        \
+        for (unsigned long _benchmark_i = 0; _benchmark_i < (runs);         \
+             _benchmark_i++) {                                              \
+            func;                                                           \
+        }                                                                   \
+        benchmark_print(name, benchmark_now() - _benchmark_start, (runs));  \
+    } while (0)
+
+/**
+ * @brief   Initialize and start the time source
+ *
+ * This function is called by auto_init.
+ */
+void benchmark_init(void);
+
+/**
+ * @brief   Read the current value of the time source
+ *
+ * @return  current time in @ref BENCHMARK_UNIT
+ */
+uint32_t benchmark_now(void);
+
+/**
+ * @brief   Print the result of a benchmark
+ *
+ * @param[in] name      name of the benchmark
+ * @param[in] total     time all runs took together, in @ref BENCHMARK_UNIT
+ * @param[in] runs      number of runs
+ */
+void benchmark_print(const char *name, uint32_t total, unsigned long runs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H */
+/** @} */
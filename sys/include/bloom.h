@@ -148,8 +148,46 @@ typedef struct {
     uint8_t *a;
     /** the hash functions */
     hashfp_t *hash;
+    /** derive the k probes from hash[0] and hash[1] */
+    bool double_hashing;
 } bloom_t;
 
+/**
+ * @brief Number of counters that fit into one byte of a counting Bloom filter
+ */
+#define BLOOM_COUNTERS_PER_BYTE (2U)
+
+/**
+ * @brief Largest value of a counter, a counter that reached it is never
+ *        decremented again
+ */
+#define BLOOM_COUNTER_MAX (15U)
+
+/**
+ * @brief Declare the counters of a counting Bloom filter with a given number
+ *        of counters
+ */
+#define BLOOM_COUNTERS(NAME, SIZE) \
+    uint8_t NAME[((SIZE) + BLOOM_COUNTERS_PER_BYTE - 1) / BLOOM_COUNTERS_PER_BYTE]
+
+/**
+ * @brief bloom_counting_t counting Bloom filter object
+ *
+ * Every position of the filter is a 4-bit counter instead of a bit, so
+ * strings can be removed again. The probes are always derived by double
+ * hashing.
+ */
+typedef struct {
+    /** number of counters */
+    size_t m;
+    /** number of probes */
+    size_t k;
+    /** the counters, see @ref BLOOM_COUNTERS */
+    uint8_t *c;
+    /** the two hash functions */
+    hashfp_t *hash;
+} bloom_counting_t;
+
 /**
  * @brief Initialize a Bloom Filter.
  *
@@ -165,6 +203,26 @@ typedef struct {
  */
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof);
 
+/**
+ * @brief Initialize a Bloom Filter that uses double hashing.
+ *
+ * Only two hash functions are computed per string, the @p k probes are
+ * derived from them by enhanced double hashing (Kirsch and Mitzenmacher,
+ * "Less Hashing, Same Performance: Building a Better Bloom Filter"). The
+ * false positive rate stays about the same as with @p k independent hash
+ * functions, but a string is only read twice.
+ *
+ * @param bloom             bloom_t to initialize
+ * @param size              size of the bloom filter in bits
+ * @param bitfield          underlying bitfield of the bloom filter
+ * @param hashes            array of two hashes
+ * @param k                 number of probes per string
+ *
+ * @pre     @p bitfield MUST be large enough to hold @p size bits.
+ * @pre     @p size MUST be at least 2.
+ */
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, size_t k);
+
 /**
  * @brief Delete a Bloom filter.
  *
@@ -228,6 +286,58 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @brief Initialize a counting Bloom Filter.
+ *
+ * @param bloom             bloom_counting_t to initialize
+ * @param size              number of counters
+ * @param counters          underlying counters, zeroed
+ * @param hashes            array of two hashes
+ * @param k                 number of probes per string
+ *
+ * @pre     @p counters MUST be declared with BLOOM_COUNTERS() for at least
+ *          @p size counters.
+ * @pre     @p size MUST be at least 2.
+ */
+void bloom_counting_init(bloom_counting_t *bloom, size_t size, uint8_t *counters,
+                         hashfp_t *hashes, size_t k);
+
+/**
+ * @brief Add a string to a counting Bloom filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Remove a string from a counting Bloom filter.
+ *
+ * Removing a string that was never added may remove other strings from the
+ * filter, so only remove strings that were added before.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to remove
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if the string was not in the filter, nothing changed
+ * @return       true if the string was removed
+ */
+bool bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a string is in a counting Bloom filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_counting_check(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -100,6 +100,33 @@ int conn_can_raw_close(conn_can_raw_t *conn);
  */
 int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t timeout);
 
+/**
+ * @brief  Receive several CAN frames without copying them
+ *
+ * Waits for a first frame, then takes all frames already queued on @p conn,
+ * up to @p max. The frames stay in the CAN stack packets, @p frames is filled
+ * with references to them which must be given back with
+ * conn_can_raw_release().
+ *
+ * @param[in] conn          CAN connection
+ * @param[out] frames       references to the received frames
+ * @param[in] max           number of entries in @p frames
+ * @param[in] timeout       timeout in us for the first frame, 0 for infinite
+ *
+ * @return the number of frames received
+ * @return any other negative number in case of an error
+ */
+int conn_can_raw_recv_batch(conn_can_raw_t *conn, struct can_frame **frames,
+                            size_t max, uint32_t timeout);
+
+/**
+ * @brief  Release frames received by conn_can_raw_recv_batch()
+ *
+ * @param[in] frames        references to the frames
+ * @param[in] count         number of frames in @p frames
+ */
+void conn_can_raw_release(struct can_frame **frames, size_t count);
+
 /**
  * @brief  Generic can send
  *
@@ -71,6 +71,7 @@ typedef struct candev_dev {
     int ifnum;        /**< interface number */
     kernel_pid_t pid; /**< pid */
     const char *name; /**< device name */
+    volatile uint8_t isr_pending; /**< set while an ISR event is queued */
 #if defined(MODULE_CAN_TRX) || defined(DOXYGEN)
     can_trx_t *trx;   /**< transceiver attached to the device */
 #endif
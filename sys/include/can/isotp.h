@@ -31,6 +31,15 @@ extern "C" {
 #include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
 
+#ifndef CAN_ISOTP_TX_PIPELINE
+/**
+ * @brief Maximum number of consecutive frames queued to the DLL at once
+ *
+ * This is only used when the receiver asks for no separation time, it should
+ * match the number of TX mailboxes of the controller.
+ */
+#define CAN_ISOTP_TX_PIPELINE   (3U)
+#endif
 
 /**
  * @brief The isotp_fc_options struct
@@ -95,6 +104,8 @@ struct isotp {
     can_reg_entry_t entry;         /**< entry containing ifnum and upper layer msg system */
     uint32_t tx_gap;               /**< transmit gap from fc (in us) */
     uint8_t tx_wft;                /**< transmit wait counter */
+    uint8_t tx_pending;            /**< number of frames waiting for a tx confirmation */
+    int tx_handles[CAN_ISOTP_TX_PIPELINE]; /**< handles of the pending frames */
     void *arg;                     /**< upper layer private arg */
 };
 
@@ -166,6 +177,20 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags);
  */
 int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg);
 
+/**
+ * @brief Set the flow control options sent by a bound isotp channel
+ *
+ * @p fc replaces the default block size and separation time advertised to a
+ * sender, it is used from the next flow control frame on.
+ *
+ * @param isotp           the bound channel
+ * @param fc              the flow control options
+ *
+ * @return 0 on success
+ * @return -EINVAL if the separation time is a reserved value
+ */
+int isotp_set_rxfc(struct isotp *isotp, const struct isotp_fc_options *fc);
+
 /**
  * @brief Release a bound isotp channel
  *
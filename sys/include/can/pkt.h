@@ -35,6 +35,15 @@ extern "C" {
 #include "mbox.h"
 #endif
 
+#ifndef CAN_PKT_RX_POOL_SIZE
+/**
+ * @brief Number of received CAN packets allocated from a static pool
+ *
+ * Received packets are taken from the packet buffer once the pool is empty.
+ */
+#define CAN_PKT_RX_POOL_SIZE (32U)
+#endif
+
 /**
  * @brief A CAN packet
  *
@@ -45,7 +54,7 @@ typedef struct {
     atomic_uint ref_count;   /**< Reference counter (for rx frames) */
     int handle;              /**< handle (for tx frames */
     struct can_frame frame;  /**< CAN Frame */
-    gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip */
+    gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip, NULL if pooled */
 } can_pkt_t;
 
 /**
@@ -72,6 +81,9 @@ can_pkt_t *can_pkt_alloc_tx(int ifnum, const struct can_frame *frame, kernel_pid
 /**
  * @brief Allocate an incoming CAN packet
  *
+ * The packet is taken from the RX pool, or from the packet buffer if the
+ * pool is exhausted.
+ *
  * @param[in] ifnum  the interface number
  * @param[in] frame  the received frame
  *
@@ -29,6 +29,37 @@ extern "C" {
 #include "can/can.h"
 #include "can/pkt.h"
 
+/**
+ * @brief Number of hash buckets per interface for exact match filters
+ *
+ * Filters with a mask of @ref CAN_ROUTER_EXACT_MASK are kept in a hash by
+ * their CAN ID, so a received frame only looks at one bucket of them. All
+ * other filters are checked one by one.
+ */
+#ifndef CAN_ROUTER_HASH_SIZE
+#define CAN_ROUTER_HASH_SIZE    (16U)
+#endif
+
+/**
+ * @brief Number of filters allocated from a static pool
+ *
+ * Filters are taken from the packet buffer once the pool is empty.
+ */
+#ifndef CAN_ROUTER_FILTER_POOL_SIZE
+#define CAN_ROUTER_FILTER_POOL_SIZE (16U)
+#endif
+
+/**
+ * @brief Mask of a filter that matches exactly one CAN ID, flags included
+ */
+#define CAN_ROUTER_EXACT_MASK   (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_ERR_FLAG | \
+                                 CAN_EFF_MASK)
+
+/**
+ * @brief Initialize the router
+ */
+void can_router_init(void);
+
 /**
  * @brief Register a user @p entry to receive a frame @p can_id
  *
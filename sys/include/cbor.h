@@ -98,6 +98,35 @@
  *
  * @see [RFC7049, section 2.4](https://tools.ietf.org/html/rfc7049#section-2.3)
  *
+ * # Streaming
+ * Documents larger than the available RAM can be encoded into a small buffer
+ * that is passed on to a @ref cbor_flush_t callback (e.g. to a sock, a file or
+ * a CoAP block) whenever it is full, see cbor_init_flush(). Byte and text
+ * strings that do not fit into the buffer are passed on directly.
+ *
+ * Fragmented input is decoded with a @ref cbor_reader_t, which reads more data
+ * into its buffer when the next item is incomplete:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * unsigned char buf[64];
+ * cbor_reader_t reader;
+ * size_t offset = 0, read;
+ * int val;
+ *
+ * cbor_reader_init(&reader, buf, sizeof(buf), my_read, &my_sock);
+ * while (1) {
+ *     if ((read = cbor_deserialize_int(&reader.stream, offset, &val)) > 0) {
+ *         offset += read;
+ *         // (...)
+ *     }
+ *     else if (cbor_reader_fill(&reader, &offset) <= 0) {
+ *         break;  // end of input or error
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Every single item must fit into the buffer of the reader.
+ *
  * @todo API for Indefinite-Length Byte Strings and Text Strings
  *       (see https://tools.ietf.org/html/rfc7049#section-2.2.2)
  * @{
@@ -119,6 +148,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <sys/types.h>
 
 #ifdef MODULE_CBOR_CTIME
 #include <time.h>
@@ -128,6 +158,31 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Signature of functions the encoded data is passed on to
+ *
+ * @param[in] data  encoded data
+ * @param[in] len   length of @p data in bytes
+ * @param[in] arg   argument given to cbor_init_flush()
+ *
+ * @return  0 on success
+ * @return  negative value if the data could not be passed on
+ */
+typedef int (*cbor_flush_t)(const unsigned char *data, size_t len, void *arg);
+
+/**
+ * @brief Signature of functions reading input for a @ref cbor_reader_t
+ *
+ * @param[out] buf  buffer to read into
+ * @param[in] len   size of @p buf in bytes
+ * @param[in] arg   argument given to cbor_reader_init()
+ *
+ * @return  number of bytes read into @p buf
+ * @return  0 at the end of the input
+ * @return  negative value on error
+ */
+typedef ssize_t (*cbor_read_t)(unsigned char *buf, size_t len, void *arg);
+
 /**
  * @brief Struct containing CBOR-encoded data
  *
@@ -153,8 +208,25 @@ typedef struct {
     unsigned char *data;    /**< Array containing CBOR encoded data */
     size_t size;            /**< Size of the array */
     size_t pos;             /**< Index to the next free byte */
+    cbor_flush_t flush;     /**< Function the data is passed on to when the
+                             *   array is full, may be NULL */
+    void *arg;              /**< Argument for cbor_stream_t::flush */
 } cbor_stream_t;
 
+/**
+ * @brief Decoder for input that arrives in fragments
+ *
+ * @see cbor_reader_init
+ * @see cbor_reader_fill
+ */
+typedef struct {
+    cbor_stream_t stream;   /**< Stream to deserialize the data read so far
+                             *   from */
+    cbor_read_t read;       /**< Function to read more input */
+    void *arg;              /**< Argument for cbor_reader_t::read */
+    size_t capacity;        /**< Size of the buffer of cbor_reader_t::stream */
+} cbor_reader_t;
+
 /**
  * @brief Initialize cbor struct
  *
@@ -165,6 +237,64 @@ typedef struct {
  */
 void cbor_init(cbor_stream_t *stream, unsigned char *buffer, size_t size);
 
+/**
+ * @brief Initialize cbor struct for streaming encoding
+ *
+ * Whenever @p buffer is too full for the next item, its contents are passed
+ * to @p flush and it is cleared. Call cbor_flush() after the last item.
+ *
+ * @note Does *not* take ownership of @p buffer
+ * @param[in] stream The cbor struct to initialize
+ * @param[in] buffer The buffer used for storing CBOR-encoded data
+ * @param[in] size   The size of buffer @p buffer
+ * @param[in] flush  Function the encoded data is passed on to
+ * @param[in] arg    Argument passed to @p flush
+ */
+void cbor_init_flush(cbor_stream_t *stream, unsigned char *buffer, size_t size,
+                     cbor_flush_t flush, void *arg);
+
+/**
+ * @brief Pass the encoded data of @p stream on and clear it
+ *
+ * Does nothing for streams without cbor_stream_t::flush function.
+ *
+ * @param[in, out] stream Pointer to the cbor struct
+ *
+ * @return  0 on success
+ * @return  negative value returned by cbor_stream_t::flush on error
+ */
+int cbor_flush(cbor_stream_t *stream);
+
+/**
+ * @brief Initialize a reader for fragmented input
+ *
+ * @param[out] reader The reader to initialize
+ * @param[in] buffer  The buffer the input is read into
+ * @param[in] size    The size of buffer @p buffer, **must** be large enough
+ *                    for any single item of the input
+ * @param[in] read    Function to read input with
+ * @param[in] arg     Argument passed to @p read
+ */
+void cbor_reader_init(cbor_reader_t *reader, unsigned char *buffer, size_t size,
+                      cbor_read_t read, void *arg);
+
+/**
+ * @brief Read more input into @p reader
+ *
+ * Call this when deserializing the item at @p offset from
+ * cbor_reader_t::stream failed, because it is incomplete. All data before
+ * @p offset is dropped to make room, so @p offset is set to 0.
+ *
+ * @param[in, out] reader The reader
+ * @param[in, out] offset The offset of the first item not deserialized yet
+ *
+ * @return  number of bytes read
+ * @return  0 at the end of the input
+ * @return  -ENOBUFS if the item at @p offset does not fit into the buffer
+ * @return  other negative values returned by cbor_reader_t::read on error
+ */
+ssize_t cbor_reader_fill(cbor_reader_t *reader, size_t *offset);
+
 /**
  * @brief Clear cbor struct
  *
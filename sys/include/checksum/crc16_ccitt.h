@@ -22,6 +22,9 @@
  *              does (and is thus also for more memory efficient). Its caveat
  *              however is that it is slower by about factor 8 than this version.
  *
+ *              Setting @ref CRC16_CCITT_SLICE_BY_4 to 1 processes four bytes
+ *              at once with three additional lookup tables (1.5 KiB in ROM).
+ *
  * @{
  * @file
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
@@ -37,6 +40,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Use the four table (slice-by-4) implementation
+ */
+#ifndef CRC16_CCITT_SLICE_BY_4
+#define CRC16_CCITT_SLICE_BY_4  (0)
+#endif
+
 /**
  * @brief           Update CRC16-CCITT
  *
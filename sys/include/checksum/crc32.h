@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32  CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 checksum algorithm
+ * @details     This is the CRC32 of IEEE 802.3, zlib and PNG (reflected
+ *              polynomial 0xEDB88320, start value and final XOR 0xFFFFFFFF),
+ *              the checksum of "123456789" is 0xCBF43926.
+ *
+ *              The default implementation processes four bytes at once with
+ *              four lookup tables (4 KiB in ROM), setting @ref CRC32_SLICE_BY_4
+ *              to 0 selects a single lookup table (1 KiB in ROM). With the
+ *              `periph_crc` feature the CRC unit of the MCU computes the
+ *              word aligned part of the data, unless it is busy.
+ *
+ * @{
+ * @file
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef CHECKSUM_CRC32_H
+#define CHECKSUM_CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Use the four table (slice-by-4) implementation
+ */
+#ifndef CRC32_SLICE_BY_4
+#define CRC32_SLICE_BY_4    (1)
+#endif
+
+/**
+ * @brief           Update CRC32
+ *
+ * @param[in]  crc  A start value for the CRC calculation, usually the
+ *                  return value of a previous call to crc32_calc() or
+ *                  crc32_update()
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area based on the
+ *                  given start value
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+static inline uint32_t crc32_calc(const void *buf, size_t len)
+{
+    return crc32_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC32_H */
+
+/** @} */
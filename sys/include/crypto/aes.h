@@ -123,6 +123,17 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+#if defined(MODULE_CRYPTO_AES_HW) || defined(DOXYGEN)
+/**
+ * @brief   AES interface of a hardware engine
+ *
+ * Provided by the CPU if the crypto_aes_hw module is used, CIPHER_AES_128
+ * refers to it then. It initializes the context with aes_init() and uses
+ * aes_encrypt() and aes_decrypt() whenever the engine is not available.
+ */
+extern const cipher_interface_t aes_hw_interface;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
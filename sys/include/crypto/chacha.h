@@ -68,6 +68,21 @@ int chacha_init(chacha_ctx *ctx,
                 const uint8_t *key, uint32_t keylen,
                 const uint8_t nonce[8]);
 
+/**
+ * @brief Generate the next blocks of the keystream.
+ *
+ * @details If you want to seek inside the cipher steam, then you have to
+ *          update the clock in `ctx->state[13]:ctx->state[12]` manually.
+ *
+ * @warning You need to re-initialized the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx   The ChaCha context
+ * @param[out]    x     The blocks of the keystream (`sizeof(x) == 64 * numof`).
+ * @param[in]     numof Number of blocks to generate.
+ */
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t numof);
+
 /**
  * @brief Generate next block in the keystream.
  *
@@ -80,7 +95,28 @@ int chacha_init(chacha_ctx *ctx,
  * @param[in,out] ctx The ChaCha context
  * @param[out]    x   The block of the keystream (`sizeof(x) == 64`).
  */
-void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
+static inline void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
+{
+    chacha_keystream_blocks(ctx, x, 1);
+}
+
+/**
+ * @brief Encode or decode a buffer.
+ *
+ * @details @p m is always the input regardless if it is the plaintext or ciphertext,
+ *          and @p c vice verse. They may be the same buffer. A block of the
+ *          keystream is used for every 64 bytes, if @p len is not a multiple
+ *          of 64, the rest of the last block is discarded.
+ *
+ * @warning You need to re-initialized the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx The ChaCha context.
+ * @param[in]     m   The input.
+ * @param[out]    c   The output.
+ * @param[in]     len Length of @p m and @p c in bytes.
+ */
+void chacha_encrypt(chacha_ctx *ctx, const void *m, void *c, size_t len);
 
 /**
  * @brief Encode or decode a block of data.
@@ -95,16 +131,26 @@ void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
  * @param[in]     m   The input.
  * @param[out]    c   The output.
  */
-void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c);
+static inline void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
+{
+    chacha_encrypt(ctx, m, c, 64);
+}
 
 /**
  * @copydoc chacha_encrypt_bytes()
  */
 static inline void chacha_decrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
 {
-    chacha_encrypt_bytes(ctx, m, c);
+    chacha_encrypt(ctx, m, c, 64);
 }
 
+/**
+ * @brief Number of keystream blocks the PRNG generates at once.
+ */
+#ifndef CHACHA_PRNG_BLOCKS
+#define CHACHA_PRNG_BLOCKS  (4U)
+#endif
+
 /**
  * @brief Seed the pseudo-random number generator.
  *
@@ -125,6 +171,18 @@ static inline void chacha_decrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8
  */
 void chacha_prng_seed(const void *data, size_t bytes);
 
+/**
+ * @brief Mix fresh entropy into the pseudo-random number generator.
+ *
+ * @details Unlike chacha_prng_seed(), the data is XORed into the key part of
+ *          the state, so entropy of earlier seeds is kept. Numbers generated
+ *          before but not yet returned are dropped.
+ *
+ * @param[in] data  Some random data.
+ * @param[in] bytes Length of @p data in bytes where `0 < bytes <= 32`.
+ */
+void chacha_prng_reseed(const void *data, size_t bytes);
+
 /**
  * @brief Extract a number from the pseudo-random number generator.
  *
@@ -133,6 +191,17 @@ void chacha_prng_seed(const void *data, size_t bytes);
  */
 uint32_t chacha_prng_next(void);
 
+/**
+ * @brief Fill a buffer from the pseudo-random number generator.
+ *
+ * @details Takes the same numbers chacha_prng_next() would return, rounded up
+ *          to whole numbers.
+ *
+ * @param[out] buf  The buffer.
+ * @param[in]  len  Length of @p buf in bytes.
+ */
+void chacha_prng_bytes(void *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
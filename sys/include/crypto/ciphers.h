@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -63,6 +64,8 @@ extern "C" {
 #define CIPHER_ERR_INVALID_LENGTH     -4
 #define CIPHER_ERR_ENC_FAILED         -5
 #define CIPHER_ERR_DEC_FAILED         -6
+/** Returned by cipher_interface_st::process if the software modes are to be used */
+#define CIPHER_ERR_NOT_SUPPORTED      -7
 /** Is returned by the cipher_init functions, if the coresponding alogirithm has not been included in the build */
 #define CIPHER_ERR_BAD_CONTEXT_SIZE    0
 /**  Returned by cipher_init upon succesful initialization of a cipher. */
@@ -76,6 +79,15 @@ typedef struct {
 } cipher_context_t;
 
 
+/**
+ * @brief   Modes of operation a cipher implementation may process on its own
+ */
+typedef enum {
+    CIPHER_MODE_ECB,            /**< electronic code book */
+    CIPHER_MODE_CBC,            /**< cipher block chaining */
+    CIPHER_MODE_CTR,            /**< counter */
+} cipher_mode_t;
+
 /**
  * @brief   BlockCipher-Interface for the Cipher-Algorithms
  */
@@ -96,6 +108,22 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /**
+     * @brief   processes several blocks in a mode of operation at once, e.g.
+     *          with a hardware engine, may be NULL
+     *
+     * @p iv is the initialization vector for CBC and the nonce and counter
+     * for CTR, which must be advanced like the software CTR mode does it.
+     * @p nonce_len is only used for CTR.
+     *
+     * @return  the length of @p output
+     * @return  CIPHER_ERR_NOT_SUPPORTED to use the software mode instead
+     * @return  other negative value on error
+     */
+    int (*process)(const cipher_context_t* ctx, cipher_mode_t mode,
+                   int encrypt, uint8_t* iv, uint8_t nonce_len,
+                   const uint8_t* input, size_t length, uint8_t* output);
 } cipher_interface_t;
 
 
@@ -165,6 +193,23 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_get_block_size(const cipher_t* cipher);
 
 
+/**
+ * @brief   Let the cipher implementation process several blocks in a mode of
+ *          operation, see cipher_interface_st::process
+ *
+ * This is used by the @ref sys_crypto_modes before they fall back to
+ * processing single blocks.
+ *
+ * @return  the length of @p output
+ * @return  CIPHER_ERR_NOT_SUPPORTED if the implementation does not support
+ *          this
+ * @return  other negative value on error
+ */
+int cipher_process(const cipher_t* cipher, cipher_mode_t mode, int encrypt,
+                   uint8_t* iv, uint8_t nonce_len, const uint8_t* input,
+                   size_t length, uint8_t* output);
+
+
 #ifdef __cplusplus
 }
 #endif
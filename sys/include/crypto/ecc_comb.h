@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_crypto_ecc_comb Fixed point ECC for micro-ecc
+ * @ingroup     sys_crypto
+ * @brief       ECDSA and ECDH with precomputed comb tables on top of
+ *              @ref pkg_micro_ecc
+ *
+ * The point multiplications of micro-ecc start from scratch for every
+ * operation. A comb table holds @ref ECC_COMB_POINTS multiples of one point,
+ * the generator or a public key that is used over and over again, e.g. the
+ * key of a firmware signer or of a DTLS peer. With a table a multiplication
+ * needs a quarter (with the default of four teeth) of the doublings and
+ * additions. Verification uses tables for both the generator and the public
+ * key and shares the doublings between them.
+ *
+ * A table only depends on its point, so it can be computed once with
+ * ecc_comb_init() and kept in RAM, or it can be computed on the host and
+ * stored as a constant in flash.
+ *
+ * The keys, signatures and shared secrets have the format of micro-ecc, so
+ * both can be mixed freely. Signing needs the RNG of micro-ecc (see
+ * @ref pkg_micro_ecc).
+ *
+ * The additions and table lookups for private scalars (signing, public key
+ * computation and ECDH) do not depend on the value of the scalar, the
+ * verification is not hardened as it only handles public values.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Fixed point ECC interface
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef CRYPTO_ECC_COMB_H
+#define CRYPTO_ECC_COMB_H
+
+#include <stdint.h>
+
+#include "uECC.h"
+#include "uECC_vli.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of teeth of the comb
+ *
+ * A multiplication needs (256 / ECC_COMB_TEETH) doublings and additions on
+ * secp256r1, a table holds 2^ECC_COMB_TEETH - 1 points.
+ */
+#ifndef ECC_COMB_TEETH
+#define ECC_COMB_TEETH      (4U)
+#endif
+
+/**
+ * @brief   Number of points in a table
+ */
+#define ECC_COMB_POINTS     ((1U << ECC_COMB_TEETH) - 1)
+
+/**
+ * @brief   Number of words of a coordinate of the largest curve
+ */
+#define ECC_COMB_WORDS      ((32 + sizeof(uECC_word_t) - 1) / sizeof(uECC_word_t))
+
+/**
+ * @brief   Maximum number of signatures that share their inversions in
+ *          ecc_comb_verify_batch()
+ */
+#ifndef ECC_COMB_BATCH_MAX
+#define ECC_COMB_BATCH_MAX  (4U)
+#endif
+
+/**
+ * @brief   Comb table of a point
+ */
+typedef struct {
+    uECC_Curve curve;   /**< the curve of the point */
+    /**
+     * @brief   points[i - 1] is the sum of the multiples
+     *          2^(j * d) * P for each bit j set in i, with
+     *          d = ceil(bits of the curve order / @ref ECC_COMB_TEETH),
+     *          as affine coordinates (x, y) in the native format of
+     *          the micro-ecc VLI API
+     */
+    uECC_word_t points[ECC_COMB_POINTS][2 * ECC_COMB_WORDS];
+} ecc_comb_t;
+
+/**
+ * @brief   A signature for ecc_comb_verify_batch()
+ */
+typedef struct {
+    const ecc_comb_t *key;      /**< table of the public key */
+    const uint8_t *hash;        /**< hash of the message */
+    unsigned hash_size;         /**< length of @p hash in bytes */
+    const uint8_t *signature;   /**< signature in the micro-ecc format */
+} ecc_comb_sig_t;
+
+/**
+ * @brief   Computes the table of a point
+ *
+ * @param[out] comb         table to compute
+ * @param[in] public_key    public key in the micro-ecc format, NULL for the
+ *                          generator of @p curve
+ * @param[in] curve         curve of @p public_key
+ *
+ * @return  1 on success
+ * @return  0 if @p public_key is not a valid point on @p curve
+ */
+int ecc_comb_init(ecc_comb_t *comb, const uint8_t *public_key,
+                  uECC_Curve curve);
+
+/**
+ * @brief   Computes the public key of a private key, like
+ *          uECC_compute_public_key()
+ *
+ * @param[in] g             table of the generator
+ * @param[in] private_key   private key
+ * @param[out] public_key   the public key
+ *
+ * @return  1 on success
+ * @return  0 if @p private_key is invalid
+ */
+int ecc_comb_compute_public_key(const ecc_comb_t *g, const uint8_t *private_key,
+                                uint8_t *public_key);
+
+/**
+ * @brief   Computes the ECDH shared secret with a public key, like
+ *          uECC_shared_secret()
+ *
+ * @param[in] key           table of the public key of the peer
+ * @param[in] private_key   own private key
+ * @param[out] secret       the shared secret, the size of a coordinate
+ *
+ * @return  1 on success
+ * @return  0 if @p private_key is invalid
+ */
+int ecc_comb_shared_secret(const ecc_comb_t *key, const uint8_t *private_key,
+                           uint8_t *secret);
+
+/**
+ * @brief   Signs a hash with a random nonce, like uECC_sign()
+ *
+ * @param[in] g             table of the generator
+ * @param[in] private_key   private key
+ * @param[in] hash          hash of the message
+ * @param[in] hash_size     length of @p hash in bytes
+ * @param[out] signature    the signature, twice the size of a coordinate
+ *
+ * @return  1 on success
+ * @return  0 if @p private_key is invalid or no RNG is available
+ */
+int ecc_comb_sign(const ecc_comb_t *g, const uint8_t *private_key,
+                  const uint8_t *hash, unsigned hash_size, uint8_t *signature);
+
+/**
+ * @brief   Verifies a signature, like uECC_verify()
+ *
+ * @param[in] g             table of the generator
+ * @param[in] key           table of the public key, on the curve of @p g
+ * @param[in] hash          hash of the message
+ * @param[in] hash_size     length of @p hash in bytes
+ * @param[in] signature     the signature
+ *
+ * @return  1 if the signature is valid
+ * @return  0 otherwise
+ */
+int ecc_comb_verify(const ecc_comb_t *g, const ecc_comb_t *key,
+                    const uint8_t *hash, unsigned hash_size,
+                    const uint8_t *signature);
+
+/**
+ * @brief   Verifies several signatures
+ *
+ * Groups of up to @ref ECC_COMB_BATCH_MAX signatures share one modular
+ * inversion, the most expensive step of a verification after the point
+ * multiplication.
+ *
+ * @param[in] g             table of the generator
+ * @param[in] sigs          the signatures, on the curve of @p g
+ * @param[in] numof         number of signatures in @p sigs
+ *
+ * @return  1 if all signatures are valid
+ * @return  0 otherwise
+ */
+int ecc_comb_verify_batch(const ecc_comb_t *g, const ecc_comb_sig_t *sigs,
+                          unsigned numof);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_ECC_COMB_H */
+/** @} */
@@ -81,6 +81,62 @@ int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
                        uint8_t length_encoding, uint8_t* nonce, size_t nonce_len,
                        uint8_t* input, size_t input_len, uint8_t* output);
 
+/**
+ * @brief Encrypt and authenticate data of arbitrary length in ccm* mode.
+ *
+ * CCM* as used by IEEE 802.15.4 additionally allows to only encrypt the data,
+ * with a @p mac_length of 0. Otherwise it is the same as cipher_encrypt_ccm().
+ * @p input and @p output may point to the same buffer.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data (maximum: 0xfeff)
+ * @param mac_length       length of the appended MAC (0 or between 4 and 16 -
+ *                         only even values)
+ * @param length_encoding  maximal supported length of plaintext
+ *                         (2^(8*length_enc)).
+ * @param nonce            Nounce for ctr mode encryption
+ * @param nonce_len        Length of the nonce in octets
+ *                         (maximum: 15-length_encoding)
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for encrypted data. It
+ *                         has to be of size data_len + mac_length.
+ * @return                 length of encrypted data or error code
+ */
+int cipher_encrypt_ccm_star(cipher_t* cipher, const uint8_t* auth_data,
+                            uint32_t auth_data_len, uint8_t mac_length,
+                            uint8_t length_encoding, const uint8_t* nonce,
+                            size_t nonce_len, const uint8_t* input,
+                            size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypt data of arbitrary length in ccm* mode.
+ *
+ * @see cipher_encrypt_ccm_star()
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data (maximum: 0xfeff)
+ * @param mac_length       length of the appended MAC (0 or between 4 and 16 -
+ *                         only even values)
+ * @param length_encoding  maximal supported length of plaintext
+ *                         (2^(8*length_enc)).
+ * @param nonce            Nounce for ctr mode encryption
+ * @param nonce_len        Length of the nonce in octets
+ *                         (maximum: 15-length_encoding)
+ * @param input            pointer to input data to decrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for decrypted data. It
+ *                         has to be of size data_len - mac_length.
+ * @return                 length of decrypted data or error code
+ */
+int cipher_decrypt_ccm_star(cipher_t* cipher, const uint8_t* auth_data,
+                            uint32_t auth_data_len, uint8_t mac_length,
+                            uint8_t length_encoding, const uint8_t* nonce,
+                            size_t nonce_len, const uint8_t* input,
+                            size_t input_len, uint8_t* output);
+
 #ifdef __cplusplus
 }
 #endif
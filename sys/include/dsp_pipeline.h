@@ -0,0 +1,487 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_dsp_pipeline Signal processing pipeline
+ * @ingroup     sys
+ * @brief       Turn a stream of samples into features, using CMSIS-DSP
+ *
+ * A pipeline collects the samples of a source into frames of a fixed length
+ * and passes each frame through a chain of stages to a sink:
+ *
+ * - sources: a continuous ADC stream (`dsp_pipeline_adc`, see
+ *   adc_stream_start()) or the hardware FIFO of a SAUL device
+ *   (`dsp_pipeline_saul`, see saul_reg_fifo_start())
+ * - stages: DC removal, window, FFT, RMS and band energies
+ * - sinks: CBOR encoding (`dsp_pipeline_cbor`) and CoAP Observe
+ *   notifications (`dsp_pipeline_coap`)
+ *
+ * Stages work in place on the frame, or hand their own output buffer on to
+ * the next stage, and append the values they extract to the features of the
+ * frame. Samples are converted right into one of two frame buffers, so while
+ * the stages work on one frame the source fills the other one and no samples
+ * are copied around. Only the features reach the sink, which keeps what is
+ * transmitted small.
+ *
+ * The stages run in the thread that calls dsp_pipeline_process():
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static float32_t _frames[2][256], _spectrum[256], _hann[256];
+ * static uint16_t _dma[2 * 128];
+ * static const uint16_t _edges[] = { 1, 8, 32, 128 };
+ *
+ * dsp_pipeline_init(&p, _frames[0], _frames[1], 256);
+ * dsp_dc_init(&dc);
+ * dsp_rms_init(&rms);
+ * dsp_window_init(&win, _hann, 256);
+ * dsp_fft_init(&fft, _spectrum, 256);
+ * dsp_bands_init(&bands, _edges, 3);
+ * dsp_pipeline_add(&p, &dc.stage);
+ * dsp_pipeline_add(&p, &rms.stage);
+ * dsp_pipeline_add(&p, &win.stage);
+ * dsp_pipeline_add(&p, &fft.stage);
+ * dsp_pipeline_add(&p, &bands.stage);
+ * dsp_sink_coap_init(&sink, &_resources[0]);
+ * dsp_pipeline_set_sink(&p, &sink.sink);
+ *
+ * dsp_pipeline_adc_start(&p, ADC_LINE(0), ADC_RES_12BIT, 4000, _dma, 256);
+ * while (1) {
+ *     dsp_pipeline_process(&p);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Custom stages and sinks embed a @ref dsp_stage_t or @ref dsp_sink_t as
+ * their first member.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Signal processing pipeline interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef DSP_PIPELINE_H
+#define DSP_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "arm_math.h"
+#include "thread.h"
+
+#ifdef MODULE_DSP_PIPELINE_ADC
+#include "periph/adc.h"
+#endif
+#ifdef MODULE_DSP_PIPELINE_SAUL
+#include "saul_reg.h"
+#endif
+#ifdef MODULE_DSP_PIPELINE_COAP
+#include "net/gcoap.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of features extracted from one frame
+ */
+#ifndef DSP_PIPELINE_FEATURES
+#define DSP_PIPELINE_FEATURES   (8U)
+#endif
+
+/**
+ * @brief   Thread flag the sources use to wake up dsp_pipeline_process()
+ */
+#ifndef DSP_PIPELINE_FLAG
+#define DSP_PIPELINE_FLAG       (0x1 << 12)
+#endif
+
+/**
+ * @brief   Number of FIFO samples read at once by the SAUL source
+ *
+ * The samples are read to the stack of the thread calling
+ * dsp_pipeline_process().
+ */
+#ifndef DSP_PIPELINE_SAUL_CHUNK
+#define DSP_PIPELINE_SAUL_CHUNK (8U)
+#endif
+
+/**
+ * @brief   Frame passed through the stages
+ */
+typedef struct {
+    float32_t *data;        /**< samples, or the output of the last stage */
+    size_t len;             /**< number of values at dsp_frame_t::data */
+    float32_t *features;    /**< features extracted so far */
+    unsigned numof;         /**< number of features */
+    uint32_t time;          /**< time of the last sample in microseconds,
+                             *   0 without the xtimer module */
+} dsp_frame_t;
+
+/**
+ * @brief   Forward declaration of a stage
+ */
+typedef struct dsp_stage dsp_stage_t;
+
+/**
+ * @brief   Process a frame
+ *
+ * @param[in] stage         the stage
+ * @param[in,out] frame     frame to process
+ *
+ * @return  0 on success
+ * @return  < 0 to drop the frame
+ */
+typedef int (*dsp_process_t)(dsp_stage_t *stage, dsp_frame_t *frame);
+
+/**
+ * @brief   Stage of a pipeline
+ */
+struct dsp_stage {
+    dsp_stage_t *next;      /**< next stage */
+    dsp_process_t process;  /**< processing function */
+};
+
+/**
+ * @brief   Forward declaration of a sink
+ */
+typedef struct dsp_sink dsp_sink_t;
+
+/**
+ * @brief   Consume the features of a frame
+ *
+ * @param[in] sink      the sink
+ * @param[in] frame     processed frame
+ *
+ * @return  0 on success
+ * @return  < 0 on error
+ */
+typedef int (*dsp_write_t)(dsp_sink_t *sink, const dsp_frame_t *frame);
+
+/**
+ * @brief   Sink of a pipeline
+ */
+struct dsp_sink {
+    dsp_write_t write;      /**< write function */
+};
+
+/**
+ * @brief   Pipeline
+ *
+ * All members are private.
+ */
+typedef struct {
+    float32_t *buf[2];                      /**< frame buffers */
+    size_t len;                             /**< samples per frame */
+    size_t pos;                             /**< samples in the buffer being
+                                             *   filled */
+    volatile int ready;                     /**< complete buffer, -1 if none */
+    uint8_t fill;                           /**< buffer being filled */
+    uint8_t source;                         /**< type of the source */
+    unsigned overruns;                      /**< frames dropped */
+    uint32_t time[2];                       /**< time of each frame */
+    dsp_stage_t *stages;                    /**< first stage */
+    dsp_sink_t *sink;                       /**< sink */
+    thread_t *thread;                       /**< thread processing frames */
+#if defined(MODULE_DSP_PIPELINE_ADC) || defined(DOXYGEN)
+    adc_t line;                             /**< sampled ADC line */
+#endif
+#if defined(MODULE_DSP_PIPELINE_SAUL) || defined(DOXYGEN)
+    saul_reg_t *dev;                        /**< SAUL device */
+    uint8_t axis;                           /**< value of the samples used */
+#endif
+    float32_t features[DSP_PIPELINE_FEATURES];  /**< features of a frame */
+} dsp_pipeline_t;
+
+/**
+ * @brief   Removes the mean of the frame
+ */
+typedef struct {
+    dsp_stage_t stage;          /**< stage */
+} dsp_dc_t;
+
+/**
+ * @brief   Multiplies the frame with a window
+ */
+typedef struct {
+    dsp_stage_t stage;          /**< stage */
+    const float32_t *coeffs;    /**< window */
+} dsp_window_t;
+
+/**
+ * @brief   Replaces the frame with its magnitude spectrum
+ */
+typedef struct {
+    dsp_stage_t stage;                  /**< stage */
+    arm_rfft_fast_instance_f32 rfft;    /**< CMSIS-DSP instance */
+    float32_t *out;                     /**< spectrum */
+} dsp_fft_t;
+
+/**
+ * @brief   Extracts the root mean square of the frame
+ */
+typedef struct {
+    dsp_stage_t stage;          /**< stage */
+} dsp_rms_t;
+
+/**
+ * @brief   Extracts the energy in bands of a spectrum
+ */
+typedef struct {
+    dsp_stage_t stage;          /**< stage */
+    const uint16_t *edges;      /**< first bin of each band, and the end */
+    unsigned numof;             /**< number of bands */
+} dsp_bands_t;
+
+/**
+ * @brief   Called with the CBOR encoded features of each frame
+ *
+ * @param[in] arg       argument given to dsp_sink_cbor_init()
+ * @param[in] data      encoded features
+ * @param[in] len       length of @p data in bytes
+ *
+ * @return  0 on success
+ * @return  < 0 on error
+ */
+typedef int (*dsp_cbor_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Sink encoding the features as CBOR
+ */
+typedef struct {
+    dsp_sink_t sink;            /**< sink */
+    uint8_t *buf;               /**< buffer for the encoding */
+    size_t size;                /**< size of dsp_sink_cbor_t::buf */
+    dsp_cbor_cb_t cb;           /**< callback */
+    void *arg;                  /**< argument of dsp_sink_cbor_t::cb */
+} dsp_sink_cbor_t;
+
+#if defined(MODULE_DSP_PIPELINE_COAP) || defined(DOXYGEN)
+/**
+ * @brief   Sink notifying the observers of a CoAP resource
+ */
+typedef struct {
+    dsp_sink_t sink;                    /**< sink */
+    const coap_resource_t *resource;    /**< resource to notify */
+} dsp_sink_coap_t;
+#endif
+
+/**
+ * @brief   Initialize a pipeline
+ *
+ * @param[out] p        pipeline to initialize
+ * @param[in] buf0      first frame buffer
+ * @param[in] buf1      second frame buffer
+ * @param[in] len       length of each buffer, in samples
+ */
+void dsp_pipeline_init(dsp_pipeline_t *p, float32_t *buf0, float32_t *buf1,
+                       size_t len);
+
+/**
+ * @brief   Append a stage to a pipeline
+ *
+ * @param[in,out] p     pipeline
+ * @param[in] stage     stage to append
+ */
+void dsp_pipeline_add(dsp_pipeline_t *p, dsp_stage_t *stage);
+
+/**
+ * @brief   Set the sink of a pipeline
+ *
+ * @param[in,out] p     pipeline
+ * @param[in] sink      sink the features are written to
+ */
+static inline void dsp_pipeline_set_sink(dsp_pipeline_t *p, dsp_sink_t *sink)
+{
+    p->sink = sink;
+}
+
+#if defined(MODULE_DSP_PIPELINE_ADC) || defined(DOXYGEN)
+/**
+ * @brief   Sample an ADC line continuously
+ *
+ * Must be called by the thread that calls dsp_pipeline_process(). Only
+ * available with the `dsp_pipeline_adc` module.
+ *
+ * @param[in,out] p     pipeline
+ * @param[in] line      ADC line, initialized with adc_init()
+ * @param[in] res       resolution
+ * @param[in] rate      sampling rate in Hz
+ * @param[out] dma      DMA buffer
+ * @param[in] len       number of samples @p dma holds, see adc_stream_start()
+ *
+ * @return  0 on success
+ * @return  < 0, as adc_stream_start()
+ */
+int dsp_pipeline_adc_start(dsp_pipeline_t *p, adc_t line, adc_res_t res,
+                           uint32_t rate, uint16_t *dma, size_t len);
+#endif
+
+#if defined(MODULE_DSP_PIPELINE_SAUL) || defined(DOXYGEN)
+/**
+ * @brief   Use the hardware FIFO of a SAUL device as source
+ *
+ * Must be called by the thread that calls dsp_pipeline_process(). Only
+ * available with the `dsp_pipeline_saul` module.
+ *
+ * @param[in,out] p         pipeline
+ * @param[in] dev           device with a FIFO
+ * @param[in] axis          index of the value of the samples to use
+ * @param[in] watermark     number of samples read at once
+ *
+ * @return  0 on success
+ * @return  < 0, as saul_reg_fifo_start()
+ */
+int dsp_pipeline_saul_start(dsp_pipeline_t *p, saul_reg_t *dev, unsigned axis,
+                            unsigned watermark);
+#endif
+
+/**
+ * @brief   Stop the source of a pipeline
+ *
+ * @param[in,out] p     pipeline
+ */
+void dsp_pipeline_stop(dsp_pipeline_t *p);
+
+/**
+ * @brief   Wait for the next frame and pass it through the pipeline
+ *
+ * @param[in,out] p     pipeline
+ *
+ * @return  0 on success
+ * @return  < 0, as returned by a stage, the sink or the source
+ */
+int dsp_pipeline_process(dsp_pipeline_t *p);
+
+/**
+ * @brief   Number of frames dropped because the previous one was still being
+ *          processed
+ *
+ * @param[in] p         pipeline
+ *
+ * @return  number of dropped frames
+ */
+static inline unsigned dsp_pipeline_overruns(const dsp_pipeline_t *p)
+{
+    return p->overruns;
+}
+
+/**
+ * @brief   Append a feature to a frame
+ *
+ * For use by stages.
+ *
+ * @param[in,out] frame     frame
+ * @param[in] value         feature
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if @ref DSP_PIPELINE_FEATURES are reached
+ */
+int dsp_frame_add_feature(dsp_frame_t *frame, float32_t value);
+
+/**
+ * @brief   Initialize a DC removal stage
+ *
+ * @param[out] dc       stage to initialize
+ */
+void dsp_dc_init(dsp_dc_t *dc);
+
+/**
+ * @brief   Initialize a window stage with a Hann window
+ *
+ * @param[out] win      stage to initialize
+ * @param[out] coeffs   buffer for the window
+ * @param[in] len       length of the window, the length of a frame
+ */
+void dsp_window_init(dsp_window_t *win, float32_t *coeffs, size_t len);
+
+/**
+ * @brief   Initialize an FFT stage
+ *
+ * The output are the magnitudes of the bins 0 to @p len / 2 - 1, bin i is
+ * at i * rate / @p len Hz.
+ *
+ * @param[out] fft      stage to initialize
+ * @param[out] out      buffer of @p len values for the FFT
+ * @param[in] len       length of a frame, a power of 2 from 32 to 4096
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p len is not supported
+ */
+int dsp_fft_init(dsp_fft_t *fft, float32_t *out, size_t len);
+
+/**
+ * @brief   Initialize an RMS stage
+ *
+ * @param[out] rms      stage to initialize
+ */
+void dsp_rms_init(dsp_rms_t *rms);
+
+/**
+ * @brief   Initialize a band energy stage
+ *
+ * Band i spans the bins edges[i] up to edges[i + 1] - 1 of the spectrum of an
+ * FFT stage and adds the sum of their squares as feature.
+ *
+ * @param[out] bands    stage to initialize
+ * @param[in] edges     @p numof + 1 ascending bin indices, must stay valid
+ * @param[in] numof     number of bands
+ */
+void dsp_bands_init(dsp_bands_t *bands, const uint16_t *edges, unsigned numof);
+
+/**
+ * @brief   Encode the features of a frame as CBOR
+ *
+ * The encoding is an array of the time of the frame, as unsigned integer,
+ * followed by the features as floats.
+ *
+ * @param[in] frame     processed frame
+ * @param[out] buf      buffer for the encoding
+ * @param[in] size      size of @p buf
+ *
+ * @return  length of the encoding
+ * @return  -ENOBUFS, if @p buf is too small
+ */
+ssize_t dsp_pipeline_cbor_encode(const dsp_frame_t *frame, uint8_t *buf,
+                                 size_t size);
+
+/**
+ * @brief   Initialize a CBOR sink
+ *
+ * @param[out] sink     sink to initialize
+ * @param[out] buf      buffer for the encoding
+ * @param[in] size      size of @p buf
+ * @param[in] cb        called with each encoding
+ * @param[in] arg       argument passed to @p cb
+ */
+void dsp_sink_cbor_init(dsp_sink_cbor_t *sink, uint8_t *buf, size_t size,
+                        dsp_cbor_cb_t cb, void *arg);
+
+#if defined(MODULE_DSP_PIPELINE_COAP) || defined(DOXYGEN)
+/**
+ * @brief   Initialize a CoAP sink
+ *
+ * Sends the CBOR encoded features of each frame as Observe notification of
+ * @p resource, if it has an observer. The PDU is built on the stack of the
+ * thread calling dsp_pipeline_process().
+ *
+ * @param[out] sink     sink to initialize
+ * @param[in] resource  observable resource, registered with gcoap
+ */
+void dsp_sink_coap_init(dsp_sink_coap_t *sink, const coap_resource_t *resource);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_PIPELINE_H */
+/** @} */
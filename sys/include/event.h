@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Provides an Event loop
+ *
+ * This module offers an event queue framework like libevent or libuev.
+ *
+ * An event queue is basically a FIFO queue of events, with some functions to
+ * efficiently and safely handle adding and getting events to / from such a
+ * queue.
+ *
+ * An event queue is bound to a thread, but any thread or ISR can put events
+ * into a queue. The events are intrusive list nodes, so posting never
+ * allocates and never fails. An event that is already queued is not queued a
+ * second time.
+ *
+ * The waiting thread is woken up with @ref THREAD_FLAG_EVENT, other thread
+ * flags and messages of that thread stay usable.
+ *
+ * An event is a structure containing a pointer to an event handler. It can be
+ * extended to provide context or arguments to the handler. It can also be
+ * embedded into existing structures (see examples).
+ *
+ * Compared to msg or mbox, this has some fundamental differences:
+ *
+ * 1. events are "sender allocated". Unlike msg_send(), event_post() never
+ *    blocks or fails.
+ * 2. events contain everything necessary to handle them, thus a thread
+ *    processing the events of an event queue doesn't need to be changed in
+ *    order to support new event types.
+ * 3. a queue can be safely used from any thread or ISR, without the waiting
+ *    thread needing a message queue.
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * #include "event.h"
+ *
+ * static void custom_handler(event_t *event)
+ * {
+ *     (void)event;
+ *     puts("triggered custom event");
+ * }
+ *
+ * static event_t custom_event = { .handler = custom_handler };
+ *
+ * static void handler(event_t *event)
+ * {
+ *     (void)event;
+ *     puts("triggered event");
+ * }
+ *
+ * static event_t event = { .handler = handler };
+ *
+ * int main(void)
+ * {
+ *     event_queue_t queue;
+ *
+ *     event_queue_init(&queue);
+ *
+ *     event_post(&queue, &event);
+ *     event_post(&queue, &custom_event);
+ *
+ *     event_loop(&queue);
+ *
+ *     return 0;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event API
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "assert.h"
+#include "clist.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag use to notify available events in an event queue
+ *
+ * @note    Threads waiting for events must not use this flag for anything
+ *          else.
+ */
+#ifndef THREAD_FLAG_EVENT
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   event_queue_t static initializer
+ *
+ * The queue is bound to the thread executing the initialization.
+ */
+#define EVENT_QUEUE_INIT    { .waiter = (thread_t *)sched_active_thread }
+
+/**
+ * @brief   static initializer for events
+ *
+ * @param[in]   _handler    event handler function
+ */
+#define EVENT_INIT(_handler) { .list_node = { NULL }, .handler = (_handler) }
+
+/**
+ * @brief   event structure forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   event handler type definition
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list node, NULL while the
+                                 *   event is not queued */
+    event_handler_t handler;    /**< pointer to event handler function */
+};
+
+/**
+ * @brief   event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events */
+    thread_t *waiter;           /**< thread owning event queue */
+} event_queue_t;
+
+/**
+ * @brief   Initialize an event queue
+ *
+ * This will set the calling thread as owner of @p queue.
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+static inline void event_queue_init(event_queue_t *queue)
+{
+    assert(queue);
+    queue->event_list.next = NULL;
+    queue->waiter = (thread_t *)sched_active_thread;
+}
+
+/**
+ * @brief   Queue an event
+ *
+ * Can be called from interrupt context. If @p event is already queued, it is
+ * not queued again, but the queue's thread is still notified.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue in event queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * This will remove a queued event from an event queue.
+ *
+ * @note    Due to the underlying list implementation, this will run in O(n).
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove from queue
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get next event from event queue, non-blocking
+ *
+ * In order to handle an event retrieved using this function,
+ * call event->handler(event).
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if no event available
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get next event from event queue, blocking
+ *
+ * This function will block until an event becomes available.
+ *
+ * In order to handle an event retrieved using this function,
+ * call event->handler(event).
+ *
+ * @pre     The calling thread owns @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Simple event loop
+ *
+ * This function will forever sit in a loop, waiting for events to be queued
+ * and executing their handlers.
+ *
+ * It is pretty much defined as:
+ *
+ *     while ((event = event_wait(queue))) {
+ *         event->handler(event);
+ *     }
+ *
+ * @param[in]   queue   event queue to process
+ */
+static inline void event_loop(event_queue_t *queue)
+{
+    event_t *event;
+
+    while ((event = event_wait(queue))) {
+        event->handler(event);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
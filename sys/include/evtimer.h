@@ -31,6 +31,13 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * By default, pending events are kept in a sorted list, so adding and
+ * removing events is O(n). With the `evtimer_heap` module, a pairing heap is
+ * used instead, which makes adding O(1) and removing O(log n) (amortized) at
+ * the cost of two pointers per event. Events with the same target time then
+ * fire in no particular order, and evtimer_del() must only be called on
+ * events that are either pending or have been zero initialized.
+ *
  * @{
  *
  * @file
@@ -57,6 +64,11 @@ extern "C" {
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
     uint32_t offset;            /**< offset in milliseconds from previous event */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< first child in the heap */
+    struct evtimer_event *prev;     /**< previous sibling or parent in the
+                                         heap */
+#endif
 } evtimer_event_t;
 
 /**
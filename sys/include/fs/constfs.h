@@ -15,6 +15,13 @@
  * RIOT VFS layer. The implementation uses an array of @c constfs_file_t objects
  * as its storage back-end.
  *
+ * Files are searched linearly by default. If the array is sorted by path, as
+ * generated by `dist/tools/mkconstfs`, set constfs_t::sorted to search it
+ * with a binary search instead.
+ *
+ * The contents of a file need not be read through the VFS, @ref constfs_find()
+ * gives direct access to them, e.g. to send them from flash without copying.
+ *
  * @{
  * @file
  * @brief   ConstFS public API
@@ -24,6 +31,7 @@
 #ifndef FS_CONSTFS_H
 #define FS_CONSTFS_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -48,6 +56,7 @@ typedef struct {
 typedef struct {
     const size_t nfiles; /**< Number of files */
     const constfs_file_t *files; /**< Files array */
+    const bool sorted; /**< @c files is sorted by path in @c strcmp order */
 } constfs_t;
 
 /**
@@ -57,6 +66,17 @@ typedef struct {
  */
 extern const vfs_file_system_t constfs_file_system;
 
+/**
+ * @brief Look up a file
+ *
+ * @param[in]  fs     file system to search
+ * @param[in]  path   path of the file, relative to the mount point
+ *
+ * @return the file, constfs_file_t::data may be accessed directly
+ * @return NULL if there is no file @p path in @p fs
+ */
+const constfs_file_t *constfs_find(const constfs_t *fs, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
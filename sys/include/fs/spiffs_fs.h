@@ -54,8 +54,30 @@ extern "C" {
 #ifndef SPIFFS_FS_FD_SPACE_SIZE
 #define SPIFFS_FS_FD_SPACE_SIZE (125)
 #endif
+
+/**
+ * @brief   Stack a @ref drivers_mtd_cache on the device of a file system
+ *
+ * The page cache keeps object lookup and index pages SPIFFS reads over and
+ * over again, e.g. while searching a file, in RAM. Pages modified by a file
+ * system operation are written back when the operation completes, so the
+ * order in which SPIFFS updates the flash is kept on power failures.
+ *
+ * Requires the mtd_cache module and SPIFFS_HAL_CALLBACK_EXTRA.
+ */
+#ifndef SPIFFS_FS_MTD_CACHE
+#define SPIFFS_FS_MTD_CACHE     (0)
+#endif
 /** @} */
 
+#if SPIFFS_FS_MTD_CACHE
+#include "mtd_cache.h"
+
+#if SPIFFS_HAL_CALLBACK_EXTRA != 1
+#error "SPIFFS_FS_MTD_CACHE requires SPIFFS_HAL_CALLBACK_EXTRA"
+#endif
+#endif
+
 /**
  * This contains everything needed to run an instance of SPIFFS
  */
@@ -72,6 +94,10 @@ typedef struct spiffs_desc {
 #if (SPIFFS_HAL_CALLBACK_EXTRA == 1) || defined(DOXYGEN)
     mtd_dev_t *dev;                             /**< The underlying mtd device, must be set by user */
 #endif
+#if SPIFFS_FS_MTD_CACHE || defined(DOXYGEN)
+    mtd_cache_t mtd_cache;                      /**< Page cache on @p dev, set up at mount time,
+                                                 *   except for mtd_cache_t::read_ahead */
+#endif
 } spiffs_desc_t;
 
 /** The SPIFFS vfs driver, a pointer to a spiffs_desc_t must be provided as vfs_mountp::private_data */
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_fw_update Streaming firmware update
+ * @ingroup     sys
+ * @brief       Write a firmware image to a @ref drivers_mtd slot as it is
+ *              received
+ *
+ * The image is passed in chunks of any size, as they arrive from whatever
+ * transport is used, e.g. from the Block1 handler of a @ref net_gcoap
+ * resource. The chunks are collected in one of two buffers of
+ * @ref FW_UPDATE_BUF_SIZE bytes. A full buffer is handed to a writer thread,
+ * which erases the sectors of the slot as they are reached, programs the
+ * buffer and adds it to a SHA-256 hash of the image. Meanwhile, the next
+ * chunks are collected in the other buffer, so receiving and programming
+ * overlap. fw_update_write() only blocks if both buffers are full.
+ *
+ * Images compressed with @ref pkg_heatshrink are decompressed on the fly,
+ * if @ref FW_UPDATE_COMPRESSED is passed to fw_update_start() and the
+ * package is used.
+ *
+ * With the `fw_update_delta` module, the image can instead be a delta patch
+ * against another image, usually the one currently running, see
+ * fw_update_set_source(). The patch consists of the following operations,
+ * where all numbers are encoded as LEB128 varints:
+ *
+ * | opcode | arguments              | effect                                 |
+ * |:------:|:-----------------------|:---------------------------------------|
+ * | 0x00   | length, length bytes   | add the bytes to the next bytes of the |
+ * |        |                        | source and append the result           |
+ * | 0x01   | length, length bytes   | append the bytes                       |
+ * | 0x02   | offset, zigzag encoded | move the position in the source        |
+ *
+ * The source position starts at 0 and is advanced by 0x00 operations. For
+ * small changes most added bytes are 0, so the patch compresses well.
+ * `dist/tools/fw_delta/mkdelta.py` creates such patches.
+ *
+ * The hash covers the image as it was written to the slot. fw_update_finish()
+ * compares it to the expected digest, without reading the slot back.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static fw_update_t _update;
+ *
+ * fw_update_start(&_update, mtd, SLOT_OFFSET, SLOT_SIZE, 0);
+ * ...
+ * // for each received chunk
+ * if (fw_update_write(&_update, chunk, chunk_len) < 0) {
+ *     ...
+ * }
+ * ...
+ * if (fw_update_finish(&_update, expected_sha256) >= 0) {
+ *     // image is valid
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Only one update can be in progress at a time.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Streaming firmware update definitions
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef FW_UPDATE_H
+#define FW_UPDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha256.h"
+#include "mtd.h"
+#include "mutex.h"
+#include "thread.h"
+
+#ifdef MODULE_HEATSHRINK
+#include "heatshrink_decoder.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of each of the two buffers in bytes
+ */
+#ifndef FW_UPDATE_BUF_SIZE
+#define FW_UPDATE_BUF_SIZE      (256U)
+#endif
+
+/**
+ * @brief   Priority of the writer thread
+ *
+ * Lower than the thread feeding the update, so it receives while a buffer is
+ * programmed.
+ */
+#ifndef FW_UPDATE_PRIO
+#define FW_UPDATE_PRIO          (THREAD_PRIORITY_MAIN + 1)
+#endif
+
+/**
+ * @brief   Stack size of the writer thread
+ */
+#ifndef FW_UPDATE_STACKSIZE
+#define FW_UPDATE_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Maximum number of source bytes read at once by a delta patch
+ *
+ * The buffer holding them is on the stack of the caller of
+ * fw_update_write().
+ */
+#ifndef FW_UPDATE_DELTA_CHUNK
+#define FW_UPDATE_DELTA_CHUNK   (32U)
+#endif
+
+/**
+ * @brief   Flag for fw_update_start(): the image is compressed with
+ *          heatshrink
+ */
+#define FW_UPDATE_COMPRESSED    (0x1)
+
+/**
+ * @brief   State of an update
+ *
+ * All members are private.
+ */
+typedef struct {
+    mtd_dev_t *mtd;                         /**< device of the slot */
+    uint32_t offset;                        /**< address of the slot */
+    uint32_t size;                          /**< size of the slot */
+    uint32_t pos;                           /**< bytes handed to the writer */
+    uint32_t erased;                        /**< bytes of the slot erased */
+    sha256_context_t sha;                   /**< hash of the written image */
+    uint8_t buf[2][FW_UPDATE_BUF_SIZE];     /**< buffers */
+    size_t fill;                            /**< bytes in the current buffer */
+    unsigned cur;                           /**< index of the current buffer */
+    const uint8_t *wr_buf;                  /**< buffer being programmed */
+    size_t wr_len;                          /**< length of fw_update_t::wr_buf */
+    uint32_t wr_addr;                       /**< slot offset it goes to */
+    mutex_t busy;                           /**< held while programming */
+    int error;                              /**< first error of the writer */
+#if defined(MODULE_HEATSHRINK) || defined(DOXYGEN)
+    heatshrink_decoder hsd;                 /**< decompressor */
+    unsigned flags;                         /**< flags of the update */
+#endif
+#if defined(MODULE_FW_UPDATE_DELTA) || defined(DOXYGEN)
+    mtd_dev_t *src_mtd;                     /**< device of the source image */
+    uint32_t src_offset;                    /**< address of the source */
+    uint32_t src_size;                      /**< size of the source */
+    uint32_t src_pos;                       /**< position in the source */
+    uint32_t arg;                           /**< argument being decoded */
+    uint8_t shift;                          /**< bits of it decoded */
+    uint8_t op;                             /**< current operation */
+    uint8_t state;                          /**< state of the patch parser */
+#endif
+} fw_update_t;
+
+/**
+ * @brief   Start an update
+ *
+ * @param[out] update   state of the update
+ * @param[in] mtd       device holding the slot
+ * @param[in] offset    address of the slot, aligned to a sector
+ * @param[in] size      size of the slot in bytes
+ * @param[in] flags     0 or @ref FW_UPDATE_COMPRESSED
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if the slot is not aligned to a sector
+ * @return  -ENOTSUP, if the image is compressed, but the heatshrink package
+ *          is not used
+ */
+int fw_update_start(fw_update_t *update, mtd_dev_t *mtd, uint32_t offset,
+                    uint32_t size, unsigned flags);
+
+/**
+ * @brief   Treat the image as a delta patch against a source image
+ *
+ * Must be called after fw_update_start() and before the first chunk is
+ * written. The source must not overlap the slot. If it is on the same device,
+ * it is only read while the slot is not programmed. Only available with the
+ * `fw_update_delta` module.
+ *
+ * @param[in,out] update    state of the update
+ * @param[in] mtd           device holding the source image
+ * @param[in] offset        address of the source image
+ * @param[in] size          size of the source image in bytes
+ */
+void fw_update_set_source(fw_update_t *update, mtd_dev_t *mtd,
+                          uint32_t offset, uint32_t size);
+
+/**
+ * @brief   Add the next chunk of the image
+ *
+ * @param[in,out] update    state of the update
+ * @param[in] data          chunk of the image
+ * @param[in] len           length of @p data in bytes
+ *
+ * @return  0 on success
+ * @return  -EFBIG, if the image does not fit into the slot
+ * @return  -EINVAL, if the compressed data or the patch is corrupt
+ * @return  < 0, if erasing or programming failed before
+ */
+int fw_update_write(fw_update_t *update, const void *data, size_t len);
+
+/**
+ * @brief   Write out the rest of the image and verify it
+ *
+ * @param[in,out] update    state of the update
+ * @param[in] digest        expected SHA-256 digest of the image, may be
+ *                          NULL to skip the check
+ *
+ * @return  size of the image in bytes on success
+ * @return  -EBADMSG, if the image does not match @p digest
+ * @return  -EINVAL, if the patch is truncated
+ * @return  < 0, if writing the image failed
+ */
+int fw_update_finish(fw_update_t *update,
+                     const uint8_t digest[SHA256_DIGEST_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_UPDATE_H */
+/** @} */
@@ -235,6 +235,24 @@ int sha256_chain_verify_element(void *element,
                                 void *tail_element,
                                 size_t chain_length);
 
+#if defined(MODULE_SHA256_HW) || defined(DOXYGEN)
+/**
+ * @brief Compresses complete blocks with the hash engine of the CPU
+ *
+ * Provided by the CPU if the sha256_hw module is used, sha256_update() hands
+ * its complete blocks to it. The engine may stop early, e.g. when it is busy,
+ * the remaining blocks are then compressed in software.
+ *
+ * @param[in,out] state  intermediate hash value of a sha256_context_t
+ * @param[in] blocks     blocks of SHA256_INTERNAL_BLOCK_SIZE bytes
+ * @param[in] numof      number of blocks in @p blocks
+ *
+ * @returns the number of blocks from the beginning of @p blocks compressed
+ *          into @p state
+ */
+size_t sha256_hw_transform(uint32_t *state, const void *blocks, size_t numof);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_irq_handler Deferred interrupt handler
+ * @ingroup     sys
+ * @brief       Run the bulk of interrupt handling in a shared thread
+ *
+ * Drivers that must not do their work in interrupt context usually own a
+ * thread that the ISR wakes up with a message. That costs a full stack per
+ * driver. With this module, an ISR only queues a preallocated
+ * @ref irq_event_t and a single high priority thread executes the handlers,
+ * in the order they were queued.
+ *
+ * Queuing an event is lock-free and can be done from any ISR or thread. An
+ * event that is already pending is not queued a second time, so an ISR
+ * that fires several times before its handler ran is handled once.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(void *ctx)
+ * {
+ *     dev_t *dev = ctx;
+ *     ... read the device, runs in thread context ...
+ * }
+ *
+ * static irq_event_t _event = IRQ_EVENT_INIT(_handler, &dev);
+ *
+ * static void _isr(void *arg)
+ * {
+ *     irq_event_add(&_event);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Deferred interrupt handler interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef IRQ_HANDLER_H
+#define IRQ_HANDLER_H
+
+#include <stdatomic.h>
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority of the interrupt handler thread
+ */
+#ifndef IRQ_HANDLER_PRIO
+#define IRQ_HANDLER_PRIO        (0)
+#endif
+
+/**
+ * @brief   Stack size of the interrupt handler thread
+ */
+#ifndef IRQ_HANDLER_STACKSIZE
+#define IRQ_HANDLER_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Deferred interrupt event
+ */
+typedef struct irq_event {
+    struct irq_event *next;     /**< next pending event, internal */
+    void (*isr)(void *ctx);     /**< handler, called in thread context */
+    void *ctx;                  /**< context passed to the handler */
+    atomic_int pending;         /**< != 0 while the event is queued */
+} irq_event_t;
+
+/**
+ * @brief   Static initializer for @ref irq_event_t
+ *
+ * @param[in] handler   function to call in thread context
+ * @param[in] context   argument for @p handler
+ */
+#define IRQ_EVENT_INIT(handler, context) \
+    { .next = NULL, .isr = handler, .ctx = context, .pending = ATOMIC_VAR_INIT(0) }
+
+/**
+ * @brief   Initialize an interrupt event
+ *
+ * @param[out] irq      event to initialize
+ * @param[in] handler   function to call in thread context
+ * @param[in] ctx       argument for @p handler
+ */
+static inline void irq_event_init(irq_event_t *irq, void (*handler)(void *),
+                                  void *ctx)
+{
+    irq->next = NULL;
+    irq->isr = handler;
+    irq->ctx = ctx;
+    atomic_init(&irq->pending, 0);
+}
+
+/**
+ * @brief   Queue an interrupt event for execution in the handler thread
+ *
+ * Can be called from interrupt context.
+ *
+ * @param[in] irq   event to queue, must be initialized
+ *
+ * @return  0 on success
+ * @return  -EALREADY if the event is already pending
+ */
+int irq_event_add(irq_event_t *irq);
+
+/**
+ * @brief   Start the interrupt handler thread
+ *
+ * Called automatically by @ref auto_init.
+ *
+ * @return  PID of the interrupt handler thread
+ */
+kernel_pid_t irq_handler_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IRQ_HANDLER_H */
+/** @} */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_kvstore Key-value store
+ * @ingroup     sys
+ * @brief       Log-structured key-value store on a memory technology device
+ *
+ * The store appends a record for every set or delete to the sectors of a
+ * @ref drivers_mtd device, so changing a value does not erase anything. A
+ * RAM index maps the hash of each key to its latest record, which makes
+ * reads and writes independent of the size of the store.
+ *
+ * The sectors are used as a ring. When the active sector is full, the next
+ * one is started. If it was the last empty sector, the live records of the
+ * oldest sector are copied to the active one and the oldest sector is
+ * released again. This spreads the erases evenly over all sectors.
+ * @ref kvstore_compact() does this in advance, e.g. from a low priority
+ * thread, so later writes do not have to.
+ *
+ * Every record carries a CRC, a record torn by a power failure is ignored
+ * when mounting and the previous value of its key is used. The oldest sector
+ * is only released after its live records were copied, so no value is lost
+ * if power fails during that either.
+ *
+ * The device must allow writes of single bytes, programming only bits that
+ * are still erased, like NOR flash does. Erased bytes must read as 0xff.
+ * @{
+ *
+ * @file
+ * @brief       Key-value store definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the RAM index
+ *
+ * The store holds at most one key less than this.
+ */
+#ifndef KVSTORE_INDEX_SIZE
+#define KVSTORE_INDEX_SIZE      (32U)
+#endif
+
+/**
+ * @brief   Maximum length of a key
+ */
+#ifndef KVSTORE_KEY_LEN_MAX
+#define KVSTORE_KEY_LEN_MAX     (32U)
+#endif
+
+/**
+ * @brief   Entry of the RAM index
+ */
+typedef struct {
+    uint32_t addr;              /**< address of the latest record, 0 if unused */
+    uint32_t hash;              /**< hash of the key */
+} kvstore_entry_t;
+
+/**
+ * @brief   A key-value store
+ */
+typedef struct {
+    mtd_dev_t *mtd;             /**< device the store is on */
+    uint32_t sector_size;       /**< size of a sector of kvstore_t::mtd */
+    uint32_t active;            /**< sector records are appended to */
+    uint32_t offset;            /**< offset of the next record in the active
+                                 *   sector */
+    uint32_t seq;               /**< sequence number of the active sector */
+    mutex_t lock;               /**< serializes access to the store */
+    unsigned numof;             /**< number of keys */
+    kvstore_entry_t index[KVSTORE_INDEX_SIZE];  /**< the RAM index */
+} kvstore_t;
+
+/**
+ * @brief   Mounts a store
+ *
+ * Builds the RAM index from the records on @p mtd. A device without any
+ * sector of a store is formatted.
+ *
+ * @param[out] kv   the store
+ * @param[in] mtd   the device, it must be initialized and have at least two
+ *                  sectors
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p mtd has less than two sectors
+ * @return  -ENOMEM if the store holds more keys than the index can take
+ * @return  other negative errno of the device
+ */
+int kvstore_init(kvstore_t *kv, mtd_dev_t *mtd);
+
+/**
+ * @brief   Erases all keys
+ *
+ * @param[in] kv    the store
+ *
+ * @return  0 on success
+ * @return  negative errno of the device
+ */
+int kvstore_format(kvstore_t *kv);
+
+/**
+ * @brief   Reads the value of a key
+ *
+ * @param[in] kv        the store
+ * @param[in] key       the key
+ * @param[out] value    buffer for the value
+ * @param[in] len       size of @p value, at most this many bytes are copied
+ *
+ * @return  the length of the value, may be larger than @p len
+ * @return  -ENOENT if @p key is not in the store
+ * @return  other negative errno of the device
+ */
+int kvstore_get(kvstore_t *kv, const char *key, void *value, size_t len);
+
+/**
+ * @brief   Sets the value of a key
+ *
+ * @param[in] kv        the store
+ * @param[in] key       the key, at most @ref KVSTORE_KEY_LEN_MAX characters
+ * @param[in] value     the value
+ * @param[in] len       length of @p value, a record must fit into a sector
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p key or @p len are too long
+ * @return  -ENOMEM if @p key is new and the index is full
+ * @return  -ENOSPC if the live records do not leave room for the value
+ * @return  other negative errno of the device
+ */
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len);
+
+/**
+ * @brief   Removes a key
+ *
+ * @param[in] kv        the store
+ * @param[in] key       the key
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p key is not in the store
+ * @return  -ENOSPC if there is no room for the deletion record
+ * @return  other negative errno of the device
+ */
+int kvstore_delete(kvstore_t *kv, const char *key);
+
+/**
+ * @brief   Releases the oldest sector if there is only one empty sector left
+ *
+ * @param[in] kv        the store
+ *
+ * @return  0 on success, also if nothing was to do
+ * @return  -ENOSPC if the live records of the oldest sector do not fit
+ * @return  other negative errno of the device
+ */
+int kvstore_compact(kvstore_t *kv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KVSTORE_H */
+/** @} */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_memarray    Memory pool of fixed sized elements
+ * @ingroup     sys
+ * @brief       Allocate and free fixed sized elements in constant time
+ *
+ * A memarray manages a caller provided array of equally sized elements. Free
+ * elements form a list that is chained through their first bytes, so the
+ * pool needs no memory besides the array and allocating as well as freeing
+ * is O(1).
+ *
+ * The pool counts its allocated elements, the maximum of that count and the
+ * allocations that failed, so exhausted pools can be spotted in one place.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static entry_t _entries[ENTRY_NUMOF];
+ * static memarray_t _pool;
+ *
+ * memarray_init(&_pool, _entries, sizeof(entry_t), ENTRY_NUMOF);
+ * entry_t *entry = memarray_alloc(&_pool);
+ * ...
+ * memarray_free(&_pool, entry);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @note    A memarray is not thread-safe, users that share a pool between
+ *          threads need to lock it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Memory pool of fixed sized elements interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef MEMARRAY_H
+#define MEMARRAY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Memory pool
+ */
+typedef struct {
+    void *free_data;    /**< first free element */
+    size_t size;        /**< size of one element */
+    size_t num;         /**< number of elements */
+    size_t used;        /**< number of allocated elements */
+    size_t used_max;    /**< maximum of memarray_t::used since initialization */
+    size_t failed;      /**< number of allocations that found the pool empty */
+} memarray_t;
+
+/**
+ * @brief   Initialize a memory pool
+ *
+ * @pre     `mem != NULL && data != NULL`
+ * @pre     `size >= sizeof(void *)`, the free list uses the elements' space
+ * @pre     @p data is suitably aligned for pointers
+ *
+ * @param[out] mem      pool to initialize
+ * @param[in] data      array of @p num elements of @p size bytes each
+ * @param[in] size      size of one element
+ * @param[in] num       number of elements in @p data
+ */
+void memarray_init(memarray_t *mem, void *data, size_t size, size_t num);
+
+/**
+ * @brief   Allocate an element of a pool
+ *
+ * The content of the element is undefined.
+ *
+ * @param[in,out] mem   pool to allocate from
+ *
+ * @return  pointer to the element
+ * @return  NULL, if all elements are in use
+ */
+void *memarray_alloc(memarray_t *mem);
+
+/**
+ * @brief   Return an element to its pool
+ *
+ * @pre     @p ptr was allocated from @p mem and is not freed yet
+ *
+ * @param[in,out] mem   pool of @p ptr
+ * @param[in] ptr       element to free
+ */
+void memarray_free(memarray_t *mem, void *ptr);
+
+/**
+ * @brief   Number of free elements of a pool
+ *
+ * @param[in] mem   pool to query
+ *
+ * @return  number of elements that can still be allocated
+ */
+static inline size_t memarray_available(const memarray_t *mem)
+{
+    return mem->num - mem->used;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMARRAY_H */
+/** @} */
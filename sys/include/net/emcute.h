@@ -59,6 +59,8 @@
  * - updating will message
  * - sending out periodic PINGREQ messages
  * - handling re-transmits
+ * - publishing on pre-defined and short topic IDs, also with QoS -1 without
+ *   connecting to the gateway
  *
  * The following features are however still missing (but planned):
  * @todo        Gateway discovery (so far there is no support for handling
@@ -68,7 +70,6 @@
  * @todo        QOS level 2
  * @todo        put the node to sleep (send DISCONNECT with duration field set)
  * @todo        handle DISCONNECT messages initiated by the broker/gateway
- * @todo        support for pre-defined and short topic IDs
  * @todo        handle (previously) active subscriptions on reconnect/disconnect
  * @todo        handle re-connect/disconnect from unresponsive gateway (in case
  *              a number of ping requests are unanswered)
@@ -164,6 +165,14 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_PUB_WINDOW
+/**
+ * @brief   Maximum number of QoS 1 messages published with emcute_pub_async()
+ *          waiting for their PUBACK at the same time
+ */
+#define EMCUTE_PUB_WINDOW       (4U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -177,6 +186,7 @@ extern "C" {
 enum {
     EMCUTE_DUP        = 0x80,   /**< duplicate flag */
     EMCUTE_QOS_MASK   = 0x60,   /**< QoS level mask */
+    EMCUTE_QOS_M1     = 0x60,   /**< QoS level -1, see emcute_pub_m1() */
     EMCUTE_QOS_2      = 0x40,   /**< QoS level 2 */
     EMCUTE_QOS_1      = 0x20,   /**< QoS level 1 */
     EMCUTE_QOS_0      = 0x00,   /**< QoS level 0 */
@@ -206,9 +216,26 @@ enum {
  */
 typedef struct {
     const char *name;           /**< topic string (currently ACSII only) */
-    uint16_t id;                /**< topic id, as assigned by the gateway */
+    uint16_t id;                /**< topic id, as assigned by the gateway, or
+                                 *   a pre-defined or short topic ID */
 } emcute_topic_t;
 
+/**
+ * @brief   Get the topic ID of a short topic name
+ *
+ * Short topic names consist of exactly two characters, which are sent in
+ * place of a topic ID when publishing with @ref EMCUTE_TIT_SHORT. No
+ * registration is needed for them.
+ *
+ * @param[in] name      short topic name, **must** have two characters
+ *
+ * @return  the topic ID to use for @p name
+ */
+static inline uint16_t emcute_topic_short(const char *name)
+{
+    return (uint16_t)(((uint8_t)name[0] << 8) | (uint8_t)name[1]);
+}
+
 /**
  * @brief   Signature for callbacks fired when publish messages are received
  *
@@ -228,6 +255,41 @@ typedef struct emcute_sub {
     void *arg;                  /**< optional custom argument */
 } emcute_sub_t;
 
+/**
+ * @brief   Forward declaration of the asynchronous publish context
+ */
+typedef struct emcute_pub emcute_pub_t;
+
+/**
+ * @brief   Signature for callbacks fired when an asynchronous publish is done
+ *
+ * @param[in] pub       publish context
+ * @param[in] res       EMCUTE_OK if the PUBACK was received, EMCUTE_REJECT
+ *                      if the gateway rejected the message, EMCUTE_TIMEOUT if
+ *                      no PUBACK was received after @ref EMCUTE_N_RETRY
+ *                      transmissions, EMCUTE_NOGW if the connection to the
+ *                      gateway was closed before
+ */
+typedef void(*emcute_pub_cb_t)(emcute_pub_t *pub, int res);
+
+/**
+ * @brief   Data-structure for keeping track of asynchronous publishs
+ */
+struct emcute_pub {
+    struct emcute_pub *next;    /**< next publish waiting for its PUBACK */
+    const emcute_topic_t *topic;/**< topic to publish on, **must** be
+                                 *   registered */
+    const void *data;           /**< data to publish, **must** stay valid
+                                 *   until emcute_pub_t::cb is called */
+    size_t len;                 /**< length of emcute_pub_t::data in bytes */
+    emcute_pub_cb_t cb;         /**< function called when the publish is done */
+    void *arg;                  /**< optional custom argument */
+    uint32_t sent;              /**< time of last transmission in usec */
+    uint16_t id;                /**< message ID */
+    uint8_t flags;              /**< flags used for publication */
+    uint8_t retries;            /**< number of transmissions so far */
+};
+
 /**
  * @brief   Connect to a given MQTT-SN gateway (CONNECT)
  *
@@ -264,6 +326,11 @@ int emcute_discon(void);
 /**
  * @brief   Get a topic ID for the given topic name from the gateway
  *
+ * The topic ID stays valid as long as the gateway keeps the session. A node
+ * that connects without clean session flag can therefore keep its registered
+ * topics, e.g. in memory that is retained while sleeping, and publish on them
+ * after reconnecting without registering them again.
+ *
  * @param[in,out] topic     topic to register, topic.name **must not** be NULL
  *
  * @return  EMCUTE_OK on success
@@ -281,7 +348,8 @@ int emcute_reg(emcute_topic_t *topic);
  *                      (topic.id **must** populated).
  * @param[in] buf       data to publish
  * @param[in] len       length of @p data in bytes
- * @param[in] flags     flags used for publication, allowed are QoS and retain
+ * @param[in] flags     flags used for publication, allowed are QoS, retain
+ *                      and the topic ID type
  *
  * @return  EMCUTE_OK on success
  * @return  EMCUTE_NOGW if not connected to a gateway
@@ -293,6 +361,55 @@ int emcute_reg(emcute_topic_t *topic);
 int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
                unsigned flags);
 
+/**
+ * @brief   Publish data without waiting for the PUBACK
+ *
+ * When calling this function, @p pub->topic, @p pub->data, @p pub->len, and
+ * for QoS 1 @p pub->cb **must** be set. For QoS 1 up to
+ * @ref EMCUTE_PUB_WINDOW messages can wait for their PUBACK at the same time.
+ * The emCute thread retransmits them every @ref EMCUTE_T_RETRY seconds and
+ * calls @p pub->cb once the message is acknowledged, rejected or timed out.
+ * Until then @p pub and @p pub->data **must** stay valid.
+ *
+ * For QoS 0 the message is sent and @p pub->cb is not called.
+ *
+ * @param[in,out] pub   publish context
+ * @param[in] flags     flags used for publication, allowed are QoS, retain
+ *                      and the topic ID type
+ *
+ * @return  EMCUTE_OK if the message was sent
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of data exceeds @ref EMCUTE_BUFSIZE or
+ *          if @ref EMCUTE_PUB_WINDOW messages are already waiting for their
+ *          PUBACK
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ */
+int emcute_pub_async(emcute_pub_t *pub, unsigned flags);
+
+/**
+ * @brief   Publish data with QoS -1, i.e. without being connected
+ *
+ * QoS -1 messages are sent to the gateway without any connection setup,
+ * registration or acknowledgement, so a node can wake up, publish and go back
+ * to sleep right away. They can only be published on pre-defined or short
+ * topic IDs, so @p flags **must** contain @ref EMCUTE_TIT_PREDEF or
+ * @ref EMCUTE_TIT_SHORT, and @p topic->id **must** be set to the pre-defined
+ * ID or to the value of emcute_topic_short().
+ *
+ * @param[in] remote    address of the gateway
+ * @param[in] topic     topic to publish on
+ * @param[in] data      data to publish
+ * @param[in] len       length of @p data in bytes
+ * @param[in] flags     flags used for publication, allowed are retain and the
+ *                      topic ID type
+ *
+ * @return  EMCUTE_OK if the message was sent
+ * @return  EMCUTE_OVERFLOW if length of data exceeds @ref EMCUTE_BUFSIZE
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ */
+int emcute_pub_m1(const sock_udp_ep_t *remote, const emcute_topic_t *topic,
+                  const void *data, size_t len, unsigned flags);
+
 /**
  * @brief   Subscribe to the given topic
  *
@@ -11,6 +11,12 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * fib_get_next_hop() scans the whole table by default. With the module
+ * `fib_trie` a table can have a longest-prefix-match index: if
+ * fib_table_t::trie_nodes points to FIB_TRIE_NODES_NUMOF(size) nodes before
+ * fib_init() is called, lookups only take time proportional to the address
+ * length.
+ *
  * @{
  *
  * @file
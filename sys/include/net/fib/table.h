@@ -53,6 +53,31 @@ typedef struct {
     universal_address_container_t *next_hop;
 } fib_entry_t;
 
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+* @brief Node of the longest-prefix-match index of a FIB table
+*
+* The key of a node is the size byte of the address followed by the address,
+* so addresses of different sizes never share a prefix.
+*/
+typedef struct fib_trie_node {
+    /** subtrees for the next key bit being 0 and 1 */
+    struct fib_trie_node *child[2];
+    /** the entry with this prefix, NULL for a pure branching node */
+    fib_entry_t *entry;
+    /** next node for another entry with the same prefix but a different
+    *   address, these nodes have no children */
+    struct fib_trie_node *same;
+    /** prefix length in bits, including the size byte */
+    uint16_t len;
+} fib_trie_node_t;
+
+/**
+* @brief Number of index nodes a FIB table with @p size entries needs
+*/
+#define FIB_TRIE_NODES_NUMOF(size)  (2 * (size))
+#endif
+
 /**
 * @brief Container descriptor for a FIB source route entry
 */
@@ -133,6 +158,20 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** incremented on every change of the single hop entries.
+    *   Allows users to detect when cached lookup results become stale.
+    */
+    uint32_t gen;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** node pool of the longest-prefix-match index for single hop entries,
+    *   holding FIB_TRIE_NODES_NUMOF(size) nodes.
+    *   NULL disables the index, lookups then scan the whole table.
+    *   Only available with module `fib_trie`.
+    */
+    fib_trie_node_t *trie_nodes;
+    /** root of the longest-prefix-match index */
+    fib_trie_node_t *trie_root;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
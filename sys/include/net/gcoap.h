@@ -46,10 +46,12 @@
  * gcoap allows an application to specify a collection of request resource paths
  * it wants to be notified about. Create an array of resources, coap_resource_t
  * structs. Use gcoap_register_listener() at application startup to pass in
- * these resources, wrapped in a gcoap_listener_t.
+ * these resources, wrapped in a gcoap_listener_t. The array must be sorted
+ * alphabetically by path.
  *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
- * lists all of the registered paths.
+ * lists all of the registered paths. Define GCOAP_LINK_CACHE_SIZE to build its
+ * response only once instead of on every request.
  *
  * ### Creating a response ###
  *
@@ -126,8 +128,9 @@
  *
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
- * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * take any action to support Observe client registration. Several observers
+ * may register for the same resource, up to GCOAP_OBS_REGISTRATIONS_MAX
+ * registrations in total.
  *
  * An Observe notification is considered a response to the original client
  * registration request. So, the Observe server only needs to create and send
@@ -183,9 +186,10 @@
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
  *
- * - Message Type: Supports non-confirmable (NON) messaging. Additionally
- *   provides a callback on timeout. Provides piggybacked ACK response to a
- *   confirmable (CON) request.
+ * - Message Type: Supports non-confirmable (NON) and confirmable (CON)
+ *   requests; CON requests are retransmitted with exponential backoff.
+ *   Additionally provides a callback on timeout. Provides piggybacked ACK
+ *   response to a confirmable (CON) request.
  * - Observe extension: Provides server-side registration and notifications.
  * - Server and Client provide helper functions for writing the
  *   response/request. See the CoAP topic in the source documentation for
@@ -197,6 +201,10 @@
  *   in a user provided callback.
  * - Client generates token; length defined at compile time.
  * - Options: Supports Content-Format for payload.
+ * - Block-wise transfers (RFC 7959): Server handlers serve a large resource
+ *   block by block with gcoap_block2_init() and gcoap_block_finish(), and
+ *   acknowledge received Block1 blocks with GCOAP_CODE_CONTINUE. The client
+ *   retrieves a resource block by block with gcoap_block2_get().
  *
  * @{
  *
@@ -210,6 +218,7 @@
 #ifndef NET_GCOAP_H
 #define NET_GCOAP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdatomic.h>
 #include "net/sock/udp.h"
@@ -242,16 +251,16 @@ extern "C" {
  * @brief   Size of the buffer used to write options, other than Uri-Path, in a
  *          request
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and Block2.
  */
-#define GCOAP_REQ_OPTIONS_BUF   (8)
+#define GCOAP_REQ_OPTIONS_BUF   (12)
 
 /**
  * @brief   Size of the buffer used to write options in a response
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and Block2.
  */
-#define GCOAP_RESP_OPTIONS_BUF  (8)
+#define GCOAP_RESP_OPTIONS_BUF  (12)
 
 /**
  * @brief   Size of the buffer used to write options in an Observe notification
@@ -261,9 +270,12 @@ extern "C" {
 #define GCOAP_OBS_OPTIONS_BUF   (8)
 
 /**
- * @brief   Maximum number of requests awaiting a response
+ * @brief   Maximum number of requests awaiting a response; use 2 if not
+ *          defined
  */
+#ifndef GCOAP_REQ_WAITING_MAX
 #define GCOAP_REQ_WAITING_MAX   (2)
+#endif
 
 /**
  * @brief   Maximum length in bytes for a token
@@ -310,6 +322,40 @@ extern "C" {
  */
 #define GCOAP_NON_TIMEOUT       (5000000U)
 
+/**
+ * @brief   Initial time to wait for the ACK of a confirmable request [in usec]
+ *
+ * Corresponds to ACK_TIMEOUT of RFC 7252.
+ */
+#ifndef GCOAP_ACK_TIMEOUT
+#define GCOAP_ACK_TIMEOUT       (2000000U)
+#endif
+
+/**
+ * @brief   Maximum random time added to GCOAP_ACK_TIMEOUT [in usec]
+ *
+ * Corresponds to ACK_TIMEOUT * (ACK_RANDOM_FACTOR - 1) of RFC 7252.
+ */
+#ifndef GCOAP_ACK_TIMEOUT_RANDOM
+#define GCOAP_ACK_TIMEOUT_RANDOM    (1000000U)
+#endif
+
+/**
+ * @brief   Maximum number of retransmissions of a confirmable request; use 4
+ *          if not defined
+ */
+#ifndef GCOAP_MAX_RETRANSMIT
+#define GCOAP_MAX_RETRANSMIT    (4)
+#endif
+
+/**
+ * @brief   Maximum number of unacknowledged confirmable requests to a single
+ *          server; use 1 (RFC 7252 default) if not defined
+ */
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART            (1)
+#endif
+
 /**
  * @brief   Identifies waiting timed out for a response to a sent message
  */
@@ -323,6 +369,47 @@ extern "C" {
  */
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
+/**
+ * @name    Option numbers for block-wise transfers (RFC 7959)
+ * @{
+ */
+#define GCOAP_OPT_BLOCK2        (23)
+#define GCOAP_OPT_BLOCK1        (27)
+/** @} */
+
+/**
+ * @brief   Response code 2.31 (Continue) for a received Block1 block
+ */
+#define GCOAP_CODE_CONTINUE     ((COAP_CLASS_SUCCESS << 5) | 31)
+
+/**
+ * @brief   Largest block size exponent; the block size is 2^(szx + 4) bytes
+ */
+#define GCOAP_BLOCK_SZX_MAX     (6)
+
+/**
+ * @brief   Block size exponent requested by gcoap_block2_get(); use 2 (64
+ *          bytes) if not defined
+ *
+ * The block and the request options must fit into GCOAP_PDU_BUF_SIZE.
+ */
+#ifndef GCOAP_BLOCK_SZX
+#define GCOAP_BLOCK_SZX         (2)
+#endif
+
+/**
+ * @brief   Size of the cache for the /.well-known/core response; use 0 (no
+ *          cache) if not defined
+ *
+ * If not 0, the link format list of the resources is built once after a
+ * listener is registered and then served from this cache, instead of being
+ * rebuilt on every request. Resources that do not fit into the cache are not
+ * listed.
+ */
+#ifndef GCOAP_LINK_CACHE_SIZE
+#define GCOAP_LINK_CACHE_SIZE   (0)
+#endif
+
 /**
  * @brief   Maximum number of Observe clients; use 2 if not defined
  */
@@ -402,7 +489,9 @@ extern "C" {
  */
 typedef struct gcoap_listener {
     coap_resource_t *resources;     /**< First element in the array of
-                                     *   resources; must order alphabetically */
+                                     *   resources; must be sorted
+                                     *   alphabetically by path, as they are
+                                     *   looked up with a binary search */
     size_t resources_len;           /**< Length of array */
     struct gcoap_listener *next;    /**< Next listener in list */
 } gcoap_listener_t;
@@ -415,6 +504,29 @@ typedef struct gcoap_listener {
  */
 typedef void (*gcoap_resp_handler_t)(unsigned req_state, coap_pkt_t* pdu);
 
+/**
+ * @brief   Value of a Block1 or Block2 option
+ */
+typedef struct {
+    uint32_t num;                       /**< Block number */
+    uint8_t szx;                        /**< Block size exponent */
+    bool more;                          /**< More blocks follow */
+} gcoap_block_t;
+
+/**
+ * @brief   Handler function for each block received by gcoap_block2_get()
+ *
+ * Called with the same states as a gcoap_resp_handler_t. The transfer is over
+ * when @p block has no more blocks following or on a timeout or an error.
+ *
+ * @param[in] req_state State of the request for the block
+ * @param[in] pdu       Response with the block, or the request on a timeout
+ * @param[in] block     The block; its payload starts at
+ *                      gcoap_block_offset(@p block) within the resource
+ */
+typedef void (*gcoap_block_handler_t)(unsigned req_state, coap_pkt_t *pdu,
+                                      const gcoap_block_t *block);
+
 /**
  * @brief   Memo to handle a response for a request
  */
@@ -425,6 +537,13 @@ typedef struct {
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
+    const uint8_t *msg;                 /**< Unacknowledged confirmable
+                                         *   request to retransmit; NULL
+                                         *   otherwise */
+    size_t msg_len;                     /**< Length of the request */
+    sock_udp_ep_t remote;               /**< Destination of the request */
+    uint32_t send_timeout;              /**< Current retransmission timeout */
+    unsigned send_limit;                /**< Remaining retransmissions */
 } gcoap_request_memo_t;
 
 /**
@@ -504,6 +623,25 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  */
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format);
 
+/**
+ * @brief   Finishes formatting a CoAP PDU with Block1 and/or Block2 options
+ *
+ * Same as gcoap_finish(), but also writes the given block options.
+ *
+ * @param[in,out] pdu       Request metadata
+ * @param[in] payload_len   Length of the payload, or 0 if none
+ * @param[in] format        Format code for the payload; use COAP_FORMAT_NONE if
+ *                          not specified
+ * @param[in] block1        Block1 option, or NULL if none
+ * @param[in] block2        Block2 option, or NULL if none
+ *
+ * @return  size of the PDU
+ * @return  < 0 on error
+ */
+ssize_t gcoap_block_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           const gcoap_block_t *block1,
+                           const gcoap_block_t *block2);
+
 /**
  * @brief   Writes a complete CoAP request PDU when there is not a payload
  *
@@ -527,6 +665,13 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 /**
  * @brief   Sends a buffer containing a CoAP request to the provided endpoint
  *
+ * If the request is confirmable (see coap_hdr_set_type()), it is
+ * retransmitted with exponential backoff until it is acknowledged, up to
+ * GCOAP_MAX_RETRANSMIT times. The buffer is retransmitted as is, so it must
+ * stay valid and unchanged until @p resp_handler is called. At most
+ * GCOAP_NSTART confirmable requests to the same @p remote may be
+ * unacknowledged at a time.
+ *
  * @param[in] buf           Buffer containing the PDU
  * @param[in] len           Length of the buffer
  * @param[in] remote        Destination for the packet
@@ -610,9 +755,11 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
 /**
  * @brief   Sends a buffer containing a CoAP Observe notification to the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * Assumes a single observer for a resource.
+ * The notification is built only once. For each observer only the header and
+ * the token are replaced while sending, the options and the payload are sent
+ * from @p buf as they are.
  *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
@@ -624,6 +771,96 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource);
 
+/**
+ * @brief   Returns the size of a block in bytes
+ *
+ * @param[in] block The block
+ *
+ * @return  size of @p block
+ */
+static inline size_t gcoap_block_size(const gcoap_block_t *block)
+{
+    return 16U << block->szx;
+}
+
+/**
+ * @brief   Returns the offset of a block within the resource
+ *
+ * @param[in] block The block
+ *
+ * @return  offset of the first byte of @p block
+ */
+static inline uint32_t gcoap_block_offset(const gcoap_block_t *block)
+{
+    return block->num << (block->szx + 4);
+}
+
+/**
+ * @brief   Reads the Block1 option of a received PDU
+ *
+ * @param[in] pdu       Parsed PDU
+ * @param[out] block    Value of the option
+ *
+ * @return  1 if the option was found
+ * @return  0 if the PDU has no Block1 option
+ * @return  -EBADMSG if the option is malformed
+ */
+int gcoap_get_block1(coap_pkt_t *pdu, gcoap_block_t *block);
+
+/**
+ * @brief   Reads the Block2 option of a received PDU
+ *
+ * @param[in] pdu       Parsed PDU
+ * @param[out] block    Value of the option
+ *
+ * @return  1 if the option was found
+ * @return  0 if the PDU has no Block2 option
+ * @return  -EBADMSG if the option is malformed
+ */
+int gcoap_get_block2(coap_pkt_t *pdu, gcoap_block_t *block);
+
+/**
+ * @brief   Initializes a CoAP response packet for the block a request asks for
+ *
+ * Reads the Block2 option of the request and initializes the response like
+ * gcoap_resp_init(). If the request has no Block2 option, the first block is
+ * returned. The block size is reduced until the block fits into @p buf.
+ *
+ * The handler then writes up to gcoap_block_size(@p block) bytes of the
+ * resource from gcoap_block_offset(@p block) on to the payload, sets
+ * gcoap_block_t::more if the resource continues after the block and calls
+ * gcoap_block_finish() with @p block as Block2 option.
+ *
+ * @param[in,out] pdu   Request on input, response metadata on output
+ * @param[in] buf       Buffer containing the PDU
+ * @param[in] len       Length of the buffer
+ * @param[in] code      Response code
+ * @param[out] block    Block to write to the response
+ *
+ * @return  0 on success
+ * @return  -EBADMSG if the Block2 option of the request is malformed
+ */
+int gcoap_block2_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
+                      gcoap_block_t *block);
+
+/**
+ * @brief   Retrieves a resource block-wise with GET requests
+ *
+ * Requests the blocks of the resource one after another and calls @p handler
+ * for each of them. The request for a block is sent by the gcoap thread right
+ * after the response for the previous one was handled. Only one transfer may be
+ * in progress at a time.
+ *
+ * @param[in] remote    Server of the resource
+ * @param[in] path      Resource path, *must* start with '/'
+ * @param[in] handler   Callback for each block
+ *
+ * @return  length of the request for the first block
+ * @return  0 if cannot send, e.g. because a transfer is already in progress
+ */
+size_t gcoap_block2_get(const sock_udp_ep_t *remote, char *path,
+                        gcoap_block_handler_t handler);
+
 /**
  * @brief   Provides important operational statistics
  *
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_addr_set IPv6 prefix set
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Hashed set of IPv6 prefixes, the storage of the IPv6
+ *              black- and whitelist
+ *
+ * The prefixes are kept in an open addressing hash table with linear
+ * probing, hashed over their masked bits and their length. Addresses are
+ * prefixes of length 128.
+ *
+ * To match an address, the set remembers which prefix lengths are in use and
+ * looks up the address masked to each of them. The cost of a match thus
+ * depends on the number of distinct prefix lengths, usually one or two, and
+ * not on the number of entries, as long as the table is not nearly full.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 prefix set definitions
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_IPV6_ADDR_SET_H
+#define NET_GNRC_IPV6_ADDR_SET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of words of the bitmap of prefix lengths in use
+ */
+#define GNRC_IPV6_ADDR_SET_LENS_WORDS   ((IPV6_ADDR_BIT_LEN / \
+                                          (8 * sizeof(unsigned))) + 1)
+
+/**
+ * @brief   An entry of a prefix set
+ */
+typedef struct {
+    ipv6_addr_t prefix;     /**< the prefix, bits behind @p len are zero */
+    uint8_t len;            /**< length of the prefix in bits */
+    bool used;              /**< the entry holds a prefix */
+} gnrc_ipv6_addr_set_entry_t;
+
+/**
+ * @brief   A prefix set
+ */
+typedef struct {
+    gnrc_ipv6_addr_set_entry_t *entries;    /**< the hash table */
+    unsigned size;                          /**< number of slots */
+    /**
+     * @brief   bit n is set, if a prefix of length n is in the set
+     */
+    unsigned lens[GNRC_IPV6_ADDR_SET_LENS_WORDS];
+} gnrc_ipv6_addr_set_t;
+
+/**
+ * @brief   Static initializer for a prefix set
+ *
+ * @param[in] e     array of gnrc_ipv6_addr_set_entry_t, the slots
+ */
+#define GNRC_IPV6_ADDR_SET_INIT(e)  { .entries = (e), \
+                                      .size = sizeof(e) / sizeof((e)[0]) }
+
+/**
+ * @brief   Adds a prefix to a set
+ *
+ * @param[in] set       A prefix set.
+ * @param[in] prefix    An IPv6 prefix, bits behind @p len are ignored.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ *
+ * @return  0, on success or if @p prefix is already in @p set.
+ * @return  -ENOMEM, if @p set is full.
+ */
+int gnrc_ipv6_addr_set_add(gnrc_ipv6_addr_set_t *set,
+                           const ipv6_addr_t *prefix, uint8_t len);
+
+/**
+ * @brief   Removes a prefix from a set
+ *
+ * @param[in] set       A prefix set.
+ * @param[in] prefix    An IPv6 prefix, bits behind @p len are ignored.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ *
+ * @return  0, on success.
+ * @return  -ENOENT, if @p prefix is not in @p set.
+ */
+int gnrc_ipv6_addr_set_del(gnrc_ipv6_addr_set_t *set,
+                           const ipv6_addr_t *prefix, uint8_t len);
+
+/**
+ * @brief   Checks if an address is covered by a prefix of a set
+ *
+ * @param[in] set       A prefix set.
+ * @param[in] addr      An IPv6 address.
+ *
+ * @return  true, if a prefix of @p set matches @p addr.
+ * @return  false, otherwise.
+ */
+bool gnrc_ipv6_addr_set_match(const gnrc_ipv6_addr_set_t *set,
+                              const ipv6_addr_t *addr);
+
+/**
+ * @brief   Prints the prefixes of a set, one per line
+ *
+ * @param[in] set       A prefix set.
+ */
+void gnrc_ipv6_addr_set_print(const gnrc_ipv6_addr_set_t *set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_ADDR_SET_H */
+/** @} */
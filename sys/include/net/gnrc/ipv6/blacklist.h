@@ -25,6 +25,7 @@
 #include <stdbool.h>
 
 #include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/addr_set.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,11 @@ extern "C" {
 
 /**
  * Maximum size of the blacklist.
+ *
+ * The blacklist is a hash table of prefixes, see
+ * @ref net_gnrc_ipv6_addr_set. Checking an address takes constant time as
+ * long as the blacklist is not nearly full, so keep some slots, e.g. a quarter,
+ * unused for large lists.
  */
 #ifndef GNRC_IPV6_BLACKLIST_SIZE
 #define GNRC_IPV6_BLACKLIST_SIZE    (8)
@@ -56,12 +62,36 @@ int gnrc_ipv6_blacklist_add(const ipv6_addr_t *addr);
  */
 void gnrc_ipv6_blacklist_del(const ipv6_addr_t *addr);
 
+/**
+ * @brief   Adds an IPv6 prefix to the blacklist.
+ *
+ * All addresses matching the prefix are blacklisted.
+ *
+ * @param[in] prefix    An IPv6 prefix.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ *
+ * @return  0, on success.
+ * @return  -1, if blacklist is full.
+ */
+int gnrc_ipv6_blacklist_add_prefix(const ipv6_addr_t *prefix, uint8_t len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the blacklist.
+ *
+ * Prefixes not in the blacklist will be ignored. Addresses and prefixes
+ * within @p prefix stay in the blacklist.
+ *
+ * @param[in] prefix    An IPv6 prefix.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ */
+void gnrc_ipv6_blacklist_del_prefix(const ipv6_addr_t *prefix, uint8_t len);
+
 /**
  * @brief   Checks if an IPv6 address is blacklisted.
  *
  * @param[in] addr  An IPv6 address.
  *
- * @return  true, if @p addr is blacklisted.
+ * @return  true, if @p addr or a prefix of it is blacklisted.
  * @return  false, if @p addr is not blacklisted.
  */
 bool gnrc_ipv6_blacklisted(const ipv6_addr_t *addr);
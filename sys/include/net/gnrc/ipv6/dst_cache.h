@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_dst_cache IPv6 destination cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Remembers the next hop of recently used destinations
+ *
+ * With the module `gnrc_ipv6_dst_cache` @ref net_gnrc_ipv6 stores the
+ * interface and link-layer address of the next hop it determined for a
+ * destination, so following packets to the same destination can skip the
+ * FIB and neighbor cache lookups.
+ *
+ * Instead of tracking which destinations went through which FIB or neighbor
+ * cache entry, every change of the FIB, the neighbor cache, the default
+ * router list or the prefix list invalidates the whole cache through a
+ * generation counter. Entries also expire after
+ * @ref GNRC_IPV6_DST_CACHE_TIMEOUT, since FIB entries only expire when
+ * they are looked up.
+ *
+ * The path MTUs learned from ICMPv6 Packet Too Big messages are kept
+ * separately, so they survive these invalidations, and expire after
+ * @ref GNRC_IPV6_DST_CACHE_PMTU_TIMEOUT. Transport protocols and sock users
+ * can size their payloads with gnrc_ipv6_dst_cache_get_pmtu(), which unlike
+ * the other functions may be called from any thread.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc4861#section-5.1">
+ *          RFC 4861, section 5.1
+ *      </a>
+ * @see <a href="https://tools.ietf.org/html/rfc8201">
+ *          RFC 8201
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       IPv6 destination cache definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_IPV6_DST_CACHE_H
+#define NET_GNRC_IPV6_DST_CACHE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the destination cache
+ */
+#ifndef GNRC_IPV6_DST_CACHE_SIZE
+#define GNRC_IPV6_DST_CACHE_SIZE    (4U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which an entry is looked up again
+ */
+#ifndef GNRC_IPV6_DST_CACHE_TIMEOUT
+#define GNRC_IPV6_DST_CACHE_TIMEOUT (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Number of path MTUs to remember
+ */
+#ifndef GNRC_IPV6_DST_CACHE_PMTU_SIZE
+#define GNRC_IPV6_DST_CACHE_PMTU_SIZE       (4U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which a learned path MTU is dropped
+ *
+ * Allows the path MTU to increase again, see
+ * <a href="https://tools.ietf.org/html/rfc8201#section-4">
+ * RFC 8201, section 4</a>.
+ */
+#ifndef GNRC_IPV6_DST_CACHE_PMTU_TIMEOUT
+#define GNRC_IPV6_DST_CACHE_PMTU_TIMEOUT    (600U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Destination cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination address */
+    uint32_t version;           /**< gnrc_ipv6_dst_cache_version() when added */
+    uint32_t time;              /**< time in microseconds when added */
+    kernel_pid_t req_iface;     /**< interface the next hop was looked up for,
+                                 *   KERNEL_PID_UNDEF for any */
+    kernel_pid_t iface;         /**< interface to the next hop */
+    uint16_t mtu;               /**< path MTU */
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];   /**< link-layer address of
+                                                 *   the next hop */
+    uint8_t l2addr_len;         /**< length of gnrc_ipv6_dst_cache_t::l2addr */
+} gnrc_ipv6_dst_cache_t;
+
+#if defined(MODULE_GNRC_IPV6_DST_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the destination cache
+ *
+ * Must be called on every change to the neighbor cache, the default router
+ * list or the prefix list. Changes to the FIB are detected by
+ * fib_table_t::gen.
+ */
+void gnrc_ipv6_dst_cache_invalidate(void);
+
+/**
+ * @brief   Gets the current version of the data the cache is based on
+ *
+ * Take it before looking up the next hop for gnrc_ipv6_dst_cache_add(), so
+ * changes during the lookup invalidate the entry.
+ *
+ * @return  a value that changes on every invalidation
+ */
+uint32_t gnrc_ipv6_dst_cache_version(void);
+
+/**
+ * @brief   Gets the cached next hop for a destination
+ *
+ * @param[in] iface the interface to send over, KERNEL_PID_UNDEF for any
+ * @param[in] dst   the destination address
+ *
+ * @return  the valid entry for @p dst and @p iface
+ * @return  NULL if there is none
+ */
+const gnrc_ipv6_dst_cache_t *gnrc_ipv6_dst_cache_get(kernel_pid_t iface,
+                                                     const ipv6_addr_t *dst);
+
+/**
+ * @brief   Adds the next hop for a destination to the cache
+ *
+ * Replaces the oldest entry if the cache is full.
+ *
+ * @param[in] version       gnrc_ipv6_dst_cache_version() before the lookup
+ * @param[in] req_iface     the interface the next hop was looked up for,
+ *                          KERNEL_PID_UNDEF for any
+ * @param[in] dst           the destination address
+ * @param[in] iface         the interface to the next hop
+ * @param[in] l2addr        link-layer address of the next hop
+ * @param[in] l2addr_len    length of @p l2addr, at most
+ *                          @ref GNRC_IPV6_NC_L2_ADDR_MAX
+ */
+void gnrc_ipv6_dst_cache_add(uint32_t version, kernel_pid_t req_iface,
+                             const ipv6_addr_t *dst, kernel_pid_t iface,
+                             const uint8_t *l2addr, uint8_t l2addr_len);
+
+/**
+ * @brief   Sets the path MTU to a destination
+ *
+ * To be called for a received ICMPv6 Packet Too Big message. Replaces the
+ * oldest path MTU if there is no space left.
+ *
+ * @param[in] dst   the destination address
+ * @param[in] mtu   the MTU reported for the path to @p dst. Values below
+ *                  @ref IPV6_MIN_MTU are raised to it.
+ */
+void gnrc_ipv6_dst_cache_set_pmtu(const ipv6_addr_t *dst, uint16_t mtu);
+
+/**
+ * @brief   Gets the path MTU to a destination
+ *
+ * @param[in] iface the interface to send over, KERNEL_PID_UNDEF to use the
+ *                  interface of a cached next hop for @p dst
+ * @param[in] dst   the destination address
+ *
+ * @return  the smaller one of the learned path MTU and the MTU of the
+ *          interface
+ * @return  @ref IPV6_MIN_MTU if neither is known
+ */
+uint16_t gnrc_ipv6_dst_cache_get_pmtu(kernel_pid_t iface, const ipv6_addr_t *dst);
+#else
+static inline void gnrc_ipv6_dst_cache_invalidate(void)
+{
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_DST_CACHE_H */
+/** @} */
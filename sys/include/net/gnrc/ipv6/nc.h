@@ -51,6 +51,17 @@ extern "C" {
 #define GNRC_IPV6_NC_L2_ADDR_MAX    (8)
 #endif
 
+#ifndef GNRC_IPV6_NC_HASH_SIZE
+/**
+ * @brief   Number of slots of the hash index over the neighbor cache
+ *
+ * Only used with the module `gnrc_ipv6_nc_hash`, which makes
+ * gnrc_ipv6_nc_get() and gnrc_ipv6_nc_add() find entries without scanning
+ * the whole neighbor cache. Must be larger than @ref GNRC_IPV6_NC_SIZE.
+ */
+#define GNRC_IPV6_NC_HASH_SIZE      (2 * GNRC_IPV6_NC_SIZE)
+#endif
+
 /**
  * @{
  * @name Flag definitions for gnrc_ipv6_nc_t
@@ -65,6 +65,13 @@ extern "C" {
 #define GNRC_IPV6_NETIF_ADDR_NUMOF  (6 + GNRC_IPV6_NETIF_RPL_ADDR + GNRC_IPV6_NETIF_RTR_ADDR)
 #endif
 
+/**
+ * @brief   Number of buckets of the index mapping addresses to interfaces
+ */
+#ifndef GNRC_IPV6_NETIF_ADDR_INDEX_SIZE
+#define GNRC_IPV6_NETIF_ADDR_INDEX_SIZE (16)
+#endif
+
 /**
  * @brief   Default MTU
  *
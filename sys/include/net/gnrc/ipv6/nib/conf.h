@@ -184,6 +184,16 @@ extern "C" {
 #define GNRC_IPV6_NIB_NUMOF                 (4)
 #endif
 
+/**
+ * @brief   Number of slots of the hash index over the on-link entries
+ *
+ * Only used with the module `gnrc_ipv6_nc_hash`. Must be larger than
+ * @ref GNRC_IPV6_NIB_NUMOF.
+ */
+#ifndef GNRC_IPV6_NIB_HASH_SIZE
+#define GNRC_IPV6_NIB_HASH_SIZE             (2 * GNRC_IPV6_NIB_NUMOF)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@
 #include <stdbool.h>
 
 #include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/addr_set.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,6 +31,11 @@ extern "C" {
 
 /**
  * Maximum size of the whitelist.
+ *
+ * The whitelist is a hash table of prefixes, see
+ * @ref net_gnrc_ipv6_addr_set. Checking an address takes constant time as
+ * long as the whitelist is not nearly full, so keep some slots, e.g. a quarter,
+ * unused for large lists.
  */
 #ifndef GNRC_IPV6_WHITELIST_SIZE
 #define GNRC_IPV6_WHITELIST_SIZE    (8)
@@ -54,12 +60,36 @@ int gnrc_ipv6_whitelist_add(const ipv6_addr_t *addr);
  */
 void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr);
 
+/**
+ * @brief   Adds an IPv6 prefix to the whitelist.
+ *
+ * All addresses matching the prefix are whitelisted.
+ *
+ * @param[in] prefix    An IPv6 prefix.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ *
+ * @return  0, on success.
+ * @return  -1, if whitelist is full.
+ */
+int gnrc_ipv6_whitelist_add_prefix(const ipv6_addr_t *prefix, uint8_t len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the whitelist.
+ *
+ * Prefixes not in the whitelist will be ignored. Addresses and prefixes
+ * within @p prefix stay in the whitelist.
+ *
+ * @param[in] prefix    An IPv6 prefix.
+ * @param[in] len       Length of @p prefix in bits, at most 128.
+ */
+void gnrc_ipv6_whitelist_del_prefix(const ipv6_addr_t *prefix, uint8_t len);
+
 /**
  * @brief   Checks if an IPv6 address is whitelisted.
  *
  * @param[in] addr  An IPv6 address.
  *
- * @return  true, if @p addr is whitelisted.
+ * @return  true, if @p addr or a prefix of it is whitelisted.
  * @return  false, if @p addr is not whitelisted.
  */
 bool gnrc_ipv6_whitelisted(const ipv6_addr_t *addr);
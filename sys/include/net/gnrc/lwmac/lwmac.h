@@ -93,11 +93,50 @@ extern "C" {
  * the chances for receiving packets from neighbors (i.e., leads to higher
  * throughput), but also results in higher power consumption.
  * In LWMAC, by default, we regard the wake-up period as the beginning of a cycle.
+ * With traffic adaptation (see @ref GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX) this is
+ * the longest wake-up interval, used while a node is idle.
  */
 #ifndef GNRC_LWMAC_WAKEUP_INTERVAL_US
 #define GNRC_LWMAC_WAKEUP_INTERVAL_US        (100LU * US_PER_MS)
 #endif
 
+/**
+ * @brief Maximum exponent by which the wake-up interval is shortened under load.
+ *
+ * A node adapts its wake-up interval to the traffic it sees: the interval is
+ * @ref GNRC_LWMAC_WAKEUP_INTERVAL_US >> exponent, where the exponent grows by
+ * one after a cycle with at least @ref GNRC_LWMAC_ADAPT_BUSY_THRESHOLD
+ * received WRs and queued packets, and shrinks by one after
+ * @ref GNRC_LWMAC_ADAPT_IDLE_CYCLES cycles without any. The current exponent is
+ * advertised in every WA, so senders predict the phase of the receiver with
+ * the right interval. Since the intervals divide each other, a receiver still
+ * wakes up at the phase its senders knew after shortening its interval, and
+ * WR streams cover the longest interval in any case. The shortest interval
+ * must be longer than 3 times @ref GNRC_LWMAC_WAKEUP_DURATION_US.
+ * Set to "0" to disable the adaptation.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX
+#define GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX   (1U)
+#endif
+
+/**
+ * @brief Load in one cycle from which the wake-up interval is shortened.
+ *
+ * The load is the number of WRs for this node received in the cycle plus the
+ * number of packets in its TX queues at the start of the next one.
+ */
+#ifndef GNRC_LWMAC_ADAPT_BUSY_THRESHOLD
+#define GNRC_LWMAC_ADAPT_BUSY_THRESHOLD      (2U)
+#endif
+
+/**
+ * @brief Number of consecutive idle cycles after which the wake-up interval is
+ *        stretched again.
+ */
+#ifndef GNRC_LWMAC_ADAPT_IDLE_CYCLES
+#define GNRC_LWMAC_ADAPT_IDLE_CYCLES         (8U)
+#endif
+
 /**
  * @brief The Maximum WR (preamble packet @ref gnrc_lwmac_frame_wr_t) duration time.
  *
@@ -162,6 +201,22 @@ extern "C" {
 #define GNRC_LWMAC_BROADCAST_DURATION_US     ((GNRC_LWMAC_WAKEUP_INTERVAL_US * 11) / 10)
 #endif
 
+/**
+ * @brief Every how many broadcasts one is sent for the full
+ *        @ref GNRC_LWMAC_BROADCAST_DURATION_US.
+ *
+ * LWMAC learns the phases of its neighbors from every WA it hears, also from
+ * WAs addressed to other nodes. When the phases of all neighbors in its TX
+ * neighbor table are known, a broadcast is only repeated until the last of
+ * them has woken up. Nodes that LWMAC does not know yet only catch the
+ * broadcasts that last for the full duration, so this sends every
+ * @ref GNRC_LWMAC_BROADCAST_FULL_PERIOD th broadcast for the full duration.
+ * Set to "1" to always send broadcasts for the full duration.
+ */
+#ifndef GNRC_LWMAC_BROADCAST_FULL_PERIOD
+#define GNRC_LWMAC_BROADCAST_FULL_PERIOD     (4U)
+#endif
+
 /**
  * @brief Time to idle between two successive broadcast packets, referenced to the
  *        start of the packet.
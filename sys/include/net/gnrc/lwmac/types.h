@@ -203,6 +203,12 @@ typedef struct lwmac {
     uint32_t last_wakeup;                                    /**< Used to calculate wakeup times */
     uint8_t lwmac_info;                                      /**< LWMAC's internal informations (flags) */
     gnrc_lwmac_timeout_t timeouts[GNRC_LWMAC_TIMEOUT_COUNT]; /**< Store timeouts used for protocol */
+    uint8_t interval_exp;                                    /**< Current wake-up interval is
+                                                                  @ref GNRC_LWMAC_WAKEUP_INTERVAL_US
+                                                                  >> interval_exp */
+    uint8_t idle_cycles;                                     /**< Consecutive cycles without traffic */
+    uint8_t wr_count;                                        /**< WRs for this node received in the
+                                                                  current cycle */
 
 #if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
     /* Parameters for recording duty-cycle */
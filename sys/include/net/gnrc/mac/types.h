@@ -108,6 +108,10 @@ typedef struct {
 #if (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN)
     gnrc_priority_pktqueue_t queue;                  /**< TX queue for this particular Neighbor */
 #endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
+#if defined(MODULE_GNRC_LWMAC) || defined(DOXYGEN)
+    uint8_t interval_exp;                            /**< Exponent of neighbor's wake-up interval
+                                                          advertised by LWMAC */
+#endif
 } gnrc_mac_tx_neighbor_t;
 
 /**
@@ -20,10 +20,34 @@
 #ifndef NET_GNRC_NDP_NODE_H
 #define NET_GNRC_NDP_NODE_H
 
+#include "kernel_types.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/addr.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of packets that can wait for address resolution in total
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_SIZE
+#define GNRC_NDP_NODE_QUEUE_SIZE        (GNRC_IPV6_NC_SIZE * 2)
+#endif
+
+/**
+ * @brief   Number of packets that can wait for the address resolution of a
+ *          single neighbor
+ *
+ * If the queue of a neighbor is full, a new packet replaces the oldest one
+ * (see <a href="https://tools.ietf.org/html/rfc4861#section-7.2.2">
+ * RFC 4861, section 7.2.2</a>).
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_NBR_SIZE
+#define GNRC_NDP_NODE_QUEUE_NBR_SIZE    (3U)
+#endif
+
 /**
  * @brief   Get link-layer address and interface for next hop to destination
  *          IPv6 address.
@@ -34,7 +58,10 @@ extern "C" {
  *                              May be @ref KERNEL_PID_UNDEF if not specified.
  * @param[in] dst               An IPv6 address to search the next hop for.
  * @param[in] pkt               Packet to send to @p dst. Leave NULL if you
- *                              just want to get the addresses.
+ *                              just want to get the addresses. If address
+ *                              resolution for the next hop is still
+ *                              performed, @p pkt is held and queued until the
+ *                              neighbor advertisement arrives.
  *
  * @return  The PID of the interface, on success.
  * @return  -EHOSTUNREACH, if @p dst is not reachable.
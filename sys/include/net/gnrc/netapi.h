@@ -51,6 +51,40 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_direct   Direct dispatch mode
+ * @ingroup     net_gnrc_netapi
+ * @brief       Run the 6LoWPAN and UDP layers without threads of their own
+ * @{
+ * @details With the submodule `gnrc_netapi_direct` @ref net_gnrc_sixlowpan
+ *          and @ref net_gnrc_udp do not start threads, but register
+ *          [callbacks](@ref net_gnrc_netapi_callbacks) instead. A
+ *          gnrc_netapi_dispatch_receive() or gnrc_netapi_dispatch_send() to
+ *          them then handles the packet right away on the stack of the
+ *          dispatching thread, which saves two thread stacks and two context
+ *          switches per packet:
+ *
+ *          - received frames are decompressed on the stack of the network
+ *            interface thread
+ *          - 6LoWPAN compression and fragmentation run on the stack of the
+ *            IPv6 thread
+ *          - outgoing UDP headers are built on the stack of the sending
+ *            thread, incoming ones are parsed on the stack of the IPv6 thread
+ *
+ *          The stacks of these threads must be sized accordingly.
+ *
+ * @note    The 6LoWPAN reassembly buffer is not shared safely between several
+ *          network interface threads, so this mode is meant for nodes with
+ *          a single 6LoWPAN interface. Multi-interface routers should keep
+ *          the default threaded model.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
  */
@@ -92,6 +126,45 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a train of packets up the network
+ *          stack
+ *
+ * @details @ref msg_t::content::ptr points to a snip of type
+ *          @ref GNRC_NETTYPE_UNDEF whose data is an array of packet pointers,
+ *          see @ref gnrc_netapi_train_len() and @ref gnrc_netapi_train_get().
+ *          The receiver takes over every packet of the train and has to
+ *          release the train snip itself.
+ *
+ * @note    0x0206 is taken by @ref GNRC_NETERR_MSG_TYPE
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_TRAIN  (0x0207)
+
+/**
+ * @brief   @ref core_msg type for passing a train of packets down the network
+ *          stack
+ *
+ * @see     GNRC_NETAPI_MSG_TYPE_RCV_TRAIN
+ */
+#define GNRC_NETAPI_MSG_TYPE_SND_TRAIN  (0x0208)
+
+/**
+ * @brief   @ref core_msg type for getting several options of a network module
+ *          at once
+ *
+ * @details @ref msg_t::content::ptr points to a @ref gnrc_netapi_opts_t.
+ *          Modules not supporting it reply with -ENOTSUP.
+ */
+#define GNRC_NETAPI_MSG_TYPE_GET_MULTI  (0x0209)
+
+/**
+ * @brief   @ref core_msg type for setting several options of a network module
+ *          at once
+ *
+ * @see     GNRC_NETAPI_MSG_TYPE_GET_MULTI
+ */
+#define GNRC_NETAPI_MSG_TYPE_SET_MULTI  (0x020A)
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -103,6 +176,21 @@ typedef struct {
     uint16_t data_len;          /**< size of the data / the buffer */
 } gnrc_netapi_opt_t;
 
+/**
+ * @brief   Data structure to be send for setting
+ *          (@ref GNRC_NETAPI_MSG_TYPE_SET_MULTI) and getting
+ *          (@ref GNRC_NETAPI_MSG_TYPE_GET_MULTI) several options
+ *
+ * The receiver handles the options in order and stores the result of each,
+ * as it would have replied to the single option, in gnrc_netapi_opts_t::res.
+ * It replies with the number of non-negative results.
+ */
+typedef struct {
+    gnrc_netapi_opt_t *opts;    /**< the options to get/set */
+    int *res;                   /**< results of the options */
+    unsigned numof;             /**< number of options */
+} gnrc_netapi_opts_t;
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_SND messages
  *
@@ -114,6 +202,24 @@ typedef struct {
  */
 int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Sends @p numof packets to @p pid with a single
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_TRAIN message
+ *
+ * A train of one packet is sent as a plain @ref GNRC_NETAPI_MSG_TYPE_SND
+ * message. On error the packets are still owned by the caller.
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] pkts      packets to send
+ * @param[in] numof     number of packets in @p pkts
+ *
+ * @return              1 if the train was successfully delivered
+ * @return              0 if the receiver queue is full
+ * @return              -1 on error (invalid PID or no space in the packet
+ *                      buffer for the train)
+ */
+int gnrc_netapi_send_train(kernel_pid_t pid, gnrc_pktsnip_t **pkts, unsigned numof);
+
 /**
  * @brief   Sends @p cmd to all subscribers to (@p type, @p demux_ctx).
  *
@@ -154,6 +260,52 @@ static inline int gnrc_netapi_dispatch_send(gnrc_nettype_t type, uint32_t demux_
  */
 int gnrc_netapi_receive(kernel_pid_t pid, gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Passes @p numof packets to @p pid with a single
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_TRAIN message
+ *
+ * @see     gnrc_netapi_send_train()
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] pkts      received packets
+ * @param[in] numof     number of packets in @p pkts
+ *
+ * @return              1 if the train was successfully delivered
+ * @return              0 if the receiver queue is full
+ * @return              -1 on error (invalid PID or no space in the packet
+ *                      buffer for the train)
+ */
+int gnrc_netapi_receive_train(kernel_pid_t pid, gnrc_pktsnip_t **pkts, unsigned numof);
+
+/**
+ * @brief   Number of packets in a train
+ *
+ * @param[in] train     train snip of a @ref GNRC_NETAPI_MSG_TYPE_SND_TRAIN or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_RCV_TRAIN message
+ *
+ * @return  number of packets in @p train
+ */
+static inline unsigned gnrc_netapi_train_len(const gnrc_pktsnip_t *train)
+{
+    return train->size / sizeof(gnrc_pktsnip_t *);
+}
+
+/**
+ * @brief   Gets a packet of a train
+ *
+ * @param[in] train     train snip of a @ref GNRC_NETAPI_MSG_TYPE_SND_TRAIN or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_RCV_TRAIN message
+ * @param[in] idx       index of the packet, must be lesser than
+ *                      gnrc_netapi_train_len(@p train)
+ *
+ * @return  the packet at @p idx
+ */
+static inline gnrc_pktsnip_t *gnrc_netapi_train_get(const gnrc_pktsnip_t *train,
+                                                    unsigned idx)
+{
+    return ((gnrc_pktsnip_t **)train->data)[idx];
+}
+
 /**
  * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_RCV command to all subscribers to
  *          (@p type, @p demux_ctx).
@@ -206,6 +358,42 @@ int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
 int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len);
 
+/**
+ * @brief   Gets @p numof options with a single
+ *          @ref GNRC_NETAPI_MSG_TYPE_GET_MULTI message
+ *
+ * If the module does not support it, the options are read one by one with
+ * @ref gnrc_netapi_get().
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in,out] opts  options to get, with their buffers
+ * @param[out] res      result for each option, as returned by
+ *                      @ref gnrc_netapi_get()
+ * @param[in] numof     number of options in @p opts and @p res
+ *
+ * @return              number of options read successfully
+ */
+int gnrc_netapi_get_multi(kernel_pid_t pid, gnrc_netapi_opt_t *opts, int *res,
+                          unsigned numof);
+
+/**
+ * @brief   Sets @p numof options with a single
+ *          @ref GNRC_NETAPI_MSG_TYPE_SET_MULTI message
+ *
+ * The options are set in order. If the module does not support it, they are
+ * set one by one with @ref gnrc_netapi_set().
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] opts      options to set, with their data
+ * @param[out] res      result for each option, as returned by
+ *                      @ref gnrc_netapi_set()
+ * @param[in] numof     number of options in @p opts and @p res
+ *
+ * @return              number of options set successfully
+ */
+int gnrc_netapi_set_multi(kernel_pid_t pid, gnrc_netapi_opt_t *opts, int *res,
+                          unsigned numof);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,9 +38,21 @@
 #include "net/gnrc/mac/types.h"
 #include "net/ieee802154.h"
 #include "net/gnrc/mac/mac.h"
+#ifdef MODULE_GNRC_NETDEV_QOS
+#include "net/gnrc/netdev/qos.h"
+#endif
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+#include "net/gnrc/netdev/indirect.h"
+#endif
+#ifdef MODULE_GNRC_NETDEV_TXSTATUS
+#include "net/gnrc/netdev/txstatus.h"
+#endif
 #ifdef MODULE_GNRC_MAC
 #include "net/csma_sender.h"
 #endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +70,16 @@ extern "C" {
  */
 #define NETDEV_MSG_TYPE_EVENT 0x1234
 
+/**
+ * @brief   Thread flag signaling pending device events
+ *
+ * @details Set by the device's event callback in ISR context. Unlike the
+ *          @ref NETDEV_MSG_TYPE_EVENT message, which is only sent to wake up
+ *          the thread, the flag can not get lost when the message queue of
+ *          the thread is full.
+ */
+#define GNRC_NETDEV_FLAG_EVENT  (0x0001)
+
 /**
  * @brief   Mask for @ref gnrc_mac_tx_feedback_t
  */
@@ -116,6 +138,17 @@ typedef struct gnrc_netdev {
      */
     gnrc_pktsnip_t * (*recv)(struct gnrc_netdev *dev);
 
+#if defined(MODULE_NETDEV_IEEE802154_MULTICHANNEL) || defined(DOXYGEN)
+    /**
+     * @brief Handle the end of a transmission, may be NULL
+     *
+     * Called on the events ending a transmission, e.g. to switch back to the
+     * receive channel after a frame was sent on the channel of its
+     * destination.
+     */
+    void (*tx_end)(struct gnrc_netdev *dev);
+#endif
+
     /**
      * @brief netdev handle this adapter is working with
      */
@@ -170,7 +203,41 @@ typedef struct gnrc_netdev {
     gnrc_lwmac_t lwmac;
 #endif
 
+#ifdef MODULE_GNRC_TSCH
+    /**
+     * @brief TSCH specific structure object for storing TSCH internal states.
+     */
+    gnrc_tsch_t tsch;
+#endif
+
 #endif /* MODULE_GNRC_MAC */
+
+#if defined(MODULE_GNRC_NETDEV_QOS) || defined(DOXYGEN)
+    /**
+     * @brief   transmit queue
+     *
+     * @note    Only available with @ref net_gnrc_netdev_qos.
+     */
+    gnrc_netdev_qos_t qos;
+#endif
+
+#if defined(MODULE_GNRC_NETDEV_INDIRECT) || defined(DOXYGEN)
+    /**
+     * @brief   queues for sleepy children
+     *
+     * @note    Only available with @ref net_gnrc_netdev_indirect.
+     */
+    gnrc_netdev_indirect_t indirect;
+#endif
+
+#if defined(MODULE_GNRC_NETDEV_TXSTATUS) || defined(DOXYGEN)
+    /**
+     * @brief   destination of the frame in flight
+     *
+     * @note    Only available with @ref net_gnrc_netdev_txstatus.
+     */
+    gnrc_netdev_txstatus_dst_t tx_dst;
+#endif
 } gnrc_netdev_t;
 
 #ifdef MODULE_GNRC_MAC
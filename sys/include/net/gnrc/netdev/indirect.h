@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netdev_indirect Indirect transmission for IEEE 802.15.4
+ * @ingroup     net_gnrc_netdev
+ * @brief       Holds packets for sleepy children until they poll for them
+ *
+ * With the module `gnrc_netdev_indirect` a router keeps a queue of
+ * downstream packets for every child that polls it with IEEE 802.15.4 data
+ * requests, instead of sending them while the child sleeps. A child becomes
+ * known with its first data request and is forgotten, together with its
+ * packets, when it did not poll for @ref GNRC_NETDEV_INDIRECT_TIMEOUT_US.
+ *
+ * The ACK to a data request tells the child with the frame pending bit
+ * whether it has to stay awake. Drivers that support
+ * @ref NETOPT_ACK_PENDING_SRC set it only for the children that have
+ * packets queued. For all other drivers it is set with
+ * @ref NETOPT_ACK_PENDING as long as any child has packets queued, and
+ * children without packets get an empty data frame so they can go back to
+ * sleep right away. The last frame of a queue is sent without the frame
+ * pending bit, all others with it, so a child keeps polling until its queue
+ * is empty.
+ *
+ * Broadcast and multicast packets are always sent directly.
+ * @{
+ *
+ * @file
+ * @brief       Indirect transmission definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_NETDEV_INDIRECT_H
+#define NET_GNRC_NETDEV_INDIRECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/ieee802154.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of sleepy children per device
+ */
+#ifndef GNRC_NETDEV_INDIRECT_CHILDREN
+#define GNRC_NETDEV_INDIRECT_CHILDREN       (4U)
+#endif
+
+/**
+ * @brief   Maximum number of packets queued per child
+ */
+#ifndef GNRC_NETDEV_INDIRECT_QUEUE_SIZE
+#define GNRC_NETDEV_INDIRECT_QUEUE_SIZE     (4U)
+#endif
+
+/**
+ * @brief   Time without data requests after which a child is forgotten
+ *
+ * Must be longer than the poll interval of the children and, as it is
+ * measured with 32-bit microseconds, shorter than about 71 minutes.
+ */
+#ifndef GNRC_NETDEV_INDIRECT_TIMEOUT_US
+#define GNRC_NETDEV_INDIRECT_TIMEOUT_US     (10U * 60U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   A sleepy child and its queued packets
+ */
+typedef struct {
+    gnrc_pktsnip_t *queue[GNRC_NETDEV_INDIRECT_QUEUE_SIZE]; /**< FIFO of packets */
+    uint32_t last_poll;                         /**< time of last data request */
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< address of the child */
+    uint8_t addr_len;                           /**< length of gnrc_netdev_indirect_child_t::addr,
+                                                 *   0 for an unused entry */
+    uint8_t head;                               /**< first packet in
+                                                 *   gnrc_netdev_indirect_child_t::queue */
+    uint8_t numof;                              /**< number of queued packets */
+} gnrc_netdev_indirect_child_t;
+
+/**
+ * @brief   Per-device indirect transmission state
+ */
+typedef struct {
+    gnrc_netdev_indirect_child_t children[GNRC_NETDEV_INDIRECT_CHILDREN]; /**< children */
+    uint8_t pending;        /**< children with queued packets */
+    bool pending_src;       /**< driver sets the frame pending bit per source */
+} gnrc_netdev_indirect_t;
+
+/**
+ * @brief   Initializes the indirect transmission state of a device
+ *
+ * @param[out] indirect the state
+ */
+void gnrc_netdev_indirect_init(gnrc_netdev_indirect_t *indirect);
+
+/**
+ * @brief   Looks up a child
+ *
+ * @param[in] indirect  the state
+ * @param[in] addr      address of the child
+ * @param[in] addr_len  length of @p addr
+ *
+ * @return  the child
+ * @return  NULL if @p addr is not a known child
+ */
+gnrc_netdev_indirect_child_t *gnrc_netdev_indirect_get(gnrc_netdev_indirect_t *indirect,
+                                                       const uint8_t *addr,
+                                                       size_t addr_len);
+
+/**
+ * @brief   Records a data request of a child
+ *
+ * Unknown children are added to an unused or an expired entry without
+ * packets.
+ *
+ * @param[in] indirect  the state
+ * @param[in] addr      address of the child
+ * @param[in] addr_len  length of @p addr
+ * @param[in] now       current time in microseconds
+ *
+ * @return  the child
+ * @return  NULL if there is no room for another child
+ */
+gnrc_netdev_indirect_child_t *gnrc_netdev_indirect_poll(gnrc_netdev_indirect_t *indirect,
+                                                        const uint8_t *addr,
+                                                        size_t addr_len,
+                                                        uint32_t now);
+
+/**
+ * @brief   Checks if a child did not poll for too long
+ *
+ * @param[in] child     the child
+ * @param[in] now       current time in microseconds
+ *
+ * @return  true, if the child did not poll for
+ *          @ref GNRC_NETDEV_INDIRECT_TIMEOUT_US
+ */
+static inline bool gnrc_netdev_indirect_expired(const gnrc_netdev_indirect_child_t *child,
+                                                uint32_t now)
+{
+    return (now - child->last_poll) > GNRC_NETDEV_INDIRECT_TIMEOUT_US;
+}
+
+/**
+ * @brief   Queues a packet for a child
+ *
+ * @param[in,out] child the child
+ * @param[in] pkt       the packet
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if the queue of @p child is full. @p pkt is not released
+ *          in that case.
+ */
+int gnrc_netdev_indirect_push(gnrc_netdev_indirect_child_t *child,
+                              gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Takes the next packet of a child
+ *
+ * @param[in,out] child the child
+ *
+ * @return  the oldest packet of @p child
+ * @return  NULL if the queue of @p child is empty
+ */
+gnrc_pktsnip_t *gnrc_netdev_indirect_pop(gnrc_netdev_indirect_child_t *child);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETDEV_INDIRECT_H */
+/** @} */
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netdev_qos Transmit scheduler for gnrc_netdev
+ * @ingroup     net_gnrc_netdev
+ * @brief       Multi-class transmit queue between @ref net_gnrc_netdev and
+ *              the device driver
+ *
+ * With the module `gnrc_netdev_qos` the @ref net_gnrc_netdev thread does not
+ * hand packets to the driver in the order they arrive. Instead it sorts
+ * them into one queue per traffic class and only transmits while no other
+ * message is pending. This way routing and neighbor discovery messages are
+ * not stuck behind e.g. a large block-wise transfer.
+ *
+ * The classes are
+ * - @ref GNRC_NETDEV_QOS_CONTROL: ICMPv6 (NDP, RPL, ...) and packets with
+ *   the network control DSCPs CS6 and CS7
+ * - @ref GNRC_NETDEV_QOS_LATENCY: packets with DSCP EF (expedited forwarding)
+ * - @ref GNRC_NETDEV_QOS_BULK: everything else
+ *
+ * The queues are served in strict priority order. If
+ * @ref GNRC_NETDEV_QOS_WEIGHTS is defined, they are served weighted
+ * round-robin instead: every class may send as many packets in a row as its
+ * weight says before the next class gets a turn.
+ * @{
+ *
+ * @file
+ * @brief       Multi-class transmit queue definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_NETDEV_QOS_H
+#define NET_GNRC_NETDEV_QOS_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/priority_pktqueue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Traffic classes, in order of priority
+ */
+typedef enum {
+    GNRC_NETDEV_QOS_CONTROL = 0,    /**< control traffic (NDP, RPL, ...) */
+    GNRC_NETDEV_QOS_LATENCY,        /**< latency-sensitive traffic (DSCP EF) */
+    GNRC_NETDEV_QOS_BULK,           /**< all other traffic */
+    GNRC_NETDEV_QOS_NUMOF,          /**< number of traffic classes */
+} gnrc_netdev_qos_class_t;
+
+/**
+ * @brief   Maximum number of packets queued per class
+ *
+ * @details Initializer for an array of @ref GNRC_NETDEV_QOS_NUMOF values.
+ *          Packets for a full class are dropped.
+ */
+#ifndef GNRC_NETDEV_QOS_LIMITS
+#define GNRC_NETDEV_QOS_LIMITS      { 4, 4, 8 }
+#endif
+
+/**
+ * @brief   Total number of packets that can be queued per device
+ */
+#ifndef GNRC_NETDEV_QOS_QUEUE_SIZE
+#define GNRC_NETDEV_QOS_QUEUE_SIZE  (16U)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief   Weights for weighted round-robin scheduling
+ *
+ * @details Initializer for an array of @ref GNRC_NETDEV_QOS_NUMOF values,
+ *          e.g. `{ 4, 2, 1 }`. Leave undefined for strict priority
+ *          scheduling.
+ */
+#define GNRC_NETDEV_QOS_WEIGHTS
+#endif
+
+/**
+ * @brief   DSCP for expedited forwarding (RFC 3246)
+ */
+#define GNRC_NETDEV_QOS_DSCP_EF     (46U)
+
+/**
+ * @brief   DSCP class selector 6 (RFC 2474), used for network control
+ */
+#define GNRC_NETDEV_QOS_DSCP_CS6    (48U)
+
+/**
+ * @brief   Per-device transmit queue state
+ */
+typedef struct {
+    /**
+     * @brief   one FIFO per class
+     */
+    gnrc_priority_pktqueue_t queues[GNRC_NETDEV_QOS_NUMOF];
+    /**
+     * @brief   pool of queue nodes
+     */
+    gnrc_priority_pktqueue_node_t nodes[GNRC_NETDEV_QOS_QUEUE_SIZE];
+    uint8_t len[GNRC_NETDEV_QOS_NUMOF];     /**< packets queued per class */
+#if defined(GNRC_NETDEV_QOS_WEIGHTS) || defined(DOXYGEN)
+    /**
+     * @brief   packets a class may still send in the current round
+     */
+    uint8_t credit[GNRC_NETDEV_QOS_NUMOF];
+#endif
+    uint16_t drops[GNRC_NETDEV_QOS_NUMOF];  /**< packets dropped per class */
+} gnrc_netdev_qos_t;
+
+/**
+ * @brief   Initializes a transmit queue
+ *
+ * @param[out] qos  the transmit queue
+ */
+void gnrc_netdev_qos_init(gnrc_netdev_qos_t *qos);
+
+/**
+ * @brief   Determines the traffic class of an outgoing packet
+ *
+ * @param[in] pkt   packet as handed to gnrc_netdev_t::send(), i.e. starting
+ *                  with a @ref net_gnrc_netif_hdr
+ *
+ * @return  the class of @p pkt
+ */
+gnrc_netdev_qos_class_t gnrc_netdev_qos_classify(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Queues an outgoing packet
+ *
+ * @param[in,out] qos   the transmit queue
+ * @param[in]     pkt   the packet
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if the class of @p pkt or the queue is full. @p pkt is
+ *          not released in that case.
+ */
+int gnrc_netdev_qos_push(gnrc_netdev_qos_t *qos, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Takes the next packet to send from a transmit queue
+ *
+ * @param[in,out] qos   the transmit queue
+ *
+ * @return  the next packet to send
+ * @return  NULL if the queue is empty
+ */
+gnrc_pktsnip_t *gnrc_netdev_qos_pop(gnrc_netdev_qos_t *qos);
+
+/**
+ * @brief   Drops all packets of a transmit queue
+ *
+ * @param[in,out] qos   the transmit queue
+ */
+void gnrc_netdev_qos_flush(gnrc_netdev_qos_t *qos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETDEV_QOS_H */
+/** @} */
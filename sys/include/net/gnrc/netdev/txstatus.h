@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netdev_txstatus Link layer transmission status
+ * @ingroup     net_gnrc_netdev
+ * @brief       Reports the outcome of link layer transmissions to upper
+ *              layers
+ *
+ * With the module `gnrc_netdev_txstatus`, @ref net_gnrc_netdev passes the
+ * result of every transmission the device reports, i.e. whether the
+ * frame was acknowledged, not acknowledged or could not be sent due to a
+ * busy medium, to all subscribers. The status carries the destination, so
+ * e.g. neighbor discovery can mark an unreachable neighbor right away and
+ * TCP can retransmit without waiting for its timeout.
+ *
+ * The module enables @ref NETOPT_TX_END_IRQ on every device, as most
+ * devices do not report the end of a transmission otherwise. It assumes
+ * the device transmits one frame at a time.
+ *
+ * The callbacks of the subscribers run in the thread of the device, they
+ * must be short and must not block, so they should e.g. only forward the
+ * status to their thread with @ref msg_try_send().
+ * @{
+ *
+ * @file
+ * @brief       Link layer transmission status definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_NETDEV_TXSTATUS_H
+#define NET_GNRC_NETDEV_TXSTATUS_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/netdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Value of gnrc_netdev_txstatus_t::retries if the device does not
+ *          report the number of retransmissions
+ */
+#define GNRC_NETDEV_TXSTATUS_RETRIES_UNKNOWN    (0xffU)
+
+/**
+ * @brief   Outcome of a transmission
+ */
+typedef enum {
+    GNRC_NETDEV_TXSTATUS_SUCCESS = 0,   /**< sent, and acknowledged if
+                                             requested */
+    GNRC_NETDEV_TXSTATUS_NOACK,         /**< no ACK after all retries */
+    GNRC_NETDEV_TXSTATUS_BUSY,          /**< medium busy, e.g. CSMA failed */
+    GNRC_NETDEV_TXSTATUS_TIMEOUT,       /**< device timed out sending */
+} gnrc_netdev_txstatus_result_t;
+
+/**
+ * @brief   Status of a transmission
+ */
+typedef struct {
+    kernel_pid_t iface;             /**< interface that sent the frame */
+    uint8_t result;                 /**< @ref gnrc_netdev_txstatus_result_t */
+    uint8_t retries;                /**< retransmissions needed, or
+                                         @ref GNRC_NETDEV_TXSTATUS_RETRIES_UNKNOWN */
+    uint32_t timestamp;             /**< time of the status in microseconds,
+                                         0 without xtimer */
+    uint8_t dst_l2addr_len;         /**< length of the destination, 0 for
+                                         broadcast and multicast */
+    uint8_t dst_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN]; /**< destination */
+} gnrc_netdev_txstatus_t;
+
+/**
+ * @brief   Transmission status callback
+ *
+ * @param[in] status    status of the transmission
+ * @param[in] arg       argument of the subscription
+ */
+typedef void (*gnrc_netdev_txstatus_cb_t)(const gnrc_netdev_txstatus_t *status,
+                                          void *arg);
+
+/**
+ * @brief   Subscription to the transmission status
+ */
+typedef struct gnrc_netdev_txstatus_sub {
+    struct gnrc_netdev_txstatus_sub *next;  /**< next subscription */
+    gnrc_netdev_txstatus_cb_t cb;           /**< callback */
+    void *arg;                              /**< argument for gnrc_netdev_txstatus_sub_t::cb */
+} gnrc_netdev_txstatus_sub_t;
+
+/**
+ * @brief   Destination of the frame in flight, kept by @ref net_gnrc_netdev
+ */
+typedef struct {
+    uint8_t addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];    /**< destination */
+    uint8_t addr_len;                               /**< length of
+                                                         gnrc_netdev_txstatus_dst_t::addr */
+} gnrc_netdev_txstatus_dst_t;
+
+/**
+ * @brief   Subscribe to the transmission status of all interfaces
+ *
+ * @param[in] sub   subscription, with gnrc_netdev_txstatus_sub_t::cb and
+ *                  gnrc_netdev_txstatus_sub_t::arg set, must stay valid
+ *                  until unsubscribed
+ */
+void gnrc_netdev_txstatus_subscribe(gnrc_netdev_txstatus_sub_t *sub);
+
+/**
+ * @brief   Unsubscribe from the transmission status
+ *
+ * @param[in] sub   subscription
+ */
+void gnrc_netdev_txstatus_unsubscribe(gnrc_netdev_txstatus_sub_t *sub);
+
+/**
+ * @brief   Prepares a device for reporting its transmission status
+ *
+ * Called by @ref net_gnrc_netdev after initializing the device.
+ *
+ * @param[in] dev   device
+ */
+void gnrc_netdev_txstatus_init(netdev_t *dev);
+
+/**
+ * @brief   Remembers the destination of a frame handed to the device
+ *
+ * Called by @ref net_gnrc_netdev before sending.
+ *
+ * @param[out] dst  destination of the frame in flight
+ * @param[in] pkt   packet to send, starting with its netif header
+ */
+void gnrc_netdev_txstatus_sent(gnrc_netdev_txstatus_dst_t *dst,
+                               const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Reports a device event to the subscribers, if it is a
+ *          transmission status
+ *
+ * Called by @ref net_gnrc_netdev in the thread of the device.
+ *
+ * @param[in] dev   device
+ * @param[in] iface interface of the device
+ * @param[in] dst   destination of the frame in flight
+ * @param[in] event event of the device
+ */
+void gnrc_netdev_txstatus_event(netdev_t *dev, kernel_pid_t iface,
+                                const gnrc_netdev_txstatus_dst_t *dst,
+                                netdev_event_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETDEV_TXSTATUS_H */
+/** @} */
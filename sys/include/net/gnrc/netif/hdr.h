@@ -87,6 +87,14 @@ typedef struct {
     uint8_t flags;              /**< flags as defined above */
     uint8_t rssi;               /**< rssi of received packet (optional) */
     uint8_t lqi;                /**< lqi of received packet (optional) */
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+    /**
+     * @brief   time the packet was received in microseconds, 0 if unknown
+     *
+     * @note    Only available with module `gnrc_pkttrace`
+     */
+    uint32_t timestamp;
+#endif
 } gnrc_netif_hdr_t;
 
 /**
@@ -105,6 +113,9 @@ static inline void gnrc_netif_hdr_init(gnrc_netif_hdr_t *hdr, uint8_t src_l2addr
     hdr->rssi = 0;
     hdr->lqi = 0;
     hdr->flags = 0;
+#ifdef MODULE_GNRC_PKTTRACE
+    hdr->timestamp = 0;
+#endif
 }
 
 /**
@@ -22,6 +22,7 @@
 #define NET_GNRC_NETREG_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include "kernel_types.h"
 #include "net/gnrc/nettype.h"
@@ -79,6 +80,21 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t with the
+ *          `gnrc_netreg_hash` module
+ *
+ * @details With `gnrc_netreg_hash` the entries of a type are spread over
+ *          this many lists, selected by gnrc_netreg_entry_t::demux_ctx.
+ *          This speeds up gnrc_netreg_lookup() and gnrc_netreg_getnext()
+ *          for types with many registrations (e.g. a lot of UDP ports) at
+ *          the cost of `GNRC_NETTYPE_NUMOF * GNRC_NETREG_HASH_BUCKETS`
+ *          pointers of RAM. Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (8U)
+#endif
+
 /**
  * @brief   Initializes a netreg entry statically with PID
  *
@@ -88,7 +104,7 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#ifdef MODULE_GNRC_NETAPI_MBOX
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -152,6 +168,15 @@ typedef void (*gnrc_netreg_entry_cb_t)(uint16_t cmd, gnrc_pktsnip_t *pkt,
 typedef struct {
     gnrc_netreg_entry_cb_t cb;  /**< the callback */
     void *ctx;                  /**< application context for the callback */
+    /**
+     * @brief   Reports if the target would drop a packet right now
+     *
+     * Asked through gnrc_netreg_full() for a packet a protocol considers
+     * to shed before processing it, so a target that reports being full
+     * should account that packet as dropped. May be NULL, if the target
+     * is never full.
+     */
+    bool (*full)(void *ctx);
 } gnrc_netreg_entry_cbd_t;
 #endif
 
@@ -331,6 +356,25 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  */
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Checks if all entries with the same gnrc_netreg_entry_t::type and
+ *          gnrc_netreg_entry_t::demux_ctx are full
+ *
+ * Protocols can use this to shed a packet before processing it, if it would be
+ * dropped by all its receivers anyway. Only entries of type
+ * @ref GNRC_NETREG_TYPE_MBOX and of type @ref GNRC_NETREG_TYPE_CB with
+ * gnrc_netreg_entry_cbd_t::full can be full.
+ *
+ * @param[in] type      Type of the protocol.
+ * @param[in] demux_ctx The demultiplexing context for the registered thread.
+ *                      See gnrc_netreg_entry_t::demux_ctx.
+ *
+ * @return  true, if there are entries for @p type and @p demux_ctx and all of
+ *          them are full.
+ * @return  false, otherwise.
+ */
+bool gnrc_netreg_full(gnrc_nettype_t type, uint32_t demux_ctx);
+
 /**
  * @brief   Returns the next entry after @p entry with the same
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pcap Stream network packets as pcap records
+ * @ingroup     net_gnrc
+ * @brief       Packet sink for sniffers, keeping up with the radio
+ *
+ * Unlike @ref net_gnrc_pktdump, which formats packets as text, this module
+ * copies them as binary records into a ring buffer. The buffer is sent out
+ * over a UART in the background, with DMA where the CPU supports
+ * uart_write_async(). Packets arriving while the buffer is full are dropped
+ * and their number is reported with the next record.
+ *
+ * Register the thread for the packets to capture, usually all raw frames of
+ * an interface in promiscuous mode:
+ *
+ * @code
+ * gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+ *                                                        gnrc_pcap_pid);
+ * gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+ * @endcode
+ *
+ * Each record is framed like in @ref drivers_ethos: it starts and ends with
+ * 0x7E, and 0x7E and 0x7D in the frame are sent as 0x7D followed by the byte
+ * XOR 0x20. Output outside frames, e.g. stdio sharing the UART, is text. A
+ * frame consists of a @ref gnrc_pcap_hdr_t and at most @ref GNRC_PCAP_SNAPLEN
+ * bytes of the packet. `dist/tools/sniffer/pcap_stream.py` converts the
+ * stream into a pcap file for Wireshark.
+ *
+ * The timestamp is taken when the packet reaches this thread, so it lags the
+ * reception by the latency of the stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface of the pcap packet sink
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef NET_GNRC_PCAP_H
+#define NET_GNRC_PCAP_H
+
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "kernel_types.h"
+#include "uart_stdio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   UART to stream the records to
+ *
+ * If this is the stdio UART, its configuration is kept.
+ */
+#ifndef GNRC_PCAP_UART
+#define GNRC_PCAP_UART                  (UART_STDIO_DEV)
+#endif
+
+/**
+ * @brief   Baudrate of @ref GNRC_PCAP_UART if it is not the stdio UART
+ */
+#ifndef GNRC_PCAP_BAUDRATE
+#define GNRC_PCAP_BAUDRATE              (UART_STDIO_BAUDRATE)
+#endif
+
+/**
+ * @brief   Size of the ring buffer holding the framed records, must be a
+ *          power of two
+ */
+#ifndef GNRC_PCAP_BUFSIZE
+#define GNRC_PCAP_BUFSIZE               (2048U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes of a packet that are recorded
+ */
+#ifndef GNRC_PCAP_SNAPLEN
+#define GNRC_PCAP_SNAPLEN               (256U)
+#endif
+
+/**
+ * @brief   Message queue size for the pcap thread
+ */
+#ifndef GNRC_PCAP_MSG_QUEUE_SIZE
+#define GNRC_PCAP_MSG_QUEUE_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Priority of the pcap thread
+ */
+#ifndef GNRC_PCAP_PRIO
+#define GNRC_PCAP_PRIO                  (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Stack size used for the pcap thread
+ */
+#ifndef GNRC_PCAP_STACKSIZE
+#define GNRC_PCAP_STACKSIZE             (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Header of a record, all fields in network byte order
+ */
+typedef struct __attribute__((packed)) {
+    network_uint32_t sec;       /**< seconds since boot */
+    network_uint32_t usec;      /**< microseconds of the second */
+    network_uint16_t len;       /**< length of the packet, before it was
+                                 *   truncated to @ref GNRC_PCAP_SNAPLEN */
+    network_uint16_t dropped;   /**< packets dropped since the last record,
+                                 *   saturating */
+    uint8_t if_pid;             /**< interface the packet was received on */
+    uint8_t rssi;               /**< RSSI from the netif header, device
+                                 *   specific */
+    uint8_t lqi;                /**< LQI from the netif header */
+    uint8_t reserved;           /**< reserved, 0 */
+} gnrc_pcap_hdr_t;
+
+/**
+ * @brief   The PID of the pcap thread
+ */
+extern kernel_pid_t gnrc_pcap_pid;
+
+/**
+ * @brief   Start the pcap thread
+ *
+ * @return  PID of the pcap thread
+ * @return  negative value on error
+ */
+kernel_pid_t gnrc_pcap_init(void);
+
+/**
+ * @brief   Get the total number of packets that were dropped because the
+ *          ring buffer was full
+ *
+ * @return  number of dropped packets
+ */
+uint32_t gnrc_pcap_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PCAP_H */
+/** @} */
@@ -58,6 +58,33 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Configuration of the `gnrc_pktbuf_pool` implementation
+ *
+ * Instead of one buffer shared by all allocations, `gnrc_pktbuf_pool` uses
+ * separate pools of fixed size blocks for snip descriptors, small data (e.g.
+ * headers) and large data (e.g. payloads). Allocation and release are O(1)
+ * and there is no external fragmentation, but data larger than
+ * @ref GNRC_PKTBUF_POOL_LARGE_SIZE can not be allocated.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_POOL_SNIP_NUMOF
+#define GNRC_PKTBUF_POOL_SNIP_NUMOF     (48U)   /**< number of snip descriptors */
+#endif
+#ifndef GNRC_PKTBUF_POOL_SMALL_SIZE
+#define GNRC_PKTBUF_POOL_SMALL_SIZE     (64U)   /**< size of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_POOL_SMALL_NUMOF
+#define GNRC_PKTBUF_POOL_SMALL_NUMOF    (32U)   /**< number of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_POOL_LARGE_SIZE
+#define GNRC_PKTBUF_POOL_LARGE_SIZE     (1536U) /**< size of large blocks */
+#endif
+#ifndef GNRC_PKTBUF_POOL_LARGE_NUMOF
+#define GNRC_PKTBUF_POOL_LARGE_NUMOF    (3U)    /**< number of large blocks */
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -187,6 +214,47 @@ static inline void gnrc_pktbuf_release(gnrc_pktsnip_t *pkt)
  */
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Gets write access to the headers of a packet, but keeps sharing its
+ *          payload.
+ *
+ * @details Calls gnrc_pktbuf_start_write() for @p pkt and every following
+ *          snip up to the first one of type @ref GNRC_NETTYPE_UNDEF. That
+ *          snip and the rest of the packet are not duplicated, but stay
+ *          shared with the other users. Use this when only header fields
+ *          (addresses, lengths, checksums) of a held packet are rewritten,
+ *          e.g. when sending it over several interfaces.
+ *
+ * @note    Do *not* call this function in a thread twice on the same packet.
+ *
+ * @param[in] pkt   The packet whose headers you want to write into.
+ *
+ * @return  The (new) pointer to the pkt.
+ * @return  NULL, if there is not enough space in the packet buffer. @p pkt
+ *          is released in that case.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_hdrs(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Prepends a new header to a packet that stays shared
+ *
+ * @details In contrast to gnrc_pktbuf_add() the caller keeps its reference to
+ *          @p pkt: the packet is held once more for the new header, so it can
+ *          be prepended with different headers several times without
+ *          copying it.
+ *
+ * @param[in] pkt   The (shared) packet to prepend the header to.
+ * @param[in] data  Data of the new header. If @p data is NULL the header is
+ *                  left uninitialized.
+ * @param[in] size  Length of @p data.
+ * @param[in] type  Protocol type of the header.
+ *
+ * @return  The new header with @p pkt as its gnrc_pktsnip_t::next.
+ * @return  NULL, if there is not enough space in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_prepend_shared(gnrc_pktsnip_t *pkt, void *data,
+                                           size_t size, gnrc_nettype_t type);
+
 /**
  * @brief   Create a IOVEC representation of the packet pointed to by *pkt*
  *
@@ -286,6 +354,57 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
 void gnrc_pktbuf_stats(void);
 #endif
 
+#if defined(MODULE_GNRC_PKTBUF_COUNTERS) || defined(DOXYGEN)
+/**
+ * @brief   Number of packet types allocation failures are counted for
+ */
+#define GNRC_PKTBUF_COUNTERS_TYPES  (GNRC_NETTYPE_NUMOF - GNRC_NETTYPE_IOVEC)
+
+/**
+ * @brief   Packet buffer counters, requires the `gnrc_pktbuf_counters` module
+ */
+typedef struct {
+    size_t used;            /**< bytes currently allocated, including snip
+                                 descriptors and padding */
+    size_t peak;            /**< maximum of gnrc_pktbuf_counters_t::used */
+    size_t largest_free;    /**< largest data size that can currently be
+                                 allocated */
+    uint32_t refs;          /**< references to snips taken, by allocation or
+                                 gnrc_pktbuf_hold() */
+    uint32_t unrefs;        /**< references to snips released */
+    /**
+     * @brief   allocation failures, by type of the snip that was to be
+     *          allocated, index is `type - GNRC_NETTYPE_IOVEC`
+     */
+    uint32_t fails[GNRC_PKTBUF_COUNTERS_TYPES];
+} gnrc_pktbuf_counters_t;
+
+/**
+ * @brief   Allocation failure callback type
+ *
+ * Called with the packet buffer locked, must not call any gnrc_pktbuf
+ * function.
+ *
+ * @param[in] type  type of the snip that was to be allocated
+ * @param[in] size  size of the data that was to be allocated
+ */
+typedef void (*gnrc_pktbuf_fail_cb_t)(gnrc_nettype_t type, size_t size);
+
+/**
+ * @brief   Get a copy of the packet buffer counters
+ *
+ * @param[out] counters target for the counters
+ */
+void gnrc_pktbuf_get_counters(gnrc_pktbuf_counters_t *counters);
+
+/**
+ * @brief   Set a callback to be called on every allocation failure
+ *
+ * @param[in] cb    the callback, NULL to disable
+ */
+void gnrc_pktbuf_set_fail_cb(gnrc_pktbuf_fail_cb_t cb);
+#endif
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
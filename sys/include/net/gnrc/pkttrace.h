@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pkttrace Packet latency tracing
+ * @ingroup     net_gnrc
+ * @brief       Records when packets enter and leave the layers of GNRC
+ *
+ * With the module `gnrc_pkttrace` @ref net_gnrc_netdev, @ref net_gnrc_sixlowpan,
+ * @ref net_gnrc_ipv6, @ref net_gnrc_udp and @ref net_gnrc_sock log every
+ * packet they start and finish handling, for both directions. This gives
+ *
+ * - a histogram per layer and direction of the time a packet spent in that
+ *   layer, and
+ * - a ring buffer of the most recent trace points. For received packets every
+ *   entry also holds the time since the frame was read from the device,
+ *   which @ref net_gnrc_netdev stores in gnrc_netif_hdr_t::timestamp.
+ *
+ * The time for a layer is measured between its entry and exit trace points.
+ * Since every layer handles one packet at a time in its own thread this
+ * needs no per-packet state.
+ *
+ * The shell command `pkttrace` prints the collected data.
+ * @{
+ *
+ * @file
+ * @brief       Packet latency tracing definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_PKTTRACE_H
+#define NET_GNRC_PKTTRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the trace log
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_PKTTRACE_LOG_SIZE
+#define GNRC_PKTTRACE_LOG_SIZE      (32U)
+#endif
+
+/**
+ * @brief   Number of histogram buckets of @ref gnrc_pkttrace_stats_t
+ *
+ * Bucket 0 counts the value 0, bucket n > 0 counts values in
+ * [2^(n-1), 2^n), the last bucket also counts all larger values.
+ */
+#ifndef GNRC_PKTTRACE_BUCKETS
+#define GNRC_PKTTRACE_BUCKETS       (16U)
+#endif
+
+/**
+ * @brief   Traced layers
+ */
+typedef enum {
+    GNRC_PKTTRACE_NETDEV = 0,       /**< @ref net_gnrc_netdev */
+    GNRC_PKTTRACE_SIXLOWPAN,        /**< @ref net_gnrc_sixlowpan */
+    GNRC_PKTTRACE_IPV6,             /**< @ref net_gnrc_ipv6 */
+    GNRC_PKTTRACE_UDP,              /**< @ref net_gnrc_udp */
+    GNRC_PKTTRACE_SOCK,             /**< @ref net_gnrc_sock */
+    GNRC_PKTTRACE_LAYER_NUMOF,      /**< number of traced layers */
+} gnrc_pkttrace_layer_t;
+
+/**
+ * @brief   Directions of a packet
+ */
+typedef enum {
+    GNRC_PKTTRACE_RX = 0,           /**< received packet */
+    GNRC_PKTTRACE_TX,               /**< packet to send */
+    GNRC_PKTTRACE_DIR_NUMOF,        /**< number of directions */
+} gnrc_pkttrace_dir_t;
+
+/**
+ * @brief   Entry of the trace log
+ */
+typedef struct {
+    uint32_t time;          /**< time of the trace point in microseconds */
+    uint32_t since_rx;      /**< microseconds since the frame was received,
+                             *   0 if unknown (e.g. for sent packets) */
+    uint8_t layer;          /**< @ref gnrc_pkttrace_layer_t */
+    uint8_t dir;            /**< @ref gnrc_pkttrace_dir_t */
+    bool exit;              /**< the layer finished handling the packet */
+} gnrc_pkttrace_entry_t;
+
+/**
+ * @brief   Time spent per layer
+ */
+typedef struct {
+    /**
+     * @brief   histograms of the time between entry and exit in microseconds
+     */
+    uint32_t hist[GNRC_PKTTRACE_LAYER_NUMOF][GNRC_PKTTRACE_DIR_NUMOF][GNRC_PKTTRACE_BUCKETS];
+    /**
+     * @brief   longest time between entry and exit in microseconds
+     */
+    uint32_t max[GNRC_PKTTRACE_LAYER_NUMOF][GNRC_PKTTRACE_DIR_NUMOF];
+} gnrc_pkttrace_stats_t;
+
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+/**
+ * @brief   Stores the current time in the netif header of a received packet
+ *
+ * @param[in] pkt   a received packet. May be NULL or without netif header.
+ */
+void gnrc_pkttrace_stamp(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Logs that a layer starts handling a packet
+ *
+ * @param[in] layer the layer
+ * @param[in] dir   the direction of @p pkt
+ * @param[in] pkt   the packet. May be NULL if it is not known yet.
+ */
+void gnrc_pkttrace_enter(gnrc_pkttrace_layer_t layer, gnrc_pkttrace_dir_t dir,
+                         gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Logs that a layer finished handling a packet
+ *
+ * @param[in] layer the layer
+ * @param[in] dir   the direction of @p pkt
+ * @param[in] pkt   the packet. May be NULL if it was already handed on.
+ */
+void gnrc_pkttrace_exit(gnrc_pkttrace_layer_t layer, gnrc_pkttrace_dir_t dir,
+                        gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Copies the trace log
+ *
+ * @param[out] log      target for the entries, oldest first
+ * @param[in] numof     number of entries @p log can hold
+ *
+ * @return  number of entries copied into @p log
+ */
+unsigned gnrc_pkttrace_get_log(gnrc_pkttrace_entry_t *log, unsigned numof);
+
+/**
+ * @brief   Gets a copy of the per-layer statistics
+ *
+ * @param[out] stats    target for the data
+ */
+void gnrc_pkttrace_get_stats(gnrc_pkttrace_stats_t *stats);
+
+/**
+ * @brief   Resets the trace log and the statistics
+ */
+void gnrc_pkttrace_reset(void);
+#else
+static inline void gnrc_pkttrace_stamp(gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+}
+
+static inline void gnrc_pkttrace_enter(gnrc_pkttrace_layer_t layer,
+                                       gnrc_pkttrace_dir_t dir,
+                                       gnrc_pktsnip_t *pkt)
+{
+    (void)layer;
+    (void)dir;
+    (void)pkt;
+}
+
+static inline void gnrc_pkttrace_exit(gnrc_pkttrace_layer_t layer,
+                                      gnrc_pkttrace_dir_t dir,
+                                      gnrc_pktsnip_t *pkt)
+{
+    (void)layer;
+    (void)dir;
+    (void)pkt;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTTRACE_H */
+/** @} */
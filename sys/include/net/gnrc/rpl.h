@@ -24,6 +24,22 @@
  *   USEMODULE += gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - RPL (Non-Storing Mode), with the source routing headers that the root
+ *   uses for downward routes (see @ref net_gnrc_rpl_srh)
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl
+ *   USEMODULE += gnrc_rpl_srh
+ *   CFLAGS += -DGNRC_RPL_DEFAULT_MOP=GNRC_RPL_MOP_NON_STORING_MODE
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * - RPL with parents selected by the ETX of the links (see
+ *   @ref net_gnrc_rpl_mrhof)
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl
+ *   USEMODULE += gnrc_rpl_mrhof
+ *   CFLAGS += -DGNRC_RPL_DEFAULT_OCP=1
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * - RPL auto-initialization on interface
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
  *   USEMODULE += auto_init_gnrc_rpl
@@ -193,12 +209,18 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
  * @brief   Default Objective Code Point (OF0)
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -280,6 +302,43 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #endif
 /** @} */
 
+/**
+ * @brief   Fraction of its interval by which a trickle timer may fire early
+ *
+ * When the trickle timer of one instance sends a DIO, the timers of the other
+ * instances on the same interface that are due within 1/@p
+ * GNRC_RPL_DIO_BATCH_DIVISOR of their interval fire right away, so the DIOs
+ * go out in one burst instead of waking the radio several times. 0 disables
+ * this.
+ */
+#ifndef GNRC_RPL_DIO_BATCH_DIVISOR
+#define GNRC_RPL_DIO_BATCH_DIVISOR (8)
+#endif
+
+/**
+ * @name Adaptive DIO redundancy constant
+ *
+ * The distinct senders of DIOs of a DODAG within the last two periods of
+ * @ref GNRC_RPL_DIO_DENSITY_PERIOD seconds estimate the number of neighbors.
+ * Above @ref GNRC_RPL_DIO_DENSITY_REF neighbors the redundancy constant of
+ * the DODAG configuration is lowered proportionally, but not below
+ * @ref GNRC_RPL_DIO_REDUNDANCY_MIN, so dense neighborhoods send fewer DIOs
+ * per interval. A redundancy constant of 0 (infinity) is never changed.
+ * @{
+ */
+#ifndef GNRC_RPL_DIO_DENSITY_REF
+#define GNRC_RPL_DIO_DENSITY_REF (16)
+#endif
+
+#ifndef GNRC_RPL_DIO_REDUNDANCY_MIN
+#define GNRC_RPL_DIO_REDUNDANCY_MIN (2)
+#endif
+
+#ifndef GNRC_RPL_DIO_DENSITY_PERIOD
+#define GNRC_RPL_DIO_DENSITY_PERIOD (600)
+#endif
+/** @} */
+
 /**
  * @name Default parent and route entry lifetime
  * default lifetime will be multiplied by the lifetime unit to obtain the resulting lifetime
@@ -337,6 +396,16 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #ifndef GNRC_RPL_DEFAULT_DAO_DELAY
 #define GNRC_RPL_DEFAULT_DAO_DELAY (1)
 #endif
+/**
+ * @brief   Maximum random time in seconds added to
+ *          @ref GNRC_RPL_DEFAULT_DAO_DELAY
+ *
+ * Spreads the DAOs of the nodes that all react to the same event, e.g. a new
+ * DODAG version after a global repair.
+ */
+#ifndef GNRC_RPL_DAO_DELAY_JITTER
+#define GNRC_RPL_DAO_DELAY_JITTER (2)
+#endif
 /** @} */
 
 /**
@@ -564,6 +633,12 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
 /**
  * @brief   Delay the DAO sending interval
  *
+ * Schedules a DAO after @ref GNRC_RPL_DEFAULT_DAO_DELAY plus a random
+ * jitter. An already scheduled DAO is not postponed, so the targets of all
+ * DAOs received until then go into one DAO. While a DAO waits for its DAO-ACK,
+ * the next one is only scheduled when the DAO-ACK arrives or with the
+ * retransmission.
+ *
  * @param[in] dodag     The DODAG of the DAO
  */
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
@@ -169,6 +169,31 @@ void gnrc_rpl_leaf_operation(gnrc_rpl_dodag_t *dodag);
  * @param[in] dodag     Pointer to the DODAG
  */
 void gnrc_rpl_router_operation(gnrc_rpl_dodag_t *dodag);
+
+/**
+ * @brief   Notes the sender of a DIO of @p dodag and adapts the redundancy
+ *          constant of its trickle timer to the number of neighbors
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] src       Source address of the DIO
+ */
+void gnrc_rpl_dio_sender_add(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *src);
+
+/**
+ * @brief   Starts a new period of @ref GNRC_RPL_DIO_DENSITY_PERIOD for the
+ *          DIO senders of @p dodag
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ */
+void gnrc_rpl_dio_senders_age(gnrc_rpl_dodag_t *dodag);
+
+/**
+ * @brief   Sets the redundancy constant of the trickle timer of @p dodag from
+ *          gnrc_rpl_dodag_t::dio_redun and the number of neighbors
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ */
+void gnrc_rpl_dio_redundancy_update(gnrc_rpl_dodag_t *dodag);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof RPL Minimum Rank with Hysteresis Objective Function
+ * @ingroup     net_gnrc_rpl
+ * @brief       MRHOF with the ETX metric
+ *
+ * With the module `gnrc_rpl_mrhof` RPL can select parents by the expected
+ * transmission count (ETX) of the path to the root instead of the hop count
+ * of @ref net_gnrc_rpl "OF0". The link ETX comes from
+ * @ref net_netstats_neighbor, the path cost via a parent is its rank plus
+ * the ETX of the link to it in units of 1/128, and the rank of a node is its
+ * path cost, but at least one MinHopRankIncrease more than the rank of its
+ * preferred parent. MRHOF is used when the root announces its objective code
+ * point (OCP) 1, so the root selects it with
+ *
+ *     CFLAGS += -DGNRC_RPL_DEFAULT_OCP=1
+ *
+ * Without a DAG metric container the ETX is not advertised, so it is
+ * carried in the rank as RFC 6719 allows.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_RPL_MRHOF_H
+#define NET_GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective code point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (0x1)
+
+/**
+ * @brief   Maximum ETX of a link to a parent, in units of 1/128
+ *
+ * Parents behind worse links are not used.
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+
+/**
+ * @brief   Maximum path cost via a parent
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_PATH_COST
+#define GNRC_RPL_MRHOF_MAX_PATH_COST            (32768U)
+#endif
+
+/**
+ * @brief   Decrease of the path cost needed to switch the preferred parent
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_MRHOF_H */
+/** @} */
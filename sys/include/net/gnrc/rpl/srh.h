@@ -10,9 +10,21 @@
  * @defgroup    net_gnrc_rpl_srh RPL source routing header extension
  * @ingroup     net_gnrc_rpl
  * @brief       Implementation of RPL source routing extension headers
+ *
+ * Besides processing source routing headers, the module keeps the downward
+ * routes of a DODAG root in non-storing mode. Instead of one FIB entry with
+ * full addresses per node, the root stores the DAO parent of every node as
+ * an index into a compact table of 16 bytes per node and builds the source
+ * routing header for a destination from these parent pointers when sending
+ * to it (see gnrc_rpl_srh_build()). The addresses in it are shortened by the
+ * prefix they share with the first hop.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc6554">
  *          RFC 6554
  *      </a>
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7, Non-storing Mode
+ *      </a>
  * @{
  *
  * @file
@@ -23,6 +35,9 @@
 #ifndef NET_GNRC_RPL_SRH_H
 #define NET_GNRC_RPL_SRH_H
 
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -35,6 +50,32 @@ extern "C" {
  */
 #define GNRC_RPL_SRH_TYPE   (3U)
 
+/**
+ * @brief   Number of nodes a DODAG root in non-storing mode can store the
+ *          parents of
+ */
+#ifndef GNRC_RPL_SRH_TABLE_SIZE
+#define GNRC_RPL_SRH_TABLE_SIZE         (16U)
+#endif
+
+/**
+ * @brief   Number of different 64-bit prefixes the nodes in the source route
+ *          table can have
+ */
+#ifndef GNRC_RPL_SRH_TABLE_PREFIX_NUMOF
+#define GNRC_RPL_SRH_TABLE_PREFIX_NUMOF (2U)
+#endif
+
+/**
+ * @brief   Maximum number of addresses in a source routing header built by
+ *          gnrc_rpl_srh_build()
+ *
+ * Longer paths are treated as routing loops.
+ */
+#ifndef GNRC_RPL_SRH_MAX_HOPS
+#define GNRC_RPL_SRH_MAX_HOPS           (16U)
+#endif
+
 /**
  * @brief   The RPL Source routing header.
  *
@@ -66,6 +107,57 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh);
 
+/**
+ * @brief   Sets the DAO parent of a node in the source route table
+ *
+ * A parent that is not in the table yet is added without a parent of its
+ * own, until it announces one itself.
+ *
+ * @param[in] target    The address of the node.
+ * @param[in] parent    The address of the DAO parent of @p target, NULL if it
+ *                      is the DODAG root itself.
+ * @param[in] lifetime  Lifetime of the route in seconds. 0 removes
+ *                      @p target.
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if the table or the prefixes of the table are full
+ */
+int gnrc_rpl_srh_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                           uint32_t lifetime);
+
+/**
+ * @brief   Removes a node from the source route table
+ *
+ * Nodes that have @p target as parent stay in the table, but can not be
+ * routed to until they announce a new parent.
+ *
+ * @param[in] target    The address of the node.
+ */
+void gnrc_rpl_srh_table_remove(const ipv6_addr_t *target);
+
+/**
+ * @brief   Removes all nodes from the source route table
+ */
+void gnrc_rpl_srh_table_flush(void);
+
+/**
+ * @brief   Builds the source routing header to a node in the source route
+ *          table
+ *
+ * The header lists all hops after the first one up to @p dst. Its next
+ * header field is left for the caller to set, before it sets the
+ * destination address of the IPv6 header to @p first_hop.
+ *
+ * @param[in] dst           The final destination.
+ * @param[out] first_hop    The first hop on the path to @p dst.
+ *
+ * @return  The source routing header, with the type
+ *          @ref GNRC_NETTYPE_IPV6_EXT if available.
+ * @return  NULL if @p dst is not in the table, is a child of the root, its
+ *          path is broken or too long, or the packet buffer is full.
+ */
+gnrc_pktsnip_t *gnrc_rpl_srh_build(const ipv6_addr_t *dst, ipv6_addr_t *first_hop);
+
 #ifdef __cplusplus
 }
 #endif
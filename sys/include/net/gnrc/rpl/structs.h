@@ -269,9 +269,12 @@ struct gnrc_rpl_dodag {
     uint8_t dao_seq;                /**< dao sequence number */
     uint8_t dao_counter;            /**< amount of retried DAOs */
     bool dao_ack_received;          /**< flag to check for DAO-ACK */
+    bool dao_pending;               /**< DAO scheduled while waiting for a DAO-ACK */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     uint8_t dao_time;               /**< time to schedule a DAO in seconds */
+    uint32_t dio_senders[2][2];     /**< 64 bit filters of the DIO senders in
+                                         the current and the previous period */
     trickle_t trickle;              /**< trickle representation */
 };
 
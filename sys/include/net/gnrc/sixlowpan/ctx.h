@@ -38,6 +38,18 @@ extern "C" {
 #define GNRC_SIXLOWPAN_CTX_SIZE (16)    /**< maximum number of entries in
                                          *   context buffer */
 
+/**
+ * @brief   Number of addresses to remember the result of
+ *          gnrc_sixlowpan_ctx_lookup_addr() for
+ *
+ * Spares the prefix match against all contexts for the source and
+ * destination of every compressed packet in a steady flow. The results are
+ * dropped whenever a context is updated. 0 disables the cache.
+ */
+#ifndef GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+#define GNRC_SIXLOWPAN_CTX_CACHE_SIZE   (4U)
+#endif
+
 /**
  * @{
  * @name    Context flags.
@@ -11,9 +11,37 @@
  * @defgroup    net_gnrc_sixlowpan_frag   6LoWPAN Fragmentation
  * @ingroup     net_gnrc_sixlowpan
  * @brief       6LoWPAN Fragmentation headers and functionality
+ *
+ * With the module `gnrc_sixlowpan_frag_vrb` a router forwards the fragments
+ * of datagrams not addressed to itself as they arrive, instead of
+ * reassembling the datagram first. Only the IPv6 header of the first fragment
+ * is decompressed to find the next hop, the following fragments are sent on
+ * with their tag replaced. Datagrams for the router itself, to a non-6LoWPAN
+ * interface, or whose first fragment did not arrive first are still
+ * reassembled. Not available with @ref net_gnrc_netapi_direct.
+ *
+ * With the module `gnrc_sixlowpan_frag_sfr` datagrams to a unicast
+ * destination are sent as recoverable fragments (RFRAG) instead. The
+ * receiver acknowledges the fragments it got with a bitmap whenever the
+ * sender asks for it with the last fragment of a round, and only the
+ * fragments missing in that bitmap are sent again, until the datagram is
+ * acknowledged completely or @ref GNRC_SIXLOWPAN_FRAG_SFR_RETRIES rounds
+ * failed. The receiver needs `gnrc_sixlowpan_frag_sfr` as well. Datagrams of
+ * more than 32 fragments, multicast datagrams, and datagrams sent while
+ * another one is still being recovered use the fragmentation of RFC 4944.
+ * Other than RFC 8931 allows, a receiver only stores fragments that arrive
+ * after the first one and does not forward fragments. Not available with
+ * @ref net_gnrc_netapi_direct.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly
+ *      </a>
+ * @see <a href="https://tools.ietf.org/html/rfc8931">
+ *          RFC 8931
+ *      </a>
  * @{
  *
  * @file
@@ -32,16 +60,59 @@
 #include "kernel_types.h"
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief   Message type for passing one 6LoWPAN fragment down the network stack
+ * @brief   Message type for sending the (next) fragments of a datagram
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Message type for removing timed out datagrams from the
+ *          reassembly buffer
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF (0x0226)
+
+/**
+ * @brief   Message type for sending the next recoverable fragment
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND     (0x0227)
+
+/**
+ * @brief   Message type for the timeout of an RFRAG-ACK
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT (0x0228)
+
+/**
+ * @brief   Gap in microseconds between the fragments of a datagram
+ *
+ * With the default of 0 all fragments of a datagram are handed to the
+ * interface in one burst. A gap gives the receiver time to process a
+ * fragment and lowers the chance of collisions with hidden nodes that
+ * forward the previous fragment.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_PACING
+#define GNRC_SIXLOWPAN_FRAG_PACING          (0U)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait for an RFRAG-ACK
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RTO
+#define GNRC_SIXLOWPAN_FRAG_SFR_RTO         (500U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of times missing recoverable fragments are sent again
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RETRIES
+#define GNRC_SIXLOWPAN_FRAG_SFR_RETRIES     (3U)
+#endif
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -51,16 +122,28 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+    uint16_t tag;           /**< Tag of the datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
 /**
  * @brief   Sends a packet fragmented.
  *
+ * Sends all fragments at once, or with @ref GNRC_SIXLOWPAN_FRAG_PACING
+ * one fragment and the next one on a @ref GNRC_SIXLOWPAN_MSG_FRAG_SND after
+ * the gap.
+ *
  * @param[in] fragment_msg    Message containing status of the 6LoWPAN
  *                            fragmentation progress
  */
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
 
+/**
+ * @brief   Gets a new datagram tag for sending fragments
+ *
+ * @return  a tag not used for the last 65535 datagrams sent fragmented
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Handles a packet containing a fragment header.
  *
@@ -68,6 +151,43 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Removes timed out datagrams from the reassembly buffer
+ *
+ * Called on @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF, which the reassembly
+ * buffer schedules itself while datagrams are incomplete.
+ */
+void gnrc_sixlowpan_frag_rbuf_gc(void);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Starts sending a datagram as recoverable fragments
+ *
+ * @param[in] pkt   The compressed datagram, starting with its
+ *                  @ref net_gnrc_netif_hdr.
+ *
+ * @return  true, if the datagram is sent as recoverable fragments and
+ *          @p pkt is taken over
+ * @return  false, if the datagram has to be fragmented otherwise
+ */
+bool gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Handles @ref GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND and
+ *          @ref GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT
+ *
+ * @param[in] type  The type of the message.
+ */
+void gnrc_sixlowpan_frag_sfr_event(uint16_t type);
+
+/**
+ * @brief   Handles a packet containing an RFRAG or RFRAG-ACK header.
+ *
+ * @param[in] pkt   The packet to handle.
+ */
+void gnrc_sixlowpan_frag_sfr_handle_pkt(gnrc_pktsnip_t *pkt);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
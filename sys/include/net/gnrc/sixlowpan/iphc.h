@@ -10,6 +10,14 @@
  * @defgroup    net_gnrc_sixlowpan_iphc   IPv6 header compression (IPHC)
  * @ingroup     net_gnrc_sixlowpan
  * @brief       IPv6 header compression for 6LoWPAN.
+ *
+ * With the module `gnrc_sixlowpan_iphc_nhc` the UDP header and the IPv6
+ * Hop-by-Hop Options, Routing, Destination Options and Mobility headers
+ * following the IPv6 header are compressed with LOWPAN_NHC.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6282#section-4">
+ *          RFC 6282, section 4
+ *      </a>
  * @{
  *
  * @file
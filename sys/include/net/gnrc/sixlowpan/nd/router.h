@@ -23,8 +23,11 @@
 #include <stdbool.h>
 
 #include "bitfield.h"
+#include "net/eui64.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan/nd.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +54,56 @@ extern "C" {
         (GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF * GNRC_NETIF_NUMOF)
 #endif
 
+/**
+ * @brief   Number of address registrations the router keeps at maximum
+ *
+ * @details On a 6LBR this also caches the results of multihop duplicate
+ *          address detection, so it should be sized for the whole network.
+ *          Must be smaller than UINT16_MAX.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF      (GNRC_IPV6_NC_SIZE)
+#endif
+
+/**
+ * @brief   Number of buckets of the address and EUI-64 hashes of the
+ *          registration table
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS    (16U)
+#endif
+
+/**
+ * @brief   Number of one minute slots of the timer wheel expiring the
+ *          registrations
+ *
+ * @details Registrations with a longer lifetime stay in their slot for
+ *          several rounds of the wheel.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE (64U)
+#endif
+
+/**
+ * @brief   An address registration on a (border) router
+ *
+ * @details The table entries are chained through their indexes into the
+ *          address hash, the EUI-64 hash and the timer wheel. Free entries
+ *          have the unspecified address.
+ */
+typedef struct {
+    ipv6_addr_t addr;       /**< the registered address */
+    eui64_t eui64;          /**< EUI-64 of the registering node */
+    kernel_pid_t iface;     /**< interface the registration was received on,
+                             *   KERNEL_PID_UNDEF for registrations via DAR */
+    uint16_t expires;       /**< minute of the table's clock the registration ends in */
+    uint16_t addr_next;     /**< next entry in the address hash bucket */
+    uint16_t eui64_next;    /**< next entry in the EUI-64 hash bucket */
+    uint16_t wheel_next;    /**< next entry in the timer wheel slot */
+} gnrc_sixlowpan_nd_router_reg_t;
+
 /**
  * @brief   Representation for prefixes coming from a router
  */
@@ -153,6 +206,67 @@ bool gnrc_sixlowpan_nd_router_abr_older(sixlowpan_nd_opt_abr_t *abr_opt);
  */
 void gnrc_sixlowpan_nd_router_abr_remove(gnrc_sixlowpan_nd_router_abr_t *abr);
 
+/**
+ * @brief   Gets the registration of an address.
+ *
+ * @note    The registration table must only be used from the IPv6 thread.
+ *
+ * @param[in] addr  A registered address.
+ *
+ * @return  The registration of @p addr.
+ * @return  NULL, if @p addr is not registered.
+ */
+gnrc_sixlowpan_nd_router_reg_t *gnrc_sixlowpan_nd_router_reg_get(const ipv6_addr_t *addr);
+
+/**
+ * @brief   Iterates over the registrations of a node.
+ *
+ * @param[in] eui64 The EUI-64 of the node.
+ * @param[in] prev  The registration returned by the previous call. NULL to
+ *                  get the first registration.
+ *
+ * @return  The next registration of @p eui64.
+ * @return  NULL, if there are no more registrations.
+ */
+gnrc_sixlowpan_nd_router_reg_t *gnrc_sixlowpan_nd_router_reg_get_by_eui64(const eui64_t *eui64,
+                                                                         gnrc_sixlowpan_nd_router_reg_t *prev);
+
+/**
+ * @brief   Registers, refreshes or removes the registration of an address.
+ *
+ * @pre addr != NULL && eui64 != NULL
+ *
+ * @param[in] iface The interface the registration was received on.
+ *                  KERNEL_PID_UNDEF for a registration via DAR.
+ * @param[in] addr  The address to register.
+ * @param[in] eui64 The EUI-64 of the registering node.
+ * @param[in] ltime The registration lifetime in minutes. 0 removes the
+ *                  registration.
+ *
+ * @return  SIXLOWPAN_ND_STATUS_SUCCESS, on success.
+ * @return  SIXLOWPAN_ND_STATUS_DUP, if another node registered @p addr.
+ * @return  SIXLOWPAN_ND_STATUS_NC_FULL, if the table is full.
+ */
+uint8_t gnrc_sixlowpan_nd_router_reg_update(kernel_pid_t iface, const ipv6_addr_t *addr,
+                                            const eui64_t *eui64, uint16_t ltime);
+
+/**
+ * @brief   Removes a registration.
+ *
+ * @param[in] reg   A registration.
+ */
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_sixlowpan_nd_router_reg_t *reg);
+
+/**
+ * @brief   Advances the registration table's clock by one minute and removes
+ *          the registrations that ended.
+ *
+ * @details Handles @ref GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT. The neighbor cache
+ *          entries of expired registrations are garbage-collected with
+ *          gnrc_sixlowpan_nd_router_gc_nc().
+ */
+void gnrc_sixlowpan_nd_router_reg_timeout(void);
+
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
 /**
  * @brief   Makes this node a new border router.
@@ -214,6 +328,22 @@ int gnrc_sixlowpan_nd_router_abr_add_ctx(gnrc_sixlowpan_nd_router_abr_t *abr, ui
  * @param[in] cid       The context to be remove.
  */
 void gnrc_sixlowpan_nd_router_abr_rem_ctx(gnrc_sixlowpan_nd_router_abr_t *abr, uint8_t cid);
+
+/**
+ * @brief   Handles a duplicate address request and answers it with a
+ *          duplicate address confirmation.
+ *
+ * @details The registration table serves as the border router's cache for
+ *          multihop duplicate address detection, so repeated requests for
+ *          the same registration are answered without further state.
+ *
+ * @see     [RFC 6775, section 8.2.3](https://tools.ietf.org/html/rfc6775#section-8.2.3)
+ *
+ * @param[in] ipv6      The IPv6 header of the request.
+ * @param[in] dar       The duplicate address request.
+ * @param[in] size      The size of @p dar.
+ */
+void gnrc_sixlowpan_nd_router_dar_handle(ipv6_hdr_t *ipv6, sixlowpan_nd_da_t *dar, size_t size);
 #else
 #define gnrc_sixlowpan_nd_router_abr_create(addr, ltime)    (NULL)
 #endif
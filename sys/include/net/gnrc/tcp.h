@@ -106,12 +106,78 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
  *            -EINVAL if @p address_family is not the same the address_family used in TCB.
  *            -EISCONN if TCB is already in use.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
+ *
+ * @note A receive buffer is claimed when a connection request arrives. Requests
+ *       are ignored while all are in use. Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                           const uint8_t *local_addr, const uint16_t local_port);
 
+/**
+ * @brief Listens for incomming connections with a pool of TCBs.
+ *
+ * Every TCB of @p tcbs accepts one connection, so up to @p tcbs_len
+ * connections are established without waiting for gnrc_tcp_accept().
+ * Accepted TCBs are used like actively opened ones. Closing or aborting them
+ * puts them back into the pool.
+ *
+ * @pre @p queue and @p tcbs must not be NULL.
+ * @pre @p tcbs_len must be greater than zero.
+ * @pre local_port is not zero.
+ *
+ * @note The TCBs of @p tcbs are initialized by this function.
+ *
+ * @param[out]    queue            Listen queue to set up.
+ * @param[in,out] tcbs             Pool of TCBs for the connections.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL the queue is bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valid.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port);
+
+/**
+ * @brief Takes the next established connection from a listen queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue and @p tcb must not be NULL.
+ *
+ * @note Blocks until a connection was established or the timeout expired.
+ *
+ * @param[in,out] queue                 Listen queue to accept from.
+ * @param[out]    tcb                   TCB of the accepted connection.
+ * @param[in]     timeout_duration_us   If zero, the function returns immediately.
+ *                                      If not zero, the function waits at most
+ *                                      timeout_duration_us for a connection.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening.
+ *            -EAGAIN if @p timeout_duration_us is zero and no connection was established.
+ *            -ETIMEDOUT if no connection was established in time.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us);
+
+/**
+ * @brief Stops listening on a listen queue.
+ *
+ * Connections that were not accepted yet are aborted. Accepted ones stay
+ * open, but are not returned into the pool on close.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listen queue to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -120,6 +186,10 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is retransmitted until the peer acknowledged it, but
+ *       this function does not wait for that. With @ref GNRC_TCP_FLAG_NAGLE set
+ *       in gnrc_tcp_tcb_t::flags, small writes are held back while data is in
+ *       flight and count as transmitted.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -71,7 +71,18 @@ extern "C" {
  * @brief Number of preallocated receive buffers
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
-#define GNRC_TCP_RCV_BUFFERS (1U)
+#define GNRC_TCP_RCV_BUFFERS (2U)
+#endif
+
+/**
+ * @brief Maximum number of receive buffers a connection claims
+ *
+ * A connection takes as many adjacent free buffers as available up to this
+ * number, at least one. As there is no window scaling, this times
+ * GNRC_TCP_RCV_BUF_SIZE must not exceed 65535.
+ */
+#ifndef GNRC_TCP_RCV_BUFFERS_PER_TCB
+#define GNRC_TCP_RCV_BUFFERS_PER_TCB (2U)
 #endif
 
 /**
@@ -123,6 +134,66 @@ extern "C" {
 #define GNRC_TCP_RTO_K (4U)
 #endif
 
+/**
+ * @brief Number of unacknowledged segments that can be in flight.
+ *
+ * One of them is kept for the FIN, so data is sent with up to
+ * GNRC_TCP_RETRANSMIT_QUEUE_SIZE - 1 segments in flight. Fast retransmit
+ * needs at least three segments behind a lost one to trigger. At most 8
+ * segments are supported.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (5U)
+#endif
+
+/**
+ * @brief Time an ACK of received data is delayed at most (see RFC 1122, section 4.2.3.2)
+ */
+#ifndef GNRC_TCP_DELAYED_ACK_TIMEOUT
+#define GNRC_TCP_DELAYED_ACK_TIMEOUT (200U * US_PER_MS)
+#endif
+
+/**
+ * @brief Flags of new TCBs, see gnrc_tcp_tcb_t::flags
+ */
+#ifndef GNRC_TCP_FLAGS_DEFAULT
+#define GNRC_TCP_FLAGS_DEFAULT (GNRC_TCP_FLAG_DELAYED_ACK)
+#endif
+
+/**
+ * @brief Number of hash buckets used to look up the TCB of an incoming segment
+ */
+#ifndef GNRC_TCP_TCB_HASH_SIZE
+#define GNRC_TCP_TCB_HASH_SIZE (8U)
+#endif
+
+/**
+ * @brief Offer and accept selective acknowledgments (see RFC 2018)
+ *
+ * GNRC TCP only uses SACK information to skip segments the peer already
+ * holds when retransmitting, it never sends SACK blocks itself.
+ */
+#ifndef GNRC_TCP_SACK
+#define GNRC_TCP_SACK (1U)
+#endif
+
+/**
+ * @brief Offer and accept TCP timestamps (see RFC 7323)
+ *
+ * Timestamps give an RTT sample with every ACK but take 12 bytes of every
+ * segment.
+ */
+#ifndef GNRC_TCP_TIMESTAMPS
+#define GNRC_TCP_TIMESTAMPS (1U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for the duration between probes
  */
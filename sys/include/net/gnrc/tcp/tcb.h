@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
@@ -45,6 +46,16 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @name Flags to tune a connection, see gnrc_tcp_tcb_t::flags
+ * @{
+ */
+#define GNRC_TCP_FLAG_DELAYED_ACK (1 << 0)  /**< Delay ACKs of received data, so they can
+                                             *   be piggybacked on replies (see RFC 1122) */
+#define GNRC_TCP_FLAG_NAGLE       (1 << 1)  /**< Hold back small writes while data is in
+                                             *   flight and coalesce them (see RFC 896) */
+/** @} */
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -58,6 +69,7 @@ typedef struct _transmission_control_block {
     uint16_t peer_port;    /**< Peer connections port number */
     uint8_t state;         /**< Connections state */
     uint8_t status;        /**< A connections status flags */
+    uint8_t flags;         /**< GNRC_TCP_FLAG_* set by the user, may be changed at any time */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
     uint16_t snd_wnd;      /**< Send window */
@@ -68,23 +80,61 @@ typedef struct _transmission_control_block {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t options;       /**< Negotiated options and options of the last received segment */
+    uint32_t ts_recent;    /**< Timestamp to echo to the peer */
+    uint32_t ts_val;       /**< Timestamp value of the last received segment */
+    uint32_t ts_ecr;       /**< Timestamp echo reply of the last received segment */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number that acknowledges the timed segment */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent when loss recovery started */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    uint8_t delack;        /**< Number of received segments not acknowledged yet */
+    xtimer_t tim_delack;   /**< Timer struct for delayed ACKs */
+    msg_t msg_delack;      /**< Message, sent when a delayed ACK is due */
+    gnrc_pktsnip_t *pkt_nagle;  /**< Small write held back by Nagle's algorithm */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_RETRANSMIT_QUEUE_SIZE];  /**< Retransmit queue,
+                                                                       *   oldest packet first */
+    uint8_t pkt_retransmit_numof;     /**< Number of packets in the retransmit queue */
+    uint8_t pkt_sacked;    /**< Bitmap of packets in the retransmit queue the peer has
+                            *   selectively acknowledged */
+    uint8_t pkt_resent;    /**< Bitmap of packets in the retransmit queue that were resent
+                            *   during the current loss recovery */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listen queue the TCB belongs to */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
+    struct _transmission_control_block *hash_next;  /**< Pointer to next TCB in the same
+                                                     *   4-tuple hash bucket */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listen queue of GNRC TCP: a pool of TCBs accepting connections on one port.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;            /**< Mutex for accept call synchronization */
+    gnrc_tcp_tcb_t *tcbs;    /**< TCB pool, one TCB per connection */
+    size_t tcbs_len;         /**< Number of TCBs in the pool */
+#ifdef MODULE_GNRC_IPV6
+    uint8_t local_addr[sizeof(ipv6_addr_t)];  /**< Address the pool is bound to,
+                                               *   unspecified for any address */
+#endif
+    uint16_t local_port;     /**< Port the pool listens on */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;             /**< Mbox notified about newly established connections */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,14 @@
  *  - https://tools.ietf.org/html/rfc2349
  *     (RFC2349 TFTP Timeout Interval and Transfer Size Options)
  *
+ *  - https://tools.ietf.org/html/rfc7440
+ *     (RFC7440 TFTP Windowsize Option)
+ *
+ * The data callback gets the offset of each block within the file, so it can
+ * read from or write to e.g. a VFS file or an MTD device directly. With
+ * windows of several blocks it may be called again for a block that was lost
+ * and has to be sent again.
+ *
  * @author      Nick van IJzendoorn <nijzendoorn@engineering-spirit.nl>
  */
 
@@ -69,11 +77,25 @@ extern "C" {
 
 /**
  * @brief The maximum allowed data bytes in the data packet
+ *
+ * With option extensions, the block size is negotiated up to this value or
+ * to what fits into a packet of the first interface, whichever is smaller.
  */
 #ifndef GNRC_TFTP_MAX_TRANSFER_UNIT
 #define GNRC_TFTP_MAX_TRANSFER_UNIT         (512)
 #endif
 
+/**
+ * @brief The maximum number of blocks sent before waiting for an ACK
+ *
+ * With option extensions, clients request this window size and servers
+ * accept it up to this value. Every block of a window occupies the packet
+ * buffer until it was sent.
+ */
+#ifndef GNRC_TFTP_WINDOW_SIZE
+#define GNRC_TFTP_WINDOW_SIZE               (1)
+#endif
+
 /**
  * @brief The number of retries that must be made before stopping a transfer
  */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch TSCH
+ * @ingroup     net_gnrc
+ * @brief       Time Slotted Channel Hopping MAC of IEEE 802.15.4e
+ *
+ * ## Slotframes and channel hopping
+ * Time is divided into timeslots of @ref GNRC_TSCH_TIMESLOT_US, numbered by the
+ * absolute slot number (ASN) since the coordinator started the network. The
+ * timeslots repeat in a slotframe, in which every cell (link) says whether a
+ * node transmits, receives or sleeps. A cell is used on the channel
+ * `hopping_sequence[(ASN + channel_offset) % 16]`, so consecutive uses of a
+ * cell hop over all channels.
+ *
+ * ## Minimal schedule
+ * Without a scheduling function the slotframe is the minimal schedule of
+ * 6TiSCH (RFC 8180): a single shared cell in timeslot 0 carries enhanced
+ * beacons, broadcasts and unicasts of all nodes. Collisions in shared cells
+ * are resolved with the TSCH CSMA-CA backoff after missing ACKs.
+ *
+ * ## Time synchronization
+ * Slot timing comes from a @ref drivers_periph_timer, which must be 32 bit
+ * wide. Nodes synchronize to their time source: the neighbor whose enhanced
+ * beacon (EB) made them join. Every frame from it corrects the start of the
+ * timeslot by the offset between its expected and its actual arrival time.
+ * Nodes that did not hear their time source for @ref GNRC_TSCH_DESYNC_TIMEOUT_US
+ * scan for EBs again.
+ *
+ * ## Joining
+ * A node scans the channels of the hopping sequence for EBs. An EB carries the
+ * ASN, the join metric (hops to the coordinator), the timeslot template, the
+ * hopping sequence and the slotframe, so a node that received one can follow
+ * the schedule right away. The PAN coordinator is chosen with
+ * @ref NETOPT_TSCH_COORDINATOR.
+ *
+ * ## Limitations
+ * ACKs are the immediate ACKs of the transceiver, not enhanced ACKs, so nodes
+ * only synchronize to frames of their time source and have no keep-alives.
+ * Data frames are sent as IEEE 802.15.4-2006 frames without IEs.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for TSCH
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef NET_GNRC_TSCH_H
+#define NET_GNRC_TSCH_H
+
+#include "kernel_types.h"
+#include "timex.h"
+#include "periph/timer.h"
+#include "net/gnrc/netdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timer that clocks the timeslots
+ *
+ * Must be a 32-bit timer with two channels, not used by @ref sys_xtimer.
+ */
+#ifndef GNRC_TSCH_TIMER_DEV
+#define GNRC_TSCH_TIMER_DEV             TIMER_DEV(1)
+#endif
+
+/**
+ * @brief   Frequency of @ref GNRC_TSCH_TIMER_DEV in Hz
+ */
+#ifndef GNRC_TSCH_TIMER_FREQ
+#define GNRC_TSCH_TIMER_FREQ            (1000000LU)
+#endif
+
+/**
+ * @name    Timeslot template
+ *
+ * The default template of IEEE 802.15.4e for the 2.4 GHz band. All nodes of a
+ * network must use the same template.
+ * @{
+ */
+#ifndef GNRC_TSCH_TIMESLOT_US
+#define GNRC_TSCH_TIMESLOT_US           (10000U)    /**< duration of a timeslot */
+#endif
+#ifndef GNRC_TSCH_TX_OFFSET_US
+#define GNRC_TSCH_TX_OFFSET_US          (2120U)     /**< start of the timeslot to
+                                                     *   start of a frame */
+#endif
+#ifndef GNRC_TSCH_RX_OFFSET_US
+#define GNRC_TSCH_RX_OFFSET_US          (1020U)     /**< start of the timeslot to
+                                                     *   start of listening */
+#endif
+#ifndef GNRC_TSCH_RX_WAIT_US
+#define GNRC_TSCH_RX_WAIT_US            (2200U)     /**< time to wait for the
+                                                     *   start of a frame */
+#endif
+/** @} */
+
+/**
+ * @brief   Latency between triggering a transmission and the start of the
+ *          frame on air
+ *
+ * Mostly the time to upload the frame to the transceiver. It is subtracted
+ * from the measured arrival time of frames, so it should be the same on all
+ * nodes of a network.
+ */
+#ifndef GNRC_TSCH_TX_LATENCY_US
+#define GNRC_TSCH_TX_LATENCY_US         (0U)
+#endif
+
+/**
+ * @brief   Maximum correction of the start of a timeslot per frame
+ *
+ * Frames that arrive further off are not used for synchronization.
+ */
+#ifndef GNRC_TSCH_SYNC_GUARD_US
+#define GNRC_TSCH_SYNC_GUARD_US         (GNRC_TSCH_RX_WAIT_US / 2)
+#endif
+
+/**
+ * @brief   Interval between enhanced beacons of a synchronized node
+ *
+ * EBs are sent in the first shared cell after the interval, with a random
+ * extension of up to a quarter of it to avoid that neighbors beacon in
+ * lockstep.
+ */
+#ifndef GNRC_TSCH_EB_PERIOD_US
+#define GNRC_TSCH_EB_PERIOD_US          (4U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Time without frames from the time source after which a node
+ *          leaves the network and scans for EBs again
+ */
+#ifndef GNRC_TSCH_DESYNC_TIMEOUT_US
+#define GNRC_TSCH_DESYNC_TIMEOUT_US     (30U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Time to listen on one channel while scanning for EBs
+ */
+#ifndef GNRC_TSCH_SCAN_DWELL_US
+#define GNRC_TSCH_SCAN_DWELL_US         (GNRC_TSCH_EB_PERIOD_US + (US_PER_SEC / 2))
+#endif
+
+/**
+ * @brief   Maximum number of retransmissions of a unicast frame
+ */
+#ifndef GNRC_TSCH_MAX_RETRIES
+#define GNRC_TSCH_MAX_RETRIES           (4U)
+#endif
+
+/**
+ * @name    Backoff exponents of the TSCH CSMA-CA in shared cells
+ * @{
+ */
+#ifndef GNRC_TSCH_MIN_BE
+#define GNRC_TSCH_MIN_BE                (1U)
+#endif
+#ifndef GNRC_TSCH_MAX_BE
+#define GNRC_TSCH_MAX_BE                (5U)
+#endif
+/** @} */
+
+/**
+ * @brief   The size of the message queue of the TSCH thread
+ */
+#ifndef GNRC_TSCH_IPC_MSG_QUEUE_SIZE
+#define GNRC_TSCH_IPC_MSG_QUEUE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Initialize an instance of the TSCH layer
+ *
+ * The initialization starts a new thread that connects to the given netdev
+ * device and starts a link layer event loop. The node scans for enhanced
+ * beacons until it joins a network or is made the PAN coordinator with
+ * @ref NETOPT_TSCH_COORDINATOR.
+ *
+ * @param[in] stack         stack for the control thread
+ * @param[in] stacksize     size of *stack*
+ * @param[in] priority      priority for the thread housing the TSCH instance
+ * @param[in] name          name of the thread housing the TSCH instance
+ * @param[in] dev           netdev device, needs to be already initialized
+ *
+ * @return                  PID of TSCH thread on success
+ * @return                  -EINVAL if creation of thread fails
+ * @return                  -ENODEV if *dev* is invalid
+ */
+kernel_pid_t gnrc_tsch_init(char *stack, int stacksize, char priority,
+                            const char *name, gnrc_netdev_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_H */
+/** @} */
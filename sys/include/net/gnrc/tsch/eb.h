@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       TSCH enhanced beacons and information elements
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc8180#section-6">
+ *          RFC 8180, section 6
+ *      </a>
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef NET_GNRC_TSCH_EB_H
+#define NET_GNRC_TSCH_EB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Information element IDs
+ * @{
+ */
+#define GNRC_TSCH_IE_HT1                    (0x7eU) /**< header termination 1 */
+#define GNRC_TSCH_IE_HT2                    (0x7fU) /**< header termination 2 */
+#define GNRC_TSCH_IE_GROUP_MLME             (0x1U)  /**< MLME payload IE group */
+#define GNRC_TSCH_IE_GROUP_TERM             (0xfU)  /**< payload termination */
+#define GNRC_TSCH_IE_SUB_SYNC               (0x1aU) /**< TSCH synchronization */
+#define GNRC_TSCH_IE_SUB_SLOTFRAME          (0x1bU) /**< TSCH slotframe and link */
+#define GNRC_TSCH_IE_SUB_TIMESLOT           (0x1cU) /**< TSCH timeslot */
+#define GNRC_TSCH_IE_SUB_HOPPING            (0x9U)  /**< channel hopping (long) */
+/** @} */
+
+/**
+ * @brief   Maximum length of the information elements of an enhanced beacon
+ */
+#define GNRC_TSCH_EB_IE_LEN_MAX             (2U + 2U + (2U + 6U) + (2U + 1U) + \
+                                             (2U + 1U) + (2U + 5U + \
+                                             (5U * GNRC_TSCH_CELLS_MAX)))
+
+/**
+ * @brief   Content of an enhanced beacon
+ */
+typedef struct {
+    uint64_t asn;                           /**< absolute slot number */
+    uint8_t join_metric;                    /**< hops of the sender to the
+                                             *   coordinator */
+    uint8_t timeslot_id;                    /**< timeslot template */
+    uint8_t hopping_id;                     /**< hopping sequence */
+} gnrc_tsch_eb_t;
+
+/**
+ * @brief   Writes the information elements of an enhanced beacon
+ *
+ * @param[out] buf      buffer behind the MAC header of the beacon frame
+ * @param[in] len       length of @p buf
+ * @param[in] eb        content of the beacon
+ * @param[in] sf        slotframe to advertise, NULL for none
+ *
+ * @return  length of the information elements
+ * @return  0 if @p buf is too small
+ */
+size_t gnrc_tsch_eb_write(uint8_t *buf, size_t len, const gnrc_tsch_eb_t *eb,
+                          const gnrc_tsch_slotframe_t *sf);
+
+/**
+ * @brief   Parses information elements
+ *
+ * @param[in] buf       information elements behind the MAC header
+ * @param[in] len       length of @p buf
+ * @param[out] eb       content of a beacon, NULL to only skip the IEs
+ * @param[out] sf       advertised slotframe, left untouched if none is
+ *                      advertised, NULL to ignore it
+ *
+ * @return  length of the information elements, i.e. offset of the payload
+ * @return  -EBADMSG if the IEs are malformed or, with @p eb, if there is no
+ *          TSCH synchronization IE
+ */
+int gnrc_tsch_eb_parse(const uint8_t *buf, size_t len, gnrc_tsch_eb_t *eb,
+                       gnrc_tsch_slotframe_t *sf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_EB_H */
+/** @} */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       TSCH slotframe and channel hopping
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef NET_GNRC_TSCH_SCHEDULE_H
+#define NET_GNRC_TSCH_SCHEDULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of the minimal slotframe in timeslots
+ *
+ * RFC 8180 leaves the length to the deployment: the one cell of the minimal
+ * schedule carries all broadcast and unicast traffic, so short slotframes give
+ * more capacity and longer ones save energy.
+ */
+#ifndef GNRC_TSCH_SLOTFRAME_LENGTH
+#define GNRC_TSCH_SLOTFRAME_LENGTH          (7U)
+#endif
+
+/**
+ * @brief   Channel hopping sequence
+ *
+ * The default sequence of IEEE 802.15.4 for the 16 channels of the 2.4 GHz
+ * band.
+ */
+#ifndef GNRC_TSCH_HOPPING_SEQUENCE
+#define GNRC_TSCH_HOPPING_SEQUENCE          { 16, 17, 23, 18, 26, 15, 25, 22, \
+                                              19, 11, 12, 13, 24, 14, 20, 21 }
+#endif
+
+/**
+ * @brief   Initializes the minimal schedule of RFC 8180
+ *
+ * One shared cell for all traffic in timeslot 0 at channel offset 0.
+ *
+ * @param[out] sf   the slotframe
+ */
+void gnrc_tsch_slotframe_init_minimal(gnrc_tsch_slotframe_t *sf);
+
+/**
+ * @brief   Adds a cell to the slotframe
+ *
+ * @param[in,out] sf    the slotframe
+ * @param[in] cell      the cell
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the timeslot is outside of the slotframe
+ * @return  -ENOMEM if the slotframe has no room for another cell
+ */
+int gnrc_tsch_slotframe_add(gnrc_tsch_slotframe_t *sf, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Gets the cell to use in a timeslot
+ *
+ * Of several cells in a timeslot the first one added is used.
+ *
+ * @param[in] sf    the slotframe
+ * @param[in] asn   absolute slot number of the timeslot
+ *
+ * @return  the cell
+ * @return  NULL if the node sleeps in the timeslot
+ */
+const gnrc_tsch_cell_t *gnrc_tsch_slotframe_get(const gnrc_tsch_slotframe_t *sf,
+                                                uint64_t asn);
+
+/**
+ * @brief   Calculates the channel of a cell in a timeslot
+ *
+ * @param[in] asn               absolute slot number of the timeslot
+ * @param[in] channel_offset    channel offset of the cell
+ *
+ * @return  the channel
+ */
+uint8_t gnrc_tsch_channel(uint64_t asn, uint16_t channel_offset);
+
+/**
+ * @brief   Gets a channel of the hopping sequence
+ *
+ * @param[in] idx   index in the hopping sequence, taken modulo its length
+ *
+ * @return  the channel
+ */
+uint8_t gnrc_tsch_hopping_channel(unsigned idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_SCHEDULE_H */
+/** @} */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Internal types of TSCH
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef NET_GNRC_TSCH_TYPES_H
+#define NET_GNRC_TSCH_TYPES_H
+
+#include <stdint.h>
+
+#include "net/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of cells in the slotframe
+ */
+#ifndef GNRC_TSCH_CELLS_MAX
+#define GNRC_TSCH_CELLS_MAX                 (4U)
+#endif
+
+/**
+ * @name    Link options of a cell
+ *
+ * The same bits as in the TSCH Slotframe and Link IE.
+ * @{
+ */
+#define GNRC_TSCH_CELL_OPT_TX               (0x01U) /**< transmit in the cell */
+#define GNRC_TSCH_CELL_OPT_RX               (0x02U) /**< receive in the cell */
+#define GNRC_TSCH_CELL_OPT_SHARED           (0x04U) /**< contention with backoff */
+#define GNRC_TSCH_CELL_OPT_TIMEKEEPING      (0x08U) /**< synchronize in the cell */
+/** @} */
+
+/**
+ * @brief   Synchronization state of TSCH
+ */
+typedef enum {
+    GNRC_TSCH_STATE_OFF,                    /**< radio is off */
+    GNRC_TSCH_STATE_SCANNING,               /**< listening for enhanced beacons */
+    GNRC_TSCH_STATE_SYNCED,                 /**< part of a TSCH network */
+} gnrc_tsch_state_t;
+
+/**
+ * @brief   A cell (link) of the slotframe
+ */
+typedef struct {
+    uint16_t timeslot;                      /**< timeslot within the slotframe */
+    uint16_t channel_offset;                /**< channel offset */
+    uint8_t options;                        /**< link options, GNRC_TSCH_CELL_OPT_* */
+    uint8_t l2_addr_len;                    /**< length of gnrc_tsch_cell_t::l2_addr,
+                                             *   0 for cells to any neighbor */
+    uint8_t l2_addr[IEEE802154_LONG_ADDRESS_LEN];   /**< neighbor of a
+                                                     *   dedicated cell */
+} gnrc_tsch_cell_t;
+
+/**
+ * @brief   The slotframe
+ */
+typedef struct {
+    gnrc_tsch_cell_t cells[GNRC_TSCH_CELLS_MAX];    /**< cells of the slotframe */
+    uint16_t length;                        /**< length in timeslots */
+    uint8_t handle;                         /**< slotframe handle */
+    uint8_t numof;                          /**< number of used cells */
+} gnrc_tsch_slotframe_t;
+
+/**
+ * @brief   TSCH specific structure for storing internal states.
+ */
+typedef struct {
+    gnrc_tsch_slotframe_t slotframe;        /**< the schedule */
+    uint64_t asn;                           /**< absolute slot number of the
+                                             *   current timeslot */
+    uint64_t last_sync_asn;                 /**< ASN of the last synchronization
+                                             *   with the time source */
+    uint64_t next_eb_asn;                   /**< ASN from which the next
+                                             *   enhanced beacon is sent */
+    uint32_t slot_start;                    /**< timer ticks at the start of the
+                                             *   current timeslot */
+    uint32_t isr_time;                      /**< timer ticks at the last interrupt
+                                             *   of the device */
+    gnrc_tsch_state_t state;                /**< synchronization state */
+    const gnrc_tsch_cell_t *cell;           /**< cell of the current timeslot */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];   /**< neighbor this node
+                                                         *   synchronizes to */
+    uint8_t time_source_len;                /**< length of gnrc_tsch_t::time_source,
+                                             *   0 for the coordinator */
+    uint8_t slot_action;                    /**< pending action in the current
+                                             *   timeslot */
+    uint8_t join_metric;                    /**< hops to the coordinator */
+    uint8_t be;                             /**< backoff exponent in shared cells */
+    uint8_t backoff;                        /**< shared cells to skip */
+    uint8_t tx_retries;                     /**< retransmissions of the current packet */
+    uint8_t scan_channel;                   /**< index of the scanned channel in
+                                             *   the hopping sequence */
+    uint8_t eb_pending;                     /**< an enhanced beacon is being sent */
+} gnrc_tsch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TYPES_H */
+/** @} */
@@ -84,6 +84,7 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
  * @brief   Initialize and start UDP
  *
  * @return  PID of the UDP thread
+ * @return  0 with @ref net_gnrc_netapi_direct, where UDP runs without thread
  * @return  negative value on error
  */
 int gnrc_udp_init(void);
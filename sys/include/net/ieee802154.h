@@ -65,10 +65,13 @@ extern "C" {
 #define IEEE802154_FCF_DST_ADDR_RESV        (0x04)  /**< reserved address mode */
 #define IEEE802154_FCF_DST_ADDR_SHORT       (0x08)  /**< destination address length is 2 */
 #define IEEE802154_FCF_DST_ADDR_LONG        (0x0c)  /**< destination address length is 8 */
+#define IEEE802154_FCF_IE_PRESENT           (0x02)  /**< information elements follow
+                                                     *   (frame version 2 only) */
 
 #define IEEE802154_FCF_VERS_MASK            (0x30)
 #define IEEE802154_FCF_VERS_V0              (0x00)
 #define IEEE802154_FCF_VERS_V1              (0x10)
+#define IEEE802154_FCF_VERS_V2              (0x20)
 
 #define IEEE802154_FCF_SRC_ADDR_MASK        (0xc0)
 #define IEEE802154_FCF_SRC_ADDR_VOID        (0x00)  /**< no source address */
@@ -77,6 +80,13 @@ extern "C" {
 #define IEEE802154_FCF_SRC_ADDR_LONG        (0xc0)  /**< source address length is 8 */
 /** @} */
 
+/**
+ * @brief   IEEE802.15.4 MAC command frame identifiers
+ * @{
+ */
+#define IEEE802154_CMD_DATA_REQ             (0x04)  /**< data request */
+/** @} */
+
 /**
  * @brief   Channel ranges
  * @{
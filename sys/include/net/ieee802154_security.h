@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ieee802154_security IEEE 802.15.4 security
+ * @ingroup     net_ieee802154
+ * @brief       IEEE 802.15.4 frame security with AES-CCM*
+ *
+ * Frames are secured in place: the auxiliary security header follows the
+ * MAC header, the payload is encrypted and/or authenticated with CCM*
+ * and the MIC is appended. The key table keeps a cipher set up for every key,
+ * which uses the AES engine of the CPU with the crypto_aes_hw module.
+ *
+ * Outgoing frames identify their key by its index
+ * (@ref IEEE802154_SEC_KEY_ID_INDEX). Incoming frames are matched against
+ * the key table by their key index, the key source is not checked. Frames
+ * received from a sender are only accepted with a frame counter higher than
+ * that of the last one, senders using short addresses have to be added to
+ * the device table with their long address beforehand.
+ *
+ * Secured frames are longer than others by ieee802154_sec_overhead(), which
+ * the maximum packet size reported by the device does not account for.
+ *
+ * @see IEEE Std 802.15.4-2011, 7 Security
+ * @{
+ *
+ * @file
+ * @brief       IEEE 802.15.4 security definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_IEEE802154_SECURITY_H
+#define NET_IEEE802154_SECURITY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crypto/ciphers.h"
+#include "net/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Security control field of the auxiliary security header
+ * @{
+ */
+#define IEEE802154_SEC_SCF_LEVEL_MASK       (0x07)  /**< security level */
+#define IEEE802154_SEC_LEVEL_NONE           (0x00)  /**< no security */
+#define IEEE802154_SEC_LEVEL_MIC_32         (0x01)  /**< 4 byte MIC */
+#define IEEE802154_SEC_LEVEL_MIC_64         (0x02)  /**< 8 byte MIC */
+#define IEEE802154_SEC_LEVEL_MIC_128        (0x03)  /**< 16 byte MIC */
+#define IEEE802154_SEC_LEVEL_ENC            (0x04)  /**< encryption */
+#define IEEE802154_SEC_LEVEL_ENC_MIC_32     (0x05)  /**< encryption and 4 byte MIC */
+#define IEEE802154_SEC_LEVEL_ENC_MIC_64     (0x06)  /**< encryption and 8 byte MIC */
+#define IEEE802154_SEC_LEVEL_ENC_MIC_128    (0x07)  /**< encryption and 16 byte MIC */
+
+#define IEEE802154_SEC_SCF_KEY_ID_MASK      (0x18)  /**< key identifier mode */
+#define IEEE802154_SEC_KEY_ID_IMPLICIT      (0x00)  /**< key known by the devices */
+#define IEEE802154_SEC_KEY_ID_INDEX         (0x08)  /**< key index */
+#define IEEE802154_SEC_KEY_ID_SRC4_INDEX    (0x10)  /**< 4 byte key source and index */
+#define IEEE802154_SEC_KEY_ID_SRC8_INDEX    (0x18)  /**< 8 byte key source and index */
+/** @} */
+
+#define IEEE802154_SEC_KEY_LEN              (16U)   /**< length of a key */
+#define IEEE802154_SEC_AUX_HDR_LEN_MAX      (14U)   /**< maximum length of the
+                                                     *   auxiliary security header */
+#define IEEE802154_SEC_MIC_LEN_MAX          (16U)   /**< maximum length of the MIC */
+
+/**
+ * @name    Default values
+ * @{
+ */
+/**
+ * @brief   Number of keys in the key table
+ */
+#ifndef IEEE802154_SEC_KEYS_NUMOF
+#define IEEE802154_SEC_KEYS_NUMOF           (2U)
+#endif
+
+/**
+ * @brief   Number of senders in the device table
+ */
+#ifndef IEEE802154_SEC_DEVS_NUMOF
+#define IEEE802154_SEC_DEVS_NUMOF           (4U)
+#endif
+
+/**
+ * @brief   Security level of outgoing frames
+ */
+#ifndef IEEE802154_SEC_DEFAULT_LEVEL
+#define IEEE802154_SEC_DEFAULT_LEVEL        (IEEE802154_SEC_LEVEL_ENC_MIC_64)
+#endif
+
+/**
+ * @brief   Index of the key for outgoing frames
+ */
+#ifndef IEEE802154_SEC_DEFAULT_KEY_INDEX
+#define IEEE802154_SEC_DEFAULT_KEY_INDEX    (1U)
+#endif
+/** @} */
+
+/**
+ * @brief   Key table entry
+ */
+typedef struct {
+    cipher_t cipher;                /**< cipher initialized with the key */
+    uint8_t index;                  /**< key index */
+    bool valid;                     /**< entry is in use */
+} ieee802154_sec_key_t;
+
+/**
+ * @brief   Device table entry
+ */
+typedef struct {
+    /**
+     * @brief   Long address in network byte order
+     */
+    uint8_t long_addr[IEEE802154_LONG_ADDRESS_LEN];
+    /**
+     * @brief   Short address in network byte order, frames from a short
+     *          address of ff:ff are not matched
+     */
+    uint8_t short_addr[IEEE802154_SHORT_ADDRESS_LEN];
+    uint32_t frame_counter;         /**< lowest frame counter accepted */
+    bool valid;                     /**< entry is in use */
+} ieee802154_sec_dev_t;
+
+/**
+ * @brief   Security state of an interface
+ */
+typedef struct {
+    ieee802154_sec_key_t keys[IEEE802154_SEC_KEYS_NUMOF];   /**< key table */
+    ieee802154_sec_dev_t devs[IEEE802154_SEC_DEVS_NUMOF];   /**< device table */
+    uint32_t frame_counter;         /**< frame counter of the next outgoing frame */
+    uint8_t level;                  /**< security level of outgoing frames */
+    uint8_t key_index;              /**< key index of outgoing frames */
+} ieee802154_sec_context_t;
+
+/**
+ * @brief   Gets the length of the MIC for a security level
+ *
+ * @param[in] level a security level
+ *
+ * @return  Length of the MIC for @p level.
+ */
+static inline uint8_t ieee802154_sec_mic_len(uint8_t level)
+{
+    level &= IEEE802154_SEC_SCF_LEVEL_MASK;
+    return (level & 0x03) ? (2U << (level & 0x03)) : 0;
+}
+
+/**
+ * @brief   Gets the length of an auxiliary security header
+ *
+ * @param[in] scf   security control field of the header
+ *
+ * @return  Length of the auxiliary security header.
+ */
+static inline size_t ieee802154_sec_aux_hdr_len(uint8_t scf)
+{
+    static const uint8_t key_id_len[] = { 0, 1, 5, 9 };
+
+    /* security control field and frame counter */
+    return 5 + key_id_len[(scf & IEEE802154_SEC_SCF_KEY_ID_MASK) >> 3];
+}
+
+/**
+ * @brief   Gets the length added to a frame secured with @p ctx
+ *
+ * @param[in] ctx   security state of an interface
+ *
+ * @return  Length of the auxiliary security header and the MIC.
+ */
+static inline size_t ieee802154_sec_overhead(const ieee802154_sec_context_t *ctx)
+{
+    return ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX) +
+           ieee802154_sec_mic_len(ctx->level);
+}
+
+/**
+ * @brief   Initializes the security state of an interface
+ *
+ * Empties the key and device tables and sets
+ * @ref IEEE802154_SEC_DEFAULT_LEVEL and @ref IEEE802154_SEC_DEFAULT_KEY_INDEX.
+ *
+ * @param[out] ctx  security state of an interface
+ */
+void ieee802154_sec_init(ieee802154_sec_context_t *ctx);
+
+/**
+ * @brief   Adds a key to the key table or replaces the one of the same index
+ *
+ * @param[in,out] ctx   security state of an interface
+ * @param[in] index     key index
+ * @param[in] key       the key
+ * @param[in] key_len   length of @p key, must be @ref IEEE802154_SEC_KEY_LEN
+ *
+ * @return  0, on success.
+ * @return  -EINVAL, if @p key_len is invalid.
+ * @return  -ENOMEM, if the key table is full.
+ */
+int ieee802154_sec_set_key(ieee802154_sec_context_t *ctx, uint8_t index,
+                           const uint8_t *key, size_t key_len);
+
+/**
+ * @brief   Adds a sender to the device table or updates its short address
+ *
+ * Senders using long addresses are added when their first frame is received.
+ *
+ * @param[in,out] ctx       security state of an interface
+ * @param[in] long_addr     long address of the sender in network byte order
+ * @param[in] short_addr    short address of the sender in network byte order,
+ *                          may be NULL
+ *
+ * @return  0, on success.
+ * @return  -ENOMEM, if the device table is full.
+ */
+int ieee802154_sec_add_dev(ieee802154_sec_context_t *ctx,
+                           const uint8_t *long_addr, const uint8_t *short_addr);
+
+/**
+ * @brief   Secures a frame
+ *
+ * @pre @ref IEEE802154_FCF_SECURITY_EN is set in the MAC header.
+ *
+ * Writes the auxiliary security header after the MAC header and encrypts
+ * and/or authenticates the payload in place, which the caller has to put at
+ * `frame + mhr_len + ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX)`
+ * beforehand.
+ *
+ * @param[in,out] ctx       security state of an interface
+ * @param[in,out] frame     the frame, of size @ref IEEE802154_FRAME_LEN_MAX
+ * @param[in] mhr_len       length of the MAC header
+ * @param[in] payload_len   length of the payload
+ * @param[in] long_addr     long address of the interface in network byte order
+ *
+ * @return  Length of the secured frame without FCS, on success.
+ * @return  -EINVAL, if no security level is set.
+ * @return  -ENOENT, if the key for outgoing frames is not in the key table.
+ * @return  -EMSGSIZE, if the secured frame does not fit into a frame.
+ * @return  -EOVERFLOW, if the frame counter is exhausted.
+ */
+int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx, uint8_t *frame,
+                                 size_t mhr_len, size_t payload_len,
+                                 const uint8_t *long_addr);
+
+/**
+ * @brief   Verifies and decrypts a received frame in place
+ *
+ * @pre @ref IEEE802154_FCF_SECURITY_EN is set in the MAC header.
+ *
+ * @param[in,out] ctx   security state of an interface
+ * @param[in,out] frame the frame
+ * @param[in] frame_len length of @p frame without FCS
+ * @param[out] hdr_len  length of the MAC header and the auxiliary security
+ *                      header, the payload follows
+ *
+ * @return  Length of the payload without MIC, on success.
+ * @return  -EBADMSG, if the frame is malformed or its MIC does not match.
+ * @return  -ENOENT, if the key or the sender is unknown.
+ * @return  -ENOMEM, if the device table is full.
+ * @return  -EALREADY, if the frame counter was already used (replayed frame).
+ */
+int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx, uint8_t *frame,
+                                 size_t frame_len, size_t *hdr_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_IEEE802154_SECURITY_H */
+/** @} */
@@ -73,6 +73,38 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates a normalized Internet Checksum after a 16-bit word of its
+ *          domain changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Allows forwarding or address rewriting to fix up a checksum
+ *          without summing up the whole domain again. Unlike the other
+ *          functions @p csum is the 1's complemented value as it is found
+ *          in the header. For larger changes call this for every changed
+ *          16-bit word.
+ *
+ * @param[in] csum      The checksum field before the change in host byte
+ *                      order.
+ * @param[in] old_val   The 16-bit word before the change in host byte order.
+ * @param[in] new_val   The 16-bit word after the change in host byte order.
+ *
+ * @return  The updated checksum field in host byte order.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_val,
+                                        uint16_t new_val)
+{
+    /* HC' = ~(~HC + ~m + m'), RFC 1624, section 3 */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_val + new_val;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,10 @@ extern "C" {
 
 /**
  * @brief   Number of slots in each filter list (filter entries per device)
+ *
+ * The list is a hash table with linear probing, so looking up an address
+ * takes constant time as long as the list is not nearly full. Keep some
+ * slots, e.g. a quarter, unused for lists of hundreds of entries.
  */
 #ifndef L2FILTER_LISTSIZE
 #define L2FILTER_LISTSIZE               (8U)
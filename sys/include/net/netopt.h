@@ -342,6 +342,56 @@ typedef enum {
      */
     NETOPT_IQ_INVERT,
 
+    /**
+     * @brief   get statistics about the links to the neighbors of the device
+     *
+     * Expects a pointer to a @ref netstats_nb_table_t pointer that will be
+     * pointed to the table of the device.
+     */
+    NETOPT_STATS_NEIGHBOR,
+
+    /**
+     * @brief   (@ref netopt_enable_t) act as PAN coordinator of a TSCH
+     *          network
+     *
+     * A coordinator starts the network and sends the first enhanced beacons,
+     * other nodes join the network by scanning for them.
+     */
+    NETOPT_TSCH_COORDINATOR,
+
+    /**
+     * @brief   (uint8_t[]) set the frame pending bit in ACKs to data
+     *          requests from the given source address
+     *
+     * The address is a short or long address in network byte order. Setting
+     * returns -ENOMEM if the address table of the device is full.
+     */
+    NETOPT_ACK_PENDING_SRC,
+
+    /**
+     * @brief   (uint8_t[]) clear the frame pending bit in ACKs to data
+     *          requests from the given source address again
+     */
+    NETOPT_ACK_PENDING_SRC_RM,
+
+    /**
+     * @brief   Get/Set the wake-up interval of a duty-cycled listen mode
+     *
+     * The device sleeps and only checks for channel activity in this
+     * interval. Values are retrieved/passed as uint32_t in microseconds,
+     * 0 disables the listen mode.
+     */
+    NETOPT_LISTEN_INTERVAL,
+
+    /**
+     * @brief   (uint8_t) get the number of retransmissions the last
+     *          transmission needed
+     *
+     * Read only, valid after the device reported the end of the
+     * transmission.
+     */
+    NETOPT_TX_RETRIES_NEEDED,
+
     /* add more options if needed */
 
     /**
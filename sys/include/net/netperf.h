@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netperf Network performance measurement
+ * @ingroup     net
+ * @brief       iperf-like throughput and latency measurements
+ *
+ * netperf measures what a network stack actually achieves, to compare it
+ * before and after a change:
+ *
+ * - UDP: netperf_udp_send() sends numbered and timestamped datagrams,
+ *   back to back or paced, netperf_udp_recv() counts them, their loss and
+ *   reordering, and the interarrival jitter as defined in RFC 3550.
+ * - TCP: netperf_tcp_send() pushes a number of bytes through a connection,
+ *   netperf_tcp_recv() accepts one and measures the goodput.
+ * - ICMPv6: netperf_ping() floods or paces echo requests and collects the
+ *   round trip times in a histogram.
+ *
+ * UDP and TCP use @ref net_sock, so they work with any stack implementing
+ * it. For TCP over GNRC, which has no sock_tcp implementation, the
+ * @ref net_gnrc_tcp API is used directly. The ping flood is only available
+ * with @ref net_gnrc_icmpv6.
+ *
+ * The module provides the `netperf` shell command with @ref sys_shell_commands.
+ * @{
+ *
+ * @file
+ * @brief       netperf definitions
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef NET_NETPERF_H
+#define NET_NETPERF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the send and receive buffer, the maximum datagram size
+ */
+#ifndef NETPERF_BUF_SIZE
+#define NETPERF_BUF_SIZE        (512U)
+#endif
+
+/**
+ * @brief   Number of buckets of the RTT histogram
+ *
+ * Bucket 0 counts RTTs below 1us, bucket n > 0 counts RTTs in
+ * [2^(n-1), 2^n) us, the last bucket also counts all larger values.
+ */
+#ifndef NETPERF_HIST_BUCKETS
+#define NETPERF_HIST_BUCKETS    (21U)
+#endif
+
+/**
+ * @brief   Time in us a ping flood waits for a reply before sending the next
+ *          request
+ */
+#ifndef NETPERF_PING_FLOOD_WAIT
+#define NETPERF_PING_FLOOD_WAIT (10U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Time in us to wait for outstanding replies after the last request
+ */
+#ifndef NETPERF_PING_TIMEOUT
+#define NETPERF_PING_TIMEOUT    (US_PER_SEC)
+#endif
+
+/**
+ * @brief   Statistics of the sending side
+ */
+typedef struct {
+    uint32_t sent;          /**< datagrams or writes that succeeded */
+    uint32_t failed;        /**< datagrams or writes that failed */
+    uint64_t bytes;         /**< payload bytes sent */
+    uint32_t duration;      /**< time in us from the first to the last send */
+} netperf_tx_stats_t;
+
+/**
+ * @brief   Statistics of the receiving side
+ */
+typedef struct {
+    uint32_t received;      /**< datagrams or reads */
+    uint32_t lost;          /**< datagrams missing in the sequence (UDP) */
+    uint32_t reordered;     /**< datagrams arriving after a later one (UDP) */
+    uint32_t jitter;        /**< interarrival jitter in us (UDP) */
+    uint64_t bytes;         /**< payload bytes received */
+    uint32_t duration;      /**< time in us from the first to the last
+                             *   reception */
+} netperf_rx_stats_t;
+
+/**
+ * @brief   Statistics of a ping flood
+ */
+typedef struct {
+    uint32_t sent;          /**< echo requests sent */
+    uint32_t received;      /**< echo replies received */
+    uint32_t rtt_min;       /**< minimum RTT in us */
+    uint32_t rtt_max;       /**< maximum RTT in us */
+    uint64_t rtt_sum;       /**< sum of all RTTs in us */
+    uint32_t duration;      /**< time in us from the first request to the
+                             *   last reply */
+    uint32_t hist[NETPERF_HIST_BUCKETS];    /**< RTT histogram */
+} netperf_ping_stats_t;
+
+/**
+ * @brief   Send UDP datagrams
+ *
+ * Every datagram starts with its sequence number and a timestamp.
+ *
+ * @param[in] addr      destination address
+ * @param[in] netif     interface to send on, KERNEL_PID_UNDEF for any
+ * @param[in] port      destination port
+ * @param[in] size      UDP payload size, at least 8
+ * @param[in] count     number of datagrams to send
+ * @param[in] interval  time in us between two datagrams, 0 to send as fast
+ *                      as possible
+ * @param[out] stats    statistics of the transmission
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p size is out of range
+ */
+int netperf_udp_send(const ipv6_addr_t *addr, kernel_pid_t netif,
+                     uint16_t port, size_t size, uint32_t count,
+                     uint32_t interval, netperf_tx_stats_t *stats);
+
+/**
+ * @brief   Receive UDP datagrams sent by netperf_udp_send()
+ *
+ * Returns when no datagram arrived for @p timeout us.
+ *
+ * @param[in] port      local port
+ * @param[in] timeout   time in us of silence ending the measurement
+ * @param[out] stats    statistics of the reception
+ *
+ * @return  0 on success
+ * @return  -ETIMEDOUT if nothing was received
+ * @return  < 0 if the UDP sock could not be created
+ */
+int netperf_udp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats);
+
+/**
+ * @brief   Send bytes over a TCP connection
+ *
+ * @param[in] addr      destination address
+ * @param[in] port      destination port
+ * @param[in] bytes     number of bytes to send
+ * @param[out] stats    statistics of the transmission, one write per
+ *                      @ref NETPERF_BUF_SIZE bytes
+ *
+ * @return  0 on success
+ * @return  < 0 if the connection failed
+ */
+int netperf_tcp_send(const ipv6_addr_t *addr, uint16_t port, uint32_t bytes,
+                     netperf_tx_stats_t *stats);
+
+/**
+ * @brief   Accept a TCP connection and receive everything sent over it
+ *
+ * Returns when the connection is closed or no data arrived for @p timeout us.
+ *
+ * @param[in] port      local port
+ * @param[in] timeout   time in us to wait for the connection and for data
+ * @param[out] stats    statistics of the reception
+ *
+ * @return  0 on success
+ * @return  < 0 if no connection was established
+ */
+int netperf_tcp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats);
+
+/**
+ * @brief   Send ICMPv6 echo requests and measure the RTT of the replies
+ *
+ * @param[in] addr      destination address
+ * @param[in] netif     interface to send on, KERNEL_PID_UNDEF for any
+ * @param[in] size      payload size, at least 4
+ * @param[in] count     number of requests to send
+ * @param[in] interval  time in us between two requests, 0 to flood: the next
+ *                      request is sent as soon as the reply arrived or after
+ *                      @ref NETPERF_PING_FLOOD_WAIT
+ * @param[out] stats    RTT statistics
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p size is out of range
+ * @return  -ENOTSUP if the stack is not supported
+ */
+int netperf_ping(const ipv6_addr_t *addr, kernel_pid_t netif, size_t size,
+                 uint32_t count, uint32_t interval,
+                 netperf_ping_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NETPERF_H */
+/** @} */
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Link statistics per neighbor
+ * @ingroup     net_netstats
+ * @brief       Estimates the expected transmission count (ETX) of the links
+ *              to the neighbors of a network device
+ *
+ * With the module `netstats_neighbor` every network device keeps a small
+ * table in netdev_t of the neighbors it sent unicast frames to. The link
+ * layer records the destination of every frame before sending it, and the
+ * result the device reports with the following @ref NETDEV_EVENT_TX_COMPLETE
+ * or @ref NETDEV_EVENT_TX_NOACK event updates an exponentially weighted
+ * moving average of the ETX of that neighbor. Frames to the same neighbor
+ * are usually sent in a row, so the result is simply attributed to the
+ * frame recorded last.
+ *
+ * The devices do not report how many retransmissions a frame needed, so an
+ * acknowledged frame counts as one transmission and a frame that was not
+ * acknowledged adds @ref NETSTATS_NB_ETX_NOACK_PENALTY to the average.
+ * Failed channel access (@ref NETDEV_EVENT_TX_MEDIUM_BUSY) says nothing
+ * about the link and is not counted.
+ *
+ * Every received frame updates the neighbor it came from with moving averages
+ * of the RSSI and LQI the device reported for it, in the units of the device.
+ * Neighbors that are only heard are added as well, so routing protocols can
+ * compare the link quality of candidates before sending them anything.
+ * Entries are replaced in least recently used order and the neighbor the
+ * device is sending to is never replaced by a received frame.
+ *
+ * Upper layers get the table of a device with @ref NETOPT_STATS_NEIGHBOR.
+ * The shell shows it with `ifconfig <if_id> nbstats`.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Link statistics per neighbor definitions
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_NETSTATS_NEIGHBOR_H
+#define NET_NETSTATS_NEIGHBOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors per device
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE                (8U)
+#endif
+
+/**
+ * @brief   Maximum length of the link-layer addresses of the neighbors
+ */
+#ifndef NETSTATS_NB_L2_ADDR_MAX
+#define NETSTATS_NB_L2_ADDR_MAX         (8U)
+#endif
+
+/**
+ * @brief   Fixed point divisor of netstats_nb_t::etx
+ *
+ * The same as the one of the ETX object of RPL, see
+ * <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ * RFC 6551, section 4.3.2</a>.
+ */
+#define NETSTATS_NB_ETX_DIVISOR         (128U)
+
+/**
+ * @brief   ETX of neighbors without any transmission results yet
+ */
+#ifndef NETSTATS_NB_ETX_INIT
+#define NETSTATS_NB_ETX_INIT            (2U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   ETX sample for a frame that was not acknowledged
+ */
+#ifndef NETSTATS_NB_ETX_NOACK_PENALTY
+#define NETSTATS_NB_ETX_NOACK_PENALTY   (6U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Weight of a new sample in the moving average in percent
+ */
+#ifndef NETSTATS_NB_ETX_ALPHA
+#define NETSTATS_NB_ETX_ALPHA           (15U)
+#endif
+
+/**
+ * @brief   Weight of a new sample in the moving averages of RSSI and LQI in
+ *          percent
+ */
+#ifndef NETSTATS_NB_RX_ALPHA
+#define NETSTATS_NB_RX_ALPHA            (25U)
+#endif
+
+/**
+ * @brief   Result of a transmission
+ */
+typedef enum {
+    NETSTATS_NB_SUCCESS,        /**< frame was acknowledged */
+    NETSTATS_NB_NOACK,          /**< frame was not acknowledged */
+    NETSTATS_NB_BUSY,           /**< channel access failed */
+} netstats_nb_result_t;
+
+/**
+ * @brief   Statistics of a neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[NETSTATS_NB_L2_ADDR_MAX];   /**< link-layer address */
+    uint8_t l2_addr_len;        /**< length of netstats_nb_t::l2_addr,
+                                 *   0 for unused entries */
+    uint16_t etx;               /**< ETX in units of
+                                 *   1/@ref NETSTATS_NB_ETX_DIVISOR */
+    uint32_t tx_count;          /**< frames with a reported result */
+    uint32_t tx_failed;         /**< frames that were not acknowledged */
+    uint32_t rx_count;          /**< frames received from the neighbor */
+    uint32_t last_updated;      /**< time in seconds of the last result or
+                                 *   received frame */
+    uint32_t last_seen;         /**< time in seconds of the last received
+                                 *   frame, only valid if
+                                 *   netstats_nb_t::rx_count is not 0 */
+    uint8_t rssi;               /**< moving average of the RSSI */
+    uint8_t lqi;                /**< moving average of the LQI */
+} netstats_nb_t;
+
+/**
+ * @brief   Neighbor statistics of a device
+ */
+typedef struct {
+    netstats_nb_t entries[NETSTATS_NB_SIZE];    /**< the neighbors */
+    netstats_nb_t *pending;     /**< neighbor the last frame was sent to,
+                                 *   NULL for multicast frames */
+} netstats_nb_table_t;
+
+/**
+ * @brief   Records the destination of a frame about to be sent
+ *
+ * Adds the neighbor if it is unknown, replacing the one updated least
+ * recently if the table is full.
+ *
+ * @param[in] table         the table of the device
+ * @param[in] l2_addr       the destination, NULL for multicast frames
+ * @param[in] l2_addr_len   length of @p l2_addr
+ */
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        size_t l2_addr_len);
+
+/**
+ * @brief   Updates the neighbor recorded last with a transmission result
+ *
+ * @param[in] table     the table of the device
+ * @param[in] result    the result reported by the device
+ */
+void netstats_nb_update_tx(netstats_nb_table_t *table, netstats_nb_result_t result);
+
+/**
+ * @brief   Updates a neighbor with a frame received from it
+ *
+ * Adds the neighbor if it is unknown, replacing the one updated least
+ * recently except for the one a frame is currently sent to, if the table is
+ * full.
+ *
+ * @param[in] table         the table of the device
+ * @param[in] l2_addr       the source of the frame
+ * @param[in] l2_addr_len   length of @p l2_addr
+ * @param[in] rssi          RSSI of the frame as reported by the device
+ * @param[in] lqi           LQI of the frame as reported by the device
+ */
+void netstats_nb_update_rx(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                           size_t l2_addr_len, uint8_t rssi, uint8_t lqi);
+
+/**
+ * @brief   Gets the statistics of a neighbor
+ *
+ * May be called from other threads than the one of the device: the values
+ * might be updated while they are read.
+ *
+ * @param[in] table         the table of the device
+ * @param[in] l2_addr       link-layer address of the neighbor
+ * @param[in] l2_addr_len   length of @p l2_addr
+ *
+ * @return  the statistics of the neighbor
+ * @return  NULL if the neighbor is unknown
+ */
+const netstats_nb_t *netstats_nb_get(const netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, size_t l2_addr_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NETSTATS_NEIGHBOR_H */
+/** @} */
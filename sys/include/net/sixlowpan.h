@@ -141,6 +141,131 @@ static inline bool sixlowpan_frag_is(sixlowpan_frag_t *hdr)
 }
 /** @} */
 
+/**
+ * @name    6LoWPAN selective fragment recovery definitions
+ * @see     <a href="https://tools.ietf.org/html/rfc8931#section-5">
+ *              RFC 8931, section 5
+ *          </a>
+ * @{
+ */
+#define SIXLOWPAN_SFR_DISP_MASK     (0xfe)      /**< mask for SFR dispatches */
+#define SIXLOWPAN_SFR_RFRAG_DISP    (0xe8)      /**< dispatch for RFRAG */
+#define SIXLOWPAN_SFR_ACK_DISP      (0xea)      /**< dispatch for RFRAG-ACK */
+#define SIXLOWPAN_SFR_ECN           (0x01)      /**< explicit congestion
+                                                 *   notification flag */
+#define SIXLOWPAN_SFR_ACK_REQ       (0x8000U)   /**< acknowledgment request flag */
+#define SIXLOWPAN_SFR_SEQ_MASK      (0x7c00U)   /**< mask for the sequence number */
+#define SIXLOWPAN_SFR_SEQ_POS       (10U)       /**< position of the sequence number */
+#define SIXLOWPAN_SFR_SEQ_MAX       (31U)       /**< maximum sequence number */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MASK  (0x03ffU) /**< mask for the fragment size */
+#define SIXLOWPAN_SFR_ACK_FULL      (0xffffffffUL)  /**< bitmap of a complete
+                                                     *   datagram */
+#define SIXLOWPAN_SFR_ACK_NULL      (0UL)       /**< bitmap to abort a datagram */
+
+/**
+ * @brief   Recoverable fragment (RFRAG) header
+ *
+ * For the first fragment (sequence number 0) sixlowpan_sfr_rfrag_t::offset
+ * is the size of the compressed datagram.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    /**
+     * @brief   Acknowledgment request flag, sequence number and fragment size
+     */
+    network_uint16_t ar_seq_size;
+    network_uint16_t offset;        /**< offset in the compressed datagram */
+} sixlowpan_sfr_rfrag_t;
+
+/**
+ * @brief   RFRAG acknowledgment (RFRAG-ACK) header
+ *
+ * The most significant bit of the bitmap stands for sequence number 0.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    network_uint32_t bitmap;        /**< acknowledged sequence numbers */
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a given frame is an RFRAG
+ *
+ * @param[in] disp  The first byte of a frame.
+ *
+ * @return  true, if frame is an RFRAG.
+ * @return  false, if frame is not an RFRAG.
+ */
+static inline bool sixlowpan_sfr_rfrag_is(uint8_t disp)
+{
+    return (disp & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_RFRAG_DISP;
+}
+
+/**
+ * @brief   Checks if a given frame is an RFRAG-ACK
+ *
+ * @param[in] disp  The first byte of a frame.
+ *
+ * @return  true, if frame is an RFRAG-ACK.
+ * @return  false, if frame is not an RFRAG-ACK.
+ */
+static inline bool sixlowpan_sfr_ack_is(uint8_t disp)
+{
+    return (disp & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_ACK_DISP;
+}
+
+/**
+ * @brief   Gets the sequence number of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  the sequence number of @p hdr
+ */
+static inline unsigned sixlowpan_sfr_rfrag_get_seq(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_SEQ_MASK) >>
+           SIXLOWPAN_SFR_SEQ_POS;
+}
+
+/**
+ * @brief   Gets the fragment size of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  the size of the fragment payload following @p hdr
+ */
+static inline size_t sixlowpan_sfr_rfrag_get_frag_size(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+}
+
+/**
+ * @brief   Checks if an RFRAG requests an acknowledgment
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  true, if @p hdr requests an RFRAG-ACK
+ * @return  false, otherwise
+ */
+static inline bool sixlowpan_sfr_rfrag_ack_req(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_ACK_REQ) != 0;
+}
+
+/**
+ * @brief   Gets the bit for a sequence number in an RFRAG-ACK bitmap
+ *
+ * @param[in] seq   A sequence number.
+ *
+ * @return  the bit of @p seq
+ */
+static inline uint32_t sixlowpan_sfr_ack_bit(unsigned seq)
+{
+    return 0x80000000UL >> seq;
+}
+/** @} */
+
 /**
  * @name    6LoWPAN IPHC dispatch definitions
  * @{
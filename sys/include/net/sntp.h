@@ -11,6 +11,14 @@
  * @defgroup    net_sntp Simple Network Time Protocol
  * @ingroup     net
  * @brief       Simple Network Time Protocol (SNTP) implementation
+ *
+ * With the (pseudo-)module `sntp_clock` every sntp_sync() also disciplines a
+ * clock: small offsets are slewed out at @ref SNTP_CLOCK_SLEW_PPM instead of
+ * being stepped, the drift of the system clock is estimated from successive
+ * samples and corrected continuously, and sntp_clock_poll_interval() grows
+ * while the clock stays within @ref SNTP_CLOCK_POLL_THRESHOLD. The
+ * application calls sntp_sync() every sntp_clock_poll_interval() seconds and
+ * reads the time with sntp_clock_unix_usec().
  * @{
  *
  * @file
@@ -34,6 +42,59 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Offset in microseconds above which the clock is stepped instead of
+ *          slewed
+ */
+#ifndef SNTP_CLOCK_STEP_THRESHOLD
+#define SNTP_CLOCK_STEP_THRESHOLD   (128000LL)
+#endif
+
+/**
+ * @brief   Rate in parts per million at which offsets are slewed out
+ */
+#ifndef SNTP_CLOCK_SLEW_PPM
+#define SNTP_CLOCK_SLEW_PPM         (500LL)
+#endif
+
+/**
+ * @brief   Maximum drift correction in parts per billion
+ */
+#ifndef SNTP_CLOCK_FREQ_MAX
+#define SNTP_CLOCK_FREQ_MAX         (500000LL)
+#endif
+
+/**
+ * @brief   Fraction (1/n) of the measured drift error that is corrected per
+ *          sample
+ *
+ * Larger values filter out more network jitter, but converge slower.
+ */
+#ifndef SNTP_CLOCK_FLL_GAIN
+#define SNTP_CLOCK_FLL_GAIN         (4)
+#endif
+
+/**
+ * @brief   Offset in microseconds up to which the poll interval grows
+ */
+#ifndef SNTP_CLOCK_POLL_THRESHOLD
+#define SNTP_CLOCK_POLL_THRESHOLD   (5000LL)
+#endif
+
+/**
+ * @brief   Minimum poll interval in log2 seconds
+ */
+#ifndef SNTP_CLOCK_POLL_MIN
+#define SNTP_CLOCK_POLL_MIN         (6U)
+#endif
+
+/**
+ * @brief   Maximum poll interval in log2 seconds
+ */
+#ifndef SNTP_CLOCK_POLL_MAX
+#define SNTP_CLOCK_POLL_MAX         (10U)
+#endif
+
 /**
  * @brief Synchronize with time server
  *
@@ -62,6 +123,38 @@ static inline uint64_t sntp_get_unix_usec(void)
     return (uint64_t)(sntp_get_offset() - (NTP_UNIX_OFFSET * US_PER_SEC) + xtimer_now_usec64());
 }
 
+/**
+ * @brief   Get the disciplined time in microseconds from
+ *          1970-01-01 00:00:00 UTC
+ *
+ * The returned time never decreases, so after a step backwards it stands
+ * still until the real time caught up.
+ *
+ * @note    Only available with module `sntp_clock`.
+ *
+ * @return  Time in microseconds from 1970-01-01 00:00:00 UTC
+ * @return  0 before the first successful sntp_sync()
+ */
+uint64_t sntp_clock_unix_usec(void);
+
+/**
+ * @brief   Get the interval after which sntp_sync() should be called again
+ *
+ * @note    Only available with module `sntp_clock`.
+ *
+ * @return  Poll interval in seconds
+ */
+uint32_t sntp_clock_poll_interval(void);
+
+/**
+ * @brief   Get the estimated drift of the system clock
+ *
+ * @note    Only available with module `sntp_clock`.
+ *
+ * @return  Correction applied to the system clock in parts per billion
+ */
+int32_t sntp_clock_drift(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock
+ * @ingroup     net_sock
+ * @brief       Readiness notification for sock objects
+ *
+ * With the (pseudo-)module `sock_async` a callback can be set for a sock
+ * object (see e.g. @ref sock_udp_set_cb()), which the stack calls when the
+ * sock becomes ready, e.g. when a message was received for it. This way one
+ * thread can serve several sock objects, instead of blocking in a receive
+ * call with its own thread for each of them.
+ *
+ * The callback is called in the context of the network stack, so it must not
+ * block and should hand the event over to the application thread, e.g. with
+ * thread flags. The application thread then calls the receive function of the
+ * ready sock with a timeout of `0`:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * #include "thread_flags.h"
+ * #include "net/sock/udp.h"
+ *
+ * #define COAP_FLAG   (0x1)
+ * #define DNS_FLAG    (0x2)
+ *
+ * static thread_t *app_thread;
+ *
+ * static void _cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+ * {
+ *     (void)sock;
+ *     if (flags & SOCK_ASYNC_MSG_RECV) {
+ *         thread_flags_set(app_thread, (thread_flags_t)(uintptr_t)arg);
+ *     }
+ * }
+ *
+ * ...
+ *     app_thread = (thread_t *)sched_active_thread;
+ *     sock_udp_set_cb(&coap_sock, _cb, (void *)COAP_FLAG);
+ *     sock_udp_set_cb(&dns_sock, _cb, (void *)DNS_FLAG);
+ *     while (1) {
+ *         thread_flags_t flags = thread_flags_wait_any(COAP_FLAG | DNS_FLAG);
+ *
+ *         if (flags & COAP_FLAG) {
+ *             while ((res = sock_udp_recv(&coap_sock, buf, sizeof(buf), 0,
+ *                                         &remote)) != -EAGAIN) {
+ *                 if (res > 0) {
+ *                     ...
+ *                 }
+ *             }
+ *         }
+ *         ...
+ *     }
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * As several messages may have been received before the application thread
+ * runs, it should receive until the receive function returns `-EAGAIN`.
+ * @{
+ *
+ * @file
+ * @brief   Asynchronous sock definitions
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Events a sock callback is called for
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x01,     /**< a message was received */
+} sock_async_flags_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
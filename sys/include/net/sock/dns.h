@@ -12,6 +12,12 @@
  *
  * @brief       Sock DNS client
  *
+ * With the (pseudo-)module `sock_dns_cache` answers are cached for their
+ * time to live, so that resolving the same name again does not need a round
+ * trip to the DNS server. Answers saying that a name has no address are
+ * cached as well, for @ref SOCK_DNS_CACHE_NEG_TTL. If the cache is full, the
+ * least recently used entry is replaced.
+ *
  * @{
  *
  * @file
@@ -61,6 +67,36 @@ typedef struct {
 #define SOCK_DNS_QUERYBUF_LEN   (sizeof(sock_dns_hdr_t) + 4 + SOCK_DNS_MAX_NAME_LEN)
 /** @} */
 
+/**
+ * @brief   Number of names cached with module `sock_dns_cache`
+ */
+#ifndef SOCK_DNS_CACHE_SIZE
+#define SOCK_DNS_CACHE_SIZE     (4U)
+#endif
+
+/**
+ * @brief   Maximum time in seconds an answer is cached, regardless of its TTL
+ */
+#ifndef SOCK_DNS_CACHE_TTL_MAX
+#define SOCK_DNS_CACHE_TTL_MAX  (24U * 60U * 60U)
+#endif
+
+/**
+ * @brief   Time in seconds an answer without address is cached
+ */
+#ifndef SOCK_DNS_CACHE_NEG_TTL
+#define SOCK_DNS_CACHE_NEG_TTL  (60U)
+#endif
+
+/**
+ * @brief   Asynchronous DNS query
+ */
+typedef struct {
+    sock_udp_t sock;            /**< sock the reply is received on */
+    const char *domain_name;    /**< name to resolve */
+    int family;                 /**< requested address family */
+} sock_dns_req_t;
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -85,6 +121,50 @@ typedef struct {
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+/**
+ * @brief   Starts resolving a DNS name without waiting for the reply
+ *
+ * Answers from the cache are returned right away. Otherwise a query is sent
+ * and the reply is received on @p req->sock. Wait for it e.g. with
+ * @ref sock_udp_set_cb() (see @ref net_sock_async) and get it with
+ * sock_dns_query_result(). To retry a query that was not answered in time,
+ * cancel it with sock_dns_query_cancel() and start it again.
+ *
+ * @param[out]  req             query state, **must** stay valid until the
+ *                              query is done
+ * @param[in]   domain_name     DNS name to resolve into address, **must**
+ *                              stay valid until the query is done
+ * @param[out]  addr_out        buffer to write a cached result into
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ *
+ * @return      -EINPROGRESS if the query was sent
+ * @return      length of the address written to @p addr_out, if the name was
+ *              found in the cache
+ * @return      other negative values, if the name was found in the cache
+ *              without address or the query could not be sent
+ */
+int sock_dns_query_async(sock_dns_req_t *req, const char *domain_name,
+                         void *addr_out, int family);
+
+/**
+ * @brief   Gets the result of a query started with sock_dns_query_async()
+ *
+ * @param[in,out] req       query state
+ * @param[out]  addr_out    buffer to write result into, see sock_dns_query()
+ *
+ * @return      length of the address written to @p addr_out
+ * @return      -EAGAIN if no reply was received yet
+ * @return      other negative values if the reply has no address or on error
+ */
+int sock_dns_query_result(sock_dns_req_t *req, void *addr_out);
+
+/**
+ * @brief   Cancels a query started with sock_dns_query_async()
+ *
+ * @param[in,out] req       query state
+ */
+void sock_dns_query_cancel(sock_dns_req_t *req);
+
 /**
  * @brief global DNS server endpoint
  */
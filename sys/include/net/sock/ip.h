@@ -274,6 +274,7 @@
 #include <sys/types.h>
 
 #include "net/sock.h"
+#include "net/sock/async.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -448,6 +449,37 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote);
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Event callback for @ref sock_ip_t
+ *
+ * @note    Only available with module `sock_async`, see @ref net_sock_async.
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The event(s) that happened.
+ * @param[in] arg   Argument given to @ref sock_ip_set_cb().
+ */
+typedef void (*sock_ip_cb_t)(sock_ip_t *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Sets the event callback of a raw IPv4/IPv6 sock object
+ *
+ * The callback is called in the context of the network stack whenever a
+ * message was received for @p sock, see @ref net_sock_async. Messages that
+ * were already received before the callback was set do not trigger it.
+ *
+ * @note    Only available with module `sock_async`.
+ *
+ * @pre `sock != NULL`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] cb        The callback. May be `NULL` to unset the callback.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
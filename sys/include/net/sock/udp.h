@@ -272,8 +272,10 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "net/sock.h"
+#include "net/sock/async.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -289,6 +291,17 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   A UDP message for @ref sock_udp_send_batch()
+ */
+typedef struct {
+    const struct iovec *vector;     /**< segments of the message */
+    unsigned count;                 /**< number of segments in
+                                     *   sock_udp_msg_t::vector */
+    const sock_udp_ep_t *remote;    /**< remote end point, may be `NULL` for
+                                     *   the remote of the sock */
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -399,6 +412,61 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message from a remote end point without copying it
+ *
+ * Instead of copying the payload into an application buffer, the
+ * implementation lends its own buffer holding the received message to the
+ * application, e.g. to parse a message in place. This is only available for
+ * stacks that keep the payload of a received packet contiguous (currently
+ * @ref net_gnrc).
+ *
+ * The application has to give the buffer back by calling this function again
+ * with the same @p buf_ctx, before the next message can be received:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res;
+ *
+ * if ((res = sock_udp_recv_buf(&sock, &data, &ctx, SOCK_NO_TIMEOUT,
+ *                              &remote)) > 0) {
+ *     parse(data, res);
+ *     sock_udp_recv_buf(&sock, &data, &ctx, 0, NULL);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the payload of the received message. Only
+ *                      valid until @p buf_ctx is given back.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. Must point to
+ *                      `NULL` to receive a message. If it points to the
+ *                      context of a lent buffer, that buffer is given back
+ *                      and @p buf_ctx is reset to `NULL`.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes received on success.
+ * @return  0, if a lent buffer was given back, or if no received data is
+ *          available, but everything is in order.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -433,6 +501,81 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message made up of several segments to remote end point
+ *
+ * The segments are gathered straight into the buffer of the stack, so e.g. a
+ * pre-built header and a payload do not have to be copied into one buffer by
+ * the application first. Only available for stacks that support it
+ * (currently @ref net_gnrc).
+ *
+ * @pre `((sock != NULL || remote != NULL)) && (if (count != 0): (vector != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, see
+ *                      @ref sock_udp_send().
+ * @param[in] vector    Segments of the message in the order they are sent.
+ *                      May be `NULL` if `count == 0`.
+ * @param[in] count     Number of segments in @p vector.
+ * @param[in] remote    Remote end point for the sent data, see
+ *                      @ref sock_udp_send().
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as @ref sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const struct iovec *vector,
+                       unsigned count, const sock_udp_ep_t *remote);
+
+/**
+ * @brief   Sends several UDP messages in one call
+ *
+ * @pre `((sock != NULL) || (every remote of @p msgs != NULL)) &&
+ *       (if (numof != 0): (msgs != NULL))`
+ *
+ * Messages are sent in order, sending stops at the first message that fails.
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, see
+ *                      @ref sock_udp_send().
+ * @param[in] msgs      The messages.
+ * @param[in] numof     Number of messages in @p msgs.
+ *
+ * @return  The number of messages sent.
+ * @return  The error of @ref sock_udp_sendv(), if the first message could not
+ *          be sent.
+ */
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned numof);
+
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Event callback for @ref sock_udp_t
+ *
+ * @note    Only available with module `sock_async`, see @ref net_sock_async.
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The event(s) that happened.
+ * @param[in] arg   Argument given to @ref sock_udp_set_cb().
+ */
+typedef void (*sock_udp_cb_t)(sock_udp_t *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Sets the event callback of a UDP sock object
+ *
+ * The callback is called in the context of the network stack whenever a
+ * message was received for @p sock, see @ref net_sock_async. Messages that
+ * were already received before the callback was set do not trigger it.
+ *
+ * @note    Only available with module `sock_async`.
+ *
+ * @pre `sock != NULL`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] cb        The callback. May be `NULL` to unset the callback.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -43,6 +43,9 @@ extern "C" {
 #define TCP_OPTION_KIND_EOL (0x00)  /**< "End of List"-Option */
 #define TCP_OPTION_KIND_NOP (0x01)  /**< "No Operatrion"-Option */
 #define TCP_OPTION_KIND_MSS (0x02)  /**< "Maximum Segment Size"-Option */
+#define TCP_OPTION_KIND_SACK_PERM (0x04)  /**< "SACK Permitted"-Option */
+#define TCP_OPTION_KIND_SACK      (0x05)  /**< "Selective Acknowledgment"-Option */
+#define TCP_OPTION_KIND_TIMESTAMP (0x08)  /**< "Timestamps"-Option */
 /** @} */
 
 /**
@@ -50,6 +53,9 @@ extern "C" {
  * @{
  */
 #define TCP_OPTION_LENGTH_MSS (0x04)  /**< MSS Option Size always 4 */
+#define TCP_OPTION_LENGTH_SACK_PERM  (0x02)  /**< SACK Permitted Option Size always 2 */
+#define TCP_OPTION_LENGTH_TIMESTAMP  (0x0A)  /**< Timestamps Option Size always 10 */
+#define TCP_OPTION_LENGTH_SACK_BLOCK (0x08)  /**< Size of each block in a SACK Option */
 /** @} */
 
 /**
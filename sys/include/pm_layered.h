@@ -25,6 +25,27 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * If the board (or CPU) defines PM_WAKEUP_LATENCY_US and xtimer is used, the
+ * idle thread does not blindly enter the lowest unblocked mode. Instead, it
+ * picks the lowest unblocked mode whose wakeup latency still fits before the
+ * next xtimer deadline, so short sleeps are not delayed by a slow wakeup
+ * from a deep mode.
+ *
+ * PM_WAKEUP_LATENCY_US is an initializer for an array of PM_NUM_MODES
+ * values, the wakeup latency of mode 0 first, e.g.:
+ *
+ *     #define PM_WAKEUP_LATENCY_US    { 1000, 50, 10 }
+ *
+ * With the `pm_layered_stats` module, the idle thread records the time spent
+ * in each mode and what woke the CPU up, see @ref pm_stats_get(). The
+ * residency is measured with xtimer, so modes stopping xtimer's timer are not
+ * measured correctly. If the board defines PM_CURRENT_UA, the statistics also
+ * give an estimate of the energy consumed. It is an initializer for an array
+ * of PM_NUM_MODES + 2 values, the current in microampere drawn in mode 0
+ * first, then the idle mode and then while running, e.g.:
+ *
+ *     #define PM_CURRENT_UA           { 2, 40, 800, 1500, 4000 }
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -34,6 +55,8 @@
 #ifndef PM_LAYERED_H
 #define PM_LAYERED_H
 
+#include <stdint.h>
+
 #include "assert.h"
 #include "periph/pm.h"
 //#include "periph_cpu.h" 
@@ -69,6 +92,92 @@ void pm_unblock(unsigned mode);
  */
 void pm_set(unsigned mode);
 
+#if defined(MODULE_PM_LAYERED_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Number of distinct wakeup sources counted in @ref pm_stats_t
+ */
+#ifndef PM_STATS_WAKEUP_SOURCES
+#define PM_STATS_WAKEUP_SOURCES (8U)
+#endif
+
+/**
+ * @brief   Supply voltage used for the energy estimate, in millivolt
+ */
+#ifndef PM_SUPPLY_MV
+#define PM_SUPPLY_MV            (3300U)
+#endif
+
+/**
+ * @brief   Wakeup source reported if the CPU can't tell
+ */
+#define PM_WAKEUP_UNKNOWN       (0U)
+
+/**
+ * @brief   Number of wakeups by one source
+ */
+typedef struct {
+    unsigned source;                /**< source, see
+                                         @ref pm_layered_wakeup_source() */
+    uint32_t count;                 /**< number of wakeups */
+} pm_wakeup_stats_t;
+
+/**
+ * @brief   Power mode statistics, requires the `pm_layered_stats` module
+ *
+ * Mode PM_NUM_MODES is the idle mode. The time not spent in any mode was
+ * spent running.
+ */
+typedef struct {
+    uint64_t total_us;                          /**< time covered */
+    uint64_t residency_us[PM_NUM_MODES + 1];    /**< time spent in each mode */
+    uint32_t entries[PM_NUM_MODES + 1];         /**< number of times each mode
+                                                     was entered */
+    uint32_t wakeups_timer;                     /**< wakeups due to the next
+                                                     xtimer deadline */
+    uint32_t wakeups_other;                     /**< wakeups by sources not fitting
+                                                     into pm_stats_t::wakeups */
+    pm_wakeup_stats_t wakeups[PM_STATS_WAKEUP_SOURCES]; /**< wakeups per
+                                                             source */
+} pm_stats_t;
+
+/**
+ * @brief   Get the source of the latest wakeup
+ *
+ * Called with interrupts disabled right after @ref pm_set() returned. The
+ * default implementation returns PM_WAKEUP_UNKNOWN, on Cortex-M it returns
+ * the number of the pending exception, i.e. 16 + the IRQ number.
+ *
+ * @return  CPU specific wakeup source
+ * @return  PM_WAKEUP_UNKNOWN if unknown
+ */
+unsigned pm_layered_wakeup_source(void);
+
+/**
+ * @brief   Get a copy of the current statistics
+ *
+ * @param[out] stats    target for the statistics
+ */
+void pm_stats_get(pm_stats_t *stats);
+
+/**
+ * @brief   Reset the statistics
+ */
+void pm_stats_reset(void);
+
+#if defined(PM_CURRENT_UA) || defined(DOXYGEN)
+/**
+ * @brief   Estimate the energy consumed in the time covered by @p stats
+ *
+ * Requires the board to define PM_CURRENT_UA.
+ *
+ * @param[in] stats     statistics from @ref pm_stats_get()
+ *
+ * @return  energy in microjoule
+ */
+uint64_t pm_stats_energy_uj(const pm_stats_t *stats);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
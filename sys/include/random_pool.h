@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_random_pool Entropy pool
+ * @ingroup     sys_random
+ * @brief       Entropy pool reseeding the ChaCha PRNG in the background
+ *
+ * The pool collects entropy from noisy sources in a SHA-256 context. A thread
+ * of low priority periodically adds bytes from the hardware random number
+ * generator, if the platform provides `periph_hwrng`, and mixes the digest of
+ * the pool into the key of the ChaCha PRNG of `prng_chacha`. The digest also
+ * covers output of the PRNG, so a reseed from a poorly filled pool never
+ * lowers the strength of the PRNG.
+ *
+ * Consumers take their numbers from the PRNG with random_pool_bytes() or
+ * random_uint32(), which never block on the hardware and run at the speed of
+ * the cipher. Slow or blocking hardware random number generators are only
+ * read by the pool's thread.
+ *
+ * Further sources, like the RSSI of received frames, are added with
+ * random_pool_add() or random_pool_add_sample(). With `gnrc_netdev`, each
+ * frame received by an IEEE 802.15.4 device is added as a sample.
+ * @{
+ *
+ * @file
+ * @brief       Entropy pool interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef RANDOM_POOL_H
+#define RANDOM_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crypto/chacha.h"
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority of the thread refilling the pool
+ */
+#ifndef RANDOM_POOL_PRIO
+#define RANDOM_POOL_PRIO        (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the thread refilling the pool
+ */
+#ifndef RANDOM_POOL_STACKSIZE
+#define RANDOM_POOL_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Time between two reseeds of the PRNG in microseconds
+ */
+#ifndef RANDOM_POOL_INTERVAL
+#define RANDOM_POOL_INTERVAL    (60U * 1000U * 1000U)
+#endif
+
+/**
+ * @brief   Number of bytes read from the hardware random number generator
+ *          before each reseed
+ */
+#ifndef RANDOM_POOL_HWRNG_BYTES
+#define RANDOM_POOL_HWRNG_BYTES (32U)
+#endif
+
+/**
+ * @brief   Start the thread refilling the pool
+ *
+ * Called by auto_init. The first reseed happens right after the thread was
+ * started.
+ *
+ * @return  PID of the thread
+ */
+kernel_pid_t random_pool_init(void);
+
+/**
+ * @brief   Add data of a noisy source to the pool
+ *
+ * @note    Must not be called from interrupt context.
+ *
+ * @param[in] data      the data
+ * @param[in] len       length of @p data in bytes
+ */
+void random_pool_add(const void *data, size_t len);
+
+/**
+ * @brief   Add a noisy measurement together with its time to the pool
+ *
+ * @note    Must not be called from interrupt context.
+ *
+ * @param[in] sample    the measurement, e.g. the RSSI of a received frame
+ */
+void random_pool_add_sample(uint32_t sample);
+
+/**
+ * @brief   Mix the pool into the PRNG now
+ *
+ * Useful after a burst of entropy was added, e.g. before creating a key.
+ */
+void random_pool_reseed(void);
+
+/**
+ * @brief   Fill a buffer with random bytes
+ *
+ * Does not block on the hardware and can be called from any thread.
+ *
+ * @param[out] buf      the buffer
+ * @param[in] len       length of @p buf in bytes
+ */
+static inline void random_pool_bytes(void *buf, size_t len)
+{
+    chacha_prng_bytes(buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RANDOM_POOL_H */
+/** @} */
@@ -52,6 +52,11 @@ int uart_stdio_read(char* buffer, int len);
  */
 int uart_stdio_write(const char* buffer, int len);
 
+/**
+ * @brief wait until the host read all output, if stdout blocking is enabled
+ */
+void uart_stdio_flush(void);
+
 /**
  * @brief enable stdin polling, at a power consumption cost. This is enabled
  *        by default unless RTT_STDIO_DISABLE_STDIN is defined.
@@ -41,8 +41,31 @@ typedef struct saul_reg {
     void *dev;                      /**< pointer to the device descriptor */
     const char *name;               /**< string identifier for the device */
     saul_driver_t const *driver;    /**< the devices read callback */
+    struct saul_reg *next_type;     /**< next device of the same type, kept
+                                     *   by the registry */
 } saul_reg_t;
 
+/**
+ * @brief   Number of device types the registry indexes
+ *
+ * Looking up a type beyond these falls back to walking the list.
+ */
+#ifndef SAUL_REG_INDEX_NUMOF
+#define SAUL_REG_INDEX_NUMOF    (8U)
+#endif
+
+/**
+ * @brief   Result of reading one device with saul_reg_read_all()
+ */
+typedef struct {
+    saul_reg_t *dev;            /**< the device that was read */
+    phydat_t data;              /**< the data read from the device */
+    uint32_t time;              /**< time of the read in microseconds, the
+                                 *   same clock as xtimer_now_usec(), 0
+                                 *   without the xtimer module */
+    int res;                    /**< what saul_reg_read() returned */
+} saul_reg_data_t;
+
 /**
  * @brief   Additional data to collect for each entry
  */
@@ -99,6 +122,20 @@ saul_reg_t *saul_reg_find_nth(int pos);
  */
 saul_reg_t *saul_reg_find_type(uint8_t type);
 
+/**
+ * @brief   Find the next device of the same type as the given one
+ *
+ * @param[in] dev       device found by saul_reg_find_type() or by this
+ *                      function
+ *
+ * @return      pointer to the next device of the type of @p dev
+ * @return      NULL if there is none
+ */
+static inline saul_reg_t *saul_reg_find_type_next(const saul_reg_t *dev)
+{
+    return dev->next_type;
+}
+
 /**
  * @brief   Find a device by its name
  *
@@ -122,6 +159,70 @@ saul_reg_t *saul_reg_find_name(const char *name);
  */
 int saul_reg_read(saul_reg_t *dev, phydat_t *res);
 
+/**
+ * @brief   Read all devices of a type in one go
+ *
+ * This walks the registry once instead of looking up each device, and reads
+ * the devices in registry order, so the entries of one physical device, and
+ * in that the use of its bus, follow each other. Each result carries the time
+ * it was read at.
+ *
+ * @param[in] type      device type to read, SAUL_CLASS_ANY for all devices
+ * @param[out] data     results, one per device
+ * @param[in] numof     number of entries in @p data
+ *
+ * @return      the number of devices read into @p data, check the `res` field
+ *              of each result for errors
+ */
+unsigned saul_reg_read_all(uint8_t type, saul_reg_data_t *data,
+                           unsigned numof);
+
+/**
+ * @brief   Start collecting samples in the hardware FIFO of the given device
+ *
+ * @p cb is called in interrupt context once @p watermark samples were
+ * collected, read them with saul_reg_read_fifo() from a thread.
+ *
+ * @param[in] dev       device to start
+ * @param[in] watermark number of collected samples that trigger @p cb
+ * @param[in] cb        callback for reaching the watermark
+ * @param[in] arg       argument passed to @p cb
+ *
+ * @return      0 on success
+ * @return      -ENODEV if given device is invalid
+ * @return      -ENOTSUP if the device has no FIFO
+ * @return      -ECANCELED on device errors
+ */
+int saul_reg_fifo_start(saul_reg_t *dev, unsigned watermark,
+                        saul_notify_t cb, void *arg);
+
+/**
+ * @brief   Stop collecting samples in the hardware FIFO of the given device
+ *
+ * @param[in] dev       device to stop
+ */
+void saul_reg_fifo_stop(saul_reg_t *dev);
+
+/**
+ * @brief   Read the samples collected in the hardware FIFO of the given device
+ *
+ * Sample i of n was taken at `*time - (n - 1 - i) * *period`.
+ *
+ * @param[in] dev       device to read from
+ * @param[out] res      samples, oldest first
+ * @param[in] numof     maximum number of samples to read
+ * @param[out] time     time of the newest sample in microseconds, 0 without
+ *                      the xtimer module
+ * @param[out] period   time between two samples in microseconds
+ *
+ * @return      the number of samples written to @p res
+ * @return      -ENODEV if given device is invalid
+ * @return      -ENOTSUP if the device has no FIFO
+ * @return      -ECANCELED on device errors
+ */
+int saul_reg_read_fifo(saul_reg_t *dev, phydat_t *res, size_t numof,
+                       uint32_t *time, uint32_t *period);
+
 /**
  * @brief   Write data to the given device
  *
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round Robin Scheduler
+ * @ingroup     sys
+ * @brief       Time slicing among threads of the same priority
+ *
+ * The RIOT scheduler only switches between threads of the same priority when
+ * the running thread blocks or yields voluntarily. With this module, a
+ * thread that keeps running while other threads of its priority are
+ * runnable is moved to the end of its runqueue after
+ * @ref SCHED_RR_TIMEBASE microseconds.
+ *
+ * The slice timer is only armed while a runqueue actually holds more than
+ * one thread, so the module does not cause any wakeups on an idle system.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Round robin time slicing among equal priority threads
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a time slice in microseconds
+ */
+#ifndef SCHED_RR_TIMEBASE
+#define SCHED_RR_TIMEBASE   (10000U)
+#endif
+
+/**
+ * @brief   Bitmask of priorities that are excluded from time slicing
+ *
+ * Bit n set means that threads with priority n are never preempted by the
+ * round robin scheduler. The idle priority is always excluded.
+ */
+#ifndef SCHED_RR_MASK
+#define SCHED_RR_MASK       (0U)
+#endif
+
+/**
+ * @brief   Initialize the round robin scheduler
+ *
+ * Called automatically by @ref auto_init once xtimer is available.
+ */
+void sched_round_robin_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_schedstatistics Schedstatistics
+ * @ingroup     sys
+ * @brief       When including this module scheduler statistics
+ *              (@ref schedstat_t) for all threads will be updated on every
+ *              context switch.
+ *
+ * The statistics are gathered from a callback registered with
+ * @ref sched_register_cb(), so the scheduler itself does not need to know
+ * about them. Use @ref ps() to show the CPU usage of every thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler statistics
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef SCHEDSTATISTICS_H
+#define SCHEDSTATISTICS_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Scheduler statistics
+ */
+typedef struct {
+    uint64_t laststart;      /**< Time stamp of the last time this thread was
+                                  scheduled to run */
+    unsigned int schedules;  /**< How often the thread was scheduled to run */
+    uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+} schedstat_t;
+
+/**
+ *  Thread statistics table
+ */
+extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
+
+/**
+ *  @brief  Registers the sched statistics callback and sets laststart for
+ *          the caller thread
+ *
+ *  Called automatically by @ref auto_init once xtimer is available.
+ */
+void init_schedstatistics(void);
+
+/**
+ *  @brief  Get the runtime of a thread including its current time slice
+ *
+ *  @param[in] pid  pid of the thread
+ *
+ *  @return the total runtime of the thread in xtimer ticks
+ */
+uint64_t schedstatistics_runtime(kernel_pid_t pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDSTATISTICS_H */
+/** @} */
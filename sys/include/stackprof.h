@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_stackprof Stack profiler
+ * @ingroup     sys
+ * @brief       Continuously track the maximum stack usage of all threads
+ *
+ * With this module, every stack is painted on thread creation (as if
+ * @ref THREAD_CREATE_STACKTEST was given) and the scheduler updates a high
+ * water mark for the thread it switches away from:
+ *
+ * - the saved stack pointer of the thread is taken into account right away
+ * - @ref STACKPROF_SCAN_WORDS words of the painted area are checked,
+ *   continuing where the last check stopped, so deeper excursions between two
+ *   context switches are found after a number of switches
+ *
+ * The cost per context switch is thus constant, and reading the high water
+ * mark with stackprof_usage() is O(1), in contrast to
+ * thread_measure_stack_free(), which scans the whole stack.
+ *
+ * To trap stack overflows as they occur instead of finding them after the
+ * fact, use the module together with `mpu_stack_guard` on CPUs with an MPU.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Stack profiler interface
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ */
+
+#ifndef STACKPROF_H
+#define STACKPROF_H
+
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of stack words checked per context switch
+ */
+#ifndef STACKPROF_SCAN_WORDS
+#define STACKPROF_SCAN_WORDS    (8U)
+#endif
+
+/**
+ * @brief   Update the high water mark of @p thread
+ *
+ * This function is called by the scheduler whenever @p thread is switched
+ * out, there is no need to call it manually.
+ *
+ * @param[in] thread    thread to update, must not be NULL
+ */
+void stackprof_update(thread_t *thread);
+
+/**
+ * @brief   Get the maximum stack usage of a thread seen so far
+ *
+ * As for `ps`, the usage includes the thread control block.
+ *
+ * @param[in] pid       thread to query
+ *
+ * @return  maximum number of stack bytes used
+ * @return  -1 if there is no thread with @p pid
+ */
+int stackprof_usage(kernel_pid_t pid);
+
+/**
+ * @brief   Print size, maximum usage and free space of all stacks
+ */
+void stackprof_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACKPROF_H */
+/** @} */
@@ -52,6 +52,8 @@ typedef struct {
                                          after each interval */
     msg_t msg;                      /**< the msg_t to use for intervals */
     uint64_t msg_time;              /**< interval in ms */
+    uint64_t msg_deadline;          /**< time in microseconds when msg_timer
+                                         fires, 0 if stopped */
     xtimer_t msg_timer;             /**< xtimer to send a msg_t to the target thread
                                          for a new interval */
 } trickle_t;
@@ -89,6 +91,19 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
  */
 void trickle_stop(trickle_t *trickle);
 
+/**
+ * @brief   Gets the time until the callback is called next
+ *
+ * Allows to align the transmissions of several trickle timers: a timer that
+ * is due soon can be stopped and trickle_callback() called right away.
+ *
+ * @param[in] trickle   trickle timer
+ *
+ * @return  the time in milliseconds, 0 if the timer is due
+ * @return  UINT32_MAX if the timer is stopped
+ */
+uint32_t trickle_time_left(const trickle_t *trickle);
+
 /**
  * @brief increments the counter by one
  *
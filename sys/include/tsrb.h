@@ -128,6 +128,52 @@ int tsrb_get_one(tsrb_t *rb);
  */
 int tsrb_get(tsrb_t *rb, char *dst, size_t n);
 
+/**
+ * @brief       Drop bytes from ringbuffer
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   max number of bytes to drop
+ * @return      nr of dropped bytes
+ */
+int tsrb_drop(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get the readable bytes that are stored contiguously in the
+ *              ringbuffer, without removing them
+ *
+ * This lets a consumer work directly on the buffer, e.g. to parse or to copy
+ * its contents in one go. Call tsrb_drop() afterwards to remove the bytes it
+ * used. If the data wraps around the end of the buffer, the rest is returned
+ * by the next call.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    set to the first readable byte
+ * @return      nr of bytes readable at @p data
+ */
+unsigned tsrb_get_span(const tsrb_t *rb, char **data);
+
+/**
+ * @brief       Get the free space that is contiguous in the ringbuffer
+ *
+ * The producer counterpart of tsrb_get_span(): write up to the returned
+ * number of bytes to @p data, then make them readable with tsrb_add_span().
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    set to the first free byte
+ * @return      nr of bytes writable at @p data
+ */
+unsigned tsrb_free_span(const tsrb_t *rb, char **data);
+
+/**
+ * @brief       Make bytes written to the span of tsrb_free_span() readable
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[in]   n       nr of bytes written, at most the size of the span
+ */
+static inline void tsrb_add_span(tsrb_t *rb, unsigned n)
+{
+    assert(n <= tsrb_free(rb));
+    rb->writes += n;
+}
+
 /**
  * @brief       Add a byte to ringbuffer
  * @param[in]   rb  Ringbuffer to operate on
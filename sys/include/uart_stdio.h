@@ -23,6 +23,7 @@
 /* Boards may override the default STDIO UART device */
 #include <stdint.h>
 #include "board.h"
+#include "periph/uart.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,6 +50,60 @@ extern "C" {
 #define UART_STDIO_RX_BUFSIZE    (64)
 #endif
 
+#ifndef UART_STDIO_RX_DMA_BUFSIZE
+/**
+ * @brief Size of the circular buffer STDIO receives into by DMA, where
+ *        available
+ */
+#define UART_STDIO_RX_DMA_BUFSIZE    (64)
+#endif
+
+/**
+ * @name    Overflow policies of the STDIO transmit buffer
+ * @{
+ */
+#define UART_STDIO_TX_BLOCK         (0) /**< wait for room in the buffer */
+#define UART_STDIO_TX_DROP_NEWEST   (1) /**< drop what does not fit */
+#define UART_STDIO_TX_DROP_OLDEST   (2) /**< drop the oldest buffered data
+                                         *   to make room */
+/** @} */
+
+#ifndef UART_STDIO_TX_BUFSIZE
+/**
+ * @brief Size of the buffer STDIO output is queued in, 0 to write
+ *        synchronously
+ *
+ * Queued output is sent from interrupt context, so writes return right away
+ * unless the buffer overflows. This only pays off with
+ * `PERIPH_UART_HAS_WRITE_ASYNC`, so it is disabled on other CPUs by default.
+ */
+#ifdef PERIPH_UART_HAS_WRITE_ASYNC
+#define UART_STDIO_TX_BUFSIZE       (128)
+#else
+#define UART_STDIO_TX_BUFSIZE       (0)
+#endif
+#endif
+
+#ifndef UART_STDIO_TX_POLICY
+/**
+ * @brief What to do when the STDIO transmit buffer overflows
+ *
+ * With @ref UART_STDIO_TX_BLOCK, a thread waits until the UART made room,
+ * while an ISR sends the buffer synchronously.
+ */
+#define UART_STDIO_TX_POLICY        UART_STDIO_TX_BLOCK
+#endif
+
+#ifndef UART_STDIO_TX_CHUNK
+/**
+ * @brief Maximum number of bytes handed to the UART at once
+ *
+ * The bytes are copied out of the transmit buffer, so the buffer can take
+ * new output while they are sent.
+ */
+#define UART_STDIO_TX_CHUNK         (16)
+#endif
+
 /**
  * @brief initialize the module
  */
@@ -76,6 +131,13 @@ int uart_stdio_read(char* buffer, int len);
  */
 int uart_stdio_write(const char* buffer, int len);
 
+/**
+ * @brief send all queued output synchronously
+ *
+ * Works with interrupts disabled, e.g. on a kernel panic.
+ */
+void uart_stdio_flush(void);
+
 /**
  * @brief internal callback for periph/uart drivers
  *
@@ -130,6 +130,25 @@ extern "C" {
 #define VFS_NAME_MAX (31)
 #endif
 
+/**
+ * @name    Readiness events for vfs_poll
+ *
+ * Same values as the corresponding `POLL*` events of `poll.h`
+ * @{
+ */
+#define VFS_POLLIN      (0x0001)    /**< data may be read without blocking */
+#define VFS_POLLOUT     (0x0004)    /**< data may be written without blocking */
+#define VFS_POLLERR     (0x0008)    /**< an error occurred */
+#define VFS_POLLHUP     (0x0010)    /**< the peer hung up */
+/** @} */
+
+/**
+ * @brief Thread flag a poll waiter is woken up with
+ *
+ * @see vfs_file_ops::poll
+ */
+#define VFS_POLL_THREAD_FLAG    (0x1 << 12)
+
 /**
  * @brief Used with vfs_bind to bind to any available fd number
  */
@@ -346,6 +365,45 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Get direct read access to the contents of an open file
+     *
+     * For files that are stored in addressable memory, e.g. internal flash.
+     * The file position is not changed.
+     *
+     * If this is NULL, the file can only be read with @c read.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[out] addr     address of the contents at the current file position
+     * @param[out] len      number of bytes that can be read from @p addr, 0 at
+     *                      or beyond the end of the file
+     *
+     * @return 0 on success
+     * @return <0 on error, e.g. -ENOTSUP if this file is not mapped currently
+     */
+    int (*mmap) (vfs_file_t *filp, const void **addr, size_t *len);
+
+    /**
+     * @brief Query the readiness of an open file
+     *
+     * If none of @p events is ready and @p waiter is not KERNEL_PID_UNDEF, the
+     * file system driver must remember @p waiter and set
+     * @ref VFS_POLL_THREAD_FLAG on it as soon as one of @p events may have
+     * become ready. Only one waiter needs to be remembered per file. A call
+     * with @p waiter = KERNEL_PID_UNDEF removes the waiter again.
+     *
+     * If this is NULL, the file is always ready for reading and writing.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  events   events to check for, see @ref VFS_POLLIN etc.
+     * @param[in]  waiter   thread to wake up, or KERNEL_PID_UNDEF
+     *
+     * @return the ready events of @p events, and VFS_POLLERR or VFS_POLLHUP
+     *         if applicable
+     * @return <0 on error
+     */
+    int (*poll) (vfs_file_t *filp, unsigned events, kernel_pid_t waiter);
 };
 
 /**
@@ -602,6 +660,27 @@ off_t vfs_lseek(int fd, off_t off, int whence);
  */
 int vfs_open(const char *name, int flags, mode_t mode);
 
+/**
+ * @brief Get direct read access to the contents of an open file
+ *
+ * Gives the address of the file contents at the current position, so they
+ * can be used without copying them with vfs_read(). The file position is not
+ * changed, use vfs_lseek() to map other parts of the file.
+ *
+ * The memory must not be written to and is only valid while the file is open
+ * and not modified.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[out] addr     address of the contents at the current file position
+ * @param[out] len      number of bytes that can be read from @p addr, 0 at or
+ *                      beyond the end of the file
+ *
+ * @return 0 on success
+ * @return -EINVAL if the file system driver does not support this
+ * @return <0 on other errors
+ */
+int vfs_mmap(int fd, const void **addr, size_t *len);
+
 /**
  * @brief Read bytes from an open file
  *
@@ -626,6 +705,21 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Query the readiness of an open file
+ *
+ * @see vfs_file_ops::poll
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  events   events to check for, see @ref VFS_POLLIN etc.
+ * @param[in]  waiter   thread to wake up with @ref VFS_POLL_THREAD_FLAG when
+ *                      none of @p events is ready yet, or KERNEL_PID_UNDEF
+ *
+ * @return the ready events on success (>= 0)
+ * @return <0 on error
+ */
+int vfs_poll(int fd, unsigned events, kernel_pid_t waiter);
+
 /**
  * @brief Open a directory for reading with readdir
  *
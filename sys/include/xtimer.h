@@ -33,6 +33,7 @@
 #include "timex.h"
 #include "msg.h"
 #include "mutex.h"
+#include "thread_flags.h"
 
 #include "board.h"
 #include "periph_conf.h"
@@ -74,6 +75,9 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may fire before target */
+#endif
 } xtimer_t;
 
 /**
@@ -114,6 +118,21 @@ static inline uint32_t xtimer_now_usec(void);
  */
 static inline uint64_t xtimer_now_usec64(void);
 
+/**
+ * @brief get the current system time in milliseconds since start
+ *
+ * This is cheaper than `xtimer_now_usec64() / 1000`: it reads the
+ * low-level timer and the time of the start of the current timer period,
+ * which is kept up to date by xtimer, and only uses 32 bit arithmetic on
+ * most platforms. Like xtimer_now64(), it never disables interrupts.
+ *
+ * @note    Overflows after 2**32 milliseconds (~49.7 days), use differences
+ *          of two values only.
+ *
+ * @return  current time in milliseconds
+ */
+uint32_t xtimer_now_coarse_ms(void);
+
 /**
  * @brief xtimer initialization function
  *
@@ -207,6 +226,62 @@ static inline void xtimer_spin(xtimer_ticks32_t ticks);
  */
 static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup, uint32_t period);
 
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+/**
+ * @brief   Persistent periodic timer
+ *
+ * Unlike xtimer_periodic_wakeup(), the timer stays armed: it reloads itself
+ * from the timer interrupt, so the period does not drift and the waiting
+ * thread does no timer list work per period. Each period is signalled to the
+ * thread with a thread flag.
+ *
+ * @note    this requires core_thread_flags to be enabled
+ */
+typedef struct {
+    xtimer_t timer;             /**< underlying timer */
+    uint32_t period;            /**< period in ticks */
+    uint32_t next;              /**< target time of the next period in ticks */
+    thread_t *thread;           /**< thread to signal */
+    thread_flags_t flag;        /**< flag to set on each period */
+    volatile uint32_t elapsed;  /**< periods elapsed since last
+                                     xtimer_periodic_wait() */
+} xtimer_periodic_t;
+
+/**
+ * @brief   Start a persistent periodic timer signalling the calling thread
+ *
+ * The first period ends @p period microseconds from now.
+ *
+ * @param[out] periodic periodic timer to start, must not be running
+ * @param[in] period    period in microseconds, must be larger than
+ *                      @ref XTIMER_PERIODIC_SPIN ticks
+ * @param[in] flag      thread flag to set at the end of each period
+ */
+void xtimer_periodic_start(xtimer_periodic_t *periodic, uint32_t period,
+                           thread_flags_t flag);
+
+/**
+ * @brief   Stop a persistent periodic timer
+ *
+ * @param[in] periodic  periodic timer to stop
+ */
+void xtimer_periodic_stop(xtimer_periodic_t *periodic);
+
+/**
+ * @brief   Wait until the end of the current period of a periodic timer
+ *
+ * Returns immediately if a period ended since the last call.
+ *
+ * @param[in] periodic  periodic timer to wait for, must have been started by
+ *                      the calling thread
+ *
+ * @return  number of periods that were missed since the last call, i.e. the
+ *          number of periods that ended in addition to the one that is
+ *          reported by this call
+ */
+uint32_t xtimer_periodic_wait(xtimer_periodic_t *periodic);
+#endif
+
 /**
  * @brief Set a timer that sends a message
  *
@@ -291,6 +366,28 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer that may fire anywhere inside a time window
+ *
+ * Like xtimer_set(), but the callback is executed somewhere between
+ * @p offset and @p offset + @p slack microseconds in the future. With the
+ * `xtimer_slack` module, xtimer uses the window to fire the timer together
+ * with other timers, so that the CPU wakes up less often. This is meant for
+ * periodic housekeeping that does not need exact timing.
+ *
+ * Without the `xtimer_slack` module, the timer fires after exactly
+ * @p offset microseconds.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    earliest time in microseconds from now the callback
+ *                      may be executed
+ * @param[in] slack     length of the window in microseconds
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
 /**
  * @brief remove a timer
  *
@@ -303,6 +400,9 @@ void xtimer_remove(xtimer_t *timer);
 /**
  * @brief receive a message blocking but with timeout
  *
+ * The timeout wakes up the thread directly, it neither needs nor uses a slot
+ * in the thread's message queue.
+ *
  * @param[out] msg      pointer to a msg_t which will be filled in case of
  *                      no timeout
  * @param[in]  timeout  timeout in microseconds relative
@@ -426,6 +526,20 @@ static inline bool xtimer_less(xtimer_ticks32_t a, xtimer_ticks32_t b);
  */
 static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b);
 
+/**
+ * @brief Get the time until xtimer needs the CPU again
+ *
+ * Returns the time until the low-level timer fires next, either for the
+ * earliest set timer or for xtimer's own overflow handling. This is the time
+ * the CPU may spend sleeping without delaying any timer.
+ *
+ * @note    Should be called with interrupts disabled, otherwise the result
+ *          may be outdated by the time it is used.
+ *
+ * @return  ticks until the next xtimer interrupt
+ */
+xtimer_ticks32_t xtimer_time_to_next_event(void);
+
 /**
  * @brief lock a mutex but with timeout
  *
@@ -439,6 +553,49 @@ static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b);
  */
 int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 
+#if defined(MODULE_XTIMER_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Number of histogram buckets of @ref xtimer_stats_t
+ *
+ * Bucket 0 counts the value 0, bucket n > 0 counts values in
+ * [2^(n-1), 2^n), the last bucket also counts all larger values.
+ */
+#ifndef XTIMER_STATS_BUCKETS
+#define XTIMER_STATS_BUCKETS    (12U)
+#endif
+
+/**
+ * @brief   xtimer instrumentation data, requires the `xtimer_stats` module
+ */
+typedef struct {
+    uint32_t latency[XTIMER_STATS_BUCKETS]; /**< histogram of the delay
+                                                 between target time and
+                                                 callback execution, in ticks,
+                                                 for timers fired by the
+                                                 timer interrupt */
+    uint32_t depth[XTIMER_STATS_BUCKETS];   /**< histogram of the number of
+                                                 timers an inserted timer was
+                                                 sorted behind */
+    uint32_t latency_max;                   /**< largest latency seen */
+    uint32_t spins;                         /**< number of busy waits
+                                                 (XTIMER_BACKOFF and
+                                                 XTIMER_ISR_BACKOFF) */
+    uint32_t spin_ticks;                    /**< ticks spent busy waiting */
+} xtimer_stats_t;
+
+/**
+ * @brief   Get a copy of the current instrumentation data
+ *
+ * @param[out] stats    target for the data
+ */
+void xtimer_stats_get(xtimer_stats_t *stats);
+
+/**
+ * @brief   Reset the instrumentation data
+ */
+void xtimer_stats_reset(void);
+#endif
+
 /**
  * @brief xtimer backoff value
  *
@@ -580,6 +737,20 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_HZ 1000000ul
 #endif
 
+#ifndef XTIMER_WHEEL_SLOTS
+/**
+ * @brief   Number of slots of the timer wheel, must be a power of two
+ *
+ * Only used with the `xtimer_wheel` module. Instead of a sorted list, timers
+ * that do not expire in the current period of the low-level timer
+ * (2^XTIMER_WIDTH ticks) are kept unsorted in slot
+ * (period % XTIMER_WHEEL_SLOTS) of a timer wheel, which makes adding and
+ * removing them O(1) on average. When a period starts, the timers of its
+ * slot are moved to the sorted list of the current period.
+ */
+#define XTIMER_WHEEL_SLOTS  (16U)
+#endif
+
 #include "xtimer/tick_conversion.h"
 
 #include "xtimer/implementation.h"
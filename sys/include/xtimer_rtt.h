@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_xtimer_rtt Low-power clock domain for xtimer
+ * @ingroup     sys_xtimer
+ * @brief       Run long timers on the RTT instead of the high speed timer
+ *
+ * xtimer uses a high speed peripheral timer, whose clock has to keep running
+ * while a timer is pending. This module adds a second clock domain based on
+ * @ref drivers_periph_rtt for timers that expire far in the future:
+ *
+ * - timers shorter than @ref XTIMER_RTT_THRESHOLD are passed to xtimer
+ *   directly
+ * - longer timers wait on the RTT until @ref XTIMER_RTT_HANDOVER before their
+ *   target time, and are then handed over to xtimer, which fires them with
+ *   its usual precision
+ *
+ * While only RTT-based timers are pending, xtimer has nothing to do and the
+ * CPU may enter power modes that stop the high speed clock.
+ *
+ * Timers longer than half of the RTT's range are handled by intermediate RTT
+ * alarms, so any 64 bit offset can be used.
+ *
+ * @note    This module takes over the RTT alarm. It can not be used together
+ *          with other users of the RTT alarm (e.g. lwmac).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Low-power clock domain for xtimer interface
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef XTIMER_RTT_H
+#define XTIMER_RTT_H
+
+#include <stdint.h>
+
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timers with an offset of at least this many microseconds are run
+ *          on the RTT
+ *
+ * Must fit into 32 bit. Offsets that are not much longer than
+ * @ref XTIMER_RTT_HANDOVER always use xtimer.
+ */
+#ifndef XTIMER_RTT_THRESHOLD
+#define XTIMER_RTT_THRESHOLD    (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Time in microseconds before the target time at which a timer is
+ *          handed over from the RTT to xtimer
+ *
+ * This has to cover the wake-up time of the deepest power mode used plus
+ * one RTT tick.
+ */
+#ifndef XTIMER_RTT_HANDOVER
+#define XTIMER_RTT_HANDOVER     (5U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Timer that automatically uses the RTT for long offsets
+ *
+ * Set xtimer_rtt_t::timer.callback and xtimer_rtt_t::timer.arg before use,
+ * all other fields must be zero initialized.
+ */
+typedef struct xtimer_rtt {
+    xtimer_t timer;             /**< xtimer used for short offsets and the
+                                     last part of long ones */
+    struct xtimer_rtt *next;    /**< next timer waiting on the RTT */
+    uint32_t rtt_target;        /**< RTT counter value of the next alarm */
+    uint64_t rtt_left;          /**< RTT ticks left after that alarm */
+    uint32_t rtt_rest;          /**< remainder below one RTT tick in us */
+} xtimer_rtt_t;
+
+/**
+ * @brief   Initialize the RTT clock domain
+ *
+ * Called by auto_init.
+ */
+void xtimer_rtt_init(void);
+
+/**
+ * @brief   Set a timer to execute its callback @p offset microseconds in
+ *          the future
+ *
+ * The clock domain is chosen based on @p offset. As with xtimer_set(), the
+ * callback is executed in interrupt context.
+ *
+ * @param[in] timer     timer to set
+ * @param[in] offset    offset in microseconds
+ */
+void xtimer_rtt_set(xtimer_rtt_t *timer, uint64_t offset);
+
+/**
+ * @brief   Remove a timer, regardless of its clock domain
+ *
+ * @param[in] timer     timer to remove
+ */
+void xtimer_rtt_remove(xtimer_rtt_t *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XTIMER_RTT_H */
+/** @} */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_irq_handler
+ * @{
+ *
+ * @file
+ * @brief       Deferred interrupt handler implementation
+ *
+ * Pending events form a LIFO that producers push to with a single
+ * compare-and-swap. The handler thread takes the whole LIFO at once and
+ * reverses it, so events still run in the order they were queued.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "irq_handler.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define IRQ_HANDLER_FLAG        (0x1)
+
+static char _stack[IRQ_HANDLER_STACKSIZE];
+
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+/* head of the pending events, stored as integer for C99 compatibility */
+static atomic_uintptr_t _pending = ATOMIC_VAR_INIT(0);
+
+int irq_event_add(irq_event_t *irq)
+{
+    if (atomic_exchange(&irq->pending, 1)) {
+        DEBUG("irq_handler: event %p already pending\n", (void *)irq);
+        return -EALREADY;
+    }
+
+    uintptr_t head = atomic_load(&_pending);
+    do {
+        irq->next = (irq_event_t *)head;
+    } while (!atomic_compare_exchange_weak(&_pending, &head, (uintptr_t)irq));
+
+    /* events queued before the thread was started are handled on start */
+    if (_pid != KERNEL_PID_UNDEF) {
+        thread_flags_set((thread_t *)sched_threads[_pid], IRQ_HANDLER_FLAG);
+    }
+
+    return 0;
+}
+
+static void *_irq_handler_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        if (atomic_load(&_pending) == 0) {
+            thread_flags_wait_any(IRQ_HANDLER_FLAG);
+        }
+
+        irq_event_t *lifo = (irq_event_t *)atomic_exchange(&_pending, 0);
+        irq_event_t *fifo = NULL;
+
+        /* restore queuing order */
+        while (lifo) {
+            irq_event_t *next = lifo->next;
+            lifo->next = fifo;
+            fifo = lifo;
+            lifo = next;
+        }
+
+        while (fifo) {
+            irq_event_t *irq = fifo;
+            fifo = irq->next;
+            /* allow the ISR to re-queue the event while it is handled */
+            atomic_store(&irq->pending, 0);
+            DEBUG("irq_handler: handling event %p\n", (void *)irq);
+            irq->isr(irq->ctx);
+        }
+    }
+
+    return NULL;
+}
+
+kernel_pid_t irq_handler_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), IRQ_HANDLER_PRIO,
+                             THREAD_CREATE_STACKTEST, _irq_handler_thread,
+                             NULL, "irq_handler");
+    }
+
+    return _pid;
+}
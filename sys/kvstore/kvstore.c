@@ -0,0 +1,722 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_kvstore
+ * @{
+ *
+ * @file
+ * @brief       Key-value store implementation
+ *
+ * Every sector in use starts with a header of the magic number and a
+ * sequence number, which increases with every sector started. The records
+ * follow the header:
+ *
+ *     0           1       2         4       6
+ *     +-----------+-------+---------+-------+-----+-------+
+ *     | key length| type  | val len |  CRC  | key | value |
+ *     +-----------+-------+---------+-------+-----+-------+
+ *
+ * The CRC covers the first four bytes, the key and the value. The log of a
+ * sector ends at an erased key length.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "hashes.h"
+#include "kvstore.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define SECTOR_MAGIC        (0x3153564bUL)  /**< "KVS1" */
+#define SECTOR_HDR_LEN      (8U)
+#define REC_HDR_LEN         (6U)
+#define REC_TYPE_VALUE      ('V')
+#define REC_TYPE_DELETE     ('D')
+#define REC_END             (0xffU)         /**< erased key length */
+
+/* data is copied and checked in chunks of this size */
+#define CHUNK_LEN           (32U)
+
+typedef struct {
+    uint8_t key_len;
+    uint8_t type;
+    uint16_t val_len;
+    uint16_t crc;
+} _rec_t;
+
+/* the on-device format is little endian */
+static inline uint16_t _get_u16(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8);
+}
+
+static inline uint32_t _get_u32(const uint8_t *buf)
+{
+    return _get_u16(buf) | ((uint32_t)_get_u16(&buf[2]) << 16);
+}
+
+static inline void _put_u16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = val & 0xff;
+    buf[1] = val >> 8;
+}
+
+static inline void _put_u32(uint8_t *buf, uint32_t val)
+{
+    _put_u16(buf, val & 0xffff);
+    _put_u16(&buf[2], val >> 16);
+}
+
+static inline uint32_t _sector_addr(const kvstore_t *kv, uint32_t sector)
+{
+    return sector * kv->sector_size;
+}
+
+static inline uint32_t _next(const kvstore_t *kv, uint32_t sector)
+{
+    return (sector + 1) % kv->mtd->sector_count;
+}
+
+static inline uint32_t _hash(const char *key, size_t key_len)
+{
+    return djb2_hash((const uint8_t *)key, key_len);
+}
+
+static inline unsigned _home(uint32_t hash)
+{
+    return hash % KVSTORE_INDEX_SIZE;
+}
+
+static int _read(kvstore_t *kv, uint32_t addr, void *buf, size_t len)
+{
+    int res = mtd_read(kv->mtd, buf, addr, len);
+
+    return (res < 0) ? res : 0;
+}
+
+/* writes may not cross a page */
+static int _write(kvstore_t *kv, uint32_t addr, const void *buf, size_t len)
+{
+    const uint8_t *src = buf;
+    uint32_t page_size = kv->mtd->page_size;
+
+    while (len > 0) {
+        size_t chunk = page_size - (addr % page_size);
+        int res;
+
+        if (chunk > len) {
+            chunk = len;
+        }
+        if ((res = mtd_write(kv->mtd, src, addr, chunk)) < 0) {
+            return res;
+        }
+        addr += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+static bool _in_use(kvstore_t *kv, uint32_t sector, uint32_t *seq)
+{
+    uint8_t hdr[SECTOR_HDR_LEN];
+
+    if (_read(kv, _sector_addr(kv, sector), hdr, sizeof(hdr)) < 0) {
+        return false;
+    }
+    if (_get_u32(hdr) != SECTOR_MAGIC) {
+        return false;
+    }
+    if (seq != NULL) {
+        *seq = _get_u32(&hdr[4]);
+    }
+    return true;
+}
+
+static int _open_sector(kvstore_t *kv, uint32_t sector)
+{
+    uint32_t addr = _sector_addr(kv, sector);
+    uint8_t hdr[SECTOR_HDR_LEN];
+    int res;
+
+    DEBUG("kvstore: open sector %" PRIu32 "\n", sector);
+    if ((res = mtd_erase(kv->mtd, addr, kv->sector_size)) < 0) {
+        return res;
+    }
+    _put_u32(hdr, SECTOR_MAGIC);
+    _put_u32(&hdr[4], kv->seq + 1);
+    /* the magic number comes last, so a torn header leaves the sector
+     * unused */
+    if (((res = _write(kv, addr + 4, &hdr[4], 4)) < 0) ||
+        ((res = _write(kv, addr, hdr, 4)) < 0)) {
+        return res;
+    }
+    kv->seq++;
+    kv->active = sector;
+    kv->offset = SECTOR_HDR_LEN;
+    return 0;
+}
+
+static int _release_sector(kvstore_t *kv, uint32_t sector)
+{
+    static const uint8_t zero[4] = { 0 };
+
+    DEBUG("kvstore: release sector %" PRIu32 "\n", sector);
+    /* only clears bits, so there is no need to erase here */
+    return _write(kv, _sector_addr(kv, sector), zero, sizeof(zero));
+}
+
+/**
+ * @brief   Reads and checks the record at @p addr
+ *
+ * @return  1 if there is a valid record, its key is read to @p key
+ * @return  0 at the end of the log
+ * @return  -EBADMSG if the record is corrupted
+ * @return  other negative errno of the device
+ */
+static int _read_rec(kvstore_t *kv, uint32_t addr, uint32_t end, _rec_t *rec,
+                     char *key)
+{
+    uint8_t buf[CHUNK_LEN];
+    uint32_t pos, rec_end;
+    uint16_t crc;
+    int res;
+
+    if ((end - addr) < REC_HDR_LEN) {
+        return 0;
+    }
+    if ((res = _read(kv, addr, buf, REC_HDR_LEN)) < 0) {
+        return res;
+    }
+    rec->key_len = buf[0];
+    rec->type = buf[1];
+    rec->val_len = _get_u16(&buf[2]);
+    rec->crc = _get_u16(&buf[4]);
+    if (rec->key_len == REC_END) {
+        return 0;
+    }
+    rec_end = addr + REC_HDR_LEN + rec->key_len + rec->val_len;
+    if ((rec->key_len == 0) || (rec->key_len > KVSTORE_KEY_LEN_MAX) ||
+        ((rec->type != REC_TYPE_VALUE) && (rec->type != REC_TYPE_DELETE)) ||
+        (rec_end > end)) {
+        return -EBADMSG;
+    }
+    crc = crc16_ccitt_calc(buf, 4);
+    if ((res = _read(kv, addr + REC_HDR_LEN, key, rec->key_len)) < 0) {
+        return res;
+    }
+    crc = crc16_ccitt_update(crc, (uint8_t *)key, rec->key_len);
+    for (pos = addr + REC_HDR_LEN + rec->key_len; pos < rec_end;) {
+        uint32_t chunk = rec_end - pos;
+
+        if (chunk > sizeof(buf)) {
+            chunk = sizeof(buf);
+        }
+        if ((res = _read(kv, pos, buf, chunk)) < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, buf, chunk);
+        pos += chunk;
+    }
+    return (crc == rec->crc) ? 1 : -EBADMSG;
+}
+
+static inline uint32_t _rec_len(const _rec_t *rec)
+{
+    return REC_HDR_LEN + rec->key_len + rec->val_len;
+}
+
+/**
+ * @brief   Looks up @p key in the index
+ *
+ * @return  1 if found, @p slot is its entry
+ * @return  0 if not found, @p slot is the empty entry to use for it
+ * @return  negative errno of the device
+ */
+static int _find(kvstore_t *kv, const char *key, size_t key_len, uint32_t hash,
+                 unsigned *slot)
+{
+    unsigned i = _home(hash);
+
+    /* the index always has an empty entry, which ends the probing */
+    for (; kv->index[i].addr != 0; i = (i + 1) % KVSTORE_INDEX_SIZE) {
+        uint8_t hdr[REC_HDR_LEN];
+        char stored[KVSTORE_KEY_LEN_MAX];
+        int res;
+
+        if (kv->index[i].hash != hash) {
+            continue;
+        }
+        if ((res = _read(kv, kv->index[i].addr, hdr, sizeof(hdr))) < 0) {
+            return res;
+        }
+        if (hdr[0] != key_len) {
+            continue;
+        }
+        res = _read(kv, kv->index[i].addr + REC_HDR_LEN, stored, key_len);
+        if (res < 0) {
+            return res;
+        }
+        if (memcmp(stored, key, key_len) == 0) {
+            *slot = i;
+            return 1;
+        }
+    }
+    *slot = i;
+    return 0;
+}
+
+static void _remove(kvstore_t *kv, unsigned slot)
+{
+    unsigned i = slot, j = slot;
+
+    /* backward shift deletion, so no entry becomes unreachable */
+    kv->index[i].addr = 0;
+    while (1) {
+        unsigned home;
+
+        j = (j + 1) % KVSTORE_INDEX_SIZE;
+        if (kv->index[j].addr == 0) {
+            break;
+        }
+        home = _home(kv->index[j].hash);
+        /* entries with their home in (i, j] stay where they are */
+        if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+            continue;
+        }
+        kv->index[i] = kv->index[j];
+        kv->index[j].addr = 0;
+        i = j;
+    }
+    kv->numof--;
+}
+
+/* applies a record found while mounting to the index */
+static int _apply(kvstore_t *kv, uint32_t addr, const _rec_t *rec,
+                  const char *key)
+{
+    uint32_t hash = _hash(key, rec->key_len);
+    unsigned slot;
+    int res;
+
+    if ((res = _find(kv, key, rec->key_len, hash, &slot)) < 0) {
+        return res;
+    }
+    if (rec->type == REC_TYPE_DELETE) {
+        if (res == 1) {
+            _remove(kv, slot);
+        }
+        return 0;
+    }
+    if (res == 0) {
+        if (kv->numof >= (KVSTORE_INDEX_SIZE - 1)) {
+            return -ENOMEM;
+        }
+        kv->index[slot].hash = hash;
+        kv->numof++;
+    }
+    kv->index[slot].addr = addr;
+    return 0;
+}
+
+/* copies len bytes within the device */
+static int _copy(kvstore_t *kv, uint32_t dst, uint32_t src, uint32_t len)
+{
+    uint8_t buf[CHUNK_LEN];
+
+    while (len > 0) {
+        uint32_t chunk = (len > sizeof(buf)) ? sizeof(buf) : len;
+        int res;
+
+        if (((res = _read(kv, src, buf, chunk)) < 0) ||
+            ((res = _write(kv, dst, buf, chunk)) < 0)) {
+            return res;
+        }
+        src += chunk;
+        dst += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+/**
+ * @brief   Moves the live records of @p sector to the active sector
+ *
+ * Records of deleted keys are dropped, as @p sector is the oldest one, so
+ * there is no older record the deletion record would have to hide.
+ *
+ * @param[in] copy  if false, only the size of the live records is computed
+ *
+ * @return  the size of the live records
+ * @return  negative errno of the device
+ */
+static int _collect(kvstore_t *kv, uint32_t sector, bool copy)
+{
+    uint32_t addr = _sector_addr(kv, sector) + SECTOR_HDR_LEN;
+    uint32_t end = _sector_addr(kv, sector) + kv->sector_size;
+    uint32_t live = 0;
+    _rec_t rec;
+    char key[KVSTORE_KEY_LEN_MAX];
+    int res;
+
+    /* a corrupted record ends the log of a sector */
+    while ((res = _read_rec(kv, addr, end, &rec, key)) == 1) {
+        unsigned slot;
+
+        if (rec.type == REC_TYPE_VALUE) {
+            res = _find(kv, key, rec.key_len, _hash(key, rec.key_len), &slot);
+            if (res < 0) {
+                return res;
+            }
+            if ((res == 1) && (kv->index[slot].addr == addr)) {
+                if (copy) {
+                    uint32_t dst = _sector_addr(kv, kv->active) + kv->offset;
+
+                    if ((res = _copy(kv, dst, addr, _rec_len(&rec))) < 0) {
+                        return res;
+                    }
+                    kv->index[slot].addr = dst;
+                    kv->offset += _rec_len(&rec);
+                }
+                live += _rec_len(&rec);
+            }
+        }
+        addr += _rec_len(&rec);
+    }
+    if ((res < 0) && (res != -EBADMSG)) {
+        return res;
+    }
+    if (copy && ((res = _release_sector(kv, sector)) < 0)) {
+        return res;
+    }
+    return (int)live;
+}
+
+/* the oldest sector in use, the active one if no other is used */
+static uint32_t _oldest(kvstore_t *kv)
+{
+    uint32_t sector = _next(kv, kv->active);
+
+    while ((sector != kv->active) && !_in_use(kv, sector, NULL)) {
+        sector = _next(kv, sector);
+    }
+    return sector;
+}
+
+/**
+ * @brief   Starts the next sector
+ *
+ * One sector is always kept unused, so if the next sector after the new one
+ * is in use, it is the oldest and its live records are moved to the new
+ * sector. They always fit, as they come from a single sector.
+ */
+static int _advance(kvstore_t *kv)
+{
+    uint32_t next = _next(kv, kv->active);
+    uint32_t after = _next(kv, next);
+    int res;
+
+    if (_in_use(kv, next, NULL)) {
+        /* the unused sector was lost to an earlier error */
+        return -ENOSPC;
+    }
+    if ((res = _open_sector(kv, next)) < 0) {
+        return res;
+    }
+    if ((after != next) && _in_use(kv, after, NULL)) {
+        res = _collect(kv, after, true);
+    }
+    return (res < 0) ? res : 0;
+}
+
+static int _make_room(kvstore_t *kv, uint32_t len)
+{
+    for (uint32_t i = 0; (kv->offset + len) > kv->sector_size; i++) {
+        int res;
+
+        /* every sector was collected without freeing enough space */
+        if (i >= kv->mtd->sector_count) {
+            return -ENOSPC;
+        }
+        if ((res = _advance(kv)) < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int _append(kvstore_t *kv, uint8_t type, const char *key,
+                   size_t key_len, const void *value, size_t len,
+                   uint32_t *addr)
+{
+    uint8_t hdr[REC_HDR_LEN];
+    uint16_t crc;
+    int res;
+
+    if ((res = _make_room(kv, REC_HDR_LEN + key_len + len)) < 0) {
+        return res;
+    }
+    hdr[0] = key_len;
+    hdr[1] = type;
+    _put_u16(&hdr[2], len);
+    crc = crc16_ccitt_calc(hdr, 4);
+    crc = crc16_ccitt_update(crc, (const uint8_t *)key, key_len);
+    crc = crc16_ccitt_update(crc, value, len);
+    _put_u16(&hdr[4], crc);
+
+    *addr = _sector_addr(kv, kv->active) + kv->offset;
+    /* the record is taken into account from here on, even if writing it
+     * fails half-way */
+    kv->offset += REC_HDR_LEN + key_len + len;
+    if (((res = _write(kv, *addr, hdr, sizeof(hdr))) < 0) ||
+        ((res = _write(kv, *addr + REC_HDR_LEN, key, key_len)) < 0) ||
+        ((res = _write(kv, *addr + REC_HDR_LEN + key_len, value, len)) < 0)) {
+        return res;
+    }
+    return 0;
+}
+
+static int _mount(kvstore_t *kv)
+{
+    uint32_t seq, sector;
+    bool found = false;
+
+    for (uint32_t i = 0; i < kv->mtd->sector_count; i++) {
+        if (_in_use(kv, i, &seq) &&
+            (!found || ((int32_t)(seq - kv->seq) > 0))) {
+            kv->active = i;
+            kv->seq = seq;
+            found = true;
+        }
+    }
+    if (!found) {
+        return -ENOENT;
+    }
+
+    /* the sectors in use follow each other on the ring, ending at the active
+     * one */
+    sector = kv->active;
+    do {
+        uint32_t addr, end;
+        _rec_t rec;
+        char key[KVSTORE_KEY_LEN_MAX];
+        int res;
+
+        sector = _next(kv, sector);
+        if (!_in_use(kv, sector, NULL)) {
+            continue;
+        }
+        addr = _sector_addr(kv, sector) + SECTOR_HDR_LEN;
+        end = _sector_addr(kv, sector) + kv->sector_size;
+        while ((res = _read_rec(kv, addr, end, &rec, key)) == 1) {
+            if ((res = _apply(kv, addr, &rec, key)) < 0) {
+                return res;
+            }
+            addr += _rec_len(&rec);
+        }
+        if (res == -EBADMSG) {
+            DEBUG("kvstore: corrupted record at 0x%" PRIx32 "\n", addr);
+            /* nothing is appended behind a corrupted record */
+            addr = end;
+        }
+        else if (res < 0) {
+            return res;
+        }
+        if (sector == kv->active) {
+            kv->offset = addr - _sector_addr(kv, sector);
+        }
+    } while (sector != kv->active);
+
+    /* power was lost while the oldest sector was collected, the records not
+     * copied yet are still live */
+    sector = _next(kv, kv->active);
+    if (_in_use(kv, sector, NULL)) {
+        int live = _collect(kv, sector, false);
+
+        if (live < 0) {
+            return live;
+        }
+        if ((kv->offset + (uint32_t)live) <= kv->sector_size) {
+            live = _collect(kv, sector, true);
+        }
+        return (live < 0) ? live : 0;
+    }
+    return 0;
+}
+
+static int _format(kvstore_t *kv)
+{
+    int res;
+
+    memset(kv->index, 0, sizeof(kv->index));
+    kv->numof = 0;
+    for (uint32_t i = 0; i < kv->mtd->sector_count; i++) {
+        if (_in_use(kv, i, NULL) && ((res = _release_sector(kv, i)) < 0)) {
+            return res;
+        }
+    }
+    kv->seq = 0;
+    return _open_sector(kv, 0);
+}
+
+int kvstore_init(kvstore_t *kv, mtd_dev_t *mtd)
+{
+    int res;
+
+    if (mtd->sector_count < 2) {
+        return -EINVAL;
+    }
+    kv->mtd = mtd;
+    kv->sector_size = mtd->pages_per_sector * mtd->page_size;
+    kv->numof = 0;
+    memset(kv->index, 0, sizeof(kv->index));
+    mutex_init(&kv->lock);
+
+    if ((res = _mount(kv)) == -ENOENT) {
+        DEBUG("kvstore: no store found, formatting\n");
+        res = _format(kv);
+    }
+    return res;
+}
+
+int kvstore_format(kvstore_t *kv)
+{
+    int res;
+
+    mutex_lock(&kv->lock);
+    res = _format(kv);
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_get(kvstore_t *kv, const char *key, void *value, size_t len)
+{
+    size_t key_len = strlen(key);
+    unsigned slot;
+    uint8_t hdr[REC_HDR_LEN];
+    uint16_t val_len;
+    int res;
+
+    if ((key_len == 0) || (key_len > KVSTORE_KEY_LEN_MAX)) {
+        return -ENOENT;
+    }
+    mutex_lock(&kv->lock);
+    if ((res = _find(kv, key, key_len, _hash(key, key_len), &slot)) == 0) {
+        res = -ENOENT;
+    }
+    if ((res < 0) ||
+        ((res = _read(kv, kv->index[slot].addr, hdr, sizeof(hdr))) < 0)) {
+        goto out;
+    }
+    val_len = _get_u16(&hdr[2]);
+    if (len > val_len) {
+        len = val_len;
+    }
+    res = _read(kv, kv->index[slot].addr + REC_HDR_LEN + key_len, value, len);
+    if (res == 0) {
+        res = val_len;
+    }
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = _hash(key, key_len);
+    uint32_t addr;
+    unsigned slot;
+    int res;
+
+    if ((key_len == 0) || (key_len > KVSTORE_KEY_LEN_MAX) ||
+        (len > UINT16_MAX) ||
+        ((REC_HDR_LEN + key_len + len) > (kv->sector_size - SECTOR_HDR_LEN))) {
+        return -EINVAL;
+    }
+    mutex_lock(&kv->lock);
+    if ((res = _find(kv, key, key_len, hash, &slot)) < 0) {
+        goto out;
+    }
+    if ((res == 0) && (kv->numof >= (KVSTORE_INDEX_SIZE - 1))) {
+        res = -ENOMEM;
+        goto out;
+    }
+    if ((res = _append(kv, REC_TYPE_VALUE, key, key_len, value, len, &addr)) < 0) {
+        goto out;
+    }
+    /* garbage collection only changes addresses, the slot is still valid */
+    if (kv->index[slot].addr == 0) {
+        kv->index[slot].hash = hash;
+        kv->numof++;
+    }
+    kv->index[slot].addr = addr;
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_delete(kvstore_t *kv, const char *key)
+{
+    size_t key_len = strlen(key);
+    uint32_t addr;
+    unsigned slot;
+    int res;
+
+    if ((key_len == 0) || (key_len > KVSTORE_KEY_LEN_MAX)) {
+        return -ENOENT;
+    }
+    mutex_lock(&kv->lock);
+    if ((res = _find(kv, key, key_len, _hash(key, key_len), &slot)) == 0) {
+        res = -ENOENT;
+    }
+    if ((res < 0) ||
+        ((res = _append(kv, REC_TYPE_DELETE, key, key_len, NULL, 0, &addr)) < 0)) {
+        goto out;
+    }
+    _remove(kv, slot);
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_compact(kvstore_t *kv)
+{
+    uint32_t oldest;
+    int res = 0;
+
+    mutex_lock(&kv->lock);
+    oldest = _oldest(kv);
+    /* there is more than one unused sector if the oldest one is not the
+     * second next */
+    if ((oldest == kv->active) || (oldest != _next(kv, _next(kv, kv->active)))) {
+        goto out;
+    }
+    if ((res = _collect(kv, oldest, false)) < 0) {
+        goto out;
+    }
+    if ((kv->offset + (uint32_t)res) <= kv->sector_size) {
+        res = _collect(kv, oldest, true);
+    }
+    else {
+        res = _advance(kv);
+    }
+out:
+    mutex_unlock(&kv->lock);
+    return (res < 0) ? res : 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_deferred
+ * @{
+ *
+ * @file
+ * @brief       Deferred binary log implementation
+ *
+ * A record consists of the format string's address and the timestamp in
+ * microseconds as 32-bit values, the level and the number of arguments as
+ * single bytes, followed by the arguments as 32-bit values, all in the CPU's
+ * byte order. Dropped records are reported by a record with a NULL format
+ * string and their number as only argument.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "ringbuffer.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#include "log_module.h"
+
+#define LOG_DEFERRED_FLAG       (0x1)
+
+#define HDR_LEN                 (10U)
+#define RECORD_LEN_MAX          (HDR_LEN + (4 * LOG_DEFERRED_ARGS_MAX))
+
+static char _buf[LOG_DEFERRED_BUFSIZE];
+static ringbuffer_t _rb = RINGBUFFER_INIT(_buf);
+static uint32_t _dropped;
+
+static char _stack[LOG_DEFERRED_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+static void _add(const char *format, unsigned level, const uint32_t *args,
+                 unsigned nargs, uint32_t now)
+{
+    char hdr[HDR_LEN];
+    uintptr_t fmt = (uintptr_t)format;
+
+    memcpy(hdr, &fmt, 4);
+    memcpy(&hdr[4], &now, 4);
+    hdr[8] = level;
+    hdr[9] = nargs;
+    ringbuffer_add(&_rb, hdr, sizeof(hdr));
+    ringbuffer_add(&_rb, (const char *)args, 4 * nargs);
+}
+
+void log_deferred_write(unsigned level, const char *format,
+                        const uint32_t *args, unsigned nargs)
+{
+    uint32_t now = xtimer_now_usec();
+    unsigned state;
+
+    assert(nargs <= LOG_DEFERRED_ARGS_MAX);
+
+    state = irq_disable();
+
+    /* report the records lost before, if this one fits as well */
+    if (_dropped &&
+        (ringbuffer_get_free(&_rb) >= (2 * HDR_LEN) + 4 + (4 * nargs))) {
+        _add(NULL, 0, &_dropped, 1, now);
+        _dropped = 0;
+    }
+    if (_dropped || (ringbuffer_get_free(&_rb) < HDR_LEN + (4 * nargs))) {
+        _dropped++;
+        irq_restore(state);
+        return;
+    }
+    _add(format, level, args, nargs, now);
+    irq_restore(state);
+
+    /* records stored before the thread was started are written on start */
+    if (_pid != KERNEL_PID_UNDEF) {
+        thread_flags_set((thread_t *)sched_threads[_pid], LOG_DEFERRED_FLAG);
+    }
+}
+
+static unsigned _get(char *record)
+{
+    unsigned state = irq_disable();
+    unsigned len = 0;
+
+    if (!ringbuffer_empty(&_rb)) {
+        len = ringbuffer_get(&_rb, record, HDR_LEN);
+        len += ringbuffer_get(&_rb, &record[HDR_LEN], 4 * (uint8_t)record[9]);
+    }
+    irq_restore(state);
+    return len;
+}
+
+static void *_log_deferred_thread(void *arg)
+{
+    static const char hex[] = "0123456789abcdef";
+    char record[RECORD_LEN_MAX];
+    char line[3 + (2 * RECORD_LEN_MAX)] = "~L";
+
+    (void)arg;
+
+    while (1) {
+        unsigned len = _get(record);
+
+        if (len == 0) {
+            thread_flags_wait_any(LOG_DEFERRED_FLAG);
+            continue;
+        }
+        for (unsigned i = 0; i < len; i++) {
+            line[2 + (2 * i)] = hex[(record[i] >> 4) & 0xf];
+            line[3 + (2 * i)] = hex[record[i] & 0xf];
+        }
+        line[2 + (2 * len)] = '\0';
+        puts(line);
+    }
+
+    return NULL;
+}
+
+kernel_pid_t log_deferred_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), LOG_DEFERRED_PRIO,
+                             THREAD_CREATE_STACKTEST, _log_deferred_thread,
+                             NULL, "log_deferred");
+    }
+
+    return _pid;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_deferred Deferred binary log module
+ * @ingroup     sys
+ * @brief       Log records that are formatted on the host
+ *
+ * A log call does not format anything on the device. It stores the address
+ * of its format string, a timestamp and its arguments as a binary record in
+ * a RAM ring buffer and returns. A low priority thread writes the records to
+ * stdio, in whatever backend that uses (UART, RTT, ...), as lines of the form
+ * `~L<hex encoded record>`. Other output passes through unchanged.
+ *
+ * The format strings are placed into the `.riot_log_fmt` section of the
+ * ELF file. `dist/tools/log_deferred/decode.py` looks them up there and
+ * formats the records on the host:
+ *
+ *     make term | dist/tools/log_deferred/decode.py bin/<board>/<app>.elf
+ *
+ * Limitations:
+ * - at most @ref LOG_DEFERRED_ARGS_MAX arguments are recorded per call
+ * - every argument is stored as 32-bit integer, so 64-bit and floating point
+ *   values are not supported
+ * - `%s` arguments are looked up in the ELF file as well, so they must point
+ *   to constant strings
+ * - records that do not fit into the ring buffer are dropped and reported as
+ *   such
+ *
+ * @{
+ *
+ * @file
+ * @brief       log_module header
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer holding the records in bytes
+ */
+#ifndef LOG_DEFERRED_BUFSIZE
+#define LOG_DEFERRED_BUFSIZE    (512U)
+#endif
+
+/**
+ * @brief   Priority of the thread writing out the records
+ */
+#ifndef LOG_DEFERRED_PRIO
+#define LOG_DEFERRED_PRIO       (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the thread writing out the records
+ */
+#ifndef LOG_DEFERRED_STACKSIZE
+#define LOG_DEFERRED_STACKSIZE  (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Maximum number of arguments of one log call
+ */
+#define LOG_DEFERRED_ARGS_MAX   (8U)
+
+/**
+ * @brief   Section the format strings are placed in
+ */
+#define LOG_DEFERRED_SECTION    ".riot_log_fmt"
+
+/**
+ * @name    Helpers to store the arguments of a log call
+ * @{
+ */
+#define _LOG_DEFERRED_NARGS(...) \
+    _LOG_DEFERRED_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _LOG_DEFERRED_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define _LOG_DEFERRED_CAT(a, b)     _LOG_DEFERRED_CAT_(a, b)
+#define _LOG_DEFERRED_CAT_(a, b)    a ## b
+#define _LOG_DEFERRED_ARG(x)        ((uint32_t)(uintptr_t)(x))
+#define _LOG_DEFERRED_ARGS_0()
+#define _LOG_DEFERRED_ARGS_1(a)     , _LOG_DEFERRED_ARG(a)
+#define _LOG_DEFERRED_ARGS_2(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_1(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_3(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_2(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_4(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_3(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_5(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_4(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_6(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_5(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_7(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_6(__VA_ARGS__)
+#define _LOG_DEFERRED_ARGS_8(a, ...) \
+    , _LOG_DEFERRED_ARG(a) _LOG_DEFERRED_ARGS_7(__VA_ARGS__)
+/** @} */
+
+/**
+ * @brief log_write overridden function
+ *
+ * The format string must be a string literal.
+ *
+ * @param[in] level     level of the message
+ * @param[in] format    format string of the message
+ */
+#define log_write(level, format, ...) do { \
+        static const char _log_fmt[] \
+            __attribute__((section(LOG_DEFERRED_SECTION))) = format; \
+        const uint32_t _log_args[] = { \
+            0 _LOG_DEFERRED_CAT(_LOG_DEFERRED_ARGS_, \
+                                _LOG_DEFERRED_NARGS(__VA_ARGS__))(__VA_ARGS__) \
+        }; \
+        log_deferred_write((level), _log_fmt, &_log_args[1], \
+                           _LOG_DEFERRED_NARGS(__VA_ARGS__)); \
+    } while (0)
+
+/**
+ * @brief   Store a log record
+ *
+ * Use log_write() instead, which places the format string where the decoder
+ * finds it.
+ *
+ * @param[in] level     level of the message
+ * @param[in] format    format string of the message
+ * @param[in] args      arguments of the message
+ * @param[in] nargs     number of elements in @p args
+ */
+void log_deferred_write(unsigned level, const char *format,
+                        const uint32_t *args, unsigned nargs);
+
+/**
+ * @brief   Start the thread writing out the records
+ *
+ * Records that are stored before are written out once it runs.
+ *
+ * @return  PID of the thread
+ */
+kernel_pid_t log_deferred_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+/**@}*/
+#endif /* LOG_MODULE_H */
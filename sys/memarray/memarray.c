@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_memarray
+ * @{
+ *
+ * @file
+ * @brief       Memory pool of fixed sized elements implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "assert.h"
+#include "memarray.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void memarray_init(memarray_t *mem, void *data, size_t size, size_t num)
+{
+    assert((mem != NULL) && (data != NULL) && (size >= sizeof(void *)));
+
+    mem->free_data = NULL;
+    mem->size = size;
+    mem->num = num;
+    mem->used = 0;
+    mem->used_max = 0;
+    mem->failed = 0;
+
+    /* chain from the back, so elements are handed out in array order */
+    for (size_t i = num; i > 0; i--) {
+        void **element = (void **)((uint8_t *)data + ((i - 1) * size));
+        *element = mem->free_data;
+        mem->free_data = element;
+    }
+}
+
+void *memarray_alloc(memarray_t *mem)
+{
+    void **element = mem->free_data;
+
+    if (element == NULL) {
+        DEBUG("memarray: pool %p is exhausted\n", (void *)mem);
+        mem->failed++;
+        return NULL;
+    }
+    mem->free_data = *element;
+    if (++mem->used > mem->used_max) {
+        mem->used_max = mem->used;
+    }
+    return element;
+}
+
+void memarray_free(memarray_t *mem, void *ptr)
+{
+    assert((ptr != NULL) && (mem->used > 0));
+
+    *((void **)ptr) = mem->free_data;
+    mem->free_data = ptr;
+    mem->used--;
+}
@@ -20,6 +20,7 @@
 
 #include <errno.h>
 #include "net/gcoap.h"
+#include "nanocoap_opt.h"
 #include "random.h"
 #include "thread.h"
 
@@ -30,11 +31,16 @@
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              const gcoap_block_t *block1,
+                              const gcoap_block_t *block2);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           const gcoap_block_t *block1,
+                           const gcoap_block_t *block2);
 static void _expire_request(gcoap_request_memo_t *memo);
+static void _handle_empty(coap_pkt_t *pdu);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
 static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
@@ -44,6 +50,10 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static gcoap_observe_memo_t *_find_obs_memo_observer(const sock_udp_ep_t *observer,
+                                                     const coap_resource_t *resource);
+static size_t _block2_send(void);
+static void _block2_resp_handler(unsigned req_state, coap_pkt_t *pdu);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -64,6 +74,15 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static sock_udp_t _sock;
 
+/* State of the client Block2 transfer */
+static struct {
+    sock_udp_ep_t remote;               /* server */
+    char path[NANOCOAP_URL_MAX];        /* resource path */
+    gcoap_block_handler_t handler;      /* callback for each block; transfer
+                                         * unused if NULL */
+    gcoap_block_t block;                /* next block to request */
+} _block2_xfer;
+
 
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
@@ -136,7 +155,13 @@ static void _listen(sock_udp_t *sock)
     }
 
     if (coap_get_code(&pdu) == COAP_CODE_EMPTY) {
-        DEBUG("gcoap: empty messages not handled yet\n");
+        if ((coap_get_type(&pdu) == COAP_TYPE_ACK) ||
+                (coap_get_type(&pdu) == COAP_TYPE_RST)) {
+            _handle_empty(&pdu);
+        }
+        else {
+            DEBUG("gcoap: empty messages not handled yet\n");
+        }
         return;
 
     /* incoming request */
@@ -156,11 +181,25 @@ static void _listen(sock_udp_t *sock)
 
     /* incoming response */
     else {
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            /* acknowledge separate response */
+            coap_hdr_t ack;
+
+            coap_build_hdr(&ack, COAP_TYPE_ACK, NULL, 0, COAP_CODE_EMPTY, 0);
+            ack.id = pdu.hdr->id;
+            sock_udp_send(sock, &ack, sizeof(ack), &remote);
+        }
         _find_req_memo(&memo, &pdu, buf, sizeof(buf));
         if (memo) {
+            gcoap_resp_handler_t resp_handler = memo->resp_handler;
+            unsigned state = memo->state;
+
             xtimer_remove(&memo->response_timer);
-            memo->resp_handler(memo->state, &pdu);
+            /* release memo first, so the handler can send a follow-up
+             * request, e.g. for the next block */
+            memo->msg   = NULL;
             memo->state = GCOAP_MEMO_UNUSED;
+            resp_handler(state, &pdu);
         }
     }
 }
@@ -179,24 +218,23 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     gcoap_listener_t *listener;
     sock_udp_ep_t *observer    = NULL;
     gcoap_observe_memo_t *memo = NULL;
-    gcoap_observe_memo_t *resource_memo = NULL;
 
     _find_resource(pdu, &resource, &listener);
     if (resource == NULL) {
         return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
     }
-    else {
-        /* used below to ensure a memo not already recorded for the resource */
-        _find_obs_memo_resource(&resource_memo, resource);
-    }
 
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        int obs_slot   = _find_observer(&observer, remote);
+
+        if ((memo == NULL) && (observer != NULL)) {
+            /* a new token of an observer replaces its old registration */
+            memo = _find_obs_memo_observer(observer, resource);
+        }
         /* record observe memo */
         if (memo == NULL) {
-            if (empty_slot >= 0 && resource_memo == NULL) {
-
-                int obs_slot = _find_observer(&observer, remote);
+            if (empty_slot >= 0) {
                 /* cache new observer */
                 if (observer == NULL) {
                     if (obs_slot >= 0) {
@@ -216,7 +254,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
             }
         }
         if (memo != NULL) {
-            memo->observer  = observer;
+            memo->observer  = (observer != NULL) ? observer : memo->observer;
             memo->resource  = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
@@ -262,6 +300,9 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
+ * Resources of a listener are expected in alphabetical order of their path, so
+ * each listener is searched with a binary search.
+ *
  * param[out] resource_ptr -- found resource
  * param[out] listener_ptr -- listener for found resource
  */
@@ -269,29 +310,30 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr)
 {
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    const char *path = (char *)&pdu->url[0];
 
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
     while (listener) {
-        coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-            if (! (resource->methods & method_flag)) {
-                continue;
-            }
+        coap_resource_t *resources = listener->resources;
+        size_t lo = 0, hi = listener->resources_len;
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
+        /* find first resource with a path not less than the requested one */
+        while (lo < hi) {
+            size_t mid = lo + ((hi - lo) / 2);
+
+            if (strcmp(resources[mid].path, path) < 0) {
+                lo = mid + 1;
             }
             else {
-                *resource_ptr = resource;
+                hi = mid;
+            }
+        }
+        /* several resources may share a path for different methods */
+        for (; (lo < listener->resources_len) &&
+               (strcmp(resources[lo].path, path) == 0); lo++) {
+            if (resources[lo].methods & method_flag) {
+                *resource_ptr = &resources[lo];
                 *listener_ptr = listener;
                 return;
             }
@@ -308,9 +350,11 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
  *
  * Returns the size of the PDU within the buffer, or < 0 on error.
  */
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           const gcoap_block_t *block1,
+                           const gcoap_block_t *block2)
 {
-    ssize_t hdr_len = _write_options(pdu, buf, len);
+    ssize_t hdr_len = _write_options(pdu, buf, len, block1, block2);
     DEBUG("gcoap: header length: %i\n", (int)hdr_len);
 
     if (hdr_len > 0) {
@@ -368,13 +412,71 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     }
 }
 
+/*
+ * Finds the memo for an outstanding confirmable request within the
+ * _coap_state.open_reqs array. Matches on message ID.
+ */
+static gcoap_request_memo_t *_find_con_memo(coap_pkt_t *src_pdu)
+{
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+        coap_hdr_t *memo_hdr = (coap_hdr_t *)&memo->hdr_buf[0];
+
+        if ((memo->state == GCOAP_MEMO_WAIT) && (memo->msg != NULL) &&
+                (memo_hdr->id == src_pdu->hdr->id)) {
+            return memo;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Handles an empty ACK or a reset for a confirmable request.
+ */
+static void _handle_empty(coap_pkt_t *pdu)
+{
+    gcoap_request_memo_t *memo = _find_con_memo(pdu);
+
+    if (memo == NULL) {
+        DEBUG("gcoap: empty message for no open request\n");
+        return;
+    }
+    xtimer_remove(&memo->response_timer);
+    memo->msg = NULL;
+    if (coap_get_type(pdu) == COAP_TYPE_RST) {
+        gcoap_resp_handler_t resp_handler = memo->resp_handler;
+        coap_pkt_t req;
+
+        req.hdr = (coap_hdr_t *)&memo->hdr_buf[0];   /* for reference */
+        memo->state = GCOAP_MEMO_UNUSED;
+        resp_handler(GCOAP_MEMO_ERR, &req);
+    }
+    else if (GCOAP_NON_TIMEOUT > 0) {
+        /* acknowledged; wait for the separate response */
+        xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
+                       &memo->timeout_msg, _pid);
+    }
+}
+
 /* Calls handler callback on receipt of a timeout message. */
 static void _expire_request(gcoap_request_memo_t *memo)
 {
     coap_pkt_t req;
 
     DEBUG("coap: received timeout message\n");
-    if (memo->state == GCOAP_MEMO_WAIT) {
+    if ((memo->state == GCOAP_MEMO_WAIT) && (memo->msg != NULL) &&
+            (memo->send_limit > 0)) {
+        /* retransmit unacknowledged confirmable request */
+        memo->send_limit--;
+        memo->send_timeout <<= 1;
+        if (sock_udp_send(&_sock, memo->msg, memo->msg_len, &memo->remote) <= 0) {
+            DEBUG("gcoap: retransmission failed\n");
+        }
+        xtimer_set_msg(&memo->response_timer, memo->send_timeout,
+                       &memo->timeout_msg, _pid);
+    }
+    else if (memo->state == GCOAP_MEMO_WAIT) {
+        memo->msg   = NULL;
         memo->state = GCOAP_MEMO_TIMEOUT;
         /* Pass response to handler */
         if (memo->resp_handler) {
@@ -390,42 +492,123 @@ static void _expire_request(gcoap_request_memo_t *memo)
 }
 
 /*
- * Handler for /.well-known/core. Lists registered handlers, except for
+ * Writes the link format list of registered resources, except for
  * /.well-known/core itself.
+ *
+ * Returns the length of the list written to buf. Stops at the last resource
+ * fitting into buf.
  */
-static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len)
+static size_t _write_link_format(uint8_t *buf, size_t len)
 {
-   /* write header */
-    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
-
     /* skip the first listener, gcoap itself */
     gcoap_listener_t *listener = _coap_state.listeners->next;
-
-    /* write payload */
-    uint8_t *bufpos            = pdu->payload;
+    uint8_t *bufpos = buf;
 
     while (listener) {
         coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
+        for (size_t i = 0; i < listener->resources_len; i++, resource++) {
+            unsigned url_len = strlen(resource->path);
+
             /* Don't overwrite buffer if paths are too long. */
-            if (bufpos + strlen(resource->path) + 3 > buf + len) {
-               break;
+            if (bufpos + url_len + 3 > buf + len) {
+                return bufpos - buf;
             }
-            if (i) {
+            if (bufpos > buf) {
                 *bufpos++ = ',';
-                resource++;
             }
             *bufpos++ = '<';
-            unsigned url_len = strlen(resource->path);
             memcpy(bufpos, resource->path, url_len);
             bufpos   += url_len;
             *bufpos++ = '>';
         }
         listener = listener->next;
     }
+    return bufpos - buf;
+}
+
+#if GCOAP_LINK_CACHE_SIZE
+static uint8_t _link_cache[GCOAP_LINK_CACHE_SIZE];
+/* length of _link_cache, or -1 if it must be rebuilt */
+static int _link_cache_len = -1;
+#endif
+
+/*
+ * Handler for /.well-known/core. Lists registered handlers, except for
+ * /.well-known/core itself.
+ */
+static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len)
+{
+    size_t payload_len;
+
+   /* write header */
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+
+    /* write payload */
+    len -= pdu->payload - buf;
+#if GCOAP_LINK_CACHE_SIZE
+    if (_link_cache_len < 0) {
+        _link_cache_len = _write_link_format(_link_cache, sizeof(_link_cache));
+    }
+    if ((size_t)_link_cache_len <= len) {
+        payload_len = _link_cache_len;
+        memcpy(pdu->payload, _link_cache, payload_len);
+    }
+    else {
+        payload_len = _write_link_format(pdu->payload, len);
+    }
+#else
+    payload_len = _write_link_format(pdu->payload, len);
+#endif
 
     /* response content */
-    return gcoap_finish(pdu, bufpos - pdu->payload, COAP_FORMAT_LINK);
+    return gcoap_finish(pdu, payload_len, COAP_FORMAT_LINK);
+}
+
+/*
+ * Writes a Block1 or Block2 option.
+ *
+ * Returns length of the option.
+ */
+static size_t _put_block_option(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                                const gcoap_block_t *block)
+{
+    uint32_t val = (block->num << 4) | (block->more ? 0x8 : 0) | block->szx;
+    uint8_t bytes[3];
+    size_t olen = 0;
+
+    /* write the value with as few bytes as possible */
+    for (uint32_t tmp = val; tmp; tmp >>= 8) {
+        olen++;
+    }
+    for (size_t i = 0; i < olen; i++) {
+        bytes[i] = (uint8_t)(val >> ((olen - 1 - i) * 8));
+    }
+    return coap_put_option(buf, lastonum, onum, bytes, olen);
+}
+
+/*
+ * Finds a Block1 or Block2 option in a parsed PDU.
+ *
+ * Returns 1 if found, 0 if not found, or -EBADMSG on a malformed option.
+ */
+static int _get_block_option(coap_pkt_t *pdu, unsigned onum,
+                             gcoap_block_t *block)
+{
+    coap_opt_t opt;
+    uint32_t val;
+    int res = coap_opt_find(pdu, onum, &opt);
+
+    if (res <= 0) {
+        return res;
+    }
+    val = coap_opt_uint(&opt);
+    if ((opt.len > 3) || ((val & 0x7) > GCOAP_BLOCK_SZX_MAX)) {
+        return -EBADMSG;
+    }
+    block->num  = val >> 4;
+    block->more = (val & 0x8) != 0;
+    block->szx  = val & 0x7;
+    return 1;
 }
 
 /*
@@ -433,7 +616,9 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
  *
  * Returns length of header + options, or -EINVAL on illegal path.
  */
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              const gcoap_block_t *block1,
+                              const gcoap_block_t *block2)
 {
     uint8_t last_optnum = 0;
     (void)len;
@@ -472,8 +657,18 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     /* Content-Format */
     if (pdu->content_type != COAP_FORMAT_NONE) {
         bufpos += coap_put_option_ct(bufpos, last_optnum, pdu->content_type);
-        /* uncomment when add an option after Content-Format */
-        /* last_optnum = COAP_OPT_CONTENT_FORMAT; */
+        last_optnum = COAP_OPT_CONTENT_FORMAT;
+    }
+
+    /* Block2 and Block1 */
+    if (block2 != NULL) {
+        bufpos += _put_block_option(bufpos, last_optnum, GCOAP_OPT_BLOCK2, block2);
+        last_optnum = GCOAP_OPT_BLOCK2;
+    }
+    if (block1 != NULL) {
+        bufpos += _put_block_option(bufpos, last_optnum, GCOAP_OPT_BLOCK1, block1);
+        /* uncomment when add an option after Block1 */
+        /* last_optnum = GCOAP_OPT_BLOCK1; */
     }
 
     /* write payload marker */
@@ -585,6 +780,23 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
     }
 }
 
+/*
+ * Find registered observe memo of an observer for a resource.
+ *
+ * return Registered observe memo, or NULL if not found
+ */
+static gcoap_observe_memo_t *_find_obs_memo_observer(const sock_udp_ep_t *observer,
+                                                     const coap_resource_t *resource)
+{
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        if (_coap_state.observe_memos[i].observer == observer
+                && _coap_state.observe_memos[i].resource == resource) {
+            return &_coap_state.observe_memos[i];
+        }
+    }
+    return NULL;
+}
+
 /*
  * gcoap interface functions
  */
@@ -618,6 +830,10 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+#if GCOAP_LINK_CACHE_SIZE
+    /* rebuild /.well-known/core on next request */
+    _link_cache_len = -1;
+#endif
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
@@ -664,13 +880,20 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
 }
 
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format)
+{
+    return gcoap_block_finish(pdu, payload_len, format, NULL, NULL);
+}
+
+ssize_t gcoap_block_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           const gcoap_block_t *block1,
+                           const gcoap_block_t *block2)
 {
     /* reconstruct full PDU buffer length */
     size_t len = pdu->payload_len + (pdu->payload - (uint8_t *)pdu->hdr);
 
     pdu->content_type = format;
     pdu->payload_len  = payload_len;
-    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len);
+    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len, block1, block2);
 }
 
 size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
@@ -692,27 +915,59 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                        gcoap_resp_handler_t resp_handler)
 {
     gcoap_request_memo_t *memo = NULL;
+    coap_pkt_t req;
+    bool con;
+    unsigned nstart = 0;
     assert(remote != NULL);
     assert(resp_handler != NULL);
 
+    req.hdr = (coap_hdr_t *)buf;
+    con = (coap_get_type(&req) == COAP_TYPE_CON);
+
     /* Find empty slot in list of open requests. */
     mutex_lock(&_coap_state.lock);
     for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-            memo = &_coap_state.open_reqs[i];
-            memo->state = GCOAP_MEMO_WAIT;
-            break;
+        gcoap_request_memo_t *open_req = &_coap_state.open_reqs[i];
+
+        if (open_req->state == GCOAP_MEMO_UNUSED) {
+            if (memo == NULL) {
+                memo = open_req;
+            }
+        }
+        else if (con && (open_req->msg != NULL) &&
+                 (open_req->remote.port == remote->port) &&
+                 (memcmp(&open_req->remote.addr, &remote->addr,
+                         sizeof(remote->addr)) == 0)) {
+            nstart++;
         }
     }
+    if (nstart >= GCOAP_NSTART) {
+        memo = NULL;
+    }
+    if (memo) {
+        memo->state = GCOAP_MEMO_WAIT;
+        memo->msg   = NULL;
+    }
     mutex_unlock(&_coap_state.lock);
 
     if (memo) {
         memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
         memo->resp_handler = resp_handler;
+        memo->remote       = *remote;
 
         size_t res = sock_udp_send(&_sock, buf, len, remote);
-
-        if (res && (GCOAP_NON_TIMEOUT > 0)) {
+        uint32_t timeout = GCOAP_NON_TIMEOUT;
+
+        if (res && con) {
+            /* keep the request for retransmission */
+            memo->msg          = buf;
+            memo->msg_len      = len;
+            memo->send_limit   = GCOAP_MAX_RETRANSMIT;
+            memo->send_timeout = GCOAP_ACK_TIMEOUT +
+                                 random_uint32_range(0, GCOAP_ACK_TIMEOUT_RANDOM);
+            timeout            = memo->send_timeout;
+        }
+        if (res && (timeout > 0)) {
             /* interrupt sock listening (to set a listen timeout) */
             msg_t mbox_msg;
             mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
@@ -721,10 +976,11 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                 /* start response wait timer */
                 memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
                 memo->timeout_msg.content.ptr = (char *)memo;
-                xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
+                xtimer_set_msg(&memo->response_timer, timeout,
                                                       &memo->timeout_msg, _pid);
             }
             else {
+                memo->msg   = NULL;
                 memo->state = GCOAP_MEMO_UNUSED;
                 DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
             }
@@ -795,16 +1051,163 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
-    gcoap_observe_memo_t *memo = NULL;
+    const coap_hdr_t *hdr = (const coap_hdr_t *)buf;
+    size_t hdr_len = sizeof(coap_hdr_t) + (hdr->ver_t_tkl & 0xf);
+    size_t res = 0;
+    bool first = true;
 
-    _find_obs_memo_resource(&memo, resource);
+    if (len < hdr_len) {
+        return 0;
+    }
+    /* the options and the payload are shared by all observers, only the
+     * header and the token differ */
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *memo = &_coap_state.observe_memos[i];
+        coap_hdr_t obs_hdr = *hdr;
+        struct iovec vector[] = {
+            { .iov_base = &obs_hdr, .iov_len = sizeof(obs_hdr) },
+            { .iov_base = memo->token, .iov_len = memo->token_len },
+            { .iov_base = (void *)(buf + hdr_len), .iov_len = len - hdr_len },
+        };
+
+        if ((memo->observer == NULL) || (memo->resource != resource)) {
+            continue;
+        }
+        obs_hdr.ver_t_tkl = (hdr->ver_t_tkl & 0xf0) | memo->token_len;
+        if (!first) {
+            /* the first observer uses the message ID of the notification */
+            uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+            obs_hdr.id = byteorder_htons(msgid).u16;
+        }
+        first = false;
+        if (sock_udp_sendv(&_sock, vector, sizeof(vector) / sizeof(vector[0]),
+                           memo->observer) > 0) {
+            res = len;
+        }
+    }
+    return res;
+}
 
-    if (memo) {
-        return sock_udp_send(&_sock, buf, len, memo->observer);
+int gcoap_get_block1(coap_pkt_t *pdu, gcoap_block_t *block)
+{
+    return _get_block_option(pdu, GCOAP_OPT_BLOCK1, block);
+}
+
+int gcoap_get_block2(coap_pkt_t *pdu, gcoap_block_t *block)
+{
+    return _get_block_option(pdu, GCOAP_OPT_BLOCK2, block);
+}
+
+int gcoap_block2_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
+                      gcoap_block_t *block)
+{
+    size_t avail = len - (coap_get_total_hdr_len(pdu) + GCOAP_RESP_OPTIONS_BUF);
+    int res;
+
+    /* read the option before the response overwrites the request */
+    res = gcoap_get_block2(pdu, block);
+    if (res < 0) {
+        return res;
+    }
+    else if (res == 0) {
+        block->num = 0;
+        block->szx = GCOAP_BLOCK_SZX_MAX;
+    }
+    block->more = false;
+    /* use a smaller block size if the requested one does not fit, but keep
+     * the offset of the requested block */
+    while ((block->szx > 0) && (gcoap_block_size(block) > avail)) {
+        block->szx--;
+        block->num <<= 1;
+    }
+    return gcoap_resp_init(pdu, buf, len, code);
+}
+
+/*
+ * Requests the next block of the client Block2 transfer.
+ */
+static size_t _block2_send(void)
+{
+    coap_pkt_t pdu;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    ssize_t len;
+
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET,
+                       _block2_xfer.path) < 0) {
+        return 0;
+    }
+    len = gcoap_block_finish(&pdu, 0, COAP_FORMAT_NONE, NULL,
+                             &_block2_xfer.block);
+    if (len < 0) {
+        return 0;
+    }
+    return gcoap_req_send2(buf, len, &_block2_xfer.remote, _block2_resp_handler);
+}
+
+/*
+ * Handles a response of the client Block2 transfer and requests the next
+ * block right away from the gcoap thread.
+ */
+static void _block2_resp_handler(unsigned req_state, coap_pkt_t *pdu)
+{
+    gcoap_block_handler_t handler = _block2_xfer.handler;
+    gcoap_block_t block = _block2_xfer.block;
+
+    if ((req_state == GCOAP_MEMO_TIMEOUT) || (req_state == GCOAP_MEMO_ERR)) {
+        _block2_xfer.handler = NULL;
+        handler(req_state, pdu, &block);
+        return;
+    }
+    if ((coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) ||
+        (gcoap_get_block2(pdu, &block) <= 0)) {
+        /* error response or whole representation in one response */
+        block.more = false;
+    }
+    if (block.more) {
+        /* continue with the block size the server chose */
+        _block2_xfer.block.num  = block.num + 1;
+        _block2_xfer.block.szx  = block.szx;
+        _block2_xfer.block.more = false;
     }
     else {
+        _block2_xfer.handler = NULL;
+    }
+    handler(req_state, pdu, &block);
+    if (block.more && (_block2_send() == 0)) {
+        DEBUG("gcoap: can't request next block\n");
+        _block2_xfer.handler = NULL;
+        handler(GCOAP_MEMO_ERR, pdu, &_block2_xfer.block);
+    }
+}
+
+size_t gcoap_block2_get(const sock_udp_ep_t *remote, char *path,
+                        gcoap_block_handler_t handler)
+{
+    size_t res;
+
+    assert(handler != NULL);
+    if (strlen(path) >= sizeof(_block2_xfer.path)) {
         return 0;
     }
+    mutex_lock(&_coap_state.lock);
+    if (_block2_xfer.handler != NULL) {
+        mutex_unlock(&_coap_state.lock);
+        DEBUG("gcoap: block transfer already in progress\n");
+        return 0;
+    }
+    _block2_xfer.handler = handler;
+    mutex_unlock(&_coap_state.lock);
+
+    _block2_xfer.remote = *remote;
+    strcpy(_block2_xfer.path, path);
+    _block2_xfer.block.num  = 0;
+    _block2_xfer.block.szx  = GCOAP_BLOCK_SZX;
+    _block2_xfer.block.more = false;
+    res = _block2_send();
+    if (res == 0) {
+        _block2_xfer.handler = NULL;
+    }
+    return res;
 }
 
 uint8_t gcoap_op_state(void)
@@ -15,7 +15,9 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 
 #include "net/sock/udp.h"
@@ -25,9 +27,117 @@
 #include "byteorder.h"
 #endif
 
+#ifdef MODULE_SOCK_DNS_CACHE
+#include "mutex.h"
+#include "xtimer.h"
+#endif
+
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+/* result of a reply without matching answer */
+#define DNS_NO_ANSWER       (-1)
+
+#define DNS_RCODE_MASK      (0x000f)
+#define DNS_RCODE_NXDOMAIN  (3)
+
+#ifdef MODULE_SOCK_DNS_CACHE
+typedef struct {
+    uint32_t expires;                       /* in seconds */
+    uint32_t used;                          /* for LRU eviction */
+    int16_t res;                            /* address length or error */
+    int8_t family;                          /* family of the query */
+    uint8_t addr[16];
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];   /* empty if unused */
+} _cache_entry_t;
+
+static _cache_entry_t _cache[SOCK_DNS_CACHE_SIZE];
+static uint32_t _cache_used;
+static mutex_t _cache_lock = MUTEX_INIT;
+
+static uint32_t _now_sec(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static bool _cache_match(const _cache_entry_t *entry, const char *domain_name,
+                         int family)
+{
+    return (entry->name[0] != '\0') && (entry->family == family) &&
+           (strcasecmp(entry->name, domain_name) == 0);
+}
+
+static bool _cache_free(const _cache_entry_t *entry, uint32_t now)
+{
+    return (entry->name[0] == '\0') || ((int32_t)(entry->expires - now) <= 0);
+}
+
+static int _cache_get(const char *domain_name, void *addr_out, int family)
+{
+    uint32_t now = _now_sec();
+    int res = 0;
+
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *entry = &_cache[i];
+
+        if (!_cache_match(entry, domain_name, family)) {
+            continue;
+        }
+        if (_cache_free(entry, now)) {
+            entry->name[0] = '\0';
+            break;
+        }
+        entry->used = ++_cache_used;
+        if (entry->res > 0) {
+            memcpy(addr_out, entry->addr, entry->res);
+        }
+        res = entry->res;
+        break;
+    }
+    mutex_unlock(&_cache_lock);
+    return res;
+}
+
+static void _cache_put(const char *domain_name, const void *addr, int res,
+                       int family, uint32_t ttl)
+{
+    uint32_t now = _now_sec();
+    _cache_entry_t *entry = &_cache[0];
+
+    if (ttl == 0) {
+        return;
+    }
+    if (ttl > SOCK_DNS_CACHE_TTL_MAX) {
+        ttl = SOCK_DNS_CACHE_TTL_MAX;
+    }
+    mutex_lock(&_cache_lock);
+    /* replace the same name or an unused, an expired or the least recently
+     * used entry, in that order */
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *tmp = &_cache[i];
+
+        if (_cache_match(tmp, domain_name, family)) {
+            entry = tmp;
+            break;
+        }
+        if (!_cache_free(entry, now) &&
+            (_cache_free(tmp, now) || ((int32_t)(tmp->used - entry->used) < 0))) {
+            entry = tmp;
+        }
+    }
+    strcpy(entry->name, domain_name);
+    entry->family = family;
+    entry->res = res;
+    if (res > 0) {
+        memcpy(entry->addr, addr, res);
+    }
+    entry->expires = now + ttl;
+    entry->used = ++_cache_used;
+    mutex_unlock(&_cache_lock);
+}
+#endif
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -85,10 +195,26 @@ static size_t _skip_hostname(uint8_t *buf)
     return (bufpos - buf + 1);
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+static uint32_t _get_long(uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return _tmp;
+}
+
+static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family,
+                            uint32_t *ttl)
 {
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     uint8_t *bufpos = buf + sizeof(*hdr);
+    unsigned rcode = ntohs(hdr->flags) & DNS_RCODE_MASK;
+
+    /* only cache answers that say that a name does not exist, not failures
+     * of the server */
+    if ((rcode != 0) && (rcode != DNS_RCODE_NXDOMAIN)) {
+        return -EBADMSG;
+    }
+    *ttl = SOCK_DNS_CACHE_NEG_TTL;
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
@@ -102,7 +228,8 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         bufpos += 2;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += 2;
-        bufpos += 4; /* skip ttl */
+        uint32_t _ttl = ntohl(_get_long(bufpos));
+        bufpos += 4;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         bufpos += 2;
@@ -121,21 +248,16 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        /* TTL is a signed value, see RFC 2181, section 8 */
+        *ttl = (_ttl & 0x80000000) ? 0 : _ttl;
         return addrlen;
     }
 
-    return -1;
+    return DNS_NO_ANSWER;
 }
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
+static size_t _build_query(uint8_t *buf, const char *domain_name, int family)
 {
-    uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
-    uint8_t reply_buf[512];
-
-    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
-        return -ENOSPC;
-    }
-
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     memset(hdr, 0, sizeof(*hdr));
     hdr->id = 0; /* random? */
@@ -163,28 +285,103 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
     }
 
-    sock_udp_t sock_dns;
+    return (bufpos - buf);
+}
+
+/* sends the query for req, returns 0 if it was sent */
+static ssize_t _send_query(sock_dns_req_t *req)
+{
+    uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
+    size_t len = _build_query(buf, req->domain_name, req->family);
+    ssize_t res = sock_udp_send(&req->sock, buf, len, NULL);
+
+    return (res > 0) ? 0 : ((res < 0) ? res : -EIO);
+}
 
-    ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
-    if (res) {
-            puts("a");
-        goto out;
+/* receives and parses the reply for req, returns -EAGAIN or -ETIMEDOUT if
+ * there is no reply (yet) */
+static int _recv_reply(sock_dns_req_t *req, void *addr_out, uint32_t timeout)
+{
+    uint8_t reply_buf[512];
+    uint32_t ttl;
+    ssize_t res = sock_udp_recv(&req->sock, reply_buf, sizeof(reply_buf),
+                                timeout, NULL);
+
+    if (res < 0) {
+        return res;
     }
+    if (res <= (int)DNS_MIN_REPLY_LEN) {
+        return -EBADMSG;
+    }
+    res = _parse_dns_reply(reply_buf, res, addr_out, req->family, &ttl);
+#ifdef MODULE_SOCK_DNS_CACHE
+    if ((res > 0) || (res == DNS_NO_ANSWER)) {
+        _cache_put(req->domain_name, addr_out, res, req->family, ttl);
+    }
+#endif
+    return res;
+}
 
+int sock_dns_query_async(sock_dns_req_t *req, const char *domain_name,
+                         void *addr_out, int family)
+{
+    int res;
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+#ifdef MODULE_SOCK_DNS_CACHE
+    if ((res = _cache_get(domain_name, addr_out, family)) != 0) {
+        return res;
+    }
+#else
+    (void)addr_out;
+#endif
+    req->domain_name = domain_name;
+    req->family = family;
+    if ((res = sock_udp_create(&req->sock, NULL, &sock_dns_server, 0)) != 0) {
+        return res;
+    }
+    if ((res = _send_query(req)) != 0) {
+        sock_udp_close(&req->sock);
+        return res;
+    }
+    return -EINPROGRESS;
+}
+
+int sock_dns_query_result(sock_dns_req_t *req, void *addr_out)
+{
+    int res;
+
+    while ((res = _recv_reply(req, addr_out, 0)) == -EBADMSG) {}
+    if (res != -EAGAIN) {
+        sock_udp_close(&req->sock);
+    }
+    return res;
+}
+
+void sock_dns_query_cancel(sock_dns_req_t *req)
+{
+    sock_udp_close(&req->sock);
+}
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    sock_dns_req_t req;
+    int res = sock_dns_query_async(&req, domain_name, addr_out, family);
+
+    if (res != -EINPROGRESS) {
+        return res;
+    }
     for (int i = 0; i < SOCK_DNS_RETRIES; i++) {
-        res = sock_udp_send(&sock_dns, buf, (bufpos-buf), NULL);
-        if (res <= 0) {
+        if ((i > 0) && ((res = _send_query(&req)) != 0)) {
             continue;
         }
-        res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf), 1000000LU, NULL);
-        if ((res > 0) && (res > (int)DNS_MIN_REPLY_LEN)) {
-            if ((res = _parse_dns_reply(reply_buf, res, addr_out, family)) > 0) {
-                goto out;
-            }
+        res = _recv_reply(&req, addr_out, 1000000LU);
+        if ((res > 0) || (res == DNS_NO_ANSWER)) {
+            break;
         }
     }
-
-out:
-    sock_udp_close(&sock_dns);
+    sock_udp_close(&req.sock);
     return res;
 }
@@ -35,6 +35,7 @@
 #define PROTOCOL_VERSION    (0x01)
 
 #define PUB_FLAGS           (EMCUTE_QOS_MASK | EMCUTE_RETAIN)
+#define PUB_TIT_FLAGS       (PUB_FLAGS | EMCUTE_TIT_MASK)
 #define SUB_FLAGS           (EMCUTE_DUP | EMCUTE_QOS_MASK | EMCUTE_TIT_MASK)
 
 #define TFLAGS_RESP         (0x0001)
@@ -53,6 +54,11 @@ static emcute_sub_t *subs = NULL;
 
 static mutex_t txlock;
 
+/* asynchronous publishs waiting for their PUBACK */
+static emcute_pub_t *pubs = NULL;
+static unsigned pubs_numof = 0;
+static mutex_t publock = MUTEX_INIT;
+
 static xtimer_t timer;
 static uint16_t id_next = 0x1234;
 static volatile uint8_t waiton = 0xff;
@@ -165,6 +171,100 @@ static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
     }
 }
 
+/* writes a PUBLISH message into buf, which must hold EMCUTE_BUFSIZE bytes */
+static size_t pub_build(uint8_t *buf, uint16_t tid, uint16_t id,
+                        const void *data, size_t len, unsigned flags)
+{
+    size_t pos = set_len(buf, (len + 6));
+
+    buf[pos++] = PUBLISH;
+    buf[pos++] = flags;
+    set_u16(&buf[pos], tid);
+    pos += 2;
+    set_u16(&buf[pos], id);
+    pos += 2;
+    memcpy(&buf[pos], data, len);
+    return pos + len;
+}
+
+static emcute_pub_t *pub_remove(uint16_t id)
+{
+    emcute_pub_t **prev;
+    emcute_pub_t *pub = NULL;
+
+    mutex_lock(&publock);
+    for (prev = &pubs; *prev; prev = &(*prev)->next) {
+        if ((*prev)->id == id) {
+            pub = *prev;
+            *prev = pub->next;
+            pubs_numof--;
+            break;
+        }
+    }
+    mutex_unlock(&publock);
+    return pub;
+}
+
+static bool on_puback(void)
+{
+    emcute_pub_t *pub = pub_remove(get_u16(&rbuf[4]));
+
+    if (pub == NULL) {
+        return false;
+    }
+    pub->cb(pub, (rbuf[6] == ACCEPT) ? EMCUTE_OK : EMCUTE_REJECT);
+    return true;
+}
+
+/* retransmits asynchronous publishs whose PUBACK is overdue and fails all of
+ * them once the gateway is gone, returns the time in usec until the next
+ * retransmission is due */
+static uint32_t pub_retry(uint32_t now)
+{
+    uint32_t next = (EMCUTE_T_RETRY * US_PER_SEC);
+    emcute_pub_t *timed_out = NULL;
+    emcute_pub_t **prev;
+    int res = (gateway.port == 0) ? EMCUTE_NOGW : EMCUTE_TIMEOUT;
+
+    mutex_lock(&publock);
+    prev = &pubs;
+    while (*prev) {
+        emcute_pub_t *pub = *prev;
+        uint32_t passed = now - pub->sent;
+
+        if ((passed < (EMCUTE_T_RETRY * US_PER_SEC)) && (gateway.port != 0)) {
+            if (((EMCUTE_T_RETRY * US_PER_SEC) - passed) < next) {
+                next = (EMCUTE_T_RETRY * US_PER_SEC) - passed;
+            }
+        }
+        else if ((pub->retries >= EMCUTE_N_RETRY) || (gateway.port == 0)) {
+            *prev = pub->next;
+            pubs_numof--;
+            pub->next = timed_out;
+            timed_out = pub;
+            continue;
+        }
+        else {
+            /* the receive buffer is not in use while we are here */
+            DEBUG("[emcute] pub_retry: resending message %u\n", pub->id);
+            size_t len = pub_build(rbuf, pub->topic->id, pub->id, pub->data,
+                                   pub->len, pub->flags | EMCUTE_DUP);
+            sock_udp_send(&sock, rbuf, len, &gateway);
+            pub->sent = now;
+            pub->retries++;
+        }
+        prev = &pub->next;
+    }
+    mutex_unlock(&publock);
+
+    while (timed_out) {
+        emcute_pub_t *pub = timed_out;
+        timed_out = pub->next;
+        pub->cb(pub, res);
+    }
+    return next;
+}
+
 static void on_publish(size_t len, size_t pos)
 {
     /* make sure packet length is valid - if not, drop packet silently */
@@ -182,7 +282,7 @@ static void on_publish(size_t len, size_t pos)
 
     /* return error code in case we don't support/understand active flags. So
      * far we only understand QoS 1... */
-    if (rbuf[pos + 1] & ~(EMCUTE_QOS_1 | EMCUTE_TIT_SHORT)) {
+    if (rbuf[pos + 1] & ~(EMCUTE_QOS_1 | EMCUTE_TIT_MASK)) {
         buf[6] = REJ_NOTSUP;
         sock_udp_send(&sock, &buf, 7, &gateway);
         return;
@@ -347,7 +447,8 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
 {
     int res = EMCUTE_OK;
 
-    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+    assert(((topic->id != 0) || (flags & EMCUTE_TIT_MASK)) && data &&
+           (len > 0) && !(flags & ~PUB_TIT_FLAGS));
 
     if (gateway.port == 0) {
         return EMCUTE_NOGW;
@@ -355,24 +456,16 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     if (len >= (EMCUTE_BUFSIZE - 9)) {
         return EMCUTE_OVERFLOW;
     }
-    if (flags & EMCUTE_QOS_2) {
+    if ((flags & EMCUTE_QOS_MASK) == EMCUTE_QOS_2) {
         return EMCUTE_NOTSUP;
     }
 
     mutex_lock(&txlock);
 
-    size_t pos = set_len(tbuf, (len + 6));
-    len += (pos + 6);
-    tbuf[pos++] = PUBLISH;
-    tbuf[pos++] = flags;
-    set_u16(&tbuf[pos], topic->id);
-    pos += 2;
-    set_u16(&tbuf[pos], id_next);
     waitonid = id_next++;
-    pos += 2;
-    memcpy(&tbuf[pos], data, len);
+    len = pub_build(tbuf, topic->id, waitonid, data, len, flags);
 
-    if (flags & EMCUTE_QOS_1) {
+    if ((flags & EMCUTE_QOS_MASK) == EMCUTE_QOS_1) {
         res = syncsend(PUBACK, len, true);
     }
     else {
@@ -383,6 +476,76 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     return res;
 }
 
+int emcute_pub_async(emcute_pub_t *pub, unsigned flags)
+{
+    assert(pub && pub->topic &&
+           ((pub->topic->id != 0) || (flags & EMCUTE_TIT_MASK)) && pub->data &&
+           (pub->len > 0) && !(flags & ~PUB_TIT_FLAGS) &&
+           (((flags & EMCUTE_QOS_MASK) != EMCUTE_QOS_1) || pub->cb));
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if (pub->len >= (EMCUTE_BUFSIZE - 9)) {
+        return EMCUTE_OVERFLOW;
+    }
+    if ((flags & EMCUTE_QOS_MASK) == EMCUTE_QOS_2) {
+        return EMCUTE_NOTSUP;
+    }
+
+    mutex_lock(&txlock);
+
+    pub->id = id_next++;
+    pub->flags = flags;
+    pub->retries = 1;
+    size_t len = pub_build(tbuf, pub->topic->id, pub->id, pub->data, pub->len,
+                           flags);
+
+    if ((flags & EMCUTE_QOS_MASK) == EMCUTE_QOS_1) {
+        mutex_lock(&publock);
+        if (pubs_numof >= EMCUTE_PUB_WINDOW) {
+            mutex_unlock(&publock);
+            mutex_unlock(&txlock);
+            return EMCUTE_OVERFLOW;
+        }
+        /* add before sending, so a fast PUBACK finds its message */
+        pub->sent = xtimer_now_usec();
+        pub->next = pubs;
+        pubs = pub;
+        pubs_numof++;
+        mutex_unlock(&publock);
+    }
+    sock_udp_send(&sock, tbuf, len, &gateway);
+    mutex_unlock(&txlock);
+
+    return EMCUTE_OK;
+}
+
+int emcute_pub_m1(const sock_udp_ep_t *remote, const emcute_topic_t *topic,
+                  const void *data, size_t len, unsigned flags)
+{
+    assert(remote && topic && data && (len > 0) &&
+           !(flags & ~(EMCUTE_RETAIN | EMCUTE_TIT_MASK)));
+
+    if (len >= (EMCUTE_BUFSIZE - 9)) {
+        return EMCUTE_OVERFLOW;
+    }
+    /* normal topic IDs are only valid within a connection */
+    if ((flags & EMCUTE_TIT_MASK) == EMCUTE_TIT_NORMAL) {
+        return EMCUTE_NOTSUP;
+    }
+
+    mutex_lock(&txlock);
+
+    /* QoS -1 messages carry no message ID */
+    len = pub_build(tbuf, topic->id, 0, data, len, flags | EMCUTE_QOS_M1);
+    sock_udp_send(&sock, tbuf, len, remote);
+
+    mutex_unlock(&txlock);
+
+    return EMCUTE_OK;
+}
+
 int emcute_sub(emcute_sub_t *sub, unsigned flags)
 {
     assert(sub && (sub->cb) && (sub->topic.name) && !(flags & ~SUB_FLAGS));
@@ -556,7 +719,11 @@ void emcute_run(uint16_t port, const char *id)
                 case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
                 case REGACK:        on_ack(type, 4, 6, 2);              break;
                 case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
-                case PUBACK:        on_ack(type, 4, 6, 0);              break;
+                case PUBACK:
+                    if (!on_puback()) {
+                        on_ack(type, 4, 6, 0);
+                    }
+                    break;
                 case SUBACK:        on_ack(type, 5, 7, 3);              break;
                 case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
                 case PINGREQ:       on_pingreq(&remote);                break;
@@ -579,5 +746,11 @@ void emcute_run(uint16_t port, const char *id)
         else {
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
+        /* we can not be woken up for a new asynchronous publish, so wake up
+         * at least once per retransmission interval */
+        uint32_t t_retry = pub_retry(now);
+        if (t_retry < t_out) {
+            t_out = t_retry;
+        }
     }
 }
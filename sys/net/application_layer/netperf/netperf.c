@@ -0,0 +1,495 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       netperf implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/af.h"
+#include "net/netperf.h"
+#include "xtimer.h"
+
+#ifdef MODULE_SOCK_UDP
+#include "net/sock/udp.h"
+#endif
+#ifdef MODULE_GNRC_TCP
+#include "net/gnrc/tcp.h"
+#elif defined(MODULE_SOCK_TCP)
+#include "net/sock/tcp.h"
+#endif
+#ifdef MODULE_GNRC_ICMPV6
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "thread.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Header of the UDP datagrams
+ */
+typedef struct __attribute__((packed)) {
+    network_uint32_t seq;       /**< sequence number, starting at 0 */
+    network_uint32_t time;      /**< send time in us */
+} _udp_hdr_t;
+
+/**
+ * @brief   ICMPv6 echo identifier of netperf_ping()
+ */
+#define PING_ID                 (0x4e50)
+
+static uint8_t _buf[NETPERF_BUF_SIZE];
+
+#ifdef MODULE_SOCK_UDP
+int netperf_udp_send(const ipv6_addr_t *addr, kernel_pid_t netif,
+                     uint16_t port, size_t size, uint32_t count,
+                     uint32_t interval, netperf_tx_stats_t *stats)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = port,
+                             .netif = (uint16_t)netif };
+    _udp_hdr_t *hdr = (_udp_hdr_t *)_buf;
+
+    if ((size < sizeof(_udp_hdr_t)) || (size > sizeof(_buf))) {
+        return -EINVAL;
+    }
+    memcpy(&remote.addr, addr, sizeof(ipv6_addr_t));
+    memset(stats, 0, sizeof(*stats));
+    for (size_t i = sizeof(_udp_hdr_t); i < size; i++) {
+        _buf[i] = (uint8_t)i;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    xtimer_ticks32_t last_wakeup = xtimer_now();
+    for (uint32_t seq = 0; seq < count; seq++) {
+        hdr->seq = byteorder_htonl(seq);
+        hdr->time = byteorder_htonl(xtimer_now_usec());
+        if (sock_udp_send(NULL, _buf, size, &remote) < 0) {
+            /* most likely the stack ran out of buffers, keep counting so the
+             * receiver sees it as loss */
+            stats->failed++;
+        }
+        else {
+            stats->sent++;
+            stats->bytes += size;
+        }
+        if (interval) {
+            xtimer_periodic_wakeup(&last_wakeup, interval);
+        }
+    }
+    stats->duration = xtimer_now_usec() - start;
+    return 0;
+}
+
+int netperf_udp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = port };
+    sock_udp_t sock;
+    const _udp_hdr_t *hdr = (const _udp_hdr_t *)_buf;
+    uint32_t next_seq = 0, first = 0, last = 0;
+    int32_t last_transit = 0;
+    uint32_t jitter16 = 0;  /* jitter, scaled by 16 as in RFC 3550, A.8 */
+    int res;
+
+    if ((res = sock_udp_create(&sock, &local, NULL, 0)) < 0) {
+        return res;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    while ((res = sock_udp_recv(&sock, _buf, sizeof(_buf), timeout,
+                                NULL)) >= 0) {
+        uint32_t now = xtimer_now_usec();
+
+        if ((size_t)res < sizeof(_udp_hdr_t)) {
+            continue;
+        }
+        uint32_t seq = byteorder_ntohl(hdr->seq);
+        int32_t transit = (int32_t)(now - byteorder_ntohl(hdr->time));
+
+        if (stats->received == 0) {
+            first = now;
+        }
+        else {
+            int32_t d = transit - last_transit;
+            jitter16 += ((d < 0) ? -d : d) - ((jitter16 + 8) >> 4);
+        }
+        last_transit = transit;
+        last = now;
+
+        if (seq < next_seq) {
+            stats->reordered++;
+        }
+        else {
+            next_seq = seq + 1;
+        }
+        stats->received++;
+        stats->bytes += res;
+    }
+    sock_udp_close(&sock);
+
+    if (stats->received == 0) {
+        return -ETIMEDOUT;
+    }
+    stats->lost = (next_seq > stats->received) ?
+                  (next_seq - stats->received) : 0;
+    stats->jitter = jitter16 >> 4;
+    stats->duration = last - first;
+    return 0;
+}
+#else
+int netperf_udp_send(const ipv6_addr_t *addr, kernel_pid_t netif,
+                     uint16_t port, size_t size, uint32_t count,
+                     uint32_t interval, netperf_tx_stats_t *stats)
+{
+    (void)addr;
+    (void)netif;
+    (void)port;
+    (void)size;
+    (void)count;
+    (void)interval;
+    (void)stats;
+    return -ENOTSUP;
+}
+
+int netperf_udp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats)
+{
+    (void)port;
+    (void)timeout;
+    (void)stats;
+    return -ENOTSUP;
+}
+#endif
+
+#if defined(MODULE_GNRC_TCP) || defined(MODULE_SOCK_TCP)
+/*
+ * Minimal TCP abstraction over gnrc_tcp and sock_tcp
+ */
+#ifdef MODULE_GNRC_TCP
+typedef gnrc_tcp_tcb_t _tcp_t;
+
+static int _tcp_connect(_tcp_t *tcp, const ipv6_addr_t *addr, uint16_t port)
+{
+    gnrc_tcp_tcb_init(tcp);
+    return gnrc_tcp_open_active(tcp, AF_INET6, (const uint8_t *)addr, port, 0);
+}
+
+static ssize_t _tcp_write(_tcp_t *tcp, const void *data, size_t len)
+{
+    return gnrc_tcp_send(tcp, data, len, 0);
+}
+
+static ssize_t _tcp_read(_tcp_t *tcp, void *data, size_t len, uint32_t timeout)
+{
+    return gnrc_tcp_recv(tcp, data, len, timeout);
+}
+
+static void _tcp_close(_tcp_t *tcp)
+{
+    gnrc_tcp_close(tcp);
+}
+
+static _tcp_t *_tcp_accept(_tcp_t *pool, uint16_t port, uint32_t timeout)
+{
+    gnrc_tcp_tcb_queue_t queue;
+    gnrc_tcp_tcb_t *tcb = NULL;
+
+    if (gnrc_tcp_listen(&queue, pool, 1, AF_INET6, NULL, port) < 0) {
+        return NULL;
+    }
+    gnrc_tcp_accept(&queue, &tcb, timeout);
+    gnrc_tcp_stop_listen(&queue);
+    return tcb;
+}
+#else
+typedef sock_tcp_t _tcp_t;
+
+static int _tcp_connect(_tcp_t *tcp, const ipv6_addr_t *addr, uint16_t port)
+{
+    sock_tcp_ep_t remote = { .family = AF_INET6, .port = port };
+
+    memcpy(&remote.addr, addr, sizeof(ipv6_addr_t));
+    return sock_tcp_connect(tcp, &remote, 0, 0);
+}
+
+static ssize_t _tcp_write(_tcp_t *tcp, const void *data, size_t len)
+{
+    return sock_tcp_write(tcp, data, len);
+}
+
+static ssize_t _tcp_read(_tcp_t *tcp, void *data, size_t len, uint32_t timeout)
+{
+    return sock_tcp_read(tcp, data, len, timeout);
+}
+
+static void _tcp_close(_tcp_t *tcp)
+{
+    sock_tcp_disconnect(tcp);
+}
+
+static _tcp_t *_tcp_accept(_tcp_t *pool, uint16_t port, uint32_t timeout)
+{
+    sock_tcp_queue_t queue;
+    sock_tcp_ep_t local = { .family = AF_INET6, .port = port };
+    sock_tcp_t *sock = NULL;
+
+    if (sock_tcp_listen(&queue, &local, pool, 1, 0) < 0) {
+        return NULL;
+    }
+    if (sock_tcp_accept(&queue, &sock, timeout) < 0) {
+        sock = NULL;
+    }
+    sock_tcp_stop_listen(&queue);
+    return sock;
+}
+#endif
+
+static _tcp_t _tcp;
+
+int netperf_tcp_send(const ipv6_addr_t *addr, uint16_t port, uint32_t bytes,
+                     netperf_tx_stats_t *stats)
+{
+    int res;
+
+    memset(stats, 0, sizeof(*stats));
+    for (size_t i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)i;
+    }
+    if ((res = _tcp_connect(&_tcp, addr, port)) < 0) {
+        return res;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    while (stats->bytes < bytes) {
+        size_t len = bytes - stats->bytes;
+        if (len > sizeof(_buf)) {
+            len = sizeof(_buf);
+        }
+        ssize_t sent = _tcp_write(&_tcp, _buf, len);
+        if (sent <= 0) {
+            DEBUG("netperf: TCP write failed: %d\n", (int)sent);
+            stats->failed++;
+            break;
+        }
+        stats->sent++;
+        stats->bytes += sent;
+    }
+    stats->duration = xtimer_now_usec() - start;
+    _tcp_close(&_tcp);
+    return 0;
+}
+
+int netperf_tcp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats)
+{
+    _tcp_t *tcp;
+    ssize_t res;
+    uint32_t first = 0, last = 0;
+
+    memset(stats, 0, sizeof(*stats));
+    if ((tcp = _tcp_accept(&_tcp, port, timeout)) == NULL) {
+        return -ETIMEDOUT;
+    }
+    /* a closed connection ends with an error, or with the timeout if the
+     * stack keeps waiting for data in CLOSE_WAIT */
+    while ((res = _tcp_read(tcp, _buf, sizeof(_buf), timeout)) > 0) {
+        last = xtimer_now_usec();
+        if (stats->received == 0) {
+            first = last;
+        }
+        stats->received++;
+        stats->bytes += res;
+    }
+    _tcp_close(tcp);
+    stats->duration = last - first;
+    return 0;
+}
+#else
+int netperf_tcp_send(const ipv6_addr_t *addr, uint16_t port, uint32_t bytes,
+                     netperf_tx_stats_t *stats)
+{
+    (void)addr;
+    (void)port;
+    (void)bytes;
+    (void)stats;
+    return -ENOTSUP;
+}
+
+int netperf_tcp_recv(uint16_t port, uint32_t timeout,
+                     netperf_rx_stats_t *stats)
+{
+    (void)port;
+    (void)timeout;
+    (void)stats;
+    return -ENOTSUP;
+}
+#endif
+
+#ifdef MODULE_GNRC_ICMPV6
+static int _ping_send(const ipv6_addr_t *addr, kernel_pid_t netif,
+                      uint16_t seq, size_t size)
+{
+    gnrc_pktsnip_t *pkt;
+    network_uint32_t now = byteorder_htonl(xtimer_now_usec());
+
+    pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, PING_ID, seq, NULL, size);
+    if (pkt == NULL) {
+        return -ENOMEM;
+    }
+    /* the send time makes replies self-contained */
+    memcpy(((icmpv6_echo_t *)pkt->data) + 1, &now, sizeof(now));
+    memset(((uint8_t *)(((icmpv6_echo_t *)pkt->data) + 1)) + sizeof(now),
+           0, size - sizeof(now));
+    pkt = gnrc_ipv6_hdr_build(pkt, NULL, addr);
+    if ((pkt != NULL) && (netif != KERNEL_PID_UNDEF)) {
+        gnrc_pktsnip_t *netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+        if (netif_hdr == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return -ENOMEM;
+        }
+        ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = netif;
+        LL_PREPEND(pkt, netif_hdr);
+    }
+    if (pkt == NULL) {
+        return -ENOMEM;
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6,
+                                   GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        return -ENODEV;
+    }
+    return 0;
+}
+
+static void _ping_reply(gnrc_pktsnip_t *pkt, netperf_ping_stats_t *stats)
+{
+    uint32_t now = xtimer_now_usec();
+    gnrc_pktsnip_t *icmpv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6);
+    icmpv6_echo_t *echo;
+    network_uint32_t sent;
+
+    if ((icmpv6 == NULL) ||
+        (icmpv6->size < (sizeof(icmpv6_echo_t) + sizeof(sent)))) {
+        return;
+    }
+    echo = icmpv6->data;
+    if (byteorder_ntohs(echo->id) != PING_ID) {
+        return;
+    }
+    memcpy(&sent, echo + 1, sizeof(sent));
+
+    uint32_t rtt = now - byteorder_ntohl(sent);
+    unsigned bucket = 0;
+    while ((rtt >> bucket) && (bucket < (NETPERF_HIST_BUCKETS - 1))) {
+        bucket++;
+    }
+    stats->hist[bucket]++;
+    stats->received++;
+    stats->rtt_sum += rtt;
+    if (rtt < stats->rtt_min) {
+        stats->rtt_min = rtt;
+    }
+    if (rtt > stats->rtt_max) {
+        stats->rtt_max = rtt;
+    }
+}
+
+/* handles replies until `deadline`, or the first one that leaves no request
+ * outstanding if `flood` is set */
+static void _ping_wait(uint32_t deadline, bool flood,
+                       netperf_ping_stats_t *stats)
+{
+    msg_t msg;
+    int32_t left;
+
+    while ((left = (int32_t)(deadline - xtimer_now_usec())) > 0) {
+        if (flood && (stats->received >= stats->sent)) {
+            break;
+        }
+        if (xtimer_msg_receive_timeout(&msg, left) < 0) {
+            break;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            _ping_reply(msg.content.ptr, stats);
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+
+int netperf_ping(const ipv6_addr_t *addr, kernel_pid_t netif, size_t size,
+                 uint32_t count, uint32_t interval,
+                 netperf_ping_stats_t *stats)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(ICMPV6_ECHO_REP,
+                                                           sched_active_pid);
+    msg_t msg;
+
+    if ((size < sizeof(uint32_t)) || (size > NETPERF_BUF_SIZE)) {
+        return -EINVAL;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->rtt_min = UINT32_MAX;
+    if (gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &entry) < 0) {
+        return -ENOMEM;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    uint32_t next = start;
+    for (uint32_t i = 0; i < count; i++) {
+        if (_ping_send(addr, netif, (uint16_t)i, size) == 0) {
+            stats->sent++;
+        }
+        if (interval) {
+            next += interval;
+        }
+        else {
+            next = xtimer_now_usec() + NETPERF_PING_FLOOD_WAIT;
+        }
+        if (i + 1 < count) {
+            _ping_wait(next, (interval == 0), stats);
+        }
+    }
+    _ping_wait(xtimer_now_usec() + NETPERF_PING_TIMEOUT, true, stats);
+    stats->duration = xtimer_now_usec() - start;
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_ICMPV6, &entry);
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return 0;
+}
+#else
+int netperf_ping(const ipv6_addr_t *addr, kernel_pid_t netif, size_t size,
+                 uint32_t count, uint32_t interval,
+                 netperf_ping_stats_t *stats)
+{
+    (void)addr;
+    (void)netif;
+    (void)size;
+    (void)count;
+    (void)interval;
+    (void)stats;
+    return -ENOTSUP;
+}
+#endif
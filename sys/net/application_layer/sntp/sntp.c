@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 #include "net/sntp.h"
 #include "net/ntp_packet.h"
@@ -34,9 +36,103 @@ static int64_t _sntp_offset = 0;
 static mutex_t _sntp_mutex = MUTEX_INIT;
 static ntp_packet_t _sntp_packet;
 
+#ifdef MODULE_SNTP_CLOCK
+static uint64_t _clk_local;         /* system time of the reference point */
+static int64_t _clk_wall;           /* real time of the reference point */
+static int64_t _clk_slew;           /* offset still to apply from there */
+static uint64_t _clk_sample;        /* system time of the last sample */
+static uint64_t _clk_last;          /* last value returned, for monotonicity */
+static int32_t _clk_freq;           /* frequency correction in ppb */
+static uint8_t _clk_poll = SNTP_CLOCK_POLL_MIN;
+static bool _clk_synced;
+
+static inline int64_t _abs64(int64_t val)
+{
+    return (val < 0) ? -val : val;
+}
+
+/* part of the offset that was slewed `dt` microseconds after the reference
+ * point, must be called with _sntp_mutex locked */
+static int64_t _clk_slewed(int64_t dt)
+{
+    int64_t slew_max = (dt * SNTP_CLOCK_SLEW_PPM) / US_PER_SEC;
+
+    if (_clk_slew > slew_max) {
+        return slew_max;
+    }
+    if (_clk_slew < -slew_max) {
+        return -slew_max;
+    }
+    return _clk_slew;
+}
+
+/* real time at system time `now`, must be called with _sntp_mutex locked */
+static int64_t _clk_wall_at(uint64_t now)
+{
+    int64_t dt = (int64_t)(now - _clk_local);
+
+    return _clk_wall + dt + ((dt * _clk_freq) / 1000000000LL) + _clk_slewed(dt);
+}
+
+/* feeds a sample of the real time `wall` at system time `now` into the
+ * clock, must be called with _sntp_mutex locked */
+static void _clk_update(uint64_t now, int64_t wall)
+{
+    int64_t cur = _clk_wall_at(now);
+    int64_t theta = wall - cur;
+    int64_t interval = (int64_t)(now - _clk_sample);
+
+    _clk_sample = now;
+    if (!_clk_synced || (_abs64(theta) > SNTP_CLOCK_STEP_THRESHOLD)) {
+        DEBUG("sntp: stepping clock by %" PRId32 " us\n", (int32_t)theta);
+        _clk_local = now;
+        _clk_wall = wall;
+        _clk_slew = 0;
+        _clk_poll = SNTP_CLOCK_POLL_MIN;
+        _clk_synced = true;
+        return;
+    }
+    if (interval > 0) {
+        /* the part of the last offset that was not slewed yet is no drift */
+        int64_t pending = _clk_slew - _clk_slewed((int64_t)(now - _clk_local));
+        int64_t freq = _clk_freq +
+                       (((theta - pending) * 1000000000LL) / interval) / SNTP_CLOCK_FLL_GAIN;
+
+        if (freq > SNTP_CLOCK_FREQ_MAX) {
+            freq = SNTP_CLOCK_FREQ_MAX;
+        }
+        else if (freq < -SNTP_CLOCK_FREQ_MAX) {
+            freq = -SNTP_CLOCK_FREQ_MAX;
+        }
+        _clk_freq = (int32_t)freq;
+    }
+    _clk_local = now;
+    _clk_wall = cur;
+    _clk_slew = theta;
+    /* poll less often while the clock stays within the threshold */
+    if (_abs64(theta) <= SNTP_CLOCK_POLL_THRESHOLD) {
+        if (_clk_poll < SNTP_CLOCK_POLL_MAX) {
+            _clk_poll++;
+        }
+    }
+    else if (_clk_poll > SNTP_CLOCK_POLL_MIN) {
+        _clk_poll--;
+    }
+    DEBUG("sntp: offset %" PRId32 " us, drift %" PRId32 " ppb, poll 2^%u s\n",
+          (int32_t)theta, _clk_freq, _clk_poll);
+}
+#endif
+
+static int64_t _ntp_usec(const ntp_timestamp_t *ts)
+{
+    return (((int64_t)byteorder_ntohl(ts->seconds)) * US_PER_SEC) +
+           ((((uint64_t)byteorder_ntohl(ts->fraction)) * US_PER_SEC) >> 32);
+}
+
 int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
 {
     int result;
+    uint64_t sent, received;
 
     if ((result = sock_udp_create(&_sntp_sock,
                                   NULL,
@@ -49,6 +145,7 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
     ntp_packet_set_vn(&_sntp_packet);
     ntp_packet_set_mode(&_sntp_packet, NTP_MODE_CLIENT);
 
+    sent = xtimer_now_usec64();
     if ((result = (int)sock_udp_send(&_sntp_sock,
                                      &_sntp_packet,
                                      sizeof(_sntp_packet),
@@ -66,11 +163,21 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
         sock_udp_close(&_sntp_sock);
         return result;
     }
+    received = xtimer_now_usec64();
     sock_udp_close(&_sntp_sock);
+
+    /* the server time between receiving and sending its reply corresponds to
+     * the middle of our round trip */
+    uint64_t local = sent + ((received - sent) / 2);
+    int64_t wall = _ntp_usec(&_sntp_packet.receive) +
+                   ((_ntp_usec(&_sntp_packet.transmit) -
+                     _ntp_usec(&_sntp_packet.receive)) / 2);
+
     mutex_lock(&_sntp_mutex);
-    _sntp_offset = (((int64_t)byteorder_ntohl(_sntp_packet.transmit.seconds)) * US_PER_SEC) +
-                   ((((int64_t)byteorder_ntohl(_sntp_packet.transmit.fraction)) * 232)
-                   / 1000000) - xtimer_now_usec64();
+    _sntp_offset = wall - (int64_t)local;
+#ifdef MODULE_SNTP_CLOCK
+    _clk_update(local, wall);
+#endif
     mutex_unlock(&_sntp_mutex);
     return 0;
 }
@@ -84,3 +191,42 @@ int64_t sntp_get_offset(void)
     mutex_unlock(&_sntp_mutex);
     return result;
 }
+
+#ifdef MODULE_SNTP_CLOCK
+uint64_t sntp_clock_unix_usec(void)
+{
+    uint64_t result = 0;
+
+    mutex_lock(&_sntp_mutex);
+    if (_clk_synced) {
+        result = (uint64_t)(_clk_wall_at(xtimer_now_usec64()) -
+                            (NTP_UNIX_OFFSET * US_PER_SEC));
+        if (result < _clk_last) {
+            result = _clk_last;
+        }
+        _clk_last = result;
+    }
+    mutex_unlock(&_sntp_mutex);
+    return result;
+}
+
+uint32_t sntp_clock_poll_interval(void)
+{
+    uint32_t result;
+
+    mutex_lock(&_sntp_mutex);
+    result = (1UL << _clk_poll);
+    mutex_unlock(&_sntp_mutex);
+    return result;
+}
+
+int32_t sntp_clock_drift(void)
+{
+    int32_t result;
+
+    mutex_lock(&_sntp_mutex);
+    result = _clk_freq;
+    mutex_unlock(&_sntp_mutex);
+    return result;
+}
+#endif
@@ -13,16 +13,126 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* aligned words are read regardless of the type of the buffer */
+typedef uint16_t __attribute__((__may_alias__)) _u16_t;
+typedef uint32_t __attribute__((__may_alias__)) _u32_t;
+
+static inline uint16_t _fold(uint32_t csum)
+{
+    csum = (csum & 0xffff) + (csum >> 16);
+    return (csum & 0xffff) + (csum >> 16);
+}
+
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+static inline uint16_t _sum_words(const _u32_t *buf, uint16_t len)
+{
+    uint32_t csum = 0;
+
+    for (; len >= 16; len -= 16, buf += 4) {
+        uint32_t a = buf[0], b = buf[1], c = buf[2], d = buf[3];
+
+        __asm__ ("adds %[s], %[s], %[a]\n"
+                 "adcs %[s], %[s], %[b]\n"
+                 "adcs %[s], %[s], %[c]\n"
+                 "adcs %[s], %[s], %[d]\n"
+                 /* can carry again if everything was 0xffffffff */
+                 "adcs %[s], %[s], #0\n"
+                 "adc  %[s], %[s], #0\n"
+                 : [s] "+r" (csum)
+                 : [a] "r" (a), [b] "r" (b), [c] "r" (c), [d] "r" (d)
+                 : "cc");
+    }
+    for (; len >= 4; len -= 4, buf++) {
+        __asm__ ("adds %[s], %[s], %[a]\n"
+                 "adc  %[s], %[s], #0\n"
+                 : [s] "+r" (csum)
+                 : [a] "r" (*buf)
+                 : "cc");
+    }
+    return _fold(csum);
+}
+#elif defined(MODULE_MSP430_COMMON)
+static inline uint16_t _sum_words(const _u32_t *buf, uint16_t len)
+{
+    const _u16_t *ptr = (const _u16_t *)buf;
+    uint16_t csum = 0;
+
+    /* 16-bit CPU, so add the half words with carry directly */
+    for (; len >= 8; len -= 8) {
+        __asm__ ("add  @%[p]+, %[s]\n"
+                 "addc @%[p]+, %[s]\n"
+                 "addc @%[p]+, %[s]\n"
+                 "addc @%[p]+, %[s]\n"
+                 /* can carry again if everything was 0xffff */
+                 "addc #0, %[s]\n"
+                 "addc #0, %[s]\n"
+                 : [s] "+r" (csum), [p] "+r" (ptr)
+                 :
+                 : "cc", "memory");
+    }
+    for (; len >= 2; len -= 2) {
+        __asm__ ("add  @%[p]+, %[s]\n"
+                 "addc #0, %[s]\n"
+                 : [s] "+r" (csum), [p] "+r" (ptr)
+                 :
+                 : "cc", "memory");
+    }
+    return csum;
+}
+#else
+static inline uint16_t _sum_words(const _u32_t *buf, uint16_t len)
+{
+    uint32_t csum = 0;
+
+    for (; len >= 4; len -= 4, buf++) {
+        csum += *buf;
+        csum += (csum < *buf);  /* end-around carry */
+    }
+    return _fold(csum);
+}
+#endif
+
+/* sums up buf in host byte order, buf needs to be 16-bit aligned */
+static uint16_t _sum(const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = 0;
+
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        csum += *((const _u16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    csum += _sum_words((const _u32_t *)buf, len);
+    buf += len & ~3;
+    if (len & 2) {
+        csum += *((const _u16_t *)buf);
+        buf += 2;
+    }
+    if (len & 1) {
+        /* last byte is the first half of a 16-bit word */
+        uint8_t last[2] = { *buf, 0 };
+        csum += *((const _u16_t *)last);
+    }
+    return _fold(csum);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint16_t part;
+    /* bytes at even positions of the checksum domain are the top half of
+     * 16-bit words */
+    bool odd = (accum_len & 1);
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -37,25 +147,27 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     if (len == 0)
         return csum;
 
-    if (accum_len & 1) {      /* if accumulated length is odd */
-        csum += *buf;         /* add first byte as bottom half of 16-byte word */
+    if ((uintptr_t)buf & 1) {   /* align buffer to 16-bit words */
+        csum += (odd) ? *buf : (uint16_t)(*buf << 8);
         buf++;
         len--;
-        accum_len++;
+        odd = !odd;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    part = _sum(buf, len);
+    /* since 0x10000 equals 1 in the ones' complement sum, a sum of words that
+     * are shifted by one byte is the byte-swapped sum (RFC 1071, section 2 (B)).
+     * _sum() sums in host byte order, starting at an even position. */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!odd) {
+        part = byteorder_swaps(part);
     }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+#else
+    if (odd) {
+        part = byteorder_swaps(part);
     }
+#endif
+    csum = _fold(csum + part);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
@@ -74,6 +74,12 @@ static const char *_netopt_strmap[] = {
     [NETOPT_CHANNEL_HOP_PERIOD]    = "NETOPT_CHANNEL_HOP_PERIOD",
     [NETOPT_FIXED_HEADER]          = "NETOPT_FIXED_HEADER",
     [NETOPT_IQ_INVERT]             = "NETOPT_IQ_INVERT",
+    [NETOPT_STATS_NEIGHBOR]        = "NETOPT_STATS_NEIGHBOR",
+    [NETOPT_TSCH_COORDINATOR]      = "NETOPT_TSCH_COORDINATOR",
+    [NETOPT_ACK_PENDING_SRC]       = "NETOPT_ACK_PENDING_SRC",
+    [NETOPT_ACK_PENDING_SRC_RM]    = "NETOPT_ACK_PENDING_SRC_RM",
+    [NETOPT_LISTEN_INTERVAL]       = "NETOPT_LISTEN_INTERVAL",
+    [NETOPT_TX_RETRIES_NEEDED]     = "NETOPT_TX_RETRIES_NEEDED",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
@@ -52,6 +52,8 @@ static kernel_pid_t _tftp_kernel_pid;
 #define TFTP_STOP_SERVER_MSG        0x4001
 #define TFTP_DEFAULT_DATA_SIZE      (GNRC_TFTP_MAX_TRANSFER_UNIT    \
                                      + sizeof(tftp_packet_data_t))
+#define TFTP_DEFAULT_BLOCK_SIZE     (512)   /**< block size without options */
+#define TFTP_MIN_BLOCK_SIZE         (8)     /**< see RFC 2348 */
 
 /**
  * @brief TFTP mode help support
@@ -111,13 +113,15 @@ typedef enum {
     TOPT_BLKSIZE,
     TOPT_TIMEOUT,
     TOPT_TSIZE,
+    TOPT_WINDOWSIZE,
 } tftp_options_t;
 
 /* ordered as @see tftp_options_t */
 tftp_opt_t _tftp_options[] = {
-    [TOPT_BLKSIZE] = MODE(blksize),
-    [TOPT_TIMEOUT] = MODE(timeout),
-    [TOPT_TSIZE]   = MODE(tsize),
+    [TOPT_BLKSIZE]    = MODE(blksize),
+    [TOPT_TIMEOUT]    = MODE(timeout),
+    [TOPT_TSIZE]      = MODE(tsize),
+    [TOPT_WINDOWSIZE] = MODE(windowsize),
 };
 
 /**
@@ -160,6 +164,11 @@ typedef struct {
 
     /* transfer parameters */
     uint16_t block_nr;
+    uint16_t block_acked;       /* last block acknowledged by the receiver */
+    uint16_t block_last_rx;     /* last block received */
+    uint16_t window_size;
+    uint16_t window_count;      /* blocks received since the last ACK */
+    bool nak_sent;              /* ACK for an unexpected block was sent */
     uint16_t block_size;
     size_t transfer_size;
     uint32_t block_timeout;
@@ -228,6 +237,9 @@ static tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tft
 /* send and TFTP error to the client */
 static tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg);
 
+/* send the blocks following the last acknowledged one */
+static tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
+
 /* this function sends the actual packet */
 static tftp_state _tftp_send(gnrc_pktsnip_t *buf, tftp_context_t *ctxt, size_t len);
 
@@ -237,7 +249,7 @@ static int _tftp_decode_start(tftp_context_t *ctxt, uint8_t *buf, gnrc_pktsnip_t
 /* decode the TFTP option extensions */
 static int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t start);
 
-/* decode the received ACK packet */
+/* decode the received ACK packet and update the acknowledged block */
 static bool _tftp_validate_ack(tftp_context_t *ctxt, uint8_t *buf);
 
 /* processes the received data packet and calls the callback defined by the user */
@@ -279,7 +291,7 @@ int gnrc_tftp_client_read(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = MIN(_tftp_get_maximum_block_size(), GNRC_TFTP_MAX_TRANSFER_UNIT);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, 0) != TS_FINISHED) {
         _tftp_set_default_options(&ctxt);
@@ -312,7 +324,7 @@ int gnrc_tftp_client_write(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = MIN(_tftp_get_maximum_block_size(), GNRC_TFTP_MAX_TRANSFER_UNIT);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, total_size) != TS_FINISHED) {
 
@@ -360,7 +372,8 @@ int _tftp_init_ctxt(ipv6_addr_t *addr, const char *file_name,
     ctxt->enable_options = enable_options;
 
     /* transport layer parameters */
-    ctxt->block_size = GNRC_TFTP_MAX_TRANSFER_UNIT;
+    ctxt->block_size = TFTP_DEFAULT_BLOCK_SIZE;
+    ctxt->window_size = 1;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->write_finished = false;
 
@@ -374,7 +387,8 @@ int _tftp_init_ctxt(ipv6_addr_t *addr, const char *file_name,
 
 void _tftp_set_default_options(tftp_context_t *ctxt)
 {
-    ctxt->block_size = GNRC_TFTP_MAX_TRANSFER_UNIT;
+    ctxt->block_size = TFTP_DEFAULT_BLOCK_SIZE;
+    ctxt->window_size = 1;
     ctxt->timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->transfer_size = 0;
@@ -388,6 +402,7 @@ int _tftp_set_opts(tftp_context_t *ctxt, size_t blksize, uint32_t timeout, size_
     }
 
     ctxt->block_size = blksize;
+    ctxt->window_size = GNRC_TFTP_WINDOW_SIZE;
     ctxt->timeout = timeout;
     ctxt->block_timeout = timeout;
     ctxt->transfer_size = total_size;
@@ -588,7 +603,11 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             DEBUG("tftp: last data or ack packet lost, resending\n");
             /* we are sending / receiving data */
             /* if we are reading resent the ACK, if writing the DATA */
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_RRQ) ? TO_ACK : TO_DATA);
+            if (((ctxt->ct == CT_CLIENT) && (ctxt->op == TO_RRQ)) ||
+                ((ctxt->ct == CT_SERVER) && (ctxt->op == TO_WRQ))) {
+                return _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            }
+            return _tftp_send_window(ctxt, outbuf);
         }
     }
     else if (m->type != GNRC_NETAPI_MSG_TYPE_RCV) {
@@ -699,7 +718,15 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             }
 
             if (proc == TS_DUP) {
-                DEBUG("tftp: duplicated data received, acking...\n");
+                /* acknowledge the last block received in order once per
+                 * window, so the sender restarts from there */
+                if (ctxt->nak_sent) {
+                    gnrc_pktbuf_release(outbuf);
+                    return TS_BUSY;
+                }
+                DEBUG("tftp: unexpected data received, acking...\n");
+                ctxt->nak_sent = true;
+                ctxt->window_count = 0;
                 _tftp_send_dack(ctxt, outbuf, TO_ACK);
                 return TS_BUSY;
             }
@@ -716,10 +743,17 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
             }
 
-            /* wait for the next data block */
+            /* wait for the next data block, acknowledge once per window */
             DEBUG("tftp: wait for the next data block\n");
             ++(ctxt->block_nr);
-            _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            if ((++(ctxt->window_count) >= ctxt->window_size) ||
+                (proc < ctxt->block_size)) {
+                ctxt->window_count = 0;
+                _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            }
+            else {
+                gnrc_pktbuf_release(outbuf);
+            }
 
             /* check if the data transfer has finished */
             if (proc < ctxt->block_size) {
@@ -745,7 +779,7 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             }
 
             /* check if the write action is finished */
-            if (ctxt->write_finished) {
+            if (ctxt->write_finished && (ctxt->block_acked == ctxt->block_nr)) {
                 gnrc_pktbuf_release(outbuf);
 
                 if (ctxt->stop_cb) {
@@ -764,10 +798,8 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
             }
 
-            /* send the next data block */
-            ++(ctxt->block_nr);
-
-            return _tftp_send_dack(ctxt, outbuf, TO_DATA);
+            /* send the next data blocks */
+            return _tftp_send_window(ctxt, outbuf);
         } break;
 
         case TO_ERROR: {
@@ -792,22 +824,26 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             if (ctxt->dst_port != byteorder_ntohs(udp->src_port)) {
                 DEBUG("tftp: TO_OACK received\n");
 
+                /* options missing in the OACK were declined by the server */
+                ctxt->block_size = TFTP_DEFAULT_BLOCK_SIZE;
+                ctxt->window_size = 1;
+
                 /* decode the options */
                 _tftp_decode_options(ctxt, pkt, 0);
 
                 /* take the new source port */
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
 
-                /* we must send block one to finish the negotiation in send mode */
-                if (ctxt->op == TO_WRQ) {
-                    ++(ctxt->block_nr);
-                }
             }
             else {
                 DEBUG("tftp: dropping double TO_OACK\n");
             }
 
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_WRQ) ? TO_DATA : TO_ACK);
+            /* we must send the first blocks to finish the negotiation in send mode */
+            if (ctxt->op == TO_WRQ) {
+                return _tftp_send_window(ctxt, outbuf);
+            }
+            return _tftp_send_dack(ctxt, outbuf, TO_ACK);
         } break;
     }
 
@@ -846,6 +882,12 @@ uint32_t _tftp_append_options(tftp_context_t *ctxt, tftp_header_t *hdr, uint32_t
         offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_TSIZE, ctxt->transfer_size);
     }
 
+    /* without the option, a window of one block is used */
+    if (ctxt->window_size > 1) {
+        offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_WINDOWSIZE,
+                                   ctxt->window_size);
+    }
+
     return offset;
 }
 
@@ -910,6 +952,36 @@ tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcod
     return _tftp_send(buf, ctxt, sizeof(tftp_packet_data_t) + len);
 }
 
+tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
+{
+    tftp_state state = TS_BUSY;
+
+    /* (re-)start after the last acknowledged block */
+    ctxt->block_nr = ctxt->block_acked;
+    for (unsigned i = 0; i < ctxt->window_size; i++) {
+        if (!buf) {
+            buf = gnrc_pktbuf_add(NULL, NULL, TFTP_DEFAULT_DATA_SIZE, GNRC_NETTYPE_UNDEF);
+            if (!buf) {
+                /* the remaining blocks are sent after the next timeout */
+                DEBUG("tftp: no space for block %u of window\n", i);
+                break;
+            }
+        }
+
+        ++(ctxt->block_nr);
+        state = _tftp_send_dack(ctxt, buf, TO_DATA);
+        buf = NULL;
+        if ((state != TS_BUSY) || ctxt->write_finished) {
+            break;
+        }
+    }
+
+    if (buf) {
+        gnrc_pktbuf_release(buf);
+    }
+    return state;
+}
+
 tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg)
 {
     int strl = err_msg ? strlen(err_msg) + 1 : 0;
@@ -1018,8 +1090,18 @@ tftp_state _tftp_send(gnrc_pktsnip_t *buf, tftp_context_t *ctxt, size_t len)
 bool _tftp_validate_ack(tftp_context_t *ctxt, uint8_t *buf)
 {
     tftp_packet_data_t *pkt = (tftp_packet_data_t *) buf;
-
-    return ctxt->block_nr == byteorder_ntohs(pkt->block_nr);
+    uint16_t block_nr = byteorder_ntohs(pkt->block_nr);
+    uint16_t sent = ctxt->block_nr - ctxt->block_acked;
+    uint16_t acked = block_nr - ctxt->block_acked;
+
+    /* with windows, the receiver acknowledges any block of the window, or
+     * again the last acknowledged block if the first one got lost */
+    if ((block_nr == ctxt->block_nr) ||
+        ((acked <= sent) && ((acked > 0) || (ctxt->window_size > 1)))) {
+        ctxt->block_acked = block_nr;
+        return true;
+    }
+    return false;
 }
 
 int _tftp_decode_start(tftp_context_t *ctxt, uint8_t *buf, gnrc_pktsnip_t *outbuf)
@@ -1078,7 +1160,12 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
                 /* set the option value of the known options */
                 switch (idx) {
                     case TOPT_BLKSIZE:
-                        ctxt->block_size = atoi(value);
+                        ctxt->block_size = MIN((unsigned)atoi(value),
+                                               MIN(_tftp_get_maximum_block_size(),
+                                                   GNRC_TFTP_MAX_TRANSFER_UNIT));
+                        if (ctxt->block_size < TFTP_MIN_BLOCK_SIZE) {
+                            ctxt->block_size = TFTP_DEFAULT_BLOCK_SIZE;
+                        }
                         DEBUG("tftp: got option TOPT_BLKSIZE = %" PRIu16 "\n", ctxt->block_size);
                         break;
 
@@ -1095,6 +1182,14 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
                         ctxt->timeout = atoi(value) * US_PER_SEC;
                         DEBUG("tftp: option TOPT_TIMEOUT = %" PRIu32 " ms\n", ctxt->timeout / US_PER_MS);
                         break;
+
+                    case TOPT_WINDOWSIZE:
+                        ctxt->window_size = MIN((unsigned)atoi(value), GNRC_TFTP_WINDOW_SIZE);
+                        if (ctxt->window_size == 0) {
+                            ctxt->window_size = 1;
+                        }
+                        DEBUG("tftp: got option TOPT_WINDOWSIZE = %" PRIu16 "\n", ctxt->window_size);
+                        break;
                 }
 
                 break;
@@ -1114,17 +1209,20 @@ int _tftp_process_data(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
 
     uint16_t block_nr = byteorder_ntohs(pkt->block_nr);
 
-    /* check if this is the packet we are waiting for */
-    if (block_nr > (ctxt->block_nr + 1)) {
-        DEBUG("tftp: incorrect block_nr %d received from server, expected %d\n",
-               block_nr, (ctxt->block_nr + 1));
-        return TS_FAILED;
+    /* the sender (re-)started a window if the block numbers did not increase */
+    if ((int16_t)(block_nr - ctxt->block_last_rx) <= 0) {
+        ctxt->nak_sent = false;
     }
-    if (block_nr < (ctxt->block_nr + 1)) {
+    ctxt->block_last_rx = block_nr;
+
+    /* check if this is the packet we are waiting for, a later one means
+     * that blocks of the window got lost */
+    if (block_nr != (uint16_t)(ctxt->block_nr + 1)) {
         DEBUG("tftp: not the packet we were waiting for, expected %d, received %d\n",
               (uint16_t)(ctxt->block_nr + 1), block_nr);
         return TS_DUP;
     }
+    ctxt->nak_sent = false;
 
     /* send the user data trough to the user application */
     if (ctxt->data_cb(ctxt->block_nr * ctxt->block_size, pkt->data,
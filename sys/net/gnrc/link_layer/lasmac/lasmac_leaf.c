@@ -463,6 +463,13 @@ static void *_gnrc_lasmac_thread(void *args)
 				reply.content.value = (uint32_t)res;
 				msg_reply(&msg, &reply);
 				break;
+			case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+			case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+				/* the caller falls back to single options */
+				reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+				reply.content.value = (uint32_t)(-ENOTSUP);
+				msg_reply(&msg, &reply);
+				break;
 			default:
 				DEBUG("gnrc_netdev: Unknown command %" PRIu16 "\n", msg.type);
 				break;
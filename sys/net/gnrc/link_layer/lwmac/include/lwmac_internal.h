@@ -27,6 +27,7 @@
 #include "net/gnrc/netdev.h"
 #include "net/gnrc/mac/types.h"
 #include "net/gnrc/lwmac/types.h"
+#include "net/gnrc/lwmac/hdr.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -307,49 +308,112 @@ netopt_state_t _gnrc_lwmac_get_netdev_state(gnrc_netdev_t *gnrc_netdev);
  */
 void _gnrc_lwmac_set_netdev_state(gnrc_netdev_t *gnrc_netdev, netopt_state_t devstate);
 
+/**
+ * @brief Get the wake-up interval for an interval exponent
+ *
+ * @param[in]   exp      interval exponent, see @ref gnrc_lwmac_t::interval_exp
+ *
+ * @return               wake-up interval in microseconds
+ */
+static inline uint32_t _gnrc_lwmac_interval_us(uint8_t exp)
+{
+    return (GNRC_LWMAC_WAKEUP_INTERVAL_US >> exp);
+}
+
+/**
+ * @brief Get the device's current wake-up interval
+ *
+ * @param[in]   gnrc_netdev    gnrc_netdev structure
+ *
+ * @return                     wake-up interval in microseconds
+ */
+static inline uint32_t _gnrc_lwmac_wakeup_interval(gnrc_netdev_t *gnrc_netdev)
+{
+    return _gnrc_lwmac_interval_us(gnrc_netdev->lwmac.interval_exp);
+}
+
+/**
+ * @brief Get the wake-up interval of a neighbor, as it had advertised
+ *
+ * @param[in]   neighbor       tx neighbor
+ *
+ * @return                     wake-up interval in microseconds
+ */
+static inline uint32_t _gnrc_lwmac_neighbor_interval(gnrc_mac_tx_neighbor_t *neighbor)
+{
+    return _gnrc_lwmac_interval_us(neighbor->interval_exp);
+}
+
 /**
  * @brief Convert RTT ticks to device phase
  *
- * @param[in]   ticks    RTT ticks
+ * @param[in]   ticks       RTT ticks
+ * @param[in]   interval    wake-up interval in microseconds
  *
- * @return               device phase
+ * @return                  device phase
  */
-static inline uint32_t _gnrc_lwmac_ticks_to_phase(uint32_t ticks)
+static inline uint32_t _gnrc_lwmac_ticks_to_phase(uint32_t ticks, uint32_t interval)
 {
-    assert(GNRC_LWMAC_WAKEUP_INTERVAL_US != 0);
+    assert(interval != 0);
 
-    return (ticks % RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+    return (ticks % RTT_US_TO_TICKS(interval));
 }
 
 /**
  * @brief Get device's current phase
  *
- * @return               device phase
+ * @param[in]   interval    wake-up interval in microseconds
+ *
+ * @return                  device phase
  */
-static inline uint32_t _gnrc_lwmac_phase_now(void)
+static inline uint32_t _gnrc_lwmac_phase_now(uint32_t interval)
 {
-    return _gnrc_lwmac_ticks_to_phase(rtt_get_counter());
+    return _gnrc_lwmac_ticks_to_phase(rtt_get_counter(), interval);
 }
 
 /**
  * @brief Calculate how many ticks remaining to the targeted phase in the future
  *
- * @param[in]   phase    device phase
+ * @param[in]   phase       device phase
+ * @param[in]   interval    wake-up interval of the device in microseconds
  *
- * @return               RTT ticks
+ * @return                  RTT ticks
  */
-static inline uint32_t _gnrc_lwmac_ticks_until_phase(uint32_t phase)
+static inline uint32_t _gnrc_lwmac_ticks_until_phase(uint32_t phase, uint32_t interval)
 {
-    long int tmp = phase - _gnrc_lwmac_phase_now();
+    long int tmp = phase - _gnrc_lwmac_phase_now(interval);
 
     if (tmp < 0) {
         /* Phase in next interval */
-        tmp += RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+        tmp += RTT_US_TO_TICKS(interval);
     }
 
     return (uint32_t)tmp;
 }
 
+/**
+ * @brief Calculate the phase of the sender of a WA
+ *
+ * @param[in]   wa          received WA
+ *
+ * @return                  phase of the sender within the wake-up interval it
+ *                          advertised in @p wa
+ */
+uint32_t _gnrc_lwmac_wa_to_phase(const gnrc_lwmac_frame_wa_t *wa);
+
+/**
+ * @brief Learn the phase of a neighbor from a WA it sent, to whomever
+ *
+ *        Updates the TX neighbor entry of the sender, or takes a free entry
+ *        for it, so later packets to it are sent in its phase right away.
+ *
+ * @param[in,out]   gnrc_netdev    gnrc_netdev structure
+ * @param[in]       addr           address of the sender of @p wa
+ * @param[in]       wa             received WA
+ */
+void _gnrc_lwmac_learn_phase(gnrc_netdev_t *gnrc_netdev, const gnrc_lwmac_l2_addr_t *addr,
+                             const gnrc_lwmac_frame_wa_t *wa);
+
 /**
  * @brief Store the received packet to the dispatch buffer and remove possible
  *        duplicate packets.
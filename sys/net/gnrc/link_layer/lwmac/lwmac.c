@@ -75,7 +75,9 @@ static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netdev_t *gnrc_netdev)
             /* Unknown destinations are initialized with their phase at the end
              * of the local interval, so known destinations that still wakeup
              * in this interval will be preferred. */
-            uint32_t phase_check = _gnrc_lwmac_ticks_until_phase(gnrc_netdev->tx.neighbors[i].phase);
+            uint32_t phase_check = _gnrc_lwmac_ticks_until_phase(gnrc_netdev->tx.neighbors[i].phase,
+                                                                 _gnrc_lwmac_neighbor_interval(
+                                                                     &gnrc_netdev->tx.neighbors[i]));
 
             if (phase_check <= phase_nearest) {
                 next = i;
@@ -107,6 +109,40 @@ static uint32_t _next_inphase_event(uint32_t last, uint32_t interval)
     return last;
 }
 
+/* Adapt the wake-up interval to the load of the cycle that just ended */
+static void _adapt_wakeup_interval(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev->lwmac;
+    unsigned load = lwmac->wr_count;
+
+    for (int i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        load += gnrc_priority_pktqueue_length(&gnrc_netdev->tx.neighbors[i].queue);
+    }
+    lwmac->wr_count = 0;
+
+    if (load >= GNRC_LWMAC_ADAPT_BUSY_THRESHOLD) {
+        lwmac->idle_cycles = 0;
+        if (lwmac->interval_exp < GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX) {
+            lwmac->interval_exp++;
+            LOG_INFO("[LWMAC] Load %u, wake-up interval now %" PRIu32 " us\n",
+                     load, _gnrc_lwmac_wakeup_interval(gnrc_netdev));
+        }
+    }
+    else if (load == 0) {
+        if (++lwmac->idle_cycles >= GNRC_LWMAC_ADAPT_IDLE_CYCLES) {
+            lwmac->idle_cycles = 0;
+            if (lwmac->interval_exp > 0) {
+                lwmac->interval_exp--;
+                LOG_INFO("[LWMAC] Idle, wake-up interval now %" PRIu32 " us\n",
+                         _gnrc_lwmac_wakeup_interval(gnrc_netdev));
+            }
+        }
+    }
+    else {
+        lwmac->idle_cycles = 0;
+    }
+}
+
 inline void lwmac_schedule_update(gnrc_netdev_t *gnrc_netdev)
 {
     gnrc_netdev_lwmac_set_reschedule(gnrc_netdev, true);
@@ -168,15 +204,16 @@ void lwmac_set_state(gnrc_netdev_t *gnrc_netdev, gnrc_lwmac_state_t newstate)
             if (gnrc_netdev_lwmac_get_phase_backoff(gnrc_netdev)) {
                 gnrc_netdev_lwmac_set_phase_backoff(gnrc_netdev, false);
                 uint32_t alarm;
+                uint32_t interval = _gnrc_lwmac_wakeup_interval(gnrc_netdev);
 
                 rtt_clear_alarm();
                 alarm = random_uint32_range(RTT_US_TO_TICKS((3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)),
-                                            RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US -
+                                            RTT_US_TO_TICKS(interval -
                                                             (3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)));
                 LOG_WARNING("WARNING: [LWMAC] phase backoffed: %lu us\n", RTT_TICKS_TO_US(alarm));
                 gnrc_netdev->lwmac.last_wakeup = gnrc_netdev->lwmac.last_wakeup + alarm;
                 alarm = _next_inphase_event(gnrc_netdev->lwmac.last_wakeup,
-                                            RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                            RTT_US_TO_TICKS(interval));
                 rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             }
 
@@ -249,6 +286,8 @@ static void _sleep_management(gnrc_netdev_t *gnrc_netdev)
         }
 
         if (neighbour != NULL) {
+            uint32_t interval = _gnrc_lwmac_neighbor_interval(neighbour);
+
             /* if phase is unknown, send immediately. */
             if (neighbour->phase > RTT_TICKS_TO_US(GNRC_LWMAC_WAKEUP_INTERVAL_US)) {
                 gnrc_netdev->tx.current_neighbor = neighbour;
@@ -260,12 +299,13 @@ static void _sleep_management(gnrc_netdev_t *gnrc_netdev)
 
             /* Offset in microseconds when the earliest (phase) destination
              * node wakes up that we have packets for. */
-            int time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbour->phase));
+            int time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbour->phase,
+                                                                              interval));
 
             /* If there's not enough time to prepare a WR to catch the phase
              * postpone to next interval */
             if (time_until_tx < GNRC_LWMAC_WR_PREPARATION_US) {
-                time_until_tx += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+                time_until_tx += interval;
             }
             time_until_tx -= GNRC_LWMAC_WR_PREPARATION_US;
 
@@ -318,7 +358,7 @@ static void _rx_management_failed(gnrc_netdev_t *gnrc_netdev)
         phase = phase - gnrc_netdev->lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4*RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)/5)) {
+    if (phase > (4*RTT_US_TO_TICKS(_gnrc_lwmac_wakeup_interval(gnrc_netdev))/5)) {
         gnrc_netdev_lwmac_set_quit_rx(gnrc_netdev, true);
     }
 
@@ -349,7 +389,7 @@ static void _rx_management_success(gnrc_netdev_t *gnrc_netdev)
         phase = phase - gnrc_netdev->lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4*RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)/5)) {
+    if (phase > (4*RTT_US_TO_TICKS(_gnrc_lwmac_wakeup_interval(gnrc_netdev))/5)) {
         gnrc_netdev_lwmac_set_quit_rx(gnrc_netdev, true);
     }
 
@@ -568,6 +608,7 @@ void rtt_handler(uint32_t event, gnrc_netdev_t *gnrc_netdev)
         case GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING: {
             /* A new cycle starts, set sleep timing and initialize related MAC-info flags. */
             gnrc_netdev->lwmac.last_wakeup = rtt_get_alarm();
+            _adapt_wakeup_interval(gnrc_netdev);
             alarm = _next_inphase_event(gnrc_netdev->lwmac.last_wakeup,
                                         RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_DURATION_US));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING);
@@ -581,7 +622,7 @@ void rtt_handler(uint32_t event, gnrc_netdev_t *gnrc_netdev)
         case GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING: {
             /* Set next wake-up timing. */
             alarm = _next_inphase_event(gnrc_netdev->lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                        RTT_US_TO_TICKS(_gnrc_lwmac_wakeup_interval(gnrc_netdev)));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             lwmac_set_state(gnrc_netdev, GNRC_LWMAC_SLEEPING);
             break;
@@ -606,7 +647,7 @@ void rtt_handler(uint32_t event, gnrc_netdev_t *gnrc_netdev)
             LOG_DEBUG("[LWMAC] RTT: Resume duty cycling\n");
             rtt_clear_alarm();
             alarm = _next_inphase_event(gnrc_netdev->lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                        RTT_US_TO_TICKS(_gnrc_lwmac_wakeup_interval(gnrc_netdev)));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             gnrc_netdev_lwmac_set_dutycycle_active(gnrc_netdev, true);
             break;
@@ -701,6 +742,14 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             default:
                 LOG_WARNING("WARNING: [LWMAC] Unhandled netdev event: %u\n", event);
         }
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+        /* wake-up requests and data go out on the receiver's channel */
+        if ((event == NETDEV_EVENT_TX_COMPLETE) ||
+            (event == NETDEV_EVENT_TX_NOACK) ||
+            (event == NETDEV_EVENT_TX_MEDIUM_BUSY)) {
+            gnrc_netdev->tx_end(gnrc_netdev);
+        }
+#endif
     }
 }
 
@@ -765,6 +814,11 @@ static void *_lwmac_thread(void *args)
     /* Reset all timeouts just to be sure */
     gnrc_lwmac_reset_timeouts(gnrc_netdev);
 
+    /* Start with the longest wake-up interval until there is traffic */
+    gnrc_netdev->lwmac.interval_exp = 0;
+    gnrc_netdev->lwmac.idle_cycles = 0;
+    gnrc_netdev->lwmac.wr_count = 0;
+
     /* Start duty cycling */
     lwmac_set_state(gnrc_netdev, GNRC_LWMAC_START);
 
@@ -880,6 +934,13 @@ static void *_lwmac_thread(void *args)
                 msg_reply(&msg, &reply);
                 break;
             }
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                /* the caller falls back to single options */
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
             default:
                 LOG_ERROR("ERROR: [LWMAC] Unknown command %" PRIu16 "\n", msg.type);
                 break;
@@ -78,8 +78,16 @@ int _gnrc_lwmac_parse_packet(gnrc_pktsnip_t *pkt, gnrc_lwmac_packet_info_t *info
     lwmac_hdr = lwmac_snip->data;
 
     if (lwmac_hdr->type == GNRC_LWMAC_FRAMETYPE_WA) {
+        gnrc_lwmac_frame_wa_t *wa = (gnrc_lwmac_frame_wa_t *)lwmac_hdr;
+
         /* WA is broadcast, so get dst address out of header instead of netif */
-        info->dst_addr = ((gnrc_lwmac_frame_wa_t *)lwmac_hdr)->dst_addr;
+        info->dst_addr = wa->dst_addr;
+        /* Phases are only interpreted with wake-up intervals we can handle */
+        if (wa->interval_exp > GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX) {
+            DEBUG("[LWMAC-int] Unsupported wake-up interval exponent %u\n",
+                  wa->interval_exp);
+            wa->interval_exp = GNRC_LWMAC_WAKEUP_INTERVAL_EXP_MAX;
+        }
     }
     else if (lwmac_hdr->type == GNRC_LWMAC_FRAMETYPE_WR) {
         /* WR is broadcast, so get dst address out of header instead of netif */
@@ -144,6 +152,60 @@ netopt_state_t _gnrc_lwmac_get_netdev_state(gnrc_netdev_t *gnrc_netdev)
     return -1;
 }
 
+uint32_t _gnrc_lwmac_wa_to_phase(const gnrc_lwmac_frame_wa_t *wa)
+{
+    uint32_t interval = _gnrc_lwmac_interval_us(wa->interval_exp);
+    uint32_t phase = _gnrc_lwmac_phase_now(interval);
+
+    /* The WA tells how far its sender is into its current cycle */
+    if (phase >= wa->current_phase) {
+        phase -= wa->current_phase;
+    }
+    else {
+        phase += RTT_US_TO_TICKS(interval);
+        phase -= wa->current_phase;
+    }
+
+    return phase;
+}
+
+void _gnrc_lwmac_learn_phase(gnrc_netdev_t *gnrc_netdev, const gnrc_lwmac_l2_addr_t *addr,
+                             const gnrc_lwmac_frame_wa_t *wa)
+{
+    gnrc_mac_tx_neighbor_t *neighbor = NULL;
+
+    assert(addr->len > 0);
+
+    /* Broadcast neighbor is at index 0 */
+    for (int i = 1; i <= (signed)GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        gnrc_mac_tx_neighbor_t *tmp = &gnrc_netdev->tx.neighbors[i];
+
+        if ((tmp->l2_addr_len == addr->len) &&
+            (memcmp(tmp->l2_addr, addr->addr, addr->len) == 0)) {
+            neighbor = tmp;
+            break;
+        }
+        if ((neighbor == NULL) && (tmp->l2_addr_len == 0)) {
+            neighbor = tmp;
+        }
+    }
+
+    if (neighbor == NULL) {
+        /* Don't push out neighbors we have packets for */
+        return;
+    }
+    if (neighbor->l2_addr_len == 0) {
+        /* Take a free entry, so packets to the neighbor can use its phase
+         * right away */
+        gnrc_priority_pktqueue_init(&neighbor->queue);
+        memcpy(neighbor->l2_addr, addr->addr, addr->len);
+        neighbor->l2_addr_len = addr->len;
+    }
+    neighbor->interval_exp = wa->interval_exp;
+    neighbor->phase = _gnrc_lwmac_wa_to_phase(wa);
+    DEBUG("[LWMAC-int] Learned phase %" PRIu32 " of neighbor\n", neighbor->phase);
+}
+
 int _gnrc_lwmac_dispatch_defer(gnrc_pktsnip_t *buffer[], gnrc_pktsnip_t *pkt)
 {
     assert(buffer != NULL);
@@ -71,6 +71,14 @@ static uint8_t _packet_process_in_wait_for_wr(gnrc_netdev_t *gnrc_netdev)
             continue;
         }
 
+        if (info.header->type == GNRC_LWMAC_FRAMETYPE_WA) {
+            /* Overheard WA of another receiver, remember when it wakes up */
+            _gnrc_lwmac_learn_phase(gnrc_netdev, &info.src_addr,
+                                    (gnrc_lwmac_frame_wa_t *)info.header);
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+
         if (info.header->type == GNRC_LWMAC_FRAMETYPE_BROADCAST) {
             _gnrc_lwmac_dispatch_defer(gnrc_netdev->rx.dispatch_buffer, pkt);
             gnrc_mac_dispatch(&gnrc_netdev->rx);
@@ -104,6 +112,11 @@ static uint8_t _packet_process_in_wait_for_wr(gnrc_netdev_t *gnrc_netdev)
         /* Save source address for later addressing */
         gnrc_netdev->rx.l2_addr = info.src_addr;
 
+        /* Count the load of this cycle for adapting the wake-up interval */
+        if (gnrc_netdev->lwmac.wr_count < UINT8_MAX) {
+            gnrc_netdev->lwmac.wr_count++;
+        }
+
         rx_info |= GNRC_LWMAC_RX_FOUND_WR;
         break;
     }
@@ -133,19 +146,22 @@ static bool _send_wa(gnrc_netdev_t *gnrc_netdev)
     lwmac_hdr.header.type = GNRC_LWMAC_FRAMETYPE_WA;
     lwmac_hdr.dst_addr = gnrc_netdev->rx.l2_addr;
 
-    uint32_t phase_now = _gnrc_lwmac_phase_now();
+    uint32_t interval = _gnrc_lwmac_wakeup_interval(gnrc_netdev);
+    uint32_t phase_now = _gnrc_lwmac_phase_now(interval);
+    uint32_t phase_wakeup = _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup,
+                                                       interval);
 
     /* Embed the current 'relative phase timing' (counted from the start of this cycle)
      * of the receiver into its WA packet, thus to allow the sender to infer the
      * receiver's exact wake-up timing */
-    if (phase_now > _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup)) {
-        lwmac_hdr.current_phase = (phase_now -
-                                   _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup));
+    if (phase_now > phase_wakeup) {
+        lwmac_hdr.current_phase = (phase_now - phase_wakeup);
     }
     else {
-        lwmac_hdr.current_phase = (phase_now + RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) -
-                                  _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup);
+        lwmac_hdr.current_phase = (phase_now + RTT_US_TO_TICKS(interval)) - phase_wakeup;
     }
+    /* The sender needs the interval to predict the next wake-ups */
+    lwmac_hdr.interval_exp = gnrc_netdev->lwmac.interval_exp;
 
     pkt = gnrc_pktbuf_add(NULL, &lwmac_hdr, sizeof(lwmac_hdr), GNRC_NETTYPE_LWMAC);
     if (pkt == NULL) {
@@ -219,6 +235,14 @@ static uint8_t _packet_process_in_wait_for_data(gnrc_netdev_t *gnrc_netdev)
             continue;
         }
 
+        if (info.header->type == GNRC_LWMAC_FRAMETYPE_WA) {
+            /* Overheard WA of another receiver, remember when it wakes up */
+            _gnrc_lwmac_learn_phase(gnrc_netdev, &info.src_addr,
+                                    (gnrc_lwmac_frame_wa_t *)info.header);
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+
         if (info.header->type == GNRC_LWMAC_FRAMETYPE_BROADCAST) {
             _gnrc_lwmac_dispatch_defer(gnrc_netdev->rx.dispatch_buffer, pkt);
             gnrc_mac_dispatch(&gnrc_netdev->rx);
@@ -49,6 +49,46 @@
  */
 #define GNRC_LWMAC_TX_FAIL            (0x02U)
 
+static uint32_t _bcast_duration(gnrc_netdev_t *gnrc_netdev)
+{
+    uint32_t duration = 0;
+
+    if ((gnrc_netdev->tx.bcast_seqnr % GNRC_LWMAC_BROADCAST_FULL_PERIOD) == 0) {
+        /* Reach neighbors we don't know yet */
+        return GNRC_LWMAC_BROADCAST_DURATION_US;
+    }
+
+    /* Otherwise broadcast until all known neighbors have been awake. Broadcast
+     * neighbor is at index 0 */
+    for (int i = 1; i <= (signed)GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        gnrc_mac_tx_neighbor_t *neighbor = &gnrc_netdev->tx.neighbors[i];
+        uint32_t interval = _gnrc_lwmac_neighbor_interval(neighbor);
+        uint32_t until;
+
+        if (neighbor->l2_addr_len == 0) {
+            continue;
+        }
+        if (neighbor->phase >= RTT_US_TO_TICKS(interval)) {
+            /* Phase unknown, so it may wake up any time */
+            return GNRC_LWMAC_BROADCAST_DURATION_US;
+        }
+        until = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbor->phase, interval));
+        if (until > (interval - GNRC_LWMAC_WAKEUP_DURATION_US)) {
+            /* Neighbor is awake right now */
+            until = 0;
+        }
+        until += GNRC_LWMAC_WAKEUP_DURATION_US;
+        if (until > duration) {
+            duration = until;
+        }
+    }
+
+    if ((duration == 0) || (duration > GNRC_LWMAC_BROADCAST_DURATION_US)) {
+        return GNRC_LWMAC_BROADCAST_DURATION_US;
+    }
+    return duration;
+}
+
 static uint8_t _send_bcast(gnrc_netdev_t *gnrc_netdev)
 {
     assert(gnrc_netdev != NULL);
@@ -67,9 +107,10 @@ static uint8_t _send_bcast(gnrc_netdev_t *gnrc_netdev)
         }
     }
     else {
-        LOG_INFO("[LWMAC-tx] Initialize broadcasting\n");
-        gnrc_lwmac_set_timeout(gnrc_netdev, GNRC_LWMAC_TIMEOUT_BROADCAST_END,
-                          GNRC_LWMAC_BROADCAST_DURATION_US);
+        uint32_t duration = _bcast_duration(gnrc_netdev);
+
+        LOG_INFO("[LWMAC-tx] Initialize broadcasting for %" PRIu32 " us\n", duration);
+        gnrc_lwmac_set_timeout(gnrc_netdev, GNRC_LWMAC_TIMEOUT_BROADCAST_END, duration);
 
         gnrc_pktsnip_t *pkt_payload;
 
@@ -269,6 +310,11 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netdev_t *gnrc_netdev)
          * further now. */
         if (!(memcmp(&info.dst_addr.addr, &gnrc_netdev->l2_addr,
                      gnrc_netdev->l2_addr_len) == 0) && from_expected_destination) {
+            if (info.header->type == GNRC_LWMAC_FRAMETYPE_WA) {
+                /* At least send in its phase next time */
+                _gnrc_lwmac_learn_phase(gnrc_netdev, &info.src_addr,
+                                        (gnrc_lwmac_frame_wa_t *)info.header);
+            }
             if (!gnrc_mac_queue_tx_packet(&gnrc_netdev->tx, 0, gnrc_netdev->tx.packet)) {
                 gnrc_pktbuf_release(gnrc_netdev->tx.packet);
                 LOG_WARNING("WARNING: [LWMAC-tx] TX queue full, drop packet\n");
@@ -300,38 +346,44 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netdev_t *gnrc_netdev)
             continue;
         }
 
+        gnrc_lwmac_frame_wa_t *wa_hdr;
+        wa_hdr = (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_LWMAC))->data;
+
         if (from_expected_destination) {
+            /* The receiver's phase is relative to its current wake-up interval */
+            gnrc_netdev->tx.current_neighbor->interval_exp = wa_hdr->interval_exp;
+            uint32_t interval = _gnrc_lwmac_interval_us(wa_hdr->interval_exp);
+
             /* calculate the phase of the receiver based on WA */
-            gnrc_netdev->tx.timestamp = _gnrc_lwmac_phase_now();
-            gnrc_lwmac_frame_wa_t *wa_hdr;
-            wa_hdr = (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_LWMAC))->data;
+            gnrc_netdev->tx.timestamp = _gnrc_lwmac_wa_to_phase(wa_hdr);
 
-            if (gnrc_netdev->tx.timestamp >= wa_hdr->current_phase) {
-                gnrc_netdev->tx.timestamp = gnrc_netdev->tx.timestamp -
-                                            wa_hdr->current_phase;
-            }
-            else {
-                gnrc_netdev->tx.timestamp += RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
-                gnrc_netdev->tx.timestamp -= wa_hdr->current_phase;
+            /* The wake-ups of both nodes repeat with the shorter of both intervals */
+            if (_gnrc_lwmac_wakeup_interval(gnrc_netdev) < interval) {
+                interval = _gnrc_lwmac_wakeup_interval(gnrc_netdev);
             }
 
-            uint32_t own_phase;
-            own_phase = _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup);
+            uint32_t own_phase, rx_phase;
+            own_phase = _gnrc_lwmac_ticks_to_phase(gnrc_netdev->lwmac.last_wakeup, interval);
+            rx_phase = _gnrc_lwmac_ticks_to_phase(gnrc_netdev->tx.timestamp, interval);
 
-            if (own_phase >= gnrc_netdev->tx.timestamp) {
-                own_phase = own_phase - gnrc_netdev->tx.timestamp;
+            if (own_phase >= rx_phase) {
+                own_phase = own_phase - rx_phase;
             }
             else {
-                own_phase = gnrc_netdev->tx.timestamp - own_phase;
+                own_phase = rx_phase - own_phase;
             }
 
             if ((own_phase < RTT_US_TO_TICKS((3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2))) ||
-                (own_phase > RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US -
+                (own_phase > RTT_US_TO_TICKS(interval -
                                              (3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)))) {
                 gnrc_netdev_lwmac_set_phase_backoff(gnrc_netdev, true);
                 LOG_WARNING("WARNING: [LWMAC-tx] phase close\n");
             }
         }
+        else {
+            /* WA of another receiver, remember when it wakes up */
+            _gnrc_lwmac_learn_phase(gnrc_netdev, &info.src_addr, wa_hdr);
+        }
 
         /* No need to keep pkt anymore */
         gnrc_pktbuf_release(pkt);
@@ -670,7 +722,9 @@ static bool _lwmac_tx_update(gnrc_netdev_t *gnrc_netdev)
             LOG_DEBUG("[LWMAC-tx] Destination phase was: %" PRIu32 "\n",
                            gnrc_netdev->tx.current_neighbor->phase);
             LOG_DEBUG("[LWMAC-tx] Phase when sent was:   %" PRIu32 "\n",
-                           _gnrc_lwmac_ticks_to_phase(gnrc_netdev->tx.timestamp));
+                           _gnrc_lwmac_ticks_to_phase(gnrc_netdev->tx.timestamp,
+                                                      _gnrc_lwmac_neighbor_interval(
+                                                          gnrc_netdev->tx.current_neighbor)));
             LOG_DEBUG("[LWMAC-tx] Ticks when sent was:   %" PRIu32 "\n",
                            gnrc_netdev->tx.timestamp);
             _gnrc_lwmac_set_netdev_state(gnrc_netdev, NETOPT_STATE_IDLE);
@@ -20,11 +20,14 @@
 
 #include <errno.h>
 
+#include "irq.h"
 #include "msg.h"
 #include "thread.h"
+#include "thread_flags.h"
 
 #include "net/gnrc.h"
 #include "net/gnrc/nettype.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/netdev.h"
 
 #include "net/gnrc/netdev.h"
@@ -40,6 +43,9 @@
 #define NETDEV_NETAPI_MSG_QUEUE_SIZE 8
 
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _record_src(netdev_t *dev, gnrc_pktsnip_t *pkt);
+#endif
 
 /**
  * @brief   Function called by the device driver on device events
@@ -51,13 +57,25 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
     gnrc_netdev_t *gnrc_netdev = (gnrc_netdev_t*) dev->context;
 
     if (event == NETDEV_EVENT_ISR) {
-        msg_t msg;
+        thread_t *thread = (thread_t *)thread_get(gnrc_netdev->pid);
+        unsigned state = irq_disable();
+        bool pending = (thread->flags & GNRC_NETDEV_FLAG_EVENT);
+
+        thread_flags_set(thread, GNRC_NETDEV_FLAG_EVENT);
+        irq_restore(state);
+        /* the thread handles all pending events at once, so it only needs
+         * to be woken up for the first one */
+        if (!pending) {
+            msg_t msg;
 
-        msg.type = NETDEV_MSG_TYPE_EVENT;
-        msg.content.ptr = gnrc_netdev;
+            msg.type = NETDEV_MSG_TYPE_EVENT;
+            msg.content.ptr = gnrc_netdev;
 
-        if (msg_send(&msg, gnrc_netdev->pid) <= 0) {
-            puts("gnrc_netdev: possibly lost interrupt.");
+            if (msg_send(&msg, gnrc_netdev->pid) <= 0) {
+                /* queue is full => thread checks the flag after its next
+                 * message */
+                DEBUG("gnrc_netdev: unable to send wake-up message\n");
+            }
         }
     }
     else {
@@ -65,25 +83,59 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         switch(event) {
             case NETDEV_EVENT_RX_COMPLETE:
                 {
-                    gnrc_pktsnip_t *pkt = gnrc_netdev->recv(gnrc_netdev);
+                    gnrc_pktsnip_t *pkt;
 
+                    gnrc_pkttrace_enter(GNRC_PKTTRACE_NETDEV, GNRC_PKTTRACE_RX, NULL);
+                    pkt = gnrc_netdev->recv(gnrc_netdev);
                     if (pkt) {
+                        gnrc_pkttrace_stamp(pkt);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                        _record_src(dev, pkt);
+#endif
                         _pass_on_packet(pkt);
                     }
+                    gnrc_pkttrace_exit(GNRC_PKTTRACE_NETDEV, GNRC_PKTTRACE_RX, NULL);
 
                     break;
                 }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&dev->nb_stats, NETSTATS_NB_BUSY);
+#endif
                 break;
             case NETDEV_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&dev->nb_stats, NETSTATS_NB_SUCCESS);
+#endif
+                break;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            case NETDEV_EVENT_TX_NOACK:
+                netstats_nb_update_tx(&dev->nb_stats, NETSTATS_NB_NOACK);
                 break;
 #endif
             default:
                 DEBUG("gnrc_netdev: warning: unhandled event %u.\n", event);
         }
+#ifdef MODULE_GNRC_NETDEV_TXSTATUS
+        gnrc_netdev_txstatus_event(dev, gnrc_netdev->pid, &gnrc_netdev->tx_dst,
+                                   event);
+#endif
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+        if ((gnrc_netdev->tx_end != NULL) &&
+            ((event == NETDEV_EVENT_TX_COMPLETE) ||
+             (event == NETDEV_EVENT_TX_NOACK) ||
+             (event == NETDEV_EVENT_TX_MEDIUM_BUSY))) {
+            gnrc_netdev->tx_end(gnrc_netdev);
+        }
+#endif
     }
 }
 
@@ -97,6 +149,112 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/* the device reports the result of the transmission without the destination */
+static void _record_dst(netdev_t *dev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    if ((hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (hdr->dst_l2addr_len > NETSTATS_NB_L2_ADDR_MAX)) {
+        netstats_nb_record(&dev->nb_stats, NULL, 0);
+    }
+    else {
+        netstats_nb_record(&dev->nb_stats, gnrc_netif_hdr_get_dst_addr(hdr),
+                           hdr->dst_l2addr_len);
+    }
+}
+
+/* received frames are attributed to their source */
+static void _record_src(netdev_t *dev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    gnrc_netif_hdr_t *hdr;
+
+    if (netif == NULL) {
+        return;
+    }
+    hdr = netif->data;
+    if ((hdr->src_l2addr_len > 0) && (hdr->src_l2addr_len <= NETSTATS_NB_L2_ADDR_MAX)) {
+        netstats_nb_update_rx(&dev->nb_stats, gnrc_netif_hdr_get_src_addr(hdr),
+                              hdr->src_l2addr_len, hdr->rssi, hdr->lqi);
+    }
+}
+#endif
+
+static inline void _transmit(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pkttrace_enter(GNRC_PKTTRACE_NETDEV, GNRC_PKTTRACE_TX, pkt);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    _record_dst(gnrc_netdev->dev, pkt);
+#endif
+#ifdef MODULE_GNRC_NETDEV_TXSTATUS
+    gnrc_netdev_txstatus_sent(&gnrc_netdev->tx_dst, pkt);
+#endif
+    gnrc_netdev->send(gnrc_netdev, pkt);
+    gnrc_pkttrace_exit(GNRC_PKTTRACE_NETDEV, GNRC_PKTTRACE_TX, NULL);
+}
+
+static inline void _send(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_NETDEV_QOS
+    if (gnrc_netdev_qos_push(&gnrc_netdev->qos, pkt) < 0) {
+        DEBUG("gnrc_netdev: transmit queue full, dropping packet\n");
+        gnrc_pktbuf_release_error(pkt, ENOBUFS);
+    }
+#else
+    _transmit(gnrc_netdev, pkt);
+#endif
+}
+
+/**
+ * @brief   Handles the pending device events, if any
+ *
+ * @return  true, if there were pending events
+ */
+static inline bool _handle_events(netdev_t *dev)
+{
+    if (thread_flags_clear(GNRC_NETDEV_FLAG_EVENT)) {
+        dev->driver->isr(dev);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief   Gets or sets each option of a bulk request
+ *
+ * @return  the number of options handled successfully
+ */
+static uint32_t _get_set_multi(netdev_t *dev, gnrc_netapi_opts_t *opts,
+                               bool get)
+{
+    uint32_t ok = 0;
+
+    for (unsigned i = 0; i < opts->numof; i++) {
+        gnrc_netapi_opt_t *opt = &opts->opts[i];
+
+        if (get) {
+            opts->res[i] = dev->driver->get(dev, opt->opt, opt->data,
+                                            opt->data_len);
+        }
+        else {
+            opts->res[i] = dev->driver->set(dev, opt->opt, opt->data,
+                                            opt->data_len);
+        }
+        DEBUG("gnrc_netdev: %s %s: %i\n", get ? "get" : "set",
+              netopt2str(opt->opt), opts->res[i]);
+        if (opts->res[i] >= 0) {
+            ok++;
+        }
+    }
+    return ok;
+}
+
 /**
  * @brief   Startup code and event loop of the gnrc_netdev layer
  *
@@ -129,21 +287,57 @@ static void *_gnrc_netdev_thread(void *args)
 
     /* initialize low-level driver */
     dev->driver->init(dev);
+#ifdef MODULE_GNRC_NETDEV_QOS
+    gnrc_netdev_qos_init(&gnrc_netdev->qos);
+#endif
+#ifdef MODULE_GNRC_NETDEV_TXSTATUS
+    gnrc_netdev_txstatus_init(dev);
+#endif
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+    if (gnrc_netdev->tx_end != NULL) {
+        /* the device returns to its receive channel on the end of the
+         * transmission */
+        netopt_enable_t enable = NETOPT_ENABLE;
+
+        dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+    }
+#endif
 
     /* start the event loop */
     while (1) {
+        /* events might have been signaled while the message queue was full */
+        if (_handle_events(dev)) {
+            continue;
+        }
+#ifdef MODULE_GNRC_NETDEV_QOS
+        /* only transmit when no message is pending, so packets that arrived
+         * in between get sorted into their class first */
+        gnrc_pktsnip_t *next;
+        if ((msg_avail() == 0) && (next = gnrc_netdev_qos_pop(&gnrc_netdev->qos))) {
+            _transmit(gnrc_netdev, next);
+            continue;
+        }
+#endif
         DEBUG("gnrc_netdev: waiting for incoming messages\n");
         msg_receive(&msg);
         /* dispatch NETDEV and NETAPI messages */
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netdev: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
+                _handle_events(dev);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 gnrc_pktsnip_t *pkt = msg.content.ptr;
-                gnrc_netdev->send(gnrc_netdev, pkt);
+                _send(gnrc_netdev, pkt);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_TRAIN:
+                DEBUG("gnrc_netdev: GNRC_NETAPI_MSG_TYPE_SND_TRAIN received\n");
+                gnrc_pktsnip_t *train = msg.content.ptr;
+                for (unsigned i = 0; i < gnrc_netapi_train_len(train); i++) {
+                    _send(gnrc_netdev, gnrc_netapi_train_get(train, i));
+                }
+                gnrc_pktbuf_release(train);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
                 /* read incoming options */
@@ -171,6 +365,13 @@ static void *_gnrc_netdev_thread(void *args)
                 reply.content.value = (uint32_t)res;
                 msg_reply(&msg, &reply);
                 break;
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = _get_set_multi(dev, msg.content.ptr,
+                        msg.type == GNRC_NETAPI_MSG_TYPE_GET_MULTI);
+                msg_reply(&msg, &reply);
+                break;
             default:
                 DEBUG("gnrc_netdev: Unknown command %" PRIu16 "\n", msg.type);
                 break;
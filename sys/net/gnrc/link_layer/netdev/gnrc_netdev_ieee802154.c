@@ -14,6 +14,7 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include "od.h"
 #include "net/l2filter.h"
@@ -21,15 +22,30 @@
 #include "net/ieee802154.h"
 
 #include "net/gnrc/netdev/ieee802154.h"
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+#include "xtimer.h"
+#endif
+#ifdef MODULE_RANDOM_POOL
+#include "random_pool.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev);
 static int _send(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt);
+static int _send_frame(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt,
+                       uint8_t frame_pend);
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+static void _indirect_poll(gnrc_netdev_t *gnrc_netdev, const uint8_t *addr,
+                           size_t addr_len);
+#endif
 #if MODULE_GNRC_LASMAC
 static int _send_dataReq(gnrc_netdev_t *gnrc_netdev);
 #endif
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+static void _tx_end(gnrc_netdev_t *gnrc_netdev);
+#endif
 int gnrc_netdev_ieee802154_init(gnrc_netdev_t *gnrc_netdev,
                                 netdev_ieee802154_t *dev)
 {
@@ -39,6 +55,16 @@ int gnrc_netdev_ieee802154_init(gnrc_netdev_t *gnrc_netdev,
 #endif
     gnrc_netdev->recv = _recv;
     gnrc_netdev->dev = (netdev_t *)dev;
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+    gnrc_netdev->tx_end = _tx_end;
+    netdev_ieee802154_chan_init(dev);
+#endif
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+    gnrc_netdev_indirect_init(&gnrc_netdev->indirect);
+#endif
+#ifdef MODULE_IEEE802154_SECURITY
+    ieee802154_sec_init(&dev->sec_ctx);
+#endif
 
     return 0;
 }
@@ -91,6 +117,10 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_RANDOM_POOL
+        /* the low bits of RSSI and LQI and the arrival time are noisy */
+        random_pool_add_sample(((uint32_t)rx_info.rssi << 8) | rx_info.lqi);
+#endif
         if (!(state->flags & NETDEV_IEEE802154_RAW)) {
             gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
             gnrc_netif_hdr_t *hdr;
@@ -104,6 +134,22 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
+#ifdef MODULE_IEEE802154_SECURITY
+            if (((uint8_t *)pkt->data)[0] & IEEE802154_FCF_SECURITY_EN) {
+                /* mhr_len grows by the auxiliary security header */
+                int res = ieee802154_sec_decrypt_frame(&state->sec_ctx,
+                                                       pkt->data, nread,
+                                                       &mhr_len);
+
+                if (res < 0) {
+                    DEBUG("_recv_ieee802154: dropping insecure frame (%d)\n",
+                          res);
+                    gnrc_pktbuf_release(pkt);
+                    return NULL;
+                }
+                nread = mhr_len + res;
+            }
+#endif
             nread -= mhr_len;
             /* mark IEEE 802.15.4 header */
             ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
@@ -130,6 +176,18 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 return NULL;
             }
 #endif
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+            if (((((uint8_t *)ieee802154_hdr->data)[0] & IEEE802154_FCF_TYPE_MASK) ==
+                 IEEE802154_FCF_TYPE_MACCMD) && (nread > 0) &&
+                (((uint8_t *)pkt->data)[0] == IEEE802154_CMD_DATA_REQ)) {
+                /* data requests are answered here and not passed up */
+                _indirect_poll(gnrc_netdev, gnrc_netif_hdr_get_src_addr(hdr),
+                               hdr->src_l2addr_len);
+                gnrc_pktbuf_release(pkt);
+                gnrc_pktbuf_release(netif_hdr);
+                return NULL;
+            }
+#endif
 
             hdr->lqi = rx_info.lqi;
             hdr->rssi = rx_info.rssi;
@@ -156,20 +214,182 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
     return pkt;
 }
 
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+static void _pending_update(gnrc_netdev_t *gnrc_netdev,
+                            gnrc_netdev_indirect_child_t *child, bool pending)
+{
+    netdev_t *netdev = gnrc_netdev->dev;
+    gnrc_netdev_indirect_t *indirect = &gnrc_netdev->indirect;
+    netopt_enable_t enable;
+
+    if (pending) {
+        indirect->pending++;
+        if (indirect->pending_src) {
+            if (netdev->driver->set(netdev, NETOPT_ACK_PENDING_SRC,
+                                    child->addr, child->addr_len) >= 0) {
+                return;
+            }
+            /* no (room in the) source address table of the device, tell all
+             * children from now on */
+            DEBUG("_pending_update: frame pending for all children\n");
+            indirect->pending_src = false;
+        }
+        else if (indirect->pending > 1) {
+            return;
+        }
+    }
+    else {
+        indirect->pending--;
+        /* also removes children added before falling back */
+        netdev->driver->set(netdev, NETOPT_ACK_PENDING_SRC_RM,
+                            child->addr, child->addr_len);
+        if (indirect->pending_src || (indirect->pending > 0)) {
+            return;
+        }
+    }
+    enable = (indirect->pending > 0) ? NETOPT_ENABLE : NETOPT_DISABLE;
+    netdev->driver->set(netdev, NETOPT_ACK_PENDING, &enable, sizeof(enable));
+}
+
+static void _indirect_expire(gnrc_netdev_t *gnrc_netdev, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_NETDEV_INDIRECT_CHILDREN; i++) {
+        gnrc_netdev_indirect_child_t *child = &gnrc_netdev->indirect.children[i];
+        gnrc_pktsnip_t *pkt;
+
+        if ((child->addr_len == 0) || !gnrc_netdev_indirect_expired(child, now)) {
+            continue;
+        }
+        DEBUG("_indirect_expire: child did not poll, dropping %u packets\n",
+              (unsigned)child->numof);
+        if (child->numof > 0) {
+            while ((pkt = gnrc_netdev_indirect_pop(child)) != NULL) {
+                gnrc_pktbuf_release_error(pkt, ETIMEDOUT);
+            }
+            _pending_update(gnrc_netdev, child, false);
+        }
+        child->addr_len = 0;
+    }
+}
+
+static bool _indirect_queue(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr;
+    gnrc_netdev_indirect_child_t *child;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return false;
+    }
+    netif_hdr = pkt->data;
+    if (netif_hdr->flags &
+        (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return false;
+    }
+    _indirect_expire(gnrc_netdev, xtimer_now_usec());
+    child = gnrc_netdev_indirect_get(&gnrc_netdev->indirect,
+                                     gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                     netif_hdr->dst_l2addr_len);
+    if (child == NULL) {
+        return false;
+    }
+    if (gnrc_netdev_indirect_push(child, pkt) < 0) {
+        DEBUG("_send_ieee802154: indirect queue full, dropping packet\n");
+        gnrc_pktbuf_release_error(pkt, ENOBUFS);
+    }
+    else if (child->numof == 1) {
+        _pending_update(gnrc_netdev, child, true);
+    }
+    return true;
+}
+
+static void _indirect_poll(gnrc_netdev_t *gnrc_netdev, const uint8_t *addr,
+                           size_t addr_len)
+{
+    gnrc_netdev_indirect_t *indirect = &gnrc_netdev->indirect;
+    gnrc_netdev_indirect_child_t *child;
+    gnrc_pktsnip_t *pkt = NULL;
+    uint32_t now = xtimer_now_usec();
+
+    _indirect_expire(gnrc_netdev, now);
+    child = gnrc_netdev_indirect_poll(indirect, addr, addr_len, now);
+    if (child != NULL) {
+        pkt = gnrc_netdev_indirect_pop(child);
+    }
+    else {
+        DEBUG("_indirect_poll: no room for another child\n");
+    }
+    if (pkt != NULL) {
+        if (child->numof == 0) {
+            _pending_update(gnrc_netdev, child, false);
+        }
+        _send_frame(gnrc_netdev, pkt,
+                    (child->numof > 0) ? IEEE802154_FCF_FRAME_PEND : 0);
+    }
+    else if (!indirect->pending_src && (indirect->pending > 0)) {
+        /* the ACK told the child to wait for a frame, so let it go back to
+         * sleep with an empty one */
+        pkt = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)addr, addr_len);
+        if (pkt != NULL) {
+            _send_frame(gnrc_netdev, pkt, 0);
+        }
+    }
+}
+#endif
+
+#ifdef MODULE_IEEE802154_SECURITY
+/* puts the payload behind the headers in frame and secures it in place */
+static int _secure_frame(netdev_ieee802154_t *state, uint8_t *frame,
+                         size_t mhr_len, gnrc_pktsnip_t *payload)
+{
+    size_t pos = mhr_len +
+                 ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX);
+    size_t payload_len = gnrc_pkt_len(payload);
+
+    if ((pos + payload_len + ieee802154_sec_mic_len(state->sec_ctx.level)) >
+        (IEEE802154_FRAME_LEN_MAX - IEEE802154_FCS_LEN)) {
+        return -EMSGSIZE;
+    }
+    for (; payload != NULL; payload = payload->next) {
+        memcpy(&frame[pos], payload->data, payload->size);
+        pos += payload->size;
+    }
+    return ieee802154_sec_encrypt_frame(&state->sec_ctx, frame, mhr_len,
+                                        payload_len, state->long_addr);
+}
+#endif
+
 static int _send(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_NETDEV_INDIRECT
+    if (_indirect_queue(gnrc_netdev, pkt)) {
+        return 0;
+    }
+#endif
+    return _send_frame(gnrc_netdev, pkt, 0);
+}
+
+static int _send_frame(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt,
+                       uint8_t frame_pend)
 {
     netdev_t *netdev = gnrc_netdev->dev;
     netdev_ieee802154_t *state = (netdev_ieee802154_t *)gnrc_netdev->dev;
     gnrc_netif_hdr_t *netif_hdr;
     gnrc_pktsnip_t *vec_snip;
+    struct iovec *vector;
     const uint8_t *src, *dst = NULL;
     int res = 0;
     size_t n, src_len, dst_len;
+#ifdef MODULE_IEEE802154_SECURITY
+    /* takes the whole frame, when it is secured */
+    uint8_t mhr[IEEE802154_FRAME_LEN_MAX];
+    struct iovec secured;
+#else
     uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+#endif
     uint8_t flags = (uint8_t)(state->flags & NETDEV_IEEE802154_SEND_MASK);
     le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
 
-    flags |= IEEE802154_FCF_TYPE_DATA;
+    flags |= IEEE802154_FCF_TYPE_DATA | frame_pend;
     if (pkt == NULL) {
         DEBUG("_send_ieee802154: pkt was NULL\n");
         return -EINVAL;
@@ -209,42 +429,73 @@ static int _send(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
         return -EINVAL;
     }
     /* prepare packet for sending */
-    vec_snip = gnrc_pktbuf_get_iovec(pkt, &n);
-    if (vec_snip != NULL) {
-        struct iovec *vector;
-
+#ifdef MODULE_IEEE802154_SECURITY
+    if (flags & IEEE802154_FCF_SECURITY_EN) {
+        /* the secured frame is sent from mhr as a whole */
+        if ((res = _secure_frame(state, mhr, res, pkt->next)) < 0) {
+            DEBUG("_send_ieee802154: unable to secure frame (%d)\n", res);
+            gnrc_pktbuf_release_error(pkt, -res);
+            return res;
+        }
+        secured.iov_base = mhr;
+        secured.iov_len = (size_t)res;
+        vector = &secured;
+        n = 1;
+    }
+    else
+#endif
+    if ((vec_snip = gnrc_pktbuf_get_iovec(pkt, &n)) != NULL) {
         pkt = vec_snip;     /* reassign for later release; vec_snip is prepended to pkt */
         vector = (struct iovec *)pkt->data;
         vector[0].iov_base = mhr;
         vector[0].iov_len = (size_t)res;
+    }
+    else {
+        return -ENOBUFS;
+    }
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
         (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
-            gnrc_netdev->dev->stats.tx_mcast_count++;
-        }
-        else {
-            gnrc_netdev->dev->stats.tx_unicast_count++;
-        }
+        gnrc_netdev->dev->stats.tx_mcast_count++;
+    }
+    else {
+        gnrc_netdev->dev->stats.tx_unicast_count++;
+    }
 #endif
-#ifdef MODULE_GNRC_MAC
-        if (gnrc_netdev->mac_info & GNRC_NETDEV_MAC_INFO_CSMA_ENABLED) {
-            res = csma_sender_csma_ca_send(netdev, vector, n, &gnrc_netdev->csma_conf);
-        }
-        else {
-            res = netdev->driver->send(netdev, vector, n);
-        }
-#else
-        res = netdev->driver->send(netdev, vector, n);
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+    /* before the channel access, so CCA is done on the destination's channel */
+    if (netdev_ieee802154_chan_tx_begin(state, dst, dst_len) < 0) {
+        DEBUG("_send_ieee802154: unable to switch to channel of destination\n");
+    }
 #endif
+#ifdef MODULE_GNRC_MAC
+    if (gnrc_netdev->mac_info & GNRC_NETDEV_MAC_INFO_CSMA_ENABLED) {
+        res = csma_sender_csma_ca_send(netdev, vector, n, &gnrc_netdev->csma_conf);
     }
     else {
-        return -ENOBUFS;
+        res = netdev->driver->send(netdev, vector, n);
     }
+#else
+    res = netdev->driver->send(netdev, vector, n);
+#endif
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+    if (res < 0) {
+        /* no event will end this transmission */
+        netdev_ieee802154_chan_tx_end(state);
+    }
+#endif
     /* release old data */
     gnrc_pktbuf_release(pkt);
     return res;
 }
 
+#ifdef MODULE_NETDEV_IEEE802154_MULTICHANNEL
+static void _tx_end(gnrc_netdev_t *gnrc_netdev)
+{
+    netdev_ieee802154_chan_tx_end((netdev_ieee802154_t *)gnrc_netdev->dev);
+}
+#endif
+
 #ifdef MODULE_GNRC_LASMAC
 static int _send_dataReq(gnrc_netdev_t *gnrc_netdev) 
 {
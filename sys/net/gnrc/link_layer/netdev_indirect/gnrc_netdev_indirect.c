@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_netdev_indirect
+ * @{
+ *
+ * @file
+ * @brief       Table of sleepy children and their packet queues
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netdev/indirect.h"
+
+void gnrc_netdev_indirect_init(gnrc_netdev_indirect_t *indirect)
+{
+    memset(indirect, 0, sizeof(gnrc_netdev_indirect_t));
+    /* until the driver tells otherwise */
+    indirect->pending_src = true;
+}
+
+gnrc_netdev_indirect_child_t *gnrc_netdev_indirect_get(gnrc_netdev_indirect_t *indirect,
+                                                       const uint8_t *addr,
+                                                       size_t addr_len)
+{
+    for (unsigned i = 0; i < GNRC_NETDEV_INDIRECT_CHILDREN; i++) {
+        gnrc_netdev_indirect_child_t *child = &indirect->children[i];
+
+        if ((child->addr_len != 0) && (child->addr_len == addr_len) &&
+            (memcmp(child->addr, addr, addr_len) == 0)) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+gnrc_netdev_indirect_child_t *gnrc_netdev_indirect_poll(gnrc_netdev_indirect_t *indirect,
+                                                        const uint8_t *addr,
+                                                        size_t addr_len,
+                                                        uint32_t now)
+{
+    gnrc_netdev_indirect_child_t *child;
+
+    if ((addr_len == 0) || (addr_len > IEEE802154_LONG_ADDRESS_LEN)) {
+        return NULL;
+    }
+    child = gnrc_netdev_indirect_get(indirect, addr, addr_len);
+    for (unsigned i = 0; (child == NULL) && (i < GNRC_NETDEV_INDIRECT_CHILDREN); i++) {
+        gnrc_netdev_indirect_child_t *tmp = &indirect->children[i];
+
+        if ((tmp->addr_len == 0) ||
+            ((tmp->numof == 0) && gnrc_netdev_indirect_expired(tmp, now))) {
+            child = tmp;
+            memcpy(child->addr, addr, addr_len);
+            child->addr_len = addr_len;
+            child->head = 0;
+            child->numof = 0;
+        }
+    }
+    if (child != NULL) {
+        child->last_poll = now;
+    }
+    return child;
+}
+
+int gnrc_netdev_indirect_push(gnrc_netdev_indirect_child_t *child,
+                              gnrc_pktsnip_t *pkt)
+{
+    if (child->numof >= GNRC_NETDEV_INDIRECT_QUEUE_SIZE) {
+        return -ENOBUFS;
+    }
+    child->queue[(child->head + child->numof) % GNRC_NETDEV_INDIRECT_QUEUE_SIZE] = pkt;
+    child->numof++;
+    return 0;
+}
+
+gnrc_pktsnip_t *gnrc_netdev_indirect_pop(gnrc_netdev_indirect_child_t *child)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (child->numof == 0) {
+        return NULL;
+    }
+    pkt = child->queue[child->head];
+    child->head = (child->head + 1) % GNRC_NETDEV_INDIRECT_QUEUE_SIZE;
+    child->numof--;
+    return pkt;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_netdev_qos
+ * @{
+ *
+ * @file
+ * @brief       Multi-class transmit queue implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netdev/qos.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static const uint8_t _limits[GNRC_NETDEV_QOS_NUMOF] = GNRC_NETDEV_QOS_LIMITS;
+#ifdef GNRC_NETDEV_QOS_WEIGHTS
+static const uint8_t _weights[GNRC_NETDEV_QOS_NUMOF] = GNRC_NETDEV_QOS_WEIGHTS;
+#endif
+
+static gnrc_netdev_qos_class_t _dscp_class(uint8_t dscp)
+{
+    if (dscp >= GNRC_NETDEV_QOS_DSCP_CS6) {
+        return GNRC_NETDEV_QOS_CONTROL;
+    }
+    if (dscp == GNRC_NETDEV_QOS_DSCP_EF) {
+        return GNRC_NETDEV_QOS_LATENCY;
+    }
+    return GNRC_NETDEV_QOS_BULK;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN
+/* gets the DSCP of a 6LoWPAN dispatch: inline in IPHC (RFC 6282, 3.1.1) for
+ * TF = 00 or 10, elided (0) otherwise */
+static uint8_t _sixlowpan_dscp(const uint8_t *data, size_t size)
+{
+    if ((size > sizeof(ipv6_hdr_t)) && (data[0] == SIXLOWPAN_UNCOMP)) {
+        return ipv6_hdr_get_tc_dscp((ipv6_hdr_t *)(data + 1));
+    }
+    if ((size >= 3) && sixlowpan_iphc_is((uint8_t *)data) &&
+        ((data[0] & 0x08) == 0)) {
+        /* ECN and DSCP follow the base header and the optional CID byte */
+        unsigned pos = (data[1] & SIXLOWPAN_IPHC2_CID_EXT) ? 3 : 2;
+
+        if (pos < size) {
+            return data[pos] & 0x3f;
+        }
+    }
+    return 0;
+}
+#endif
+
+gnrc_netdev_qos_class_t gnrc_netdev_qos_classify(gnrc_pktsnip_t *pkt)
+{
+    for (; pkt != NULL; pkt = pkt->next) {
+        switch (pkt->type) {
+#ifdef MODULE_GNRC_ICMPV6
+            case GNRC_NETTYPE_ICMPV6:
+                return GNRC_NETDEV_QOS_CONTROL;
+#endif
+#ifdef MODULE_GNRC_IPV6
+            case GNRC_NETTYPE_IPV6:
+                if (pkt->size >= sizeof(ipv6_hdr_t)) {
+                    gnrc_netdev_qos_class_t cls;
+
+                    cls = _dscp_class(ipv6_hdr_get_tc_dscp(pkt->data));
+                    if (cls != GNRC_NETDEV_QOS_BULK) {
+                        return cls;
+                    }
+                }
+                break;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN
+            case GNRC_NETTYPE_SIXLOWPAN: {
+                gnrc_netdev_qos_class_t cls;
+
+                cls = _dscp_class(_sixlowpan_dscp(pkt->data, pkt->size));
+                if (cls != GNRC_NETDEV_QOS_BULK) {
+                    return cls;
+                }
+                break;
+            }
+#endif
+            default:
+                break;
+        }
+    }
+    return GNRC_NETDEV_QOS_BULK;
+}
+
+void gnrc_netdev_qos_init(gnrc_netdev_qos_t *qos)
+{
+    memset(qos, 0, sizeof(gnrc_netdev_qos_t));
+    for (unsigned i = 0; i < GNRC_NETDEV_QOS_NUMOF; i++) {
+        gnrc_priority_pktqueue_init(&qos->queues[i]);
+#ifdef GNRC_NETDEV_QOS_WEIGHTS
+        qos->credit[i] = _weights[i];
+#endif
+    }
+}
+
+int gnrc_netdev_qos_push(gnrc_netdev_qos_t *qos, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netdev_qos_class_t cls = gnrc_netdev_qos_classify(pkt);
+    gnrc_priority_pktqueue_node_t *node = NULL;
+
+    if (qos->len[cls] < _limits[cls]) {
+        for (unsigned i = 0; i < GNRC_NETDEV_QOS_QUEUE_SIZE; i++) {
+            if (qos->nodes[i].pkt == NULL) {
+                node = &qos->nodes[i];
+                break;
+            }
+        }
+    }
+    if (node == NULL) {
+        DEBUG("gnrc_netdev_qos: queue for class %u full\n", (unsigned)cls);
+        qos->drops[cls]++;
+        return -ENOBUFS;
+    }
+    /* all nodes of a class share one priority => FIFO */
+    gnrc_priority_pktqueue_node_init(node, 0, pkt);
+    gnrc_priority_pktqueue_push(&qos->queues[cls], node);
+    qos->len[cls]++;
+    return 0;
+}
+
+static int _next_class(gnrc_netdev_qos_t *qos)
+{
+#ifdef GNRC_NETDEV_QOS_WEIGHTS
+    for (unsigned round = 0; round < 2; round++) {
+        for (unsigned i = 0; i < GNRC_NETDEV_QOS_NUMOF; i++) {
+            if ((qos->len[i] > 0) && (qos->credit[i] > 0)) {
+                qos->credit[i]--;
+                return i;
+            }
+        }
+        /* all waiting classes used up their credit => start new round */
+        for (unsigned i = 0; i < GNRC_NETDEV_QOS_NUMOF; i++) {
+            qos->credit[i] = _weights[i];
+        }
+    }
+#else
+    for (unsigned i = 0; i < GNRC_NETDEV_QOS_NUMOF; i++) {
+        if (qos->len[i] > 0) {
+            return i;
+        }
+    }
+#endif
+    return -1;
+}
+
+gnrc_pktsnip_t *gnrc_netdev_qos_pop(gnrc_netdev_qos_t *qos)
+{
+    int cls = _next_class(qos);
+
+    if (cls < 0) {
+        return NULL;
+    }
+    qos->len[cls]--;
+    return gnrc_priority_pktqueue_pop(&qos->queues[cls]);
+}
+
+void gnrc_netdev_qos_flush(gnrc_netdev_qos_t *qos)
+{
+    for (unsigned i = 0; i < GNRC_NETDEV_QOS_NUMOF; i++) {
+        gnrc_priority_pktqueue_flush(&qos->queues[i]);
+        qos->len[i] = 0;
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_netdev_txstatus
+ * @file
+ * @brief       Link layer transmission status implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/netdev/txstatus.h"
+#include "net/netopt.h"
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_netdev_txstatus_sub_t *_subs;
+static mutex_t _lock = MUTEX_INIT;
+
+void gnrc_netdev_txstatus_subscribe(gnrc_netdev_txstatus_sub_t *sub)
+{
+    mutex_lock(&_lock);
+    sub->next = _subs;
+    _subs = sub;
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netdev_txstatus_unsubscribe(gnrc_netdev_txstatus_sub_t *sub)
+{
+    mutex_lock(&_lock);
+    for (gnrc_netdev_txstatus_sub_t **ptr = &_subs; *ptr; ptr = &(*ptr)->next) {
+        if (*ptr == sub) {
+            *ptr = sub->next;
+            break;
+        }
+    }
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netdev_txstatus_init(netdev_t *dev)
+{
+    netopt_enable_t enable = NETOPT_ENABLE;
+
+    if (dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable)) < 0) {
+        DEBUG("gnrc_netdev_txstatus: device can't report the end of TX\n");
+    }
+}
+
+void gnrc_netdev_txstatus_sent(gnrc_netdev_txstatus_dst_t *dst,
+                               const gnrc_pktsnip_t *pkt)
+{
+    const gnrc_netif_hdr_t *hdr;
+
+    dst->addr_len = 0;
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    if ((hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                       GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (hdr->dst_l2addr_len > sizeof(dst->addr))) {
+        return;
+    }
+    memcpy(dst->addr, gnrc_netif_hdr_get_dst_addr((gnrc_netif_hdr_t *)hdr),
+           hdr->dst_l2addr_len);
+    dst->addr_len = hdr->dst_l2addr_len;
+}
+
+void gnrc_netdev_txstatus_event(netdev_t *dev, kernel_pid_t iface,
+                                const gnrc_netdev_txstatus_dst_t *dst,
+                                netdev_event_t event)
+{
+    gnrc_netdev_txstatus_t status;
+    uint8_t retries;
+
+    switch (event) {
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            status.result = GNRC_NETDEV_TXSTATUS_SUCCESS;
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            status.result = GNRC_NETDEV_TXSTATUS_NOACK;
+            break;
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            status.result = GNRC_NETDEV_TXSTATUS_BUSY;
+            break;
+        case NETDEV_EVENT_TX_TIMEOUT:
+            status.result = GNRC_NETDEV_TXSTATUS_TIMEOUT;
+            break;
+        default:
+            return;
+    }
+    if (_subs == NULL) {
+        return;
+    }
+
+    status.iface = iface;
+    status.retries = GNRC_NETDEV_TXSTATUS_RETRIES_UNKNOWN;
+    if (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                         sizeof(retries)) == sizeof(retries)) {
+        status.retries = retries;
+    }
+#ifdef MODULE_XTIMER
+    status.timestamp = xtimer_now_usec();
+#else
+    status.timestamp = 0;
+#endif
+    status.dst_l2addr_len = dst->addr_len;
+    memcpy(status.dst_l2addr, dst->addr, dst->addr_len);
+    DEBUG("gnrc_netdev_txstatus: %" PRIkernel_pid ": result %u, retries %u\n",
+          iface, status.result, status.retries);
+
+    mutex_lock(&_lock);
+    for (gnrc_netdev_txstatus_sub_t *sub = _subs; sub; sub = sub->next) {
+        sub->cb(&status, sub->arg);
+    }
+    mutex_unlock(&_lock);
+}
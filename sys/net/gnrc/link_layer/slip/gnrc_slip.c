@@ -144,6 +144,38 @@ static inline void _slip_send_char(gnrc_slip_dev_t *dev, char c)
     uart_write(dev->uart, (uint8_t *)&c, 1);
 }
 
+static void _slip_send_escaped(gnrc_slip_dev_t *dev, const uint8_t *data, size_t len)
+{
+    static const uint8_t end_esc[] = { _SLIP_ESC, _SLIP_END_ESC };
+    static const uint8_t esc_esc[] = { _SLIP_ESC, _SLIP_ESC_ESC };
+    const uint8_t *start = data, *end = data + len;
+
+    for (; data < end; data++) {
+        const uint8_t *esc;
+
+        if (*data == (uint8_t)_SLIP_END) {
+            DEBUG("slip: encountered END byte on send: stuff with ESC\n");
+            esc = end_esc;
+        }
+        else if (*data == (uint8_t)_SLIP_ESC) {
+            DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
+            esc = esc_esc;
+        }
+        else {
+            continue;
+        }
+        /* write everything up to the special byte in one go */
+        if (data > start) {
+            uart_write(dev->uart, start, data - start);
+        }
+        uart_write(dev->uart, esc, 2);
+        start = data + 1;
+    }
+    if (end > start) {
+        uart_write(dev->uart, start, end - start);
+    }
+}
+
 /* SLIP send handler */
 static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
 {
@@ -153,29 +185,7 @@ static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
 
     while (ptr != NULL) {
         DEBUG("slip: send pktsnip of length %u over UART_%d\n", (unsigned)ptr->size, dev->uart);
-        char *data = ptr->data;
-
-        for (size_t i = 0; i < ptr->size; i++) {
-            switch (data[i]) {
-                case _SLIP_END:
-                    DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
-                    break;
-
-                case _SLIP_ESC:
-                    DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
-                    break;
-
-                default:
-                    _slip_send_char(dev, data[i]);
-
-                    break;
-            }
-        }
-
+        _slip_send_escaped(dev, ptr->data, ptr->size);
         ptr = ptr->next;
     }
 
@@ -235,6 +245,14 @@ static void *_slip(void *args)
                 DEBUG("slip: I don't support this but have to reply.\n");
                 msg_reply(&msg, &reply);
                 break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                /* the caller falls back to single options */
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
         }
     }
 
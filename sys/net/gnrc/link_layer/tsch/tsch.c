@@ -0,0 +1,840 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Implementation of TSCH
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "irq.h"
+#include "kernel_types.h"
+#include "log.h"
+#include "msg.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "periph/timer.h"
+#include "net/gnrc.h"
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+#include "net/gnrc/netdev.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/gnrc/tsch.h"
+#include "net/gnrc/tsch/eb.h"
+#include "net/gnrc/tsch/schedule.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @name    Message types of the TSCH thread
+ * @{
+ */
+#define GNRC_TSCH_EVENT_SLOT        (0x4500)    /**< a timeslot started */
+#define GNRC_TSCH_EVENT_OFFSET      (0x4501)    /**< offset in the timeslot reached */
+#define GNRC_TSCH_EVENT_SCAN        (0x4502)    /**< scan the next channel */
+/** @} */
+
+/**
+ * @name    Actions in a timeslot
+ * @{
+ */
+#define GNRC_TSCH_SLOT_SLEEP        (0U)        /**< radio is off */
+#define GNRC_TSCH_SLOT_TX           (1U)        /**< waiting for the TX offset */
+#define GNRC_TSCH_SLOT_TX_WAIT      (2U)        /**< waiting for the end of a
+                                                 *   transmission */
+#define GNRC_TSCH_SLOT_RX           (3U)        /**< listening */
+/** @} */
+
+#define US_TO_TICKS(us)     ((uint32_t)(((uint64_t)(us) * GNRC_TSCH_TIMER_FREQ) / US_PER_SEC))
+#define SLOT_TICKS          US_TO_TICKS(GNRC_TSCH_TIMESLOT_US)
+#define EB_PERIOD_SLOTS     (GNRC_TSCH_EB_PERIOD_US / GNRC_TSCH_TIMESLOT_US)
+#define DESYNC_SLOTS        (GNRC_TSCH_DESYNC_TIMEOUT_US / GNRC_TSCH_TIMESLOT_US)
+
+/* O-QPSK in the 2.4 GHz band sends a byte in 32us, a frame is preceded by the
+ * preamble, the SFD and the PHR */
+#define BYTE_US             (32U)
+#define PHY_HDR_LEN         (6U)
+
+static xtimer_t _scan_timer;
+static msg_t _scan_msg = { .type = GNRC_TSCH_EVENT_SCAN };
+
+static void _timer_cb(void *arg, int channel)
+{
+    gnrc_netdev_t *gnrc_netdev = arg;
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    msg_t msg;
+
+    if (channel == 0) {
+        tsch->asn++;
+        tsch->slot_start += SLOT_TICKS;
+        timer_set_absolute(GNRC_TSCH_TIMER_DEV, 0, tsch->slot_start + SLOT_TICKS);
+        msg.type = GNRC_TSCH_EVENT_SLOT;
+    }
+    else {
+        msg.type = GNRC_TSCH_EVENT_OFFSET;
+    }
+    /* lets the thread detect events of timeslots that already ended */
+    msg.content.value = (uint32_t)tsch->asn;
+    if (msg_send(&msg, gnrc_netdev->pid) <= 0) {
+        LOG_WARNING("WARNING: [TSCH] possibly lost timer event\n");
+    }
+}
+
+static void _set_state(gnrc_netdev_t *gnrc_netdev, netopt_state_t state)
+{
+    gnrc_netdev->dev->driver->set(gnrc_netdev->dev, NETOPT_STATE, &state,
+                                  sizeof(state));
+}
+
+static void _set_channel(gnrc_netdev_t *gnrc_netdev, uint8_t channel)
+{
+    uint16_t chan = channel;
+
+    gnrc_netdev->dev->driver->set(gnrc_netdev->dev, NETOPT_CHANNEL, &chan,
+                                  sizeof(chan));
+}
+
+static inline uint64_t _get_asn(gnrc_tsch_t *tsch)
+{
+    unsigned state = irq_disable();
+    uint64_t asn = tsch->asn;
+
+    irq_restore(state);
+    return asn;
+}
+
+/* Arms the timer for the next timeslot, skipping those that passed already */
+static void _arm_slot_timer(gnrc_tsch_t *tsch)
+{
+    unsigned state = irq_disable();
+    uint32_t now = timer_read(GNRC_TSCH_TIMER_DEV);
+
+    while ((int32_t)(now - tsch->slot_start) >= (int32_t)SLOT_TICKS) {
+        tsch->slot_start += SLOT_TICKS;
+        tsch->asn++;
+    }
+    timer_set_absolute(GNRC_TSCH_TIMER_DEV, 0, tsch->slot_start + SLOT_TICKS);
+    irq_restore(state);
+}
+
+static void _set_offset_timer(gnrc_tsch_t *tsch, uint32_t offset_us)
+{
+    unsigned state = irq_disable();
+
+    timer_set_absolute(GNRC_TSCH_TIMER_DEV, 1,
+                       tsch->slot_start + US_TO_TICKS(offset_us));
+    irq_restore(state);
+}
+
+static void _schedule_eb(gnrc_tsch_t *tsch, uint64_t asn)
+{
+    tsch->next_eb_asn = asn + EB_PERIOD_SLOTS +
+                        random_uint32_range(0, (EB_PERIOD_SLOTS / 4) + 1);
+}
+
+static void _stop(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    timer_clear(GNRC_TSCH_TIMER_DEV, 0);
+    timer_clear(GNRC_TSCH_TIMER_DEV, 1);
+    xtimer_remove(&_scan_timer);
+    tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+    tsch->eb_pending = 0;
+    tsch->state = GNRC_TSCH_STATE_OFF;
+    _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+}
+
+static void _scan(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    _set_channel(gnrc_netdev, gnrc_tsch_hopping_channel(tsch->scan_channel));
+    _set_state(gnrc_netdev, NETOPT_STATE_IDLE);
+    xtimer_set_msg(&_scan_timer, GNRC_TSCH_SCAN_DWELL_US, &_scan_msg,
+                   gnrc_netdev->pid);
+}
+
+static void _start_scan(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    LOG_INFO("[TSCH] scanning for enhanced beacons\n");
+    _stop(gnrc_netdev);
+    tsch->state = GNRC_TSCH_STATE_SCANNING;
+    _scan(gnrc_netdev);
+}
+
+static void _start_coordinator(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    LOG_INFO("[TSCH] starting network as PAN coordinator\n");
+    _stop(gnrc_netdev);
+    gnrc_tsch_slotframe_init_minimal(&tsch->slotframe);
+    tsch->time_source_len = 0;
+    tsch->join_metric = 0;
+    tsch->asn = 0;
+    tsch->next_eb_asn = 0;
+    tsch->slot_start = timer_read(GNRC_TSCH_TIMER_DEV);
+    tsch->state = GNRC_TSCH_STATE_SYNCED;
+    _arm_slot_timer(tsch);
+}
+
+static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netdev_t *gnrc_netdev,
+                                                 const gnrc_tsch_cell_t *cell)
+{
+    for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        gnrc_mac_tx_neighbor_t *neighbor = &gnrc_netdev->tx.neighbors[i];
+
+        if (gnrc_priority_pktqueue_length(&neighbor->queue) == 0) {
+            continue;
+        }
+        /* dedicated cells are only used for their neighbor, the broadcast
+         * queue is neighbor 0 */
+        if ((cell->l2_addr_len == 0) ||
+            ((i > 0) && (neighbor->l2_addr_len == cell->l2_addr_len) &&
+             (memcmp(neighbor->l2_addr, cell->l2_addr, cell->l2_addr_len) == 0))) {
+            return neighbor;
+        }
+    }
+    return NULL;
+}
+
+/* Decides whether to transmit in the cell */
+static bool _prepare_tx(gnrc_netdev_t *gnrc_netdev, const gnrc_tsch_cell_t *cell,
+                        uint64_t asn)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    gnrc_mac_tx_t *tx = &gnrc_netdev->tx;
+
+    if (!(cell->options & GNRC_TSCH_CELL_OPT_TX)) {
+        return false;
+    }
+    if ((cell->l2_addr_len == 0) && (asn >= tsch->next_eb_asn)) {
+        tsch->eb_pending = 1;
+        return true;
+    }
+    if (tx->packet == NULL) {
+        tx->current_neighbor = _next_tx_neighbor(gnrc_netdev, cell);
+        if (tx->current_neighbor == NULL) {
+            return false;
+        }
+        tx->packet = gnrc_priority_pktqueue_pop(&tx->current_neighbor->queue);
+        tsch->tx_retries = 0;
+        return (tx->packet != NULL);
+    }
+    /* the packet waits for a retransmission */
+    if ((cell->l2_addr_len > 0) &&
+        ((tx->current_neighbor->l2_addr_len != cell->l2_addr_len) ||
+         (memcmp(tx->current_neighbor->l2_addr, cell->l2_addr,
+                 cell->l2_addr_len) != 0))) {
+        return false;
+    }
+    if ((cell->options & GNRC_TSCH_CELL_OPT_SHARED) && (tsch->backoff > 0)) {
+        tsch->backoff--;
+        return false;
+    }
+    return true;
+}
+
+static void _slot(gnrc_netdev_t *gnrc_netdev, uint32_t asn_low)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    uint64_t asn = _get_asn(tsch);
+    const gnrc_tsch_cell_t *cell;
+
+    if ((tsch->state != GNRC_TSCH_STATE_SYNCED) || ((uint32_t)asn != asn_low)) {
+        /* the event is late and a new timeslot started already */
+        return;
+    }
+    if ((tsch->time_source_len > 0) && ((asn - tsch->last_sync_asn) > DESYNC_SLOTS)) {
+        LOG_WARNING("WARNING: [TSCH] lost synchronization to time source\n");
+        _start_scan(gnrc_netdev);
+        return;
+    }
+    if (tsch->slot_action == GNRC_TSCH_SLOT_TX_WAIT) {
+        /* the transmission of the last timeslot never completed */
+        tsch->eb_pending = 0;
+    }
+    tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+    tsch->cell = cell = gnrc_tsch_slotframe_get(&tsch->slotframe, asn);
+    if (cell == NULL) {
+        _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+        return;
+    }
+    _set_state(gnrc_netdev, NETOPT_STATE_IDLE);
+    _set_channel(gnrc_netdev, gnrc_tsch_channel(asn, cell->channel_offset));
+    if (_prepare_tx(gnrc_netdev, cell, asn)) {
+        tsch->slot_action = GNRC_TSCH_SLOT_TX;
+        _set_offset_timer(tsch, GNRC_TSCH_TX_OFFSET_US - GNRC_TSCH_TX_LATENCY_US);
+    }
+    else if (cell->options & GNRC_TSCH_CELL_OPT_RX) {
+        /* the transceiver listens right away, the timer ends the RX window */
+        tsch->slot_action = GNRC_TSCH_SLOT_RX;
+        _set_offset_timer(tsch, GNRC_TSCH_RX_OFFSET_US + GNRC_TSCH_RX_WAIT_US);
+    }
+    else {
+        _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+    }
+}
+
+static int _send_eb(gnrc_netdev_t *gnrc_netdev, uint64_t asn)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)gnrc_netdev->dev;
+    le_uint16_t pan = byteorder_btols(byteorder_htons(state->pan));
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX - IEEE802154_FCS_LEN];
+    gnrc_tsch_eb_t eb = {
+        .asn = asn,
+        .join_metric = tsch->join_metric,
+        .timeslot_id = 0,
+        .hopping_id = 0,
+    };
+    struct iovec vec;
+    size_t len, ie_len;
+
+    len = ieee802154_set_frame_hdr(frame, gnrc_netdev->l2_addr, gnrc_netdev->l2_addr_len,
+                                   ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN,
+                                   pan, pan,
+                                   IEEE802154_FCF_TYPE_BEACON | IEEE802154_FCF_PAN_COMP,
+                                   state->seq++);
+    if (len == 0) {
+        return -EINVAL;
+    }
+    /* enhanced beacons are IEEE 802.15.4-2015 frames with IEs */
+    frame[1] &= ~IEEE802154_FCF_VERS_MASK;
+    frame[1] |= IEEE802154_FCF_VERS_V2 | IEEE802154_FCF_IE_PRESENT;
+    ie_len = gnrc_tsch_eb_write(&frame[len], sizeof(frame) - len, &eb,
+                                &tsch->slotframe);
+    if (ie_len == 0) {
+        return -ENOBUFS;
+    }
+    vec.iov_base = frame;
+    vec.iov_len = len + ie_len;
+    return gnrc_netdev->dev->driver->send(gnrc_netdev->dev, &vec, 1);
+}
+
+static void _offset(gnrc_netdev_t *gnrc_netdev, uint32_t asn_low)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    uint64_t asn = _get_asn(tsch);
+    int res;
+
+    if ((uint32_t)asn != asn_low) {
+        return;
+    }
+    switch (tsch->slot_action) {
+        case GNRC_TSCH_SLOT_TX:
+            tsch->slot_action = GNRC_TSCH_SLOT_TX_WAIT;
+            if (tsch->eb_pending) {
+                res = _send_eb(gnrc_netdev, asn);
+            }
+            else {
+                /* the packet is kept for retransmissions */
+                gnrc_pktbuf_hold(gnrc_netdev->tx.packet, 1);
+                res = gnrc_netdev->send(gnrc_netdev, gnrc_netdev->tx.packet);
+            }
+            if (res < 0) {
+                DEBUG("[TSCH] sending failed: %d\n", res);
+                tsch->eb_pending = 0;
+                tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+                _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+            }
+            break;
+        case GNRC_TSCH_SLOT_RX:
+            if (!gnrc_netdev_get_rx_started(gnrc_netdev)) {
+                tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+                _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void _tx_done(gnrc_netdev_t *gnrc_netdev, gnrc_mac_tx_feedback_t feedback)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    gnrc_mac_tx_t *tx = &gnrc_netdev->tx;
+
+    if (tsch->slot_action != GNRC_TSCH_SLOT_TX_WAIT) {
+        return;
+    }
+    tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+    _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+    if (tsch->eb_pending) {
+        tsch->eb_pending = 0;
+        _schedule_eb(tsch, _get_asn(tsch));
+        return;
+    }
+    if (tx->packet == NULL) {
+        return;
+    }
+    if ((feedback == TX_FEEDBACK_NOACK) || (feedback == TX_FEEDBACK_BUSY)) {
+        if (tsch->tx_retries++ < GNRC_TSCH_MAX_RETRIES) {
+            /* TSCH CSMA-CA: the backoff only counts shared cells */
+            if ((tsch->cell != NULL) && (tsch->cell->options & GNRC_TSCH_CELL_OPT_SHARED)) {
+                if (tsch->be < GNRC_TSCH_MAX_BE) {
+                    tsch->be++;
+                }
+                tsch->backoff = random_uint32_range(0, 1U << tsch->be);
+            }
+            return;
+        }
+        DEBUG("[TSCH] dropping packet after %u retransmissions\n",
+              (unsigned)GNRC_TSCH_MAX_RETRIES);
+    }
+    else if (gnrc_priority_pktqueue_length(&tx->current_neighbor->queue) == 0) {
+        tsch->be = GNRC_TSCH_MIN_BE;
+    }
+    gnrc_pktbuf_release(tx->packet);
+    tx->packet = NULL;
+    tx->current_neighbor = NULL;
+    tsch->backoff = 0;
+}
+
+static void _dispatch(gnrc_netdev_t *gnrc_netdev)
+{
+    gnrc_pktsnip_t *pkt;
+    unsigned i = 0;
+
+    while ((i < GNRC_MAC_DISPATCH_BUFFER_SIZE) &&
+           ((pkt = gnrc_priority_pktqueue_pop(&gnrc_netdev->rx.queue)) != NULL)) {
+        gnrc_netdev->rx.dispatch_buffer[i++] = pkt;
+    }
+    gnrc_mac_dispatch(&gnrc_netdev->rx);
+}
+
+/* Corrects the start of the timeslot by the arrival time of a frame of the
+ * time source, sent at the TX offset of the timeslot */
+static void _sync(gnrc_tsch_t *tsch, uint32_t frame_start)
+{
+    unsigned state = irq_disable();
+    int32_t drift = (int32_t)(frame_start - (tsch->slot_start +
+                                             US_TO_TICKS(GNRC_TSCH_TX_OFFSET_US)));
+
+    if ((drift < -(int32_t)US_TO_TICKS(GNRC_TSCH_SYNC_GUARD_US)) ||
+        (drift > (int32_t)US_TO_TICKS(GNRC_TSCH_SYNC_GUARD_US))) {
+        irq_restore(state);
+        DEBUG("[TSCH] frame of time source %" PRIi32 " ticks off\n", drift);
+        return;
+    }
+    tsch->slot_start += drift;
+    timer_set_absolute(GNRC_TSCH_TIMER_DEV, 0, tsch->slot_start + SLOT_TICKS);
+    tsch->last_sync_asn = tsch->asn;
+    irq_restore(state);
+}
+
+static void _join(gnrc_netdev_t *gnrc_netdev, const gnrc_tsch_eb_t *eb,
+                  const gnrc_tsch_slotframe_t *sf, const uint8_t *src,
+                  size_t src_len, uint32_t frame_start)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    xtimer_remove(&_scan_timer);
+    tsch->slotframe = *sf;
+    tsch->join_metric = eb->join_metric + 1;
+    memcpy(tsch->time_source, src, src_len);
+    tsch->time_source_len = src_len;
+    tsch->asn = eb->asn;
+    tsch->last_sync_asn = eb->asn;
+    tsch->slot_start = frame_start - US_TO_TICKS(GNRC_TSCH_TX_OFFSET_US);
+    tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+    tsch->be = GNRC_TSCH_MIN_BE;
+    tsch->backoff = 0;
+    _schedule_eb(tsch, eb->asn);
+    tsch->state = GNRC_TSCH_STATE_SYNCED;
+    _arm_slot_timer(tsch);
+    _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+    LOG_INFO("[TSCH] joined network with ASN %" PRIu32 ", join metric %u\n",
+             (uint32_t)eb->asn, (unsigned)tsch->join_metric);
+}
+
+static void _recv_beacon(gnrc_netdev_t *gnrc_netdev, const uint8_t *frame,
+                         size_t mhr_len, size_t len, const uint8_t *src,
+                         size_t src_len, uint32_t frame_start)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    gnrc_tsch_eb_t eb;
+    gnrc_tsch_slotframe_t sf;
+
+    if (tsch->state != GNRC_TSCH_STATE_SCANNING) {
+        return;
+    }
+    /* networks that do not advertise their schedule use the minimal one */
+    gnrc_tsch_slotframe_init_minimal(&sf);
+    if (!(frame[1] & IEEE802154_FCF_IE_PRESENT) ||
+        (gnrc_tsch_eb_parse(&frame[mhr_len], len - mhr_len, &eb, &sf) < 0) ||
+        (eb.timeslot_id != 0) || (eb.hopping_id != 0) || (eb.join_metric == UINT8_MAX)) {
+        DEBUG("[TSCH] ignoring beacon\n");
+        return;
+    }
+    _join(gnrc_netdev, &eb, &sf, src, src_len, frame_start);
+}
+
+static void _recv(gnrc_netdev_t *gnrc_netdev)
+{
+    netdev_t *dev = gnrc_netdev->dev;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)dev;
+    netdev_ieee802154_rx_info_t rx_info;
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    gnrc_pktsnip_t *pkt, *mhr, *netif;
+    gnrc_netif_hdr_t *hdr;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t pan;
+    int src_len, dst_len, nread, hdr_len;
+    uint32_t frame_start;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+
+    if (bytes_expected <= 0) {
+        return;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("[TSCH] cannot allocate pktsnip\n");
+        /* drop the frame */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return;
+    }
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
+    hdr_len = (nread > 0) ? (int)ieee802154_get_frame_hdr_len(pkt->data) : 0;
+    if ((hdr_len == 0) || (hdr_len > nread)) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    src_len = ieee802154_get_src(pkt->data, src, &pan);
+    dst_len = ieee802154_get_dst(pkt->data, dst, &pan);
+    if ((src_len <= 0) || (dst_len < 0)) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    frame_start = tsch->isr_time -
+                  US_TO_TICKS(((PHY_HDR_LEN + nread + IEEE802154_FCS_LEN) * BYTE_US) +
+                              GNRC_TSCH_TX_LATENCY_US);
+    if ((tsch->state == GNRC_TSCH_STATE_SYNCED) && (tsch->cell != NULL) &&
+        (tsch->cell->options & GNRC_TSCH_CELL_OPT_TIMEKEEPING) &&
+        ((size_t)src_len == tsch->time_source_len) &&
+        (memcmp(src, tsch->time_source, src_len) == 0)) {
+        _sync(tsch, frame_start);
+    }
+    switch (((uint8_t *)pkt->data)[0] & IEEE802154_FCF_TYPE_MASK) {
+        case IEEE802154_FCF_TYPE_BEACON:
+            _recv_beacon(gnrc_netdev, pkt->data, hdr_len, nread, src, src_len,
+                         frame_start);
+            gnrc_pktbuf_release(pkt);
+            return;
+        case IEEE802154_FCF_TYPE_DATA:
+            break;
+        default:
+            gnrc_pktbuf_release(pkt);
+            return;
+    }
+    if (((uint8_t *)pkt->data)[1] & IEEE802154_FCF_IE_PRESENT) {
+        int ie_len = gnrc_tsch_eb_parse((uint8_t *)pkt->data + hdr_len,
+                                        nread - hdr_len, NULL, NULL);
+
+        if (ie_len < 0) {
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        hdr_len += ie_len;
+    }
+    mhr = gnrc_pktbuf_mark(pkt, hdr_len, GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build(src, src_len, dst, dst_len);
+    if ((mhr == NULL) || (netif == NULL)) {
+        DEBUG("[TSCH] no space left in packet buffer\n");
+        if (netif != NULL) {
+            gnrc_pktbuf_release(netif);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = netif->data;
+    if ((dst_len == IEEE802154_ADDR_BCAST_LEN) &&
+        (memcmp(dst, ieee802154_addr_bcast, dst_len) == 0)) {
+        hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    hdr->lqi = rx_info.lqi;
+    hdr->rssi = rx_info.rssi;
+    hdr->if_pid = thread_getpid();
+    pkt->type = state->proto;
+    gnrc_pktbuf_remove_snip(pkt, mhr);
+    gnrc_pktbuf_realloc_data(pkt, nread - hdr_len);
+    LL_APPEND(pkt, netif);
+    if (!gnrc_mac_queue_rx_packet(&gnrc_netdev->rx, 0, pkt)) {
+        LOG_ERROR("ERROR: [TSCH] Can't push RX packet @ %p, memory full?\n",
+                  (void *)pkt);
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _event_cb(netdev_t *dev, netdev_event_t event)
+{
+    gnrc_netdev_t *gnrc_netdev = (gnrc_netdev_t *) dev->context;
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg;
+
+        /* close to the end of a received frame */
+        tsch->isr_time = timer_read(GNRC_TSCH_TIMER_DEV);
+        msg.type = NETDEV_MSG_TYPE_EVENT;
+        msg.content.ptr = (void *) gnrc_netdev;
+
+        if (msg_send(&msg, gnrc_netdev->pid) <= 0) {
+            LOG_WARNING("WARNING: [TSCH] gnrc_netdev: possibly lost interrupt.\n");
+        }
+        return;
+    }
+    switch (event) {
+        case NETDEV_EVENT_RX_STARTED:
+            gnrc_netdev_set_rx_started(gnrc_netdev, true);
+            break;
+        case NETDEV_EVENT_RX_COMPLETE:
+            gnrc_netdev_set_rx_started(gnrc_netdev, false);
+            _recv(gnrc_netdev);
+            /* the transceiver acknowledged already, the timeslot is over */
+            if ((tsch->state == GNRC_TSCH_STATE_SYNCED) &&
+                (tsch->slot_action == GNRC_TSCH_SLOT_RX)) {
+                tsch->slot_action = GNRC_TSCH_SLOT_SLEEP;
+                _set_state(gnrc_netdev, NETOPT_STATE_SLEEP);
+            }
+            _dispatch(gnrc_netdev);
+            break;
+        case NETDEV_EVENT_TX_STARTED:
+            gnrc_netdev_set_rx_started(gnrc_netdev, false);
+            break;
+        case NETDEV_EVENT_TX_COMPLETE:
+            _tx_done(gnrc_netdev, TX_FEEDBACK_SUCCESS);
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            _tx_done(gnrc_netdev, TX_FEEDBACK_NOACK);
+            break;
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            _tx_done(gnrc_netdev, TX_FEEDBACK_BUSY);
+            break;
+        default:
+            DEBUG("[TSCH] unhandled netdev event: %u\n", event);
+    }
+}
+
+static int _set(gnrc_netdev_t *gnrc_netdev, gnrc_netapi_opt_t *opt)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    netdev_t *dev = gnrc_netdev->dev;
+
+    switch (opt->opt) {
+        case NETOPT_TSCH_COORDINATOR:
+            if (opt->data_len != sizeof(netopt_enable_t)) {
+                return -EINVAL;
+            }
+            if (*((netopt_enable_t *)opt->data) == NETOPT_ENABLE) {
+                _start_coordinator(gnrc_netdev);
+            }
+            else if ((tsch->state == GNRC_TSCH_STATE_SYNCED) &&
+                     (tsch->time_source_len == 0)) {
+                _start_scan(gnrc_netdev);
+            }
+            return sizeof(netopt_enable_t);
+        case NETOPT_STATE:
+            if (opt->data_len != sizeof(netopt_state_t)) {
+                return -EINVAL;
+            }
+            switch (*((netopt_state_t *)opt->data)) {
+                case NETOPT_STATE_OFF:
+                    _stop(gnrc_netdev);
+                    break;
+                case NETOPT_STATE_IDLE:
+                    if (tsch->state == GNRC_TSCH_STATE_OFF) {
+                        _start_scan(gnrc_netdev);
+                    }
+                    break;
+                case NETOPT_STATE_RESET:
+                    _start_scan(gnrc_netdev);
+                    break;
+                default:
+                    return -EINVAL;
+            }
+            return sizeof(netopt_state_t);
+        /* the channel is given by the schedule */
+        case NETOPT_CHANNEL:
+        case NETOPT_CSMA:
+        case NETOPT_RETRANS:
+            return -ENOTSUP;
+        default:
+            return dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+    }
+}
+
+static int _get(gnrc_netdev_t *gnrc_netdev, gnrc_netapi_opt_t *opt)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev->tsch;
+    netdev_t *dev = gnrc_netdev->dev;
+
+    if (opt->opt == NETOPT_TSCH_COORDINATOR) {
+        if (opt->data_len < sizeof(netopt_enable_t)) {
+            return -EOVERFLOW;
+        }
+        *((netopt_enable_t *)opt->data) = ((tsch->state == GNRC_TSCH_STATE_SYNCED) &&
+                                           (tsch->time_source_len == 0)) ?
+                                          NETOPT_ENABLE : NETOPT_DISABLE;
+        return sizeof(netopt_enable_t);
+    }
+    return dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+}
+
+/**
+ * @brief   Startup code and event loop of the TSCH layer
+ *
+ * @param[in] args          expects a pointer to the underlying netdev device
+ *
+ * @return                  never returns
+ */
+static void *_tsch_thread(void *args)
+{
+    gnrc_netdev_t *gnrc_netdev = (gnrc_netdev_t *)args;
+    netdev_t *dev = gnrc_netdev->dev;
+    msg_t msg, reply, msg_queue[GNRC_TSCH_IPC_MSG_QUEUE_SIZE];
+    netopt_enable_t enable = NETOPT_ENABLE, disable = NETOPT_DISABLE;
+    uint16_t src_len = IEEE802154_LONG_ADDRESS_LEN;
+    uint8_t retrans = 0;
+
+    gnrc_netdev->pid = thread_getpid();
+
+    LOG_INFO("[TSCH] Starting TSCH\n");
+
+    /* setup the MAC layers message queue */
+    msg_init_queue(msg_queue, GNRC_TSCH_IPC_MSG_QUEUE_SIZE);
+
+    /* register the event callback with the device driver */
+    dev->event_callback = _event_cb;
+    dev->context = (void *) gnrc_netdev;
+
+    /* register the device to the network stack*/
+    gnrc_netif_add(thread_getpid());
+
+    /* initialize low-level driver */
+    dev->driver->init(dev);
+
+    dev->driver->set(dev, NETOPT_RX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_SRC_LEN, &src_len, sizeof(src_len));
+    /* frames go out at the TX offset, retransmissions wait for the next cell */
+    dev->driver->set(dev, NETOPT_CSMA, &disable, sizeof(disable));
+    dev->driver->set(dev, NETOPT_RETRANS, &retrans, sizeof(retrans));
+    gnrc_netdev->mac_info &= ~GNRC_NETDEV_MAC_INFO_CSMA_ENABLED;
+
+    /* Get own address from netdev */
+    gnrc_netdev->l2_addr_len = dev->driver->get(dev, NETOPT_ADDRESS_LONG,
+                                                &gnrc_netdev->l2_addr,
+                                                IEEE802154_LONG_ADDRESS_LEN);
+    assert(gnrc_netdev->l2_addr_len > 0);
+
+    if (timer_init(GNRC_TSCH_TIMER_DEV, GNRC_TSCH_TIMER_FREQ, _timer_cb,
+                   gnrc_netdev) < 0) {
+        LOG_ERROR("ERROR: [TSCH] Can't initialize timer\n");
+        return NULL;
+    }
+    gnrc_netdev->tsch.be = GNRC_TSCH_MIN_BE;
+    gnrc_netdev->tsch.scan_channel = (uint8_t)random_uint32();
+    _start_scan(gnrc_netdev);
+
+    /* start the event loop */
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_TSCH_EVENT_SLOT:
+                _slot(gnrc_netdev, msg.content.value);
+                break;
+            case GNRC_TSCH_EVENT_OFFSET:
+                _offset(gnrc_netdev, msg.content.value);
+                break;
+            case GNRC_TSCH_EVENT_SCAN:
+                if (gnrc_netdev->tsch.state == GNRC_TSCH_STATE_SCANNING) {
+                    gnrc_netdev->tsch.scan_channel++;
+                    _scan(gnrc_netdev);
+                }
+                break;
+            /* Transceiver raised an interrupt */
+            case NETDEV_MSG_TYPE_EVENT:
+                /* Forward event back to driver */
+                dev->driver->isr(dev);
+                break;
+            /* TX: Queue for sending in the next fitting cell */
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *) msg.content.ptr;
+
+                if (!gnrc_mac_queue_tx_packet(&gnrc_netdev->tx, 0, pkt)) {
+                    gnrc_pktbuf_release(pkt);
+                    LOG_WARNING("WARNING: [TSCH] TX queue full, drop packet\n");
+                }
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)_set(gnrc_netdev, msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)_get(gnrc_netdev, msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                /* the caller falls back to single options */
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                LOG_ERROR("ERROR: [TSCH] Unknown command %" PRIu16 "\n", msg.type);
+                break;
+        }
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_tsch_init(char *stack, int stacksize, char priority,
+                            const char *name, gnrc_netdev_t *dev)
+{
+    kernel_pid_t res;
+
+    /* check if given netdev device is defined and the driver is set */
+    if (dev == NULL || dev->dev == NULL) {
+        LOG_ERROR("ERROR: [TSCH] No netdev supplied or driver not set\n");
+        return -ENODEV;
+    }
+
+    /* create new TSCH thread */
+    res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                        _tsch_thread, (void *)dev, name);
+    if (res <= 0) {
+        LOG_ERROR("ERROR: [TSCH] Couldn't create thread\n");
+        return -EINVAL;
+    }
+
+    return res;
+}
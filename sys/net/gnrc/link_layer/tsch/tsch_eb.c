@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       TSCH enhanced beacons and information elements
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gnrc/tsch/eb.h"
+#include "net/gnrc/tsch/schedule.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define IE_DESC_LEN             (2U)
+#define IE_PAYLOAD              (0x8000U)   /* type bit of payload IEs */
+#define IE_SUB_LONG             (0x8000U)   /* type bit of long sub-IEs */
+#define IE_SYNC_LEN             (6U)
+#define IE_SLOTFRAME_HDR_LEN    (5U)
+#define IE_LINK_LEN             (5U)
+
+static inline uint16_t _get16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static inline uint8_t *_put16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = (uint8_t)val;
+    buf[1] = (uint8_t)(val >> 8);
+    return buf + 2;
+}
+
+static inline uint8_t *_short_sub_ie(uint8_t *buf, uint8_t id, uint8_t len)
+{
+    return _put16(buf, ((uint16_t)id << 8) | len);
+}
+
+size_t gnrc_tsch_eb_write(uint8_t *buf, size_t len, const gnrc_tsch_eb_t *eb,
+                          const gnrc_tsch_slotframe_t *sf)
+{
+    uint8_t *ptr = buf, *mlme;
+    uint8_t links = (sf != NULL) ? sf->numof : 0;
+    size_t mlme_len = (IE_DESC_LEN + IE_SYNC_LEN) + (IE_DESC_LEN + 1) +
+                      (IE_DESC_LEN + 1);
+
+    if (sf != NULL) {
+        mlme_len += IE_DESC_LEN + IE_SLOTFRAME_HDR_LEN + (links * IE_LINK_LEN);
+    }
+    if (len < (2 * IE_DESC_LEN) + mlme_len) {
+        return 0;
+    }
+    /* no header IEs, so terminate them right away */
+    ptr = _put16(ptr, (uint16_t)GNRC_TSCH_IE_HT1 << 7);
+    ptr = _put16(ptr, IE_PAYLOAD | (GNRC_TSCH_IE_GROUP_MLME << 11) | mlme_len);
+    mlme = ptr;
+    ptr = _short_sub_ie(ptr, GNRC_TSCH_IE_SUB_SYNC, IE_SYNC_LEN);
+    for (unsigned i = 0; i < 5; i++) {
+        *(ptr++) = (uint8_t)(eb->asn >> (8 * i));
+    }
+    *(ptr++) = eb->join_metric;
+    ptr = _short_sub_ie(ptr, GNRC_TSCH_IE_SUB_TIMESLOT, 1);
+    *(ptr++) = eb->timeslot_id;
+    ptr = _put16(ptr, IE_SUB_LONG | (GNRC_TSCH_IE_SUB_HOPPING << 11) | 1);
+    *(ptr++) = eb->hopping_id;
+    if (sf != NULL) {
+        ptr = _short_sub_ie(ptr, GNRC_TSCH_IE_SUB_SLOTFRAME,
+                            IE_SLOTFRAME_HDR_LEN + (links * IE_LINK_LEN));
+        *(ptr++) = 1;
+        *(ptr++) = sf->handle;
+        ptr = _put16(ptr, sf->length);
+        *(ptr++) = links;
+        for (unsigned i = 0; i < links; i++) {
+            ptr = _put16(ptr, sf->cells[i].timeslot);
+            ptr = _put16(ptr, sf->cells[i].channel_offset);
+            /* dedicated cells are private to their neighbors */
+            *(ptr++) = (sf->cells[i].l2_addr_len == 0) ? sf->cells[i].options : 0;
+        }
+    }
+    assert((size_t)(ptr - mlme) == mlme_len);
+    (void)mlme;
+    return ptr - buf;
+}
+
+static int _parse_slotframe(const uint8_t *buf, size_t len, gnrc_tsch_slotframe_t *sf)
+{
+    unsigned links;
+
+    if (len < IE_SLOTFRAME_HDR_LEN) {
+        return (len >= 1) && (buf[0] == 0) ? 0 : -EBADMSG;
+    }
+    links = buf[4];
+    if (len < (IE_SLOTFRAME_HDR_LEN + (links * IE_LINK_LEN))) {
+        return -EBADMSG;
+    }
+    if ((sf == NULL) || (buf[0] == 0)) {
+        return 0;
+    }
+    memset(sf, 0, sizeof(gnrc_tsch_slotframe_t));
+    sf->handle = buf[1];
+    sf->length = _get16(&buf[2]);
+    buf += IE_SLOTFRAME_HDR_LEN;
+    for (unsigned i = 0; i < links; i++, buf += IE_LINK_LEN) {
+        gnrc_tsch_cell_t cell = {
+            .timeslot = _get16(&buf[0]),
+            .channel_offset = _get16(&buf[2]),
+            .options = buf[4],
+            .l2_addr_len = 0,
+        };
+
+        if (gnrc_tsch_slotframe_add(sf, &cell) < 0) {
+            DEBUG("tsch: ignoring link %u of advertised slotframe\n", i);
+        }
+    }
+    return 0;
+}
+
+static int _parse_mlme(const uint8_t *buf, size_t len, gnrc_tsch_eb_t *eb,
+                       gnrc_tsch_slotframe_t *sf, bool *synced)
+{
+    while (len >= IE_DESC_LEN) {
+        uint16_t desc = _get16(buf);
+        unsigned id, sub_len;
+
+        if (desc & IE_SUB_LONG) {
+            id = (desc >> 11) & 0xf;
+            sub_len = desc & 0x7ff;
+            /* long sub-IE IDs do not overlap with the short ones used here */
+            id |= 0x100;
+        }
+        else {
+            id = (desc >> 8) & 0x7f;
+            sub_len = desc & 0xff;
+        }
+        buf += IE_DESC_LEN;
+        len -= IE_DESC_LEN;
+        if (sub_len > len) {
+            return -EBADMSG;
+        }
+        switch (id) {
+            case GNRC_TSCH_IE_SUB_SYNC:
+                if (sub_len < IE_SYNC_LEN) {
+                    return -EBADMSG;
+                }
+                if (eb != NULL) {
+                    eb->asn = 0;
+                    for (unsigned i = 0; i < 5; i++) {
+                        eb->asn |= ((uint64_t)buf[i]) << (8 * i);
+                    }
+                    eb->join_metric = buf[5];
+                }
+                *synced = true;
+                break;
+            case GNRC_TSCH_IE_SUB_TIMESLOT:
+                if ((eb != NULL) && (sub_len >= 1)) {
+                    eb->timeslot_id = buf[0];
+                }
+                break;
+            case GNRC_TSCH_IE_SUB_HOPPING | 0x100:
+                if ((eb != NULL) && (sub_len >= 1)) {
+                    eb->hopping_id = buf[0];
+                }
+                break;
+            case GNRC_TSCH_IE_SUB_SLOTFRAME:
+                if (_parse_slotframe(buf, sub_len, sf) < 0) {
+                    return -EBADMSG;
+                }
+                break;
+            default:
+                break;
+        }
+        buf += sub_len;
+        len -= sub_len;
+    }
+    return (len == 0) ? 0 : -EBADMSG;
+}
+
+int gnrc_tsch_eb_parse(const uint8_t *buf, size_t len, gnrc_tsch_eb_t *eb,
+                       gnrc_tsch_slotframe_t *sf)
+{
+    size_t offset = 0;
+    bool payload_ies = false, synced = false;
+
+    /* header IEs */
+    while ((offset + IE_DESC_LEN) <= len) {
+        uint16_t desc = _get16(&buf[offset]);
+        uint8_t id = (desc >> 7) & 0xff;
+
+        offset += IE_DESC_LEN + (desc & 0x7f);
+        if (offset > len) {
+            return -EBADMSG;
+        }
+        if (id == GNRC_TSCH_IE_HT1) {
+            payload_ies = true;
+            break;
+        }
+        if (id == GNRC_TSCH_IE_HT2) {
+            break;
+        }
+    }
+    /* payload IEs */
+    while (payload_ies && ((offset + IE_DESC_LEN) <= len)) {
+        uint16_t desc = _get16(&buf[offset]);
+        uint8_t group = (desc >> 11) & 0xf;
+        size_t ie_len = desc & 0x7ff;
+
+        offset += IE_DESC_LEN;
+        if ((offset + ie_len) > len) {
+            return -EBADMSG;
+        }
+        if (group == GNRC_TSCH_IE_GROUP_TERM) {
+            offset += ie_len;
+            break;
+        }
+        if ((group == GNRC_TSCH_IE_GROUP_MLME) &&
+            (_parse_mlme(&buf[offset], ie_len, eb, sf, &synced) < 0)) {
+            return -EBADMSG;
+        }
+        offset += ie_len;
+    }
+    if ((eb != NULL) && !synced) {
+        return -EBADMSG;
+    }
+    return (int)offset;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       TSCH slotframe and channel hopping
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/tsch/schedule.h"
+
+static const uint8_t _hopping_sequence[] = GNRC_TSCH_HOPPING_SEQUENCE;
+
+void gnrc_tsch_slotframe_init_minimal(gnrc_tsch_slotframe_t *sf)
+{
+    const gnrc_tsch_cell_t cell = {
+        .timeslot = 0,
+        .channel_offset = 0,
+        .options = GNRC_TSCH_CELL_OPT_TX | GNRC_TSCH_CELL_OPT_RX |
+                   GNRC_TSCH_CELL_OPT_SHARED | GNRC_TSCH_CELL_OPT_TIMEKEEPING,
+        .l2_addr_len = 0,
+    };
+
+    memset(sf, 0, sizeof(gnrc_tsch_slotframe_t));
+    sf->length = GNRC_TSCH_SLOTFRAME_LENGTH;
+    gnrc_tsch_slotframe_add(sf, &cell);
+}
+
+int gnrc_tsch_slotframe_add(gnrc_tsch_slotframe_t *sf, const gnrc_tsch_cell_t *cell)
+{
+    if (cell->timeslot >= sf->length) {
+        return -EINVAL;
+    }
+    if (sf->numof >= GNRC_TSCH_CELLS_MAX) {
+        return -ENOMEM;
+    }
+    sf->cells[sf->numof++] = *cell;
+    return 0;
+}
+
+const gnrc_tsch_cell_t *gnrc_tsch_slotframe_get(const gnrc_tsch_slotframe_t *sf,
+                                                uint64_t asn)
+{
+    uint16_t timeslot;
+
+    if (sf->length == 0) {
+        return NULL;
+    }
+    timeslot = (uint16_t)(asn % sf->length);
+    for (unsigned i = 0; i < sf->numof; i++) {
+        if (sf->cells[i].timeslot == timeslot) {
+            return &sf->cells[i];
+        }
+    }
+    return NULL;
+}
+
+uint8_t gnrc_tsch_channel(uint64_t asn, uint16_t channel_offset)
+{
+    return _hopping_sequence[(asn + channel_offset) % sizeof(_hopping_sequence)];
+}
+
+uint8_t gnrc_tsch_hopping_channel(unsigned idx)
+{
+    return _hopping_sequence[idx % sizeof(_hopping_sequence)];
+}
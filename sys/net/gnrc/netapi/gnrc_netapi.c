@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "mbox.h"
 #include "msg.h"
 #include "net/gnrc/netreg.h"
@@ -60,6 +62,32 @@ static inline int _get_set(kernel_pid_t pid, uint16_t type,
     return (int)ack.content.value;
 }
 
+static int _get_set_multi(kernel_pid_t pid, uint16_t type, uint16_t single,
+                          gnrc_netapi_opt_t *opts, int *res, unsigned numof)
+{
+    msg_t cmd;
+    msg_t ack;
+    gnrc_netapi_opts_t o = { .opts = opts, .res = res, .numof = numof };
+    int ok = 0;
+
+    cmd.type = type;
+    cmd.content.ptr = (void *)&o;
+    msg_send_receive(&cmd, &ack, pid);
+    assert(ack.type == GNRC_NETAPI_MSG_TYPE_ACK);
+    if ((int)ack.content.value != -ENOTSUP) {
+        return (int)ack.content.value;
+    }
+    DEBUG("gnrc_netapi: %" PRIkernel_pid " handles options one by one\n", pid);
+    for (unsigned i = 0; i < numof; i++) {
+        res[i] = _get_set(pid, single, opts[i].opt, opts[i].context,
+                          opts[i].data, opts[i].data_len);
+        if (res[i] >= 0) {
+            ok++;
+        }
+    }
+    return ok;
+}
+
 static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
 {
     msg_t msg;
@@ -75,6 +103,29 @@ static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
     return ret;
 }
 
+static int _snd_rcv_train(kernel_pid_t pid, uint16_t type, uint16_t train_type,
+                          gnrc_pktsnip_t **pkts, unsigned numof)
+{
+    gnrc_pktsnip_t *train;
+    int ret;
+
+    assert((pkts != NULL) && (numof > 0));
+    if (numof == 1) {
+        return _snd_rcv(pid, type, pkts[0]);
+    }
+    train = gnrc_pktbuf_add(NULL, pkts, numof * sizeof(gnrc_pktsnip_t *),
+                            GNRC_NETTYPE_UNDEF);
+    if (train == NULL) {
+        DEBUG("gnrc_netapi: no space for train of %u packets\n", numof);
+        return -1;
+    }
+    ret = _snd_rcv(pid, train_type, train);
+    if (ret < 1) {
+        gnrc_pktbuf_release(train);
+    }
+    return ret;
+}
+
 #ifdef MODULE_GNRC_NETAPI_MBOX
 static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt)
 {
@@ -150,11 +201,23 @@ int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
     return _snd_rcv(pid, GNRC_NETAPI_MSG_TYPE_SND, pkt);
 }
 
+int gnrc_netapi_send_train(kernel_pid_t pid, gnrc_pktsnip_t **pkts, unsigned numof)
+{
+    return _snd_rcv_train(pid, GNRC_NETAPI_MSG_TYPE_SND,
+                          GNRC_NETAPI_MSG_TYPE_SND_TRAIN, pkts, numof);
+}
+
 int gnrc_netapi_receive(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 {
     return _snd_rcv(pid, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+int gnrc_netapi_receive_train(kernel_pid_t pid, gnrc_pktsnip_t **pkts, unsigned numof)
+{
+    return _snd_rcv_train(pid, GNRC_NETAPI_MSG_TYPE_RCV,
+                          GNRC_NETAPI_MSG_TYPE_RCV_TRAIN, pkts, numof);
+}
+
 int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len)
 {
@@ -168,3 +231,17 @@ int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
     return _get_set(pid, GNRC_NETAPI_MSG_TYPE_SET, opt, context,
                     data, data_len);
 }
+
+int gnrc_netapi_get_multi(kernel_pid_t pid, gnrc_netapi_opt_t *opts, int *res,
+                          unsigned numof)
+{
+    return _get_set_multi(pid, GNRC_NETAPI_MSG_TYPE_GET_MULTI,
+                          GNRC_NETAPI_MSG_TYPE_GET, opts, res, numof);
+}
+
+int gnrc_netapi_set_multi(kernel_pid_t pid, gnrc_netapi_opt_t *opts, int *res,
+                          unsigned numof)
+{
+    return _get_set_multi(pid, GNRC_NETAPI_MSG_TYPE_SET_MULTI,
+                          GNRC_NETAPI_MSG_TYPE_SET, opts, res, numof);
+}
@@ -27,13 +27,39 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of 2"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t, every type hashed by
+ * demux context. All entries of one (type, demux_ctx) pair end up in the same
+ * list, so gnrc_netreg_getnext() works the same as without hashing */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* fold the upper half in to tell apart GNRC_NETREG_DEMUX_CTX_ALL and
+     * port or protocol numbers */
+    demux_ctx ^= demux_ctx >> 16;
+    demux_ctx ^= demux_ctx >> 8;
+    return &netreg[type][demux_ctx & (GNRC_NETREG_HASH_BUCKETS - 1)];
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -53,7 +79,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(*_list(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -64,7 +90,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_list(type, entry->demux_ctx), entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -75,7 +101,7 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    LL_SEARCH_SCALAR(*_list(type, demux_ctx), res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -89,7 +115,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = *_list(type, demux_ctx);
 
     while (entry != NULL) {
         if (entry->demux_ctx == demux_ctx) {
@@ -102,6 +128,49 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
     return num;
 }
 
+bool gnrc_netreg_full(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    gnrc_netreg_entry_t *entry;
+    int num = 0, full = 0;
+
+    if (_INVALID_TYPE(type)) {
+        return false;
+    }
+
+    entry = *_list(type, demux_ctx);
+
+    /* ask every entry, so that each full one can account the packet */
+    while (entry != NULL) {
+        if (entry->demux_ctx == demux_ctx) {
+            num++;
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+            switch (entry->type) {
+#ifdef MODULE_GNRC_NETAPI_MBOX
+                case GNRC_NETREG_TYPE_MBOX:
+                    full += mbox_full(entry->target.mbox) ? 1 : 0;
+                    break;
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+                case GNRC_NETREG_TYPE_CB:
+                    if ((entry->target.cbd->full != NULL) &&
+                        entry->target.cbd->full(entry->target.cbd->ctx)) {
+                        full++;
+                    }
+                    break;
+#endif
+                default:
+                    /* the message queue of a thread can't be checked */
+                    break;
+            }
+#endif
+        }
+
+        entry = entry->next;
+    }
+
+    return (num > 0) && (full == num);
+}
+
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
     uint32_t demux_ctx;
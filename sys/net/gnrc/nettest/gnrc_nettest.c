@@ -231,6 +231,7 @@ static void *_event_loop(void *arg)
     while (1) {
         msg_t msg;
         gnrc_netapi_opt_t *opt;
+        gnrc_netapi_opts_t *opts;
 
         msg_receive(&msg);
 
@@ -248,6 +249,22 @@ static void *_event_loop(void *arg)
                                                    opt->context, opt->data,
                                                    opt->data_len);
                 break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                opts = msg.content.ptr;
+                reply.content.value = 0;
+                for (unsigned i = 0; i < opts->numof; i++) {
+                    opt = &opts->opts[i];
+                    opts->res[i] = (int)_get_set_opt(
+                        (msg.type == GNRC_NETAPI_MSG_TYPE_GET_MULTI) ?
+                        _opt_cbs[opt->opt].get : _opt_cbs[opt->opt].set,
+                        opt->context, opt->data, opt->data_len);
+                    if (opts->res[i] >= 0) {
+                        reply.content.value++;
+                    }
+                }
+                break;
         }
 
         msg_reply(&msg, &reply);
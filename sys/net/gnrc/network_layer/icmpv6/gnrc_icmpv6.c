@@ -30,6 +30,8 @@
 
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
+#include "net/gnrc/ipv6/dst_cache.h"
+#include "net/gnrc/sixlowpan/nd/router.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -86,6 +88,23 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     switch (hdr->type) {
         /* TODO: handle ICMPv6 errors */
+#ifdef MODULE_GNRC_IPV6_DST_CACHE
+        case ICMPV6_PKT_TOO_BIG:
+            DEBUG("icmpv6: packet too big received\n");
+            /* as much of the invoking packet as possible is included, so
+             * its header needs to be there */
+            if (icmpv6->size >= (sizeof(icmpv6_error_pkt_too_big_t) +
+                                 sizeof(ipv6_hdr_t))) {
+                icmpv6_error_pkt_too_big_t *ptb = (icmpv6_error_pkt_too_big_t *)hdr;
+                ipv6_hdr_t *invoking = (ipv6_hdr_t *)(ptb + 1);
+                uint32_t mtu = byteorder_ntohl(ptb->mtu);
+
+                gnrc_ipv6_dst_cache_set_pmtu(&invoking->dst,
+                                             (mtu < UINT16_MAX) ? mtu : UINT16_MAX);
+            }
+            break;
+#endif
+
 #ifdef MODULE_GNRC_ICMPV6_ECHO
         case ICMPV6_ECHO_REQ:
             DEBUG("icmpv6: handle echo request.\n");
@@ -122,6 +141,14 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
             break;
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
+        case ICMPV6_DAR:
+            DEBUG("icmpv6: duplicate address request received\n");
+            gnrc_sixlowpan_nd_router_dar_handle(ipv6->data, (sixlowpan_nd_da_t *)hdr,
+                                                icmpv6->size);
+            break;
+#endif
+
         case ICMPV6_REDIRECT:
             DEBUG("icmpv6: redirect message received\n");
             /* TODO */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "bitarithm.h"
+
+#include "net/gnrc/ipv6/addr_set.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define LENS_WORD_BITS  (8 * sizeof(unsigned))
+
+/* sets the bits of out behind the first len bits of prefix to zero */
+static void _mask(ipv6_addr_t *out, const ipv6_addr_t *prefix, uint8_t len)
+{
+    memset(out, 0, sizeof(*out));
+    ipv6_addr_init_prefix(out, prefix, len);
+}
+
+/* home slot of a masked prefix: FNV-1a over its significant bytes and its
+ * length */
+static unsigned _home(const gnrc_ipv6_addr_set_t *set,
+                      const ipv6_addr_t *prefix, uint8_t len)
+{
+    uint32_t hash = (2166136261U ^ len) * 16777619U;
+
+    for (unsigned i = 0; i < ((len + 7U) / 8U); i++) {
+        hash = (hash ^ prefix->u8[i]) * 16777619U;
+    }
+    return hash % set->size;
+}
+
+static inline unsigned _next(const gnrc_ipv6_addr_set_t *set, unsigned i)
+{
+    return (i + 1) % set->size;
+}
+
+/* finds the slot of a masked prefix by probing from its home slot on until
+ * the first unused slot */
+static int _find(const gnrc_ipv6_addr_set_t *set, const ipv6_addr_t *prefix,
+                 uint8_t len)
+{
+    unsigned i = _home(set, prefix, len);
+
+    for (unsigned n = 0; n < set->size; n++, i = _next(set, i)) {
+        const gnrc_ipv6_addr_set_entry_t *entry = &set->entries[i];
+
+        if (!entry->used) {
+            break;
+        }
+        if ((entry->len == len) && ipv6_addr_equal(&entry->prefix, prefix)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int gnrc_ipv6_addr_set_add(gnrc_ipv6_addr_set_t *set,
+                           const ipv6_addr_t *prefix, uint8_t len)
+{
+    assert(set && prefix && (len <= IPV6_ADDR_BIT_LEN));
+
+    ipv6_addr_t masked;
+    unsigned i;
+
+    _mask(&masked, prefix, len);
+    if (_find(set, &masked, len) >= 0) {
+        return 0;
+    }
+    i = _home(set, &masked, len);
+    for (unsigned n = 0; n < set->size; n++, i = _next(set, i)) {
+        gnrc_ipv6_addr_set_entry_t *entry = &set->entries[i];
+
+        if (!entry->used) {
+            entry->prefix = masked;
+            entry->len = len;
+            entry->used = true;
+            set->lens[len / LENS_WORD_BITS] |= (1U << (len % LENS_WORD_BITS));
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+int gnrc_ipv6_addr_set_del(gnrc_ipv6_addr_set_t *set,
+                           const ipv6_addr_t *prefix, uint8_t len)
+{
+    assert(set && prefix && (len <= IPV6_ADDR_BIT_LEN));
+
+    ipv6_addr_t masked;
+    int pos;
+
+    _mask(&masked, prefix, len);
+    if ((pos = _find(set, &masked, len)) < 0) {
+        return -ENOENT;
+    }
+    /* close the gap, so that no entry behind it becomes unreachable */
+    unsigned gap = pos;
+    for (unsigned i = _next(set, gap); set->entries[i].used;
+         i = _next(set, i)) {
+        gnrc_ipv6_addr_set_entry_t *entry = &set->entries[i];
+        unsigned home = _home(set, &entry->prefix, entry->len);
+        bool stays = (gap < i) ? ((gap < home) && (home <= i))
+                               : ((gap < home) || (home <= i));
+
+        /* move the entry unless the gap is before its home slot */
+        if (!stays) {
+            set->entries[gap] = *entry;
+            gap = i;
+        }
+        if (_next(set, i) == (unsigned)pos) {
+            break;
+        }
+    }
+    set->entries[gap].used = false;
+    /* removing is rare, so the lengths in use are not counted */
+    for (unsigned i = 0; i < set->size; i++) {
+        if (set->entries[i].used && (set->entries[i].len == len)) {
+            return 0;
+        }
+    }
+    set->lens[len / LENS_WORD_BITS] &= ~(1U << (len % LENS_WORD_BITS));
+    return 0;
+}
+
+bool gnrc_ipv6_addr_set_match(const gnrc_ipv6_addr_set_t *set,
+                              const ipv6_addr_t *addr)
+{
+    assert(set && addr);
+
+    for (unsigned w = 0; w < GNRC_IPV6_ADDR_SET_LENS_WORDS; w++) {
+        unsigned lens = set->lens[w];
+
+        while (lens) {
+            unsigned bit = bitarithm_lsb(lens);
+            uint8_t len = (w * LENS_WORD_BITS) + bit;
+            ipv6_addr_t masked;
+
+            lens &= ~(1U << bit);
+            _mask(&masked, addr, len);
+            if (_find(set, &masked, len) >= 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void gnrc_ipv6_addr_set_print(const gnrc_ipv6_addr_set_t *set)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+    for (unsigned i = 0; i < set->size; i++) {
+        const gnrc_ipv6_addr_set_entry_t *entry = &set->entries[i];
+
+        if (!entry->used) {
+            continue;
+        }
+        ipv6_addr_to_str(addr_str, &entry->prefix, sizeof(addr_str));
+        if (entry->len < IPV6_ADDR_BIT_LEN) {
+            printf("%s/%u\n", addr_str, (unsigned)entry->len);
+        }
+        else {
+            puts(addr_str);
+        }
+    }
+}
+
+/** @} */
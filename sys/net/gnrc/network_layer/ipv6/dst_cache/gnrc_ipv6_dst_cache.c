@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_ipv6_dst_cache
+ * @{
+ *
+ * @file
+ * @brief       IPv6 destination cache implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dst_cache.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+typedef struct {
+    ipv6_addr_t dst;
+    uint32_t time;              /* time in microseconds when set */
+    uint16_t mtu;               /* 0 marks unused entries */
+} _pmtu_t;
+
+static gnrc_ipv6_dst_cache_t _cache[GNRC_IPV6_DST_CACHE_SIZE];
+static _pmtu_t _pmtus[GNRC_IPV6_DST_CACHE_PMTU_SIZE];
+static mutex_t _mutex = MUTEX_INIT;    /* for the path MTU queries of other
+                                         * threads */
+static unsigned _next;          /* entry to replace next */
+static unsigned _pmtu_next;     /* path MTU to replace next */
+static uint32_t _gen = 1;       /* 0 marks unused entries */
+
+void gnrc_ipv6_dst_cache_invalidate(void)
+{
+    _gen++;
+}
+
+uint32_t gnrc_ipv6_dst_cache_version(void)
+{
+#ifdef MODULE_FIB
+    /* both only increase, so the sum changes whenever one of them does */
+    return _gen + gnrc_ipv6_fib_table.gen;
+#else
+    return _gen;
+#endif
+}
+
+static inline bool _valid(const gnrc_ipv6_dst_cache_t *entry, uint32_t version,
+                          uint32_t now)
+{
+    return (entry->version == version) &&
+           ((now - entry->time) < GNRC_IPV6_DST_CACHE_TIMEOUT);
+}
+
+static _pmtu_t *_pmtu_get(const ipv6_addr_t *dst, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_DST_CACHE_PMTU_SIZE; i++) {
+        _pmtu_t *pmtu = &_pmtus[i];
+
+        if ((pmtu->mtu != 0) &&
+            ((now - pmtu->time) >= GNRC_IPV6_DST_CACHE_PMTU_TIMEOUT)) {
+            DEBUG("ipv6 dst cache: path MTU to %s expired\n",
+                  ipv6_addr_to_str(addr_str, &pmtu->dst, sizeof(addr_str)));
+            pmtu->mtu = 0;
+        }
+        if ((pmtu->mtu != 0) && ipv6_addr_equal(&pmtu->dst, dst)) {
+            return pmtu;
+        }
+    }
+    return NULL;
+}
+
+static uint16_t _iface_mtu(kernel_pid_t iface, const ipv6_addr_t *dst, uint32_t now)
+{
+    gnrc_ipv6_netif_t *netif;
+    _pmtu_t *pmtu = _pmtu_get(dst, now);
+    uint16_t mtu = (pmtu != NULL) ? pmtu->mtu : UINT16_MAX;
+
+    /* KERNEL_PID_UNDEF would match unused interfaces */
+    if ((iface != KERNEL_PID_UNDEF) &&
+        ((netif = gnrc_ipv6_netif_get(iface)) != NULL) && (netif->mtu < mtu)) {
+        mtu = netif->mtu;
+    }
+    return mtu;
+}
+
+const gnrc_ipv6_dst_cache_t *gnrc_ipv6_dst_cache_get(kernel_pid_t iface,
+                                                     const ipv6_addr_t *dst)
+{
+    uint32_t version = gnrc_ipv6_dst_cache_version();
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_IPV6_DST_CACHE_SIZE; i++) {
+        gnrc_ipv6_dst_cache_t *entry = &_cache[i];
+
+        if (_valid(entry, version, now) && (entry->req_iface == iface) &&
+            ipv6_addr_equal(&entry->dst, dst)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_ipv6_dst_cache_add(uint32_t version, kernel_pid_t req_iface,
+                             const ipv6_addr_t *dst, kernel_pid_t iface,
+                             const uint8_t *l2addr, uint8_t l2addr_len)
+{
+    gnrc_ipv6_dst_cache_t *entry = NULL;
+    uint32_t now = xtimer_now_usec();
+    uint16_t mtu;
+
+    assert(l2addr_len <= GNRC_IPV6_NC_L2_ADDR_MAX);
+    if (version != gnrc_ipv6_dst_cache_version()) {
+        /* something changed during the lookup */
+        return;
+    }
+    mutex_lock(&_mutex);
+    mtu = _iface_mtu(iface, dst, now);
+    for (unsigned i = 0; i < GNRC_IPV6_DST_CACHE_SIZE; i++) {
+        /* reuse an outdated entry, preferably the one for the same
+         * destination */
+        if ((_cache[i].req_iface == req_iface) &&
+            ipv6_addr_equal(&_cache[i].dst, dst)) {
+            entry = &_cache[i];
+            break;
+        }
+        if ((entry == NULL) && !_valid(&_cache[i], version, now)) {
+            entry = &_cache[i];
+        }
+    }
+    if (entry == NULL) {
+        entry = &_cache[_next];
+        _next = (_next + 1) % GNRC_IPV6_DST_CACHE_SIZE;
+    }
+    DEBUG("ipv6 dst cache: add %s over interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), iface);
+    memcpy(&entry->dst, dst, sizeof(ipv6_addr_t));
+    entry->version = version;
+    entry->time = now;
+    entry->req_iface = req_iface;
+    entry->iface = iface;
+    entry->mtu = (mtu != UINT16_MAX) ? mtu : IPV6_MIN_MTU;
+    memcpy(entry->l2addr, l2addr, l2addr_len);
+    entry->l2addr_len = l2addr_len;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_ipv6_dst_cache_set_pmtu(const ipv6_addr_t *dst, uint16_t mtu)
+{
+    uint32_t now = xtimer_now_usec();
+    _pmtu_t *pmtu;
+
+    mutex_lock(&_mutex);
+    pmtu = _pmtu_get(dst, now);
+    if (mtu < IPV6_MIN_MTU) {
+        /* RFC 8201, section 4: a node must not reduce its estimate below the
+         * IPv6 minimum link MTU */
+        mtu = IPV6_MIN_MTU;
+    }
+    if ((pmtu != NULL) && (pmtu->mtu <= mtu)) {
+        /* RFC 8201, section 4: must not increase the estimate */
+        mutex_unlock(&_mutex);
+        return;
+    }
+    for (unsigned i = 0; (pmtu == NULL) && (i < GNRC_IPV6_DST_CACHE_PMTU_SIZE); i++) {
+        if (_pmtus[i].mtu == 0) {
+            pmtu = &_pmtus[i];
+        }
+    }
+    if (pmtu == NULL) {
+        pmtu = &_pmtus[_pmtu_next];
+        _pmtu_next = (_pmtu_next + 1) % GNRC_IPV6_DST_CACHE_PMTU_SIZE;
+    }
+    DEBUG("ipv6 dst cache: path MTU to %s is %u\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), (unsigned)mtu);
+    memcpy(&pmtu->dst, dst, sizeof(ipv6_addr_t));
+    pmtu->time = now;
+    pmtu->mtu = mtu;
+    for (unsigned i = 0; i < GNRC_IPV6_DST_CACHE_SIZE; i++) {
+        if (ipv6_addr_equal(&_cache[i].dst, dst) && (_cache[i].mtu > mtu)) {
+            _cache[i].mtu = mtu;
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+uint16_t gnrc_ipv6_dst_cache_get_pmtu(kernel_pid_t iface, const ipv6_addr_t *dst)
+{
+    uint32_t now = xtimer_now_usec();
+    uint16_t mtu;
+
+    mutex_lock(&_mutex);
+    if (iface == KERNEL_PID_UNDEF) {
+        uint32_t version = gnrc_ipv6_dst_cache_version();
+
+        for (unsigned i = 0; i < GNRC_IPV6_DST_CACHE_SIZE; i++) {
+            if (_valid(&_cache[i], version, now) &&
+                ipv6_addr_equal(&_cache[i].dst, dst)) {
+                iface = _cache[i].iface;
+                break;
+            }
+        }
+    }
+    mtu = _iface_mtu(iface, dst, now);
+    mutex_unlock(&_mutex);
+    return (mtu != UINT16_MAX) ? mtu : IPV6_MIN_MTU;
+}
@@ -22,13 +22,17 @@
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/ndp.h"
+#include "net/gnrc/pkttrace.h"
+#include "net/gnrc/rpl/srh.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc/sixlowpan/nd/router.h"
 #include "net/protnum.h"
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6/dst_cache.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
@@ -55,6 +59,13 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief buffer to store the longest-prefix-match index of the table
+ */
+static fib_trie_node_t _fib_trie_nodes[FIB_TRIE_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE)];
+#endif
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -91,6 +102,9 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+#ifdef MODULE_FIB_TRIE
+    gnrc_ipv6_fib_table.trie_nodes = _fib_trie_nodes;
+#endif
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -271,16 +285,46 @@ static void *_event_loop(void *args)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_RX, msg.content.ptr);
                 _receive(msg.content.ptr);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_RX, NULL);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_TX, msg.content.ptr);
                 _send(msg.content.ptr, true);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_TX, NULL);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_RCV_TRAIN:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_TRAIN received\n");
+                for (unsigned i = 0; i < gnrc_netapi_train_len(msg.content.ptr); i++) {
+                    gnrc_pktsnip_t *pkt = gnrc_netapi_train_get(msg.content.ptr, i);
+
+                    gnrc_pkttrace_enter(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_RX, pkt);
+                    _receive(pkt);
+                    gnrc_pkttrace_exit(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_RX, NULL);
+                }
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_TRAIN:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND_TRAIN received\n");
+                for (unsigned i = 0; i < gnrc_netapi_train_len(msg.content.ptr); i++) {
+                    gnrc_pktsnip_t *pkt = gnrc_netapi_train_get(msg.content.ptr, i);
+
+                    gnrc_pkttrace_enter(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_TX, pkt);
+                    _send(pkt, true);
+                    gnrc_pkttrace_exit(GNRC_PKTTRACE_IPV6, GNRC_PKTTRACE_TX, NULL);
+                }
+                gnrc_pktbuf_release(msg.content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 DEBUG("ipv6: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
@@ -290,6 +334,7 @@ static void *_event_loop(void *args)
             case GNRC_NDP_MSG_RTR_TIMEOUT:
                 DEBUG("ipv6: Router timeout received\n");
                 ((gnrc_ipv6_nc_t *)msg.content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                gnrc_ipv6_dst_cache_invalidate();
                 break;
 
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
@@ -348,18 +393,28 @@ static void *_event_loop(void *args)
                 DEBUG("ipv6: border router timeout event received\n");
                 gnrc_sixlowpan_nd_router_abr_remove(msg.content.ptr);
                 break;
-            /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
-             * solved properly */
-            /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
-            /*     DEBUG("ipv6: address registration timeout received\n"); */
-            /*     gnrc_sixlowpan_nd_router_gc_nc(msg.content.ptr); */
-            /*     break; */
+            case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT:
+                DEBUG("ipv6: address registration timeout received\n");
+                gnrc_sixlowpan_nd_router_reg_timeout();
+                break;
             case GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY:
                 DEBUG("ipv6: Delayed router advertisement event received\n");
                 gnrc_ipv6_nc_t *nc_entry = msg.content.ptr;
                 gnrc_ndp_internal_send_rtr_adv(nc_entry->iface, NULL,
                                                &(nc_entry->ipv6_addr), false);
                 break;
+#endif
+#if defined(MODULE_GNRC_NETAPI_DIRECT) && defined(MODULE_GNRC_SIXLOWPAN_FRAG)
+            /* 6LoWPAN sends fragments from the IPv6 thread */
+            case GNRC_SIXLOWPAN_MSG_FRAG_SND:
+                DEBUG("ipv6: 6LoWPAN fragment send event received\n");
+                gnrc_sixlowpan_frag_send(msg.content.ptr);
+                break;
+
+            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                DEBUG("ipv6: 6LoWPAN reassembly buffer garbage collection event received\n");
+                gnrc_sixlowpan_frag_rbuf_gc();
+                break;
 #endif
             default:
                 break;
@@ -544,50 +599,73 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
 #if GNRC_NETIF_NUMOF > 1
     /* interface not given: send over all interfaces */
     if (iface == KERNEL_PID_UNDEF) {
-        /* send packet to link layer */
+        uint8_t flags = 0;
+        ipv6_hdr_t *hdr = ipv6->data;
+        size_t i;
+        /* source address and hop limit are the only header fields that
+         * depend on the interface */
+        bool per_iface = prep_hdr && ((hdr->hl == 0) ||
+                                      ipv6_addr_is_unspecified(&hdr->src));
+
+        if (pkt != ipv6) {
+            /* the netif header is replaced per interface anyway, so only keep
+             * its flags (minus the broadcast/multicast flags) */
+            flags = ((gnrc_netif_hdr_t *)pkt->data)->flags &
+                    ~(GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST);
+            pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+        }
+        if (prep_hdr && !per_iface) {
+            /* headers are the same for all interfaces, so all of the packet
+             * can stay shared */
+            if (_fill_ipv6_hdr(ifs[0], ipv6, payload) < 0) {
+                /* error on filling up header */
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+        }
+        /* send packet to link layer: every interface gets its own netif
+         * header, the rest of the packet is shared by reference */
         gnrc_pktbuf_hold(pkt, ifnum - 1);
 
-        for (size_t i = 0; i < ifnum; i++) {
-            if (prep_hdr) {
+        for (i = 0; i < ifnum; i++) {
+            gnrc_pktsnip_t *netif;
+
+            ipv6 = pkt;
+            if (per_iface) {
                 /* need to get second write access (duplication) to fill IPv6
-                 * header interface-local */
-                gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
-                gnrc_pktsnip_t *ptr = tmp->next;
-                ipv6 = tmp;
+                 * header interface-local.
+                 * multiple interfaces => possibly different source addresses
+                 * => different checksums => duplication of the upper layer
+                 * headers needed, the raw payload stays shared */
+                ipv6 = gnrc_pktbuf_start_write_hdrs(pkt);
 
                 if (ipv6 == NULL) {
-                    DEBUG("ipv6: unable to get write access to IPv6 header, "
+                    DEBUG("ipv6: unable to get write access to IPv6 headers, "
                           "for interface %" PRIkernel_pid "\n", ifs[i]);
-                    gnrc_pktbuf_release(pkt);
-                    return;
+                    break;
                 }
 
-                /* multiple interfaces => possibly different source addresses
-                 * => different checksums => duplication of payload needed */
-                while (ptr != payload->next) {
-                    /* duplicate everything including payload */
-                    tmp->next = gnrc_pktbuf_start_write(ptr);
-                    if (tmp->next == NULL) {
-                        DEBUG("ipv6: unable to get write access to payload, drop it\n");
-                        gnrc_pktbuf_release(ipv6);
-                        return;
-                    }
-                    tmp = tmp->next;
-                    ptr = ptr->next;
-                }
-
-                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
+                if (_fill_ipv6_hdr(ifs[i], ipv6, ipv6->next) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(ipv6);
-                    return;
+                    break;
                 }
             }
 
-            if ((ipv6 = _create_netif_hdr(NULL, 0, ipv6)) == NULL) {
-                return;
+            netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+            if (netif == NULL) {
+                DEBUG("ipv6: error on interface header allocation, dropping packet\n");
+                gnrc_pktbuf_release(ipv6);
+                break;
             }
+            ((gnrc_netif_hdr_t *)netif->data)->flags = flags;
+            LL_PREPEND(ipv6, netif);
 
-            _send_multicast_over_iface(ifs[i], ipv6);
+            _send_multicast_over_iface(ifs[i], netif);
+        }
+        /* on error: release the references for the interfaces not sent to */
+        while (++i < ifnum) {
+            gnrc_pktbuf_release(pkt);
         }
     }
     else {
@@ -624,9 +702,9 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
 #endif  /* GNRC_NETIF_NUMOF */
 }
 
-static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
-                                            kernel_pid_t iface, ipv6_addr_t *dst,
-                                            gnrc_pktsnip_t *pkt)
+static inline kernel_pid_t _lookup_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
+                                                   kernel_pid_t iface, ipv6_addr_t *dst,
+                                                   gnrc_pktsnip_t *pkt)
 {
     kernel_pid_t found_iface;
 #if defined(MODULE_GNRC_SIXLOWPAN_ND)
@@ -654,6 +732,64 @@ static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len
     return found_iface;
 }
 
+static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
+                                            kernel_pid_t iface, ipv6_addr_t *dst,
+                                            gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_IPV6_DST_CACHE
+    const gnrc_ipv6_dst_cache_t *dc = gnrc_ipv6_dst_cache_get(iface, dst);
+    uint32_t version;
+    kernel_pid_t found_iface;
+
+    if (dc != NULL) {
+        DEBUG("ipv6: next hop found in destination cache\n");
+        memcpy(l2addr, dc->l2addr, dc->l2addr_len);
+        *l2addr_len = dc->l2addr_len;
+        return dc->iface;
+    }
+    version = gnrc_ipv6_dst_cache_version();
+    found_iface = _lookup_next_hop_l2addr(l2addr, l2addr_len, iface, dst, pkt);
+    if (found_iface > KERNEL_PID_UNDEF) {
+        gnrc_ipv6_dst_cache_add(version, iface, dst, found_iface, l2addr,
+                                *l2addr_len);
+    }
+    return found_iface;
+#else
+    return _lookup_next_hop_l2addr(l2addr, l2addr_len, iface, dst, pkt);
+#endif
+}
+
+#ifdef MODULE_GNRC_RPL_SRH
+/* inserts the source routing header of the RPL root behind the IPv6 header
+ * and a hop-by-hop options header of a prepared packet */
+static int _insert_srh(gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *srh,
+                       const ipv6_addr_t *first_hop)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    gnrc_pktsnip_t *prev = ipv6;
+    uint8_t *nh = &hdr->nh;
+
+    if ((hdr->nh == PROTNUM_IPV6_EXT_HOPOPT) && (ipv6->next != NULL) &&
+        (ipv6->next->size >= sizeof(ipv6_ext_t))) {
+        if ((prev = gnrc_pktbuf_start_write(ipv6->next)) == NULL) {
+            DEBUG("ipv6: unable to get write access to hop-by-hop options\n");
+            gnrc_pktbuf_release(srh);
+            return -ENOMEM;
+        }
+        ipv6->next = prev;
+        nh = &((ipv6_ext_t *)prev->data)->nh;
+    }
+    ((gnrc_rpl_srh_t *)srh->data)->nh = *nh;
+    *nh = PROTNUM_IPV6_EXT_RH;
+    srh->next = prev->next;
+    prev->next = srh;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + srh->size);
+    /* the checksums were already calculated for the final destination */
+    memcpy(&hdr->dst, first_hop, sizeof(ipv6_addr_t));
+    return 0;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 {
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -746,11 +882,25 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     else {
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
+        ipv6_addr_t *next_dst = &hdr->dst;
+#ifdef MODULE_GNRC_RPL_SRH
+        gnrc_pktsnip_t *srh = NULL;
+        ipv6_addr_t first_hop;
+
+        /* source routes of a RPL root in non-storing mode: only for own
+         * packets, forwarded ones would need IPv6-in-IPv6 encapsulation */
+        if (prep_hdr && ((srh = gnrc_rpl_srh_build(&hdr->dst, &first_hop)) != NULL)) {
+            next_dst = &first_hop;
+        }
+#endif
 
-        iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
+        iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, next_dst, pkt);
 
         if (iface == KERNEL_PID_UNDEF) {
             DEBUG("ipv6: error determining next hop's link layer address\n");
+#ifdef MODULE_GNRC_RPL_SRH
+            gnrc_pktbuf_release(srh);
+#endif
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -758,16 +908,97 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         if (prep_hdr) {
             if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
                 /* error on filling up header */
+#ifdef MODULE_GNRC_RPL_SRH
+                gnrc_pktbuf_release(srh);
+#endif
                 gnrc_pktbuf_release(pkt);
                 return;
             }
         }
 
+#ifdef MODULE_GNRC_RPL_SRH
+        if ((srh != NULL) && (_insert_srh(ipv6, srh, &first_hop) < 0)) {
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+#endif
+
         _send_unicast(iface, l2addr, l2addr_len, pkt);
     }
 }
 
 /* functions for receiving */
+#ifdef MODULE_GNRC_IPV6_ROUTER
+/* forwards a received packet without looking at its extension headers:
+ * the IPv6 header is the only snip written to and the netif header of
+ * reception is reused for sending */
+static void _forward(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *reversed_pkt = NULL, *netif = NULL, *ptr = pkt;
+    gnrc_netif_hdr_t *netif_hdr;
+    ipv6_hdr_t *hdr;
+    kernel_pid_t iface;
+    uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
+    uint8_t l2addr[l2addr_len];
+
+    /* reverse packet snip list order and put the netif header aside */
+    while (ptr != NULL) {
+        gnrc_pktsnip_t *next = gnrc_pktbuf_start_write(ptr); /* duplicate if not
+                                                              * already done */
+        if (next == NULL) {
+            DEBUG("ipv6: unable to get write access to packet: dropping it\n");
+            gnrc_pktbuf_release(reversed_pkt);
+            gnrc_pktbuf_release(netif);
+            gnrc_pktbuf_release(ptr);   /* the rest of the list */
+            return;
+        }
+        ptr = next;
+        next = ptr->next;
+        if (ptr->type == GNRC_NETTYPE_NETIF) {
+            ptr->next = NULL;
+            netif = ptr;
+        }
+        else {
+            ptr->next = reversed_pkt;
+            reversed_pkt = ptr;
+        }
+        ptr = next;
+    }
+    /* the IPv6 header was the last snip before the netif header */
+    hdr = reversed_pkt->data;
+    hdr->hl--;
+    DEBUG("ipv6: forward packet to next hop\n");
+    if (ipv6_addr_is_multicast(&hdr->dst)) {
+        gnrc_pktbuf_release(netif);
+        _send(reversed_pkt, false);
+        return;
+    }
+    iface = _next_hop_l2addr(l2addr, &l2addr_len, KERNEL_PID_UNDEF, &hdr->dst,
+                             reversed_pkt);
+    if (iface == KERNEL_PID_UNDEF) {
+        DEBUG("ipv6: error determining next hop's link layer address\n");
+        gnrc_pktbuf_release(netif);
+        gnrc_pktbuf_release(reversed_pkt);
+        return;
+    }
+    /* rewrite the netif header of reception for the next hop */
+    if ((netif == NULL) ||
+        (gnrc_pktbuf_realloc_data(netif, sizeof(gnrc_netif_hdr_t) + l2addr_len) != 0)) {
+        gnrc_pktbuf_release(netif);
+        _send_unicast(iface, l2addr, l2addr_len, reversed_pkt);
+        return;
+    }
+    netif_hdr = netif->data;
+    gnrc_netif_hdr_init(netif_hdr, 0, l2addr_len);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr, l2addr, l2addr_len);
+    netif->next = reversed_pkt;
+#ifdef MODULE_NETSTATS_IPV6
+    gnrc_ipv6_netif_get_stats(iface)->tx_unicast_count++;
+#endif
+    _send_to_iface(iface, netif);
+}
+#endif /* MODULE_GNRC_IPV6_ROUTER */
+
 static inline bool _pkt_not_for_me(kernel_pid_t *iface, ipv6_hdr_t *hdr)
 {
     if (ipv6_addr_is_loopback(&hdr->dst)) {
@@ -919,41 +1150,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
             return;
         }
         /* TODO: check if receiving interface is router */
-        else if (--(hdr->hl) > 0) {  /* drop packets that *reach* Hop Limit 0 */
-            gnrc_pktsnip_t *reversed_pkt = NULL, *ptr = pkt;
-
-            DEBUG("ipv6: forward packet to next hop\n");
-
-            /* pkt might not be writable yet, if header was given above */
-            ipv6 = gnrc_pktbuf_start_write(ipv6);
-            if (ipv6 == NULL) {
-                DEBUG("ipv6: unable to get write access to packet: dropping it\n");
-                gnrc_pktbuf_release(pkt);
-                return;
-            }
-
-            /* remove L2 headers around IPV6 */
-            netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
-            if (netif != NULL) {
-                gnrc_pktbuf_remove_snip(pkt, netif);
-            }
-
-            /* reverse packet snip list order */
-            while (ptr != NULL) {
-                gnrc_pktsnip_t *next;
-                ptr = gnrc_pktbuf_start_write(ptr);     /* duplicate if not already done */
-                if (ptr == NULL) {
-                    DEBUG("ipv6: unable to get write access to packet: dropping it\n");
-                    gnrc_pktbuf_release(reversed_pkt);
-                    gnrc_pktbuf_release(pkt);
-                    return;
-                }
-                next = ptr->next;
-                ptr->next = reversed_pkt;
-                reversed_pkt = ptr;
-                ptr = next;
-            }
-            _send(reversed_pkt, false);
+        else if (hdr->hl > 1) {  /* drop packets that *reach* Hop Limit 0 */
+            _forward(pkt);
             return;
         }
         else {
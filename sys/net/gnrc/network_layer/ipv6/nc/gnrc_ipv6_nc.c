@@ -17,6 +17,7 @@
 
 #include "net/gnrc/ipv6.h"
 #include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/dst_cache.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ndp.h"
@@ -37,6 +38,95 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+#define HASH_EMPTY      (0U)
+#define HASH_REMOVED    (UINT16_MAX)
+
+/* open addressing index into ncache by IPv6 address, slots hold the entry's
+ * position + 1. Addresses are unique in the neighbor cache, so the interface
+ * is only checked on lookup. */
+static uint16_t _hash_index[GNRC_IPV6_NC_HASH_SIZE];
+
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    /* multiplicative hashing, the upper bits are the well mixed ones */
+    return ((h * 2654435769U) >> 16) % GNRC_IPV6_NC_HASH_SIZE;
+}
+
+static inline unsigned _hash_next(unsigned slot)
+{
+    return (slot + 1) % GNRC_IPV6_NC_HASH_SIZE;
+}
+
+static void _hash_add(gnrc_ipv6_nc_t *entry)
+{
+    unsigned slot = _hash(&entry->ipv6_addr);
+
+    for (unsigned i = 0; i < GNRC_IPV6_NC_HASH_SIZE; i++) {
+        if ((_hash_index[slot] == HASH_EMPTY) ||
+            (_hash_index[slot] == HASH_REMOVED)) {
+            _hash_index[slot] = (entry - ncache) + 1;
+            return;
+        }
+        slot = _hash_next(slot);
+    }
+    /* can't happen since the index is larger than the neighbor cache */
+    assert(false);
+}
+
+static void _hash_remove(gnrc_ipv6_nc_t *entry)
+{
+    unsigned slot = _hash(&entry->ipv6_addr);
+    uint16_t value = (entry - ncache) + 1;
+
+    for (unsigned i = 0; i < GNRC_IPV6_NC_HASH_SIZE; i++) {
+        if (_hash_index[slot] == HASH_EMPTY) {
+            return;
+        }
+        if (_hash_index[slot] == value) {
+            _hash_index[slot] = HASH_REMOVED;
+            if (_hash_index[_hash_next(slot)] == HASH_EMPTY) {
+                /* end of a probe sequence: no lookup needs to step over the
+                 * removed slots before it anymore */
+                while (_hash_index[slot] == HASH_REMOVED) {
+                    _hash_index[slot] = HASH_EMPTY;
+                    slot = (slot + GNRC_IPV6_NC_HASH_SIZE - 1) % GNRC_IPV6_NC_HASH_SIZE;
+                }
+            }
+            return;
+        }
+        slot = _hash_next(slot);
+    }
+}
+
+static gnrc_ipv6_nc_t *_hash_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
+{
+    unsigned slot = _hash(ipv6_addr);
+
+    for (unsigned i = 0; i < GNRC_IPV6_NC_HASH_SIZE; i++) {
+        uint16_t value = _hash_index[slot];
+
+        if (value == HASH_EMPTY) {
+            break;
+        }
+        if (value != HASH_REMOVED) {
+            gnrc_ipv6_nc_t *entry = &ncache[value - 1];
+
+            if (((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+                 (iface == entry->iface)) &&
+                ipv6_addr_equal(&entry->ipv6_addr, ipv6_addr)) {
+                return entry;
+            }
+        }
+        slot = _hash_next(slot);
+    }
+    return NULL;
+}
+#endif
+
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
@@ -47,6 +137,12 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     DEBUG("ipv6_nc: Remove %s for interface %" PRIkernel_pid "\n",
           ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)),
           iface);
+    gnrc_ipv6_dst_cache_invalidate();
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    if (!ipv6_addr_is_unspecified(&entry->ipv6_addr)) {
+        _hash_remove(entry);
+    }
+#endif
 
 #ifdef MODULE_GNRC_NDP_NODE
     while (entry->pkts != NULL) {
@@ -86,6 +182,9 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    memset(_hash_index, 0, sizeof(_hash_index));
+#endif
 }
 
 gnrc_ipv6_nc_t *_find_free_entry(void)
@@ -102,7 +201,7 @@ gnrc_ipv6_nc_t *_find_free_entry(void)
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
-    gnrc_ipv6_nc_t *free_entry = NULL;
+    gnrc_ipv6_nc_t *free_entry = NULL, *entry = NULL;
 
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
@@ -114,23 +213,17 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
+    gnrc_ipv6_dst_cache_invalidate();
+
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    if ((entry = _hash_get(KERNEL_PID_UNDEF, ipv6_addr)) == NULL) {
+        free_entry = _find_free_entry();
+    }
+#else
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
-
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
-
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
-
-            }
-            return &ncache[i];
+            entry = &ncache[i];
+            break;
         }
 
         if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
@@ -138,6 +231,25 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
             free_entry = &ncache[i];
         }
     }
+#endif
+
+    if (entry != NULL) {
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                         l2_addr, l2_addr_len));
+
+            memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+            entry->l2_addr_len = l2_addr_len;
+            entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
+
+        }
+        return entry;
+    }
 
     if (!free_entry) {
         /* reached end of NC without finding updateable or free entry */
@@ -152,6 +264,9 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     free_entry->pkts = NULL;
 #endif
     memcpy(&(free_entry->ipv6_addr), ipv6_addr, sizeof(ipv6_addr_t));
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    _hash_add(free_entry);
+#endif
     DEBUG("ipv6_nc: Register %s for interface %" PRIkernel_pid,
           ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
           iface);
@@ -204,6 +319,17 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    gnrc_ipv6_nc_t *entry = _hash_get(iface, ipv6_addr);
+
+    if (entry != NULL) {
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
+    }
+    return entry;
+#else
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
              (iface == ncache[i].iface)) &&
@@ -218,6 +344,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     }
 
     return NULL;
+#endif
 }
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_next(gnrc_ipv6_nc_t *prev)
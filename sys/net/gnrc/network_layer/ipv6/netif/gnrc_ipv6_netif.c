@@ -32,6 +32,7 @@
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc/sixlowpan/netif.h"
 
+#include "net/gnrc/ipv6/dst_cache.h"
 #include "net/gnrc/ipv6/netif.h"
 
 #define ENABLE_DEBUG    (0)
@@ -51,12 +52,99 @@
 /* number of "points" assigned to an source address candidate in preferred state */
 #define RULE_3_PTS          (1)
 
+/* addresses in the index are identified by their position among the
+ * addresses of all interfaces */
+#define INDEX_SLOT_NUMOF    (GNRC_NETIF_NUMOF * GNRC_IPV6_NETIF_ADDR_NUMOF)
+#define INDEX_NONE          (UINT8_MAX)
+
+#if INDEX_SLOT_NUMOF >= INDEX_NONE
+#error "gnrc_ipv6_netif: too many addresses for the address index"
+#endif
+
 static gnrc_ipv6_netif_t ipv6_ifs[GNRC_NETIF_NUMOF];
 
+/* interface addresses hashed by their value, chained by slot */
+static uint8_t _index_head[GNRC_IPV6_NETIF_ADDR_INDEX_SIZE];
+static uint8_t _index_next[INDEX_SLOT_NUMOF];
+static mutex_t _index_mutex = MUTEX_INIT;
+
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+static inline unsigned _index_hash(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return h % GNRC_IPV6_NETIF_ADDR_INDEX_SIZE;
+}
+
+static inline uint8_t _index_slot(const gnrc_ipv6_netif_t *entry,
+                                  const gnrc_ipv6_netif_addr_t *addr)
+{
+    return ((entry - ipv6_ifs) * GNRC_IPV6_NETIF_ADDR_NUMOF) + (addr - entry->addrs);
+}
+
+static inline gnrc_ipv6_netif_addr_t *_index_addr(uint8_t slot)
+{
+    return &ipv6_ifs[slot / GNRC_IPV6_NETIF_ADDR_NUMOF].addrs[slot % GNRC_IPV6_NETIF_ADDR_NUMOF];
+}
+
+static void _index_add(const gnrc_ipv6_netif_t *entry, const gnrc_ipv6_netif_addr_t *addr)
+{
+    uint8_t slot = _index_slot(entry, addr);
+    unsigned h = _index_hash(&addr->addr);
+
+    mutex_lock(&_index_mutex);
+    _index_next[slot] = _index_head[h];
+    _index_head[h] = slot;
+    mutex_unlock(&_index_mutex);
+}
+
+/* must be called before @p addr is cleared */
+static void _index_rm(const gnrc_ipv6_netif_t *entry, const gnrc_ipv6_netif_addr_t *addr)
+{
+    uint8_t slot = _index_slot(entry, addr);
+    uint8_t *cur;
+
+    mutex_lock(&_index_mutex);
+    for (cur = &_index_head[_index_hash(&addr->addr)]; *cur != INDEX_NONE;
+         cur = &_index_next[*cur]) {
+        if (*cur == slot) {
+            *cur = _index_next[slot];
+            break;
+        }
+    }
+    mutex_unlock(&_index_mutex);
+}
+
+/* slot of @p addr on @p entry, or on the first interface having it if
+ * @p entry is NULL */
+static uint8_t _index_find(const gnrc_ipv6_netif_t *entry, const ipv6_addr_t *addr)
+{
+    uint8_t res = INDEX_NONE;
+
+    if (ipv6_addr_is_unspecified(addr)) {
+        /* never assigned, it only marks free addresses */
+        return INDEX_NONE;
+    }
+
+    mutex_lock(&_index_mutex);
+    for (uint8_t slot = _index_head[_index_hash(addr)]; slot != INDEX_NONE;
+         slot = _index_next[slot]) {
+        if ((slot < res) &&
+            ((entry == NULL) || (slot / GNRC_IPV6_NETIF_ADDR_NUMOF == entry - ipv6_ifs)) &&
+            ipv6_addr_equal(&_index_addr(slot)->addr, addr)) {
+            res = slot;
+        }
+    }
+    mutex_unlock(&_index_mutex);
+
+    return res;
+}
+
 static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr_t *addr,
                                        uint8_t prefix_len, uint8_t flags)
 {
@@ -80,12 +168,14 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
     }
 
     memcpy(&(tmp_addr->addr), addr, sizeof(ipv6_addr_t));
+    _index_add(entry, tmp_addr);
     DEBUG("ipv6 netif: Added %s/%" PRIu8 " to interface %" PRIkernel_pid "\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
           prefix_len, entry->pid);
 
     tmp_addr->prefix_len = prefix_len;
     tmp_addr->flags = flags;
+    gnrc_ipv6_dst_cache_invalidate();
 
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
     if (!ipv6_addr_is_multicast(&(tmp_addr->addr)) &&
@@ -164,7 +254,13 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 static void _reset_addr_from_entry(gnrc_ipv6_netif_t *entry)
 {
     DEBUG("ipv6 netif: Reset IPv6 addresses on interface %" PRIkernel_pid "\n", entry->pid);
+    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
+        if (!ipv6_addr_is_unspecified(&(entry->addrs[i].addr))) {
+            _index_rm(entry, &(entry->addrs[i]));
+        }
+    }
     memset(entry->addrs, 0, sizeof(entry->addrs));
+    gnrc_ipv6_dst_cache_invalidate();
 }
 
 static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
@@ -192,6 +288,7 @@ static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
 
 void gnrc_ipv6_netif_init(void)
 {
+    memset(_index_head, INDEX_NONE, sizeof(_index_head));
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         mutex_init(&(ipv6_ifs[i].mutex));
         _ipv6_netif_remove(&ipv6_ifs[i]);
@@ -320,8 +417,10 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
             DEBUG("ipv6 netif: Remove %s to interface %" PRIkernel_pid "\n",
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), entry->pid);
+            _index_rm(entry, &(entry->addrs[i]));
             ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
             entry->addrs[i].flags = 0;
+            gnrc_ipv6_dst_cache_invalidate();
 #ifdef MODULE_GNRC_NDP_ROUTER
             /* Removal of prefixes MAY allow the router to retransmit up to
              * GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF unsolicited RA
@@ -384,56 +483,44 @@ void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid)
 
 kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
-        if (out != NULL) {
-            *out = gnrc_ipv6_netif_find_addr(ipv6_ifs[i].pid, addr);
+    uint8_t slot = _index_find(NULL, addr);
 
-            if (*out != NULL) {
-                DEBUG("ipv6 netif: Found %s on interface %" PRIkernel_pid "\n",
-                      ipv6_addr_to_str(addr_str, *out, sizeof(addr_str)),
-                      ipv6_ifs[i].pid);
-                return ipv6_ifs[i].pid;
-            }
-        }
-        else {
-            if (gnrc_ipv6_netif_find_addr(ipv6_ifs[i].pid, addr) != NULL) {
-                DEBUG("ipv6 netif: Found :: on interface %" PRIkernel_pid "\n",
-                      ipv6_ifs[i].pid);
-                return ipv6_ifs[i].pid;
-            }
+    if (slot == INDEX_NONE) {
+        if (out != NULL) {
+            *out = NULL;
         }
+        return KERNEL_PID_UNDEF;
     }
 
+    kernel_pid_t pid = ipv6_ifs[slot / GNRC_IPV6_NETIF_ADDR_NUMOF].pid;
+
+    DEBUG("ipv6 netif: Found %s on interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), pid);
     if (out != NULL) {
-        *out = NULL;
+        *out = &(_index_addr(slot)->addr);
     }
 
-    return KERNEL_PID_UNDEF;
+    return pid;
 }
 
 ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr)
 {
     gnrc_ipv6_netif_t *entry = gnrc_ipv6_netif_get(pid);
+    uint8_t slot;
 
     if (entry == NULL) {
         return NULL;
     }
 
-    mutex_lock(&entry->mutex);
-
-    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
-        if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
-            mutex_unlock(&entry->mutex);
-            DEBUG("ipv6 netif: Found %s on interface %" PRIkernel_pid "\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
-                  pid);
-            return &(entry->addrs[i].addr);
-        }
+    slot = _index_find(entry, addr);
+    if (slot == INDEX_NONE) {
+        return NULL;
     }
 
-    mutex_unlock(&entry->mutex);
-
-    return NULL;
+    DEBUG("ipv6 netif: Found %s on interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
+          pid);
+    return &(_index_addr(slot)->addr);
 }
 
 static uint8_t _find_by_prefix_unsafe(ipv6_addr_t **res, gnrc_ipv6_netif_t *iface,
@@ -36,6 +36,16 @@ static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
 static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_iface_t _nis[GNRC_NETIF_NUMOF];
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+#define HASH_EMPTY      (0U)
+#define HASH_REMOVED    (UINT16_MAX)
+
+/* open addressing index into _nodes by IPv6 address, slots hold the node's
+ * position + 1. Nodes for the same address on different interfaces end up
+ * in the same probe sequence. */
+static uint16_t _hash_index[GNRC_IPV6_NIB_HASH_SIZE];
+#endif
+
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
@@ -46,12 +56,92 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    /* multiplicative hashing, the upper bits are the well mixed ones */
+    return ((h * 2654435769U) >> 16) % GNRC_IPV6_NIB_HASH_SIZE;
+}
+
+static inline unsigned _hash_next(unsigned slot)
+{
+    return (slot + 1) % GNRC_IPV6_NIB_HASH_SIZE;
+}
+
+static void _hash_add(_nib_onl_entry_t *node)
+{
+    unsigned slot = _hash(&node->ipv6);
+
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_HASH_SIZE; i++) {
+        if ((_hash_index[slot] == HASH_EMPTY) ||
+            (_hash_index[slot] == HASH_REMOVED)) {
+            _hash_index[slot] = (node - _nodes) + 1;
+            return;
+        }
+        slot = _hash_next(slot);
+    }
+    /* can't happen since the index is larger than _nodes */
+    assert(false);
+}
+
+void _nib_onl_hash_remove(_nib_onl_entry_t *node)
+{
+    unsigned slot = _hash(&node->ipv6);
+    uint16_t value = (node - _nodes) + 1;
+
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_HASH_SIZE; i++) {
+        if (_hash_index[slot] == HASH_EMPTY) {
+            return;
+        }
+        if (_hash_index[slot] == value) {
+            _hash_index[slot] = HASH_REMOVED;
+            if (_hash_index[_hash_next(slot)] == HASH_EMPTY) {
+                /* end of a probe sequence: no lookup needs to step over the
+                 * removed slots before it anymore */
+                while (_hash_index[slot] == HASH_REMOVED) {
+                    _hash_index[slot] = HASH_EMPTY;
+                    slot = (slot + GNRC_IPV6_NIB_HASH_SIZE - 1) % GNRC_IPV6_NIB_HASH_SIZE;
+                }
+            }
+            return;
+        }
+        slot = _hash_next(slot);
+    }
+}
+
+/* returns the next node after slot *pos in the probe sequence of addr */
+static _nib_onl_entry_t *_hash_iter(const ipv6_addr_t *addr, unsigned *pos,
+                                    unsigned *slot)
+{
+    for (; *pos < GNRC_IPV6_NIB_HASH_SIZE; (*pos)++) {
+        uint16_t value = _hash_index[*slot];
+
+        if (value == HASH_EMPTY) {
+            break;
+        }
+        *slot = _hash_next(*slot);
+        if ((value != HASH_REMOVED) &&
+            ipv6_addr_equal(&_nodes[value - 1].ipv6, addr)) {
+            (*pos)++;
+            return &_nodes[value - 1];
+        }
+    }
+    return NULL;
+}
+#endif
+
 void _nib_init(void)
 {
 #ifdef TEST_SUITES
     _prime_def_router = NULL;
     _next_removable.next = NULL;
     memset(_nodes, 0, sizeof(_nodes));
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    memset(_hash_index, 0, sizeof(_hash_index));
+#endif
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_nis, 0, sizeof(_nis));
 #endif
@@ -65,6 +155,24 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    unsigned pos = 0, slot = _hash(addr);
+    _nib_onl_entry_t *tmp;
+
+    while ((tmp = _hash_iter(addr, &pos, &slot)) != NULL) {
+        if (_nib_onl_get_if(tmp) == iface) {
+            /* exact match */
+            DEBUG("  %p is an exact match\n", (void *)tmp);
+            return tmp;
+        }
+    }
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        if (_nodes[i].mode == _EMPTY) {
+            node = &_nodes[i];
+            break;
+        }
+    }
+#else
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -78,6 +186,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
             node = tmp;
         }
     }
+#endif
     if (node != NULL) {
         DEBUG("  using %p\n", (void *)node);
         _override_node(addr, iface, node);
@@ -185,6 +294,19 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    unsigned pos = 0, slot = _hash(addr);
+    _nib_onl_entry_t *node;
+
+    while ((node = _hash_iter(addr, &pos, &slot)) != NULL) {
+        if ((node->mode != _EMPTY) &&
+            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+             (_nib_onl_get_if(node) == iface))) {
+            DEBUG("  Found %p\n", (void *)node);
+            return node;
+        }
+    }
+#else
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
@@ -198,6 +320,7 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
             return node;
         }
     }
+#endif
     DEBUG("  No suitable entry found\n");
     return NULL;
 }
@@ -369,6 +492,9 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
     _nib_onl_clear(node);
     memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     _nib_onl_set_if(node, iface);
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    _hash_add(node);
+#endif
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
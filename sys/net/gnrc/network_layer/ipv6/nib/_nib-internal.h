@@ -244,6 +244,17 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if defined(MODULE_GNRC_IPV6_NC_HASH) || defined(DOXYGEN)
+/**
+ * @brief   Removes an on-link entry from the hash index
+ *
+ * @note    Only available with module `gnrc_ipv6_nc_hash`.
+ *
+ * @param[in] node  An entry. Entries not in the index are ignored.
+ */
+void _nib_onl_hash_remove(_nib_onl_entry_t *node);
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -255,6 +266,9 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+        _nib_onl_hash_remove(node);
+#endif
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
@@ -13,16 +13,13 @@
  * @author Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
-#include <string.h>
-#include "bitfield.h"
-
 #include "net/gnrc/ipv6/whitelist.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-ipv6_addr_t gnrc_ipv6_whitelist[GNRC_IPV6_WHITELIST_SIZE];
-BITFIELD(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE);
+static gnrc_ipv6_addr_set_entry_t _entries[GNRC_IPV6_WHITELIST_SIZE];
+gnrc_ipv6_addr_set_t gnrc_ipv6_whitelist = GNRC_IPV6_ADDR_SET_INIT(_entries);
 
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -30,38 +27,37 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 int gnrc_ipv6_whitelist_add(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (!bf_isset(gnrc_ipv6_whitelist_set, i)) {
-            bf_set(gnrc_ipv6_whitelist_set, i);
-            memcpy(&gnrc_ipv6_whitelist[i], addr, sizeof(*addr));
-            DEBUG("IPv6 whitelist: whitelisted %s\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
-            return 0;
-        }
-    }
-    return -1;
+    return gnrc_ipv6_whitelist_add_prefix(addr, IPV6_ADDR_BIT_LEN);
 }
 
 void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (ipv6_addr_equal(addr, &gnrc_ipv6_whitelist[i])) {
-            bf_unset(gnrc_ipv6_whitelist_set, i);
-            DEBUG("IPv6 whitelist: unwhitelisted %s\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
-        }
+    gnrc_ipv6_whitelist_del_prefix(addr, IPV6_ADDR_BIT_LEN);
+}
+
+int gnrc_ipv6_whitelist_add_prefix(const ipv6_addr_t *prefix, uint8_t len)
+{
+    if (gnrc_ipv6_addr_set_add(&gnrc_ipv6_whitelist, prefix, len) < 0) {
+        return -1;
     }
+    DEBUG("IPv6 whitelist: whitelisted %s/%u\n",
+          ipv6_addr_to_str(addr_str, prefix, sizeof(addr_str)),
+          (unsigned)len);
+    return 0;
 }
 
-bool gnrc_ipv6_whitelisted(const ipv6_addr_t *addr)
+void gnrc_ipv6_whitelist_del_prefix(const ipv6_addr_t *prefix, uint8_t len)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (bf_isset(gnrc_ipv6_whitelist_set, i) &&
-            ipv6_addr_equal(addr, &gnrc_ipv6_whitelist[i])) {
-            return true;
-        }
+    if (gnrc_ipv6_addr_set_del(&gnrc_ipv6_whitelist, prefix, len) == 0) {
+        DEBUG("IPv6 whitelist: unwhitelisted %s/%u\n",
+              ipv6_addr_to_str(addr_str, prefix, sizeof(addr_str)),
+              (unsigned)len);
     }
-    return false;
+}
+
+bool gnrc_ipv6_whitelisted(const ipv6_addr_t *addr)
+{
+    return gnrc_ipv6_addr_set_match(&gnrc_ipv6_whitelist, addr);
 }
 
 /** @} */
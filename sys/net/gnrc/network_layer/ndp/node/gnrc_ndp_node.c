@@ -20,7 +20,9 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pktqueue.h"
+#include "utlist.h"
 
 #include "net/gnrc/ndp/internal.h"
 
@@ -33,7 +35,7 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static gnrc_pktqueue_t _pkt_nodes[GNRC_IPV6_NC_SIZE * 2];
+static gnrc_pktqueue_t _pkt_nodes[GNRC_NDP_NODE_QUEUE_SIZE];
 
 /**
  * @brief   Allocates a node for the packet queue.
@@ -55,6 +57,36 @@ static gnrc_pktqueue_t *_alloc_pkt_node(gnrc_pktsnip_t *pkt)
     return NULL;
 }
 
+/**
+ * @brief   Queues a packet until address resolution for a neighbor finished.
+ *
+ * @param[in] nc_entry  Neighbor cache entry of the neighbor.
+ * @param[in] pkt       Packet to queue. May be NULL.
+ */
+static void _queue_pkt(gnrc_ipv6_nc_t *nc_entry, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktqueue_t *pkt_node, *tmp;
+    unsigned queued;
+
+    if (pkt == NULL) {
+        return;
+    }
+    LL_COUNT(nc_entry->pkts, tmp, queued);
+    if (queued >= GNRC_NDP_NODE_QUEUE_NBR_SIZE) {
+        DEBUG("ndp node: packet queue of neighbor full, drop oldest packet\n");
+        pkt_node = gnrc_pktqueue_remove_head(&nc_entry->pkts);
+        gnrc_pktbuf_release(pkt_node->pkt);
+        pkt_node->pkt = pkt;
+    }
+    else if ((pkt_node = _alloc_pkt_node(pkt)) == NULL) {
+        DEBUG("ndp node: could not add packet to packet queue\n");
+        return;
+    }
+    /* prevent packet from being released by IPv6 */
+    gnrc_pktbuf_hold(pkt_node->pkt, 1);
+    gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
+}
+
 kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                                            kernel_pid_t iface, ipv6_addr_t *dst,
                                            gnrc_pktsnip_t *pkt)
@@ -127,7 +159,6 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
         return gnrc_ipv6_nc_get_l2_addr(l2addr, l2addr_len, nc_entry);
     }
     else if (nc_entry == NULL) {
-        gnrc_pktqueue_t *pkt_node;
         ipv6_addr_t dst_sol;
 
         nc_entry = gnrc_ipv6_nc_add(iface, next_hop_ip, NULL, 0,
@@ -138,16 +169,7 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             return KERNEL_PID_UNDEF;
         }
 
-        pkt_node = _alloc_pkt_node(pkt);
-
-        if (pkt_node == NULL) {
-            DEBUG("ndp node: could not add packet to packet queue\n");
-        }
-        else {
-            /* prevent packet from being released by IPv6 */
-            gnrc_pktbuf_hold(pkt_node->pkt, 1);
-            gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
-        }
+        _queue_pkt(nc_entry, pkt);
 
         /* address resolution */
         ipv6_addr_set_solicited_nodes(&dst_sol, next_hop_ip);
@@ -174,6 +196,10 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             mutex_unlock(&ipv6_iface->mutex);
         }
     }
+    else if (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE) {
+        /* address resolution is already performed */
+        _queue_pkt(nc_entry, pkt);
+    }
 
     return KERNEL_PID_UNDEF;
 }
@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
@@ -26,6 +27,19 @@ static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
+#if GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+/* result of a recent gnrc_sixlowpan_ctx_lookup_addr() */
+typedef struct {
+    ipv6_addr_t addr;
+    uint32_t gen;               /* _cache_gen when added */
+    uint8_t id;                 /* GNRC_SIXLOWPAN_CTX_SIZE for no context */
+} _cache_t;
+
+static _cache_t _cache[GNRC_SIXLOWPAN_CTX_CACHE_SIZE];
+static unsigned _cache_next;    /* entry to replace next */
+static uint32_t _cache_gen = 1; /* 0 marks unused entries */
+#endif
+
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
 
@@ -39,6 +53,55 @@ static inline bool _valid(uint8_t id)
     return (_ctxs[id].prefix_len > 0);
 }
 
+#if GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+/* gets the cached result for addr, returns false if there is none */
+static bool _cache_get(const ipv6_addr_t *addr, gnrc_sixlowpan_ctx_t **res)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_CTX_CACHE_SIZE; i++) {
+        _cache_t *entry = &_cache[i];
+
+        if ((entry->gen != _cache_gen) || !ipv6_addr_equal(&entry->addr, addr)) {
+            continue;
+        }
+        if (entry->id == GNRC_SIXLOWPAN_CTX_SIZE) {
+            *res = NULL;
+            return true;
+        }
+        /* also updates the lifetime of the context */
+        if (_valid(entry->id)) {
+            *res = &_ctxs[entry->id];
+            return true;
+        }
+        /* removed with gnrc_sixlowpan_ctx_remove() */
+        entry->gen = 0;
+        return false;
+    }
+    return false;
+}
+
+static void _cache_add(const ipv6_addr_t *addr, const gnrc_sixlowpan_ctx_t *ctx)
+{
+    _cache_t *entry = &_cache[_cache_next];
+
+    _cache_next = (_cache_next + 1) % GNRC_SIXLOWPAN_CTX_CACHE_SIZE;
+    memcpy(&entry->addr, addr, sizeof(ipv6_addr_t));
+    entry->gen = _cache_gen;
+    entry->id = (ctx != NULL) ? (uint8_t)(ctx - _ctxs) : GNRC_SIXLOWPAN_CTX_SIZE;
+}
+
+static inline void _cache_invalidate(void)
+{
+    _cache_gen++;
+    if (_cache_gen == 0) {
+        _cache_gen++;
+    }
+}
+#else
+static inline void _cache_invalidate(void)
+{
+}
+#endif
+
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
     uint8_t best = 0;
@@ -46,6 +109,13 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 
     mutex_lock(&_ctx_mutex);
 
+#if GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+    if (_cache_get(addr, &res)) {
+        mutex_unlock(&_ctx_mutex);
+        return res;
+    }
+#endif
+
     for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
         if (_valid(id)) {
             uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
@@ -57,6 +127,9 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
         }
     }
 
+#if GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+    _cache_add(addr, res);
+#endif
     mutex_unlock(&_ctx_mutex);
 
 #if ENABLE_DEBUG
@@ -126,6 +199,8 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    /* the best context of an address might have changed */
+    _cache_invalidate();
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
@@ -158,11 +233,10 @@ static void _update_lifetime(uint8_t id)
 }
 
 #ifdef TEST_SUITES
-#include <string.h>
-
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _cache_invalidate();
 }
 #endif
 
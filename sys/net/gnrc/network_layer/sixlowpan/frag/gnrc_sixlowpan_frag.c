@@ -23,9 +23,14 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
+#include "thread.h"
 #include "utlist.h"
+#include "xtimer.h"
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -35,7 +40,41 @@
 #include <inttypes.h>
 #endif
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) && defined(MODULE_GNRC_NETAPI_DIRECT)
+#error "gnrc_sixlowpan_frag_sfr is not supported with gnrc_netapi_direct"
+#endif
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* the datagram currently sent as recoverable fragments */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /* compressed datagram, NULL when idle */
+    xtimer_t timer;         /* RFRAG-ACK timeout */
+    msg_t timeout_msg;
+    uint32_t acked;         /* fragments acknowledged so far */
+    uint16_t size;          /* size of the compressed datagram */
+    uint16_t frag_size;     /* payload size of all but the last fragment */
+    uint8_t tag;
+    uint8_t frags;          /* number of fragments */
+    uint8_t next;           /* next sequence number to send in this round */
+    uint8_t retries;        /* rounds left to recover missing fragments */
+    bool sending;           /* a GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND is pending */
+} _sfr_t;
+
+static _sfr_t _sfr = {
+    .timeout_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT },
+};
+#endif
+
 static uint16_t _tag;
+#if GNRC_SIXLOWPAN_FRAG_PACING
+static xtimer_t _pacing_timer;
+static msg_t _pacing_msg;
+#endif
+
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
 
 static inline uint16_t _floor8(uint16_t length)
 {
@@ -82,7 +121,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -110,7 +150,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     pkt = pkt->next;    /* don't copy netif header */
 
@@ -129,7 +169,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send first fragment\n");
         gnrc_pktbuf_release(frag);
@@ -140,7 +180,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
 static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -166,7 +206,7 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -206,7 +246,7 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send subsequent fragment\n");
@@ -223,7 +263,6 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
 
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
@@ -236,50 +275,52 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     }
 #endif
 
-    /* Check weater to send the first or an Nth fragment */
-    if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
-            /* error sending first fragment */
-            DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-            return;
-        }
-        fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
-    }
-    else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
+    /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
+    while (fragment_msg->offset < payload_len) {
+        /* Check weater to send the first or an Nth fragment */
+        if (fragment_msg->offset == 0) {
+            /* increment tag for successive, fragmented datagrams */
+            fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
+            if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len,
+                                          fragment_msg->datagram_size,
+                                          fragment_msg->tag)) == 0) {
+                /* error sending first fragment */
+                DEBUG("6lo frag: error sending 1st fragment\n");
                 gnrc_pktbuf_release(fragment_msg->pkt);
                 fragment_msg->pkt = NULL;
                 return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            }
         }
-        else {
+        else if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len,
+                                           fragment_msg->datagram_size,
+                                           fragment_msg->offset,
+                                           fragment_msg->tag)) == 0) {
+            /* error sending subsequent fragment */
+            DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
+                  ")\n", fragment_msg->offset);
             gnrc_pktbuf_release(fragment_msg->pkt);
             fragment_msg->pkt = NULL;
+            return;
         }
+        fragment_msg->offset += res;
+#if GNRC_SIXLOWPAN_FRAG_PACING
+        if (fragment_msg->offset < payload_len) {
+            /* send the next fragment after the gap */
+            _pacing_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+            _pacing_msg.content.ptr = fragment_msg;
+            xtimer_set_msg(&_pacing_timer, GNRC_SIXLOWPAN_FRAG_PACING,
+                           &_pacing_msg, sched_active_pid);
+            return;
+        }
+#else
+        /* the interface threads have a higher priority and take the
+         * fragment right away, but let an interface of the same priority
+         * send it before the next one is built */
+        thread_yield();
+#endif
     }
+    gnrc_pktbuf_release(fragment_msg->pkt);
+    fragment_msg->pkt = NULL;
 }
 
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
@@ -306,9 +347,268 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (vrb_forward(hdr, pkt, frag_size, offset)) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
+
     rbuf_add(hdr, pkt, frag_size, offset);
 
     gnrc_pktbuf_release(pkt);
 }
 
+void gnrc_sixlowpan_frag_rbuf_gc(void)
+{
+    rbuf_gc();
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static inline uint32_t _sfr_all(void)
+{
+    /* sequence numbers 0 to _sfr.frags - 1, MSB first */
+    return (_sfr.frags >= 32) ? SIXLOWPAN_SFR_ACK_FULL :
+           ~(SIXLOWPAN_SFR_ACK_FULL >> _sfr.frags);
+}
+
+static void _sfr_finish(void)
+{
+    xtimer_remove(&_sfr.timer);
+    gnrc_pktbuf_release(_sfr.pkt);
+    _sfr.pkt = NULL;
+}
+
+/* sends the missing fragments from sequence number next on */
+static void _sfr_schedule(unsigned next)
+{
+    _sfr.next = next;
+    if (!_sfr.sending) {
+        msg_t msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND };
+
+        _sfr.sending = true;
+        msg_send_to_self(&msg);
+    }
+}
+
+static void _sfr_copy(gnrc_pktsnip_t *pkt, size_t offset, uint8_t *data,
+                      size_t len)
+{
+    while ((pkt != NULL) && (len > 0)) {
+        if (offset < pkt->size) {
+            size_t clen = _min(len, pkt->size - offset);
+
+            memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+            data += clen;
+            len -= clen;
+            offset = 0;
+        }
+        else {
+            offset -= pkt->size;
+        }
+        pkt = pkt->next;
+    }
+}
+
+static void _sfr_send_rfrag(unsigned seq, bool ack_req)
+{
+    gnrc_netif_hdr_t *netif_hdr = _sfr.pkt->data;
+    size_t offset = seq * _sfr.frag_size;
+    size_t frag_size = _min(_sfr.frag_size, _sfr.size - offset);
+    gnrc_pktsnip_t *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    uint16_t ar_seq_size = (seq << SIXLOWPAN_SFR_SEQ_POS) | frag_size;
+
+    frag = _build_frag_pkt(_sfr.pkt, frag_size + sizeof(sixlowpan_sfr_rfrag_t),
+                           frag_size + sizeof(sixlowpan_sfr_rfrag_t));
+    if (frag == NULL) {
+        /* recovered in the next round */
+        return;
+    }
+    hdr = frag->next->data;
+    hdr->disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->tag = _sfr.tag;
+    if (ack_req) {
+        ar_seq_size |= SIXLOWPAN_SFR_ACK_REQ;
+    }
+    hdr->ar_seq_size = byteorder_htons(ar_seq_size);
+    /* the first fragment carries the datagram size instead of its offset */
+    hdr->offset = byteorder_htons((seq == 0) ? _sfr.size : (uint16_t)offset);
+    _sfr_copy(_sfr.pkt->next, offset, (uint8_t *)(hdr + 1), frag_size);
+
+    DEBUG("6lo sfr: send RFRAG (datagram size: %u, tag: %u, sequence: %u, "
+          "fragment size: %u%s)\n", (unsigned)_sfr.size, (unsigned)_sfr.tag,
+          seq, (unsigned)frag_size, ack_req ? ", ACK requested" : "");
+    if (gnrc_netapi_send(netif_hdr->if_pid, frag) < 1) {
+        DEBUG("6lo sfr: unable to send RFRAG\n");
+        gnrc_pktbuf_release(frag);
+    }
+}
+
+bool gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(netif_hdr->if_pid);
+    size_t size = gnrc_pkt_len(pkt->next);
+    size_t frag_size;
+
+    if ((_sfr.pkt != NULL) || (iface == NULL) ||
+        (netif_hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                             GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        return false;
+    }
+    frag_size = _min(iface->max_frag_size - sizeof(sixlowpan_sfr_rfrag_t),
+                     SIXLOWPAN_SFR_FRAG_SIZE_MASK);
+    if ((size > UINT16_MAX) ||
+        (size > (frag_size * (SIXLOWPAN_SFR_SEQ_MAX + 1)))) {
+        DEBUG("6lo sfr: datagram needs too many fragments\n");
+        return false;
+    }
+    _sfr.pkt = pkt;
+    _sfr.acked = 0;
+    _sfr.size = (uint16_t)size;
+    _sfr.frag_size = (uint16_t)frag_size;
+    _sfr.tag = (uint8_t)gnrc_sixlowpan_frag_next_tag();
+    _sfr.frags = (uint8_t)((size + frag_size - 1) / frag_size);
+    _sfr.retries = GNRC_SIXLOWPAN_FRAG_SFR_RETRIES;
+    DEBUG("6lo sfr: send %u bytes as %u RFRAGs\n", (unsigned)size,
+          (unsigned)_sfr.frags);
+    _sfr_schedule(0);
+    return true;
+}
+
+void gnrc_sixlowpan_frag_sfr_event(uint16_t type)
+{
+    if (type == GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND) {
+        uint32_t missing;
+        unsigned seq;
+
+        _sfr.sending = false;
+        if (_sfr.pkt == NULL) {
+            return;
+        }
+        missing = (_sfr.next < _sfr.frags) ?
+                  (~_sfr.acked & _sfr_all() & (SIXLOWPAN_SFR_ACK_FULL >> _sfr.next)) :
+                  0;
+        if (missing == 0) {
+            /* round complete, the last fragment requested an RFRAG-ACK */
+            xtimer_set_msg(&_sfr.timer, GNRC_SIXLOWPAN_FRAG_SFR_RTO,
+                           &_sfr.timeout_msg, sched_active_pid);
+            return;
+        }
+        for (seq = _sfr.next; (missing & sixlowpan_sfr_ack_bit(seq)) == 0; seq++) {}
+        /* request an RFRAG-ACK with the last missing fragment */
+        _sfr_send_rfrag(seq, (missing & ~sixlowpan_sfr_ack_bit(seq)) == 0);
+        _sfr_schedule(seq + 1);
+        thread_yield();
+    }
+    else if ((type == GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT) && (_sfr.pkt != NULL)) {
+        if (_sfr.retries-- == 0) {
+            DEBUG("6lo sfr: no RFRAG-ACK, dropping datagram\n");
+            _sfr_finish();
+            return;
+        }
+        DEBUG("6lo sfr: RFRAG-ACK timed out, send missing RFRAGs again\n");
+        _sfr_schedule(0);
+    }
+}
+
+static void _sfr_handle_ack(gnrc_netif_hdr_t *netif_hdr, sixlowpan_sfr_ack_t *ack)
+{
+    gnrc_netif_hdr_t *sent_hdr;
+    uint32_t bitmap = byteorder_ntohl(ack->bitmap);
+
+    if (_sfr.pkt == NULL) {
+        return;
+    }
+    sent_hdr = _sfr.pkt->data;
+    if ((ack->tag != _sfr.tag) ||
+        (netif_hdr->src_l2addr_len != sent_hdr->dst_l2addr_len) ||
+        (memcmp(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                gnrc_netif_hdr_get_dst_addr(sent_hdr),
+                sent_hdr->dst_l2addr_len) != 0)) {
+        DEBUG("6lo sfr: RFRAG-ACK for unknown datagram\n");
+        return;
+    }
+    _sfr.acked |= bitmap;
+    if ((bitmap == SIXLOWPAN_SFR_ACK_NULL) ||
+        ((_sfr.acked & _sfr_all()) == _sfr_all())) {
+        DEBUG("6lo sfr: datagram %s\n", (bitmap == SIXLOWPAN_SFR_ACK_NULL) ?
+              "aborted by receiver" : "acknowledged");
+        _sfr_finish();
+        return;
+    }
+    xtimer_remove(&_sfr.timer);
+    if (_sfr.retries-- == 0) {
+        DEBUG("6lo sfr: RFRAGs still missing, dropping datagram\n");
+        _sfr_finish();
+        return;
+    }
+    DEBUG("6lo sfr: send missing RFRAGs (acknowledged: 0x%08lx)\n",
+          (unsigned long)_sfr.acked);
+    _sfr_schedule(0);
+}
+
+static void _sfr_send_ack(gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                          uint32_t bitmap)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_sfr_ack_t *ack;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header for RFRAG-ACK\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        DEBUG("6lo sfr: error allocating RFRAG-ACK\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    ack = pkt->data;
+    ack->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    ack->tag = tag;
+    ack->bitmap = byteorder_htonl(bitmap);
+    /* link-layer header first */
+    pkt->next = NULL;
+    netif->next = pkt;
+    DEBUG("6lo sfr: send RFRAG-ACK (tag: %u, bitmap: 0x%08lx)\n",
+          (unsigned)tag, (unsigned long)bitmap);
+    if (gnrc_netapi_send(netif_hdr->if_pid, netif) < 1) {
+        DEBUG("6lo sfr: unable to send RFRAG-ACK\n");
+        gnrc_pktbuf_release(netif);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_handle_pkt(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->next->data;
+    uint8_t *disp = pkt->data;
+
+    if (sixlowpan_sfr_ack_is(disp[0])) {
+        if (pkt->size >= sizeof(sixlowpan_sfr_ack_t)) {
+            _sfr_handle_ack(hdr, pkt->data);
+        }
+    }
+    else if (pkt->size >= sizeof(sixlowpan_sfr_rfrag_t)) {
+        sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+        uint32_t bitmap = rbuf_add_sfr(hdr, pkt);
+
+        /* also acknowledge completion right away, so the sender does not
+         * need to wait for the end of its round */
+        if ((bitmap != SIXLOWPAN_SFR_ACK_NULL) &&
+            (sixlowpan_sfr_rfrag_ack_req(rfrag) ||
+             (bitmap == SIXLOWPAN_SFR_ACK_FULL))) {
+            _sfr_send_ack(hdr, rfrag->tag, bitmap);
+        }
+    }
+    gnrc_pktbuf_release(pkt);
+}
+#endif
+
+
 /** @} */
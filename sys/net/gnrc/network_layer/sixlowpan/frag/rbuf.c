@@ -18,6 +18,7 @@
 #include "rbuf.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
@@ -29,22 +30,25 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
-
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
-
 static rbuf_t rbuf[RBUF_SIZE];
+static rbuf_t *rbuf_buckets[RBUF_HASH_SIZE];
+static xtimer_t _gc_timer;
+static msg_t _gc_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
+static bool _gc_armed = false;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* recently completed SFR datagrams, to acknowledge them again if the final
+ * RFRAG-ACK got lost */
+typedef struct {
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];
+    uint32_t arrival;
+    uint8_t src_len;                    /* 0 marks unused entries */
+    uint8_t tag;
+} _sfr_done_t;
+
+static _sfr_done_t _sfr_done[RBUF_SIZE];
+static unsigned _sfr_done_next;
+#endif
 
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
@@ -53,16 +57,22 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* checks whether start and end overlaps, but not identical to, any received
+ * fragment of entry */
+static bool _rbuf_overlap_partially(rbuf_t *entry, uint16_t start, uint16_t end);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
+/* update interval bitmaps of entry */
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
-static void _rbuf_gc(void);
+/* schedules rbuf_gc() in offset microseconds, if not already scheduled */
+static void _rbuf_gc_arm(uint32_t offset);
+/* dispatches the complete datagram of entry and removes entry */
+static void _rbuf_dispatch(rbuf_t *entry, gnrc_netif_hdr_t *netif_hdr,
+                           gnrc_nettype_t type);
+/* creates a new entry, replacing the oldest one if the buffer is full */
+static rbuf_t *_rbuf_new(rbuf_t **bucket, const void *src, size_t src_len,
+                         const void *dst, size_t dst_len,
+                         size_t size, uint16_t tag);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
@@ -77,10 +87,8 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
-    _rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
@@ -91,8 +99,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -133,21 +139,17 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, original_size, offset);
-
-            return;
-        }
+    if (_rbuf_overlap_partially(entry, offset, offset + frag_size - 1)) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
 
-        ptr = ptr->next;
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
+
+        return;
     }
 
     if (_rbuf_update_ints(entry, offset, frag_size)) {
@@ -158,105 +160,159 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 
     if (entry->cur_size == entry->pkt->size) {
-        gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(entry->src, entry->src_len,
-                                                     entry->dst, entry->dst_len);
-
-        if (netif == NULL) {
-            DEBUG("6lo rbuf: error allocating netif header\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-            return;
-        }
+        _rbuf_dispatch(entry, netif_hdr, GNRC_NETTYPE_IPV6);
+    }
+}
 
-        /* copy the transmit information of the latest fragment into the newly
-         * created header to have some link_layer information. The link_layer
-         * info of the previous fragments is discarded.
-         */
-        gnrc_netif_hdr_t *new_netif_hdr = netif->data;
-        new_netif_hdr->if_pid = netif_hdr->if_pid;
-        new_netif_hdr->flags = netif_hdr->flags;
-        new_netif_hdr->lqi = netif_hdr->lqi;
-        new_netif_hdr->rssi = netif_hdr->rssi;
-        LL_APPEND(entry->pkt, netif);
-
-        if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
-                                          entry->pkt)) {
-            DEBUG("6lo rbuf: No receivers for this packet found\n");
-            gnrc_pktbuf_release(entry->pkt);
-        }
+/* bitmap helpers, unit is the index of an 8-octet unit of the datagram */
+static inline bool _bit(const uint8_t *map, unsigned unit)
+{
+    return map[unit / 8] & (1U << (unit % 8));
+}
+
+static inline void _set_bit(uint8_t *map, unsigned unit)
+{
+    map[unit / 8] |= (1U << (unit % 8));
+}
+
+static void _rbuf_dispatch(rbuf_t *entry, gnrc_netif_hdr_t *netif_hdr,
+                           gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(entry->src, entry->src_len,
+                                                 entry->dst, entry->dst_len);
 
+    if (netif == NULL) {
+        DEBUG("6lo rbuf: error allocating netif header\n");
+        gnrc_pktbuf_release(entry->pkt);
         _rbuf_rem(entry);
+        return;
+    }
+
+    /* copy the transmit information of the latest fragment into the newly
+     * created header to have some link_layer information. The link_layer
+     * info of the previous fragments is discarded.
+     */
+    gnrc_netif_hdr_t *new_netif_hdr = netif->data;
+    new_netif_hdr->if_pid = netif_hdr->if_pid;
+    new_netif_hdr->flags = netif_hdr->flags;
+    new_netif_hdr->lqi = netif_hdr->lqi;
+    new_netif_hdr->rssi = netif_hdr->rssi;
+    LL_APPEND(entry->pkt, netif);
+
+    if (!gnrc_netapi_dispatch_receive(type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                      entry->pkt)) {
+        DEBUG("6lo rbuf: No receivers for this packet found\n");
+        gnrc_pktbuf_release(entry->pkt);
     }
+
+    _rbuf_rem(entry);
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+static inline rbuf_t **_rbuf_bucket(const uint8_t *src, size_t src_len,
+                                    uint16_t tag)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    return &rbuf_buckets[rbuf_hash(src, src_len, tag) % RBUF_HASH_SIZE];
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+static bool _rbuf_overlap_partially(rbuf_t *entry, uint16_t start, uint16_t end)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    /* all fragments but the last are multiples of 8 octets long, so a
+     * fragment covers its units completely and every received unit belongs
+     * to exactly one fragment */
+    unsigned first = start / 8U, last = end / 8U;
+    unsigned received = 0;
+
+    for (unsigned unit = first; unit <= last; unit++) {
+        if (_bit(entry->received, unit)) {
+            received++;
         }
     }
-
-    return NULL;
+    if (received == 0) {
+        return false;
+    }
+    if (received <= last - first) {
+        /* covers both received and missing units */
+        return true;
+    }
+    /* all units received: a duplicate only if a fragment started at start
+     * and the next one after end */
+    if (!_bit(entry->starts, first)) {
+        return true;
+    }
+    for (unsigned unit = first + 1; unit <= last; unit++) {
+        if (_bit(entry->starts, unit)) {
+            return true;
+        }
+    }
+    last++;
+    return (last < (RBUF_UNITS_BYTES * 8U)) && _bit(entry->received, last) &&
+           !_bit(entry->starts, last);
 }
 
 static void _rbuf_rem(rbuf_t *entry)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
-
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
-    }
+    rbuf_t **bucket = _rbuf_bucket(entry->src, entry->src_len, entry->tag);
 
+    LL_DELETE(*bucket, entry);
+    entry->next = NULL;
     entry->pkt = NULL;
 }
 
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
 {
-    rbuf_int_t *new;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
+    if (_bit(entry->received, offset / 8U)) {
+        /* _rbuf_overlap_partially() already checked it is a duplicate */
+        DEBUG("6lo rfrag: duplicate fragment (%" PRIu16 ", %" PRIu16 ")\n",
+              offset, end);
         return false;
     }
 
-    new->start = offset;
-    new->end = end;
-
     DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(l2addr_str,
+          offset, end, gnrc_netif_addr_to_str(l2addr_str,
                   sizeof(l2addr_str), entry->src, entry->src_len));
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
             sizeof(l2addr_str), entry->dst, entry->dst_len),
           (unsigned)entry->pkt->size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    _set_bit(entry->starts, offset / 8U);
+    for (unsigned unit = offset / 8U; unit <= (end / 8U); unit++) {
+        _set_bit(entry->received, unit);
+    }
 
     return true;
 }
 
-static void _rbuf_gc(void)
+static void _rbuf_gc_arm(uint32_t offset)
+{
+    if (!_gc_armed) {
+        _gc_armed = true;
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        /* fragments are received in the interface threads, the IPv6 thread
+         * handles the 6LoWPAN events */
+        xtimer_set_msg(&_gc_timer, offset, &_gc_msg, gnrc_ipv6_pid);
+#else
+        xtimer_set_msg(&_gc_timer, offset, &_gc_msg, sched_active_pid);
+#endif
+    }
+}
+
+void rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
+    uint32_t next = UINT32_MAX;
     unsigned int i;
 
+    _gc_armed = false;
     for (i = 0; i < RBUF_SIZE; i++) {
+        uint32_t age = now_usec - rbuf[i].arrival;
+
+        if (rbuf[i].pkt == NULL) {
+            continue;
+        }
         /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
+        if (age > RBUF_TIMEOUT) {
             DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
                     sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
             DEBUG("%s, %u, %u) timed out\n",
@@ -267,37 +323,85 @@ static void _rbuf_gc(void)
             gnrc_pktbuf_release(rbuf[i].pkt);
             _rbuf_rem(&(rbuf[i]));
         }
+        else if ((RBUF_TIMEOUT - age) < next) {
+            next = RBUF_TIMEOUT - age;
+        }
+    }
+    if (next != UINT32_MAX) {
+        /* wake up when the next entry times out */
+        _rbuf_gc_arm(next + 1);
+    }
+}
+
+static rbuf_t *_rbuf_find(rbuf_t *bucket, const void *src, size_t src_len,
+                          const void *dst, size_t dst_len,
+                          size_t size, uint16_t tag)
+{
+    rbuf_t *res;
+
+    LL_FOREACH(bucket, res) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if (res->sfr) {
+            continue;
+        }
+#endif
+        if ((res->pkt->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            return res;
+        }
     }
+    return NULL;
+}
+
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
+{
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+
+    return _rbuf_find(*_rbuf_bucket(src, netif_hdr->src_l2addr_len, tag),
+                      src, netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, size, tag) != NULL;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
+{
+    rbuf_t *res;
+    rbuf_t **bucket = _rbuf_bucket(src, src_len, tag);
+
+    /* check first if entry already available */
+    res = _rbuf_find(*bucket, src, src_len, dst, dst_len, size, tag);
+    if (res != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                     res->src, res->src_len));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                     res->dst, res->dst_len),
+              (unsigned)res->pkt->size, res->tag);
+        res->arrival = xtimer_now_usec();
+        return res;
+    }
+
+    /* only the first fragment of a datagram gets here */
+    return _rbuf_new(bucket, src, src_len, dst, dst_len, size, tag);
+}
+
+static rbuf_t *_rbuf_new(rbuf_t **bucket, const void *src, size_t src_len,
+                         const void *dst, size_t dst_len,
+                         size_t size, uint16_t tag)
 {
     rbuf_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
     for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
+        /* if there is a free spot: take it */
+        if (rbuf[i].pkt == NULL) {
             res = &(rbuf[i]);
+            break;
         }
 
         /* remember oldest slot */
@@ -328,12 +432,20 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                          * look-ups */
     res->arrival = now_usec;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
     memcpy(res->src, src, src_len);
     memcpy(res->dst, dst, dst_len);
     res->src_len = src_len;
     res->dst_len = dst_len;
     res->tag = tag;
     res->cur_size = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    res->seqs = 0;
+    res->sfr = false;
+#endif
+    LL_PREPEND(*bucket, res);
+    _rbuf_gc_arm(RBUF_TIMEOUT + 1);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
@@ -346,4 +458,113 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static _sfr_done_t *_sfr_done_get(const uint8_t *src, size_t src_len,
+                                  uint8_t tag, uint32_t now_usec)
+{
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        _sfr_done_t *done = &_sfr_done[i];
+
+        if ((done->src_len != 0) && ((now_usec - done->arrival) > RBUF_TIMEOUT)) {
+            done->src_len = 0;
+        }
+        if ((done->src_len == src_len) && (done->tag == tag) &&
+            (memcmp(done->src, src, src_len) == 0)) {
+            return done;
+        }
+    }
+    return NULL;
+}
+
+static void _sfr_done_add(const rbuf_t *entry, uint32_t now_usec)
+{
+    _sfr_done_t *done = &_sfr_done[_sfr_done_next];
+
+    _sfr_done_next = (_sfr_done_next + 1) % RBUF_SIZE;
+    memcpy(done->src, entry->src, entry->src_len);
+    done->arrival = now_usec;
+    done->src_len = entry->src_len;
+    done->tag = (uint8_t)entry->tag;
+}
+
+static rbuf_t *_rbuf_sfr_find(rbuf_t *bucket, const void *src, size_t src_len,
+                              const void *dst, size_t dst_len, uint8_t tag)
+{
+    rbuf_t *res;
+
+    LL_FOREACH(bucket, res) {
+        if (res->sfr && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            return res;
+        }
+    }
+    return NULL;
+}
+
+uint32_t rbuf_add_sfr(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt)
+{
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+    uint32_t now_usec = xtimer_now_usec();
+    unsigned seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    uint32_t bit = sixlowpan_sfr_ack_bit(seq);
+    size_t frag_size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    /* the first fragment carries the datagram size in its offset field */
+    size_t offset = (seq == 0) ? 0 : byteorder_ntohs(hdr->offset);
+    rbuf_t **bucket = _rbuf_bucket(src, netif_hdr->src_l2addr_len, hdr->tag);
+    rbuf_t *entry;
+
+    if ((pkt->size - sizeof(sixlowpan_sfr_rfrag_t)) < frag_size) {
+        DEBUG("6lo rbuf: RFRAG shorter than its fragment size\n");
+        return SIXLOWPAN_SFR_ACK_NULL;
+    }
+    if (_sfr_done_get(src, netif_hdr->src_l2addr_len, hdr->tag, now_usec) != NULL) {
+        DEBUG("6lo rbuf: RFRAG of already completed datagram\n");
+        return SIXLOWPAN_SFR_ACK_FULL;
+    }
+    entry = _rbuf_sfr_find(*bucket, src, netif_hdr->src_l2addr_len,
+                           dst, netif_hdr->dst_l2addr_len, hdr->tag);
+    if (entry == NULL) {
+        if (seq != 0) {
+            DEBUG("6lo rbuf: RFRAG before first fragment, ignoring\n");
+            return SIXLOWPAN_SFR_ACK_NULL;
+        }
+        entry = _rbuf_new(bucket, src, netif_hdr->src_l2addr_len,
+                          dst, netif_hdr->dst_l2addr_len,
+                          byteorder_ntohs(hdr->offset), hdr->tag);
+        if (entry == NULL) {
+            DEBUG("6lo rbuf: reassembly buffer full.\n");
+            return SIXLOWPAN_SFR_ACK_NULL;
+        }
+        /* reassembled in compressed form */
+        entry->pkt->type = GNRC_NETTYPE_SIXLOWPAN;
+        entry->sfr = true;
+    }
+    entry->arrival = now_usec;
+
+    if ((offset + frag_size) > entry->pkt->size) {
+        DEBUG("6lo rfrag: RFRAG too big for resulting datagram, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+        return SIXLOWPAN_SFR_ACK_NULL;
+    }
+    if ((entry->seqs & bit) == 0) {
+        DEBUG("6lo rbuf: add RFRAG %u (%u bytes at %u)\n", seq,
+              (unsigned)frag_size, (unsigned)offset);
+        memcpy(((uint8_t *)entry->pkt->data) + offset, hdr + 1, frag_size);
+        entry->seqs |= bit;
+        entry->cur_size += (uint16_t)frag_size;
+    }
+    if (entry->cur_size >= entry->pkt->size) {
+        _sfr_done_add(entry, now_usec);
+        _rbuf_dispatch(entry, netif_hdr, GNRC_NETTYPE_SIXLOWPAN);
+        return SIXLOWPAN_SFR_ACK_FULL;
+    }
+    return entry->seqs;
+}
+#endif
+
 /** @} */
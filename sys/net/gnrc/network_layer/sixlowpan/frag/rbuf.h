@@ -20,6 +20,7 @@
 #define RBUF_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
@@ -31,26 +32,21 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#endif
+#ifndef RBUF_HASH_SIZE
+#define RBUF_HASH_SIZE      (RBUF_SIZE)        /**< number of buckets to look up entries */
+#endif
 #define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
- *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * @brief   Size of the bitmaps of rbuf_t in bytes
  *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
- *
- * @internal
+ * One bit for every 8-octet unit of the largest possible datagram, the unit
+ * fragment offsets are given in.
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNITS_BYTES    (((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U + 7U) / 8U)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -64,25 +60,59 @@ typedef struct rbuf_int {
  *
  * to identify all fragments that belong to the given datagram.
  *
+ * The limits of the received fragments are tracked in the bitmaps
+ * rbuf_t::received and rbuf_t::starts, so overlapping fragments, that are
+ * to be discarded, can be told apart from duplicates.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  *
  * @internal
  */
-typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+typedef struct rbuf {
+    struct rbuf *next;                  /**< next entry with the same hash */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+    uint8_t received[RBUF_UNITS_BYTES]; /**< 8-octet units already received */
+    uint8_t starts[RBUF_UNITS_BYTES];   /**< 8-octet units a fragment starts in */
     uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
     uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< destination address */
     uint8_t src_len;                    /**< length of source address */
     uint8_t dst_len;                    /**< length of destination address */
     uint16_t tag;                       /**< the datagram's tag */
     uint16_t cur_size;                  /**< the datagram's current size */
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    uint32_t seqs;                      /**< sequence numbers received, in
+                                         *   the format of an RFRAG-ACK
+                                         *   bitmap */
+    bool sfr;                           /**< rbuf_t::pkt is the compressed
+                                         *   datagram of RFRAGs */
+#endif
 } rbuf_t;
 
+/**
+ * @brief   Hashes the key fragments are looked up by
+ *
+ * @param[in] src       source address of the fragment
+ * @param[in] src_len   length of @p src
+ * @param[in] tag       the datagram's tag
+ *
+ * @return  hash of @p src and @p tag, to be taken modulo the number of buckets
+ *
+ * @internal
+ */
+static inline unsigned rbuf_hash(const uint8_t *src, size_t src_len, uint16_t tag)
+{
+    unsigned hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    return hash;
+}
+
 /**
  * @brief   Adds a new fragment to the reassembly buffer. If the packet is
  *          complete, dispatch the packet with the transmit information of
@@ -100,6 +130,55 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Adds a recoverable fragment (RFRAG) to the reassembly buffer. If
+ *          the datagram is complete, dispatch it as 6LoWPAN packet with the
+ *          transmit information of the last fragment.
+ *
+ * The datagram is reassembled in its compressed form, so the first fragment
+ * must arrive before the others can be stored. Fragments arriving before it
+ * are ignored and recovered by the sender.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment, with
+ *                          gnrc_netif_hdr_t::if_pid and its source and
+ *                          destination address set.
+ * @param[in] frag          The fragment to add, starting with its RFRAG header.
+ *
+ * @return  the bitmap to acknowledge the fragment with,
+ *          @ref SIXLOWPAN_SFR_ACK_FULL if the datagram is complete
+ * @return  @ref SIXLOWPAN_SFR_ACK_NULL if the fragment could not be stored
+ *
+ * @internal
+ */
+uint32_t rbuf_add_sfr(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag);
+#endif
+
+/**
+ * @brief   Checks if the reassembly of a datagram already started
+ *
+ * @param[in] netif_hdr     The interface header of a fragment of the datagram.
+ * @param[in] size          The datagram's size.
+ * @param[in] tag           The datagram's tag.
+ *
+ * @return  true, if there is an entry for the datagram
+ * @return  false, otherwise
+ *
+ * @internal
+ */
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag);
+
+/**
+ * @brief   Removes timed out entries from the reassembly buffer
+ *
+ * To be called from the 6LoWPAN thread on
+ * @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF, which rbuf_add() schedules while
+ * there are incomplete datagrams.
+ *
+ * @internal
+ */
+void rbuf_gc(void);
+
 #ifdef __cplusplus
 }
 #endif
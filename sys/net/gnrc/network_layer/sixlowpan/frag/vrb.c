@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/nd.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/* IPHC would query the interface from its own thread */
+#error "gnrc_sixlowpan_frag_vrb does not work with gnrc_netapi_direct"
+#endif
+
+static vrb_t vrb[VRB_SIZE];
+static vrb_t *vrb_buckets[VRB_HASH_SIZE];
+
+static inline vrb_t **_vrb_bucket(const uint8_t *src, size_t src_len,
+                                  uint16_t tag)
+{
+    return &vrb_buckets[rbuf_hash(src, src_len, tag) % VRB_HASH_SIZE];
+}
+
+static void _vrb_rem(vrb_t *entry)
+{
+    LL_DELETE(*_vrb_bucket(entry->src, entry->src_len, entry->tag), entry);
+    entry->next = NULL;
+    entry->src_len = 0;
+}
+
+static vrb_t *_vrb_get(const uint8_t *src, size_t src_len, size_t size,
+                       uint16_t tag, uint32_t now_usec)
+{
+    vrb_t *entry, *tmp;
+
+    LL_FOREACH_SAFE(*_vrb_bucket(src, src_len, tag), entry, tmp) {
+        if ((now_usec - entry->arrival) > RBUF_TIMEOUT) {
+            /* fragments stopped coming or some got lost */
+            _vrb_rem(entry);
+        }
+        else if ((entry->size == size) && (entry->tag == tag) &&
+                 (entry->src_len == src_len) &&
+                 (memcmp(entry->src, src, src_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static vrb_t *_vrb_add(const uint8_t *src, size_t src_len, size_t size,
+                       uint16_t tag, uint32_t now_usec)
+{
+    vrb_t *res = NULL;
+
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        if ((vrb[i].src_len == 0) ||
+            ((now_usec - vrb[i].arrival) > RBUF_TIMEOUT)) {
+            res = &vrb[i];
+            break;
+        }
+        /* note that xtimer_now will overflow in ~1.2 hours */
+        if ((res == NULL) || (res->arrival - vrb[i].arrival < UINT32_MAX / 2)) {
+            res = &vrb[i];
+        }
+    }
+    if (res->src_len != 0) {
+        DEBUG("6lo vrb: replace entry for tag %u\n", (unsigned)res->tag);
+        _vrb_rem(res);
+    }
+    memcpy(res->src, src, src_len);
+    res->src_len = src_len;
+    res->size = size;
+    res->tag = tag;
+    res->out_tag = gnrc_sixlowpan_frag_next_tag();
+    res->fwd_size = 0;
+    LL_PREPEND(*_vrb_bucket(src, src_len, tag), res);
+    return res;
+}
+
+/* decompresses the headers of the first fragment of a datagram of the given
+ * size into an IPv6 snip, followed by nh_len bytes of next headers.
+ * data and data_len are set to the remaining payload of the fragment.
+ * Decompressed next headers hardly grow beyond their compressed size, if they
+ * do not fit the datagram is reassembled */
+static gnrc_pktsnip_t *_decode_hdrs(gnrc_pktsnip_t *frag, size_t size,
+                                    size_t *nh_len, uint8_t **data,
+                                    size_t *data_len)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktbuf_add(NULL, NULL,
+                                           sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) +
+                                           frag->size,
+                                           GNRC_NETTYPE_IPV6);
+    size_t hdr_len = 0;
+
+    if (ipv6 == NULL) {
+        return NULL;
+    }
+    memset(ipv6->data, 0, ipv6->size);
+    *data = ((uint8_t *)frag->data) + sizeof(sixlowpan_frag_t);
+    *data_len = frag->size - sizeof(sixlowpan_frag_t);
+    *nh_len = 0;
+    if ((*data_len > sizeof(ipv6_hdr_t)) && ((*data)[0] == SIXLOWPAN_UNCOMP)) {
+        memcpy(ipv6->data, *data + 1, sizeof(ipv6_hdr_t));
+        hdr_len = sizeof(ipv6_hdr_t) + 1;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    else if ((*data_len > 0) && sixlowpan_iphc_is(*data)) {
+        hdr_len = gnrc_sixlowpan_iphc_decode(&ipv6, frag, size,
+                                             sizeof(sixlowpan_frag_t), nh_len);
+    }
+#else
+    (void)size;
+#endif
+    if ((hdr_len == 0) || (hdr_len > *data_len)) {
+        DEBUG("6lo vrb: could not decode first fragment\n");
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    *data += hdr_len;
+    *data_len -= hdr_len;
+    return ipv6;
+}
+
+/* builds the first fragment to the next hop of the datagram ipv6 belongs to
+ * and creates its VRB entry if *entry is NULL, ipv6 is released on error */
+static gnrc_pktsnip_t *_build_first(vrb_t **entry, gnrc_netif_hdr_t *netif_hdr,
+                                    gnrc_pktsnip_t *ipv6, size_t nh_len,
+                                    const uint8_t *data, size_t data_len,
+                                    size_t size, uint16_t tag,
+                                    uint32_t now_usec)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    ipv6_addr_t *local;
+    gnrc_sixlowpan_netif_t *iface;
+    gnrc_pktsnip_t *payload, *netif, *frag_hdr;
+    sixlowpan_frag_t *frag;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len = sizeof(l2addr);
+    kernel_pid_t out_iface;
+
+    /* reassemble everything that is not forwarded over 6LoWPAN */
+    if (ipv6_addr_is_multicast(&hdr->dst) || ipv6_addr_is_link_local(&hdr->dst) ||
+        (hdr->hl <= 1) ||
+        (gnrc_ipv6_netif_find_by_addr(&local, &hdr->dst) != KERNEL_PID_UNDEF) ||
+        ((out_iface = gnrc_sixlowpan_nd_next_hop_l2addr(l2addr, &l2addr_len,
+                                                         KERNEL_PID_UNDEF,
+                                                         &hdr->dst)) <= KERNEL_PID_UNDEF) ||
+        (l2addr_len > RBUF_L2ADDR_MAX_LEN) ||
+        ((iface = gnrc_sixlowpan_netif_get(out_iface)) == NULL)) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    payload = gnrc_pktbuf_add(NULL, NULL, nh_len + data_len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    memcpy(payload->data, hdr + 1, nh_len);
+    memcpy(((uint8_t *)payload->data) + nh_len, data, data_len);
+    gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t));
+    hdr = ipv6->data;
+    hdr->hl--;
+    ipv6->next = payload;
+    netif = gnrc_netif_hdr_build(NULL, 0, l2addr, l2addr_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = out_iface;
+    netif->next = ipv6;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if (iface->iphc_enabled) {
+        /* addresses might only be elidable on the previous link */
+        if (!gnrc_sixlowpan_iphc_encode(netif)) {
+            gnrc_pktbuf_release(netif);
+            return NULL;
+        }
+    }
+    else
+#endif
+    {
+        uint8_t disp = SIXLOWPAN_UNCOMP;
+
+        if ((netif->next = gnrc_pktbuf_add(ipv6, &disp, sizeof(disp),
+                                           GNRC_NETTYPE_SIXLOWPAN)) == NULL) {
+            netif->next = ipv6;
+            gnrc_pktbuf_release(netif);
+            return NULL;
+        }
+    }
+    /* a longer header does not fit anymore if the previous hop used the
+     * whole frame */
+    if ((gnrc_pkt_len(netif->next) + sizeof(sixlowpan_frag_t)) > iface->max_frag_size) {
+        DEBUG("6lo vrb: first fragment grew too big\n");
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    if ((frag_hdr = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                                    GNRC_NETTYPE_SIXLOWPAN)) == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    netif->next = frag_hdr;
+
+    if (*entry == NULL) {
+        *entry = _vrb_add(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                          netif_hdr->src_l2addr_len, size, tag, now_usec);
+    }
+    memcpy((*entry)->out_dst, l2addr, l2addr_len);
+    (*entry)->out_dst_len = l2addr_len;
+    (*entry)->out_iface = out_iface;
+    (*entry)->fwd_size += sizeof(ipv6_hdr_t) + nh_len + data_len;
+
+    frag = frag_hdr->data;
+    frag->disp_size = byteorder_htons((uint16_t)size);
+    frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    frag->tag = byteorder_htons((*entry)->out_tag);
+    return netif;
+}
+
+static gnrc_pktsnip_t *_build_nth(vrb_t *entry, gnrc_pktsnip_t *frag,
+                                  size_t frag_size)
+{
+    gnrc_pktsnip_t *netif, *fwd;
+
+    fwd = gnrc_pktbuf_add(NULL, frag->data, frag->size, GNRC_NETTYPE_SIXLOWPAN);
+    if (fwd == NULL) {
+        return NULL;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->out_dst, entry->out_dst_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(fwd);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = entry->out_iface;
+    ((sixlowpan_frag_t *)fwd->data)->tag = byteorder_htons(entry->out_tag);
+    entry->fwd_size += frag_size;
+    LL_PREPEND(fwd, netif);
+    return netif;
+}
+
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t frag_size, size_t offset)
+{
+    sixlowpan_frag_t *hdr = frag->data;
+    size_t size = byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(hdr->tag);
+    uint32_t now_usec = xtimer_now_usec();
+    vrb_t *entry = _vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                            netif_hdr->src_l2addr_len, size, tag, now_usec);
+    gnrc_pktsnip_t *pkt;
+    kernel_pid_t out_iface;
+
+    if (offset == 0) {
+        gnrc_pktsnip_t *ipv6;
+        uint8_t *data;
+        size_t nh_len, data_len;
+
+        /* the following fragments of a datagram already in reassembly would
+         * not be forwarded */
+        if (((entry == NULL) && rbuf_has(netif_hdr, size, tag)) ||
+            ((ipv6 = _decode_hdrs(frag, size, &nh_len, &data, &data_len)) == NULL) ||
+            ((pkt = _build_first(&entry, netif_hdr, ipv6, nh_len, data,
+                                 data_len, size, tag, now_usec)) == NULL)) {
+            return false;
+        }
+    }
+    else if ((entry == NULL) ||
+             ((pkt = _build_nth(entry, frag, frag_size)) == NULL)) {
+        return false;
+    }
+    entry->arrival = now_usec;
+    out_iface = entry->out_iface;
+    DEBUG("6lo vrb: forward fragment (tag %u -> %u, offset %u) over "
+          "interface %" PRIkernel_pid "\n", (unsigned)tag,
+          (unsigned)entry->out_tag, (unsigned)offset, out_iface);
+    if (entry->fwd_size >= size) {
+        /* all fragments forwarded */
+        _vrb_rem(entry);
+    }
+    if (gnrc_netapi_send(out_iface, pkt) < 1) {
+        DEBUG("6lo vrb: unable to forward fragment\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return true;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
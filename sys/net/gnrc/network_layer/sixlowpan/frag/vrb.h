@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ *
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly
+ *      </a>
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef VRB_H
+#define VRB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef VRB_SIZE
+#define VRB_SIZE            (16U)       /**< number of datagrams forwarded at once */
+#endif
+#ifndef VRB_HASH_SIZE
+#define VRB_HASH_SIZE       (VRB_SIZE)  /**< number of buckets to look up entries */
+#endif
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ *
+ * Maps the fragments of a datagram to the next hop they are forwarded to.
+ * Entries time out like rbuf_t entries after @ref RBUF_TIMEOUT.
+ *
+ * @internal
+ */
+typedef struct vrb {
+    struct vrb *next;                   /**< next entry with the same hash */
+    uint32_t arrival;                   /**< time in microseconds of arrival of
+                                         *   last received fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
+    uint8_t out_dst[RBUF_L2ADDR_MAX_LEN];   /**< address of the next hop */
+    uint8_t src_len;                    /**< length of source address, 0 for
+                                         *   unused entries */
+    uint8_t out_dst_len;                /**< length of vrb_t::out_dst */
+    kernel_pid_t out_iface;             /**< interface to the next hop */
+    uint16_t size;                      /**< the datagram's size */
+    uint16_t tag;                       /**< the datagram's tag */
+    uint16_t out_tag;                   /**< the datagram's tag to the next hop */
+    uint16_t fwd_size;                  /**< bytes of the datagram forwarded */
+} vrb_t;
+
+/**
+ * @brief   Forwards a fragment without reassembling its datagram, if possible
+ *
+ * @param[in] netif_hdr     The interface header of the fragment, with
+ *                          gnrc_netif_hdr_t::if_pid and its source and
+ *                          destination address set.
+ * @param[in] frag          The fragment. Not released.
+ * @param[in] frag_size     The fragment's size in the uncompressed datagram.
+ *                          For the first fragment this still includes the
+ *                          compressed header.
+ * @param[in] offset        The fragment's offset.
+ *
+ * @return  true, if the fragment was forwarded
+ * @return  false, if the datagram needs to be reassembled
+ *
+ * @internal
+ */
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t frag_size, size_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VRB_H */
+/** @} */
@@ -18,6 +18,7 @@
 #include "utlist.h"
 
 #include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
@@ -32,23 +33,43 @@
 #include <inttypes.h>
 #endif
 
-static kernel_pid_t _pid = KERNEL_PID_UNDEF;
-
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
+static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0, 0};
 #endif
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/* handles all netapi commands in the dispatching thread */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_cbd_t _cbd = { _netapi_cb, NULL, NULL };
+static gnrc_netreg_entry_t _me_reg;
+#else
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
+#endif
 
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* handles GNRC_NETAPI_MSG_TYPE_SND commands */
 static void _send(gnrc_pktsnip_t *pkt);
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+kernel_pid_t gnrc_sixlowpan_init(void)
+{
+    if (_me_reg.target.cbd == NULL) {
+        /* register interest in all 6LoWPAN packets */
+        gnrc_netreg_entry_init_cb(&_me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &_me_reg);
+    }
+    return KERNEL_PID_UNDEF;
+}
+#else
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
 
@@ -63,6 +84,7 @@ kernel_pid_t gnrc_sixlowpan_init(void)
 
     return _pid;
 }
+#endif
 
 static void _receive(gnrc_pktsnip_t *pkt)
 {
@@ -127,6 +149,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_rfrag_is(dispatch[0]) ||
+             sixlowpan_sfr_ack_is(dispatch[0])) {
+        DEBUG("6lo: received recoverable fragment or acknowledgment\n");
+        gnrc_sixlowpan_frag_sfr_handle_pkt(pkt);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         size_t dispatch_size, nh_len;
@@ -271,6 +301,13 @@ static void _send(gnrc_pktsnip_t *pkt)
 
         return;
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (gnrc_sixlowpan_frag_sfr_send(pkt2)) {
+        DEBUG("6lo: Send as recoverable fragments (%u > %" PRIu16 ")\n",
+              (unsigned int)datagram_size, iface->max_frag_size);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (fragment_msg.pkt != NULL) {
         DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
@@ -291,7 +328,8 @@ static void _send(gnrc_pktsnip_t *pkt)
         /* set the outgoing message's fields */
         msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
         msg.content.ptr = &fragment_msg;
-        /* send message to self */
+        /* send message to self (with gnrc_netapi_direct that is the IPv6
+         * thread, which passes it on to gnrc_sixlowpan_frag_send()) */
         msg_send_to_self(&msg);
     }
     else {
@@ -307,6 +345,32 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+            gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, pkt);
+            _receive(pkt);
+            gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, NULL);
+            break;
+
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
+            gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, pkt);
+            _send(pkt);
+            gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, NULL);
+            break;
+
+        default:
+            DEBUG("6lo: operation not supported\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+#else
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
@@ -330,16 +394,46 @@ static void *_event_loop(void *args)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, msg.content.ptr);
                 _receive(msg.content.ptr);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, NULL);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, msg.content.ptr);
                 _send(msg.content.ptr);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, NULL);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_RCV_TRAIN:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV_TRAIN received\n");
+                for (unsigned i = 0; i < gnrc_netapi_train_len(msg.content.ptr); i++) {
+                    gnrc_pktsnip_t *pkt = gnrc_netapi_train_get(msg.content.ptr, i);
+
+                    gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, pkt);
+                    _receive(pkt);
+                    gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_RX, NULL);
+                }
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_TRAIN:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND_TRAIN received\n");
+                for (unsigned i = 0; i < gnrc_netapi_train_len(msg.content.ptr); i++) {
+                    gnrc_pktsnip_t *pkt = gnrc_netapi_train_get(msg.content.ptr, i);
+
+                    gnrc_pkttrace_enter(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, pkt);
+                    _send(pkt);
+                    gnrc_pkttrace_exit(GNRC_PKTTRACE_SIXLOWPAN, GNRC_PKTTRACE_TX, NULL);
+                }
+                gnrc_pktbuf_release(msg.content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 DEBUG("6lo: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
@@ -349,6 +443,18 @@ static void *_event_loop(void *args)
                 DEBUG("6lo: send fragmented event received\n");
                 gnrc_sixlowpan_frag_send(msg.content.ptr);
                 break;
+
+            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                DEBUG("6lo: garbage collect reassembly buffer event received\n");
+                gnrc_sixlowpan_frag_rbuf_gc();
+                break;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND:
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT:
+                DEBUG("6lo: selective fragment recovery event received\n");
+                gnrc_sixlowpan_frag_sfr_event(msg.type);
+                break;
 #endif
 
             default:
@@ -359,5 +465,6 @@ static void *_event_loop(void *args)
 
     return NULL;
 }
+#endif
 
 /** @} */
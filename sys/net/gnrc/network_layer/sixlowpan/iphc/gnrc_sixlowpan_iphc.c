@@ -20,6 +20,7 @@
 
 #include "byteorder.h"
 #include "net/ieee802154.h"
+#include "net/ipv6/ext.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/sixlowpan/ctx.h"
@@ -89,6 +90,19 @@
 #define NHC_UDP_8BIT_PORT           (0xF000)
 #define NHC_UDP_8BIT_MASK           (0xFF00)
 
+#define NHC_IPV6_EXT_ID             (0xE0)
+#define NHC_IPV6_EXT_ID_MASK        (0xF0)
+#define NHC_IPV6_EXT_EID_MASK       (0x0E)
+#define NHC_IPV6_EXT_EID_HOPOPT     (0x00)
+#define NHC_IPV6_EXT_EID_RH         (0x02)
+#define NHC_IPV6_EXT_EID_DST        (0x06)
+#define NHC_IPV6_EXT_EID_MOB        (0x08)
+#define NHC_IPV6_EXT_EID_NONE       (0xFF)  /* no EID, not part of the format */
+#define NHC_IPV6_EXT_NH             (0x01)
+
+#define NHC_IPV6_EXT_OPT_PAD1       (0x00)
+#define NHC_IPV6_EXT_OPT_PADN       (0x01)
+
 static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
                                          ipv6_addr_t *addr,
                                          eui64_t *iid)
@@ -112,11 +126,10 @@ static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
 inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **dec_hdr,
-                                         size_t datagram_size, size_t offset)
+                                         size_t datagram_size, size_t offset,
+                                         size_t *nh_size)
 {
     uint8_t *payload = pkt->data;
-    gnrc_pktsnip_t *ipv6 = *dec_hdr;
-    ipv6_hdr_t *ipv6_hdr = ipv6->data;
 #ifdef MODULE_GNRC_UDP
     const gnrc_nettype_t snip_type = GNRC_NETTYPE_UDP;
 #else
@@ -138,8 +151,12 @@ inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
     }
     else {                      /* received packet is fragmented */
         /* reassembly is in-place => don't allocate new packet snip */
-        /* TODO: account for extension headers */
-        udp_hdr = (udp_hdr_t *)(ipv6_hdr + 1);
+        if ((*dec_hdr)->size < (sizeof(ipv6_hdr_t) + *nh_size + sizeof(udp_hdr_t))) {
+            DEBUG("6lo: no space for IPHC NHC UDP decoding\n");
+            return 0;
+        }
+        udp_hdr = (udp_hdr_t *)(((uint8_t *)(*dec_hdr)->data) + sizeof(ipv6_hdr_t) +
+                                *nh_size);
     }
     network_uint16_t *src_port = &(udp_hdr->src_port);
     network_uint16_t *dst_port = &(udp_hdr->dst_port);
@@ -189,20 +206,122 @@ inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
         udp_hdr->checksum.u8[1] = payload[offset++];
     }
 
-    /* TODO subtract extension header length */
     if (udp != NULL) {
         udp_hdr->length = byteorder_htons(pkt->size - offset + sizeof(udp_hdr_t));
     }
     else {
-        udp_hdr->length = byteorder_htons(datagram_size - sizeof(ipv6_hdr_t));
+        udp_hdr->length = byteorder_htons(datagram_size - sizeof(ipv6_hdr_t) -
+                                          *nh_size);
     }
-    ipv6_hdr->nh = PROTNUM_UDP;
-    ipv6_hdr->len = udp_hdr->length;
 
     if (udp != NULL) {  /* prepend udp header in case of packet not being fragmented */
-        udp->next = ipv6;
+        udp->next = *dec_hdr;
         *dec_hdr = udp;
     }
+    *nh_size += sizeof(udp_hdr_t);
+
+    return offset;
+}
+
+inline static size_t iphc_nhc_ipv6_ext_decode(gnrc_pktsnip_t *pkt,
+                                              gnrc_pktsnip_t **dec_hdr,
+                                              size_t datagram_size, size_t offset,
+                                              size_t *nh_size, uint8_t **nh)
+{
+    uint8_t *payload = pkt->data;
+#ifdef MODULE_GNRC_IPV6_EXT
+    const gnrc_nettype_t snip_type = GNRC_NETTYPE_IPV6_EXT;
+#else
+    const gnrc_nettype_t snip_type = GNRC_NETTYPE_UNDEF;
+#endif
+    uint8_t ext_nhc = payload[offset++];
+    uint8_t next = 0;
+    gnrc_pktsnip_t *ext_snip;
+    ipv6_ext_t *ext;
+    uint8_t *pad;
+    size_t len, ext_len;
+
+    switch (ext_nhc & NHC_IPV6_EXT_EID_MASK) {
+        case NHC_IPV6_EXT_EID_HOPOPT:
+            **nh = PROTNUM_IPV6_EXT_HOPOPT;
+            break;
+
+        case NHC_IPV6_EXT_EID_RH:
+            **nh = PROTNUM_IPV6_EXT_RH;
+            break;
+
+        case NHC_IPV6_EXT_EID_DST:
+            **nh = PROTNUM_IPV6_EXT_DST;
+            break;
+
+        case NHC_IPV6_EXT_EID_MOB:
+            **nh = PROTNUM_IPV6_EXT_MOB;
+            break;
+
+        default:
+            DEBUG("6lo iphc nhc: unsupported extension header\n");
+            return 0;
+    }
+
+    if (!(ext_nhc & NHC_IPV6_EXT_NH)) {
+        next = payload[offset++];
+    }
+    if (offset >= pkt->size) {
+        DEBUG("6lo iphc nhc: extension header truncated\n");
+        return 0;
+    }
+    len = payload[offset++];
+    if ((offset + len) > pkt->size) {
+        DEBUG("6lo iphc nhc: extension header truncated\n");
+        return 0;
+    }
+    ext_len = sizeof(ipv6_ext_t) + len;
+    if ((**nh == PROTNUM_IPV6_EXT_HOPOPT) || (**nh == PROTNUM_IPV6_EXT_DST)) {
+        /* restore the padding the compressor may have elided */
+        ext_len = (ext_len + IPV6_EXT_LEN_UNIT - 1) & ~(IPV6_EXT_LEN_UNIT - 1);
+    }
+    else if ((ext_len % IPV6_EXT_LEN_UNIT) != 0) {
+        DEBUG("6lo iphc nhc: extension header not aligned\n");
+        return 0;
+    }
+
+    if (datagram_size == 0) {    /* received packet is not fragmented */
+        ext_snip = gnrc_pktbuf_add(NULL, NULL, ext_len, snip_type);
+        if (ext_snip == NULL) {
+            DEBUG("6lo: error on IPHC NHC extension header decoding\n");
+            return 0;
+        }
+        ext = ext_snip->data;
+        ext_snip->next = *dec_hdr;
+        *dec_hdr = ext_snip;
+    }
+    else {                      /* received packet is fragmented */
+        if ((*dec_hdr)->size < (sizeof(ipv6_hdr_t) + *nh_size + ext_len)) {
+            DEBUG("6lo: no space for IPHC NHC extension header decoding\n");
+            return 0;
+        }
+        ext = (ipv6_ext_t *)(((uint8_t *)(*dec_hdr)->data) + sizeof(ipv6_hdr_t) +
+                             *nh_size);
+    }
+
+    DEBUG("6lo iphc nhc: extension header %u, %u byte\n", (unsigned)**nh,
+          (unsigned)ext_len);
+    ext->nh = next;
+    ext->len = (ext_len / IPV6_EXT_LEN_UNIT) - 1;
+    memcpy(ext + 1, payload + offset, len);
+    offset += len;
+    pad = ((uint8_t *)(ext + 1)) + len;
+    len = ext_len - sizeof(ipv6_ext_t) - len;
+    if (len == 1) {
+        pad[0] = NHC_IPV6_EXT_OPT_PAD1;
+    }
+    else if (len > 1) {
+        pad[0] = NHC_IPV6_EXT_OPT_PADN;
+        pad[1] = len - 2;
+        memset(pad + 2, 0, len - 2);
+    }
+    *nh_size += ext_len;
+    *nh = &ext->nh;
 
     return offset;
 }
@@ -496,21 +615,47 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
     if (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
-        switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
-            case NHC_UDP_ID:
-                payload_offset = iphc_nhc_udp_decode(pkt, dec_hdr, datagram_size,
-                                                     payload_offset + offset);
+        uint8_t *nh = &ipv6_hdr->nh;
+        size_t nh_size = 0;
+        bool nhc = true;
 
-                if (payload_offset != 0) {
-                    payload_offset -= offset;
-                }
+        while (nhc) {
+            uint8_t nhc_id;
+
+            if ((payload_offset + offset) >= pkt->size) {
+                DEBUG("6lo iphc: NHC header missing\n");
+                return 0;
+            }
+            nhc_id = iphc_hdr[payload_offset];
+            if ((nhc_id & NHC_IPV6_EXT_ID_MASK) == NHC_IPV6_EXT_ID) {
+                payload_offset = iphc_nhc_ipv6_ext_decode(pkt, dec_hdr, datagram_size,
+                                                          payload_offset + offset,
+                                                          &nh_size, &nh);
+                nhc = (nhc_id & NHC_IPV6_EXT_NH);
+            }
+            else if ((nhc_id & NHC_ID_MASK) == NHC_UDP_ID) {
+                *nh = PROTNUM_UDP;
+                payload_offset = iphc_nhc_udp_decode(pkt, dec_hdr, datagram_size,
+                                                     payload_offset + offset,
+                                                     &nh_size);
+                nhc = false;
+            }
+            else {
+                DEBUG("6lo iphc: unsupported NHC header %02x\n", (unsigned)nhc_id);
+                return 0;
+            }
 
-                *nh_len += sizeof(udp_hdr_t);
-                break;
+            if (payload_offset == 0) {
+                return 0;
+            }
+            payload_offset -= offset;
+        }
 
-            default:
-                break;
+        if (datagram_size == 0) {
+            ipv6_hdr->len = byteorder_htons((uint16_t)(pkt->size - payload_offset +
+                                                       nh_size));
         }
+        *nh_len += nh_size;
     }
 #else
     (void)nh_len;
@@ -520,7 +665,7 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_hdr)
+inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, uint8_t *nhc_id)
 {
     udp_hdr_t *udp_hdr = udp->data;
     network_uint16_t *src_port = &(udp_hdr->src_port);
@@ -534,7 +679,7 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
     if (((byteorder_ntohs(*src_port) & NHC_UDP_4BIT_MASK) == NHC_UDP_4BIT_PORT) &&
         ((byteorder_ntohs(*dst_port) & NHC_UDP_4BIT_MASK) == NHC_UDP_4BIT_PORT)) {
         DEBUG("6lo iphc nhc: elide src and dst\n");
-        ipv6_hdr->nh = NHC_UDP_SD_ELIDED;
+        *nhc_id = NHC_UDP_SD_ELIDED;
         udp_data[nhc_len++] = byteorder_ntohs(*dst_port) - NHC_UDP_4BIT_PORT +
                               ((byteorder_ntohs(*src_port) - NHC_UDP_4BIT_PORT) << 4);
         udp_data[nhc_len++] = udp_hdr->checksum.u8[0];
@@ -542,7 +687,7 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
     }
     else if ((byteorder_ntohs(*dst_port) & NHC_UDP_8BIT_MASK) == NHC_UDP_8BIT_PORT) {
         DEBUG("6lo iphc nhc: elide dst\n");
-        ipv6_hdr->nh = NHC_UDP_S_INLINE;
+        *nhc_id = NHC_UDP_S_INLINE;
         nhc_len += 2; /* keep src_port */
         udp_data[nhc_len++] = byteorder_ntohs(*dst_port) - NHC_UDP_8BIT_PORT;
         udp_data[nhc_len++] = udp_hdr->checksum.u8[0];
@@ -550,7 +695,7 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
     }
     else if ((byteorder_ntohs(*src_port) & NHC_UDP_8BIT_MASK) == NHC_UDP_8BIT_PORT) {
         DEBUG("6lo iphc nhc: elide src\n");
-        ipv6_hdr->nh = NHC_UDP_D_INLINE;
+        *nhc_id = NHC_UDP_D_INLINE;
         udp_data[nhc_len++] = byteorder_ntohs(*src_port) - NHC_UDP_8BIT_PORT;
         udp_data[nhc_len++] = udp_hdr->dst_port.u8[0];
         udp_data[nhc_len++] = udp_hdr->dst_port.u8[1];
@@ -559,14 +704,14 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
     }
     else {
         DEBUG("6lo iphc nhc: src and dst inline\n");
-        ipv6_hdr->nh = NHC_UDP_SD_INLINE;
+        *nhc_id = NHC_UDP_SD_INLINE;
         nhc_len = sizeof(udp_hdr_t) - 4; /* skip src + dst and elide length */
         udp_data[nhc_len++] = udp_hdr->checksum.u8[0];
         udp_data[nhc_len++] = udp_hdr->checksum.u8[1];
     }
 
     /* Set UDP header ID (rfc6282#section-5). */
-    ipv6_hdr->nh |= NHC_UDP_ID;
+    *nhc_id |= NHC_UDP_ID;
 
     /* In case payload is in this snip (e.g. a forwarded packet):
      * move data to right place */
@@ -579,6 +724,152 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 
     return nhc_len;
 }
+
+static inline uint8_t _nhc_ipv6_ext_eid(uint8_t nh)
+{
+    switch (nh) {
+        case PROTNUM_IPV6_EXT_HOPOPT:
+            return NHC_IPV6_EXT_EID_HOPOPT;
+        case PROTNUM_IPV6_EXT_RH:
+            return NHC_IPV6_EXT_EID_RH;
+        case PROTNUM_IPV6_EXT_DST:
+            return NHC_IPV6_EXT_EID_DST;
+        case PROTNUM_IPV6_EXT_MOB:
+            return NHC_IPV6_EXT_EID_MOB;
+        default:
+            return NHC_IPV6_EXT_EID_NONE;
+    }
+}
+
+/* moves offset to the next snip if it points behind the end of snip */
+static inline void _nhc_skip_snip(const gnrc_pktsnip_t **snip, size_t *offset)
+{
+    if ((*snip != NULL) && (*offset >= (*snip)->size)) {
+        *snip = (*snip)->next;
+        *offset = 0;
+    }
+}
+
+/* returns the length of the extension header of type nh at offset in snip
+ * or 0 if it can not be compressed */
+static size_t _nhc_ipv6_ext_len(uint8_t nh, const gnrc_pktsnip_t *snip, size_t offset)
+{
+    const ipv6_ext_t *ext;
+    size_t ext_len;
+
+    if ((_nhc_ipv6_ext_eid(nh) == NHC_IPV6_EXT_EID_NONE) || (snip == NULL) ||
+        ((snip->size - offset) < sizeof(ipv6_ext_t))) {
+        return 0;
+    }
+    ext = (const ipv6_ext_t *)(((const uint8_t *)snip->data) + offset);
+    ext_len = (ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT;
+    /* the header must be in one piece and its compressed length must fit the
+     * 8-bit length field */
+    if ((ext_len > (snip->size - offset)) ||
+        (ext_len > (UINT8_MAX + sizeof(ipv6_ext_t)))) {
+        return 0;
+    }
+    return ext_len;
+}
+
+static bool _nhc_compressible(uint8_t nh, const gnrc_pktsnip_t *snip, size_t offset)
+{
+    _nhc_skip_snip(&snip, &offset);
+    if (nh == PROTNUM_UDP) {
+        return (snip != NULL) && ((snip->size - offset) >= sizeof(udp_hdr_t));
+    }
+    return _nhc_ipv6_ext_len(nh, snip, offset) > 0;
+}
+
+/* sums up the lengths of the extension headers that will be compressed */
+static size_t _nhc_ipv6_ext_total(uint8_t nh, const gnrc_pktsnip_t *snip)
+{
+    size_t total = 0, offset = 0, ext_len;
+
+    _nhc_skip_snip(&snip, &offset);
+    while ((ext_len = _nhc_ipv6_ext_len(nh, snip, offset)) > 0) {
+        nh = ((const ipv6_ext_t *)(((const uint8_t *)snip->data) + offset))->nh;
+        total += ext_len;
+        offset += ext_len;
+        _nhc_skip_snip(&snip, &offset);
+    }
+    return total;
+}
+
+/* returns the length of the options of a Hop-by-Hop or Destination Options
+ * header without a trailing Pad1 or PadN option, which may be elided
+ * (RFC 6282, section 4.2) */
+static size_t _nhc_ipv6_ext_opts_len(uint8_t nh, const uint8_t *opts, size_t len)
+{
+    size_t i = 0, last = len;
+
+    if ((nh != PROTNUM_IPV6_EXT_HOPOPT) && (nh != PROTNUM_IPV6_EXT_DST)) {
+        return len;
+    }
+    while (i < len) {
+        last = i;
+        if (opts[i] == NHC_IPV6_EXT_OPT_PAD1) {
+            i++;
+        }
+        else if ((i + 1) < len) {
+            i += opts[i + 1] + 2;
+        }
+        else {
+            break;
+        }
+    }
+    if ((i == len) && (last < len) && ((len - last) < IPV6_EXT_LEN_UNIT) &&
+        ((opts[last] == NHC_IPV6_EXT_OPT_PAD1) ||
+         (opts[last] == NHC_IPV6_EXT_OPT_PADN))) {
+        return last;
+    }
+    return len;
+}
+
+/* compresses the next headers following the IPv6 header into nhc_hdr and
+ * removes the compressed extension headers from the packet */
+static size_t iphc_nhc_encode(gnrc_pktsnip_t *ipv6, uint8_t *nhc_hdr)
+{
+    uint8_t nh = ((ipv6_hdr_t *)ipv6->data)->nh;
+    size_t pos = 0;
+
+    while (nh != PROTNUM_UDP) {
+        gnrc_pktsnip_t *snip = ipv6->next;
+        ipv6_ext_t *ext = snip->data;
+        size_t ext_len = (ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT;
+        size_t len = _nhc_ipv6_ext_opts_len(nh, (uint8_t *)(ext + 1),
+                                            ext_len - sizeof(ipv6_ext_t));
+        bool nhc = _nhc_compressible(ext->nh, snip, ext_len);
+
+        DEBUG("6lo iphc nhc: compress extension header %u (%u of %u byte)\n",
+              (unsigned)nh, (unsigned)len, (unsigned)ext_len);
+        nhc_hdr[pos++] = NHC_IPV6_EXT_ID | _nhc_ipv6_ext_eid(nh) |
+                         (nhc ? NHC_IPV6_EXT_NH : 0);
+        if (!nhc) {
+            nhc_hdr[pos++] = ext->nh;
+        }
+        nhc_hdr[pos++] = (uint8_t)len;
+        memcpy(nhc_hdr + pos, ext + 1, len);
+        pos += len;
+        nh = ext->nh;
+
+        /* remove the extension header from the packet */
+        if (snip->size == ext_len) {
+            gnrc_pktbuf_remove_snip(ipv6, snip);
+        }
+        else {
+            memmove(snip->data, ((uint8_t *)snip->data) + ext_len,
+                    snip->size - ext_len);
+            gnrc_pktbuf_realloc_data(snip, snip->size - ext_len);
+        }
+        if (!nhc) {
+            return pos;
+        }
+    }
+    iphc_nhc_udp_encode(ipv6->next, &nhc_hdr[pos++]);
+
+    return pos;
+}
 #endif
 
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
@@ -587,10 +878,19 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     ipv6_hdr_t *ipv6_hdr = pkt->next->data;
     uint8_t *iphc_hdr;
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-    bool addr_comp = false, nhc_comp = false;
+    bool addr_comp = false;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
+    size_t disp_size = pkt->next->size;
+    gnrc_pktsnip_t *dispatch;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    bool nhc_comp = false;
+
+    /* compressed extension headers are not longer than uncompressed ones: the
+     * byte following the last one makes up for the next header that is not
+     * carried inline by IPHC */
+    disp_size += _nhc_ipv6_ext_total(ipv6_hdr->nh, pkt->next->next);
+#endif
+    dispatch = gnrc_pktbuf_add(NULL, NULL, disp_size, GNRC_NETTYPE_SIXLOWPAN);
 
     if (dispatch == NULL) {
         DEBUG("6lo iphc: error allocating dispatch space\n");
@@ -668,18 +968,15 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     }
 
     /* compress next header */
-    switch (ipv6_hdr->nh) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            nhc_comp = true;
-            break;
+    if (_nhc_compressible(ipv6_hdr->nh, pkt->next->next, 0)) {
+        iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+        nhc_comp = true;
+    }
+    else
 #endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
+    {
+        iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
 
     /* compress hop limit */
@@ -877,9 +1174,11 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         inline_pos += 16;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
     if (nhc_comp) {
-        iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+        inline_pos += iphc_nhc_encode(pkt->next, iphc_hdr + inline_pos);
     }
+#endif
 
     /* shrink dispatch allocation to final size */
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
@@ -336,35 +336,38 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
             }
             /* TODO multihop DAD */
             if ((nc_entry != NULL) &&
-                ((gnrc_ipv6_nc_get_type(nc_entry) == GNRC_IPV6_NC_TYPE_REGISTERED) ||
-                 (gnrc_ipv6_nc_get_type(nc_entry) == GNRC_IPV6_NC_TYPE_TENTATIVE)) &&
+                (gnrc_ipv6_nc_get_type(nc_entry) == GNRC_IPV6_NC_TYPE_TENTATIVE) &&
                 ((nc_entry->eui64.uint64.u64 != 0) &&
                  (ar_opt->eui64.uint64.u64 != nc_entry->eui64.uint64.u64))) {
                 /* there is already another node with this address */
                 DEBUG("6lo nd: duplicate address detected\n");
-                status = SIXLOWPAN_ND_STATUS_DUP;
+                return SIXLOWPAN_ND_STATUS_DUP;
+            }
+            /* the registration table detects duplicates and expires the
+             * registration */
+            status = gnrc_sixlowpan_nd_router_reg_update(iface, &ipv6->src, &ar_opt->eui64,
+                                                         byteorder_ntohs(ar_opt->ltime));
+            if (status != SIXLOWPAN_ND_STATUS_SUCCESS) {
+                DEBUG("6lo nd: address registration failed with status %u\n", status);
             }
             else if ((nc_entry != NULL) && (ar_opt->ltime.u16 == 0)) {
                 gnrc_ipv6_nc_remove(iface, &ipv6->src);
                 /* TODO, notify routing protocol */
             }
             else if (ar_opt->ltime.u16 != 0) {
-                /* TODO: multihop DAD behavior */
-                uint16_t reg_ltime;
                 if (nc_entry == NULL) {
                     if ((nc_entry = gnrc_ipv6_nc_add(iface, &ipv6->src, sl2a, sl2a_len,
                                                      GNRC_IPV6_NC_STATE_STALE)) == NULL) {
                         DEBUG("6lo nd: neighbor cache is full\n");
+                        gnrc_sixlowpan_nd_router_reg_update(iface, &ipv6->src,
+                                                            &ar_opt->eui64, 0);
                         return SIXLOWPAN_ND_STATUS_NC_FULL;
                     }
                     nc_entry->eui64 = ar_opt->eui64;
                 }
                 nc_entry->flags &= ~GNRC_IPV6_NC_TYPE_MASK;
                 nc_entry->flags |= GNRC_IPV6_NC_TYPE_REGISTERED;
-                reg_ltime = byteorder_ntohs(ar_opt->ltime);
                 /* TODO: notify routing protocol */
-                xtimer_set_msg(&nc_entry->type_timeout, (reg_ltime * 60 * US_PER_SEC),
-                               &nc_entry->type_timeout_msg, gnrc_ipv6_pid);
             }
             break;
 #endif
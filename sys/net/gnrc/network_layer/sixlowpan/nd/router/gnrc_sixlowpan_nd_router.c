@@ -12,7 +12,12 @@
  * @file
  */
 
+#include <stddef.h>
+#include <string.h>
+
+#include "net/gnrc/icmpv6.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -22,9 +27,38 @@
 
 #include "net/gnrc/sixlowpan/nd/router.h"
 
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* links in the registration table are the index of the entry + 1, so the
+ * zero-initialized table is empty */
+#define REG_NONE            (0U)
+#define REG_BUCKET_MASK     (GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS - 1)
+#define REG_TICK            (60U * US_PER_SEC)
+
+#if GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF >= UINT16_MAX
+#error "GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF must be smaller than UINT16_MAX"
+#endif
+#if (GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS & REG_BUCKET_MASK) || \
+    (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE - 1))
+#error "GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS and _WHEEL_SIZE must be powers of 2"
+#endif
+
 static gnrc_sixlowpan_nd_router_abr_t _abrs[GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF];
 static gnrc_sixlowpan_nd_router_prf_t _prefixes[GNRC_SIXLOWPAN_ND_ROUTER_ABR_PRF_NUMOF];
 
+static gnrc_sixlowpan_nd_router_reg_t _regs[GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF];
+static uint16_t _reg_addr[GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS];
+static uint16_t _reg_eui64[GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS];
+static uint16_t _reg_wheel[GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE];
+static uint16_t _reg_free;      /* free entries, chained through addr_next */
+static uint16_t _reg_used;      /* entries that were never used start here */
+static uint16_t _reg_numof;
+static uint16_t _reg_now;       /* the table's clock in minutes */
+static bool _reg_ticking;
+static xtimer_t _reg_timer;
+static msg_t _reg_timer_msg = { .type = GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT };
+
 static gnrc_sixlowpan_nd_router_abr_t *_get_abr(ipv6_addr_t *addr)
 {
     gnrc_sixlowpan_nd_router_abr_t *abr = NULL;
@@ -99,6 +133,86 @@ static void _add_ctx(gnrc_sixlowpan_nd_router_abr_t *abr, sixlowpan_nd_opt_6ctx_
     bf_set(abr->ctxs, sixlowpan_nd_opt_6ctx_get_cid(ctx_opt));
 }
 
+static inline gnrc_sixlowpan_nd_router_reg_t *_reg(uint16_t link)
+{
+    return (link == REG_NONE) ? NULL : &_regs[link - 1];
+}
+
+static inline uint16_t _reg_link(gnrc_sixlowpan_nd_router_reg_t *reg)
+{
+    return (uint16_t)(reg - _regs) + 1;
+}
+
+static inline unsigned _fold(uint32_t h)
+{
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return h & REG_BUCKET_MASK;
+}
+
+static inline unsigned _addr_bucket(const ipv6_addr_t *addr)
+{
+    /* registered addresses mostly differ in their interface identifier */
+    return _fold(addr->u32[2].u32 ^ addr->u32[3].u32);
+}
+
+static inline unsigned _eui64_bucket(const eui64_t *eui64)
+{
+    return _fold((uint32_t)(eui64->uint64.u64 >> 32) ^ (uint32_t)eui64->uint64.u64);
+}
+
+/* the link to the next entry of the list chained through the member at
+ * @p offset */
+static inline uint16_t *_reg_next(uint16_t link, size_t offset)
+{
+    return (uint16_t *)(((uint8_t *)_reg(link)) + offset);
+}
+
+static void _reg_list_remove(uint16_t *head, uint16_t link, size_t offset)
+{
+    while (*head != REG_NONE) {
+        if (*head == link) {
+            *head = *_reg_next(link, offset);
+            return;
+        }
+        head = _reg_next(*head, offset);
+    }
+}
+
+static inline uint16_t *_reg_slot(uint16_t expires)
+{
+    return &_reg_wheel[expires & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE - 1)];
+}
+
+static gnrc_sixlowpan_nd_router_reg_t *_reg_alloc(void)
+{
+    gnrc_sixlowpan_nd_router_reg_t *reg = _reg(_reg_free);
+
+    if (reg != NULL) {
+        _reg_free = reg->addr_next;
+    }
+    else if (_reg_used < GNRC_SIXLOWPAN_ND_ROUTER_REG_NUMOF) {
+        reg = &_regs[_reg_used++];
+    }
+    return reg;
+}
+
+/* removes @p reg from the hashes and frees it, the caller takes it out of the
+ * timer wheel */
+static void _reg_free_entry(gnrc_sixlowpan_nd_router_reg_t *reg)
+{
+    uint16_t link = _reg_link(reg);
+
+    _reg_list_remove(&_reg_addr[_addr_bucket(&reg->addr)], link,
+                     offsetof(gnrc_sixlowpan_nd_router_reg_t, addr_next));
+    _reg_list_remove(&_reg_eui64[_eui64_bucket(&reg->eui64)], link,
+                     offsetof(gnrc_sixlowpan_nd_router_reg_t, eui64_next));
+    ipv6_addr_set_unspecified(&reg->addr);
+    reg->addr_next = _reg_free;
+    _reg_free = link;
+    _reg_numof--;
+}
+
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
 static inline bool _is_me(ipv6_addr_t *addr)
 {
@@ -185,6 +299,120 @@ void gnrc_sixlowpan_nd_router_abr_remove(gnrc_sixlowpan_nd_router_abr_t *abr)
     abr->version = 0;
 }
 
+gnrc_sixlowpan_nd_router_reg_t *gnrc_sixlowpan_nd_router_reg_get(const ipv6_addr_t *addr)
+{
+    gnrc_sixlowpan_nd_router_reg_t *reg = _reg(_reg_addr[_addr_bucket(addr)]);
+
+    while ((reg != NULL) && !ipv6_addr_equal(&reg->addr, addr)) {
+        reg = _reg(reg->addr_next);
+    }
+    return reg;
+}
+
+gnrc_sixlowpan_nd_router_reg_t *gnrc_sixlowpan_nd_router_reg_get_by_eui64(const eui64_t *eui64,
+                                                                         gnrc_sixlowpan_nd_router_reg_t *prev)
+{
+    gnrc_sixlowpan_nd_router_reg_t *reg;
+
+    reg = (prev == NULL) ? _reg(_reg_eui64[_eui64_bucket(eui64)]) : _reg(prev->eui64_next);
+    while ((reg != NULL) && (reg->eui64.uint64.u64 != eui64->uint64.u64)) {
+        reg = _reg(reg->eui64_next);
+    }
+    return reg;
+}
+
+uint8_t gnrc_sixlowpan_nd_router_reg_update(kernel_pid_t iface, const ipv6_addr_t *addr,
+                                            const eui64_t *eui64, uint16_t ltime)
+{
+    gnrc_sixlowpan_nd_router_reg_t *reg;
+    uint16_t *slot;
+
+    assert((addr != NULL) && (eui64 != NULL));
+    reg = gnrc_sixlowpan_nd_router_reg_get(addr);
+    if (reg != NULL) {
+        if (reg->eui64.uint64.u64 != eui64->uint64.u64) {
+            DEBUG("6lo nd router: address is registered by another node\n");
+            return SIXLOWPAN_ND_STATUS_DUP;
+        }
+        if (ltime == 0) {
+            gnrc_sixlowpan_nd_router_reg_remove(reg);
+            return SIXLOWPAN_ND_STATUS_SUCCESS;
+        }
+        _reg_list_remove(_reg_slot(reg->expires), _reg_link(reg),
+                         offsetof(gnrc_sixlowpan_nd_router_reg_t, wheel_next));
+        /* a refresh through a DAR keeps the registration's neighbor */
+        if (iface != KERNEL_PID_UNDEF) {
+            reg->iface = iface;
+        }
+    }
+    else if (ltime == 0) {
+        return SIXLOWPAN_ND_STATUS_SUCCESS;
+    }
+    else {
+        unsigned bucket;
+
+        if ((reg = _reg_alloc()) == NULL) {
+            DEBUG("6lo nd router: registration table is full\n");
+            return SIXLOWPAN_ND_STATUS_NC_FULL;
+        }
+        memcpy(&reg->addr, addr, sizeof(reg->addr));
+        reg->eui64 = *eui64;
+        reg->iface = iface;
+        bucket = _addr_bucket(addr);
+        reg->addr_next = _reg_addr[bucket];
+        _reg_addr[bucket] = _reg_link(reg);
+        bucket = _eui64_bucket(eui64);
+        reg->eui64_next = _reg_eui64[bucket];
+        _reg_eui64[bucket] = _reg_link(reg);
+        _reg_numof++;
+        if (!_reg_ticking) {
+            _reg_ticking = true;
+            xtimer_set_msg(&_reg_timer, REG_TICK, &_reg_timer_msg, gnrc_ipv6_pid);
+        }
+    }
+    /* the current minute of the clock already started, so round up */
+    reg->expires = _reg_now + ltime + 1;
+    slot = _reg_slot(reg->expires);
+    reg->wheel_next = *slot;
+    *slot = _reg_link(reg);
+    return SIXLOWPAN_ND_STATUS_SUCCESS;
+}
+
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_sixlowpan_nd_router_reg_t *reg)
+{
+    _reg_list_remove(_reg_slot(reg->expires), _reg_link(reg),
+                     offsetof(gnrc_sixlowpan_nd_router_reg_t, wheel_next));
+    _reg_free_entry(reg);
+}
+
+void gnrc_sixlowpan_nd_router_reg_timeout(void)
+{
+    uint16_t *link = _reg_slot(++_reg_now);
+
+    while (*link != REG_NONE) {
+        gnrc_sixlowpan_nd_router_reg_t *reg = _reg(*link);
+
+        /* entries of later rounds of the wheel stay in the slot */
+        if (reg->expires != _reg_now) {
+            link = &reg->wheel_next;
+            continue;
+        }
+        *link = reg->wheel_next;
+        if (reg->iface != KERNEL_PID_UNDEF) {
+            gnrc_ipv6_nc_t *nc_entry = gnrc_ipv6_nc_get(reg->iface, &reg->addr);
+
+            if (nc_entry != NULL) {
+                gnrc_sixlowpan_nd_router_gc_nc(nc_entry);
+            }
+        }
+        _reg_free_entry(reg);
+    }
+    _reg_ticking = (_reg_numof > 0);
+    if (_reg_ticking) {
+        xtimer_set_msg(&_reg_timer, REG_TICK, &_reg_timer_msg, gnrc_ipv6_pid);
+    }
+}
+
 /* router-only functions from net/gnrc/sixlowpan/nd.h */
 void gnrc_sixlowpan_nd_opt_abr_handle(kernel_pid_t iface, ndp_rtr_adv_t *rtr_adv, int sicmpv6_size,
                                       sixlowpan_nd_opt_abr_t *abr_opt)
@@ -381,5 +609,44 @@ void gnrc_sixlowpan_nd_router_abr_rem_ctx(gnrc_sixlowpan_nd_router_abr_t *abr, u
     abr->version++; /* TODO: store somewhere stable */
     return;
 }
+
+void gnrc_sixlowpan_nd_router_dar_handle(ipv6_hdr_t *ipv6, sixlowpan_nd_da_t *dar, size_t size)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    sixlowpan_nd_da_t *dac;
+    uint8_t status;
+
+    /* discard silently: see https://tools.ietf.org/html/rfc6775#section-8.2.3 */
+    if ((size < sizeof(sixlowpan_nd_da_t)) || (dar->code != 0) ||
+        ipv6_addr_is_unspecified(&dar->addr) || ipv6_addr_is_multicast(&dar->addr) ||
+        ipv6_addr_is_link_local(&dar->addr) || ipv6_addr_is_multicast(&ipv6->src)) {
+        DEBUG("6lo nd router: invalid duplicate address request\n");
+        return;
+    }
+    status = gnrc_sixlowpan_nd_router_reg_update(KERNEL_PID_UNDEF, &dar->addr, &dar->eui64,
+                                                 byteorder_ntohs(dar->ltime));
+    pkt = gnrc_icmpv6_build(NULL, ICMPV6_DAC, 0, sizeof(sixlowpan_nd_da_t));
+    if (pkt == NULL) {
+        DEBUG("6lo nd router: no space left in packet buffer\n");
+        return;
+    }
+    dac = pkt->data;
+    dac->status = status;
+    dac->resv = 0;
+    dac->ltime = dar->ltime;
+    dac->eui64 = dar->eui64;
+    memcpy(&dac->addr, &dar->addr, sizeof(dac->addr));
+    hdr = gnrc_ipv6_hdr_build(pkt, NULL, &ipv6->src);
+    if (hdr == NULL) {
+        DEBUG("6lo nd router: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((ipv6_hdr_t *)hdr->data)->hl = GNRC_SIXLOWPAN_ND_MULTIHOP_HOPLIMIT;
+    if (gnrc_netapi_send(gnrc_ipv6_pid, hdr) < 1) {
+        DEBUG("6lo nd router: unable to send duplicate address confirmation\n");
+        gnrc_pktbuf_release(hdr);
+    }
+}
 #endif
 /** @} */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pcap
+ * @{
+ *
+ * @file
+ * @brief       pcap packet sink implementation
+ *
+ * The thread frames the records into the ring buffer and starts sending the
+ * buffered bytes whenever the UART is idle. The end of a write is signalled by
+ * a message, but checked with every message, so a lost one only delays the
+ * next write.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "div.h"
+#include "irq.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/pcap.h"
+#include "periph/uart.h"
+#include "thread.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define MSG_TYPE_TX_DONE        (0x4c50)
+
+#define FRAME_DELIMITER         (0x7E)
+#define FRAME_ESC_CHAR          (0x7D)
+
+/* framing, with every byte escaped in the worst case */
+#define FRAME_LEN_MAX(len)      (2 + (2 * (sizeof(gnrc_pcap_hdr_t) + (len))))
+
+kernel_pid_t gnrc_pcap_pid = KERNEL_PID_UNDEF;
+
+static char _stack[GNRC_PCAP_STACKSIZE];
+static msg_t _msg_queue[GNRC_PCAP_MSG_QUEUE_SIZE];
+
+static char _buf[GNRC_PCAP_BUFSIZE];
+static tsrb_t _rb;
+static volatile unsigned _tx_len;   /* bytes of the running write */
+static unsigned _tx_sent;           /* bytes of the last write, to drop */
+static uint32_t _dropped;           /* since the last record */
+static uint32_t _dropped_total;
+
+static void _tx_done(void *arg)
+{
+    static msg_t msg = { .type = MSG_TYPE_TX_DONE };
+
+    (void)arg;
+    _tx_len = 0;
+    /* without asynchronous writes this is called from the thread itself */
+    if (irq_is_in()) {
+        msg_send_int(&msg, gnrc_pcap_pid);
+    }
+}
+
+static void _tx_start(void)
+{
+    char *data;
+
+    if (_tx_len) {
+        return;
+    }
+    if (_tx_sent) {
+        tsrb_drop(&_rb, _tx_sent);
+    }
+    /* a wrapped record is sent by two writes */
+    while ((_tx_sent = tsrb_get_span(&_rb, &data)) > 0) {
+        _tx_len = _tx_sent;
+        uart_write_async(GNRC_PCAP_UART, (uint8_t *)data, _tx_sent, _tx_done,
+                         NULL);
+        if (_tx_len) {
+            /* dropped on the next call after it completed */
+            return;
+        }
+        tsrb_drop(&_rb, _tx_sent);
+    }
+}
+
+static void _put(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if ((data[i] == FRAME_DELIMITER) || (data[i] == FRAME_ESC_CHAR)) {
+            tsrb_add_one(&_rb, FRAME_ESC_CHAR);
+            tsrb_add_one(&_rb, data[i] ^ 0x20);
+        }
+        else {
+            tsrb_add_one(&_rb, data[i]);
+        }
+    }
+}
+
+/* writes the snips outermost header first, received packets are stored in
+ * the opposite order */
+static size_t _put_snips(const gnrc_pktsnip_t *pkt, size_t left)
+{
+    size_t len = 0;
+
+    if (pkt == NULL) {
+        return 0;
+    }
+    len = _put_snips(pkt->next, left);
+    if (pkt->type != GNRC_NETTYPE_NETIF) {
+        size_t n = (pkt->size < (left - len)) ? pkt->size : (left - len);
+        _put(pkt->data, n);
+        len += n;
+    }
+    return len;
+}
+
+static void _record(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    gnrc_pcap_hdr_t hdr = { .reserved = 0 };
+    uint64_t now = xtimer_now_usec64();
+    uint64_t sec = div_u64_by_1000000(now);
+    size_t len = gnrc_pkt_len(pkt) - ((netif != NULL) ? netif->size : 0);
+    size_t caplen = (len < GNRC_PCAP_SNAPLEN) ? len : GNRC_PCAP_SNAPLEN;
+
+    if (tsrb_free(&_rb) < FRAME_LEN_MAX(caplen)) {
+        _dropped++;
+        _dropped_total++;
+        return;
+    }
+    hdr.sec = byteorder_htonl((uint32_t)sec);
+    hdr.usec = byteorder_htonl((uint32_t)(now - (sec * US_PER_SEC)));
+    hdr.len = byteorder_htons((uint16_t)len);
+    hdr.dropped = byteorder_htons((_dropped > UINT16_MAX) ? UINT16_MAX :
+                                  (uint16_t)_dropped);
+    if (netif != NULL) {
+        gnrc_netif_hdr_t *netif_hdr = netif->data;
+        hdr.if_pid = (uint8_t)netif_hdr->if_pid;
+        hdr.rssi = netif_hdr->rssi;
+        hdr.lqi = netif_hdr->lqi;
+    }
+    _dropped = 0;
+
+    tsrb_add_one(&_rb, FRAME_DELIMITER);
+    _put((uint8_t *)&hdr, sizeof(hdr));
+    _put_snips(pkt, caplen);
+    tsrb_add_one(&_rb, FRAME_DELIMITER);
+}
+
+static void *_eventloop(void *arg)
+{
+    (void)arg;
+    msg_t msg, reply;
+
+    msg_init_queue(_msg_queue, GNRC_PCAP_MSG_QUEUE_SIZE);
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                _record(msg.content.ptr);
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
+                msg_reply(&msg, &reply);
+                break;
+            case MSG_TYPE_TX_DONE:
+                break;
+            default:
+                DEBUG("gnrc_pcap: received something unexpected\n");
+                break;
+        }
+        _tx_start();
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_pcap_init(void)
+{
+    if (gnrc_pcap_pid == KERNEL_PID_UNDEF) {
+        tsrb_init(&_rb, _buf, sizeof(_buf));
+        if (GNRC_PCAP_UART != UART_STDIO_DEV) {
+            uart_init(GNRC_PCAP_UART, GNRC_PCAP_BAUDRATE, NULL, NULL);
+        }
+        gnrc_pcap_pid = thread_create(_stack, sizeof(_stack), GNRC_PCAP_PRIO,
+                                      THREAD_CREATE_STACKTEST,
+                                      _eventloop, NULL, "pcap");
+    }
+    return gnrc_pcap_pid;
+}
+
+uint32_t gnrc_pcap_dropped(void)
+{
+    return _dropped_total;
+}
@@ -0,0 +1,703 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using pools of fixed size blocks
+ *
+ * Snip descriptors, small and large data are allocated from separate pools.
+ * Free blocks of a pool are kept in a singly linked list, so allocating and
+ * releasing a block is O(1). Data pointers may point into a block (e.g. after
+ * gnrc_pktbuf_mark()), the block is found by the pointer's offset into its
+ * pool.
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(void *) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SMALL_BLOCK        _ALIGN(GNRC_PKTBUF_POOL_SMALL_SIZE)
+#define _LARGE_BLOCK        _ALIGN(GNRC_PKTBUF_POOL_LARGE_SIZE)
+
+enum {
+    _POOL_SNIP = 0,
+    _POOL_SMALL,
+    _POOL_LARGE,
+    _POOL_NUMOF
+};
+
+typedef struct _block {
+    struct _block *next;
+} _block_t;
+
+typedef struct {
+    uint8_t *buf;
+    size_t block_size;
+    unsigned numof;
+    _block_t *free;
+    unsigned free_numof;
+#ifdef DEVELHELP
+    unsigned min_free;
+#endif
+} _pool_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+static gnrc_pktsnip_t _snip_buf[GNRC_PKTBUF_POOL_SNIP_NUMOF];
+/* void * for alignment */
+static void *_small_buf[(GNRC_PKTBUF_POOL_SMALL_NUMOF * _SMALL_BLOCK) / sizeof(void *)];
+static void *_large_buf[(GNRC_PKTBUF_POOL_LARGE_NUMOF * _LARGE_BLOCK) / sizeof(void *)];
+
+static _pool_t _pools[_POOL_NUMOF] = {
+    { .buf = (uint8_t *)_snip_buf, .block_size = sizeof(gnrc_pktsnip_t),
+      .numof = GNRC_PKTBUF_POOL_SNIP_NUMOF },
+    { .buf = (uint8_t *)_small_buf, .block_size = _SMALL_BLOCK,
+      .numof = GNRC_PKTBUF_POOL_SMALL_NUMOF },
+    { .buf = (uint8_t *)_large_buf, .block_size = _LARGE_BLOCK,
+      .numof = GNRC_PKTBUF_POOL_LARGE_NUMOF },
+};
+
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+static gnrc_pktbuf_counters_t _counters;
+static gnrc_pktbuf_fail_cb_t _fail_cb;
+
+static inline void _count_used(size_t size, bool alloc)
+{
+    if (alloc) {
+        _counters.used += size;
+        if (_counters.used > _counters.peak) {
+            _counters.peak = _counters.used;
+        }
+    }
+    else {
+        _counters.used -= size;
+    }
+}
+
+static inline void _count_refs(unsigned num)
+{
+    _counters.refs += num;
+}
+
+static inline void _count_unref(void)
+{
+    _counters.unrefs++;
+}
+
+static void _count_fail(gnrc_nettype_t type, size_t size)
+{
+    _counters.fails[type - GNRC_NETTYPE_IOVEC]++;
+    if (_fail_cb) {
+        _fail_cb(type, size);
+    }
+}
+#else
+static inline void _count_used(size_t size, bool alloc)
+{
+    (void)size;
+    (void)alloc;
+}
+static inline void _count_refs(unsigned num) { (void)num; }
+static inline void _count_unref(void) { }
+static inline void _count_fail(gnrc_nettype_t type, size_t size)
+{
+    (void)type;
+    (void)size;
+}
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_data_alloc(size_t size);
+static void _data_free(void *data);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+    _count_refs(1);
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline bool _pool_contains(const _pool_t *pool, const void *ptr)
+{
+    return (size_t)((const uint8_t *)ptr - pool->buf) <
+           (pool->block_size * pool->numof);
+}
+
+/* returns the data pool @p ptr points into or NULL */
+static _pool_t *_data_pool(const void *ptr)
+{
+    for (unsigned i = _POOL_SMALL; i < _POOL_NUMOF; i++) {
+        if (_pool_contains(&_pools[i], ptr)) {
+            return &_pools[i];
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t *_block_start(const _pool_t *pool, const void *ptr)
+{
+    size_t offset = (const uint8_t *)ptr - pool->buf;
+
+    return pool->buf + (offset - (offset % pool->block_size));
+}
+
+/* number of bytes from @p ptr till the end of its block */
+static inline size_t _block_space(const _pool_t *pool, const void *ptr)
+{
+    return (_block_start(pool, ptr) + pool->block_size) - (const uint8_t *)ptr;
+}
+
+static void _pool_init(_pool_t *pool)
+{
+    pool->free = NULL;
+    for (unsigned i = pool->numof; i > 0; i--) {
+        _block_t *block = (_block_t *)(pool->buf + ((i - 1) * pool->block_size));
+        block->next = pool->free;
+        pool->free = block;
+    }
+    pool->free_numof = pool->numof;
+#ifdef DEVELHELP
+    pool->min_free = pool->numof;
+#endif
+}
+
+static void *_pool_alloc(_pool_t *pool)
+{
+    _block_t *block = pool->free;
+
+    if (block == NULL) {
+        return NULL;
+    }
+    pool->free = block->next;
+    pool->free_numof--;
+    _count_used(pool->block_size, true);
+#ifdef DEVELHELP
+    if (pool->free_numof < pool->min_free) {
+        pool->min_free = pool->free_numof;
+    }
+#endif
+    return block;
+}
+
+static void _pool_free(_pool_t *pool, void *ptr)
+{
+    _block_t *block = (_block_t *)_block_start(pool, ptr);
+
+    block->next = pool->free;
+    pool->free = block;
+    pool->free_numof++;
+    _count_used(pool->block_size, false);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _POOL_NUMOF; i++) {
+        _pool_init(&_pools[i]);
+    }
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+    memset(&_counters, 0, sizeof(_counters));
+#endif
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    mutex_lock(&_mutex);
+    if (size > GNRC_PKTBUF_POOL_LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_POOL_LARGE_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_POOL_LARGE_SIZE);
+        pkt = NULL;
+    }
+    else {
+        pkt = _create_snip(next, data, size, type);
+    }
+    if (pkt == NULL) {
+        _count_fail(type, size);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pool_alloc(&_pools[_POOL_SNIP]);
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        _count_fail(type, size);
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->size == size) {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    else {
+        /* every block must only be referenced by one snip, so copy the
+         * smaller of both parts into a new block */
+        size_t rest = pkt->size - size;
+        void *new_data = _data_alloc((size < rest) ? size : rest);
+
+        if (new_data == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pool_free(&_pools[_POOL_SNIP], marked_snip);
+            _count_fail(type, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        if (size < rest) {
+            memcpy(new_data, pkt->data, size);
+            new_data_marked = new_data;
+            pkt->data = ((uint8_t *)pkt->data) + size;
+        }
+        else {
+            memcpy(new_data, ((uint8_t *)pkt->data) + size, rest);
+            new_data_marked = pkt->data;
+            pkt->data = new_data;
+        }
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    _pool_t *pool;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _data_pool(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    pool = (pkt->data != NULL) ? _data_pool(pkt->data) : NULL;
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* data does not fit into its current block, or would waste a large one */
+    else if ((pool == NULL) || (size > _block_space(pool, pkt->data)) ||
+             ((pool == &_pools[_POOL_LARGE]) &&
+              (size <= GNRC_PKTBUF_POOL_SMALL_SIZE) &&
+              (_pools[_POOL_SMALL].free != NULL))) {
+        void *new_data = _data_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            _count_fail(pkt->type, size);
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        _data_free(pkt->data);
+        pkt->data = new_data;
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        _count_refs(num);
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pool_contains(&_pools[_POOL_SNIP], pkt));
+        tmp = pkt->next;
+        _count_unref();
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _data_free(pkt->data);
+            _pool_free(&_pools[_POOL_SNIP], pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+            _count_unref();
+        }
+        else {
+            _count_fail(pkt->type, pkt->size);
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head;
+    struct iovec *vec;
+
+    assert(len != NULL);
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of snips in the packet and allocate the IOVEC */
+    length = gnrc_pkt_count(pkt);
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    assert(head->data != NULL);
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC */
+    while (pkt != NULL) {
+        vec->iov_base = pkt->data;
+        vec->iov_len = pkt->size;
+        ++vec;
+        pkt = pkt->next;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snips", "small", "large" };
+
+    for (unsigned i = 0; i < _POOL_NUMOF; i++) {
+        printf("packet buffer %s: %u/%u blocks of %u bytes free (min: %u)\n",
+               names[i], _pools[i].free_numof, _pools[i].numof,
+               (unsigned)_pools[i].block_size, _pools[i].min_free);
+    }
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+void gnrc_pktbuf_get_counters(gnrc_pktbuf_counters_t *counters)
+{
+    mutex_lock(&_mutex);
+    if (_pools[_POOL_LARGE].free) {
+        _counters.largest_free = GNRC_PKTBUF_POOL_LARGE_SIZE;
+    }
+    else if (_pools[_POOL_SMALL].free) {
+        _counters.largest_free = GNRC_PKTBUF_POOL_SMALL_SIZE;
+    }
+    else {
+        _counters.largest_free = 0;
+    }
+    *counters = _counters;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_set_fail_cb(gnrc_pktbuf_fail_cb_t cb)
+{
+    mutex_lock(&_mutex);
+    _fail_cb = cb;
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _POOL_NUMOF; i++) {
+        if (_pools[i].free_numof != _pools[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - every block in a free list is the start of a block of its pool
+     *  - the length of a free list is the pool's free_numof <= numof
+     */
+    for (unsigned i = 0; i < _POOL_NUMOF; i++) {
+        const _pool_t *pool = &_pools[i];
+        unsigned count = 0;
+
+        for (_block_t *block = pool->free; block; block = block->next) {
+            if (!_pool_contains(pool, block) ||
+                (_block_start(pool, block) != (uint8_t *)block) ||
+                (++count > pool->numof)) {
+                return false;
+            }
+        }
+        if (count != pool->free_numof) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pool_alloc(&_pools[_POOL_SNIP]);
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pool_free(&_pools[_POOL_SNIP], pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_data_alloc(size_t size)
+{
+    void *data = NULL;
+
+    if (size <= GNRC_PKTBUF_POOL_SMALL_SIZE) {
+        data = _pool_alloc(&_pools[_POOL_SMALL]);
+    }
+    /* fall back to a large block if the small ones ran out */
+    if ((data == NULL) && (size <= GNRC_PKTBUF_POOL_LARGE_SIZE)) {
+        data = _pool_alloc(&_pools[_POOL_LARGE]);
+    }
+    if (data == NULL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+    }
+    return data;
+}
+
+static void _data_free(void *data)
+{
+    _pool_t *pool;
+
+    if ((data == NULL) || ((pool = _data_pool(data)) == NULL)) {
+        return;
+    }
+    _pool_free(pool, data);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_hdrs(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *head = gnrc_pktbuf_start_write(pkt), *tmp = head;
+
+    if (head == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* the payload snips are only read, so they can stay shared */
+    while ((tmp->next != NULL) && (tmp->next->type != GNRC_NETTYPE_UNDEF)) {
+        gnrc_pktsnip_t *next = gnrc_pktbuf_start_write(tmp->next);
+
+        if (next == NULL) {
+            gnrc_pktbuf_release(head);
+            return NULL;
+        }
+        tmp->next = next;
+        tmp = next;
+    }
+    return head;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_prepend_shared(gnrc_pktsnip_t *pkt, void *data,
+                                           size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *hdr;
+
+    gnrc_pktbuf_hold(pkt, 1);
+    hdr = gnrc_pktbuf_add(pkt, data, size, type);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return hdr;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        _count_fail(type, size);
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
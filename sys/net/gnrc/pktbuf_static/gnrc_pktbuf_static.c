@@ -50,6 +50,55 @@ static _unused_t *_first_unused;
 static uint16_t max_byte_count = 0;
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+static gnrc_pktbuf_counters_t _counters;
+static gnrc_pktbuf_fail_cb_t _fail_cb;
+
+static inline void _count_used(size_t size, bool alloc)
+{
+    if (alloc) {
+        _counters.used += size;
+        if (_counters.used > _counters.peak) {
+            _counters.peak = _counters.used;
+        }
+    }
+    else {
+        _counters.used -= size;
+    }
+}
+
+static inline void _count_refs(unsigned num)
+{
+    _counters.refs += num;
+}
+
+static inline void _count_unref(void)
+{
+    _counters.unrefs++;
+}
+
+static void _count_fail(gnrc_nettype_t type, size_t size)
+{
+    _counters.fails[type - GNRC_NETTYPE_IOVEC]++;
+    if (_fail_cb) {
+        _fail_cb(type, size);
+    }
+}
+#else
+static inline void _count_used(size_t size, bool alloc)
+{
+    (void)size;
+    (void)alloc;
+}
+static inline void _count_refs(unsigned num) { (void)num; }
+static inline void _count_unref(void) { }
+static inline void _count_fail(gnrc_nettype_t type, size_t size)
+{
+    (void)type;
+    (void)size;
+}
+#endif
+
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
                                     gnrc_nettype_t type);
@@ -67,6 +116,21 @@ static inline size_t _align(size_t size)
     return (size + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK);
 }
 
+/* rounds a pointer down to the chunk containing it */
+static inline uint8_t *_align_down(void *ptr)
+{
+    return (uint8_t *)((uintptr_t)ptr & ~((uintptr_t)_ALIGNMENT_MASK));
+}
+
+/* first byte after the chunk that holds the @p size bytes at @p data */
+static inline uint8_t *_chunk_end(void *data, size_t size)
+{
+    uint8_t *start = _align_down(data);
+    uint8_t *end = start + _align(((uint8_t *)data - start) + size);
+
+    return (end < (start + sizeof(_unused_t))) ? (start + sizeof(_unused_t)) : end;
+}
+
 static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
                                 void *data, size_t size, gnrc_nettype_t type)
 {
@@ -75,6 +139,7 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
     pkt->size = size;
     pkt->type = type;
     pkt->users = 1;
+    _count_refs(1);
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
@@ -86,6 +151,9 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+    memset(&_counters, 0, sizeof(_counters));
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -94,13 +162,18 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
 {
     gnrc_pktsnip_t *pkt;
 
+    mutex_lock(&_mutex);
     if (size > GNRC_PKTBUF_SIZE) {
         DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
               (unsigned)size, GNRC_PKTBUF_SIZE);
-        return NULL;
+        pkt = NULL;
+    }
+    else {
+        pkt = _create_snip(next, data, size, type);
+    }
+    if (pkt == NULL) {
+        _count_fail(type, size);
     }
-    mutex_lock(&_mutex);
-    pkt = _create_snip(next, data, size, type);
     mutex_unlock(&_mutex);
     return pkt;
 }
@@ -108,9 +181,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
-    /* size required for chunk */
-    size_t required_new_size = (size < sizeof(_unused_t)) ?
-                               _align(sizeof(_unused_t)) : _align(size);
+    uint8_t *split, *start, *end;
     void *new_data_marked;
 
     mutex_lock(&_mutex);
@@ -126,18 +197,50 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
+        _count_fail(type, size);
         mutex_unlock(&_mutex);
         return NULL;
     }
+    split = ((uint8_t *)pkt->data) + size;
+    start = _align_down(pkt->data);
+    end = _chunk_end(pkt->data, pkt->size);
+    if (pkt->size == size) {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    /* both parts can keep their own _unused_t marker => split in place */
+    else if ((_align_down(split) == split) &&
+             ((size_t)(split - start) >= sizeof(_unused_t)) &&
+             ((size_t)(end - split) >= sizeof(_unused_t))) {
+        new_data_marked = pkt->data;
+        pkt->data = split;
+    }
+    /* split is unaligned (e.g. a 14 byte Ethernet header), but the chunks
+     * around it are large enough => move only the marked data, the remainder
+     * stays where the driver received it */
+    else if (((size_t)(_align_down(split) - start) >= sizeof(_unused_t)) &&
+             ((size_t)(end - _align_down(split)) >= sizeof(_unused_t))) {
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _count_fail(type, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        _pktbuf_free(start, _align_down(split) - start);
+        pkt->data = split;
+    }
     /* marked data would not fit _unused_t marker => move data around to allow
      * for proper free */
-    if ((pkt->size != size) &&
-        ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t)))) {
+    else {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _count_fail(type, size);
             mutex_unlock(&_mutex);
             return NULL;
         }
@@ -146,21 +249,15 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             DEBUG("pktbuf: could not reallocate remaining section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
             _pktbuf_free(new_data_marked, size);
+            _count_fail(pkt->type, pkt->size - size);
             mutex_unlock(&_mutex);
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
-        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        memcpy(new_data_rest, split, pkt->size - size);
         _pktbuf_free(pkt->data, pkt->size);
-        marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
     }
-    else {
-        new_data_marked = pkt->data;
-        /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
-        pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
-                                          NULL;
-    }
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
     pkt->next = marked_snip;
@@ -170,8 +267,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
 
 int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 {
-    size_t aligned_size = (size < sizeof(_unused_t)) ?
-                          _align(sizeof(_unused_t)) : _align(size);
+    uint8_t *keep_end = NULL, *old_end = NULL;
 
     mutex_lock(&_mutex);
     assert(pkt != NULL);
@@ -183,6 +279,10 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         mutex_unlock(&_mutex);
         return 0;
     }
+    if (pkt->data != NULL) {
+        keep_end = _chunk_end(pkt->data, size);
+        old_end = _chunk_end(pkt->data, pkt->size);
+    }
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
@@ -191,10 +291,12 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     }
     /* if new size is bigger than old size */
     else if ((size > pkt->size) ||                          /* new size does not fit */
-        ((pkt->size - aligned_size) < sizeof(_unused_t))) { /* resulting hole would not fit marker */
+             ((keep_end < old_end) &&                       /* resulting hole would not fit marker */
+              ((size_t)(old_end - keep_end) < sizeof(_unused_t)))) {
         void *new_data = _pktbuf_alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
+            _count_fail(pkt->type, size);
             mutex_unlock(&_mutex);
             return ENOMEM;
         }
@@ -204,9 +306,8 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = new_data;
     }
-    else if (_align(pkt->size) > aligned_size) {
-        _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
-                     pkt->size - aligned_size);
+    else if (old_end > keep_end) {
+        _pktbuf_free(keep_end, old_end - keep_end);
     }
     pkt->size = size;
     mutex_unlock(&_mutex);
@@ -218,6 +319,7 @@ void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
     mutex_lock(&_mutex);
     while (pkt) {
         pkt->users += num;
+        _count_refs(num);
         pkt = pkt->next;
     }
     mutex_unlock(&_mutex);
@@ -229,6 +331,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         gnrc_pktsnip_t *tmp;
         assert(_pktbuf_contains(pkt));
         tmp = pkt->next;
+        _count_unref();
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
             _pktbuf_free(pkt->data, pkt->size);
@@ -262,6 +365,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
         if (new != NULL) {
             pkt->users--;
+            _count_unref();
+        }
+        else {
+            _count_fail(pkt->type, pkt->size);
         }
         mutex_unlock(&_mutex);
         return new;
@@ -362,6 +469,28 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+void gnrc_pktbuf_get_counters(gnrc_pktbuf_counters_t *counters)
+{
+    mutex_lock(&_mutex);
+    _counters.largest_free = 0;
+    for (_unused_t *ptr = _first_unused; ptr; ptr = ptr->next) {
+        if (ptr->size > _counters.largest_free) {
+            _counters.largest_free = ptr->size;
+        }
+    }
+    *counters = _counters;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_set_fail_cb(gnrc_pktbuf_fail_cb_t cb)
+{
+    mutex_lock(&_mutex);
+    _fail_cb = cb;
+    mutex_unlock(&_mutex);
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
@@ -439,6 +568,7 @@ static void *_pktbuf_alloc(size_t size)
         DEBUG("pktbuf: no space left in packet buffer\n");
         return NULL;
     }
+    _count_used(size, true);
     /* _unused_t struct would fit => add new space at ptr */
     if (sizeof(_unused_t) > (ptr->size - size)) {
         if (prev == NULL) { /* ptr was _first_unused */
@@ -490,17 +620,21 @@ static inline _unused_t *_merge(_unused_t *a, _unused_t *b)
 static void _pktbuf_free(void *data, size_t size)
 {
     size_t bytes_at_end;
-    _unused_t *new = (_unused_t *)data, *prev = NULL, *ptr = _first_unused;
+    _unused_t *new = (_unused_t *)_align_down(data), *prev = NULL, *ptr = _first_unused;
 
     if (!_pktbuf_contains(data)) {
         return;
     }
+    /* data may start inside its chunk after an unaligned gnrc_pktbuf_mark() */
+    size += (uint8_t *)data - (uint8_t *)new;
+    data = new;
     while (ptr && (((void *)ptr) < data)) {
         prev = ptr;
         ptr = ptr->next;
     }
     new->next = ptr;
     new->size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
+    _count_used(new->size, false);
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -556,6 +690,41 @@ gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ol
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_hdrs(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *head = gnrc_pktbuf_start_write(pkt), *tmp = head;
+
+    if (head == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* the payload snips are only read, so they can stay shared */
+    while ((tmp->next != NULL) && (tmp->next->type != GNRC_NETTYPE_UNDEF)) {
+        gnrc_pktsnip_t *next = gnrc_pktbuf_start_write(tmp->next);
+
+        if (next == NULL) {
+            gnrc_pktbuf_release(head);
+            return NULL;
+        }
+        tmp->next = next;
+        tmp = next;
+    }
+    return head;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_prepend_shared(gnrc_pktsnip_t *pkt, void *data,
+                                           size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *hdr;
+
+    gnrc_pktbuf_hold(pkt, 1);
+    hdr = gnrc_pktbuf_add(pkt, data, size, type);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return hdr;
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
 {
     mutex_lock(&_mutex);
@@ -571,6 +740,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
     gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
 
     if (new == NULL) {
+        _count_fail(type, size);
         mutex_unlock(&_mutex);
 
         return NULL;
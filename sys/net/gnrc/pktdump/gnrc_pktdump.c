@@ -146,6 +146,8 @@ static void *_eventloop(void *arg)
                 break;
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 msg_reply(&msg, &reply);
                 break;
             default:
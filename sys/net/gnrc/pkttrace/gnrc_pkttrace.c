@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pkttrace
+ * @{
+ *
+ * @file
+ * @brief       Packet latency tracing implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pkttrace.h"
+#include "xtimer.h"
+
+static gnrc_pkttrace_entry_t _log[GNRC_PKTTRACE_LOG_SIZE];
+static unsigned _log_next;  /* total number of log entries, wraps */
+static gnrc_pkttrace_stats_t _stats;
+static uint32_t _entered[GNRC_PKTTRACE_LAYER_NUMOF][GNRC_PKTTRACE_DIR_NUMOF];
+
+static unsigned _bucket(uint32_t value)
+{
+    unsigned bucket = 0;
+
+    while (value && (bucket < (GNRC_PKTTRACE_BUCKETS - 1))) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint32_t _since_rx(gnrc_pktsnip_t *pkt, uint32_t now)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_t *hdr = netif->data;
+
+        if (hdr->timestamp != 0) {
+            return now - hdr->timestamp;
+        }
+    }
+    return 0;
+}
+
+static void _log_add(gnrc_pkttrace_layer_t layer, gnrc_pkttrace_dir_t dir,
+                     gnrc_pktsnip_t *pkt, uint32_t now, bool exit)
+{
+    uint32_t since_rx = (pkt != NULL) ? _since_rx(pkt, now) : 0;
+    unsigned state = irq_disable();
+    gnrc_pkttrace_entry_t *entry = &_log[_log_next++ & (GNRC_PKTTRACE_LOG_SIZE - 1)];
+
+    entry->time = now;
+    entry->since_rx = since_rx;
+    entry->layer = layer;
+    entry->dir = dir;
+    entry->exit = exit;
+    irq_restore(state);
+}
+
+void gnrc_pkttrace_stamp(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+    if (netif != NULL) {
+        uint32_t now = xtimer_now_usec();
+
+        /* 0 marks "no timestamp" */
+        ((gnrc_netif_hdr_t *)netif->data)->timestamp = (now != 0) ? now : 1;
+    }
+}
+
+void gnrc_pkttrace_enter(gnrc_pkttrace_layer_t layer, gnrc_pkttrace_dir_t dir,
+                         gnrc_pktsnip_t *pkt)
+{
+    uint32_t now = xtimer_now_usec();
+
+    _entered[layer][dir] = now;
+    _log_add(layer, dir, pkt, now, false);
+}
+
+void gnrc_pkttrace_exit(gnrc_pkttrace_layer_t layer, gnrc_pkttrace_dir_t dir,
+                        gnrc_pktsnip_t *pkt)
+{
+    uint32_t now = xtimer_now_usec();
+    uint32_t time = now - _entered[layer][dir];
+    unsigned state = irq_disable();
+
+    _stats.hist[layer][dir][_bucket(time)]++;
+    if (time > _stats.max[layer][dir]) {
+        _stats.max[layer][dir] = time;
+    }
+    irq_restore(state);
+    _log_add(layer, dir, pkt, now, true);
+}
+
+unsigned gnrc_pkttrace_get_log(gnrc_pkttrace_entry_t *log, unsigned numof)
+{
+    unsigned state = irq_disable();
+    unsigned avail = (_log_next < GNRC_PKTTRACE_LOG_SIZE) ?
+                     _log_next : GNRC_PKTTRACE_LOG_SIZE;
+    unsigned start;
+
+    if (numof > avail) {
+        numof = avail;
+    }
+    /* copy the newest numof entries */
+    start = _log_next - numof;
+    for (unsigned i = 0; i < numof; i++) {
+        log[i] = _log[(start + i) & (GNRC_PKTTRACE_LOG_SIZE - 1)];
+    }
+    irq_restore(state);
+    return numof;
+}
+
+void gnrc_pkttrace_get_stats(gnrc_pkttrace_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    *stats = _stats;
+    irq_restore(state);
+}
+
+void gnrc_pkttrace_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(&_stats, 0, sizeof(_stats));
+    _log_next = 0;
+    irq_restore(state);
+}
@@ -19,6 +19,7 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc.h"
 #include "mutex.h"
+#include "random.h"
 
 #include "net/gnrc/rpl.h"
 #ifdef MODULE_GNRC_RPL_P2P
@@ -39,6 +40,8 @@ static msg_t _msg_q[GNRC_RPL_MSG_QUEUE_SIZE];
 static gnrc_netreg_entry_t _me_reg;
 static mutex_t _inst_id_mutex = MUTEX_INIT;
 static uint8_t _instance_id;
+static uint16_t _density_time;     /* seconds into the current period of
+                                    * GNRC_RPL_DIO_DENSITY_PERIOD */
 
 gnrc_rpl_instance_t gnrc_rpl_instances[GNRC_RPL_INSTANCES_NUMOF];
 gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
@@ -231,6 +234,8 @@ static void *_event_loop(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 DEBUG("RPL: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
@@ -247,6 +252,7 @@ void _update_lifetime(void)
 {
     gnrc_rpl_parent_t *parent;
     gnrc_rpl_instance_t *inst;
+    bool density_age = false;
 
     for (uint8_t i = 0; i < GNRC_RPL_PARENTS_NUMOF; ++i) {
         parent = &gnrc_rpl_parents[i];
@@ -265,9 +271,18 @@ void _update_lifetime(void)
         }
     }
 
+    _density_time += GNRC_RPL_LIFETIME_UPDATE_STEP;
+    if (_density_time >= GNRC_RPL_DIO_DENSITY_PERIOD) {
+        _density_time = 0;
+        density_age = true;
+    }
+
     for (int i = 0; i < GNRC_RPL_INSTANCES_NUMOF; ++i) {
         inst = &gnrc_rpl_instances[i];
         if (inst->state != 0) {
+            if (density_age) {
+                gnrc_rpl_dio_senders_age(&inst->dodag);
+            }
             if ((inst->cleanup > 0) && (inst->dodag.parents == NULL) &&
                 (inst->dodag.my_rank == GNRC_RPL_INFINITE_RANK)) {
                 inst->cleanup -= GNRC_RPL_LIFETIME_UPDATE_STEP;
@@ -294,18 +309,39 @@ void _update_lifetime(void)
     xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 }
 
+/* adds up to @p jitter seconds to @p time */
+static inline uint8_t _dao_jitter(uint8_t time, uint8_t jitter)
+{
+    return time + random_uint32_range(0, jitter + 1);
+}
+
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
-    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    if (!dodag->dao_ack_received && (dodag->dao_counter > 0)) {
+        /* the DAO sent last still waits for its DAO-ACK */
+        dodag->dao_pending = true;
+        return;
+    }
+    if (!dodag->dao_ack_received &&
+        (dodag->dao_time <= (GNRC_RPL_DEFAULT_DAO_DELAY + GNRC_RPL_DAO_DELAY_JITTER))) {
+        /* already scheduled: aggregate */
+        return;
+    }
+    dodag->dao_time = _dao_jitter(GNRC_RPL_DEFAULT_DAO_DELAY, GNRC_RPL_DAO_DELAY_JITTER);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_pending = false;
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
-    dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
+    /* the refreshes of the nodes would stay synchronous after a global
+     * repair otherwise */
+    dodag->dao_time = _dao_jitter(GNRC_RPL_REGULAR_DAO_INTERVAL,
+                                  GNRC_RPL_REGULAR_DAO_INTERVAL / 4);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_pending = false;
 }
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
@@ -316,9 +352,15 @@ void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
     }
 #endif
     if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
+        /* the DAO includes everything scheduled meanwhile */
+        uint8_t wait = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK << dodag->dao_counter;
+
         dodag->dao_counter++;
+        dodag->dao_pending = false;
         gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
-        dodag->dao_time = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+        /* back off exponentially: the DAO-ACK is missing most likely because
+         * the links towards the root are busy */
+        dodag->dao_time = _dao_jitter(wait, wait / 2);
     }
     else if (dodag->dao_ack_received == false) {
         gnrc_rpl_long_delay_dao(dodag);
@@ -32,6 +32,10 @@
 #include "gnrc_rpl_internal/validation.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -306,6 +310,49 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
+/* in non-storing mode the root stores the parent address of the transit option
+ * for all targets it belongs to */
+static void _parse_transit_non_storing(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                                       gnrc_rpl_opt_transit_t *transit)
+{
+#ifdef MODULE_GNRC_RPL_SRH
+    ipv6_addr_t parent, ll_parent;
+    bool root;
+    uint32_t lifetime = transit->path_lifetime * dodag->lifetime_unit;
+
+    if ((dodag->node_status != GNRC_RPL_ROOT_NODE) ||
+        (transit->length < (GNRC_RPL_OPT_TRANSIT_INFO_LEN + sizeof(ipv6_addr_t)))) {
+        DEBUG("RPL: no parent address in RPL TRANSIT DAO option for me\n");
+        return;
+    }
+    memcpy(&parent, transit + 1, sizeof(ipv6_addr_t));
+    /* the nodes derive the address of their parent from its link-local
+     * address, which might not be one of mine for the DODAG prefix */
+    ll_parent = parent;
+    ipv6_addr_set_link_local_prefix(&ll_parent);
+    root = (gnrc_ipv6_netif_find_by_addr(NULL, &parent) != KERNEL_PID_UNDEF) ||
+           (gnrc_ipv6_netif_find_by_addr(NULL, &ll_parent) != KERNEL_PID_UNDEF);
+
+    do {
+        DEBUG("RPL: source route to %s/%d over %s\n",
+              ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
+              target->prefix_length, root ? "me" : "parent");
+
+        if (gnrc_rpl_srh_table_add(&target->target, root ? NULL : &parent, lifetime) < 0) {
+            DEBUG("RPL: no space left in source route table\n");
+        }
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (target)) +
+                 sizeof(gnrc_rpl_opt_t) + target->length);
+    }
+    while (target->type == GNRC_RPL_OPT_TARGET);
+#else
+    (void)dodag;
+    (void)target;
+    (void)transit;
+    DEBUG("RPL: non-storing mode needs gnrc_rpl_srh to store downward routes\n");
+#endif
+}
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -361,7 +408,7 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 dodag->lifetime_unit = byteorder_ntohs(dc->lifetime_unit);
                 dodag->trickle.Imin = (1 << dodag->dio_min);
                 dodag->trickle.Imax = dodag->dio_interval_doubl;
-                dodag->trickle.k = dodag->dio_redun;
+                gnrc_rpl_dio_redundancy_update(dodag);
                 break;
 
             case (GNRC_RPL_OPT_PREFIX_INFO):
@@ -393,6 +440,11 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     first_target = target;
                 }
 
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+                    /* routes are stored with the following transit option */
+                    break;
+                }
+
                 uint32_t fib_dst_flags = 0;
 
                 if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
@@ -421,6 +473,12 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+                    _parse_transit_non_storing(dodag, first_target, transit);
+                    first_target = NULL;
+                    break;
+                }
+
                 do {
                     DEBUG("RPL: updating fib entry %s/%d\n",
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
@@ -554,6 +612,7 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
         trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_MSG,
                       (1 << dodag->dio_min), dodag->dio_interval_doubl,
                       dodag->dio_redun);
+        gnrc_rpl_dio_sender_add(dodag, src);
 
         gnrc_rpl_parent_update(dodag, parent);
         return;
@@ -587,6 +646,8 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     }
 #endif
 
+    gnrc_rpl_dio_sender_add(dodag, src);
+
     if (GNRC_RPL_COUNTER_GREATER_THAN(dio->version_number, dodag->version)) {
         if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
             dodag->version = GNRC_RPL_COUNTER_INCREMENT(dio->version_number);
@@ -676,11 +737,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent != NULL) ? sizeof(ipv6_addr_t) : 0;
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -689,11 +752,15 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit = opt_snip->data;
     transit->type = GNRC_RPL_OPT_TRANSIT;
     transit->length = sizeof(transit->e_flags) + sizeof(transit->path_control) +
-                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime);
+                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime) +
+                      parent_len;
     transit->e_flags = (external) << GNRC_RPL_OPT_TRANSIT_E_FLAG_SHIFT;
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent != NULL) {
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
@@ -718,13 +785,15 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
 #endif
 
-    if (destination == NULL) {
+    if ((destination == NULL) || (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE)) {
         if (dodag->parents == NULL) {
             DEBUG("RPL: dodag has no preferred parent\n");
             return;
         }
 
-        destination = &(dodag->parents->addr);
+        /* in non-storing mode DAOs go directly to the root */
+        destination = (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) ?
+                      &dodag->dodag_id : &(dodag->parents->addr);
     }
 
     gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
@@ -739,60 +808,76 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         return;
     }
 
-    mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        /* only the own address is announced, with the global address of the
+         * parent derived from its link-local one */
+        ipv6_addr_t parent = *me;
 
-    /* add external and RPL FIB entries */
-    for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
-        fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
-        if (fentry->lifetime != 0) {
-            if (!(fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE)) {
-                ptr = &tmp;
-                if (!ext_processed) {
-                    DEBUG("RPL: Send DAO - building external transit\n");
-                    if ((tmp = _dao_transit_build(NULL, lifetime, true)) == NULL) {
-                        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                        return;
+        memcpy(&parent.u8[8], &dodag->parents->addr.u8[8], sizeof(eui64_t));
+        DEBUG("RPL: Send DAO - building transit with parent %s\n",
+              ipv6_addr_to_str(addr_str, &parent, sizeof(addr_str)));
+        if ((pkt = _dao_transit_build(NULL, lifetime, false, &parent)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return;
+        }
+    }
+    else {
+        mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
+
+        /* add external and RPL FIB entries */
+        for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
+            fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
+            if (fentry->lifetime != 0) {
+                if (!(fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE)) {
+                    ptr = &tmp;
+                    if (!ext_processed) {
+                        DEBUG("RPL: Send DAO - building external transit\n");
+                        if ((tmp = _dao_transit_build(NULL, lifetime, true, NULL)) == NULL) {
+                            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+                            mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+                            return;
+                        }
+                        ext_processed = true;
                     }
-                    ext_processed = true;
                 }
-            }
-            else {
-                ptr = &pkt;
-                if (!int_processed) {
-                    DEBUG("RPL: Send DAO - building internal transit\n");
-                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
+                else {
+                    ptr = &pkt;
+                    if (!int_processed) {
+                        DEBUG("RPL: Send DAO - building internal transit\n");
+                        tr_int = pkt = _dao_transit_build(NULL, lifetime, false, NULL);
+                        if (tr_int == NULL) {
+                            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+                            mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+                            return;
+                        }
+                        int_processed = true;
+                    }
+                }
+                ipv6_addr_t *addr = (ipv6_addr_t *) fentry->global->address;
+                if (ipv6_addr_is_global(addr)) {
+                    size_t prefix_length = (fentry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT);
+
+                    DEBUG("RPL: Send DAO - building target %s/%d\n",
+                          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
+                          (int) prefix_length);
+
+                    if ((*ptr = _dao_target_build(*ptr, addr, (uint8_t) prefix_length)) == NULL) {
                         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                         mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                         return;
                     }
-                    int_processed = true;
-                }
-            }
-            ipv6_addr_t *addr = (ipv6_addr_t *) fentry->global->address;
-            if (ipv6_addr_is_global(addr)) {
-                size_t prefix_length = (fentry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT);
-
-                DEBUG("RPL: Send DAO - building target %s/%d\n",
-                      ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
-                      (int) prefix_length);
-
-                if ((*ptr = _dao_target_build(*ptr, addr, (uint8_t) prefix_length)) == NULL) {
-                    DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                    return;
                 }
             }
         }
-    }
 
-    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
 
-    if (tr_int) {
-        tr_int->next = tmp;
-    }
-    else {
-        pkt = tmp;
+        if (tr_int) {
+            tr_int->next = tmp;
+        }
+        else {
+            pkt = tmp;
+        }
     }
 
     /* add own address */
@@ -1014,6 +1099,11 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
     }
 
     dodag->dao_ack_received = true;
+    if (dodag->dao_pending) {
+        /* send the DAO scheduled while waiting for this DAO-ACK */
+        gnrc_rpl_delay_dao(dodag);
+        return;
+    }
     gnrc_rpl_long_delay_dao(dodag);
 }
 
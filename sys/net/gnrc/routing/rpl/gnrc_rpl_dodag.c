@@ -16,6 +16,8 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
+#include "bitarithm.h"
 #include "net/af.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -24,6 +26,9 @@
 #include "utlist.h"
 
 #include "net/gnrc/rpl.h"
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -38,6 +43,39 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag);
 
+/* fires the trickle timers of the other instances on the interface of inst
+ * that are due soon, so their DIOs are sent along with the one of inst */
+static void _batch_dios(gnrc_rpl_instance_t *inst)
+{
+#if GNRC_RPL_DIO_BATCH_DIVISOR
+    for (uint8_t i = 0; i < GNRC_RPL_INSTANCES_NUMOF; ++i) {
+        gnrc_rpl_instance_t *other = &gnrc_rpl_instances[i];
+        trickle_t *trickle = &other->dodag.trickle;
+        uint32_t left;
+
+        if ((other == inst) || (other->state == 0) ||
+            (other->dodag.iface != inst->dodag.iface) ||
+            (trickle->callback.func == NULL)) {
+            continue;
+        }
+        /* a due timer has its message queued already and a suppressed one
+         * would not send anything. The timers fired here are not due in the
+         * nested calls anymore, since their next one is at least half an
+         * interval away */
+        left = trickle_time_left(trickle);
+        if ((left == 0) || (left > (trickle->I / GNRC_RPL_DIO_BATCH_DIVISOR)) ||
+            ((trickle->k != 0) && (trickle->c >= trickle->k))) {
+            continue;
+        }
+        DEBUG("RPL: send DIO of instance %d %" PRIu32 " ms early\n", other->id, left);
+        trickle_stop(trickle);
+        trickle_callback(trickle);
+    }
+#else
+    (void) inst;
+#endif
+}
+
 static void _rpl_trickle_send_dio(void *args)
 {
     gnrc_rpl_instance_t *inst = (gnrc_rpl_instance_t *) args;
@@ -62,6 +100,7 @@ static void _rpl_trickle_send_dio(void *args)
     gnrc_rpl_send_DIO(inst, (ipv6_addr_t *) &ipv6_addr_all_rpl_nodes);
     DEBUG("trickle callback: Instance (%d) | DODAG: (%s)\n", inst->id,
           ipv6_addr_to_str(addr_str,&dodag->dodag_id, sizeof(addr_str)));
+    _batch_dios(inst);
 }
 
 bool gnrc_rpl_instance_add(uint8_t instance_id, gnrc_rpl_instance_t **inst)
@@ -114,6 +153,12 @@ bool gnrc_rpl_instance_remove(gnrc_rpl_instance_t *inst)
     gnrc_rpl_p2p_ext_remove(dodag);
 #endif
     gnrc_rpl_dodag_remove_all_parents(dodag);
+#ifdef MODULE_GNRC_RPL_SRH
+    if ((dodag->node_status == GNRC_RPL_ROOT_NODE) &&
+        (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE)) {
+        gnrc_rpl_srh_table_flush();
+    }
+#endif
     trickle_stop(&dodag->trickle);
     memset(inst, 0, sizeof(gnrc_rpl_instance_t));
     return true;
@@ -326,6 +371,10 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
             gnrc_rpl_send_DAO(dodag->instance, &old_best->addr, 0);
             gnrc_rpl_delay_dao(dodag);
         }
+        /* in non-storing mode the root learns the new parent with the next DAO */
+        else if (dodag->instance->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+            gnrc_rpl_delay_dao(dodag);
+        }
 
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
@@ -432,6 +481,49 @@ void gnrc_rpl_router_operation(gnrc_rpl_dodag_t *dodag)
     /* announce presence to neighborhood */
     trickle_reset_timer(&dodag->trickle);
 }
+
+void gnrc_rpl_dio_sender_add(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *src)
+{
+    uint8_t hash = 0;
+
+    /* of the interface identifier */
+    for (unsigned i = 8; i < sizeof(ipv6_addr_t); i++) {
+        hash = (hash * 31) + src->u8[i];
+    }
+    hash &= 63;
+    dodag->dio_senders[0][hash / 32] |= ((uint32_t)1) << (hash % 32);
+    gnrc_rpl_dio_redundancy_update(dodag);
+}
+
+void gnrc_rpl_dio_senders_age(gnrc_rpl_dodag_t *dodag)
+{
+    memcpy(dodag->dio_senders[1], dodag->dio_senders[0], sizeof(dodag->dio_senders[0]));
+    memset(dodag->dio_senders[0], 0, sizeof(dodag->dio_senders[0]));
+    gnrc_rpl_dio_redundancy_update(dodag);
+}
+
+void gnrc_rpl_dio_redundancy_update(gnrc_rpl_dodag_t *dodag)
+{
+    unsigned neighbors = 0, k = dodag->dio_redun;
+
+    /* collisions in the filter make this an underestimate for large
+     * neighborhoods, which is fine to decide on the redundancy */
+    for (unsigned i = 0; i < 2; i++) {
+        neighbors += bitarithm_bits_set(dodag->dio_senders[0][i] |
+                                        dodag->dio_senders[1][i]);
+    }
+    /* k == 0 is infinity (RFC 6206, section 6.5) */
+    if ((k > GNRC_RPL_DIO_REDUNDANCY_MIN) && (neighbors > GNRC_RPL_DIO_DENSITY_REF)) {
+        k = (k * GNRC_RPL_DIO_DENSITY_REF) / neighbors;
+        if (k < GNRC_RPL_DIO_REDUNDANCY_MIN) {
+            k = GNRC_RPL_DIO_REDUNDANCY_MIN;
+        }
+    }
+    if (k != dodag->trickle.k) {
+        DEBUG("RPL: DIO redundancy constant %u for about %u neighbors\n", k, neighbors);
+        dodag->trickle.k = k;
+    }
+}
 /**
  * @}
  */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_mrhof
+ * @{
+ *
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function with ETX
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <string.h>
+
+#include "net/eui64.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define ETX_DIVISOR     (128U)      /* of the link metric, RFC 6551 */
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+/* the table of a device never moves, so it is only asked for once per
+ * interface */
+static kernel_pid_t _table_iface = KERNEL_PID_UNDEF;
+static netstats_nb_table_t *_table;
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+static netstats_nb_table_t *_get_table(kernel_pid_t iface)
+{
+    if (iface != _table_iface) {
+        _table_iface = iface;
+        if (gnrc_netapi_get(iface, NETOPT_STATS_NEIGHBOR, 0, &_table,
+                            sizeof(_table)) != sizeof(_table)) {
+            DEBUG("RPL MRHOF: no link statistics on interface %" PRIkernel_pid "\n",
+                  iface);
+            _table = NULL;
+        }
+    }
+    return _table;
+}
+
+static const netstats_nb_t *_get_nb(gnrc_rpl_parent_t *parent)
+{
+    netstats_nb_table_t *table = _get_table(parent->dodag->iface);
+    gnrc_ipv6_nc_t *nc;
+    uint8_t l2addr[sizeof(eui64_t)];
+
+    if (table == NULL) {
+        return NULL;
+    }
+    nc = gnrc_ipv6_nc_get(parent->dodag->iface, &parent->addr);
+    if ((nc != NULL) && (nc->l2_addr_len > 0) &&
+        (gnrc_ipv6_nc_get_type(nc) != GNRC_IPV6_NC_TYPE_TENTATIVE)) {
+        return netstats_nb_get(table, nc->l2_addr, nc->l2_addr_len);
+    }
+    /* 6LoWPAN sends to link-local addresses without neighbor cache entry
+     * to the EUI-64 in their IID */
+    memcpy(l2addr, &parent->addr.u8[8], sizeof(l2addr));
+    l2addr[0] ^= 0x02;
+    return netstats_nb_get(table, l2addr, sizeof(l2addr));
+}
+
+/* ETX of the link to parent in units of 1/ETX_DIVISOR */
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+    const netstats_nb_t *nb = _get_nb(parent);
+    uint16_t etx = (nb != NULL) ? nb->etx : NETSTATS_NB_ETX_INIT;
+
+    return (uint16_t)(((uint32_t)etx * ETX_DIVISOR) / NETSTATS_NB_ETX_DIVISOR);
+}
+
+static uint16_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    uint16_t metric = _link_metric(parent);
+    uint32_t cost = (uint32_t)parent->rank + metric;
+
+    if ((metric > GNRC_RPL_MRHOF_MAX_LINK_METRIC) ||
+        (cost > GNRC_RPL_MRHOF_MAX_PATH_COST)) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    return (uint16_t)cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void) dodag;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint32_t rank, min_rank;
+    uint16_t metric;
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    if (parent == NULL) {
+        /* no link to measure */
+        rank = (uint32_t)base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+        return (rank < GNRC_RPL_INFINITE_RANK) ? rank : GNRC_RPL_INFINITE_RANK;
+    }
+
+    metric = _link_metric(parent);
+    if (metric > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    rank = (uint32_t)base_rank + metric;
+    /* RFC 6550, section 3.5.1: a rank increase is at least MinHopRankIncrease */
+    min_rank = (uint32_t)base_rank + parent->dodag->instance->min_hop_rank_inc;
+    if (rank < min_rank) {
+        rank = min_rank;
+    }
+    if ((rank > GNRC_RPL_MRHOF_MAX_PATH_COST) || (rank > GNRC_RPL_INFINITE_RANK)) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return rank;
+}
+
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t cost1 = _path_cost(p1);
+    uint32_t cost2 = _path_cost(p2);
+
+    /* RFC 6719, section 3.2.2: only switch away from the preferred parent for a
+     * considerably better path */
+    if (p1 == p1->dodag->parents) {
+        return ((cost2 + GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) < cost1) ? p2 : p1;
+    }
+    if (p2 == p2->dodag->parents) {
+        return ((cost1 + GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) < cost2) ? p1 : p2;
+    }
+
+    return (cost1 <= cost2) ? p1 : p2;
+}
+
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
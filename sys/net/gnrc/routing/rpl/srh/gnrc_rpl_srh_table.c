@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Source route table of a DODAG root in non-storing mode
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/srh.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+#define PREFIX_LEN      (8U)            /* bytes of the address in _prefixes */
+#define PARENT_ROOT     (UINT16_MAX)
+#define PARENT_NONE     (UINT16_MAX - 1)
+
+#define GNRC_RPL_SRH_COMPR(I, E)    (((I) << 4) | (E))
+#define GNRC_RPL_SRH_PAD(X)         ((X) << 4)
+
+typedef struct {
+    uint8_t iid[sizeof(ipv6_addr_t) - PREFIX_LEN];  /* interface identifier */
+    uint32_t expires;   /* time in seconds, 0 marks unused entries */
+    uint16_t parent;    /* index of the DAO parent, PARENT_ROOT or PARENT_NONE */
+    uint8_t prefix;     /* index into _prefixes */
+} _node_t;
+
+static _node_t _nodes[GNRC_RPL_SRH_TABLE_SIZE];
+static uint8_t _prefixes[GNRC_RPL_SRH_TABLE_PREFIX_NUMOF][PREFIX_LEN];
+static uint16_t _prefix_refs[GNRC_RPL_SRH_TABLE_PREFIX_NUMOF];
+static mutex_t _mutex = MUTEX_INIT;     /* the table is filled by the RPL
+                                         * thread and read by the IPv6 thread */
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _valid(const _node_t *node, uint32_t now)
+{
+    return (node->expires != 0) && ((int32_t)(node->expires - now) > 0);
+}
+
+static void _addr(unsigned idx, ipv6_addr_t *addr)
+{
+    memcpy(addr->u8, _prefixes[_nodes[idx].prefix], PREFIX_LEN);
+    memcpy(&addr->u8[PREFIX_LEN], _nodes[idx].iid, sizeof(_nodes[idx].iid));
+}
+
+static int _find(const ipv6_addr_t *addr, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_SIZE; i++) {
+        _node_t *node = &_nodes[i];
+
+        if (_valid(node, now) &&
+            (memcmp(node->iid, &addr->u8[PREFIX_LEN], sizeof(node->iid)) == 0) &&
+            (memcmp(_prefixes[node->prefix], addr->u8, PREFIX_LEN) == 0)) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+static void _release(unsigned idx)
+{
+    _node_t *node = &_nodes[idx];
+
+    if (node->expires == 0) {
+        return;
+    }
+    /* the slot may be reused for another node, so its children must not
+     * point to it anymore */
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_SIZE; i++) {
+        if (_nodes[i].parent == idx) {
+            _nodes[i].parent = PARENT_NONE;
+        }
+    }
+    _prefix_refs[node->prefix]--;
+    node->expires = 0;
+}
+
+static void _purge(uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_SIZE; i++) {
+        if (!_valid(&_nodes[i], now)) {
+            _release(i);
+        }
+    }
+}
+
+static int _prefix_get(const ipv6_addr_t *addr)
+{
+    int free = -ENOMEM;
+
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_PREFIX_NUMOF; i++) {
+        if (_prefix_refs[i] == 0) {
+            free = i;
+        }
+        else if (memcmp(_prefixes[i], addr->u8, PREFIX_LEN) == 0) {
+            return i;
+        }
+    }
+    if (free >= 0) {
+        memcpy(_prefixes[free], addr->u8, PREFIX_LEN);
+    }
+    return free;
+}
+
+static int _alloc(const ipv6_addr_t *addr, uint32_t expires)
+{
+    int prefix = _prefix_get(addr);
+
+    if (prefix < 0) {
+        DEBUG("RPL SRH: no space left for prefix of %s\n",
+              ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+        return prefix;
+    }
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_SIZE; i++) {
+        _node_t *node = &_nodes[i];
+
+        if (node->expires == 0) {
+            memcpy(node->iid, &addr->u8[PREFIX_LEN], sizeof(node->iid));
+            node->expires = expires;
+            node->parent = PARENT_NONE;
+            node->prefix = prefix;
+            _prefix_refs[prefix]++;
+            return i;
+        }
+    }
+    DEBUG("RPL SRH: no space left for %s\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+    return -ENOMEM;
+}
+
+static int _get_or_alloc(const ipv6_addr_t *addr, uint32_t now, uint32_t expires)
+{
+    int idx = _find(addr, now);
+
+    if (idx < 0) {
+        idx = _alloc(addr, expires);
+    }
+    if (idx == -ENOMEM) {
+        _purge(now);
+        idx = _alloc(addr, expires);
+    }
+    return idx;
+}
+
+int gnrc_rpl_srh_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                           uint32_t lifetime)
+{
+    uint32_t now = _now();
+    uint32_t expires = now + lifetime;
+    int idx, parent_idx = PARENT_ROOT;
+
+    if (lifetime == 0) {
+        gnrc_rpl_srh_table_remove(target);
+        return 0;
+    }
+    if (expires == 0) {
+        expires++;
+    }
+    mutex_lock(&_mutex);
+    if ((idx = _get_or_alloc(target, now, expires)) < 0) {
+        mutex_unlock(&_mutex);
+        return idx;
+    }
+    if ((parent != NULL) &&
+        ((parent_idx = _get_or_alloc(parent, now, expires)) < 0)) {
+        mutex_unlock(&_mutex);
+        return parent_idx;
+    }
+    DEBUG("RPL SRH: parent of %s is %s\n",
+          ipv6_addr_to_str(addr_str, target, sizeof(addr_str)),
+          (parent != NULL) ? "set" : "the root");
+    _nodes[idx].parent = parent_idx;
+    _nodes[idx].expires = expires;
+    if ((parent != NULL) && (_nodes[parent_idx].parent == PARENT_NONE)) {
+        /* keep the parent known for as long as its child */
+        _nodes[parent_idx].expires = expires;
+    }
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_rpl_srh_table_remove(const ipv6_addr_t *target)
+{
+    int idx;
+
+    mutex_lock(&_mutex);
+    if ((idx = _find(target, _now())) >= 0) {
+        DEBUG("RPL SRH: remove %s\n",
+              ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+        _release(idx);
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_srh_table_flush(void)
+{
+    mutex_lock(&_mutex);
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_prefix_refs, 0, sizeof(_prefix_refs));
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_rpl_srh_build(const ipv6_addr_t *dst, ipv6_addr_t *first_hop)
+{
+    uint16_t path[GNRC_RPL_SRH_MAX_HOPS + 1];
+    uint32_t now = _now();
+    gnrc_pktsnip_t *pkt;
+    gnrc_rpl_srh_t *srh;
+    uint8_t *vec;
+    unsigned hops = 0, compr = sizeof(ipv6_addr_t) - 1, addr_len, pad;
+    int idx;
+
+    mutex_lock(&_mutex);
+    if ((idx = _find(dst, now)) < 0) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* follow the parents up to the root: path[0] is dst, the last one the
+     * first hop */
+    while (idx != PARENT_ROOT) {
+        if ((idx == PARENT_NONE) || !_valid(&_nodes[idx], now) ||
+            (hops > GNRC_RPL_SRH_MAX_HOPS)) {
+            DEBUG("RPL SRH: no path to %s\n",
+                  ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        path[hops++] = idx;
+        idx = _nodes[idx].parent;
+    }
+    _addr(path[--hops], first_hop);
+    if (hops == 0) {
+        /* child of the root: no source routing header needed */
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* the addresses are reconstructed from the one of the previous hop, so
+     * only the prefix all of them share with the first hop can be elided */
+    for (unsigned i = 0; i < hops; i++) {
+        ipv6_addr_t addr;
+        unsigned match;
+
+        _addr(path[i], &addr);
+        match = ipv6_addr_match_prefix(first_hop, &addr) / 8;
+        if (match < compr) {
+            compr = match;
+        }
+    }
+    addr_len = sizeof(ipv6_addr_t) - compr;
+    pad = (8 - ((hops * addr_len) % 8)) % 8;
+#ifdef MODULE_GNRC_IPV6_EXT
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(gnrc_rpl_srh_t) + (hops * addr_len) + pad,
+                          GNRC_NETTYPE_IPV6_EXT);
+#else
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(gnrc_rpl_srh_t) + (hops * addr_len) + pad,
+                          GNRC_NETTYPE_UNDEF);
+#endif
+    if (pkt == NULL) {
+        DEBUG("RPL SRH: no space left in packet buffer\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    srh = pkt->data;
+    vec = (uint8_t *)(srh + 1);
+    srh->nh = PROTNUM_RESERVED;
+    srh->len = ((hops * addr_len) + pad) / 8;
+    srh->type = GNRC_RPL_SRH_TYPE;
+    srh->seg_left = hops;
+    srh->compr = GNRC_RPL_SRH_COMPR(compr, compr);
+    srh->pad_resv = GNRC_RPL_SRH_PAD(pad);
+    srh->resv = 0;
+    /* the hops after the first one in sending order, dst last */
+    for (unsigned i = 0; i < hops; i++) {
+        ipv6_addr_t addr;
+
+        _addr(path[hops - 1 - i], &addr);
+        memcpy(&vec[i * addr_len], &addr.u8[compr], addr_len);
+    }
+    memset(&vec[hops * addr_len], 0, pad);
+    mutex_unlock(&_mutex);
+    DEBUG("RPL SRH: %u hops to %s\n", hops + 1,
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    return pkt;
+}
+
+/** @} */
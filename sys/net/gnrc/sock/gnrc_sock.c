@@ -20,6 +20,8 @@
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/udp.h"
 #include "utlist.h"
 #include "xtimer.h"
@@ -44,10 +46,92 @@ static void _callback_put(void *arg)
 }
 #endif
 
+static bool _netreg_full(void *ctx)
+{
+    gnrc_sock_reg_t *reg = ctx;
+
+    if ((reg->policy == GNRC_SOCK_DROP_OLDEST) || !mbox_full(&reg->mbox)) {
+        reg->full_reported = false;
+        return false;
+    }
+    /* the packet is shed or dropped by _netapi_cb(), account it only once */
+    reg->drops++;
+    reg->full_reported = true;
+    return true;
+}
+
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+    gnrc_sock_reg_t *reg = ctx;
+    bool reported = reg->full_reported;
+
+    reg->full_reported = false;
+    if (cmd != GNRC_NETAPI_MSG_TYPE_RCV) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        msg_t old;
+
+        if (reg->policy == GNRC_SOCK_DROP_NEWEST) {
+            if (!reported) {
+                reg->drops++;
+            }
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        /* make room by dropping the oldest packet */
+        if (mbox_try_get(&reg->mbox, &old) &&
+            (old.type == GNRC_NETAPI_MSG_TYPE_RCV)) {
+            gnrc_pktbuf_release(old.content.ptr);
+            reg->drops++;
+        }
+        if (mbox_try_put(&reg->mbox, &msg) < 1) {
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+#ifdef MODULE_SOCK_ASYNC
+    /* reg is the first member of all sock types */
+    if (reg->type == GNRC_NETTYPE_IPV6) {
+        if (reg->async_cb.ip != NULL) {
+            reg->async_cb.ip((sock_ip_t *)reg, SOCK_ASYNC_MSG_RECV,
+                             reg->async_cb_arg);
+        }
+    }
+    else if (reg->async_cb.udp != NULL) {
+        reg->async_cb.udp((sock_udp_t *)reg, SOCK_ASYNC_MSG_RECV,
+                          reg->async_cb_arg);
+    }
+#endif
+}
+
+void gnrc_sock_init(gnrc_sock_reg_t *reg, const gnrc_sock_queue_t *queue)
+{
+    if ((queue != NULL) && (queue->queue != NULL)) {
+        mbox_init(&reg->mbox, queue->queue, queue->size);
+    }
+    else {
+        mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+    }
+    reg->policy = (queue != NULL) ? queue->policy : GNRC_SOCK_DROP_NEWEST;
+    reg->drops = 0;
+    reg->full_reported = false;
+#ifdef MODULE_SOCK_ASYNC
+    reg->async_cb.udp = NULL;
+#endif
+}
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
-    gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    reg->netreg_cb.full = _netreg_full;
+#ifdef MODULE_SOCK_ASYNC
+    reg->type = type;
+#endif
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
     gnrc_netreg_register(type, &reg->entry);
 }
 
@@ -80,6 +164,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
             pkt = msg.content.ptr;
+            gnrc_pkttrace_enter(GNRC_PKTTRACE_SOCK, GNRC_PKTTRACE_RX, pkt);
             break;
 #ifdef MODULE_XTIMER
         case _TIMEOUT_MSG_TYPE:
@@ -108,6 +193,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         remote->netif = (uint16_t)netif_hdr->if_pid;
     }
     *pkt_out = pkt; /* set out parameter */
+    gnrc_pkttrace_exit(GNRC_PKTTRACE_SOCK, GNRC_PKTTRACE_RX, pkt);
     return 0;
 }
 
@@ -119,6 +205,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
     gnrc_nettype_t type;
     size_t payload_len = gnrc_pkt_len(payload);
 
+    gnrc_pkttrace_enter(GNRC_PKTTRACE_SOCK, GNRC_PKTTRACE_TX, payload);
     if (local->family != remote->family) {
         gnrc_pktbuf_release(payload);
         return -EAFNOSUPPORT;
@@ -177,6 +264,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         gnrc_pktbuf_release(pkt);
         return -EBADMSG;
     }
+    gnrc_pkttrace_exit(GNRC_PKTTRACE_SOCK, GNRC_PKTTRACE_TX, NULL);
 #ifdef MODULE_GNRC_NETERR
     msg_t err_report;
     err_report.type = 0;
@@ -96,6 +96,12 @@ static inline bool gnrc_ep_addr_any(const sock_ip_ep_t *ep)
     return true;
 }
 
+/**
+ * @brief   Initialize the queue of a sock internally
+ * @internal
+ */
+void gnrc_sock_init(gnrc_sock_reg_t *reg, const gnrc_sock_queue_t *queue);
+
 /**
  * @brief   Create a sock internally
  * @internal
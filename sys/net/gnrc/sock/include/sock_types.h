@@ -40,6 +40,29 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+/**
+ * @brief   What to drop when the queue of a sock is full
+ */
+typedef enum {
+    GNRC_SOCK_DROP_NEWEST = 0,          /**< drop the newly received packet */
+    GNRC_SOCK_DROP_OLDEST,              /**< drop the oldest queued packet */
+} gnrc_sock_drop_t;
+
+/**
+ * @brief   Queue configuration for gnrc_sock_udp_create() and
+ *          gnrc_sock_ip_create()
+ */
+typedef struct {
+    /**
+     * @brief   Message queue for received packets, NULL for the built-in queue
+     *          of @ref SOCK_MBOX_SIZE messages
+     */
+    msg_t *queue;
+    unsigned size;                      /**< size of gnrc_sock_queue_t::queue,
+                                         *   must be a power of 2 */
+    gnrc_sock_drop_t policy;            /**< drop policy */
+} gnrc_sock_queue_t;
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
@@ -49,8 +72,25 @@ typedef struct gnrc_sock_reg {
     struct gnrc_sock_reg *next;         /**< list-like for internal storage */
 #endif
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
+    gnrc_netreg_entry_cbd_t netreg_cb;  /**< netapi callback that fills
+                                         *   gnrc_sock_reg_t::mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
-    msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+    msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< built-in queue for gnrc_sock_reg_t::mbox */
+    uint32_t drops;                     /**< packets dropped for the sock */
+    uint8_t policy;                     /**< @ref gnrc_sock_drop_t */
+    bool full_reported;                 /**< the last packet was already
+                                         *   accounted as dropped */
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   Event callback of the sock
+     */
+    union {
+        sock_ip_cb_t ip;                /**< callback of a raw IP sock */
+        sock_udp_cb_t udp;              /**< callback of a UDP sock */
+    } async_cb;
+    void *async_cb_arg;                 /**< argument for gnrc_sock_reg_t::async_cb */
+    gnrc_nettype_t type;                /**< type the sock is registered for */
+#endif
 } gnrc_sock_reg_t;
 
 /**
@@ -75,6 +115,74 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+/**
+ * @brief   Creates a new raw IPv4/IPv6 sock object with its own queue
+ *
+ * Same as @ref sock_ip_create(), but with the queue of received packets
+ * configured by @p queue.
+ *
+ * @param[out] sock     The resulting sock object.
+ * @param[in] local     Local end point for the sock object.
+ * @param[in] remote    Remote end point for the sock object.
+ * @param[in] proto     Protocol to use in the raw IPv4/IPv6 sock object.
+ * @param[in] flags     Flags for the sock object. See also @ref net_sock_flags.
+ * @param[in] queue     Queue configuration, NULL for the built-in queue
+ *                      dropping the newest packets.
+ *
+ * @return  The same as @ref sock_ip_create().
+ */
+int gnrc_sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
+                        const sock_ip_ep_t *remote, uint8_t proto,
+                        uint16_t flags, const gnrc_sock_queue_t *queue);
+
+/**
+ * @brief   Creates a new UDP sock object with its own queue
+ *
+ * Same as @ref sock_udp_create(), but with the queue of received packets
+ * configured by @p queue.
+ *
+ * @param[out] sock     The resulting sock object.
+ * @param[in] local     Local end point for the sock object.
+ * @param[in] remote    Remote end point for the sock object.
+ * @param[in] flags     Flags for the sock object. See also @ref net_sock_flags.
+ * @param[in] queue     Queue configuration, NULL for the built-in queue
+ *                      dropping the newest packets.
+ *
+ * @return  The same as @ref sock_udp_create().
+ */
+int gnrc_sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
+                         const sock_udp_ep_t *remote, uint16_t flags,
+                         const gnrc_sock_queue_t *queue);
+
+/**
+ * @brief   Returns the number of packets dropped for a raw IPv4/IPv6 sock
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ *
+ * @return  Number of packets dropped since the sock was created, because its
+ *          queue was full.
+ */
+static inline uint32_t gnrc_sock_ip_get_drops(const sock_ip_t *sock)
+{
+    return sock->reg.drops;
+}
+
+/**
+ * @brief   Returns the number of packets dropped for a UDP sock
+ *
+ * Packets shed by @ref net_gnrc_udp before they reached the full sock are
+ * included.
+ *
+ * @param[in] sock  A UDP sock object.
+ *
+ * @return  Number of packets dropped since the sock was created, because its
+ *          queue was full.
+ */
+static inline uint32_t gnrc_sock_udp_get_drops(const sock_udp_t *sock)
+{
+    return sock->reg.drops;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,13 @@
 
 int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
                    const sock_ip_ep_t *remote, uint8_t proto, uint16_t flags)
+{
+    return gnrc_sock_ip_create(sock, local, remote, proto, flags, NULL);
+}
+
+int gnrc_sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
+                        const sock_ip_ep_t *remote, uint8_t proto,
+                        uint16_t flags, const gnrc_sock_queue_t *queue)
 {
     assert(sock);
     if ((local != NULL) && (remote != NULL) &&
@@ -36,6 +43,7 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+    gnrc_sock_init(&sock->reg, queue);
     memset(&sock->local, 0, sizeof(sock_ip_ep_t));
     if (local != NULL) {
         if (gnrc_af_not_supported(local->family)) {
@@ -196,4 +204,13 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb_arg = cb_arg;
+    sock->reg.async_cb.ip = cb;
+}
+#endif
+
 /** @} */
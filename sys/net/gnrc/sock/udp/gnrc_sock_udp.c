@@ -16,6 +16,7 @@
  */
 
 #include <errno.h>
+#include <sys/uio.h>
 
 #include "byteorder.h"
 #include "net/af.h"
@@ -85,6 +86,13 @@ static uint16_t _get_dyn_port(sock_udp_t *sock)
 
 int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
                     const sock_udp_ep_t *remote, uint16_t flags)
+{
+    return gnrc_sock_udp_create(sock, local, remote, flags, NULL);
+}
+
+int gnrc_sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
+                         const sock_udp_ep_t *remote, uint16_t flags,
+                         const gnrc_sock_queue_t *queue)
 {
     assert(sock);
     assert(local == NULL || local->port != 0);
@@ -95,6 +103,7 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+    gnrc_sock_init(&sock->reg, queue);
     memset(&sock->local, 0, sizeof(sock_udp_ep_t));
     if (local != NULL) {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
@@ -165,15 +174,21 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a UDP packet and checks it against the remote of @p sock
+ *
+ * @return  The payload size on success, @p pkt_out is then set to the
+ *          received packet and has to be released by the caller.
+ * @return  Negative errno on error, see @ref sock_udp_recv()
+ */
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -182,10 +197,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -204,22 +215,65 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    *pkt_out = pkt;
+    return (ssize_t)pkt->size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (pkt->size > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
     memcpy(data, pkt->data, pkt->size);
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_ip_ep_t *rem;
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the application is done with the lent packet */
+        gnrc_pktbuf_release(*buf_ctx);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    /* the payload of a received packet is always the first snip, so it is
+     * contiguous and can be handed out as is */
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return res;
+}
 
+/**
+ * @brief   Checks the end points for sending and binds @p sock if required
+ *
+ * @return  0 on success, negative errno on error, see @ref sock_udp_send()
+ */
+static int _send_prepare(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                         sock_ip_ep_t *local, sock_ip_ep_t **rem,
+                         uint16_t *src_port, uint16_t *dst_port)
+{
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -247,20 +301,20 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     /* cppcheck-suppress nullPointer */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(sock_ip_ep_t));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EINVAL;
         }
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -269,27 +323,61 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(sock_ip_ep_t));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        *rem = (sock_ip_ep_t *)&sock->remote;
+        *dst_port = sock->remote.port;
     }
     else {
-        rem = (sock_ip_ep_t *)remote;
-        dst_port = remote->port;
+        *rem = (sock_ip_ep_t *)remote;
+        *dst_port = remote->port;
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = (*rem)->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != (*rem)->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    return 0;
+}
+
+/**
+ * @brief   Builds the payload snip of a datagram from @p vector
+ */
+static gnrc_pktsnip_t *_build_payload(const struct iovec *vector,
+                                      unsigned count)
+{
+    gnrc_pktsnip_t *payload;
+    size_t len = 0;
+    uint8_t *ptr;
+
+    for (unsigned i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    /* copy the segments straight into the packet buffer */
+    ptr = payload->data;
+    for (unsigned i = 0; i < count; i++) {
+        assert((vector[i].iov_len == 0) || (vector[i].iov_base != NULL));
+        memcpy(ptr, vector[i].iov_base, vector[i].iov_len);
+        ptr += vector[i].iov_len;
+    }
+    return payload;
+}
+
+static ssize_t _send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
+                     sock_ip_ep_t *rem, uint16_t src_port, uint16_t dst_port)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
     if (payload == NULL) {
         return -ENOMEM;
     }
@@ -298,11 +386,77 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+    int res;
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    res = _send_prepare(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    /* generate payload and header snips */
+    return _send(gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF),
+                 &local, rem, src_port, dst_port);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const struct iovec *vector,
+                       unsigned count, const sock_udp_ep_t *remote)
+{
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+    int res;
+
+    assert((count == 0) || (vector != NULL));
+
+    res = _send_prepare(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    return _send(_build_payload(vector, count), &local, rem, src_port,
+                 dst_port);
+}
+
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned numof)
+{
+    unsigned sent;
+
+    assert((numof == 0) || (msgs != NULL));
+
+    for (sent = 0; sent < numof; sent++) {
+        const sock_udp_msg_t *msg = &msgs[sent];
+        ssize_t res = sock_udp_sendv(sock, msg->vector, msg->count,
+                                     msg->remote);
+
+        if (res < 0) {
+            /* only report the error if nothing was sent at all */
+            return (sent == 0) ? (int)res : (int)sent;
+        }
+    }
+    return (int)sent;
+}
+
+#ifdef MODULE_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb_arg = cb_arg;
+    sock->reg.async_cb.udp = cb;
+}
+#endif
+
 /** @} */
@@ -18,6 +18,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include <utlist.h>
 #include "net/af.h"
 #include "net/gnrc/tcp.h"
@@ -59,6 +60,11 @@ gnrc_tcp_tcb_t *_list_tcb_head;
  */
 mutex_t _list_tcb_lock;
 
+/**
+ * @brief Hash buckets of TCBs with a known peer.
+ */
+gnrc_tcp_tcb_t *_hash_tcb[GNRC_TCP_TCB_HASH_SIZE];
+
 /**
  * @brief Helper struct, holding all argument data for_cb_mbox_put_msg.
  */
@@ -208,6 +214,71 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
     return ret;
 }
 
+/**
+ * @brief Puts a TCB of a listen queue into LISTEN state, without waiting for a connection.
+ *
+ * @note Reinitializes @p tcb, so its function lock must not be held.
+ *
+ * @param[in,out] tcb     TCB of @p queue.
+ * @param[in]     queue   Listen queue holding local address and port.
+ *
+ * @returns   Zero on success.
+ *            Negative value on error.
+ */
+static int _listen(gnrc_tcp_tcb_t *tcb, gnrc_tcp_tcb_queue_t *queue)
+{
+    gnrc_tcp_tcb_init(tcb);
+    tcb->queue = queue;
+    tcb->status |= STATUS_PASSIVE;
+#ifdef MODULE_GNRC_IPV6
+    if (ipv6_addr_is_unspecified((ipv6_addr_t *) queue->local_addr)) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+    else {
+        memcpy(tcb->local_addr, queue->local_addr, sizeof(ipv6_addr_t));
+    }
+#else
+    tcb->status |= STATUS_ALLOW_ANY_ADDR;
+#endif
+    tcb->local_port = queue->local_port;
+    return _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+}
+
+/**
+ * @brief Takes an established, not yet accepted connection from a listen queue.
+ *
+ * TCBs whose connection was closed before it was accepted listen again.
+ *
+ * @param[in,out] queue   Listen queue to search.
+ * @param[out]    tcb     TCB of the accepted connection.
+ *
+ * @returns   Zero if a connection was accepted.
+ *            -EAGAIN if there is no established connection.
+ */
+static int _accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb)
+{
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *iter = &queue->tcbs[i];
+        bool closed = false;
+
+        mutex_lock(&(iter->fsm_lock));
+        if (!(iter->status & STATUS_ACCEPTED)) {
+            if (iter->state == FSM_STATE_ESTABLISHED || iter->state == FSM_STATE_CLOSE_WAIT) {
+                iter->status |= STATUS_ACCEPTED;
+                mutex_unlock(&(iter->fsm_lock));
+                *tcb = iter;
+                return 0;
+            }
+            closed = (iter->state == FSM_STATE_CLOSED);
+        }
+        mutex_unlock(&(iter->fsm_lock));
+        if (closed) {
+            _listen(iter, queue);
+        }
+    }
+    return -EAGAIN;
+}
+
 /* External GNRC TCP API */
 int gnrc_tcp_init(void)
 {
@@ -221,6 +292,7 @@ int gnrc_tcp_init(void)
 
     /* Initialize TCB list */
     _list_tcb_head = NULL;
+    memset(_hash_tcb, 0, sizeof(_hash_tcb));
     _rcvbuf_init();
 
     /* Start TCP processing thread */
@@ -240,6 +312,7 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->flags = GNRC_TCP_FLAGS_DEFAULT;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
@@ -294,6 +367,121 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    /* Setup listen queue */
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+#ifdef MODULE_GNRC_IPV6
+    if (local_addr != NULL) {
+        memcpy(queue->local_addr, local_addr, sizeof(ipv6_addr_t));
+    }
+    else {
+        ipv6_addr_set_unspecified((ipv6_addr_t *) queue->local_addr);
+    }
+#endif
+    queue->local_port = local_port;
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+
+    /* Let every TCB of the pool listen */
+    for (size_t i = 0; i < tcbs_len; i++) {
+        int ret = _listen(&tcbs[i], queue);
+
+        if (ret < 0) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_listen() : Can't listen with TCB %u\n", (unsigned) i);
+            queue->tcbs_len = i;
+            gnrc_tcp_stop_listen(queue);
+            return ret;
+        }
+    }
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = 0;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* Queue is not listening: Return -EINVAL */
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox, established connections are found by _accept() */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+    }
+
+    /* Wait until a connection was established or the timeout fired */
+    while ((ret = _accept(queue, tcb)) == -EAGAIN && timeout_duration_us > 0) {
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &queue->tcbs[i];
+
+        /* Detach it first, so it doesn't listen again when aborted */
+        tcb->queue = NULL;
+        if (!(tcb->status & STATUS_ACCEPTED)) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -336,8 +524,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent, acknowledgment is handled by the retransmit queue */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -359,6 +547,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         /* Try to send data in case there nothing has been sent and we are not probing */
         if (ret == 0 && !probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret != 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -525,6 +716,9 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
+        if (tcb->queue != NULL) {
+            _listen(tcb, tcb->queue);
+        }
         return;
     }
 
@@ -564,6 +758,11 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
+
+    /* Connections of a listen queue are returned into the pool */
+    if (tcb->queue != NULL) {
+        _listen(tcb, tcb->queue);
+    }
 }
 
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
@@ -577,6 +776,11 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
     mutex_unlock(&(tcb->function_lock));
+
+    /* Connections of a listen queue are returned into the pool */
+    if (tcb->queue != NULL) {
+        _listen(tcb, tcb->queue);
+    }
 }
 
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
@@ -65,6 +65,58 @@ static int _send(gnrc_pktsnip_t *pkt)
     return 0;
 }
 
+#ifdef MODULE_GNRC_IPV6
+/**
+ * @brief Finds a listening TCB for an incoming connection request.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in] dst        Destination port of the request.
+ * @param[in] dst_addr   Destination address of the request.
+ *
+ * @returns   Listening TCB or NULL if nobody listens on @p dst.
+ */
+static gnrc_tcp_tcb_t *_find_listener(uint16_t dst, ipv6_addr_t *dst_addr)
+{
+    for (gnrc_tcp_tcb_t *tcb = _list_tcb_head; tcb != NULL; tcb = tcb->next) {
+        /* The local address must be unspecified or the requested one */
+        if (tcb->address_family == AF_INET6 && tcb->local_port == dst &&
+            tcb->state == FSM_STATE_LISTEN &&
+            (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, dst_addr) ||
+             ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr))) {
+            return tcb;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Looks up the TCB of a connection by its 4-tuple.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in] local_port   Local port of the connection.
+ * @param[in] peer_port    Peer port of the connection.
+ * @param[in] peer_addr    Peer address of the connection.
+ *
+ * @returns   TCB of the connection or NULL if there is none.
+ */
+static gnrc_tcp_tcb_t *_find_connection(uint16_t local_port, uint16_t peer_port,
+                                        ipv6_addr_t *peer_addr)
+{
+    unsigned bucket = _tcb_hash(local_port, peer_port, peer_addr->u8, sizeof(ipv6_addr_t));
+
+    for (gnrc_tcp_tcb_t *tcb = _hash_tcb[bucket]; tcb != NULL; tcb = tcb->hash_next) {
+        if (tcb->address_family == AF_INET6 && tcb->local_port == local_port &&
+            tcb->peer_port == peer_port &&
+            ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, peer_addr)) {
+            return tcb;
+        }
+    }
+    return NULL;
+}
+#endif
+
 /**
  * @brief Receive function, receive packet from network layer.
  *
@@ -155,39 +207,22 @@ static int _receive(gnrc_pktsnip_t *pkt)
 
     /* Find TCB to for this packet */
     mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
 #ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
+    if (ip->type == GNRC_NETTYPE_IPV6) {
+        /* If SYN is set, a connection is listening on that port, else it is connected */
+        if (syn) {
+            tcb = _find_listener(dst, &((ipv6_hdr_t *)ip->data)->dst);
+        }
+        else {
+            tcb = _find_connection(dst, src, &((ipv6_hdr_t *)ip->data)->src);
         }
+    }
 #else
-        /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
+    /* Supress compiler warnings if TCP is build without network layer */
+    (void) syn;
+    (void) src;
+    (void) dst;
 #endif
-        tcb = tcb->next;
-    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
@@ -246,6 +281,8 @@ void *_event_loop(__attribute__((unused)) void *arg)
             /* Reply to option set and set messages*/
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 msg_reply(&msg, &reply);
                 break;
 
@@ -256,6 +293,13 @@ void *_event_loop(__attribute__((unused)) void *arg)
                      NULL, NULL, 0);
                 break;
 
+            /* Delayed ACK timer expired: Call FSM with delayed ACK event */
+            case MSG_TYPE_DELAYED_ACK:
+                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : MSG_TYPE_DELAYED_ACK\n");
+                _fsm((gnrc_tcp_tcb_t *)msg.content.ptr, FSM_EVENT_TIMEOUT_DELAYED_ACK,
+                     NULL, NULL, 0);
+                break;
+
             /* Timewait timer expired: Call FSM with timewait event */
             case MSG_TYPE_TIMEWAIT:
                 DEBUG("gnrc_tcp_eventloop.c : _event_loop() : MSG_TYPE_TIMEWAIT\n");
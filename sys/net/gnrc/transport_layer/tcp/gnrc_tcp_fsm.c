@@ -17,8 +17,10 @@
  * @}
  */
 
+#include <string.h>
 #include "random.h"
 #include "net/af.h"
+#include "net/gnrc/pktbuf.h"
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
@@ -27,6 +29,7 @@
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dst_cache.h"
 #endif
 
 #define ENABLE_DEBUG (0)
@@ -54,6 +57,60 @@ static int _is_local_port_in_use(const uint16_t port_number)
     return (iter != NULL);
 }
 
+/**
+ * @brief Calculates the hash bucket of a TCB.
+ *
+ * @param[in] tcb   TCB with a known peer.
+ *
+ * @returns   Index into _hash_tcb.
+ */
+static unsigned _hash_of(const gnrc_tcp_tcb_t *tcb)
+{
+#ifdef MODULE_GNRC_IPV6
+    return _tcb_hash(tcb->local_port, tcb->peer_port, tcb->peer_addr, sizeof(tcb->peer_addr));
+#else
+    return _tcb_hash(tcb->local_port, tcb->peer_port, NULL, 0);
+#endif
+}
+
+/**
+ * @brief Adds a TCB to its hash bucket, if it is not already in there.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in,out] tcb   TCB with a known peer.
+ */
+static void _hash_add(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_t **bucket = &_hash_tcb[_hash_of(tcb)];
+
+    for (gnrc_tcp_tcb_t *iter = *bucket; iter != NULL; iter = iter->hash_next) {
+        if (iter == tcb) {
+            return;
+        }
+    }
+    LL_PREPEND2(*bucket, tcb, hash_next);
+}
+
+/**
+ * @brief Removes a TCB from its hash bucket, if it is in there.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in,out] tcb   TCB that should be removed.
+ */
+static void _hash_del(gnrc_tcp_tcb_t *tcb)
+{
+    for (gnrc_tcp_tcb_t **iter = &_hash_tcb[_hash_of(tcb)]; *iter != NULL;
+         iter = &((*iter)->hash_next)) {
+        if (*iter == tcb) {
+            *iter = tcb->hash_next;
+            tcb->hash_next = NULL;
+            return;
+        }
+    }
+}
+
 /**
  * @brief Generate random unused local port above the well-known ports (> 1024).
  *
@@ -80,14 +137,188 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->pkt_retransmit_numof > 0) {
+        for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+            tcb->pkt_retransmit[i] = NULL;
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->pkt_retransmit_numof = 0;
     }
+    tcb->pkt_sacked = 0;
+    tcb->pkt_resent = 0;
     return 0;
 }
 
+/**
+ * @brief Sender maximum segment size used for congestion control.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The SMSS in bytes.
+ */
+static uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->mss == 0 || tcb->mss > GNRC_TCP_MSS) {
+        return GNRC_TCP_MSS;
+    }
+    return tcb->mss;
+}
+
+/**
+ * @brief Initializes congestion control of a new connection (see RFC 5681, section 3.1).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    /* ssthresh starts with the largest possible advertised window */
+    tcb->ssthresh = UINT16_MAX;
+    tcb->recover = tcb->iss;
+    tcb->dup_acks = 0;
+    tcb->status &= ~(STATUS_FAST_RECOVERY | STATUS_RTO_RECOVERY);
+}
+
+/**
+ * @brief Reduces ssthresh after a loss, see RFC 5681, equation (4).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cc_reduce_ssthresh(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+    uint32_t smss = _smss(tcb);
+
+    tcb->ssthresh = ((flight_size / 2) > (2 * smss)) ? (flight_size / 2) : (2 * smss);
+}
+
+/**
+ * @brief Congestion control for an ACK of new data.
+ *
+ * Grows cwnd with slow start or congestion avoidance (see RFC 5681) and
+ * handles partial and full ACKs during loss recovery (see RFC 6582).
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     seg_ack   Acknowledgment number of the ACK.
+ * @param[in]     acked     Number of newly acknowledged bytes.
+ */
+static void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t seg_ack, uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+    bool full_ack = LSS_32_BIT(tcb->recover, seg_ack);
+
+    tcb->dup_acks = 0;
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        if (full_ack) {
+            /* Deflate the window and leave fast recovery */
+            uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+
+            flight_size = ((flight_size > smss) ? flight_size : smss) + smss;
+            tcb->cwnd = (tcb->ssthresh < flight_size) ? tcb->ssthresh : flight_size;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+        }
+        else {
+            /* Partial ACK: the next segment was lost as well */
+            _pkt_retransmit(tcb);
+            tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+            if (tcb->cwnd < smss) {
+                tcb->cwnd = smss;
+            }
+        }
+        return;
+    }
+    if (tcb->status & STATUS_RTO_RECOVERY) {
+        if (full_ack) {
+            tcb->status &= ~STATUS_RTO_RECOVERY;
+        }
+        else {
+            /* Everything that was in flight at the timeout is likely lost */
+            _pkt_retransmit(tcb);
+        }
+    }
+    if (tcb->cwnd < tcb->ssthresh) {
+        /* Slow start */
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    else {
+        /* Congestion avoidance */
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+}
+
+/**
+ * @brief Congestion control for a duplicate ACK.
+ *
+ * Triggers fast retransmit and fast recovery (see RFC 5681 and RFC 6582).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Every duplicate ACK means a segment left the network */
+        tcb->cwnd += smss;
+        /* SACK information may have revealed further holes */
+        _pkt_retransmit(tcb);
+        return;
+    }
+    if (++tcb->dup_acks != GNRC_TCP_DUP_ACK_THRESHOLD) {
+        return;
+    }
+    /* Don't start a new recovery for losses of the previous window */
+    if (!LSS_32_BIT(tcb->recover, tcb->snd_una - 1)) {
+        return;
+    }
+    DEBUG("gnrc_tcp_fsm.c : _cc_dup_ack() : Fast retransmit\n");
+    _cc_reduce_ssthresh(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->pkt_resent = 0;
+    _pkt_retransmit(tcb);
+    tcb->cwnd = tcb->ssthresh + (GNRC_TCP_DUP_ACK_THRESHOLD * smss);
+    tcb->status &= ~STATUS_RTO_RECOVERY;
+    tcb->status |= STATUS_FAST_RECOVERY;
+}
+
+/**
+ * @brief Congestion control for a retransmission timeout (see RFC 5681 and RFC 6582).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* ssthresh is kept if a retransmission is lost again */
+    if (tcb->retries == 0) {
+        _cc_reduce_ssthresh(tcb);
+    }
+    tcb->cwnd = _smss(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->dup_acks = 0;
+    /* The peer may have discarded selectively acknowledged data (see RFC 2018) */
+    tcb->pkt_sacked = 0;
+    tcb->pkt_resent = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->status |= STATUS_RTO_RECOVERY;
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -104,6 +335,21 @@ static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief Starts the delayed ACK timer, if it is not already running.
+ *
+ * @param[in,out] tcb   TCB holding the timer struct.
+ */
+static void _start_delack_timer(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->delack == 1) {
+        tcb->msg_delack.type = MSG_TYPE_DELAYED_ACK;
+        tcb->msg_delack.content.ptr = (void *)tcb;
+        xtimer_set_msg(&tcb->tim_delack, GNRC_TCP_DELAYED_ACK_TIMEOUT, &tcb->msg_delack,
+                       gnrc_tcp_pid);
+    }
+}
+
 /**
  * @brief Transition from current FSM state into another state.
  *
@@ -120,12 +366,19 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue, pending ACKs and held back data */
             _clear_retransmit(tcb);
+            xtimer_remove(&tcb->tim_delack);
+            tcb->delack = 0;
+            if (tcb->pkt_nagle != NULL) {
+                gnrc_pktbuf_release(tcb->pkt_nagle);
+                tcb->pkt_nagle = NULL;
+            }
 
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
             LL_DELETE(_list_tcb_head, tcb);
+            _hash_del(tcb);
             mutex_unlock(&_list_tcb_lock);
 
             /* Free potencially allocated receive buffer */
@@ -134,6 +387,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_LISTEN:
+            /* The peer is unknown again */
+            mutex_lock(&_list_tcb_lock);
+            _hash_del(tcb);
+            mutex_unlock(&_list_tcb_lock);
+
             /* Clear address info */
 #ifdef MODULE_GNRC_IPV6
             if (tcb->address_family == AF_INET6) {
@@ -145,10 +403,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* Receive buffers are claimed by incoming connections, not by listeners */
+            _rcvbuf_release_buffer(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -185,11 +441,28 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
                 }
                 LL_PREPEND(_list_tcb_head, tcb);
             }
+            _hash_add(tcb);
+            mutex_unlock(&_list_tcb_lock);
+            break;
+
+        case FSM_STATE_SYN_RCVD:
+            /* Allocate receive buffer, if this was a listening connection */
+            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                return -ENOMEM;
+            }
+
+            /* The peer is known now: make the connection reachable by its 4-tuple */
+            mutex_lock(&_list_tcb_lock);
+            _hash_add(tcb);
             mutex_unlock(&_list_tcb_lock);
             break;
 
         case FSM_STATE_ESTABLISHED:
         case FSM_STATE_CLOSE_WAIT:
+            /* Connection was just synchronized: Start congestion control */
+            if (tcb->state == FSM_STATE_SYN_SENT || tcb->state == FSM_STATE_SYN_RCVD) {
+                _cc_init(tcb);
+            }
             tcb->status |= STATUS_NOTIFY_USER;
             break;
 
@@ -232,6 +505,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
         tcb->iss = random_uint32();
         tcb->snd_nxt = tcb->iss;
         tcb->snd_una = tcb->iss;
+        tcb->options = 0;
 
         /* Transition FSM to SYN_SENT */
         ret = _transition_to(tcb, FSM_STATE_SYN_SENT);
@@ -250,6 +524,71 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     return ret;
 }
 
+/**
+ * @brief Largest payload of a segment to the peer.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Payload size of a full-sized segment in bytes.
+ */
+static size_t _full_seg_size(const gnrc_tcp_tcb_t *tcb)
+{
+    size_t payload = (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+
+    /* MSS doesn't cover options (see RFC 6691) */
+    if ((tcb->options & OPTION_TIMESTAMP) && payload > tcb->mss - OPTION_WORDS_TIMESTAMP * 4) {
+        payload = tcb->mss - OPTION_WORDS_TIMESTAMP * 4;
+    }
+#if defined(MODULE_GNRC_IPV6) && defined(MODULE_GNRC_IPV6_DST_CACHE)
+    if (tcb->address_family == AF_INET6) {
+        /* don't get fragmented on the path to the peer */
+        size_t pmss = gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF,
+                                                   (ipv6_addr_t *)tcb->peer_addr) -
+                      sizeof(ipv6_hdr_t) - sizeof(tcp_hdr_t) -
+                      ((tcb->options & OPTION_TIMESTAMP) ? OPTION_WORDS_TIMESTAMP * 4 : 0);
+
+        payload = (payload < pmss) ? payload : pmss;
+    }
+#endif
+    return payload;
+}
+
+/**
+ * @brief Sends the data held back by Nagle's algorithm as one segment.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     force   Send even if the windows are closed.
+ *
+ * @returns   Zero on success.
+ *            -EAGAIN if the windows are closed or the retransmit queue is full.
+ *            -ENOMEM if the segment could not be allocated.
+ */
+static int _nagle_flush(gnrc_tcp_tcb_t *tcb, bool force)
+{
+    gnrc_pktsnip_t *out_pkt = NULL;
+    uint16_t seq_con = 0;
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+    uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+
+    if (tcb->pkt_nagle == NULL) {
+        return 0;
+    }
+    /* Keep a retransmit slot for the FIN, unless this is the last data before it */
+    if ((tcb->pkt_retransmit_numof + (force ? 0U : 1U)) >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE ||
+        (!force && (flight_size + tcb->pkt_nagle->size) > wnd)) {
+        return -EAGAIN;
+    }
+    if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                   tcb->pkt_nagle->data, tcb->pkt_nagle->size) < 0) {
+        return -ENOMEM;
+    }
+    gnrc_pktbuf_release(tcb->pkt_nagle);
+    tcb->pkt_nagle = NULL;
+    _pkt_setup_retransmit(tcb, out_pkt, false);
+    _pkt_send(tcb, out_pkt, seq_con, false);
+    return 0;
+}
+
 /**
  * @brief FSM Handling function for sending data.
  *
@@ -263,24 +602,68 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    size_t full = _full_seg_size(tcb);
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+
+    /* Held back data leaves first: fill it up to a full segment */
+    if (tcb->pkt_nagle != NULL) {
+        size_t held = tcb->pkt_nagle->size;
+
+        sent = (held < full) ? full - held : 0;
+        sent = (sent < len) ? sent : len;
+        if (sent > 0) {
+            if (gnrc_pktbuf_realloc_data(tcb->pkt_nagle, held + sent) != 0) {
+                return 0;
+            }
+            memcpy((uint8_t *)tcb->pkt_nagle->data + held, buf, sent);
+        }
+        /* Send it, once it is full or nothing is in flight anymore */
+        if (tcb->pkt_nagle->size >= full || tcb->snd_nxt == tcb->snd_una) {
+            _nagle_flush(tcb, false);
+        }
+        if (tcb->pkt_nagle != NULL) {
+            return sent;
+        }
+    }
+
+    /* Send segments while the windows are open, keep a retransmit slot for the FIN */
+    while (sent < len && (tcb->pkt_retransmit_numof + 1U) < GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+
+        /* Nagle: don't send a small segment while data is in flight (see RFC 896) */
+        if ((tcb->flags & GNRC_TCP_FLAG_NAGLE) && flight_size > 0 && (len - sent) < full) {
+            tcb->pkt_nagle = gnrc_pktbuf_add(NULL, (uint8_t *)buf + sent, len - sent,
+                                             GNRC_NETTYPE_UNDEF);
+            if (tcb->pkt_nagle != NULL) {
+                sent = len;
+            }
+            break;
+        }
+        if (flight_size >= wnd) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd - flight_size;
+        payload = (payload < full) ? payload : full;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+        if (payload == 0) {
+            break;
+        }
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -330,6 +713,11 @@ static int _fsm_call_close(gnrc_tcp_tcb_t *tcb)
     if (tcb->state == FSM_STATE_SYN_RCVD || tcb->state == FSM_STATE_ESTABLISHED ||
         tcb->state == FSM_STATE_CLOSE_WAIT) {
 
+        /* Held back data must precede the FIN */
+        if (_nagle_flush(tcb, true) < 0) {
+            DEBUG("gnrc_tcp_fsm.c : _fsm_call_close() : Held back data was lost\n");
+        }
+
         /* Send FIN packet */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
@@ -417,6 +805,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The timestamp of a SYN is echoed right away */
+    if ((ctl & MSK_SYN) && (tcb->options & OPTION_TIMESTAMP)) {
+        tcb->ts_recent = tcb->ts_val;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -489,11 +882,17 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
 
-            /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
+            /* T: LISTEN -> SYN_RCVD, drop the SYN if there is no receive buffer left */
+            if (_transition_to(tcb, FSM_STATE_SYN_RCVD) == -ENOMEM) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Out of receive buffers\n");
+                _transition_to(tcb, FSM_STATE_LISTEN);
+                return 0;
+            }
+
+            /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt */
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
             _pkt_setup_retransmit(tcb, out_pkt, false);
             _pkt_send(tcb, out_pkt, seq_con, false);
-            _transition_to(tcb, FSM_STATE_SYN_RCVD);
         }
         return 0;
     }
@@ -569,6 +968,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             }
             return 0;
         }
+        /* Remember the timestamp to echo (see RFC 7323, section 4.3) */
+        if ((tcb->options & OPTION_TIMESTAMP) && (tcb->options & OPTION_TS_RCVD) &&
+            LEQ_32_BIT(tcb->ts_recent, tcb->ts_val) && LEQ_32_BIT(seg_seq, tcb->rcv_nxt)) {
+            tcb->ts_recent = tcb->ts_val;
+        }
         /* 2) Check RST: If RST is set ... */
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
@@ -614,8 +1018,23 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, seg_ack, acked);
+
+                    /* Everything was acknowledged: held back data may leave now */
+                    if (tcb->pkt_nagle != NULL && (tcb->snd_una == tcb->snd_nxt ||
+                                                   tcb->pkt_nagle->size >= _full_seg_size(tcb))) {
+                        _nagle_flush(tcb, false);
+                    }
+                }
+                /* Duplicate ACK: Peer received a segment out of order (see RFC 5681) */
+                else if (seg_ack == tcb->snd_una && tcb->snd_una != tcb->snd_nxt &&
+                         pay_len == 0 && !(ctl & (MSK_SYN | MSK_FIN)) &&
+                         seg_wnd == tcb->snd_wnd) {
+                    _cc_dup_ack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -639,25 +1058,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -676,7 +1095,8 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
 
                 /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
+                bool in_order = (tcb->rcv_nxt == seg_seq);
+                if (in_order) {
                     /* Copy contents into receive buffer */
                     while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
                         tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
@@ -688,11 +1108,18 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* Send ACK, if FIN processing sends ACK already */
-                /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
-                    _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
-                               NULL, 0);
-                    _pkt_send(tcb, out_pkt, seq_con, false);
+                    /* Delay the ACK of in-order data, outgoing data may carry it. Every
+                     * second segment is acknowledged right away (see RFC 1122). */
+                    if (in_order && (tcb->flags & GNRC_TCP_FLAG_DELAYED_ACK) &&
+                        ++tcb->delack < 2) {
+                        _start_delack_timer(tcb);
+                    }
+                    else {
+                        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                                   NULL, 0);
+                        _pkt_send(tcb, out_pkt, seq_con, false);
+                    }
                 }
             }
         }
@@ -711,7 +1138,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_numof == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -743,6 +1170,27 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief FSM handling function for delayed ACKs.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ */
+static int _fsm_timeout_delayed_ack(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *out_pkt = NULL;
+    uint16_t seq_con = 0;
+
+    DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_delayed_ack()\n");
+    /* Nothing was sent in the meantime that carried the ACK */
+    if (tcb->delack > 0 && tcb->state != FSM_STATE_CLOSED) {
+        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+        _pkt_send(tcb, out_pkt, seq_con, false);
+    }
+    return 0;
+}
+
 /**
  * @brief FSM handling function for retransmissions.
  *
@@ -753,9 +1201,10 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->pkt_retransmit_numof > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -853,6 +1302,9 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
         case FSM_EVENT_TIMEOUT_TIMEWAIT :
             ret = _fsm_timeout_timewait(tcb);
             break;
+        case FSM_EVENT_TIMEOUT_DELAYED_ACK :
+            ret = _fsm_timeout_delayed_ack(tcb);
+            break;
         case FSM_EVENT_TIMEOUT_RETRANSMIT :
             ret = _fsm_timeout_retransmit(tcb);
             break;
@@ -884,6 +1336,13 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+    /* Notify a thread waiting for connections of the TCBs listen queue */
+    if ((tcb->status & STATUS_NOTIFY_USER) && tcb->queue != NULL &&
+        !(tcb->status & STATUS_ACCEPTED)) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
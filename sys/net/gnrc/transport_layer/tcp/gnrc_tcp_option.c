@@ -16,16 +16,82 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
+#include "byteorder.h"
+#include "xtimer.h"
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+uint32_t _option_timestamp_now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_MS);
+}
+
+void _option_build_timestamp(const gnrc_tcp_tcb_t *tcb, uint8_t *opt_ptr)
+{
+    network_uint32_t val = byteorder_htonl(_option_timestamp_now());
+    network_uint32_t ecr = byteorder_htonl((tcb->options & OPTION_TIMESTAMP) ? tcb->ts_recent : 0);
+
+    opt_ptr[0] = TCP_OPTION_KIND_NOP;
+    opt_ptr[1] = TCP_OPTION_KIND_NOP;
+    opt_ptr[2] = TCP_OPTION_KIND_TIMESTAMP;
+    opt_ptr[3] = TCP_OPTION_LENGTH_TIMESTAMP;
+    memcpy(&opt_ptr[4], &val, sizeof(val));
+    memcpy(&opt_ptr[8], &ecr, sizeof(ecr));
+}
+
+void _option_update_timestamp(const gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+{
+    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t *opt_ptr = (uint8_t *) hdr + sizeof(tcp_hdr_t);
+    uint8_t opt_left = (offset - TCP_HDR_OFFSET_MIN) * 4;
+
+    /* Options were built by _pkt_build, so they are well formed */
+    while (opt_left >= TCP_OPTION_LENGTH_TIMESTAMP && *opt_ptr != TCP_OPTION_KIND_EOL) {
+        if (*opt_ptr == TCP_OPTION_KIND_NOP) {
+            opt_ptr += 1;
+            opt_left -= 1;
+            continue;
+        }
+        if (*opt_ptr == TCP_OPTION_KIND_TIMESTAMP) {
+            /* The option is padded with two NOPs, rebuild it including those */
+            _option_build_timestamp(tcb, opt_ptr - 2);
+            return;
+        }
+        opt_left -= opt_ptr[1];
+        opt_ptr += opt_ptr[1];
+    }
+}
+
+/**
+ * @brief Reads a 32 bit value in network byteorder from an option.
+ *
+ * @param[in] ptr   Pointer to the value.
+ *
+ * @returns   Value in host byteorder.
+ */
+static inline uint32_t _get_u32(const uint8_t *ptr)
+{
+    return ((uint32_t) ptr[0] << 24) | ((uint32_t) ptr[1] << 16) |
+           ((uint32_t) ptr[2] << 8) | ptr[3];
+}
+
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+
+    /* Options of a SYN are negotiated anew */
+    tcb->options &= ~OPTION_TS_RCVD;
+    if (ctl & MSK_SYN) {
+        tcb->options &= ~(OPTION_SACK | OPTION_TIMESTAMP);
+    }
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -49,7 +115,15 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 opt_ptr += 1;
                 opt_left -= 1;
                 continue;
+        }
+
+        /* All other options carry a length that must fit into the option field */
+        if (opt_left < 2 || option->length < 2 || option->length > opt_left) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : invalid option length.\n");
+            return -1;
+        }
 
+        switch (option->kind) {
             case TCP_OPTION_KIND_MSS:
                 if (option->length != TCP_OPTION_LENGTH_MSS) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : invalid MSS Option length.\n");
@@ -60,6 +134,45 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Permitted length.\n");
+                    return -1;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK Permitted option found.\n");
+                if (GNRC_TCP_SACK && (ctl & MSK_SYN)) {
+                    tcb->options |= OPTION_SACK;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if ((option->length - 2) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                /* Mark the selectively acknowledged packets in the retransmit queue */
+                if (tcb->options & OPTION_SACK) {
+                    for (uint8_t i = 0; i < option->length - 2; i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        _pkt_sack(tcb, _get_u32(&option->value[i]), _get_u32(&option->value[i + 4]));
+                    }
+                }
+                break;
+
+            case TCP_OPTION_KIND_TIMESTAMP:
+                if (option->length != TCP_OPTION_LENGTH_TIMESTAMP) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid Timestamps length.\n");
+                    return -1;
+                }
+                tcb->ts_val = _get_u32(&option->value[0]);
+                tcb->ts_ecr = _get_u32(&option->value[4]);
+                tcb->options |= OPTION_TS_RCVD;
+                DEBUG("gnrc_tcp_option.c : _option_parse() : Timestamps option found. \
+                      TSval=%"PRIu32", TSecr=%"PRIu32"\n", tcb->ts_val, tcb->ts_ecr);
+                if (GNRC_TCP_TIMESTAMPS && (ctl & MSK_SYN)) {
+                    tcb->options |= OPTION_TIMESTAMP;
+                }
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -33,6 +33,10 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if GNRC_TCP_RETRANSMIT_QUEUE_SIZE > 8
+#error "GNRC_TCP_RETRANSMIT_QUEUE_SIZE exceeds the bitmaps of the retransmit queue"
+#endif
+
 /**
  * @brief Calculates the maximum of two unsigned numbers.
  *
@@ -144,10 +148,23 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
+    /* Offer SACK and timestamps on SYN, answer a SYN only with what the peer offered */
+    bool syn = (ctl & MSK_SYN);
+    bool sack_perm = GNRC_TCP_SACK && syn &&
+                     (!(ctl & MSK_ACK) || (tcb->options & OPTION_SACK));
+    bool timestamp = GNRC_TCP_TIMESTAMPS && !(ctl & MSK_RST) &&
+                     ((syn && !(ctl & MSK_ACK)) || (tcb->options & OPTION_TIMESTAMP));
+
     /* Add MSS option if SYN is sent */
-    if (ctl & MSK_SYN) {
+    if (syn) {
         offset += 1;
     }
+    if (sack_perm) {
+        offset += OPTION_WORDS_SACK_PERM;
+    }
+    if (timestamp) {
+        offset += OPTION_WORDS_TIMESTAMP;
+    }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -169,11 +186,20 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             memset(opt_ptr, TCP_OPTION_KIND_EOL, opt_left);
 
             /* If SYN flag is set: Add MSS option */
-            if (ctl & MSK_SYN) {
+            if (syn) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            if (sack_perm) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+            }
+            if (timestamp) {
+                _option_build_timestamp(tcb, opt_ptr);
+                opt_ptr += OPTION_WORDS_TIMESTAMP * sizeof(network_uint32_t);
             }
-            /* Increase opt_ptr and decrease opt_ptr, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -219,12 +245,34 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
+        gnrc_pktsnip_t *snp = NULL;
+
+        /* Every new segment carries the ACK of everything received */
+        LL_SEARCH_SCALAR(out_pkt, snp, type, GNRC_NETTYPE_TCP);
+        if (tcb->delack > 0 && (byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl) & MSK_ACK)) {
+            tcb->delack = 0;
+            xtimer_remove(&tcb->tim_delack);
+        }
+
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+        /* Time one segment per round trip */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
     else {
+        gnrc_pktsnip_t *snp = NULL;
+
         tcb->retries += 1;
+        /* Karns Algorithm: Don't measure a round trip that might be ambiguous */
+        tcb->status &= ~STATUS_RTT_PENDING;
+        /* The echo of a retransmission must report the time it was resent */
+        if (tcb->options & OPTION_TIMESTAMP) {
+            LL_SEARCH_SCALAR(out_pkt, snp, type, GNRC_NETTYPE_TCP);
+            _option_update_timestamp(tcb, (tcp_hdr_t *) snp->data);
+        }
     }
 
     /* Pass packet down the network stack */
@@ -296,6 +344,44 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _update_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a measurement, rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Starts the retransmission timer for the oldest packet in the retransmit queue.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _start_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    xtimer_remove(&tcb->tim_tout);
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -308,10 +394,26 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
+    /* Only the oldest packet is retransmitted on timeouts */
+    if (retransmit) {
+        if (tcb->pkt_retransmit_numof == 0 || tcb->pkt_retransmit[0] != pkt) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not the oldest packet\n");
+            return -EINVAL;
+        }
+        gnrc_pktbuf_hold(pkt, 1);
+        tcb->pkt_resent |= 1;
+
+        /* If this is a retransmission: Double the rto (Timer Backoff) */
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        _start_retransmit_timer(tcb);
+        return 0;
     }
 
     /* Extract control bits and segment length */
@@ -324,45 +426,93 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Check if retransmit queue is full */
+    if (tcb->pkt_retransmit_numof >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+        return -ENOMEM;
+    }
+
+    /* Append pkt and increase users: every send attempt consumes a user */
+    tcb->pkt_retransmit[tcb->pkt_retransmit_numof++] = pkt;
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    /* The timer runs for the oldest packet, start it if this is the only one */
+    if (tcb->pkt_retransmit_numof == 1) {
+        _update_rto(tcb);
+        _start_retransmit_timer(tcb);
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the sequence number of a packet.
+ *
+ * @param[in] pkt   Packet holding a TCP header.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+static uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
+int _pkt_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    unsigned lost = 1;
+
+    /* Everything below the highest selectively acknowledged packet is lost */
+    for (unsigned i = tcb->pkt_retransmit_numof; i > 1; i--) {
+        if (tcb->pkt_sacked & (1 << (i - 1))) {
+            lost = i - 1;
+            break;
         }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+    for (unsigned i = 0; i < lost && i < tcb->pkt_retransmit_numof; i++) {
+        if (!((tcb->pkt_sacked | tcb->pkt_resent) & (1 << i))) {
+            tcb->pkt_resent |= (1 << i);
+            gnrc_pktbuf_hold(tcb->pkt_retransmit[i], 1);
+            return _pkt_send(tcb, tcb->pkt_retransmit[i], 0, true);
         }
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
+    DEBUG("gnrc_tcp_pkt.c : _pkt_retransmit() : No packet to retransmit\n");
+    return -ENODATA;
+}
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[i];
+        uint32_t seq = _pkt_get_seq_num(pkt);
+
+        if (LEQ_32_BIT(left, seq) && LEQ_32_BIT(seq + _pkt_get_seg_len(pkt), right)) {
+            tcb->pkt_sacked |= (1 << i);
         }
     }
+}
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+/**
+ * @brief Updates the round trip time estimation with a new sample (see RFC 6298).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     rtt   Measured round trip time.
+ */
+static void _rtt_sample(gnrc_tcp_tcb_t *tcb, int32_t rtt)
+{
+    /* If this is the first sample taken */
+    if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->srtt = rtt;
+        tcb->rtt_var = (rtt >> 1);
     }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    /* If this is a subsequent sample */
+    else {
+        tcb->rtt_var = (tcb->rtt_var / GNRC_TCP_RTO_B_DIV) * (GNRC_TCP_RTO_B_DIV-1);
+        tcb->rtt_var += abs(tcb->srtt - rtt) / GNRC_TCP_RTO_B_DIV;
+        tcb->srtt = (tcb->srtt / GNRC_TCP_RTO_A_DIV) * (GNRC_TCP_RTO_A_DIV-1);
+        tcb->srtt += rtt / GNRC_TCP_RTO_A_DIV;
     }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
-    return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
@@ -370,44 +520,63 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
     uint32_t seg = 0;
     gnrc_pktsnip_t *snp = NULL;
     tcp_hdr_t *hdr;
+    unsigned acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->pkt_retransmit_numof == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
+    /* Release all packets that are acknowledged, oldest first */
+    while (acked < tcb->pkt_retransmit_numof) {
+        LL_SEARCH_SCALAR(tcb->pkt_retransmit[acked], snp, type, GNRC_NETTYPE_TCP);
+        hdr = (tcp_hdr_t *) snp->data;
+        seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit[acked]) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(tcb->pkt_retransmit[acked]);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->pkt_retransmit_numof -= acked;
+    memmove(tcb->pkt_retransmit, &tcb->pkt_retransmit[acked],
+            tcb->pkt_retransmit_numof * sizeof(gnrc_pktsnip_t *));
+    tcb->pkt_sacked >>= acked;
+    tcb->pkt_resent >>= acked;
+    tcb->retries = 0;
 
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* With timestamps, every ACK of new data echoes the time of the segment it answers */
+    if ((tcb->options & OPTION_TIMESTAMP) && (tcb->options & OPTION_TS_RCVD)) {
+        int32_t rtt = (_option_timestamp_now() - tcb->ts_ecr) * US_PER_MS;
 
-        /* Measure round trip time */
+        tcb->status &= ~STATUS_RTT_PENDING;
+        if (rtt >= 0) {
+            _rtt_sample(tcb, (rtt > 0) ? rtt : 1);
+        }
+    }
+    /* Measure round trip time, if the timed segment was acknowledged */
+    else if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
-            /* If this is the first sample taken */
-            if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
-                tcb->srtt = rtt;
-                tcb->rtt_var = (rtt >> 1);
-            }
-            /* If this is a subsequent sample */
-            else {
-                tcb->rtt_var = (tcb->rtt_var / GNRC_TCP_RTO_B_DIV) * (GNRC_TCP_RTO_B_DIV-1);
-                tcb->rtt_var += abs(tcb->srtt - rtt) / GNRC_TCP_RTO_B_DIV;
-                tcb->srtt = (tcb->srtt / GNRC_TCP_RTO_A_DIV) * (GNRC_TCP_RTO_A_DIV-1);
-                tcb->srtt += rtt / GNRC_TCP_RTO_A_DIV;
-            }
+        tcb->status &= ~STATUS_RTT_PENDING;
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
+            _rtt_sample(tcb, rtt);
         }
     }
+
+    /* Stop the timer or restart it for the now oldest packet (see RFC 6298) */
+    if (tcb->pkt_retransmit_numof == 0) {
+        xtimer_remove(&(tcb->tim_tout));
+    }
+    else {
+        _update_rto(tcb);
+        _start_retransmit_timer(tcb);
+    }
     return 0;
 }
 
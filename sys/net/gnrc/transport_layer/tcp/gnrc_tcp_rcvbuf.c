@@ -34,45 +34,60 @@ void _rcvbuf_init(void)
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
     for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
+        _static_buf.used[i] = 0;
     }
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate the longest run of adjacent free receive buffers.
  *
- * @returns   Not NULL if a receive buffer was allocated.
+ * @param[out] numof   Number of allocated buffers.
+ *
+ * @returns   Not NULL if receive buffers were allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t *numof)
 {
-    void *result = NULL;
+    size_t best = 0;
+    size_t best_len = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS && best_len < GNRC_TCP_RCV_BUFFERS_PER_TCB; ) {
+        size_t len = 0;
+
+        while ((i + len) < GNRC_TCP_RCV_BUFFERS && _static_buf.used[i + len] == 0 &&
+               len < GNRC_TCP_RCV_BUFFERS_PER_TCB) {
+            len++;
+        }
+        if (len > best_len) {
+            best = i;
+            best_len = len;
         }
+        i += len + 1;
+    }
+    for (size_t i = best; i < (best + best_len); ++i) {
+        _static_buf.used[i] = 1;
     }
     mutex_unlock(&(_static_buf.lock));
-    return result;
+    *numof = best_len;
+    return (best_len > 0) ? _static_buf.buffers[best] : NULL;
 }
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release allocated receive buffers.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] buf     Pointer to the first buffer that should be released.
+ * @param[in] numof   Number of buffers that should be released.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_free(void * const buf, size_t numof)
 {
+    size_t first = ((uint8_t *)buf - _static_buf.buffers[0]) / GNRC_TCP_RCV_BUF_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    for (size_t i = first; i < (first + numof) && i < GNRC_TCP_RCV_BUFFERS; ++i) {
+        _static_buf.used[i] = 0;
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,13 +95,17 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t numof = 0;
+
+        tcb->rcv_buf_raw = _rcvbuf_alloc(&numof);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw,
+                            numof * GNRC_TCP_RCV_BUF_SIZE);
+            tcb->rcv_wnd = numof * GNRC_TCP_RCV_BUF_SIZE;
         }
     }
     return 0;
@@ -95,7 +114,7 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size / GNRC_TCP_RCV_BUF_SIZE);
         tcb->rcv_buf_raw = NULL;
     }
 }
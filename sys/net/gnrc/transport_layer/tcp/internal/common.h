@@ -22,6 +22,7 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "assert.h"
 #include "kernel_types.h"
@@ -49,6 +50,10 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_PENDING    (1 << 4)
+#define STATUS_FAST_RECOVERY  (1 << 5)
+#define STATUS_RTO_RECOVERY   (1 << 6)
+#define STATUS_ACCEPTED       (1 << 7)
 /** @} */
 
 /**
@@ -89,6 +94,7 @@ extern "C" {
 #define MSG_TYPE_RETRANSMISSION     (GNRC_NETAPI_MSG_TYPE_ACK + 104)
 #define MSG_TYPE_TIMEWAIT           (GNRC_NETAPI_MSG_TYPE_ACK + 105)
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
+#define MSG_TYPE_DELAYED_ACK        (GNRC_NETAPI_MSG_TYPE_ACK + 107)
 /** @} */
 
 /**
@@ -132,6 +138,35 @@ extern gnrc_tcp_tcb_t *_list_tcb_head;
  */
 extern mutex_t _list_tcb_lock;
 
+/**
+ * @brief Hash buckets of all TCBs with a known peer, protected by _list_tcb_lock.
+ */
+extern gnrc_tcp_tcb_t *_hash_tcb[GNRC_TCP_TCB_HASH_SIZE];
+
+/**
+ * @brief Calculates the hash bucket of a connection.
+ *
+ * @param[in] local_port   Local port number.
+ * @param[in] peer_port    Peer port number.
+ * @param[in] peer_addr    Peer address, may be NULL.
+ * @param[in] addr_len     Length of @p peer_addr.
+ *
+ * @returns   Index into _hash_tcb.
+ */
+static inline unsigned _tcb_hash(uint16_t local_port, uint16_t peer_port,
+                                 const uint8_t *peer_addr, size_t addr_len)
+{
+    uint32_t hash = ((uint32_t) local_port << 16) ^ peer_port;
+
+    /* The interface identifier differs most between peers */
+    for (size_t i = (addr_len > 4) ? (addr_len - 4) : 0; i < addr_len; i++) {
+        hash ^= (uint32_t) peer_addr[i] << (8 * (i & 3));
+    }
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash % GNRC_TCP_TCB_HASH_SIZE;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,7 @@ typedef enum {
     FSM_EVENT_CALL_ABORT,         /* User function call: abort */
     FSM_EVENT_RCVD_PKT,           /* Paket received from peer */
     FSM_EVENT_TIMEOUT_TIMEWAIT,   /* Timeout: timewait */
+    FSM_EVENT_TIMEOUT_DELAYED_ACK, /* Timeout: delayed ACK */
     FSM_EVENT_TIMEOUT_RETRANSMIT, /* Timeout: retransmit */
     FSM_EVENT_TIMEOUT_CONNECTION, /* Timeout: connection */
     FSM_EVENT_SEND_PROBE,         /* Send zero window probe */
@@ -31,6 +31,25 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Option flags in gnrc_tcp_tcb_t::options
+ * @{
+ */
+#define OPTION_SACK      (1 << 0)  /**< Peer permitted selective acknowledgments */
+#define OPTION_TIMESTAMP (1 << 1)  /**< Timestamps are used on this connection */
+#define OPTION_TS_RCVD   (1 << 2)  /**< Last received segment carried a timestamp */
+/** @} */
+
+/**
+ * @brief Option space of a padded SACK Permitted option in 32 bit words.
+ */
+#define OPTION_WORDS_SACK_PERM (1U)
+
+/**
+ * @brief Option space of a padded Timestamps option in 32 bit words.
+ */
+#define OPTION_WORDS_TIMESTAMP (3U)
+
 /**
  * @brief Helper function to build the MSS option.
  *
@@ -44,6 +63,41 @@ inline static uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the padded SACK Permitted option.
+ *
+ * @returns   SACK Permitted option value, preceded by two NOPs.
+ */
+inline static uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) | ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Writes the padded Timestamps option with the current time.
+ *
+ * @param[in]  tcb       TCB holding the timestamp to echo.
+ * @param[out] opt_ptr   Option field to write to, at least
+ *                       OPTION_WORDS_TIMESTAMP * 4 bytes long.
+ */
+void _option_build_timestamp(const gnrc_tcp_tcb_t *tcb, uint8_t *opt_ptr);
+
+/**
+ * @brief Refreshes the Timestamps option of a TCP header before it is resent.
+ *
+ * @param[in]     tcb   TCB holding the timestamp to echo.
+ * @param[in,out] hdr   TCP header holding the option.
+ */
+void _option_update_timestamp(const gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
+
+/**
+ * @brief Current value of the timestamp clock in milliseconds.
+ *
+ * @returns   Timestamp value.
+ */
+uint32_t _option_timestamp_now(void);
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -61,6 +115,9 @@ inline static uint16_t _option_build_offset_control(uint16_t nopts, uint16_t ctl
 /**
  * @brief Parses options of a given TCP header.
  *
+ * Options announced on SYN segments are negotiated, SACK blocks are passed to
+ * the retransmit queue and the timestamps are stored in @p tcb.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     hdr   TCP header to be parsed.
  *
@@ -110,9 +110,13 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * @note The retransmission timer runs for the oldest packet in the queue.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
- * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
+ * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit
+ *                             after a timeout. @p pkt must be the oldest packet
+ *                             in the queue then.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
@@ -121,7 +125,33 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Retransmits the next hole of the retransmission queue right away.
+ *
+ * The hole is the oldest packet that was neither selectively acknowledged nor
+ * resent during the current loss recovery. Packets above the highest
+ * selectively acknowledged one are not considered lost, without SACK
+ * information only the oldest packet is.
+ *
+ * @note Used during loss recovery. Unlike a timeout, this keeps the RTO.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if there is no hole to retransmit.
+ */
+int _pkt_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Marks packets of the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block, first number after the block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
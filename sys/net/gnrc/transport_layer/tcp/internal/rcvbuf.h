@@ -31,20 +31,16 @@
 extern "C" {
 #endif
 
-/**
- * @brief Receive buffer entry.
- */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
-
 /**
  * @brief   Stuct holding receive buffers.
+ *
+ * @note The buffers are contiguous, so that a TCB can use several adjacent
+ *       buffers as one receive buffer.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                                  /**< Lock for allocation synchronization */
+    uint8_t used[GNRC_TCP_RCV_BUFFERS];            /**< Flags: Is buffer in use? */
+    uint8_t buffers[GNRC_TCP_RCV_BUFFERS][GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
 } rcvbuf_t;
 
 /**
@@ -55,6 +51,9 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * The TCB claims up to GNRC_TCP_RCV_BUFFERS_PER_TCB adjacent free buffers,
+ * as many as are available, and its receive window covers all of them.
+ *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
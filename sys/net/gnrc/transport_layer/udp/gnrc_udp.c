@@ -25,6 +25,7 @@
 #include "thread.h"
 #include "utlist.h"
 #include "net/ipv6/hdr.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
 #include "net/inet_csum.h"
@@ -33,6 +34,12 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/**
+ * @brief   Registry entry for handling UDP packets in the dispatching thread
+ */
+static gnrc_netreg_entry_t _netreg;
+#else
 /**
  * @brief   Save the UDP's thread PID for later reference
  */
@@ -46,6 +53,7 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -104,6 +112,23 @@ static void _receive(gnrc_pktsnip_t *pkt)
     udp_hdr_t *hdr;
     uint32_t port;
 
+    /* shed packets all receivers would drop before copying and checking them */
+    if ((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_UDP) &&
+        (pkt->next->size == sizeof(udp_hdr_t))) {
+        udp = pkt->next;
+    }
+    else {
+        udp = pkt;
+    }
+    if (udp->size >= sizeof(udp_hdr_t)) {
+        hdr = (udp_hdr_t *)udp->data;
+        if (gnrc_netreg_full(GNRC_NETTYPE_UDP, byteorder_ntohs(hdr->dst_port))) {
+            DEBUG("udp: receivers are full, dropping packet\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+
     /* mark UDP header */
     udp = gnrc_pktbuf_start_write(pkt);
     if (udp == NULL) {
@@ -217,6 +242,32 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+            gnrc_pkttrace_enter(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_RX, pkt);
+            _receive(pkt);
+            gnrc_pkttrace_exit(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_RX, NULL);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+            gnrc_pkttrace_enter(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_TX, pkt);
+            _send(pkt);
+            gnrc_pkttrace_exit(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_TX, NULL);
+            break;
+        default:
+            DEBUG("udp: received unidentified command\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _cbd = { _netapi_cb, NULL, NULL };
+#else
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -238,14 +289,20 @@ static void *_event_loop(void *arg)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_RX, msg.content.ptr);
                 _receive(msg.content.ptr);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_RX, NULL);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+                gnrc_pkttrace_enter(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_TX, msg.content.ptr);
                 _send(msg.content.ptr);
+                gnrc_pkttrace_exit(GNRC_PKTTRACE_UDP, GNRC_PKTTRACE_TX, NULL);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_GET_MULTI:
+            case GNRC_NETAPI_MSG_TYPE_SET_MULTI:
                 msg_reply(&msg, &reply);
                 break;
             default:
@@ -257,6 +314,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -298,6 +356,14 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 
 int gnrc_udp_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* check if UDP is already registered */
+    if (_netreg.target.cbd == NULL) {
+        gnrc_netreg_entry_init_cb(&_netreg, GNRC_NETREG_DEMUX_CTX_ALL, &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netreg);
+    }
+    return 0;
+#else
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
@@ -305,4 +371,5 @@ int gnrc_udp_init(void)
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
     return _pid;
+#endif
 }
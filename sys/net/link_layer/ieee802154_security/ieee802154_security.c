@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/modes/ccm.h"
+#include "net/ieee802154_security.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* CCM* nonce: long address, frame counter and security level */
+#define NONCE_LEN           (IEEE802154_LONG_ADDRESS_LEN + 5)
+/* length field of CCM*, 15 - NONCE_LEN */
+#define LENGTH_ENCODING     (2)
+
+static ieee802154_sec_key_t *_find_key(ieee802154_sec_context_t *ctx,
+                                       uint8_t index)
+{
+    for (unsigned i = 0; i < IEEE802154_SEC_KEYS_NUMOF; i++) {
+        if (ctx->keys[i].valid && (ctx->keys[i].index == index)) {
+            return &ctx->keys[i];
+        }
+    }
+    return NULL;
+}
+
+static ieee802154_sec_dev_t *_find_dev(ieee802154_sec_context_t *ctx,
+                                       const uint8_t *addr, size_t addr_len)
+{
+    for (unsigned i = 0; i < IEEE802154_SEC_DEVS_NUMOF; i++) {
+        ieee802154_sec_dev_t *dev = &ctx->devs[i];
+
+        if (!dev->valid) {
+            continue;
+        }
+        if ((addr_len == IEEE802154_LONG_ADDRESS_LEN) &&
+            (memcmp(dev->long_addr, addr, addr_len) == 0)) {
+            return dev;
+        }
+        if ((addr_len == IEEE802154_SHORT_ADDRESS_LEN) &&
+            (memcmp(dev->short_addr, ieee802154_addr_bcast, addr_len) != 0) &&
+            (memcmp(dev->short_addr, addr, addr_len) == 0)) {
+            return dev;
+        }
+    }
+    return NULL;
+}
+
+static ieee802154_sec_dev_t *_free_dev(ieee802154_sec_context_t *ctx)
+{
+    for (unsigned i = 0; i < IEEE802154_SEC_DEVS_NUMOF; i++) {
+        if (!ctx->devs[i].valid) {
+            return &ctx->devs[i];
+        }
+    }
+    return NULL;
+}
+
+static void _set_nonce(uint8_t *nonce, const uint8_t *long_addr,
+                       uint32_t frame_counter, uint8_t level)
+{
+    memcpy(nonce, long_addr, IEEE802154_LONG_ADDRESS_LEN);
+    nonce += IEEE802154_LONG_ADDRESS_LEN;
+    /* big endian, unlike in the auxiliary security header */
+    *(nonce++) = frame_counter >> 24;
+    *(nonce++) = frame_counter >> 16;
+    *(nonce++) = frame_counter >> 8;
+    *(nonce++) = frame_counter;
+    *nonce = level;
+}
+
+/* len is the length of the payload including the MIC when decrypting */
+static int _ccm(ieee802154_sec_key_t *key, int encrypt, uint8_t *frame,
+                size_t hdr_len, size_t len, uint8_t level,
+                const uint8_t *nonce)
+{
+    uint8_t mic_len = ieee802154_sec_mic_len(level);
+    uint8_t *payload = &frame[hdr_len];
+    size_t plain_len;
+    int res;
+
+    if (level & IEEE802154_SEC_LEVEL_ENC) {
+        if (encrypt) {
+            return cipher_encrypt_ccm_star(&key->cipher, frame, hdr_len,
+                                           mic_len, LENGTH_ENCODING, nonce,
+                                           NONCE_LEN, payload, len, payload);
+        }
+        return cipher_decrypt_ccm_star(&key->cipher, frame, hdr_len, mic_len,
+                                       LENGTH_ENCODING, nonce, NONCE_LEN,
+                                       payload, len, payload);
+    }
+    /* the payload is only authenticated, along with the headers */
+    plain_len = (encrypt) ? len : (len - mic_len);
+    if (encrypt) {
+        res = cipher_encrypt_ccm_star(&key->cipher, frame, hdr_len + plain_len,
+                                      mic_len, LENGTH_ENCODING, nonce,
+                                      NONCE_LEN, NULL, 0, &payload[plain_len]);
+    }
+    else {
+        res = cipher_decrypt_ccm_star(&key->cipher, frame, hdr_len + plain_len,
+                                      mic_len, LENGTH_ENCODING, nonce,
+                                      NONCE_LEN, &payload[plain_len], mic_len,
+                                      NULL);
+    }
+    if (res < 0) {
+        return res;
+    }
+    return (encrypt) ? (plain_len + mic_len) : plain_len;
+}
+
+void ieee802154_sec_init(ieee802154_sec_context_t *ctx)
+{
+    memset(ctx, 0, sizeof(ieee802154_sec_context_t));
+    ctx->level = IEEE802154_SEC_DEFAULT_LEVEL;
+    ctx->key_index = IEEE802154_SEC_DEFAULT_KEY_INDEX;
+}
+
+int ieee802154_sec_set_key(ieee802154_sec_context_t *ctx, uint8_t index,
+                           const uint8_t *key, size_t key_len)
+{
+    ieee802154_sec_key_t *entry = _find_key(ctx, index);
+
+    if (key_len != IEEE802154_SEC_KEY_LEN) {
+        return -EINVAL;
+    }
+    if (entry == NULL) {
+        for (unsigned i = 0; i < IEEE802154_SEC_KEYS_NUMOF; i++) {
+            if (!ctx->keys[i].valid) {
+                entry = &ctx->keys[i];
+                break;
+            }
+        }
+        if (entry == NULL) {
+            return -ENOMEM;
+        }
+    }
+    /* the cipher is set up here and not for every frame */
+    entry->valid = false;
+    if (cipher_init(&entry->cipher, CIPHER_AES_128, key, key_len) != 1) {
+        return -EINVAL;
+    }
+    entry->index = index;
+    entry->valid = true;
+    return 0;
+}
+
+int ieee802154_sec_add_dev(ieee802154_sec_context_t *ctx,
+                           const uint8_t *long_addr, const uint8_t *short_addr)
+{
+    ieee802154_sec_dev_t *dev = _find_dev(ctx, long_addr,
+                                          IEEE802154_LONG_ADDRESS_LEN);
+
+    if (dev == NULL) {
+        if ((dev = _free_dev(ctx)) == NULL) {
+            return -ENOMEM;
+        }
+        memcpy(dev->long_addr, long_addr, IEEE802154_LONG_ADDRESS_LEN);
+        dev->frame_counter = 0;
+        dev->valid = true;
+    }
+    if (short_addr != NULL) {
+        memcpy(dev->short_addr, short_addr, IEEE802154_SHORT_ADDRESS_LEN);
+    }
+    else {
+        memcpy(dev->short_addr, ieee802154_addr_bcast,
+               IEEE802154_SHORT_ADDRESS_LEN);
+    }
+    return 0;
+}
+
+int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx, uint8_t *frame,
+                                 size_t mhr_len, size_t payload_len,
+                                 const uint8_t *long_addr)
+{
+    uint8_t *aux = &frame[mhr_len];
+    size_t aux_len = ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX);
+    ieee802154_sec_key_t *key;
+    uint8_t nonce[NONCE_LEN];
+    uint32_t frame_counter;
+    int res;
+
+    if (ctx->level == IEEE802154_SEC_LEVEL_NONE) {
+        return -EINVAL;
+    }
+    if ((key = _find_key(ctx, ctx->key_index)) == NULL) {
+        DEBUG("ieee802154_security: no key of index %u\n",
+              (unsigned)ctx->key_index);
+        return -ENOENT;
+    }
+    if ((mhr_len + aux_len + payload_len + ieee802154_sec_mic_len(ctx->level)) >
+        (IEEE802154_FRAME_LEN_MAX - IEEE802154_FCS_LEN)) {
+        return -EMSGSIZE;
+    }
+    if (ctx->frame_counter == UINT32_MAX) {
+        /* the key has to be replaced */
+        return -EOVERFLOW;
+    }
+    frame_counter = ctx->frame_counter++;
+
+    aux[0] = ctx->level | IEEE802154_SEC_KEY_ID_INDEX;
+    aux[1] = frame_counter;
+    aux[2] = frame_counter >> 8;
+    aux[3] = frame_counter >> 16;
+    aux[4] = frame_counter >> 24;
+    aux[5] = ctx->key_index;
+    _set_nonce(nonce, long_addr, frame_counter, ctx->level);
+    res = _ccm(key, 1, frame, mhr_len + aux_len, payload_len, ctx->level,
+               nonce);
+    if (res < 0) {
+        DEBUG("ieee802154_security: encryption failed (%d)\n", res);
+        return -EINVAL;
+    }
+    return mhr_len + aux_len + res;
+}
+
+int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx, uint8_t *frame,
+                                 size_t frame_len, size_t *hdr_len)
+{
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t nonce[NONCE_LEN];
+    const uint8_t *aux;
+    ieee802154_sec_key_t *key;
+    ieee802154_sec_dev_t *dev;
+    le_uint16_t src_pan;
+    size_t mhr_len, aux_len;
+    uint32_t frame_counter;
+    uint8_t level;
+    int src_len, res;
+
+    mhr_len = ieee802154_get_frame_hdr_len(frame);
+    if ((mhr_len == 0) || (mhr_len >= frame_len) ||
+        ((frame[1] & IEEE802154_FCF_VERS_MASK) == IEEE802154_FCF_VERS_V0)) {
+        return -EBADMSG;
+    }
+    aux = &frame[mhr_len];
+    aux_len = ieee802154_sec_aux_hdr_len(aux[0]);
+    level = aux[0] & IEEE802154_SEC_SCF_LEVEL_MASK;
+    if ((level == IEEE802154_SEC_LEVEL_NONE) ||
+        (frame_len < (mhr_len + aux_len + ieee802154_sec_mic_len(level)))) {
+        return -EBADMSG;
+    }
+    frame_counter = aux[1] | (aux[2] << 8) | ((uint32_t)aux[3] << 16) |
+                    ((uint32_t)aux[4] << 24);
+    if (frame_counter == UINT32_MAX) {
+        return -EBADMSG;
+    }
+    key = _find_key(ctx, ((aux[0] & IEEE802154_SEC_SCF_KEY_ID_MASK) ==
+                          IEEE802154_SEC_KEY_ID_IMPLICIT) ?
+                         ctx->key_index : aux[aux_len - 1]);
+    if (key == NULL) {
+        DEBUG("ieee802154_security: unknown key\n");
+        return -ENOENT;
+    }
+
+    src_len = ieee802154_get_src(frame, src, &src_pan);
+    if (src_len <= 0) {
+        return -ENOENT;
+    }
+    dev = _find_dev(ctx, src, src_len);
+    if (dev == NULL) {
+        /* the long address of a short one has to be known */
+        if (src_len != IEEE802154_LONG_ADDRESS_LEN) {
+            DEBUG("ieee802154_security: unknown sender\n");
+            return -ENOENT;
+        }
+        if ((dev = _free_dev(ctx)) == NULL) {
+            DEBUG("ieee802154_security: device table full\n");
+            return -ENOMEM;
+        }
+    }
+    else if (frame_counter < dev->frame_counter) {
+        DEBUG("ieee802154_security: replayed frame\n");
+        return -EALREADY;
+    }
+
+    _set_nonce(nonce, (dev->valid) ? dev->long_addr : src, frame_counter,
+               level);
+    *hdr_len = mhr_len + aux_len;
+    res = _ccm(key, 0, frame, *hdr_len, frame_len - *hdr_len, level, nonce);
+    if (res < 0) {
+        DEBUG("ieee802154_security: MIC check failed (%d)\n", res);
+        return -EBADMSG;
+    }
+    if (!dev->valid) {
+        memcpy(dev->long_addr, src, IEEE802154_LONG_ADDRESS_LEN);
+        memcpy(dev->short_addr, ieee802154_addr_bcast,
+               IEEE802154_SHORT_ADDRESS_LEN);
+        dev->valid = true;
+    }
+    dev->frame_counter = frame_counter + 1;
+    return res;
+}
+
+/** @} */
@@ -33,6 +33,40 @@ static inline bool match(const l2filter_t *filter,
             (memcmp(filter->addr, addr, addr_len) == 0));
 }
 
+/* home slot of an address: FNV-1a over its bytes */
+static unsigned _home(const void *addr, size_t addr_len)
+{
+    const uint8_t *bytes = addr;
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < addr_len; i++) {
+        hash = (hash ^ bytes[i]) * 16777619U;
+    }
+    return hash % L2FILTER_LISTSIZE;
+}
+
+static inline unsigned _next(unsigned i)
+{
+    return (i + 1) % L2FILTER_LISTSIZE;
+}
+
+/* finds the slot of an address by probing from its home slot on until the
+ * first empty slot */
+static int _find(const l2filter_t *list, const void *addr, size_t addr_len)
+{
+    unsigned i = _home(addr, addr_len);
+
+    for (unsigned n = 0; n < L2FILTER_LISTSIZE; n++, i = _next(i)) {
+        if (list[i].addr_len == 0) {
+            break;
+        }
+        if (match(&list[i], addr, addr_len)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void l2filter_init(l2filter_t *list)
 {
     assert(list);
@@ -47,8 +81,9 @@ int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len)
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
     int res = -ENOMEM;
+    unsigned i = _home(addr, addr_len);
 
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+    for (unsigned n = 0; n < L2FILTER_LISTSIZE; n++, i = _next(i)) {
         if (list[i].addr_len == 0) {
             list[i].addr_len = addr_len;
             memcpy(list[i].addr, addr, addr_len);
@@ -64,17 +99,30 @@ int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOENT;
+    int pos = _find(list, addr, addr_len);
 
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            list[i].addr_len = 0;
-            res = 0;
+    if (pos < 0) {
+        return -ENOENT;
+    }
+    /* close the gap, so that no entry behind it becomes unreachable */
+    unsigned gap = pos;
+    for (unsigned i = _next(gap); list[i].addr_len != 0; i = _next(i)) {
+        unsigned home = _home(list[i].addr, list[i].addr_len);
+        bool stays = (gap < i) ? ((gap < home) && (home <= i))
+                               : ((gap < home) || (home <= i));
+
+        /* move the entry unless the gap is before its home slot */
+        if (!stays) {
+            list[gap] = list[i];
+            gap = i;
+        }
+        if (_next(i) == (unsigned)pos) {
             break;
         }
     }
+    list[gap].addr_len = 0;
 
-    return res;
+    return 0;
 }
 
 bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len)
@@ -82,25 +130,13 @@ bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len)
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
 #ifdef MODULE_L2FILTER_WHITELIST
-    bool res = false;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] whitelist: address match -> packet passes\n");
-            res = true;
-            break;
-        }
-    }
-    DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
+    bool res = (_find(list, addr, addr_len) >= 0);
+    DEBUG("[l2filter] whitelist: %s -> packet %s\n",
+          res ? "address match" : "no match", res ? "passes" : "dropped");
 #else
-    bool res = true;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
-            res = false;
-            break;
-        }
-    }
-    DEBUG("[l2fitler] blacklist: no match -> packet passes\n");
+    bool res = (_find(list, addr, addr_len) < 0);
+    DEBUG("[l2filter] blacklist: %s -> packet %s\n",
+          res ? "no match" : "address match", res ? "passes" : "dropped");
 #endif
 
     return res;
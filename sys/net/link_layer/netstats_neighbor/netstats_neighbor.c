@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_netstats_neighbor
+ * @{
+ *
+ * @file
+ * @brief       Link statistics per neighbor implementation
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "assert.h"
+#include "net/netstats/neighbor.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _match(const netstats_nb_t *entry, const uint8_t *l2_addr,
+                          size_t l2_addr_len)
+{
+    return (entry->l2_addr_len == l2_addr_len) &&
+           (memcmp(entry->l2_addr, l2_addr, l2_addr_len) == 0);
+}
+
+/* free entries first, then the one updated least recently */
+static inline bool _replace_first(const netstats_nb_t *a, const netstats_nb_t *b,
+                                  uint32_t now)
+{
+    if (b->l2_addr_len == 0) {
+        return false;
+    }
+    return (a->l2_addr_len == 0) ||
+           ((now - a->last_updated) > (now - b->last_updated));
+}
+
+/* gets the entry of a neighbor, adding it if it is unknown */
+static netstats_nb_t *_get_or_add(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                                  size_t l2_addr_len, uint32_t now)
+{
+    netstats_nb_t *entry = NULL;
+
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        netstats_nb_t *tmp = &table->entries[i];
+
+        if (_match(tmp, l2_addr, l2_addr_len)) {
+            return tmp;
+        }
+        /* the result of the ongoing transmission must not go to a new
+         * neighbor */
+        if ((tmp != table->pending) &&
+            ((entry == NULL) || _replace_first(tmp, entry, now))) {
+            entry = tmp;
+        }
+    }
+    if (entry == NULL) {
+        return NULL;
+    }
+    DEBUG("netstats_nb: add neighbor (%u byte address)\n", (unsigned)l2_addr_len);
+    memset(entry, 0, sizeof(netstats_nb_t));
+    memcpy(entry->l2_addr, l2_addr, l2_addr_len);
+    entry->l2_addr_len = l2_addr_len;
+    entry->etx = NETSTATS_NB_ETX_INIT;
+    entry->last_updated = now;
+    return entry;
+}
+
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        size_t l2_addr_len)
+{
+    assert(table != NULL);
+    assert(l2_addr_len <= NETSTATS_NB_L2_ADDR_MAX);
+    table->pending = NULL;
+    if ((l2_addr == NULL) || (l2_addr_len == 0)) {
+        return;
+    }
+    table->pending = _get_or_add(table, l2_addr, l2_addr_len, _now());
+}
+
+void netstats_nb_update_tx(netstats_nb_table_t *table, netstats_nb_result_t result)
+{
+    netstats_nb_t *entry = table->pending;
+    uint32_t sample;
+
+    table->pending = NULL;
+    if ((entry == NULL) || (result == NETSTATS_NB_BUSY)) {
+        return;
+    }
+    entry->tx_count++;
+    if (result == NETSTATS_NB_SUCCESS) {
+        sample = NETSTATS_NB_ETX_DIVISOR;
+    }
+    else {
+        entry->tx_failed++;
+        sample = NETSTATS_NB_ETX_NOACK_PENALTY;
+    }
+    entry->etx = (uint16_t)((((uint32_t)entry->etx * (100U - NETSTATS_NB_ETX_ALPHA)) +
+                             (sample * NETSTATS_NB_ETX_ALPHA)) / 100U);
+    entry->last_updated = _now();
+    DEBUG("netstats_nb: ETX %u/%u after %s\n", (unsigned)entry->etx,
+          NETSTATS_NB_ETX_DIVISOR, (result == NETSTATS_NB_SUCCESS) ? "ACK" : "no ACK");
+}
+
+/* rounds towards the sample, so the average reaches a constant sample */
+static inline uint8_t _ewma(uint8_t avg, uint8_t sample)
+{
+    int delta = ((int)sample - avg) * (int)NETSTATS_NB_RX_ALPHA;
+
+    delta += (delta > 0) ? 99 : ((delta < 0) ? -99 : 0);
+    return (uint8_t)(avg + (delta / 100));
+}
+
+void netstats_nb_update_rx(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                           size_t l2_addr_len, uint8_t rssi, uint8_t lqi)
+{
+    netstats_nb_t *entry;
+    uint32_t now = _now();
+
+    assert(table != NULL);
+    assert(l2_addr_len <= NETSTATS_NB_L2_ADDR_MAX);
+    if ((l2_addr == NULL) || (l2_addr_len == 0)) {
+        return;
+    }
+    if ((entry = _get_or_add(table, l2_addr, l2_addr_len, now)) == NULL) {
+        return;
+    }
+    if (entry->rx_count == 0) {
+        entry->rssi = rssi;
+        entry->lqi = lqi;
+    }
+    else {
+        entry->rssi = _ewma(entry->rssi, rssi);
+        entry->lqi = _ewma(entry->lqi, lqi);
+    }
+    entry->rx_count++;
+    entry->last_seen = now;
+    entry->last_updated = now;
+}
+
+const netstats_nb_t *netstats_nb_get(const netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, size_t l2_addr_len)
+{
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        if (_match(&table->entries[i], l2_addr, l2_addr_len)) {
+            return &table->entries[i];
+        }
+    }
+    return NULL;
+}
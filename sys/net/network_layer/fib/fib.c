@@ -65,6 +65,333 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief returns the byte at index @p idx of the key (size byte followed by
+ *        the address) of an address
+ */
+static inline uint8_t fib_trie_byte(uint8_t size, const uint8_t *addr, unsigned idx)
+{
+    return (idx == 0) ? size : addr[idx - 1];
+}
+
+/**
+ * @brief returns the bit at position @p pos of the key of an address
+ */
+static inline unsigned fib_trie_bit(uint8_t size, const uint8_t *addr, unsigned pos)
+{
+    return (fib_trie_byte(size, addr, pos >> 3) >> (7 - (pos & 7))) & 0x01;
+}
+
+/**
+ * @brief returns the first bit position in [@p from, @p to) in which the keys
+ *        of two addresses differ, or @p to if they are equal in that range
+ */
+static unsigned fib_trie_diff(uint8_t size_a, const uint8_t *a,
+                              uint8_t size_b, const uint8_t *b,
+                              unsigned from, unsigned to)
+{
+    unsigned pos = from;
+
+    while (pos < to) {
+        /* compare whole bytes where possible */
+        if (((pos & 7) == 0) && ((pos + 8) <= to) &&
+            (fib_trie_byte(size_a, a, pos >> 3) == fib_trie_byte(size_b, b, pos >> 3))) {
+            pos += 8;
+            continue;
+        }
+        if (fib_trie_bit(size_a, a, pos) != fib_trie_bit(size_b, b, pos)) {
+            return pos;
+        }
+        pos++;
+    }
+    return to;
+}
+
+/**
+ * @brief returns the key length in bits for the destination of an entry
+ *
+ * The all zero address is the default route, i.e. matches every address of
+ * its size. Entries without a prefix length only match their address.
+ */
+static unsigned fib_trie_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned bits = global->address_size << 3;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < global->address_size; i++) {
+        if (global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+    if (is_all_zeros_addr) {
+        bits = 0;
+    }
+    else if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                              >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix_len < bits) {
+            bits = prefix_len;
+        }
+    }
+    return bits + 8;
+}
+
+static fib_trie_node_t *fib_trie_node_alloc(fib_table_t *table)
+{
+    for (size_t i = 0; i < FIB_TRIE_NODES_NUMOF(table->size); i++) {
+        fib_trie_node_t *node = &table->trie_nodes[i];
+
+        /* only unused nodes have neither an entry nor children */
+        if ((node->entry == NULL) && (node->child[0] == NULL) &&
+            (node->child[1] == NULL) && (node->same == NULL)) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief returns some entry of the subtree below @p node
+ */
+static fib_entry_t *fib_trie_any_entry(fib_trie_node_t *node)
+{
+    /* branching nodes always have two children */
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+    return node->entry;
+}
+
+/**
+ * @brief adds an entry to the index
+ *
+ * @return 0 on success
+ *         -ENOMEM if the node pool is exhausted
+ */
+static int fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t size = entry->global->address_size;
+    uint8_t *addr = entry->global->address;
+    unsigned len = fib_trie_len(entry);
+    fib_trie_node_t **link = &table->trie_root;
+    fib_trie_node_t *node = table->trie_root, *leaf, *branch;
+    universal_address_container_t *other;
+    unsigned diff = 0;
+
+    if (table->trie_nodes == NULL) {
+        return 0;
+    }
+
+    if (node != NULL) {
+        /* walk down as far as the key reaches to find a key to compare with */
+        while (node->len < len) {
+            fib_trie_node_t *next = node->child[fib_trie_bit(size, addr, node->len)];
+            if (next == NULL) {
+                break;
+            }
+            node = next;
+        }
+        other = fib_trie_any_entry(node)->global;
+        diff = fib_trie_diff(size, addr, other->address_size, other->address, 0,
+                             (len < node->len) ? len : node->len);
+
+        /* walk down again to the first node that does not share the first
+         * diff bits with the key */
+        node = table->trie_root;
+        while ((node != NULL) && (node->len < diff)) {
+            link = &node->child[fib_trie_bit(size, addr, node->len)];
+            node = *link;
+        }
+
+        if ((node != NULL) && (node->len == len) && (diff == len) &&
+            (node->entry == NULL)) {
+            /* branching node for exactly this prefix */
+            node->entry = entry;
+            return 0;
+        }
+    }
+
+    if ((leaf = fib_trie_node_alloc(table)) == NULL) {
+        return -ENOMEM;
+    }
+    leaf->entry = entry;
+    leaf->len = len;
+
+    if (node == NULL) {
+        *link = leaf;
+    }
+    else if ((node->len == len) && (diff == len)) {
+        /* same prefix, different address */
+        leaf->same = node->same;
+        node->same = leaf;
+    }
+    else if (node->len == diff) {
+        /* the key continues below node where there is no subtree yet */
+        node->child[fib_trie_bit(size, addr, diff)] = leaf;
+    }
+    else if (diff == len) {
+        /* the key is a prefix of node */
+        leaf->child[fib_trie_bit(other->address_size, other->address, len)] = node;
+        *link = leaf;
+    }
+    else {
+        /* key and node branch off at diff */
+        if ((branch = fib_trie_node_alloc(table)) == NULL) {
+            leaf->entry = NULL;
+            return -ENOMEM;
+        }
+        branch->len = diff;
+        branch->child[fib_trie_bit(size, addr, diff)] = leaf;
+        branch->child[fib_trie_bit(other->address_size, other->address, diff)] = node;
+        *link = branch;
+    }
+    return 0;
+}
+
+/**
+ * @brief removes an entry from the index
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t size = entry->global->address_size;
+    uint8_t *addr = entry->global->address;
+    unsigned len = fib_trie_len(entry);
+    fib_trie_node_t **link = &table->trie_root, **parent_link = NULL;
+    fib_trie_node_t *node;
+
+    if (table->trie_nodes == NULL) {
+        return;
+    }
+
+    while (((node = *link) != NULL) && (node->len < len)) {
+        parent_link = link;
+        link = &node->child[fib_trie_bit(size, addr, node->len)];
+    }
+    if ((node == NULL) || (node->len != len)) {
+        return;
+    }
+    if (node->entry != entry) {
+        /* search the entries with the same prefix */
+        for (fib_trie_node_t **same = &node->same; *same != NULL; same = &(*same)->same) {
+            if ((*same)->entry == entry) {
+                fib_trie_node_t *tmp = *same;
+
+                *same = tmp->same;
+                memset(tmp, 0, sizeof(fib_trie_node_t));
+                return;
+            }
+        }
+        return;
+    }
+    if (node->same != NULL) {
+        /* move the next entry with the same prefix up */
+        fib_trie_node_t *tmp = node->same;
+
+        node->entry = tmp->entry;
+        node->same = tmp->same;
+        memset(tmp, 0, sizeof(fib_trie_node_t));
+        return;
+    }
+    node->entry = NULL;
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* node stays as branching node */
+        return;
+    }
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    memset(node, 0, sizeof(fib_trie_node_t));
+
+    if ((*link == NULL) && (parent_link != NULL) && ((*parent_link)->entry == NULL)) {
+        /* the parent is a branching node with only one subtree left */
+        node = *parent_link;
+        *parent_link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+        memset(node, 0, sizeof(fib_trie_node_t));
+    }
+}
+
+/**
+ * @brief returns the entry with the longest prefix matching @p dst
+ *
+ * An entry with exactly the address @p dst is preferred, as in
+ * fib_find_entry(). Expired entries are skipped, the first one found is
+ * removed.
+ *
+ * @return the matching entry
+ *         NULL if there is none
+ */
+static fib_entry_t *fib_trie_lookup(fib_table_t *table, uint8_t *dst, size_t dst_size)
+{
+    uint64_t now = xtimer_now_usec64();
+    fib_trie_node_t *node = table->trie_root;
+    fib_entry_t *best = NULL, *expired = NULL;
+    unsigned checked = 0, bits = (dst_size << 3) + 8;
+    bool exact = false;
+
+    if (dst_size > UNIVERSAL_ADDRESS_SIZE) {
+        return NULL;
+    }
+
+    while ((node != NULL) && (node->len <= bits)) {
+        if (node->entry != NULL) {
+            fib_entry_t *entry = node->entry;
+            universal_address_container_t *global = entry->global;
+
+            /* all keys below node share its first len bits, so when they
+             * don't match dst there is no better entry */
+            if (fib_trie_diff(dst_size, dst, global->address_size, global->address,
+                              checked, node->len) < node->len) {
+                break;
+            }
+            checked = node->len;
+            entry = NULL;
+            for (fib_trie_node_t *same = node; same != NULL; same = same->same) {
+                if ((same->entry->lifetime != FIB_LIFETIME_NO_EXPIRE) &&
+                    (same->entry->lifetime < now)) {
+                    if (expired == NULL) {
+                        expired = same->entry;
+                    }
+                }
+                else if ((node->len == bits) ||
+                         (memcmp(same->entry->global->address, dst, dst_size) == 0)) {
+                    /* exact match */
+                    entry = same->entry;
+                    exact = true;
+                    break;
+                }
+                else if (entry == NULL) {
+                    entry = same->entry;
+                }
+            }
+            if (entry != NULL) {
+                best = entry;
+            }
+            if (exact) {
+                break;
+            }
+        }
+        if (node->len == bits) {
+            break;
+        }
+        node = node->child[fib_trie_bit(dst_size, dst, node->len)];
+    }
+
+    if (expired != NULL) {
+        fib_remove(table, expired);
+    }
+
+#if ENABLE_DEBUG
+    if (best != NULL) {
+        DEBUG("[fib_trie_lookup] found prefix on interface %d\n", best->iface_id);
+    }
+#endif
+    return best;
+}
+#endif /* MODULE_FIB_TRIE */
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -112,20 +439,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
             /* check if the lifetime expired */
             if (table->data.entries[i].lifetime < now) {
                 /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
+                fib_remove(table, &table->data.entries[i]);
             }
         }
 
@@ -268,6 +582,12 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_TRIE
+                if (fib_trie_insert(table, &table->data.entries[i]) < 0) {
+                    fib_remove(table, &table->data.entries[i]);
+                    return -ENOMEM;
+                }
+#endif
                 return 0;
             }
         }
@@ -279,14 +599,19 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table holding the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
     if (entry->global != NULL) {
+#ifdef MODULE_FIB_TRIE
+        fib_trie_remove(table, entry);
+#endif
         universal_address_rem(entry->global);
+        table->gen++;
     }
 
     if (entry->next_hop) {
@@ -409,6 +734,7 @@ int fib_add_entry(fib_table_t *table,
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
                                next_hop, next_hop_size, next_hop_flags, lifetime);
     }
+    table->gen++;
 
     mutex_unlock(&(table->mtx_access));
     return ret;
@@ -434,6 +760,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        table->gen++;
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +784,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,13 +804,35 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
     mutex_unlock(&(table->mtx_access));
 }
 
+/**
+ * @brief returns the entry to route to the given destination address
+ *
+ * Uses the longest-prefix-match index of the table if there is one and
+ * fib_find_entry() otherwise.
+ *
+ * @return 0 or 1 if a next-hop is found
+ *         -EHOSTUNREACH if no fitting next-hop is available
+ */
+static int fib_lookup(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                      fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+#ifdef MODULE_FIB_TRIE
+    if (table->trie_nodes != NULL) {
+        entry_arr[0] = fib_trie_lookup(table, dst, dst_size);
+        *entry_arr_size = (entry_arr[0] != NULL) ? 1 : 0;
+        return (entry_arr[0] != NULL) ? 0 : -EHOSTUNREACH;
+    }
+#endif
+    return fib_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+}
+
 int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
                      uint8_t *next_hop, size_t *next_hop_size,
                      uint32_t *next_hop_flags, uint8_t *dst, size_t dst_size,
@@ -506,14 +855,14 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
         return -EFAULT;
     }
 
-    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+    int ret = fib_lookup(table, dst, dst_size, &(entry[0]), &count);
     if (!(ret == 0 || ret == 1)) {
         /* notify all responsible RPs for unknown  next-hop for the destination address */
         if (fib_signal_rp(table, FIB_MSG_RP_SIGNAL_UNREACHABLE_DESTINATION,
                           dst, dst_size, dst_flags) == 0) {
             count = 1;
             /* now lets see if the RRPs have found a valid next-hop */
-            ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+            ret = fib_lookup(table, dst, dst_size, &(entry[0]), &count);
         }
     }
 
@@ -596,7 +945,15 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        if (table->trie_nodes != NULL) {
+            memset(table->trie_nodes, 0,
+                   FIB_TRIE_NODES_NUMOF(table->size) * sizeof(fib_trie_node_t));
+        }
+        table->trie_root = NULL;
+#endif
     }
+    table->gen++;
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -621,7 +978,15 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        if (table->trie_nodes != NULL) {
+            memset(table->trie_nodes, 0,
+                   FIB_TRIE_NODES_NUMOF(table->size) * sizeof(fib_trie_node_t));
+        }
+        table->trie_root = NULL;
+#endif
     }
+    table->gen++;
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
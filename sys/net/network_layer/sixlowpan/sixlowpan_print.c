@@ -61,6 +61,30 @@ void sixlowpan_print(uint8_t *data, size_t size)
                     size - sizeof(sixlowpan_frag_n_t),
                     OD_WIDTH_DEFAULT);
     }
+    else if (sixlowpan_sfr_rfrag_is(data[0])) {
+        sixlowpan_sfr_rfrag_t *hdr = (sixlowpan_sfr_rfrag_t *)data;
+
+        puts("Recoverable Fragment Header");
+        printf("tag: 0x%02x\n", (unsigned)hdr->tag);
+        printf("sequence: %u%s\n", sixlowpan_sfr_rfrag_get_seq(hdr),
+               sixlowpan_sfr_rfrag_ack_req(hdr) ? " (ACK requested)" : "");
+        printf("fragment size: %u\n",
+               (unsigned)sixlowpan_sfr_rfrag_get_frag_size(hdr));
+        printf("%s: %u\n",
+               (sixlowpan_sfr_rfrag_get_seq(hdr) == 0) ? "datagram size" : "offset",
+               (unsigned)byteorder_ntohs(hdr->offset));
+
+        od_hex_dump(data + sizeof(sixlowpan_sfr_rfrag_t),
+                    size - sizeof(sixlowpan_sfr_rfrag_t),
+                    OD_WIDTH_DEFAULT);
+    }
+    else if (sixlowpan_sfr_ack_is(data[0])) {
+        sixlowpan_sfr_ack_t *hdr = (sixlowpan_sfr_ack_t *)data;
+
+        puts("Recoverable Fragment Acknowledgment");
+        printf("tag: 0x%02x\n", (unsigned)hdr->tag);
+        printf("bitmap: 0x%08" PRIx32 "\n", byteorder_ntohl(hdr->bitmap));
+    }
     else if ((data[0] & SIXLOWPAN_IPHC1_DISP_MASK) == SIXLOWPAN_IPHC1_DISP) {
         uint8_t offset = SIXLOWPAN_IPHC_HDR_LEN;
         puts("IPHC dispatch");
@@ -164,7 +164,7 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_SYMMETRIC,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_SYM;
+                                    nhdp_set_addr_tmp(addr_elt->address, NHDP_ADDR_TMP_SYM);
                                     break;
 
                                 case IIB_LT_STATUS_HEARD:
@@ -173,7 +173,7 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_HEARD,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                                    nhdp_set_addr_tmp(addr_elt->address, NHDP_ADDR_TMP_ANY);
                                     break;
 
                                 case IIB_LT_STATUS_UNKNOWN:
@@ -185,7 +185,7 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_LOST,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                                    nhdp_set_addr_tmp(addr_elt->address, NHDP_ADDR_TMP_ANY);
                                     break;
 
                                 case IIB_LT_STATUS_PENDING:
@@ -659,7 +659,7 @@ static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t
         }
 
         /* Add a new entry for every signaled symmetric neighbor address */
-        LL_FOREACH(nhdp_get_addr_db_head(), addr_elt) {
+        LL_FOREACH2(nhdp_get_tmp_addr_head(), addr_elt, tmp_next) {
             if (NHDP_ADDR_TMP_IN_TH_SYM_LIST(addr_elt)) {
                 if (add_two_hop_entry(base_entry, ls_entry, addr_elt, now, val_time)) {
                     /* No more memory available, return error */
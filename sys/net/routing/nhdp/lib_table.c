@@ -111,7 +111,7 @@ void lib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                 nhdp_writer_add_addr(wr, add_tmp->address,
                                      RFC5444_ADDRTLV_LOCAL_IF, RFC5444_LOCALIF_THIS_IF,
                                      NHDP_METRIC_UNKNOWN, NHDP_METRIC_UNKNOWN);
-                add_tmp->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                nhdp_set_addr_tmp(add_tmp->address, NHDP_ADDR_TMP_ANY);
             }
             break;
         }
@@ -127,7 +127,7 @@ void lib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                     nhdp_writer_add_addr(wr, add_tmp->address,
                                          RFC5444_ADDRTLV_LOCAL_IF, RFC5444_LOCALIF_OTHER_IF,
                                          NHDP_METRIC_UNKNOWN, NHDP_METRIC_UNKNOWN);
-                    add_tmp->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                    nhdp_set_addr_tmp(add_tmp->address, NHDP_ADDR_TMP_ANY);
                 }
             }
         }
@@ -26,7 +26,11 @@
 
 /* Internal variables */
 static mutex_t mtx_addr_access = MUTEX_INIT;
-static nhdp_addr_t *nhdp_addr_db_head = NULL;
+static nhdp_addr_t *nhdp_addr_db[NHDP_ADDR_DB_BUCKETS];
+static nhdp_addr_t *nhdp_tmp_addr_head = NULL;
+
+/* Internal function prototypes */
+static nhdp_addr_t **get_bucket(uint8_t *addr, size_t addr_size);
 
 
 /*---------------------------------------------------------------------------*
@@ -35,11 +39,12 @@ static nhdp_addr_t *nhdp_addr_db_head = NULL;
 
 nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t addr_type)
 {
+    nhdp_addr_t **bucket = get_bucket(addr, addr_size);
     nhdp_addr_t *addr_elt;
 
     mutex_lock(&mtx_addr_access);
 
-    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+    LL_FOREACH(*bucket, addr_elt) {
         if ((addr_elt->addr_size == addr_size) && (addr_elt->addr_type == addr_type)) {
             if (memcmp(addr_elt->addr, addr, addr_size) == 0) {
                 /* Found a matching entry */
@@ -54,6 +59,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
 
         if (!addr_elt) {
             /* Insufficient memory */
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -63,6 +69,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         if (!addr_elt->addr) {
             /* Insufficient memory */
             free(addr_elt);
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -72,7 +79,9 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         addr_elt->usg_count = 0;
         addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
         addr_elt->tmp_metric_val = NHDP_METRIC_UNKNOWN;
-        LL_PREPEND(nhdp_addr_db_head, addr_elt);
+        addr_elt->nb_entry = NULL;
+        addr_elt->tmp_next = NULL;
+        LL_PREPEND(*bucket, addr_elt);
     }
 
     addr_elt->usg_count++;
@@ -91,7 +100,10 @@ void nhdp_decrement_addr_usage(nhdp_addr_t *addr)
         addr->usg_count--;
         if (addr->usg_count == 0) {
             /* Free address space if address is no longer used */
-            LL_DELETE(nhdp_addr_db_head, addr);
+            LL_DELETE(*get_bucket(addr->addr, addr->addr_size), addr);
+            if (addr->in_tmp_table) {
+                LL_DELETE2(nhdp_tmp_addr_head, addr, tmp_next);
+            }
             free(addr->addr);
             free(addr);
         }
@@ -114,13 +126,24 @@ void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry)
     free(addr_entry);
 }
 
+void nhdp_set_addr_tmp(nhdp_addr_t *addr, uint8_t tmp_type)
+{
+    if (!addr->in_tmp_table && tmp_type) {
+        LL_PREPEND2(nhdp_tmp_addr_head, addr, tmp_next);
+    }
+    else if (addr->in_tmp_table && !tmp_type) {
+        LL_DELETE2(nhdp_tmp_addr_head, addr, tmp_next);
+    }
+    addr->in_tmp_table = tmp_type;
+}
+
 nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type)
 {
     nhdp_addr_entry_t *new_list_head;
     nhdp_addr_t *addr_elt;
 
     new_list_head = NULL;
-    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+    LL_FOREACH2(nhdp_tmp_addr_head, addr_elt, tmp_next) {
         if (addr_elt->in_tmp_table & tmp_type) {
             nhdp_addr_entry_t *new_entry = (nhdp_addr_entry_t *) malloc(sizeof(nhdp_addr_entry_t));
 
@@ -144,18 +167,42 @@ void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg)
 {
     nhdp_addr_t *addr_elt, *addr_tmp;
 
-    LL_FOREACH_SAFE(nhdp_addr_db_head, addr_elt, addr_tmp) {
+    /* Detach the list first, so no address is removed from it while walking it */
+    addr_elt = nhdp_tmp_addr_head;
+    nhdp_tmp_addr_head = NULL;
+
+    while (addr_elt) {
+        addr_tmp = addr_elt->tmp_next;
+        addr_elt->tmp_next = NULL;
         addr_elt->tmp_metric_val = NHDP_METRIC_UNKNOWN;
-        if (addr_elt->in_tmp_table) {
-            addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
-            if (decr_usg) {
-                nhdp_decrement_addr_usage(addr_elt);
-            }
+        addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
+        if (decr_usg) {
+            nhdp_decrement_addr_usage(addr_elt);
         }
+        addr_elt = addr_tmp;
     }
 }
 
-nhdp_addr_t *nhdp_get_addr_db_head(void)
+nhdp_addr_t *nhdp_get_tmp_addr_head(void)
 {
-    return nhdp_addr_db_head;
+    return nhdp_tmp_addr_head;
+}
+
+
+/*------------------------------------------------------------------------------------*/
+/*                                Internal functions                                  */
+/*------------------------------------------------------------------------------------*/
+
+/**
+ * Get the hash bucket of the central address storage for the given address (FNV-1a)
+ */
+static nhdp_addr_t **get_bucket(uint8_t *addr, size_t addr_size)
+{
+    uint32_t hash = 2166136261UL;
+
+    for (size_t i = 0; i < addr_size; i++) {
+        hash = (hash ^ addr[i]) * 16777619UL;
+    }
+
+    return &nhdp_addr_db[hash % NHDP_ADDR_DB_BUCKETS];
 }
@@ -23,6 +23,18 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets of the central address storage
+ *
+ * Lookups only compare the addresses of one bucket, so this should be in the
+ * order of the number of addresses known by the node.
+ */
+#ifndef NHDP_ADDR_DB_BUCKETS
+#define NHDP_ADDR_DB_BUCKETS        (16)
+#endif
+
+struct nib_entry;
+
 /**
  * @brief   NHDP address representation
  */
@@ -33,7 +45,9 @@ typedef struct nhdp_addr {
     uint8_t usg_count;                  /**< Usage count in information bases */
     uint8_t in_tmp_table;               /**< Signals usage in a writers temp table */
     uint16_t tmp_metric_val;            /**< Encoded metric value used during HELLO processing */
+    struct nib_entry *nb_entry;         /**< Neighbor Tuple holding this address, if any */
     struct nhdp_addr *next;             /**< Pointer to next address (used in central storage) */
+    struct nhdp_addr *tmp_next;         /**< Pointer to next address with in_tmp_table set */
 } nhdp_addr_t;
 
 /**
@@ -107,6 +121,18 @@ void nhdp_free_addr_list(nhdp_addr_entry_t *list_head);
  */
 void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry);
 
+/**
+ * @brief                   Set the in_tmp_table flags of a NHDP address
+ *
+ * Addresses with flags set are kept in a list, so the temporary tables can be
+ * processed and reset without walking all known addresses. The flags must only
+ * be written through this function.
+ *
+ * @param[in] addr          Pointer to the NHDP address
+ * @param[in] tmp_type      New value of the address' in_tmp_table flags
+ */
+void nhdp_set_addr_tmp(nhdp_addr_t *addr, uint8_t tmp_type);
+
 /**
  * @brief                   Construct an addr list containing all addresses with
  *                          the given tmp_type
@@ -117,7 +143,7 @@ void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry);
 nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type);
 
 /**
- * @brief                   Reset in_tmp_table flag of all NHDP addresses
+ * @brief                   Reset in_tmp_table flag of all NHDP addresses that have it set
  *
  * @note
  * Must not be called from outside the NHDP writer's or reader's message creation process.
@@ -127,12 +153,15 @@ nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type);
 void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg);
 
 /**
- * @brief                   Get a pointer to the head of the address storage list
+ * @brief                   Get a pointer to the head of the list of addresses
+ *                          with in_tmp_table set
+ *
+ * The list is linked by the tmp_next member of the addresses.
  *
- * @return                  Pointer to the head of the central storage address list
- * @return                  NULL if no addresses are registered
+ * @return                  Pointer to the head of the temporary address list
+ * @return                  NULL if no address is in a temporary table
  */
-nhdp_addr_t *nhdp_get_addr_db_head(void);
+nhdp_addr_t *nhdp_get_tmp_addr_head(void);
 
 #ifdef __cplusplus
 }
@@ -185,11 +185,11 @@ _nhdp_blocktlv_address_cb(struct rfc5444_reader_tlvblock_context *cont)
     if (_nhdp_addr_tlvs[RFC5444_ADDRTLV_LOCAL_IF].tlv) {
         switch (*_nhdp_addr_tlvs[RFC5444_ADDRTLV_LOCAL_IF].tlv->single_value) {
             case RFC5444_LOCALIF_THIS_IF:
-                current_addr->in_tmp_table = NHDP_ADDR_TMP_SEND_LIST;
+                nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_SEND_LIST);
                 break;
 
             case RFC5444_LOCALIF_OTHER_IF:
-                current_addr->in_tmp_table = NHDP_ADDR_TMP_NB_LIST;
+                nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_NB_LIST);
                 break;
 
             default:
@@ -240,7 +240,7 @@ _nhdp_blocktlv_address_cb(struct rfc5444_reader_tlvblock_context *cont)
         switch (*_nhdp_addr_tlvs[RFC5444_ADDRTLV_LINK_STATUS].tlv->single_value) {
             case RFC5444_LINKSTATUS_SYMMETRIC:
                 add_temp_metric_value(current_addr);
-                current_addr->in_tmp_table = NHDP_ADDR_TMP_TH_SYM_LIST;
+                nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_TH_SYM_LIST);
                 break;
 
             case RFC5444_LINKSTATUS_HEARD:
@@ -252,10 +252,10 @@ _nhdp_blocktlv_address_cb(struct rfc5444_reader_tlvblock_context *cont)
                     == RFC5444_OTHERNEIGHB_SYMMETRIC) {
                     /* Symmetric has higher priority */
                     add_temp_metric_value(current_addr);
-                    current_addr->in_tmp_table = NHDP_ADDR_TMP_TH_SYM_LIST;
+                    nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_TH_SYM_LIST);
                 }
                 else {
-                    current_addr->in_tmp_table = NHDP_ADDR_TMP_TH_REM_LIST;
+                    nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_TH_REM_LIST);
                 }
 
                 break;
@@ -270,11 +270,11 @@ _nhdp_blocktlv_address_cb(struct rfc5444_reader_tlvblock_context *cont)
         switch (*_nhdp_addr_tlvs[RFC5444_ADDRTLV_OTHER_NEIGHB].tlv->single_value) {
             case RFC5444_OTHERNEIGHB_SYMMETRIC:
                 add_temp_metric_value(current_addr);
-                current_addr->in_tmp_table = NHDP_ADDR_TMP_TH_SYM_LIST;
+                nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_TH_SYM_LIST);
                 break;
 
             case RFC5444_OTHERNEIGHB_LOST:
-                current_addr->in_tmp_table = NHDP_ADDR_TMP_TH_REM_LIST;
+                nhdp_set_addr_tmp(current_addr, NHDP_ADDR_TMP_TH_REM_LIST);
                 break;
 
             default:
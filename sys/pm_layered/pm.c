@@ -18,10 +18,17 @@
  * @}
  */
 
+#include <string.h>
+
 #include "irq.h"
 #include "periph/pm.h"
 #include "pm_layered.h"
 
+#if (defined(MODULE_XTIMER) && defined(PM_WAKEUP_LATENCY_US)) || \
+    defined(MODULE_PM_LAYERED_STATS)
+#include "xtimer.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -46,6 +53,128 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#if defined(MODULE_XTIMER) && defined(PM_WAKEUP_LATENCY_US)
+/**
+ * @brief Wakeup latency of each power mode in microseconds
+ */
+static const uint32_t _wakeup_latency[PM_NUM_MODES] = PM_WAKEUP_LATENCY_US;
+
+/**
+ * @brief Skip modes that could not wake up before the next xtimer deadline
+ *
+ * Must be called with interrupts disabled.
+ */
+static unsigned _fit_next_deadline(unsigned mode)
+{
+    uint32_t left = xtimer_usec_from_ticks(xtimer_time_to_next_event());
+
+    while ((mode < PM_NUM_MODES) && (_wakeup_latency[mode] >= left)) {
+        mode++;
+    }
+
+    return mode;
+}
+#else
+static inline unsigned _fit_next_deadline(unsigned mode)
+{
+    return mode;
+}
+#endif
+
+#ifdef MODULE_PM_LAYERED_STATS
+/**
+ * @brief Residency and wakeup statistics
+ */
+static pm_stats_t _stats;
+
+/**
+ * @brief Start of the time covered by the statistics, in microseconds
+ */
+static uint64_t _stats_since;
+
+unsigned __attribute__((weak)) pm_layered_wakeup_source(void)
+{
+    return PM_WAKEUP_UNKNOWN;
+}
+
+static void _count_wakeup(unsigned source)
+{
+    for (unsigned i = 0; i < PM_STATS_WAKEUP_SOURCES; i++) {
+        if (!_stats.wakeups[i].count || (_stats.wakeups[i].source == source)) {
+            _stats.wakeups[i].source = source;
+            _stats.wakeups[i].count++;
+            return;
+        }
+    }
+    _stats.wakeups_other++;
+}
+
+/* Must be called with interrupts disabled, so the interrupt that woke the
+ * CPU is still pending. */
+static void _set(unsigned mode)
+{
+    uint32_t left = xtimer_usec_from_ticks(xtimer_time_to_next_event());
+    uint64_t start = xtimer_now_usec64();
+
+    pm_set(mode);
+
+    uint64_t slept = xtimer_now_usec64() - start;
+
+    _stats.residency_us[mode] += slept;
+    _stats.entries[mode]++;
+    if (slept >= left) {
+        _stats.wakeups_timer++;
+    }
+    _count_wakeup(pm_layered_wakeup_source());
+}
+
+void pm_stats_get(pm_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    stats->total_us = xtimer_now_usec64() - _stats_since;
+    irq_restore(state);
+}
+
+void pm_stats_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(&_stats, 0, sizeof(_stats));
+    _stats_since = xtimer_now_usec64();
+    irq_restore(state);
+}
+
+#ifdef PM_CURRENT_UA
+/**
+ * @brief Current drawn in each power mode, the idle mode and while running,
+ *        in microampere
+ */
+static const uint32_t _current[PM_NUM_MODES + 2] = PM_CURRENT_UA;
+
+uint64_t pm_stats_energy_uj(const pm_stats_t *stats)
+{
+    uint64_t sleeping = 0;
+    uint64_t charge_nc = 0;
+
+    for (unsigned mode = 0; mode <= PM_NUM_MODES; mode++) {
+        charge_nc += (_current[mode] * stats->residency_us[mode]) / 1000;
+        sleeping += stats->residency_us[mode];
+    }
+    if (stats->total_us > sleeping) {
+        charge_nc += (_current[PM_NUM_MODES + 1] *
+                      (stats->total_us - sleeping)) / 1000;
+    }
+
+    return (charge_nc * PM_SUPPLY_MV) / 1000000;
+}
+#endif
+#else
+static inline void _set(unsigned mode)
+{
+    pm_set(mode);
+}
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = (pm_blocker_t) pm_blocker;
@@ -60,8 +189,9 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+        mode = _fit_next_deadline(mode);
         DEBUG("pm: setting mode %u\n", mode);
-        pm_set(mode);
+        _set(mode);
     }
     else {
         DEBUG("pm: mode block changed\n");
@@ -90,6 +220,9 @@ void pm_unblock(unsigned mode)
 void __attribute__((weak)) pm_off(void)
 {
     pm_blocker.val_u32 = 0;
-    pm_set_lowest();
+    /* don't use pm_set_lowest() here, as it might pick a higher mode to
+     * honor a pending timer */
+    irq_disable();
+    pm_set(0);
     while(1);
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    posix_poll  POSIX poll and select
+ * @ingroup     posix
+ * @brief       Waits for readiness of several file descriptors at once
+ *
+ * The (pseudo-)module `posix_poll` provides `poll()` and `select()` over VFS
+ * file descriptors, e.g. sockets of @ref posix_sockets. A file descriptor
+ * whose driver does not implement vfs_file_ops::poll is always ready.
+ *
+ * @note    Only one thread can wait for a file descriptor at a time.
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *          The Open Group Base Specification Issue 7, poll.h
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief   POSIX compatible poll.h definitions
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#ifndef DOXYGEN
+#if defined(CPU_NATIVE) || MODULE_NEWLIB
+/* If building on native or newlib we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Events for pollfd::events and pollfd::revents
+ * @{
+ */
+#define POLLIN      VFS_POLLIN      /**< data may be read without blocking */
+#define POLLRDNORM  VFS_POLLIN      /**< normal data may be read */
+#define POLLOUT     VFS_POLLOUT     /**< data may be written without blocking */
+#define POLLWRNORM  VFS_POLLOUT     /**< normal data may be written */
+#define POLLERR     VFS_POLLERR     /**< an error occurred (revents only) */
+#define POLLHUP     VFS_POLLHUP     /**< the peer hung up (revents only) */
+#define POLLNVAL    (0x0020)        /**< invalid file descriptor (revents only) */
+/** @} */
+
+typedef unsigned int nfds_t;    /**< number of file descriptors */
+
+/**
+ * @brief   A file descriptor to poll
+ */
+struct pollfd {
+    int fd;                     /**< the file descriptor, ignored if < 0 */
+    short events;               /**< the events to wait for */
+    short revents;              /**< the events that happened */
+};
+
+/**
+ * @brief   Waits for events on several file descriptors
+ *
+ * @param[in,out] fds   the file descriptors
+ * @param[in] nfds      number of elements in @p fds
+ * @param[in] timeout   timeout in milliseconds, -1 to wait forever
+ *
+ * @return  number of elements of @p fds with pollfd::revents != 0
+ * @return  0 if @p timeout expired
+ * @return  -1 on error, errno is set accordingly
+ */
+int poll(struct pollfd *fds, nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE || MODULE_NEWLIB */
+#endif /* DOXYGEN */
+/** @} */
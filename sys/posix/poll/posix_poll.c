@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   poll() and select() over VFS file descriptors
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include "sched.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "timex.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static void _timeout_cb(void *arg)
+{
+    thread_flags_set(arg, THREAD_FLAG_TIMEOUT);
+}
+
+/**
+ * @brief   Checks all @p fds and fills their pollfd::revents
+ *
+ * @return  number of elements of @p fds with pollfd::revents != 0
+ */
+static int _poll_fds(struct pollfd *fds, nfds_t nfds, kernel_pid_t waiter)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        int res;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        res = vfs_poll(fds[i].fd, (unsigned)fds[i].events, waiter);
+        if (res < 0) {
+            fds[i].revents = POLLNVAL;
+        }
+        else {
+            /* errors and hang-ups are reported even if not asked for */
+            fds[i].revents = res & (fds[i].events | POLLERR | POLLHUP);
+        }
+        if (fds[i].revents != 0) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    xtimer_t timer = { .callback = _timeout_cb,
+                       .arg = (void *)sched_active_thread };
+    kernel_pid_t waiter = (timeout != 0) ? sched_active_pid : KERNEL_PID_UNDEF;
+    int ready;
+
+    if ((fds == NULL) && (nfds > 0)) {
+        errno = EFAULT;
+        return -1;
+    }
+    thread_flags_clear(VFS_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    if (timeout > 0) {
+        xtimer_set(&timer, (uint32_t)timeout * US_PER_MS);
+    }
+    /* drivers wake us with a thread flag, so readiness that shows between
+     * checking and waiting is not lost */
+    while (((ready = _poll_fds(fds, nfds, waiter)) == 0) && (timeout != 0)) {
+        thread_flags_t flags = thread_flags_wait_any(VFS_POLL_THREAD_FLAG |
+                                                     THREAD_FLAG_TIMEOUT);
+
+        if (flags & THREAD_FLAG_TIMEOUT) {
+            DEBUG("poll: timeout\n");
+            waiter = KERNEL_PID_UNDEF;
+            timeout = 0;
+        }
+    }
+    if (waiter != KERNEL_PID_UNDEF) {
+        /* remove this thread as waiter again */
+        for (nfds_t i = 0; i < nfds; i++) {
+            if (fds[i].fd >= 0) {
+                vfs_poll(fds[i].fd, 0, KERNEL_PID_UNDEF);
+            }
+        }
+    }
+    xtimer_remove(&timer);
+    thread_flags_clear(VFS_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    return ready;
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    struct pollfd fds[VFS_MAX_OPEN_FILES];
+    nfds_t numof = 0;
+    int ms = -1, res;
+
+    if ((nfds < 0) || (nfds > VFS_MAX_OPEN_FILES) ||
+        ((timeout != NULL) && ((timeout->tv_sec < 0) || (timeout->tv_usec < 0)))) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+
+        if ((readfds != NULL) && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if ((writefds != NULL) && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        if ((events != 0) || ((errorfds != NULL) && FD_ISSET(fd, errorfds))) {
+            fds[numof].fd = fd;
+            fds[numof].events = events;
+            numof++;
+        }
+    }
+    if (timeout != NULL) {
+        /* round up so that short timeouts do not become non-blocking */
+        ms = (timeout->tv_sec * MS_PER_SEC) +
+             ((timeout->tv_usec + US_PER_MS - 1) / US_PER_MS);
+    }
+    if ((res = poll(fds, numof, ms)) < 0) {
+        return -1;
+    }
+    for (nfds_t i = 0; i < numof; i++) {
+        if (fds[i].revents & POLLNVAL) {
+            errno = EBADF;
+            return -1;
+        }
+    }
+    res = 0;
+    if (readfds != NULL) {
+        FD_ZERO(readfds);
+    }
+    if (writefds != NULL) {
+        FD_ZERO(writefds);
+    }
+    if (errorfds != NULL) {
+        FD_ZERO(errorfds);
+    }
+    for (nfds_t i = 0; i < numof; i++) {
+        /* select() reports a hang-up as readable */
+        if ((readfds != NULL) && (fds[i].events & POLLIN) &&
+            (fds[i].revents & (POLLIN | POLLHUP))) {
+            FD_SET(fds[i].fd, readfds);
+            res++;
+        }
+        if ((writefds != NULL) && (fds[i].revents & POLLOUT)) {
+            FD_SET(fds[i].fd, writefds);
+            res++;
+        }
+        if ((errorfds != NULL) && (fds[i].revents & POLLERR)) {
+            FD_SET(fds[i].fd, errorfds);
+            res++;
+        }
+    }
+    return res;
+}
+
+/** @} */
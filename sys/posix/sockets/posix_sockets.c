@@ -23,10 +23,15 @@
 #include <string.h>
 
 #include "bitfield.h"
+#include "irq.h"
 #include "mutex.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
 #include "random.h"
+#ifdef MODULE_POSIX_POLL
+#include "thread.h"
+#include "thread_flags.h"
+#endif
 #include "vfs.h"
 
 #include "sys/socket.h"
@@ -73,6 +78,10 @@ typedef struct {
     uint32_t recv_timeout;
 #endif
     socket_sock_t *sock;
+#ifdef MODULE_POSIX_POLL
+    kernel_pid_t waiter;        /* thread polling the socket */
+    unsigned pending;           /* messages received but not read yet */
+#endif
 #ifdef MODULE_SOCK_TCP
     sock_tcp_t *queue_array;
     unsigned queue_array_len;
@@ -315,6 +324,78 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+#ifdef MODULE_POSIX_POLL
+static void _recv_event(socket_t *s)
+{
+    kernel_pid_t waiter;
+    unsigned state = irq_disable();
+
+    s->pending++;
+    waiter = s->waiter;
+    irq_restore(state);
+    if (waiter != KERNEL_PID_UNDEF) {
+        thread_flags_set((thread_t *)thread_get(waiter), VFS_POLL_THREAD_FLAG);
+    }
+}
+
+static void _recv_done(socket_t *s, int res)
+{
+    /* these do not take a message out of the sock */
+    if ((res == -EAGAIN) || (res == -ETIMEDOUT) || (res == -EADDRNOTAVAIL) ||
+        (res == -EINTR)) {
+        return;
+    }
+    unsigned state = irq_disable();
+    if (s->pending > 0) {
+        s->pending--;
+    }
+    irq_restore(state);
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _recv_event(arg);
+    }
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _recv_event(arg);
+    }
+}
+#endif
+
+static int socket_poll(vfs_file_t *filp, unsigned events, kernel_pid_t waiter)
+{
+    socket_t *s = filp->private_data.ptr;
+    int res = events & VFS_POLLOUT;
+
+    switch (s->type) {
+        case SOCK_RAW:
+        case SOCK_DGRAM: {
+            unsigned state = irq_disable();
+
+            if ((s->sock != NULL) && (events & VFS_POLLIN) && (s->pending > 0)) {
+                res |= VFS_POLLIN;
+            }
+            s->waiter = (res == 0) ? waiter : KERNEL_PID_UNDEF;
+            irq_restore(state);
+            return res;
+        }
+        default:
+            /* no readiness notification for stream sockets (yet) */
+            return -ENOTSUP;
+    }
+}
+#endif
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
     .fcntl = NULL,          /* TODO: provide when needed */
@@ -322,6 +403,9 @@ static const vfs_file_ops_t socket_ops = {
     .lseek = socket_lseek,
     .read = socket_read,
     .write = socket_write,
+#ifdef MODULE_POSIX_POLL
+    .poll = socket_poll,
+#endif
 };
 
 int socket(int domain, int type, int protocol)
@@ -360,6 +444,10 @@ int socket(int domain, int type, int protocol)
             }
             s->bound = false;
             s->sock = NULL;
+#ifdef MODULE_POSIX_POLL
+            s->waiter = KERNEL_PID_UNDEF;
+            s->pending = 0;
+#endif
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
@@ -559,6 +647,9 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
             /* TODO apply flags if possible */
             res = sock_ip_create(&sock->raw, (sock_ip_ep_t *)local,
                                  (sock_ip_ep_t *)remote, s->protocol, 0);
+#ifdef MODULE_POSIX_POLL
+            sock_ip_set_cb(&sock->raw, _ip_cb, s);
+#endif
             break;
 #endif
 #ifdef MODULE_SOCK_TCP
@@ -573,6 +664,9 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         case SOCK_DGRAM:
             /* TODO apply flags if possible */
             res = sock_udp_create(&sock->udp, local, remote, 0);
+#ifdef MODULE_POSIX_POLL
+            sock_udp_set_cb(&sock->udp, _udp_cb, s);
+#endif
             break;
 #endif
         default:
@@ -841,6 +935,9 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
         case SOCK_RAW:
             res = sock_ip_recv(&s->sock->raw, buffer, length, recv_timeout,
                                (sock_ip_ep_t *)&ep);
+#ifdef MODULE_POSIX_POLL
+            _recv_done(s, res);
+#endif
             break;
 #endif
 #ifdef MODULE_SOCK_TCP
@@ -853,6 +950,9 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
         case SOCK_DGRAM:
             res = sock_udp_recv(&s->sock->udp, buffer, length, recv_timeout,
                                 &ep);
+#ifdef MODULE_POSIX_POLL
+            _recv_done(s, res);
+#endif
             break;
 #endif
         default:
@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -22,8 +23,12 @@
 #include "thread.h"
 #include "kernel_types.h"
 
+#ifdef MODULE_STACKPROF
+#include "stackprof.h"
+#endif
+
 #ifdef MODULE_SCHEDSTATISTICS
-#include "xtimer.h"
+#include "schedstatistics.h"
 #endif
 
 #ifdef MODULE_TLSF
@@ -65,6 +70,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime | switches"
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+           "| msgq ( max) / size | received |  dropped"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -84,6 +92,17 @@ void ps(void)
     }
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS
+    /* the CPU share of each thread is relative to the time accounted to all
+     * threads since schedstatistics was initialized */
+    uint64_t rt_sum = 0;
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] != NULL) {
+            rt_sum += schedstatistics_runtime(i);
+        }
+    }
+#endif
+
     for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
         thread_t *p = (thread_t *)sched_threads[i];
 
@@ -94,13 +113,22 @@ void ps(void)
 #ifdef DEVELHELP
             int stacksz = p->stack_size;                                           /* get stack size */
             overall_stacksz += stacksz;
+#ifdef MODULE_STACKPROF
+            stacksz = stackprof_usage(i);                                          /* get high water mark */
+#else
             stacksz -= thread_measure_stack_free(p->stack_start);
+#endif
             overall_used += stacksz;
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-            double runtime_ticks = sched_pidlist[i].runtime_ticks /
-                                   (double) _xtimer_now64() * 100;
+            double runtime_ticks = (rt_sum == 0) ? 0 :
+                                   schedstatistics_runtime(i) /
+                                   (double) rt_sum * 100;
             int switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+            unsigned msgq_size = p->msg_array ? (p->msg_queue.mask + 1) : 0;
+            int msgq = p->msg_array ? cib_avail(&p->msg_queue) : 0;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -112,6 +140,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %6.3f%% |  %8d"
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+                   " | %4i (%4u) / %4u | %8" PRIu32 " | %8" PRIu32
 #endif
                    "\n",
                    p->pid,
@@ -124,6 +155,10 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_ticks, switches
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+                   , msgq, (unsigned)p->msg_queue_max, msgq_size,
+                   p->msg_received, p->msg_dropped
 #endif
                   );
         }
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_random
+ * @{
+ * @file
+ *
+ * @brief Glue-code for the ChaCha PRNG of sys/crypto
+ *
+ * The numbers are taken from a buffer of CHACHA_PRNG_BLOCKS keystream blocks,
+ * so most calls do not run the cipher. The seeds overwrite the beginning of
+ * the ChaCha state, the rest keeps the seed of the build process.
+ *
+ * @author Martine Lenders <mlenders@inf.fu-berlin.de>
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "crypto/chacha.h"
+
+void random_init(uint32_t seed)
+{
+    chacha_prng_seed(&seed, sizeof(seed));
+}
+
+uint32_t random_uint32(void)
+{
+    return chacha_prng_next();
+}
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    size_t len = key_length * sizeof(uint32_t);
+
+    if (len > sizeof(((chacha_ctx *)0)->state)) {
+        len = sizeof(((chacha_ctx *)0)->state);
+    }
+    if (len > 0) {
+        chacha_prng_seed(init_key, len);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random_pool
+ * @{
+ *
+ * @file
+ * @brief       Entropy pool implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "mutex.h"
+#include "xtimer.h"
+#include "random_pool.h"
+
+#ifdef FEATURE_PERIPH_HWRNG
+#include "periph/hwrng.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static sha256_context_t _pool;
+static mutex_t _lock = MUTEX_INIT;
+static unsigned _pool_bytes;
+
+static char _stack[RANDOM_POOL_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+void random_pool_add(const void *data, size_t len)
+{
+    mutex_lock(&_lock);
+    sha256_update(&_pool, data, len);
+    _pool_bytes += len;
+    mutex_unlock(&_lock);
+}
+
+void random_pool_add_sample(uint32_t sample)
+{
+    uint32_t data[2] = { xtimer_now_usec(), sample };
+
+    random_pool_add(data, sizeof(data));
+}
+
+void random_pool_reseed(void)
+{
+    uint8_t seed[SHA256_DIGEST_LENGTH];
+
+    mutex_lock(&_lock);
+    /* chain in the current PRNG output, so the new key depends on all
+     * entropy seen so far and not only on this batch */
+    chacha_prng_bytes(seed, sizeof(seed));
+    sha256_update(&_pool, seed, sizeof(seed));
+    sha256_final(&_pool, seed);
+    sha256_init(&_pool);
+    DEBUG("random_pool: reseed from %u bytes\n", _pool_bytes);
+    _pool_bytes = 0;
+    mutex_unlock(&_lock);
+
+    chacha_prng_reseed(seed, sizeof(seed));
+    memset(seed, 0, sizeof(seed));
+}
+
+static void *_random_pool_thread(void *arg)
+{
+    (void)arg;
+
+#ifdef FEATURE_PERIPH_HWRNG
+    hwrng_init();
+#endif
+
+    while (1) {
+#ifdef FEATURE_PERIPH_HWRNG
+        uint8_t buf[RANDOM_POOL_HWRNG_BYTES];
+
+        /* may block for a while on some platforms, only this thread waits */
+        hwrng_read(buf, sizeof(buf));
+        random_pool_add(buf, sizeof(buf));
+        memset(buf, 0, sizeof(buf));
+#endif
+        random_pool_add_sample(xtimer_now_usec());
+        random_pool_reseed();
+        xtimer_usleep(RANDOM_POOL_INTERVAL);
+    }
+
+    return NULL;
+}
+
+kernel_pid_t random_pool_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        sha256_init(&_pool);
+        _pid = thread_create(_stack, sizeof(_stack), RANDOM_POOL_PRIO,
+                             THREAD_CREATE_STACKTEST, _random_pool_thread,
+                             NULL, "random_pool");
+    }
+
+    return _pid;
+}
@@ -324,6 +324,12 @@ int uart_stdio_read(char* buffer, int count) {
     return res;
 }
 
+void uart_stdio_flush(void) {
+    /* the host reads the buffer on its own, only wait for it if it is
+       known to be attached */
+    while (blocking_stdout && (rtt_cb.up[0].rd_off != rtt_cb.up[0].wr_off)) {}
+}
+
 int uart_stdio_write(const char* buffer, int len) {
     int written = rtt_write(buffer, len);
     xtimer_ticks32_t last_wakeup = xtimer_now();
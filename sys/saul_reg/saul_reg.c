@@ -24,15 +24,54 @@
 
 #include "saul_reg.h"
 
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+
 /**
  * @brief   Keep the head of the device list as global variable
  */
 saul_reg_t *saul_reg = NULL;
 
+/**
+ * @brief   First device of each indexed type, unused slots are NULL
+ *
+ * The devices of one type are chained through their `next_type` field in
+ * registry order, whether their type made it into the index or not.
+ */
+static saul_reg_t *_index[SAUL_REG_INDEX_NUMOF];
+
+/**
+ * @brief   Set once a type did not fit into the index, a type missing from
+ *          the index then is not known to be unregistered
+ */
+static uint8_t _index_full = 0;
+
+static saul_reg_t **_index_slot(uint8_t type)
+{
+    for (unsigned i = 0; i < SAUL_REG_INDEX_NUMOF; i++) {
+        if (_index[i] && (_index[i]->driver->type == type)) {
+            return &_index[i];
+        }
+    }
+    return NULL;
+}
+
+static void _index_add(saul_reg_t *dev)
+{
+    for (unsigned i = 0; i < SAUL_REG_INDEX_NUMOF; i++) {
+        if (_index[i] == NULL) {
+            _index[i] = dev;
+            return;
+        }
+    }
+    _index_full = 1;
+}
 
 int saul_reg_add(saul_reg_t *dev)
 {
     saul_reg_t *tmp = saul_reg;
+    saul_reg_t *last_type = NULL;
 
     if (dev == NULL) {
         return -ENODEV;
@@ -40,38 +79,70 @@ int saul_reg_add(saul_reg_t *dev)
 
     /* prepare new entry */
     dev->next = NULL;
+    dev->next_type = NULL;
     /* add to registry */
     if (saul_reg == NULL) {
         saul_reg = dev;
     }
     else {
-        while (tmp->next != NULL) {
+        while (1) {
+            if (tmp->driver->type == dev->driver->type) {
+                last_type = tmp;
+            }
+            if (tmp->next == NULL) {
+                break;
+            }
             tmp = tmp->next;
         }
         tmp->next = dev;
     }
+    /* chain it to the devices of the same type */
+    if (last_type) {
+        last_type->next_type = dev;
+    }
+    else {
+        _index_add(dev);
+    }
     return 0;
 }
 
 int saul_reg_rm(saul_reg_t *dev)
 {
+    saul_reg_t *prev = NULL;
+    saul_reg_t *prev_type = NULL;
     saul_reg_t *tmp = saul_reg;
 
-    if (saul_reg == NULL || dev == NULL) {
+    if (dev == NULL) {
         return -ENODEV;
     }
-    if (saul_reg == dev) {
-        saul_reg = dev->next;
-    }
-    while (tmp->next && (tmp->next != dev)) {
+    while (tmp && (tmp != dev)) {
+        if (tmp->driver->type == dev->driver->type) {
+            prev_type = tmp;
+        }
+        prev = tmp;
         tmp = tmp->next;
     }
-    if (tmp->next == dev) {
-        tmp->next = dev->next;
+    if (tmp == NULL) {
+        return -ENODEV;
+    }
+
+    if (prev) {
+        prev->next = dev->next;
     }
     else {
-        return -ENODEV;
+        saul_reg = dev->next;
     }
+    if (prev_type) {
+        prev_type->next_type = dev->next_type;
+    }
+    else {
+        saul_reg_t **slot = _index_slot(dev->driver->type);
+        if (slot) {
+            *slot = dev->next_type;
+        }
+    }
+    dev->next = NULL;
+    dev->next_type = NULL;
     return 0;
 }
 
@@ -87,8 +158,15 @@ saul_reg_t *saul_reg_find_nth(int pos)
 
 saul_reg_t *saul_reg_find_type(uint8_t type)
 {
+    saul_reg_t **slot = _index_slot(type);
     saul_reg_t *tmp = saul_reg;
 
+    if (slot) {
+        return *slot;
+    }
+    if (!_index_full) {
+        return NULL;
+    }
     while (tmp) {
         if (tmp->driver->type == type) {
             return tmp;
@@ -119,6 +197,63 @@ int saul_reg_read(saul_reg_t *dev, phydat_t *res)
     return dev->driver->read(dev->dev, res);
 }
 
+unsigned saul_reg_read_all(uint8_t type, saul_reg_data_t *data,
+                           unsigned numof)
+{
+    saul_reg_t *tmp;
+    unsigned i = 0;
+
+    tmp = (type == SAUL_CLASS_ANY) ? saul_reg : saul_reg_find_type(type);
+    for (; tmp && (i < numof); i++) {
+        data[i].dev = tmp;
+#ifdef MODULE_XTIMER
+        data[i].time = xtimer_now_usec();
+#else
+        data[i].time = 0;
+#endif
+        data[i].res = tmp->driver->read(tmp->dev, &data[i].data);
+        tmp = (type == SAUL_CLASS_ANY) ? tmp->next : tmp->next_type;
+    }
+    return i;
+}
+
+int saul_reg_fifo_start(saul_reg_t *dev, unsigned watermark,
+                        saul_notify_t cb, void *arg)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->driver->fifo == NULL) {
+        return -ENOTSUP;
+    }
+    return dev->driver->fifo->start(dev->dev, watermark, cb, arg);
+}
+
+void saul_reg_fifo_stop(saul_reg_t *dev)
+{
+    if (dev && dev->driver->fifo) {
+        dev->driver->fifo->stop(dev->dev);
+    }
+}
+
+int saul_reg_read_fifo(saul_reg_t *dev, phydat_t *res, size_t numof,
+                       uint32_t *time, uint32_t *period)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->driver->fifo == NULL) {
+        return -ENOTSUP;
+    }
+    /* the newest sample is at most one period older than this */
+#ifdef MODULE_XTIMER
+    *time = xtimer_now_usec();
+#else
+    *time = 0;
+#endif
+    return dev->driver->fifo->read(dev->dev, res, numof, period);
+}
+
 int saul_reg_write(saul_reg_t *dev, phydat_t *data)
 {
     if (dev == NULL) {
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_round_robin
+ * @{
+ *
+ * @file
+ * @brief       Round robin time slicing implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "sched.h"
+#include "sched_round_robin.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Marker for "no runqueue is being sliced"
+ */
+#define RR_PRIO_NONE        (0xff)
+
+static void _rr_cb(void *arg);
+
+static xtimer_t _rr_timer = { .callback = _rr_cb };
+
+/* priority of the runqueue the slice timer is currently armed for */
+static uint8_t _rr_prio = RR_PRIO_NONE;
+
+/* runqueues change before xtimer is initialized, ignore those */
+static uint8_t _rr_initialized = 0;
+
+static inline int _is_sliced(uint8_t prio)
+{
+    return (prio < (SCHED_PRIO_LEVELS - 1)) && !(SCHED_RR_MASK & (1U << prio));
+}
+
+static void _rr_arm(uint8_t prio)
+{
+    DEBUG("sched_rr: slicing runqueue %u\n", (unsigned)prio);
+    _rr_prio = prio;
+    xtimer_set(&_rr_timer, SCHED_RR_TIMEBASE);
+}
+
+static void _rr_disarm(void)
+{
+    _rr_prio = RR_PRIO_NONE;
+    xtimer_remove(&_rr_timer);
+
+    /* a lower priority runqueue might still need slicing */
+    for (uint8_t prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        if (_is_sliced(prio) && sched_runq_more_than_one(prio)) {
+            _rr_arm(prio);
+            return;
+        }
+    }
+}
+
+static void _rr_cb(void *arg)
+{
+    (void)arg;
+    uint8_t prio = _rr_prio;
+
+    _rr_prio = RR_PRIO_NONE;
+    if ((prio == RR_PRIO_NONE) || !sched_runq_more_than_one(prio)) {
+        return;
+    }
+
+    sched_runq_advance(prio);
+    thread_t *active = (thread_t *)sched_active_thread;
+    if (active && (active->priority == prio)) {
+        /* we are in ISR context, so this only requests the context switch
+         * on ISR exit */
+        thread_yield_higher();
+    }
+
+    /* the thread now at the head of the runqueue gets a fresh slice */
+    _rr_arm(prio);
+}
+
+void sched_runq_callback(uint8_t prio)
+{
+    if (!_rr_initialized || !_is_sliced(prio)) {
+        return;
+    }
+
+    if (sched_runq_more_than_one(prio)) {
+        if ((_rr_prio == RR_PRIO_NONE) || (prio < _rr_prio)) {
+            _rr_arm(prio);
+        }
+    }
+    else if (_rr_prio == prio) {
+        _rr_disarm();
+    }
+}
+
+void sched_round_robin_init(void)
+{
+    unsigned state = irq_disable();
+    _rr_initialized = 1;
+    _rr_disarm();
+    irq_restore(state);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_schedstatistics
+ * @{
+ *
+ * @file
+ * @brief       Scheduler statistics implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "sched.h"
+#include "schedstatistics.h"
+#include "xtimer.h"
+
+schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
+
+static void _sched_statistics_cb(kernel_pid_t active_thread,
+                                 kernel_pid_t next_thread)
+{
+    uint64_t now = _xtimer_now64();
+
+    /* Update active thread stats */
+    if (active_thread != KERNEL_PID_UNDEF) {
+        schedstat_t *active_stat = &sched_pidlist[active_thread];
+        if (active_stat->laststart) {
+            active_stat->runtime_ticks += now - active_stat->laststart;
+        }
+    }
+
+    /* Update next_thread stats */
+    schedstat_t *next_stat = &sched_pidlist[next_thread];
+    next_stat->laststart = now;
+    next_stat->schedules++;
+}
+
+void init_schedstatistics(void)
+{
+    /* Init laststart for the thread starting schedstatistics since the
+     * callback wasn't registered when it was first scheduled */
+    schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
+    active_stat->laststart = _xtimer_now64();
+    active_stat->schedules = 1;
+    sched_register_cb(_sched_statistics_cb);
+}
+
+uint64_t schedstatistics_runtime(kernel_pid_t pid)
+{
+    unsigned state = irq_disable();
+    uint64_t runtime = sched_pidlist[pid].runtime_ticks;
+
+    if ((pid == sched_active_pid) && sched_pidlist[pid].laststart) {
+        runtime += _xtimer_now64() - sched_pidlist[pid].laststart;
+    }
+    irq_restore(state);
+
+    return runtime;
+}
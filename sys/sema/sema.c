@@ -16,7 +16,9 @@
  */
 
 #include <errno.h>
-#include "irq.h"
+#include <limits.h>
+#include <stdbool.h>
+
 #include "assert.h"
 #include "sema.h"
 #include "xtimer.h"
@@ -44,18 +46,51 @@ void sema_destroy(sema_t *sema)
     mutex_unlock(&sema->mutex);
 }
 
+/**
+ * @brief   Take a token from the semaphore, if there is one
+ *
+ * On CPUs without native atomic instructions, the __atomic builtins are
+ * provided by atomic_c11.c.
+ *
+ * @param[in]  sema     the semaphore
+ * @param[out] value    value of the semaphore after taking the token
+ *
+ * @return  1 if a token was taken
+ * @return  0 if the semaphore value was 0
+ */
+static inline int _take(sema_t *sema, unsigned *value)
+{
+    unsigned old = __atomic_load_n(&sema->value, __ATOMIC_RELAXED);
+
+    do {
+        if (old == 0) {
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&sema->value, &old, old - 1, true,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    *value = old - 1;
+    return 1;
+}
+
 int _sema_wait(sema_t *sema, int block, uint64_t us)
 {
     assert(sema != NULL);
 
+    unsigned value;
+
     if (sema->state != SEMA_OK) {
         return -ECANCELED;
     }
 
-    int did_block = block;
-    unsigned old = irq_disable();
-    while ((sema->value == 0) && block) {
-        irq_restore(old);
+    /* uncontended case: the mutex is only needed to sleep until a post */
+    if (_take(sema, &value)) {
+        return 0;
+    }
+    if (!block) {
+        return -EAGAIN;
+    }
+
+    while (block) {
         if (us == 0) {
             mutex_lock(&sema->mutex);
         }
@@ -77,38 +112,33 @@ int _sema_wait(sema_t *sema, int block, uint64_t us)
             return -ECANCELED;
         }
 
-        old = irq_disable();
-    }
-
-    if (sema->value == 0) {
-        irq_restore(old);
-        return (did_block) ? -ETIMEDOUT : -EAGAIN;
-    }
-
-    unsigned int value = --sema->value;
-    irq_restore(old);
-
-    /* only unlock mutex if it was a blocking operation */
-    if (did_block && value > 0) {
-        mutex_unlock(&sema->mutex);
+        if (_take(sema, &value)) {
+            /* pass the wake-up on to the next waiter */
+            if (value > 0) {
+                mutex_unlock(&sema->mutex);
+            }
+            return 0;
+        }
     }
 
-    return 0;
+    return -ETIMEDOUT;
 }
 
 int sema_post(sema_t *sema)
 {
     assert(sema != NULL);
 
-    unsigned old = irq_disable();
-    if (sema->value == UINT_MAX) {
-        irq_restore(old);
-        return -EOVERFLOW;
-    }
+    unsigned value = __atomic_load_n(&sema->value, __ATOMIC_RELAXED);
 
-    unsigned value = sema->value++;
-    irq_restore(old);
+    do {
+        if (value == UINT_MAX) {
+            return -EOVERFLOW;
+        }
+    } while (!__atomic_compare_exchange_n(&sema->value, &value, value + 1,
+                                          true, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
 
+    /* only a waiter sleeping on an empty semaphore needs to be woken */
     if (value == 0) {
         mutex_unlock(&sema->mutex);
     }
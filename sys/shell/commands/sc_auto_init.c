@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the duration of the auto_init steps
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "auto_init.h"
+
+int _auto_init_profile_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    unsigned numof;
+    const auto_init_profile_t *profile = auto_init_profile(&numof);
+    uint32_t total = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        printf("%-24s %10" PRIu32 " us\n", profile[i].name, profile[i].usec);
+        total += profile[i].usec;
+    }
+    printf("%-24s %10" PRIu32 " us\n", "total", total);
+
+    return 0;
+}
@@ -22,11 +22,13 @@
 static void _usage(char *cmd)
 {
     printf("usage: * %s\n", cmd);
-    puts("         Lists all addresses in the blacklist.");
-    printf("       * %s add <addr>\n", cmd);
-    puts("         Adds <addr> to the blacklist.");
-    printf("       * %s del <addr>\n", cmd);
-    puts("         Deletes <addr> from the blacklist.");
+    puts("         Lists all addresses and prefixes in the blacklist.");
+    printf("       * %s add <addr>[/<prefix_len>]\n", cmd);
+    puts("         Adds <addr> or the prefix <addr>/<prefix_len> to the");
+    puts("         blacklist.");
+    printf("       * %s del <addr>[/<prefix_len>]\n", cmd);
+    puts("         Deletes <addr> or the prefix <addr>/<prefix_len> from the");
+    puts("         blacklist.");
     printf("       * %s help\n", cmd);
     puts("         Print this.");
 }
@@ -34,21 +36,24 @@ static void _usage(char *cmd)
 int _blacklist(int argc, char **argv)
 {
     ipv6_addr_t addr;
+    int len = IPV6_ADDR_BIT_LEN;
     if (argc < 2) {
         gnrc_ipv6_blacklist_print();
         return 0;
     }
     else if (argc > 2) {
-        if (ipv6_addr_from_str(&addr, argv[2]) == NULL) {
+        len = ipv6_addr_split_prefix(argv[2]);
+        if ((len < 0) || (len > IPV6_ADDR_BIT_LEN) ||
+            (ipv6_addr_from_str(&addr, argv[2]) == NULL)) {
             _usage(argv[0]);
             return 1;
         }
     }
     if (strcmp("add", argv[1]) == 0) {
-        gnrc_ipv6_blacklist_add(&addr);
+        gnrc_ipv6_blacklist_add_prefix(&addr, (uint8_t)len);
     }
     else if (strcmp("del", argv[1]) == 0) {
-        gnrc_ipv6_blacklist_del(&addr);
+        gnrc_ipv6_blacklist_del_prefix(&addr, (uint8_t)len);
     }
     else if (strcmp("help", argv[1]) == 0) {
         _usage(argv[0]);
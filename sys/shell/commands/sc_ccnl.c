@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <inttypes.h>
+
 #include "random.h"
 #include "sched.h"
 #include "net/gnrc/netif.h"
@@ -283,3 +285,21 @@ int _ccnl_fib(int argc, char **argv)
     }
     return 0;
 }
+
+#ifdef MODULE_CCN_LITE_CACHE
+int _ccnl_cs(int argc, char **argv)
+{
+    ccnl_cache_stats_t stats;
+
+    (void)argc;
+    (void)argv;
+    ccnl_cache_get_stats(&ccnl_relay, &stats);
+    printf("entries: %i/%i\n", ccnl_relay.contentcnt, ccnl_relay.max_cache_entries);
+    printf("interests: %" PRIu32 ", hits: %" PRIu32, stats.interests, stats.hits);
+    if (stats.interests > 0) {
+        printf(" (%" PRIu32 "%%)", (stats.hits * 100) / stats.interests);
+    }
+    printf("\nevictions: %" PRIu32 "\n", stats.evictions);
+    return 0;
+}
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the packet buffer counters
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+
+int _gnrc_pktbuf_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    gnrc_pktbuf_counters_t counters;
+    gnrc_pktbuf_get_counters(&counters);
+
+    printf("used: %u bytes (peak: %u bytes)\n", (unsigned)counters.used,
+           (unsigned)counters.peak);
+    printf("largest free: %u bytes\n", (unsigned)counters.largest_free);
+    printf("references: %" PRIu32 " taken, %" PRIu32 " released, "
+           "%" PRIu32 " held\n", counters.refs, counters.unrefs,
+           counters.refs - counters.unrefs);
+    puts("allocation failures:");
+    for (unsigned i = 0; i < GNRC_PKTBUF_COUNTERS_TYPES; i++) {
+        if (counters.fails[i]) {
+            printf("  type %3d: %" PRIu32 "\n", (int)i + GNRC_NETTYPE_IOVEC,
+                   counters.fails[i]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the packet latency traces
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pkttrace.h"
+
+static const char *_layers[] = { "netdev", "6lo", "ipv6", "udp", "sock" };
+static const char *_dirs[] = { "rx", "tx" };
+
+/* too large for the shell's stack */
+static gnrc_pkttrace_stats_t _stats;
+static gnrc_pkttrace_entry_t _log[GNRC_PKTTRACE_LOG_SIZE];
+
+static void _print_histogram(const uint32_t *buckets)
+{
+    for (unsigned i = 0; i < GNRC_PKTTRACE_BUCKETS; i++) {
+        if (!buckets[i]) {
+            continue;
+        }
+        if (i == 0) {
+            printf("  %10u      : %" PRIu32 "\n", 0, buckets[i]);
+        }
+        else if (i == (GNRC_PKTTRACE_BUCKETS - 1)) {
+            printf("  %10" PRIu32 " +    : %" PRIu32 "\n",
+                   (uint32_t)1 << (i - 1), buckets[i]);
+        }
+        else {
+            printf("  %10" PRIu32 " - %-3" PRIu32 ": %" PRIu32 "\n",
+                   (uint32_t)1 << (i - 1), ((uint32_t)1 << i) - 1, buckets[i]);
+        }
+    }
+}
+
+static void _print_stats(void)
+{
+    gnrc_pkttrace_get_stats(&_stats);
+    for (unsigned l = 0; l < GNRC_PKTTRACE_LAYER_NUMOF; l++) {
+        for (unsigned d = 0; d < GNRC_PKTTRACE_DIR_NUMOF; d++) {
+            uint32_t count = 0;
+
+            for (unsigned i = 0; i < GNRC_PKTTRACE_BUCKETS; i++) {
+                count += _stats.hist[l][d][i];
+            }
+            if (count == 0) {
+                continue;
+            }
+            printf("%s %s [us] (packets: %" PRIu32 ", max: %" PRIu32 "):\n",
+                   _layers[l], _dirs[d], count, _stats.max[l][d]);
+            _print_histogram(_stats.hist[l][d]);
+        }
+    }
+}
+
+static void _print_log(void)
+{
+    unsigned numof = gnrc_pkttrace_get_log(_log, GNRC_PKTTRACE_LOG_SIZE);
+
+    for (unsigned i = 0; i < numof; i++) {
+        printf("%10" PRIu32 " %-6s %s %-5s", _log[i].time,
+               _layers[_log[i].layer], _dirs[_log[i].dir],
+               _log[i].exit ? "exit" : "enter");
+        if (_log[i].since_rx) {
+            printf(" +%" PRIu32, _log[i].since_rx);
+        }
+        puts("");
+    }
+}
+
+int _gnrc_pkttrace_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        _print_stats();
+    }
+    else if (strcmp(argv[1], "log") == 0) {
+        _print_log();
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        gnrc_pkttrace_reset();
+    }
+    else {
+        printf("usage: %s [log|reset]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
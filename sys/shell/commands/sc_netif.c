@@ -42,6 +42,9 @@
 #ifdef MODULE_L2FILTER
 #include "net/l2filter.h"
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
 
 /**
  * @brief   The maximal expected link layer address length in byte
@@ -282,6 +285,24 @@ static void _print_netopt_state(netopt_state_t state)
     }
 }
 
+/**
+ * @brief   Flags shown by ifconfig, if enabled
+ */
+static const struct {
+    netopt_t opt;
+    const char *name;
+} _flags[] = {
+    { NETOPT_PROMISCUOUSMODE, "PROMISC" },
+    { NETOPT_AUTOACK, "AUTOACK" },
+    { NETOPT_ACK_REQ, "ACK_REQ" },
+    { NETOPT_PRELOADING, "PRELOAD" },
+    { NETOPT_RAWMODE, "RAWMODE" },
+    { NETOPT_CSMA, "CSMA" },
+    { NETOPT_AUTOCCA, "AUTOCCA" },
+};
+
+#define FLAGS_NUMOF     (sizeof(_flags) / sizeof(_flags[0]))
+
 static void _netif_list(kernel_pid_t dev)
 {
     uint8_t hwaddr[MAX_ADDR_LEN];
@@ -376,53 +397,23 @@ static void _netif_list(kernel_pid_t dev)
 
     printf("\n           ");
 
-    res = gnrc_netapi_get(dev, NETOPT_PROMISCUOUSMODE, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("PROMISC  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_AUTOACK, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("AUTOACK  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_ACK_REQ, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("ACK_REQ  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_PRELOADING, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("PRELOAD  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_RAWMODE, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("RAWMODE  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_CSMA, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("CSMA  ");
-        linebreak = true;
-    }
-
-    res = gnrc_netapi_get(dev, NETOPT_AUTOCCA, 0, &enable, sizeof(enable));
-
-    if ((res >= 0) && (enable == NETOPT_ENABLE)) {
-        printf("AUTOCCA  ");
-        linebreak = true;
+    /* read all flags with a single request */
+    gnrc_netapi_opt_t flag_opts[FLAGS_NUMOF];
+    netopt_enable_t flags[FLAGS_NUMOF];
+    int flag_res[FLAGS_NUMOF];
+
+    for (unsigned i = 0; i < FLAGS_NUMOF; i++) {
+        flag_opts[i].opt = _flags[i].opt;
+        flag_opts[i].context = 0;
+        flag_opts[i].data = &flags[i];
+        flag_opts[i].data_len = sizeof(flags[i]);
+    }
+    gnrc_netapi_get_multi(dev, flag_opts, flag_res, FLAGS_NUMOF);
+    for (unsigned i = 0; i < FLAGS_NUMOF; i++) {
+        if ((flag_res[i] >= 0) && (flags[i] == NETOPT_ENABLE)) {
+            printf("%s  ", _flags[i].name);
+            linebreak = true;
+        }
     }
 
 #ifdef MODULE_GNRC_IPV6_NETIF
@@ -835,6 +826,46 @@ static void _l2filter_usage(const char *cmd)
 }
 #endif
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static int _netif_nbstats(kernel_pid_t dev)
+{
+    netstats_nb_table_t *table;
+    char addr_str[(NETSTATS_NB_L2_ADDR_MAX * 3)];
+    unsigned count = 0;
+
+    if (gnrc_netapi_get(dev, NETOPT_STATS_NEIGHBOR, 0, &table, sizeof(&table)) < 0) {
+        puts("error: device doesn't provide neighbor statistics");
+        return 1;
+    }
+    puts("L2 address               ETX  TX (failed)    RX  RSSI  LQI");
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        const netstats_nb_t *nb = &table->entries[i];
+
+        if (nb->l2_addr_len == 0) {
+            continue;
+        }
+        printf("%-23s %2u.%02u %5u (%5u) %5u %5u %4u\n",
+               gnrc_netif_addr_to_str(addr_str, sizeof(addr_str), nb->l2_addr,
+                                      nb->l2_addr_len),
+               (unsigned)(nb->etx / NETSTATS_NB_ETX_DIVISOR),
+               (unsigned)(((nb->etx % NETSTATS_NB_ETX_DIVISOR) * 100U) /
+                          NETSTATS_NB_ETX_DIVISOR),
+               (unsigned)nb->tx_count, (unsigned)nb->tx_failed,
+               (unsigned)nb->rx_count, (unsigned)nb->rssi, (unsigned)nb->lqi);
+        count++;
+    }
+    if (count == 0) {
+        puts("--- none ---");
+    }
+    return 0;
+}
+
+static void _nbstats_usage(const char *cmd)
+{
+    printf("usage: %s <if_id> nbstats\n", cmd);
+}
+#endif
+
 static int _netif_set(char *cmd_name, kernel_pid_t dev, char *key, char *value)
 {
     if ((strcmp("addr", key) == 0) || (strcmp("addr_short", key) == 0)) {
@@ -1234,6 +1265,11 @@ int _netif_config(int argc, char **argv)
                 return 1;
             }
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            else if (strcmp(argv[2], "nbstats") == 0) {
+                return _netif_nbstats((kernel_pid_t)dev);
+            }
+#endif
 #ifdef MODULE_NETSTATS
             else if (strcmp(argv[2], "stats") == 0) {
                 uint8_t module;
@@ -1314,6 +1350,9 @@ int _netif_config(int argc, char **argv)
 #ifdef MODULE_L2FILTER
     _l2filter_usage(argv[0]);
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    _nbstats_usage(argv[0]);
+#endif
 #ifdef MODULE_NETSTATS
     _stats_usage(argv[0]);
 #endif
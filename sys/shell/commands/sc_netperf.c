@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for netperf
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/netperf.h"
+#include "timex.h"
+
+#define DEFAULT_COUNT       (100U)
+#define DEFAULT_SIZE        (64U)
+#define DEFAULT_BYTES       (64U * 1024U)
+#define DEFAULT_TIMEOUT     (5000U)     /* in ms */
+
+static void _usage(void)
+{
+    puts("usage: netperf udp send <addr>[%<if>] <port> [<count> [<size> "
+         "[<interval us>]]]\n"
+         "       netperf udp recv <port> [<timeout ms>]\n"
+         "       netperf tcp send <addr> <port> [<bytes>]\n"
+         "       netperf tcp recv <port> [<timeout ms>]\n"
+         "       netperf ping <addr>[%<if>] [<count> [<size> "
+         "[<interval us>]]]");
+}
+
+static int _parse_addr(ipv6_addr_t *addr, kernel_pid_t *netif, char *str)
+{
+    int iface = ipv6_addr_split_iface(str);
+
+    *netif = (iface < 0) ? KERNEL_PID_UNDEF : (kernel_pid_t)iface;
+    if (ipv6_addr_from_str(addr, str) == NULL) {
+        printf("error: unable to parse address %s\n", str);
+        return -1;
+    }
+    return 0;
+}
+
+static uint32_t _arg(int argc, char **argv, int idx, uint32_t def)
+{
+    return (argc > idx) ? (uint32_t)strtoul(argv[idx], NULL, 0) : def;
+}
+
+/* kbit/s for a number of bytes in us */
+static uint32_t _kbps(uint64_t bytes, uint32_t duration)
+{
+    return duration ? (uint32_t)((bytes * 8U * US_PER_MS) / duration) : 0;
+}
+
+static int _error(int res)
+{
+    if (res == -ENOTSUP) {
+        puts("error: not supported by the network stack");
+    }
+    else {
+        printf("error: %d\n", res);
+    }
+    return 1;
+}
+
+static void _print_tx(const netperf_tx_stats_t *stats)
+{
+    printf("%" PRIu32 " sent, %" PRIu32 " failed, %" PRIu32 " bytes in %"
+           PRIu32 " us: %" PRIu32 " kbit/s\n",
+           stats->sent, stats->failed, (uint32_t)stats->bytes,
+           stats->duration, _kbps(stats->bytes, stats->duration));
+}
+
+static void _print_rx(const netperf_rx_stats_t *stats)
+{
+    printf("%" PRIu32 " received, %" PRIu32 " bytes in %" PRIu32 " us: %"
+           PRIu32 " kbit/s\n",
+           stats->received, (uint32_t)stats->bytes, stats->duration,
+           _kbps(stats->bytes, stats->duration));
+}
+
+static int _udp(int argc, char **argv)
+{
+    int res;
+
+    if ((argc > 4) && (strcmp(argv[2], "send") == 0)) {
+        netperf_tx_stats_t stats;
+        ipv6_addr_t addr;
+        kernel_pid_t netif;
+
+        if (_parse_addr(&addr, &netif, argv[3]) < 0) {
+            return 1;
+        }
+        res = netperf_udp_send(&addr, netif, atoi(argv[4]),
+                               _arg(argc, argv, 6, DEFAULT_SIZE),
+                               _arg(argc, argv, 5, DEFAULT_COUNT),
+                               _arg(argc, argv, 7, 0), &stats);
+        if (res < 0) {
+            return _error(res);
+        }
+        _print_tx(&stats);
+        return 0;
+    }
+    if ((argc > 3) && (strcmp(argv[2], "recv") == 0)) {
+        netperf_rx_stats_t stats;
+
+        res = netperf_udp_recv(atoi(argv[3]),
+                               _arg(argc, argv, 4, DEFAULT_TIMEOUT) * US_PER_MS,
+                               &stats);
+        if (res < 0) {
+            return _error(res);
+        }
+        _print_rx(&stats);
+        printf("%" PRIu32 " lost, %" PRIu32 " reordered, jitter %" PRIu32
+               " us\n", stats.lost, stats.reordered, stats.jitter);
+        return 0;
+    }
+    _usage();
+    return 1;
+}
+
+static int _tcp(int argc, char **argv)
+{
+    int res;
+
+    if ((argc > 4) && (strcmp(argv[2], "send") == 0)) {
+        netperf_tx_stats_t stats;
+        ipv6_addr_t addr;
+        kernel_pid_t netif;
+
+        if (_parse_addr(&addr, &netif, argv[3]) < 0) {
+            return 1;
+        }
+        res = netperf_tcp_send(&addr, atoi(argv[4]),
+                               _arg(argc, argv, 5, DEFAULT_BYTES), &stats);
+        if (res < 0) {
+            return _error(res);
+        }
+        _print_tx(&stats);
+        return 0;
+    }
+    if ((argc > 3) && (strcmp(argv[2], "recv") == 0)) {
+        netperf_rx_stats_t stats;
+
+        res = netperf_tcp_recv(atoi(argv[3]),
+                               _arg(argc, argv, 4, DEFAULT_TIMEOUT) * US_PER_MS,
+                               &stats);
+        if (res < 0) {
+            return _error(res);
+        }
+        _print_rx(&stats);
+        return 0;
+    }
+    _usage();
+    return 1;
+}
+
+static int _ping(int argc, char **argv)
+{
+    netperf_ping_stats_t stats;
+    ipv6_addr_t addr;
+    kernel_pid_t netif;
+    int res;
+
+    if (argc < 3) {
+        _usage();
+        return 1;
+    }
+    if (_parse_addr(&addr, &netif, argv[2]) < 0) {
+        return 1;
+    }
+    res = netperf_ping(&addr, netif, _arg(argc, argv, 4, DEFAULT_SIZE),
+                       _arg(argc, argv, 3, DEFAULT_COUNT),
+                       _arg(argc, argv, 5, 0), &stats);
+    if (res < 0) {
+        return _error(res);
+    }
+    printf("%" PRIu32 " sent, %" PRIu32 " received in %" PRIu32 " us\n",
+           stats.sent, stats.received, stats.duration);
+    if (stats.received == 0) {
+        return 0;
+    }
+    printf("rtt min/avg/max = %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us\n",
+           stats.rtt_min, (uint32_t)(stats.rtt_sum / stats.received),
+           stats.rtt_max);
+    for (unsigned i = 0; i < NETPERF_HIST_BUCKETS; i++) {
+        if (stats.hist[i] == 0) {
+            continue;
+        }
+        if (i == 0) {
+            printf("        < 1 us: %" PRIu32 "\n", stats.hist[i]);
+        }
+        else if (i == (NETPERF_HIST_BUCKETS - 1)) {
+            printf("  >= %8" PRIu32 " us: %" PRIu32 "\n",
+                   (uint32_t)1 << (i - 1), stats.hist[i]);
+        }
+        else {
+            printf("  < %9" PRIu32 " us: %" PRIu32 "\n",
+                   (uint32_t)1 << i, stats.hist[i]);
+        }
+    }
+    return 0;
+}
+
+int _netperf_handler(int argc, char **argv)
+{
+    if (argc > 1) {
+        if (strcmp(argv[1], "udp") == 0) {
+            return _udp(argc, argv);
+        }
+        if (strcmp(argv[1], "tcp") == 0) {
+            return _tcp(argc, argv);
+        }
+        if (strcmp(argv[1], "ping") == 0) {
+            return _ping(argc, argv);
+        }
+    }
+    _usage();
+    return 1;
+}
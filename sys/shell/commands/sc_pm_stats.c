@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing power mode statistics
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "pm_layered.h"
+
+static void _print_mode(const char *name, uint64_t time, uint32_t entries,
+                        uint64_t total)
+{
+    /* per mille, to print one decimal */
+    unsigned share = total ? (unsigned)((time * 1000) / total) : 0;
+
+    printf("%-7s %10" PRIu32 " %14" PRIu64 " %3u.%u%%\n", name, entries, time,
+           share / 10, share % 10);
+}
+
+int _pm_stats_handler(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        pm_stats_reset();
+        return 0;
+    }
+    else if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    pm_stats_t stats;
+    uint64_t sleeping = 0;
+    char name[8];
+
+    pm_stats_get(&stats);
+
+    puts("mode       entries residency [us]");
+    for (unsigned mode = 0; mode < PM_NUM_MODES; mode++) {
+        snprintf(name, sizeof(name), "%u", mode);
+        _print_mode(name, stats.residency_us[mode], stats.entries[mode],
+                    stats.total_us);
+        sleeping += stats.residency_us[mode];
+    }
+    _print_mode("idle", stats.residency_us[PM_NUM_MODES],
+                stats.entries[PM_NUM_MODES], stats.total_us);
+    sleeping += stats.residency_us[PM_NUM_MODES];
+    _print_mode("running", (stats.total_us > sleeping) ?
+                (stats.total_us - sleeping) : 0, 0, stats.total_us);
+
+    printf("wakeups by xtimer deadline: %" PRIu32 "\n", stats.wakeups_timer);
+    for (unsigned i = 0; i < PM_STATS_WAKEUP_SOURCES; i++) {
+        if (!stats.wakeups[i].count) {
+            break;
+        }
+        if (stats.wakeups[i].source == PM_WAKEUP_UNKNOWN) {
+            printf("  unknown source: %" PRIu32 "\n", stats.wakeups[i].count);
+        }
+        else {
+            printf("  source %3u: %" PRIu32 "\n", stats.wakeups[i].source,
+                   stats.wakeups[i].count);
+        }
+    }
+    if (stats.wakeups_other) {
+        printf("  other sources: %" PRIu32 "\n", stats.wakeups_other);
+    }
+
+#ifdef PM_CURRENT_UA
+    uint64_t energy = pm_stats_energy_uj(&stats);
+    uint64_t avg = stats.total_us ?
+                   (((energy * 1000000) / PM_SUPPLY_MV) * 1000) /
+                   stats.total_us : 0;
+
+    printf("energy: %" PRIu64 " uJ, average current: %" PRIu64 " uA\n",
+           energy, avg);
+#endif
+
+    return 0;
+}
@@ -21,11 +21,13 @@
 static void _usage(char *cmd)
 {
     printf("usage: * %s\n", cmd);
-    puts("         Lists all addresses in the whitelist.");
-    printf("       * %s add <addr>\n", cmd);
-    puts("         Adds <addr> to the whitelist.");
-    printf("       * %s del <addr>\n", cmd);
-    puts("         Deletes <addr> from the whitelist.");
+    puts("         Lists all addresses and prefixes in the whitelist.");
+    printf("       * %s add <addr>[/<prefix_len>]\n", cmd);
+    puts("         Adds <addr> or the prefix <addr>/<prefix_len> to the");
+    puts("         whitelist.");
+    printf("       * %s del <addr>[/<prefix_len>]\n", cmd);
+    puts("         Deletes <addr> or the prefix <addr>/<prefix_len> from the");
+    puts("         whitelist.");
     printf("       * %s help\n", cmd);
     puts("         Print this.");
 }
@@ -33,21 +35,24 @@ static void _usage(char *cmd)
 int _whitelist(int argc, char **argv)
 {
     ipv6_addr_t addr;
+    int len = IPV6_ADDR_BIT_LEN;
     if (argc < 2) {
         gnrc_ipv6_whitelist_print();
         return 0;
     }
     else if (argc > 2) {
-        if (ipv6_addr_from_str(&addr, argv[2]) == NULL) {
+        len = ipv6_addr_split_prefix(argv[2]);
+        if ((len < 0) || (len > IPV6_ADDR_BIT_LEN) ||
+            (ipv6_addr_from_str(&addr, argv[2]) == NULL)) {
             _usage(argv[0]);
             return 1;
         }
     }
     if (strcmp("add", argv[1]) == 0) {
-        gnrc_ipv6_whitelist_add(&addr);
+        gnrc_ipv6_whitelist_add_prefix(&addr, (uint8_t)len);
     }
     else if (strcmp("del", argv[1]) == 0) {
-        gnrc_ipv6_whitelist_del(&addr);
+        gnrc_ipv6_whitelist_del_prefix(&addr, (uint8_t)len);
     }
     else if (strcmp("help", argv[1]) == 0) {
         _usage(argv[0]);
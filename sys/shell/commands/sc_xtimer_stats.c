@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing xtimer instrumentation data
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+static void _print_histogram(const char *name, const uint32_t *buckets)
+{
+    printf("%s:\n", name);
+    for (unsigned i = 0; i < XTIMER_STATS_BUCKETS; i++) {
+        if (!buckets[i]) {
+            continue;
+        }
+        if (i == 0) {
+            printf("  %10u      : %" PRIu32 "\n", 0, buckets[i]);
+        }
+        else if (i == (XTIMER_STATS_BUCKETS - 1)) {
+            printf("  %10" PRIu32 " +    : %" PRIu32 "\n",
+                   (uint32_t)1 << (i - 1), buckets[i]);
+        }
+        else {
+            printf("  %10" PRIu32 " - %-3" PRIu32 ": %" PRIu32 "\n",
+                   (uint32_t)1 << (i - 1), ((uint32_t)1 << i) - 1, buckets[i]);
+        }
+    }
+}
+
+int _xtimer_stats_handler(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        xtimer_stats_reset();
+        return 0;
+    }
+    else if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    xtimer_stats_t stats;
+    xtimer_stats_get(&stats);
+
+    _print_histogram("latency [ticks]", stats.latency);
+    printf("latency max: %" PRIu32 " ticks\n", stats.latency_max);
+    _print_histogram("insertion depth [timers]", stats.depth);
+    printf("busy waits: %" PRIu32 " (%" PRIu32 " ticks)\n",
+           stats.spins, stats.spin_ticks);
+
+    return 0;
+}
@@ -29,7 +29,7 @@ extern int _reboot_handler(int argc, char **argv);
 extern int _id_handler(int argc, char **argv);
 #endif
 
-#ifdef MODULE_LPC_COMMON
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_TLSF_MALLOC)
 extern int _heap_handler(int argc, char **argv);
 #endif
 
@@ -121,12 +121,19 @@ extern int _ccnl_open(int argc, char **argv);
 extern int _ccnl_content(int argc, char **argv);
 extern int _ccnl_interest(int argc, char **argv);
 extern int _ccnl_fib(int argc, char **argv);
+#ifdef MODULE_CCN_LITE_CACHE
+extern int _ccnl_cs(int argc, char **argv);
+#endif
 #endif
 
 #ifdef MODULE_SNTP
 extern int _ntpdate(int argc, char **argv);
 #endif
 
+#ifdef MODULE_NETPERF
+extern int _netperf_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_VFS
 extern int _vfs_handler(int argc, char **argv);
 extern int _ls_handler(int argc, char **argv);
@@ -136,6 +143,26 @@ extern int _ls_handler(int argc, char **argv);
 extern int _can_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_XTIMER_STATS
+extern int _xtimer_stats_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_PM_LAYERED_STATS
+extern int _pm_stats_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_AUTO_INIT_PROFILE
+extern int _auto_init_profile_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+extern int _gnrc_pktbuf_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_GNRC_PKTTRACE
+extern int _gnrc_pkttrace_handler(int argc, char **argv);
+#endif
+
 const shell_command_t _shell_command_list[] = {
     {"reboot", "Reboot the node", _reboot_handler},
 #ifdef MODULE_CONFIG
@@ -143,6 +170,8 @@ const shell_command_t _shell_command_list[] = {
 #endif
 #ifdef MODULE_LPC_COMMON
     {"heap", "Shows the heap state for the LPC2387 on the command shell.", _heap_handler},
+#elif defined(MODULE_TLSF_MALLOC)
+    {"heap", "Shows usage and fragmentation of the heap.", _heap_handler},
 #endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
@@ -217,16 +246,37 @@ const shell_command_t _shell_command_list[] = {
     { "ccnl_int", "sends an interest", _ccnl_interest },
     { "ccnl_cont", "create content and populated it", _ccnl_content },
     { "ccnl_fib", "shows or modifies the CCN-Lite FIB", _ccnl_fib },
+#ifdef MODULE_CCN_LITE_CACHE
+    { "ccnl_cs", "shows the CCN-Lite content store statistics", _ccnl_cs },
+#endif
 #endif
 #ifdef MODULE_SNTP
     { "ntpdate", "synchronizes with a remote time server", _ntpdate },
 #endif
+#ifdef MODULE_NETPERF
+    { "netperf", "measures network throughput and latency", _netperf_handler },
+#endif
 #ifdef MODULE_VFS
     {"vfs", "virtual file system operations", _vfs_handler},
     {"ls", "list files", _ls_handler},
 #endif
 #ifdef MODULE_CONN_CAN
     {"can", "CAN commands", _can_handler},
+#endif
+#ifdef MODULE_XTIMER_STATS
+    {"xtimer_stats", "Prints xtimer latency statistics ('xtimer_stats [reset]')", _xtimer_stats_handler},
+#endif
+#ifdef MODULE_PM_LAYERED_STATS
+    {"pm_stats", "Prints power mode residency and wakeups ('pm_stats [reset]')", _pm_stats_handler},
+#endif
+#ifdef MODULE_AUTO_INIT_PROFILE
+    {"autoinit", "Prints the time each auto_init step took", _auto_init_profile_handler},
+#endif
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+    {"pktbuf", "Prints packet buffer counters", _gnrc_pktbuf_handler},
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    {"pkttrace", "Prints per-layer packet latencies ('pkttrace [log|reset]')", _gnrc_pkttrace_handler},
 #endif
     {NULL, NULL, NULL}
 };
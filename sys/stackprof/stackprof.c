@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_stackprof
+ * @{
+ *
+ * @file
+ * @brief       Incremental stack high water mark tracking
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "stackprof.h"
+
+void stackprof_update(thread_t *thread)
+{
+    uintptr_t *start = (uintptr_t *)thread->stack_start;
+    uintptr_t *hwm = thread->stack_hwm;
+    uintptr_t *sp = (uintptr_t *)thread->sp;
+    uintptr_t *scan = thread->stack_scan;
+
+    /* the saved stack pointer is known to be in use */
+    if ((sp >= start) && (sp < hwm)) {
+        hwm = sp;
+    }
+
+    /* check the next couple of words inside the area that is still painted
+     * so far, the stack grows downwards */
+    for (unsigned i = 0; i < STACKPROF_SCAN_WORDS; i++) {
+        if (scan >= hwm) {
+            scan = start;
+            break;
+        }
+        if (*scan != (uintptr_t)scan) {
+            hwm = scan;
+            scan = start;
+            break;
+        }
+        scan++;
+    }
+
+    thread->stack_hwm = hwm;
+    thread->stack_scan = scan;
+}
+
+int stackprof_usage(kernel_pid_t pid)
+{
+    int res = -1;
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread) {
+        res = thread->stack_size -
+              ((char *)thread->stack_hwm - thread->stack_start);
+    }
+    irq_restore(state);
+
+    return res;
+}
+
+void stackprof_print(void)
+{
+    int overall_size = 0, overall_used = 0;
+
+    printf("\tpid | stack ( used) | free\n");
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        thread_t *p = (thread_t *)sched_threads[i];
+
+        if (p != NULL) {
+            int used = stackprof_usage(i);
+            overall_size += p->stack_size;
+            overall_used += used;
+            printf("\t%3" PRIkernel_pid " | %5i (%5i) | %5i\n",
+                   p->pid, p->stack_size, used, p->stack_size - used);
+        }
+    }
+    printf("\tSUM | %5i (%5i) | %5i\n", overall_size, overall_used,
+           overall_size - overall_used);
+}
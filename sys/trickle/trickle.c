@@ -52,6 +52,7 @@ void trickle_interval(trickle_t *trickle)
     trickle->t = random_uint32_range(old_interval, trickle->I);
 
     trickle->msg_time = (trickle->t + diff) * MS_PER_SEC;
+    trickle->msg_deadline = xtimer_now_usec64() + trickle->msg_time;
     xtimer_set_msg64(&trickle->msg_timer, trickle->msg_time, &trickle->msg,
                      trickle->pid);
 }
@@ -89,6 +90,20 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
 void trickle_stop(trickle_t *trickle)
 {
     xtimer_remove(&trickle->msg_timer);
+    trickle->msg_deadline = 0;
+}
+
+uint32_t trickle_time_left(const trickle_t *trickle)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    if (trickle->msg_deadline == 0) {
+        return UINT32_MAX;
+    }
+    if (trickle->msg_deadline <= now) {
+        return 0;
+    }
+    return (uint32_t)((trickle->msg_deadline - now) / US_PER_MS);
 }
 
 void trickle_increment_counter(trickle_t *trickle)
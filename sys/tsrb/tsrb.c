@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -41,12 +43,31 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t first;
+
+    if (n > tsrb_avail(rb)) {
+        n = tsrb_avail(rb);
+    }
+    /* copy up to the end of the buffer, then the rest from its start */
+    first = rb->size - pos;
+    if (first > n) {
+        first = n;
     }
-    return (n - tmp);
+    memcpy(dst, &rb->buf[pos], first);
+    memcpy(dst + first, rb->buf, n - first);
+    /* only hand the space back to the writer after copying */
+    rb->reads += n;
+    return n;
+}
+
+int tsrb_drop(tsrb_t *rb, size_t n)
+{
+    if (n > tsrb_avail(rb)) {
+        n = tsrb_avail(rb);
+    }
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +83,37 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t first;
+
+    if (n > tsrb_free(rb)) {
+        n = tsrb_free(rb);
+    }
+    first = rb->size - pos;
+    if (first > n) {
+        first = n;
     }
-    return (n - tmp);
+    memcpy(&rb->buf[pos], src, first);
+    memcpy(rb->buf, src + first, n - first);
+    /* only hand the bytes to the reader after copying */
+    rb->writes += n;
+    return n;
+}
+
+unsigned tsrb_get_span(const tsrb_t *rb, char **data)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    unsigned avail = tsrb_avail(rb);
+
+    *data = &rb->buf[pos];
+    return (avail < rb->size - pos) ? avail : rb->size - pos;
+}
+
+unsigned tsrb_free_span(const tsrb_t *rb, char **data)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    unsigned free = tsrb_free(rb);
+
+    *data = &rb->buf[pos];
+    return (free < rb->size - pos) ? free : rb->size - pos;
 }
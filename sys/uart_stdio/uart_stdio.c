@@ -34,8 +34,10 @@
 #include "uart_stdio.h"
 
 #include "board.h"
+#include "irq.h"
 #include "periph/uart.h"
 #include "isrpipe.h"
+#include "ringbuffer.h"
 
 #ifdef USE_ETHOS_FOR_STDIO
 #include "ethos.h"
@@ -52,6 +54,72 @@ extern ethos_t ethos;
 static char _rx_buf_mem[UART_STDIO_RX_BUFSIZE];
 isrpipe_t uart_stdio_isrpipe = ISRPIPE_INIT(_rx_buf_mem);
 
+#if !defined(USE_ETHOS_FOR_STDIO) && defined(PERIPH_UART_HAS_INIT_RX_DMA) \
+    && defined(DMA_NUMOF)
+#define UART_STDIO_RX_DMA
+static uint8_t _rx_dma_mem[UART_STDIO_RX_DMA_BUFSIZE];
+
+static void _rx_span(void *arg, const uint8_t *data, size_t len)
+{
+    isrpipe_write(arg, (const char *)data, len);
+}
+#endif
+
+#if !defined(USE_ETHOS_FOR_STDIO) && (UART_STDIO_TX_BUFSIZE > 0)
+#define UART_STDIO_TX_BUF
+static char _tx_buf_mem[UART_STDIO_TX_BUFSIZE];
+static ringbuffer_t _tx_rb = RINGBUFFER_INIT(_tx_buf_mem);
+
+/* bytes handed to the UART, they are copied out of the ringbuffer */
+static uint8_t _tx_chunk[UART_STDIO_TX_CHUNK];
+static uint8_t _tx_busy;
+static uint8_t _tx_sync;
+
+static void _tx_next(void);
+
+static void _tx_done(void *arg)
+{
+    (void)arg;
+    unsigned state = irq_disable();
+    _tx_busy = 0;
+    if (!_tx_sync) {
+        _tx_next();
+    }
+    irq_restore(state);
+}
+
+/* start sending the next chunk, with interrupts disabled */
+static void _tx_next(void)
+{
+    unsigned len;
+
+    if (_tx_busy) {
+        return;
+    }
+    len = ringbuffer_get(&_tx_rb, (char *)_tx_chunk, sizeof(_tx_chunk));
+    if (len) {
+        _tx_busy = 1;
+        uart_write_async(UART_STDIO_DEV, _tx_chunk, len, _tx_done, NULL);
+    }
+}
+
+/* send everything queued by polling, with interrupts disabled */
+static void _tx_flush(void)
+{
+    unsigned len;
+
+    _tx_sync = 1;
+    /* completes the chunk in flight, which must not be followed by the
+     * next one from the callback */
+    uart_write(UART_STDIO_DEV, NULL, 0);
+    while ((len = ringbuffer_get(&_tx_rb, (char *)_tx_chunk,
+                                 sizeof(_tx_chunk)))) {
+        uart_write(UART_STDIO_DEV, _tx_chunk, len);
+    }
+    _tx_sync = 0;
+}
+#endif
+
 #if MODULE_VFS
 static ssize_t uart_stdio_vfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t uart_stdio_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
@@ -85,7 +153,10 @@ static ssize_t uart_stdio_vfs_write(vfs_file_t *filp, const void *src, size_t nb
 
 void uart_stdio_init(void)
 {
-#ifndef USE_ETHOS_FOR_STDIO
+#if defined(UART_STDIO_RX_DMA)
+    uart_init_rx_dma(UART_STDIO_DEV, UART_STDIO_BAUDRATE, _rx_dma_mem,
+                     sizeof(_rx_dma_mem), _rx_span, &uart_stdio_isrpipe);
+#elif !defined(USE_ETHOS_FOR_STDIO)
     uart_init(UART_STDIO_DEV, UART_STDIO_BAUDRATE, (uart_rx_cb_t) isrpipe_write_one, &uart_stdio_isrpipe);
 #else
     uart_init(ETHOS_UART, ETHOS_BAUDRATE, (uart_rx_cb_t) isrpipe_write_one, &uart_stdio_isrpipe);
@@ -114,10 +185,49 @@ int uart_stdio_read(char* buffer, int count)
 
 int uart_stdio_write(const char* buffer, int len)
 {
-#ifndef USE_ETHOS_FOR_STDIO
+#if defined(UART_STDIO_TX_BUF)
+    unsigned state = irq_disable();
+#if UART_STDIO_TX_POLICY == UART_STDIO_TX_DROP_OLDEST
+    unsigned n = len;
+
+    if (n > _tx_rb.size) {
+        buffer += n - _tx_rb.size;
+        n = _tx_rb.size;
+    }
+    if (n > ringbuffer_get_free(&_tx_rb)) {
+        ringbuffer_remove(&_tx_rb, n - ringbuffer_get_free(&_tx_rb));
+    }
+    ringbuffer_add(&_tx_rb, buffer, n);
+#elif UART_STDIO_TX_POLICY == UART_STDIO_TX_DROP_NEWEST
+    ringbuffer_add(&_tx_rb, buffer, len);
+#else
+    unsigned done = ringbuffer_add(&_tx_rb, buffer, len);
+
+    while (done < (unsigned)len) {
+        irq_restore(state);
+        /* wait until the buffer is sent, this polls the UART, so it works
+         * in interrupt context and with interrupts disabled as well */
+        uart_write(UART_STDIO_DEV, NULL, 0);
+        state = irq_disable();
+        _tx_next();
+        done += ringbuffer_add(&_tx_rb, &buffer[done], len - done);
+    }
+#endif
+    _tx_next();
+    irq_restore(state);
+#elif !defined(USE_ETHOS_FOR_STDIO)
     uart_write(UART_STDIO_DEV, (const uint8_t *)buffer, (size_t)len);
 #else
     ethos_send_frame(&ethos, (const uint8_t *)buffer, len, ETHOS_FRAME_TYPE_TEXT);
 #endif
     return len;
 }
+
+void uart_stdio_flush(void)
+{
+#if defined(UART_STDIO_TX_BUF)
+    unsigned state = irq_disable();
+    _tx_flush();
+    irq_restore(state);
+#endif
+}
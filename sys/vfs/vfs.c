@@ -117,6 +117,19 @@ inline static int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
  */
 inline static int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path);
 
+/**
+ * @internal
+ * @brief Insert a mount into the list of mounts, ordered by descending length
+ * of the mount point
+ *
+ * This way _find_mount() can stop at the first match, which is the longest
+ * one. A mount is inserted before the mounts with the same length, so it
+ * shadows them like before.
+ *
+ * @param[in]  mountp  the mount to insert
+ */
+static void _insert_mount(vfs_mount_t *mountp);
+
 /**
  * @internal
  * @brief Check that a given fd number is valid
@@ -287,6 +300,28 @@ int vfs_open(const char *name, int flags, mode_t mode)
     return fd;
 }
 
+int vfs_mmap(int fd, const void **addr, size_t *len)
+{
+    DEBUG("vfs_mmap: %d, %p, %p\n", fd, (void *)addr, (void *)len);
+    if ((addr == NULL) || (len == NULL)) {
+        return -EFAULT;
+    }
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (((filp->flags & O_ACCMODE) != O_RDONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for reading */
+        return -EBADF;
+    }
+    if (filp->f_op->mmap == NULL) {
+        /* driver does not implement mmap() */
+        return -EINVAL;
+    }
+    return filp->f_op->mmap(filp, addr, len);
+}
+
 ssize_t vfs_read(int fd, void *dest, size_t count)
 {
     DEBUG("vfs_read: %d, %p, %lu\n", fd, dest, (unsigned long)count);
@@ -332,6 +367,21 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
     return filp->f_op->write(filp, src, count);
 }
 
+int vfs_poll(int fd, unsigned events, kernel_pid_t waiter)
+{
+    DEBUG("vfs_poll: %d, 0x%x, %d\n", fd, events, (int)waiter);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->poll == NULL) {
+        /* files without readiness are never blocking */
+        return events & (VFS_POLLIN | VFS_POLLOUT);
+    }
+    return filp->f_op->poll(filp, events, waiter);
+}
+
 int vfs_opendir(vfs_DIR *dirp, const char *dirname)
 {
     DEBUG("vfs_opendir: %p, \"%s\"\n", (void *)dirp, dirname);
@@ -438,8 +488,7 @@ int vfs_mount(vfs_mount_t *mountp)
             }
         }
     }
-    /* insert last in list */
-    clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    _insert_mount(mountp);
     mutex_unlock(&_mount_mutex);
     DEBUG("vfs_mount: mount done\n");
     return 0;
@@ -861,6 +910,26 @@ inline static int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
     return fd;
 }
 
+static void _insert_mount(vfs_mount_t *mountp)
+{
+    size_t len = mountp->mount_point_len;
+    clist_node_t *prev = _vfs_mounts_list.next;
+
+    if ((prev == NULL) ||
+        (container_of(prev, vfs_mount_t, list_entry)->mount_point_len > len)) {
+        /* list empty or all mount points are longer: insert last */
+        clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+        return;
+    }
+    /* start with the head, there is a shorter or equal mount point at the
+     * latest at the end of the list */
+    while (container_of(prev->next, vfs_mount_t, list_entry)->mount_point_len > len) {
+        prev = prev->next;
+    }
+    mountp->list_entry.next = prev->next;
+    prev->next = &mountp->list_entry;
+}
+
 inline static int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path)
 {
     size_t longest_match = 0;
@@ -878,10 +947,6 @@ inline static int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         node = node->next;
         vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
         size_t len = it->mount_point_len;
-        if (len < longest_match) {
-            /* Already found a longer prefix */
-            continue;
-        }
         if (len > name_len) {
             /* path name is shorter than the mount point name */
             continue;
@@ -891,12 +956,14 @@ inline static int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
             continue;
         }
         if (strncmp(name, it->mount_point, len) == 0) {
-            /* mount_point is a prefix of name */
+            /* mount_point is a prefix of name, and as the list is sorted by
+             * length (see _insert_mount()) the longest one */
             /* special check for mount_point == "/" */
             if (len > 1) {
                 longest_match = len;
             }
             mountp = it;
+            break;
         }
     } while (node != _vfs_mounts_list.next);
     if (mountp == NULL) {
@@ -130,6 +130,65 @@ out:
     *last_wakeup = target;
 }
 
+#ifdef MODULE_CORE_THREAD_FLAGS
+static void _periodic_callback(void *arg)
+{
+    xtimer_periodic_t *periodic = (xtimer_periodic_t *)arg;
+    uint32_t periods = 1;
+    uint32_t late = _xtimer_now() - periodic->next;
+
+    if (late >= periodic->period) {
+        /* skip the periods we missed, staying in phase */
+        periods += late / periodic->period;
+    }
+    periodic->next += periods * periodic->period;
+    periodic->elapsed += periods;
+
+    _xtimer_set_absolute(&periodic->timer, periodic->next);
+    thread_flags_set(periodic->thread, periodic->flag);
+}
+
+void xtimer_periodic_start(xtimer_periodic_t *periodic, uint32_t period,
+                           thread_flags_t flag)
+{
+    periodic->period = _xtimer_ticks_from_usec(period);
+    assert(periodic->period > XTIMER_PERIODIC_SPIN);
+
+    periodic->timer.target = periodic->timer.long_target = 0;
+    periodic->timer.callback = _periodic_callback;
+    periodic->timer.arg = periodic;
+    periodic->thread = (thread_t *)sched_active_thread;
+    periodic->flag = flag;
+    periodic->elapsed = 0;
+
+    unsigned state = irq_disable();
+    periodic->next = _xtimer_now() + periodic->period;
+    _xtimer_set_absolute(&periodic->timer, periodic->next);
+    irq_restore(state);
+}
+
+void xtimer_periodic_stop(xtimer_periodic_t *periodic)
+{
+    xtimer_remove(&periodic->timer);
+    thread_flags_clear(periodic->flag);
+}
+
+uint32_t xtimer_periodic_wait(xtimer_periodic_t *periodic)
+{
+    uint32_t elapsed;
+
+    do {
+        thread_flags_wait_any(periodic->flag);
+        unsigned state = irq_disable();
+        elapsed = periodic->elapsed;
+        periodic->elapsed = 0;
+        irq_restore(state);
+    } while (!elapsed);
+
+    return elapsed - 1;
+}
+#endif
+
 static void _callback_msg(void* arg)
 {
     msg_t *msg = (msg_t*)arg;
@@ -186,46 +245,46 @@ void xtimer_now_timex(timex_t *out)
     out->microseconds = now - (out->seconds * US_PER_SEC);
 }
 
-/* Prepares the message to trigger the timeout.
- * Additionally, the xtimer_t struct gets initialized.
- */
-static void _setup_timer_msg(msg_t *m, xtimer_t *t)
+typedef struct {
+    kernel_pid_t pid;
+    msg_t *msg;
+    volatile int cancelled;
+} _msg_timeout_t;
+
+static void _msg_timeout(void *arg)
 {
-    m->type = MSG_XTIMER;
-    m->content.ptr = m;
+    _msg_timeout_t *mt = (_msg_timeout_t *)arg;
 
-    t->target = t->long_target = 0;
+    msg_receive_cancel(mt->pid, mt->msg, &mt->cancelled);
 }
 
-/* Waits for incoming message or timeout. */
-static int _msg_wait(msg_t *m, msg_t *tmsg, xtimer_t *t)
+/* Waits for incoming message or timeout. The timeout wakes the thread up
+ * directly, so it doesn't need a slot in the thread's message queue. */
+static int _msg_wait(msg_t *m, uint32_t offset, uint32_t long_offset)
 {
-    msg_receive(m);
-    if (m->type == MSG_XTIMER && m->content.ptr == tmsg) {
-        /* we hit the timeout */
-        return -1;
-    }
-    else {
-        xtimer_remove(t);
-        return 1;
-    }
+    xtimer_t t;
+    _msg_timeout_t mt = { sched_active_pid, m, 0 };
+
+    t.target = t.long_target = 0;
+    t.callback = _msg_timeout;
+    t.arg = (void *)&mt;
+
+    /* short timeouts fire right away, set from within _xtimer_set64() */
+    _xtimer_set64(&t, offset, long_offset);
+
+    int res = msg_receive_cancellable(m, &mt.cancelled);
+    xtimer_remove(&t);
+
+    return res;
 }
 
 int _xtimer_msg_receive_timeout64(msg_t *m, uint64_t timeout_ticks) {
-    msg_t tmsg;
-    xtimer_t t;
-    _setup_timer_msg(&tmsg, &t);
-    _xtimer_set_msg64(&t, timeout_ticks, &tmsg, sched_active_pid);
-    return _msg_wait(m, &tmsg, &t);
+    return _msg_wait(m, timeout_ticks, timeout_ticks >> 32);
 }
 
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout_ticks)
 {
-    msg_t tmsg;
-    xtimer_t t;
-    _setup_timer_msg(&tmsg, &t);
-    _xtimer_set_msg(&t, timeout_ticks, &tmsg, sched_active_pid);
-    return _msg_wait(msg, &tmsg, &t);
+    return _msg_wait(msg, timeout_ticks, 0);
 }
 
 static void _mutex_timeout(void *arg)
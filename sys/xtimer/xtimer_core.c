@@ -35,14 +35,33 @@ static volatile uint32_t _long_cnt = 0;
 volatile uint32_t _xtimer_high_cnt = 0;
 #endif
 
+/* incremented before and after the period counters are advanced, so readers
+ * can detect a concurrent update without disabling interrupts */
+static volatile uint32_t _period_seq = 0;
+/* time at the start of the current low-level timer period in milliseconds
+ * plus remaining microseconds, for xtimer_now_coarse_ms() */
+static volatile uint32_t _period_start_ms = 0;
+static volatile uint32_t _period_start_us = 0;
+
 static inline void xtimer_spin_until(uint32_t value);
 
 static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
+#ifdef MODULE_XTIMER_SLACK
+/* largest slack requested so far, bounds the search for timers to coalesce */
+static uint32_t _max_slack = 0;
+#endif
+#ifdef MODULE_XTIMER_WHEEL
+static xtimer_t *timer_wheel[XTIMER_WHEEL_SLOTS];
+#else
 static xtimer_t *long_list_head = NULL;
+#endif
+#ifdef MODULE_XTIMER_STATS
+static xtimer_stats_t _stats;
+#endif
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
-static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+static void _add_timer_to_long_list(xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -58,6 +77,90 @@ static inline int _is_set(xtimer_t *timer)
     return (timer->target || timer->long_target);
 }
 
+#ifdef MODULE_XTIMER_WHEEL
+/**
+ * @brief   Get the number of the low-level timer period a target lies in
+ */
+static inline uint64_t _period(uint32_t long_target, uint32_t target)
+{
+#if XTIMER_MASK
+    return ((uint64_t)long_target << (32 - XTIMER_WIDTH)) |
+           (target >> XTIMER_WIDTH);
+#else
+    (void)target;
+    return long_target;
+#endif
+}
+
+static inline uint64_t _current_period(void)
+{
+#if XTIMER_MASK
+    return _period(_long_cnt, _xtimer_high_cnt);
+#else
+    return _period(_long_cnt, 0);
+#endif
+}
+
+static inline xtimer_t **_wheel_slot(uint64_t period)
+{
+    return &timer_wheel[period & (XTIMER_WHEEL_SLOTS - 1)];
+}
+#endif
+
+#ifdef MODULE_XTIMER_STATS
+static unsigned _stats_bucket(uint32_t value)
+{
+    unsigned bucket = 0;
+
+    while (value && (bucket < (XTIMER_STATS_BUCKETS - 1))) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/* called right before a timer that expired at low-level time @p target is
+ * fired from the timer interrupt */
+static inline void _stats_latency(uint32_t target)
+{
+    uint32_t latency = _xtimer_lltimer_mask(_xtimer_lltimer_now() - target);
+
+    _stats.latency[_stats_bucket(latency)]++;
+    if (latency > _stats.latency_max) {
+        _stats.latency_max = latency;
+    }
+}
+
+static inline void _stats_spin(uint32_t ticks)
+{
+    _stats.spins++;
+    _stats.spin_ticks += ticks;
+}
+
+static inline void _stats_depth(unsigned depth)
+{
+    _stats.depth[_stats_bucket(depth)]++;
+}
+
+void xtimer_stats_get(xtimer_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+
+void xtimer_stats_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(&_stats, 0, sizeof(_stats));
+    irq_restore(state);
+}
+#else
+static inline void _stats_latency(uint32_t target) { (void)target; }
+static inline void _stats_spin(uint32_t ticks) { (void)ticks; }
+static inline void _stats_depth(unsigned depth) { (void)depth; }
+#endif
+
 static inline void xtimer_spin_until(uint32_t target) {
 #if XTIMER_MASK
     target = _xtimer_lltimer_mask(target);
@@ -77,18 +180,14 @@ void xtimer_init(void)
 
 static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
 {
-    uint32_t before, after, long_value;
+    uint32_t seq;
 
-    /* loop to cope with possible overflow of _xtimer_now() */
+    /* retry if the period counters were advanced while reading */
     do {
-        before = _xtimer_now();
-        long_value = _long_cnt;
-        after = _xtimer_now();
-
-    } while(before > after);
-
-    *short_term = after;
-    *long_term = long_value;
+        seq = _period_seq;
+        *short_term = _xtimer_now();
+        *long_term = _long_cnt;
+    } while ((seq & 1) || (seq != _period_seq));
 }
 
 uint64_t _xtimer_now64(void)
@@ -99,6 +198,26 @@ uint64_t _xtimer_now64(void)
     return ((uint64_t)long_term<<32) + short_term;
 }
 
+uint32_t xtimer_now_coarse_ms(void)
+{
+    uint32_t seq, ticks, ms, us;
+
+    do {
+        seq = _period_seq;
+        ticks = _xtimer_lltimer_now();
+        ms = _period_start_ms;
+        us = _period_start_us;
+    } while ((seq & 1) || (seq != _period_seq));
+
+#if (XTIMER_WIDTH < 32) || (XTIMER_HZ >= 1000000ul)
+    /* time since the period start fits into 32 bit microseconds */
+    uint32_t period_us = _xtimer_usec_from_ticks(ticks);
+    return ms + (period_us / 1000) + ((us + (period_us % 1000)) / 1000);
+#else
+    return ms + (uint32_t)((_xtimer_usec_from_ticks64(ticks) + us) / 1000);
+#endif
+}
+
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 {
     DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
@@ -112,6 +231,9 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
             _remove(timer);
         }
 
+#ifdef MODULE_XTIMER_SLACK
+        timer->slack = 0;
+#endif
         _xtimer_now_internal(&timer->target, &timer->long_target);
         timer->target += offset;
         timer->long_target += long_offset;
@@ -119,7 +241,7 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
             timer->long_target++;
         }
 
-        _add_timer_to_long_list(&long_list_head, timer);
+        _add_timer_to_long_list(timer);
         irq_restore(state);
         DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
                 timer->long_target, timer->target);
@@ -138,6 +260,7 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     xtimer_remove(timer);
 
     if (offset < XTIMER_BACKOFF) {
+        _stats_spin(offset);
         _xtimer_spin(offset);
         _shoot(timer);
     }
@@ -147,6 +270,26 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
 }
 
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    /* the timer is sorted in by the end of its window */
+    if ((offset + slack) < offset) {
+        slack = UINT32_MAX - offset;
+    }
+    _xtimer_set(timer, offset + slack);
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        timer->slack = slack;
+        if (slack > _max_slack) {
+            _max_slack = slack;
+        }
+    }
+    irq_restore(state);
+}
+#endif
+
 static void _periph_timer_callback(void *arg, int chan)
 {
     (void)arg;
@@ -178,6 +321,7 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     timer->next = NULL;
     if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
         /* backoff */
+        _stats_spin(target + XTIMER_BACKOFF - now);
         xtimer_spin_until(target + XTIMER_BACKOFF);
         _shoot(timer);
         return 0;
@@ -188,6 +332,9 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
         _remove(timer);
     }
 
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = 0;
+#endif
     timer->target = target;
     timer->long_target = _long_cnt;
     if (target < now) {
@@ -196,7 +343,7 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     if ( (timer->long_target > _long_cnt) || !_this_high_period(target) ) {
         DEBUG("xtimer_set_absolute(): the timer doesn't fit into the low-level timer's mask.\n");
-        _add_timer_to_long_list(&long_list_head, timer);
+        _add_timer_to_long_list(timer);
     }
     else {
         if (_xtimer_lltimer_mask(now) >= target) {
@@ -221,16 +368,32 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
+    unsigned depth = 0;
+
     while (*list_head && (*list_head)->target <= timer->target) {
         list_head = &((*list_head)->next);
+        depth++;
     }
+    _stats_depth(depth);
 
     timer->next = *list_head;
     *list_head = timer;
 }
 
-static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
+#ifdef MODULE_XTIMER_WHEEL
+static void _add_timer_to_long_list(xtimer_t *timer)
 {
+    /* timers of later periods are kept unsorted */
+    xtimer_t **slot = _wheel_slot(_period(timer->long_target, timer->target));
+
+    timer->next = *slot;
+    *slot = timer;
+}
+#else
+static void _add_timer_to_long_list(xtimer_t *timer)
+{
+    xtimer_t **list_head = &long_list_head;
+
     while (*list_head
         && (((*list_head)->long_target < timer->long_target)
         || (((*list_head)->long_target == timer->long_target) && ((*list_head)->target <= timer->target)))) {
@@ -240,6 +403,7 @@ static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
     timer->next = *list_head;
     *list_head = timer;
 }
+#endif
 
 static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 {
@@ -256,6 +420,16 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 
 static void _remove(xtimer_t *timer)
 {
+#ifdef MODULE_XTIMER_WHEEL
+    /* all timers of later periods are in the wheel, so only one slot has to
+     * be searched */
+    uint64_t period = _period(timer->long_target, timer->target);
+    if (period > _current_period()) {
+        _remove_timer_from_list(_wheel_slot(period), timer);
+        return;
+    }
+#endif
+
     if (timer_list_head == timer) {
         uint32_t next;
         timer_list_head = timer->next;
@@ -270,9 +444,13 @@ static void _remove(xtimer_t *timer)
     }
     else {
         if (!_remove_timer_from_list(&timer_list_head, timer)) {
+#ifdef MODULE_XTIMER_WHEEL
+            _remove_timer_from_list(&overflow_list_head, timer);
+#else
             if (!_remove_timer_from_list(&overflow_list_head, timer)) {
                 _remove_timer_from_list(&long_list_head, timer);
             }
+#endif
         }
     }
 }
@@ -286,6 +464,23 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+xtimer_ticks32_t xtimer_time_to_next_event(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = _xtimer_lltimer_now();
+    uint32_t next;
+
+    if (timer_list_head) {
+        next = _xtimer_lltimer_mask(timer_list_head->target - XTIMER_OVERHEAD);
+    }
+    else {
+        next = _xtimer_lltimer_mask(0xFFFFFFFF);
+    }
+    irq_restore(state);
+
+    return xtimer_ticks((next > now) ? (next - now) : 0);
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -311,6 +506,29 @@ static inline int _this_high_period(uint32_t target) {
 #endif
 }
 
+#ifdef MODULE_XTIMER_WHEEL
+/**
+ * @brief move the timers of the wheel slot of the current period into the
+ *        (sorted) current timer list
+ */
+static void _select_long_timers(void)
+{
+    uint64_t period = _current_period();
+    xtimer_t **pos = _wheel_slot(period);
+
+    while (*pos) {
+        xtimer_t *timer = *pos;
+        if (_period(timer->long_target, timer->target) == period) {
+            *pos = timer->next;
+            _add_timer_to_list(&timer_list_head, timer);
+        }
+        else {
+            /* belongs to a later round of the wheel */
+            pos = &timer->next;
+        }
+    }
+}
+#else
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -400,12 +618,18 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
  */
 static void _next_period(void)
 {
+    /* length of one low-level timer period, a compile time constant */
+    uint64_t period_us = _xtimer_usec_from_ticks64(1ULL << XTIMER_WIDTH);
+    uint32_t us = _period_start_us + (uint32_t)(period_us % 1000);
+
+    _period_seq++;
 #if XTIMER_MASK
     /* advance <32bit mask register */
     _xtimer_high_cnt += ~XTIMER_MASK + 1;
@@ -417,6 +641,9 @@ static void _next_period(void)
     /* advance >32bit counter */
     _long_cnt++;
 #endif
+    _period_start_ms += (uint32_t)(period_us / 1000) + (us / 1000);
+    _period_start_us = us % 1000;
+    _period_seq++;
 
     /* swap overflow list to current timer list */
     timer_list_head = overflow_list_head;
@@ -425,6 +652,40 @@ static void _next_period(void)
     _select_long_timers();
 }
 
+#ifdef MODULE_XTIMER_SLACK
+/**
+ * @brief fire the first timer of the current list whose slack window has
+ *        already started
+ *
+ * @return 1 if a timer was fired, 0 otherwise
+ */
+static int _fire_slack_timer(uint32_t reference)
+{
+    xtimer_t **pos = &timer_list_head;
+
+    while (*pos) {
+        xtimer_t *timer = *pos;
+        uint32_t left = _time_left(_xtimer_lltimer_mask(timer->target), reference);
+
+        if (left > _max_slack) {
+            /* the list is sorted by the end of the windows, no later timer's
+             * window can have started yet */
+            break;
+        }
+        if (left <= timer->slack) {
+            *pos = timer->next;
+            timer->target = 0;
+            timer->long_target = 0;
+            _shoot(timer);
+            return 1;
+        }
+        pos = &timer->next;
+    }
+
+    return 0;
+}
+#endif
+
 /**
  * @brief main xtimer callback function
  */
@@ -466,7 +727,12 @@ overflow:
     /* check if next timers are close to expiring */
     while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
         /* make sure we don't fire too early */
-        while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
+        uint32_t early = _time_left(_xtimer_lltimer_mask(timer_list_head->target), reference);
+        if (early) {
+            _stats_spin(early);
+            while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
+        }
+        _stats_latency(_xtimer_lltimer_mask(timer_list_head->target));
 
         /* pick first timer in list */
         xtimer_t *timer = timer_list_head;
@@ -482,6 +748,14 @@ overflow:
         _shoot(timer);
     }
 
+#ifdef MODULE_XTIMER_SLACK
+    /* piggy-back timers that may fire now on this wakeup. The callback may
+     * have changed the list, so start over after each one. */
+    if (_fire_slack_timer(reference)) {
+        goto overflow;
+    }
+#endif
+
     /* possibly executing all callbacks took enough
      * time to overflow.  In that case we advance to
      * next timer period and check again for expired
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_xtimer_rtt
+ * @{
+ *
+ * @file
+ * @brief       Low-power clock domain for xtimer implementation
+ *
+ * All pending RTT alarms are kept within half of the RTT's range from the
+ * current counter value, so that they can be compared with modular
+ * arithmetic and no software extension of the RTT counter is needed.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+
+#include "irq.h"
+#include "periph/rtt.h"
+#include "xtimer_rtt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* longest distance of a single RTT alarm */
+#define RTT_HOP         (RTT_MAX_VALUE >> 1)
+
+/* handover time in RTT ticks, at least two ticks */
+#define HANDOVER_TICKS  ((RTT_US_TO_TICKS(XTIMER_RTT_HANDOVER) > 2) ? \
+                         RTT_US_TO_TICKS(XTIMER_RTT_HANDOVER) : 2)
+
+static xtimer_rtt_t *_list;
+
+static void _rtt_cb(void *arg);
+
+static inline uint32_t _ticks_until(uint32_t target, uint32_t now)
+{
+    return (target - now) & RTT_MAX_VALUE;
+}
+
+static inline int _reached(uint32_t target, uint32_t now)
+{
+    return ((now - target) & RTT_MAX_VALUE) <= RTT_HOP;
+}
+
+static void _add(xtimer_rtt_t *timer, uint32_t now)
+{
+    xtimer_rtt_t **pos = &_list;
+    uint32_t ticks = _ticks_until(timer->rtt_target, now);
+
+    while (*pos && (_ticks_until((*pos)->rtt_target, now) <= ticks)) {
+        pos = &(*pos)->next;
+    }
+    timer->next = *pos;
+    *pos = timer;
+}
+
+static int _unlink(xtimer_rtt_t *timer)
+{
+    for (xtimer_rtt_t **pos = &_list; *pos; pos = &(*pos)->next) {
+        if (*pos == timer) {
+            *pos = timer->next;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void _hop(xtimer_rtt_t *timer)
+{
+    uint64_t ticks = timer->rtt_left;
+
+    if (ticks > RTT_HOP) {
+        ticks = RTT_HOP;
+    }
+    timer->rtt_target = (timer->rtt_target + ticks) & RTT_MAX_VALUE;
+    timer->rtt_left -= ticks;
+}
+
+static void _update_alarm(void)
+{
+    if (_list) {
+        rtt_set_alarm(_list->rtt_target, _rtt_cb, NULL);
+    }
+    else {
+        rtt_clear_alarm();
+    }
+}
+
+static void _process(void)
+{
+    uint32_t now = rtt_get_counter();
+
+    while (_list && _reached(_list->rtt_target, now)) {
+        xtimer_rtt_t *timer = _list;
+        _list = timer->next;
+
+        if (timer->rtt_left > HANDOVER_TICKS) {
+            /* still far away, wait for the next alarm */
+            _hop(timer);
+            _add(timer, now);
+            continue;
+        }
+
+        /* hand the rest over to xtimer */
+        uint32_t ticks = _ticks_until(timer->rtt_target + timer->rtt_left, now);
+        uint32_t rest = timer->rtt_rest;
+        if (ticks > RTT_HOP) {
+            /* we are late, the target already passed */
+            ticks = 0;
+            rest = 0;
+        }
+        DEBUG("xtimer_rtt: handing over, %" PRIu32 " ticks left\n", ticks);
+        xtimer_set(&timer->timer, RTT_TICKS_TO_US(ticks) + rest);
+    }
+
+    _update_alarm();
+}
+
+static void _rtt_cb(void *arg)
+{
+    (void)arg;
+    _process();
+}
+
+void xtimer_rtt_init(void)
+{
+    rtt_init();
+}
+
+void xtimer_rtt_set(xtimer_rtt_t *timer, uint64_t offset)
+{
+    xtimer_rtt_remove(timer);
+
+    uint64_t ticks = (offset * RTT_FREQUENCY) / US_PER_SEC;
+
+    if ((offset < XTIMER_RTT_THRESHOLD) || (ticks <= 2 * HANDOVER_TICKS)) {
+        xtimer_set(&timer->timer, (uint32_t)offset);
+        return;
+    }
+
+    /* the RTT alarm fires HANDOVER_TICKS early */
+    unsigned state = irq_disable();
+    uint32_t now = rtt_get_counter();
+
+    timer->rtt_target = now;
+    timer->rtt_rest = offset - (ticks * US_PER_SEC) / RTT_FREQUENCY;
+    timer->rtt_left = ticks - HANDOVER_TICKS;
+    _hop(timer);
+    timer->rtt_left += HANDOVER_TICKS;
+
+    _add(timer, now);
+    if (_list == timer) {
+        _update_alarm();
+    }
+    irq_restore(state);
+
+    /* the alarm might have been set too close to the current counter value */
+    if (_reached(timer->rtt_target, rtt_get_counter())) {
+        state = irq_disable();
+        _process();
+        irq_restore(state);
+    }
+}
+
+void xtimer_rtt_remove(xtimer_rtt_t *timer)
+{
+    unsigned state = irq_disable();
+
+    if (_unlink(timer)) {
+        _update_alarm();
+    }
+    irq_restore(state);
+
+    xtimer_remove(&timer->timer);
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for ciphers, hashes and ECDSA
+ *
+ * Every result is printed as a CSV line after a header line, the time per
+ * byte of the signatures is that per byte of the signed digest.
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "crypto/aes.h"
+#include "crypto/chacha.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "hashes/cmac.h"
+#include "hashes/md5.h"
+#include "hashes/sha1.h"
+#include "hashes/sha256.h"
+
+#ifdef MODULE_MICRO_ECC
+#include "uECC.h"
+#endif
+#ifdef MODULE_RELIC
+#include "relic.h"
+#endif
+
+#define RUNS            (20UL)
+#define ECC_RUNS        (4UL)
+#define BUF_SIZE        (1024U)
+
+#define CCM_MAC_LEN     (8U)
+#define CCM_NONCE_LEN   (13U)
+
+static const unsigned sizes[] = { 16, 64, 256, 1024 };
+
+static const uint8_t key[AES_KEY_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+static const uint8_t chacha_key[32] = {
+    0xc4, 0x6e, 0xc1, 0xb1, 0x8c, 0xe8, 0xa8, 0x78,
+    0x72, 0x5a, 0x37, 0xe7, 0x80, 0xdf, 0xb7, 0x35,
+};
+static const uint8_t nonce[CCM_NONCE_LEN] = {
+    0x1a, 0xda, 0x31, 0xd5, 0xcf, 0x68, 0x82, 0x21,
+    0x00, 0x01, 0x02, 0x03, 0x04,
+};
+
+static uint32_t in[BUF_SIZE / sizeof(uint32_t)];
+static uint32_t out[(BUF_SIZE + CCM_MAC_LEN) / sizeof(uint32_t)];
+static uint8_t digest[SHA256_DIGEST_LENGTH];
+static cipher_t cipher;
+static chacha_ctx chacha;
+
+typedef struct {
+    const char *name;
+    void (*run)(size_t len);
+} bench_t;
+
+static void _aes_ecb(size_t len)
+{
+    cipher_encrypt_ecb(&cipher, (uint8_t *)in, len, (uint8_t *)out);
+}
+
+static void _aes_cbc(size_t len)
+{
+    uint8_t iv[AES_BLOCK_SIZE] = { 0 };
+
+    cipher_encrypt_cbc(&cipher, iv, (uint8_t *)in, len, (uint8_t *)out);
+}
+
+static void _aes_ctr(size_t len)
+{
+    uint8_t ctr[AES_BLOCK_SIZE] = { 0 };
+
+    cipher_encrypt_ctr(&cipher, ctr, 0, (uint8_t *)in, len, (uint8_t *)out);
+}
+
+static void _aes_ccm(size_t len)
+{
+    cipher_encrypt_ccm(&cipher, NULL, 0, CCM_MAC_LEN, 15 - CCM_NONCE_LEN,
+                       (uint8_t *)nonce, sizeof(nonce), (uint8_t *)in, len,
+                       (uint8_t *)out);
+}
+
+static void _chacha20(size_t len)
+{
+    chacha_encrypt(&chacha, in, out, len);
+}
+
+static void _md5(size_t len)
+{
+    md5(digest, in, len);
+}
+
+static void _sha1(size_t len)
+{
+    sha1(digest, in, len);
+}
+
+static void _sha256(size_t len)
+{
+    sha256(in, len, digest);
+}
+
+static void _hmac_sha256(size_t len)
+{
+    hmac_sha256(key, sizeof(key), in, len, digest);
+}
+
+static void _cmac(size_t len)
+{
+    cmac_context_t ctx;
+
+    cmac_init(&ctx, key, sizeof(key));
+    cmac_update(&ctx, in, len);
+    cmac_final(&ctx, digest);
+}
+
+static const bench_t benchs[] = {
+    { "aes-128-ecb", _aes_ecb },
+    { "aes-128-cbc", _aes_cbc },
+    { "aes-128-ctr", _aes_ctr },
+    { "aes-128-ccm", _aes_ccm },
+    { "chacha20", _chacha20 },
+    { "md5", _md5 },
+    { "sha1", _sha1 },
+    { "sha256", _sha256 },
+    { "hmac-sha256", _hmac_sha256 },
+    { "cmac-aes-128", _cmac },
+};
+
+static void _print(const char *name, size_t len, unsigned long runs,
+                   uint32_t total)
+{
+    uint64_t per_run = ((uint64_t)total * 100) / runs;
+    uint64_t per_byte = per_run / len;
+
+    printf("%s,%u,%lu,%lu.%02u,%lu.%02u,%s\n", name, (unsigned)len, runs,
+           (unsigned long)(per_run / 100), (unsigned)(per_run % 100),
+           (unsigned long)(per_byte / 100), (unsigned)(per_byte % 100),
+           BENCHMARK_UNIT);
+}
+
+#ifdef MODULE_MICRO_ECC
+/* the key pair of tests/pkg_micro-ecc */
+static const uint8_t uecc_private[] = {
+    0x9b, 0x4c, 0x4b, 0xa0, 0xb7, 0xb1, 0x25, 0x23,
+    0x9c, 0x09, 0x85, 0x4f, 0x9a, 0x21, 0xb4, 0x14,
+    0x70, 0xe0, 0xce, 0x21, 0x25, 0x00, 0xa5, 0x62,
+    0x34, 0xa4, 0x25, 0xf0, 0x0f, 0x00, 0xeb, 0xe7,
+};
+static const uint8_t uecc_public[] = {
+    0x54, 0x3e, 0x98, 0xf8, 0x14, 0x55, 0x08, 0x13,
+    0xb5, 0x1a, 0x1d, 0x02, 0x02, 0xd7, 0x0e, 0xab,
+    0xa0, 0x98, 0x74, 0x61, 0x91, 0x12, 0x3d, 0x96,
+    0x50, 0xfa, 0xd5, 0x94, 0xa2, 0x86, 0xa8, 0xb0,
+    0xd0, 0x7b, 0xda, 0x36, 0xba, 0x8e, 0xd3, 0x9a,
+    0xa0, 0x16, 0x11, 0x0e, 0x1b, 0x6e, 0x81, 0x13,
+    0xd7, 0xf4, 0x23, 0xa1, 0xb2, 0x9b, 0xaf, 0xf6,
+    0x6b, 0xc4, 0x2a, 0xdf, 0xbd, 0xe4, 0x61, 0x5c,
+};
+
+typedef struct {
+    uECC_HashContext uECC;
+    sha256_context_t ctx;
+} uecc_sha256_ctx_t;
+
+static void _uecc_init_hash(const uECC_HashContext *base)
+{
+    sha256_init(&((uecc_sha256_ctx_t *)base)->ctx);
+}
+
+static void _uecc_update_hash(const uECC_HashContext *base,
+                              const uint8_t *message, unsigned message_size)
+{
+    sha256_update(&((uecc_sha256_ctx_t *)base)->ctx, message, message_size);
+}
+
+static void _uecc_finish_hash(const uECC_HashContext *base,
+                              uint8_t *hash_result)
+{
+    sha256_final(&((uecc_sha256_ctx_t *)base)->ctx, hash_result);
+}
+
+static int _bench_uecc(void)
+{
+    const struct uECC_Curve_t *curve = uECC_secp256r1();
+    uint8_t tmp[2 * SHA256_DIGEST_LENGTH + SHA256_INTERNAL_BLOCK_SIZE];
+    uint8_t sig[sizeof(uecc_public)];
+    uecc_sha256_ctx_t ctx = {
+        .uECC = {
+            .init_hash = _uecc_init_hash,
+            .update_hash = _uecc_update_hash,
+            .finish_hash = _uecc_finish_hash,
+            .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+            .result_size = SHA256_DIGEST_LENGTH,
+            .tmp = tmp,
+        },
+    };
+    uint32_t start;
+    int res = 1;
+
+    sha256(in, BUF_SIZE, digest);
+    start = benchmark_now();
+    for (unsigned long i = 0; i < ECC_RUNS; i++) {
+        res &= uECC_sign_deterministic(uecc_private, digest, sizeof(digest),
+                                       &ctx.uECC, sig, curve);
+    }
+    _print("ecdsa-p256-sign-uecc", sizeof(digest), ECC_RUNS,
+           benchmark_now() - start);
+    start = benchmark_now();
+    for (unsigned long i = 0; i < ECC_RUNS; i++) {
+        res &= uECC_verify(uecc_public, digest, sizeof(digest), sig, curve);
+    }
+    _print("ecdsa-p256-verify-uecc", sizeof(digest), ECC_RUNS,
+           benchmark_now() - start);
+    return (res == 1) ? 0 : -1;
+}
+#endif
+
+#ifdef MODULE_RELIC
+static int _bench_relic(void)
+{
+    bn_t d, r, s;
+    ec_t q;
+    uint32_t start;
+    int res = 1;
+
+    if ((core_init() != STS_OK) || (ec_param_set_any() != STS_OK)) {
+        return -1;
+    }
+    bn_null(d);
+    bn_null(r);
+    bn_null(s);
+    ec_null(q);
+    bn_new(d);
+    bn_new(r);
+    bn_new(s);
+    ec_new(q);
+    if (cp_ecdsa_gen(d, q) != STS_OK) {
+        res = 0;
+    }
+    sha256(in, BUF_SIZE, digest);
+    start = benchmark_now();
+    for (unsigned long i = 0; i < ECC_RUNS; i++) {
+        /* the digest is signed as is, not hashed again */
+        res &= (cp_ecdsa_sig(r, s, digest, sizeof(digest), 1, d) == STS_OK);
+    }
+    _print("ecdsa-sign-relic", sizeof(digest), ECC_RUNS,
+           benchmark_now() - start);
+    start = benchmark_now();
+    for (unsigned long i = 0; i < ECC_RUNS; i++) {
+        res &= cp_ecdsa_ver(r, s, digest, sizeof(digest), 1, q);
+    }
+    _print("ecdsa-verify-relic", sizeof(digest), ECC_RUNS,
+           benchmark_now() - start);
+    bn_free(d);
+    bn_free(r);
+    bn_free(s);
+    ec_free(q);
+    core_clean();
+    return (res == 1) ? 0 : -1;
+}
+#endif
+
+int main(void)
+{
+    int res = 0;
+
+    puts("Crypto benchmark");
+    for (unsigned i = 0; i < sizeof(in); i++) {
+        ((uint8_t *)in)[i] = (i * 7) + 3;
+    }
+    if ((cipher_init(&cipher, CIPHER_AES_128, key, sizeof(key)) != 1) ||
+        (chacha_init(&chacha, 20, chacha_key, sizeof(chacha_key),
+                     nonce) != 0)) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    puts("algorithm,bytes,runs,per_run,per_byte,unit");
+    for (unsigned i = 0; i < (sizeof(benchs) / sizeof(benchs[0])); i++) {
+        for (unsigned j = 0; j < (sizeof(sizes) / sizeof(sizes[0])); j++) {
+            uint32_t start = benchmark_now();
+
+            for (unsigned long k = 0; k < RUNS; k++) {
+                benchs[i].run(sizes[j]);
+            }
+            _print(benchs[i].name, sizes[j], RUNS, benchmark_now() - start);
+        }
+    }
+#ifdef MODULE_MICRO_ECC
+    res |= _bench_uecc();
+#endif
+#ifdef MODULE_RELIC
+    res |= _bench_relic();
+#endif
+    if (res != 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Crypto benchmark")
+    child.expect_exact(u"algorithm,bytes,runs,per_run,per_byte,unit")
+    for algorithm in (u"aes-128-ecb", u"aes-128-cbc", u"aes-128-ctr",
+                      u"aes-128-ccm", u"chacha20", u"md5", u"sha1",
+                      u"sha256", u"hmac-sha256", u"cmac-aes-128"):
+        for size in (16, 64, 256, 1024):
+            child.expect(u"%s,%i,\d+,\d+\.\d+,\d+\.\d+,\w+" %
+                         (algorithm, size))
+    child.expect_exact(u"Test END")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for evtimer_add() and evtimer_del()
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "evtimer.h"
+
+#define RUNS            (1000UL)
+#define EVENTS_NUMOF    (500U)
+/* offsets are far enough in the future for no event to fire */
+#define OFFSET          (100U * MS_PER_SEC)
+#define SPREAD          (100U * MS_PER_SEC)
+
+static const unsigned sizes[] = { 10, 100, 500 };
+
+static evtimer_t evtimer;
+static evtimer_event_t events[EVENTS_NUMOF];
+static evtimer_event_t event;
+
+static void _cb(evtimer_event_t *event)
+{
+    (void)event;
+}
+
+static void _fill(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        /* spread the events pseudo randomly */
+        events[i].offset = OFFSET + ((i * 7919U) % SPREAD);
+        evtimer_add(&evtimer, &events[i]);
+    }
+}
+
+static void _clear(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        evtimer_del(&evtimer, &events[i]);
+    }
+}
+
+int main(void)
+{
+    char name[32];
+
+    evtimer_init(&evtimer, _cb);
+
+    puts("evtimer benchmark");
+    for (unsigned i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        unsigned numof = sizes[i];
+
+        _fill(numof);
+        snprintf(name, sizeof(name), "add/del last (%u events)", numof);
+        BENCHMARK_FUNC(name, RUNS,
+                       event.offset = OFFSET + SPREAD;
+                       evtimer_add(&evtimer, &event);
+                       evtimer_del(&evtimer, &event));
+        snprintf(name, sizeof(name), "add/del middle (%u events)", numof);
+        BENCHMARK_FUNC(name, RUNS,
+                       event.offset = OFFSET + (SPREAD / 2);
+                       evtimer_add(&evtimer, &event);
+                       evtimer_del(&evtimer, &event));
+        snprintf(name, sizeof(name), "del/add (%u events)", numof);
+        BENCHMARK_FUNC(name, RUNS,
+                       evtimer_del(&evtimer, &events[numof / 2]);
+                       events[numof / 2].offset = OFFSET + (SPREAD / 2);
+                       evtimer_add(&evtimer, &events[numof / 2]));
+        _clear(numof);
+    }
+    puts("Test END");
+
+    return 0;
+}
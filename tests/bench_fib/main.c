@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for fib_get_next_hop() with and without the
+ *              longest-prefix-match index
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/fib.h"
+
+#define RUNS            (1000UL)
+#define ROUTES_NUMOF    (1000U)
+#define ADDR_SIZE       (16U)
+
+static const unsigned sizes[] = { 10, 100, 1000 };
+
+static fib_entry_t scan_entries[ROUTES_NUMOF];
+static fib_entry_t trie_entries[ROUTES_NUMOF];
+static fib_trie_node_t trie_nodes[FIB_TRIE_NODES_NUMOF(ROUTES_NUMOF)];
+
+static fib_table_t scan_table = { .data.entries = scan_entries,
+                                  .table_type = FIB_TABLE_TYPE_SH,
+                                  .size = ROUTES_NUMOF };
+static fib_table_t trie_table = { .data.entries = trie_entries,
+                                  .table_type = FIB_TABLE_TYPE_SH,
+                                  .size = ROUTES_NUMOF,
+                                  .trie_nodes = trie_nodes };
+
+/* route n is 2001:db8:<n>::/48, every fourth route is a /64 within the
+ * previous one */
+static unsigned _route(unsigned n, uint8_t *addr)
+{
+    unsigned base = (n % 4 == 3) ? n - 1 : n;
+
+    memset(addr, 0, ADDR_SIZE);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = base >> 8;
+    addr[5] = base & 0xff;
+    if (base != n) {
+        addr[7] = 0x01;
+        return 64;
+    }
+    return 48;
+}
+
+static void _fill(fib_table_t *table, unsigned numof)
+{
+    uint8_t dst[ADDR_SIZE], next_hop[ADDR_SIZE] = { 0xfe, 0x80 };
+
+    for (unsigned n = 0; n < numof; n++) {
+        uint32_t prefix_len = _route(n, dst);
+
+        next_hop[15] = n & 0x0f;
+        fib_add_entry(table, 1, dst, ADDR_SIZE,
+                      prefix_len << FIB_FLAG_NET_PREFIX_SHIFT, next_hop,
+                      ADDR_SIZE, 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    }
+}
+
+static int _lookup(fib_table_t *table, uint8_t *dst, uint8_t *next_hop)
+{
+    kernel_pid_t iface;
+    size_t next_hop_size = ADDR_SIZE;
+    uint32_t next_hop_flags;
+
+    return fib_get_next_hop(table, &iface, next_hop, &next_hop_size,
+                            &next_hop_flags, dst, ADDR_SIZE, 0);
+}
+
+/* checks if both tables route addresses within every route the same way */
+static int _check(unsigned numof)
+{
+    uint8_t dst[ADDR_SIZE], scan_hop[ADDR_SIZE], trie_hop[ADDR_SIZE];
+
+    for (unsigned n = 0; n < numof; n++) {
+        _route(n, dst);
+        dst[15] = 0x42;
+        if ((_lookup(&scan_table, dst, scan_hop) != 0) ||
+            (_lookup(&trie_table, dst, trie_hop) != 0) ||
+            (memcmp(scan_hop, trie_hop, ADDR_SIZE) != 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    char name[40];
+    uint8_t hit[ADDR_SIZE], miss[ADDR_SIZE], next_hop[ADDR_SIZE];
+
+    puts("FIB benchmark");
+    for (unsigned i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        unsigned numof = sizes[i];
+
+        fib_init(&scan_table);
+        fib_init(&trie_table);
+        _fill(&scan_table, numof);
+        _fill(&trie_table, numof);
+        if (_check(numof) < 0) {
+            puts("[FAILED]");
+            return 1;
+        }
+        _route(numof - 1, hit);
+        hit[15] = 0x01;
+        _route(numof - 1, miss);
+        miss[2] = 0x0e;
+
+        snprintf(name, sizeof(name), "scan hit (%u routes)", numof);
+        BENCHMARK_FUNC(name, RUNS, _lookup(&scan_table, hit, next_hop));
+        snprintf(name, sizeof(name), "scan miss (%u routes)", numof);
+        BENCHMARK_FUNC(name, RUNS, _lookup(&scan_table, miss, next_hop));
+        snprintf(name, sizeof(name), "trie hit (%u routes)", numof);
+        BENCHMARK_FUNC(name, RUNS, _lookup(&trie_table, hit, next_hop));
+        snprintf(name, sizeof(name), "trie miss (%u routes)", numof);
+        BENCHMARK_FUNC(name, RUNS, _lookup(&trie_table, miss, next_hop));
+
+        fib_deinit(&scan_table);
+        fib_deinit(&trie_table);
+    }
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for inet_csum_slice()
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/inet_csum.h"
+
+#define RUNS            (1000UL)
+#define BUF_SIZE        (1280U)
+
+static const unsigned sizes[] = { 8, 40, 127, 1280 };
+
+static uint32_t buf[(BUF_SIZE / sizeof(uint32_t)) + 1];
+static volatile uint16_t result;    /* keeps the compiler from dropping calls */
+
+/* the checksum one byte pair at a time, as RFC 1071 defines it */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; (i + 1) < len; i += 2) {
+        csum += (data[i] << 8) | data[i + 1];
+    }
+    if (len & 1) {
+        csum += data[len - 1] << 8;
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+int main(void)
+{
+    char name[40];
+    uint8_t *aligned = (uint8_t *)buf, *unaligned = aligned + 1;
+
+    puts("Internet checksum benchmark");
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        aligned[i] = (i * 7) + 3;
+    }
+    for (unsigned i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        unsigned len = sizes[i];
+
+        if ((inet_csum(0, aligned, len) != _ref_csum(0, aligned, len)) ||
+            (inet_csum(0, unaligned, len) != _ref_csum(0, unaligned, len))) {
+            puts("[FAILED]");
+            return 1;
+        }
+        snprintf(name, sizeof(name), "reference (%u byte)", len);
+        BENCHMARK_FUNC(name, RUNS, result = _ref_csum(0, aligned, len));
+        snprintf(name, sizeof(name), "aligned (%u byte)", len);
+        BENCHMARK_FUNC(name, RUNS, result = inet_csum(0, aligned, len));
+        snprintf(name, sizeof(name), "unaligned (%u byte)", len);
+        BENCHMARK_FUNC(name, RUNS, result = inet_csum(0, unaligned, len));
+    }
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for msg_send_receive() and msg_reply()
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "thread.h"
+
+#define RUNS            (10000UL)
+
+static char stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_replier(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        msg_reply(&m, &m);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t m, reply;
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _replier, NULL, "replier");
+
+    puts("msg_send_receive benchmark");
+    BENCHMARK_FUNC("msg_send_receive", RUNS, msg_send_receive(&m, &reply, pid));
+    puts("Test END");
+
+    return 0;
+}
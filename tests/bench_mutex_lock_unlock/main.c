@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for uncontended mutex operations
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "mutex.h"
+
+#define RUNS            (10000UL)
+
+static mutex_t lock = MUTEX_INIT;
+
+int main(void)
+{
+    puts("mutex benchmark");
+    BENCHMARK_FUNC("mutex_lock/unlock", RUNS,
+                   mutex_lock(&lock);
+                   mutex_unlock(&lock));
+    BENCHMARK_FUNC("mutex_trylock/unlock", RUNS,
+                   mutex_trylock(&lock);
+                   mutex_unlock(&lock));
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for gnrc_netreg_lookup() and gnrc_netreg_getnext()
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/netreg.h"
+
+#define RUNS            (10000UL)
+#define ENTRIES_NUMOF   (64U)
+#define MSG_QUEUE_SIZE  (4U)
+/* first "port" to register, the type does not matter to the registry */
+#define BASE_CTX        (1024U)
+
+static const unsigned sizes[] = { 1, 16, 64 };
+
+static gnrc_netreg_entry_t entries[ENTRIES_NUMOF];
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+
+static void _fill(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_entry_init_pid(&entries[i], BASE_CTX + i, sched_active_pid);
+        gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[i]);
+    }
+}
+
+static void _clear(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &entries[i]);
+    }
+}
+
+static unsigned _count(uint32_t demux_ctx)
+{
+    unsigned res = 0;
+
+    for (gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, demux_ctx);
+         entry != NULL; entry = gnrc_netreg_getnext(entry)) {
+        res++;
+    }
+    return res;
+}
+
+int main(void)
+{
+    char name[40];
+
+    /* only threads with a message queue are allowed to register */
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_init();
+
+    puts("gnrc_netreg benchmark");
+    for (unsigned i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        unsigned numof = sizes[i];
+
+        _fill(numof);
+        /* the first registered entry is the last in its list */
+        if (_count(BASE_CTX) != 1) {
+            puts("[FAILED]");
+            return 1;
+        }
+        snprintf(name, sizeof(name), "lookup first (%u entries)", numof);
+        BENCHMARK_FUNC(name, RUNS, _count(BASE_CTX));
+        snprintf(name, sizeof(name), "lookup missing (%u entries)", numof);
+        BENCHMARK_FUNC(name, RUNS, _count(BASE_CTX + ENTRIES_NUMOF));
+        _clear(numof);
+    }
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for sha256()
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "hashes/sha256.h"
+
+#define RUNS            (100UL)
+#define BUF_SIZE        (4096U)
+
+static const unsigned sizes[] = { 64, 1024, 4096 };
+
+/* SHA-256("abc") from FIPS 180-2, appendix B.1 */
+static const uint8_t abc_digest[] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+    0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+    0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+static uint32_t buf[(BUF_SIZE / sizeof(uint32_t)) + 1];
+static uint8_t digest[SHA256_DIGEST_LENGTH];
+
+/* the hash of data fed one byte at a time, through the context buffer only */
+static void _bytewise(const uint8_t *data, size_t len, uint8_t *res)
+{
+    sha256_context_t ctx;
+
+    sha256_init(&ctx);
+    for (size_t i = 0; i < len; i++) {
+        sha256_update(&ctx, &data[i], 1);
+    }
+    sha256_final(&ctx, res);
+}
+
+int main(void)
+{
+    char name[40];
+    uint8_t ref[SHA256_DIGEST_LENGTH];
+    uint8_t *aligned = (uint8_t *)buf, *unaligned = aligned + 1;
+
+    puts("SHA-256 benchmark");
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        aligned[i] = (i * 7) + 3;
+    }
+    sha256("abc", 3, digest);
+    if (memcmp(digest, abc_digest, sizeof(digest)) != 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    for (unsigned i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        unsigned len = sizes[i];
+
+        _bytewise(aligned, len, ref);
+        sha256(aligned, len, digest);
+        if (memcmp(digest, ref, sizeof(digest)) != 0) {
+            puts("[FAILED]");
+            return 1;
+        }
+        _bytewise(unaligned, len, ref);
+        sha256(unaligned, len, digest);
+        if (memcmp(digest, ref, sizeof(digest)) != 0) {
+            puts("[FAILED]");
+            return 1;
+        }
+        snprintf(name, sizeof(name), "aligned (%u byte)", len);
+        BENCHMARK_FUNC(name, RUNS, sha256(aligned, len, digest));
+        snprintf(name, sizeof(name), "unaligned (%u byte)", len);
+        BENCHMARK_FUNC(name, RUNS, sha256(unaligned, len, digest));
+    }
+    puts("Test END");
+
+    return 0;
+}
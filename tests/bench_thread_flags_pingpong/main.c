@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for thread_flags_set() and thread_flags_wait_any()
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#define RUNS            (10000UL)
+#define FLAG_PING       (0x1)
+
+static char stack[THREAD_STACKSIZE_DEFAULT];
+static thread_t *main_thread;
+
+static void *_ponger(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_PING);
+        thread_flags_set(main_thread, FLAG_PING);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    main_thread = (thread_t *)sched_active_thread;
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _ponger, NULL, "ponger");
+    thread_t *ponger = (thread_t *)thread_get(pid);
+
+    puts("thread_flags benchmark");
+    BENCHMARK_FUNC("thread_flags_set/wait", RUNS,
+                   thread_flags_set(ponger, FLAG_PING);
+                   thread_flags_wait_any(FLAG_PING));
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for context switches between two threads
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "thread.h"
+
+#define RUNS            (10000UL)
+
+static char stack[THREAD_STACKSIZE_DEFAULT];
+static volatile int done;
+
+static void *_yielder(void *arg)
+{
+    (void)arg;
+
+    while (!done) {
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    thread_create(stack, sizeof(stack), THREAD_PRIORITY_MAIN,
+                  THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                  _yielder, NULL, "yielder");
+
+    puts("context switch benchmark");
+    /* every iteration switches to the other thread and back */
+    BENCHMARK_FUNC("thread_yield (2 context switches)", RUNS, thread_yield());
+    done = 1;
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for xtimer_set() and xtimer_remove()
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "xtimer.h"
+
+#define RUNS            (1000UL)
+#define TIMERS_NUMOF    (20U)
+#define OFFSET          (10U * US_PER_SEC)
+
+static xtimer_t timers[TIMERS_NUMOF];
+static xtimer_t timer;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+}
+
+int main(void)
+{
+    timer.callback = _cb;
+
+    puts("xtimer benchmark");
+    BENCHMARK_FUNC("xtimer_set/remove (empty list)", RUNS,
+                   xtimer_set(&timer, OFFSET);
+                   xtimer_remove(&timer));
+
+    /* fill the timer list so that inserting has to traverse it */
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        timers[i].callback = _cb;
+        xtimer_set(&timers[i], OFFSET + (i * US_PER_SEC));
+    }
+    BENCHMARK_FUNC("xtimer_set/remove (20 timers)", RUNS,
+                   xtimer_set(&timer, OFFSET + (TIMERS_NUMOF * US_PER_SEC));
+                   xtimer_remove(&timer));
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        xtimer_remove(&timers[i]);
+    }
+    puts("Test END");
+
+    return 0;
+}
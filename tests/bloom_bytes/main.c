@@ -49,6 +49,12 @@ hashfp_t hashes[BLOOM_HASHF] = {
     (hashfp_t) rotating_hash, (hashfp_t) one_at_a_time_hash,
 };
 
+static bloom_counting_t counting;
+BLOOM_COUNTERS(counters, BLOOM_BITS);
+hashfp_t double_hashes[2] = {
+    (hashfp_t) fnv_hash, (hashfp_t) one_at_a_time_hash,
+};
+
 static void buf_fill(uint32_t *buf, int len)
 {
     for (int k = 0; k < len; k++) {
@@ -56,16 +62,30 @@ static void buf_fill(uint32_t *buf, int len)
     }
 }
 
-int main(void)
+static void _add(void *filter, const uint8_t *buf, size_t len)
 {
-    xtimer_init();
+    bloom_add(filter, buf, len);
+}
 
-    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+static bool _check(void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_check(filter, buf, len);
+}
 
-    printf("Testing Bloom filter.\n\n");
-    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
-           (uint32_t) bloom.k);
+static void _counting_add(void *filter, const uint8_t *buf, size_t len)
+{
+    bloom_counting_add(filter, buf, len);
+}
 
+static bool _counting_check(void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_counting_check(filter, buf, len);
+}
+
+static void run(void *filter,
+                void (*add)(void *, const uint8_t *, size_t),
+                bool (*check)(void *, const uint8_t *, size_t))
+{
     random_init(myseed);
 
     unsigned long t1 = xtimer_now_usec();
@@ -73,9 +93,9 @@ int main(void)
     for (int i = 0; i < lenB; i++) {
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_B;
-        bloom_add(&bloom,
-                  (uint8_t *) buf,
-                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
+        add(filter,
+            (uint8_t *) buf,
+            BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
     }
 
     unsigned long t2 = xtimer_now_usec();
@@ -91,9 +111,9 @@ int main(void)
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_A;
 
-        if (bloom_check(&bloom,
-                        (uint8_t *) buf,
-                        BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
+        if (check(filter,
+                  (uint8_t *) buf,
+                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
             in++;
         }
         else {
@@ -109,9 +129,37 @@ int main(void)
     printf("%d elements probably in the filter.\n", in);
     printf("%d elements not in the filter.\n", not_in);
     double false_positive_rate = (double) in / (double) lenA;
-    printf("%f false positive rate.\n", false_positive_rate);
+    printf("%f false positive rate.\n\n", false_positive_rate);
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+
+    printf("Testing Bloom filter.\n\n");
+    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
+           (uint32_t) bloom.k);
+    run(&bloom, _add, _check);
+    bloom_del(&bloom);
 
+    bloom_init_double(&bloom, BLOOM_BITS, bf, double_hashes, BLOOM_HASHF);
+
+    printf("Testing Bloom filter with double hashing.\n\n");
+    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
+           (uint32_t) bloom.k);
+    run(&bloom, _add, _check);
     bloom_del(&bloom);
-    printf("\nAll done!\n");
+
+    bloom_counting_init(&counting, BLOOM_BITS, counters, double_hashes,
+                        BLOOM_HASHF);
+
+    printf("Testing counting Bloom filter.\n\n");
+    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) counting.m,
+           (uint32_t) counting.k);
+    run(&counting, _counting_add, _counting_check);
+
+    printf("All done!\n");
     return 0;
 }
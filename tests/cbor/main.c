@@ -22,7 +22,7 @@
 #include "cbor.h"
 
 static unsigned char stream_data[1024];
-static cbor_stream_t stream = {stream_data, sizeof(stream_data), 0};
+static cbor_stream_t stream = {stream_data, sizeof(stream_data), 0, NULL, NULL};
 
 void test_stream_decode(void)
 {
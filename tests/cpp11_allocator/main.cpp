@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test pool and arena allocators
+ *
+ * @author Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+#include <cstdio>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include "riot/allocator.hpp"
+
+using namespace std;
+using namespace riot;
+
+int main() {
+  puts("\n************ C++ allocator test ***********");
+
+  puts("Pool list ...");
+  {
+    using list_t = pool_list<int, 4>;
+    list_t a;
+    list_t b;
+    a.push_back(1);
+    a.push_back(2);
+    b.push_back(3);
+    b.push_back(4);
+    bool failed = false;
+    try {
+      a.push_back(5);
+    }
+    catch (const bad_alloc&) {
+      failed = true;
+    }
+    assert(failed);
+    assert(a.size() == 2);
+    b.pop_front();
+    a.push_back(5);
+    a.splice(a.end(), b);
+    assert(a.size() == 4 && a.back() == 4);
+  }
+  puts("Done\n");
+
+  puts("Pool map ...");
+  {
+    pool_map<int, const char*, 8> map;
+    map[3] = "three";
+    map[1] = "one";
+    map.emplace(2, "two");
+    assert(map.size() == 3);
+    assert(map.begin()->first == 1);
+    map.erase(1);
+    for (int i = 10; i < 15; ++i) {
+      map[i] = "many";
+    }
+    assert(map.size() == 7);
+  }
+  puts("Done\n");
+
+  puts("Arena vector ...");
+  {
+    static uint8_t buf[256];
+    arena_t arena;
+    arena_init(&arena, buf, sizeof(buf));
+    arena_mark_t mark = arena_mark(&arena);
+    {
+      arena_vector<uint16_t> v{arena_allocator<uint16_t>(arena)};
+      v.reserve(32);
+      for (uint16_t i = 0; i < 32; ++i) {
+        v.push_back(i);
+      }
+      assert(v[31] == 31);
+      bool failed = false;
+      try {
+        v.reserve(256);
+      }
+      catch (const bad_alloc&) {
+        failed = true;
+      }
+      assert(failed && v.size() == 32);
+    }
+    arena_reset(&arena, mark);
+    assert(arena_available(&arena) == sizeof(buf));
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
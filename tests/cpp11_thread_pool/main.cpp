@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test thread pool header
+ *
+ * @author Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+#include <cstdio>
+#include <cassert>
+
+#include "riot/thread_pool.hpp"
+
+using namespace std;
+using namespace riot;
+
+static int sum(const int* values, size_t len) {
+  int res = 0;
+  for (size_t i = 0; i < len; ++i) {
+    res += values[i];
+  }
+  return res;
+}
+
+int main() {
+  puts("\n************ C++ thread pool test ***********");
+
+  puts("Fan out ...");
+  {
+    static thread_pool<2> pool;
+    int values[64];
+    for (int i = 0; i < 64; ++i) {
+      values[i] = i;
+    }
+    auto a = make_task([&] { return sum(values, 32); });
+    auto b = make_task([&] { return sum(&values[32], 32); });
+    bool ran = false;
+    auto c = make_task([&] { ran = true; });
+    assert(pool.submit(a));
+    assert(pool.submit(b));
+    assert(pool.submit(c));
+    assert(a.get() + b.get() == 63 * 64 / 2);
+    c.get();
+    assert(ran);
+    assert(a.ready());
+  }
+  puts("Done\n");
+
+  puts("Bounded queue ...");
+  {
+    /* the workers run only once main waits */
+    static thread_pool<1, 2> pool(THREAD_PRIORITY_MAIN + 1);
+    int count = 0;
+    auto a = make_task([&] { return ++count; });
+    auto b = make_task([&] { return ++count; });
+    auto c = make_task([&] { return ++count; });
+    assert(pool.submit(a));
+    assert(pool.submit(b));
+    assert(!pool.submit(c));
+    assert(!a.ready());
+    assert(b.get() == 2);
+    assert(a.get() == 1);
+    assert(pool.submit(c));
+    assert(c.get() == 3);
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
@@ -20,6 +20,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -233,6 +234,14 @@ int send_cmd(int argc, char **argv)
 
 int listen_cmd(int argc, char **argv)
 {
+    if (argc > 1) {
+        /* Switch to CAD-based duty-cycled listen mode */
+        uint32_t interval = atoi(argv[1]);
+        netdev->driver->set(netdev, NETOPT_LISTEN_INTERVAL, &interval, sizeof(uint32_t));
+        printf("Listen mode set with a CAD every %" PRIu32 " us\n", interval);
+        return 0;
+    }
+
     /* Switch to continuous listen mode */
     netdev->driver->set(netdev, NETOPT_SINGLE_RECEIVE, false, sizeof(uint8_t));
     sx127x_set_rx(&sx127x);
@@ -279,7 +288,7 @@ static const shell_command_t shell_commands[] = {
     { "channel",  "Get/Set channel frequency (in Hz)",       channel_cmd },
     { "register", "Get/Set value(s) of registers of sx127x", register_cmd },
     { "send",     "Send raw payload string",                 send_cmd },
-    { "listen",   "Start raw payload listener",              listen_cmd },
+    { "listen",   "Start raw payload listener [CAD interval in us]", listen_cmd },
     { NULL, NULL, NULL }
 };
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the signal processing pipeline
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "dsp_pipeline.h"
+#include "periph/adc.h"
+
+#define RATE            (4000U)
+#define FRAME_LEN       (256U)
+#define DMA_LEN         (2 * 128U)
+#define BANDS           (4U)
+
+static float32_t _frames[2][FRAME_LEN];
+static float32_t _spectrum[FRAME_LEN];
+static float32_t _hann[FRAME_LEN];
+static uint16_t _dma[DMA_LEN];
+
+/* 15.6Hz per bin: <125Hz, <250Hz, <500Hz and <2kHz */
+static const uint16_t _edges[BANDS + 1] = { 1, 8, 16, 32, 128 };
+
+static dsp_pipeline_t _pipeline;
+static dsp_dc_t _dc;
+static dsp_rms_t _rms;
+static dsp_window_t _window;
+static dsp_fft_t _fft;
+static dsp_bands_t _bands;
+
+static int _print(dsp_sink_t *sink, const dsp_frame_t *frame)
+{
+    (void)sink;
+
+    printf("%10lu rms %8.2f bands", (unsigned long)frame->time,
+           (double)frame->features[0]);
+    for (unsigned i = 1; i < frame->numof; i++) {
+        printf(" %10.1f", (double)frame->features[i]);
+    }
+    puts("");
+    return 0;
+}
+
+static dsp_sink_t _sink = { .write = _print };
+
+int main(void)
+{
+    puts("\nRIOT signal processing pipeline test\n");
+    printf("This test samples ADC_LINE(0) at %uHz and prints the RMS and the\n"
+           "energy of %u frequency bands of each frame of %u samples\n\n",
+           RATE, BANDS, FRAME_LEN);
+
+    if (adc_init(ADC_LINE(0)) < 0) {
+        puts("Initialization of ADC_LINE(0) failed");
+        return 1;
+    }
+
+    dsp_pipeline_init(&_pipeline, _frames[0], _frames[1], FRAME_LEN);
+    dsp_dc_init(&_dc);
+    dsp_rms_init(&_rms);
+    dsp_window_init(&_window, _hann, FRAME_LEN);
+    if (dsp_fft_init(&_fft, _spectrum, FRAME_LEN) < 0) {
+        puts("FFT initialization failed");
+        return 1;
+    }
+    dsp_bands_init(&_bands, _edges, BANDS);
+    dsp_pipeline_add(&_pipeline, &_dc.stage);
+    dsp_pipeline_add(&_pipeline, &_rms.stage);
+    dsp_pipeline_add(&_pipeline, &_window.stage);
+    dsp_pipeline_add(&_pipeline, &_fft.stage);
+    dsp_pipeline_add(&_pipeline, &_bands.stage);
+    dsp_pipeline_set_sink(&_pipeline, &_sink);
+
+    if (dsp_pipeline_adc_start(&_pipeline, ADC_LINE(0), ADC_RES_12BIT, RATE,
+                               _dma, DMA_LEN) < 0) {
+        puts("Starting the ADC stream failed");
+        return 1;
+    }
+
+    while (1) {
+        int res = dsp_pipeline_process(&_pipeline);
+        if (res < 0) {
+            printf("processing failed: %d\n", res);
+        }
+        if (dsp_pipeline_overruns(&_pipeline)) {
+            printf("%u frames dropped\n", dsp_pipeline_overruns(&_pipeline));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Checks the comb tables against micro-ecc
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/ecc_comb.h"
+#include "hashes/sha256.h"
+#include "uECC.h"
+
+#define BATCH_SIZE      (6U)
+
+/* the key pairs of tests/pkg_micro-ecc */
+static const uint8_t private1[] = {
+    0x9b, 0x4c, 0x4b, 0xa0, 0xb7, 0xb1, 0x25, 0x23,
+    0x9c, 0x09, 0x85, 0x4f, 0x9a, 0x21, 0xb4, 0x14,
+    0x70, 0xe0, 0xce, 0x21, 0x25, 0x00, 0xa5, 0x62,
+    0x34, 0xa4, 0x25, 0xf0, 0x0f, 0x00, 0xeb, 0xe7,
+};
+static const uint8_t public1[] = {
+    0x54, 0x3e, 0x98, 0xf8, 0x14, 0x55, 0x08, 0x13,
+    0xb5, 0x1a, 0x1d, 0x02, 0x02, 0xd7, 0x0e, 0xab,
+    0xa0, 0x98, 0x74, 0x61, 0x91, 0x12, 0x3d, 0x96,
+    0x50, 0xfa, 0xd5, 0x94, 0xa2, 0x86, 0xa8, 0xb0,
+    0xd0, 0x7b, 0xda, 0x36, 0xba, 0x8e, 0xd3, 0x9a,
+    0xa0, 0x16, 0x11, 0x0e, 0x1b, 0x6e, 0x81, 0x13,
+    0xd7, 0xf4, 0x23, 0xa1, 0xb2, 0x9b, 0xaf, 0xf6,
+    0x6b, 0xc4, 0x2a, 0xdf, 0xbd, 0xe4, 0x61, 0x5c,
+};
+static const uint8_t private2[] = {
+    0xb5, 0x45, 0xaf, 0xa0, 0x2e, 0x5c, 0xa6, 0x17,
+    0x3b, 0x5a, 0x55, 0x76, 0x67, 0x5d, 0xd4, 0x5e,
+    0x41, 0x7c, 0x4f, 0x19, 0x9f, 0xb9, 0x75, 0xdc,
+    0xba, 0x57, 0xc4, 0xa2, 0x26, 0xc6, 0x86, 0x2a,
+};
+static const uint8_t public2[] = {
+    0x2e, 0x81, 0x24, 0x3c, 0x44, 0xac, 0x63, 0x13,
+    0x9b, 0xc1, 0x27, 0xe9, 0x53, 0x3b, 0x0a, 0xe2,
+    0xf9, 0x22, 0xcd, 0x06, 0xfd, 0x12, 0x17, 0x2e,
+    0xe5, 0x0e, 0xb5, 0xce, 0x6b, 0x50, 0xe2, 0x44,
+    0xbf, 0x6b, 0x3f, 0xe8, 0x4e, 0x70, 0xd1, 0x06,
+    0x85, 0x84, 0xb8, 0xef, 0xe2, 0x25, 0x91, 0x21,
+    0xf3, 0x46, 0x70, 0xa9, 0x1c, 0x79, 0x19, 0xe3,
+    0xfb, 0x11, 0x36, 0x64, 0x37, 0x64, 0x58, 0xc9,
+};
+/* ECDH of the key pairs */
+static const uint8_t secret[] = {
+    0xb4, 0xac, 0x71, 0xb4, 0xe4, 0xba, 0x10, 0xa2,
+    0x6b, 0x7b, 0x35, 0xc8, 0x3d, 0x23, 0xee, 0x46,
+    0x16, 0x8a, 0xd3, 0x4c, 0x8e, 0x9e, 0x8a, 0x10,
+    0x4f, 0x9e, 0xfd, 0x22, 0x2f, 0x48, 0xa3, 0x7c,
+};
+/* ECDSA of SHA-256("riot") with private1 and nonce 0x1234567 */
+static const uint8_t signature[] = {
+    0x08, 0x8b, 0xb9, 0xff, 0x22, 0xab, 0x29, 0x1a,
+    0x74, 0xc8, 0x6f, 0xc6, 0x77, 0xba, 0x89, 0x7b,
+    0xaa, 0xde, 0xe3, 0x70, 0xcc, 0x61, 0x29, 0xb8,
+    0x2d, 0x17, 0x0b, 0xa3, 0xfc, 0x26, 0x41, 0x5c,
+    0xf2, 0x3d, 0x30, 0x29, 0x7e, 0x4c, 0xdb, 0x20,
+    0x5d, 0x3d, 0xe8, 0xc1, 0x2a, 0x91, 0x37, 0x04,
+    0x9e, 0x5b, 0x71, 0x18, 0x62, 0x9e, 0x63, 0xe7,
+    0x51, 0x30, 0x9b, 0x9e, 0xae, 0x34, 0x23, 0x97,
+};
+
+static ecc_comb_t g, key1, key2;
+static uint8_t hash[SHA256_DIGEST_LENGTH];
+static uint8_t sigs[BATCH_SIZE][sizeof(signature)];
+static uint8_t tmp[2 * SHA256_DIGEST_LENGTH + SHA256_INTERNAL_BLOCK_SIZE];
+
+typedef struct {
+    uECC_HashContext uECC;
+    sha256_context_t ctx;
+} uecc_sha256_ctx_t;
+
+static void _init_hash(const uECC_HashContext *base)
+{
+    sha256_init(&((uecc_sha256_ctx_t *)base)->ctx);
+}
+
+static void _update_hash(const uECC_HashContext *base,
+                         const uint8_t *message, unsigned message_size)
+{
+    sha256_update(&((uecc_sha256_ctx_t *)base)->ctx, message, message_size);
+}
+
+static void _finish_hash(const uECC_HashContext *base, uint8_t *hash_result)
+{
+    sha256_final(&((uecc_sha256_ctx_t *)base)->ctx, hash_result);
+}
+
+static int _check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("%s failed\n", what);
+    }
+    return cond ? 0 : 1;
+}
+
+static int _keys(void)
+{
+    uint8_t buf[sizeof(public1)];
+    int errors = 0;
+
+    errors += _check(ecc_comb_compute_public_key(&g, private1, buf) &&
+                     (memcmp(buf, public1, sizeof(buf)) == 0),
+                     "public key 1");
+    errors += _check(ecc_comb_compute_public_key(&g, private2, buf) &&
+                     (memcmp(buf, public2, sizeof(buf)) == 0),
+                     "public key 2");
+    errors += _check(ecc_comb_shared_secret(&key2, private1, buf) &&
+                     (memcmp(buf, secret, sizeof(secret)) == 0),
+                     "shared secret 1");
+    errors += _check(ecc_comb_shared_secret(&key1, private2, buf) &&
+                     (memcmp(buf, secret, sizeof(secret)) == 0),
+                     "shared secret 2");
+    memset(buf, 0, sizeof(buf));
+    errors += _check(!ecc_comb_compute_public_key(&g, buf, buf),
+                     "zero private key");
+    return errors;
+}
+
+static int _signatures(void)
+{
+    const struct uECC_Curve_t *curve = uECC_secp256r1();
+    uint8_t sig[sizeof(signature)];
+    uecc_sha256_ctx_t ctx = {
+        .uECC = {
+            .init_hash = _init_hash,
+            .update_hash = _update_hash,
+            .finish_hash = _finish_hash,
+            .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+            .result_size = SHA256_DIGEST_LENGTH,
+            .tmp = tmp,
+        },
+    };
+    int errors = 0;
+
+    errors += _check(ecc_comb_verify(&g, &key1, hash, sizeof(hash), signature),
+                     "verify");
+    errors += _check(!ecc_comb_verify(&g, &key2, hash, sizeof(hash), signature),
+                     "verify with the wrong key");
+    memcpy(sig, signature, sizeof(sig));
+    sig[sizeof(sig) - 1] ^= 0x01;
+    errors += _check(!ecc_comb_verify(&g, &key1, hash, sizeof(hash), sig),
+                     "verify a modified signature");
+    errors += _check(uECC_sign_deterministic(private2, hash, sizeof(hash),
+                                             &ctx.uECC, sig, curve) &&
+                     ecc_comb_verify(&g, &key2, hash, sizeof(hash), sig),
+                     "verify a micro-ecc signature");
+#ifdef FEATURE_PERIPH_HWRNG
+    errors += _check(ecc_comb_sign(&g, private1, hash, sizeof(hash), sig) &&
+                     uECC_verify(public1, hash, sizeof(hash), sig, curve),
+                     "sign");
+#endif
+    return errors;
+}
+
+static int _batch(void)
+{
+    const struct uECC_Curve_t *curve = uECC_secp256r1();
+    ecc_comb_sig_t batch[BATCH_SIZE];
+    uecc_sha256_ctx_t ctx = {
+        .uECC = {
+            .init_hash = _init_hash,
+            .update_hash = _update_hash,
+            .finish_hash = _finish_hash,
+            .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+            .result_size = SHA256_DIGEST_LENGTH,
+            .tmp = tmp,
+        },
+    };
+    int errors = 0;
+
+    for (unsigned i = 0; i < BATCH_SIZE; i++) {
+        const uint8_t *private_key = (i & 1) ? private2 : private1;
+
+        /* a different hash for every signature */
+        batch[i].key = (i & 1) ? &key2 : &key1;
+        batch[i].hash = hash;
+        batch[i].hash_size = sizeof(hash) - i;
+        batch[i].signature = sigs[i];
+        if (!uECC_sign_deterministic(private_key, hash, batch[i].hash_size,
+                                     &ctx.uECC, sigs[i], curve)) {
+            puts("uECC_sign_deterministic() failed");
+            return 1;
+        }
+    }
+    errors += _check(ecc_comb_verify_batch(&g, batch, BATCH_SIZE),
+                     "verify a batch");
+    for (unsigned i = 0; i < BATCH_SIZE; i++) {
+        sigs[i][0] ^= 0x80;
+        errors += _check(!ecc_comb_verify_batch(&g, batch, BATCH_SIZE),
+                         "verify a batch with a modified signature");
+        sigs[i][0] ^= 0x80;
+    }
+    return errors;
+}
+
+int main(void)
+{
+    const struct uECC_Curve_t *curve = uECC_secp256r1();
+    int errors = 0;
+
+    puts("ECC comb test");
+    sha256("riot", 4, hash);
+    if (!ecc_comb_init(&g, NULL, curve) ||
+        !ecc_comb_init(&key1, public1, curve) ||
+        !ecc_comb_init(&key2, public2, curve)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    errors += _keys();
+    errors += _signatures();
+    errors += _batch();
+    if (errors) {
+        printf("[FAILED] %d error(s)\n", errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
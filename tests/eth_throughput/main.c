@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput test for Ethernet devices
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "shell.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+#define RX_QUEUE_SIZE       (16U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _rx_stack[THREAD_STACKSIZE_DEFAULT];
+
+static uint32_t _rx_frames, _rx_bytes, _rx_first, _rx_last;
+
+static void _print_rate(unsigned frames, uint32_t bytes, uint32_t usec)
+{
+    printf("%u frames, %" PRIu32 " payload bytes in %" PRIu32 " us", frames, bytes, usec);
+    if (usec > 0) {
+        printf(": %" PRIu32 " kbit/s", (uint32_t)(((uint64_t)bytes * 8000) / usec));
+    }
+    puts("");
+}
+
+/* counts all frames of ethertypes the stack does not know */
+static void *_rx_thread(void *arg)
+{
+    msg_t queue[RX_QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           sched_active_pid);
+
+    (void)arg;
+    msg_init_queue(queue, RX_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+            _rx_last = xtimer_now_usec();
+            if (_rx_frames++ == 0) {
+                _rx_first = _rx_last;
+            }
+            _rx_bytes += pkt->size;
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_build(size_t size)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    memset(pkt->data, 0x55, size);
+    hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->flags = GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, hdr);
+    return pkt;
+}
+
+static int _tx(int argc, char **argv)
+{
+    kernel_pid_t iface;
+    unsigned count, size;
+    gnrc_pktsnip_t *last = NULL;
+    uint32_t start;
+
+    if (argc < 4) {
+        printf("usage: %s <if_id> <count> <payload size>\n", argv[0]);
+        return 1;
+    }
+    iface = (kernel_pid_t)atoi(argv[1]);
+    count = (unsigned)atoi(argv[2]);
+    size = (unsigned)atoi(argv[3]);
+    if ((count == 0) || (size > ETHERNET_DATA_LEN)) {
+        printf("error: count must be > 0 and size <= %u\n", ETHERNET_DATA_LEN);
+        return 1;
+    }
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < count; i++) {
+        gnrc_pktsnip_t *pkt;
+
+        while ((pkt = _build(size)) == NULL) {
+            /* packet buffer is full, let the device catch up */
+            xtimer_usleep(US_PER_MS);
+        }
+        if ((i + 1) == count) {
+            /* keep the last frame to see when the device is done with it */
+            gnrc_pktbuf_hold(pkt, 1);
+            last = pkt;
+        }
+        if (gnrc_netapi_send(iface, pkt) < 1) {
+            puts("error: unable to send");
+            gnrc_pktbuf_release(pkt);
+            if (last != NULL) {
+                gnrc_pktbuf_release(last);
+            }
+            return 1;
+        }
+    }
+    while (last->users > 1) {
+        xtimer_usleep(100);
+    }
+    _print_rate(count, (uint32_t)count * size, xtimer_now_usec() - start);
+    gnrc_pktbuf_release(last);
+    return 0;
+}
+
+static int _rx(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        _rx_frames = 0;
+        _rx_bytes = 0;
+        return 0;
+    }
+    if (_rx_frames == 0) {
+        puts("no frames received");
+        return 0;
+    }
+    _print_rate(_rx_frames, _rx_bytes, _rx_last - _rx_first);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "tx", "send broadcast frames and print the TX throughput", _tx },
+    { "rx", "print the RX throughput of frames of unknown ethertypes", _rx },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    /* we need a message queue for the thread running the shell in order to
+     * receive potentially fast incoming networking packets */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("Ethernet throughput test\n");
+
+    thread_create(_rx_stack, sizeof(_rx_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _rx_thread, NULL, "rx");
+
+    /* start shell */
+    puts("Starting the shell now...");
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    /* should be never reached */
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the event queue
+ *
+ * Events posted twice before they were handled must only be handled once,
+ * cancelled events not at all, and the remaining ones in the order they
+ * were posted. A timeout event is posted from ISR context.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event.h"
+#include "event/callback.h"
+#include "event/timeout.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT         (10UL * US_PER_MS)
+
+static char _order[5];
+static unsigned _order_pos;
+
+static void _log(char c)
+{
+    if (_order_pos < sizeof(_order) - 1) {
+        _order[_order_pos++] = c;
+    }
+}
+
+static void _handler(event_t *event);
+
+static event_t _ev_a = EVENT_INIT(_handler);
+static event_t _ev_b = EVENT_INIT(_handler);
+static event_t _ev_c = EVENT_INIT(_handler);
+
+static void _handler(event_t *event)
+{
+    char c = (event == &_ev_a) ? 'a' : (event == &_ev_b) ? 'b' : 'c';
+
+    printf("handler %c\n", c);
+    _log(c);
+}
+
+static void _callback(void *arg)
+{
+    printf("callback %s\n", (char *)arg);
+    _log('d');
+}
+
+static event_callback_t _ev_cb = EVENT_CALLBACK_INIT(_callback, "called");
+
+static void _timeout_handler(event_t *event)
+{
+    (void)event;
+    puts("timeout");
+    _log('t');
+}
+
+static event_t _ev_timeout = EVENT_INIT(_timeout_handler);
+
+int main(void)
+{
+    event_queue_t queue = EVENT_QUEUE_INIT;
+    event_timeout_t timeout;
+    event_t *event;
+
+    puts("event test");
+
+    event_post(&queue, &_ev_a);
+    event_post(&queue, &_ev_b);
+    event_post(&queue, &_ev_a);
+    event_post(&queue, &_ev_c);
+    event_cancel(&queue, &_ev_c);
+    event_post(&queue, &_ev_cb.super);
+
+    while ((event = event_get(&queue))) {
+        event->handler(event);
+    }
+
+    event_timeout_init(&timeout, &queue, &_ev_timeout);
+    event_timeout_set(&timeout, TIMEOUT);
+    event = event_wait(&queue);
+    event->handler(event);
+
+    if ((event_get(&queue) == NULL) && (_order_pos == 4) &&
+        (_order[0] == 'a') && (_order[1] == 'b') && (_order[2] == 'd') &&
+        (_order[3] == 't')) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}
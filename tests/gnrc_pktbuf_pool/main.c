@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the gnrc_pktbuf_pool packet buffer
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("check failed in line %d: %s\n", __LINE__, #cond); \
+            return 0; \
+        } \
+    } while (0)
+
+static uint8_t _data[GNRC_PKTBUF_POOL_LARGE_SIZE];
+
+static int _test_add_release(void)
+{
+    gnrc_pktsnip_t *small = gnrc_pktbuf_add(NULL, _data, 8, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *large = gnrc_pktbuf_add(small, _data, sizeof(_data),
+                                            GNRC_NETTYPE_UNDEF);
+
+    CHECK(small && large);
+    CHECK(memcmp(large->data, _data, sizeof(_data)) == 0);
+    CHECK(!gnrc_pktbuf_add(NULL, NULL, sizeof(_data) + 1, GNRC_NETTYPE_UNDEF));
+    CHECK(!gnrc_pktbuf_is_empty() && gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(large);
+    CHECK(gnrc_pktbuf_is_empty() && gnrc_pktbuf_is_sane());
+    return 1;
+}
+
+static int _test_mark(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _data, 256, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *hdr, *trailer;
+
+    CHECK(pkt);
+    /* small header is copied out */
+    hdr = gnrc_pktbuf_mark(pkt, 16, GNRC_NETTYPE_UNDEF);
+    CHECK(hdr && (hdr->size == 16) && (pkt->size == 240));
+    CHECK(memcmp(hdr->data, _data, 16) == 0);
+    CHECK(memcmp(pkt->data, _data + 16, 240) == 0);
+    /* most of the rest stays in place */
+    trailer = gnrc_pktbuf_mark(pkt, 200, GNRC_NETTYPE_UNDEF);
+    CHECK(trailer && (trailer->size == 200) && (pkt->size == 40));
+    CHECK(memcmp(trailer->data, _data + 16, 200) == 0);
+    CHECK(memcmp(pkt->data, _data + 216, 40) == 0);
+    CHECK(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    CHECK(gnrc_pktbuf_is_empty() && gnrc_pktbuf_is_sane());
+    return 1;
+}
+
+static int _test_realloc(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _data, 8, GNRC_NETTYPE_UNDEF);
+    void *old;
+
+    CHECK(pkt);
+    old = pkt->data;
+    CHECK(gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_POOL_SMALL_SIZE) == 0);
+    CHECK(pkt->data == old);
+    CHECK(gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_POOL_SMALL_SIZE + 1) == 0);
+    CHECK((pkt->data != old) && (memcmp(pkt->data, _data, 8) == 0));
+    CHECK(gnrc_pktbuf_realloc_data(pkt, sizeof(_data) + 1) == ENOMEM);
+    CHECK(gnrc_pktbuf_realloc_data(pkt, 0) == 0);
+    CHECK(pkt->data == NULL);
+    gnrc_pktbuf_release(pkt);
+    CHECK(gnrc_pktbuf_is_empty() && gnrc_pktbuf_is_sane());
+    return 1;
+}
+
+static int _test_exhaust(void)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+    unsigned numof = 0;
+
+    /* small data falls back to large blocks, then allocation fails */
+    while (numof < (GNRC_PKTBUF_POOL_SMALL_NUMOF + GNRC_PKTBUF_POOL_LARGE_NUMOF)) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_add(pkt, NULL, 1, GNRC_NETTYPE_UNDEF);
+        if (tmp == NULL) {
+            break;
+        }
+        pkt = tmp;
+        numof++;
+    }
+    CHECK((numof == GNRC_PKTBUF_POOL_SNIP_NUMOF) ||
+          (numof == (GNRC_PKTBUF_POOL_SMALL_NUMOF + GNRC_PKTBUF_POOL_LARGE_NUMOF)));
+    CHECK(!gnrc_pktbuf_add(pkt, NULL, 1, GNRC_NETTYPE_UNDEF));
+    CHECK(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    CHECK(gnrc_pktbuf_is_empty() && gnrc_pktbuf_is_sane());
+    return 1;
+}
+
+int main(void)
+{
+    puts("gnrc_pktbuf_pool test");
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (uint8_t)i;
+    }
+    gnrc_pktbuf_init();
+
+    if (_test_add_release() && _test_mark() && _test_realloc() &&
+        _test_exhaust()) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}
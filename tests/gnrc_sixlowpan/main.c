@@ -20,10 +20,13 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
+#include "benchmark.h"
 #include "shell.h"
 #include "msg.h"
 #include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/pktbuf.h"
@@ -32,6 +35,17 @@
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pktdump.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+
+#define BENCH_RUNS      (1000UL)
+#define BENCH_PAYLOAD   (32U)
+
+static uint8_t bench_src_l2[] = { 0x02, 0x00, 0x00, 0xFF, 0xFE, 0x00, 0x00, 0x02 };
+static uint8_t bench_dst_l2[] = { 0x02, 0x00, 0x00, 0xFF, 0xFE, 0x00, 0x00, 0x01 };
+static uint8_t bench_frame[128];
+static size_t bench_frame_len;
 
 static void _init_interface(void)
 {
@@ -156,12 +170,98 @@ static void _send_packet(void)
     gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN, GNRC_NETREG_DEMUX_CTX_ALL, pkt2);
 }
 
+static gnrc_pktsnip_t *_bench_netif(void)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(bench_src_l2, sizeof(bench_src_l2),
+                                                 bench_dst_l2, sizeof(bench_dst_l2));
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+
+    gnrc_netif_get(ifs);
+    if (netif != NULL) {
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = ifs[0];
+    }
+    return netif;
+}
+
+/* compresses a UDP packet from fd01::ff:fe00:2 to fd01::ff:fe00:1 */
+static gnrc_pktsnip_t *_bench_encode(void)
+{
+    /* both addresses are derived from the link-layer addresses with the
+     * context for fd01::/64 */
+    ipv6_addr_t src = { .u8 = { 0xfd, 0x01, [11] = 0xff, 0xfe, 0x00, 0x00, 0x02 } };
+    ipv6_addr_t dst = { .u8 = { 0xfd, 0x01, [11] = 0xff, 0xfe, 0x00, 0x00, 0x01 } };
+    gnrc_pktsnip_t *netif, *ipv6, *udp, *payload;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, BENCH_PAYLOAD, GNRC_NETTYPE_UNDEF);
+    udp = gnrc_udp_hdr_build(payload, 61616, 61617);
+    ipv6 = gnrc_ipv6_hdr_build(udp, &src, &dst);
+    netif = _bench_netif();
+    if ((payload == NULL) || (udp == NULL) || (ipv6 == NULL) || (netif == NULL)) {
+        puts("[FAILED] packet buffer full");
+        return NULL;
+    }
+    ((ipv6_hdr_t *)ipv6->data)->nh = PROTNUM_UDP;
+    ((ipv6_hdr_t *)ipv6->data)->hl = 64;
+    netif->next = ipv6;
+    if (!gnrc_sixlowpan_iphc_encode(netif)) {
+        puts("[FAILED] IPHC encoding");
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    return netif;
+}
+
+static void _bench_encode_release(void)
+{
+    gnrc_pktbuf_release(_bench_encode());
+}
+
+static void _bench_decode(void)
+{
+    gnrc_pktsnip_t *netif = _bench_netif();
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(netif, bench_frame, bench_frame_len,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+                                              GNRC_NETTYPE_IPV6);
+    size_t nh_len;
+
+    if ((pkt == NULL) || (dec_hdr == NULL) ||
+        (gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, 0, 0, &nh_len) == 0)) {
+        puts("[FAILED] IPHC decoding");
+    }
+    gnrc_pktbuf_release(dec_hdr);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _benchmark(void)
+{
+    ipv6_addr_t prefix = { .u8 = { 0xfd, 0x01 } };
+    gnrc_pktsnip_t *pkt;
+
+    gnrc_sixlowpan_ctx_update(0, &prefix, 64, UINT16_MAX, true);
+    /* keep a compressed frame to decode */
+    if ((pkt = _bench_encode()) == NULL) {
+        return;
+    }
+    bench_frame_len = 0;
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy(bench_frame + bench_frame_len, snip->data, snip->size);
+        bench_frame_len += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    printf("IPHC frame: %u byte\n", (unsigned)bench_frame_len);
+
+    BENCHMARK_FUNC("IPHC encode", BENCH_RUNS, _bench_encode_release());
+    BENCHMARK_FUNC("IPHC decode", BENCH_RUNS, _bench_decode());
+}
+
 int main(void)
 {
     puts("RIOT network stack example application");
 
     _init_interface();
     _send_packet();
+    _benchmark();
 
     return 0;
 }
@@ -76,5 +76,10 @@ def testfunc(child):
     child.expect_exact("source address: fe80::ff:fe00:2")
     child.expect_exact("destination address: fd01::1")
 
+    # IPHC benchmark
+    child.expect(r"IPHC frame: \d+ byte")
+    child.expect(r"IPHC encode: \d+ runs, \d+\.\d+ \w+ per run")
+    child.expect(r"IPHC decode: \d+ runs, \d+\.\d+ \w+ per run")
+
 if __name__ == "__main__":
     sys.exit(testrunner.run(testfunc))
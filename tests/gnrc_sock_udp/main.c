@@ -379,6 +379,68 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    /* packet is still lent to the application */
+    assert(!gnrc_pktbuf_is_empty());
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv__drop_oldest(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    static msg_t queue[2];
+    static const gnrc_sock_queue_t conf = {
+        .queue = queue,
+        .size = sizeof(queue) / sizeof(queue[0]),
+        .policy = GNRC_SOCK_DROP_OLDEST
+    };
+
+    assert(0 == gnrc_sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP,
+                                     &conf));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "A", sizeof("A"), _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "BC", sizeof("BC"), _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "DEF", sizeof("DEF"), _TEST_NETIF));
+    assert(1 == gnrc_sock_udp_get_drops(&_sock));
+    /* the first packet was dropped */
+    assert(sizeof("BC") == sock_udp_recv(&_sock, _test_buffer,
+                                         sizeof(_test_buffer), 0, NULL));
+    assert(sizeof("DEF") == sock_udp_recv(&_sock, _test_buffer,
+                                          sizeof(_test_buffer), 0, NULL));
+    assert(-EAGAIN == sock_udp_recv(&_sock, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -515,6 +577,64 @@ static void test_sock_udp_send__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    const struct iovec vector[] = { { .iov_base = "AB", .iov_len = 2 },
+                                    { .iov_base = NULL, .iov_len = 0 },
+                                    { .iov_base = "CD", .iov_len = sizeof("CD") } };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, vector, 3, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    static const sock_udp_ep_t bad_remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                              .family = AF_INET6,
+                                              .port = 0 };
+    const struct iovec abcd = { .iov_base = "ABCD", .iov_len = sizeof("ABCD") };
+    const struct iovec efgh = { .iov_base = "EFGH", .iov_len = sizeof("EFGH") };
+    const sock_udp_msg_t msgs[] = { { .vector = &abcd, .count = 1, .remote = &remote },
+                                    { .vector = &efgh, .count = 1, .remote = &remote },
+                                    { .vector = &abcd, .count = 1, .remote = &bad_remote } };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-EINVAL == sock_udp_send_batch(&_sock, &msgs[2], 1));
+    /* sending stops at the bad message */
+    assert(2 == sock_udp_send_batch(&_sock, msgs, 3));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD",
+                         sizeof("ABCD"), _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "EFGH",
+                         sizeof("EFGH"), _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -680,6 +800,8 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv__drop_oldest());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -697,6 +819,8 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_sendv());
+    CALL(test_sock_udp_send_batch());
 
     puts("ALL TESTS SUCCESSFUL");
 
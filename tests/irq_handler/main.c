@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the deferred interrupt handler
+ *
+ * Two xtimer callbacks (ISR context) queue events, which must be handled
+ * in the irq_handler thread in the order they were queued. An event queued
+ * twice before it was handled must only be handled once.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "irq_handler.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT         (10UL * US_PER_MS)
+
+static unsigned _handled[2];
+static char _order[3];
+static unsigned _order_pos;
+static int _double_add;
+static kernel_pid_t _main_pid;
+
+static void _handler(void *ctx)
+{
+    unsigned num = (unsigned)ctx;
+
+    _handled[num]++;
+    if (_order_pos < sizeof(_order) - 1) {
+        _order[_order_pos++] = 'a' + num;
+    }
+    printf("handler %u running in %s\n", num,
+           (thread_getpid() == _main_pid) ? "main" : "irq_handler");
+}
+
+static irq_event_t _ev_a = IRQ_EVENT_INIT(_handler, (void *)0);
+static irq_event_t _ev_b = IRQ_EVENT_INIT(_handler, (void *)1);
+
+static void _timer_cb(void *arg)
+{
+    (void)arg;
+
+    irq_event_add(&_ev_a);
+    irq_event_add(&_ev_b);
+    _double_add = irq_event_add(&_ev_a);
+}
+
+int main(void)
+{
+    xtimer_t timer = { .callback = _timer_cb };
+
+    puts("irq_handler test");
+    _main_pid = thread_getpid();
+
+    xtimer_set(&timer, TIMEOUT);
+    xtimer_usleep(2 * TIMEOUT);
+
+    if ((_handled[0] == 1) && (_handled[1] == 1) &&
+        (_order[0] == 'a') && (_order[1] == 'b') &&
+        (_double_add == -EALREADY)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Check the libfixmath array kernels against fix16_mul() and
+ *              compare their speed
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "fix16_vec.h"
+#include "xtimer.h"
+
+#define LEN     (64U)
+#define TAPS    (8U)
+
+static fix16_t _a[LEN];
+static fix16_t _b[LEN];
+static fix16_t _out[LEN];
+static fix16_t _coeffs[TAPS];
+static fix16_t _state[2 * TAPS];
+
+static unsigned _errors;
+
+static void _check(const char *what, unsigned i, fix16_t res, fix16_t expect)
+{
+    fix16_t diff = res - expect;
+
+    /* the kernels round once, the references once per product */
+    if ((diff > 4) || (diff < -4)) {
+        printf("%s[%u]: got 0x%08lx, expected 0x%08lx\n", what, i,
+               (unsigned long)res, (unsigned long)expect);
+        _errors++;
+    }
+}
+
+static fix16_t _ref_dot(const fix16_t *a, const fix16_t *b, size_t len)
+{
+    fix16_t acc = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        acc = fix16_sadd(acc, fix16_mul(a[i], b[i]));
+    }
+    return acc;
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < LEN; i++) {
+        _a[i] = fix16_from_dbl((i * 37 % 23) / 7.0 - 1.5);
+        _b[i] = fix16_from_dbl((i * 11 % 17) / 13.0 - 0.5);
+    }
+    for (unsigned i = 0; i < TAPS; i++) {
+        _coeffs[i] = fix16_from_dbl(1.0 / (i + 2));
+    }
+
+    _check("dot", 0, fix16_vec_dot(_a, _b, LEN), _ref_dot(_a, _b, LEN));
+
+    fix16_vec_scale(_out, _a, fix16_from_dbl(-2.25), LEN);
+    for (unsigned i = 0; i < LEN; i++) {
+        _check("scale", i, _out[i], fix16_mul(_a[i], fix16_from_dbl(-2.25)));
+    }
+
+    fix16_vec_add(_out, _a, _b, LEN);
+    for (unsigned i = 0; i < LEN; i++) {
+        _check("add", i, _out[i], fix16_sadd(_a[i], _b[i]));
+    }
+    _a[0] = fix16_maximum;
+    fix16_vec_add(_out, _a, _a, 1);
+    _check("add saturated", 0, _out[0], fix16_maximum);
+    _a[0] = 0;
+
+    /* filter in two blocks, the second continues the first */
+    fix16_fir_t fir;
+    fix16_fir_init(&fir, _coeffs, _state, TAPS);
+    fix16_fir_process(&fir, _out, _a, 5);
+    fix16_fir_process(&fir, &_out[5], &_a[5], LEN - 5);
+    for (unsigned n = 0; n < LEN; n++) {
+        fix16_t expect = 0;
+        for (unsigned k = 0; (k < TAPS) && (k <= n); k++) {
+            expect = fix16_sadd(expect, fix16_mul(_coeffs[k], _a[n - k]));
+        }
+        _check("fir", n, _out[n], expect);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < 100; i++) {
+        _out[i % LEN] = _ref_dot(_a, _b, LEN);
+    }
+    uint32_t ref = xtimer_now_usec() - start;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < 100; i++) {
+        _out[i % LEN] = fix16_vec_dot(_a, _b, LEN);
+    }
+    uint32_t vec = xtimer_now_usec() - start;
+    printf("100 dot products of %u: %lu us with fix16_mul(), "
+           "%lu us with fix16_vec_dot()\n", LEN, (unsigned long)ref,
+           (unsigned long)vec);
+
+    if (_errors) {
+        printf("%u errors\n", _errors);
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the lock-free mailbox
+ *
+ * Two timer ISRs feed a single consumer thread.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mbox_lf.h"
+#include "xtimer.h"
+
+#define SLOTS_NUMOF     (8U)
+#define PRODUCER_NUMOF  (2U)
+#define MSGS_PER_PROD   (100U)
+#define INTERVAL        (1000U)
+
+typedef struct {
+    xtimer_t timer;
+    uint16_t type;
+    uint32_t seq;
+    unsigned failed;
+} producer_t;
+
+static mbox_lf_slot_t slots[SLOTS_NUMOF];
+static mbox_lf_t mbox = MBOX_LF_INIT(slots, SLOTS_NUMOF);
+static producer_t producers[PRODUCER_NUMOF];
+
+static void _produce(void *arg)
+{
+    producer_t *p = arg;
+    msg_t m = { .type = p->type, .content.value = p->seq };
+
+    if (mbox_lf_try_put(&mbox, &m)) {
+        p->seq++;
+    }
+    else {
+        p->failed++;
+    }
+    if (p->seq < MSGS_PER_PROD) {
+        xtimer_set(&p->timer, INTERVAL + p->type * 100);
+    }
+}
+
+static int _test_fill(void)
+{
+    msg_t m;
+
+    for (unsigned i = 0; i < SLOTS_NUMOF; i++) {
+        m.content.value = i;
+        if (!mbox_lf_try_put(&mbox, &m)) {
+            puts("error: mailbox full too early");
+            return -1;
+        }
+    }
+    if (mbox_lf_try_put(&mbox, &m)) {
+        puts("error: put into full mailbox succeeded");
+        return -1;
+    }
+    for (unsigned i = 0; i < SLOTS_NUMOF; i++) {
+        if (!mbox_lf_try_get(&mbox, &m) || (m.content.value != i)) {
+            puts("error: messages got lost or reordered");
+            return -1;
+        }
+    }
+    if (mbox_lf_try_get(&mbox, &m)) {
+        puts("error: got message from empty mailbox");
+        return -1;
+    }
+    return 0;
+}
+
+static int _test_isr_producers(void)
+{
+    uint32_t expected[PRODUCER_NUMOF] = { 0 };
+    msg_t m;
+
+    for (unsigned i = 0; i < PRODUCER_NUMOF; i++) {
+        producers[i].timer.callback = _produce;
+        producers[i].timer.arg = &producers[i];
+        producers[i].type = i;
+        xtimer_set(&producers[i].timer, INTERVAL);
+    }
+
+    for (unsigned i = 0; i < PRODUCER_NUMOF * MSGS_PER_PROD; i++) {
+        mbox_lf_get(&mbox, &m);
+        if ((m.type >= PRODUCER_NUMOF) || (m.sender_pid != KERNEL_PID_ISR) ||
+            (m.content.value != expected[m.type]++)) {
+            puts("error: unexpected message");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("lock-free mailbox test");
+
+    if (_test_fill() == 0) {
+        puts("fill: OK");
+    }
+    if (_test_isr_producers() == 0) {
+        printf("isr producers: OK (%u full)\n",
+               producers[0].failed + producers[1].failed);
+    }
+    puts("Test END");
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+
+#define PRIO_LOW            (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_MID            (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_HIGH           (THREAD_PRIORITY_MAIN - 3)
+
+extern volatile thread_t *sched_active_thread;
+
+static char stack_low[THREAD_STACKSIZE_MAIN];
+static char stack_mid[THREAD_STACKSIZE_MAIN];
+static char stack_high[THREAD_STACKSIZE_MAIN];
+
+static kernel_pid_t pid_low;
+
+static mutex_t res = MUTEX_INIT;
+
+static void *t_low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&res);
+    puts("low: locked resource, going to sleep");
+    thread_sleep();
+    printf("low: unlocking resource (prio %i)\n",
+           (int)sched_active_thread->priority);
+    mutex_unlock(&res);
+    printf("low: done (prio %i)\n", (int)sched_active_thread->priority);
+
+    return NULL;
+}
+
+static void *t_mid(void *arg)
+{
+    (void)arg;
+
+    puts("mid: waking up low");
+    thread_wakeup(pid_low);
+    puts("mid: done");
+
+    return NULL;
+}
+
+static void *t_high(void *arg)
+{
+    (void)arg;
+
+    puts("high: trying to lock resource");
+    mutex_lock(&res);
+    puts("high: locked resource");
+    mutex_unlock(&res);
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Mutex priority inversion test\n");
+
+    pid_low = thread_create(stack_low, sizeof(stack_low), PRIO_LOW, 0,
+                            t_low, NULL, "low");
+    kernel_pid_t pid_mid = thread_create(stack_mid, sizeof(stack_mid),
+                                         PRIO_MID, THREAD_CREATE_SLEEPING,
+                                         t_mid, NULL, "mid");
+    thread_create(stack_high, sizeof(stack_high), PRIO_HIGH, 0,
+                  t_high, NULL, "high");
+
+    /* low holds the mutex and high is waiting for it, so low must have been
+     * boosted and preempt mid as soon as mid has woken it up */
+    thread_wakeup(pid_mid);
+
+    puts("\nTest END, check that high got the resource before mid finished.");
+
+    return 0;
+}
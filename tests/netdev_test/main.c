@@ -254,6 +254,39 @@ static int test_set_addr(void)
     return 1;
 }
 
+static int test_get_set_multi(void)
+{
+    static const uint8_t new_addr[] = { 0x2a, 0x83, 0x0e, 0x97, 0xc1, 0x3d };
+    uint8_t tmp[sizeof(new_addr)];
+    uint16_t chan;
+    int res[2];
+    gnrc_netapi_opt_t set[] = {
+        { .opt = NETOPT_ADDRESS, .data = (void *)new_addr,
+          .data_len = sizeof(new_addr) },
+    };
+    gnrc_netapi_opt_t get[] = {
+        { .opt = NETOPT_ADDRESS, .data = tmp, .data_len = sizeof(tmp) },
+        /* not supported by the device */
+        { .opt = NETOPT_CHANNEL, .data = &chan, .data_len = sizeof(chan) },
+    };
+
+    if ((gnrc_netapi_set_multi(_mac_pid, set, res, 1) != 1) ||
+        (res[0] != sizeof(new_addr))) {
+        puts("Error setting device address in bulk");
+        return 0;
+    }
+    if ((gnrc_netapi_get_multi(_mac_pid, get, res, 2) != 1) ||
+        (res[0] != sizeof(tmp)) || (res[1] != -ENOTSUP)) {
+        puts("Error getting options in bulk");
+        return 0;
+    }
+    else if (memcmp(tmp, new_addr, sizeof(new_addr)) != 0) {
+        puts("Got wrong device address in bulk");
+        return 0;
+    }
+    return 1;
+}
+
 int main(void)
 {
     /* initialization */
@@ -278,6 +311,7 @@ int main(void)
     EXECUTE(test_send);
     EXECUTE(test_receive);
     EXECUTE(test_set_addr);
+    EXECUTE(test_get_set_multi);
     puts("ALL TESTS SUCCESSFUL");
 
     return 0;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for continuous sampling of the ADC drivers
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "xtimer.h"
+#include "timex.h"
+#include "periph/adc.h"
+
+#define RES             ADC_RES_12BIT
+#define RATE            (20000U)
+#define BUF_LEN         (2 * 256U)
+#define DELAY           (1LU * US_PER_SEC)
+
+static uint16_t buf[BUF_LEN];
+
+static struct {
+    uint32_t count;
+    uint32_t sum;
+    uint16_t min;
+    uint16_t max;
+} stats;
+
+static void _reset(void)
+{
+    stats.count = 0;
+    stats.sum = 0;
+    stats.min = UINT16_MAX;
+    stats.max = 0;
+}
+
+static void _samples(void *arg, const uint16_t *samples, size_t len)
+{
+    (void)arg;
+
+    for (size_t i = 0; i < len; i++) {
+        stats.sum += samples[i];
+        if (samples[i] < stats.min) {
+            stats.min = samples[i];
+        }
+        if (samples[i] > stats.max) {
+            stats.max = samples[i];
+        }
+    }
+    stats.count += len;
+}
+
+int main(void)
+{
+    xtimer_ticks32_t last = xtimer_now();
+    adc_t line = ADC_LINE(0);
+
+    puts("\nRIOT ADC continuous sampling test\n");
+    printf("This test samples ADC_LINE(0) at %uHz with a 12-bit resolution\n"
+           "and prints statistics of the samples once every second\n\n", RATE);
+
+    if (adc_init(line) < 0) {
+        puts("Initialization of ADC_LINE(0) failed");
+        return 1;
+    }
+    _reset();
+    if (adc_stream_start(&line, 1, RES, RATE, buf, BUF_LEN, _samples,
+                         NULL) < 0) {
+        puts("Continuous sampling of ADC_LINE(0) failed to start");
+        return 1;
+    }
+
+    while (1) {
+        xtimer_periodic_wakeup(&last, DELAY);
+
+        unsigned state = irq_disable();
+        uint32_t count = stats.count;
+        uint32_t sum = stats.sum;
+        uint16_t min = stats.min;
+        uint16_t max = stats.max;
+        _reset();
+        irq_restore(state);
+
+        printf("%lu samples, min %u, max %u, mean %lu\n",
+               (unsigned long)count, min, max,
+               (unsigned long)(count ? sum / count : 0));
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Low-level DMA driver test
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#include "periph/dma.h"
+
+#define BUF_SIZE    (1024U)
+
+static uint32_t src[BUF_SIZE / sizeof(uint32_t)];
+static uint32_t dst[BUF_SIZE / sizeof(uint32_t)];
+static mutex_t done = MUTEX_INIT_LOCKED;
+static int done_res;
+
+static void _cb(void *arg, int res)
+{
+    (void)arg;
+    done_res = res;
+    mutex_unlock(&done);
+}
+
+static int _check(const char *name, uint32_t usec)
+{
+    int res = memcmp(src, dst, sizeof(dst));
+
+    printf("%-24s %6" PRIu32 " us %s\n", name, usec, res ? "FAILED" : "ok");
+    memset(dst, 0, sizeof(dst));
+    return (res != 0);
+}
+
+int main(void)
+{
+    dma_xfer_t xfer = {
+        .src = src,
+        .dst = dst,
+        .dir = DMA_MEM_TO_MEM,
+        .flags = DMA_INC_SRC | DMA_INC_DST,
+    };
+    static const char *names[] = { "DMA, bytes", "DMA, half words",
+                                   "DMA, words" };
+    int errors = 0;
+    uint32_t start;
+    dma_t dma;
+
+    puts("\nDMA peripheral driver test\n");
+
+    for (unsigned i = 0; i < sizeof(src); i++) {
+        ((uint8_t *)src)[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    dma = dma_acquire(DMA_TRIGGER_MEM);
+    if (dma == DMA_UNDEF) {
+        puts("[FAILED] no DMA channel");
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    memcpy(dst, src, sizeof(dst));
+    errors += _check("memcpy()", xtimer_now_usec() - start);
+
+    for (dma_width_t width = DMA_WIDTH_BYTE; width <= DMA_WIDTH_WORD; width++) {
+        xfer.width = width;
+        xfer.len = sizeof(dst) >> width;
+        start = xtimer_now_usec();
+        if (dma_transfer(dma, &xfer) != DMA_OK) {
+            printf("%s: dma_transfer() failed\n", names[width]);
+            errors++;
+            continue;
+        }
+        errors += _check(names[width], xtimer_now_usec() - start);
+    }
+
+    xfer.width = DMA_WIDTH_WORD;
+    xfer.len = sizeof(dst) / sizeof(uint32_t);
+    if (dma_start(dma, &xfer, _cb, NULL) != DMA_OK) {
+        puts("dma_start() failed");
+        errors++;
+    }
+    else {
+        mutex_lock(&done);
+        if (done_res != DMA_OK) {
+            puts("callback reported an error");
+            errors++;
+        }
+        errors += _check("DMA, callback", 0);
+    }
+
+    xfer.len = DMA_MAX_LEN + 1;
+    if (dma_transfer(dma, &xfer) != DMA_NOLEN) {
+        puts("too long transfer was not rejected");
+        errors++;
+    }
+
+    dma_release(dma);
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -210,6 +210,74 @@ static int cmd_edit(int argc, char **argv)
     return 0;
 }
 
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+static flashpage_writer_t writer;
+
+static int cmd_write_raw(int argc, char **argv)
+{
+    /* aligned, so that it can be used as source */
+    static uint32_t raw_buf[LINE_LEN / sizeof(uint32_t)];
+    uintptr_t addr;
+    size_t len;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <data>\n", argv[0]);
+        return 1;
+    }
+
+    addr = (uintptr_t)strtoul(argv[1], NULL, 0);
+    len = strlen(argv[2]);
+    if (len > sizeof(raw_buf)) {
+        len = sizeof(raw_buf);
+    }
+    /* pad to complete blocks, 0xff leaves the flash as it is */
+    memset(raw_buf, 0xff, sizeof(raw_buf));
+    memcpy(raw_buf, argv[2], len);
+    len += (FLASHPAGE_RAW_BLOCKSIZE - (len % FLASHPAGE_RAW_BLOCKSIZE)) %
+           FLASHPAGE_RAW_BLOCKSIZE;
+    if ((addr % FLASHPAGE_RAW_ALIGNMENT) || (addr < CPU_FLASH_BASE) ||
+        ((addr + len) > (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)))) {
+        printf("error: address must be aligned to %u byte and in flash\n",
+               (unsigned)FLASHPAGE_RAW_ALIGNMENT);
+        return 1;
+    }
+
+    flashpage_write_raw((void *)addr, raw_buf, len);
+    printf("wrote %u byte to erased flash at addr %p\n", (unsigned)len,
+           (void *)addr);
+    return 0;
+}
+
+static int cmd_write_buffered(int argc, char **argv)
+{
+    uintptr_t addr;
+    size_t len;
+
+    if (argc < 2) {
+        printf("usage: %s <addr> [<data>]\n", argv[0]);
+        return 1;
+    }
+
+    addr = (uintptr_t)strtoul(argv[1], NULL, 0);
+    if (argc < 3) {
+        /* no data, write the buffered page */
+        flashpage_writer_flush(&writer);
+        puts("flushed the buffered page");
+        return 0;
+    }
+    len = strlen(argv[2]);
+    if ((addr < CPU_FLASH_BASE) ||
+        ((addr + len) > (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)))) {
+        puts("error: given address is out of bounds");
+        return 1;
+    }
+
+    flashpage_writer_write(&writer, (void *)addr, argv[2], len);
+    printf("buffered %u byte for addr %p\n", (unsigned)len, (void *)addr);
+    return 0;
+}
+#endif
+
 static int cmd_test(int argc, char **argv)
 {
     int page;
@@ -251,6 +319,11 @@ static const shell_command_t shell_commands[] = {
     { "erase", "Erase the given page", cmd_erase },
     { "edit", "Write bytes to the local page", cmd_edit },
     { "test", "Write and verify test pattern", cmd_test },
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+    { "write_raw", "Write (ASCII) data to erased flash", cmd_write_raw },
+    { "write_buffered", "Write (ASCII) data to flash through the buffered "
+      "writer, flush without data", cmd_write_buffered },
+#endif
     { NULL, NULL, NULL }
 };
 
@@ -260,6 +333,9 @@ int main(void)
     puts("Please refer to the README.md for further information\n");
 
     cmd_info(0, NULL);
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+    flashpage_writer_init(&writer);
+#endif
 
     /* run the shell */
     char line_buf[SHELL_DEFAULT_BUFSIZE];
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Compare the speed of priority_queue_t and priority_heap_t
+ *
+ * Fills each queue with a growing number of entries with pseudo random
+ * priorities and empties it again, and prints the average time per
+ * add/remove_head pair.
+ *
+ * @author    Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "priority_heap.h"
+#include "priority_queue.h"
+#include "xtimer.h"
+
+#define MAX_NODES       (64U)
+#define REPEAT          (100U)
+
+static priority_queue_node_t qnodes[MAX_NODES];
+static priority_heap_node_t hnodes[MAX_NODES];
+static uint32_t prios[MAX_NODES];
+
+static void _init_prios(void)
+{
+    uint32_t lcg = 12345;
+
+    for (unsigned i = 0; i < MAX_NODES; i++) {
+        lcg = lcg * 1103515245 + 12345;
+        prios[i] = lcg >> 16;
+    }
+}
+
+static uint32_t _run_queue(unsigned num)
+{
+    priority_queue_t q = PRIORITY_QUEUE_INIT;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned r = 0; r < REPEAT; r++) {
+        for (unsigned i = 0; i < num; i++) {
+            qnodes[i].priority = prios[i];
+            priority_queue_add(&q, &qnodes[i]);
+        }
+        while (priority_queue_remove_head(&q)) {}
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _run_heap(unsigned num)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned r = 0; r < REPEAT; r++) {
+        for (unsigned i = 0; i < num; i++) {
+            hnodes[i].priority = prios[i];
+            priority_heap_add(&h, &hnodes[i]);
+        }
+        while (priority_heap_remove_head(&h)) {}
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    puts("priority queue timings (ns per add + remove_head)");
+    puts("  nodes |  list |  heap");
+
+    _init_prios();
+
+    for (unsigned num = 4; num <= MAX_NODES; num *= 2) {
+        uint32_t t_queue = _run_queue(num);
+        uint32_t t_heap = _run_heap(num);
+        printf("  %5u | %5" PRIu32 " | %5" PRIu32 "\n", num,
+               (uint32_t)((uint64_t)t_queue * 1000 / (num * REPEAT)),
+               (uint32_t)((uint64_t)t_heap * 1000 / (num * REPEAT)));
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for round robin time slicing
+ *
+ * Starts a number of busy threads with the same priority. Without time
+ * slicing only the first one would ever run.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORKER_NUMOF        (3U)
+#define TEST_DURATION       (1U * US_PER_SEC)
+
+static char stacks[WORKER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+
+static volatile uint32_t counters[WORKER_NUMOF];
+
+static void *busy(void *arg)
+{
+    volatile uint32_t *counter = arg;
+
+    while (1) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Round robin test");
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        thread_create(stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      busy, (void *)&counters[i], "busy");
+    }
+
+    xtimer_usleep(TEST_DURATION);
+
+    unsigned failed = 0;
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        printf("worker %u: %" PRIu32 "\n", i, counters[i]);
+        if (counters[i] == 0) {
+            failed = 1;
+        }
+    }
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -50,13 +50,18 @@ int main(void)
 #ifdef DEVELHELP
     P(name);
 #endif
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_STACKPROF)
     P(stack_start);
 #endif
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_STACKPROF)
     P(stack_size);
 #endif
+#ifdef MODULE_STACKPROF
+    P(stack_hwm);
+    P(stack_scan);
+#endif
 
     puts("Done.");
     return 0;
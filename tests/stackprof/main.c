@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the stack profiler
+ *
+ * A worker thread uses a known amount of stack once and then only sleeps.
+ * After enough context switches, the profiler must have found the deepest
+ * stack usage.
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stackprof.h"
+#include "thread.h"
+
+#define BUF_SIZE        (512U)
+#define WAKEUPS         (1000U)
+
+static char stack[THREAD_STACKSIZE_DEFAULT + BUF_SIZE];
+
+static void __attribute__((noinline)) _use_stack(void)
+{
+    volatile char buf[BUF_SIZE];
+
+    memset((char *)buf, 0x55, sizeof(buf));
+}
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    _use_stack();
+    while (1) {
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("stack profiler test");
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0,
+                                     _worker, NULL, "worker");
+
+    for (unsigned i = 0; i < WAKEUPS; i++) {
+        thread_wakeup(pid);
+    }
+
+    int usage = stackprof_usage(pid);
+    printf("worker stack usage: %i\n", usage);
+    if ((usage >= (int)BUF_SIZE) && (usage < (int)sizeof(stack))) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    stackprof_print();
+
+    return 0;
+}
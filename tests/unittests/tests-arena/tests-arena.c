@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "arena.h"
+#include "tests-arena.h"
+
+#define BUF_SIZE    (64U)
+
+static uint8_t _buf[BUF_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+static arena_t _arena;
+
+static void set_up(void)
+{
+    arena_init(&_arena, _buf, sizeof(_buf));
+}
+
+static void test_arena_alloc_align(void)
+{
+    uint8_t *a = arena_alloc(&_arena, 1);
+    uint8_t *b = arena_alloc(&_arena, 1);
+
+    TEST_ASSERT(a == _buf);
+    TEST_ASSERT(b == (_buf + ARENA_ALIGN));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - ARENA_ALIGN - 1, arena_available(&_arena));
+}
+
+static void test_arena_alloc_full(void)
+{
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, BUF_SIZE - 1));
+    /* the last byte is lost to alignment */
+    TEST_ASSERT_NULL(arena_alloc(&_arena, 1));
+    arena_clear(&_arena);
+    TEST_ASSERT_NULL(arena_alloc(&_arena, BUF_SIZE + 1));
+    TEST_ASSERT(arena_alloc(&_arena, BUF_SIZE) == _buf);
+    TEST_ASSERT_EQUAL_INT(0, arena_available(&_arena));
+}
+
+static void test_arena_mark_reset(void)
+{
+    uint8_t *a = arena_alloc(&_arena, 8);
+    arena_mark_t mark = arena_mark(&_arena);
+    uint8_t *b = arena_calloc(&_arena, 16);
+
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_INT(0, b[15]);
+    b[0] = 0xab;
+    arena_reset(&_arena, mark);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 8, arena_available(&_arena));
+    /* memory handed out after the mark is reused */
+    b = arena_calloc(&_arena, 4);
+    TEST_ASSERT(b == (a + 8));
+    TEST_ASSERT_EQUAL_INT(0, b[0]);
+}
+
+Test *tests_arena_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_arena_alloc_align),
+        new_TestFixture(test_arena_alloc_full),
+        new_TestFixture(test_arena_mark_reset),
+    };
+
+    EMB_UNIT_TESTCALLER(arena_tests, set_up, NULL, fixtures);
+
+    return (Test *)&arena_tests;
+}
+
+void tests_arena(void)
+{
+    TESTS_RUN(tests_arena_tests());
+}
+/** @} */
@@ -23,8 +23,17 @@
 #define TESTS_BLOOM_NOT_IN_FILTER (996)
 #define TESTS_BLOOM_FALSE_POS_RATE_THR (0.005)
 
+#define TESTS_BLOOM_DOUBLE_PROB_IN_FILTER (4)
+#define TESTS_BLOOM_COUNTING_REMOVED (5)
+
 static bloom_t bloom;
+static bloom_counting_t counting;
 BITFIELD(bf, TESTS_BLOOM_BITS);
+BLOOM_COUNTERS(counters, TESTS_BLOOM_BITS);
+hashfp_t double_hashes[2] = {
+                     (hashfp_t) fnv_hash,
+                     (hashfp_t) one_at_a_time_hash,
+                    };
 hashfp_t hashes[TESTS_BLOOM_HASHF] = {
                      (hashfp_t) fnv_hash,
                      (hashfp_t) sax_hash,
@@ -43,6 +52,20 @@ static void load_dictionary_fixture(void)
 
 }
 
+static int count_counting_in_filter(void)
+{
+    int in = 0;
+
+    for (int i = 0; i < lenA; i++)
+    {
+        if (bloom_counting_check(&counting, (const uint8_t *) A[i], strlen(A[i])))
+        {
+            in++;
+        }
+    }
+    return in;
+}
+
 static void set_up_bloom(void)
 {
     bloom_init(&bloom, TESTS_BLOOM_BITS, bf, hashes, TESTS_BLOOM_HASHF);
@@ -85,11 +108,79 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static void test_bloom_double_hashing_based_on_dictionary_fixture(void)
+{
+    int in;
+
+    bloom_init_double(&bloom, TESTS_BLOOM_BITS, bf, double_hashes,
+                      TESTS_BLOOM_HASHF);
+    load_dictionary_fixture();
+
+    for (int i = 0; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_check(&bloom, (const uint8_t *) B[i], strlen(B[i])));
+    }
+    in = 0;
+    for (int i = 0; i < lenA; i++)
+    {
+        if (bloom_check(&bloom, (const uint8_t *) A[i], strlen(A[i])))
+        {
+            in++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_DOUBLE_PROB_IN_FILTER, in);
+    TEST_ASSERT(((double) in / (double) lenA) < TESTS_BLOOM_FALSE_POS_RATE_THR);
+}
+
+static void test_bloom_counting_add_remove(void)
+{
+    memset(counters, 0, sizeof(counters));
+    bloom_counting_init(&counting, TESTS_BLOOM_BITS, counters, double_hashes,
+                        TESTS_BLOOM_HASHF);
+
+    for (int i = 0; i < lenB; i++)
+    {
+        bloom_counting_add(&counting, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_DOUBLE_PROB_IN_FILTER,
+                          count_counting_in_filter());
+
+    for (int i = 0; i < TESTS_BLOOM_COUNTING_REMOVED; i++)
+    {
+        TEST_ASSERT(bloom_counting_remove(&counting, (const uint8_t *) B[i],
+                                          strlen(B[i])));
+    }
+    for (int i = TESTS_BLOOM_COUNTING_REMOVED; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    for (int i = 0; i < TESTS_BLOOM_COUNTING_REMOVED; i++)
+    {
+        TEST_ASSERT(!bloom_counting_check(&counting, (const uint8_t *) B[i],
+                                          strlen(B[i])));
+    }
+
+    for (int i = TESTS_BLOOM_COUNTING_REMOVED; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_counting_remove(&counting, (const uint8_t *) B[i],
+                                          strlen(B[i])));
+    }
+    for (unsigned i = 0; i < sizeof(counters); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, counters[i]);
+    }
+    TEST_ASSERT(!bloom_counting_remove(&counting, (const uint8_t *) B[0],
+                                       strlen(B[0])));
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_double_hashing_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_counting_add_remove),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
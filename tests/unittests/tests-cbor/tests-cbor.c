@@ -18,6 +18,7 @@
 #include "bitarithm.h"
 #include "cbor.h"
 
+#include <errno.h>
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -38,7 +39,7 @@ static void my_cbor_print(const cbor_stream_t *stream)
     if (memcmp(stream.data, expected_value, expected_value_size) != 0) { \
         printf("\n"); \
         printf("  CBOR encoded data: "); my_cbor_print(&stream); printf("\n"); \
-        cbor_stream_t tmp = {expected_value, expected_value_size, expected_value_size}; \
+        cbor_stream_t tmp = {expected_value, expected_value_size, expected_value_size, NULL, NULL}; \
         printf("  Expected data    : "); my_cbor_print(&tmp); printf("\n"); \
         TEST_FAIL("Test failed"); \
     } \
@@ -55,7 +56,7 @@ static void my_cbor_print(const cbor_stream_t *stream)
     cbor_clear(&stream); \
     TEST_ASSERT(cbor_serialize_##function_suffix(&stream, input)); \
     CBOR_CHECK_SERIALIZED(stream, data, sizeof(data)); \
-    cbor_stream_t tmp = {data, sizeof(data), sizeof(data)}; \
+    cbor_stream_t tmp = {data, sizeof(data), sizeof(data), NULL, NULL}; \
     TEST_ASSERT_EQUAL_INT(sizeof(data), cbor_deserialize_##function_suffix(&tmp, 0, &buffer)); \
     CBOR_CHECK_DESERIALIZED(input, buffer, comparator); \
 } while (0)
@@ -91,13 +92,13 @@ static void my_cbor_print(const cbor_stream_t *stream)
 #endif
 
 static unsigned char stream_data[1024];
-static cbor_stream_t stream = {stream_data, sizeof(stream_data), 0};
+static cbor_stream_t stream = {stream_data, sizeof(stream_data), 0, NULL, NULL};
 
-static cbor_stream_t empty_stream = {NULL, 0, 0}; /* stream that is not large enough */
+static cbor_stream_t empty_stream = {NULL, 0, 0, NULL, NULL}; /* stream that is not large enough */
 
 static unsigned char invalid_stream_data[] = {0x40}; /* empty string encoded in CBOR */
 static cbor_stream_t invalid_stream = {invalid_stream_data, sizeof(invalid_stream_data),
-                                sizeof(invalid_stream_data)
+                                sizeof(invalid_stream_data), NULL, NULL
                                };
 
 static void setUp(void)
@@ -206,7 +207,7 @@ static void test_uint64_t_invalid(void)
     {
         /* check reading from stream that contains other type of data */
         unsigned char data[] = {0x40}; /* empty string encoded in CBOR */
-        cbor_stream_t stream = {data, 1, 1};
+        cbor_stream_t stream = {data, 1, 1, NULL, NULL};
         uint64_t val_uint64_t = 0;
         TEST_ASSERT_EQUAL_INT(0, cbor_deserialize_uint64_t(&stream, 0, &val_uint64_t));
     }
@@ -242,7 +243,7 @@ static void test_int64_t_invalid(void)
         /* check reading from stream that contains other type of data */
 
         unsigned char data[] = {0x40}; /* empty string encoded in CBOR */
-        cbor_stream_t stream = {data, 1, 1};
+        cbor_stream_t stream = {data, 1, 1, NULL, NULL};
 
         int64_t val = 0;
         TEST_ASSERT_EQUAL_INT(0, cbor_deserialize_int64_t(&stream, 0, &val));
@@ -561,7 +562,7 @@ static void test_map_invalid(void)
     {
         /* check reading from stream that contains other type of data */
         unsigned char data[] = {0x40}; /* empty string encoded in CBOR */
-        cbor_stream_t stream = {data, 1, 1};
+        cbor_stream_t stream = {data, 1, 1, NULL, NULL};
 
         size_t map_length;
         TEST_ASSERT_EQUAL_INT(0, cbor_deserialize_map(&stream, 0, &map_length));
@@ -748,6 +749,103 @@ static void test_double_invalid(void)
 }
 #endif /* MODULE_CBOR_FLOAT */
 
+static unsigned char flushed_data[64];
+static size_t flushed_len;
+
+static int flush_cb(const unsigned char *data, size_t len, void *arg)
+{
+    (void)arg;
+    if ((flushed_len + len) > sizeof(flushed_data)) {
+        return -1;
+    }
+    memcpy(&flushed_data[flushed_len], data, len);
+    flushed_len += len;
+    return 0;
+}
+
+static ssize_t read_cb(unsigned char *buf, size_t len, void *arg)
+{
+    size_t *pos = arg;
+
+    /* hand out the input in fragments of at most 3 bytes */
+    if (len > 3) {
+        len = 3;
+    }
+    if (len > (flushed_len - *pos)) {
+        len = flushed_len - *pos;
+    }
+    memcpy(buf, &flushed_data[*pos], len);
+    *pos += len;
+    return len;
+}
+
+static void test_stream_flush(void)
+{
+    unsigned char data[] = HEX_LITERAL(0x82, 0x19, 0x01, 0x00, 0x4a, 0x30, 0x31, 0x32,
+                                       0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x17);
+    unsigned char buf[6];
+    cbor_stream_t window;
+
+    flushed_len = 0;
+    cbor_init_flush(&window, buf, sizeof(buf), flush_cb, NULL);
+    TEST_ASSERT_EQUAL_INT(1, cbor_serialize_array(&window, 2));
+    TEST_ASSERT_EQUAL_INT(3, cbor_serialize_int(&window, 256));
+    /* does not fit into the window at all */
+    TEST_ASSERT_EQUAL_INT(11, cbor_serialize_byte_string(&window, "0123456789"));
+    TEST_ASSERT_EQUAL_INT(1, cbor_serialize_int(&window, 23));
+    TEST_ASSERT_EQUAL_INT(1, window.pos);
+    TEST_ASSERT_EQUAL_INT(0, cbor_flush(&window));
+    TEST_ASSERT_EQUAL_INT(0, window.pos);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), flushed_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, flushed_data, sizeof(data)));
+}
+
+static void test_reader_fill(void)
+{
+    unsigned char buf[4];
+    cbor_reader_t reader;
+    size_t pos = 0, offset = 0, read;
+    int vals[] = { 0, 24, 256, 65536, 3 }, val;
+    unsigned i = 0;
+
+    for (unsigned j = 0; j < sizeof(vals) / sizeof(vals[0]); j++) {
+        TEST_ASSERT(cbor_serialize_int(&stream, vals[j]));
+    }
+    memcpy(flushed_data, stream.data, stream.pos);
+    flushed_len = stream.pos;
+
+    /* the fourth value is 5 bytes long, so does not fit */
+    cbor_reader_init(&reader, buf, sizeof(buf), read_cb, &pos);
+    while (1) {
+        if ((read = cbor_deserialize_int(&reader.stream, offset, &val)) > 0) {
+            TEST_ASSERT_EQUAL_INT(vals[i++], val);
+            offset += read;
+        }
+        else if (cbor_reader_fill(&reader, &offset) <= 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(3, i);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_reader_fill(&reader, &offset));
+
+    unsigned char large_buf[8];
+    pos = offset = i = 0;
+    cbor_reader_init(&reader, large_buf, sizeof(large_buf), read_cb, &pos);
+    while (1) {
+        if ((read = cbor_deserialize_int(&reader.stream, offset, &val)) > 0) {
+            TEST_ASSERT_EQUAL_INT(vals[i++], val);
+            offset += read;
+        }
+        else if (cbor_reader_fill(&reader, &offset) <= 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(5, i);
+    /* all input was consumed */
+    TEST_ASSERT_EQUAL_INT(0, reader.stream.pos);
+    TEST_ASSERT_EQUAL_INT(flushed_len, pos);
+}
+
 /**
  * See examples from CBOR RFC (cf. Appendix A. Examples)
  */
@@ -789,6 +887,8 @@ TestRef tests_cbor_all(void)
                         new_TestFixture(test_double),
                         new_TestFixture(test_double_invalid),
 #endif /* MODULE_CBOR_FLOAT */
+                        new_TestFixture(test_stream_flush),
+                        new_TestFixture(test_reader_fill),
     };
 
     EMB_UNIT_TESTCALLER(CborTest, setUp, tearDown, fixtures);
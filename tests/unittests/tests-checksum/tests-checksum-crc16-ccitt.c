@@ -88,6 +88,15 @@ static void test_checksum_crc16_ccitt_sequence_4bytes(void)
                 sizeof(buf) / 2, expect));
 }
 
+/* the start value of 0 is used by SD cards */
+static void test_checksum_crc16_ccitt_update_seed0(void)
+{
+    unsigned char buf[] = "123456789";
+    uint16_t expect = 0x31C3;
+
+    TEST_ASSERT_EQUAL_INT(expect, crc16_ccitt_update(0, buf, sizeof(buf) - 1));
+}
+
 Test *tests_checksum_crc16_ccitt_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -98,6 +107,7 @@ Test *tests_checksum_crc16_ccitt_tests(void)
         new_TestFixture(test_checksum_crc16_ccitt_sequence_256a),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_1to9),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_4bytes),
+        new_TestFixture(test_checksum_crc16_ccitt_update_seed0),
     };
 
     EMB_UNIT_TESTCALLER(checksum_crc16_ccitt_tests, NULL, NULL, fixtures);
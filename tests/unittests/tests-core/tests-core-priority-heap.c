@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-core.h"
+
+#define H_LEN (8)
+
+static priority_heap_t h = PRIORITY_HEAP_INIT;
+static priority_heap_node_t he[H_LEN];
+
+static void set_up(void)
+{
+    priority_heap_init(&h);
+    for (unsigned i = 0; i < H_LEN; ++i) {
+        priority_heap_node_init(&(he[i]));
+    }
+}
+
+static void test_priority_heap_remove_head_empty(void)
+{
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+    TEST_ASSERT_NULL(priority_heap_peek(&h));
+}
+
+static void test_priority_heap_add_one(void)
+{
+    priority_heap_node_t *elem = &(he[1]), *res;
+
+    elem->data = 7317;
+    elem->priority = 713643658;
+
+    priority_heap_add(&h, elem);
+
+    TEST_ASSERT(priority_heap_peek(&h) == elem);
+
+    res = priority_heap_remove_head(&h);
+
+    TEST_ASSERT(res == elem);
+    TEST_ASSERT_EQUAL_INT(7317, res->data);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_sorted(void)
+{
+    static const uint32_t prios[H_LEN] = { 5, 3, 7, 1, 6, 0, 4, 2 };
+
+    for (unsigned i = 0; i < H_LEN; ++i) {
+        he[i].priority = prios[i];
+        he[i].data = i;
+        priority_heap_add(&h, &he[i]);
+    }
+
+    for (uint32_t prio = 0; prio < H_LEN; ++prio) {
+        priority_heap_node_t *res = priority_heap_remove_head(&h);
+        TEST_ASSERT_NOT_NULL(res);
+        TEST_ASSERT_EQUAL_INT(prio, res->priority);
+    }
+
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_remove(void)
+{
+    for (unsigned i = 0; i < H_LEN; ++i) {
+        he[i].priority = i;
+        priority_heap_add(&h, &he[i]);
+    }
+
+    /* force a tree structure, then remove the root and two inner nodes */
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[0]);
+    priority_heap_remove(&h, &he[1]);
+    priority_heap_remove(&h, &he[5]);
+    /* removing a node twice must be harmless */
+    priority_heap_remove(&h, &he[5]);
+
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[2]);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[3]);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[4]);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[6]);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[7]);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+Test *tests_core_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_remove_head_empty),
+        new_TestFixture(test_priority_heap_add_one),
+        new_TestFixture(test_priority_heap_sorted),
+        new_TestFixture(test_priority_heap_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(core_priority_heap_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&core_priority_heap_tests;
+}
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -131,11 +133,64 @@ static void tests_core_ringbuffer_remove(void)
 
 }
 
+static void tests_core_ringbuffer_add_get_wrap(void)
+{
+    char mem[5];
+    char out[5];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_get(&buf, out, 2));
+    /* wraps around the end and is cut to the free space */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_add(&buf, "defgh", 5));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_add(&buf, "x", 1));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "cdefg", 5));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_empty(&buf));
+}
+
+static void tests_core_ringbuffer_span(void)
+{
+    char mem[5];
+    char *span;
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_span(&buf, &span));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_reserve_span(&buf, &span));
+    memcpy(span, "abcd", 4);
+    ringbuffer_commit(&buf, 4);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+
+    /* the free space wraps around: only the part up to the end */
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_reserve_span(&buf, &span));
+    TEST_ASSERT(span == &mem[4]);
+    *span = 'e';
+    ringbuffer_commit(&buf, 1);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_reserve_span(&buf, &span));
+    TEST_ASSERT(span == &mem[0]);
+    memcpy(span, "fg", 2);
+    ringbuffer_commit(&buf, 2);
+
+    /* the elements wrap around: "de" then "fg" */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_span(&buf, &span));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span, "de", 2));
+    ringbuffer_remove(&buf, 2);
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_span(&buf, &span));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span, "fg", 2));
+    ringbuffer_remove(&buf, 2);
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_empty(&buf));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
+        new_TestFixture(tests_core_ringbuffer_add_get_wrap),
+        new_TestFixture(tests_core_ringbuffer_span),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -130,12 +130,68 @@ static void test_crypto_chacha20_tc8(void)
                         TC8_CHACHA20_BLOCK0, TC8_CHACHA20_BLOCK1);
 }
 
+static void test_crypto_chacha20_tc8_multi_block(void)
+{
+    chacha_ctx ctx;
+    uint32_t buf[(2 * 64 / sizeof(uint32_t)) + 1];
+    uint8_t *unaligned = ((uint8_t *)buf) + 1;
+    uint8_t expected[2 * 64];
+
+    memcpy(expected, TC8_CHACHA20_BLOCK0, 64);
+    memcpy(&expected[64], TC8_CHACHA20_BLOCK1, 64);
+
+    TEST_ASSERT_EQUAL_INT(0, chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV));
+    chacha_keystream_blocks(&ctx, unaligned, 2);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(unaligned, expected, sizeof(expected)));
+
+    /* the keystream XORed onto zeros, in place */
+    TEST_ASSERT_EQUAL_INT(0, chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV));
+    memset(buf, 0, sizeof(buf));
+    chacha_encrypt(&ctx, buf, buf, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, expected, sizeof(expected)));
+
+    /* a partial block discards the rest of its keystream */
+    TEST_ASSERT_EQUAL_INT(0, chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV));
+    memset(buf, 0, sizeof(buf));
+    chacha_encrypt(&ctx, unaligned, unaligned, 10);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(unaligned, expected, 10));
+    chacha_encrypt(&ctx, &unaligned[10], &unaligned[10], 64);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&unaligned[10], &expected[64], 64));
+    TEST_ASSERT_EQUAL_INT(2, ctx.state[12]);
+}
+
+static void test_crypto_chacha_prng_reseed(void)
+{
+    static const uint8_t seed[64];
+    static const uint8_t entropy[32] = { 0x01, 0x02, 0x03, 0x04 };
+    uint32_t plain[4], mixed[4], again[4];
+
+    chacha_prng_seed(seed, sizeof(seed));
+    chacha_prng_bytes(plain, sizeof(plain));
+
+    /* buffered numbers are dropped, the new ones depend on the entropy */
+    chacha_prng_seed(seed, sizeof(seed));
+    chacha_prng_next();
+    chacha_prng_reseed(entropy, sizeof(entropy));
+    chacha_prng_bytes(mixed, sizeof(mixed));
+    TEST_ASSERT(memcmp(plain, mixed, sizeof(plain)) != 0);
+
+    /* the old key is kept: mixing the same entropy twice cancels out */
+    chacha_prng_seed(seed, sizeof(seed));
+    chacha_prng_reseed(entropy, sizeof(entropy));
+    chacha_prng_reseed(entropy, sizeof(entropy));
+    chacha_prng_bytes(again, sizeof(again));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, again, sizeof(plain)));
+}
+
 Test *tests_crypto_chacha_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_chacha8_tc8),
         new_TestFixture(test_crypto_chacha12_tc8),
         new_TestFixture(test_crypto_chacha20_tc8),
+        new_TestFixture(test_crypto_chacha20_tc8_multi_block),
+        new_TestFixture(test_crypto_chacha_prng_reseed),
     };
     EMB_UNIT_TESTCALLER(crypto_chacha_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_chacha_tests;
@@ -7,9 +7,13 @@
  */
 
 #include <limits.h>
+#include <string.h>
 
 #include "embUnit.h"
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ecb.h"
 #include "tests-crypto.h"
 
 static uint8_t TEST_KEY[] = {
@@ -59,11 +63,75 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
 }
 
+static unsigned _process_calls;
+
+/* processes ECB itself, like a hardware engine would */
+static int _process(const cipher_context_t *ctx, cipher_mode_t mode,
+                    int encrypt, uint8_t *iv, uint8_t nonce_len,
+                    const uint8_t *input, size_t length, uint8_t *output)
+{
+    (void)iv;
+    (void)nonce_len;
+
+    _process_calls++;
+    if ((mode != CIPHER_MODE_ECB) || !encrypt) {
+        return CIPHER_ERR_NOT_SUPPORTED;
+    }
+    for (size_t i = 0; i < length; i += AES_BLOCK_SIZE) {
+        aes_encrypt(ctx, input + i, output + i);
+    }
+    return length;
+}
+
+static const cipher_interface_t _process_interface = {
+    .block_size = AES_BLOCK_SIZE,
+    .max_key_size = AES_KEY_SIZE,
+    .init = aes_init,
+    .encrypt = aes_encrypt,
+    .decrypt = aes_decrypt,
+    .process = _process,
+};
+
+static void test_crypto_cipher_process(void)
+{
+    cipher_t cipher;
+    int err, cmp;
+    uint8_t iv[16] = {0};
+    uint8_t inp[32], data[32];
+
+    memcpy(inp, TEST_INP, 16);
+    memcpy(inp + 16, TEST_INP, 16);
+
+    err = cipher_init(&cipher, &_process_interface, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    _process_calls = 0;
+    err = cipher_encrypt_ecb(&cipher, inp, sizeof(inp), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(inp), err);
+    TEST_ASSERT_EQUAL_INT(1, _process_calls);
+    cmp = compare(TEST_ENC_AES, data + 16, 16);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+
+    /* modes the implementation does not process fall back to software */
+    err = cipher_decrypt_ecb(&cipher, data, sizeof(data), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), err);
+    TEST_ASSERT_EQUAL_INT(2, _process_calls);
+    cmp = compare(inp, data, sizeof(inp));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+
+    err = cipher_encrypt_cbc(&cipher, iv, TEST_INP, 16, data);
+    TEST_ASSERT_EQUAL_INT(16, err);
+    TEST_ASSERT_EQUAL_INT(3, _process_calls);
+    cmp = compare(TEST_ENC_AES, data, 16);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+}
+
 Test* tests_crypto_cipher_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
-        new_TestFixture(test_crypto_cipher_aes_decrypt)
+        new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_process)
     };
 
     EMB_UNIT_TESTCALLER(crypto_cipher_tests, NULL, NULL, fixtures);
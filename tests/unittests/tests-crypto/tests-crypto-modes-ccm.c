@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "embUnit.h"
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
 #include "crypto/modes/ccm.h"
 #include "tests-crypto.h"
@@ -147,12 +148,105 @@ static void test_crypto_modes_ccm_decrypt(void)
                     TEST_2_INPUT_LEN);
 }
 
+/* leaves everything to software, but takes the path for ciphers processing
+ * whole messages */
+static int _process(const cipher_context_t *ctx, cipher_mode_t mode,
+                    int encrypt, uint8_t *iv, uint8_t nonce_len,
+                    const uint8_t *input, size_t length, uint8_t *output)
+{
+    (void)ctx;
+    (void)mode;
+    (void)encrypt;
+    (void)iv;
+    (void)nonce_len;
+    (void)input;
+    (void)length;
+    (void)output;
+    return CIPHER_ERR_NOT_SUPPORTED;
+}
+
+static const cipher_interface_t _process_interface = {
+    .block_size = AES_BLOCK_SIZE,
+    .max_key_size = AES_KEY_SIZE,
+    .init = aes_init,
+    .encrypt = aes_encrypt,
+    .decrypt = aes_decrypt,
+    .process = _process,
+};
+
+static void test_ccm_star_op(const cipher_interface_t *interface)
+{
+    cipher_t cipher;
+    int len, err;
+    uint8_t data[60], adata[40];
+    uint8_t *ciphertext = TEST_1_EXPECTED + TEST_1_ADATA_LEN;
+
+    err = cipher_init(&cipher, interface, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    /* in place, same as CCM with a MAC */
+    memcpy(data, TEST_1_INPUT + TEST_1_ADATA_LEN, TEST_1_INPUT_LEN);
+    len = cipher_encrypt_ccm_star(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                                  TEST_1_NONCE, TEST_1_NONCE_LEN, data,
+                                  TEST_1_INPUT_LEN, data);
+    TEST_ASSERT_EQUAL_INT(TEST_1_EXPECTED_LEN - TEST_1_ADATA_LEN, len);
+    TEST_ASSERT_EQUAL_INT(1, compare(ciphertext, data, len));
+    len = cipher_decrypt_ccm_star(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                                  TEST_1_NONCE, TEST_1_NONCE_LEN, data, len,
+                                  data);
+    TEST_ASSERT_EQUAL_INT(TEST_1_INPUT_LEN, len);
+    TEST_ASSERT_EQUAL_INT(1, compare(TEST_1_INPUT + TEST_1_ADATA_LEN, data, len));
+
+    /* the MAC covers the additional data */
+    memcpy(data, ciphertext, TEST_1_EXPECTED_LEN - TEST_1_ADATA_LEN);
+    memcpy(adata, TEST_1_INPUT, TEST_1_ADATA_LEN);
+    adata[0] ^= 0x01;
+    len = cipher_decrypt_ccm_star(&cipher, adata, TEST_1_ADATA_LEN, 8, 2,
+                                  TEST_1_NONCE, TEST_1_NONCE_LEN, data,
+                                  TEST_1_EXPECTED_LEN - TEST_1_ADATA_LEN, data);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC, len);
+
+    /* encryption only, the ciphertext is the same as with a MAC */
+    len = cipher_encrypt_ccm_star(&cipher, NULL, 0, 0, 2, TEST_1_NONCE,
+                                  TEST_1_NONCE_LEN,
+                                  TEST_1_INPUT + TEST_1_ADATA_LEN,
+                                  TEST_1_INPUT_LEN, data);
+    TEST_ASSERT_EQUAL_INT(TEST_1_INPUT_LEN, len);
+    TEST_ASSERT_EQUAL_INT(1, compare(ciphertext, data, len));
+    len = cipher_decrypt_ccm_star(&cipher, NULL, 0, 0, 2, TEST_1_NONCE,
+                                  TEST_1_NONCE_LEN, data, len, data);
+    TEST_ASSERT_EQUAL_INT(TEST_1_INPUT_LEN, len);
+    TEST_ASSERT_EQUAL_INT(1, compare(TEST_1_INPUT + TEST_1_ADATA_LEN, data, len));
+
+    /* additional data spanning several blocks, without a message */
+    for (unsigned i = 0; i < sizeof(adata); i++) {
+        adata[i] = i;
+    }
+    len = cipher_encrypt_ccm_star(&cipher, adata, sizeof(adata), 16, 2,
+                                  TEST_1_NONCE, TEST_1_NONCE_LEN, NULL, 0, data);
+    TEST_ASSERT_EQUAL_INT(16, len);
+    len = cipher_decrypt_ccm_star(&cipher, adata, sizeof(adata), 16, 2,
+                                  TEST_1_NONCE, TEST_1_NONCE_LEN, data, 16, NULL);
+    TEST_ASSERT_EQUAL_INT(0, len);
+
+    len = cipher_encrypt_ccm_star(&cipher, NULL, 0, 3, 2, TEST_1_NONCE,
+                                  TEST_1_NONCE_LEN, data, 1, data);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_MAC_LENGTH, len);
+}
+
+static void test_crypto_modes_ccm_star(void)
+{
+    test_ccm_star_op(CIPHER_AES_128);
+    test_ccm_star_op(&_process_interface);
+}
+
 
 Test* tests_crypto_modes_ccm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
-                        new_TestFixture(test_crypto_modes_ccm_decrypt)
+                        new_TestFixture(test_crypto_modes_ccm_decrypt),
+                        new_TestFixture(test_crypto_modes_ccm_star)
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "fb_page.h"
+
+#include "tests-fb_page.h"
+
+#define WIDTH       (20U)
+#define PAGES       (3U)
+
+static uint8_t _buf[FB_PAGE_BUF_SIZE(WIDTH, PAGES * 8)];
+static fb_page_dirty_t _dirty[PAGES];
+static fb_page_t _fb;
+
+static unsigned _calls;
+static uint8_t _page;
+static uint16_t _x;
+static size_t _len;
+
+static void _flush_cb(void *arg, uint8_t page, uint16_t x,
+                      const uint8_t *data, size_t len)
+{
+    (void)arg;
+    TEST_ASSERT(data == &_buf[page * WIDTH + x]);
+    _calls++;
+    _page = page;
+    _x = x;
+    _len = len;
+}
+
+static void set_up(void)
+{
+    fb_page_init(&_fb, _buf, _dirty, WIDTH, PAGES);
+    /* the content of a new framebuffer is unknown to the display */
+    TEST_ASSERT(fb_page_is_dirty(&_fb));
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    _calls = 0;
+}
+
+static void test_fb_page_init(void)
+{
+    fb_page_init(&_fb, _buf, _dirty, WIDTH, PAGES);
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(PAGES, _calls);
+    TEST_ASSERT_EQUAL_INT(0, _x);
+    TEST_ASSERT_EQUAL_INT(WIDTH, _len);
+    TEST_ASSERT(!fb_page_is_dirty(&_fb));
+}
+
+static void test_fb_page_write_unchanged(void)
+{
+    static const uint8_t zeros[WIDTH] = { 0 };
+
+    fb_page_write(&_fb, 1, 0, zeros, sizeof(zeros));
+    fb_page_fill(&_fb, 0x00);
+    TEST_ASSERT(!fb_page_is_dirty(&_fb));
+}
+
+static void test_fb_page_write_changed_part(void)
+{
+    const uint8_t data[] = { 0x00, 0xff, 0x00, 0x81, 0x00 };
+
+    /* only the columns from the first to the last change are taken */
+    fb_page_write(&_fb, 2, 5, data, sizeof(data));
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, _calls);
+    TEST_ASSERT_EQUAL_INT(2, _page);
+    TEST_ASSERT_EQUAL_INT(6, _x);
+    TEST_ASSERT_EQUAL_INT(3, _len);
+    TEST_ASSERT_EQUAL_INT(0x81, _buf[2 * WIDTH + 8]);
+}
+
+static void test_fb_page_write_cut_off(void)
+{
+    const uint8_t data[] = { 0x01, 0x02, 0x03, 0x04 };
+
+    fb_page_write(&_fb, 0, WIDTH - 2, data, sizeof(data));
+    fb_page_write(&_fb, PAGES, 0, data, sizeof(data));
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, _calls);
+    TEST_ASSERT_EQUAL_INT(WIDTH - 2, _x);
+    TEST_ASSERT_EQUAL_INT(2, _len);
+}
+
+static void test_fb_page_pixel(void)
+{
+    fb_page_set_pixel(&_fb, 3, 9, true);
+    TEST_ASSERT(fb_page_get_pixel(&_fb, 3, 9));
+    TEST_ASSERT(!fb_page_get_pixel(&_fb, 3, 8));
+    TEST_ASSERT_EQUAL_INT(0x02, _buf[WIDTH + 3]);
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, _page);
+    TEST_ASSERT_EQUAL_INT(3, _x);
+    TEST_ASSERT_EQUAL_INT(1, _len);
+    /* setting it again changes nothing */
+    fb_page_set_pixel(&_fb, 3, 9, true);
+    TEST_ASSERT(!fb_page_is_dirty(&_fb));
+    fb_page_set_pixel(&_fb, 3, 9, false);
+    TEST_ASSERT(fb_page_is_dirty(&_fb));
+    TEST_ASSERT(!fb_page_get_pixel(&_fb, 3, 9));
+}
+
+static void test_fb_page_flush_max_pages(void)
+{
+    fb_page_set_pixel(&_fb, 0, 0, true);
+    fb_page_set_pixel(&_fb, 0, 8, true);
+    fb_page_set_pixel(&_fb, 0, 16, true);
+    TEST_ASSERT(fb_page_flush(&_fb, _flush_cb, NULL, 2));
+    TEST_ASSERT_EQUAL_INT(2, _calls);
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 2));
+    TEST_ASSERT_EQUAL_INT(3, _calls);
+    TEST_ASSERT_EQUAL_INT(2, _page);
+}
+
+static void test_fb_page_take_in_turns(void)
+{
+    uint8_t page;
+    uint16_t x;
+
+    fb_page_set_pixel(&_fb, 1, 0, true);
+    TEST_ASSERT_EQUAL_INT(1, fb_page_take(&_fb, &page, &x));
+    TEST_ASSERT_EQUAL_INT(0, page);
+    /* page 0 changes again while it is transferred, page 1 goes first */
+    fb_page_set_pixel(&_fb, 1, 1, true);
+    fb_page_set_pixel(&_fb, 2, 8, true);
+    TEST_ASSERT_EQUAL_INT(1, fb_page_take(&_fb, &page, &x));
+    TEST_ASSERT_EQUAL_INT(1, page);
+    TEST_ASSERT_EQUAL_INT(1, fb_page_take(&_fb, &page, &x));
+    TEST_ASSERT_EQUAL_INT(0, page);
+    TEST_ASSERT_EQUAL_INT(0, fb_page_take(&_fb, &page, &x));
+}
+
+static void test_fb_page_mark(void)
+{
+    fb_page_mark(&_fb, 1, 4, 2);
+    fb_page_mark(&_fb, 1, 10, 3);
+    TEST_ASSERT(!fb_page_flush(&_fb, _flush_cb, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, _calls);
+    TEST_ASSERT_EQUAL_INT(4, _x);
+    TEST_ASSERT_EQUAL_INT(9, _len);
+}
+
+Test *tests_fb_page_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fb_page_init),
+        new_TestFixture(test_fb_page_write_unchanged),
+        new_TestFixture(test_fb_page_write_changed_part),
+        new_TestFixture(test_fb_page_write_cut_off),
+        new_TestFixture(test_fb_page_pixel),
+        new_TestFixture(test_fb_page_flush_max_pages),
+        new_TestFixture(test_fb_page_take_in_turns),
+        new_TestFixture(test_fb_page_mark),
+    };
+
+    EMB_UNIT_TESTCALLER(fb_page_tests, set_up, NULL, fixtures);
+
+    return (Test *)&fb_page_tests;
+}
+
+void tests_fb_page(void)
+{
+    TESTS_RUN(tests_fb_page_tests());
+}
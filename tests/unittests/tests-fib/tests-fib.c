@@ -21,11 +21,18 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+#ifdef MODULE_FIB_TRIE
+static fib_trie_node_t _trie_nodes[FIB_TRIE_NODES_NUMOF(TEST_FIB_TABLE_SIZE)];
+#endif
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
                                       .mtx_access = MUTEX_INIT,
-                                      .notify_rp_pos = 0 };
+                                      .notify_rp_pos = 0,
+#ifdef MODULE_FIB_TRIE
+                                      .trie_nodes = _trie_nodes,
+#endif
+                                    };
 
 /*
 * @brief helper to fill FIB with unique entries
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "fw_update.h"
+#include "hashes/sha256.h"
+#include "mtd.h"
+
+#include "tests-fw_update.h"
+
+#define SECTOR_COUNT    (8U)
+#define PAGE_PER_SECTOR (2U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define SLOT_OFFSET     (SECTOR_SIZE)
+#define SLOT_SIZE       (4 * SECTOR_SIZE)
+#define IMAGE_SIZE      (SLOT_SIZE - SECTOR_SIZE - 17)
+#define SOURCE_OFFSET   (5 * SECTOR_SIZE)
+#define SOURCE_SIZE     (3 * SECTOR_SIZE)
+
+/* RAM-based mtd, programming only clears bits like NOR flash */
+static uint8_t _memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned _erases[SECTOR_COUNT];
+
+static uint8_t _image[IMAGE_SIZE];
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+static fw_update_t _update;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, &_memory[addr], size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((addr + size > sizeof(_memory)) ||
+        ((addr % PAGE_SIZE) + size > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        _memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((addr % SECTOR_SIZE != 0) || (size % SECTOR_SIZE != 0) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(&_memory[addr], 0xff, size);
+    for (uint32_t i = 0; i < size / SECTOR_SIZE; i++) {
+        _erases[(addr / SECTOR_SIZE) + i]++;
+    }
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static void set_up(void)
+{
+    /* previous content of the slot, that must be erased */
+    memset(_memory, 0, sizeof(_memory));
+    memset(_erases, 0, sizeof(_erases));
+    for (unsigned i = 0; i < sizeof(_image); i++) {
+        _image[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    sha256(_image, sizeof(_image), _digest);
+}
+
+static void _write_image(size_t chunk)
+{
+    for (size_t pos = 0; pos < sizeof(_image); pos += chunk) {
+        size_t len = sizeof(_image) - pos;
+        if (len > chunk) {
+            len = chunk;
+        }
+        TEST_ASSERT_EQUAL_INT(0, fw_update_write(&_update, &_image[pos], len));
+    }
+}
+
+static void test_fw_update_write_verify(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             SLOT_SIZE, 0));
+    _write_image(37);
+    TEST_ASSERT_EQUAL_INT(IMAGE_SIZE, fw_update_finish(&_update, _digest));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_memory[SLOT_OFFSET], _image,
+                                    sizeof(_image)));
+
+    /* only the sectors holding the image are erased */
+    TEST_ASSERT_EQUAL_INT(0, _erases[0]);
+    TEST_ASSERT_EQUAL_INT(1, _erases[1]);
+    TEST_ASSERT_EQUAL_INT(1, _erases[3]);
+    TEST_ASSERT_EQUAL_INT(0, _erases[4]);
+    TEST_ASSERT_EQUAL_INT(0, _memory[SLOT_OFFSET + SLOT_SIZE - 1]);
+}
+
+static void test_fw_update_digest_mismatch(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             SLOT_SIZE, 0));
+    _write_image(FW_UPDATE_BUF_SIZE);
+    _digest[0] ^= 1;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, fw_update_finish(&_update, _digest));
+}
+
+static void test_fw_update_too_big(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             2 * SECTOR_SIZE, 0));
+    TEST_ASSERT_EQUAL_INT(0, fw_update_write(&_update, _image,
+                                             2 * SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EFBIG, fw_update_write(&_update, _image, 1));
+    TEST_ASSERT_EQUAL_INT(2 * SECTOR_SIZE, fw_update_finish(&_update, NULL));
+}
+
+static void test_fw_update_unaligned(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, fw_update_start(&_update, &_dev,
+                                                   PAGE_SIZE, SLOT_SIZE, 0));
+}
+
+static void _write_chunks(const uint8_t *data, size_t len, size_t chunk)
+{
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = ((len - pos) < chunk) ? (len - pos) : chunk;
+        TEST_ASSERT_EQUAL_INT(0, fw_update_write(&_update, &data[pos], n));
+    }
+}
+
+static void test_fw_update_delta(void)
+{
+    uint8_t patch[128] = { 0x00, 100 };
+    uint8_t *p = &patch[2 + 100];
+    static const uint8_t ops[] = {
+        0x01, 5, 'h', 'e', 'l', 'l', 'o',
+        0x02, 20,                   /* seek +10 */
+        0x00, 4, 1, 1, 1, 1,
+        0x02, 0xe3, 0x01,           /* seek -114 */
+        0x00, 2, 0, 0,
+    };
+    uint8_t *src = &_memory[SOURCE_OFFSET];
+
+    memcpy(p, ops, sizeof(ops));
+    p += sizeof(ops);
+    for (unsigned i = 0; i < SOURCE_SIZE; i++) {
+        src[i] = (uint8_t)(i * 3);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             SLOT_SIZE, 0));
+    fw_update_set_source(&_update, &_dev, SOURCE_OFFSET, SOURCE_SIZE);
+    _write_chunks(patch, p - patch, 7);
+    TEST_ASSERT_EQUAL_INT(111, fw_update_finish(&_update, NULL));
+
+    uint8_t *img = &_memory[SLOT_OFFSET];
+    TEST_ASSERT_EQUAL_INT(0, memcmp(img, src, 100));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&img[100], "hello", 5));
+    TEST_ASSERT_EQUAL_INT(src[110] + 1, img[105]);
+    TEST_ASSERT_EQUAL_INT(src[113] + 1, img[108]);
+    TEST_ASSERT_EQUAL_INT(src[0], img[109]);
+    TEST_ASSERT_EQUAL_INT(src[1], img[110]);
+}
+
+static void test_fw_update_delta_invalid(void)
+{
+    /* truncated */
+    static const uint8_t truncated[] = { 0x01, 5, 'h' };
+    /* seek before the start of the source */
+    static const uint8_t seek[] = { 0x02, 0x01 };
+
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             SLOT_SIZE, 0));
+    fw_update_set_source(&_update, &_dev, SOURCE_OFFSET, SOURCE_SIZE);
+    _write_chunks(truncated, sizeof(truncated), 2);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, fw_update_finish(&_update, NULL));
+
+    TEST_ASSERT_EQUAL_INT(0, fw_update_start(&_update, &_dev, SLOT_OFFSET,
+                                             SLOT_SIZE, 0));
+    fw_update_set_source(&_update, &_dev, SOURCE_OFFSET, SOURCE_SIZE);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, fw_update_write(&_update, seek,
+                                                   sizeof(seek)));
+}
+
+Test *tests_fw_update_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fw_update_write_verify),
+        new_TestFixture(test_fw_update_digest_mismatch),
+        new_TestFixture(test_fw_update_too_big),
+        new_TestFixture(test_fw_update_unaligned),
+        new_TestFixture(test_fw_update_delta),
+        new_TestFixture(test_fw_update_delta_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(fw_update_tests, set_up, NULL, fixtures);
+
+    return (Test *)&fw_update_tests;
+}
+
+void tests_fw_update(void)
+{
+    TESTS_RUN(tests_fw_update_tests());
+}
+/** @} */
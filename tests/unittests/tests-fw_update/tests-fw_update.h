@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``fw_update`` module
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ */
+#ifndef TESTS_FW_UPDATE_H
+#define TESTS_FW_UPDATE_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+    * @brief   The entry point of this test suite.
+    */
+void tests_fw_update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_FW_UPDATE_H */
+/** @} */
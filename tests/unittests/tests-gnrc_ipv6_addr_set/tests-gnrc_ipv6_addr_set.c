@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/addr_set.h"
+
+#include "tests-gnrc_ipv6_addr_set.h"
+
+#define SET_SIZE    (8U)
+
+static gnrc_ipv6_addr_set_entry_t _entries[SET_SIZE];
+static gnrc_ipv6_addr_set_t _set = GNRC_IPV6_ADDR_SET_INIT(_entries);
+
+static void _test_addr(ipv6_addr_t *addr, uint8_t last)
+{
+    ipv6_addr_from_str(addr, "2001:db8::");
+    addr->u8[15] = last;
+}
+
+static void set_up(void)
+{
+    memset(_entries, 0, sizeof(_entries));
+    memset(_set.lens, 0, sizeof(_set.lens));
+}
+
+static void test_gnrc_ipv6_addr_set_match__empty(void)
+{
+    ipv6_addr_t addr;
+
+    _test_addr(&addr, 1);
+    TEST_ASSERT(!gnrc_ipv6_addr_set_match(&_set, &addr));
+}
+
+static void test_gnrc_ipv6_addr_set_add__addr(void)
+{
+    ipv6_addr_t addr;
+
+    _test_addr(&addr, 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_add(&_set, &addr,
+                                                    IPV6_ADDR_BIT_LEN));
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+    _test_addr(&addr, 2);
+    TEST_ASSERT(!gnrc_ipv6_addr_set_match(&_set, &addr));
+}
+
+static void test_gnrc_ipv6_addr_set_add__prefix(void)
+{
+    ipv6_addr_t addr;
+
+    /* the bits behind the prefix are ignored */
+    _test_addr(&addr, 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_add(&_set, &addr, 64));
+    _test_addr(&addr, 0xff);
+    addr.u8[8] = 0xab;
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+    addr.u8[7] = 0x01;
+    TEST_ASSERT(!gnrc_ipv6_addr_set_match(&_set, &addr));
+}
+
+static void test_gnrc_ipv6_addr_set_add__twice(void)
+{
+    ipv6_addr_t addr;
+
+    _test_addr(&addr, 1);
+    for (unsigned i = 0; i < SET_SIZE + 1; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_add(&_set, &addr,
+                                                        IPV6_ADDR_BIT_LEN));
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_del(&_set, &addr,
+                                                    IPV6_ADDR_BIT_LEN));
+    TEST_ASSERT(!gnrc_ipv6_addr_set_match(&_set, &addr));
+}
+
+static void test_gnrc_ipv6_addr_set_add__full(void)
+{
+    ipv6_addr_t addr;
+
+    for (unsigned i = 0; i < SET_SIZE; i++) {
+        _test_addr(&addr, i);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_add(&_set, &addr,
+                                                        IPV6_ADDR_BIT_LEN));
+    }
+    _test_addr(&addr, SET_SIZE);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_ipv6_addr_set_add(&_set, &addr,
+                                                          IPV6_ADDR_BIT_LEN));
+    for (unsigned i = 0; i < SET_SIZE; i++) {
+        _test_addr(&addr, i);
+        TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+    }
+}
+
+static void test_gnrc_ipv6_addr_set_del__unknown(void)
+{
+    ipv6_addr_t addr;
+
+    _test_addr(&addr, 1);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_ipv6_addr_set_del(&_set, &addr, 64));
+    gnrc_ipv6_addr_set_add(&_set, &addr, 64);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_ipv6_addr_set_del(&_set, &addr, 48));
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+}
+
+static void test_gnrc_ipv6_addr_set_del__keeps_others(void)
+{
+    ipv6_addr_t addr;
+
+    /* a full table makes sure some entries were probed past their home */
+    for (unsigned i = 0; i < SET_SIZE; i++) {
+        _test_addr(&addr, i);
+        gnrc_ipv6_addr_set_add(&_set, &addr, IPV6_ADDR_BIT_LEN);
+    }
+    for (unsigned i = 0; i < SET_SIZE; i += 2) {
+        _test_addr(&addr, i);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_del(&_set, &addr,
+                                                        IPV6_ADDR_BIT_LEN));
+    }
+    for (unsigned i = 0; i < SET_SIZE; i++) {
+        _test_addr(&addr, i);
+        TEST_ASSERT_EQUAL_INT(i & 1, gnrc_ipv6_addr_set_match(&_set, &addr));
+    }
+}
+
+static void test_gnrc_ipv6_addr_set_del__prefix(void)
+{
+    ipv6_addr_t addr, other;
+
+    _test_addr(&addr, 1);
+    _test_addr(&other, 2);
+    gnrc_ipv6_addr_set_add(&_set, &addr, 64);
+    gnrc_ipv6_addr_set_add(&_set, &addr, IPV6_ADDR_BIT_LEN);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_addr_set_del(&_set, &addr, 64));
+    /* the address within the prefix stays */
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+    TEST_ASSERT(!gnrc_ipv6_addr_set_match(&_set, &other));
+}
+
+static void test_gnrc_ipv6_addr_set_match__default_route(void)
+{
+    ipv6_addr_t addr;
+
+    gnrc_ipv6_addr_set_add(&_set, &ipv6_addr_unspecified, 0);
+    _test_addr(&addr, 1);
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &addr));
+    TEST_ASSERT(gnrc_ipv6_addr_set_match(&_set, &ipv6_addr_loopback));
+}
+
+Test *tests_gnrc_ipv6_addr_set_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_ipv6_addr_set_match__empty),
+        new_TestFixture(test_gnrc_ipv6_addr_set_add__addr),
+        new_TestFixture(test_gnrc_ipv6_addr_set_add__prefix),
+        new_TestFixture(test_gnrc_ipv6_addr_set_add__twice),
+        new_TestFixture(test_gnrc_ipv6_addr_set_add__full),
+        new_TestFixture(test_gnrc_ipv6_addr_set_del__unknown),
+        new_TestFixture(test_gnrc_ipv6_addr_set_del__keeps_others),
+        new_TestFixture(test_gnrc_ipv6_addr_set_del__prefix),
+        new_TestFixture(test_gnrc_ipv6_addr_set_match__default_route),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_addr_set_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_ipv6_addr_set_tests;
+}
+
+void tests_gnrc_ipv6_addr_set(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_addr_set_tests());
+}
+/** @} */
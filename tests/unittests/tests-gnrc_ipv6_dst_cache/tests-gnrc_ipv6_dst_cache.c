@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ipv6.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/dst_cache.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_ipv6_dst_cache.h"
+
+#define TEST_NETIF      (TEST_UINT8)
+#define OTHER_NETIF     (TEST_UINT8 + 1)
+
+static const uint8_t l2addr[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+
+static void _test_addr(ipv6_addr_t *addr, uint8_t last)
+{
+    ipv6_addr_from_str(addr, "2001:db8::");
+    addr->u8[15] = last;
+}
+
+static void set_up(void)
+{
+    /* drops all entries of previous tests */
+    gnrc_ipv6_dst_cache_invalidate();
+}
+
+static void test_gnrc_ipv6_dst_cache_get__empty(void)
+{
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 1);
+    TEST_ASSERT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_add__success(void)
+{
+    const gnrc_ipv6_dst_cache_t *entry;
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 1);
+    gnrc_ipv6_dst_cache_add(gnrc_ipv6_dst_cache_version(), KERNEL_PID_UNDEF,
+                            &dst, TEST_NETIF, l2addr, sizeof(l2addr));
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT_EQUAL_INT(TEST_NETIF, entry->iface);
+    TEST_ASSERT_EQUAL_INT(sizeof(l2addr), entry->l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(l2addr, entry->l2addr, sizeof(l2addr)));
+    /* entries are per requested interface */
+    TEST_ASSERT_NULL(gnrc_ipv6_dst_cache_get(OTHER_NETIF, &dst));
+    _test_addr(&dst, 2);
+    TEST_ASSERT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_add__outdated(void)
+{
+    uint32_t version = gnrc_ipv6_dst_cache_version();
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 1);
+    /* change during the lookup of the next hop */
+    gnrc_ipv6_dst_cache_invalidate();
+    gnrc_ipv6_dst_cache_add(version, KERNEL_PID_UNDEF, &dst, TEST_NETIF,
+                            l2addr, sizeof(l2addr));
+    TEST_ASSERT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_add__full(void)
+{
+    ipv6_addr_t dst;
+
+    for (unsigned i = 0; i <= GNRC_IPV6_DST_CACHE_SIZE; i++) {
+        _test_addr(&dst, i);
+        gnrc_ipv6_dst_cache_add(gnrc_ipv6_dst_cache_version(), KERNEL_PID_UNDEF,
+                                &dst, TEST_NETIF, l2addr, sizeof(l2addr));
+    }
+    /* the newest entries are all there */
+    for (unsigned i = 1; i <= GNRC_IPV6_DST_CACHE_SIZE; i++) {
+        _test_addr(&dst, i);
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+    }
+}
+
+static void test_gnrc_ipv6_dst_cache_invalidate(void)
+{
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 1);
+    gnrc_ipv6_dst_cache_add(gnrc_ipv6_dst_cache_version(), KERNEL_PID_UNDEF,
+                            &dst, TEST_NETIF, l2addr, sizeof(l2addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_dst_cache_invalidate();
+    TEST_ASSERT_NULL(gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_get_pmtu__unknown(void)
+{
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 1);
+    TEST_ASSERT_EQUAL_INT(IPV6_MIN_MTU,
+                          gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_set_pmtu(void)
+{
+    const gnrc_ipv6_dst_cache_t *entry;
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 2);
+    gnrc_ipv6_dst_cache_add(gnrc_ipv6_dst_cache_version(), KERNEL_PID_UNDEF,
+                            &dst, TEST_NETIF, l2addr, sizeof(l2addr));
+    gnrc_ipv6_dst_cache_set_pmtu(&dst, 1400);
+    TEST_ASSERT_EQUAL_INT(1400,
+                          gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+    /* must not increase */
+    gnrc_ipv6_dst_cache_set_pmtu(&dst, 1500);
+    TEST_ASSERT_EQUAL_INT(1400,
+                          gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+    /* must not get below the minimum MTU */
+    gnrc_ipv6_dst_cache_set_pmtu(&dst, 576);
+    TEST_ASSERT_EQUAL_INT(IPV6_MIN_MTU,
+                          gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_dst_cache_get(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT_EQUAL_INT(IPV6_MIN_MTU, entry->mtu);
+}
+
+static void test_gnrc_ipv6_dst_cache_set_pmtu__survives_invalidate(void)
+{
+    ipv6_addr_t dst;
+
+    _test_addr(&dst, 3);
+    gnrc_ipv6_dst_cache_set_pmtu(&dst, 1400);
+    gnrc_ipv6_dst_cache_invalidate();
+    TEST_ASSERT_EQUAL_INT(1400,
+                          gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_gnrc_ipv6_dst_cache_set_pmtu__full(void)
+{
+    ipv6_addr_t dst;
+
+    for (unsigned i = 0; i <= GNRC_IPV6_DST_CACHE_PMTU_SIZE; i++) {
+        _test_addr(&dst, 0x10 + i);
+        gnrc_ipv6_dst_cache_set_pmtu(&dst, 1300 + i);
+    }
+    /* the newest path MTUs are all there */
+    for (unsigned i = 1; i <= GNRC_IPV6_DST_CACHE_PMTU_SIZE; i++) {
+        _test_addr(&dst, 0x10 + i);
+        TEST_ASSERT_EQUAL_INT(1300 + i,
+                              gnrc_ipv6_dst_cache_get_pmtu(KERNEL_PID_UNDEF, &dst));
+    }
+}
+
+Test *tests_gnrc_ipv6_dst_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_ipv6_dst_cache_get__empty),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_add__success),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_add__outdated),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_add__full),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_invalidate),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_get_pmtu__unknown),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_set_pmtu),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_set_pmtu__survives_invalidate),
+        new_TestFixture(test_gnrc_ipv6_dst_cache_set_pmtu__full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_dst_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_ipv6_dst_cache_tests;
+}
+
+void tests_gnrc_ipv6_dst_cache(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_dst_cache_tests());
+}
+/** @} */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netdev/indirect.h"
+
+#include "tests-gnrc_netdev_indirect.h"
+
+#define TEST_NOW    (1000U)
+
+static gnrc_netdev_indirect_t indirect;
+static gnrc_pktsnip_t pkts[GNRC_NETDEV_INDIRECT_QUEUE_SIZE + 1];
+static const uint8_t child_short[] = { 0x12, 0x34 };
+static const uint8_t child_long[] = { 0x02, 0x01, 0x02, 0x03,
+                                      0x04, 0x05, 0x06, 0x07 };
+
+static void set_up(void)
+{
+    gnrc_netdev_indirect_init(&indirect);
+}
+
+static void test_gnrc_netdev_indirect_init(void)
+{
+    TEST_ASSERT(indirect.pending_src);
+    TEST_ASSERT_EQUAL_INT(0, indirect.pending);
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_get(&indirect, child_short,
+                                              sizeof(child_short)));
+}
+
+static void test_gnrc_netdev_indirect_poll(void)
+{
+    gnrc_netdev_indirect_child_t *child;
+
+    child = gnrc_netdev_indirect_poll(&indirect, child_short,
+                                      sizeof(child_short), TEST_NOW);
+    TEST_ASSERT_NOT_NULL(child);
+    TEST_ASSERT_EQUAL_INT(TEST_NOW, child->last_poll);
+    TEST_ASSERT(child == gnrc_netdev_indirect_get(&indirect, child_short,
+                                                  sizeof(child_short)));
+    /* a second poll refreshes the entry */
+    TEST_ASSERT(child == gnrc_netdev_indirect_poll(&indirect, child_short,
+                                                   sizeof(child_short),
+                                                   TEST_NOW + 1));
+    TEST_ASSERT_EQUAL_INT(TEST_NOW + 1, child->last_poll);
+    /* addresses of different length are different children */
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_get(&indirect, child_long,
+                                              sizeof(child_short)));
+    TEST_ASSERT(child != gnrc_netdev_indirect_poll(&indirect, child_long,
+                                                   sizeof(child_long),
+                                                   TEST_NOW + 1));
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_poll(&indirect, child_long, 0,
+                                               TEST_NOW));
+}
+
+static void test_gnrc_netdev_indirect_poll__full(void)
+{
+    uint8_t addr[] = { 0x00, 0x00 };
+    gnrc_netdev_indirect_child_t *child;
+
+    for (unsigned i = 0; i < GNRC_NETDEV_INDIRECT_CHILDREN; i++) {
+        addr[1] = i;
+        TEST_ASSERT_NOT_NULL(gnrc_netdev_indirect_poll(&indirect, addr,
+                                                       sizeof(addr), TEST_NOW));
+    }
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_poll(&indirect, child_short,
+                                               sizeof(child_short), TEST_NOW));
+    /* expired children without packets make room */
+    addr[1] = 0;
+    child = gnrc_netdev_indirect_get(&indirect, addr, sizeof(addr));
+    TEST_ASSERT_NOT_NULL(child);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_indirect_push(child, &pkts[0]));
+    addr[1] = 1;
+    child = gnrc_netdev_indirect_get(&indirect, addr, sizeof(addr));
+    TEST_ASSERT(child == gnrc_netdev_indirect_poll(&indirect, child_short,
+                                                   sizeof(child_short),
+                                                   TEST_NOW + GNRC_NETDEV_INDIRECT_TIMEOUT_US + 1));
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_get(&indirect, addr, sizeof(addr)));
+}
+
+static void test_gnrc_netdev_indirect_expired(void)
+{
+    gnrc_netdev_indirect_child_t *child;
+
+    child = gnrc_netdev_indirect_poll(&indirect, child_short,
+                                      sizeof(child_short), UINT32_MAX);
+    TEST_ASSERT_NOT_NULL(child);
+    /* survives the wrap-around of the clock */
+    TEST_ASSERT(!gnrc_netdev_indirect_expired(child, GNRC_NETDEV_INDIRECT_TIMEOUT_US - 1));
+    TEST_ASSERT(gnrc_netdev_indirect_expired(child, GNRC_NETDEV_INDIRECT_TIMEOUT_US));
+}
+
+static void test_gnrc_netdev_indirect_push_pop(void)
+{
+    gnrc_netdev_indirect_child_t *child;
+
+    child = gnrc_netdev_indirect_poll(&indirect, child_long,
+                                      sizeof(child_long), TEST_NOW);
+    TEST_ASSERT_NOT_NULL(child);
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_pop(child));
+    for (unsigned i = 0; i < GNRC_NETDEV_INDIRECT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_indirect_push(child, &pkts[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_netdev_indirect_push(child,
+                                                    &pkts[GNRC_NETDEV_INDIRECT_QUEUE_SIZE]));
+    TEST_ASSERT(&pkts[0] == gnrc_netdev_indirect_pop(child));
+    /* the queue wraps around */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_indirect_push(child,
+                                                       &pkts[GNRC_NETDEV_INDIRECT_QUEUE_SIZE]));
+    for (unsigned i = 1; i <= GNRC_NETDEV_INDIRECT_QUEUE_SIZE; i++) {
+        TEST_ASSERT(&pkts[i] == gnrc_netdev_indirect_pop(child));
+    }
+    TEST_ASSERT_EQUAL_INT(0, child->numof);
+    TEST_ASSERT_NULL(gnrc_netdev_indirect_pop(child));
+}
+
+Test *tests_gnrc_netdev_indirect_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_netdev_indirect_init),
+        new_TestFixture(test_gnrc_netdev_indirect_poll),
+        new_TestFixture(test_gnrc_netdev_indirect_poll__full),
+        new_TestFixture(test_gnrc_netdev_indirect_expired),
+        new_TestFixture(test_gnrc_netdev_indirect_push_pop),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netdev_indirect_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_netdev_indirect_tests;
+}
+
+void tests_gnrc_netdev_indirect(void)
+{
+    TESTS_RUN(tests_gnrc_netdev_indirect_tests());
+}
+/** @} */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/netdev/qos.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_netdev_qos.h"
+
+#define PKT_INIT_ELEM(len, data, next) \
+    { 1, (next), (data), (len), GNRC_NETTYPE_UNDEF }
+#define PKT_INIT_ELEM_STATIC_DATA(data, next) PKT_INIT_ELEM(sizeof(data), data, next)
+
+#define BULK_LIMIT      (8U)
+
+static gnrc_netdev_qos_t qos;
+static gnrc_pktsnip_t pkts[BULK_LIMIT + 1];
+
+static void set_up(void)
+{
+    gnrc_pktsnip_t pkt = PKT_INIT_ELEM_STATIC_DATA(TEST_STRING8, NULL);
+
+    for (unsigned i = 0; i < (sizeof(pkts) / sizeof(pkts[0])); i++) {
+        pkts[i] = pkt;
+    }
+    gnrc_netdev_qos_init(&qos);
+}
+
+static void test_gnrc_netdev_qos_classify(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV_QOS_BULK,
+                          gnrc_netdev_qos_classify(&pkts[0]));
+}
+
+static void test_gnrc_netdev_qos_pop_empty(void)
+{
+    TEST_ASSERT_NULL(gnrc_netdev_qos_pop(&qos));
+}
+
+static void test_gnrc_netdev_qos_push_pop(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_qos_push(&qos, &pkts[0]));
+    TEST_ASSERT(&pkts[0] == gnrc_netdev_qos_pop(&qos));
+    TEST_ASSERT_NULL(gnrc_netdev_qos_pop(&qos));
+}
+
+static void test_gnrc_netdev_qos_fifo(void)
+{
+    for (unsigned i = 0; i < BULK_LIMIT; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_qos_push(&qos, &pkts[i]));
+    }
+    for (unsigned i = 0; i < BULK_LIMIT; i++) {
+        TEST_ASSERT(&pkts[i] == gnrc_netdev_qos_pop(&qos));
+    }
+    TEST_ASSERT_NULL(gnrc_netdev_qos_pop(&qos));
+}
+
+static void test_gnrc_netdev_qos_limit(void)
+{
+    for (unsigned i = 0; i < BULK_LIMIT; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_qos_push(&qos, &pkts[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, gnrc_netdev_qos_push(&qos, &pkts[BULK_LIMIT]));
+    TEST_ASSERT_EQUAL_INT(1, qos.drops[GNRC_NETDEV_QOS_BULK]);
+    /* freed space can be used again */
+    TEST_ASSERT(&pkts[0] == gnrc_netdev_qos_pop(&qos));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netdev_qos_push(&qos, &pkts[BULK_LIMIT]));
+}
+
+Test *tests_gnrc_netdev_qos_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_netdev_qos_classify),
+        new_TestFixture(test_gnrc_netdev_qos_pop_empty),
+        new_TestFixture(test_gnrc_netdev_qos_push_pop),
+        new_TestFixture(test_gnrc_netdev_qos_fifo),
+        new_TestFixture(test_gnrc_netdev_qos_limit),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netdev_qos_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_netdev_qos_tests;
+}
+
+void tests_gnrc_netdev_qos(void)
+{
+    TESTS_RUN(tests_gnrc_netdev_qos_tests());
+}
+/** @} */
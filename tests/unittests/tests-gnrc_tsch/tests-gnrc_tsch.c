@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/tsch/eb.h"
+#include "net/gnrc/tsch/schedule.h"
+
+#include "tests-gnrc_tsch.h"
+
+#define TEST_ASN    (0x123456789aULL)
+
+static gnrc_tsch_slotframe_t sf;
+static uint8_t buf[GNRC_TSCH_EB_IE_LEN_MAX];
+
+static void set_up(void)
+{
+    memset(&sf, 0, sizeof(sf));
+    memset(buf, 0, sizeof(buf));
+}
+
+static void test_gnrc_tsch_slotframe_init_minimal(void)
+{
+    const gnrc_tsch_cell_t *cell;
+
+    gnrc_tsch_slotframe_init_minimal(&sf);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_SLOTFRAME_LENGTH, sf.length);
+    TEST_ASSERT_EQUAL_INT(1, sf.numof);
+    TEST_ASSERT_NOT_NULL((cell = gnrc_tsch_slotframe_get(&sf, 0)));
+    TEST_ASSERT_EQUAL_INT(0, cell->channel_offset);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_CELL_OPT_TX | GNRC_TSCH_CELL_OPT_RX |
+                          GNRC_TSCH_CELL_OPT_SHARED | GNRC_TSCH_CELL_OPT_TIMEKEEPING,
+                          cell->options);
+    /* the cell repeats with the slotframe */
+    TEST_ASSERT(cell == gnrc_tsch_slotframe_get(&sf, GNRC_TSCH_SLOTFRAME_LENGTH));
+    TEST_ASSERT_NULL(gnrc_tsch_slotframe_get(&sf, 1));
+    TEST_ASSERT_NULL(gnrc_tsch_slotframe_get(&sf, GNRC_TSCH_SLOTFRAME_LENGTH - 1));
+}
+
+static void test_gnrc_tsch_slotframe_add(void)
+{
+    gnrc_tsch_cell_t cell = { .timeslot = 3, .channel_offset = 5,
+                              .options = GNRC_TSCH_CELL_OPT_RX };
+
+    gnrc_tsch_slotframe_init_minimal(&sf);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_slotframe_add(&sf, &cell));
+    TEST_ASSERT_EQUAL_INT(5, gnrc_tsch_slotframe_get(&sf, 3)->channel_offset);
+    cell.timeslot = GNRC_TSCH_SLOTFRAME_LENGTH;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_slotframe_add(&sf, &cell));
+    cell.timeslot = 1;
+    for (unsigned i = sf.numof; i < GNRC_TSCH_CELLS_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_slotframe_add(&sf, &cell));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_tsch_slotframe_add(&sf, &cell));
+}
+
+static void test_gnrc_tsch_channel(void)
+{
+    uint8_t seen[IEEE802154_CHANNEL_MAX + 1] = { 0 };
+
+    /* a cell hops over all channels */
+    for (uint64_t asn = TEST_ASN; asn < (TEST_ASN + (16 * 7)); asn += 7) {
+        uint8_t channel = gnrc_tsch_channel(asn, 2);
+
+        TEST_ASSERT(channel >= IEEE802154_CHANNEL_MIN);
+        TEST_ASSERT(channel <= IEEE802154_CHANNEL_MAX);
+        seen[channel]++;
+    }
+    for (unsigned i = IEEE802154_CHANNEL_MIN; i <= IEEE802154_CHANNEL_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(1, seen[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(gnrc_tsch_channel(TEST_ASN + 1, 0),
+                          gnrc_tsch_channel(TEST_ASN, 1));
+    TEST_ASSERT_EQUAL_INT(gnrc_tsch_hopping_channel(0), gnrc_tsch_channel(0, 0));
+}
+
+static void test_gnrc_tsch_eb_write__too_small(void)
+{
+    gnrc_tsch_eb_t eb = { .asn = TEST_ASN };
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_eb_write(buf, 4, &eb, NULL));
+}
+
+static void test_gnrc_tsch_eb_write_parse(void)
+{
+    gnrc_tsch_eb_t eb = { .asn = TEST_ASN, .join_metric = 3 }, res;
+    gnrc_tsch_slotframe_t res_sf;
+    gnrc_tsch_cell_t cell = { .timeslot = 4, .channel_offset = 1,
+                              .options = GNRC_TSCH_CELL_OPT_TX };
+    size_t len;
+
+    gnrc_tsch_slotframe_init_minimal(&sf);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_slotframe_add(&sf, &cell));
+    len = gnrc_tsch_eb_write(buf, sizeof(buf), &eb, &sf);
+    TEST_ASSERT(len > 0);
+    /* header termination 1 */
+    TEST_ASSERT_EQUAL_INT(0x00, buf[0]);
+    TEST_ASSERT_EQUAL_INT(0x3f, buf[1]);
+    memset(&res, 0xff, sizeof(res));
+    memset(&res_sf, 0, sizeof(res_sf));
+    TEST_ASSERT_EQUAL_INT(len, gnrc_tsch_eb_parse(buf, len, &res, &res_sf));
+    TEST_ASSERT(TEST_ASN == res.asn);
+    TEST_ASSERT_EQUAL_INT(3, res.join_metric);
+    TEST_ASSERT_EQUAL_INT(0, res.timeslot_id);
+    TEST_ASSERT_EQUAL_INT(0, res.hopping_id);
+    TEST_ASSERT_EQUAL_INT(sf.length, res_sf.length);
+    TEST_ASSERT_EQUAL_INT(2, res_sf.numof);
+    TEST_ASSERT_EQUAL_INT(sf.cells[0].options, res_sf.cells[0].options);
+    TEST_ASSERT_EQUAL_INT(4, res_sf.cells[1].timeslot);
+    TEST_ASSERT_EQUAL_INT(1, res_sf.cells[1].channel_offset);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_CELL_OPT_TX, res_sf.cells[1].options);
+}
+
+static void test_gnrc_tsch_eb_parse__no_sync(void)
+{
+    /* HT1 followed by an empty MLME IE */
+    static const uint8_t ies[] = { 0x00, 0x3f, 0x00, 0x88 };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(ies), gnrc_tsch_eb_parse(ies, sizeof(ies), NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_tsch_eb_parse(ies, sizeof(ies),
+                                                       (gnrc_tsch_eb_t *)buf, NULL));
+}
+
+static void test_gnrc_tsch_eb_parse__truncated(void)
+{
+    gnrc_tsch_eb_t eb = { .asn = TEST_ASN }, res;
+    size_t len = gnrc_tsch_eb_write(buf, sizeof(buf), &eb, NULL);
+
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_tsch_eb_parse(buf, len - 1, &res, NULL));
+}
+
+static void test_gnrc_tsch_eb_parse__payload(void)
+{
+    /* HT2 and payload */
+    static const uint8_t frame[] = { 0x80, 0x3f, 0xab, 0xcd };
+
+    TEST_ASSERT_EQUAL_INT(2, gnrc_tsch_eb_parse(frame, sizeof(frame), NULL, NULL));
+}
+
+Test *tests_gnrc_tsch_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tsch_slotframe_init_minimal),
+        new_TestFixture(test_gnrc_tsch_slotframe_add),
+        new_TestFixture(test_gnrc_tsch_channel),
+        new_TestFixture(test_gnrc_tsch_eb_write__too_small),
+        new_TestFixture(test_gnrc_tsch_eb_write_parse),
+        new_TestFixture(test_gnrc_tsch_eb_parse__no_sync),
+        new_TestFixture(test_gnrc_tsch_eb_parse__truncated),
+        new_TestFixture(test_gnrc_tsch_eb_parse__payload),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tsch_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tsch_tests;
+}
+
+void tests_gnrc_tsch(void)
+{
+    TESTS_RUN(tests_gnrc_tsch_tests());
+}
+/** @} */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ieee802154.h"
+#include "net/ieee802154_security.h"
+
+#include "tests-ieee802154_security.h"
+
+#define TEST_PAYLOAD        "secured payload"
+#define TEST_PAYLOAD_LEN    (sizeof(TEST_PAYLOAD) - 1)
+
+static ieee802154_sec_context_t sender, receiver;
+static uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+static const uint8_t key[] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                               0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+static const uint8_t sender_long[] = { 0xac, 0xde, 0x48, 0x00,
+                                       0x00, 0x00, 0x00, 0x01 };
+static const uint8_t sender_short[] = { 0x12, 0x34 };
+static const uint8_t receiver_short[] = { 0x56, 0x78 };
+
+static void set_up(void)
+{
+    ieee802154_sec_init(&sender);
+    ieee802154_sec_init(&receiver);
+    ieee802154_sec_set_key(&sender, IEEE802154_SEC_DEFAULT_KEY_INDEX, key,
+                           sizeof(key));
+    ieee802154_sec_set_key(&receiver, IEEE802154_SEC_DEFAULT_KEY_INDEX, key,
+                           sizeof(key));
+    memset(frame, 0, sizeof(frame));
+}
+
+/* builds a secured frame from sender and returns its length */
+static int _build_frame(const uint8_t *src, size_t src_len)
+{
+    const le_uint16_t pan = { .u16 = 0x0023 };
+    size_t mhr_len = ieee802154_set_frame_hdr(frame, src, src_len,
+                                              receiver_short,
+                                              sizeof(receiver_short), pan, pan,
+                                              IEEE802154_FCF_TYPE_DATA |
+                                              IEEE802154_FCF_SECURITY_EN, 0);
+
+    if (mhr_len == 0) {
+        return -EINVAL;
+    }
+    memcpy(&frame[mhr_len + ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX)],
+           TEST_PAYLOAD, TEST_PAYLOAD_LEN);
+    return ieee802154_sec_encrypt_frame(&sender, frame, mhr_len,
+                                        TEST_PAYLOAD_LEN, sender_long);
+}
+
+static void test_ieee802154_sec_lengths(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_NONE));
+    TEST_ASSERT_EQUAL_INT(4, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_MIC_32));
+    TEST_ASSERT_EQUAL_INT(8, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_MIC_64));
+    TEST_ASSERT_EQUAL_INT(16, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_MIC_128));
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_ENC));
+    TEST_ASSERT_EQUAL_INT(4, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_ENC_MIC_32));
+    TEST_ASSERT_EQUAL_INT(8, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_ENC_MIC_64));
+    TEST_ASSERT_EQUAL_INT(16, ieee802154_sec_mic_len(IEEE802154_SEC_LEVEL_ENC_MIC_128));
+    TEST_ASSERT_EQUAL_INT(5, ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_IMPLICIT));
+    TEST_ASSERT_EQUAL_INT(6, ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_INDEX));
+    TEST_ASSERT_EQUAL_INT(10, ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_SRC4_INDEX));
+    TEST_ASSERT_EQUAL_INT(14, ieee802154_sec_aux_hdr_len(IEEE802154_SEC_KEY_ID_SRC8_INDEX));
+}
+
+static void test_ieee802154_sec_set_key(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_sec_set_key(&sender, 2, key,
+                                                          sizeof(key) - 1));
+    /* replacing a key takes no new entry */
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_set_key(&sender,
+                                                    IEEE802154_SEC_DEFAULT_KEY_INDEX,
+                                                    key, sizeof(key)));
+    for (unsigned i = 1; i < IEEE802154_SEC_KEYS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_set_key(&sender,
+                                                        IEEE802154_SEC_DEFAULT_KEY_INDEX + i,
+                                                        key, sizeof(key)));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, ieee802154_sec_set_key(&sender, 0, key,
+                                                          sizeof(key)));
+}
+
+static void test_ieee802154_sec_encrypt_decrypt(void)
+{
+    uint8_t copy[IEEE802154_FRAME_LEN_MAX];
+    size_t hdr_len = 0;
+    int len = _build_frame(sender_long, sizeof(sender_long));
+
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(1, sender.frame_counter);
+    TEST_ASSERT_EQUAL_INT(ieee802154_get_frame_hdr_len(frame) +
+                          ieee802154_sec_overhead(&sender) + TEST_PAYLOAD_LEN,
+                          len);
+    TEST_ASSERT(memcmp(&frame[len - TEST_PAYLOAD_LEN - 8], TEST_PAYLOAD,
+                       TEST_PAYLOAD_LEN) != 0);
+    memcpy(copy, frame, len);
+
+    TEST_ASSERT_EQUAL_INT(TEST_PAYLOAD_LEN,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+    TEST_ASSERT_EQUAL_INT(len - TEST_PAYLOAD_LEN - 8, hdr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&frame[hdr_len], TEST_PAYLOAD,
+                                    TEST_PAYLOAD_LEN));
+    /* the sender was added to the device table */
+    TEST_ASSERT(receiver.devs[0].valid);
+    TEST_ASSERT_EQUAL_INT(1, receiver.devs[0].frame_counter);
+
+    /* the same frame again */
+    memcpy(frame, copy, len);
+    TEST_ASSERT_EQUAL_INT(-EALREADY,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+}
+
+static void test_ieee802154_sec_decrypt_tampered(void)
+{
+    size_t hdr_len;
+    int len = _build_frame(sender_long, sizeof(sender_long));
+
+    TEST_ASSERT(len > 0);
+    /* the sequence number is authenticated */
+    frame[2] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+    TEST_ASSERT(!receiver.devs[0].valid);
+}
+
+static void test_ieee802154_sec_decrypt_unknown_key(void)
+{
+    size_t hdr_len;
+    int len;
+
+    sender.key_index = IEEE802154_SEC_DEFAULT_KEY_INDEX + 1;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _build_frame(sender_long,
+                                                sizeof(sender_long)));
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_set_key(&sender, sender.key_index,
+                                                    key, sizeof(key)));
+    len = _build_frame(sender_long, sizeof(sender_long));
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+}
+
+static void test_ieee802154_sec_decrypt_short_src(void)
+{
+    uint8_t copy[IEEE802154_FRAME_LEN_MAX];
+    size_t hdr_len;
+    int len = _build_frame(sender_short, sizeof(sender_short));
+
+    TEST_ASSERT(len > 0);
+    memcpy(copy, frame, len);
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_add_dev(&receiver, sender_long,
+                                                    sender_short));
+    TEST_ASSERT_EQUAL_INT(TEST_PAYLOAD_LEN,
+                          ieee802154_sec_decrypt_frame(&receiver, copy, len,
+                                                       &hdr_len));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&copy[hdr_len], TEST_PAYLOAD,
+                                    TEST_PAYLOAD_LEN));
+}
+
+static void test_ieee802154_sec_mic_only(void)
+{
+    size_t hdr_len;
+    int len;
+
+    sender.level = IEEE802154_SEC_LEVEL_MIC_32;
+    len = _build_frame(sender_long, sizeof(sender_long));
+    TEST_ASSERT(len > 0);
+    /* the payload is sent as is */
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&frame[len - TEST_PAYLOAD_LEN - 4],
+                                    TEST_PAYLOAD, TEST_PAYLOAD_LEN));
+    TEST_ASSERT_EQUAL_INT(TEST_PAYLOAD_LEN,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+    /* and authenticated */
+    len = _build_frame(sender_long, sizeof(sender_long));
+    frame[len - 5] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          ieee802154_sec_decrypt_frame(&receiver, frame, len,
+                                                       &hdr_len));
+}
+
+static void test_ieee802154_sec_encrypt_too_long(void)
+{
+    size_t mhr_len = 9;
+
+    TEST_ASSERT_EQUAL_INT(-EMSGSIZE,
+                          ieee802154_sec_encrypt_frame(&sender, frame, mhr_len,
+                                                       IEEE802154_FRAME_LEN_MAX,
+                                                       sender_long));
+    sender.frame_counter = UINT32_MAX;
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, _build_frame(sender_long,
+                                                   sizeof(sender_long)));
+}
+
+Test *tests_ieee802154_security_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ieee802154_sec_lengths),
+        new_TestFixture(test_ieee802154_sec_set_key),
+        new_TestFixture(test_ieee802154_sec_encrypt_decrypt),
+        new_TestFixture(test_ieee802154_sec_decrypt_tampered),
+        new_TestFixture(test_ieee802154_sec_decrypt_unknown_key),
+        new_TestFixture(test_ieee802154_sec_decrypt_short_src),
+        new_TestFixture(test_ieee802154_sec_mic_only),
+        new_TestFixture(test_ieee802154_sec_encrypt_too_long),
+    };
+
+    EMB_UNIT_TESTCALLER(ieee802154_security_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ieee802154_security_tests;
+}
+
+void tests_ieee802154_security(void)
+{
+    TESTS_RUN(tests_ieee802154_security_tests());
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,76 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* IPv6 pseudo header and ICMPv6 payload of test_inet_csum__ipv6_pseudo_hdr */
+    static const uint8_t data[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+        0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x3a,
+        0x86, 0x00, 0xab, 0x32, 0x40, 0x58, 0x07, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x04, 0x40, 0xc0, 0x00, 0x00, 0x00, 0x1e,
+        0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x02, 0x18, 0x3d, 0xdb, 0xa4, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x58, 0x6d, 0x8f, 0x56, 0x30, 0x09
+    };
+    uint32_t buf[(sizeof(data) / sizeof(uint32_t)) + 1];
+
+    /* result must not depend on the alignment of the buffer */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        uint8_t *ptr = ((uint8_t *)buf) + offset;
+
+        memcpy(ptr, data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, ptr, sizeof(data)));
+    }
+}
+
+static void test_inet_csum__slices(void)
+{
+    static const uint8_t data[] = {
+        0x50, 0x02, 0x00, 0x01, 0xb4, 0x74, 0x65, 0x73,
+        0x74, 0x10, 0xff, 0x61,
+    };
+    uint16_t expected = inet_csum(0, data, sizeof(data));
+
+    /* splitting the domain at any point must not change the result */
+    for (unsigned i = 0; i <= sizeof(data); i++) {
+        uint16_t sum = inet_csum_slice(0, data, i, 0);
+
+        sum = inet_csum_slice(sum, &data[i], sizeof(data) - i, i);
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
+static void test_inet_csum__update_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update(0xdd2f, 0x5555, 0x3285));
+}
+
+static void test_inet_csum__update(void)
+{
+    /* IPv4 header of test_inet_csum__calculate_csum with checksum */
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0xb8, 0x61, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+    uint16_t csum;
+
+    /* decrement TTL */
+    csum = inet_csum_update(0xb861, 0x4011, 0x3f11);
+    data[8] = 0x3f;
+    data[10] = csum >> 8;
+    data[11] = csum & 0xff;
+    /* result unnormalized: take 1's-complement of 0 */
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, data, sizeof(data)));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +247,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__slices),
+        new_TestFixture(test_inet_csum__update_rfc_example),
+        new_TestFixture(test_inet_csum__update),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
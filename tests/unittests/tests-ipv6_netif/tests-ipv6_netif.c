@@ -277,6 +277,27 @@ static void test_ipv6_netif_find_by_addr__success(void)
     TEST_ASSERT_EQUAL_INT(true, ipv6_addr_equal(out, &addr));
 }
 
+static void test_ipv6_netif_find_by_addr__other_iface(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t all_nodes = IPV6_ADDR_ALL_NODES_LINK_LOCAL;
+    ipv6_addr_t *out = NULL;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface */
+    gnrc_ipv6_netif_add(OTHER_TEST_NETIF);
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(OTHER_TEST_NETIF, &addr,
+                                                  DEFAULT_TEST_PREFIX_LEN, 0));
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(&out, &addr));
+    TEST_ASSERT_EQUAL_INT(true, ipv6_addr_equal(out, &addr));
+
+    /* the address is gone with its interface, the shared one is not */
+    gnrc_ipv6_netif_remove(OTHER_TEST_NETIF);
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF, gnrc_ipv6_netif_find_by_addr(&out, &addr));
+    TEST_ASSERT_NULL(out);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(NULL, &all_nodes));
+}
+
 static void test_ipv6_netif_find_addr__no_iface(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -551,6 +572,7 @@ Test *tests_ipv6_netif_tests(void)
         new_TestFixture(test_ipv6_netif_reset_addr__success),
         new_TestFixture(test_ipv6_netif_find_by_addr__empty),
         new_TestFixture(test_ipv6_netif_find_by_addr__success),
+        new_TestFixture(test_ipv6_netif_find_by_addr__other_iface),
         new_TestFixture(test_ipv6_netif_find_addr__no_iface),
         new_TestFixture(test_ipv6_netif_find_addr__wrong_iface),
         new_TestFixture(test_ipv6_netif_find_addr__wrong_addr),
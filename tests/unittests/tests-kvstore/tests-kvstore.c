@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "kvstore.h"
+#include "mtd.h"
+
+#include "tests-kvstore.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (2U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+/* RAM-based mtd, programming only clears bits like NOR flash */
+static uint8_t _memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned _erases[SECTOR_COUNT];
+/* number of bytes written before writes fail, to simulate a power failure */
+static int _write_budget;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, &_memory[addr], size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((addr + size > sizeof(_memory)) ||
+        ((addr % PAGE_SIZE) + size > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        if (_write_budget == 0) {
+            return -EIO;
+        }
+        if (_write_budget > 0) {
+            _write_budget--;
+        }
+        _memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((addr % SECTOR_SIZE != 0) || (size % SECTOR_SIZE != 0) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(&_memory[addr], 0xff, size);
+    for (uint32_t i = 0; i < size / SECTOR_SIZE; i++) {
+        _erases[(addr / SECTOR_SIZE) + i]++;
+    }
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = NULL,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static kvstore_t _kv;
+
+static void set_up(void)
+{
+    memset(_memory, 0xff, sizeof(_memory));
+    memset(_erases, 0, sizeof(_erases));
+    _write_budget = -1;
+    TEST_ASSERT_EQUAL_INT(0, kvstore_init(&_kv, &_dev));
+}
+
+static void _remount(void)
+{
+    memset(&_kv, 0, sizeof(_kv));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_init(&_kv, &_dev));
+}
+
+static void test_kvstore_set_get(void)
+{
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "foo", "bar", 4));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "fo", "baz!", 5));
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("bar", (char *)buf);
+    TEST_ASSERT_EQUAL_INT(5, kvstore_get(&_kv, "fo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("baz!", (char *)buf);
+
+    /* the length of the value is returned even if it is truncated */
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(5, kvstore_get(&_kv, "fo", buf, 2));
+    TEST_ASSERT_EQUAL_STRING("ba", (char *)buf);
+
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "foo", "qux1", 5));
+    TEST_ASSERT_EQUAL_INT(5, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("qux1", (char *)buf);
+}
+
+static void test_kvstore_set_invalid(void)
+{
+    static const uint8_t big[SECTOR_SIZE] = { 0 };
+    char key[KVSTORE_KEY_LEN_MAX + 2];
+
+    memset(key, 'k', sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, "", "x", 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, key, "x", 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, "big", big, sizeof(big)));
+}
+
+static void test_kvstore_delete(void)
+{
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_delete(&_kv, "foo"));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "foo", "bar", 4));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "baz", "qux", 4));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_delete(&_kv, "foo"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "baz", buf, sizeof(buf)));
+
+    _remount();
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "baz", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("qux", (char *)buf);
+}
+
+static void test_kvstore_index_full(void)
+{
+    char key[12];
+
+    for (unsigned i = 0; i < KVSTORE_INDEX_SIZE - 1; i++) {
+        sprintf(key, "k%u", i);
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, NULL, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, kvstore_set(&_kv, "new", NULL, 0));
+    /* existing keys can still be changed */
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "k0", "x", 1));
+
+    /* removing keys shifts colliding entries back, all stay reachable */
+    for (unsigned i = 0; i < KVSTORE_INDEX_SIZE - 1; i += 2) {
+        sprintf(key, "k%u", i);
+        TEST_ASSERT_EQUAL_INT(0, kvstore_delete(&_kv, key));
+    }
+    for (unsigned i = 0; i < KVSTORE_INDEX_SIZE - 1; i++) {
+        sprintf(key, "k%u", i);
+        TEST_ASSERT_EQUAL_INT((i % 2) ? 0 : -ENOENT,
+                              kvstore_get(&_kv, key, NULL, 0));
+    }
+}
+
+static void test_kvstore_wear_leveling(void)
+{
+    char buf[4];
+    uint32_t i;
+
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "const", "abc", 4));
+    for (i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "cnt", &i, sizeof(i)));
+    }
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "cnt", &i, sizeof(i)));
+    TEST_ASSERT_EQUAL_INT(199, i);
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "const", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("abc", (char *)buf);
+
+    /* the sectors were used in turn */
+    for (unsigned s = 1; s < SECTOR_COUNT; s++) {
+        TEST_ASSERT(_erases[s] + 1 >= _erases[0]);
+        TEST_ASSERT(_erases[0] + 1 >= _erases[s]);
+    }
+
+    _remount();
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "cnt", &i, sizeof(i)));
+    TEST_ASSERT_EQUAL_INT(199, i);
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "const", buf, sizeof(buf)));
+}
+
+static void test_kvstore_full(void)
+{
+    static const uint8_t val[SECTOR_SIZE / 2] = { 0 };
+    char key[12];
+    int res = 0;
+    unsigned i;
+
+    for (i = 0; res == 0; i++) {
+        sprintf(key, "k%u", i);
+        res = kvstore_set(&_kv, key, val, sizeof(val));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, res);
+    /* all keys written before stay readable */
+    for (unsigned j = 0; j < i - 1; j++) {
+        sprintf(key, "k%u", j);
+        TEST_ASSERT_EQUAL_INT(sizeof(val), kvstore_get(&_kv, key, NULL, 0));
+    }
+    /* formatting makes room again */
+    TEST_ASSERT_EQUAL_INT(0, kvstore_format(&_kv));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "k0", NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "k0", val, sizeof(val)));
+}
+
+static void test_kvstore_power_failure(void)
+{
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "foo", "old", 4));
+    /* the record is torn in the middle of the value */
+    _write_budget = 8;
+    TEST_ASSERT_EQUAL_INT(-EIO, kvstore_set(&_kv, "foo", "new", 4));
+    _write_budget = -1;
+
+    _remount();
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("old", (char *)buf);
+    /* writing continues in the next sector */
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "foo", "new", 4));
+    _remount();
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "foo", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("new", (char *)buf);
+}
+
+static void test_kvstore_compact(void)
+{
+    uint32_t i;
+
+    /* fill all but one sector with outdated values */
+    for (i = 0; _kv.active != SECTOR_COUNT - 2; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "cnt", &i, sizeof(i)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _erases[SECTOR_COUNT - 1]);
+    TEST_ASSERT_EQUAL_INT(0, kvstore_compact(&_kv));
+    /* the oldest sector was released without starting a new one */
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT - 2, _kv.active);
+    TEST_ASSERT_EQUAL_INT(0, _erases[SECTOR_COUNT - 1]);
+    TEST_ASSERT_EQUAL_INT(0, kvstore_compact(&_kv));
+
+    _remount();
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "cnt", &i, sizeof(i)));
+}
+
+Test *tests_kvstore_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_kvstore_set_get),
+        new_TestFixture(test_kvstore_set_invalid),
+        new_TestFixture(test_kvstore_delete),
+        new_TestFixture(test_kvstore_index_full),
+        new_TestFixture(test_kvstore_wear_leveling),
+        new_TestFixture(test_kvstore_full),
+        new_TestFixture(test_kvstore_power_failure),
+        new_TestFixture(test_kvstore_compact),
+    };
+
+    EMB_UNIT_TESTCALLER(kvstore_tests, set_up, NULL, fixtures);
+
+    return (Test *)&kvstore_tests;
+}
+
+void tests_kvstore(void)
+{
+    TESTS_RUN(tests_kvstore_tests());
+}
+/** @} */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/l2filter.h"
+
+#include "tests-l2filter.h"
+
+#ifdef MODULE_L2FILTER_WHITELIST
+#define IN_LIST(list, addr, len)    (l2filter_pass(list, addr, len))
+#else
+#define IN_LIST(list, addr, len)    (!l2filter_pass(list, addr, len))
+#endif
+
+static l2filter_t list[L2FILTER_LISTSIZE];
+
+static void set_up(void)
+{
+    memset(list, 0, sizeof(list));
+}
+
+static void _addr(uint8_t *addr, unsigned i)
+{
+    memset(addr, 0, L2FILTER_ADDR_MAXLEN);
+    addr[L2FILTER_ADDR_MAXLEN - 1] = (uint8_t)i;
+    addr[L2FILTER_ADDR_MAXLEN - 2] = (uint8_t)(i >> 8);
+}
+
+static void test_l2filter_add(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    _addr(addr, 1);
+    TEST_ASSERT(!IN_LIST(list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_add(list, addr, sizeof(addr)));
+    TEST_ASSERT(IN_LIST(list, addr, sizeof(addr)));
+    /* the length is part of the address */
+    TEST_ASSERT(!IN_LIST(list, addr, 2));
+    TEST_ASSERT(!IN_LIST(list, &addr[L2FILTER_ADDR_MAXLEN - 2], 2));
+}
+
+static void test_l2filter_add__full(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_add(list, addr, sizeof(addr)));
+    }
+    _addr(addr, L2FILTER_LISTSIZE);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, l2filter_add(list, addr, sizeof(addr)));
+    TEST_ASSERT(!IN_LIST(list, addr, sizeof(addr)));
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT(IN_LIST(list, addr, sizeof(addr)));
+    }
+}
+
+static void test_l2filter_rm__not_found(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    _addr(addr, 1);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, l2filter_rm(list, addr, sizeof(addr)));
+}
+
+static void test_l2filter_rm(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    /* remove every entry of full lists in every order of colliding entries,
+     * all others must stay reachable */
+    for (unsigned rm = 0; rm < L2FILTER_LISTSIZE; rm++) {
+        memset(list, 0, sizeof(list));
+        for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+            _addr(addr, i);
+            TEST_ASSERT_EQUAL_INT(0, l2filter_add(list, addr, sizeof(addr)));
+        }
+        _addr(addr, rm);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_rm(list, addr, sizeof(addr)));
+        TEST_ASSERT(!IN_LIST(list, addr, sizeof(addr)));
+        for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+            _addr(addr, i);
+            TEST_ASSERT((i == rm) || IN_LIST(list, addr, sizeof(addr)));
+        }
+        /* the slot can be used again */
+        _addr(addr, L2FILTER_LISTSIZE);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_add(list, addr, sizeof(addr)));
+        TEST_ASSERT(IN_LIST(list, addr, sizeof(addr)));
+    }
+}
+
+static void test_l2filter_rm__all(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_add(list, addr, sizeof(addr)));
+    }
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_rm(list, addr, sizeof(addr)));
+        for (unsigned j = i + 1; j < L2FILTER_LISTSIZE; j++) {
+            _addr(addr, j);
+            TEST_ASSERT(IN_LIST(list, addr, sizeof(addr)));
+        }
+    }
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, list[i].addr_len);
+    }
+}
+
+Test *tests_l2filter_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_l2filter_add),
+        new_TestFixture(test_l2filter_add__full),
+        new_TestFixture(test_l2filter_rm__not_found),
+        new_TestFixture(test_l2filter_rm),
+        new_TestFixture(test_l2filter_rm__all),
+    };
+
+    EMB_UNIT_TESTCALLER(l2filter_tests, set_up, NULL, fixtures);
+
+    return (Test *)&l2filter_tests;
+}
+
+void tests_l2filter(void)
+{
+    TESTS_RUN(tests_l2filter_tests());
+}
+/** @} */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "memarray.h"
+#include "tests-memarray.h"
+
+#define NUMOF   (4U)
+
+typedef struct {
+    void *next;
+    uint32_t value;
+} element_t;
+
+static element_t _elements[NUMOF];
+static memarray_t _pool;
+
+static void set_up(void)
+{
+    memarray_init(&_pool, _elements, sizeof(element_t), NUMOF);
+}
+
+static void test_memarray_alloc_all(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        TEST_ASSERT(memarray_alloc(&_pool) == &_elements[i]);
+    }
+    TEST_ASSERT_NULL(memarray_alloc(&_pool));
+    TEST_ASSERT_EQUAL_INT(0, memarray_available(&_pool));
+    TEST_ASSERT_EQUAL_INT(NUMOF, _pool.used_max);
+    TEST_ASSERT_EQUAL_INT(1, _pool.failed);
+}
+
+static void test_memarray_free_realloc(void)
+{
+    element_t *a = memarray_alloc(&_pool);
+    element_t *b = memarray_alloc(&_pool);
+
+    a->value = 0xdeadbeef;
+    b->value = 0xcafe;
+    memarray_free(&_pool, a);
+    TEST_ASSERT_EQUAL_INT(NUMOF - 1, memarray_available(&_pool));
+    /* the last freed element is handed out first */
+    TEST_ASSERT(memarray_alloc(&_pool) == a);
+    TEST_ASSERT_EQUAL_INT(0xcafe, b->value);
+    memarray_free(&_pool, b);
+    memarray_free(&_pool, a);
+    TEST_ASSERT_EQUAL_INT(NUMOF, memarray_available(&_pool));
+    TEST_ASSERT_EQUAL_INT(2, _pool.used_max);
+    TEST_ASSERT_EQUAL_INT(0, _pool.failed);
+}
+
+Test *tests_memarray_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_memarray_alloc_all),
+        new_TestFixture(test_memarray_free_realloc),
+    };
+
+    EMB_UNIT_TESTCALLER(memarray_tests, set_up, NULL, fixtures);
+
+    return (Test *)&memarray_tests;
+}
+
+void tests_memarray(void)
+{
+    TESTS_RUN(tests_memarray_tests());
+}
+/** @} */
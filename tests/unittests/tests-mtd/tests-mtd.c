@@ -19,6 +19,10 @@
 #include "mtd.h"
 #include "board.h"
 
+#if MODULE_MTD_CACHE
+#include "mtd_cache.h"
+#endif
+
 #if MODULE_VFS
 #include <fcntl.h>
 #include <stdio.h>
@@ -41,6 +45,8 @@
 #endif
 
 static uint8_t dummy_memory[PAGE_PER_SECTOR * PAGE_SIZE * SECTOR_COUNT];
+/* number of driver calls, to check what the cache saves */
+static unsigned _reads, _writes;
 
 static int init(mtd_dev_t *dev)
 {
@@ -58,6 +64,7 @@ static int read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
         return -EOVERFLOW;
     }
     memcpy(buff, dummy_memory + addr, size);
+    _reads++;
 
     return size;
 }
@@ -73,6 +80,7 @@ static int write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
         return -EOVERFLOW;
     }
     memcpy(dummy_memory + addr, buff, size);
+    _writes++;
 
     return size;
 }
@@ -102,12 +110,21 @@ static int power(mtd_dev_t *dev, enum mtd_power_state power)
     return 0;
 }
 
+static int mmap(mtd_dev_t *dev, const void **addr)
+{
+    (void)dev;
+
+    *addr = dummy_memory;
+    return 0;
+}
+
 static const mtd_desc_t driver = {
     .init = init,
     .read = read,
     .write = write,
     .erase = erase,
     .power = power,
+    .mmap = mmap,
 };
 
 static mtd_dev_t _dev = {
@@ -119,6 +136,14 @@ static mtd_dev_t _dev = {
 
 static mtd_dev_t *dev = (mtd_dev_t*) &_dev;
 
+#if MODULE_MTD_CACHE
+static mtd_cache_t _cache = {
+    .base = { .driver = &mtd_cache_driver },
+    .parent = &_dev,
+    .read_ahead = 1,
+};
+#endif
+
 #endif /* MTD_0 */
 
 static void setup_teardown(void)
@@ -239,6 +264,57 @@ static void test_mtd_write_read_flash(void)
 }
 #endif
 
+#if MODULE_MTD_CACHE && !defined(MTD_0)
+static void test_mtd_cache(void)
+{
+    mtd_dev_t *cdev = &_cache.base;
+    const char buf[] = "ABCD";
+    char buf_read[2 * sizeof(buf)];
+    int ret;
+
+    ret = mtd_init(cdev);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, cdev->page_size);
+
+    /* writes to the same page are written back at once */
+    _writes = 0;
+    ret = mtd_write(cdev, buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    ret = mtd_write(cdev, buf, sizeof(buf), sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(0xff, dummy_memory[0]);
+    ret = mtd_read(cdev, buf_read, 0, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read + sizeof(buf), sizeof(buf)));
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, dummy_memory, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, dummy_memory + sizeof(buf), sizeof(buf)));
+
+    /* reading from a page also loads the next one */
+    _reads = 0;
+    ret = mtd_read(cdev, buf_read, PAGE_SIZE, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    ret = mtd_read(cdev, buf_read, 2 * PAGE_SIZE, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    TEST_ASSERT_EQUAL_INT(2, _reads);
+
+    /* erasing drops modifications of the erased pages */
+    ret = mtd_write(cdev, buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    ret = mtd_erase(cdev, 0, cdev->pages_per_sector * cdev->page_size);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_read(cdev, buf_read, 0, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    TEST_ASSERT_EQUAL_INT(0xff, (uint8_t)buf_read[0]);
+}
+#endif
+
 #if MODULE_VFS
 static void test_mtd_vfs(void)
 {
@@ -265,6 +341,18 @@ static void test_mtd_vfs(void)
     ret = vfs_write(fd, buf, sizeof(buf));
     /* Attempted to write past the device memory */
     TEST_ASSERT(ret < 0);
+
+#ifndef MTD_0
+    const void *addr;
+    size_t len;
+    ret = vfs_lseek(fd, sizeof(buf_empty), SEEK_SET);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_empty), ret);
+    ret = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT(addr == &dummy_memory[sizeof(buf_empty)]);
+    TEST_ASSERT_EQUAL_INT(sizeof(dummy_memory) - sizeof(buf_empty), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, addr, sizeof(buf)));
+#endif
 }
 #endif
 
@@ -278,6 +366,9 @@ Test *tests_mtd_tests(void)
 #ifdef MTD_0
         new_TestFixture(test_mtd_write_read_flash),
 #endif
+#if MODULE_MTD_CACHE && !defined(MTD_0)
+        new_TestFixture(test_mtd_cache),
+#endif
 #if MODULE_VFS
         new_TestFixture(test_mtd_vfs),
 #endif
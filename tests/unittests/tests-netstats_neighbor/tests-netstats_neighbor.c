@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/netstats/neighbor.h"
+
+#include "tests-netstats_neighbor.h"
+
+static netstats_nb_table_t table;
+static uint8_t l2addr[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+static void set_up(void)
+{
+    memset(&table, 0, sizeof(table));
+}
+
+static void test_netstats_nb_get__empty(void)
+{
+    TEST_ASSERT_NULL(netstats_nb_get(&table, l2addr, sizeof(l2addr)));
+}
+
+static void test_netstats_nb_record(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_count);
+    /* addresses of other length are other neighbors */
+    TEST_ASSERT_NULL(netstats_nb_get(&table, l2addr, 2));
+}
+
+static void test_netstats_nb_update_tx__success(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    netstats_nb_update_tx(&table, NETSTATS_NB_SUCCESS);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_failed);
+    TEST_ASSERT(nb->etx < NETSTATS_NB_ETX_INIT);
+    /* only the recorded frame is counted */
+    netstats_nb_update_tx(&table, NETSTATS_NB_SUCCESS);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    /* a perfect link converges to an ETX of 1 */
+    for (unsigned i = 0; i < 100; i++) {
+        netstats_nb_record(&table, l2addr, sizeof(l2addr));
+        netstats_nb_update_tx(&table, NETSTATS_NB_SUCCESS);
+    }
+    TEST_ASSERT(nb->etx >= NETSTATS_NB_ETX_DIVISOR);
+    TEST_ASSERT(nb->etx < (NETSTATS_NB_ETX_DIVISOR + 8));
+}
+
+static void test_netstats_nb_update_tx__noack(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    netstats_nb_update_tx(&table, NETSTATS_NB_NOACK);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_failed);
+    TEST_ASSERT(nb->etx > NETSTATS_NB_ETX_INIT);
+    TEST_ASSERT(nb->etx < NETSTATS_NB_ETX_NOACK_PENALTY);
+}
+
+static void test_netstats_nb_update_tx__busy(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    netstats_nb_update_tx(&table, NETSTATS_NB_BUSY);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+}
+
+static void test_netstats_nb_update_tx__multicast(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    netstats_nb_record(&table, NULL, 0);
+    netstats_nb_update_tx(&table, NETSTATS_NB_NOACK);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+}
+
+static void test_netstats_nb_record__full(void)
+{
+    uint8_t addr[sizeof(l2addr)];
+    unsigned known = 0;
+
+    memcpy(addr, l2addr, sizeof(addr));
+    for (unsigned i = 0; i <= NETSTATS_NB_SIZE; i++) {
+        addr[0] = i;
+        netstats_nb_record(&table, addr, sizeof(addr));
+    }
+    /* the newest one replaced another one */
+    TEST_ASSERT_NOT_NULL(netstats_nb_get(&table, addr, sizeof(addr)));
+    for (unsigned i = 0; i <= NETSTATS_NB_SIZE; i++) {
+        addr[0] = i;
+        if (netstats_nb_get(&table, addr, sizeof(addr)) != NULL) {
+            known++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_SIZE, known);
+}
+
+static void test_netstats_nb_update_rx(void)
+{
+    const netstats_nb_t *nb;
+
+    netstats_nb_update_rx(&table, l2addr, sizeof(l2addr), 200, 100);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(1, nb->rx_count);
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+    /* the first frame sets the averages */
+    TEST_ASSERT_EQUAL_INT(200, nb->rssi);
+    TEST_ASSERT_EQUAL_INT(100, nb->lqi);
+    netstats_nb_update_rx(&table, l2addr, sizeof(l2addr), 100, 200);
+    TEST_ASSERT_EQUAL_INT(2, nb->rx_count);
+    TEST_ASSERT(nb->rssi < 200);
+    TEST_ASSERT(nb->rssi > 100);
+    TEST_ASSERT(nb->lqi > 100);
+    TEST_ASSERT(nb->lqi < 200);
+    /* a constant link converges */
+    for (unsigned i = 0; i < 100; i++) {
+        netstats_nb_update_rx(&table, l2addr, sizeof(l2addr), 100, 200);
+    }
+    TEST_ASSERT_EQUAL_INT(100, nb->rssi);
+    TEST_ASSERT_EQUAL_INT(200, nb->lqi);
+}
+
+static void test_netstats_nb_update_rx__full(void)
+{
+    uint8_t addr[sizeof(l2addr)];
+    const netstats_nb_t *nb;
+
+    memcpy(addr, l2addr, sizeof(addr));
+    netstats_nb_record(&table, l2addr, sizeof(l2addr));
+    for (unsigned i = 1; i <= (2 * NETSTATS_NB_SIZE); i++) {
+        addr[0] = l2addr[0] + i;
+        netstats_nb_update_rx(&table, addr, sizeof(addr), 0, 0);
+    }
+    TEST_ASSERT_NOT_NULL(netstats_nb_get(&table, addr, sizeof(addr)));
+    /* the neighbor a frame is sent to stays */
+    netstats_nb_update_tx(&table, NETSTATS_NB_SUCCESS);
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&table, l2addr, sizeof(l2addr))));
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(0, nb->rx_count);
+}
+
+Test *tests_netstats_neighbor_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netstats_nb_get__empty),
+        new_TestFixture(test_netstats_nb_record),
+        new_TestFixture(test_netstats_nb_update_tx__success),
+        new_TestFixture(test_netstats_nb_update_tx__noack),
+        new_TestFixture(test_netstats_nb_update_tx__busy),
+        new_TestFixture(test_netstats_nb_update_tx__multicast),
+        new_TestFixture(test_netstats_nb_record__full),
+        new_TestFixture(test_netstats_nb_update_rx),
+        new_TestFixture(test_netstats_nb_update_rx__full),
+    };
+
+    EMB_UNIT_TESTCALLER(netstats_neighbor_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netstats_neighbor_tests;
+}
+
+void tests_netstats_neighbor(void)
+{
+    TESTS_RUN(tests_netstats_neighbor_tests());
+}
+/** @} */
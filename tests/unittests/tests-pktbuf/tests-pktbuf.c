@@ -759,6 +759,57 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_start_write_hdrs__pkt_users_2(void)
+{
+    gnrc_pktsnip_t *payload, *hdr, *pkt, *pkt_copy;
+
+    payload = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                              GNRC_NETTYPE_UNDEF);
+    hdr = gnrc_pktbuf_add(payload, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_TEST);
+    pkt = gnrc_pktbuf_add(hdr, TEST_STRING4, sizeof(TEST_STRING4),
+                          GNRC_NETTYPE_TEST);
+    gnrc_pktbuf_hold(pkt, 1);
+
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write_hdrs(pkt)));
+    TEST_ASSERT(pkt != pkt_copy);
+    TEST_ASSERT(hdr != pkt_copy->next);
+    TEST_ASSERT(payload == pkt_copy->next->next);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->users);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->next->users);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT_EQUAL_INT(1, hdr->users);
+    TEST_ASSERT_EQUAL_INT(2, payload->users);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt_copy->next->data);
+
+    gnrc_pktbuf_release(pkt_copy);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend_shared(void)
+{
+    gnrc_pktsnip_t *payload, *hdr1, *hdr2;
+
+    payload = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                              GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL((hdr1 = gnrc_pktbuf_prepend_shared(payload, TEST_STRING4,
+                                                            sizeof(TEST_STRING4),
+                                                            GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_NOT_NULL((hdr2 = gnrc_pktbuf_prepend_shared(payload, TEST_STRING8,
+                                                            sizeof(TEST_STRING8),
+                                                            GNRC_NETTYPE_TEST)));
+    TEST_ASSERT(payload == hdr1->next);
+    TEST_ASSERT(payload == hdr2->next);
+    TEST_ASSERT_EQUAL_INT(3, payload->users);
+
+    gnrc_pktbuf_release(hdr1);
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT_EQUAL_INT(1, payload->users);
+    gnrc_pktbuf_release(payload);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_get_iovec__1_elem(void)
 {
     struct iovec *vec;
@@ -855,6 +906,8 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
+        new_TestFixture(test_pktbuf_start_write_hdrs__pkt_users_2),
+        new_TestFixture(test_pktbuf_prepend_shared),
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
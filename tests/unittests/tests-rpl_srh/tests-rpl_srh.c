@@ -11,6 +11,7 @@
  *
  * @file
  */
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
@@ -18,6 +19,7 @@
 #include "net/ipv6/addr.h"
 #include "net/ipv6/ext.h"
 #include "net/ipv6/hdr.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/rpl/srh.h"
 
 #include "unittests-constants.h"
@@ -36,6 +38,11 @@
                                0x00, 0x00, 0x00, 0x00, \
                                0x00, 0x00, 0x00, 0x03 }}
 
+#define IPV6_ADDR3          {{ 0x20, 0x01, 0xab, 0xce, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x04 }}
+
 #define IPV6_ADDR1_ELIDED   { 0x00, 0x00, 0x02 }
 #define IPV6_ADDR2_ELIDED   { 0x00, 0x00, 0x03 }
 #define IPV6_ELIDED_PREFIX  (13)
@@ -105,14 +112,145 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void set_up(void)
+{
+    gnrc_rpl_srh_table_flush();
+}
+
+/* root -> IPV6_ADDR1 -> IPV6_ADDR2 -> IPV6_DST */
+static void _add_path(void)
+{
+    ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&a1, NULL, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&a2, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&dst, &a2, 60));
+}
+
+static void test_rpl_srh_build__unknown(void)
+{
+    ipv6_addr_t dst = IPV6_DST, first_hop;
+
+    _add_path();
+    gnrc_rpl_srh_table_flush();
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&dst, &first_hop));
+}
+
+static void test_rpl_srh_build__child_of_root(void)
+{
+    ipv6_addr_t a1 = IPV6_ADDR1, first_hop;
+
+    _add_path();
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&a1, &first_hop));
+}
+
+static void test_rpl_srh_build__path(void)
+{
+    ipv6_hdr_t hdr;
+    gnrc_pktsnip_t *pkt;
+    gnrc_rpl_srh_t *srh;
+    ipv6_addr_t dst = IPV6_DST, expected1 = IPV6_ADDR1, expected2 = IPV6_ADDR2;
+
+    _add_path();
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_rpl_srh_build(&dst, &hdr.dst)));
+    srh = pkt->data;
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected1));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_SRH_TYPE, srh->type);
+    TEST_ASSERT_EQUAL_INT(2, srh->seg_left);
+    /* all addresses share 15 bytes: 1 byte each, padded to 8 bytes */
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 15, srh->compr);
+    TEST_ASSERT_EQUAL_INT(6 << 4, srh->pad_resv);
+    TEST_ASSERT_EQUAL_INT(1, srh->len);
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 8, pkt->size);
+
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &dst));
+    TEST_ASSERT_EQUAL_INT(0, srh->seg_left);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_rpl_srh_build__other_prefix(void)
+{
+    ipv6_hdr_t hdr;
+    gnrc_pktsnip_t *pkt;
+    gnrc_rpl_srh_t *srh;
+    ipv6_addr_t a1 = IPV6_ADDR1, a3 = IPV6_ADDR3;
+
+    _add_path();
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&a3, &a1, 60));
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_rpl_srh_build(&a3, &hdr.dst)));
+    srh = pkt->data;
+    /* only 2001:ab is shared with the first hop */
+    TEST_ASSERT_EQUAL_INT((3 << 4) | 3, srh->compr);
+    TEST_ASSERT_EQUAL_INT(3 << 4, srh->pad_resv);
+    TEST_ASSERT_EQUAL_INT(2, srh->len);
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &a3));
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_rpl_srh_build__parent_removed(void)
+{
+    gnrc_pktsnip_t *pkt;
+    ipv6_addr_t a2 = IPV6_ADDR2, dst = IPV6_DST, first_hop;
+
+    _add_path();
+    gnrc_rpl_srh_table_remove(&a2);
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&dst, &first_hop));
+    /* until the child announces the parent again */
+    _add_path();
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_rpl_srh_build(&dst, &first_hop)));
+    gnrc_pktbuf_release(pkt);
+    /* a lifetime of 0 removes as well */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&a2, NULL, 0));
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&dst, &first_hop));
+}
+
+static void test_rpl_srh_build__loop(void)
+{
+    ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST, first_hop;
+
+    _add_path();
+    /* IPV6_ADDR1 now announces IPV6_DST as parent */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&a1, &dst, 60));
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&dst, &first_hop));
+    TEST_ASSERT_NULL(gnrc_rpl_srh_build(&a2, &first_hop));
+}
+
+static void test_rpl_srh_table_add__full(void)
+{
+    ipv6_addr_t addr = IPV6_DST;
+
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TABLE_SIZE; i++) {
+        addr.u8[15] = i;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&addr, NULL, 60));
+    }
+    addr.u8[15] = GNRC_RPL_SRH_TABLE_SIZE;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_srh_table_add(&addr, NULL, 60));
+    /* removed entries are reused */
+    addr.u8[15] = 0;
+    gnrc_rpl_srh_table_remove(&addr);
+    addr.u8[15] = GNRC_RPL_SRH_TABLE_SIZE;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_table_add(&addr, NULL, 60));
+}
+
 Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+        new_TestFixture(test_rpl_srh_build__unknown),
+        new_TestFixture(test_rpl_srh_build__child_of_root),
+        new_TestFixture(test_rpl_srh_build__path),
+        new_TestFixture(test_rpl_srh_build__other_prefix),
+        new_TestFixture(test_rpl_srh_build__parent_removed),
+        new_TestFixture(test_rpl_srh_build__loop),
+        new_TestFixture(test_rpl_srh_table_add__full),
     };
 
-    EMB_UNIT_TESTCALLER(rpl_srh_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(rpl_srh_tests, set_up, NULL, fixtures);
 
     return (Test *)&rpl_srh_tests;
 }
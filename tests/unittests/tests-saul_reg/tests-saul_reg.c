@@ -25,15 +25,43 @@
 #include "saul_reg.h"
 #include "tests-saul_reg.h"
 
-static const saul_driver_t s0_dri = { NULL, NULL, SAUL_ACT_SERVO };
-static const saul_driver_t s1_dri = { NULL, NULL, SAUL_SENSE_TEMP };
-static const saul_driver_t s2_dri = { NULL, NULL, SAUL_SENSE_LIGHT };
-static const saul_driver_t s3_dri = { NULL, NULL, SAUL_ACT_LED_RGB };
+static int read_one(const void *dev, phydat_t *res)
+{
+    (void)dev;
+    res->val[0] = 42;
+    return 1;
+}
+
+static int read_notsup(const void *dev, phydat_t *res)
+{
+    (void)dev;
+    (void)res;
+    return -ENOTSUP;
+}
+
+static int fifo_read(const void *dev, phydat_t *res, size_t numof,
+                     uint32_t *period)
+{
+    (void)dev;
+    for (size_t i = 0; i < numof; i++) {
+        res[i].val[0] = i;
+    }
+    *period = 1000;
+    return numof;
+}
+
+static const saul_fifo_t s1_fifo = { NULL, NULL, fifo_read };
 
-static saul_reg_t s0 = { NULL, NULL, "S0", &s0_dri };
-static saul_reg_t s1 = { NULL, NULL, "S1", &s1_dri };
-static saul_reg_t s2 = { NULL, NULL, "S2", &s2_dri };
-static saul_reg_t s3 = { NULL, NULL, "S3", &s3_dri };
+static const saul_driver_t s0_dri = { NULL, NULL, SAUL_ACT_SERVO, NULL };
+static const saul_driver_t s1_dri = { read_one, NULL, SAUL_SENSE_TEMP, &s1_fifo };
+static const saul_driver_t s2_dri = { read_notsup, NULL, SAUL_SENSE_LIGHT, NULL };
+static const saul_driver_t s3_dri = { NULL, NULL, SAUL_ACT_LED_RGB, NULL };
+
+static saul_reg_t s0 = { NULL, NULL, "S0", &s0_dri, NULL };
+static saul_reg_t s1 = { NULL, NULL, "S1", &s1_dri, NULL };
+static saul_reg_t s2 = { NULL, NULL, "S2", &s2_dri, NULL };
+static saul_reg_t s3 = { NULL, NULL, "S3", &s3_dri, NULL };
+static saul_reg_t s4 = { NULL, NULL, "S4", &s1_dri, NULL };
 
 
 static int count(void)
@@ -173,6 +201,101 @@ static void test_reg_rm(void)
     TEST_ASSERT_EQUAL_INT(2, count());
 }
 
+static void test_reg_rm_head(void)
+{
+    int res;
+
+    res = saul_reg_rm(&s0);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(1, count());
+    TEST_ASSERT_EQUAL_STRING("S2", saul_reg->name);
+    TEST_ASSERT_NULL(saul_reg_find_type(SAUL_ACT_SERVO));
+
+    res = saul_reg_rm(&s2);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_NULL(saul_reg);
+    TEST_ASSERT_NULL(saul_reg_find_type(SAUL_SENSE_LIGHT));
+}
+
+static void test_reg_find_type_next(void)
+{
+    saul_reg_t *dev;
+
+    saul_reg_add(&s1);
+    saul_reg_add(&s2);
+    saul_reg_add(&s4);
+
+    dev = saul_reg_find_type(SAUL_SENSE_TEMP);
+    TEST_ASSERT_NOT_NULL(dev);
+    TEST_ASSERT_EQUAL_STRING("S1", dev->name);
+    dev = saul_reg_find_type_next(dev);
+    TEST_ASSERT_NOT_NULL(dev);
+    TEST_ASSERT_EQUAL_STRING("S4", dev->name);
+    TEST_ASSERT_NULL(saul_reg_find_type_next(dev));
+
+    dev = saul_reg_find_type(SAUL_SENSE_LIGHT);
+    TEST_ASSERT_NOT_NULL(dev);
+    TEST_ASSERT_EQUAL_STRING("S2", dev->name);
+    TEST_ASSERT_NULL(saul_reg_find_type_next(dev));
+
+    saul_reg_rm(&s1);
+    dev = saul_reg_find_type(SAUL_SENSE_TEMP);
+    TEST_ASSERT_NOT_NULL(dev);
+    TEST_ASSERT_EQUAL_STRING("S4", dev->name);
+    TEST_ASSERT_NULL(saul_reg_find_type_next(dev));
+}
+
+static void test_reg_read_all(void)
+{
+    saul_reg_data_t data[4];
+    unsigned num;
+
+    /* S2, S4, S1 */
+    saul_reg_add(&s1);
+
+    num = saul_reg_read_all(SAUL_CLASS_ANY, data, 4);
+    TEST_ASSERT_EQUAL_INT(3, num);
+    TEST_ASSERT_EQUAL_STRING("S2", data[0].dev->name);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, data[0].res);
+    TEST_ASSERT_EQUAL_STRING("S4", data[1].dev->name);
+    TEST_ASSERT_EQUAL_INT(1, data[1].res);
+    TEST_ASSERT_EQUAL_INT(42, data[1].data.val[0]);
+    TEST_ASSERT_EQUAL_STRING("S1", data[2].dev->name);
+    TEST_ASSERT_EQUAL_INT(1, data[2].res);
+
+    num = saul_reg_read_all(SAUL_SENSE_TEMP, data, 4);
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT_EQUAL_STRING("S4", data[0].dev->name);
+    TEST_ASSERT_EQUAL_STRING("S1", data[1].dev->name);
+
+    num = saul_reg_read_all(SAUL_SENSE_TEMP, data, 1);
+    TEST_ASSERT_EQUAL_INT(1, num);
+    TEST_ASSERT_EQUAL_STRING("S4", data[0].dev->name);
+
+    num = saul_reg_read_all(SAUL_ACT_MOTOR, data, 4);
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+static void test_reg_read_fifo(void)
+{
+    phydat_t res[2];
+    uint32_t time, period;
+    int num;
+
+    num = saul_reg_read_fifo(&s1, res, 2, &time, &period);
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT_EQUAL_INT(0, res[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(1, res[1].val[0]);
+    TEST_ASSERT_EQUAL_INT(1000, period);
+
+    num = saul_reg_read_fifo(&s2, res, 2, &time, &period);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, num);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, saul_reg_fifo_start(&s2, 1, NULL, NULL));
+
+    num = saul_reg_read_fifo(NULL, res, 2, &time, &period);
+    TEST_ASSERT_EQUAL_INT(-ENODEV, num);
+}
+
 Test *tests_saul_reg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -181,7 +304,11 @@ Test *tests_saul_reg_tests(void)
         new_TestFixture(test_reg_find_nth),
         new_TestFixture(test_reg_find_type),
         new_TestFixture(test_reg_find_name),
-        new_TestFixture(test_reg_rm)
+        new_TestFixture(test_reg_rm),
+        new_TestFixture(test_reg_rm_head),
+        new_TestFixture(test_reg_find_type_next),
+        new_TestFixture(test_reg_read_all),
+        new_TestFixture(test_reg_read_fifo)
     };
 
     EMB_UNIT_TESTCALLER(pkt_tests, NULL, NULL, fixtures);
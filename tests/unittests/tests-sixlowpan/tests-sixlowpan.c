@@ -44,6 +44,8 @@
 #define MESH_DISP       (0xB3)  /* 10 11 00 11 */
 #define FRAG1_DISP      (0xC5)  /* 11 00 01 01 */
 #define FRAGN_DISP      (0xE5)  /* 11 10 01 01 */
+#define RFRAG_DISP      (0xE9)  /* 11 10 10 01 */
+#define RFRAG_ACK_DISP  (0xEA)  /* 11 10 10 10 */
 
 
 /* Test with 6LoWPAN dispatch byte indicating a none-LoWPAN frame (NALP = Not a
@@ -147,6 +149,40 @@ static void test_sixlowpan_nalp_is_6lowpan_frame_12(void)
     TEST_ASSERT(!sixlowpan_nalp(FRAGN_DISP));
 }
 
+static void test_sixlowpan_sfr_rfrag_is(void)
+{
+    uint8_t disp = RFRAG_DISP;
+
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(RFRAG_DISP));
+    TEST_ASSERT(!sixlowpan_sfr_rfrag_is(RFRAG_ACK_DISP));
+    TEST_ASSERT(!sixlowpan_sfr_rfrag_is(FRAGN_DISP));
+    /* does not collide with fragment headers of RFC 4944 */
+    TEST_ASSERT(!sixlowpan_frag_is((sixlowpan_frag_t *)&disp));
+}
+
+static void test_sixlowpan_sfr_ack_is(void)
+{
+    TEST_ASSERT(sixlowpan_sfr_ack_is(RFRAG_ACK_DISP));
+    TEST_ASSERT(!sixlowpan_sfr_ack_is(RFRAG_DISP));
+    TEST_ASSERT(!sixlowpan_sfr_ack_is(FRAGN_DISP));
+}
+
+static void test_sixlowpan_sfr_rfrag_fields(void)
+{
+    /* ack requested, sequence 5, fragment size 0x123 */
+    sixlowpan_sfr_rfrag_t hdr = { .disp_ecn = RFRAG_DISP, .tag = 0x42,
+                                  .ar_seq_size = { .u8 = { 0x95, 0x23 } } };
+
+    TEST_ASSERT_EQUAL_INT(6, sizeof(sixlowpan_sfr_rfrag_t));
+    TEST_ASSERT_EQUAL_INT(5, sixlowpan_sfr_rfrag_get_seq(&hdr));
+    TEST_ASSERT_EQUAL_INT(0x123, sixlowpan_sfr_rfrag_get_frag_size(&hdr));
+    TEST_ASSERT(sixlowpan_sfr_rfrag_ack_req(&hdr));
+    hdr.ar_seq_size.u8[0] &= ~0x80;
+    TEST_ASSERT(!sixlowpan_sfr_rfrag_ack_req(&hdr));
+    TEST_ASSERT_EQUAL_INT(0x80000000UL, sixlowpan_sfr_ack_bit(0));
+    TEST_ASSERT_EQUAL_INT(0x00000001UL, sixlowpan_sfr_ack_bit(31));
+}
+
 Test *test_sixlowpan_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -170,6 +206,10 @@ Test *test_sixlowpan_tests(void)
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_10),
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_11),
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_12),
+
+        new_TestFixture(test_sixlowpan_sfr_rfrag_is),
+        new_TestFixture(test_sixlowpan_sfr_ack_is),
+        new_TestFixture(test_sixlowpan_sfr_rfrag_fields),
     };
 
     EMB_UNIT_TESTCALLER(test_sixlowpan_tests_caller, NULL, NULL, fixtures);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "tsrb.h"
+
+#include "tests-tsrb.h"
+
+#define TESTS_TSRB_SIZE     (8)
+
+static char buf[TESTS_TSRB_SIZE];
+static tsrb_t rb;
+
+static void set_up(void)
+{
+    memset(buf, 0, sizeof(buf));
+    tsrb_init(&rb, buf, sizeof(buf));
+}
+
+static void test_tsrb_add_get_wrap(void)
+{
+    char out[TESTS_TSRB_SIZE];
+
+    /* move the start close to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&rb, "abcdef", 6));
+    TEST_ASSERT_EQUAL_INT(6, tsrb_drop(&rb, 6));
+
+    TEST_ASSERT_EQUAL_INT(5, tsrb_add(&rb, "01234", 5));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT(memcmp(out, "01234", 5) == 0);
+    TEST_ASSERT(tsrb_empty(&rb));
+}
+
+static void test_tsrb_add_full(void)
+{
+    TEST_ASSERT_EQUAL_INT(TESTS_TSRB_SIZE,
+                          tsrb_add(&rb, "0123456789", 10));
+    TEST_ASSERT(tsrb_full(&rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add(&rb, "x", 1));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&rb, 'x'));
+    TEST_ASSERT_EQUAL_INT('0', tsrb_get_one(&rb));
+}
+
+static void test_tsrb_get_span(void)
+{
+    char *data;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get_span(&rb, &data));
+
+    tsrb_add(&rb, "abcdef", 6);
+    tsrb_drop(&rb, 6);
+    tsrb_add(&rb, "01234", 5);
+
+    /* the data wraps, so it comes in two spans */
+    TEST_ASSERT_EQUAL_INT(2, tsrb_get_span(&rb, &data));
+    TEST_ASSERT(memcmp(data, "01", 2) == 0);
+    tsrb_drop(&rb, 2);
+    TEST_ASSERT_EQUAL_INT(3, tsrb_get_span(&rb, &data));
+    TEST_ASSERT(data == buf);
+    TEST_ASSERT(memcmp(data, "234", 3) == 0);
+    tsrb_drop(&rb, 3);
+    TEST_ASSERT(tsrb_empty(&rb));
+}
+
+static void test_tsrb_free_span(void)
+{
+    char *data;
+    char out[TESTS_TSRB_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(TESTS_TSRB_SIZE, tsrb_free_span(&rb, &data));
+    TEST_ASSERT(data == buf);
+
+    tsrb_add(&rb, "abcde", 5);
+    tsrb_drop(&rb, 4);
+    /* free space up to the end of the buffer, then from its start */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_free_span(&rb, &data));
+    memcpy(data, "fgh", 3);
+    tsrb_add_span(&rb, 3);
+    TEST_ASSERT_EQUAL_INT(4, tsrb_free_span(&rb, &data));
+    TEST_ASSERT(data == buf);
+    memcpy(data, "ij", 2);
+    tsrb_add_span(&rb, 2);
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT(memcmp(out, "efghij", 6) == 0);
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_add_get_wrap),
+        new_TestFixture(test_tsrb_add_full),
+        new_TestFixture(test_tsrb_get_span),
+        new_TestFixture(test_tsrb_free_span),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``tsrb`` module
+ *
+ * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef TESTS_TSRB_H
+#define TESTS_TSRB_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_tsrb(void);
+
+/**
+ * @brief   Generates tests for tsrb
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_tsrb_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_TSRB_H */
+/** @} */
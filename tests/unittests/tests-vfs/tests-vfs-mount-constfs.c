@@ -55,6 +55,43 @@ static const constfs_t fs_data = {
     .nfiles = sizeof(_files) / sizeof(_files[0]),
 };
 
+static const constfs_file_t _nested_files[] = {
+    {
+        .path = "/nested.bin",
+        .data = bin_data,
+        .size = sizeof(bin_data),
+    },
+};
+
+static const constfs_t fs_nested_data = {
+    .files = _nested_files,
+    .nfiles = sizeof(_nested_files) / sizeof(_nested_files[0]),
+};
+
+static const constfs_file_t _sorted_files[] = {
+    {
+        .path = "/a.bin",
+        .data = bin_data,
+        .size = sizeof(bin_data),
+    },
+    {
+        .path = "/b.txt",
+        .data = str_data,
+        .size = sizeof(str_data),
+    },
+    {
+        .path = "/c/d.bin",
+        .data = bin_data,
+        .size = 4,
+    },
+};
+
+static const constfs_t fs_sorted_data = {
+    .files = _sorted_files,
+    .nfiles = sizeof(_sorted_files) / sizeof(_sorted_files[0]),
+    .sorted = true,
+};
+
 static vfs_mount_t _test_vfs_mount_invalid_mount = {
     .mount_point = "test",
     .fs = &constfs_file_system,
@@ -67,6 +104,12 @@ static vfs_mount_t _test_vfs_mount = {
     .private_data = (void *)&fs_data,
 };
 
+static vfs_mount_t _test_vfs_mount_nested = {
+    .mount_point = "/test/sub",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&fs_nested_data,
+};
+
 static void test_vfs_mount_umount(void)
 {
     int res;
@@ -164,6 +207,22 @@ static void test_vfs_constfs_read_lseek(void)
     res = vfs_fcntl(fd, F_GETFL, 0);
     TEST_ASSERT_EQUAL_INT(O_RDONLY, res);
 
+    /* mapping starts at the current position, which does not change */
+    const void *addr;
+    size_t len;
+    pos = vfs_lseek(fd, 5, SEEK_SET);
+    TEST_ASSERT_EQUAL_INT(5, pos);
+    res = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(addr == &str_data[5]);
+    TEST_ASSERT_EQUAL_INT(sizeof(str_data) - 5, len);
+    pos = vfs_lseek(fd, 0, SEEK_CUR);
+    TEST_ASSERT_EQUAL_INT(5, pos);
+    pos = vfs_lseek(fd, 0, SEEK_END);
+    res = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, len);
+
     res = vfs_close(fd);
     TEST_ASSERT_EQUAL_INT(0, res);
 
@@ -171,6 +230,59 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void test_vfs_constfs_find(void)
+{
+    const constfs_file_t *fp;
+
+    fp = constfs_find(&fs_data, "/data.bin");
+    TEST_ASSERT(fp == &_files[1]);
+    TEST_ASSERT_NULL(constfs_find(&fs_data, "/data"));
+
+    for (unsigned i = 0; i < fs_sorted_data.nfiles; i++) {
+        fp = constfs_find(&fs_sorted_data, _sorted_files[i].path);
+        TEST_ASSERT(fp == &_sorted_files[i]);
+    }
+    TEST_ASSERT_NULL(constfs_find(&fs_sorted_data, "/"));
+    TEST_ASSERT_NULL(constfs_find(&fs_sorted_data, "/b"));
+    TEST_ASSERT_NULL(constfs_find(&fs_sorted_data, "/c"));
+    TEST_ASSERT_NULL(constfs_find(&fs_sorted_data, "/z"));
+
+    /* the contents are the array itself, not a copy */
+    fp = constfs_find(&fs_sorted_data, "/b.txt");
+    TEST_ASSERT(fp->data == str_data);
+    TEST_ASSERT_EQUAL_INT(sizeof(str_data), fp->size);
+}
+
+static void test_vfs_mount__nested(void)
+{
+    int res, fd;
+
+    /* the longest mount point takes precedence, regardless of mount order */
+    res = vfs_mount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    fd = vfs_open("/test/sub/nested.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    fd = vfs_open("/test/sub/test.txt", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fd);
+    fd = vfs_open("/test/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    /* no directory separator after "/test/sub" */
+    fd = vfs_open("/test/subnested.bin", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fd);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_umount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -208,8 +320,10 @@ Test *tests_vfs_mount_constfs_tests(void)
         new_TestFixture(test_vfs_mount_umount),
         new_TestFixture(test_vfs_mount__invalid),
         new_TestFixture(test_vfs_umount__invalid_mount),
+        new_TestFixture(test_vfs_mount__nested),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_constfs_find),
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
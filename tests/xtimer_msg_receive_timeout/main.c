@@ -48,6 +48,10 @@ int main(void)
         /* flip sign */
         offset *= (-1);
     }
+    /* a timeout that expires before the thread blocks must not hang */
+    if (xtimer_msg_receive_timeout(&m, 0) < 0) {
+        puts("Timeout!");
+    }
     puts("[SUCCESS]");
     return 0;
 }
@@ -17,6 +17,7 @@ def testfunc(child):
     for i in range(5):
         child.expect("Message: 42")
         child.expect("Timeout!")
+    child.expect("Timeout!")
     child.expect("[SUCCESS]")
 
 if __name__ == "__main__":
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_periodic test application
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define PERIOD          (10U * US_PER_MS)
+#define PERIODS         (100U)
+#define BUSY_PERIODS    (3U)
+#define TOLERANCE       (2U * US_PER_MS)
+#define FLAG            (0x1)
+
+int main(void)
+{
+    xtimer_periodic_t periodic;
+    uint32_t missed = 0;
+    int res = 1;
+
+    puts("xtimer_periodic test");
+
+    uint32_t start = xtimer_now_usec();
+    xtimer_periodic_start(&periodic, PERIOD, FLAG);
+    for (unsigned i = 0; i < PERIODS; i++) {
+        missed += xtimer_periodic_wait(&periodic);
+    }
+    uint32_t diff = xtimer_now_usec() - start;
+    printf("%u periods took %" PRIu32 " us, missed %" PRIu32 "\n",
+           PERIODS, diff, missed);
+    if ((diff < (PERIODS * PERIOD)) || (diff > (PERIODS * PERIOD + TOLERANCE))) {
+        res = 0;
+    }
+
+    /* stay busy for a few periods, all but one must be reported as missed */
+    xtimer_usleep(BUSY_PERIODS * PERIOD + (PERIOD / 2));
+    missed = xtimer_periodic_wait(&periodic);
+    printf("after sleeping: missed %" PRIu32 "\n", missed);
+    if (missed != (BUSY_PERIODS - 1)) {
+        res = 0;
+    }
+    xtimer_periodic_stop(&periodic);
+
+    puts(res ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_rtt test application
+ *
+ * Sets one timer below and one above XTIMER_RTT_THRESHOLD and checks that
+ * both fire in time.
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread_flags.h"
+#include "xtimer_rtt.h"
+
+#define SHORT_OFFSET    (XTIMER_RTT_THRESHOLD / 2)
+#define LONG_OFFSET     (XTIMER_RTT_THRESHOLD * 3)
+#define TOLERANCE       (10U * US_PER_MS)
+
+static void _cb(void *arg)
+{
+    thread_flags_set((thread_t *)arg, 0x1);
+}
+
+static int _run(uint32_t offset)
+{
+    xtimer_rtt_t timer = { .timer = { .callback = _cb,
+                                      .arg = (void *)sched_active_thread } };
+
+    uint32_t before = xtimer_now_usec();
+    xtimer_rtt_set(&timer, offset);
+    thread_flags_wait_any(0x1);
+    uint32_t diff = xtimer_now_usec() - before;
+
+    printf("offset %" PRIu32 " us: fired after %" PRIu32 " us\n", offset, diff);
+    return (diff >= offset) && (diff <= offset + TOLERANCE);
+}
+
+int main(void)
+{
+    puts("xtimer_rtt test");
+
+    if (_run(SHORT_OFFSET) && _run(LONG_OFFSET)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2017 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_stats test application
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#define NUMOF_TIMERS    (8U)
+#define BASE_OFFSET     (10U * US_PER_MS)
+
+static xtimer_t timers[NUMOF_TIMERS];
+static volatile unsigned fired;
+
+static void _cb(void *arg)
+{
+    if (++fired == NUMOF_TIMERS) {
+        thread_flags_set((thread_t *)arg, 0x1);
+    }
+}
+
+int main(void)
+{
+    xtimer_stats_t stats;
+    uint32_t latencies = 0;
+    uint32_t depths = 0;
+
+    puts("xtimer_stats test");
+
+    xtimer_stats_reset();
+
+    /* set in reverse order, so every timer is sorted in at the list head */
+    for (unsigned i = 0; i < NUMOF_TIMERS; i++) {
+        timers[i].callback = _cb;
+        timers[i].arg = (void *)sched_active_thread;
+        xtimer_set(&timers[i], BASE_OFFSET * (NUMOF_TIMERS - i));
+    }
+    thread_flags_wait_any(0x1);
+
+    xtimer_stats_get(&stats);
+    for (unsigned i = 0; i < XTIMER_STATS_BUCKETS; i++) {
+        latencies += stats.latency[i];
+        depths += stats.depth[i];
+    }
+    printf("fired: %" PRIu32 " inserted: %" PRIu32 " at head: %" PRIu32 "\n",
+           latencies, depths, stats.depth[0]);
+    printf("latency max: %" PRIu32 " ticks\n", stats.latency_max);
+
+    if ((latencies == NUMOF_TIMERS) && (stats.depth[0] >= NUMOF_TIMERS)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}